@@ -7,22 +7,16 @@
 // Reconstructs the exact turn-start state from the replay snapshot and runs
 // the REAL engine code (linked against engine/build/libbb_engine.so):
 //   1. getAvailableMacros + the real expand() priors at the root
+//      (MacroMCTSSearch::expandRootPriorsForTest)
 //   2. per-root-macro one-ply Monte Carlo Q: greedyExpandMacro (real dice)
-//      followed by the real MacroMCTSSearch::simulate() leaf heuristic
-//   3. term-by-term decomposition of simulate() for representative post-BLOCK
-//      / post-ADVANCE states (mirror is asserted equal to the real simulate()
-//      to 1e-9 on every state it touches)
+//      followed by the real leaf evaluation (MacroMCTSSearch::leafBreakdown)
+//   3. term-by-term decomposition of the leaf value for representative
+//      post-BLOCK / post-ADVANCE states (leafBreakdown's terms)
 //   4. full MacroMCTSSearch::search() over many seeds with the production
 //      config used to generate the replays (iters=100, C=1.0, vfBlend=0,
 //      policy net loaded with policyBlend=0 -> heuristic prior floors active)
 //   5. variants: carrier unmarked (id21 moved away), different reroll counts
 //
-// NOTE: `#define private public` before including macro_mcts.h exposes
-// MacroMCTSSearch::simulate()/expand() for direct invocation. Access
-// specifiers do not change layout or mangling here, so the calls land in the
-// exact compiled code inside libbb_engine.so. Diagnostic-only trick; no
-// engine source is modified.
-//
 // Build (repo root):
 //   g++ -O2 -std=c++20 -Iengine/include -Iengine/third_party \
 //       diag_advance_vs_block_harness.cpp \
@@ -40,6 +34,7 @@
 #include "bb/game_simulator.h"
 #include "bb/roster.h"
 #include "bb/helpers.h"
+#include "bb/macro_mcts.h"
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
@@ -49,10 +44,6 @@
 #include <string>
 #include <vector>
 
-#define private public
-#include "bb/macro_mcts.h"
-#undef private
-
 using namespace bb;
 
 static const char* macroName(MacroType t) {
@@ -133,7 +124,7 @@ static GameState makeState(int rerolls) {
         Player& p = s.getPlayer(sn.id);
         p.state = (sn.st == 0) ? PlayerState::STANDING : PlayerState::PRONE;
         p.position = {(int8_t)sn.x, (int8_t)sn.y};
-        p.movementRemaining = p.stats.movement;
+        p.movementRemaining = p.stats().movement;
     }
     s.getPlayer(20).state = PlayerState::KO;  // KO'd on home T3 (turns[21])
 
@@ -144,150 +135,21 @@ static GameState makeState(int rerolls) {
 }
 
 // ---------------------------------------------------------------------------
-// Mirror of MacroMCTSSearch::simulate() with per-term printout.
-// vfBlend=0 / leafLookahead=false paths only (the production replay config).
-// Asserted equal to the real simulate() on every state it is used on.
+// The real leaf evaluation, optionally printed term by term.
 // ---------------------------------------------------------------------------
-static double simMirror(const GameState& state, TeamSide perspective, bool print,
-                        std::map<std::string, double>* termsOut = nullptr) {
-    const TeamState& my = state.getTeamState(perspective);
-    const TeamState& opp = state.getTeamState(opponent(perspective));
-    double heuristic = 0.0, scoringBonus = 0.0;
-    std::map<std::string, double> T;
-
-    T["scoreDiff*0.5"] = (my.score - opp.score) * 0.5;
-    heuristic += T["scoreDiff*0.5"];
-
-    int turnsLeft = std::max(0, 9 - my.turnNumber);
-
-    if (state.ball.isHeld && state.ball.carrierId > 0) {
-        const Player& carrier = state.getPlayer(state.ball.carrierId);
-        int ezX = (carrier.teamSide == TeamSide::HOME) ? 25 : 0;
-        int dist = std::abs(carrier.position.x - ezX);
-        int ma = carrier.stats.movement;
-        double proximity = 1.0 - dist / 25.0;
-
-        if (carrier.teamSide == perspective) {
-            T["possession"] = 0.1; heuristic += 0.1;
-            T["SB:proximity"] = 0.25 * proximity; scoringBonus += T["SB:proximity"];
-
-            if (turnsLeft >= 3) {
-                double cageProxSum = 0.0; int cageN = 0;
-                state.forEachOnPitch(perspective, [&](const Player& p) {
-                    if (p.state != PlayerState::STANDING) return;
-                    if (p.id == carrier.id) return;
-                    if (p.position.distanceTo(carrier.position) > 4) return;
-                    int pd = std::abs(p.position.x - ezX);
-                    cageProxSum += 1.0 - pd / 25.0;
-                    cageN++;
-                });
-                if (cageN > 0) {
-                    T["SB:cageAdvance"] = 0.20 * (cageProxSum / cageN);
-                    scoringBonus += T["SB:cageAdvance"];
-                }
-                T["(cageN)"] = cageN;
-            }
-
-            if (dist <= (int)carrier.movementRemaining) {
-                T["SB:safeWalkIn"] = 0.4; scoringBonus += 0.4;
-            } else if (dist <= carrier.movementRemaining + 2) {
-                T["SB:gfiScore"] = 0.2; scoringBonus += 0.2;
-            }
-
-            if (turnsLeft > 0 && dist > 0) {
-                int idealDist = turnsLeft * ma;
-                double pacing = 1.0 - std::abs(dist - idealDist) / (double)std::max(idealDist, 1);
-                if (pacing > 0) { T["SB:stallPacing"] = 0.1 * pacing; scoringBonus += 0.1 * pacing; }
-                T["(idealDist)"] = idealDist; T["(dist)"] = dist;
-            }
-
-            if (turnsLeft <= 2 && dist <= ma + 2) { T["SB:urgency"] = 0.3; scoringBonus += 0.3; }
-            if (turnsLeft <= 1) {
-                if (dist <= (int)carrier.movementRemaining) { T["SB:ottSafe"] = 0.8; scoringBonus += 0.8; }
-                else if (dist <= carrier.movementRemaining + 2) { T["SB:ottGfi"] = 0.5; scoringBonus += 0.5; }
-            }
-
-            if (dist > (int)carrier.movementRemaining + 2) {
-                auto adj = carrier.position.getAdjacent();
-                for (auto& apos : adj) {
-                    if (!apos.isOnPitch()) continue;
-                    const Player* tm = state.getPlayerAtPosition(apos);
-                    if (!tm || tm->teamSide != perspective) continue;
-                    if (tm->state != PlayerState::STANDING) continue;
-                    int tmDist = std::abs(tm->position.x - ezX);
-                    if (tmDist > 0 && tmDist <= (int)tm->movementRemaining + 2) {
-                        T["SB:handoffPot"] = 0.15; scoringBonus += 0.15; break;
-                    }
-                }
-            }
-        } else {
-            T["oppPossession"] = -0.1 - 0.25 * proximity;
-            heuristic += T["oppPossession"];
-            if (dist <= (int)carrier.movementRemaining) { T["oppCanScore"] = -0.4; heuristic += -0.4; }
-        }
-    } else if (!state.ball.isHeld && state.ball.isOnPitch()) {
-        T["looseBall"] = -0.1; heuristic += -0.1;
-        int nearestDist = 999;
-        state.forEachOnPitch(perspective, [&](const Player& p) {
-            if (p.state != PlayerState::STANDING) return;
-            int d = p.position.distanceTo(state.ball.position);
-            if (d < nearestDist) nearestDist = d;
-        });
-        if (nearestDist <= 2) { T["nearLoose"] = 0.08; heuristic += 0.08; }
-        else if (nearestDist <= 4) { T["nearLoose"] = 0.04; heuristic += 0.04; }
-    }
-
-    if (state.ball.isHeld && state.ball.carrierId > 0) {
-        const Player& bh = state.getPlayer(state.ball.carrierId);
-        if (bh.teamSide != perspective && bh.isOnPitch() && bh.state == PlayerState::STANDING) {
-            int carrierTZ = countTacklezones(state, bh.position, bh.teamSide);
-            if (carrierTZ > 0) { T["markOppCarrier"] = 0.08 * std::min(carrierTZ, 3); heuristic += T["markOppCarrier"]; }
-            int y = bh.position.y;
-            if (y <= 2 || y >= 12) { T["sidelineTrap"] = 0.10; heuristic += 0.10; }
-            else if (y <= 4 || y >= 10) { T["sidelineTrap"] = 0.05; heuristic += 0.05; }
-            if (bh.stats.agility >= 4) {
-                int tzCount = countTacklezones(state, bh.position, bh.teamSide);
-                if (tzCount >= 2) { T["containAgile"] = 0.06 * std::min(tzCount - 1, 2); heuristic += T["containAgile"]; }
-            }
-        }
-    }
-
-    {
-        int bashExposure = 0;
-        state.forEachOnPitch(perspective, [&](const Player& p) {
-            if (p.state != PlayerState::STANDING) return;
-            auto adj = p.position.getAdjacent();
-            for (auto& apos : adj) {
-                if (!apos.isOnPitch()) continue;
-                const Player* o = state.getPlayerAtPosition(apos);
-                if (o && o->teamSide != perspective && o->state == PlayerState::STANDING &&
-                    o->stats.strength >= 4) { bashExposure++; break; }
-            }
-        });
-        if (bashExposure) { T["bashExposure"] = -0.05 * bashExposure; heuristic += T["bashExposure"]; }
-    }
-
-    int myPlayers = 0, oppPlayers = 0;
-    state.forEachOnPitch(perspective, [&](const Player& p) { if (p.state == PlayerState::STANDING) myPlayers++; });
-    state.forEachOnPitch(opponent(perspective), [&](const Player& p) { if (p.state == PlayerState::STANDING) oppPlayers++; });
-    T["playerDiff*0.03"] = (myPlayers - oppPlayers) * 0.03;
-    heuristic += T["playerDiff*0.03"];
-
-    heuristic = std::clamp(heuristic, -1.0, 1.0);
-    double total = std::clamp(heuristic + scoringBonus, -1.0, 1.0);
-
+static LeafBreakdown leafEval(const MacroMCTSSearch& search, const GameState& state, bool print) {
+    DiceRoller dice(1);  // only the leafLookahead term rolls (off in this config)
+    LeafBreakdown b = search.leafBreakdown(state, TeamSide::HOME, dice);
     if (print) {
-        for (auto& [k, v] : T)
-            if (k[0] != '(') printf("      %-18s %+0.4f\n", k.c_str(), v);
-        if (T.count("(idealDist)"))
-            printf("      (dist=%g idealDist=%g cageN=%g)\n",
-                   T.count("(dist)") ? T["(dist)"] : -1, T["(idealDist)"],
-                   T.count("(cageN)") ? T["(cageN)"] : 0);
+        for (size_t i = 0; i < b.terms.size(); ++i) {
+            LeafTerm t = static_cast<LeafTerm>(i);
+            if (b.terms[i] != 0.0)
+                printf("      %s%-16s %+0.4f\n", isScoringTerm(t) ? "SB:" : "   ", leafTermName(t), b.terms[i]);
+        }
         printf("      heuristic=%+0.4f scoringBonus=%+0.4f TOTAL=%+0.4f\n",
-               heuristic, total - heuristic, total);
+               b.heuristic, b.scoringBonus, b.value);
     }
-    if (termsOut) *termsOut = T;
-    return total;
+    return b;
 }
 
 // ---------------------------------------------------------------------------
@@ -326,8 +188,8 @@ int main(int argc, char** argv) {
         const Player& p = state.getPlayer(id);
         printf("p%-2d side=%s (%d,%d) st=%d MA%d ST%d AG%d block=%d dodge=%d sureHands=%d\n",
                id, p.teamSide == TeamSide::HOME ? "H" : "A", (int)p.position.x,
-               (int)p.position.y, (int)p.state, p.stats.movement, p.stats.strength,
-               p.stats.agility, p.hasSkill(SkillName::Block),
+               (int)p.position.y, (int)p.state, p.stats().movement, p.stats().strength,
+               p.stats().agility, p.hasSkill(SkillName::Block),
                p.hasSkill(SkillName::Dodge), p.hasSkill(SkillName::SureHands));
     }
 
@@ -335,39 +197,34 @@ int main(int argc, char** argv) {
     MCTSConfig cfg = makeConfig(pol.get());
     MacroMCTSSearch search(vf.get(), cfg, 12345);
 
-    MacroMCTSNode root_;
-    root_.visits = 1;
-    search.expand(&root_, state);
-    printf("\n=== ROOT MACROS (real expand(), n=%zu) ===\n", root_.children.size());
-    for (auto& c : root_.children)
-        printf("  prior=%.4f  %s\n", c.prior, macroLabel(c.macro).c_str());
+    auto rootChildren = search.expandRootPriorsForTest(state);
+    printf("\n=== ROOT MACROS (real expand(), n=%zu) ===\n", rootChildren.size());
+    for (auto& [macro, prior] : rootChildren)
+        printf("  prior=%.4f  %s\n", prior, macroLabel(macro).c_str());
 
     // --- baseline leaf value of the root state itself ---
-    printf("\n=== ROOT STATE simulate() decomposition (perspective HOME) ===\n");
-    double realV = search.simulate(state, TeamSide::HOME);
-    double mirV = simMirror(state, TeamSide::HOME, true);
-    printf("  real simulate()=%.6f mirror=%.6f %s\n", realV, mirV,
-           std::fabs(realV - mirV) < 1e-9 ? "MATCH" : "*** MISMATCH ***");
+    printf("\n=== ROOT STATE leaf decomposition (perspective HOME) ===\n");
+    leafEval(search, state, true);
 
     // --- 2. one-ply Monte Carlo Q per root macro ---
-    printf("\n=== ONE-PLY MC Q (greedyExpandMacro + real simulate(), K=3000) ===\n");
+    printf("\n=== ONE-PLY MC Q (greedyExpandMacro + real leaf value, K=3000) ===\n");
     printf("%-28s %8s %8s %8s %10s %10s\n", "macro", "meanQ", "sd", "p(TO)", "Q|noTO", "Q|TO");
     const int K = 3000;
-    for (auto& c : root_.children) {
+    for (auto& [macro, prior] : rootChildren) {
         DiceRoller d(777);
         double sum = 0, sum2 = 0, sumTO = 0, sumOK = 0;
         int nTO = 0;
         for (int k = 0; k < K; ++k) {
             GameState sim = state.clone();
-            auto res = greedyExpandMacro(sim, c.macro, d);
-            double v = search.simulate(sim, TeamSide::HOME);
+            auto res = greedyExpandMacro(sim, macro, d);
+            double v = leafEval(search, sim, false).value;
             sum += v; sum2 += v * v;
             if (res.turnover) { nTO++; sumTO += v; } else sumOK += v;
         }
         double mean = sum / K;
         double sd = std::sqrt(std::max(0.0, sum2 / K - mean * mean));
         printf("%-28s %+8.4f %8.4f %8.3f %+10.4f %+10.4f\n",
-               macroLabel(c.macro).c_str(), mean, sd, (double)nTO / K,
+               macroLabel(macro).c_str(), mean, sd, (double)nTO / K,
                nTO < K ? sumOK / (K - nTO) : 0.0, nTO ? sumTO / nTO : 0.0);
     }
 
@@ -383,10 +240,7 @@ int main(int argc, char** argv) {
                    label, seed, (int)car.position.x, (int)car.position.y, (int)car.state,
                    (int)sim.ball.position.x, (int)sim.ball.position.y,
                    (int)sim.ball.isHeld, sim.ball.carrierId, (int)res.turnover);
-            double rv = search.simulate(sim, TeamSide::HOME);
-            double mv = simMirror(sim, TeamSide::HOME, true);
-            printf("      real=%.6f mirror=%.6f %s\n", rv, mv,
-                   std::fabs(rv - mv) < 1e-9 ? "MATCH" : "*** MISMATCH ***");
+            leafEval(search, sim, true);
             return;
         }
         printf("\n  -- %s: no such outcome in %d seeds\n", label, maxTries);
@@ -394,12 +248,12 @@ int main(int argc, char** argv) {
 
     Macro blockM{}, advM{};
     bool haveBlock = false, haveAdv = false;
-    for (auto& c : root_.children) {
-        if (c.macro.type == MacroType::BLOCK && c.macro.playerId == 3 && c.macro.targetId == 21) {
-            blockM = c.macro; haveBlock = true;
+    for (auto& [macro, prior] : rootChildren) {
+        if (macro.type == MacroType::BLOCK && macro.playerId == 3 && macro.targetId == 21) {
+            blockM = macro; haveBlock = true;
         }
-        if (c.macro.type == MacroType::ADVANCE && c.macro.playerId == 3) {
-            advM = c.macro; haveAdv = true;
+        if (macro.type == MacroType::ADVANCE && macro.playerId == 3) {
+            advM = macro; haveAdv = true;
         }
     }
     printf("\n=== REPRESENTATIVE POST-STATES ===");
@@ -453,24 +307,23 @@ int main(int argc, char** argv) {
         runSearches(s1, "id21 moved to (11,1): carrier UNMARKED", 400);
 
         // one-ply Q of ADVANCE in the unmarked state
-        MacroMCTSNode r1; r1.visits = 1;
         MacroMCTSSearch s3(vf.get(), cfg, 999);
-        s3.expand(&r1, s1);
+        auto r1 = s3.expandRootPriorsForTest(s1);
         printf("\n  unmarked-state root priors:\n");
-        for (auto& c : r1.children)
-            printf("    prior=%.4f  %s\n", c.prior, macroLabel(c.macro).c_str());
+        for (auto& [macro, prior] : r1)
+            printf("    prior=%.4f  %s\n", prior, macroLabel(macro).c_str());
         printf("  one-ply MC Q (K=3000):\n");
-        for (auto& c : r1.children) {
+        for (auto& [macro, prior] : r1) {
             DiceRoller d(777);
             double sum = 0; int nTO = 0;
             for (int k = 0; k < K; ++k) {
                 GameState sim = s1.clone();
-                auto res = greedyExpandMacro(sim, c.macro, d);
-                sum += s3.simulate(sim, TeamSide::HOME);
+                auto res = greedyExpandMacro(sim, macro, d);
+                sum += leafEval(s3, sim, false).value;
                 if (res.turnover) nTO++;
             }
             printf("    %-28s meanQ=%+0.4f p(TO)=%.3f\n",
-                   macroLabel(c.macro).c_str(), sum / K, (double)nTO / K);
+                   macroLabel(macro).c_str(), sum / K, (double)nTO / K);
         }
     }
     { // where does ADVANCE actually take the carrier? show the pacing math.
@@ -485,14 +338,11 @@ int main(int argc, char** argv) {
         for (int x = 0; x <= 12; ++x) {
             s2.getPlayer(3).position = {(int8_t)x, 4};
             s2.ball.position = {(int8_t)x, 4};
-            double v = search.simulate(s2, TeamSide::HOME);
-            std::map<std::string, double> T;
-            simMirror(s2, TeamSide::HOME, false, &T);
-            printf("    x=%2d total=%+0.4f  prox=%+0.4f pacing=%+0.4f cage=%+0.4f (cageN=%g)\n",
-                   x, v, T.count("SB:proximity") ? T["SB:proximity"] : 0,
-                   T.count("SB:stallPacing") ? T["SB:stallPacing"] : 0,
-                   T.count("SB:cageAdvance") ? T["SB:cageAdvance"] : 0,
-                   T.count("(cageN)") ? T["(cageN)"] : 0);
+            LeafBreakdown b = leafEval(search, s2, false);
+            auto term = [&](LeafTerm t) { return b.terms[static_cast<size_t>(t)]; };
+            printf("    x=%2d total=%+0.4f  prox=%+0.4f pacing=%+0.4f cage=%+0.4f\n",
+                   x, b.value, term(LeafTerm::PROXIMITY), term(LeafTerm::PACING),
+                   term(LeafTerm::CAGE_ADVANCE));
         }
     }
 
@@ -142,10 +142,11 @@ def verify_mapping() -> None:
         gs = bb_engine.GameState()
         bb_engine.setup_half(gs, hr, ar)
         table = player_table(ra, rb)
+        players = gs.as_arrays()["players"]
         for pid in range(1, 23):
-            p = gs.get_player(pid)
+            p = players[pid - 1]
             t = table[pid]
-            got = (p.stats.movement, p.stats.strength, p.stats.agility, p.stats.armour)
+            got = (int(p["movement"]), int(p["strength"]), int(p["agility"]), int(p["armour"]))
             want = (t["ma"], t["st"], t["ag"], t["av"])
             assert got == want, f"{ra}/{rb} id {pid}: engine {got} != table {want} ({t['name']})"
     print("slot-mapping verification vs bb_engine.setup_half: OK (5 race pairs, 22 ids)")
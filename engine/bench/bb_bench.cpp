@@ -0,0 +1,562 @@
+// Engine hot-path microbenchmarks (Google Benchmark).
+//
+// Every benchmark runs over the same fixture set: mid-game PLAY positions
+// sampled from seeded greedy-vs-greedy games for several roster matchups,
+// so numbers are comparable between engine revisions. Output defaults to
+// JSON on stdout; pass --benchmark_format=console for a table, or
+// --benchmark_out=FILE to keep the JSON alongside.
+#include <benchmark/benchmark.h>
+
+#include "bb/action_features.h"
+#include "bb/action_resolver.h"
+#include "bb/alloc_tracking.h"
+#include "bb/board_planes.h"
+#include "bb/conv_network.h"
+#include "bb/feature_extractor.h"
+#include "bb/game_simulator.h"
+#include "bb/macro_actions.h"
+#include "bb/macro_mcts.h"
+#include "bb/mlp.h"
+#include "bb/mcts.h"
+#include "bb/pathfinder.h"
+#include "bb/policies.h"
+#include "bb/policy_network.h"
+#include "bb/roster.h"
+#include "bb/rules_engine.h"
+#include "bb/undo_journal.h"
+#include "bb/value_function.h"
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace bb;
+
+namespace {
+
+struct Matchup {
+    const char* name;
+    const char* home;
+    const char* away;
+};
+
+const Matchup MATCHUPS[] = {
+    {"human_v_orc", "human", "orc"},
+    {"skaven_v_dwarf", "skaven", "dwarf"},
+    {"wood-elf_v_chaos", "wood-elf", "chaos"},
+    {"goblin_v_ogre", "goblin", "ogre"},        // bombs, ball & chain, team-mate throws
+    {"vampire_v_halfling", "vampire", "halfling"},  // hypnotic gaze
+};
+
+const char* const ACTION_NAMES[] = {
+    "MOVE", "BLOCK", "BLITZ", "PASS", "HAND_OFF", "FOUL", "THROW_TEAM_MATE",
+    "BOMB_THROW", "HYPNOTIC_GAZE", "BALL_AND_CHAIN", "MULTIPLE_BLOCK",
+    "END_TURN", "SETUP_PLAYER", "END_SETUP", "MOVE_PATH",
+};
+
+const char* const MACRO_NAMES[] = {
+    "SCORE", "ADVANCE", "CAGE", "BLITZ", "BLOCK", "PICKUP", "PASS_ACTION",
+    "FOUL", "REPOSITION", "END_TURN", "BLITZ_AND_SCORE", "HAND_OFF_SCORE",
+    "PASS_SCORE", "CHAIN_SCORE",
+};
+
+constexpr int POSITIONS_PER_MATCHUP = 12;
+constexpr int SAMPLE_EVERY = 17;  // greedy decisions between captured positions
+
+// Mid-game PLAY positions of one matchup, from a seeded greedy game (and
+// further games if the first ends early).
+std::vector<GameState> samplePositions(const Matchup& m) {
+    const TeamRoster& home = *getRosterByName(m.home);
+    const TeamRoster& away = *getRosterByName(m.away);
+    std::vector<GameState> out;
+    for (uint32_t seed = 1; out.size() < POSITIONS_PER_MATCHUP && seed < 20; ++seed) {
+        DiceRoller dice(seed);
+        int decisions = 0;
+        ActionSelector greedy = [&](const GameState& s) {
+            if (s.phase == GamePhase::PLAY && ++decisions % SAMPLE_EVERY == 0 &&
+                out.size() < POSITIONS_PER_MATCHUP) {
+                out.push_back(s.clone());
+            }
+            return greedyPolicy(s, dice);
+        };
+        simulateGame(home, away, greedy, greedy, dice);
+    }
+    return out;
+}
+
+const std::vector<std::vector<GameState>>& fixtures() {
+    static const std::vector<std::vector<GameState>> all = [] {
+        std::vector<std::vector<GameState>> f;
+        for (const Matchup& m : MATCHUPS) f.push_back(samplePositions(m));
+        return f;
+    }();
+    return all;
+}
+
+// Every fixture position, all matchups
+std::vector<const GameState*> allPositions() {
+    std::vector<const GameState*> out;
+    for (const auto& positions : fixtures()) {
+        for (const GameState& s : positions) out.push_back(&s);
+    }
+    return out;
+}
+
+// Heap allocations and bytes per benchmark iteration since `start`, plus
+// the peak live heap, as counters (BB_ALLOC_TRACKING builds only).
+void reportAllocations(benchmark::State& st, const AllocCounters& start) {
+    if (!allocTrackingEnabled()) return;
+    AllocCounters d = threadAllocCounters().since(start);
+    using benchmark::Counter;
+    st.counters["allocs"] = Counter(static_cast<double>(d.allocations), Counter::kAvgIterations);
+    st.counters["allocBytes"] = Counter(static_cast<double>(d.bytes), Counter::kAvgIterations);
+    st.counters["peakBytes"] = static_cast<double>(allocPeakBytes());
+}
+
+// --- Move generation and features (per matchup) ---
+
+void BM_GetAvailableActions(benchmark::State& st, int matchup) {
+    const auto& positions = fixtures()[matchup];
+    ActionList actions;
+    size_t i = 0;
+    AllocCounters allocStart = threadAllocCounters();
+    for (auto _ : st) {
+        getAvailableActions(positions[i], actions);
+        benchmark::DoNotOptimize(actions.size());
+        if (++i == positions.size()) i = 0;
+    }
+    st.SetItemsProcessed(st.iterations());
+    reportAllocations(st, allocStart);
+}
+
+void BM_ExtractFeatures(benchmark::State& st, int matchup) {
+    const auto& positions = fixtures()[matchup];
+    float features[NUM_FEATURES];
+    size_t i = 0;
+    for (auto _ : st) {
+        extractFeatures(positions[i], positions[i].activeTeam, features);
+        benchmark::DoNotOptimize(features);
+        if (++i == positions.size()) i = 0;
+    }
+    st.SetItemsProcessed(st.iterations());
+}
+
+// Items = states featurized; all fixture positions, one batch call per pass
+void BM_ExtractFeaturesBatch(benchmark::State& st) {
+    std::vector<GameState> positions;
+    std::vector<TeamSide> persp;
+    for (const GameState* s : allPositions()) {
+        positions.push_back(*s);
+        persp.push_back(s->activeTeam);
+    }
+    int n = static_cast<int>(positions.size());
+    std::vector<float> features(static_cast<size_t>(n) * NUM_FEATURES);
+    for (auto _ : st) {
+        extractFeaturesBatch(positions.data(), n, persp.data(), features.data());
+        benchmark::DoNotOptimize(features.data());
+    }
+    st.SetItemsProcessed(st.iterations() * n);
+}
+
+// Items = states featurized into packed board planes
+void BM_ExtractBoardPlanes(benchmark::State& st) {
+    std::vector<const GameState*> positions = allPositions();
+    std::vector<uint8_t> planes(NUM_BOARD_PLANES * BOARD_PLANE_BYTES);
+    size_t i = 0;
+    for (auto _ : st) {
+        extractBoardPlanesPacked(*positions[i], positions[i]->activeTeam, planes.data());
+        benchmark::DoNotOptimize(planes.data());
+        if (++i == positions.size()) i = 0;
+    }
+    st.SetItemsProcessed(st.iterations());
+}
+
+// Items = actions featurized (every legal action of each position)
+void BM_ExtractActionFeatures(benchmark::State& st, int matchup) {
+    const auto& positions = fixtures()[matchup];
+    std::vector<std::vector<Action>> actions(positions.size());
+    for (size_t p = 0; p < positions.size(); ++p) getAvailableActions(positions[p], actions[p]);
+    float features[NUM_ACTION_FEATURES];
+    size_t i = 0;
+    int64_t items = 0;
+    for (auto _ : st) {
+        for (const Action& a : actions[i]) {
+            extractActionFeatures(positions[i], a, features);
+            benchmark::DoNotOptimize(features);
+        }
+        items += static_cast<int64_t>(actions[i].size());
+        if (++i == positions.size()) i = 0;
+    }
+    st.SetItemsProcessed(items);
+}
+
+// Items = (player, target) queries; targets are the ball and every enemy.
+// The cached variant hits the per-thread reachability cache after the first
+// pass, as search does; the uncached one rebuilds the map every query.
+void reachQueries(const GameState& s, std::vector<std::pair<int, Position>>& out) {
+    out.clear();
+    s.forEachOnPitch(s.activeTeam, [&](const Player& p) {
+        if (s.ball.isOnPitch()) out.push_back({p.id, s.ball.position});
+        s.forEachOnPitch(opponent(s.activeTeam), [&](const Player& e) {
+            out.push_back({p.id, e.position});
+        });
+    });
+}
+
+void BM_CanReachAdjacentTo(benchmark::State& st, int matchup) {
+    const auto& positions = fixtures()[matchup];
+    std::vector<std::vector<std::pair<int, Position>>> queries(positions.size());
+    for (size_t p = 0; p < positions.size(); ++p) reachQueries(positions[p], queries[p]);
+    size_t i = 0;
+    int64_t items = 0;
+    for (auto _ : st) {
+        for (auto [id, target] : queries[i]) {
+            Position adj;
+            benchmark::DoNotOptimize(canReachAdjacentTo(positions[i], positions[i].getPlayer(id),
+                                                        target, adj));
+        }
+        items += static_cast<int64_t>(queries[i].size());
+        if (++i == positions.size()) i = 0;
+    }
+    st.SetItemsProcessed(items);
+}
+
+void BM_ComputeReachability(benchmark::State& st, int matchup) {
+    const auto& positions = fixtures()[matchup];
+    ReachabilityMap map;
+    size_t i = 0;
+    int64_t items = 0;
+    for (auto _ : st) {
+        positions[i].forEachOnPitch(positions[i].activeTeam, [&](const Player& p) {
+            computeReachability(positions[i], p, map);
+            benchmark::DoNotOptimize(map.reachable);
+            ++items;
+        });
+        if (++i == positions.size()) i = 0;
+    }
+    st.SetItemsProcessed(items);
+}
+
+// --- Execution (per action / macro type, all matchups) ---
+
+// One executeAction of `type` on a working copy, rolled back through the
+// undo journal (so the rollback is part of the measured cost, as in search).
+void BM_ExecuteAction(benchmark::State& st, ActionType type) {
+    struct Sample { const GameState* state; Action action; };
+    std::vector<Sample> samples;
+    for (const GameState* s : allPositions()) {
+        std::vector<Action> actions;
+        if (type == ActionType::MOVE_PATH) getAvailableActionsWithPaths(*s, actions);
+        else getAvailableActions(*s, actions);
+        for (const Action& a : actions) {
+            if (a.type == type) samples.push_back({s, a});
+        }
+    }
+    if (samples.empty()) {
+        st.SkipWithError("no fixture position offers this action");
+        return;
+    }
+
+    FastDiceRoller dice(42);
+    UndoJournal journal;
+    size_t i = 0;
+    GameState work = samples[0].state->clone();
+    AllocCounters allocStart = threadAllocCounters();
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(executeActionJournaled(work, samples[i].action, dice, journal));
+        journal.undoTo(work, 0);
+        if (++i == samples.size()) i = 0;
+        // Samples are grouped by position: copy only when it changes
+        if (samples[i].state != samples[i ? i - 1 : samples.size() - 1].state) {
+            work = samples[i].state->clone();
+        }
+    }
+    st.SetItemsProcessed(st.iterations());
+    reportAllocations(st, allocStart);
+    st.counters["samples"] = static_cast<double>(samples.size());
+}
+
+void BM_GreedyExpandMacro(benchmark::State& st, MacroType type) {
+    struct Sample { const GameState* state; Macro macro; };
+    std::vector<Sample> samples;
+    for (const GameState* s : allPositions()) {
+        MacroList macros;
+        getAvailableMacros(*s, macros);
+        for (const Macro& m : macros) {
+            if (m.type == type) samples.push_back({s, m});
+        }
+    }
+    if (samples.empty()) {
+        st.SkipWithError("no fixture position offers this macro");
+        return;
+    }
+
+    FastDiceRoller dice(42);
+    UndoJournal journal;
+    size_t i = 0;
+    GameState work = samples[0].state->clone();
+    AllocCounters allocStart = threadAllocCounters();
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(greedyExpandMacroJournaled(work, samples[i].macro, dice, journal));
+        journal.undoTo(work, 0);
+        if (++i == samples.size()) i = 0;
+        // Samples are grouped by position: copy only when it changes
+        if (samples[i].state != samples[i ? i - 1 : samples.size() - 1].state) {
+            work = samples[i].state->clone();
+        }
+    }
+    st.SetItemsProcessed(st.iterations());
+    reportAllocations(st, allocStart);
+    st.counters["samples"] = static_cast<double>(samples.size());
+}
+
+void BM_GetAvailableMacros(benchmark::State& st) {
+    std::vector<const GameState*> positions = allPositions();
+    MacroList macros;
+    size_t i = 0;
+    AllocCounters allocStart = threadAllocCounters();
+    for (auto _ : st) {
+        getAvailableMacros(*positions[i], macros);
+        benchmark::DoNotOptimize(macros.size());
+        if (++i == positions.size()) i = 0;
+    }
+    st.SetItemsProcessed(st.iterations());
+    reportAllocations(st, allocStart);
+}
+
+// --- Network inference (random weights; only the shape matters) ---
+
+constexpr int HIDDEN = 64;
+
+std::vector<float> randomVector(size_t n, std::mt19937& rng) {
+    std::normal_distribution<float> dist(0.0f, 0.1f);
+    std::vector<float> v(n);
+    for (float& x : v) x = dist(rng);
+    return v;
+}
+
+NeuralValueFunction makeValueNetwork() {
+    std::mt19937 rng(7);
+    std::vector<std::vector<float>> W1(NUM_FEATURES);
+    for (auto& row : W1) row = randomVector(HIDDEN, rng);
+    return NeuralValueFunction(NUM_FEATURES, HIDDEN, W1, randomVector(HIDDEN, rng),
+                               randomVector(HIDDEN, rng), 0.0f);
+}
+
+PolicyNetwork makePolicyNetwork() {
+    std::mt19937 rng(11);
+    return PolicyNetwork(randomVector(static_cast<size_t>(POLICY_INPUT_SIZE) * HIDDEN, rng),
+                         randomVector(HIDDEN, rng), randomVector(HIDDEN, rng), 0.0f, HIDDEN);
+}
+
+// Items = feature rows; range(0) = batch size, range(1) = int8
+void BM_ValueNetwork(benchmark::State& st) {
+    NeuralValueFunction vf = makeValueNetwork();
+    vf.setInt8(st.range(1) != 0);
+    int batch = static_cast<int>(st.range(0));
+    std::vector<const GameState*> positions = allPositions();
+    std::vector<float> features(static_cast<size_t>(batch) * NUM_FEATURES);
+    for (int b = 0; b < batch; ++b) {
+        const GameState& s = *positions[b % positions.size()];
+        extractFeatures(s, s.activeTeam, &features[static_cast<size_t>(b) * NUM_FEATURES]);
+    }
+    std::vector<float> out(batch);
+    for (auto _ : st) {
+        vf.evaluateBatch(features.data(), batch, NUM_FEATURES, out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    st.SetItemsProcessed(st.iterations() * batch);
+}
+
+// Items = feature rows; range(0) = hidden width. Three hidden layers;
+// 128 runs the compiled-width kernels, 120 the runtime-sized loop.
+void BM_MlpValueNetwork(benchmark::State& st) {
+    std::mt19937 rng(17);
+    int width = static_cast<int>(st.range(0));
+    const int widths[] = {NUM_FEATURES, width, width, width, 1};
+    std::vector<MlpLayer> layers;
+    for (int l = 0; l < 4; ++l) {
+        int in = widths[l], out = widths[l + 1];
+        layers.push_back({in, out, randomVector(static_cast<size_t>(in) * out, rng), randomVector(out, rng)});
+    }
+    MlpValueFunction vf(std::make_shared<const Mlp>(std::move(layers)));
+    std::vector<const GameState*> positions = allPositions();
+    std::vector<float> features(positions.size() * NUM_FEATURES);
+    for (size_t p = 0; p < positions.size(); ++p) {
+        extractFeatures(*positions[p], positions[p]->activeTeam, &features[p * NUM_FEATURES]);
+    }
+    size_t i = 0;
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(vf.evaluate(&features[i * NUM_FEATURES], NUM_FEATURES));
+        if (++i == positions.size()) i = 0;
+    }
+    st.SetItemsProcessed(st.iterations());
+}
+
+// Items = positions valued; range(0) = channels, range(1) = batch size.
+// Three 3x3 conv layers over the board planes.
+void BM_ConvValueNetwork(benchmark::State& st) {
+    std::mt19937 rng(13);
+    int channels = static_cast<int>(st.range(0));
+    std::vector<ConvLayer> trunk;
+    for (int l = 0, in = NUM_BOARD_PLANES; l < 3; ++l, in = channels) {
+        trunk.push_back({in, channels, randomVector(static_cast<size_t>(channels) * in * 9, rng),
+                         randomVector(channels, rng)});
+    }
+    ConvValueFunction vf(std::make_shared<const ConvNet>(
+        std::move(trunk), randomVector(static_cast<size_t>(HIDDEN) * channels, rng),
+        randomVector(HIDDEN, rng), randomVector(HIDDEN, rng), 0.0f,
+        randomVector(static_cast<size_t>(CONV_POLICY_PLANES) * channels, rng),
+        randomVector(CONV_POLICY_PLANES, rng)));
+    int batch = static_cast<int>(st.range(1));
+    std::vector<const GameState*> positions = allPositions();
+    std::vector<float> planes(static_cast<size_t>(batch) * CONV_INPUT_SIZE);
+    for (int b = 0; b < batch; ++b) {
+        const GameState& s = *positions[b % positions.size()];
+        vf.encodeState(s, s.activeTeam, &planes[static_cast<size_t>(b) * CONV_INPUT_SIZE]);
+    }
+    std::vector<float> out(batch);
+    for (auto _ : st) {
+        vf.evaluateBatch(planes.data(), batch, CONV_INPUT_SIZE, out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    st.SetItemsProcessed(st.iterations() * batch);
+}
+
+// Items = actions scored: priors over every legal action of each position
+void BM_PolicyNetwork(benchmark::State& st) {
+    PolicyNetwork policy = makePolicyNetwork();
+    policy.setInt8(st.range(0) != 0);
+    std::vector<const GameState*> positions = allPositions();
+    struct Input { std::vector<float> state, actions; int count; };
+    std::vector<Input> inputs;
+    for (const GameState* s : positions) {
+        std::vector<Action> actions;
+        getAvailableActions(*s, actions);
+        Input in{std::vector<float>(NUM_FEATURES),
+                 std::vector<float>(actions.size() * NUM_ACTION_FEATURES),
+                 static_cast<int>(actions.size())};
+        extractFeatures(*s, s->activeTeam, in.state.data());
+        for (size_t a = 0; a < actions.size(); ++a) {
+            extractActionFeatures(*s, actions[a], &in.actions[a * NUM_ACTION_FEATURES]);
+        }
+        inputs.push_back(std::move(in));
+    }
+    std::vector<float> priors;
+    size_t i = 0;
+    int64_t items = 0;
+    for (auto _ : st) {
+        const Input& in = inputs[i];
+        priors.resize(in.count);
+        policy.computePriors(in.state.data(), in.actions.data(), in.count, priors.data());
+        benchmark::DoNotOptimize(priors.data());
+        items += in.count;
+        if (++i == inputs.size()) i = 0;
+    }
+    st.SetItemsProcessed(items);
+}
+
+// --- Full search (iterations per second, over every fixture position) ---
+
+constexpr int SEARCH_ITERATIONS = 200;
+
+MCTSConfig searchConfig() {
+    MCTSConfig config;
+    config.timeBudgetMs = 1 << 30;  // iteration-bound, not time-bound
+    config.maxIterations = SEARCH_ITERATIONS;
+    return config;
+}
+
+// Items = search iterations
+void BM_MCTSSearch(benchmark::State& st) {
+    NeuralValueFunction vf = makeValueNetwork();
+    std::vector<const GameState*> positions = allPositions();
+    MCTSSearch search(&vf, searchConfig(), 42);
+    size_t i = 0;
+    int64_t items = 0;
+    AllocCounters allocStart = threadAllocCounters();
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(search.search(*positions[i]));
+        items += search.lastIterations();
+        if (++i == positions.size()) i = 0;
+    }
+    st.SetItemsProcessed(items);
+    reportAllocations(st, allocStart);
+}
+
+// range(0) = vfBlend > 0 (neural leaf evals on top of the heuristic)
+void BM_MacroMCTSSearch(benchmark::State& st) {
+    NeuralValueFunction vf = makeValueNetwork();
+    MCTSConfig config = searchConfig();
+    config.vfBlend = st.range(0) ? 0.5f : 0.0f;
+    std::vector<const GameState*> positions = allPositions();
+    MacroMCTSSearch search(&vf, config, 42);
+    size_t i = 0;
+    int64_t items = 0;
+    AllocCounters allocStart = threadAllocCounters();
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(search.search(*positions[i]));
+        items += search.lastIterations();
+        if (++i == positions.size()) i = 0;
+    }
+    st.SetItemsProcessed(items);
+    reportAllocations(st, allocStart);
+}
+
+void registerBenchmarks() {
+    for (int m = 0; m < static_cast<int>(std::size(MATCHUPS)); ++m) {
+        std::string suffix = std::string("/") + MATCHUPS[m].name;
+        benchmark::RegisterBenchmark(("getAvailableActions" + suffix).c_str(), BM_GetAvailableActions, m);
+        benchmark::RegisterBenchmark(("extractFeatures" + suffix).c_str(), BM_ExtractFeatures, m);
+        benchmark::RegisterBenchmark(("extractActionFeatures" + suffix).c_str(), BM_ExtractActionFeatures, m);
+        benchmark::RegisterBenchmark(("canReachAdjacentTo" + suffix).c_str(), BM_CanReachAdjacentTo, m);
+        benchmark::RegisterBenchmark(("computeReachability" + suffix).c_str(), BM_ComputeReachability, m);
+    }
+    for (int t = 0; t < static_cast<int>(std::size(ACTION_NAMES)); ++t) {
+        ActionType type = static_cast<ActionType>(t);
+        if (type == ActionType::SETUP_PLAYER || type == ActionType::END_SETUP) continue;  // not in PLAY
+        benchmark::RegisterBenchmark((std::string("executeAction/") + ACTION_NAMES[t]).c_str(),
+                                     BM_ExecuteAction, type);
+    }
+    benchmark::RegisterBenchmark("extractFeaturesBatch", BM_ExtractFeaturesBatch);
+    benchmark::RegisterBenchmark("extractBoardPlanes", BM_ExtractBoardPlanes);
+    benchmark::RegisterBenchmark("getAvailableMacros", BM_GetAvailableMacros);
+    for (int t = 0; t < static_cast<int>(MacroType::MACRO_COUNT); ++t) {
+        benchmark::RegisterBenchmark((std::string("greedyExpandMacro/") + MACRO_NAMES[t]).c_str(),
+                                     BM_GreedyExpandMacro, static_cast<MacroType>(t));
+    }
+    benchmark::RegisterBenchmark("valueNetwork", BM_ValueNetwork)
+        ->ArgNames({"batch", "int8"})->ArgsProduct({{1, 64}, {0, 1}});
+    benchmark::RegisterBenchmark("mlpValueNetwork", BM_MlpValueNetwork)
+        ->ArgName("width")->Arg(64)->Arg(120)->Arg(128)->Arg(256);
+    benchmark::RegisterBenchmark("convValueNetwork", BM_ConvValueNetwork)
+        ->ArgNames({"channels", "batch"})->ArgsProduct({{16, 32}, {1, 16}});
+    benchmark::RegisterBenchmark("policyNetwork", BM_PolicyNetwork)->ArgName("int8")->Arg(0)->Arg(1);
+    benchmark::RegisterBenchmark("MCTSSearch", BM_MCTSSearch)->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark("MacroMCTSSearch", BM_MacroMCTSSearch)
+        ->ArgName("vf")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+}
+
+} // anonymous namespace
+
+static_assert(std::size(ACTION_NAMES) == static_cast<size_t>(ActionType::MOVE_PATH) + 1);
+static_assert(std::size(MACRO_NAMES) == static_cast<size_t>(MacroType::MACRO_COUNT));
+
+int main(int argc, char** argv) {
+    // JSON unless the caller picked a format
+    std::vector<char*> args(argv, argv + argc);
+    bool formatGiven = false;
+    for (int i = 1; i < argc; ++i) {
+        formatGiven |= std::strncmp(argv[i], "--benchmark_format", 18) == 0;
+    }
+    char jsonFormat[] = "--benchmark_format=json";
+    if (!formatGiven) args.push_back(jsonFormat);
+    int n = static_cast<int>(args.size());
+
+    benchmark::Initialize(&n, args.data());
+    if (benchmark::ReportUnrecognizedArguments(n, args.data())) return 1;
+    registerBenchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
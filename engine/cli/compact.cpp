@@ -0,0 +1,92 @@
+#include "bb/shard_compactor.h"
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace bb;
+
+// Merge self-play shard directories into one, folding duplicate decisions
+// and dropping low-information ones (shard_compactor.h).
+
+namespace {
+
+struct Options {
+    std::vector<std::string> inputs;
+    std::string outputDir;
+    CompactorConfig config;
+};
+
+void printUsage() {
+    std::cout << "Usage: bb_compact --out=DIR [options] INPUT_DIR...\n"
+              << "\nDuplicates:\n"
+              << "  --canonical           Fold a position and its y-mirror together\n"
+              << "  --memory-mb=N         Memory for duplicate groups; more input takes more\n"
+              << "                        passes (default: 1024)\n"
+              << "\nLow-information decisions (dropped):\n"
+              << "  --min-actions=N       Fewer visited actions (default: 2, i.e. forced moves)\n"
+              << "  --min-visits=N        Searches with fewer root visits (default: 0)\n"
+              << "  --max-top=F           Top action's share above F (default: 1, keep all)\n"
+              << "\nOutput:\n"
+              << "  --out=DIR             Output shard directory (appended to if it has shards)\n"
+              << "  --no-states           Do not copy the state records\n"
+              << "  --max-shard-mb=N      Roll output shards over at N MB (default: 256)\n"
+              << "  --zstd[=LEVEL]        Compress closed output shards (BB_ZSTD builds)\n"
+              << "  --help                Show this help\n";
+}
+
+Options parseArgs(int argc, char* argv[]) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find("--out=") == 0) opts.outputDir = arg.substr(6);
+        else if (arg == "--canonical") opts.config.canonical = true;
+        else if (arg.find("--memory-mb=") == 0) opts.config.memoryBytes = std::stoull(arg.substr(12)) << 20;
+        else if (arg.find("--min-actions=") == 0) opts.config.minActions = std::stoi(arg.substr(14));
+        else if (arg.find("--min-visits=") == 0) opts.config.minVisitWeight = std::stof(arg.substr(13));
+        else if (arg.find("--max-top=") == 0) opts.config.maxTopFraction = std::stof(arg.substr(10));
+        else if (arg == "--no-states") opts.config.copyStates = false;
+        else if (arg.find("--max-shard-mb=") == 0) opts.config.output.maxShardBytes = std::stoull(arg.substr(15)) << 20;
+        else if (arg == "--zstd") opts.config.output.compress = true;
+        else if (arg.find("--zstd=") == 0) {
+            opts.config.output.compress = true;
+            opts.config.output.compressionLevel = std::stoi(arg.substr(7));
+        }
+        else if (arg == "--help") { printUsage(); exit(0); }
+        else if (arg.find("--") == 0) { std::cerr << "Unknown option: " << arg << "\n"; printUsage(); exit(1); }
+        else opts.inputs.push_back(arg);
+    }
+    return opts;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options opts;
+    try {
+        opts = parseArgs(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Bad option: " << e.what() << "\n";
+        return 1;
+    }
+    if (opts.outputDir.empty() || opts.inputs.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    CompactorStats s;
+    try {
+        s = compactShards(opts.inputs, opts.outputDir, opts.config);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    std::printf("decisions %llu -> %llu (%llu low-information, %llu duplicates, %llu of them mirrored)\n",
+                static_cast<unsigned long long>(s.decisionsIn), static_cast<unsigned long long>(s.decisionsOut),
+                static_cast<unsigned long long>(s.dropped), static_cast<unsigned long long>(s.merged),
+                static_cast<unsigned long long>(s.mirrorMerged));
+    std::printf("visit rows %llu -> %llu, states %llu, %d pass%s\n",
+                static_cast<unsigned long long>(s.visitsIn), static_cast<unsigned long long>(s.visitsOut),
+                static_cast<unsigned long long>(s.statesOut), s.passes, s.passes == 1 ? "" : "es");
+    return 0;
+}
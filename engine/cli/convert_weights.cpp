@@ -0,0 +1,29 @@
+#include "bb/weights_file.h"
+#include <iostream>
+#include <string>
+
+using namespace bb;
+
+// Convert JSON weights snapshots to the binary memory-mappable format:
+//   convert_weights IN.json OUT.bin [IN.json OUT.bin ...]
+int main(int argc, char* argv[]) {
+    if (argc < 3 || argc % 2 == 0) {
+        std::cerr << "Usage: convert_weights IN.json OUT.bin [IN.json OUT.bin ...]\n";
+        return 1;
+    }
+    int failures = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string in = argv[i], out = argv[i + 1];
+        bool ok = false;
+        try {
+            ok = convertWeightsJson(in, out);
+        } catch (const std::exception& e) {
+            std::cerr << in << ": " << e.what() << "\n";
+        }
+        if (!ok) {
+            std::cerr << "Failed to convert " << in << "\n";
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
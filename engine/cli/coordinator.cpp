@@ -0,0 +1,218 @@
+#include "bb/self_play_cluster.h"
+#include <nlohmann/json.hpp>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace bb;
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+// Self-play coordinator: splits a run into units of consecutive seeds and
+// serves them to bb_worker processes over TCP (see self_play_cluster.h).
+// Each completed unit's shards land in OUT/unit-NNNNNN/; OUT/summary.jsonl
+// lists the units in order once the run is over.
+
+namespace {
+
+struct Options {
+    int port = 7878;
+    std::string bind = "0.0.0.0";
+    std::string modelPath;
+    std::string outDir = "cluster_run";
+    ClusterRunConfig run;
+};
+
+void printUsage() {
+    std::cout << "Usage: bb_coordinator --model=PATH --games=N [options]\n"
+              << "\nListening:\n"
+              << "  --port=N            TCP port (default: 7878)\n"
+              << "  --bind=ADDR         Address to listen on (default: 0.0.0.0)\n"
+              << "\nRun:\n"
+              << "  --model=PATH        Value network shipped to the workers (JSON or binary)\n"
+              << "  --games=N           Games in the run\n"
+              << "  --seed=N            First seed (default: 1)\n"
+              << "  --unit-games=N      Games per work unit (default: 16)\n"
+              << "  --home=NAME         Home roster (default: human)\n"
+              << "  --away=NAME         Away roster (default: orc)\n"
+              << "  --set=FIELD=VALUE   MCTSConfig field, as bb_sweep names it (repeatable)\n"
+              << "  --concurrent=N      Games a worker plays at once (default: 8)\n"
+              << "  --top-k=N           Logged visit distribution size (default: 20)\n"
+              << "  --full-kickoff      Roll the kickoff table\n"
+              << "\nRetries:\n"
+              << "  --max-attempts=N    Attempts before a unit is given up (default: 3)\n"
+              << "  --lease-ms=MS       Reassign a unit not reported in time (default: 1800000)\n"
+              << "\nOutput:\n"
+              << "  --out=DIR           Output directory (default: cluster_run)\n"
+              << "  --help              Show this help\n";
+}
+
+Options parseArgs(int argc, char* argv[]) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find("--port=") == 0) opts.port = std::stoi(arg.substr(7));
+        else if (arg.find("--bind=") == 0) opts.bind = arg.substr(7);
+        else if (arg.find("--model=") == 0) opts.modelPath = arg.substr(8);
+        else if (arg.find("--games=") == 0) opts.run.games = std::stoi(arg.substr(8));
+        else if (arg.find("--seed=") == 0) opts.run.firstSeed = static_cast<uint32_t>(std::stoul(arg.substr(7)));
+        else if (arg.find("--unit-games=") == 0) opts.run.unitGames = std::stoi(arg.substr(13));
+        else if (arg.find("--home=") == 0) opts.run.spec.home = arg.substr(7);
+        else if (arg.find("--away=") == 0) opts.run.spec.away = arg.substr(7);
+        else if (arg.find("--set=") == 0) {
+            std::string kv = arg.substr(6);
+            size_t eq = kv.find('=');
+            if (eq == std::string::npos) {
+                std::cerr << "Expected --set=FIELD=VALUE: " << arg << "\n";
+                exit(1);
+            }
+            opts.run.spec.search[kv.substr(0, eq)] = std::stod(kv.substr(eq + 1));
+        }
+        else if (arg.find("--concurrent=") == 0) opts.run.spec.concurrentGames = std::stoi(arg.substr(13));
+        else if (arg.find("--top-k=") == 0) opts.run.spec.topK = std::stoi(arg.substr(8));
+        else if (arg == "--full-kickoff") opts.run.spec.useFullKickoff = true;
+        else if (arg.find("--max-attempts=") == 0) opts.run.maxAttempts = std::stoi(arg.substr(15));
+        else if (arg.find("--lease-ms=") == 0) opts.run.leaseMs = std::stoi(arg.substr(11));
+        else if (arg.find("--out=") == 0) opts.outDir = arg.substr(6);
+        else if (arg == "--help") { printUsage(); exit(0); }
+        else { std::cerr << "Unknown option: " << arg << "\n"; printUsage(); exit(1); }
+    }
+    return opts;
+}
+
+std::atomic<int> listenFd{-1};
+
+void closeListener(int) {
+    int fd = listenFd.exchange(-1);
+    if (fd >= 0) {
+        ::shutdown(fd, SHUT_RDWR);
+        ::close(fd);
+    }
+}
+
+int openListener(const Options& opts) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(opts.port));
+    if (::inet_pton(AF_INET, opts.bind.c_str(), &addr.sin_addr) != 1 ||
+        ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 64) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool readFile(const std::string& path, std::vector<uint8_t>& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+std::string unitDir(const std::string& out, uint32_t id) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "unit-%06u", id);
+    return (fs::path(out) / name).string();
+}
+
+// Write completed units as they arrive; the summary is written at the end
+void saveResults(ClusterCoordinator& coordinator, const std::string& out, std::map<uint32_t, json>& summary) {
+    for (auto& [id, result] : coordinator.takeResults()) {
+        std::string dir = unitDir(out, id);
+        fs::remove_all(dir);
+        for (const ClusterFile& f : result.files) {
+            fs::path path = fs::path(dir) / f.name;
+            fs::create_directories(path.parent_path());
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(f.bytes.data()), static_cast<std::streamsize>(f.bytes.size()));
+        }
+        summary[id] = {{"unit", id}, {"home_wins", result.homeWins}, {"away_wins", result.awayWins},
+                       {"draws", result.draws}, {"total_actions", result.totalActions}};
+        std::cout << "unit " << id << " done (" << coordinator.completed() << "/" << coordinator.units()
+                  << ")" << std::endl;
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options opts = parseArgs(argc, argv);
+
+    std::vector<uint8_t> model;
+    if (opts.modelPath.empty() || !readFile(opts.modelPath, model)) {
+        std::cerr << "Cannot read model: " << opts.modelPath << "\n";
+        return 1;
+    }
+    opts.run.spec.modelHash = contentHash(model);
+
+    std::unique_ptr<ClusterCoordinator> coordinator;
+    try {
+        coordinator = std::make_unique<ClusterCoordinator>(opts.run);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    fs::create_directories(opts.outDir);
+
+    int fd = openListener(opts);
+    if (fd < 0) {
+        std::cerr << "Cannot listen on " << opts.bind << ":" << opts.port << ": " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    listenFd = fd;
+    std::signal(SIGINT, closeListener);
+    std::signal(SIGTERM, closeListener);
+    std::signal(SIGPIPE, SIG_IGN);
+    std::cout << "Serving " << coordinator->units() << " unit(s) of model " << opts.run.spec.modelHash
+              << " on " << opts.bind << ":" << opts.port << std::endl;
+
+    std::thread acceptor([&] {
+        for (;;) {
+            int client = ::accept(fd, nullptr, nullptr);
+            if (client < 0) {
+                if (errno == EINTR && listenFd.load() >= 0) continue;
+                break;
+            }
+            std::thread([&coordinator, &model, client] {
+                ClusterChannel channel(client);
+                serveClusterConnection(*coordinator, channel, model);
+                ::close(client);
+            }).detach();
+        }
+    });
+
+    std::map<uint32_t, json> summary;
+    while (listenFd.load() >= 0 && !coordinator->finished()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        coordinator->expireLeases();
+        saveResults(*coordinator, opts.outDir, summary);
+    }
+    saveResults(*coordinator, opts.outDir, summary);
+    // Workers still connected are told "done" on their next request
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    closeListener(0);
+    acceptor.join();
+
+    std::ofstream out(fs::path(opts.outDir) / "summary.jsonl", std::ios::trunc);
+    for (const auto& [id, line] : summary) out << line.dump() << "\n";
+    std::cout << coordinator->completed() << " unit(s) completed, " << coordinator->failed() << " given up"
+              << std::endl;
+    return coordinator->failed() > 0 ? 2 : 0;
+}
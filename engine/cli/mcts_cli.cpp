@@ -1,12 +1,26 @@
+#include "bb/alloc_tracking.h"
+#include "bb/decision_capture.h"
 #include "bb/game_simulator.h"
+#include "bb/macro_mcts.h"
+#include "bb/model_cache.h"
 #include "bb/policies.h"
+#include "bb/policy_network.h"
+#include "bb/root_cache.h"
 #include "bb/roster.h"
 #include "bb/value_function.h"
+#include <sys/resource.h>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdio>
 #include <iostream>
 #include <string>
 #include <cstring>
 #include <chrono>
 #include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
 
 using namespace bb;
 
@@ -17,12 +31,18 @@ struct Options {
     std::string awayAI = "random";
     int games = 100;
     int timeBudgetMs = 1000;
+    bool timeSet = false;
+    int iterations = 0;  // 0 = the MCTSConfig default cap
+    int threads = 1;
     std::string weightsPath;
+    std::string policyPath;
     double explorationC = 1.41;
     uint32_t seed = 42;
     std::string homeRoster = "human";
     std::string awayRoster = "human";
     bool verbose = false;
+    std::string replayPath;   // --replay-decision: replay one captured search instead of playing games
+    bool replayTime = false;  // replay under the captured time budget rather than its iteration count
 };
 
 const TeamRoster& getRoster(const std::string& name) {
@@ -31,14 +51,42 @@ const TeamRoster& getRoster(const std::string& name) {
     return getHumanRoster();  // default
 }
 
+bool searches(const std::string& ai) {
+    return ai == "mcts" || ai == "macro_mcts";
+}
+
+// One game's outcome and how much searching it took
+struct GameStats {
+    GameResult result;
+    int decisions = 0;      // actions chosen by either side
+    int searches = 0;       // of those, the ones that ran a search
+    int64_t iterations = 0;
+    uint64_t searchAllocations = 0;  // heap allocations inside those searches
+    uint64_t searchBytes = 0;
+};
+
+// Peak resident set size of this process, in MB
+double peakRssMB() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0);  // bytes
+#else
+    return usage.ru_maxrss / 1024.0;  // kilobytes
+#endif
+}
+
 void printUsage() {
     std::cout << "Usage: mcts_cli [options]\n"
               << "\nOptions:\n"
-              << "  --home=POLICY     Home AI: random, greedy, mcts (default: random)\n"
-              << "  --away=POLICY     Away AI: random, greedy, mcts (default: random)\n"
+              << "  --home=POLICY     Home AI: random, greedy, mcts, macro_mcts (default: random)\n"
+              << "  --away=POLICY     Away AI: random, greedy, mcts, macro_mcts (default: random)\n"
               << "  --games=N         Number of games (default: 100)\n"
               << "  --time=MS         MCTS time budget in ms (default: 1000)\n"
-              << "  --weights=PATH    Path to weights JSON file\n"
+              << "  --iterations=N    MCTS iteration cap; without --time, the only budget\n"
+              << "  --threads=N       Games played in parallel (default: 1)\n"
+              << "  --weights=PATH    Path to weights file (JSON or binary)\n"
+              << "  --policy=PATH     Policy network for macro_mcts priors (JSON or binary)\n"
               << "  --exploration=C   UCT exploration constant (default: 1.41)\n"
               << "  --seed=N          RNG seed (default: 42)\n"
               << "  --home-roster=R   Home roster: human, orc, skaven, dwarf, wood-elf, chaos,\n"
@@ -48,6 +96,10 @@ void printUsage() {
               << "                    khorne, chaos-pact (default: human)\n"
               << "  --away-roster=R   Same roster options as --home-roster (default: human)\n"
               << "  --verbose         Print per-game results\n"
+              << "\nReplay (reproducers from bb_server --slow-dir):\n"
+              << "  --replay-decision=FILE  Run the captured search again, on the networks it\n"
+              << "                    names unless --weights/--policy are given\n"
+              << "  --replay-time     Use the captured time budget, not its iteration count\n"
               << "  --help            Show this help\n";
 }
 
@@ -58,23 +110,84 @@ Options parseArgs(int argc, char* argv[]) {
         if (arg.find("--home=") == 0) opts.homeAI = arg.substr(7);
         else if (arg.find("--away=") == 0) opts.awayAI = arg.substr(7);
         else if (arg.find("--games=") == 0) opts.games = std::stoi(arg.substr(8));
-        else if (arg.find("--time=") == 0) opts.timeBudgetMs = std::stoi(arg.substr(7));
+        else if (arg.find("--time=") == 0) { opts.timeBudgetMs = std::stoi(arg.substr(7)); opts.timeSet = true; }
+        else if (arg.find("--iterations=") == 0) opts.iterations = std::stoi(arg.substr(13));
+        else if (arg.find("--threads=") == 0) opts.threads = std::stoi(arg.substr(10));
         else if (arg.find("--weights=") == 0) opts.weightsPath = arg.substr(10);
+        else if (arg.find("--policy=") == 0) opts.policyPath = arg.substr(9);
         else if (arg.find("--exploration=") == 0) opts.explorationC = std::stod(arg.substr(14));
         else if (arg.find("--seed=") == 0) opts.seed = static_cast<uint32_t>(std::stoul(arg.substr(7)));
         else if (arg.find("--home-roster=") == 0) opts.homeRoster = arg.substr(14);
         else if (arg.find("--away-roster=") == 0) opts.awayRoster = arg.substr(14);
         else if (arg == "--verbose") opts.verbose = true;
+        else if (arg.find("--replay-decision=") == 0) opts.replayPath = arg.substr(18);
+        else if (arg == "--replay-time") opts.replayTime = true;
         else if (arg == "--help") { printUsage(); exit(0); }
         else { std::cerr << "Unknown option: " << arg << "\n"; printUsage(); exit(1); }
     }
     return opts;
 }
 
+void printStats(const char* label, double ms, const SearchStats& s) {
+    std::printf("%-9s %8.1f ms, %d iterations (select %.1f, replay %.1f, expand %.1f, simulate %.1f, "
+                "backprop %.1f ms), %d nodes, depth %d\n",
+                label, ms, s.iterations, s.selectMs, s.replayMs, s.expandMs, s.simulateMs, s.backpropMs,
+                s.nodesAllocated, s.maxDepth);
+}
+
+int replayMain(const Options& opts) {
+    std::optional<DecisionCapture> capture = loadDecisionCapture(opts.replayPath);
+    if (!capture) {
+        std::cerr << "Cannot read decision capture: " << opts.replayPath << "\n";
+        return 1;
+    }
+    // The captured networks, unless overridden
+    ModelCache models;
+    std::shared_ptr<const ValueFunction> valueFn;
+    std::shared_ptr<const PolicyNetwork> policy;
+    std::string valuePath = opts.weightsPath.empty() ? capture->valuePath : opts.weightsPath;
+    std::string policyPath = opts.policyPath.empty() ? capture->policyPath : opts.policyPath;
+    if (!valuePath.empty()) {
+        auto model = models.get(valuePath);
+        if (!model || !model->value) {
+            std::cerr << "No value network in: " << valuePath << "\n";
+            return 1;
+        }
+        valueFn = model->value;
+    }
+    if (!policyPath.empty()) {
+        auto model = models.get(policyPath);
+        if (!model || !model->policy) {
+            std::cerr << "No policy network in: " << policyPath << "\n";
+            return 1;
+        }
+        policy = model->policy;
+    }
+    if (rootCacheModelKey({valuePath, policyPath}) != capture->modelKey) {
+        std::cout << "Warning: the networks differ from the captured ones; the replay is not the same search\n";
+    }
+    if (capture->config.numThreads > 1 || capture->reusedVisits > 0 || capture->config.ttMemoryMB > 0) {
+        std::cout << "Warning: the captured search was tree-parallel, reused a subtree or kept a transposition "
+                     "table; the replay is a fresh search of the same position\n";
+    }
+
+    std::cout << "Captured: " << capture->reason << "\n";
+    printStats("captured", capture->searchMs, capture->stats);
+    DecisionReplay replay = replayDecision(*capture, valueFn.get(), policy.get(), !opts.replayTime);
+    printStats("replayed", replay.searchMs, replay.stats);
+    std::cout << "Macro: " << macroTypeName(replay.macro.type) << " player " << replay.macro.playerId
+              << (replay.sameMacro ? " (as captured)" : " (captured: ")
+              << (replay.sameMacro ? "" : std::string(macroTypeName(capture->macro.type)) + " player " +
+                                          std::to_string(capture->macro.playerId) + ")")
+              << "\n";
+    return 0;
+}
+
 } // anonymous namespace
 
 int main(int argc, char* argv[]) {
     Options opts = parseArgs(argc, argv);
+    if (!opts.replayPath.empty()) return replayMain(opts);
 
     // Load value function if specified
     std::unique_ptr<ValueFunction> valueFn;
@@ -87,6 +200,16 @@ int main(int argc, char* argv[]) {
         std::cout << "Loaded weights from " << opts.weightsPath << "\n";
     }
 
+    std::unique_ptr<PolicyNetwork> policyNet;
+    if (!opts.policyPath.empty()) {
+        policyNet = loadPolicyNetworkFromFile(opts.policyPath);
+        if (!policyNet) {
+            std::cerr << "Failed to load policy network from: " << opts.policyPath << "\n";
+            return 1;
+        }
+        std::cout << "Loaded policy network from " << opts.policyPath << "\n";
+    }
+
     const TeamRoster& homeRoster = getRoster(opts.homeRoster);
     const TeamRoster& awayRoster = getRoster(opts.awayRoster);
 
@@ -94,50 +217,98 @@ int main(int argc, char* argv[]) {
     mctsConfig.timeBudgetMs = opts.timeBudgetMs;
     mctsConfig.explorationC = opts.explorationC;
     mctsConfig.verbose = opts.verbose;
+    if (opts.iterations > 0) {
+        mctsConfig.maxIterations = opts.iterations;
+        if (!opts.timeSet) mctsConfig.timeBudgetMs = INT_MAX;
+    }
+    // Macro-MCTS reads a non-positive budget as "iterations only"
+    MCTSConfig macroConfig = mctsConfig;
+    if (opts.iterations > 0 && !opts.timeSet) macroConfig.timeBudgetMs = 0;
+    macroConfig.policy = policyNet.get();
 
     std::cout << "Match: " << opts.homeAI << " (" << homeRoster.name << ") vs "
               << opts.awayAI << " (" << awayRoster.name << ")\n";
-    std::cout << "Games: " << opts.games << "\n";
-    if (opts.homeAI == "mcts" || opts.awayAI == "mcts") {
-        std::cout << "MCTS time budget: " << opts.timeBudgetMs << "ms\n";
+    std::cout << "Games: " << opts.games << " on " << opts.threads << " thread(s)\n";
+    if (searches(opts.homeAI) || searches(opts.awayAI)) {
+        if (opts.iterations > 0) std::cout << "MCTS iterations: " << opts.iterations << "\n";
+        if (opts.iterations <= 0 || opts.timeSet) {
+            std::cout << "MCTS time budget: " << opts.timeBudgetMs << "ms\n";
+        }
     }
 
-    int homeWins = 0, awayWins = 0, draws = 0;
-    int totalHomeScore = 0, totalAwayScore = 0;
-
-    auto benchStart = std::chrono::steady_clock::now();
+    // Each game owns its dice and policies; the networks are shared read-only
+    std::vector<GameStats> stats(std::max(opts.games, 0));
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int g = next.fetch_add(1); g < opts.games; g = next.fetch_add(1)) {
+            uint32_t gameSeed = opts.seed + g;
+            DiceRoller dice(gameSeed);
+            GameStats& game = stats[g];
 
-    for (int g = 0; g < opts.games; ++g) {
-        uint32_t gameSeed = opts.seed + g;
-        DiceRoller dice(gameSeed);
-
-        // Create policies
-        // For MCTS, each game gets its own policy instance with unique seed
-        std::unique_ptr<MCTSPolicy> homeMCTS, awayMCTS;
-
-        ActionSelector homePolicy;
-        if (opts.homeAI == "mcts") {
-            homeMCTS = std::make_unique<MCTSPolicy>(valueFn.get(), mctsConfig, gameSeed * 31);
-            homePolicy = [&](const GameState& s) { return (*homeMCTS)(s); };
-        } else if (opts.homeAI == "greedy") {
-            homePolicy = [&dice](const GameState& s) { return greedyPolicy(s, dice); };
-        } else {
-            homePolicy = [&dice](const GameState& s) { return randomPolicy(s, dice); };
-        }
+            // For MCTS, each game gets its own policy instance with unique seed
+            std::unique_ptr<MCTSPolicy> mcts[2];
+            std::unique_ptr<MacroMCTSPolicy> macro[2];
+            auto makePolicy = [&](const std::string& ai, int side, uint32_t seed) -> ActionSelector {
+                if (ai == "macro_mcts") {
+                    macro[side] = std::make_unique<MacroMCTSPolicy>(valueFn.get(), macroConfig, seed);
+                    return [&game, p = macro[side].get()](const GameState& s) {
+                        ++game.decisions;
+                        int before = p->searches();
+                        Action a = (*p)(s);
+                        if (p->searches() != before) {
+                            game.searchAllocations += p->lastSearchStats().allocations;
+                            game.searchBytes += p->lastSearchStats().allocatedBytes;
+                        }
+                        return a;
+                    };
+                }
+                if (ai == "mcts") {
+                    mcts[side] = std::make_unique<MCTSPolicy>(valueFn.get(), mctsConfig, seed);
+                    return [&game, p = mcts[side].get()](const GameState& s) {
+                        Action a = (*p)(s);
+                        ++game.decisions;
+                        ++game.searches;
+                        game.iterations += p->lastIterations();
+                        game.searchAllocations += p->lastSearchStats().allocations;
+                        game.searchBytes += p->lastSearchStats().allocatedBytes;
+                        return a;
+                    };
+                }
+                if (ai == "greedy") {
+                    return [&game, &dice](const GameState& s) { ++game.decisions; return greedyPolicy(s, dice); };
+                }
+                return [&game, &dice](const GameState& s) { ++game.decisions; return randomPolicy(s, dice); };
+            };
+            ActionSelector homePolicy = makePolicy(opts.homeAI, 0, gameSeed * 31);
+            ActionSelector awayPolicy = makePolicy(opts.awayAI, 1, gameSeed * 37);
 
-        ActionSelector awayPolicy;
-        if (opts.awayAI == "mcts") {
-            awayMCTS = std::make_unique<MCTSPolicy>(valueFn.get(), mctsConfig, gameSeed * 37);
-            awayPolicy = [&](const GameState& s) { return (*awayMCTS)(s); };
-        } else if (opts.awayAI == "greedy") {
-            awayPolicy = [&dice](const GameState& s) { return greedyPolicy(s, dice); };
-        } else {
-            awayPolicy = [&dice](const GameState& s) { return randomPolicy(s, dice); };
+            game.result = simulateGame(homeRoster, awayRoster, homePolicy, awayPolicy, dice);
+            for (const auto& p : macro) {
+                if (!p) continue;
+                game.searches += p->searches();
+                game.iterations += p->searchIterations();
+            }
         }
+    };
 
-        GameResult result = simulateGame(homeRoster, awayRoster,
-                                          homePolicy, awayPolicy, dice);
+    AllocCounters allocStart = processAllocCounters();
+    auto benchStart = std::chrono::steady_clock::now();
+    const int workers = std::clamp(opts.threads, 1, std::max(opts.games, 1));
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (int t = 1; t < workers; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+    auto benchEnd = std::chrono::steady_clock::now();
+    double totalSec = std::chrono::duration<double>(benchEnd - benchStart).count();
+    AllocCounters allocs = processAllocCounters().since(allocStart);
 
+    int homeWins = 0, awayWins = 0, draws = 0;
+    int totalHomeScore = 0, totalAwayScore = 0;
+    int64_t decisions = 0, searchCount = 0, iterations = 0;
+    uint64_t searchAllocations = 0, searchBytes = 0;
+    for (int g = 0; g < opts.games; ++g) {
+        const GameResult& result = stats[g].result;
         totalHomeScore += result.homeScore;
         totalAwayScore += result.awayScore;
 
@@ -145,6 +316,12 @@ int main(int argc, char* argv[]) {
         else if (result.awayScore > result.homeScore) awayWins++;
         else draws++;
 
+        decisions += stats[g].decisions;
+        searchCount += stats[g].searches;
+        iterations += stats[g].iterations;
+        searchAllocations += stats[g].searchAllocations;
+        searchBytes += stats[g].searchBytes;
+
         if (opts.verbose) {
             std::cout << "Game " << (g + 1) << ": "
                       << result.homeScore << "-" << result.awayScore
@@ -152,9 +329,6 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    auto benchEnd = std::chrono::steady_clock::now();
-    double totalSec = std::chrono::duration<double>(benchEnd - benchStart).count();
-
     std::cout << "\n=== Results ===\n";
     std::cout << "Home wins: " << homeWins << " (" << (100.0 * homeWins / opts.games) << "%)\n";
     std::cout << "Away wins: " << awayWins << " (" << (100.0 * awayWins / opts.games) << "%)\n";
@@ -164,5 +338,27 @@ int main(int argc, char* argv[]) {
     std::cout << "Time:      " << totalSec << "s ("
               << (opts.games / totalSec) << " games/sec)\n";
 
+    std::cout << "\n=== Throughput ===\n";
+    std::cout << "Decisions: " << decisions << " (" << (decisions / totalSec) << "/sec)\n";
+    if (searchCount > 0) {
+        std::cout << "Searches:  " << searchCount << " (avg "
+                  << (1.0 * iterations / searchCount) << " iterations)\n";
+        std::cout << "Iterations/sec: " << (iterations / totalSec) << "\n";
+    }
+    std::cout << "Peak RSS:  " << peakRssMB() << " MB\n";
+
+    if (allocTrackingEnabled()) {
+        std::cout << "\n=== Allocations ===\n";
+        if (decisions > 0) {
+            std::cout << "Per decision: " << (1.0 * allocs.allocations / decisions) << " ("
+                      << (1.0 * allocs.bytes / decisions) << " bytes)\n";
+        }
+        if (searchCount > 0) {
+            std::cout << "Per search:   " << (1.0 * searchAllocations / searchCount) << " ("
+                      << (1.0 * searchBytes / searchCount) << " bytes)\n";
+        }
+        std::cout << allocReport();
+    }
+
     return 0;
 }
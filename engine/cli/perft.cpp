@@ -0,0 +1,284 @@
+#include "bb/game_simulator.h"
+#include "bb/policies.h"
+#include "bb/roster.h"
+#include "bb/rules_engine.h"
+#include "bb/state_io.h"
+#include "bb/undo_journal.h"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace bb;
+
+// Perft for the rules engine: enumerate every action sequence to a fixed
+// depth from one position and count what was executed. Each action is
+// resolved with dice seeded from (--seed, position hash, action), or with a
+// fresh copy of the scripted --dice list, so the counts and the leaf hash
+// depend only on the position and the rules -- not on generation order or
+// on search heuristics. Any change in them after a refactor of move
+// generation, occupancy or make/unmake is a behaviour change.
+
+namespace {
+
+constexpr int ACTION_TYPES = static_cast<int>(ActionType::MOVE_PATH) + 1;
+const char* const ACTION_NAMES[ACTION_TYPES] = {
+    "MOVE", "BLOCK", "BLITZ", "PASS", "HAND_OFF", "FOUL", "THROW_TEAM_MATE",
+    "BOMB_THROW", "HYPNOTIC_GAZE", "BALL_AND_CHAIN", "MULTIPLE_BLOCK",
+    "END_TURN", "SETUP_PLAYER", "END_SETUP", "MOVE_PATH",
+};
+
+struct Options {
+    std::string positionPath;
+    std::string savePath;
+    std::string homeRoster = "human";
+    std::string awayRoster = "orc";
+    uint32_t genSeed = 1;
+    int plies = 40;
+    int depth = 2;
+    uint64_t seed = 42;
+    std::vector<int> dice;  // scripted rolls (empty = seeded)
+    bool paths = false;
+    bool divide = false;
+};
+
+void printUsage() {
+    std::cout << "Usage: bb_perft [options]\n"
+              << "\nPosition (one of):\n"
+              << "  --position=FILE     Load a JSON or binary position (bb/state_io.h)\n"
+              << "  --home-roster=R     Otherwise play a seeded greedy game between these\n"
+              << "  --away-roster=R     rosters (default: human v orc) ...\n"
+              << "  --gen-seed=N        ... with this dice seed (default: 1) ...\n"
+              << "  --plies=N           ... and take the Nth PLAY decision (default: 40)\n"
+              << "  --save=FILE         Write the position used as JSON\n"
+              << "\nEnumeration:\n"
+              << "  --depth=N           Actions deep (default: 2)\n"
+              << "  --seed=N            Dice seed (default: 42)\n"
+              << "  --dice=A,B,...      Scripted rolls instead: every action gets a fresh\n"
+              << "                      roller over this list, repeated as needed\n"
+              << "  --paths             Generate MOVE_PATH moves instead of single steps\n"
+              << "  --divide            Also print the node count under each root action\n"
+              << "  --help              Show this help\n";
+}
+
+std::vector<int> parseDice(const std::string& list) {
+    std::vector<int> out;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) out.push_back(std::stoi(item));
+    return out;
+}
+
+Options parseArgs(int argc, char* argv[]) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find("--position=") == 0) opts.positionPath = arg.substr(11);
+        else if (arg.find("--save=") == 0) opts.savePath = arg.substr(7);
+        else if (arg.find("--home-roster=") == 0) opts.homeRoster = arg.substr(14);
+        else if (arg.find("--away-roster=") == 0) opts.awayRoster = arg.substr(14);
+        else if (arg.find("--gen-seed=") == 0) opts.genSeed = static_cast<uint32_t>(std::stoul(arg.substr(11)));
+        else if (arg.find("--plies=") == 0) opts.plies = std::stoi(arg.substr(8));
+        else if (arg.find("--depth=") == 0) opts.depth = std::stoi(arg.substr(8));
+        else if (arg.find("--seed=") == 0) opts.seed = std::stoull(arg.substr(7));
+        else if (arg.find("--dice=") == 0) opts.dice = parseDice(arg.substr(7));
+        else if (arg == "--paths") opts.paths = true;
+        else if (arg == "--divide") opts.divide = true;
+        else if (arg == "--help") { printUsage(); exit(0); }
+        else { std::cerr << "Unknown option: " << arg << "\n"; printUsage(); exit(1); }
+    }
+    return opts;
+}
+
+// The position --plies greedy decisions into a seeded game, or the last
+// PLAY position if the game ends first.
+std::optional<GameState> generatePosition(const Options& opts) {
+    const TeamRoster* home = getRosterByName(opts.homeRoster);
+    const TeamRoster* away = getRosterByName(opts.awayRoster);
+    if (!home || !away) return std::nullopt;
+
+    std::optional<GameState> out;
+    DiceRoller dice(opts.genSeed);
+    int decisions = 0;
+    ActionSelector greedy = [&](const GameState& s) {
+        if (s.phase == GamePhase::PLAY && decisions++ <= opts.plies) out = s.clone();
+        return greedyPolicy(s, dice);
+    };
+    simulateGame(*home, *away, greedy, greedy, dice);
+    return out;
+}
+
+uint64_t actionKey(const Action& a) {
+    return static_cast<uint64_t>(a.type)
+         | static_cast<uint64_t>(static_cast<uint8_t>(a.playerId)) << 8
+         | static_cast<uint64_t>(static_cast<uint8_t>(a.targetId)) << 16
+         | static_cast<uint64_t>(static_cast<uint8_t>(a.target.x)) << 24
+         | static_cast<uint64_t>(static_cast<uint8_t>(a.target.y)) << 32;
+}
+
+// splitmix64 finalizer: leaf hashes are summed, so mix them first
+uint64_t mix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+bool isTerminal(const GameState& s) {
+    return s.phase == GamePhase::GAME_OVER || s.phase == GamePhase::TOUCHDOWN ||
+           s.phase == GamePhase::HALF_TIME;
+}
+
+struct PerftCounts {
+    std::vector<uint64_t> nodesAtDepth;  // [ply], ply 1 = root's children
+    std::array<uint64_t, ACTION_TYPES> byType{};
+    uint64_t turnovers = 0;
+    uint64_t terminal = 0;   // positions reached early with no play left (not expanded)
+    uint64_t leafHash = 0;   // sum of mixed GameState::hash() over depth-N leaves
+};
+
+class Perft {
+    const Options& opts_;
+    UndoJournal journal_;
+    std::vector<std::vector<Action>> actions_;  // per ply, reused
+    std::vector<int> scripted_;                 // opts_.dice repeated
+
+public:
+    PerftCounts counts;
+
+    explicit Perft(const Options& opts) : opts_(opts), actions_(opts.depth) {
+        counts.nodesAtDepth.assign(opts.depth + 1, 0);
+        if (!opts.dice.empty()) {
+            while (scripted_.size() < 1024) {
+                scripted_.insert(scripted_.end(), opts.dice.begin(), opts.dice.end());
+            }
+        }
+    }
+
+    void generate(const GameState& s, std::vector<Action>& out) const {
+        if (opts_.paths) getAvailableActionsWithPaths(s, out);
+        else getAvailableActions(s, out);
+    }
+
+    ActionResult execute(GameState& s, const Action& a) {
+        if (!scripted_.empty()) {
+            FixedDiceRoller dice(scripted_);
+            return executeActionJournaled(s, a, dice, journal_);
+        }
+        FastDiceRoller dice(opts_.seed, s.hash(), actionKey(a));
+        return executeActionJournaled(s, a, dice, journal_);
+    }
+
+    // Depth-N leaves under `s`, which is `ply` actions below the root
+    uint64_t run(GameState& s, int ply) {
+        if (ply == opts_.depth) {
+            counts.leafHash += mix(s.hash());
+            return 1;
+        }
+        if (isTerminal(s)) {
+            counts.terminal++;
+            return 0;
+        }
+        std::vector<Action>& actions = actions_[ply];
+        generate(s, actions);
+        uint64_t leaves = 0;
+        for (size_t i = 0; i < actions.size(); ++i) {
+            const Action& a = actions[i];
+            size_t mark = journal_.mark();
+            ActionResult r = execute(s, a);
+            counts.nodesAtDepth[ply + 1]++;
+            counts.byType[static_cast<int>(a.type)]++;
+            if (r.turnover) counts.turnovers++;
+            leaves += run(s, ply + 1);
+            journal_.undoTo(s, mark);
+        }
+        return leaves;
+    }
+
+    // --divide: leaves under each root action
+    void divide(GameState& s) {
+        std::vector<Action> roots;
+        generate(s, roots);
+        for (const Action& a : roots) {
+            size_t mark = journal_.mark();
+            PerftCounts saved = counts;
+            execute(s, a);
+            uint64_t leaves = opts_.depth > 1 ? run(s, 1) : 1;
+            journal_.undoTo(s, mark);
+            counts = saved;
+            std::printf("  %-15s player=%-2d target=%-2d (%2d,%2d)  %llu\n",
+                        ACTION_NAMES[static_cast<int>(a.type)], a.playerId, a.targetId,
+                        a.target.x, a.target.y, static_cast<unsigned long long>(leaves));
+        }
+    }
+};
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options opts = parseArgs(argc, argv);
+    if (opts.depth < 1) {
+        std::cerr << "--depth must be at least 1\n";
+        return 1;
+    }
+
+    std::optional<GameState> position;
+    if (!opts.positionPath.empty()) {
+        position = loadState(opts.positionPath);
+        if (!position) {
+            std::cerr << "Failed to load position from: " << opts.positionPath << "\n";
+            return 1;
+        }
+    } else {
+        position = generatePosition(opts);
+        if (!position) {
+            std::cerr << "No PLAY position for rosters " << opts.homeRoster << " v "
+                      << opts.awayRoster << "\n";
+            return 1;
+        }
+    }
+    if (!opts.savePath.empty() && !saveState(*position, opts.savePath)) {
+        std::cerr << "Failed to write position to: " << opts.savePath << "\n";
+        return 1;
+    }
+
+    GameState state = position->clone();
+    std::printf("position hash %016llx, depth %d, %s\n",
+                static_cast<unsigned long long>(state.hash()), opts.depth,
+                opts.dice.empty() ? ("seed " + std::to_string(opts.seed)).c_str() : "scripted dice");
+
+    Perft perft(opts);
+    if (opts.divide) perft.divide(state);
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t leaves;
+    try {
+        leaves = perft.run(state, 0);
+    } catch (const std::out_of_range& e) {
+        std::cerr << "Scripted dice ran out: " << e.what() << "\n";
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const PerftCounts& c = perft.counts;
+    uint64_t nodes = 0;
+    for (int d = 1; d <= opts.depth; ++d) {
+        std::printf("depth %d: %llu\n", d, static_cast<unsigned long long>(c.nodesAtDepth[d]));
+        nodes += c.nodesAtDepth[d];
+    }
+    std::printf("by type:\n");
+    for (int t = 0; t < ACTION_TYPES; ++t) {
+        if (c.byType[t] == 0) continue;
+        std::printf("  %-15s %llu\n", ACTION_NAMES[t], static_cast<unsigned long long>(c.byType[t]));
+    }
+    std::printf("leaves %llu, turnovers %llu, terminal %llu, leaf hash %016llx\n",
+                static_cast<unsigned long long>(leaves), static_cast<unsigned long long>(c.turnovers),
+                static_cast<unsigned long long>(c.terminal), static_cast<unsigned long long>(c.leafHash));
+    std::printf("%llu nodes in %.3f s (%.0f nodes/s)\n", static_cast<unsigned long long>(nodes),
+                seconds, seconds > 0.0 ? nodes / seconds : 0.0);
+    return 0;
+}
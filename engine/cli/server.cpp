@@ -0,0 +1,427 @@
+#include "bb/model_cache.h"
+#include "bb/move_server.h"
+#include "bb/root_cache.h"
+#include <nlohmann/json.hpp>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace bb;
+
+// Long-running move server for the web app: networks are loaded once and
+// searches run on a bounded worker pool. Clients connect to a Unix socket
+// (or 127.0.0.1:PORT) and exchange one JSON object per line; replies carry
+// the request's id and may arrive out of order. See move_server.h for the
+// message format.
+
+namespace {
+
+struct Options {
+    std::string socketPath = "/tmp/bb_server.sock";
+    int port = 0;  // > 0: listen on 127.0.0.1:port instead of the Unix socket
+    int metricsPort = 0;  // > 0: serve GET /metrics on 127.0.0.1:metricsPort
+    std::string weightsPath;
+    std::string policyPath;  // default: the policy in --weights, if any
+    int reloadMs = 0;        // > 0: watch --weights and swap in new versions
+    int workers = 2;
+    int queue = 32;
+    int timeBudgetMs = 1000;
+    int maxTimeBudgetMs = 30000;
+    int iterations = 100000;
+    double explorationC = 1.41;
+    float vfBlend = 0.0f;
+    float policyBlend = 0.0f;
+    int maxTreeNodes = 0;
+    std::string rootCachePath;
+    int rootCacheMb = 256;
+    SlowDecisionConfig slow;
+    bool verbose = false;
+};
+
+void printUsage() {
+    std::cout << "Usage: bb_server [options]\n"
+              << "\nListening:\n"
+              << "  --socket=PATH       Unix socket path (default: /tmp/bb_server.sock)\n"
+              << "  --port=N            Listen on 127.0.0.1:N instead\n"
+              << "  --metrics-port=N    Serve Prometheus metrics at http://127.0.0.1:N/metrics\n"
+              << "                      (also the protocol's {\"op\":\"metrics\"})\n"
+              << "\nModels:\n"
+              << "  --weights=PATH      Value network (JSON or binary)\n"
+              << "  --policy=PATH       Policy network (default: the one in --weights)\n"
+              << "  --reload-ms=N       Check --weights every N ms and move new searches to a\n"
+              << "                      changed file without a restart (default: 0, off)\n"
+              << "\nSearch:\n"
+              << "  --workers=N         Concurrent searches (default: 2)\n"
+              << "  --queue=N           Waiting requests before new ones are refused (default: 32)\n"
+              << "  --time=MS           Default time budget per request (default: 1000)\n"
+              << "  --max-time=MS       Cap on a request's time_ms (default: 30000)\n"
+              << "  --iterations=N      Default iteration cap (default: 100000)\n"
+              << "  --exploration=C     PUCT exploration constant (default: 1.41)\n"
+              << "  --vf-blend=F        Value network share of leaf evaluations (default: 0)\n"
+              << "  --policy-blend=F    Policy network share of priors (default: 0)\n"
+              << "  --max-nodes=N       Node budget per search tree: bounds each request's memory\n"
+              << "                      (default: 0, unbounded)\n"
+              << "  --root-cache=PATH   Keep finished searches' root results in PATH, shared\n"
+              << "                      across restarts and processes\n"
+              << "  --root-cache-mb=N   Size of a new --root-cache file (default: 256)\n"
+              << "\nSlow decisions (replay with mcts_cli --replay-decision=FILE):\n"
+              << "  --slow-dir=DIR      Write a reproducer for each slow search to DIR\n"
+              << "  --slow-ms=MS        Slow: a search longer than MS\n"
+              << "  --slow-outlier=F    Slow: time per iteration over F times the running mean\n"
+              << "  --slow-max=N        Reproducers written at most (default: 100)\n"
+              << "  --verbose           Log each request\n"
+              << "  --help              Show this help\n";
+}
+
+Options parseArgs(int argc, char* argv[]) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find("--socket=") == 0) opts.socketPath = arg.substr(9);
+        else if (arg.find("--port=") == 0) opts.port = std::stoi(arg.substr(7));
+        else if (arg.find("--metrics-port=") == 0) opts.metricsPort = std::stoi(arg.substr(15));
+        else if (arg.find("--weights=") == 0) opts.weightsPath = arg.substr(10);
+        else if (arg.find("--policy=") == 0) opts.policyPath = arg.substr(9);
+        else if (arg.find("--reload-ms=") == 0) opts.reloadMs = std::stoi(arg.substr(12));
+        else if (arg.find("--workers=") == 0) opts.workers = std::stoi(arg.substr(10));
+        else if (arg.find("--queue=") == 0) opts.queue = std::stoi(arg.substr(8));
+        else if (arg.find("--time=") == 0) opts.timeBudgetMs = std::stoi(arg.substr(7));
+        else if (arg.find("--max-time=") == 0) opts.maxTimeBudgetMs = std::stoi(arg.substr(11));
+        else if (arg.find("--iterations=") == 0) opts.iterations = std::stoi(arg.substr(13));
+        else if (arg.find("--exploration=") == 0) opts.explorationC = std::stod(arg.substr(14));
+        else if (arg.find("--vf-blend=") == 0) opts.vfBlend = std::stof(arg.substr(11));
+        else if (arg.find("--policy-blend=") == 0) opts.policyBlend = std::stof(arg.substr(15));
+        else if (arg.find("--max-nodes=") == 0) opts.maxTreeNodes = std::stoi(arg.substr(12));
+        else if (arg.find("--root-cache=") == 0) opts.rootCachePath = arg.substr(13);
+        else if (arg.find("--root-cache-mb=") == 0) opts.rootCacheMb = std::stoi(arg.substr(16));
+        else if (arg.find("--slow-dir=") == 0) opts.slow.dir = arg.substr(11);
+        else if (arg.find("--slow-ms=") == 0) opts.slow.thresholdMs = std::stod(arg.substr(10));
+        else if (arg.find("--slow-outlier=") == 0) opts.slow.outlierFactor = std::stod(arg.substr(15));
+        else if (arg.find("--slow-max=") == 0) opts.slow.maxCaptures = std::stoi(arg.substr(11));
+        else if (arg == "--verbose") opts.verbose = true;
+        else if (arg == "--help") { printUsage(); exit(0); }
+        else { std::cerr << "Unknown option: " << arg << "\n"; printUsage(); exit(1); }
+    }
+    return opts;
+}
+
+std::atomic<int> listenFd{-1};
+std::atomic<int> metricsFd{-1};
+
+void onSignal(int) {
+    for (std::atomic<int>* listener : {&listenFd, &metricsFd}) {
+        int fd = listener->exchange(-1);
+        if (fd >= 0) {
+            ::shutdown(fd, SHUT_RDWR);
+            ::close(fd);
+        }
+    }
+}
+
+// One client connection. Replies are written from worker threads, so
+// writes are serialized; tickets still in flight when the client goes away
+// are cancelled.
+class Connection : public std::enable_shared_from_this<Connection> {
+public:
+    Connection(int fd, MoveServer& server, bool verbose) : fd_(fd), server_(server), verbose_(verbose) {}
+    ~Connection() { ::close(fd_); }
+
+    void serve() {
+        std::string buffer;
+        char chunk[65536];
+        for (;;) {
+            ssize_t n = ::read(fd_, chunk, sizeof(chunk));
+            if (n <= 0) break;
+            buffer.append(chunk, static_cast<size_t>(n));
+            size_t start = 0, end;
+            while ((end = buffer.find('\n', start)) != std::string::npos) {
+                handle(buffer.substr(start, end - start));
+                start = end + 1;
+            }
+            buffer.erase(0, start);
+        }
+        std::map<std::string, uint64_t> pending;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+            pending.swap(pending_);
+        }
+        for (const auto& [tag, ticket] : pending) server_.cancel(ticket);
+    }
+
+private:
+    void handle(const std::string& line) {
+        if (line.empty() || line == "\r") return;
+        ServerMessage msg = parseServerMessage(line);
+        switch (msg.op) {
+            case ServerOp::MOVE: {
+                std::string tag = msg.request.tag;
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (pending_.count(tag)) {
+                    write(serverErrorJson(tag, "id already in flight"));
+                    return;
+                }
+                auto self = shared_from_this();
+                uint64_t ticket = server_.submit(std::move(msg.request), [self](const MoveReply& reply) {
+                    self->finish(reply);
+                });
+                if (ticket == 0) write(serverErrorJson(tag, "busy"));
+                else pending_[tag] = ticket;
+                return;
+            }
+            case ServerOp::CANCEL: {
+                uint64_t ticket = 0;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto it = pending_.find(msg.request.tag);
+                    if (it != pending_.end()) ticket = it->second;
+                }
+                // The cancelled request answers for itself
+                if (ticket == 0 || !server_.cancel(ticket)) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    write(serverErrorJson(msg.request.tag, "no such request"));
+                }
+                return;
+            }
+            case ServerOp::METRICS: {
+                nlohmann::json reply = {{"status", "ok"}, {"metrics", server_.metricsText()}};
+                std::lock_guard<std::mutex> lock(mutex_);
+                write(reply.dump());
+                return;
+            }
+            case ServerOp::STATS: {
+                std::lock_guard<std::mutex> lock(mutex_);
+                write("{\"status\":\"ok\",\"queued\":" + std::to_string(server_.queued()) +
+                      ",\"running\":" + std::to_string(server_.running()) +
+                      ",\"workers\":" + std::to_string(server_.config().workers) + "}");
+                return;
+            }
+            default: {
+                std::lock_guard<std::mutex> lock(mutex_);
+                write(serverErrorJson(msg.request.tag, msg.error));
+                return;
+            }
+        }
+    }
+
+    void finish(const MoveReply& reply) {
+        if (verbose_) {
+            std::cerr << "id " << reply.tag << ": " << moveStatusName(reply.status) << ", "
+                      << reply.iterations << " iterations, " << reply.queueMs << " ms queued, "
+                      << reply.searchMs << " ms searching\n";
+        }
+        if (!reply.capture.empty()) std::cerr << "id " << reply.tag << ": slow, written to " << reply.capture << "\n";
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.erase(reply.tag);
+        if (!closed_) write(moveReplyToJson(reply));
+    }
+
+    // Under mutex_
+    void write(std::string line) {
+        line += '\n';
+        size_t sent = 0;
+        while (sent < line.size()) {
+            ssize_t n = ::send(fd_, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return;
+            sent += static_cast<size_t>(n);
+        }
+    }
+
+    int fd_;
+    MoveServer& server_;
+    bool verbose_;
+    std::mutex mutex_;
+    std::map<std::string, uint64_t> pending_;  // tag -> ticket
+    bool closed_ = false;
+};
+
+// Bound to 127.0.0.1:port, not yet listening; -1 on failure.
+int bindLoopback(int port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int openListener(const Options& opts) {
+    int fd;
+    if (opts.port > 0) {
+        fd = bindLoopback(opts.port);
+        if (fd < 0) return -1;
+    } else {
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (opts.socketPath.size() >= sizeof(addr.sun_path)) {
+            ::close(fd);
+            return -1;
+        }
+        std::strcpy(addr.sun_path, opts.socketPath.c_str());
+        ::unlink(opts.socketPath.c_str());
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(fd);
+            return -1;
+        }
+    }
+    if (::listen(fd, 64) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Just enough HTTP for a Prometheus scrape: one request per connection,
+// GET /metrics answered, anything else 404.
+void serveMetrics(int fd, MoveServer& server) {
+    for (;;) {
+        int client = ::accept(fd, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR && metricsFd.load() >= 0) continue;
+            return;
+        }
+        std::string request;
+        char chunk[4096];
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < 65536) {
+            ssize_t n = ::read(client, chunk, sizeof(chunk));
+            if (n <= 0) break;
+            request.append(chunk, static_cast<size_t>(n));
+        }
+        bool found = request.rfind("GET /metrics ", 0) == 0 || request.rfind("GET /metrics?", 0) == 0;
+        std::string body = found ? server.metricsText() : "not found\n";
+        std::string response = std::string(found ? "HTTP/1.0 200 OK\r\n" : "HTTP/1.0 404 Not Found\r\n") +
+                               "Content-Type: text/plain; version=0.0.4\r\n" +
+                               "Content-Length: " + std::to_string(body.size()) + "\r\n" +
+                               "Connection: close\r\n\r\n" + body;
+        size_t sent = 0;
+        while (sent < response.size()) {
+            ssize_t n = ::send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) break;
+            sent += static_cast<size_t>(n);
+        }
+        ::close(client);
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options opts = parseArgs(argc, argv);
+
+    MoveServerConfig config;
+    config.workers = opts.workers;
+    config.queueCapacity = opts.queue;
+    config.maxTimeBudgetMs = opts.maxTimeBudgetMs;
+    config.search.timeBudgetMs = opts.timeBudgetMs;
+    config.search.maxIterations = opts.iterations;
+    config.search.explorationC = opts.explorationC;
+    config.search.vfBlend = opts.vfBlend;
+    config.search.policyBlend = opts.policyBlend;
+    config.search.maxTreeNodes = opts.maxTreeNodes;
+    config.slowDecisions = opts.slow;
+
+    ModelCache models;
+    if (!opts.weightsPath.empty()) {
+        config.model = models.get(opts.weightsPath);
+        if (!config.model || !config.model->value) {
+            std::cerr << "No value network in: " << opts.weightsPath << "\n";
+            return 1;
+        }
+        if (opts.reloadMs > 0) {
+            config.liveModel = std::make_shared<ModelHandle>(opts.weightsPath, models);
+            config.liveModel->watch(opts.reloadMs);
+        }
+    }
+    std::shared_ptr<LoadedModel> policyModel;
+    if (!opts.policyPath.empty()) {
+        policyModel = models.get(opts.policyPath);
+        if (!policyModel || !policyModel->policy) {
+            std::cerr << "No policy network in: " << opts.policyPath << "\n";
+            return 1;
+        }
+        config.search.policy = policyModel->policy.get();
+        config.policyPath = opts.policyPath;
+    }
+
+    std::unique_ptr<RootCache> rootCache;
+    if (!opts.rootCachePath.empty()) {
+        rootCache = RootCache::open(opts.rootCachePath, static_cast<size_t>(opts.rootCacheMb) << 20);
+        if (!rootCache) {
+            std::cerr << "Cannot open root cache: " << opts.rootCachePath << "\n";
+            return 1;
+        }
+        config.search.rootCache = rootCache.get();
+        config.search.rootCacheModel = rootCacheModelKey({opts.weightsPath, opts.policyPath});
+    }
+
+    std::unique_ptr<MoveServer> server;
+    try {
+        server = std::make_unique<MoveServer>(config);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    int fd = openListener(opts);
+    if (fd < 0) {
+        std::cerr << "Cannot listen on "
+                  << (opts.port > 0 ? "127.0.0.1:" + std::to_string(opts.port) : opts.socketPath)
+                  << ": " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    listenFd = fd;
+    std::thread metricsThread;
+    if (opts.metricsPort > 0) {
+        int mfd = bindLoopback(opts.metricsPort);
+        if (mfd < 0 || ::listen(mfd, 16) != 0) {
+            std::cerr << "Cannot serve metrics on 127.0.0.1:" << opts.metricsPort << ": " << std::strerror(errno) << "\n";
+            return 1;
+        }
+        metricsFd = mfd;
+        metricsThread = std::thread([mfd, &server] { serveMetrics(mfd, *server); });
+    }
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+    std::cout << "Listening on "
+              << (opts.port > 0 ? "127.0.0.1:" + std::to_string(opts.port) : opts.socketPath)
+              << " with " << opts.workers << " worker(s)" << std::endl;
+
+    for (;;) {
+        int client = ::accept(fd, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR && listenFd.load() >= 0) continue;
+            break;  // closed by a signal
+        }
+        auto connection = std::make_shared<Connection>(client, *server, opts.verbose);
+        std::thread([connection] { connection->serve(); }).detach();
+    }
+
+    onSignal(0);  // the metrics listener too, however the loop ended
+    if (metricsThread.joinable()) metricsThread.join();
+    server->shutdown();
+    if (opts.port <= 0) ::unlink(opts.socketPath.c_str());
+    std::cout << "Stopped" << std::endl;
+    return 0;
+}
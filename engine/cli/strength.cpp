@@ -0,0 +1,238 @@
+#include "bb/model_cache.h"
+#include "bb/roster.h"
+#include "bb/strength_bench.h"
+#include "bb/sweep.h"
+#include "bb/thread_placement.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace bb;
+
+// Strength per compute: one MCTSConfig at a list of iteration or time
+// budgets, each scored on a fixed position suite (accuracy against known
+// good macros) and on paired matches against a fixed opponent. Prints one
+// row per budget with the compute it spent.
+
+namespace {
+
+struct Options {
+    std::string weightsPath;
+    std::string policyPath;  // default: the policy in --weights, if any
+    std::vector<std::pair<std::string, double>> base;
+    std::vector<std::pair<std::string, double>> opponent;
+    std::vector<int> iterations;
+    std::vector<int> timesMs;
+    std::string suitePath;
+    std::string writeSuitePath;
+    int positionSeeds = 4;
+    int pairs = 4;
+    uint32_t seed = 1;
+    int threads = 1;
+    std::vector<std::string> rosters = {"human", "orc"};
+    int tv = 1000;
+    std::string csvPath;
+};
+
+void printUsage() {
+    std::cout << "Usage: bb_strength [--iterations=N,...] [--time-ms=MS,...] [options]\n"
+              << "\nBudgets (one row each; default: --iterations=50,200,800):\n"
+              << "  --iterations=N,...    maxIterations budgets, no time limit\n"
+              << "  --time-ms=MS,...      timeBudgetMs budgets, no iteration limit\n"
+              << "\nSearch:\n"
+              << "  --set=FIELD=V         Set an MCTSConfig field of the measured search\n"
+              << "  --vs=FIELD=V          Set a field of the opponent (default: 100 iterations)\n"
+              << "  --weights=FILE        Value network (JSON or binary)\n"
+              << "  --policy=FILE         Policy network (default: the one in --weights)\n"
+              << "\nPositions:\n"
+              << "  --suite=FILE          Position suite JSON (default: the built-in suite)\n"
+              << "  --write-suite=FILE    Write the built-in suite as JSON and exit\n"
+              << "  --position-seeds=N    Searches per position (default: 4)\n"
+              << "\nMatches:\n"
+              << "  --pairs=N             Seed pairs per budget, each side at home once (default: 4)\n"
+              << "  --seed=N              First seed (default: 1)\n"
+              << "  --rosters=A,B,...     Rosters, rotated per pair (default: human,orc)\n"
+              << "  --tv=N                Developed rosters for this team value (default: 1000)\n"
+              << "\nRun:\n"
+              << "  --threads=N           Searches and games in parallel (default: 1; wall and\n"
+              << "                        time budgets are cleanest at 1)\n"
+              << "  --affinity=MODE       Pin threads: none, compact or spread over NUMA nodes\n"
+              << "  --csv=FILE            Also write the table as CSV\n"
+              << "  --help                Show this help\n";
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> out;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) out.push_back(item);
+    return out;
+}
+
+std::vector<int> parseInts(const std::string& list) {
+    std::vector<int> out;
+    for (const std::string& v : splitList(list)) out.push_back(std::stoi(v));
+    return out;
+}
+
+std::pair<std::string, double> parseField(const std::string& spec) {
+    size_t eq = spec.find('=');
+    if (eq == std::string::npos) throw std::invalid_argument("expected FIELD=VALUE: " + spec);
+    return {spec.substr(0, eq), std::stod(spec.substr(eq + 1))};
+}
+
+Options parseArgs(int argc, char* argv[]) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find("--iterations=") == 0) opts.iterations = parseInts(arg.substr(13));
+        else if (arg.find("--time-ms=") == 0) opts.timesMs = parseInts(arg.substr(10));
+        else if (arg.find("--set=") == 0) opts.base.push_back(parseField(arg.substr(6)));
+        else if (arg.find("--vs=") == 0) opts.opponent.push_back(parseField(arg.substr(5)));
+        else if (arg.find("--weights=") == 0) opts.weightsPath = arg.substr(10);
+        else if (arg.find("--policy=") == 0) opts.policyPath = arg.substr(9);
+        else if (arg.find("--suite=") == 0) opts.suitePath = arg.substr(8);
+        else if (arg.find("--write-suite=") == 0) opts.writeSuitePath = arg.substr(14);
+        else if (arg.find("--position-seeds=") == 0) opts.positionSeeds = std::stoi(arg.substr(17));
+        else if (arg.find("--pairs=") == 0) opts.pairs = std::stoi(arg.substr(8));
+        else if (arg.find("--seed=") == 0) opts.seed = static_cast<uint32_t>(std::stoul(arg.substr(7)));
+        else if (arg.find("--threads=") == 0) opts.threads = std::stoi(arg.substr(10));
+        else if (arg.find("--affinity=") == 0) {
+            AffinityMode mode;
+            if (!parseAffinityMode(arg.substr(11), mode)) {
+                std::cerr << "Expected --affinity=none|compact|spread: " << arg << "\n";
+                exit(1);
+            }
+            setThreadAffinity(mode);
+        }
+        else if (arg.find("--rosters=") == 0) opts.rosters = splitList(arg.substr(10));
+        else if (arg.find("--tv=") == 0) opts.tv = std::stoi(arg.substr(5));
+        else if (arg.find("--csv=") == 0) opts.csvPath = arg.substr(6);
+        else if (arg == "--help") { printUsage(); exit(0); }
+        else { std::cerr << "Unknown option: " << arg << "\n"; printUsage(); exit(1); }
+    }
+    if (opts.iterations.empty() && opts.timesMs.empty()) opts.iterations = {50, 200, 800};
+    return opts;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options opts;
+    try {
+        opts = parseArgs(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Bad option: " << e.what() << "\n";
+        return 1;
+    }
+    if (!opts.writeSuitePath.empty()) {
+        if (!savePositionSuite(referencePositions(), opts.writeSuitePath)) {
+            std::cerr << "Cannot write " << opts.writeSuitePath << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    ModelCache models;
+    std::shared_ptr<LoadedModel> model, policyModel;
+    if (!opts.weightsPath.empty()) {
+        model = models.get(opts.weightsPath);
+        if (!model || !model->value) {
+            std::cerr << "No value network in: " << opts.weightsPath << "\n";
+            return 1;
+        }
+    }
+    if (!opts.policyPath.empty()) {
+        policyModel = models.get(opts.policyPath);
+        if (!policyModel || !policyModel->policy) {
+            std::cerr << "No policy network in: " << opts.policyPath << "\n";
+            return 1;
+        }
+    } else {
+        policyModel = model;
+    }
+
+    // Evaluation defaults, as bb_sweep: no root noise, low exploration.
+    // The opponent is the same search at a fixed 100 iterations.
+    StrengthBenchConfig bench;
+    bench.search.explorationC = 1.0;
+    if (policyModel) bench.search.policy = policyModel->policy.get();
+    for (const auto& [field, value] : opts.base) {
+        if (!setSearchParameter(bench.search, field, value)) {
+            std::cerr << "Unknown MCTSConfig field: " << field << "\n";
+            return 1;
+        }
+    }
+    bench.opponent = bench.search;
+    bench.opponent.timeBudgetMs = 0;
+    bench.opponent.maxIterations = 100;
+    for (const auto& [field, value] : opts.opponent) {
+        if (!setSearchParameter(bench.opponent, field, value)) {
+            std::cerr << "Unknown MCTSConfig field: " << field << "\n";
+            return 1;
+        }
+    }
+    bench.valueFn = model ? model->value.get() : nullptr;
+    bench.opponentValueFn = bench.valueFn;
+    for (int n : opts.iterations) bench.budgets.push_back({n, 0});
+    for (int ms : opts.timesMs) bench.budgets.push_back({0, ms});
+    if (!opts.suitePath.empty()) {
+        bench.positions = loadPositionSuite(opts.suitePath);
+        if (bench.positions.empty()) {
+            std::cerr << "No positions in: " << opts.suitePath << "\n";
+            return 1;
+        }
+    }
+    bench.positionSeeds = opts.positionSeeds;
+    bench.matchPairs = opts.pairs;
+    bench.threads = opts.threads;
+    bench.seed = opts.seed;
+    for (const std::string& name : opts.rosters) {
+        const TeamRoster* r = getDevelopedRoster(name, opts.tv);
+        if (!r) {
+            std::cerr << "Unknown roster: " << name << "\n";
+            return 1;
+        }
+        bench.rosters.push_back(r);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<StrengthRow> rows;
+    try {
+        rows = runStrengthBench(bench);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::ofstream csv;
+    if (!opts.csvPath.empty()) csv.open(opts.csvPath);
+    std::printf("%8s %7s %8s %8s %8s %6s %6s %5s %7s %8s %9s %9s\n", "iters", "time_ms", "accuracy",
+                "pos_it", "pos_ms", "games", "score", "W-D-L", "tdDiff", "game_it", "game_s", "cpu_s");
+    if (csv.is_open()) {
+        csv << "iterations,time_ms,accuracy,position_iterations,position_ms,games,wins,draws,losses,"
+               "score,td_diff,game_search_iterations,game_ms,cpu_seconds\n";
+    }
+    for (const StrengthRow& r : rows) {
+        std::string wdl = std::to_string(r.wins) + "-" + std::to_string(r.draws) + "-" + std::to_string(r.losses);
+        std::printf("%8d %7d %8.3f %8.1f %8.2f %6d %6.3f %5s %+7.2f %8.1f %9.2f %9.2f\n", r.budget.iterations,
+                    r.budget.timeMs, r.accuracy, r.positionIterations, r.positionMs, r.games, r.score,
+                    wdl.c_str(), r.scoreDiff, r.gameSearchIterations, r.gameMs / 1000.0, r.cpuSeconds);
+        for (const auto& [category, accuracy] : r.categoryAccuracy) {
+            std::printf("%17s %-16s %.3f\n", "", category.c_str(), accuracy);
+        }
+        if (csv.is_open()) {
+            csv << r.budget.iterations << ',' << r.budget.timeMs << ',' << r.accuracy << ','
+                << r.positionIterations << ',' << r.positionMs << ',' << r.games << ',' << r.wins << ','
+                << r.draws << ',' << r.losses << ',' << r.score << ',' << r.scoreDiff << ','
+                << r.gameSearchIterations << ',' << r.gameMs << ',' << r.cpuSeconds << '\n';
+        }
+    }
+    std::printf("%.1f s\n", seconds);
+    return 0;
+}
@@ -0,0 +1,222 @@
+#include "bb/model_cache.h"
+#include "bb/roster.h"
+#include "bb/sweep.h"
+#include "bb/thread_placement.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace bb;
+
+// Hyperparameter sweeps of Macro-MCTS: a grid over MCTSConfig fields,
+// every cell playing the same seeds, all games on one thread pool with
+// the networks loaded once. Prints one table row per cell.
+
+namespace {
+
+struct Options {
+    std::string weightsPath;
+    std::string policyPath;  // default: the policy in --weights, if any
+    std::vector<SweepAxis> grid;
+    std::vector<std::pair<std::string, double>> base;
+    std::vector<std::pair<std::string, double>> opponent;
+    bool mirror = true;
+    int games = 8;
+    uint32_t seed = 9000;
+    int threads = 1;
+    std::vector<std::string> rosters = {"human", "orc"};
+    int tv = 1000;
+    std::string csvPath;
+};
+
+void printUsage() {
+    std::cout << "Usage: bb_sweep --grid=FIELD=V1,V2,... [--grid=...] [options]\n"
+              << "\nGrid (FIELD is an MCTSConfig member: explorationC, maxIterations, nRollouts,\n"
+              << "vfBlend, policyBlend, leafLookahead, dirichletAlpha, gumbelTopK, ...):\n"
+              << "  --grid=FIELD=V,...    One axis; cells are the product of all axes\n"
+              << "  --set=FIELD=V         Fix a field in every cell\n"
+              << "  --vs=FIELD=V          Away side plays the base config with this change\n"
+              << "                        instead of mirroring the cell (repeatable)\n"
+              << "\nModels:\n"
+              << "  --weights=FILE        Value network (JSON or binary)\n"
+              << "  --policy=FILE         Policy network (default: the one in --weights)\n"
+              << "\nGames:\n"
+              << "  --games=N             Seeds per cell (default: 8)\n"
+              << "  --seed=N              First seed (default: 9000)\n"
+              << "  --threads=N           Games in parallel (default: 1)\n"
+              << "  --affinity=MODE       Pin game threads: none, compact or spread over NUMA nodes\n"
+              << "                        (default: none)\n"
+              << "  --rosters=A,B,...     Rosters, rotated per seed (default: human,orc)\n"
+              << "  --tv=N                Developed rosters for this team value (default: 1000)\n"
+              << "  --csv=FILE            Also write the table as CSV\n"
+              << "  --help                Show this help\n";
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> out;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) out.push_back(item);
+    return out;
+}
+
+// FIELD=V or FIELD=V1,V2,...
+SweepAxis parseAxis(const std::string& spec) {
+    size_t eq = spec.find('=');
+    if (eq == std::string::npos) throw std::invalid_argument("expected FIELD=VALUES: " + spec);
+    SweepAxis axis{spec.substr(0, eq), {}};
+    for (const std::string& v : splitList(spec.substr(eq + 1))) axis.values.push_back(std::stod(v));
+    return axis;
+}
+
+Options parseArgs(int argc, char* argv[]) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find("--grid=") == 0) opts.grid.push_back(parseAxis(arg.substr(7)));
+        else if (arg.find("--set=") == 0) {
+            SweepAxis a = parseAxis(arg.substr(6));
+            opts.base.emplace_back(a.field, a.values.at(0));
+        }
+        else if (arg.find("--vs=") == 0) {
+            SweepAxis a = parseAxis(arg.substr(5));
+            opts.opponent.emplace_back(a.field, a.values.at(0));
+            opts.mirror = false;
+        }
+        else if (arg.find("--weights=") == 0) opts.weightsPath = arg.substr(10);
+        else if (arg.find("--policy=") == 0) opts.policyPath = arg.substr(9);
+        else if (arg.find("--games=") == 0) opts.games = std::stoi(arg.substr(8));
+        else if (arg.find("--seed=") == 0) opts.seed = static_cast<uint32_t>(std::stoul(arg.substr(7)));
+        else if (arg.find("--threads=") == 0) opts.threads = std::stoi(arg.substr(10));
+        else if (arg.find("--affinity=") == 0) {
+            AffinityMode mode;
+            if (!parseAffinityMode(arg.substr(11), mode)) {
+                std::cerr << "Expected --affinity=none|compact|spread: " << arg << "\n";
+                exit(1);
+            }
+            setThreadAffinity(mode);
+        }
+        else if (arg.find("--rosters=") == 0) opts.rosters = splitList(arg.substr(10));
+        else if (arg.find("--tv=") == 0) opts.tv = std::stoi(arg.substr(5));
+        else if (arg.find("--csv=") == 0) opts.csvPath = arg.substr(6);
+        else if (arg == "--help") { printUsage(); exit(0); }
+        else { std::cerr << "Unknown option: " << arg << "\n"; printUsage(); exit(1); }
+    }
+    return opts;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options opts;
+    try {
+        opts = parseArgs(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Bad option: " << e.what() << "\n";
+        return 1;
+    }
+
+    ModelCache models;
+    std::shared_ptr<LoadedModel> model, policyModel;
+    if (!opts.weightsPath.empty()) {
+        model = models.get(opts.weightsPath);
+        if (!model || !model->value) {
+            std::cerr << "No value network in: " << opts.weightsPath << "\n";
+            return 1;
+        }
+    }
+    if (!opts.policyPath.empty()) {
+        policyModel = models.get(opts.policyPath);
+        if (!policyModel || !policyModel->policy) {
+            std::cerr << "No policy network in: " << opts.policyPath << "\n";
+            return 1;
+        }
+    } else {
+        policyModel = model;
+    }
+
+    // Evaluation defaults: fixed iteration budget, no root noise
+    MCTSConfig base;
+    base.timeBudgetMs = 0;
+    base.maxIterations = 100;
+    base.explorationC = 1.0;
+    if (policyModel) base.policy = policyModel->policy.get();
+    for (const auto& [field, value] : opts.base) {
+        if (!setSearchParameter(base, field, value)) {
+            std::cerr << "Unknown MCTSConfig field: " << field << "\n";
+            return 1;
+        }
+    }
+
+    SweepConfig sweep;
+    sweep.threads = opts.threads;
+    sweep.valueFn = model ? model->value.get() : nullptr;
+    sweep.mirror = opts.mirror;
+    sweep.opponent = base;
+    for (const auto& [field, value] : opts.opponent) {
+        if (!setSearchParameter(sweep.opponent, field, value)) {
+            std::cerr << "Unknown MCTSConfig field: " << field << "\n";
+            return 1;
+        }
+    }
+    for (int g = 0; g < opts.games; ++g) sweep.seeds.push_back(opts.seed + g);
+    for (const std::string& name : opts.rosters) {
+        const TeamRoster* r = getDevelopedRoster(name, opts.tv);
+        if (!r) {
+            std::cerr << "Unknown roster: " << name << "\n";
+            return 1;
+        }
+        sweep.rosters.push_back(r);
+    }
+
+    std::vector<MCTSConfig> cells;
+    try {
+        cells = expandGrid(base, opts.grid);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    std::printf("%zu cells x %d games on %d threads\n", cells.size(), opts.games, opts.threads);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<SweepCellResult> results = runSweep(cells, sweep);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::ofstream csv;
+    if (!opts.csvPath.empty()) csv.open(opts.csvPath);
+    std::string header;
+    for (const SweepAxis& axis : opts.grid) {
+        std::printf("%14s ", axis.field.c_str());
+        header += axis.field + ",";
+    }
+    std::printf("%6s %5s %5s %5s %7s %9s %7s %7s %8s %8s\n", "games", "W", "D", "L", "tdDiff",
+                "decisions", "H_norm", "top1", "iters", "ms");
+    if (csv.is_open()) csv << header << "games,wins,draws,losses,td_diff,decisions,h_norm,top1,iterations,search_ms\n";
+
+    // Row c of a grid is the c-th cell of the product, first axis slowest
+    for (size_t c = 0; c < cells.size(); ++c) {
+        size_t rest = c, stride = cells.size();
+        std::string row;
+        for (const SweepAxis& axis : opts.grid) {
+            stride /= axis.values.size();
+            double v = axis.values[rest / stride];
+            rest %= stride;
+            std::printf("%14g ", v);
+            row += std::to_string(v) + ",";
+        }
+        const SweepCellResult& r = results[c];
+        std::printf("%6d %5d %5d %5d %+7.2f %9d %7.3f %7.3f %8.1f %8.2f\n", r.games, r.wins, r.draws,
+                    r.losses, r.scoreDiff, r.decisions, r.visitEntropy, r.topShare, r.iterations, r.searchMs);
+        if (csv.is_open()) {
+            csv << row << r.games << ',' << r.wins << ',' << r.draws << ',' << r.losses << ','
+                << r.scoreDiff << ',' << r.decisions << ',' << r.visitEntropy << ',' << r.topShare << ','
+                << r.iterations << ',' << r.searchMs << '\n';
+        }
+    }
+    std::printf("%.1f s\n", seconds);
+    return 0;
+}
@@ -0,0 +1,354 @@
+#include "bb/metrics.h"
+#include "bb/model_cache.h"
+#include "bb/roster.h"
+#include "bb/root_cache.h"
+#include "bb/tournament.h"
+#include "bb/thread_placement.h"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace bb;
+
+// Gating and evaluation matches between weights snapshots: paired,
+// side-swapped games on a thread pool, stopped as soon as SPRT (or a
+// Wilson interval) settles the match. Every game is streamed to CSV
+// and/or JSON lines as it finishes, so an interrupted run keeps its data.
+//
+// --shard plays a block of pairs of a longer match (no early stop) and
+// --summary saves the outcome; --merge combines shard summaries into the
+// result one run over all their pairs would have given.
+
+namespace {
+
+struct Entrant {
+    std::string name;
+    std::string weights;
+};
+
+struct Options {
+    std::vector<Entrant> players;
+    std::string ai = "macro_mcts";
+    int iterations = 100;
+    float vfBlend = 0.0f;
+    std::string policyPath;
+    float policyBlend = 0.0f;
+    int gumbelTopK = 0;
+    std::string rootCachePath;
+    int rootCacheMb = 256;
+    std::vector<std::string> rosters = {"human", "orc"};
+    int tv = 1000;
+    TournamentConfig tournament;
+    std::string csvPath;
+    std::string jsonPath;
+    std::string metricsPath;
+    bool shard = false;
+    std::string summaryPath;
+    std::vector<std::string> mergePaths;
+};
+
+void printUsage() {
+    std::cout << "Usage: bb_tournament --player=[NAME=]WEIGHTS --player=... [options]\n"
+              << "\nEntrants (two or more; the first is A in a two-player gate):\n"
+              << "  --player=[NAME=]FILE  Weights file (JSON or binary); NAME defaults to FILE\n"
+              << "  --ai=AI               macro_mcts, mcts or learning (default: macro_mcts)\n"
+              << "  --iterations=N        Search iterations per decision (default: 100)\n"
+              << "  --vf-blend=X          Value-function blend (default: 0)\n"
+              << "  --policy=FILE         Policy network for every entrant's priors\n"
+              << "  --policy-blend=X      (default: 0)\n"
+              << "  --gumbel-top-k=K      Gumbel root over K macros (default: 0 = PUCT)\n"
+              << "\nMatch:\n"
+              << "  --root-cache=FILE     Reuse macro_mcts root results across games and runs\n"
+              << "  --root-cache-mb=N     Size of a new --root-cache file (default: 256)\n"
+              << "  --pairs=N             Most seed pairs per match (default: 200)\n"
+              << "  --min-pairs=N         Pairs before stopping is considered (default: 10)\n"
+              << "  --threads=N           Games in parallel (default: 1)\n"
+              << "  --affinity=MODE       Pin game threads: none, compact or spread over NUMA nodes\n"
+              << "                        (default: none)\n"
+              << "  --seed=N              Seed of pair 0 (default: 1)\n"
+              << "  --rosters=A,B,...     Rosters, rotated per pair (default: human,orc)\n"
+              << "  --tv=N                Developed rosters for this team value (default: 1000)\n"
+              << "  --stop=RULE           sprt, wilson or none (default: sprt)\n"
+              << "  --elo0=X --elo1=X     SPRT hypotheses (default: 0, 35)\n"
+              << "  --alpha=X --beta=X    SPRT error rates (default: 0.05, 0.05)\n"
+              << "  --z=X                 Wilson interval quantile (default: 1.96)\n"
+              << "\nSharding:\n"
+              << "  --shard=FIRST:COUNT   Play pairs FIRST .. FIRST+COUNT-1 only, without stopping\n"
+              << "  --summary=FILE        Write the match outcomes for --merge\n"
+              << "  --merge=FILE,...      Merge shard summaries (no games played); the match\n"
+              << "                        options above decide stopping, as in a single run\n"
+              << "\nOutput:\n"
+              << "  --csv=FILE            One row per game\n"
+              << "  --json=FILE           One JSON object per game (JSON lines)\n"
+              << "  --metrics-file=FILE   Prometheus metrics (decisions, search latency, games),\n"
+              << "                        rewritten every 5 s for node_exporter's textfile collector\n"
+              << "  --help                Show this help\n";
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> out;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) out.push_back(item);
+    return out;
+}
+
+Options parseArgs(int argc, char* argv[]) {
+    Options opts;
+    TournamentConfig& t = opts.tournament;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find("--player=") == 0) {
+            std::string spec = arg.substr(9);
+            size_t eq = spec.find('=');
+            if (eq == std::string::npos) opts.players.push_back({spec, spec});
+            else opts.players.push_back({spec.substr(0, eq), spec.substr(eq + 1)});
+        }
+        else if (arg.find("--ai=") == 0) opts.ai = arg.substr(5);
+        else if (arg.find("--iterations=") == 0) opts.iterations = std::stoi(arg.substr(13));
+        else if (arg.find("--vf-blend=") == 0) opts.vfBlend = std::stof(arg.substr(11));
+        else if (arg.find("--policy=") == 0) opts.policyPath = arg.substr(9);
+        else if (arg.find("--policy-blend=") == 0) opts.policyBlend = std::stof(arg.substr(15));
+        else if (arg.find("--gumbel-top-k=") == 0) opts.gumbelTopK = std::stoi(arg.substr(15));
+        else if (arg.find("--root-cache=") == 0) opts.rootCachePath = arg.substr(13);
+        else if (arg.find("--root-cache-mb=") == 0) opts.rootCacheMb = std::stoi(arg.substr(16));
+        else if (arg.find("--pairs=") == 0) t.maxPairs = std::stoi(arg.substr(8));
+        else if (arg.find("--min-pairs=") == 0) t.minPairs = std::stoi(arg.substr(12));
+        else if (arg.find("--threads=") == 0) t.threads = std::stoi(arg.substr(10));
+        else if (arg.find("--affinity=") == 0) {
+            AffinityMode mode;
+            if (!parseAffinityMode(arg.substr(11), mode)) {
+                std::cerr << "Expected --affinity=none|compact|spread: " << arg << "\n";
+                exit(1);
+            }
+            setThreadAffinity(mode);
+        }
+        else if (arg.find("--seed=") == 0) t.seed = static_cast<uint32_t>(std::stoul(arg.substr(7)));
+        else if (arg.find("--rosters=") == 0) opts.rosters = splitList(arg.substr(10));
+        else if (arg.find("--tv=") == 0) opts.tv = std::stoi(arg.substr(5));
+        else if (arg == "--stop=sprt") t.stop = StopRule::SPRT;
+        else if (arg == "--stop=wilson") t.stop = StopRule::WILSON;
+        else if (arg == "--stop=none") t.stop = StopRule::NONE;
+        else if (arg.find("--elo0=") == 0) t.elo0 = std::stod(arg.substr(7));
+        else if (arg.find("--elo1=") == 0) t.elo1 = std::stod(arg.substr(7));
+        else if (arg.find("--alpha=") == 0) t.alpha = std::stod(arg.substr(8));
+        else if (arg.find("--beta=") == 0) t.beta = std::stod(arg.substr(7));
+        else if (arg.find("--z=") == 0) t.wilsonZ = std::stod(arg.substr(4));
+        else if (arg.find("--shard=") == 0) {
+            std::string range = arg.substr(8);
+            size_t colon = range.find(':');
+            if (colon == std::string::npos) {
+                std::cerr << "Expected --shard=FIRST:COUNT: " << arg << "\n";
+                exit(1);
+            }
+            t.firstPair = std::stoi(range.substr(0, colon));
+            t.maxPairs = std::stoi(range.substr(colon + 1));
+            opts.shard = true;
+        }
+        else if (arg.find("--summary=") == 0) opts.summaryPath = arg.substr(10);
+        else if (arg.find("--merge=") == 0) opts.mergePaths = splitList(arg.substr(8));
+        else if (arg.find("--csv=") == 0) opts.csvPath = arg.substr(6);
+        else if (arg.find("--json=") == 0) opts.jsonPath = arg.substr(7);
+        else if (arg.find("--metrics-file=") == 0) opts.metricsPath = arg.substr(15);
+        else if (arg == "--help") { printUsage(); exit(0); }
+        else { std::cerr << "Unknown option: " << arg << "\n"; printUsage(); exit(1); }
+    }
+    // A shard's pairs are counted whole; stopping is the merge's decision
+    if (opts.shard) t.stop = StopRule::NONE;
+    return opts;
+}
+
+// What must agree between shards of one match
+nlohmann::json runDescription(const Options& opts) {
+    nlohmann::json players = nlohmann::json::array();
+    for (const Entrant& e : opts.players) players.push_back({{"name", e.name}, {"weights", e.weights}});
+    return {
+        {"players", std::move(players)}, {"ai", opts.ai}, {"iterations", opts.iterations},
+        {"vf_blend", opts.vfBlend}, {"policy", opts.policyPath}, {"policy_blend", opts.policyBlend},
+        {"gumbel_top_k", opts.gumbelTopK}, {"rosters", opts.rosters}, {"tv", opts.tv},
+        {"seed", opts.tournament.seed},
+    };
+}
+
+void printResults(const std::vector<MatchResult>& results, const std::vector<std::string>& names,
+                  StopRule stop) {
+    for (const MatchResult& m : results) {
+        std::printf("%s vs %s: +%d =%d -%d over %d pairs, score %.3f [%.3f, %.3f]",
+                    names[m.playerA].c_str(), names[m.playerB].c_str(),
+                    m.wins, m.draws, m.losses, m.pairs, m.score, m.lower, m.upper);
+        if (stop == StopRule::SPRT) std::printf(", LLR %.2f", m.llr);
+        std::printf(" -> %s\n", matchVerdictName(m.verdict));
+        std::printf("  touchdowns %d-%d, score differences", m.touchdownsA, m.touchdownsB);
+        for (const auto& [diff, games] : m.scoreDiff) std::printf(" %+d:%d", diff, games);
+        std::printf("\n");
+    }
+}
+
+bool writeSummary(const std::string& path, nlohmann::json run, const std::vector<MatchResult>& results) {
+    nlohmann::json matches = nlohmann::json::array();
+    for (const MatchResult& m : results) matches.push_back(nlohmann::json::parse(matchSummaryJson(m)));
+    run["matches"] = std::move(matches);
+    std::ofstream out(path);
+    out << run.dump() << "\n";
+    return static_cast<bool>(out);
+}
+
+int mergeSummaries(const Options& opts) {
+    nlohmann::json run;
+    std::map<std::pair<int, int>, std::vector<MatchResult>> shards;
+    for (const std::string& path : opts.mergePaths) {
+        std::ifstream in(path);
+        nlohmann::json file = nlohmann::json::parse(in, nullptr, false);
+        if (file.is_discarded() || !file.contains("matches")) {
+            std::cerr << "Not a match summary: " << path << "\n";
+            return 1;
+        }
+        nlohmann::json matches = file["matches"];
+        file.erase("matches");
+        if (run.is_null()) run = file;
+        else if (file != run) {
+            std::cerr << "Summary from a different run: " << path << "\n";
+            return 1;
+        }
+        for (const nlohmann::json& m : matches) {
+            MatchResult shard;
+            if (!parseMatchSummary(m.dump(), shard)) {
+                std::cerr << "Malformed match in: " << path << "\n";
+                return 1;
+            }
+            shards[{shard.playerA, shard.playerB}].push_back(std::move(shard));
+        }
+    }
+
+    std::vector<MatchResult> results;
+    try {
+        for (const auto& [players, parts] : shards) results.push_back(mergeMatches(parts, opts.tournament));
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    std::vector<std::string> names;
+    for (const nlohmann::json& p : run["players"]) names.push_back(p.value("name", std::string()));
+    printResults(results, names, opts.tournament.stop);
+    if (!opts.summaryPath.empty() && !writeSummary(opts.summaryPath, run, results)) {
+        std::cerr << "Cannot write " << opts.summaryPath << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options opts = parseArgs(argc, argv);
+    if (!opts.mergePaths.empty()) return mergeSummaries(opts);
+    if (opts.players.size() < 2) {
+        std::cerr << "Need at least two --player entrants\n";
+        printUsage();
+        return 1;
+    }
+
+    ModelCache models;
+    std::shared_ptr<const PolicyNetwork> policy;
+    if (!opts.policyPath.empty()) {
+        auto m = models.get(opts.policyPath);
+        if (!m || !m->policy) {
+            std::cerr << "No policy network in: " << opts.policyPath << "\n";
+            return 1;
+        }
+        policy = m->policy;
+    }
+    std::shared_ptr<RootCache> rootCache;
+    if (!opts.rootCachePath.empty()) {
+        rootCache = RootCache::open(opts.rootCachePath, static_cast<size_t>(opts.rootCacheMb) << 20);
+        if (!rootCache) {
+            std::cerr << "Cannot open root cache: " << opts.rootCachePath << "\n";
+            return 1;
+        }
+    }
+    MetricsRegistry metrics;
+    std::unique_ptr<MetricsFile> metricsFile;
+    if (!opts.metricsPath.empty()) metricsFile = std::make_unique<MetricsFile>(metrics, opts.metricsPath);
+    std::vector<PlayerConfig> players;
+    for (const Entrant& e : opts.players) {
+        auto m = models.get(e.weights);
+        if (!m || !m->value) {
+            std::cerr << "No value network in: " << e.weights << "\n";
+            return 1;
+        }
+        PlayerConfig p;
+        p.ai = opts.ai;
+        p.valueFn = m->value;
+        p.policy = policy ? policy : m->policy;
+        p.epsilon = 0.0f;
+        p.mctsIterations = opts.iterations;
+        p.vfBlend = opts.vfBlend;
+        p.policyBlend = opts.policyBlend;
+        p.gumbelTopK = opts.gumbelTopK;
+        if (rootCache) {
+            p.rootCache = rootCache;
+            p.rootCacheModel = rootCacheModelKey({e.weights, opts.policyPath});
+        }
+        if (metricsFile) p.metrics = &metrics;
+        players.push_back(std::move(p));
+    }
+    for (const std::string& name : opts.rosters) {
+        const TeamRoster* r = getDevelopedRoster(name, opts.tv);
+        if (!r) {
+            std::cerr << "Unknown roster: " << name << "\n";
+            return 1;
+        }
+        opts.tournament.rosters.push_back(r);
+    }
+
+    std::ofstream csv, json;
+    if (!opts.csvPath.empty()) {
+        csv.open(opts.csvPath);
+        csv << "player_a,player_b,pair,a_is_home,seed,home_roster,away_roster,score_a,score_b,actions\n";
+    }
+    if (!opts.jsonPath.empty()) json.open(opts.jsonPath);
+    if ((!opts.csvPath.empty() && !csv) || (!opts.jsonPath.empty() && !json)) {
+        std::cerr << "Cannot open the output files\n";
+        return 1;
+    }
+    auto onGame = [&](const TournamentGame& g) {
+        const std::string& a = opts.players[g.playerA].name;
+        const std::string& b = opts.players[g.playerB].name;
+        if (csv.is_open()) {
+            csv << a << ',' << b << ',' << g.pair << ',' << (g.aIsHome ? 1 : 0) << ',' << g.seed << ','
+                << g.homeRoster << ',' << g.awayRoster << ',' << g.scoreA << ',' << g.scoreB << ','
+                << g.totalActions << std::endl;
+        }
+        if (json.is_open()) {
+            nlohmann::json row = {
+                {"player_a", a}, {"player_b", b}, {"pair", g.pair}, {"a_is_home", g.aIsHome},
+                {"seed", g.seed}, {"home_roster", g.homeRoster}, {"away_roster", g.awayRoster},
+                {"score_a", g.scoreA}, {"score_b", g.scoreB}, {"actions", g.totalActions},
+            };
+            json << row.dump() << std::endl;
+        }
+        if (metricsFile) metricsFile->update();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<MatchResult> results = runTournament(players, opts.tournament, onGame);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (metricsFile && !metricsFile->update(true)) std::cerr << "Cannot write " << opts.metricsPath << "\n";
+
+    std::vector<std::string> names;
+    for (const Entrant& e : opts.players) names.push_back(e.name);
+    printResults(results, names, opts.tournament.stop);
+    std::printf("%.1f s\n", seconds);
+    if (!opts.summaryPath.empty() && !writeSummary(opts.summaryPath, runDescription(opts), results)) {
+        std::cerr << "Cannot write " << opts.summaryPath << "\n";
+        return 1;
+    }
+    return 0;
+}
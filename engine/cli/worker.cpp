@@ -0,0 +1,133 @@
+#include "bb/self_play_cluster.h"
+#include "bb/thread_placement.h"
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace bb;
+
+// Self-play worker: connects to a bb_coordinator, plays the units it is
+// given and sends their shards back (see self_play_cluster.h). Reconnects
+// with backoff when the coordinator is unreachable.
+
+namespace {
+
+struct Options {
+    std::string host;
+    std::string port;
+    int retries = 10;  // consecutive failed connects before giving up
+    ClusterWorkerOptions worker;
+};
+
+void printUsage() {
+    std::cout << "Usage: bb_worker --coordinator=HOST:PORT [options]\n"
+              << "\nOptions:\n"
+              << "  --coordinator=HOST:PORT  Coordinator address\n"
+              << "  --name=NAME              Worker name in the coordinator's log (default: hostname)\n"
+              << "  --cache=DIR              Model cache (default: bb_worker_cache)\n"
+              << "  --scratch=DIR            Shard output before upload (default: bb_worker_scratch)\n"
+              << "  --max-units=N            Stop after N units (default: until the run is done)\n"
+              << "  --retries=N              Failed connects in a row before giving up (default: 10)\n"
+              << "  --affinity=MODE          Pin game threads: none, compact or spread over NUMA\n"
+              << "                           nodes (default: none)\n"
+              << "  --help                   Show this help\n";
+}
+
+Options parseArgs(int argc, char* argv[]) {
+    Options opts;
+    char host[256] = {};
+    if (::gethostname(host, sizeof(host) - 1) == 0) opts.worker.name = host;
+    opts.worker.cacheDir = "bb_worker_cache";
+    opts.worker.scratchDir = "bb_worker_scratch";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find("--coordinator=") == 0) {
+            std::string address = arg.substr(14);
+            size_t colon = address.rfind(':');
+            if (colon == std::string::npos) {
+                std::cerr << "Expected --coordinator=HOST:PORT: " << arg << "\n";
+                exit(1);
+            }
+            opts.host = address.substr(0, colon);
+            opts.port = address.substr(colon + 1);
+        }
+        else if (arg.find("--name=") == 0) opts.worker.name = arg.substr(7);
+        else if (arg.find("--cache=") == 0) opts.worker.cacheDir = arg.substr(8);
+        else if (arg.find("--scratch=") == 0) opts.worker.scratchDir = arg.substr(10);
+        else if (arg.find("--max-units=") == 0) opts.worker.maxUnits = std::stoi(arg.substr(12));
+        else if (arg.find("--retries=") == 0) opts.retries = std::stoi(arg.substr(10));
+        else if (arg.find("--affinity=") == 0) {
+            AffinityMode mode;
+            if (!parseAffinityMode(arg.substr(11), mode)) {
+                std::cerr << "Expected --affinity=none|compact|spread: " << arg << "\n";
+                exit(1);
+            }
+            setThreadAffinity(mode);
+        }
+        else if (arg == "--help") { printUsage(); exit(0); }
+        else { std::cerr << "Unknown option: " << arg << "\n"; printUsage(); exit(1); }
+    }
+    if (opts.host.empty()) {
+        printUsage();
+        exit(1);
+    }
+    return opts;
+}
+
+int connectTo(const std::string& host, const std::string& port) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* found = nullptr;
+    if (::getaddrinfo(host.c_str(), port.c_str(), &hints, &found) != 0) return -1;
+    int fd = -1;
+    for (addrinfo* a = found; a && fd < 0; a = a->ai_next) {
+        fd = ::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd >= 0 && ::connect(fd, a->ai_addr, a->ai_addrlen) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    ::freeaddrinfo(found);
+    return fd;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options opts = parseArgs(argc, argv);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int total = 0;
+    int misses = 0;
+    int backoffMs = 500;
+    while (misses < opts.retries) {
+        int fd = connectTo(opts.host, opts.port);
+        if (fd < 0) {
+            misses++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(backoffMs));
+            backoffMs = std::min(backoffMs * 2, 30000);
+            continue;
+        }
+        misses = 0;
+        backoffMs = 500;
+        ClusterChannel channel(fd);
+        ClusterWorkerOptions worker = opts.worker;
+        if (worker.maxUnits > 0) worker.maxUnits -= total;
+        bool finished = false;
+        total += runClusterWorker(channel, worker, &finished);
+        ::close(fd);
+        std::cout << opts.worker.name << ": " << total << " unit(s) played" << std::endl;
+        if (finished) return 0;
+        std::this_thread::sleep_for(std::chrono::milliseconds(backoffMs));
+    }
+    std::cerr << "Lost the coordinator at " << opts.host << ":" << opts.port << "\n";
+    return 1;
+}
@@ -15,5 +15,11 @@ constexpr int NUM_ACTION_FEATURES = 23;
 //         memory project-neural-policy-rootcause.
 // out must point to at least NUM_ACTION_FEATURES floats.
 void extractActionFeatures(const GameState& state, const Action& action, float* out);
+// The same for actions[0..n), row i of the n x NUM_ACTION_FEATURES matrix
+// at `out` for actions[i], bit-identical to the calls one by one. Block
+// assists are counted once per attacker and defender for each run of
+// actions by one player (generation order keeps a player's actions
+// together), rather than once per action.
+void extractActionFeatures(const GameState& state, const Action* actions, int n, float* out);
 
 } // namespace bb
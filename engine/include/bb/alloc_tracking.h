@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace bb {
+
+// Heap allocation counters, built in only with -DBB_ALLOC_TRACKING=ON,
+// which replaces the global operator new/delete. Every thread counts into
+// its own slot; each allocation is charged to the subsystem tag innermost
+// on that thread (BB_ALLOC_SCOPE), OTHER when there is none. Live and peak
+// bytes are process-wide. Sizes are the allocator's usable sizes.
+//
+// Without BB_ALLOC_TRACKING the BB_ALLOC_SCOPE macro expands to nothing and
+// the API below reports zeros.
+namespace alloc {
+
+enum Tag : uint8_t {
+    OTHER = 0,
+    SEARCH_TREE,      // node expansion, priors, tree bookkeeping
+    MOVE_GEN,         // getAvailableActions / getAvailableMacros
+    MACRO_EXPANSION,  // greedyExpandMacro and the actions it resolves
+    LOGGING,          // game event logs, replays and shard writers
+    BINDINGS,         // Python <-> C++ conversions
+    NUM_TAGS
+};
+
+} // namespace alloc
+
+struct AllocCounters {
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t bytes = 0;  // allocated, not net of frees
+    uint64_t tagAllocations[alloc::NUM_TAGS] = {};
+    uint64_t tagBytes[alloc::NUM_TAGS] = {};
+
+    // Counts accumulated since `earlier` (a snapshot of the same source).
+    AllocCounters since(const AllocCounters& earlier) const;
+};
+
+// True when built with BB_ALLOC_TRACKING.
+bool allocTrackingEnabled();
+const char* allocTagName(alloc::Tag tag);
+// The calling thread's counters, and the sum over every thread.
+AllocCounters threadAllocCounters();
+AllocCounters processAllocCounters();
+int64_t allocLiveBytes();
+// Highest allocLiveBytes() since start or the last allocResetPeak().
+int64_t allocPeakBytes();
+void allocResetPeak();
+// processAllocCounters() per tag, plus live and peak bytes, as a text table.
+std::string allocReport();
+
+#ifdef BB_ALLOC_TRACKING
+
+// Charge the calling thread's allocations to `tag` until destruction.
+class AllocTagScope {
+    uint8_t saved_;
+public:
+    explicit AllocTagScope(alloc::Tag tag);
+    ~AllocTagScope();
+    AllocTagScope(const AllocTagScope&) = delete;
+    AllocTagScope& operator=(const AllocTagScope&) = delete;
+};
+
+#define BB_ALLOC_CONCAT_(a, b) a##b
+#define BB_ALLOC_CONCAT(a, b) BB_ALLOC_CONCAT_(a, b)
+// Tag the rest of the enclosing block.
+#define BB_ALLOC_SCOPE(tag) \
+    ::bb::AllocTagScope BB_ALLOC_CONCAT(bbAllocScope_, __LINE__)(tag)
+
+#else
+
+#define BB_ALLOC_SCOPE(tag) ((void)0)
+
+#endif
+
+} // namespace bb
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "bb/game_simulator.h"
+#include "bb/policy_network.h"
+#include "bb/value_function.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+class MetricsRegistry;
+class RootCache;
+
+// Per-game settings: the AI names and knobs of the simulate_game binding.
+// AI names: "random", "greedy", "learning", "mcts", "macro_mcts".
+struct GameConfig {
+    std::string homeAI = "random";
+    std::string awayAI = "random";
+    std::shared_ptr<const ValueFunction> valueFn;  // learning / mcts / macro_mcts
+    std::shared_ptr<const PolicyNetwork> policy;   // priors for the search AIs
+    float epsilon = 0.3f;      // learning AI exploration
+    int mctsIterations = 0;    // search AIs fall back to random at 0
+    int gameIterations = 0;    // macro_mcts: per-team iterations for the whole game, spread over
+                               // decisions by a TimeManager with mctsIterations as the per-search
+                               // cap (0 = mctsIterations for every search)
+    float policyBlend = 0.0f;
+    float vfBlend = 0.0f;
+    int gumbelTopK = 0;        // macro_mcts: Gumbel sequential-halving root over this many macros (0 = PUCT)
+    bool adjudicate = false;   // stop once the winner is settled (simulateGame's adjudicate)
+};
+
+// One side's AI: GameConfig's knobs for a single team, so the two sides
+// can bring different networks (gating, tournaments).
+struct PlayerConfig {
+    std::string ai = "random";
+    std::shared_ptr<const ValueFunction> valueFn;
+    std::shared_ptr<const PolicyNetwork> policy;
+    float epsilon = 0.3f;
+    int mctsIterations = 0;
+    int gameIterations = 0;
+    float policyBlend = 0.0f;
+    float vfBlend = 0.0f;
+    int gumbelTopK = 0;
+    bool ponder = false;  // macro_mcts: search on the opponent's time (MacroMCTSPolicy::ponder)
+    // macro_mcts: MCTSConfig::rootCache / rootCacheModel
+    std::shared_ptr<RootCache> rootCache;
+    uint64_t rootCacheModel = 0;
+    // Each decision recorded here (recordDecision, labelled by `ai`); the
+    // registry must outlive the games
+    MetricsRegistry* metrics = nullptr;
+};
+
+// The home or away half of `config`.
+PlayerConfig playerConfig(const GameConfig& config, TeamSide side);
+
+// One game with evaluation search settings (low exploration, no root noise).
+GameResult playConfiguredGame(const TeamRoster& home, const TeamRoster& away,
+                              const GameConfig& config, uint32_t seed);
+GameResult playConfiguredGame(const TeamRoster& home, const TeamRoster& away,
+                              const PlayerConfig& homePlayer, const PlayerConfig& awayPlayer,
+                              uint32_t seed, bool adjudicate = false);
+
+struct BatchResult {
+    std::vector<GameResult> games;  // in seed order
+    int homeWins = 0;
+    int awayWins = 0;
+    int draws = 0;
+    long totalActions = 0;
+};
+
+// Play seeds.size() games on `threads` workers. `configs` holds one entry
+// per game or a single entry shared by all. Networks are shared read-only
+// between workers; each game owns its dice and search state, so game i's
+// result depends only on configs[i] and seeds[i].
+BatchResult runGames(const TeamRoster& home, const TeamRoster& away,
+                     const std::vector<GameConfig>& configs,
+                     const std::vector<uint32_t>& seeds, int threads = 1);
+
+struct ContinuationResult {
+    std::vector<GameResult> games;  // final scores, by continuation
+    int homeScored = 0;             // continuations in which home added a touchdown
+    int awayScored = 0;
+    std::map<int, int> scoreDiff;   // final home minus away score -> continuations
+    long totalActions = 0;
+
+    double homeTdProbability() const { return games.empty() ? 0.0 : static_cast<double>(homeScored) / games.size(); }
+    double awayTdProbability() const { return games.empty() ? 0.0 : static_cast<double>(awayScored) / games.size(); }
+    double meanScoreDiff() const {
+        double sum = 0.0;
+        for (const auto& [diff, count] : scoreDiff) sum += static_cast<double>(diff) * count;
+        return games.empty() ? 0.0 : sum / games.size();
+    }
+};
+
+// Monte Carlo continuations of `state`, a position of a game between
+// `home` and `away`: nGames independent plays to `until` on `threads`
+// workers (continueGame). Continuation i draws from its own stream,
+// FastDiceRoller(seed, i), which also seeds its policies, so results do not
+// depend on the thread count. Pondering is not used.
+ContinuationResult simulateFromState(const GameState& state, const TeamRoster& home,
+                                     const TeamRoster& away, const PlayerConfig& homePlayer,
+                                     const PlayerConfig& awayPlayer, int nGames, int threads,
+                                     PlayUntil until, uint32_t seed = 0);
+
+} // namespace bb
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "bb/game_simulator.h"
+#include "bb/mcts.h"
+#include "bb/value_function.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace bb {
+
+// A ValueFunction front shared by searches on several threads, so their
+// leaf evaluations reach the model as one batch instead of one call per
+// search. evaluate()/evaluateBatch() queue the caller's rows and block.
+// Once every attached client is waiting, `maxBatch` rows are queued or the
+// oldest request has waited `maxWaitUs`, the thread that notices runs the
+// model once over everything queued and hands each caller its values.
+// Clients attach() for as long as they will keep submitting; a client that
+// stops without detach()ing only costs the others maxWaitUs per batch.
+class SharedEvalBatcher : public ValueFunction {
+public:
+    struct Stats {
+        uint64_t batches = 0;   // model calls
+        uint64_t requests = 0;  // evaluate()/evaluateBatch() calls served
+        uint64_t rows = 0;
+    };
+
+    explicit SharedEvalBatcher(const ValueFunction& model, int maxBatch = 1024, int maxWaitUs = 2000);
+
+    void attach();
+    void detach();
+
+    float evaluate(const float* features, int numFeatures) const override;
+    void evaluateBatch(const float* features, int batch, int numFeatures, float* out) const override;
+    int inputSize() const override { return model_.inputSize(); }
+    void encodeState(const GameState& state, TeamSide perspective, float* out) const override {
+        model_.encodeState(state, perspective, out);
+    }
+
+    Stats stats() const;
+
+private:
+    struct Request {
+        const float* rows;
+        int count;
+        float* out;
+        bool done = false;
+    };
+    void submit(Request& req) const;
+
+    const ValueFunction& model_;
+    const int maxBatch_;
+    const int maxWaitUs_;
+    mutable std::mutex mutex_;
+    mutable std::condition_variable changed_;
+    mutable std::vector<Request*> queue_;
+    mutable int queuedRows_ = 0;
+    mutable bool evaluating_ = false;
+    int attached_ = 0;
+    mutable Stats stats_;
+    // The evaluating thread's scratch (only touched while evaluating_)
+    mutable std::vector<float> rows_;
+    mutable std::vector<float> values_;
+};
+
+// Self-play with M games in flight in one process: each game runs on its
+// own thread with its own MacroMCTSPolicy per side, and every search
+// values its leaves through one SharedEvalBatcher over `model`, so the
+// model sees batches of about M * search.evalBatchSize rows. Set
+// search.vfBlend > 0 and search.evalBatchSize > 1; with evalBatchSize 1
+// each leaf is a batch rendezvous of its own.
+struct BatchedSelfPlayConfig {
+    int concurrentGames = 8;
+    MCTSConfig search;
+    int topK = 20;             // logged visits per decision
+    bool logBoards = true;
+    bool useFullKickoff = false;
+    int maxBatch = 1024;       // SharedEvalBatcher limits
+    int maxWaitUs = 2000;
+    GameLogMode logMode = GameLogMode::FULL;
+};
+
+struct BatchedSelfPlayResult {
+    // In seed order; policyDecisions holds both sides' searches, home first
+    std::vector<LoggedGameResult> games;
+    SharedEvalBatcher::Stats eval;
+};
+
+// Game i plays seeds[i]; its searches are seeded from that seed. How
+// leaves group into batches depends on timing, so under an iteration
+// budget a game plays as it would alone whenever the model values each
+// row independently of the rows batched with it.
+BatchedSelfPlayResult runBatchedSelfPlay(const TeamRoster& home, const TeamRoster& away,
+                                         const ValueFunction& model,
+                                         const BatchedSelfPlayConfig& config,
+                                         const std::vector<uint32_t>& seeds);
+
+} // namespace bb
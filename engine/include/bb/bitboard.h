@@ -0,0 +1,82 @@
+#pragma once
+
+#include "bb/position.h"
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace bb {
+
+// 390-square pitch as a bitset: bit (y * PITCH_WIDTH + x). Rows are packed
+// back to back, so ascending bit order is the same row-major order that
+// Position::getAdjacent() uses -- iterating a mask visits squares in the
+// order the per-square loops did.
+struct Bitboard {
+    static constexpr int SQUARES = Position::PITCH_WIDTH * Position::PITCH_HEIGHT;
+    static constexpr int WORDS = (SQUARES + 63) / 64;
+
+    std::array<uint64_t, WORDS> w{};
+
+    static int indexOf(Position p) { return p.y * Position::PITCH_WIDTH + p.x; }
+    static Position positionOf(int idx) {
+        return {static_cast<int8_t>(idx % Position::PITCH_WIDTH),
+                static_cast<int8_t>(idx / Position::PITCH_WIDTH)};
+    }
+
+    void set(int idx) { w[idx >> 6] |= uint64_t{1} << (idx & 63); }
+    void clear(int idx) { w[idx >> 6] &= ~(uint64_t{1} << (idx & 63)); }
+    void assign(int idx, bool on) { on ? set(idx) : clear(idx); }
+    bool test(int idx) const { return (w[idx >> 6] >> (idx & 63)) & 1; }
+
+    void set(Position p) { set(indexOf(p)); }
+    bool test(Position p) const { return test(indexOf(p)); }
+
+    bool any() const {
+        uint64_t acc = 0;
+        for (uint64_t x : w) acc |= x;
+        return acc != 0;
+    }
+    int count() const {
+        int n = 0;
+        for (uint64_t x : w) n += std::popcount(x);
+        return n;
+    }
+
+    Bitboard operator&(const Bitboard& o) const { Bitboard r; for (int i = 0; i < WORDS; ++i) r.w[i] = w[i] & o.w[i]; return r; }
+    Bitboard operator|(const Bitboard& o) const { Bitboard r; for (int i = 0; i < WORDS; ++i) r.w[i] = w[i] | o.w[i]; return r; }
+    Bitboard& operator&=(const Bitboard& o) { for (int i = 0; i < WORDS; ++i) w[i] &= o.w[i]; return *this; }
+    Bitboard& operator|=(const Bitboard& o) { for (int i = 0; i < WORDS; ++i) w[i] |= o.w[i]; return *this; }
+    // Set difference (a & ~b); there is no operator~ so padding bits stay clear.
+    Bitboard andNot(const Bitboard& o) const { Bitboard r; for (int i = 0; i < WORDS; ++i) r.w[i] = w[i] & ~o.w[i]; return r; }
+    bool operator==(const Bitboard& o) const { return w == o.w; }
+
+    // Multi-word shifts toward higher / lower bit indices.
+    Bitboard shiftUp(int n) const;
+    Bitboard shiftDown(int n) const;
+
+    // Visit set squares in ascending index order.
+    template<typename F>
+    void forEach(F&& func) const {
+        for (int i = 0; i < WORDS; ++i) {
+            uint64_t bits = w[i];
+            while (bits) {
+                int idx = (i << 6) + std::countr_zero(bits);
+                bits &= bits - 1;
+                func(idx);
+            }
+        }
+    }
+
+    static const Bitboard& pitch();
+    // The 8 on-pitch squares around `p` (p itself excluded). Table lookup.
+    static const Bitboard& adjacent(Position p);
+};
+
+// Chebyshev-radius-1 dilation: every square in or next to `b`.
+Bitboard dilate(const Bitboard& b);
+
+// Squares reachable from `start` in at most `steps` king moves through
+// `passable` squares (start is included even if not passable).
+Bitboard floodFill(Position start, const Bitboard& passable, int steps);
+
+} // namespace bb
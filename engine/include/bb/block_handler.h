@@ -27,5 +27,11 @@ ActionResult resolveMultipleBlock(GameState& state, int attackerId,
 BlockDiceFace autoChooseBlockDie(const BlockDiceFace* faces, int count,
                                  bool attackerChooses,
                                  const Player& att, const Player& def);
+// The same choice from the skills it depends on (bb/block_odds.h tables it).
+BlockDiceFace chooseBlockDie(const BlockDiceFace* faces, int count, bool attackerChooses,
+                             bool attHasBlock, bool defHasBlock, bool defHasDodge,
+                             bool attHasTackle);
+// The chosen face is worth a Pro or team reroll of all the dice.
+bool shouldRerollBlock(BlockDiceFace face, bool attHasBlock);
 
 } // namespace bb
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "bb/game_state.h"
+#include "bb/helpers.h"
+#include "bb/risk_oracle.h"
+#include <array>
+
+namespace bb {
+
+// What a block comes to once its die is chosen and the skills applied.
+enum class BlockOutcome : uint8_t {
+    DEFENDER_DOWN,  // knocked down (pushed first, unless Stand Firm)
+    PUSHED,         // pushed back, still standing
+    STANDOFF,       // nothing: both have Block on Both Down, or Stand Firm holds a push
+    WRESTLED,       // both placed prone, no armour, no turnover
+    BOTH_DOWN,      // both knocked down: turnover
+    ATTACKER_DOWN,  // attacker knocked down alone: turnover
+    COUNT
+};
+
+// The skills a block's outcome depends on.
+struct BlockSkills {
+    bool attBlock = false;
+    bool attWrestle = false;
+    bool attTackle = false;
+    bool defBlock = false;
+    bool defDodge = false;
+    bool defWrestle = false;
+    bool defStandFirm = false;
+};
+
+struct BlockOdds {
+    std::array<float, static_cast<size_t>(BlockOutcome::COUNT)> p{};
+
+    float operator[](BlockOutcome o) const { return p[static_cast<size_t>(o)]; }
+    float defenderDown() const { return (*this)[BlockOutcome::DEFENDER_DOWN] + (*this)[BlockOutcome::BOTH_DOWN]; }
+    float turnover() const { return (*this)[BlockOutcome::BOTH_DOWN] + (*this)[BlockOutcome::ATTACKER_DOWN]; }
+};
+
+// The skills of `att` and `def` that bear on a block between them.
+BlockSkills blockSkills(const Player& att, const Player& def);
+
+// What the chosen `face` comes to with the skills applied (resolveBlock's
+// step 5; Juggernaut aside).
+BlockOutcome blockOutcome(BlockDiceFace face, const BlockSkills& skills);
+
+// The dice `att` rolls blocking `def` where they stand: strength, Horns on
+// a blitz and assists (Dauntless not rolled).
+BlockDiceInfo blockDice(const GameState& state, const Player& att, const Player& def,
+                        bool isBlitz);
+
+// Outcome distribution of a block as resolveBlock plays it: the dice rolled
+// (1-3, `attackerChooses` or not), the face autoChooseBlockDie picks, and
+// a Pro, then team, reroll of all the dice when shouldRerollBlock says so
+// (Loner gating the team reroll). Looked up in a table built on first use
+// over every (dice, chooser, skills, rerolls) combination. Juggernaut,
+// Dauntless and the Foul Appearance / Chainsaw / Stab paths are not modelled.
+const BlockOdds& blockOdds(int dice, bool attackerChooses, const BlockSkills& skills,
+                           RerollAccess rerolls);
+
+// The same for `att` blocking `def` where they stand: strength, Horns on a
+// blitz, assists and the attacker's rerolls as of now.
+const BlockOdds& blockOdds(const GameState& state, const Player& att, const Player& def,
+                           bool isBlitz);
+
+} // namespace bb
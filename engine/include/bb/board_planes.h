@@ -0,0 +1,50 @@
+#pragma once
+
+#include "bb/bitboard.h"
+#include "bb/game_state.h"
+#include "bb/enums.h"
+#include <array>
+#include <cstdint>
+
+namespace bb {
+
+// Spatial input for convolutional nets: NUM_BOARD_PLANES binary planes of
+// 15 x 26 squares, plane-major then row-major (out[c][y][x]). The pitch is
+// seen from `perspective`: x is mirrored for AWAY so "own" always attacks
+// toward x = 25. Counts (tacklezones, MA remaining) are thermometer coded
+// -- plane k is set where the count reaches the level -- so every plane
+// is a bitboard and the packed form loses nothing.
+enum BoardPlane : int {
+    PLANE_OWN_STANDING, PLANE_OWN_PRONE, PLANE_OWN_STUNNED,
+    PLANE_OPP_STANDING, PLANE_OPP_PRONE, PLANE_OPP_STUNNED,
+    PLANE_OWN_TZ_1, PLANE_OWN_TZ_2, PLANE_OWN_TZ_3,   // tacklezones own players exert
+    PLANE_OPP_TZ_1, PLANE_OPP_TZ_2, PLANE_OPP_TZ_3,
+    PLANE_BALL,                                        // ball square, held or loose
+    PLANE_OWN_CARRIER, PLANE_OPP_CARRIER,
+    PLANE_OWN_CAN_ACT,
+    PLANE_OWN_MA_1, PLANE_OWN_MA_3, PLANE_OWN_MA_5, PLANE_OWN_MA_7,  // movementRemaining >= level
+    PLANE_OWN_TURN,                                    // all set when perspective is the active team
+    NUM_BOARD_PLANES
+};
+
+constexpr int BOARD_PLANE_HEIGHT = Position::PITCH_HEIGHT;
+constexpr int BOARD_PLANE_WIDTH = Position::PITCH_WIDTH;
+constexpr int BOARD_PLANE_SIZE = Bitboard::SQUARES;
+// One packed plane: BOARD_PLANE_SIZE bits, LSB first, padded to a byte
+// (numpy.unpackbits(..., count=390, bitorder="little") reverses it).
+constexpr int BOARD_PLANE_BYTES = (BOARD_PLANE_SIZE + 7) / 8;
+
+using BoardPlaneMasks = std::array<Bitboard, NUM_BOARD_PLANES>;
+
+// The planes as bitboards, in perspective coordinates.
+void boardPlaneMasks(const GameState& state, TeamSide perspective, BoardPlaneMasks& out);
+
+// out must hold NUM_BOARD_PLANES * BOARD_PLANE_SIZE values (0 or 1).
+void extractBoardPlanes(const GameState& state, TeamSide perspective, float* out);
+void extractBoardPlanes(const GameState& state, TeamSide perspective, uint8_t* out);
+
+// Bit-packed: out must hold NUM_BOARD_PLANES * BOARD_PLANE_BYTES bytes;
+// about 1 KB per state against 32 KB as floats.
+void extractBoardPlanesPacked(const GameState& state, TeamSide perspective, uint8_t* out);
+
+} // namespace bb
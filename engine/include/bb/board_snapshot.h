@@ -6,6 +6,8 @@
 
 namespace bb {
 
+struct TeamRoster;
+
 // Snapshot of a single player for replay
 struct PlayerSnapshot {
     int id = -1;
@@ -15,9 +17,10 @@ struct PlayerSnapshot {
     std::string name;    // positional name (e.g., "Blitzer")
 };
 
-// Board-only snapshot (players + ball), shared by TurnLog and PolicyDecision
-// so both replay logging and policy-training decision logging capture the
-// same raw per-player state from one implementation.
+// Board-only snapshot (players + ball) of a TurnLog. It is expanded from
+// the compact form below, which PolicyDecision keeps, so replay logging and
+// policy-training decision logging capture the same raw per-player state
+// from one implementation.
 struct BoardSnapshot {
     std::vector<PlayerSnapshot> homePlayers;
     std::vector<PlayerSnapshot> awayPlayers;
@@ -26,6 +29,74 @@ struct BoardSnapshot {
     int ballCarrierId = -1;
 };
 
+// Fixed-size form of BoardSnapshot, taken at every logged search decision:
+// no allocation. Players carry their profile instead of a name; the
+// positional is resolved against the roster at export (positionalIndex).
+struct CompactPlayerSnapshot {
+    uint8_t id = 0;
+    int8_t x = -1, y = -1;
+    uint8_t flags = 0;  // state (as PlayerSnapshot) in bits 0-1, has ball bit 2
+    ProfileId profile = 0;
+
+    uint8_t state() const { return flags & 3; }
+    bool hasBall() const { return flags & 4; }
+};
+static_assert(sizeof(CompactPlayerSnapshot) == 6);
+
+struct CompactBoardSnapshot {
+    static constexpr int MAX_PLAYERS = 22;
+    CompactPlayerSnapshot players[MAX_PLAYERS];  // home players first
+    uint8_t numHome = 0, numAway = 0;
+    int8_t ballX = -1, ballY = -1;
+    bool ballHeld = false;
+    int8_t ballCarrierId = -1;
+    bool captured = false;  // false when board logging was off
+
+    int numPlayers() const { return numHome + numAway; }
+};
+
+CompactBoardSnapshot captureCompactBoardSnapshot(const GameState& state);
+// Unnamed players; names are only known to replay files.
+BoardSnapshot expandBoardSnapshot(const CompactBoardSnapshot& snap);
 BoardSnapshot captureBoardSnapshot(const GameState& state);
 
+// The roster positional a player's profile was built from, or -1 (a
+// profile changed in play, or another roster).
+int positionalIndex(const TeamRoster& roster, ProfileId profile);
+
+// What a board snapshot does not record about its position, supplied
+// with it when the state is rebuilt (a TurnLog's header, say). As a row
+// of COLS integers: half, home_turn, away_turn, active_team, home_score,
+// away_score, home_rerolls, away_rerolls, kicking_team (sides 0 home,
+// 1 away).
+struct SnapshotContext {
+    static constexpr int COLS = 9;
+
+    int half = 1;
+    int homeTurn = 1;
+    int awayTurn = 0;
+    TeamSide activeTeam = TeamSide::HOME;
+    int homeScore = 0;
+    int awayScore = 0;
+    int homeRerolls = 3;
+    int awayRerolls = 3;
+    TeamSide kickingTeam = TeamSide::AWAY;
+
+    static SnapshotContext fromRow(const int16_t* row);
+};
+
+// The state a snapshot was taken from, as far as the snapshot and
+// `context` tell: setupHalf's players for both rosters, those in the
+// snapshot placed as recorded and the rest off the pitch, the ball, and
+// the context's clock, score and rerolls, in PLAY at the start of an
+// activation. Player ids follow setupHalf (home 1-11, away 12-22), so a
+// player's positional follows from its id; a compact snapshot's non-zero
+// profiles override that, which keeps in-game changes. Not recovered:
+// KO and casualty boxes, used actions and movement, weather.
+// Throws std::invalid_argument for an id outside its side's range.
+GameState stateFromSnapshot(const CompactBoardSnapshot& snap, const TeamRoster& home,
+                            const TeamRoster& away, const SnapshotContext& context);
+GameState stateFromSnapshot(const BoardSnapshot& board, const TeamRoster& home,
+                            const TeamRoster& away, const SnapshotContext& context);
+
 } // namespace bb
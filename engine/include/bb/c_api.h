@@ -0,0 +1,85 @@
+#ifndef BB_C_API_H
+#define BB_C_API_H
+
+/*
+ * A stable C ABI over libbb_engine, for foreign-function interfaces (PHP
+ * FFI, ctypes). Plain C types only: states and search engines are opaque
+ * handles, everything else is JSON text in the formats the engine already
+ * speaks:
+ *
+ *   states   stateToJson (state_io.h): enums as integers, player ids 1-22
+ *   actions  {"type": "MOVE", "type_id": 0, "player": 9, "target_player": -1,
+ *             "x": 10, "y": 7}; as input, "type" may be the name or the
+ *            type_id, and absent fields default to -1
+ *   replies  bb_server's move replies (move_server.h moveReplyToJson)
+ *
+ * Returned strings belong to the library and stay valid until the calling
+ * thread's next call into it. Functions that fail return NULL (or a
+ * negative count) and leave a message for bb_last_error(); no C++
+ * exception ever crosses into the caller. A handle may be
+ * used by one thread at a time; distinct handles are independent.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped whenever a signature or a JSON format changes incompatibly */
+#define BB_ABI_VERSION 1
+
+typedef struct bb_state bb_state;
+typedef struct bb_engine bb_engine;
+
+int bb_abi_version(void);
+
+/* Why the calling thread's last failed call failed ("" if none has) */
+const char* bb_last_error(void);
+
+/* States */
+
+/* A new game between two rosters by name (getRosterByName, e.g. "human",
+ * "Orc (TV1200)"), set up with the away team kicking and the kick-off
+ * resolved with `seed`'s dice: the home team's first turn. */
+bb_state* bb_state_new(const char* home_roster, const char* away_roster, uint32_t seed);
+bb_state* bb_state_from_json(const char* json);
+bb_state* bb_state_clone(const bb_state* state);
+void bb_state_free(bb_state* state);
+const char* bb_state_to_json(const bb_state* state);
+
+/* Rules */
+
+/* getAvailableActions(): a JSON array of actions */
+const char* bb_legal_actions(const bb_state* state);
+
+/* Resolve one legal action with `seed`'s dice (executeAction: turnovers
+ * end the turn). A state from bb_state_new knows its rosters and goes on
+ * through touchdowns and half-time to the next kick-off, as the simulator
+ * does; any other stops in the TOUCHDOWN or HALF_TIME phase for the caller.
+ * Answers {"success": b, "turnover": b, "phase": N, "events": [...]}, each
+ * event as
+ * {"type": "dodge", "player", "target", "from": [x, y], "to": [x, y],
+ * "roll", "die1", "die2", "success"}. An illegal or malformed action
+ * leaves the state untouched and returns NULL. */
+const char* bb_execute(bb_state* state, const char* action, uint32_t seed);
+
+/* Macro-MCTS move selection */
+
+/* A search engine: {"weights": PATH, "policy": PATH, "time_ms": N,
+ * "iterations": N, "exploration_c": X, "vf_blend": X, "policy_blend": X,
+ * "seed": N}, every key optional (no weights = heuristic evaluation).
+ * NULL for a malformed config or an unreadable network. */
+bb_engine* bb_engine_new(const char* config);
+void bb_engine_free(bb_engine* engine);
+
+/* Search `state` for its active team: a move reply, whose "actions" holds
+ * the chosen macro's first action (or its whole plan). `options` may be
+ * NULL or {"time_ms": N, "iterations": N, "plan": b, "id": ...}. */
+const char* bb_engine_move(bb_engine* engine, const bb_state* state, const char* options);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* BB_C_API_H */
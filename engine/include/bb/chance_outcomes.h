@@ -0,0 +1,55 @@
+#pragma once
+
+#include "bb/dice.h"
+#include "bb/game_state.h"
+#include "bb/rules_engine.h"
+#include <vector>
+
+namespace bb {
+
+// Serves a scripted prefix of d6 faces, then hands every roll to `inner`.
+// Scripting the dice a handler reads first forces it down one chosen
+// outcome while whatever comes after still rolls normally.
+class OutcomeDiceRoller : public DiceRollerBase {
+    const uint8_t* script_;
+    const uint8_t* next_;
+    const uint8_t* end_;
+    DiceRollerBase& inner_;
+protected:
+    int d6() override { return next_ != end_ ? *next_++ : inner_.rollD6(); }
+    int d8() override { return inner_.rollD8(); }
+public:
+    OutcomeDiceRoller(const uint8_t* script, int length, DiceRollerBase& inner)
+        : script_(script), next_(script), end_(script + length), inner_(inner) {}
+
+    // Script faces served so far.
+    int consumed() const { return static_cast<int>(next_ - script_); }
+};
+
+// One chance outcome of an action: its probability and the d6 prefix that
+// forces it through OutcomeDiceRoller.
+struct ChanceOutcome {
+    static constexpr int MAX_SCRIPT = 10;
+    float probability = 0.0f;
+    uint8_t length = 0;
+    uint8_t script[MAX_SCRIPT] = {};
+};
+
+// Splits `action`, played from `state`, into its chance outcomes:
+//  - BLOCK, or a BLITZ already standing next to its target: the block
+//    outcome classes of block_odds.h, with DEFENDER_DOWN and ATTACKER_DOWN
+//    split further into the fallen player's armour held or broken;
+//  - FOUL: armour held or broken, each with and without doubles.
+// Probabilities come from those tables and the 2d6 armour roll. A class's
+// script is one representative path (all block dice showing one face, a
+// bad face rerolled into itself with Pro or else the team reroll), played
+// on a copy of `state` with `fallback` for the later dice to check that it
+// reaches the class; an armour split whose script does not (a crowd surf
+// rolls no armour) collapses back into its block class. Returns false, `out`
+// empty, for any other action and for paths the tables leave out: Foul
+// Appearance, Chainsaw, Stab, Dauntless, Juggernaut on a blitz and the
+// big guy checks.
+bool enumerateChanceOutcomes(const GameState& state, const Action& action,
+                             DiceRollerBase& fallback, std::vector<ChanceOutcome>& out);
+
+} // namespace bb
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "bb/board_planes.h"
+#include "bb/rules_engine.h"
+#include "bb/simd.h"
+#include "bb/value_function.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+// Small convolutional net over the board planes (board_planes.h): a trunk
+// of 3x3 same-padded conv + ReLU layers, then a value head (global average
+// pool -> dense ReLU layer -> scalar) and a policy head (a 1x1 conv to one
+// logit map per ActionType). Runs natively so search can value leaves
+// without a round trip through Python.
+//
+// Activations are kept in a padded layout: the 15 x 26 board inside a
+// one-square zero border, rows CONV_ROW floats apart. A 3x3 tap is then a
+// fixed flat offset, and one output plane is a single straight run of
+// multiply-adds over the whole board (the border columns inside the run are
+// re-zeroed after the ReLU).
+constexpr int CONV_ROW = BOARD_PLANE_WIDTH + 2;
+constexpr int CONV_PLANE = simdPadded((BOARD_PLANE_HEIGHT + 2) * CONV_ROW);
+constexpr int CONV_INPUT_SIZE = NUM_BOARD_PLANES * BOARD_PLANE_SIZE;
+constexpr int CONV_POLICY_PLANES = static_cast<int>(ActionType::MOVE_PATH) + 1;
+
+struct ConvLayer {
+    int inChannels = 0;
+    int outChannels = 0;
+    std::vector<float> weights;  // [out][in][3][3]
+    std::vector<float> bias;     // [out]
+};
+
+class ConvNet {
+public:
+    // The first layer reads NUM_BOARD_PLANES channels, each later one the
+    // previous layer's output. Value head: W1 [hidden][channels], b1 and
+    // W2 [hidden]. Policy head: W [CONV_POLICY_PLANES][channels] and b
+    // [CONV_POLICY_PLANES]. Throws std::invalid_argument on bad shapes.
+    ConvNet(std::vector<ConvLayer> trunk,
+            std::vector<float> valueW1, std::vector<float> valueB1,
+            std::vector<float> valueW2, float valueB2,
+            std::vector<float> policyW, std::vector<float> policyB);
+
+    int channels() const { return trunk_.back().outChannels; }
+    int valueHidden() const { return static_cast<int>(valueB1_.size()); }
+
+    // Value of one row of CONV_INPUT_SIZE plane floats (extractBoardPlanes).
+    float value(const float* planes) const;
+    // `batch` rows -> `batch` values, sharing one set of activation buffers.
+    void values(const float* planes, int batch, float* out) const;
+    // Raw policy logits for `numActions` actions of the position `planes`
+    // encodes from `perspective` (action targets are mirrored to match).
+    // An action's logit is its type's map at the target square, or its
+    // type's weights over the pooled trunk when it has no target.
+    void policyLogits(const float* planes, TeamSide perspective, const Action* actions,
+                      int numActions, float* out) const;
+
+private:
+    std::vector<ConvLayer> trunk_;
+    std::vector<float> valueW1_, valueB1_, valueW2_;
+    float valueB2_;
+    std::vector<float> policyW_, policyB_;
+    int maxChannels_ = NUM_BOARD_PLANES;
+
+    // Runs the trunk; returns the final activations (channels() padded
+    // planes) inside the calling thread's scratch buffer.
+    const float* forward(const float* planes) const;
+    void pool(const float* act, float* out) const;
+    float valueHead(const float* pooled) const;
+    friend struct ConvNetAccess;
+};
+
+class ConvValueFunction : public ValueFunction {
+    std::shared_ptr<const ConvNet> net_;
+public:
+    explicit ConvValueFunction(std::shared_ptr<const ConvNet> net);
+    // `numFeatures` must be CONV_INPUT_SIZE (board planes, not the scalar
+    // features); throws std::invalid_argument otherwise.
+    float evaluate(const float* planes, int numFeatures) const override;
+    void evaluateBatch(const float* planes, int batch, int numFeatures, float* out) const override;
+    int inputSize() const override { return CONV_INPUT_SIZE; }
+    void encodeState(const GameState& state, TeamSide perspective, float* out) const override;
+    const std::shared_ptr<const ConvNet>& net() const { return net_; }
+};
+
+class ConvPolicyNetwork {
+    std::shared_ptr<const ConvNet> net_;
+    float temperature_;
+public:
+    explicit ConvPolicyNetwork(std::shared_ptr<const ConvNet> net, float temperature = 1.0f);
+    // Softmax priors over `actions` for the team on turn in `state`.
+    void computePriors(const GameState& state, const Action* actions, int numActions,
+                       float* outPriors) const;
+    float temperature() const { return temperature_; }
+    void setTemperature(float t) { temperature_ = t; }
+};
+
+// Binary conv weights file: a ConvFileHeader, then float arrays packed in
+// this order, in host byte order:
+//   per trunk layer: weights [out][in][3][3], bias [out]
+//   value head:      W1 [hidden][channels], b1 [hidden], W2 [hidden]
+//   policy head:     W [CONV_POLICY_PLANES][channels], b [CONV_POLICY_PLANES]
+// Layer l reads NUM_BOARD_PLANES channels if l == 0, else `channels`.
+constexpr uint32_t CONV_FILE_MAGIC = 0x4E434242;  // "BBCN"
+constexpr uint32_t CONV_FILE_VERSION = 1;
+
+struct ConvFileHeader {
+    uint32_t magic = CONV_FILE_MAGIC;
+    uint32_t version = CONV_FILE_VERSION;
+    int32_t inputPlanes = NUM_BOARD_PLANES;
+    int32_t layers = 0;
+    int32_t channels = 0;
+    int32_t valueHidden = 0;
+    int32_t policyPlanes = CONV_POLICY_PLANES;
+    float valueB2 = 0.0f;
+};
+
+// True if `path` starts with the conv weights magic.
+bool isConvNetFile(const std::string& path);
+// nullptr if the file is missing, truncated or shaped for other planes.
+std::shared_ptr<const ConvNet> loadConvNet(const std::string& path);
+bool writeConvNet(const std::string& path, const ConvNet& net);
+
+} // namespace bb
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "bb/game_state.h"
+#include "bb/macro_actions.h"
+#include "bb/mcts.h"
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+class MacroMCTSSearch;
+
+// Reproducers for slow decisions. When a search runs long, everything it
+// started from is written to one JSON file: the position, the search
+// settings, the search object's dice as the search began, the networks it
+// ran on (path and content key) and what the search reported. Replaying
+// the file (replayDecision, mcts_cli --replay-decision) runs the same
+// search again, for a profiler or a debugger.
+//
+// The replay is the original search, iteration for iteration, when that
+// search was serial (numThreads 1), began on a fresh tree (reusedVisits 0)
+// and kept no transposition table (ttMemoryMB 0); a replay runs on a new
+// search object, so nothing an earlier search left behind carries over.
+// Otherwise it is a search of the same position under the same settings.
+struct DecisionCapture {
+    std::string reason;          // why it was captured, e.g. "2150 ms over 1000 ms"
+    GameState state;
+    MCTSConfig config;           // the searchParameters (sweep.h) in effect; no networks or caches
+    uint32_t seed = 0;           // the search object's construction seed
+    std::vector<uint8_t> dice;   // serializeDice of its roller as the search began
+    std::string valuePath;       // networks searched ("" = none)
+    std::string policyPath;
+    uint64_t modelKey = 0;       // rootCacheModelKey({valuePath, policyPath}) at capture
+    uint64_t modelVersion = 0;   // ModelHandle::version() (live models)
+    int reusedVisits = 0;        // MacroMCTSSearch::lastReusedVisits()
+    Macro macro;                 // the search's choice
+    double searchMs = 0.0;
+    SearchStats stats;
+};
+
+// Fill searchMs, stats and reusedVisits of `capture` from `search`, which
+// has just searched `capture.state` (the caller sets the macro it chose).
+void recordDecisionOutcome(DecisionCapture& capture, const MacroMCTSSearch& search, double searchMs);
+
+std::string decisionCaptureToJson(const DecisionCapture& capture);
+// nullopt for malformed JSON, a damaged state or dice record, or an
+// unknown search setting.
+std::optional<DecisionCapture> decisionCaptureFromJson(const std::string& json);
+bool saveDecisionCapture(const DecisionCapture& capture, const std::string& path);
+std::optional<DecisionCapture> loadDecisionCapture(const std::string& path);
+
+// When a decision counts as slow. Both tests are off at 0.
+struct SlowDecisionConfig {
+    std::string dir;              // where captures go; empty = capture nothing
+    double thresholdMs = 0.0;     // a search longer than this
+    // A search whose time per iteration is this many times the running
+    // mean of the decisions before it (a stall rather than a big budget).
+    // The mean needs `warmup` decisions first.
+    double outlierFactor = 0.0;
+    int warmup = 32;
+    int maxCaptures = 100;        // per monitor, so a slow model cannot fill the disk
+};
+
+// Decides which decisions to capture and writes them. Thread-safe: one
+// monitor serves all of a server's workers.
+class SlowDecisionMonitor {
+public:
+    explicit SlowDecisionMonitor(SlowDecisionConfig config);
+
+    bool enabled() const { return !config_.dir.empty() && (config_.thresholdMs > 0.0 || config_.outlierFactor > 0.0); }
+    // Record a finished search; the reason to capture it, or "" if it is
+    // not slow (or the capture limit is reached).
+    std::string observe(double searchMs, int iterations);
+    // Write `capture` as DIR/decision-<time>-<N>.json, creating DIR; its
+    // path, or "" if the file could not be written.
+    std::string write(const DecisionCapture& capture);
+    int captures() const;
+
+private:
+    SlowDecisionConfig config_;
+    mutable std::mutex mutex_;
+    double meanMsPerIteration_ = 0.0;
+    int observed_ = 0;
+    int captures_ = 0;
+    int written_ = 0;
+};
+
+struct DecisionReplay {
+    Macro macro;
+    int iterations = 0;
+    double searchMs = 0.0;
+    SearchStats stats;
+    bool sameMacro = false;      // the replay chose the captured macro
+};
+
+// Search `capture.state` again on a new MacroMCTSSearch with the captured
+// settings and dice, the given networks (normally those at capture.valuePath
+// and policyPath) and no root cache. With `sameIterations` (and a captured
+// iteration count) the budget is that count and no time limit, so a
+// replay under a profiler does the captured amount of work however slowly
+// it runs; otherwise the captured budget applies.
+DecisionReplay replayDecision(const DecisionCapture& capture, const ValueFunction* valueFn,
+                              const PolicyNetwork* policy, bool sameIterations = true);
+
+} // namespace bb
@@ -7,13 +7,87 @@
 
 namespace bb {
 
+// xoshiro256** (Blackman & Vigna): 32 bytes of state, a few cycles per
+// draw, and bounded faces by Lemire's multiply-shift with rejection, so
+// every face is exactly equally likely. Seeding hashes the arguments with
+// splitmix64, which makes streams counter-based: any (seed, game,
+// decision, thread) tuple names an independent stream that can be
+// derived anywhere without coordination, so a game replays exactly no
+// matter which worker or how many threads ran it.
+struct Xoshiro256 {
+    uint64_t s[4] = {};
+
+    void seed(uint64_t seed, uint64_t gameId, uint64_t decisionId, uint64_t threadId);
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+    // Uniform in [0, n)
+    uint32_t bounded(uint32_t n) {
+        uint64_t m = (next() >> 32) * n;
+        uint32_t low = static_cast<uint32_t>(m);
+        if (low < n) {
+            uint32_t threshold = (0u - n) % n;
+            while (low < threshold) {
+                m = (next() >> 32) * n;
+                low = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+};
+
+// How the table-driven handlers resolve: Sampled rolls the dice; Expected
+// takes each roll's typical outcome instead and emits no events, for
+// rollouts that only need a plausible leaf state. Covered: armour and
+// injury (injury.h), ball bounces and throw-ins (ball_handler.h).
+enum class ResolutionMode : uint8_t { Sampled, Expected };
+
+// Dice source taken by every rules handler. The roll functions are not
+// virtual: a roller backed by the inline xoshiro generator (FastDiceRoller)
+// is served by a flag test and an inlined draw, so self-play dice cost no
+// indirect call. Other rollers (DiceRoller, FixedDiceRoller for scripted
+// tests) implement the virtual d6()/d8() the roll functions fall back to.
 class DiceRollerBase {
+protected:
+    Xoshiro256 gen_;
+    bool inlineGen_ = false;
+    ResolutionMode mode_ = ResolutionMode::Sampled;
+
+    virtual int d6() = 0;
+    virtual int d8() = 0;
+    int rollIndexFromD6(int n);
 public:
     virtual ~DiceRollerBase() = default;
-    virtual int rollD6() = 0;
-    virtual int rollD8() = 0;
-    virtual int roll2D6() { return rollD6() + rollD6(); }
-    virtual BlockDiceFace rollBlockDie() {
+
+    // Generator state for checkpoints (bb/state_io.h frames it): appended
+    // to `out`, or read back from [in, end) with `in` advanced. Rollers
+    // that cannot be saved (scripted, recording) return false.
+    virtual bool saveState(std::vector<uint8_t>& out) const;
+    virtual bool restoreState(const uint8_t*& in, const uint8_t* end);
+
+    int rollD6() { return inlineGen_ ? 1 + static_cast<int>(gen_.bounded(6)) : d6(); }
+    int rollD8() { return inlineGen_ ? 1 + static_cast<int>(gen_.bounded(8)) : d8(); }
+    int roll2D6() { return rollD6() + rollD6(); }
+    ResolutionMode resolutionMode() const { return mode_; }
+    void setResolutionMode(ResolutionMode mode) { mode_ = mode; }
+    // Uniform in [0, n) for samplers (rollout policies). Rollers without the
+    // inline generator build it from d6 digits with rejection, so scripted
+    // dice still give exactly uniform picks.
+    int rollIndex(int n) {
+        return inlineGen_ ? static_cast<int>(gen_.bounded(static_cast<uint32_t>(n)))
+                          : rollIndexFromD6(n);
+    }
+    BlockDiceFace rollBlockDie() {
         int roll = rollD6();
         switch (roll) {
             case 1: return BlockDiceFace::ATTACKER_DOWN;
@@ -25,14 +99,93 @@ public:
     }
 };
 
+// Puts a roller in `mode` for a scope, restoring the previous mode after.
+class ResolutionScope {
+    DiceRollerBase& dice_;
+    ResolutionMode previous_;
+public:
+    ResolutionScope(DiceRollerBase& dice, ResolutionMode mode)
+        : dice_(dice), previous_(dice.resolutionMode()) {
+        dice.setResolutionMode(mode);
+    }
+    ~ResolutionScope() { dice_.setResolutionMode(previous_); }
+    ResolutionScope(const ResolutionScope&) = delete;
+    ResolutionScope& operator=(const ResolutionScope&) = delete;
+};
+
 class DiceRoller : public DiceRollerBase {
     std::mt19937 rng_;
+protected:
+    int d6() override;
+    int d8() override;
 public:
     explicit DiceRoller(uint32_t seed);
     DiceRoller();  // uses random_device
 
-    int rollD6() override;
-    int rollD8() override;
+    bool saveState(std::vector<uint8_t>& out) const override;
+    bool restoreState(const uint8_t*& in, const uint8_t* end) override;
+};
+
+// Roller on the inline xoshiro256** path.
+class FastDiceRoller : public DiceRollerBase {
+protected:
+    int d6() override { return 1 + static_cast<int>(gen_.bounded(6)); }
+    int d8() override { return 1 + static_cast<int>(gen_.bounded(8)); }
+public:
+    explicit FastDiceRoller(uint64_t seed, uint64_t gameId = 0,
+                            uint64_t decisionId = 0, uint64_t threadId = 0) {
+        gen_.seed(seed, gameId, decisionId, threadId);
+        inlineGen_ = true;
+    }
+
+    uint64_t next() { return gen_.next(); }
+
+    bool saveState(std::vector<uint8_t>& out) const override;
+    bool restoreState(const uint8_t*& in, const uint8_t* end) override;
+};
+
+// Serves faces from blocks of BLOCK pre-generated d6 and d8 results, so the
+// generator runs in bulk with its state in registers instead of once per
+// roll. Blocks come from LANES interleaved xoshiro256** streams (AVX2 when
+// built for it, the same lanes in scalar code otherwise, so a seed rolls
+// identically on every build), cut into bytes: a d6 face is byte % 6 with
+// bytes >= 252 rejected, keeping all six faces exactly equally likely; a d8
+// face is the low three bits. Rolls reach the blocks through the virtual
+// d6()/d8(), keeping DiceRollerBase free of buffer state; the search stays
+// on FastDiceRoller.
+class BufferedDiceRoller : public DiceRollerBase {
+public:
+    static constexpr int BLOCK = 4096;
+    static constexpr int LANES = 4;
+
+    explicit BufferedDiceRoller(uint64_t seed, uint64_t gameId = 0,
+                                uint64_t decisionId = 0, uint64_t threadId = 0);
+    BufferedDiceRoller(const BufferedDiceRoller& other);
+    BufferedDiceRoller& operator=(const BufferedDiceRoller& other);
+
+    bool saveState(std::vector<uint8_t>& out) const override;
+    bool restoreState(const uint8_t*& in, const uint8_t* end) override;
+
+protected:
+    int d6() override { return d6Next_ != d6End_ ? *d6Next_++ : refillD6(); }
+    int d8() override { return d8Next_ != d8End_ ? *d8Next_++ : refillD8(); }
+
+private:
+    alignas(32) uint64_t lanes_[4][LANES];  // [state word][lane]
+    uint8_t d6Buf_[BLOCK];
+    uint8_t d8Buf_[BLOCK];
+    // Faces still to serve in each block
+    const uint8_t* d6Next_ = nullptr;
+    const uint8_t* d6End_ = nullptr;
+    const uint8_t* d8Next_ = nullptr;
+    const uint8_t* d8End_ = nullptr;
+
+    // `count` (a multiple of LANES) raw words, lane-interleaved.
+    void generate(uint64_t* out, int count);
+    // Block exhausted: fill the next one and serve its first face.
+    int refillD6();
+    int refillD8();
+    void rebase(const BufferedDiceRoller& other);
 };
 
 class FixedDiceRoller : public DiceRollerBase {
@@ -40,12 +193,12 @@ class FixedDiceRoller : public DiceRollerBase {
     size_t index_ = 0;
 
     int next();
+protected:
+    int d6() override;
+    int d8() override;
 public:
     explicit FixedDiceRoller(std::vector<int> rolls);
 
-    int rollD6() override;
-    int rollD8() override;
-
     size_t remaining() const { return rolls_.size() - index_; }
 };
 
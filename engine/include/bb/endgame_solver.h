@@ -0,0 +1,73 @@
+#pragma once
+
+#include "bb/game_state.h"
+#include "bb/macro_actions.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace bb {
+
+// Exact touchdown odds for the active team's scoring lines on its last turn
+// of a half, where a sampled search at a few hundred iterations is noisy and
+// nothing but the touchdown counts. Each scoring macro (SCORE,
+// HAND_OFF_SCORE, PASS_SCORE, CHAIN_SCORE, BLITZ_AND_SCORE) is replayed
+// through greedyExpandMacro once per dice sequence, enumerating every face
+// of every die it rolls -- dodges, GFIs, pickups, passes, catches and the
+// rerolls the rules engine takes on its own -- so a line's probability is
+// exact for the way the engine plays it. Dice rolled once the outcome is
+// settled (a touchdown scored, or a turnover's armour and bounce rolls) are
+// not branched on. A line that ends the macro with the
+// turn still alive continues with the best scoring line from there, up to
+// maxDepth macros; those positions are memoized by GameState::hash() and
+// the memo is kept across solve() calls (the next decision of the same turn
+// is usually one of them). Work is capped at maxReplays expansions per
+// solve(): dice sequences left unexplored count as failures in the lower
+// bound and as touchdowns in the upper one.
+class EndgameSolver {
+public:
+    struct Config {
+        int maxReplays = 20000;  // macro expansions per solve()
+        int maxDepth = 2;        // scoring macros chained in one line
+        int maxDice = 24;        // dice per expansion before a sequence is left unexplored
+        size_t maxMemo = 1 << 16;  // memoized positions before the memo is cleared
+    };
+
+    struct Line {
+        Macro macro;
+        double pTouchdown = 0.0;  // lower bound; exact when `exact`
+        double pUpper = 0.0;
+        bool exact = false;
+    };
+
+    EndgameSolver() = default;
+    explicit EndgameSolver(Config config) : config_(config) {}
+
+    // The active team is in play on its last turn of the half.
+    static bool applies(const GameState& state);
+    static bool isScoringMacro(MacroType type);
+
+    // The active team's scoring lines, most likely touchdown first (ties in
+    // generation order). Empty when it has none.
+    std::vector<Line> solve(const GameState& state);
+
+    void clear() { memo_.clear(); }
+    size_t memoSize() const { return memo_.size(); }
+    int lastReplays() const { return replays_; }
+    const Config& config() const { return config_; }
+
+private:
+    struct Bounds {
+        double lo = 0.0;
+        double hi = 0.0;
+    };
+
+    Bounds solveState(const GameState& state, int depth);
+    Bounds solveLine(const GameState& state, const Macro& macro, int depth);
+
+    Config config_;
+    std::unordered_map<uint64_t, Bounds> memo_;  // (hash, depth) -> best line
+    int replays_ = 0;
+};
+
+} // namespace bb
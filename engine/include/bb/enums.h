@@ -46,9 +46,22 @@ enum class ActionType : uint8_t {
     MOVE, BLOCK, BLITZ, PASS, HAND_OFF, FOUL,
     THROW_TEAM_MATE, BOMB_THROW, HYPNOTIC_GAZE,
     BALL_AND_CHAIN, MULTIPLE_BLOCK,
-    END_TURN, SETUP_PLAYER, END_SETUP
+    END_TURN, SETUP_PLAYER, END_SETUP,
+    MOVE_PATH  // walk to target along the pathfinder's route, one step at a time
 };
 
+// Enumerator name, for logs and traces.
+inline const char* actionTypeName(ActionType t) {
+    static constexpr const char* names[] = {
+        "MOVE", "BLOCK", "BLITZ", "PASS", "HAND_OFF", "FOUL",
+        "THROW_TEAM_MATE", "BOMB_THROW", "HYPNOTIC_GAZE",
+        "BALL_AND_CHAIN", "MULTIPLE_BLOCK",
+        "END_TURN", "SETUP_PLAYER", "END_SETUP",
+        "MOVE_PATH",
+    };
+    return names[static_cast<int>(t)];
+}
+
 inline bool requiresPlayer(ActionType t) {
     switch (t) {
         case ActionType::END_TURN:
@@ -165,7 +178,7 @@ inline int passModifier(PassRange r) {
     return 0;
 }
 
-inline PassRange passRangeFromDistance(int dist) {
+constexpr PassRange passRangeFromDistance(int dist) {
     if (dist <= 3)  return PassRange::QUICK_PASS;
     if (dist <= 6)  return PassRange::SHORT_PASS;
     if (dist <= 10) return PassRange::LONG_PASS;
@@ -11,4 +11,9 @@ constexpr int NUM_FEATURES = 73;  // fix #3: +3 loose-ball field-position featur
 // out must point to at least NUM_FEATURES floats.
 void extractFeatures(const GameState& state, TeamSide perspective, float* out);
 
+// extractFeatures for n states: state i from persp[i]'s perspective into
+// out[i * NUM_FEATURES, (i + 1) * NUM_FEATURES). One native call for
+// offline relabelling and batched leaf evaluation.
+void extractFeaturesBatch(const GameState* states, int n, const TeamSide* persp, float* out);
+
 } // namespace bb
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "bb/board_snapshot.h"
+#include "bb/game_log_columns.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+struct TeamRoster;
+
+// Named state encoders, so offline tools can run any of them over a
+// logged corpus. "features" (extractFeatures) and "board_planes"
+// (extractBoardPlanes, as floats) are built in; research code registers
+// candidate sets next to them and evaluates them on existing logs without
+// new self-play.
+struct FeatureSet {
+    std::string name;
+    int size = 0;  // floats per state
+    std::function<void(const GameState& state, TeamSide perspective, float* out)> extract;
+};
+
+// Adds `set`, replacing one of the same name. Throws std::invalid_argument
+// for an empty name, a size below 1 or no extractor.
+void registerFeatureSet(FeatureSet set);
+// nullptr if no set has that name.
+std::shared_ptr<const FeatureSet> findFeatureSet(const std::string& name);
+std::vector<std::string> featureSetNames();  // sorted
+
+// Rebuild every board of `boards` (stateFromSnapshot) and encode it with
+// `set` from its perspective into out[k * set.size, (k + 1) * set.size),
+// on `threads` workers. `contexts` and `perspectives` hold one entry per
+// board or a single entry for all. Throws std::invalid_argument for
+// malformed boards (BoardColumnsView::validate) or mismatched lengths.
+void featurizeBoards(const FeatureSet& set, const BoardColumnsView& boards,
+                     const std::vector<SnapshotContext>& contexts,
+                     const std::vector<TeamSide>& perspectives,
+                     const TeamRoster& home, const TeamRoster& away, int threads, float* out);
+
+} // namespace bb
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "bb/game_simulator.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+// Board snapshots flattened into row arrays. Snapshot k owns player rows
+// [playerOffsets[k], playerOffsets[k + 1]).
+struct BoardColumns {
+    static constexpr int PLAYER_COLS = 6;  // side (0 home, 1 away), id, x, y, state, has_ball
+    static constexpr int BALL_COLS = 4;    // x, y, held, carrier_id
+
+    std::vector<int8_t> players;         // [rows][PLAYER_COLS]
+    std::vector<int32_t> playerOffsets{0};  // [snapshots + 1]
+    std::vector<int8_t> ball;            // [snapshots][BALL_COLS]
+
+    void append(const std::vector<PlayerSnapshot>& home, const std::vector<PlayerSnapshot>& away,
+                int ballX, int ballY, bool ballHeld, int ballCarrierId);
+    // An uncaptured board appends a snapshot with no players.
+    void append(const CompactBoardSnapshot& board);
+};
+
+// BoardColumns' arrays borrowed from elsewhere (a BoardColumns, or arrays
+// handed in from numpy), for reading a corpus back.
+struct BoardColumnsView {
+    const int8_t* players = nullptr;        // [rows][PLAYER_COLS]
+    const int32_t* playerOffsets = nullptr; // [boards + 1]
+    const int8_t* ball = nullptr;           // [boards][BALL_COLS]
+    size_t boards = 0;
+
+    static BoardColumnsView of(const BoardColumns& columns);
+    // Board k in compact form (no profiles: stateFromSnapshot takes the
+    // positional from the id).
+    CompactBoardSnapshot compact(size_t k) const;
+    // Empty if every board is well formed: offsets ascending from 0,
+    // home rows before away rows, at most 11 players a side, ids in their
+    // side's range (1-11 home, 12-22 away).
+    std::string validate() const;
+};
+
+// Columnar copy of a LoggedGameResult: each field of the per-state,
+// per-decision and per-turn logs in one contiguous array, so bindings
+// can hand the arrays out as buffers instead of building an object per
+// element. Variable-length parts (visits, events, board players) are
+// flattened with offset arrays of length count + 1.
+struct GameLogColumns {
+    static constexpr int TURN_COLS = 7;   // half, turn, active_team, home_score, away_score,
+                                          // turnover, touchdown
+    static constexpr int EVENT_COLS = 11; // type, player_id, target_id, from_x, from_y,
+                                          // to_x, to_y, roll, success, die1, die2
+
+    // States, one row each
+    std::vector<float> stateFeatures;      // [states][NUM_FEATURES]
+    std::vector<uint8_t> statePerspective; // [states], 0 = home, 1 = away
+
+    // Policy decisions
+    std::vector<float> decisionFeatures;      // [decisions][NUM_FEATURES]
+    std::vector<uint8_t> decisionPerspective; // [decisions]
+    std::vector<uint64_t> decisionHash;       // [decisions]
+    std::vector<int32_t> visitOffsets;        // [decisions + 1]
+    std::vector<float> visitActionFeatures;   // [visits][NUM_ACTION_FEATURES]
+    std::vector<float> visitFractions;        // [visits]
+    BoardColumns decisionBoards;
+
+    // Turn logs
+    std::vector<int16_t> turns;          // [turns][TURN_COLS]
+    std::vector<int32_t> eventOffsets;   // [turns + 1]
+    std::vector<int16_t> events;         // [events][EVENT_COLS]
+    BoardColumns turnBoards;
+
+    size_t numStates() const { return statePerspective.size(); }
+    size_t numDecisions() const { return decisionPerspective.size(); }
+    size_t numTurns() const { return eventOffsets.empty() ? 0 : eventOffsets.size() - 1; }
+};
+
+GameLogColumns toColumns(const LoggedGameResult& logged);
+
+} // namespace bb
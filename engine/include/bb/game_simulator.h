@@ -17,6 +17,9 @@ struct GameResult {
     int homeScore = 0;
     int awayScore = 0;
     int totalActions = 0;
+    double homePolicyMs = 0.0;  // wall time spent choosing actions, per side
+    double awayPolicyMs = 0.0;
+    bool adjudicated = false;   // stopped once the winner was settled (outcomeDecided): the margin is not final
 };
 
 // Set up 11 players per team in formation, initialize team state
@@ -36,11 +39,39 @@ void simpleKickoff(GameState& state, DiceRollerBase& dice);
 // Action selector: given a game state, return an action to execute
 using ActionSelector = std::function<Action(const GameState&)>;
 
+// Touchdowns either side can at most still score from `state` under the
+// simple kickoff. Every drive after the current one starts with a kickoff
+// that uses up a turn of its receiver, and a half ends with the first turn
+// past 8, so a half has room for two touchdowns more than its teams' turns
+// left.
+int maxTouchdownsLeft(const GameState& state);
+// The leader's lead exceeds maxTouchdownsLeft: the winner is settled.
+// Never true of a level score.
+bool outcomeDecided(const GameState& state);
+
 // Run a complete game with action selectors for each team
 // useFullKickoff: if true, use resolveKickoff() with full kickoff events
+// adjudicate: stop once outcomeDecided() (GameResult::adjudicated), for
+// runs that only need the winner. Ignored with useFullKickoff, whose Riot
+// can hand out extra turns.
 GameResult simulateGame(const TeamRoster& home, const TeamRoster& away,
                         ActionSelector homePolicy, ActionSelector awayPolicy,
-                        DiceRollerBase& dice, bool useFullKickoff = false);
+                        DiceRollerBase& dice, bool useFullKickoff = false,
+                        bool adjudicate = false);
+
+enum class PlayUntil : uint8_t {
+    DRIVE_END,  // the next touchdown, half-time or game end
+    GAME_END,
+};
+
+// Play on from `state` (any point of a game between `home` and `away`),
+// restarting drives and halves as simulateGame() does. Stops at `until`,
+// leaving `state` there; the result holds the scores then and the actions
+// played here.
+GameResult continueGame(GameState& state, const TeamRoster& home, const TeamRoster& away,
+                        ActionSelector homePolicy, ActionSelector awayPolicy,
+                        DiceRollerBase& dice, PlayUntil until, bool useFullKickoff = false,
+                        bool adjudicate = false);
 
 // Logged game result with features for training
 struct StateLog {
@@ -48,7 +79,9 @@ struct StateLog {
     TeamSide perspective;
 };
 
-// Turn-level replay log
+// Turn-level replay log. Its events are a range of the event arena of the
+// log it belongs to (LoggedGameResult::events, or the vector handed to the
+// call that produced it); turnEvents() resolves them.
 struct TurnLog {
     int half = 0;
     int turnNumber = 0;
@@ -63,23 +96,112 @@ struct TurnLog {
     bool ballHeld = false;
     int ballCarrierId = -1;
 
-    // Events that happened during this turn
-    std::vector<GameEvent> events;
+    // Events that happened during this turn: arena[firstEvent, firstEvent + numEvents)
+    uint32_t firstEvent = 0;
+    uint32_t numEvents = 0;
 
     // Summary flags
     bool turnover = false;
     bool touchdown = false;
 };
 
+// A turn's events, as a view of the arena they live in.
+struct EventRange {
+    const GameEvent* first = nullptr;
+    const GameEvent* last = nullptr;
+    const GameEvent* begin() const { return first; }
+    const GameEvent* end() const { return last; }
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+    const GameEvent& operator[](size_t i) const { return first[i]; }
+};
+
+inline EventRange turnEvents(const std::vector<GameEvent>& arena, const TurnLog& turn) {
+    const GameEvent* first = arena.data() + turn.firstEvent;
+    return {first, first + turn.numEvents};
+}
+
+// Event-sourced record of a game: everything replayGame() needs to re-run
+// it exactly. The rules' dice are kept as the faces they drew rather than a
+// seed and stream position, because the random, greedy and learning AIs
+// draw from the same roller, so the engine's share of the stream cannot be
+// recovered from the seed alone. A game is a few KB this way.
+struct GameRecord {
+    TeamRoster home{};
+    TeamRoster away{};
+    bool useFullKickoff = false;
+    bool adjudicate = false;      // played with adjudication: a replay stops where the game did
+    std::vector<Action> actions;  // every policy choice, in order
+    std::vector<uint8_t> dice;    // every d6/d8 face drawn by the rules, in order
+};
+
 struct LoggedGameResult {
     GameResult result;
     std::vector<StateLog> states;
     std::vector<PolicyDecision> policyDecisions;  // MCTS visit distributions for policy training
     std::vector<TurnLog> turnLogs;  // Turn-by-turn replay data
+    std::vector<GameEvent> events;  // event arena: every turn's events, back to back
+    GameRecord record;              // Always filled
+    // What each record.actions entry's policy call searched (FULL: its
+    // decision was eligible for policyDecisions); simulateGameLogged only
+    std::vector<DecisionSearch> decisionSearches;
+};
+
+enum class GameLogMode : uint8_t {
+    FULL,         // states, turn logs and the record
+    RECORD_ONLY,  // the record only; replayGame() regenerates the rest
 };
 
+// adjudicate as for simulateGame().
 LoggedGameResult simulateGameLogged(const TeamRoster& home, const TeamRoster& away,
                                     ActionSelector homePolicy, ActionSelector awayPolicy,
-                                    DiceRollerBase& dice, bool useFullKickoff = false);
+                                    DiceRollerBase& dice, bool useFullKickoff = false,
+                                    GameLogMode mode = GameLogMode::FULL, bool adjudicate = false);
+
+// Position in a game being simulated: the state plus the logging loop's
+// bookkeeping, so a replay can resume from a copy.
+struct GameCursor {
+    GameState state;
+    int totalActions = 0;
+    int turns = 0;                   // turns started so far
+    TeamSide lastActiveTeam = TeamSide::HOME;
+    int lastTurnNumber = 0;
+    size_t nextAction = 0;           // replay position in GameRecord::actions
+    size_t nextDie = 0;              // and in GameRecord::dice
+    bool adjudicated = false;        // the run stopped at outcomeDecided()
+};
+
+// Re-run a recorded game, regenerating its states and turn logs (policy
+// decisions and timings are not recorded). Throws std::runtime_error if
+// the record runs out of actions or dice before the game ends.
+LoggedGameResult replayGame(const GameRecord& record);
+
+// Random access into a recorded game. The constructor replays it once,
+// keeping a cursor at the start of every `checkpointInterval`-th turn;
+// each query then re-simulates from the nearest checkpoint at or before
+// the turn it asks for.
+class GameReplayer {
+public:
+    explicit GameReplayer(GameRecord record, int checkpointInterval = 4);
+
+    int numTurns() const { return numTurns_; }
+    const GameResult& result() const { return result_; }
+    const GameRecord& record() const { return record_; }
+
+    // The state as turn `turn` starts (the state its TurnLog snapshots).
+    GameState stateAtTurn(int turn) const;
+    // The turn's log; `events` is replaced by its events, which the log
+    // ranges over.
+    TurnLog turnLog(int turn, std::vector<GameEvent>& events) const;
+    StateLog stateLog(int turn) const;
+    BoardSnapshot board(int turn) const { return captureBoardSnapshot(stateAtTurn(turn)); }
+
+private:
+    GameRecord record_;
+    int interval_;
+    int numTurns_ = 0;
+    GameResult result_;
+    std::vector<GameCursor> checkpoints_;  // checkpoints_[k] starts turn k * interval_
+};
 
 } // namespace bb
@@ -4,11 +4,40 @@
 #include "bb/player.h"
 #include "bb/team_state.h"
 #include "bb/ball_state.h"
+#include "bb/bitboard.h"
 #include <array>
+#include <cstdint>
 #include <functional>
 
 namespace bb {
 
+// Per-team sums over players that extractFeatures() reads, kept up to date
+// by GameState's mutators alongside the occupancy index, so feature
+// extraction does not rescan players' stats and skills at every leaf.
+// Counters are modular: add() with -1 then +1 restores them exactly.
+struct FeatureAccumulator {
+    uint8_t standing = 0;
+    uint8_t ko = 0;
+    uint8_t injured = 0;       // INJURED or DEAD
+    uint8_t down = 0;          // PRONE or STUNNED
+    uint8_t regeneration = 0;  // any state
+    // Over standing players only:
+    uint8_t sideline = 0;      // on y = 0 or 14
+    uint8_t strength = 0;
+    uint8_t armour = 0;
+    uint8_t agility = 0;
+    uint8_t block = 0;
+    uint8_t dodge = 0;
+    uint8_t guard = 0;
+    uint8_t mightyBlow = 0;
+    uint8_t claw = 0;
+    uint16_t x = 0;            // sum of positions' x
+
+    // Count `p` in (delta = +1) or out (delta = -1).
+    void add(const Player& p, int delta);
+    bool operator==(const FeatureAccumulator&) const = default;
+};
+
 class GameState {
 public:
     int half = 1;
@@ -34,10 +63,78 @@ public:
     Player& getPlayer(int id);
     const Player& getPlayer(int id) const;
 
-    // Find player at position, or nullptr
+    // Find player at position, or nullptr. O(1): reads the occupancy index.
     Player* getPlayerAtPosition(Position pos);
     const Player* getPlayerAtPosition(Position pos) const;
 
+    // Player mutators that keep the occupancy index in sync. Rules code must
+    // move, place, push or remove players through these rather than assigning
+    // Player::position / Player::state directly.
+    void movePlayer(Player& p, Position to);
+    void setPlayerState(Player& p, PlayerState s);
+    // Take a player off the pitch (KO, casualty, ejection, ...): sets the
+    // state and moves them to the {-1,-1} off-pitch sentinel.
+    void removePlayer(Player& p, PlayerState s);
+    void setLostTacklezones(Player& p, bool lost);
+    // Overwrite every field of `p` with `saved` (same slot). Used by
+    // UndoJournal to roll a player back without invalidating the indexes.
+    void restorePlayer(Player& p, const Player& saved);
+
+    // Number of tacklezones `exertedBy`'s players put on `pos` (standing,
+    // tacklezones not lost). O(1): reads the tacklezone index.
+    int tacklezoneCount(TeamSide exertedBy, Position pos) const;
+
+    // Bitboard views of the same indexes, for mask-based move generation.
+    const Bitboard& occupiedBy(TeamSide side) const;
+    const Bitboard& standingOf(TeamSide side) const;
+    // Squares with at least one of `exertedBy`'s tacklezones on them.
+    const Bitboard& tacklezoneBoard(TeamSide exertedBy) const;
+    Bitboard occupied() const { return occupiedBy(TeamSide::HOME) | occupiedBy(TeamSide::AWAY); }
+
+    // False only if none of `side`'s players (on the pitch or not) has `s`,
+    // so a handler can skip a whole scan for it. Exact for HOT_SKILLS,
+    // always true for other skills. One load: the per-team hot-skill masks
+    // share the occupancy index's lifecycle.
+    bool teamMayHaveSkill(TeamSide side, SkillName s) const;
+    // The OR of hotSkills() over `side`'s players, as hotSkillBit() flags.
+    uint32_t teamHotSkills(TeamSide side) const;
+    // `side`'s FeatureAccumulator; same lifecycle as the occupancy index.
+    const FeatureAccumulator& featureAccumulator(TeamSide side) const;
+
+    // Code that edits `players` by hand (test fixtures, bindings, bulk
+    // setup, skill changes) calls this afterwards; the occupancy and
+    // tacklezone indexes and the team skill masks are rebuilt on the next
+    // lookup.
+    void invalidateOccupancy() { occupancyStale_ = true; stampDirty_ = true; touched_ = ALL_SLOTS; }
+    void rebuildOccupancy() const;
+    // Debug aid: true iff the indexes agree with a scan of `players`.
+    bool occupancyConsistent() const;
+
+    // players[] slots handed out for writing since clearTouched(), one bit
+    // per slot: set by the mutators, the non-const getPlayer,
+    // getPlayerAtPosition, forEachPlayer and forEachOnPitch, and (all of
+    // them) by invalidateOccupancy(). UndoJournal saves only these players.
+    uint32_t touchedPlayers() const { return touched_; }
+    void clearTouched() { touched_ = 0; }
+
+    // Identifies the current player layout (positions, states, lost
+    // tacklezones) for derived-data caches such as reachability maps. Any
+    // mutator call or invalidateOccupancy() retires the stamp; a clone
+    // shares its source's stamp until either side changes. Stamps are
+    // process-unique, so cached data can never be confused across states.
+    uint64_t occupancyStamp() const;
+
+    // 64-bit Zobrist hash of the position: player slots' squares, states and
+    // per-turn flags, ball, active team, phase, half, turn counters, scores,
+    // rerolls and the team blitz/pass/foul/reroll-used flags. Equal states
+    // hash equal, in any process (keys come from a fixed seed). The player
+    // layout part is kept incrementally by the mutators; the remaining
+    // fields are folded in on each call (a few dozen key mixes).
+    uint64_t hash() const;
+    // hash() of this position mirrored across the pitch's long axis
+    // (y -> 14 - y, symmetry.h), without building the mirrored state.
+    uint64_t mirroredHash() const;
+
     // Team state lookup
     TeamState& getTeamState(TeamSide side);
     const TeamState& getTeamState(TeamSide side) const;
@@ -46,6 +143,7 @@ public:
     template<typename F>
     void forEachPlayer(TeamSide side, F&& func) {
         int start = (side == TeamSide::HOME) ? 0 : 11;
+        touched_ |= TEAM_SLOTS << start;
         for (int i = start; i < start + 11; ++i) {
             func(players[i]);
         }
@@ -61,9 +159,12 @@ public:
 
     template<typename F>
     void forEachOnPitch(TeamSide side, F&& func) {
-        forEachPlayer(side, [&](Player& p) {
-            if (p.isOnPitch()) func(p);
-        });
+        int start = (side == TeamSide::HOME) ? 0 : 11;
+        for (int i = start; i < start + 11; ++i) {
+            if (!players[i].isOnPitch()) continue;
+            touched_ |= 1u << i;
+            func(players[i]);
+        }
     }
 
     template<typename F>
@@ -77,6 +178,53 @@ public:
 
     // Trivial copy for MCTS branching
     GameState clone() const { return *this; }
+
+private:
+    static constexpr int OCCUPANCY_SIZE = Position::PITCH_WIDTH * Position::PITCH_HEIGHT;
+    static constexpr uint32_t TEAM_SLOTS = (1u << 11) - 1;
+    static constexpr uint32_t ALL_SLOTS = (1u << 22) - 1;
+
+    // occupancy_[y * PITCH_WIDTH + x] = players[] slot + 1 of the on-pitch
+    // player on that square, 0 = empty. Flat POD so clone() stays a trivial
+    // copy. Built lazily (a default-constructed or hand-edited state is
+    // stale until its first lookup), then maintained incrementally by the
+    // mutators above. mutable: const lookups may trigger the lazy rebuild.
+    mutable std::array<uint8_t, OCCUPANCY_SIZE> occupancy_{};
+    // tacklezones_[side][square] = tacklezones that side exerts on the square.
+    // Shares occupancy_'s lifecycle (same stale flag, same mutators).
+    mutable std::array<std::array<uint8_t, OCCUPANCY_SIZE>, 2> tacklezones_{};
+    // Per-team bitboards derived from the two arrays above.
+    mutable std::array<Bitboard, 2> occupiedBoard_{};
+    mutable std::array<Bitboard, 2> standingBoard_{};
+    mutable std::array<Bitboard, 2> tacklezoneBoard_{};
+    mutable bool occupancyStale_ = true;
+    mutable bool stampDirty_ = true;
+    mutable uint64_t stamp_ = 0;
+    // XOR of layoutKey() over all players; shares occupancy_'s lifecycle.
+    mutable uint64_t layoutHash_ = 0;
+    // OR of hotSkills() over each team's players; same lifecycle.
+    mutable std::array<uint32_t, 2> teamHotSkills_{};
+    // featureAccumulator() per team; same lifecycle.
+    mutable std::array<FeatureAccumulator, 2> features_{};
+    uint32_t touched_ = ALL_SLOTS;  // touchedPlayers()
+
+    static int squareIndex(Position pos) { return pos.y * Position::PITCH_WIDTH + pos.x; }
+    int slotOf(const Player& p) const { return static_cast<int>(&p - players.data()); }
+    void touch(const Player& p) { touched_ |= 1u << slotOf(p); }
+    const Player* scanPlayerAtPosition(Position pos) const;
+    int scanTacklezoneCount(TeamSide exertedBy, Position pos) const;
+    static bool exertsIndexedTacklezone(const Player& p);
+    uint64_t layoutKey(const Player& p, bool mirrorY = false) const;
+    // hash() given the players' layout part.
+    uint64_t hashWithLayout(uint64_t layout, bool mirrorY) const;
+    void addTacklezones(const Player& p, int delta) const;
+    void refreshSquareBoards(int sq) const;
+    void unindexPlayer(const Player& p);
+    void indexPlayer(const Player& p);
 };
 
+// Search copies the whole state every replay; growth here is a slowdown.
+// 2048 bytes is 32 cache lines.
+static_assert(sizeof(GameState) <= 2048, "GameState::clone() cost: keep the state compact");
+
 } // namespace bb
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "bb/enums.h"
+#include "bb/position.h"
+#include <array>
+#include <cstdint>
+
+namespace bb {
+
+// Pitch geometry generated at compile time: rules code reads these tables
+// instead of rebuilding offsets, filtering off-pitch squares or walking
+// lines on every call.
+namespace geometry {
+
+constexpr int W = Position::PITCH_WIDTH;
+constexpr int H = Position::PITCH_HEIGHT;
+constexpr int SQUARES = W * H;
+
+constexpr bool onPitch(int x, int y) { return x >= 0 && x < W && y >= 0 && y < H; }
+
+// The 8 directions clockwise from North, as a D8 scatter roll numbers them
+// (1 = N ... 8 = NW, at index roll - 1).
+inline constexpr int8_t COMPASS[8][2] = {
+    {0,-1}, {1,-1}, {1,0}, {1,1}, {0,1}, {-1,1}, {-1,0}, {-1,-1}
+};
+
+// On-pitch neighbours of one square, in Position::getAdjacent() order.
+struct Neighbours {
+    uint8_t count = 0;
+    Position squares[8] = {};
+
+    const Position* begin() const { return squares; }
+    const Position* end() const { return squares + count; }
+};
+
+constexpr std::array<Neighbours, SQUARES> makeNeighbours() {
+    std::array<Neighbours, SQUARES> t{};
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            Neighbours& n = t[y * W + x];
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    if ((dx || dy) && onPitch(x + dx, y + dy)) {
+                        n.squares[n.count++] = {static_cast<int8_t>(x + dx),
+                                                static_cast<int8_t>(y + dy)};
+                    }
+                }
+            }
+        }
+    }
+    return t;
+}
+
+inline constexpr std::array<Neighbours, SQUARES> NEIGHBOURS = makeNeighbours();
+inline constexpr Neighbours NO_NEIGHBOURS{};
+
+// Pushback directions for each attacker->defender step (sign of dx, dy):
+// straight back, then 45 degrees clockwise, then counter-clockwise, as
+// COMPASS indices. Index (dy + 1) * 3 + (dx + 1); the centre entry (no
+// step) pushes North, as the old direction search defaulted to.
+constexpr std::array<std::array<uint8_t, 3>, 9> makePushbackDirs() {
+    std::array<std::array<uint8_t, 3>, 9> t{};
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            int idx = 0;
+            for (int i = 0; i < 8; ++i) {
+                if (COMPASS[i][0] == dx && COMPASS[i][1] == dy) idx = i;
+            }
+            t[(dy + 1) * 3 + (dx + 1)] = {static_cast<uint8_t>(idx),
+                                          static_cast<uint8_t>((idx + 1) % 8),
+                                          static_cast<uint8_t>((idx + 7) % 8)};
+        }
+    }
+    return t;
+}
+
+inline constexpr std::array<std::array<uint8_t, 3>, 9> PUSHBACK_DIRS = makePushbackDirs();
+
+// Pass lines, by (dx, dy) from thrower to target. The Bresenham walk only
+// depends on the offset, so one table of relative steps serves every
+// (src, dst) pair on the pitch. A line lists the squares strictly between
+// the ends: the interception corridor.
+struct LineStep {
+    int8_t dx = 0;
+    int8_t dy = 0;
+};
+
+struct PassLine {
+    uint16_t first = 0;   // index of the first step in PASS_LINES.steps
+    uint8_t length = 0;
+    PassRange range = PassRange::QUICK_PASS;
+};
+
+constexpr int LINE_SPAN_X = 2 * W - 1;
+constexpr int LINE_SPAN_Y = 2 * H - 1;
+constexpr int LINE_COUNT = LINE_SPAN_X * LINE_SPAN_Y;
+
+constexpr int lineIndex(int dx, int dy) { return (dy + H - 1) * LINE_SPAN_X + (dx + W - 1); }
+
+// Walks the Bresenham line from (0, 0) to (x1, y1); calls f(x, y) for each
+// square strictly between. Bounded by max(|dx|, |dy|) steps (an unbounded
+// walk could overshoot the end on degenerate inputs and never stop).
+template<typename F>
+constexpr void walkLine(int x1, int y1, F&& f) {
+    int x0 = 0, y0 = 0;
+    int dx = x1 < 0 ? -x1 : x1;
+    int dy = y1 < 0 ? -y1 : y1;
+    int sx = (x0 < x1) ? 1 : -1;
+    int sy = (y0 < y1) ? 1 : -1;
+    int err = dx - dy;
+    int steps = dx > dy ? dx : dy;
+    for (int s = 0; s < steps; ++s) {
+        int e2 = 2 * err;
+        if (e2 > -dy) {
+            err -= dy;
+            x0 += sx;
+        }
+        if (e2 < dx) {
+            err += dx;
+            y0 += sy;
+        }
+        if (x0 == x1 && y0 == y1) break;
+        f(x0, y0);
+    }
+}
+
+constexpr int countLineSteps() {
+    int total = 0;
+    for (int dy = -(H - 1); dy <= H - 1; ++dy) {
+        for (int dx = -(W - 1); dx <= W - 1; ++dx) {
+            walkLine(dx, dy, [&](int, int) { ++total; });
+        }
+    }
+    return total;
+}
+
+constexpr int LINE_STEPS = countLineSteps();
+static_assert(LINE_STEPS <= 0xFFFF, "PassLine::first is 16 bits");
+
+struct PassLineTables {
+    std::array<PassLine, LINE_COUNT> lines{};
+    std::array<LineStep, LINE_STEPS> steps{};
+};
+
+constexpr PassLineTables makePassLines() {
+    PassLineTables t{};
+    int next = 0;
+    for (int dy = -(H - 1); dy <= H - 1; ++dy) {
+        for (int dx = -(W - 1); dx <= W - 1; ++dx) {
+            PassLine& line = t.lines[lineIndex(dx, dy)];
+            line.first = static_cast<uint16_t>(next);
+            walkLine(dx, dy, [&](int x, int y) {
+                t.steps[next++] = {static_cast<int8_t>(x), static_cast<int8_t>(y)};
+            });
+            line.length = static_cast<uint8_t>(next - line.first);
+            int ax = dx < 0 ? -dx : dx, ay = dy < 0 ? -dy : dy;
+            line.range = passRangeFromDistance(ax > ay ? ax : ay);
+        }
+    }
+    return t;
+}
+
+inline constexpr PassLineTables PASS_LINES = makePassLines();
+
+} // namespace geometry
+
+// The on-pitch squares around `p`, in getAdjacent() order; none for an
+// off-pitch `p` (a removed player's {-1,-1} sentinel).
+inline const geometry::Neighbours& onPitchNeighbours(Position p) {
+    if (!p.isOnPitch()) return geometry::NO_NEIGHBOURS;
+    return geometry::NEIGHBOURS[p.y * geometry::W + p.x];
+}
+
+// The pass line from `src` to `dst` (both on the pitch).
+inline const geometry::PassLine& passLine(Position src, Position dst) {
+    return geometry::PASS_LINES.lines[geometry::lineIndex(dst.x - src.x, dst.y - src.y)];
+}
+
+// Square `i` (0 <= i < line.length) of `line`, thrown from `src`.
+inline Position passLineSquare(const geometry::PassLine& line, Position src, int i) {
+    const geometry::LineStep& s = geometry::PASS_LINES.steps[line.first + i];
+    return {static_cast<int8_t>(src.x + s.dx), static_cast<int8_t>(src.y + s.dy)};
+}
+
+} // namespace bb
@@ -9,9 +9,13 @@
 
 namespace bb {
 
-inline void emitEvent(std::vector<GameEvent>* events, GameEvent evt) {
-    if (events) events->push_back(evt);
-}
+// Append GameEvent{...} to `events` when the caller logs them. A macro so
+// that with logging off (events == nullptr) the event's fields are not
+// even evaluated.
+#define BB_EMIT_EVENT(events, ...)                                      \
+    do {                                                                \
+        if (events) (events)->push_back(::bb::GameEvent{__VA_ARGS__});  \
+    } while (0)
 
 struct BlockDiceInfo {
     int count = 1;
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace bb {
+
+// Vector with room for N elements inside the object, for the per-call
+// action and macro lists the search builds thousands of times a second: a
+// stack-allocated list never touches the heap unless a position overflows
+// N, in which case it moves to a heap buffer and keeps working. Elements
+// must be trivially copyable (Action, Macro), so growth and copies are
+// memcpy and clear() is O(1).
+template <typename T, size_t N>
+class InlineVector {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                  "InlineVector holds plain data only");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    InlineVector() = default;
+    InlineVector(const InlineVector& other) { assign(other.begin(), other.end()); }
+    InlineVector& operator=(const InlineVector& other) {
+        if (this != &other) assign(other.begin(), other.end());
+        return *this;
+    }
+    InlineVector(InlineVector&& other) noexcept { take(other); }
+    InlineVector& operator=(InlineVector&& other) noexcept {
+        if (this != &other) take(other);
+        return *this;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }
+    // False while the elements still live in the inline storage.
+    bool spilled() const { return heap_ != nullptr; }
+
+    T* data() { return heap_ ? heap_.get() : inline_(); }
+    const T* data() const { return heap_ ? heap_.get() : inline_(); }
+    T& operator[](size_t i) { return data()[i]; }
+    const T& operator[](size_t i) const { return data()[i]; }
+    T& back() { return data()[size_ - 1]; }
+    const T& back() const { return data()[size_ - 1]; }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size_; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size_; }
+
+    void clear() { size_ = 0; }
+    void push_back(const T& value) {
+        if (size_ == capacity_) grow(capacity_ * 2);
+        data()[size_++] = value;
+    }
+    void pop_back() { --size_; }
+    void reserve(size_t n) {
+        if (n > capacity_) grow(n);
+    }
+    // Removes [first, last), keeping the order of what follows.
+    iterator erase(const_iterator first, const_iterator last) {
+        T* f = const_cast<T*>(first);
+        size_t tail = static_cast<size_t>(end() - last);
+        std::memmove(static_cast<void*>(f), last, tail * sizeof(T));
+        size_ -= static_cast<size_t>(last - first);
+        return f;
+    }
+    void assign(const T* first, const T* last) {
+        size_t n = static_cast<size_t>(last - first);
+        size_ = 0;
+        reserve(n);
+        std::memcpy(static_cast<void*>(data()), first, n * sizeof(T));
+        size_ = n;
+    }
+
+private:
+    alignas(T) unsigned char storage_[N * sizeof(T)];
+    std::unique_ptr<T[]> heap_;
+    size_t size_ = 0;
+    size_t capacity_ = N;
+
+    T* inline_() { return reinterpret_cast<T*>(storage_); }
+    const T* inline_() const { return reinterpret_cast<const T*>(storage_); }
+
+    // Steals a heap buffer; inline elements are copied.
+    void take(InlineVector& other) noexcept {
+        if (other.heap_) {
+            heap_ = std::move(other.heap_);
+            capacity_ = other.capacity_;
+        } else {
+            heap_.reset();
+            capacity_ = N;
+            std::memcpy(static_cast<void*>(inline_()), other.inline_(), other.size_ * sizeof(T));
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+        other.capacity_ = N;
+    }
+
+    void grow(size_t n) {
+        std::unique_ptr<T[]> bigger(new T[n]);
+        std::memcpy(static_cast<void*>(bigger.get()), data(), size_ * sizeof(T));
+        heap_ = std::move(bigger);
+        capacity_ = n;
+    }
+};
+
+} // namespace bb
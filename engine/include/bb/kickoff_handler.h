@@ -3,10 +3,40 @@
 #include "bb/game_state.h"
 #include "bb/dice.h"
 #include "bb/game_event.h"
+#include <array>
 #include <vector>
 
 namespace bb {
 
+// Where the kicking team aims: short against fast receivers, deep otherwise.
+Position kickTarget(const GameState& state);
+
+struct KickLanding {
+    Position square;
+    float probability;
+};
+
+// A kick aimed at one square: where each (d6 distance, d8 direction)
+// scatter lands, clamped to the pitch (distance halved, rounding up, with
+// Kick), and those squares merged into a distribution.
+struct KickTable {
+    Position byRoll[6][8];
+    KickLanding landings[48];
+    int landingCount = 0;
+};
+
+// Looked up in tables built on first use for every target square, with and
+// without Kick.
+const KickTable& kickTable(Position target, bool kickSkill);
+
+// 2d6 chance of each kickoff table result, indexed by KickoffEvent.
+const std::array<float, 13>& kickoffEventOdds();
+
+// Put the kicked ball down at `landing`: a touchback (outside the
+// receiving half) goes to the nearest standing receiver, otherwise it lies
+// on the ground there. Returns true for a touchback.
+bool placeKickedBall(GameState& state, TeamSide receiving, Position landing);
+
 // Full kickoff: scatter ball, resolve kickoff event (2D6 table), handle catch/bounce
 void resolveKickoff(GameState& state, DiceRollerBase& dice, std::vector<GameEvent>* events);
 
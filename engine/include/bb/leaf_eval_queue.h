@@ -0,0 +1,47 @@
+#pragma once
+
+#include "bb/feature_extractor.h"
+#include "bb/value_function.h"
+#include <cstdint>
+#include <vector>
+
+namespace bb {
+
+// Leaf-evaluation broker. A search queues the input rows of leaves it
+// wants valued and keeps selecting (virtual loss keeps it off the pending
+// paths); once `batchSize` vectors are waiting it flush()es them through
+// ValueFunction::evaluateBatch in one call and backpropagates the results,
+// read back by the ticket push() returned. Tickets stay valid until clear().
+class LeafEvalQueue {
+public:
+    explicit LeafEvalQueue(const ValueFunction* vf = nullptr, int batchSize = 1);
+    void reset(const ValueFunction* vf, int batchSize);
+
+    // Copies one input row (the value function's inputSize() floats);
+    // returns the ticket for result().
+    int push(const float* features);
+    // Encodes `state` straight into the queue (ValueFunction::encodeState).
+    int push(const GameState& state, TeamSide perspective);
+    // Evaluate every vector queued since the last flush().
+    void flush();
+    float result(int ticket) const { return results_[ticket]; }
+    void clear();
+
+    int size() const { return static_cast<int>(results_.size()); }
+    bool empty() const { return results_.empty(); }
+    bool full() const { return size() - evaluated_ >= batchSize_; }
+    int batchSize() const { return batchSize_; }
+    // flush() calls that evaluated at least one vector, over the queue's lifetime.
+    uint64_t batches() const { return batches_; }
+
+private:
+    const ValueFunction* vf_;
+    int batchSize_;
+    int rowSize_ = NUM_FEATURES;
+    std::vector<float> features_;  // size() * rowSize_, row-major
+    std::vector<float> results_;
+    int evaluated_ = 0;            // tickets below this have results
+    uint64_t batches_ = 0;
+};
+
+} // namespace bb
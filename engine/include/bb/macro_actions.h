@@ -4,6 +4,7 @@
 #include "bb/rules_engine.h"
 #include "bb/dice.h"
 #include "bb/action_features.h"
+#include <array>
 #include <vector>
 #include <cstdint>
 
@@ -27,6 +28,9 @@ enum class MacroType : uint8_t {
     MACRO_COUNT  // = 14
 };
 
+// Enumerator name, for logs and traces.
+const char* macroTypeName(MacroType t);
+
 struct Macro {
     MacroType type = MacroType::END_TURN;
     int playerId = -1;      // primary player
@@ -40,8 +44,39 @@ struct MacroExpansionResult {
     bool turnover = false;
 };
 
+// Stack-allocatable macro list: room for the macros of any ordinary position.
+using MacroList = InlineVector<Macro, 128>;
+
+// Per-state analysis shared by macro generation, macro features and the
+// macro-MCTS prior heuristics, so a search node works it out once. Arrays
+// are indexed by player id (1-22) and filled for on-pitch players; masks
+// hold bit `id` and cover the active team only.
+struct TacticalContext {
+    TeamSide side = TeamSide::HOME;      // active team
+    const Player* carrier = nullptr;     // active team's on-pitch ball carrier
+    const Player* oppCarrier = nullptr;  // opponent's on-pitch ball carrier
+    bool ballOnGround = false;
+    int oppScoringThreats = 0;  // standing, unmarked opponents within MA + 2 of their endzone
+
+    std::array<int8_t, 23> endzoneDist{};  // squares to the endzone the player's team attacks
+    std::array<int8_t, 23> reach{};        // movementRemaining + 2 GFIs
+    std::array<int8_t, 23> tacklezones{};  // enemy tacklezones on the player's square
+
+    uint32_t freePlayers = 0;    // can act, has not moved, no Ball & Chain
+    uint32_t openReceivers = 0;  // standing, not acted, has hands; carrier excluded
+    uint32_t engaged = 0;        // next to a standing enemy
+
+    bool hasBall() const { return carrier != nullptr; }
+    static uint32_t bit(int id) { return uint32_t{1} << id; }
+};
+
+void computeTacticalContext(const GameState& state, TacticalContext& out);
+
 // Generate all available macros for the current game state
 void getAvailableMacros(const GameState& state, std::vector<Macro>& out);
+void getAvailableMacros(const GameState& state, MacroList& out);
+// Same, reusing a context already computed for `state`
+void getAvailableMacros(const GameState& state, const TacticalContext& ctx, MacroList& out);
 
 // Expand a macro into a sequence of low-level actions via greedy heuristics.
 // Modifies state in-place as actions are executed.
@@ -50,5 +85,13 @@ MacroExpansionResult greedyExpandMacro(GameState& state, const Macro& macro,
 
 // Extract NUM_ACTION_FEATURES features for a macro (shared count with action_features.h for policy reuse)
 void extractMacroFeatures(const GameState& state, const Macro& macro, float* out);
+void extractMacroFeatures(const GameState& state, const TacticalContext& ctx,
+                          const Macro& macro, float* out);
+// macros[0..n) as the rows of an n x NUM_ACTION_FEATURES matrix at `out`,
+// bit-identical to the calls one by one but with the context worked out
+// once for the whole list.
+void extractMacroFeatures(const GameState& state, const Macro* macros, int n, float* out);
+void extractMacroFeatures(const GameState& state, const TacticalContext& ctx,
+                          const Macro* macros, int n, float* out);
 
 } // namespace bb
@@ -8,15 +8,34 @@
 #include "bb/policy_network.h"
 #include "bb/policies.h"
 #include "bb/dice.h"
+#include "bb/endgame_solver.h"
+#include "bb/prior_cache.h"
+#include "bb/undo_journal.h"
+#include "bb/transposition_table.h"
+#include "bb/node_arena.h"
+#include "bb/leaf_eval_queue.h"
+#include "bb/time_manager.h"
+#include "bb/worker_pool.h"
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 #include <cstdint>
 
 namespace bb {
 
+struct MacroMCTSNode;
+class MacroSearchHandle;
+using MacroMCTSArena = NodeArena<MacroMCTSNode>;
+
 struct MacroMCTSNode {
     Macro macro;
-    MacroMCTSNode* parent = nullptr;
-    std::vector<MacroMCTSNode> children;
+    // Arena indices, as in MCTSNode.
+    uint32_t parent = MacroMCTSArena::NONE;
+    uint32_t firstChild = MacroMCTSArena::NONE;
+    uint32_t numChildren = 0;
     int visits = 0;
     double totalValue = 0.0;
     bool expanded = false;
@@ -29,15 +48,27 @@ struct MacroMCTSNode {
     // whose actingTeam differs from searchingSide represents the
     // opponent's decision (adversarial, not cooperative).
     TeamSide actingTeam = TeamSide::HOME;
+    // GameState::hash() of the state this node's macro led to on its most
+    // recent replay (0 = not recorded). Open-loop, so it can change between
+    // replays; only used to look up transposition-table statistics.
+    uint64_t stateHash = 0;
+    // As MCTSNode::expandedHash (subtree reuse only).
+    uint64_t expandedHash = 0;
 
-    MacroMCTSNode* bestChildPUCT(double C, bool maximize) const;
-    MacroMCTSNode* mostVisitedChild() const;
+    // With a `tt`, a child whose last-seen position has more visits in the
+    // table than the child itself is ranked by the table's Q instead.
+    // Both return the chosen child's arena index (NONE without children).
+    uint32_t bestChildPUCT(const MacroMCTSArena& arena, double C, bool maximize,
+                           TranspositionTable* tt = nullptr) const;
+    uint32_t mostVisitedChild(const MacroMCTSArena& arena) const;
 };
 
 struct MacroChildVisitInfo {
     Macro macro;
     int visits;
     float prior = 0.0f;  // post-renorm root prior (diagnostics/tests)
+    float target = 0.0f; // policy-improvement target: visit share, or the Gumbel root's improved policy
+    double value = 0.0;  // mean backed-up value, searching side's view (0 if unvisited)
 };
 
 // Outcome of an open-loop replay toward a target node: `reached` is the
@@ -47,27 +78,120 @@ struct MacroChildVisitInfo {
 // the tree was first built); `complete` is true only if the replay reached
 // the target node itself without incident.
 struct ReplayOutcome {
-    MacroMCTSNode* reached;
+    uint32_t reached;  // arena index
     bool complete;
 };
 
+// The terms of the macro search's leaf heuristic (MacroMCTSSearch::
+// leafBreakdown). The heuristic terms are summed, clamped to [-1, 1] and
+// blended with the value function by vfBlend. The scoring terms, PROXIMITY
+// onward, are added after the blend so the value head cannot dilute the
+// pull toward the endzone.
+enum class LeafTerm : uint8_t {
+    SCORE_DIFF, POSSESSION, OPP_POSSESSION, OPP_PROXIMITY, OPP_CAN_SCORE,
+    LOOSE_BALL, NEAR_LOOSE_BALL, MARK_OPP_CARRIER, BASH_EXPOSURE, SIDELINE_TRAP,
+    CONTAIN_AGILE, PLAYER_DIFF,
+    PROXIMITY, CAGE_ADVANCE, WALK_IN, GFI_SCORE, PACING, URGENCY, ONE_TURN_TD,
+    HAND_OFF_SCORE, LOOKAHEAD,
+    COUNT
+};
+
+inline bool isScoringTerm(LeafTerm t) { return t >= LeafTerm::PROXIMITY; }
+
+// Enumerator name, for diagnostics.
+inline const char* leafTermName(LeafTerm t) {
+    static constexpr const char* names[] = {
+        "SCORE_DIFF", "POSSESSION", "OPP_POSSESSION", "OPP_PROXIMITY", "OPP_CAN_SCORE",
+        "LOOSE_BALL", "NEAR_LOOSE_BALL", "MARK_OPP_CARRIER", "BASH_EXPOSURE", "SIDELINE_TRAP",
+        "CONTAIN_AGILE", "PLAYER_DIFF",
+        "PROXIMITY", "CAGE_ADVANCE", "WALK_IN", "GFI_SCORE", "PACING", "URGENCY", "ONE_TURN_TD",
+        "HAND_OFF_SCORE", "LOOKAHEAD",
+    };
+    return names[static_cast<int>(t)];
+}
+
+// One leaf evaluation, term by term.
+struct LeafBreakdown {
+    std::array<double, static_cast<size_t>(LeafTerm::COUNT)> terms{};  // 0 for terms that did not apply
+    double heuristic = 0.0;     // clamped sum of the heuristic terms
+    double scoringBonus = 0.0;  // sum of the scoring terms
+    float vfRaw = 0.0f;         // value function output (0 unless vfBlend uses one)
+    double value = 0.0;         // the leaf value the search backs up
+};
+
 class MacroMCTSSearch {
     const ValueFunction* valueFn_;
     MCTSConfig config_;
-    DiceRoller dice_;
+    FastDiceRoller dice_;
 
     int lastIterations_ = 0;
     double lastBestValue_ = 0.0;
     std::vector<MacroChildVisitInfo> lastChildVisits_;
+    SearchStats lastStats_;
+    bool lastSolved_ = false;
 
 public:
     MacroMCTSSearch(const ValueFunction* vf, MCTSConfig config, uint32_t seed = 0);
 
     Macro search(const GameState& state);
+    // search() on an engine-owned thread; see macro_search_handle.h. This
+    // object must outlive the handle and is not to be used until the search
+    // has finished. The handle installs its own progress callback.
+    std::unique_ptr<MacroSearchHandle> searchAsync(const GameState& state, int timeBudgetMs,
+                                                   int maxIterations);
+
+    // Called by the searching thread every 64 iterations of a serial search
+    // with the iterations run so far. It may read rootVisits() and change the
+    // budget with setBudget(); returning false ends the search there. With
+    // MCTSConfig::numThreads > 1 the worker completing every 64th iteration
+    // calls it under the tree lock; root visits then include the virtual
+    // visits of paths still in flight, and those paths finish after a false.
+    using ProgressFn = std::function<bool(int iterations)>;
+    void setProgress(ProgressFn fn) { progress_ = std::move(fn); }
+    // The visited root children and their visit shares as of now: inside a
+    // progress call, the search so far; otherwise the last search.
+    void rootVisits(std::vector<MacroChildVisitInfo>& out) const;
+    // Pondering (MacroMCTSPolicy::ponder): the next search re-roots at any
+    // expanded node of the current tree whose position it is, rather than
+    // only at the last chosen child, even without MCTSConfig::reuseTree.
+    void setPonderReuse(bool on) { ponderReuse_ = on; }
 
     int lastIterations() const { return lastIterations_; }
     double lastBestValue() const { return lastBestValue_; }
     const std::vector<MacroChildVisitInfo>& lastChildVisits() const { return lastChildVisits_; }
+    const SearchStats& lastStats() const { return lastStats_; }
+
+    // Transposition-table counters, cumulative over this search object's
+    // lifetime (table disabled unless MCTSConfig::ttMemoryMB > 0).
+    const TranspositionTable& transpositionTable() const { return tt_; }
+    // Root visits carried over by subtree reuse in the last search (0 = fresh tree).
+    int lastReusedVisits() const { return lastReusedVisits_; }
+    // The last search was settled by the endgame solver (MCTSConfig::
+    // endgameSolver): no iterations, lastBestValue() is the line's
+    // touchdown probability and lastChildVisits() holds the solved lines.
+    bool lastSolved() const { return lastSolved_; }
+    const EndgameSolver& endgameSolver() const { return endgame_; }
+
+    // The last search's tree (search_tree_file.h), nodes with fewer than
+    // `minVisits` visits pruned; empty if it built none (a forced move, a
+    // solved endgame, a root cache hit). Valid until the next search().
+    SearchTree exportTree(int minVisits = 1) const;
+
+    // Budget for the next searches (TimeManager allocations).
+    void setBudget(int timeBudgetMs, int maxIterations) {
+        config_.timeBudgetMs = timeBudgetMs;
+        config_.maxIterations = maxIterations;
+    }
+    const MCTSConfig& config() const { return config_; }
+    // The roller all of a search's randomness derives from. Saved before a
+    // search and restored into a new search object, it replays that search
+    // (decision_capture.h).
+    const FastDiceRoller& dice() const { return dice_; }
+    FastDiceRoller& dice() { return dice_; }
+    // The root candidates and priors a search of `state` would start from.
+    void rootPriors(const GameState& state, MacroList& macros, std::vector<float>& priors) const {
+        computeChildren(state, macros, priors);
+    }
 
     // Test-only: expand a fresh root for `state` and return each child's
     // (macro, prior) after floor/cap + renorm. Pure wrapper over the private
@@ -76,40 +200,287 @@ public:
     // regression tests).
     std::vector<std::pair<Macro, float>> expandRootPriorsForTest(const GameState& state);
 
+    // The leaf evaluation of `state` from `perspective` split into its
+    // terms; `value` is what the search backs up for it. `dice` is used
+    // only by the leafLookahead term.
+    LeafBreakdown leafBreakdown(const GameState& state, TeamSide perspective,
+                                DiceRollerBase& dice) const;
+
 private:
-    MacroMCTSNode* select(MacroMCTSNode* root, TeamSide searchingSide);
-    void expand(MacroMCTSNode* node, const GameState& state);
-    double simulate(const GameState& state, TeamSide perspective);
-    void backpropagate(MacroMCTSNode* node, double value);
-    ReplayOutcome replayToNode(GameState& state, MacroMCTSNode* node);
-    // Bounded greedy one-ply forward look from a leaf state (see macro_mcts.cpp).
-    double greedyLookaheadBonus(const GameState& leafState, TeamSide perspective);
+    // Subtree reuse: new root index in arena_, or NONE to build a fresh tree.
+    uint32_t reuseSubtree(const GameState& state);
+    uint32_t select(uint32_t root, TeamSide searchingSide);
+    // MCTSConfig::numThreads > 1: shared-tree workers; returns iterations run.
+    // Phase times and counters accumulate into `stats`. The root is always
+    // PUCT: the Gumbel root (MCTSConfig::gumbelTopK) is serial only.
+    int searchParallel(uint32_t root, const GameState& state, TeamSide searchingSide,
+                       std::chrono::steady_clock::time_point startTime, SearchStats& stats);
+    // Iterations left after `done` in `elapsedMs`: the iteration cap, and
+    // under a time budget the rate so far over the time left, if fewer.
+    int remainingIterations(int done, double elapsedMs) const;
+    // MCTSConfig::earlyStop: no root child can overtake the most-visited one
+    // in `remaining` more iterations. `inFlight` iterations still hold a
+    // virtual visit somewhere in the tree, each of which may yet be taken
+    // back from the leader (a replay truncated before reaching it).
+    bool rootSettled(uint32_t root, int remaining, int inFlight) const;
+    void expand(uint32_t node, const GameState& state);
+    // computeChildren() through priorCache_ (MCTSConfig::priorCacheMB),
+    // hits and misses counted in `stats`. Tree-parallel workers pass the
+    // mutex guarding the cache; generation runs outside it.
+    void cachedChildren(const GameState& state, MacroList& macros, std::vector<float>& priors,
+                        SearchStats& stats, std::mutex* cacheMutex,
+                        SearchTrace* trace = nullptr, int tid = 0);
+    // MCTSConfig::maxTreeNodes, serial search: whether `node` may be
+    // expanded. At the budget, frontier subtrees off the path to `node` are
+    // collapsed back into leaves, least visited first, until a quarter of
+    // the budget is free; false (counted in `stats`) if none is left.
+    bool makeRoom(uint32_t node, TeamSide searchingSide, bool batched, SearchStats& stats);
+    // Transposition-table key of `state`: hash(), or canonicalHash() with
+    // MCTSConfig::symmetricCaches.
+    uint64_t ttKey(const GameState& state) const;
+    // expand() in two halves so tree-parallel workers can generate macros
+    // and priors without holding the tree lock. `trace` (sampled iterations
+    // only) gets generation and prior spans on track `tid`.
+    void computeChildren(const GameState& state, MacroList& macros,
+                         std::vector<float>& priors,
+                         SearchTrace* trace = nullptr, int tid = 0) const;
+    void attachChildren(uint32_t node, const GameState& state,
+                        const MacroList& macros, const std::vector<float>& priors);
+    // MCTSConfig::opponentReplyWidth: the indices (in list order) of the
+    // macros an opponent node at `node` keeps, its highest priors; empty
+    // when the node keeps every macro. `node`'s actingTeam must be set.
+    std::vector<int> opponentReplies(uint32_t node, const std::vector<float>& priors) const;
+    double simulate(const GameState& state, TeamSide perspective, DiceRollerBase& dice) const;
+    // simulate() = combineLeaf(leafTerms(), value function): the split lets
+    // batched evaluation queue the value-function half.
+    struct LeafTerms {
+        double heuristic;
+        double scoringBonus;
+    };
+    LeafTerms leafTerms(const GameState& state, TeamSide perspective, DiceRollerBase& dice) const;
+    // Per-search constants of the leaf terms: the players (bit by id) whose
+    // ST or AG is 4+. Stats do not change within a search (Multiple Block's
+    // +2 ST is taken back within the action).
+    struct LeafInvariants {
+        uint32_t strong = 0;
+        uint32_t agile = 0;
+    };
+    static LeafInvariants leafInvariants(const GameState& state);
+    template <typename Emit>
+    void emitLeafTerms(const GameState& state, TeamSide perspective, DiceRollerBase& dice,
+                       const LeafInvariants& leaf, Emit&& emit) const;
+    double combineLeaf(const LeafTerms& terms, float vfRaw) const;
+    bool usesValueFunction() const { return valueFn_ && config_.vfBlend > 0.0f; }
+    bool cancelled() const { return config_.cancel && config_.cancel->load(std::memory_order_relaxed); }
+    // Virtual loss added to `node` while an evaluation below it is pending:
+    // a loss for the team that chose it (0 for the root).
+    double virtualLoss(uint32_t node, TeamSide searchingSide) const;
+    // Add (sign +1) or take back (sign -1) virtual loss from `node` up to the root.
+    void applyVirtualLoss(uint32_t node, TeamSide searchingSide, int sign);
+    void backpropagate(uint32_t node, double value);
+    ReplayOutcome replayToNode(GameState& state, uint32_t node);
+    // MCTSConfig::rolloutThreads: the `n` leaf samples of `node` at once.
+    // Sample 0 evaluates `sim`, already replayed to the node, on dice_; the
+    // others replay the path open loop on the pool's workers. Returns the
+    // sum of the completed samples' values, with their count in `samples`;
+    // `sim` is rolled back to the root.
+    double sampleRollouts(GameState& sim, uint32_t node, TeamSide perspective, int n,
+                          int& samples);
+    // Dice for the macro (or leaf evaluation) `depth` macros below the root:
+    // dice_, or under MCTSConfig::commonRandomNumbers the substream keyed
+    // to (this search, the visit index being evaluated, depth, sample).
+    FastDiceRoller& stepDice(int depth);
+    // MCTSConfig::stateCacheDepth: keep `state` as one of `node`'s sampled
+    // outcomes if it is shallow enough and its samples and the memory cap
+    // have room.
+    void cacheOutcome(uint32_t node, int depth, const GameState& state, bool turnover);
+    // Gumbel root (MCTSConfig::gumbelTopK): sample the candidates, then
+    // plan a phase of equal visits each from `budget` iterations left.
+    void gumbelStart(uint32_t root, int budget);
+    bool gumbelPlanPhase(int budget);
+    // Rank the candidates by noise + log prior + sigma(Q), best first.
+    void gumbelRank(uint32_t root);
+    // Keep the better half and plan its phase; false once one is left.
+    bool gumbelHalve(uint32_t root, int budget);
+    double gumbelSigma(double q, int maxVisits) const;
+    // softmax(log prior + sigma(completed Q)) over all of the root's children.
+    void gumbelTargets(uint32_t root, std::vector<float>& targets);
+    // Bounded greedy one-ply forward look from a leaf state (see macro_mcts.cpp):
+    // the macro it tries (false if none applies), then one sampled outcome.
+    double greedyLookaheadBonus(const GameState& leafState, TeamSide perspective,
+                                DiceRollerBase& dice) const;
+    bool greedyLookaheadMacro(const GameState& leafState, TeamSide perspective, Macro& out) const;
+    double greedyLookaheadSample(const GameState& leafState, TeamSide perspective,
+                                 const Macro& macro, DiceRollerBase& dice) const;
+
+    // Working-state rollback between iterations (and nRollouts samples).
+    MacroMCTSArena arena_;  // tree storage, reset at the start of each search()
+    MacroMCTSArena spare_;  // subtree reuse copies the kept subtree in here, then swaps
+    uint32_t reuseRoot_ = MacroMCTSArena::NONE;  // last search's chosen child
+    int lastReusedVisits_ = 0;
+    UndoJournal journal_;
+    std::vector<uint32_t> path_;
+    SearchTrace* iterTrace_ = nullptr;  // config_.trace during sampled serial iterations
+    ProgressFn progress_;
+    bool ponderReuse_ = false;
+    LeafInvariants leaf_;  // of the current or last search's root
+    uint32_t searchRoot_ = MacroMCTSArena::NONE;  // root of the current or last search
+
+    // Common random numbers (MCTSConfig::commonRandomNumbers, serial search).
+    // The k-th evaluation of every child of a node replays and evaluates on
+    // the same dice, depth by depth, so sibling macros are compared on the
+    // same luck rather than independent luck. crnVisit_ is the visit index
+    // of the node evaluated this iteration (-1 = off).
+    uint64_t crnBase_ = 0;
+    int crnVisit_ = -1;
+    int crnSample_ = 0;
+    FastDiceRoller crnDice_{0};
+
+    // Gumbel-top-k root with sequential halving (MCTSConfig::gumbelTopK,
+    // serial search). k root macros are sampled without replacement by
+    // Gumbel noise + log prior; each phase gives every surviving candidate
+    // the same visits, then keeps the better half by noise + log prior +
+    // sigma(Q), until one is left. Below the root, selection is unchanged.
+    struct GumbelArm {
+        uint32_t child;  // arena index
+        double score;    // Gumbel noise + log prior
+    };
+    std::vector<GumbelArm> gumbelArms_;
+    std::vector<uint32_t> gumbelSchedule_;  // this phase's root children, round robin
+    size_t gumbelNext_ = 0;
+    int gumbelPhasesLeft_ = 0;
+
+    // Closed-loop replay near the root (MCTSConfig::stateCacheDepth, serial
+    // search only). Open-loop replay re-executes the first macros of every
+    // path with fresh dice, iteration after iteration. Instead, a shallow
+    // node keeps the first stateCacheSamples states its macro produced;
+    // once it has them, replays draw one of those at random and carry on
+    // from there. Cleared every search: node indices change with reuse.
+    struct CachedOutcome {
+        GameState state;
+        bool turnover;
+    };
+    std::unordered_map<uint32_t, std::vector<CachedOutcome>> stateCache_;
+    size_t cachedStates_ = 0;
+
+    // Leaf look-ahead reuse (MCTSConfig::lookaheadSamples, serial search
+    // only). The greedy macro is a function of the leaf state, so it is
+    // chosen once per state hash; its outcome is sampled lookaheadSamples
+    // times and the mean of those samples serves every later evaluation.
+    // Cleared every search.
+    struct LookaheadEntry {
+        Macro macro;
+        bool applies = false;  // false: the bonus is 0 and nothing is sampled
+        double sum = 0.0;
+        int samples = 0;
+    };
+    mutable std::unordered_map<uint64_t, LookaheadEntry> lookahead_;
+    mutable int lookaheadReuses_ = 0;
+    bool lookaheadShared_ = false;  // lookahead_ is in use this search
+
+    // Concurrent leaf samples (MCTSConfig::rolloutThreads): one working
+    // state and journal per pool worker, reset to the root every search.
+    struct RolloutWorker {
+        GameState sim;
+        UndoJournal journal;
+    };
+    std::unique_ptr<WorkerPool> rolloutPool_;
+    std::vector<RolloutWorker> rolloutWorkers_;
+    std::vector<Macro> rolloutPath_;
+    std::vector<double> rolloutValues_;
+    TranspositionTable tt_;
+    PriorCache priorCache_;  // MCTSConfig::priorCacheMB; every expansion, kept across searches
+    EndgameSolver endgame_;  // MCTSConfig::endgameSolver; its memo is kept across searches
+
+    // Batched leaf evaluation (MCTSConfig::evalBatchSize > 1). A leaf's
+    // nRollouts samples take consecutive tickets; its value is their mean
+    // over `divisor` (incomplete extra samples count as 0, as unbatched).
+    struct PendingLeaf {
+        uint32_t node;
+        int firstTicket;
+        int samples = 0;
+        int divisor;
+    };
+    void queueSample(const GameState& state, TeamSide perspective, PendingLeaf& leaf,
+                     DiceRollerBase& dice);
+    void deferLeaf(const PendingLeaf& leaf, TeamSide searchingSide);
+    void flushLeaves(TeamSide searchingSide);
+    LeafEvalQueue evalQueue_;
+    std::vector<LeafTerms> queuedTerms_;  // by ticket
+    std::vector<PendingLeaf> pending_;
 };
 
 // Stateful policy: searches over macros, expands best into action plan,
 // returns actions one at a time
 class MacroMCTSPolicy {
     MacroMCTSSearch search_;
-    DiceRoller expansionDice_;
+    MCTSConfig baseConfig_;             // budget caps when a TimeManager is set
+    TimeManager* timeManager_ = nullptr;
+    FastDiceRoller expansionDice_;
+    FastDiceRoller capDice_;            // fullSearchFraction draws
     std::vector<Action> currentPlan_;
     int planIndex_ = 0;
 
     // Decision logging (reuses PolicyDecision struct)
     std::vector<PolicyDecision> decisions_;
     bool logDecisions_ = false;
+    bool logBoards_ = true;
+    bool logMirrored_ = false;
     int topK_ = 20;
 
+    int searches_ = 0;
+    int64_t searchIterations_ = 0;
+
+    // Background search of the opponent's position (ponder()); destroyed
+    // before search_, which it runs on
+    std::unique_ptr<MacroSearchHandle> ponder_;
+    bool pondered_ = false;  // since the last own search
+    int ponderHits_ = 0;
+
+    // search_.search() under the TimeManager's allocation, if one is set.
+    Macro budgetedSearch(const GameState& state);
+    // search_.search() capped at cheapSearchIterations, outside the
+    // TimeManager (playout-cap randomization).
+    Macro cheapSearch(const GameState& state);
+
 public:
     MacroMCTSPolicy(const ValueFunction* vf, MCTSConfig config, uint32_t seed = 0);
+    ~MacroMCTSPolicy();
 
     Action operator()(const GameState& state);
 
-    void setLogDecisions(bool log, int topK = 20);
+    // logBoards and logMirrored as for MCTSPolicy::setLogDecisions. Cheap
+    // playout-cap searches are never logged.
+    void setLogDecisions(bool log, int topK = 20, bool logBoards = true, bool logMirrored = false);
+    // Let `tm` (not owned) size each search; the config's maxIterations (and
+    // timeBudgetMs, when allocating iterations) stay as caps. Null restores
+    // the fixed budget.
+    void setTimeManager(TimeManager* tm);
     const std::vector<PolicyDecision>& decisions() const { return decisions_; }
     void clearDecisions() { decisions_.clear(); }
 
     int lastIterations() const { return search_.lastIterations(); }
     double lastBestValue() const { return search_.lastBestValue(); }
+    // Stats of the last search (plan steps replayed since then do not search).
+    const SearchStats& lastSearchStats() const { return search_.lastStats(); }
+    // Searches run so far and their summed iterations.
+    int searches() const { return searches_; }
+    int64_t searchIterations() const { return searchIterations_; }
+
+    // Pondering: while the opponent is on the move, call ponder() with each
+    // position it acts from. The opponent's position is searched on a
+    // background thread until the next ponder() or own decision; that
+    // decision's search starts from the pondered subtree at its position,
+    // when the tree reached it (an open-loop tree matches positions by
+    // hash, so mostly where the opponent's turn ended as predicted, e.g.
+    // on END_TURN). Searches stay alternating: pondering never runs during
+    // an own search. Makes play timing-dependent, so off unless called.
+    void ponder(const GameState& state, int maxIterations = 100000);
+    void stopPondering();
+    // A pondering search is still running (it stops at maxIterations).
+    bool pondering() const;
+    // Own searches that started from a pondered subtree.
+    int ponderHits() const { return ponderHits_; }
 };
 
 } // namespace bb
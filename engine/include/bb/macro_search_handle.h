@@ -0,0 +1,63 @@
+#pragma once
+
+#include "bb/macro_mcts.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bb {
+
+// A Macro-MCTS search running on its own thread (MacroMCTSSearch::
+// searchAsync), for interactive play: a front end polls it to show the
+// search's current preference, extends it while the user deliberates, and
+// cancels it to play at once. Progress is published every 64 iterations;
+// a tree-parallel search (MCTSConfig::numThreads > 1) only publishes its
+// final result. Destroying the handle cancels the search and waits for it.
+class MacroSearchHandle {
+public:
+    struct Progress {
+        int iterations = 0;
+        double elapsedMs = 0.0;
+        bool done = false;
+        bool hasBest = false;      // false until the first report
+        Macro best;                // most-visited root macro so far (the result once done)
+        double bestValue = 0.0;    // its mean value; once done, lastBestValue()
+        std::vector<MacroChildVisitInfo> visits;  // visited root children and their visit shares
+    };
+
+    MacroSearchHandle(MacroMCTSSearch& search, const GameState& state, int timeBudgetMs, int maxIterations);
+    ~MacroSearchHandle();
+    MacroSearchHandle(const MacroSearchHandle&) = delete;
+    MacroSearchHandle& operator=(const MacroSearchHandle&) = delete;
+
+    Progress poll() const;
+    bool done() const { return done_.load(); }
+    // Add to the running search's budget, applied at its next report. A
+    // search without a time limit (timeBudgetMs <= 0) stays without one.
+    // No effect once the search has finished.
+    void extend(int extraMs, int extraIterations);
+    // Stop at the next report; the result is the best macro so far.
+    void cancel() { cancelled_ = true; }
+    // Block until the search finishes and return its chosen macro.
+    Macro wait();
+
+private:
+    bool report(int iterations);  // on the search thread
+
+    MacroMCTSSearch& search_;
+    GameState state_;
+    std::chrono::steady_clock::time_point start_;
+    std::atomic<bool> cancelled_{false};
+    std::atomic<bool> done_{false};
+    std::atomic<int> extraMs_{0};
+    std::atomic<int> extraIterations_{0};
+    mutable std::mutex mutex_;
+    Progress progress_;  // under mutex_
+    Macro result_;
+    std::thread thread_;
+};
+
+} // namespace bb
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstddef>
+#include <string>
+
+namespace bb {
+
+// Read-only shared mapping of a whole file, unmapped on destruction. The
+// binary weights loader and the replay buffer hold these through
+// shared_ptr so readers keep the pages alive.
+class MappedFile {
+    void* data_ = MAP_FAILED;
+    size_t size_ = 0;
+public:
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            size_ = static_cast<size_t>(st.st_size);
+            data_ = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+    }
+    ~MappedFile() {
+        if (data_ != MAP_FAILED) ::munmap(data_, size_);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool ok() const { return data_ != MAP_FAILED; }
+    size_t size() const { return size_; }
+    const char* bytes() const { return static_cast<const char*>(data_); }
+};
+
+} // namespace bb
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "bb/game_state.h"
+#include "bb/roster.h"
+#include <cstdint>
+#include <type_traits>
+
+namespace bb {
+
+// Rare skills whose rules code move generation and action resolution
+// compile per matchup. Most rosters use none of them, and most training
+// games are human vs. orc, which use only Big Guy checks and Throw
+// Team-Mate. Templated rules code tests each feature with `if constexpr`,
+// and withMatchupFeatures() runs the narrowest instantiation covering the
+// matchup, so a human vs. orc game never tests for Bombardier or Hypnotic
+// Gaze. ALL is the generic instantiation, which handles any matchup.
+//
+// A state's features come from GameState::teamHotSkills(), which is exact,
+// so leaving a feature out never changes a result. Building with
+// -DBB_GENERIC_RULES=ON instantiates only ALL.
+namespace feature {
+
+enum : uint32_t {
+    BALL_AND_CHAIN = 1u << 0,
+    THROW_TEAM_MATE = 1u << 1,  // one team has both ThrowTeamMate and RightStuff
+    BOMBARDIER = 1u << 2,
+    HYPNOTIC_GAZE = 1u << 3,
+    MULTIPLE_BLOCK = 1u << 4,
+    BIG_GUY = 1u << 5,          // BoneHead, ReallyStupid, WildAnimal, TakeRoot or Bloodlust
+    ALL = (1u << 6) - 1,
+};
+
+} // namespace feature
+
+using MatchupFeatures = uint32_t;
+
+// The features one team with these hot skills (hotSkillMask flags) brings.
+MatchupFeatures teamFeatures(uint32_t hotSkills);
+// Either team's features.
+MatchupFeatures matchupFeatures(const GameState& state);
+// Every feature any lineup of these rosters could bring; covers
+// matchupFeatures() of every game between them.
+MatchupFeatures matchupFeatures(const TeamRoster& home, const TeamRoster& away);
+
+// The instantiated mask withMatchupFeatures() runs for `features`.
+constexpr MatchupFeatures instantiatedFeatures(MatchupFeatures features) {
+#ifndef BB_GENERIC_RULES
+    constexpr MatchupFeatures SPECIALIZED[] = {
+        0, feature::BIG_GUY, feature::BIG_GUY | feature::THROW_TEAM_MATE,
+    };
+    for (MatchupFeatures mask : SPECIALIZED) {
+        if (!(features & ~mask)) return mask;
+    }
+#endif
+    (void)features;
+    return feature::ALL;
+}
+
+// fn(std::integral_constant<MatchupFeatures, M>{}) with M =
+// instantiatedFeatures(features).
+template <typename F>
+decltype(auto) withMatchupFeatures(MatchupFeatures features, F&& fn) {
+    using feature::ALL;
+    using feature::BIG_GUY;
+    using feature::THROW_TEAM_MATE;
+    switch (instantiatedFeatures(features)) {
+#ifndef BB_GENERIC_RULES
+        case 0:
+            return fn(std::integral_constant<MatchupFeatures, 0>{});
+        case BIG_GUY:
+            return fn(std::integral_constant<MatchupFeatures, BIG_GUY>{});
+        case BIG_GUY | THROW_TEAM_MATE:
+            return fn(std::integral_constant<MatchupFeatures, BIG_GUY | THROW_TEAM_MATE>{});
+#endif
+        default:
+            return fn(std::integral_constant<MatchupFeatures, ALL>{});
+    }
+}
+
+} // namespace bb
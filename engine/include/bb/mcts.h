@@ -5,57 +5,188 @@
 #include "bb/value_function.h"
 #include "bb/feature_extractor.h"
 #include "bb/policy_network.h"
+#include "bb/rollout_policy.h"
 #include "bb/dice.h"
+#include "bb/undo_journal.h"
+#include "bb/chance_outcomes.h"
+#include "bb/node_arena.h"
+#include "bb/search_trace.h"
+#include "bb/search_tree_file.h"
+#include "bb/alloc_tracking.h"
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include <cstdint>
+#include <limits>
 
 namespace bb {
 
+class RootCache;
+
 struct MCTSConfig {
-    int timeBudgetMs = 1000;
+    int timeBudgetMs = 1000;      // Macro-MCTS treats <= 0 as no time limit (maxIterations only)
     int maxIterations = 100000;
     double explorationC = 1.41;  // UCT constant
     int rolloutDepth = 0;        // 0 = pure value function eval
+    const RolloutPolicy* rolloutPolicy = nullptr;  // Rollout action sampler, shared by all threads (null = player-first)
     bool verbose = false;
     const PolicyNetwork* policy = nullptr;  // If set, use PUCT instead of UCT
     int maxChildren = 0;   // Progressive widening: max children per node (0 = unlimited)
+    int prefilterChildren = 0;    // Low-level MCTS, with maxChildren and a policy: rank legal actions by a cheap heuristic and run the policy on only the best this many (0 = policy on every action)
+    float wideningExponent = 0.0f; // Low-level MCTS, with a policy: only a node's top ceil(2 * visits^e) children by prior are selectable, more opening as it is visited (0 = all at once)
     float dirichletAlpha = 0.0f;   // Dirichlet noise alpha (0 = disabled, 0.3 for training)
     float dirichletWeight = 0.25f; // prior = (1-w)*policy + w*Dir(alpha)
     float policyBlend = 0.0f;     // Blend policy with heuristics: 0.0 = heuristics only, 1.0 = policy only
     float vfBlend = 0.0f;         // Blend VF with heuristic eval: 0.0 = heuristic only, 1.0 = VF only
     int nRollouts = 1;            // Rollouts averaged per leaf eval (open-loop): >1 cuts macro Q-variance ~sqrt(K)
     bool leafLookahead = false;   // Macro-MCTS only: bounded greedy 1-ply forward look at leaf eval (2026-07-02 experiment)
+    int lookaheadSamples = 4;     // Macro-MCTS only: leafLookahead outcomes sampled per leaf state (by hash); later evaluations of it reuse their mean (serial search; 0 = sample every time)
+    int stateCacheDepth = 0;      // Macro-MCTS only: closed-loop replay at nodes this many macros deep or less, from cached outcome samples (0 = open loop)
+    int stateCacheSamples = 8;    // Macro-MCTS only: outcomes sampled per cached node before replays reuse them
+    int stateCacheMB = 64;        // Macro-MCTS only: memory cap for those samples
+    bool commonRandomNumbers = false;  // Macro-MCTS only: siblings' k-th visits replay and evaluate on the same per-depth dice, pairing their comparison (serial search)
+    int rolloutThreads = 0;       // Macro-MCTS only: helper threads sampling the nRollouts > 1 leaf evaluations concurrently (serial, unbatched search; 0 = one after another)
+    int priorCacheMB = 0;         // Macro-MCTS only: expanded positions' macros and priors by state hash, kept across searches (0 = disabled)
+    int maxTreeNodes = 0;         // Macro-MCTS only: node budget for the tree; once reached, the serial search recycles its least-visited frontier subtrees to expand, the tree-parallel one stops expanding (0 = unbounded)
+    int ttMemoryMB = 0;           // Macro-MCTS only: transposition table budget shared across macro orders (0 = disabled)
+    bool symmetricCaches = false; // Macro-MCTS only: key the transposition table and prior cache by canonicalHash (symmetry.h), so mirror-image positions share entries
+    bool reuseTree = false;       // Keep the chosen child's subtree as the next root when the next searched state matches it
+    float reuseDecay = 0.5f;      // Visit/value scale applied to a reused subtree (old statistics count for less)
+    int numThreads = 1;           // Macro-MCTS only: workers sharing one tree, spread apart by virtual loss (1 = serial, deterministic)
+    int evalBatchSize = 1;        // Macro-MCTS only: value-function leaf evals queued and run this many at a time (serial search, vfBlend > 0)
+    int opponentReplyWidth = 0;   // Macro-MCTS only: opponent nodes (the searching side's adversary to choose) keep only their this many highest-prior macros, renormalized, so the budget goes to our own decisions (1 = one greedy reply: the policy's argmax at policyBlend 1, else the heuristic favourite; 0 = every macro)
+    int opponentReplyMinDepth = 1;  // Macro-MCTS only: opponentReplyWidth applies to opponent nodes this many macros below the root or deeper
+    int gumbelTopK = 0;           // Macro-MCTS only: Gumbel-top-k root, sequential halving over this many sampled macros within maxIterations (serial search: numThreads > 1 keeps the PUCT root and visit-share targets; 0 = PUCT root)
+    bool earlyStop = false;       // Macro-MCTS only: stop once the most-visited root child can't be overtaken in the budget left
+    int rootParallel = 1;         // Low-level MCTS only: independent trees on their own threads and seeds, root visits summed (1 = one tree)
+    bool pathMoves = false;       // Low-level MCTS only: branch on MOVE_PATH endpoints instead of single-step MOVEs
+    SearchTrace* trace = nullptr; // If set, searches record trace spans here (sampled, see search_trace.h)
+    const std::atomic<bool>* cancel = nullptr;  // Macro-MCTS only: checked with the clock; once set, the search ends as if out of budget
+    bool endgameSolver = false;   // Macro-MCTS only: on the active team's last turn of a half, play the scoring line endgame_solver.h proves best instead of searching
+    bool expectedResolution = false;  // Low-level rollouts and the Macro-MCTS leafLookahead resolve armour, injury, bounces and throw-ins by their typical outcome (ResolutionMode::Expected)
+    bool chanceNodes = false;     // Low-level MCTS only: BLOCK/BLITZ/FOUL nodes branch on their outcomes (chance_outcomes.h), weighted by probability, instead of open-loop dice
+    RootCache* rootCache = nullptr;   // Macro-MCTS only: persistent root results (root_cache.h), consulted before a search and filled after
+    uint64_t rootCacheModel = 0;      // Macro-MCTS only: the networks' key in rootCache (rootCacheModelKey)
+    float fullSearchFraction = 1.0f;  // MCTSPolicy / MacroMCTSPolicy: share of decisions searched with the full budget and logged; the rest run cheapSearchIterations, unlogged (playout-cap randomization)
+    int cheapSearchIterations = 16;   // MCTSPolicy / MacroMCTSPolicy: iteration cap of those cheap searches
 };
 
+struct MCTSNode;
+using MCTSArena = NodeArena<MCTSNode>;
+
 struct MCTSNode {
     Action action;
-    MCTSNode* parent = nullptr;
-    std::vector<MCTSNode> children;
+    // Arena indices (MCTSArena::NONE = no parent / no children). Children
+    // are the numChildren consecutive nodes starting at firstChild.
+    uint32_t parent = MCTSArena::NONE;
+    uint32_t firstChild = MCTSArena::NONE;
+    uint32_t numChildren = 0;
     int visits = 0;
     double totalValue = 0.0;
     bool expanded = false;
     float prior = 1.0f;  // Prior probability from policy network (default uniform)
+    // GameState::hash() of the state the children were generated from (only
+    // recorded with MCTSConfig::reuseTree).
+    uint64_t expandedHash = 0;
+    // MCTSConfig::chanceNodes: a child standing for one outcome of its
+    // parent's action has that outcome's probability here and its script at
+    // index `outcome` of MCTSSearch's table (0 = an ordinary action child).
+    float chance = 0.0f;
+    uint32_t outcome = 0;
 
+    bool isChanceParent(const MCTSArena& arena) const;
     double ucb(double parentLogN, double C) const;
     double puct(double parentVisits, double C) const;
-    MCTSNode* bestChild(double C) const;
-    MCTSNode* bestChildPUCT(double C) const;
-    MCTSNode* mostVisitedChild() const;
+    // Child selection; each returns the chosen child's arena index, or
+    // MCTSArena::NONE if the node has no children.
+    uint32_t bestChild(const MCTSArena& arena, double C) const;
+    // PUCT over the first `width` children only (progressive widening).
+    uint32_t bestChildPUCT(const MCTSArena& arena, double C,
+                           uint32_t width = std::numeric_limits<uint32_t>::max()) const;
+    uint32_t mostVisitedChild(const MCTSArena& arena) const;
+    // The outcome child furthest behind its probability's share of visits.
+    uint32_t chanceChild(const MCTSArena& arena) const;
 };
 
 struct ChildVisitInfo {
     Action action;
     int visits;
+    double totalValue = 0.0;  // backed-up value sum (merging root-parallel trees)
+};
+
+// Where one search() call spent its time and what it built. Phase times are
+// wall time in a serial search; the tree-parallel macro search and the
+// root-parallel ensemble add up every thread's phases, so there they can
+// exceed totalMs. A forced move (one legal choice) leaves everything at 0.
+struct SearchStats {
+    int iterations = 0;
+    double totalMs = 0.0;
+    double selectMs = 0.0;
+    double replayMs = 0.0;
+    double expandMs = 0.0;        // child generation and priors (plus the descent into the new child)
+    double simulateMs = 0.0;      // leaf evaluation, including batched value-function flushes
+    double backpropMs = 0.0;
+    int nodesAllocated = 0;       // arena nodes added by this search (a reused subtree is not counted)
+    int maxDepth = 0;             // deepest node an iteration reached, in edges below the root
+    double avgDepth = 0.0;        // mean of that depth over iterations
+    int truncatedReplays = 0;     // replays cut short by a turnover or terminal phase
+    int leafEvals = 0;            // leaf evaluations (every nRollouts sample counts)
+    int cachedReplays = 0;        // macros not replayed because a cached outcome was sampled instead
+    int lookaheadReuses = 0;      // leafLookahead bonuses reused from earlier samples of the same leaf state
+    int priorCacheHits = 0;       // expansions served by MCTSConfig::priorCacheMB
+    int priorCacheMisses = 0;     // expansions that looked there and computed their priors
+    int recycleSweeps = 0;        // MCTSConfig::maxTreeNodes reached: sweeps that freed frontier subtrees
+    int recycledNodes = 0;        // nodes those sweeps gave back to the arena
+    int expansionsSkipped = 0;    // leaves evaluated unexpanded for want of room in the budget
+    bool stoppedEarly = false;    // MCTSConfig::earlyStop ended the search before its budget
+    bool rootCacheHit = false;    // MCTSConfig::rootCache answered instead of a search
+    double iterationsPerSec = 0.0;
+    // Heap use, counted only in BB_ALLOC_TRACKING builds (bb/alloc_tracking.h):
+    // allocations by the search's own threads, and the process's peak live
+    // bytes when it finished
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+    int64_t peakLiveBytes = 0;
+
+    double priorCacheHitRate() const {
+        int lookups = priorCacheHits + priorCacheMisses;
+        return lookups > 0 ? static_cast<double>(priorCacheHits) / lookups : 0.0;
+    }
+    // Fold another search's counters into this one (threads of one search).
+    void merge(const SearchStats& o);
+    // Add a thread's allocations over the search and take the current peak.
+    void addAllocations(const AllocCounters& delta);
+};
+
+// Lap timer for SearchStats phases: lap() returns the milliseconds since the
+// previous lap (or construction) and starts the next one.
+class SearchTimer {
+    std::chrono::steady_clock::time_point last_ = std::chrono::steady_clock::now();
+public:
+    double lap() {
+        auto now = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(now - last_).count();
+        last_ = now;
+        return ms;
+    }
+    // lap(), also recorded as a `name` span when `trace` is set.
+    double lap(SearchTrace* trace, const char* name, int tid = 0) {
+        auto start = last_;
+        double ms = lap();
+        if (trace) trace->span(name, "phase", start, last_, tid);
+        return ms;
+    }
 };
 
 class MCTSSearch {
     const ValueFunction* valueFn_;
     MCTSConfig config_;
-    DiceRoller dice_;
+    FastDiceRoller dice_;
 
     int lastIterations_ = 0;
     double lastBestValue_ = 0.0;
     std::vector<ChildVisitInfo> lastChildVisits_;
+    SearchStats lastStats_;
 
 public:
     MCTSSearch(const ValueFunction* vf, MCTSConfig config, uint32_t seed = 0);
@@ -65,17 +196,63 @@ public:
     int lastIterations() const { return lastIterations_; }
     double lastBestValue() const { return lastBestValue_; }
     const std::vector<ChildVisitInfo>& lastChildVisits() const { return lastChildVisits_; }
+    const SearchStats& lastStats() const { return lastStats_; }
+    // Root visits carried over by subtree reuse in the last search (0 = fresh tree).
+    int lastReusedVisits() const { return lastReusedVisits_; }
+
+    // Budget for the next searches, every root-parallel tree's included.
+    void setBudget(int timeBudgetMs, int maxIterations);
+    const MCTSConfig& config() const { return config_; }
+
+    // The last search's tree (search_tree_file.h), nodes with fewer than
+    // `minVisits` visits pruned; empty if it built none (a forced move).
+    // Root-parallel searches export their first tree. Valid until the next
+    // search().
+    SearchTree exportTree(int minVisits = 1) const;
 
 private:
-    MCTSNode* select(MCTSNode* root);
-    void expand(MCTSNode* node, const GameState& state);
+    // MCTSConfig::rootParallel > 1: search every ensemble_ tree concurrently
+    // and merge their root statistics into this object's results.
+    Action searchEnsemble(const GameState& state);
+    // Subtree reuse: new root index in arena_, or NONE to build a fresh tree.
+    uint32_t reuseSubtree(const GameState& state);
+    // Tree actions: getAvailableActions, or ...WithPaths under config_.pathMoves
+    void getActions(const GameState& state, std::vector<Action>& out) const;
+    uint32_t select(uint32_t root);
+    // Children of `n` selection may pick (MCTSConfig::wideningExponent).
+    uint32_t openChildren(const MCTSNode& n) const;
+    void expand(uint32_t node, const GameState& state);
+    // MCTSConfig::chanceNodes: rolls `state` back to before `node`'s action
+    // and gives the node one child per outcome. False (state left as it
+    // was) when the action has no enumerated outcomes.
+    bool expandChance(uint32_t node, GameState& state);
+    // Play `node`'s action on the working state, a chance child's with its
+    // outcome forced (a chance parent plays nothing: its child does).
+    void playNode(GameState& state, uint32_t node);
     double simulate(const GameState& state, TeamSide perspective);
-    void backpropagate(MCTSNode* node, double value, TeamSide searchingSide,
+    void backpropagate(uint32_t node, double value, TeamSide searchingSide,
                        const GameState& rootState);
     double rollout(GameState state, TeamSide perspective, int depth);
 
-    // Replay actions from root to node on a cloned state
-    bool replayToNode(GameState& state, MCTSNode* node);
+    // Replay actions from root to node on the working state, journaled so
+    // search() can roll it back to the root afterwards
+    bool replayToNode(GameState& state, uint32_t node);
+
+    MCTSArena arena_;  // tree storage, reset at the start of each search()
+    MCTSArena spare_;  // subtree reuse copies the kept subtree in here, then swaps
+    uint32_t reuseRoot_ = MCTSArena::NONE;  // last search's chosen child
+    uint32_t searchRoot_ = MCTSArena::NONE;  // root of the last search's tree
+    TeamSide searchSide_ = TeamSide::HOME;   // side to move at that root
+    int lastReusedVisits_ = 0;
+    UndoJournal journal_;
+    size_t lastPlayMark_ = 0;  // journal mark before the last action replayToNode played
+    std::vector<ChanceOutcome> outcomes_;  // chance children's scripts (MCTSNode::outcome), kept with the tree
+    std::vector<ChanceOutcome> outcomeScratch_;
+    std::vector<uint32_t> path_;
+    SearchTrace* iterTrace_ = nullptr;  // config_.trace during sampled iterations
+    int traceTid_ = 0;                  // trace track: ensemble member index + 1
+    ActionList rolloutActions_;         // rollout policy scratch, reused across plies
+    std::vector<MCTSSearch> ensemble_;  // root-parallel trees (empty = search this one)
 };
 
 } // namespace bb
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "bb/mcts.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bb {
+
+// Counters, gauges and histograms for monitoring long runs (bb_server,
+// bb_tournament and other batch runs), rendered in the Prometheus text
+// exposition format: served by bb_server (GET /metrics on --metrics-port,
+// or the "metrics" op of its line protocol) and written by bb_tournament
+// as a file for node_exporter's textfile collector (MetricsFile). Rates such as decisions
+// per second are left to the scraper (rate() over the counters).
+//
+// A series is a metric name plus a label set, e.g. `ai="macro_mcts"`,
+// created on first lookup. Lookups take a lock, updates do not: keep the
+// returned reference for hot paths. References stay valid for the
+// registry's lifetime.
+class MetricCounter {
+public:
+    void inc(double by = 1.0) { value_.fetch_add(by, std::memory_order_relaxed); }
+    double value() const { return value_.load(std::memory_order_relaxed); }
+private:
+    std::atomic<double> value_{0.0};
+};
+
+class MetricGauge {
+public:
+    void set(double v) { value_.store(v, std::memory_order_relaxed); }
+    double value() const { return value_.load(std::memory_order_relaxed); }
+private:
+    std::atomic<double> value_{0.0};
+};
+
+class MetricHistogram {
+public:
+    // `bounds`: bucket upper bounds, ascending; +Inf is implied.
+    explicit MetricHistogram(std::vector<double> bounds);
+    void observe(double v);
+    const std::vector<double>& bounds() const { return bounds_; }
+    // Observations at or below bounds()[i]; the last entry counts all.
+    std::vector<uint64_t> cumulativeCounts() const;
+    double sum() const { return sum_.load(std::memory_order_relaxed); }
+private:
+    std::vector<double> bounds_;
+    std::unique_ptr<std::atomic<uint64_t>[]> counts_;  // bounds_.size() + 1, not cumulative
+    std::atomic<double> sum_{0.0};
+};
+
+class MetricsRegistry {
+public:
+    // `labels` is the inside of the braces, `name="value",...` ("" = none).
+    // Throws std::invalid_argument if `name` is registered as another kind.
+    MetricCounter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+    MetricGauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+    MetricHistogram& histogram(const std::string& name, const std::string& help, const std::vector<double>& bounds,
+                               const std::string& labels = "");
+
+    // Every series, metric by metric in registration order.
+    std::string renderPrometheus() const;
+    // renderPrometheus() to `path` by way of a temporary file renamed over
+    // it, so a scraper never reads half a file. False if it cannot be written.
+    bool writeTextFile(const std::string& path) const;
+
+private:
+    enum class Kind : uint8_t { COUNTER, GAUGE, HISTOGRAM };
+    struct Family {
+        Kind kind;
+        std::string help;
+        std::vector<std::pair<std::string, std::unique_ptr<MetricCounter>>> counters;
+        std::vector<std::pair<std::string, std::unique_ptr<MetricGauge>>> gauges;
+        std::vector<std::pair<std::string, std::unique_ptr<MetricHistogram>>> histograms;
+    };
+    Family& family(const std::string& name, const std::string& help, Kind kind);
+
+    mutable std::mutex mutex_;
+    std::vector<std::string> order_;
+    std::map<std::string, Family> families_;
+};
+
+// `label="value"`, the value escaped as the text format requires.
+std::string metricLabel(const std::string& label, const std::string& value);
+
+// One decision by an AI of kind `ai` ("macro_mcts", "mcts", ...) that took
+// `ms`; `stats` is its search's, or null for an AI that does not search.
+// Feeds bb_decisions_total, bb_search_seconds, bb_search_iterations and the
+// cache counters (prior cache, root cache, cached replays), all labelled
+// by `ai`. Forced moves (no iterations) count as decisions only.
+void recordDecision(MetricsRegistry& metrics, const std::string& ai, double ms, const SearchStats* stats);
+
+// A registry exported as a file for a batch run (node_exporter's textfile
+// collector): update() rewrites it, process gauges refreshed, once
+// `intervalMs` has passed since the last write, or at once with `force`.
+// Thread-safe; false if the file could not be written.
+class MetricsFile {
+public:
+    MetricsFile(MetricsRegistry& metrics, std::string path, int intervalMs = 5000)
+        : metrics_(metrics), path_(std::move(path)), interval_(intervalMs) {}
+    bool update(bool force = false);
+private:
+    MetricsRegistry& metrics_;
+    std::string path_;
+    std::chrono::milliseconds interval_;
+    std::mutex mutex_;
+    std::chrono::steady_clock::time_point last_{};
+    bool written_ = false;
+};
+
+// Process-wide gauges, read when called: resident and peak memory, and
+// with a BB_PROFILE build the profiling counters (bb/profile.h) per slot.
+void updateProcessMetrics(MetricsRegistry& metrics);
+
+} // namespace bb
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "bb/simd.h"
+#include "bb/value_function.h"
+#include <memory>
+#include <vector>
+
+namespace bb {
+
+struct MlpLayer {
+    int inputs = 0;
+    int outputs = 0;
+    std::vector<float> weights;  // [outputs][inputs]
+    std::vector<float> bias;     // [outputs]
+};
+
+// Multi-layer perceptron for the value and policy nets: dense layers with a
+// ReLU after every layer but the last. With `residual`, a hidden layer
+// whose input and output widths match adds its input back after the ReLU.
+//
+// Each layer keeps one contiguous row per output unit, padded to the SIMD
+// width. Layers reading 32, 64, 128 or 256 inputs run a kernel compiled for
+// that width (fully unrolled, four output rows per pass over the input);
+// other widths use a runtime-sized loop.
+class Mlp {
+public:
+    // Throws std::invalid_argument if the layer widths do not chain.
+    explicit Mlp(std::vector<MlpLayer> layers, bool residual = false);
+
+    int inputSize() const { return layers_.front().inputs; }
+    int outputSize() const { return layers_.back().outputs; }
+    int numLayers() const { return static_cast<int>(layers_.size()); }
+    bool residual() const { return residual_; }
+    const MlpLayer& layer(int i) const { return layers_[i]; }
+
+    // out[outputSize()] from x[inputSize()].
+    void forward(const float* x, float* out) const;
+    // The layers from `first` on, given the activations entering it.
+    void forwardFrom(int first, const float* h, float* out) const;
+    // out[j] += sum_i W0[j][begin + i] * x[i] for i < count: part of the
+    // first layer's pre-activation, for callers that split its input.
+    void accumulateFirst(const float* x, int begin, int count, float* out) const;
+
+    using Kernel = void (*)(const float* rows, int stride, const float* bias,
+                            const float* x, float* y, int inputs, int outputs);
+
+private:
+    struct Packed {
+        int stride = 0;
+        AlignedVector<float> rows;  // [outputs][stride]
+        Kernel kernel = nullptr;
+        bool addInput = false;      // residual connection
+    };
+    std::vector<MlpLayer> layers_;
+    std::vector<Packed> packed_;
+    bool residual_;
+    int maxWidth_ = 0;
+};
+
+// Mlp from the JSON weights layout: an array of {"W": [[...]], "b": [...]}
+// layers, W input-major ([inputs][outputs]) like the single-hidden-layer
+// formats. A template over the JSON type, so this header does not pull in
+// the JSON library.
+template<typename Json>
+std::shared_ptr<const Mlp> mlpFromJson(const Json& layers, bool residual) {
+    std::vector<MlpLayer> out;
+    for (const auto& jl : layers) {
+        MlpLayer l;
+        const auto& W = jl["W"];
+        l.inputs = static_cast<int>(W.size());
+        l.outputs = static_cast<int>(jl["b"].size());
+        l.weights.resize(static_cast<size_t>(l.inputs) * l.outputs);
+        for (int i = 0; i < l.inputs; ++i) {
+            for (int j = 0; j < l.outputs; ++j) {
+                l.weights[static_cast<size_t>(j) * l.inputs + i] = W[i][j].template get<float>();
+            }
+        }
+        for (const auto& b : jl["b"]) l.bias.push_back(b.template get<float>());
+        out.push_back(std::move(l));
+    }
+    return std::make_shared<const Mlp>(std::move(out), residual);
+}
+
+// Value net over the scalar features: tanh of a one-output Mlp, as
+// NeuralValueFunction is for one hidden layer.
+class MlpValueFunction : public ValueFunction {
+    std::shared_ptr<const Mlp> net_;
+public:
+    // Throws std::invalid_argument unless the net has one output.
+    explicit MlpValueFunction(std::shared_ptr<const Mlp> net);
+    float evaluate(const float* features, int numFeatures) const override;
+    void evaluateBatch(const float* features, int batch, int numFeatures, float* out) const override;
+    const std::shared_ptr<const Mlp>& net() const { return net_; }
+};
+
+} // namespace bb
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "bb/policy_network.h"
+#include "bb/value_function.h"
+#include <cstddef>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace bb {
+
+// Networks loaded from one weights file (JSON or binary). Either may be
+// null: value-only snapshots have no policy and vice versa. Both are
+// immutable once loaded and safe to share between threads.
+struct LoadedModel {
+    std::string path;
+    int64_t mtime = 0;  // file modification time the networks were read at
+    std::shared_ptr<const ValueFunction> value;
+    std::shared_ptr<const PolicyNetwork> policy;
+};
+
+// Registry of loaded models keyed by path. get() re-reads a file only when
+// its modification time changes, so a worker replaying thousands of games
+// against one snapshot parses it once. Callers keep the returned handle;
+// a reload replaces the cached entry without invalidating older handles.
+class ModelCache {
+public:
+    // nullptr if the file is missing or holds neither network.
+    std::shared_ptr<LoadedModel> get(const std::string& path);
+    void clear();
+    size_t size() const;
+    // Number of get() calls that had to (re)load the file.
+    uint64_t loads() const;
+
+    // Process-wide instance used by the Python bindings.
+    static ModelCache& global();
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<LoadedModel>> models_;
+    uint64_t loads_ = 0;
+};
+
+// A model that follows its file, for long-running processes that take
+// promotions without restarting. current() is the networks last loaded;
+// refresh() re-reads the file through the cache when its modification time
+// changes and publishes the new networks with one atomic swap. A search
+// holds the shared_ptr it started with, so it finishes on the old networks
+// while the next one picks up the new. A file that fails to load (still
+// being written, or holding neither network) leaves the current model in
+// place; writing the new weights elsewhere and renaming them over the old
+// file avoids the partial reads altogether.
+class ModelHandle {
+public:
+    // Throws std::runtime_error if `path` cannot be loaded.
+    explicit ModelHandle(std::string path, ModelCache& cache = ModelCache::global());
+    ~ModelHandle();  // stopWatching()
+    ModelHandle(const ModelHandle&) = delete;
+    ModelHandle& operator=(const ModelHandle&) = delete;
+
+    std::shared_ptr<const LoadedModel> current() const { return current_.load(); }
+    // True if a new model was swapped in.
+    bool refresh();
+    // Swaps so far; 0 for the model loaded at construction.
+    uint64_t version() const { return version_.load(); }
+    const std::string& path() const { return path_; }
+
+    // refresh() every `intervalMs` on a background thread until
+    // stopWatching(). Restarts the watcher if one is running.
+    void watch(int intervalMs);
+    void stopWatching();
+
+private:
+    std::string path_;
+    ModelCache& cache_;
+    std::atomic<std::shared_ptr<const LoadedModel>> current_;
+    std::atomic<uint64_t> version_{0};
+    std::mutex refreshMutex_;  // one reload at a time
+    std::mutex watchMutex_;
+    std::condition_variable watchWake_;
+    bool watchStop_ = false;
+    std::thread watcher_;
+};
+
+} // namespace bb
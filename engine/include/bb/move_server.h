@@ -0,0 +1,176 @@
+#pragma once
+
+#include "bb/decision_capture.h"
+#include "bb/game_state.h"
+#include "bb/macro_actions.h"
+#include "bb/macro_mcts.h"
+#include "bb/metrics.h"
+#include "bb/model_cache.h"
+#include "bb/rules_engine.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bb {
+
+// Macro-MCTS moves for out-of-process clients (the web app's AI coaches)
+// from a long-running process that keeps its networks loaded. MoveServer
+// is the transport-free core: a bounded queue in front of a fixed set of
+// search workers, with per-request cancellation. bb_server puts it behind
+// a local socket speaking one JSON object per line (see parseServerMessage).
+
+struct MoveRequest {
+    std::string tag;           // opaque, echoed in the reply (the protocol's raw "id")
+    GameState state;
+    int timeBudgetMs = 0;      // 0 = the server's default; counted from submission, queueing included
+    int maxIterations = 0;     // 0 = the server's default
+    bool plan = false;         // reply with the whole macro plan rather than its first action
+};
+
+enum class MoveStatus : uint8_t { OK, CANCELLED, FAILED };
+const char* moveStatusName(MoveStatus s);
+
+struct MoveReply {
+    std::string tag;
+    MoveStatus status = MoveStatus::OK;
+    std::string error;            // FAILED only
+    Macro macro;                  // the searched macro (OK only)
+    std::vector<Action> actions;  // its first action, or the plan: the expansion under sampled dice,
+                                  // to be followed while each next action stays legal
+    int iterations = 0;
+    double value = 0.0;           // searching side's value of the macro
+    double queueMs = 0.0;
+    double searchMs = 0.0;
+    uint64_t modelVersion = 0;    // ModelHandle::version() of the model searched (live models)
+    std::string capture;          // the slow-decision reproducer written for this search ("" = none)
+};
+
+struct MoveServerConfig {
+    int workers = 2;              // concurrent searches
+    int queueCapacity = 32;       // waiting requests beyond the running ones; more are rejected
+    int maxTimeBudgetMs = 30000;  // cap on a request's budget
+    MCTSConfig search;            // defaults for every request (networks, blends, budget)
+    std::shared_ptr<const LoadedModel> model;  // value network (and policy, when search.policy is unset)
+    // Replaces `model` when set: each search runs on the handle's current
+    // model as it starts, so promotions need no restart. A swapped model
+    // also moves the root cache to a key of its own.
+    std::shared_ptr<ModelHandle> liveModel;
+    // File behind search.policy when it is set apart from the model, for
+    // the reproducers below.
+    std::string policyPath;
+    // Searches that run long are written out for replay (decision_capture.h).
+    SlowDecisionConfig slowDecisions;
+};
+
+class MoveServer {
+public:
+    using Callback = std::function<void(const MoveReply&)>;
+
+    // Starts the workers. Throws std::invalid_argument for a non-positive
+    // worker count or a negative queue capacity.
+    explicit MoveServer(MoveServerConfig config);
+    ~MoveServer();  // shutdown()
+    MoveServer(const MoveServer&) = delete;
+    MoveServer& operator=(const MoveServer&) = delete;
+
+    // Queue `request`; `done` is called exactly once, on a worker thread
+    // (or on the thread cancelling a queued request). Returns the request's
+    // ticket, or 0 if the queue is full or the server is shutting down, in
+    // which case `done` is never called.
+    uint64_t submit(MoveRequest request, Callback done);
+    // A queued request is answered CANCELLED at once; a running search
+    // stops at its next budget check and is answered CANCELLED. False if
+    // the ticket is unknown or already answered.
+    bool cancel(uint64_t ticket);
+    // Stop taking requests, cancel the queued ones, let running searches
+    // finish and join the workers. Idempotent.
+    void shutdown();
+
+    int queued() const;
+    int running() const;
+    const MoveServerConfig& config() const { return config_; }
+    // Requests answered by status, rejected submissions, queue waits, the
+    // searches' recordDecision series (ai "macro_mcts") and transposition
+    // table hits; with the queue, running searches and process gauges as
+    // of the call, in the Prometheus text format (metrics.h).
+    std::string metricsText();
+    MetricsRegistry& metrics() { return metrics_; }
+
+private:
+    struct Job {
+        uint64_t ticket = 0;
+        MoveRequest request;
+        Callback done;
+        std::chrono::steady_clock::time_point submitted;
+    };
+    struct Worker {
+        std::unique_ptr<MacroMCTSSearch> search;
+        std::shared_ptr<const LoadedModel> model;  // the networks `search` points at
+        uint64_t modelVersion = 0;
+        uint32_t seed = 0;
+        std::atomic<bool> cancel{false};
+        uint64_t ticket = 0;  // running job, 0 when idle (under mutex_)
+        uint64_t ttHits = 0;  // search->transpositionTable() counters already exported
+        uint64_t ttMisses = 0;
+    };
+
+    // (Re)build `worker`'s search on `model`.
+    void buildSearch(Worker& worker, std::shared_ptr<const LoadedModel> model, uint64_t version);
+    void workerLoop(Worker& worker);
+    MoveReply choose(Worker& worker, const Job& job);
+    void count(const MoveReply& reply);
+
+    MoveServerConfig config_;
+    MetricsRegistry metrics_;
+    bool policyFromModel_ = false;  // search.policy follows the (live) model
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<Job> queue_;
+    std::unique_ptr<SlowDecisionMonitor> slow_;
+    uint64_t nextTicket_ = 1;
+    bool stopping_ = false;
+};
+
+// The search behind one reply, without the queue: search request.state
+// with `search` at its current budget (setBudget), then expand the macro
+// into actions as MacroMCTSPolicy does, with dice seeded by `planSeed`.
+// Fills reply's status, macro, actions, iterations, value and searchMs;
+// a search stopped through `cancel` is answered CANCELLED. MoveServer's
+// workers run this; so does the single-threaded WebAssembly build.
+void searchMove(MacroMCTSSearch& search, const MoveRequest& request, uint32_t planSeed, MoveReply& reply,
+                const std::atomic<bool>* cancel = nullptr);
+
+// Line protocol. Requests:
+//   {"op":"move","id":ID,"state":{...}|"state_b64":"...","time_ms":N,"iterations":N,"plan":bool}
+//   {"op":"cancel","id":ID}
+//   {"op":"stats"}
+//   {"op":"metrics"}  -> {"status":"ok","metrics":TEXT}, TEXT as MoveServer::metricsText()
+// "state" is stateToJson's object; "state_b64" the base64 of serializeState's
+// record. "op" defaults to "move"; ID is any JSON value and comes back as is.
+enum class ServerOp : uint8_t { MOVE, CANCEL, STATS, METRICS, INVALID };
+
+struct ServerMessage {
+    ServerOp op = ServerOp::INVALID;
+    MoveRequest request;  // MOVE; request.tag also identifies a CANCEL
+    std::string error;    // INVALID
+};
+
+ServerMessage parseServerMessage(const std::string& line);
+// One line each, without the trailing newline.
+std::string moveReplyToJson(const MoveReply& reply);
+std::string serverErrorJson(const std::string& tag, const std::string& error);
+
+std::string encodeBase64(const std::vector<uint8_t>& data);
+// False on characters outside the standard alphabet or a bad length.
+bool decodeBase64(const std::string& text, std::vector<uint8_t>& out);
+
+} // namespace bb
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace bb {
+
+// Per-search storage for MCTS tree nodes. Nodes are addressed by 32-bit
+// index and handed out in contiguous blocks (one block per expand), so a
+// node's children sit next to each other in memory. Storage is a list of
+// fixed-size chunks: growing never moves existing nodes, so a Node* stays
+// valid for the rest of the search. reset() rewinds the cursor and keeps
+// the chunks, making tree teardown O(1) and later searches allocation-free.
+// release() hands a block back for allocate() to reuse when a block of the
+// same size is asked for next (bounded trees recycle subtrees this way).
+//
+// Node must be default-constructible and carry `firstChild`/`numChildren`.
+template<typename Node>
+class NodeArena {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr uint32_t CHUNK_BITS = 12;
+    static constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+
+    // `count` default-initialized nodes at consecutive indices; returns the
+    // first. A block never straddles a chunk, so count <= CHUNK_SIZE.
+    uint32_t allocate(uint32_t count) {
+        assert(count > 0 && count <= CHUNK_SIZE);
+        live_ += count;
+        if (count < freeBlocks_.size() && !freeBlocks_[count].empty()) {
+            uint32_t first = freeBlocks_[count].back();
+            freeBlocks_[count].pop_back();
+            for (uint32_t i = 0; i < count; ++i) (*this)[first + i] = Node{};
+            return first;
+        }
+        uint32_t offset = used_ & (CHUNK_SIZE - 1);
+        if (offset + count > CHUNK_SIZE) used_ += CHUNK_SIZE - offset;  // skip the tail
+        uint32_t first = used_;
+        uint32_t chunk = first >> CHUNK_BITS;
+        if (chunk == chunks_.size()) chunks_.push_back(std::make_unique<Node[]>(CHUNK_SIZE));
+        Node* block = &chunks_[chunk][first & (CHUNK_SIZE - 1)];
+        for (uint32_t i = 0; i < count; ++i) block[i] = Node{};
+        used_ += count;
+        return first;
+    }
+
+    Node& operator[](uint32_t idx) { return chunks_[idx >> CHUNK_BITS][idx & (CHUNK_SIZE - 1)]; }
+    const Node& operator[](uint32_t idx) const { return chunks_[idx >> CHUNK_BITS][idx & (CHUNK_SIZE - 1)]; }
+
+    // nullptr for NONE, so parent walks can stop at the root.
+    Node* get(uint32_t idx) { return idx == NONE ? nullptr : &(*this)[idx]; }
+    const Node* get(uint32_t idx) const { return idx == NONE ? nullptr : &(*this)[idx]; }
+
+    std::span<Node> children(const Node& n) {
+        if (n.numChildren == 0) return {};
+        return {&(*this)[n.firstChild], n.numChildren};
+    }
+    std::span<const Node> children(const Node& n) const {
+        if (n.numChildren == 0) return {};
+        return {&(*this)[n.firstChild], n.numChildren};
+    }
+
+    // Give back a block allocate(count) returned. Its nodes are reset, so
+    // scans over [0, size()) see default nodes there until it is reused.
+    void release(uint32_t first, uint32_t count) {
+        assert(count > 0 && count <= live_);
+        for (uint32_t i = 0; i < count; ++i) (*this)[first + i] = Node{};
+        if (count >= freeBlocks_.size()) freeBlocks_.resize(count + 1);
+        freeBlocks_[count].push_back(first);
+        live_ -= count;
+    }
+
+    void reset() {
+        used_ = 0;
+        live_ = 0;
+        for (auto& blocks : freeBlocks_) blocks.clear();
+    }
+    uint32_t size() const { return used_; }
+    // Nodes allocated and not released.
+    uint32_t live() const { return live_; }
+
+private:
+    std::vector<std::unique_ptr<Node[]>> chunks_;
+    uint32_t used_ = 0;  // next free index (includes skipped chunk tails)
+    uint32_t live_ = 0;
+    std::vector<std::vector<uint32_t>> freeBlocks_;  // released blocks by size
+};
+
+// Edges between `idx` and the root of its tree. Node must carry `parent`.
+template<typename Node>
+int nodeDepth(const NodeArena<Node>& arena, uint32_t idx) {
+    int depth = 0;
+    for (uint32_t cur = arena[idx].parent; cur != NodeArena<Node>::NONE; cur = arena[cur].parent) {
+        ++depth;
+    }
+    return depth;
+}
+
+// Copy the subtree rooted at `root` in `from` into `to` (reset first),
+// breadth-first so every child block stays contiguous, and return its new
+// root index. `adjust` runs on each copied node (e.g. to decay statistics).
+// Node must also carry `parent`; the new root gets NONE.
+template<typename Node, typename F>
+uint32_t copySubtree(const NodeArena<Node>& from, uint32_t root, NodeArena<Node>& to, F&& adjust) {
+    constexpr uint32_t NONE = NodeArena<Node>::NONE;
+    to.reset();
+    uint32_t newRoot = to.allocate(1);
+    to[newRoot] = from[root];
+    to[newRoot].parent = NONE;
+    adjust(to[newRoot]);
+
+    std::vector<std::pair<uint32_t, uint32_t>> queue{{root, newRoot}};  // (from, to)
+    for (size_t q = 0; q < queue.size(); ++q) {
+        auto [src, dst] = queue[q];
+        uint32_t n = from[src].numChildren;
+        if (n == 0) {
+            to[dst].firstChild = NONE;
+            continue;
+        }
+        uint32_t first = to.allocate(n);
+        to[dst].firstChild = first;
+        for (uint32_t i = 0; i < n; ++i) {
+            Node& child = to[first + i];
+            child = from[from[src].firstChild + i];
+            child.parent = dst;
+            adjust(child);
+            queue.push_back({from[src].firstChild + i, first + i});
+        }
+    }
+    return newRoot;
+}
+
+} // namespace bb
@@ -2,6 +2,9 @@
 
 #include "bb/game_state.h"
 #include "bb/position.h"
+#include "bb/bitboard.h"
+#include <algorithm>
+#include <array>
 
 namespace bb {
 
@@ -11,8 +14,50 @@ struct MoveTarget {
     bool isGfi = false;
 };
 
+// Single-source movement map for one player: BFS over empty squares from
+// their current position, limited to MA (less the stand-up cost when prone)
+// plus GFIs. cost[] counts squares moved; dodges[] is the fewest dodges
+// (steps leaving an enemy tacklezone) over any shortest path.
+struct ReachabilityMap {
+    static constexpr int SQUARES = Position::PITCH_WIDTH * Position::PITCH_HEIGHT;
+    static constexpr int8_t UNREACHABLE = -1;
+
+    int playerId = -1;
+    Position origin{-1, -1};
+    int movementAllowance = 0;  // squares available before GFIs start
+    int maxRange = 0;           // movementAllowance + GFIs
+    std::array<int8_t, SQUARES> cost;
+    std::array<int8_t, SQUARES> dodges;
+    Bitboard reachable;         // every square with cost >= 0, origin included
+
+    bool canReach(Position p) const { return p.isOnPitch() && cost[Bitboard::indexOf(p)] >= 0; }
+    int costTo(Position p) const { return canReach(p) ? cost[Bitboard::indexOf(p)] : UNREACHABLE; }
+    int dodgesTo(Position p) const { return canReach(p) ? dodges[Bitboard::indexOf(p)] : UNREACHABLE; }
+    int gfisTo(Position p) const {
+        return canReach(p) ? std::max(0, cost[Bitboard::indexOf(p)] - movementAllowance) : UNREACHABLE;
+    }
+};
+
+// Longest route tracePath() writes: no player's MA plus GFIs comes near it.
+static constexpr int MAX_PATH_LENGTH = 32;
+
+// Build the map from scratch.
+void computeReachability(const GameState& state, const Player& player, ReachabilityMap& out);
+
+// Cached lookup: reuses the map while the state's occupancyStamp() and the
+// player's position/state/movement are unchanged. Per-thread cache; the
+// reference stays valid until the next call on the same thread.
+const ReachabilityMap& getReachability(const GameState& state, const Player& player);
+
+// Route to target that the map scored: reach.costTo(target) steps with
+// reach.dodgesTo(target) dodges, first step first, ending on target. Returns
+// the step count (0 if target is the origin or unreachable).
+int tracePath(const GameState& state, const ReachabilityMap& reach, Position target,
+              Position (&out)[MAX_PATH_LENGTH]);
+
 // Can the player reach any square adjacent to target?
-// If yes, returns true and sets outAdjacent to the best adjacent square.
+// If yes, returns true and sets outAdjacent to the best adjacent square
+// (fewest squares moved, then fewest dodges). Reads getReachability().
 bool canReachAdjacentTo(const GameState& state, const Player& player,
                         Position target, Position& outAdjacent);
 
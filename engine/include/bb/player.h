@@ -2,30 +2,20 @@
 
 #include "bb/enums.h"
 #include "bb/position.h"
-#include "bb/player_stats.h"
-#include <bitset>
+#include "bb/player_profile.h"
 #include <cstdint>
 
 namespace bb {
 
-class SkillSet {
-    std::bitset<128> bits_;
-public:
-    bool has(SkillName s) const { return bits_.test(static_cast<size_t>(s)); }
-    void add(SkillName s) { bits_.set(static_cast<size_t>(s)); }
-    void remove(SkillName s) { bits_.reset(static_cast<size_t>(s)); }
-    int count() const { return static_cast<int>(bits_.count()); }
-    void clear() { bits_.reset(); }
-    bool operator==(const SkillSet& o) const { return bits_ == o.bits_; }
-};
-
+// One player's mutable record: where and how they stand this turn. Stats
+// and skills are a shared PlayerProfile referenced by `profile`; the
+// setters below re-point the player at the profile for the new values.
 struct Player {
     int id = 0;                     // 1-22
     TeamSide teamSide = TeamSide::HOME;
     PlayerState state = PlayerState::OFF_PITCH;
     Position position{0, 0};
-    PlayerStats stats{};
-    SkillSet skills;
+    ProfileId profile = 0;
     int8_t movementRemaining = 0;
     bool hasMoved = false;
     bool hasActed = false;
@@ -33,7 +23,32 @@ struct Player {
     bool lostTacklezones = false;
     bool proUsedThisTurn = false;
 
-    bool hasSkill(SkillName s) const { return skills.has(s); }
+    const PlayerStats& stats() const { return profileOf(profile).stats; }
+    const SkillSet& skills() const { return profileOf(profile).skills; }
+    bool hasSkill(SkillName s) const { return skills().has(s); }
+    // HOT_SKILLS this player has, as hotSkillBit() flags.
+    uint32_t hotSkills() const { return profileOf(profile).hot; }
+
+    void setProfile(const PlayerStats& stats, const SkillSet& skills) {
+        profile = internProfile(stats, skills);
+    }
+    void setStats(const PlayerStats& s) { setProfile(s, skills()); }
+    void setSkills(const SkillSet& s) { setProfile(stats(), s); }
+    void addSkill(SkillName s) {
+        SkillSet k = skills();
+        k.add(s);
+        setSkills(k);
+    }
+    void setStrength(int8_t st) {
+        PlayerStats s = stats();
+        s.strength = st;
+        setStats(s);
+    }
+    void setMovement(int8_t ma) {
+        PlayerStats s = stats();
+        s.movement = ma;
+        setStats(s);
+    }
 
     bool isOnPitch() const { return bb::isOnPitch(state); }
 
@@ -46,4 +61,6 @@ struct Player {
     }
 };
 
+static_assert(sizeof(Player) == 16, "GameState::clone() copies 22 of these");
+
 } // namespace bb
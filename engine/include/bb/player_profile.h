@@ -0,0 +1,99 @@
+#pragma once
+
+#include "bb/enums.h"
+#include "bb/player_stats.h"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace bb {
+
+class SkillSet {
+    uint64_t bits_[2] = {};
+    static_assert(static_cast<int>(SkillName::SKILL_COUNT) <= 128, "skills fit two words");
+public:
+    bool has(SkillName s) const {
+        auto i = static_cast<unsigned>(s);
+        return (bits_[i >> 6] >> (i & 63)) & 1;
+    }
+    void add(SkillName s) {
+        auto i = static_cast<unsigned>(s);
+        bits_[i >> 6] |= uint64_t{1} << (i & 63);
+    }
+    void remove(SkillName s) {
+        auto i = static_cast<unsigned>(s);
+        bits_[i >> 6] &= ~(uint64_t{1} << (i & 63));
+    }
+    int count() const { return std::popcount(bits_[0]) + std::popcount(bits_[1]); }
+    void clear() { bits_[0] = bits_[1] = 0; }
+    uint64_t word(int i) const { return bits_[i]; }
+    bool operator==(const SkillSet& o) const { return bits_[0] == o.bits_[0] && bits_[1] == o.bits_[1]; }
+};
+
+// Skills that rules code tests on every move step, dodge, block or
+// feature extraction, packed into one word per profile (hotSkills) and per
+// team (GameState::teamMayHaveSkill) so a whole pass can be skipped when
+// nobody could have the skill. At most 32 entries.
+inline constexpr SkillName HOT_SKILLS[] = {
+    SkillName::Block, SkillName::Dodge, SkillName::Guard, SkillName::MightyBlow,
+    SkillName::Claw, SkillName::Tackle, SkillName::Sprint, SkillName::SureFeet,
+    SkillName::JumpUp, SkillName::NoHands, SkillName::BallAndChain,
+    SkillName::Tentacles, SkillName::Shadowing, SkillName::DisturbingPresence,
+    SkillName::DivingTackle, SkillName::PrehensileTail, SkillName::BreakTackle,
+    SkillName::Stunty, SkillName::Titchy, SkillName::TwoHeads,
+    // Rare action skills (matchup_features.h)
+    SkillName::ThrowTeamMate, SkillName::RightStuff, SkillName::Bombardier,
+    SkillName::HypnoticGaze, SkillName::MultipleBlock, SkillName::BoneHead,
+    SkillName::ReallyStupid, SkillName::WildAnimal, SkillName::TakeRoot,
+    SkillName::Bloodlust,
+};
+static_assert(std::size(HOT_SKILLS) <= 32, "hot skills fit one word");
+
+// The skill's bit in a hot-skill mask, or 0 if it is not a hot skill.
+constexpr uint32_t hotSkillBit(SkillName s) {
+    for (size_t i = 0; i < std::size(HOT_SKILLS); ++i) {
+        if (HOT_SKILLS[i] == s) return uint32_t{1} << i;
+    }
+    return 0;
+}
+
+inline uint32_t hotSkillMask(const SkillSet& skills) {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < std::size(HOT_SKILLS); ++i) {
+        if (skills.has(HOT_SKILLS[i])) mask |= uint32_t{1} << i;
+    }
+    return mask;
+}
+
+// What a player is, as opposed to where and how they stand: stats and
+// skills never change during a drive, so players share one read-only,
+// process-wide table of the distinct (stats, skills) combinations and keep
+// a 16-bit index into it. That keeps Player (and so GameState::clone(),
+// which replay-based search runs every iteration) small.
+struct PlayerProfile {
+    SkillSet skills;
+    PlayerStats stats{};
+    uint32_t hot = 0;  // hotSkillMask(skills)
+};
+static_assert(sizeof(PlayerProfile) == 24);
+
+using ProfileId = uint16_t;  // 0 = zero stats, no skills
+
+// The table's id for (stats, skills), adding it on first use. Thread-safe;
+// throws std::length_error past 65536 distinct profiles.
+ProfileId internProfile(const PlayerStats& stats, const SkillSet& skills);
+
+namespace detail {
+constexpr int PROFILE_CAPACITY = 65536;
+// Entries never move once interned, and an entry is written before its id
+// is handed out, so lookups take no lock: one indexed load. Zero-filled
+// static storage, so only the pages of profiles in use are ever touched.
+extern PlayerProfile profileTable[PROFILE_CAPACITY];
+} // namespace detail
+
+inline const PlayerProfile& profileOf(ProfileId id) {
+    return detail::profileTable[id];
+}
+
+} // namespace bb
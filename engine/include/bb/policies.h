@@ -30,15 +30,50 @@ struct PolicyDecision {
         float visitFraction;
     };
     std::vector<ActionVisit> visits;  // top-K visited actions
-    BoardSnapshot board;  // raw per-player state at decision time (offline feature research)
+    CompactBoardSnapshot board;  // raw per-player state at decision time (offline feature research)
+    uint64_t stateHash = 0;  // GameState::hash() at decision time (duplicate-position detection)
+    uint64_t canonicalHash = 0;  // canonicalHash(): shared with the y-mirrored position
+    int totalVisits = 0;     // root visits behind the visit fractions
+    SearchStats search;      // the search that produced `visits`
+    bool mirrored = false;   // the y-mirrored twin of the decision before it (symmetry.h)
 };
 
+// What the policy searched for one decision (LoggedGameResult::decisionSearches)
+enum class DecisionSearch : uint8_t {
+    NONE,   // no search: a non-search AI, or a step of a plan already searched
+    CHEAP,  // a playout-cap search (MCTSConfig::fullSearchFraction), never logged
+    FULL,   // the full budget; logged if the policy logs decisions
+};
+
+// Collects what the policy calls inside it searched: MCTSPolicy and
+// MacroMCTSPolicy report each search to the innermost scope of their
+// thread, and nothing when there is none. Scopes nest per thread.
+class DecisionSearchScope {
+    DecisionSearch kind_ = DecisionSearch::NONE;
+    DecisionSearchScope* outer_;
+public:
+    DecisionSearchScope();
+    ~DecisionSearchScope();
+    DecisionSearchScope(const DecisionSearchScope&) = delete;
+    DecisionSearchScope& operator=(const DecisionSearchScope&) = delete;
+
+    DecisionSearch kind() const { return kind_; }
+    static void report(DecisionSearch kind);
+};
+
+// Playout-cap randomization: whether the next decision gets the full search
+// under `config`. Draws from `dice` only when fullSearchFraction < 1.
+bool drawFullSearch(const MCTSConfig& config, FastDiceRoller& dice);
+
 // MCTS-powered selection with optional decision logging
 class MCTSPolicy {
     MCTSSearch search_;
+    FastDiceRoller capDice_;  // fullSearchFraction draws
     std::vector<PolicyDecision> decisions_;
     int topK_ = 20;
     bool logDecisions_ = false;
+    bool logBoards_ = true;
+    bool logMirrored_ = false;
 
 public:
     MCTSPolicy(const ValueFunction* vf, MCTSConfig config, uint32_t seed = 0);
@@ -46,8 +81,13 @@ public:
 
     int lastIterations() const { return search_.lastIterations(); }
     double lastBestValue() const { return search_.lastBestValue(); }
+    const SearchStats& lastSearchStats() const { return search_.lastStats(); }
 
-    void setLogDecisions(bool log, int topK = 20);
+    // logBoards: also capture each decision's board (PolicyDecision::board).
+    // logMirrored: follow each decision with its y-mirrored twin, features
+    // and board taken from the mirrored position (a free augmented sample).
+    // Cheap playout-cap searches are never logged.
+    void setLogDecisions(bool log, int topK = 20, bool logBoards = true, bool logMirrored = false);
     const std::vector<PolicyDecision>& decisions() const { return decisions_; }
     void clearDecisions() { decisions_.clear(); }
 };
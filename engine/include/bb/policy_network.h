@@ -2,6 +2,9 @@
 
 #include "bb/action_features.h"
 #include "bb/feature_extractor.h"
+#include "bb/mlp.h"
+#include "bb/quantization.h"
+#include "bb/simd.h"
 #include <vector>
 #include <memory>
 #include <string>
@@ -18,13 +21,28 @@ class PolicyNetwork {
     // Neural mode: input(POLICY_INPUT_SIZE) → hidden(ReLU) → output(1)
     bool neural_ = false;
     int hiddenSize_ = 0;
-    std::vector<float> W1_;  // POLICY_INPUT_SIZE * hiddenSize, row-major
+    std::shared_ptr<const float[]> W1_;  // POLICY_INPUT_SIZE * hiddenSize, row-major (owned or mapped)
     std::vector<float> b1_;  // hiddenSize
     std::vector<float> W2_;  // hiddenSize
     float b2_ = 0.0f;
 
+    // Deep mode: an Mlp with any number of hidden layers over the same
+    // [state | action] input
+    std::shared_ptr<const Mlp> mlp_;
+
     float temperature_ = 1.0f;
 
+    // Int8 mode (neural only): W1 transposed to hidden-major rows of
+    // [state | action] weights, quantized per hidden unit
+    bool int8_ = false;
+    AlignedVector<int8_t> W1q_;   // hiddenSize * POLICY_INPUT_SIZE
+    std::vector<float> W1scale_;  // hiddenSize
+
+    void evaluateActionsWith(const float* stateFeatures, const float* actionFeatures,
+                             int numActions, float* outLogits, bool useInt8) const;
+    void buildInt8();
+    friend struct WeightsFileAccess;
+
 public:
     // Linear constructors
     PolicyNetwork() : weights_(POLICY_INPUT_SIZE, 0.0f) {}
@@ -34,25 +52,54 @@ public:
     PolicyNetwork(std::vector<float> W1, std::vector<float> b1,
                   std::vector<float> W2, float b2,
                   int hiddenSize, float temperature = 1.0f);
+    // Neural, W1 shared (e.g. mapped from a binary weights file)
+    PolicyNetwork(std::shared_ptr<const float[]> W1, std::vector<float> b1,
+                  std::vector<float> W2, float b2,
+                  int hiddenSize, float temperature = 1.0f);
+    // Deep: `mlp` reads POLICY_INPUT_SIZE inputs and has one output.
+    // Throws std::invalid_argument otherwise.
+    explicit PolicyNetwork(std::shared_ptr<const Mlp> mlp, float temperature = 1.0f);
 
     // Compute logit for a single action
     float evaluateAction(const float* stateFeatures, const float* actionFeatures) const;
 
+    // Logits for numActions candidates from one state (actionFeatures packed
+    // as in computePriors). The state's share of the first layer is computed
+    // once for all of them.
+    void evaluateActions(const float* stateFeatures, const float* actionFeatures,
+                         int numActions, float* outLogits) const;
+
     // Compute softmax priors for all actions.
     // actionFeatures: packed array of numActions * NUM_ACTION_FEATURES floats
     // outPriors: array of numActions floats, will sum to 1.0
     void computePriors(const float* stateFeatures, const float* actionFeatures,
                        int numActions, float* outPriors) const;
 
+    // computePriors for numStates states at once. State s has
+    // actionCounts[s] candidates; their features (and priors in outPriors)
+    // are packed one state after another.
+    void computePriorsBatch(const float* stateFeatures, int numStates,
+                            const float* actionFeatures, const int* actionCounts,
+                            float* outPriors) const;
+
+    // Int8 inference for the neural mode (no effect on a linear policy).
+    void setInt8(bool on) { int8_ = on && neural_; }
+    bool isInt8() const { return int8_; }
+    // Float vs int8 logits over `count` (state, action) pairs, row-major.
+    QuantizationError quantizationError(const float* stateFeatures, const float* actionFeatures,
+                                        int count) const;
+
     bool isNeural() const { return neural_; }
+    bool isDeep() const { return mlp_ != nullptr; }
     float temperature() const { return temperature_; }
     void setTemperature(float t) { temperature_ = t; }
 };
 
-// Load from JSON string with "policy_weights" array and "policy_bias" float
-std::unique_ptr<PolicyNetwork> loadPolicyNetwork(const std::string& jsonStr);
+// Load from JSON string with "policy_weights" array and "policy_bias" float.
+// `int8` selects int8 inference for a neural policy.
+std::unique_ptr<PolicyNetwork> loadPolicyNetwork(const std::string& jsonStr, bool int8 = false);
 
-// Load from JSON file
-std::unique_ptr<PolicyNetwork> loadPolicyNetworkFromFile(const std::string& path);
+// Load from a JSON or binary weights file (see weights_file.h)
+std::unique_ptr<PolicyNetwork> loadPolicyNetworkFromFile(const std::string& path, bool int8 = false);
 
 } // namespace bb
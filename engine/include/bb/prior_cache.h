@@ -0,0 +1,65 @@
+#pragma once
+
+#include "bb/macro_actions.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace bb {
+
+// Macro lists and final (blended, floored and capped) priors of expanded
+// positions, keyed by GameState::hash(). Expanding a node means tactical
+// analysis, macro generation, feature extraction, the policy network and
+// the heuristic prior adjustments; open-loop replay reaches the same position again and
+// again (after a deterministic move, or an END_TURN), within a search and
+// across the searches of one game. The entries depend only on the position
+// and the search config, so they stay valid until clear().
+//
+// Bounded by a byte budget and evicted by the CLOCK approximation of LRU:
+// a hit marks its entry referenced; the hand sweeping for space clears
+// marks and evicts the first unmarked entry.
+class PriorCache {
+public:
+    // 0 = disabled: lookups miss without counting, stores are dropped.
+    explicit PriorCache(size_t bytes = 0);
+
+    bool enabled() const { return budget_ > 0; }
+    size_t size() const { return index_.size(); }
+    size_t bytesUsed() const { return used_; }
+
+    // The macros and priors stored for `key`, if any.
+    bool lookup(uint64_t key, MacroList& macros, std::vector<float>& priors);
+    // Remember them for `key`, evicting older entries to make room.
+    void store(uint64_t key, const MacroList& macros, const std::vector<float>& priors);
+    void clear();
+
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+    uint64_t evictions() const { return evictions_; }
+
+private:
+    struct Entry {
+        uint64_t key = 0;
+        std::vector<Macro> macros;
+        std::vector<float> priors;
+        bool live = false;
+        bool referenced = false;
+    };
+    static size_t entryBytes(size_t macros);
+    // Evict the entry under the hand, or the next unreferenced one.
+    void evictOne();
+
+    size_t budget_;
+    size_t used_ = 0;
+    std::vector<Entry> slots_;
+    std::vector<uint32_t> freeSlots_;
+    std::unordered_map<uint64_t, uint32_t> index_;  // key -> slot
+    size_t hand_ = 0;
+
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t evictions_ = 0;
+};
+
+} // namespace bb
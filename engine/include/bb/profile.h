@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(BB_PROFILE) && (defined(__x86_64__) || defined(_M_X64))
+#include <x86intrin.h>
+#elif defined(BB_PROFILE)
+#include <chrono>
+#endif
+
+namespace bb {
+
+// Hot-path call counters and timers, built in only with -DBB_PROFILE=ON.
+// Each thread accumulates into its own slots (no shared writes on the hot
+// path); profileSnapshot() sums every thread, including threads that have
+// since exited. Without BB_PROFILE the BB_PROFILE_* macros expand to
+// nothing and the API below reports an empty profile.
+//
+// Timings are inclusive: a timed call that runs other timed calls (macro
+// expansion -> executeAction -> getAvailableActions) counts their time too.
+namespace prof {
+
+constexpr int MACRO_TYPES = 14;   // MacroType::MACRO_COUNT
+constexpr int ACTION_TYPES = 15;  // ActionType values, MOVE..MOVE_PATH
+
+enum Slot : int {
+    GET_AVAILABLE_ACTIONS = 0,
+    GET_AVAILABLE_MACROS,
+    EXTRACT_FEATURES,
+    VALUE_EVAL,            // units: feature rows evaluated
+    POLICY_EVAL,           // units: candidate actions scored
+    MACRO_REPLAY,          // MacroMCTSSearch replays; units: macros replayed
+    ACTION_REPLAY,         // MCTSSearch replays; units: actions replayed
+    EXPAND_MACRO,          // + MacroType
+    EXECUTE_ACTION = EXPAND_MACRO + MACRO_TYPES,  // + ActionType
+    NUM_SLOTS = EXECUTE_ACTION + ACTION_TYPES
+};
+
+} // namespace prof
+
+struct ProfileEntry {
+    std::string name;
+    uint64_t calls = 0;
+    uint64_t ticks = 0;    // timer ticks (TSC cycles on x86-64, else ns)
+    uint64_t units = 0;    // slot-specific quantity, e.g. replay depth
+    double seconds = 0.0;  // ticks converted at the measured tick rate
+};
+
+// True when built with BB_PROFILE.
+bool profileEnabled();
+// Slots with at least one call, in slot order.
+std::vector<ProfileEntry> profileSnapshot();
+void profileReset();
+// profileSnapshot() as a text table, busiest slot first.
+std::string profileReport();
+
+#ifdef BB_PROFILE
+
+inline uint64_t profileTicks() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Add one call (plus ticks and units) to the calling thread's slot.
+void profileRecord(int slot, uint64_t ticks, uint64_t units);
+
+class ProfileScope {
+    int slot_;
+    uint64_t units_;
+    uint64_t start_;
+public:
+    explicit ProfileScope(int slot, uint64_t units = 0)
+        : slot_(slot), units_(units), start_(profileTicks()) {}
+    ~ProfileScope() { profileRecord(slot_, profileTicks() - start_, units_); }
+    void addUnits(uint64_t n) { units_ += n; }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define BB_PROFILE_CONCAT_(a, b) a##b
+#define BB_PROFILE_CONCAT(a, b) BB_PROFILE_CONCAT_(a, b)
+// Time the rest of the enclosing block as one call to `slot`.
+#define BB_PROFILE_SCOPE(slot) \
+    ::bb::ProfileScope BB_PROFILE_CONCAT(bbProfileScope_, __LINE__)(slot)
+// Same, as a named scope whose units can be added to before it closes.
+#define BB_PROFILE_NAMED_SCOPE(name, slot) ::bb::ProfileScope name(slot)
+#define BB_PROFILE_UNITS(name, n) (name).addUnits(static_cast<uint64_t>(n))
+
+#else
+
+#define BB_PROFILE_SCOPE(slot) ((void)0)
+#define BB_PROFILE_NAMED_SCOPE(name, slot) ((void)0)
+#define BB_PROFILE_UNITS(name, n) ((void)0)
+
+#endif
+
+} // namespace bb
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "bb/simd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace bb {
+
+// Int8 inference helpers. Weights are quantized once per output channel
+// (hidden unit); activations are quantized per call. Both are symmetric:
+// q = round(x / scale) with scale = max|x| / 127, so a dot product is
+// dotInt8(qa, qb) * scaleA * scaleB with exact int32 accumulation.
+
+// Returns the scale; an all-zero input gets scale 0 and all-zero q.
+inline float quantizeSymmetric(const float* x, int n, int8_t* q) {
+    float maxAbs = 0.0f;
+    for (int i = 0; i < n; ++i) maxAbs = std::max(maxAbs, std::fabs(x[i]));
+    if (maxAbs == 0.0f) {
+        std::fill(q, q + n, int8_t{0});
+        return 0.0f;
+    }
+    float scale = maxAbs / 127.0f;
+    float inv = 1.0f / scale;
+    for (int i = 0; i < n; ++i) {
+        q[i] = static_cast<int8_t>(std::clamp(std::lround(x[i] * inv), -127L, 127L));
+    }
+    return scale;
+}
+
+// Float vs int8 outputs of one model over a sample (see the models'
+// quantizationError()).
+struct QuantizationError {
+    double maxAbs = 0.0;
+    double meanAbs = 0.0;
+    int samples = 0;
+
+    void add(double a, double b) {
+        double e = std::fabs(a - b);
+        maxAbs = std::max(maxAbs, e);
+        meanAbs += (e - meanAbs) / ++samples;
+    }
+};
+
+} // namespace bb
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "bb/dice.h"
+#include "bb/training_shards.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bb {
+
+class MappedFile;
+
+// Experience replay over the state records of a shard directory
+// (training_shards.h). Completed shards are memory-mapped, so only the
+// pages a batch touches are read; the buffer's own memory is one priority
+// tree over `capacity` slots.
+//
+// The buffer holds the newest `capacity` states. Every state gets a
+// writer-order id; refresh() maps shards completed since the last call
+// and unmaps those that have slid wholly out of the window (FIFO
+// eviction). Prioritized sampling draws in proportion to priority^alpha
+// (new states get the largest priority seen so far) and returns
+// importance weights (N * P)^-beta normalized to a batch maximum of 1.
+struct ReplayBufferConfig {
+    uint64_t capacity = 1u << 20;  // states
+    float alpha = 0.6f;
+    float beta = 0.4f;
+    uint64_t seed = 0;
+};
+
+struct ReplayBatch {
+    int size = 0;
+    std::vector<float> features;  // [size][NUM_FEATURES]
+    std::vector<float> outcomes;
+    std::vector<float> weights;   // all 1 for uniform batches
+    std::vector<uint64_t> ids;    // for updatePriorities()
+    std::vector<uint8_t> perspectives;
+};
+
+class ReplayBuffer {
+public:
+    // Maps the completed shards of `dir`. Throws std::invalid_argument for
+    // a zero capacity, std::runtime_error for a shard that is compressed
+    // or does not match this build's state records.
+    ReplayBuffer(std::string dir, ReplayBufferConfig config = {});
+    ~ReplayBuffer();
+    ReplayBuffer(const ReplayBuffer&) = delete;
+    ReplayBuffer& operator=(const ReplayBuffer&) = delete;
+
+    // Pick up shards completed since the last call. Returns how many.
+    // Safe alongside sampling and prefetch.
+    int refresh();
+
+    uint64_t size() const;
+    uint64_t totalAdded() const;  // ids run [totalAdded() - size(), totalAdded())
+
+    // Throws std::runtime_error while the buffer is empty.
+    ReplayBatch sample(int batchSize, bool prioritized);
+    // Ids that have been evicted since they were sampled are ignored.
+    void updatePriorities(const uint64_t* ids, const float* priorities, size_t n);
+
+    // Background threads keep up to `depth` batches ready for nextBatch().
+    void startPrefetch(int batchSize, bool prioritized, int threads = 2, int depth = 4);
+    ReplayBatch nextBatch();  // blocks; throws if prefetch is not running
+    void stopPrefetch();
+
+private:
+    struct MappedShard {
+        std::shared_ptr<const MappedFile> file;
+        const ShardStateRecord* rows = nullptr;
+        uint64_t firstId = 0;
+        uint64_t count = 0;
+    };
+
+    void fill(ReplayBatch& batch, int batchSize, bool prioritized, Xoshiro256& rng) const;
+    const ShardStateRecord& record(uint64_t id) const;
+    uint64_t slotId(uint64_t slot) const;
+    void setPriority(uint64_t slot, double p);
+    void prefetchLoop(int thread, int batchSize, bool prioritized);
+
+    std::string dir_;
+    ReplayBufferConfig config_;
+    std::mutex refreshMutex_;
+    mutable std::shared_mutex mutex_;  // shards_, tree_ and the counters
+    std::deque<MappedShard> shards_;
+    int lastShard_ = -1;
+    uint64_t total_ = 0;
+    uint64_t leaves_ = 1;
+    std::vector<double> tree_;  // sum tree of priority^alpha, leaves at [leaves_, 2 * leaves_)
+    double maxPriority_ = 1.0;
+
+    std::mutex sampleMutex_;  // sample()'s generator
+    Xoshiro256 rng_;
+
+    std::mutex queueMutex_;
+    std::condition_variable queueChanged_;
+    std::deque<ReplayBatch> queue_;
+    std::vector<std::thread> prefetchers_;
+    size_t depth_ = 0;
+    bool stopping_ = false;
+};
+
+} // namespace bb
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "bb/game_simulator.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+// Binary replay file: the turn logs of one game in fixed-size records, so
+// a reader can map the file and index any section directly (the Python
+// reader in blood_bowl/replay_file.py does this with numpy.memmap).
+// Numbers are stored in host byte order (the Python reader assumes
+// little-endian); each section starts on an 8-byte boundary at the offset
+// recorded in the header.
+//
+//   turns    ReplayTurnRecord[numTurns]  the turn index: per-turn header
+//                                        plus the first player and event
+//                                        record of the turn
+//   players  ReplayPlayerRecord[numPlayers]
+//   events   ReplayEventRecord[numEvents]
+//   roster   ReplayRosterRecord[numRoster]  positional name of each player
+//   names    uint32_t offsets[numNames + 1], then the interned name bytes
+//   metadata free-form bytes (e.g. JSON with seed and races)
+//
+// Board snapshots are delta-encoded: a keyframe turn lists every player
+// on the pitch, other turns list only the players whose square, state or
+// ball flag changed since the previous turn. A keyframe is written every
+// REPLAY_KEYFRAME_INTERVAL turns and whenever the set of players on the
+// pitch changes, so decoding any turn replays at most that many turns.
+constexpr uint32_t REPLAY_FILE_MAGIC = 0x50524242;  // "BBRP"
+constexpr uint32_t REPLAY_FILE_VERSION = 1;
+constexpr int REPLAY_KEYFRAME_INTERVAL = 8;
+
+struct ReplayFileHeader {
+    uint32_t magic = REPLAY_FILE_MAGIC;
+    uint32_t version = REPLAY_FILE_VERSION;
+    uint32_t numTurns = 0;
+    uint32_t numPlayers = 0;
+    uint32_t numEvents = 0;
+    uint32_t numRoster = 0;
+    uint32_t numNames = 0;
+    uint32_t metadataBytes = 0;
+    int32_t homeScore = 0;
+    int32_t awayScore = 0;
+    uint64_t turnsOffset = 0;
+    uint64_t playersOffset = 0;
+    uint64_t eventsOffset = 0;
+    uint64_t rosterOffset = 0;
+    uint64_t namesOffset = 0;
+    uint64_t metadataOffset = 0;
+};
+static_assert(sizeof(ReplayFileHeader) == 88);
+
+struct ReplayTurnRecord {
+    enum Flags : uint8_t {
+        AWAY_ACTIVE = 1, TURNOVER = 2, TOUCHDOWN = 4, KEYFRAME = 8, BALL_HELD = 16,
+    };
+    uint8_t half = 0;
+    uint8_t turnNumber = 0;
+    uint8_t flags = 0;
+    int8_t ballX = -1;
+    int8_t ballY = -1;
+    int8_t ballCarrierId = -1;
+    uint8_t homeScore = 0;
+    uint8_t awayScore = 0;
+    uint32_t firstPlayer = 0;  // player records [firstPlayer, next turn's firstPlayer)
+    uint32_t firstEvent = 0;   // likewise for events
+};
+static_assert(sizeof(ReplayTurnRecord) == 16);
+
+// flags: bits 0-1 state (PlayerSnapshot::state), bit 2 has ball, bit 3 away
+struct ReplayPlayerRecord {
+    int8_t id = -1;
+    int8_t x = -1;
+    int8_t y = -1;
+    uint8_t flags = 0;
+};
+static_assert(sizeof(ReplayPlayerRecord) == 4);
+
+// flags: bit 0 success, bits 1-3 die1, bits 4-6 die2. squares holds the
+// 24-bit value from | to << 12 (low byte first), each square packed as
+// (x + 1) | (y + 1) << 6, so coordinates from -1 to 62 round-trip.
+struct ReplayEventRecord {
+    uint8_t type = 0;
+    uint8_t flags = 0;
+    int8_t playerId = -1;
+    int8_t targetId = -1;
+    int8_t roll = 0;
+    uint8_t squares[3] = {};
+};
+static_assert(sizeof(ReplayEventRecord) == 8);
+
+struct ReplayRosterRecord {
+    uint8_t side = 0;  // 0 home, 1 away
+    int8_t id = -1;
+    uint16_t name = 0;  // index into the name table
+};
+static_assert(sizeof(ReplayRosterRecord) == 4);
+
+struct ReplayInfo {
+    int homeScore = 0;
+    int awayScore = 0;
+    std::string metadata;
+};
+
+// `events` is the arena the turns' event ranges index. Returns false if
+// the file cannot be written, a range lies outside `events`, or a value
+// does not fit its field (ids and rolls are int8, dice 0-7, scores 0-255).
+bool writeReplay(const std::string& path, const std::vector<TurnLog>& turns,
+                 const std::vector<GameEvent>& events, const ReplayInfo& info = {});
+
+// Reader over a whole replay file held in memory. turn(i) decodes from the
+// nearest keyframe at or before i.
+class ReplayReader {
+public:
+    // nullptr if the file is missing, not a replay, or malformed.
+    static std::unique_ptr<ReplayReader> open(const std::string& path);
+
+    int numTurns() const { return static_cast<int>(header_.numTurns); }
+    const ReplayInfo& info() const { return info_; }
+    // Decoded turns range over `events`, which is replaced.
+    TurnLog turn(int index, std::vector<GameEvent>& events) const;
+    std::vector<TurnLog> turns(std::vector<GameEvent>& events) const;
+
+private:
+    ReplayReader() = default;
+    bool parse();
+    const ReplayTurnRecord& turnRecord(int i) const;
+    uint32_t endPlayer(int i) const;
+    uint32_t endEvent(int i) const;
+    void applyPlayers(int i, TurnLog& log) const;
+    void fillTurn(int i, TurnLog& log, std::vector<GameEvent>& events) const;
+
+    std::vector<char> bytes_;
+    ReplayFileHeader header_;
+    ReplayInfo info_;
+    std::vector<std::string> names_;
+    std::vector<uint16_t> rosterNames_[2];  // name + 1 by player id, 0 = none
+};
+
+// Game record file: a GameRecord (see game_simulator.h) for replayGame()
+// to re-simulate. A header, the two rosters, the actions at five bytes
+// each (type, player, target, target x, target y) and one byte per die
+// face. Host byte order, like the weights file.
+constexpr uint32_t GAME_RECORD_MAGIC = 0x52474242;  // "BBGR"
+constexpr uint32_t GAME_RECORD_VERSION = 1;
+
+bool writeGameRecord(const std::string& path, const GameRecord& record);
+// nullptr if the file is missing or malformed.
+std::unique_ptr<GameRecord> readGameRecord(const std::string& path);
+
+} // namespace bb
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "bb/game_state.h"
+#include <initializer_list>
+
+namespace bb {
+
+// One d6 roll of a chain: its target (2+..6+, as calculateDodgeTarget and
+// friends return it) and whether a skill (Dodge, Sure Feet, Sure Hands,
+// Catch, ...) rerolls it.
+struct RiskRoll {
+    int target = 2;
+    bool skillReroll = false;
+};
+
+// The rerolls one player's chain can call on.
+struct RerollAccess {
+    bool team = false;   // a team reroll left and none used this turn
+    bool pro = false;    // Pro, not yet used this turn
+    bool loner = false;  // the team reroll is gated on a 4+
+};
+
+// Exact success odds of a chain of rolls by one player, under attemptRoll's
+// reroll order: the skill reroll, then Pro (4+ to use), then the team reroll
+// (behind a 4+ for Loner); Pro and the team reroll serve the chain once
+// each. The odds do not depend on the order of the rolls, so chains of up to
+// MAX_TABLED rolls are answered from a table built on first use and keyed by
+// the multiset of (target, skill) pairs and the reroll access; longer ones
+// are worked out on the spot. For macro generation, macro features and leaf
+// heuristics that want a risk figure without sampling it.
+class RiskOracle {
+public:
+    static constexpr int MAX_TABLED = 6;
+
+    // A single roll with no rerolls.
+    static float rollChance(int target);
+    static float chance(const RiskRoll* rolls, int count, RerollAccess access);
+    static float chance(std::initializer_list<RiskRoll> rolls, RerollAccess access) {
+        return chance(rolls.begin(), static_cast<int>(rolls.size()), access);
+    }
+
+    // What `player` may use right now.
+    static RerollAccess access(const GameState& state, const Player& player);
+    // `gfis` Going For It rolls by `player` (weather and Sure Feet
+    // included); 0 past what the player may attempt (2, 3 with Sprint).
+    static float goForItChance(const GameState& state, const Player& player, int gfis);
+};
+
+} // namespace bb
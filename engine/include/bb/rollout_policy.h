@@ -0,0 +1,43 @@
+#pragma once
+
+#include "bb/game_state.h"
+#include "bb/rules_engine.h"
+#include "bb/dice.h"
+
+namespace bb {
+
+// Chooses the actions MCTSSearch plays past a leaf (MCTSConfig::rolloutDepth).
+// Policies hold no per-call state, so one instance can serve every search
+// and thread; the caller owns `scratch` and keeps it across plies, so a
+// rollout stops allocating once the buffer has grown to its working size.
+class RolloutPolicy {
+public:
+    virtual ~RolloutPolicy() = default;
+
+    // False if the active team has nothing to do (ends the rollout).
+    virtual bool choose(const GameState& state, DiceRollerBase& dice,
+                        ActionList& scratch, Action& out) const = 0;
+};
+
+// Uniform over the full getAvailableActions() list.
+class UniformRolloutPolicy : public RolloutPolicy {
+public:
+    bool choose(const GameState& state, DiceRollerBase& dice,
+                ActionList& scratch, Action& out) const override;
+};
+
+// Picks uniformly among END_TURN and the active team's players that can act
+// or stand up, then uniformly among that one player's actions
+// (getPlayerActions), so a ply pays for one player's move generation rather
+// than the whole team's. Being uniform over players, the ball carrier's
+// dozen pass targets no longer crowd out everyone else's moves.
+class PlayerFirstRolloutPolicy : public RolloutPolicy {
+public:
+    bool choose(const GameState& state, DiceRollerBase& dice,
+                ActionList& scratch, Action& out) const override;
+};
+
+// Used when MCTSConfig::rolloutPolicy is null.
+const RolloutPolicy& defaultRolloutPolicy();
+
+} // namespace bb
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "bb/macro_mcts.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+// Root results of finished macro searches, kept in a memory-mapped file so
+// they outlive the process. Self-play and gating games keep meeting the
+// same early positions (setupHalf's formations, the same first-turn
+// macros); with a cache (MCTSConfig::rootCache) a search of a position
+// already searched under the same model and settings returns the stored
+// visit distribution and value instead of searching again.
+//
+// Entries are keyed by (GameState::hash(), model key). The model key must
+// change whenever the networks do (rootCacheModelKey hashes their files);
+// the search folds its own settings (budget, blends, exploration) into it
+// (rootCacheSearchKey).
+// A hit replaces the search, so the dice the search would have drawn are
+// not drawn: a run with a warm cache plays different games from the same
+// seeds than one without.
+//
+// The file is a fixed number of fixed-size slots (open addressing, a probe
+// window of PROBE slots); when a window is full the least recently used
+// entry in it is replaced. Only the MAX_CHILDREN most visited children of
+// a root are kept, the chosen one first. Every lookup and store holds an
+// exclusive flock, so several processes may share one file.
+struct RootResult {
+    std::vector<MacroChildVisitInfo> children;  // the chosen macro first
+    double value = 0.0;                         // searching side's value of the chosen macro
+};
+
+class RootCache {
+public:
+    static constexpr int MAX_CHILDREN = 32;
+    static constexpr int PROBE = 8;
+
+    // Open `path`, creating a cache of about `bytes` if the file does not
+    // exist or has another layout. An existing cache keeps its own size and
+    // contents. nullptr if the file cannot be created or mapped, and always
+    // in the WebAssembly build, which has no file to share.
+    static std::unique_ptr<RootCache> open(const std::string& path, size_t bytes);
+    ~RootCache();
+    RootCache(const RootCache&) = delete;
+    RootCache& operator=(const RootCache&) = delete;
+
+    bool lookup(uint64_t state, uint64_t model, RootResult& out);
+    // `result.children` must be non-empty.
+    void store(uint64_t state, uint64_t model, const RootResult& result);
+
+    size_t capacity() const { return slots_; }
+    size_t size() const;  // occupied slots
+
+    // This process's traffic since open().
+    uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+    uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+    uint64_t evictions() const { return evictions_.load(std::memory_order_relaxed); }
+
+private:
+    struct Header;
+    struct Slot;
+    RootCache(int fd, void* data, size_t bytes);
+    Header& header() const;
+    Slot& slot(size_t i) const;
+
+    int fd_;
+    void* data_;
+    size_t bytes_;
+    size_t slots_;
+    std::mutex mutex_;  // threads of this process; flock covers the others
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> evictions_{0};
+};
+
+// Contents hash of the files a search's networks were read from (value and
+// policy; an empty path for none), for MCTSConfig::rootCacheModel; 0 if
+// one cannot be read.
+uint64_t rootCacheModelKey(const std::vector<std::string>& paths);
+// The model key a search under `config` stores and looks up with:
+// rootCacheModel combined with every setting the result depends on.
+uint64_t rootCacheSearchKey(const MCTSConfig& config);
+
+} // namespace bb
@@ -4,6 +4,7 @@
 #include "bb/player.h"
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace bb {
 
@@ -48,7 +49,8 @@ const TeamRoster& getUnderworldRoster();
 const TeamRoster& getKhorneRoster();
 const TeamRoster& getChaosPactRoster();
 
-// Lookup roster by name (case-insensitive)
+// Lookup roster by name: case-insensitive, ignoring anything but letters
+// and digits ("wood-elf", "Wood Elf", "WOOD_ELF"). findRosterId's keys.
 const TeamRoster* getRosterByName(const std::string& name);
 
 // Lookup developed (skilled) roster for a given team value.
@@ -59,4 +61,39 @@ const TeamRoster* getDevelopedRoster(const std::string& name, int tv);
 // Classify roster speed based on average MA of an 11-player team
 RosterSpeed classifyRosterSpeed(const TeamRoster& roster);
 
+// --- Roster registry ---
+// Every built-in roster has a small stable id, for files and logs that
+// would otherwise carry its name: the base rosters in the order declared
+// above, then the developed TV1200 variants. Ids are append-only; a change
+// that gives an existing id another roster bumps ROSTER_REGISTRY_VERSION,
+// which files store beside the ids they write. Lookups are O(1) both ways.
+using RosterId = uint8_t;
+constexpr RosterId INVALID_ROSTER = 0xFF;
+constexpr uint32_t ROSTER_REGISTRY_VERSION = 1;
+
+int rosterCount();
+// nullptr for an id outside [0, rosterCount()).
+const TeamRoster* rosterById(RosterId id);
+// The id of a built-in roster or of an unchanged copy of one (by name and
+// contents); INVALID_ROSTER for anything else (a custom or edited roster).
+RosterId rosterIdOf(const TeamRoster& roster);
+// By key: "human", "woodelf", ..., "orctv1200"; names are normalized as
+// for getRosterByName, so "Orc (TV1200)" finds the developed orc roster.
+RosterId findRosterId(std::string_view name);
+// The normalized key of a built-in roster, or "" for an invalid id.
+const char* rosterKey(RosterId id);
+
+// A positional of a built-in roster: its roster id and its index in
+// TeamRoster::positionals, packed into 16 bits.
+using PositionalId = uint16_t;
+constexpr PositionalId INVALID_POSITIONAL = 0xFFFF;
+
+constexpr PositionalId makePositionalId(RosterId roster, int index) {
+    return static_cast<PositionalId>(roster << 3 | (index & 7));
+}
+constexpr RosterId positionalRoster(PositionalId id) { return static_cast<RosterId>(id >> 3); }
+constexpr int positionalSlot(PositionalId id) { return id & 7; }
+// nullptr unless the roster exists and has the positional.
+const PlayerTemplate* positionalById(PositionalId id);
+
 } // namespace bb
@@ -3,6 +3,7 @@
 #include "bb/game_state.h"
 #include "bb/enums.h"
 #include "bb/position.h"
+#include "bb/inline_vector.h"
 #include <vector>
 
 namespace bb {
@@ -14,6 +15,53 @@ struct Action {
     Position target{-1, -1};
 };
 
+// Stack-allocatable action list. 256 covers every ordinary position (the
+// adjacency-based actions of eleven players plus blitz and pass targets);
+// Throw Team-Mate grids can overflow it onto the heap.
+using ActionList = InlineVector<Action, 256>;
+
 void getAvailableActions(const GameState& state, std::vector<Action>& out);
+void getAvailableActions(const GameState& state, ActionList& out);
+
+// Whether getAvailableActions(state) lists `action`, decided for that one
+// action without generating the others (no reachability flood unless it is
+// a BLITZ at a non-adjacent target). For validating planned or submitted
+// actions.
+bool isActionLegal(const GameState& state, const Action& action);
+
+// getAvailableActions() with each player's single-step MOVEs replaced by one
+// MOVE_PATH per reachable square (stand-ups stay MOVEs), so a run of several
+// squares is one choice instead of one per square. Path moves follow the
+// single-step actions, by player, in ascending square order.
+void getAvailableActionsWithPaths(const GameState& state, std::vector<Action>& out);
+
+// The slice of getAvailableActions() belonging to one player of the active
+// team (END_TURN excluded), in the same order; empty if the player cannot act
+// or stand up. Lets samplers pick a player first and generate only its moves.
+void getPlayerActions(const GameState& state, const Player& player, std::vector<Action>& out);
+void getPlayerActions(const GameState& state, const Player& player, ActionList& out);
+
+// Publishes the move list of the decision a game loop is about to hand to a
+// policy, for the lifetime of the scope: the loop has already generated it
+// to check for an empty list, so the policy reads it instead of generating
+// it again. A state is matched by identity, so the list must outlive the
+// scope and the state must not change inside it. Scopes nest per thread.
+class PublishedActions {
+    const GameState* state_;
+    const ActionList* actions_;
+    const PublishedActions* outer_;
+public:
+    PublishedActions(const GameState& state, const ActionList& actions);
+    ~PublishedActions();
+    PublishedActions(const PublishedActions&) = delete;
+    PublishedActions& operator=(const PublishedActions&) = delete;
+
+    // The innermost published list if it was published for `state` itself,
+    // else nullptr.
+    static const ActionList* find(const GameState& state);
+};
+
+// The published list for `state`, or getAvailableActions() into `scratch`.
+const ActionList& decisionActions(const GameState& state, ActionList& scratch);
 
 } // namespace bb
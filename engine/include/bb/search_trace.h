@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+// Chrome trace_event recorder for MCTS searches (open the written file in
+// chrome://tracing or ui.perfetto.dev). A search given one through
+// MCTSConfig::trace records a span for the whole search() and, for every
+// sampleEvery-th iteration, spans for its select / replay / expand /
+// simulate / backprop phases with each replayed macro or action nested
+// under replay. Unsampled iterations cost one modulo. Tree-parallel workers
+// and root-parallel trees record on their own track (tid = index + 1).
+// Thread-safe.
+class SearchTrace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit SearchTrace(int sampleEvery = 16);
+
+    int sampleEvery() const { return sampleEvery_; }
+    bool sampled(int iteration) const { return iteration % sampleEvery_ == 0; }
+
+    // One complete ("X") event. `args` is a JSON object body without the
+    // braces (e.g. "\"depth\":3"), or empty.
+    void span(const char* name, const char* category, Clock::time_point start,
+              Clock::time_point end, int tid = 0, std::string args = {});
+
+    size_t size() const;
+    void clear();
+    std::string toJson() const;
+    // False if the file cannot be written.
+    bool write(const std::string& path) const;
+
+private:
+    struct Event {
+        const char* name;
+        const char* category;
+        double startUs;
+        double durUs;
+        int tid;
+        std::string args;
+    };
+
+    int sampleEvery_;
+    Clock::time_point origin_;
+    mutable std::mutex mutex_;
+    std::vector<Event> events_;
+};
+
+// RAII span; inert when `trace` is null, so call sites pass the trace only
+// for sampled iterations.
+class TraceSpan {
+    SearchTrace* trace_;
+    const char* name_;
+    const char* category_;
+    int tid_;
+    SearchTrace::Clock::time_point start_;
+public:
+    std::string args;  // filled in before the span closes
+
+    TraceSpan(SearchTrace* trace, const char* name, const char* category = "search", int tid = 0)
+        : trace_(trace), name_(name), category_(category), tid_(tid),
+          start_(trace ? SearchTrace::Clock::now() : SearchTrace::Clock::time_point{}) {}
+    ~TraceSpan() {
+        if (trace_) trace_->span(name_, category_, start_, SearchTrace::Clock::now(), tid_, std::move(args));
+    }
+    bool active() const { return trace_ != nullptr; }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+};
+
+} // namespace bb
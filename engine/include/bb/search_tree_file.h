@@ -0,0 +1,108 @@
+#pragma once
+
+#include "bb/enums.h"
+#include "bb/node_arena.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+// A finished search tree, flattened for offline analysis: what one
+// production search explored, without re-running it (MCTSSearch::
+// exportTree, MacroMCTSSearch::exportTree). Nodes are breadth-first from
+// the root (row 0), so a node's kept children are consecutive rows and
+// every parent row comes before its children.
+//
+// File: a SearchTreeFileHeader, then numNodes SearchTreeRecords, in host
+// byte order (the Python reader, blood_bowl/search_tree.py, maps it with
+// numpy and assumes little-endian).
+constexpr uint32_t SEARCH_TREE_MAGIC = 0x54534242;  // "BBST"
+constexpr uint32_t SEARCH_TREE_VERSION = 1;
+
+struct SearchTreeRecord {
+    int32_t parent = -1;       // row of the parent; -1 for the root
+    int32_t visits = 0;
+    float q = 0.0f;            // mean backed-up value, from the searching side's view
+    float prior = 0.0f;
+    float chance = 0.0f;       // MCTSConfig::chanceNodes outcome probability, else 0
+    uint32_t numChildren = 0;  // kept children (rows after pruning)
+    uint8_t kind = 0;          // ActionType (action tree) or MacroType (macro tree)
+    int8_t playerId = -1;
+    int8_t targetId = -1;
+    int8_t thirdId = -1;       // macros: CHAIN_SCORE's scorer
+    int8_t targetX = -1;
+    int8_t targetY = -1;
+    // The team whose choice this node is (the side to move at the root);
+    // TEAM_UNKNOWN when the tree does not say.
+    uint8_t actingTeam = 0;
+    uint8_t depth = 0;         // edges below the root, capped at 255
+
+    static constexpr uint8_t TEAM_UNKNOWN = 255;
+};
+static_assert(sizeof(SearchTreeRecord) == 32);
+
+struct SearchTree {
+    bool macro = false;  // kind holds MacroTypes
+    TeamSide searchingSide = TeamSide::HOME;
+    int minVisits = 0;   // pruning threshold the tree was exported with
+    std::vector<SearchTreeRecord> nodes;
+};
+
+struct SearchTreeFileHeader {
+    uint32_t magic = SEARCH_TREE_MAGIC;
+    uint32_t version = SEARCH_TREE_VERSION;
+    uint32_t numNodes = 0;
+    uint8_t macro = 0;
+    uint8_t searchingSide = 0;
+    uint16_t reserved = 0;
+    int32_t minVisits = 0;
+    uint32_t reserved2 = 0;
+};
+static_assert(sizeof(SearchTreeFileHeader) == 24);
+
+// False if the file cannot be written.
+bool writeSearchTree(const std::string& path, const SearchTree& tree);
+// nullptr if the file is missing, not a search tree, or malformed.
+std::unique_ptr<SearchTree> readSearchTree(const std::string& path);
+
+// The subtree of `arena` under `root`, breadth-first, keeping only nodes
+// with at least `minVisits` visits (and their ancestors: a pruned node's
+// subtree goes with it). The root is always kept. `fill(node, parent,
+// record)` sets the move fields and actingTeam; parent is null for the
+// root. The search's node types carry firstChild / numChildren / visits /
+// totalValue / prior.
+template<typename Node, typename Fill>
+void flattenTree(const NodeArena<Node>& arena, uint32_t root, int minVisits,
+                 std::vector<SearchTreeRecord>& out, Fill&& fill) {
+    out.clear();
+    if (root == NodeArena<Node>::NONE) return;
+    std::vector<uint32_t> index{root};  // arena index of each row
+    out.emplace_back();
+    for (size_t row = 0; row < index.size(); ++row) {
+        const Node& n = arena[index[row]];
+        {
+            SearchTreeRecord& r = out[row];
+            r.visits = n.visits;
+            r.q = n.visits > 0 ? static_cast<float>(n.totalValue / n.visits) : 0.0f;
+            r.prior = n.prior;
+            fill(n, r.parent < 0 ? nullptr : &arena[index[r.parent]], r);
+        }
+        uint32_t kept = 0;
+        for (uint32_t c = 0; c < n.numChildren; ++c) {
+            uint32_t child = n.firstChild + c;
+            if (arena[child].visits < minVisits) continue;
+            SearchTreeRecord r;
+            r.parent = static_cast<int32_t>(row);
+            r.depth = static_cast<uint8_t>(std::min(255, out[row].depth + 1));
+            index.push_back(child);
+            out.push_back(r);
+            ++kept;
+        }
+        out[row].numChildren = kept;
+    }
+}
+
+} // namespace bb
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "bb/value_function.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+// Self-play spread over several machines. A coordinator (bb_coordinator)
+// splits a run into work units, fixed blocks of seeds, and hands them to
+// bb_worker processes over TCP. A worker fetches the run's model by content
+// hash into its local cache, plays the unit with runBatchedSelfPlay, and
+// streams the results and the unit's training shards back. Each unit's
+// games depend only on its seeds and the run, so a unit retried elsewhere
+// (its worker failed, or its lease ran out) produces the same games, and a
+// run's output does not depend on which worker played what.
+//
+// ClusterCoordinator is the transport-free bookkeeping, ClusterChannel the
+// framing, and serveClusterConnection / runClusterWorker the two ends of
+// the conversation; the CLIs only open sockets.
+
+// What a worker needs to play any unit of a run.
+struct ClusterRunSpec {
+    std::string home = "human";  // getRosterByName names
+    std::string away = "orc";
+    std::string modelHash;       // value network, by contentHash()
+    // MCTSConfig fields over the defaults, as setSearchParameter names them
+    std::map<std::string, double> search;
+    int concurrentGames = 8;     // BatchedSelfPlayConfig::concurrentGames
+    int topK = 20;
+    bool useFullKickoff = false;
+};
+
+struct ClusterRunConfig {
+    ClusterRunSpec spec;
+    uint32_t firstSeed = 1;
+    int games = 0;
+    int unitGames = 16;          // seeds per unit; the last unit takes the rest
+    int maxAttempts = 3;         // a unit failing this often is given up
+    int leaseMs = 30 * 60 * 1000;  // an assigned unit not reported by then is reassigned
+};
+
+// Unit `id` plays seeds firstSeed + id * unitGames onwards.
+struct WorkUnit {
+    uint32_t id = 0;
+    int attempt = 0;             // 1 for the first assignment
+    uint32_t firstSeed = 0;
+    int games = 0;
+    ClusterRunSpec spec;
+};
+
+struct ClusterFile {
+    std::string name;            // relative to the unit's output directory
+    std::vector<uint8_t> bytes;
+};
+
+struct UnitResult {
+    int homeWins = 0;
+    int awayWins = 0;
+    int draws = 0;
+    long totalActions = 0;
+    std::vector<ClusterFile> files;  // the unit's shard directory
+};
+
+// Hex digest of `bytes` (two 64-bit FNV-1a lanes), naming model files.
+std::string contentHash(const std::vector<uint8_t>& bytes);
+
+// Model files on a worker's disk, named by content hash, so a model is
+// transferred once per machine however many units use it.
+class ContentStore {
+public:
+    explicit ContentStore(std::string dir);
+
+    std::string path(const std::string& hash) const;
+    bool has(const std::string& hash) const;
+    // Write `bytes` under `hash` (via a temporary file and a rename); false
+    // if they do not hash to `hash` or cannot be written.
+    bool put(const std::string& hash, const std::vector<uint8_t>& bytes);
+
+private:
+    std::string dir_;
+};
+
+// Unit bookkeeping for one run. Units are handed out lowest id first and
+// retried up to maxAttempts; results are kept by unit id. Thread-safe.
+class ClusterCoordinator {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Throws std::invalid_argument for no games, a non-positive unit size
+    // or attempt limit, or a run without a model hash.
+    explicit ClusterCoordinator(ClusterRunConfig config);
+
+    // The next unit for `worker`, or nothing if every unit is done, given
+    // up or leased out (see finished()).
+    std::optional<WorkUnit> assign(const std::string& worker, Clock::time_point now = Clock::now());
+    // Record a unit's result. Any attempt's result is accepted while the
+    // unit is open, since every attempt plays the same games; false if the
+    // unit is unknown or already settled.
+    bool complete(uint32_t id, UnitResult result);
+    // An attempt failed: the unit goes back in line until it has failed
+    // maxAttempts times. Stale attempts (already superseded) are ignored.
+    void fail(uint32_t id, int attempt, const std::string& error);
+    // `worker` went away: its leased units fail.
+    void workerLost(const std::string& worker);
+    // Fail the leases older than leaseMs; returns how many.
+    int expireLeases(Clock::time_point now = Clock::now());
+
+    bool finished() const;
+    int units() const { return static_cast<int>(units_.size()); }
+    int completed() const;
+    int failed() const;
+    // The results of the completed units, by id.
+    std::map<uint32_t, UnitResult> takeResults();
+    const ClusterRunConfig& config() const { return config_; }
+
+private:
+    enum class UnitState : uint8_t { PENDING, LEASED, DONE, FAILED };
+    struct Unit {
+        UnitState state = UnitState::PENDING;
+        int attempts = 0;
+        std::string worker;
+        Clock::time_point leased;
+        std::string lastError;
+    };
+    void failLocked(uint32_t id, const std::string& error);
+
+    ClusterRunConfig config_;
+    mutable std::mutex mutex_;
+    std::vector<Unit> units_;
+    std::map<uint32_t, UnitResult> results_;
+};
+
+// Play `unit` with `model`: runBatchedSelfPlay over its seeds, shards
+// written under `scratchDir` (removed afterwards) and read back into the
+// result. Outcomes are +1 / 0 / -1 by the final score. Throws
+// std::invalid_argument for an unknown roster or search field.
+UnitResult runWorkUnit(const WorkUnit& unit, const ValueFunction& model, const std::string& scratchDir);
+
+// Framing over a connected stream socket: JSON lines, each optionally
+// followed by a raw payload whose size the line announces.
+class ClusterChannel {
+public:
+    explicit ClusterChannel(int fd) : fd_(fd) {}
+
+    // False once the peer has closed or on a socket error.
+    bool readLine(std::string& line);
+    bool readBytes(size_t n, std::vector<uint8_t>& out);
+    bool writeLine(const std::string& line);
+    bool writeBytes(const std::vector<uint8_t>& bytes);
+
+private:
+    int fd_;
+    std::string buffer_;
+};
+
+// Coordinator side of one worker connection, until the worker leaves or
+// the run is finished. `model` is the file behind spec.modelHash.
+//   worker: {"op":"hello","worker":NAME}
+//   worker: {"op":"next"}              -> {"op":"unit",...} | {"op":"wait","ms":N} | {"op":"done"}
+//   worker: {"op":"model","hash":H}    -> {"op":"model","hash":H,"bytes":N} + N bytes
+//   worker: {"op":"result","unit":ID,"attempt":A,...,"files":[{"name":..,"bytes":N},..]}
+//           + the files back to back   -> {"op":"ack","unit":ID}
+//   worker: {"op":"failed","unit":ID,"attempt":A,"error":MSG}
+void serveClusterConnection(ClusterCoordinator& coordinator, ClusterChannel& channel,
+                            const std::vector<uint8_t>& model);
+
+struct ClusterWorkerOptions {
+    std::string name = "worker";
+    std::string cacheDir;        // ContentStore for models
+    std::string scratchDir;      // per-unit shard output before upload
+    int maxUnits = 0;            // stop after this many units (0 = until done)
+};
+
+// Worker side: asks for units until the coordinator says done, maxUnits
+// are played or the connection drops. Returns the number of units
+// completed; `finished`, if given, is set unless the connection dropped.
+int runClusterWorker(ClusterChannel& channel, const ClusterWorkerOptions& options,
+                     bool* finished = nullptr);
+
+} // namespace bb
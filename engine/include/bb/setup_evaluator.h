@@ -0,0 +1,29 @@
+#pragma once
+
+#include "bb/game_state.h"
+#include "bb/value_function.h"
+#include <vector>
+
+namespace bb {
+
+// Where one side's 11 players stand for a kickoff: squares[i] is player
+// baseId + i (1 for HOME, 12 for AWAY).
+struct SetupCandidate {
+    Position squares[11];
+};
+
+// The side's setup as `state` has it.
+SetupCandidate currentSetup(const GameState& state, TeamSide side);
+
+// Values each candidate setup for `side` with `vf`, from `perspective`.
+// `state` is a drive start as setupHalf/setupDrive leave it. Each candidate
+// is placed and played out over every square the kick can land on
+// (kickTable; touchbacks go to the nearest receiver). The values are
+// averaged by the landing chances. Kickoff table events are left out. All
+// the positions go through a single evaluateBatch call. Returns the raw
+// value function outputs, one per candidate.
+std::vector<float> evaluateSetups(const GameState& state, TeamSide side,
+                                  const std::vector<SetupCandidate>& candidates,
+                                  const ValueFunction& vf, TeamSide perspective);
+
+} // namespace bb
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "bb/training_shards.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+// Merges training shard directories into one, folding duplicate policy
+// decisions (the same position reached in many games: setups, forced
+// sequences) into a single record and dropping decisions that carry
+// little information. The output is an ordinary shard directory.
+//
+// Duplicates share a key: the decision's stateHash, or with `canonical`
+// its canonicalHash, which a position shares with its y-mirror. A group
+// keeps its first record's features and orientation; each duplicate in
+// that orientation folds in its visit distribution, weighted by the
+// records' visitWeight (actions matched by their feature rows, absent
+// ones counting as 0). A mirrored duplicate's action features do not line
+// up with the group's, so it folds in only its outcome and sample count.
+// Outcomes average over samples; visitWeight and samples add up.
+//
+// Memory stays within `memoryBytes` by splitting the key space into as
+// many partitions as the input needs and reading the input once per
+// partition. State records carry no hash and are copied through.
+struct CompactorConfig {
+    bool canonical = false;
+    uint64_t memoryBytes = 1ull << 30;
+    // Low-information decisions, dropped before grouping:
+    int minActions = 2;            // fewer visited actions (a forced move) drops the decision
+    float minVisitWeight = 0.0f;   // searches with fewer root visits
+    float maxTopFraction = 1.0f;   // a top action above this share (a foregone choice); 1 keeps all
+    bool copyStates = true;
+    ShardWriterConfig output;
+};
+
+struct CompactorStats {
+    uint64_t decisionsIn = 0;
+    uint64_t dropped = 0;          // by the low-information rules
+    uint64_t merged = 0;           // folded into an earlier duplicate
+    uint64_t mirrorMerged = 0;     // of which outcome-only (mirrored duplicates)
+    uint64_t decisionsOut = 0;
+    uint64_t visitsIn = 0;
+    uint64_t visitsOut = 0;
+    uint64_t statesOut = 0;
+    int passes = 0;
+};
+
+// Compacts the completed shards of `inputDirs` (index order, directory by
+// directory) into `outputDir`, continuing after any shards it holds.
+// Throws std::invalid_argument for a bad config or an output directory
+// that is also an input, std::runtime_error for a compressed shard or one
+// that does not match this build's records.
+CompactorStats compactShards(const std::vector<std::string>& inputDirs, const std::string& outputDir,
+                             const CompactorConfig& config = {});
+
+} // namespace bb
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "bb/dice.h"
+#include "bb/simd.h"
+#include "bb/training_shards.h"
+#include "bb/worker_pool.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+class MappedFile;
+
+// Minibatch training of the engine's small networks straight from a shard
+// directory (training_shards.h), without a trip through Python per batch.
+// The models are the ones the engine evaluates, and weightsJson() writes
+// the JSON their loaders read:
+//
+//   LINEAR_VALUE   LinearValueFunction   w . x               a flat weight list
+//   NEURAL_VALUE   NeuralValueFunction   tanh(W2 relu(W1 x))  {"type": "neural", ...}
+//   LINEAR_POLICY  PolicyNetwork         softmax over the     {"policy_weights", ...}
+//   NEURAL_POLICY  PolicyNetwork         decision's actions   {"policy_type": "neural", ...}
+//
+// Value models fit the state records' outcomes (squared error, halved);
+// policy models fit each decision's visit distribution (cross-entropy of
+// the softmax over its candidates). Shards are memory-mapped, so only the
+// records a batch touches are read; compressed shards are rejected.
+//
+// A batch is cut into a fixed number of chunks whose gradients are summed
+// in chunk order, so a run depends on the data, the config and the seed
+// but not on the thread count.
+enum class TrainerModel : uint8_t { LINEAR_VALUE, NEURAL_VALUE, LINEAR_POLICY, NEURAL_POLICY };
+enum class TrainerOptimizer : uint8_t { SGD, ADAM };
+
+const char* trainerModelName(TrainerModel model);
+// "linear_value", "neural_value", "linear_policy" or "neural_policy";
+// false for anything else.
+bool parseTrainerModel(const std::string& name, TrainerModel& out);
+
+struct TrainerConfig {
+    TrainerModel model = TrainerModel::LINEAR_VALUE;
+    int hiddenSize = 32;          // NEURAL_* only
+    TrainerOptimizer optimizer = TrainerOptimizer::ADAM;
+    float learningRate = 1e-3f;
+    float momentum = 0.0f;        // SGD only
+    float beta1 = 0.9f;           // ADAM only
+    float beta2 = 0.999f;
+    float epsilon = 1e-8f;
+    float weightDecay = 0.0f;     // L2 penalty on every parameter
+    int batchSize = 256;
+    int threads = 1;
+    uint64_t seed = 0;            // initial weights and batch order
+    std::string initialWeights;   // the model's JSON to continue from; empty = fresh init
+};
+
+class ShardTrainer {
+public:
+    // Maps the completed shards of `dir`. Throws std::invalid_argument for
+    // a bad config or initial weights of another shape, std::runtime_error
+    // for a shard that is compressed or does not match this build's records.
+    ShardTrainer(std::string dir, TrainerConfig config);
+    ~ShardTrainer();
+    ShardTrainer(const ShardTrainer&) = delete;
+    ShardTrainer& operator=(const ShardTrainer&) = delete;
+
+    // One pass over every sample in a fresh random order. Returns the mean
+    // per-sample loss seen during the pass.
+    double trainEpoch();
+    // Mean per-sample loss of the current weights over every sample.
+    double loss();
+
+    std::string weightsJson() const;
+    bool saveWeights(const std::string& path) const;
+
+    uint64_t samples() const;  // states (value models) or decisions (policy models)
+    size_t parameters() const { return params_.size(); }
+    int epochs() const { return epochs_; }
+
+private:
+    struct Sample;
+    static constexpr int CHUNKS = 16;
+
+    void mapShards();
+    void initWeights();
+    void loadWeights(const std::string& json);
+    // Summed loss of `count` samples; with `grad`, their summed gradient is
+    // added to it.
+    double accumulate(const uint32_t* rows, size_t count, float* grad, int worker);
+    double valueLoss(const Sample& s, float* grad, std::vector<float>& scratch) const;
+    double policyLoss(const Sample& s, float* grad, std::vector<float>& scratch) const;
+    // Loss (and gradient, when `learn`) of `count` samples spread over the
+    // chunks; returns the summed loss.
+    double runChunks(const uint32_t* rows, size_t count, bool learn);
+    void step(size_t batch);
+
+    bool policyModel() const;
+    int inputSize() const;
+
+    std::string dir_;
+    TrainerConfig config_;
+    std::vector<std::shared_ptr<const MappedFile>> files_;
+    std::vector<Sample> samples_;
+    std::vector<uint32_t> order_;
+
+    // Parameters back to back. Neural models keep W1 hidden-unit major
+    // (one row of inputSize() per unit) so the forward pass is a dot
+    // product per unit; weightsJson() transposes to the JSON layout.
+    AlignedVector<float> params_;
+    AlignedVector<float> moment1_;
+    AlignedVector<float> moment2_;
+    std::vector<AlignedVector<float>> grads_;   // per chunk
+    double chunkLoss_[CHUNKS] = {};
+    std::vector<std::vector<float>> scratch_;   // per worker
+    std::unique_ptr<WorkerPool> pool_;
+    Xoshiro256 rng_;
+    uint64_t steps_ = 0;
+    int epochs_ = 0;
+};
+
+} // namespace bb
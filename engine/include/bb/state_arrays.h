@@ -0,0 +1,82 @@
+#pragma once
+
+#include "bb/game_state.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace bb {
+
+// A GameState flattened into fixed-layout records, for code outside the
+// engine (numpy through the bindings, analysis scripts) that reads every
+// player of many states: one copy per state instead of one accessor call
+// per field. The records are plain data, so a batch is a single buffer
+// the bindings hand to numpy as structured arrays without conversion.
+
+// One player. Stats and skills are resolved from the player's profile.
+struct PlayerRecord {
+    enum Flag : uint8_t {
+        HAS_MOVED = 1,
+        HAS_ACTED = 2,
+        USED_BLITZ = 4,
+        LOST_TACKLEZONES = 8,
+        PRO_USED = 16,
+        HAS_BALL = 32,
+    };
+
+    uint8_t id = 0;
+    uint8_t team = 0;   // TeamSide
+    uint8_t state = 0;  // PlayerState
+    int8_t x = -1, y = -1;
+    int8_t movementRemaining = 0;
+    int8_t movement = 0, strength = 0, agility = 0, armour = 0;
+    uint8_t flags = 0;
+    uint16_t profile = 0;    // ProfileId
+    uint64_t skills[2] = {};  // SkillSet::word(0), word(1): SkillName i is bit i % 64 of word i / 64
+};
+static_assert(sizeof(PlayerRecord) == 32);
+
+// Everything about the state that is not a player.
+struct StateRecord {
+    enum TeamFlag : uint8_t {
+        REROLL_USED = 1,
+        BLITZ_USED = 2,
+        PASS_USED = 4,
+        FOUL_USED = 8,
+        HAS_APOTHECARY = 16,
+        APOTHECARY_USED = 32,
+    };
+
+    int8_t half = 1;
+    uint8_t phase = 0;         // GamePhase
+    uint8_t activeTeam = 0;    // TeamSide
+    uint8_t kickingTeam = 0;
+    uint8_t weather = 0;       // Weather
+    int8_t ballX = -1, ballY = -1;
+    uint8_t ballHeld = 0;
+    int8_t ballCarrierId = -1;
+    uint8_t turnoverPending = 0;
+    int8_t homeScore = 0, awayScore = 0;
+    int8_t homeRerolls = 0, awayRerolls = 0;
+    int8_t homeTurn = 0, awayTurn = 0;
+    uint8_t homeFlags = 0;  // TeamFlag
+    uint8_t awayFlags = 0;
+};
+static_assert(sizeof(StateRecord) == 18);
+
+// The board as player ids: board[y * PITCH_WIDTH + x] is the id of the
+// on-pitch player on (x, y), 0 for an empty square.
+constexpr int BOARD_SQUARES = Position::PITCH_WIDTH * Position::PITCH_HEIGHT;
+constexpr int STATE_PLAYERS = std::tuple_size_v<decltype(GameState::players)>;
+
+// Writes the 22 players (in GameState::players order), the board and the
+// state record of `state`. Reads `players` directly, not the occupancy
+// index, so a const state is never touched.
+void writeStateArrays(const GameState& state, PlayerRecord* players, uint8_t* board,
+                      StateRecord* record);
+
+// The same for `n` states on `threads` workers: state i fills players
+// [STATE_PLAYERS i, STATE_PLAYERS (i + 1)), board [BOARD_SQUARES i, ...) and record i.
+void writeStateArrays(const GameState* const* states, size_t n, PlayerRecord* players,
+                      uint8_t* board, StateRecord* records, int threads = 1);
+
+} // namespace bb
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "bb/dice.h"
+#include "bb/game_state.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+// GameState as JSON, for position fixtures and offline tools (bb_perft).
+// Every non-derived field is written: header, both TeamStates, the ball and
+// all 22 player slots (enums as their integer values, skills as a list of
+// SkillName values). The occupancy and tacklezone indexes are rebuilt on
+// load, so a loaded state hashes equal to the one that was saved.
+std::string stateToJson(const GameState& state);
+
+// Throws nlohmann::json::exception on malformed input, and on a state the
+// engine cannot hold: an enum or skill out of range, a player on the other
+// team's side, two players on one square, or a held ball whose carrier id
+// is not an on-pitch player on the ball's square.
+GameState stateFromJson(const std::string& json);
+
+// Binary GameState: the same fields in a fixed 744-byte record (magic,
+// version, header, two teams, ball, 22 players with stats and skill bits),
+// host byte order. Profiles are re-interned on load, since profile ids are
+// local to a process. For checkpoints, hand-off to search workers and
+// position suites (records concatenated).
+constexpr uint32_t STATE_BINARY_MAGIC = 0x53474242;  // "BBGS"
+constexpr uint32_t STATE_BINARY_VERSION = 1;
+constexpr size_t STATE_BINARY_SIZE = 744;
+
+std::vector<uint8_t> serializeState(const GameState& state);
+// nullopt unless `data` is one whole record of this version holding a state
+// stateFromJson would accept (a player's side byte must also match its slot).
+std::optional<GameState> deserializeState(const uint8_t* data, size_t size);
+
+// A roller's generator state (DiceRollerBase::saveState) behind a magic
+// and version. Empty if the roller cannot be saved; false if the bytes are
+// damaged or come from another kind of roller.
+constexpr uint32_t DICE_BINARY_MAGIC = 0x52444242;  // "BBDR"
+constexpr uint32_t DICE_BINARY_VERSION = 1;
+
+std::vector<uint8_t> serializeDice(const DiceRollerBase& dice);
+bool deserializeDice(DiceRollerBase& dice, const uint8_t* data, size_t size);
+
+// File variants: nullopt / false if the file cannot be opened (or holds a
+// damaged binary record). loadState reads either format, telling them
+// apart by the binary magic.
+std::optional<GameState> loadState(const std::string& path);
+bool saveState(const GameState& state, const std::string& path);
+bool saveStateBinary(const GameState& state, const std::string& path);
+
+} // namespace bb
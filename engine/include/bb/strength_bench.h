@@ -0,0 +1,108 @@
+#pragma once
+
+#include "bb/game_state.h"
+#include "bb/macro_actions.h"
+#include "bb/mcts.h"
+#include "bb/roster.h"
+#include "bb/value_function.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+// Playing strength per unit of compute, for judging search changes
+// (transpositions, Gumbel root, common random numbers, tree reuse) at
+// equal cost rather than by iterations per second. One MCTSConfig (and
+// model) is run at a list of budgets; at each budget it searches a fixed
+// suite of positions whose good macros are known, and plays short paired
+// matches against a fixed opponent. Every row reports accuracy, match
+// score and the compute spent, so strength can be read off against
+// iterations, wall time or CPU-seconds.
+//
+// A reference position: the side to move, and the macros that count as
+// solving it. An accepted macro matches on type, and on its player and
+// target when those are set (>= 0).
+struct AcceptedMacro {
+    MacroType type = MacroType::END_TURN;
+    int playerId = -1;
+    int targetId = -1;
+};
+
+struct BenchPosition {
+    std::string name;
+    std::string category;  // e.g. "scoring", "cage_or_advance", "defensive_blitz"
+    GameState state;
+    std::vector<AcceptedMacro> accept;
+};
+
+bool solvesPosition(const BenchPosition& position, const Macro& chosen);
+
+// The built-in suite (human v orc, from setupHalf lineups): open scoring
+// runs, a carrier to cage or advance, loose balls to pick up, and
+// opposing carriers to blitz, for both sides. Stable across versions of
+// this file only by name; results are compared within one build.
+std::vector<BenchPosition> referencePositions();
+
+// Suites as JSON: {"positions": [{"name", "category", "accept":
+// [{"macro": "SCORE", "player": 9, "target": -1}], "state": {...}}]},
+// with states in stateToJson's format and macros by macroTypeName.
+// parsePositionSuite throws on malformed input (nlohmann::json::exception,
+// or std::invalid_argument for an unknown macro name); loadPositionSuite
+// returns an empty vector instead, and also for a missing file.
+// savePositionSuite is false if the file cannot be written.
+std::string positionSuiteJson(const std::vector<BenchPosition>& positions);
+std::vector<BenchPosition> parsePositionSuite(const std::string& json);
+std::vector<BenchPosition> loadPositionSuite(const std::string& path);
+bool savePositionSuite(const std::vector<BenchPosition>& positions, const std::string& path);
+
+// One budget: maxIterations and timeBudgetMs for every measured search.
+// 0 leaves that limit off; at least one must be set.
+struct StrengthBudget {
+    int iterations = 0;
+    int timeMs = 0;
+};
+
+struct StrengthBenchConfig {
+    MCTSConfig search;                       // measured; the budget overrides its limits
+    const ValueFunction* valueFn = nullptr;  // measured side's network (MCTSConfig::policy likewise)
+    std::vector<StrengthBudget> budgets;
+    std::vector<BenchPosition> positions;    // empty = referencePositions()
+    int positionSeeds = 4;                   // searches per position, seeded seed + k
+    int matchPairs = 4;                      // seeds seed + p, played with each side at home
+    MCTSConfig opponent;                     // fixed across budgets
+    const ValueFunction* opponentValueFn = nullptr;
+    std::vector<const TeamRoster*> rosters;  // pair p: rosters[p % n] v rosters[(p + 1) % n]; empty = human v orc
+    int threads = 1;                         // positions and games in parallel (wall times then share cores)
+    uint32_t seed = 1;
+};
+
+struct StrengthRow {
+    StrengthBudget budget;
+    int searches = 0;                        // position searches
+    int solved = 0;
+    double accuracy = 0.0;                   // solved / searches
+    std::map<std::string, double> categoryAccuracy;
+    double positionIterations = 0.0;         // mean per position search
+    double positionMs = 0.0;                 // mean wall ms per position search
+    int games = 0;                           // measured side's view
+    int wins = 0;
+    int draws = 0;
+    int losses = 0;
+    double score = 0.0;                      // mean game score, win 1 and draw 1/2
+    double scoreDiff = 0.0;                  // mean touchdowns for minus against
+    double gameSearchIterations = 0.0;       // mean per measured search in the games
+    double gameMs = 0.0;                     // measured side's mean wall ms per game
+    // Measured side's search time over positions and games, times
+    // MCTSConfig::numThreads (its search threads)
+    double cpuSeconds = 0.0;
+};
+
+// One row per budget, in order. Throws std::invalid_argument for a budget
+// without a limit, non-positive threads, or negative seeds or pairs.
+// Results depend on the thread count only through wall times (and through
+// time budgets, which cut searches by the clock).
+std::vector<StrengthRow> runStrengthBench(const StrengthBenchConfig& config);
+
+} // namespace bb
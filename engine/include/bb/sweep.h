@@ -0,0 +1,65 @@
+#pragma once
+
+#include "bb/mcts.h"
+#include "bb/roster.h"
+#include "bb/value_function.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bb {
+
+// Grid sweeps of Macro-MCTS settings in one process: every cell (one
+// MCTSConfig) plays the same seeds, so cells are compared on paired games,
+// and all cell x seed games share one thread pool and one loaded copy of
+// the networks. Per cell it reports results and the shape of the logged
+// visit distributions, which the measure_* scripts used to collect
+// process by process.
+struct SweepAxis {
+    std::string field;  // MCTSConfig member name, e.g. "explorationC"
+    std::vector<double> values;
+};
+
+// Set the MCTSConfig member named `field` (as spelled in mcts.h) to
+// `value`, converted to its type. False for a name the sweep does not know.
+bool setSearchParameter(MCTSConfig& config, const std::string& field, double value);
+// Every field setSearchParameter knows with its value in `config`, in a
+// fixed order: setting them all on a default MCTSConfig gives back
+// `config`'s settings (the pointers and callbacks excepted).
+std::vector<std::pair<std::string, double>> searchParameters(const MCTSConfig& config);
+
+// Cartesian product of `axes` over `base`, first axis slowest. Throws
+// std::invalid_argument for an unknown field or an axis without values.
+std::vector<MCTSConfig> expandGrid(const MCTSConfig& base, const std::vector<SweepAxis>& axes);
+
+struct SweepConfig {
+    std::vector<uint32_t> seeds;             // every cell plays every seed
+    std::vector<const TeamRoster*> rosters;  // game g: rosters[g % n] v rosters[(g + 1) % n]; empty = human v orc
+    int threads = 1;
+    const ValueFunction* valueFn = nullptr;  // shared by every game (MCTSConfig::policy likewise)
+    // Both sides search with the cell's config, or the away side plays
+    // `opponent` and only home decisions are measured.
+    bool mirror = true;
+    MCTSConfig opponent;
+    int topK = 20;                           // logged visits per decision
+};
+
+struct SweepCellResult {
+    int games = 0;
+    int wins = 0;  // home side's view
+    int draws = 0;
+    int losses = 0;
+    double scoreDiff = 0.0;      // mean home minus away touchdowns
+    int decisions = 0;           // measured searches
+    double visitEntropy = 0.0;   // mean entropy of the logged visit shares over ln(count), 2+ visits
+    double topShare = 0.0;       // mean share of the most-visited action, same decisions
+    double iterations = 0.0;     // mean per measured search
+    double searchMs = 0.0;       // mean per measured search
+};
+
+// One result per cell, in order. Game g of each cell is seeded with
+// seeds[g], so its dice and both searches' seeds match across cells.
+std::vector<SweepCellResult> runSweep(const std::vector<MCTSConfig>& cells, const SweepConfig& config);
+
+} // namespace bb
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "bb/game_state.h"
+#include "bb/macro_actions.h"
+#include "bb/rules_engine.h"
+
+namespace bb {
+
+// The pitch is symmetric under the mirror y -> 14 - y: a position and its
+// mirror image have the same value, and their moves correspond square for
+// square. (HOME/AWAY are mirrors along x as well, but swapping them also
+// swaps player ids, turn counters and the side to move, so only the y
+// mirror is used for sharing search data.)
+//
+// A Symmetry maps one orientation to the other; the mirror is its own
+// inverse, so the same Symmetry maps actions and macros back.
+struct Symmetry {
+    bool flipY = false;
+
+    Position apply(Position p) const {
+        if (!flipY || !p.isOnPitch()) return p;
+        return {p.x, static_cast<int8_t>(Position::PITCH_HEIGHT - 1 - p.y)};
+    }
+    Action apply(Action a) const {
+        a.target = apply(a.target);
+        return a;
+    }
+    Macro apply(Macro m) const {
+        m.targetPos = apply(m.targetPos);
+        return m;
+    }
+};
+
+// A position's canonical orientation: whichever of it and its mirror has
+// the smaller hash() (unmirrored on a tie, i.e. a symmetric position).
+// `toCanonical` maps this position's actions and macros into the canonical
+// orientation and back; `hash` is the same for a position and its mirror,
+// so transposition tables and prior caches keyed by it share their entries.
+struct CanonicalForm {
+    Symmetry toCanonical;
+    uint64_t hash = 0;
+};
+
+// Two hashes, no state built.
+CanonicalForm canonicalize(const GameState& state);
+inline uint64_t canonicalHash(const GameState& state) { return canonicalize(state).hash; }
+
+// `state` under `symmetry`: players and ball moved to their image squares.
+GameState transformed(const GameState& state, Symmetry symmetry);
+
+} // namespace bb
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+// Where the engine's threads run. On multi-socket machines a game whose
+// threads drift between sockets pays for remote memory on every tree and
+// arena access; pinning keeps each game's worker on one core and its
+// search helpers on the same NUMA node. Memory is placed by first touch,
+// so the search arenas and scratch a pinned thread allocates are local to
+// its node without further help.
+//
+// The setting is process-wide and off by default; runWorkers() applies it
+// to the game-level loops (batch runner, tournaments, sweeps, batched
+// self-play) and WorkerPool to its search helpers.
+enum class AffinityMode : uint8_t {
+    NONE,     // leave placement to the OS
+    COMPACT,  // fill one node's cores before the next
+    SPREAD,   // round-robin workers over the nodes
+};
+
+const char* affinityModeName(AffinityMode mode);
+// "none", "compact" or "spread"; false for anything else.
+bool parseAffinityMode(const std::string& name, AffinityMode& out);
+
+// The CPUs this process may run on, grouped by NUMA node.
+struct CpuTopology {
+    std::vector<std::vector<int>> nodes;  // non-empty nodes only, CPUs ascending
+
+    int cpus() const;
+    int nodeOf(int cpu) const;  // index into nodes, -1 if not listed
+    // Read once from /sys/devices/system/node and the process's affinity
+    // mask; one node of every allowed CPU where there is no NUMA information.
+    static const CpuTopology& system();
+};
+
+// A kernel CPU list ("0-3,8,10-11") as CPU numbers; empty if malformed.
+std::vector<int> parseCpuList(const std::string& list);
+
+void setThreadAffinity(AffinityMode mode);
+AffinityMode threadAffinity();
+
+// The CPU for worker `index` under `mode`, or -1 for NONE or no CPUs.
+// Workers beyond the CPU count wrap around.
+int placeWorker(int index, AffinityMode mode, const CpuTopology& topology);
+
+// Bind the calling thread to one CPU, or to every CPU of a node. False if
+// the platform or the process's mask does not allow it.
+bool pinToCpu(int cpu);
+bool pinToNode(int node, const CpuTopology& topology);
+// The node the calling thread is running on, -1 if unknown.
+int currentNode(const CpuTopology& topology);
+
+// fn(worker) for worker in [0, workers), worker 0 on the calling thread
+// and the rest on new threads, each placed per threadAffinity(); returns
+// once all have returned. The caller's own affinity is restored afterwards.
+void runWorkers(int workers, const std::function<void(int worker)>& fn);
+
+} // namespace bb
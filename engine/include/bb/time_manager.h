@@ -0,0 +1,65 @@
+#pragma once
+
+#include "bb/game_state.h"
+#include <vector>
+
+namespace bb {
+
+// Spreads one team's search budget over its decisions in a game (or in each
+// of its turns). Every decision gets an even share of what is left --
+// remaining budget over expected remaining decisions -- scaled up for wide,
+// undecided roots (many macros, flat priors) and for the team's last turn of
+// a half, more so when it must score, and down for near-forced ones. A root
+// with one candidate gets nothing. Budgets are in milliseconds or in search
+// iterations (deterministic, for gating); the caller reports what each
+// search actually used through spend().
+class TimeManager {
+public:
+    enum class Unit { MILLISECONDS, ITERATIONS };
+
+    struct Config {
+        Unit unit = Unit::MILLISECONDS;
+        double gameBudget = 0.0;        // per team per game; 0 = per turn instead
+        double turnBudget = 0.0;        // per team turn (used when gameBudget is 0)
+        double decisionsPerTurn = 4.0;  // searched decisions per turn before any are seen
+        double minScale = 0.25;         // allocation bounds, as multiples of the even share
+        double maxScale = 4.0;
+        double maxFraction = 0.25;      // never more than this share of what is left (game budget)
+        double minAllocation = 1.0;     // floor for a decision that searches at all
+    };
+
+    explicit TimeManager(Config config);
+
+    // Forget the last game's spending and decision counts.
+    void newGame();
+
+    // Budget for searching `state`, whose root candidates have `priors`
+    // (one per macro, any scale). 0 when there is nothing to choose.
+    double allocate(const GameState& state, const std::vector<float>& priors);
+
+    // What the search given the last allocation actually used.
+    void spend(double used);
+
+    double remaining() const;
+    double spent() const { return gameSpent_; }
+    int decisions() const { return decisions_; }
+    const Config& config() const { return config_; }
+
+private:
+    // Track the turn `state` is in: a new one resets the turn budget.
+    void observeTurn(const GameState& state);
+    // Searched decisions per turn, the configured guess blended with the
+    // turns seen so far.
+    double decisionsPerTurn() const;
+
+    Config config_;
+    double gameSpent_ = 0.0;
+    double turnSpent_ = 0.0;
+    int decisions_ = 0;           // searched decisions this game
+    int turns_ = 0;               // turns with at least one searched decision
+    int turnDecisions_ = 0;       // searched decisions this turn
+    int turnHalf_ = 0;            // the current turn's (half, turnNumber)
+    int turnNumber_ = 0;
+};
+
+} // namespace bb
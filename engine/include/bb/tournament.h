@@ -0,0 +1,136 @@
+#pragma once
+
+#include "bb/batch_runner.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+// Head-to-head matches between AI configurations, played as seed pairs:
+// pair p plays seed (config.seed + p) twice, once with each entrant at
+// home, on the rosters rosters[p % n] (home) vs rosters[(p + 1) % n], so
+// dice, rosters and side cancel out of the comparison. Pairs run on a
+// thread pool with the networks shared read-only; after each completed
+// pair the stopping rule decides whether the match is already settled.
+//
+// Scores count a win as 1, a draw as 1/2, from entrant A's side. The
+// statistics work on pair scores (the mean of a pair's two games), which
+// keeps the correlation the shared seed introduces out of the variance.
+// Finished pairs are counted in pair order, whatever order the threads
+// finish them in, so a match's result depends only on its seeds.
+//
+// A match can also be split into shards of pairs (firstPair) played
+// anywhere with StopRule::NONE; mergeMatches() puts the shards' pairs
+// back in order and replays the stopping rule, giving exactly the result
+// one run over all the pairs would have.
+enum class StopRule : uint8_t {
+    NONE,    // play maxPairs
+    SPRT,    // sequential probability ratio test of elo1 against elo0
+    WILSON,  // stop once the Wilson interval of A's score excludes 1/2
+};
+
+struct TournamentConfig {
+    int maxPairs = 200;
+    int minPairs = 10;      // no stopping before this many pairs
+    int threads = 1;
+    uint32_t seed = 1;
+    int firstPair = 0;      // play pairs firstPair .. firstPair + maxPairs - 1 (a shard)
+    std::vector<const TeamRoster*> rosters;  // empty = human vs orc
+    StopRule stop = StopRule::SPRT;
+    // SPRT (normalized GSPRT approximation, as used by engine testing
+    // frameworks): H0 "A is elo0 stronger" against H1 "A is elo1 stronger",
+    // with error rates alpha (false accept of H1) and beta (of H0).
+    double elo0 = 0.0;
+    double elo1 = 35.0;
+    double alpha = 0.05;
+    double beta = 0.05;
+    double wilsonZ = 1.96;  // WILSON: normal quantile of the interval
+    // End games once their winner is settled (outcomeDecided). Wins and
+    // draws are unchanged; scores and score_diff then understate blowouts.
+    bool adjudicate = false;
+};
+
+struct TournamentGame {
+    int playerA = 0;  // entrant indices
+    int playerB = 0;
+    int pair = 0;
+    bool aIsHome = true;
+    uint32_t seed = 0;
+    const char* homeRoster = "";
+    const char* awayRoster = "";
+    int scoreA = 0;
+    int scoreB = 0;
+    int totalActions = 0;
+    bool adjudicated = false;  // GameResult::adjudicated
+};
+
+enum class MatchVerdict : uint8_t {
+    UNDECIDED,    // maxPairs reached (or StopRule::NONE)
+    A_STRONGER,   // SPRT accepted H1, or the Wilson interval lies above 1/2
+    NOT_STRONGER, // SPRT accepted H0, or the Wilson interval lies below 1/2
+};
+
+const char* matchVerdictName(MatchVerdict v);
+
+// Both games of a pair from A's side: [0] with A at home, [1] away.
+struct PairOutcome {
+    int pair = 0;
+    int scoreA[2] = {};
+    int scoreB[2] = {};
+    int totalActions[2] = {};
+};
+
+struct MatchResult {
+    int playerA = 0;
+    int playerB = 0;
+    int pairs = 0;  // completed pairs counted (workers may finish a few more)
+    int wins = 0;   // games, from A's side
+    int draws = 0;
+    int losses = 0;
+    double score = 0.0;  // A's mean game score
+    double llr = 0.0;    // SPRT log-likelihood ratio (0 unless StopRule::SPRT)
+    double lower = 0.0;  // Wilson interval of A's score
+    double upper = 1.0;
+    MatchVerdict verdict = MatchVerdict::UNDECIDED;
+    int touchdownsA = 0;           // over the counted games
+    int touchdownsB = 0;
+    long totalActions = 0;
+    std::map<int, int> scoreDiff;  // A's score minus B's -> games
+    std::vector<PairOutcome> outcomes;  // the counted pairs, in pair order
+};
+
+// Called once per finished game, in completion order, never concurrently.
+using GameCallback = std::function<void(const TournamentGame&)>;
+
+// A against B. Throws std::invalid_argument for non-positive maxPairs or
+// threads, or a negative firstPair.
+MatchResult runMatch(const PlayerConfig& a, const PlayerConfig& b,
+                     const TournamentConfig& config, const GameCallback& onGame = nullptr,
+                     int indexA = 0, int indexB = 1);
+
+// Round robin: every entrant against every later one, in order.
+std::vector<MatchResult> runTournament(const std::vector<PlayerConfig>& players,
+                                       const TournamentConfig& config,
+                                       const GameCallback& onGame = nullptr);
+
+// One match from shards of it: their outcomes in pair order, counted (and
+// stopped) under `config` as runMatch would. Throws std::invalid_argument
+// if a pair appears twice or the pairs leave a gap.
+MatchResult mergeMatches(const std::vector<MatchResult>& shards, const TournamentConfig& config);
+
+// A result as one JSON object (totals for reading, outcomes for merging),
+// and back: parseMatchSummary() restores the players and outcomes and
+// recounts the rest under StopRule::NONE; false on malformed input.
+std::string matchSummaryJson(const MatchResult& match);
+bool parseMatchSummary(const std::string& text, MatchResult& out);
+
+// The statistics behind the stopping rules. sprtLlr() takes the count,
+// sum and sum of squares of per-pair scores in [0, 1]; wilsonInterval()
+// takes A's mean score over n games.
+double sprtLlr(int n, double sum, double sumSquares, double elo0, double elo1);
+void wilsonInterval(double score, int n, double z, double& lower, double& upper);
+
+} // namespace bb
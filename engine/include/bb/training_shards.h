@@ -0,0 +1,133 @@
+#pragma once
+
+#include "bb/action_features.h"
+#include "bb/feature_extractor.h"
+#include "bb/game_simulator.h"
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bb {
+
+// Append-only training shards. A shard is three files in the output
+// directory, each a ShardFileHeader followed by fixed-size records, so a
+// reader maps them as numpy record arrays (blood_bowl/training_shards.py):
+//
+//   shard-NNNNNN.states     ShardStateRecord     one per StateLog
+//   shard-NNNNNN.decisions  ShardDecisionRecord  one per PolicyDecision
+//   shard-NNNNNN.visits     ShardVisitRecord     the decisions' visit
+//                                                distributions, back to back
+//
+// Record counts follow from the file size. A game's records never span
+// shards. When a shard reaches maxShardBytes it is closed and a line is
+// appended to index.jsonl; only shards listed there are complete. With
+// compression, closed files are replaced by zstd frames (name + ".zst"),
+// which must be decompressed rather than mapped.
+constexpr uint32_t SHARD_FILE_MAGIC = 0x48534242;  // "BBSH"
+constexpr uint32_t SHARD_FILE_VERSION = 2;  // 2: decisions carry canonicalHash, visitWeight, samples
+
+enum class ShardKind : uint32_t { STATES = 1, DECISIONS = 2, VISITS = 3 };
+
+struct ShardFileHeader {
+    uint32_t magic = SHARD_FILE_MAGIC;
+    uint32_t version = SHARD_FILE_VERSION;
+    ShardKind kind = ShardKind::STATES;
+    uint32_t recordSize = 0;
+    uint32_t numFeatures = NUM_FEATURES;
+    uint32_t numActionFeatures = NUM_ACTION_FEATURES;
+    uint64_t reserved = 0;
+};
+static_assert(sizeof(ShardFileHeader) == 32);
+
+struct ShardStateRecord {
+    float features[NUM_FEATURES];
+    float outcome;       // label for `perspective`, supplied by the caller
+    uint32_t game;       // writer-wide game number
+    uint16_t index;      // position among the game's states
+    uint8_t perspective; // 0 home, 1 away
+    uint8_t reserved = 0;
+};
+static_assert(sizeof(ShardStateRecord) == 304);
+
+struct ShardDecisionRecord {
+    float stateFeatures[NUM_FEATURES];
+    float outcome;
+    uint32_t game;
+    uint32_t firstVisit;  // row in this shard's visits file
+    uint32_t numVisits;
+    uint8_t perspective;
+    uint8_t mirrored;     // PolicyDecision::mirrored
+    uint8_t reserved[2] = {};
+    uint64_t stateHash;
+    uint64_t canonicalHash;  // PolicyDecision::canonicalHash
+    float visitWeight;       // root visits behind the fractions (PolicyDecision::totalVisits)
+    uint32_t samples;        // logged decisions this record stands for: 1, or more once compacted
+};
+static_assert(sizeof(ShardDecisionRecord) == 336);
+
+struct ShardVisitRecord {
+    float actionFeatures[NUM_ACTION_FEATURES];
+    float visitFraction;
+};
+static_assert(sizeof(ShardVisitRecord) == 96);
+
+struct ShardWriterConfig {
+    uint64_t maxShardBytes = 256ull << 20;
+    bool compress = false;   // needs a BB_ZSTD build
+    int compressionLevel = 3;
+};
+
+// Streams logged games into shards. appendGame() may be called from any
+// number of threads: records are packed outside the lock, then written as
+// one block.
+class ShardWriter {
+public:
+    // Creates `dir` if needed and continues after the last shard already
+    // listed in its index. Throws std::invalid_argument for compression
+    // without zstd support, std::runtime_error if files cannot be opened.
+    ShardWriter(std::string dir, ShardWriterConfig config = {});
+    ~ShardWriter();
+    ShardWriter(const ShardWriter&) = delete;
+    ShardWriter& operator=(const ShardWriter&) = delete;
+
+    // States take homeOutcome or awayOutcome by perspective, as do
+    // decisions. Returns the game's number.
+    uint32_t appendGame(const LoggedGameResult& game, float homeOutcome, float awayOutcome);
+    // Records packed elsewhere (shard_compactor.h), written as one block
+    // with their game numbers kept and firstVisit rebased from an offset
+    // into `visits` to a row of the shard. Counts toward no game.
+    void appendRecords(std::vector<ShardStateRecord>& states, std::vector<ShardDecisionRecord>& decisions,
+                       const std::vector<ShardVisitRecord>& visits);
+    // Close the open shard (if it holds anything) and stop writing.
+    void close();
+
+    int shardsWritten() const;
+
+private:
+    struct Shard {
+        std::ofstream files[3];
+        uint64_t bytes = 0;
+        uint64_t counts[3] = {};
+        uint32_t games = 0;
+    };
+    void openShard();
+    void finishShard();
+    // Under the lock: the block's three record runs
+    void writeBlock(const std::vector<ShardStateRecord>& states, std::vector<ShardDecisionRecord>& decisions,
+                    const std::vector<ShardVisitRecord>& visits);
+    std::string shardPath(int shard, ShardKind kind) const;
+
+    std::string dir_;
+    ShardWriterConfig config_;
+    mutable std::mutex mutex_;
+    Shard shard_;
+    int shardId_ = 0;
+    int shardsWritten_ = 0;
+    uint32_t nextGame_ = 0;
+    bool open_ = false;
+    bool closed_ = false;
+};
+
+} // namespace bb
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bb {
+
+// Fixed-size table of (visits, value) statistics keyed by GameState::hash(),
+// shared by search nodes that reach the same position through different
+// move orders. One 64-byte bucket per index, four entries per bucket; a
+// store that finds no matching or free entry evicts the entry from the
+// oldest search generation, then the least-visited one.
+//
+// newSearch() bumps the generation instead of clearing: entries written by
+// an earlier search read as misses and are the first to be replaced, so
+// resetting is O(1) regardless of table size.
+class TranspositionTable {
+public:
+    struct Stats {
+        uint32_t visits = 0;
+        double totalValue = 0.0;
+    };
+
+    // Budget in bytes, rounded down to a power-of-two bucket count (at least
+    // one bucket). 0 = disabled: probes miss, stores are dropped.
+    explicit TranspositionTable(size_t bytes = 0);
+    void resize(size_t bytes);
+
+    bool enabled() const { return !buckets_.empty(); }
+    size_t capacity() const { return buckets_.size() * ENTRIES_PER_BUCKET; }
+
+    void newSearch();
+    void clear();
+
+    // Statistics recorded for `key` in the current generation, if any.
+    bool probe(uint64_t key, Stats& out);
+    // Add one visit with `value` to `key`'s entry, creating it if needed.
+    void update(uint64_t key, double value);
+
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+    uint64_t evictions() const { return evictions_; }
+
+private:
+    static constexpr int ENTRIES_PER_BUCKET = 4;
+
+    struct Entry {
+        uint64_t key;
+        float totalValue;
+        uint16_t visits;      // saturates by halving visits and value together
+        uint16_t generation;
+    };
+    struct alignas(64) Bucket {
+        Entry entries[ENTRIES_PER_BUCKET];
+    };
+    static_assert(sizeof(Bucket) == 64, "one bucket per cache line");
+
+    Bucket& bucketFor(uint64_t key) { return buckets_[key & mask_]; }
+
+    std::vector<Bucket> buckets_;
+    uint64_t mask_ = 0;
+    // Generation 0 marks an empty entry, so live generations start at 1.
+    uint16_t generation_ = 1;
+
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t evictions_ = 0;
+};
+
+} // namespace bb
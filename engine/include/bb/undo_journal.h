@@ -0,0 +1,97 @@
+#pragma once
+
+#include "bb/game_state.h"
+#include "bb/action_resolver.h"
+#include "bb/macro_actions.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bb {
+
+// Make/unmake support for search. Each journaled step (one executeAction,
+// or one whole macro expansion) records the players, teams and header
+// fields it changed, so a search can walk a single working state down a
+// path and roll it back to any earlier mark instead of re-cloning the root.
+//
+// Players are recorded from GameState's write barrier: only the slots the
+// step was handed for writing (GameState::touchedPlayers) are compared with
+// the journal's copy of the players as of the previous step, and those that
+// changed are stored with their old value. A step therefore costs the
+// players it touched, not a pass over all 22. Rules code that edits
+// `players` directly must call invalidateOccupancy(), which marks every
+// slot. The header and both TeamStates are small fixed records, saved
+// whole with each step. The derived occupancy and tacklezone indexes are
+// repaired incrementally on undo (restorePlayer).
+//
+// Between clear() and undo, the working state may change only through
+// journaled steps (debug builds check this in begin() and end()).
+//
+// Any new non-derived field added to GameState must be added to Header.
+class UndoJournal {
+public:
+    // Opaque position in the journal; undoTo(mark) rolls back every step
+    // recorded after mark() was taken.
+    size_t mark() const { return steps_.size(); }
+    bool empty() const { return steps_.empty(); }
+
+    // Bracket a step: begin() saves the header and clears the state's
+    // touched slots, end() stores the touched players that changed. Steps
+    // do not nest.
+    void begin(GameState& state);
+    void end(const GameState& state);
+
+    // One step that overwrites `state` with `source`, a state of the same
+    // game (e.g. a cached search outcome). Only players that differ are
+    // re-indexed.
+    void assign(GameState& state, const GameState& source);
+
+    void undoTo(GameState& state, size_t mark);
+    // Empty the journal; the next begin() may be on any state.
+    void clear();
+
+private:
+    struct Header {
+        int half;
+        GamePhase phase;
+        TeamSide activeTeam;
+        BallState ball;
+        bool turnoverPending;
+        int currentActivationId;
+        TeamSide kickingTeam;
+        Weather weather;
+        RosterSpeed receiverSpeed;
+        TeamState homeTeam;
+        TeamState awayTeam;
+    };
+    struct PlayerEntry {
+        uint8_t slot;
+        Player before;
+    };
+    struct Step {
+        Header header;
+        uint32_t firstPlayer;
+    };
+
+    static Header readHeader(const GameState& state);
+    static void writeHeader(GameState& state, const Header& h);
+    bool matchesCurrent(const GameState& state, uint32_t slots) const;
+
+    Header preHeader_{};  // of the step in progress
+    // The working state's players as of the last step boundary; valid once
+    // `tracking_`. A changed player's entry is its slot here.
+    std::array<Player, 22> current_{};
+    bool tracking_ = false;
+
+    std::vector<Step> steps_;
+    std::vector<PlayerEntry> players_;
+};
+
+// executeAction / greedyExpandMacro recorded as one journal step.
+ActionResult executeActionJournaled(GameState& state, const Action& action,
+                                    DiceRollerBase& dice, UndoJournal& journal,
+                                    std::vector<GameEvent>* events = nullptr);
+MacroExpansionResult greedyExpandMacroJournaled(GameState& state, const Macro& macro,
+                                                DiceRollerBase& dice, UndoJournal& journal);
+
+} // namespace bb
@@ -1,44 +1,92 @@
 #pragma once
 
+#include "bb/enums.h"
+#include "bb/quantization.h"
+#include "bb/simd.h"
 #include <vector>
 #include <memory>
 #include <string>
 
 namespace bb {
 
+class GameState;
+
 class ValueFunction {
 public:
     virtual ~ValueFunction() = default;
     virtual float evaluate(const float* features, int numFeatures) const = 0;
+    // `batch` rows of numFeatures floats (row-major) -> `batch` values.
+    // Default: evaluate() per row.
+    virtual void evaluateBatch(const float* features, int batch, int numFeatures, float* out) const;
+
+    // The input row evaluate() reads and how a position is encoded into it.
+    // Default: the NUM_FEATURES scalar features (extractFeatures).
+    virtual int inputSize() const;
+    virtual void encodeState(const GameState& state, TeamSide perspective, float* out) const;
+    // encodeState() then evaluate(): how search values a leaf.
+    float evaluateState(const GameState& state, TeamSide perspective) const;
 };
 
 class LinearValueFunction : public ValueFunction {
     std::vector<float> weights_;
+    friend struct WeightsFileAccess;
 public:
     explicit LinearValueFunction(std::vector<float> weights);
     float evaluate(const float* features, int numFeatures) const override;
+    void evaluateBatch(const float* features, int batch, int numFeatures, float* out) const override;
 };
 
 class NeuralValueFunction : public ValueFunction {
     int inputSize_;
     int hiddenSize_;
-    std::vector<std::vector<float>> W1_;  // [input][hidden]
+    int stride_;                          // inputSize_ padded to the SIMD width
+    // [hidden][stride_]: one contiguous row per hidden unit. Owned, or a
+    // view into a read-only mapping of a binary weights file (shared by
+    // every process that maps it).
+    std::shared_ptr<const float[]> W1_;
     std::vector<float> b1_;               // [hidden]
     std::vector<float> W2_;               // [hidden] (single output)
     float b2_;
+
+    // Int8 mode (setInt8): W1 quantized per hidden unit, same row layout
+    bool int8_ = false;
+    AlignedVector<int8_t> W1q_;           // [hidden][stride_]
+    std::vector<float> W1scale_;          // [hidden]
+
+    float evaluateWith(const float* features, int numFeatures, bool useInt8) const;
+    void buildInt8();
+    friend struct WeightsFileAccess;
 public:
+    // W1 is given input-major ([input][hidden], the JSON layout).
     NeuralValueFunction(int inputSize, int hiddenSize,
-                        std::vector<std::vector<float>> W1,
+                        const std::vector<std::vector<float>>& W1,
+                        std::vector<float> b1,
+                        std::vector<float> W2,
+                        float b2);
+    // W1 already in the internal layout: hiddenSize rows of
+    // simdPadded(inputSize) floats, 32-byte aligned.
+    NeuralValueFunction(int inputSize, int hiddenSize,
+                        std::shared_ptr<const float[]> W1Rows,
                         std::vector<float> b1,
                         std::vector<float> W2,
                         float b2);
     float evaluate(const float* features, int numFeatures) const override;
+    void evaluateBatch(const float* features, int batch, int numFeatures, float* out) const override;
+
+    // Int8 inference: trades a little accuracy for throughput. Both weight
+    // sets are built at construction, so this is a switch, not a conversion.
+    void setInt8(bool on) { int8_ = on; }
+    bool isInt8() const { return int8_; }
+    // Float vs int8 output over `count` feature rows (valid in either mode).
+    QuantizationError quantizationError(const float* features, int count, int numFeatures) const;
 };
 
-// Load from JSON file (auto-detects linear vs neural format)
-std::unique_ptr<ValueFunction> loadValueFunction(const std::string& path);
+// Load from a JSON or binary weights file (auto-detects linear vs neural
+// format; binary files are memory-mapped, see weights_file.h). `int8`
+// switches a neural model to int8 inference; linear models ignore it.
+std::unique_ptr<ValueFunction> loadValueFunction(const std::string& path, bool int8 = false);
 
 // Load from JSON string (for testing)
-std::unique_ptr<ValueFunction> loadValueFunctionFromString(const std::string& json);
+std::unique_ptr<ValueFunction> loadValueFunctionFromString(const std::string& json, bool int8 = false);
 
 } // namespace bb
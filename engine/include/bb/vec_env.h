@@ -0,0 +1,88 @@
+#pragma once
+
+#include "bb/game_state.h"
+#include "bb/roster.h"
+#include "bb/dice.h"
+#include "bb/rules_engine.h"
+#include "bb/worker_pool.h"
+#include <cstdint>
+#include <vector>
+
+namespace bb {
+
+// N games stepped in lockstep, for RL loops that would otherwise drive
+// execute_action one game and one action at a time. Every call works on
+// all N games at once, spread over a WorkerPool, and writes into flat
+// caller-owned arrays (numpy buffers on the Python side).
+//
+// Between calls each live game waits on a decision: touchdown restarts,
+// half-time, kickoffs and forced END_TURNs (no legal action) are played
+// out inside reset() and step(), the same way simulateGame() does. A game
+// is done at GAME_OVER or after maxGameActions actions; step() leaves
+// done games alone until they are reset. A VecEnv takes one call at a time.
+struct VecEnvConfig {
+    int maxActions = 256;        // action slots per game; legal actions past this are not offered
+    bool useFullKickoff = false;
+    bool paths = false;          // offer MOVE_PATH moves (getAvailableActionsWithPaths)
+    int threads = 0;             // WorkerPool helpers; 0 runs everything on the caller
+    int maxGameActions = 5000;   // simulateGame()'s cap
+};
+
+class VecEnv {
+public:
+    // Integer columns per action slot: type, player id, target id, target x, target y
+    static constexpr int ACTION_COLUMNS = 5;
+
+    // Throws std::invalid_argument for a non-positive numEnvs or maxActions.
+    VecEnv(const TeamRoster& home, const TeamRoster& away, int numEnvs, VecEnvConfig config = {});
+
+    int numEnvs() const { return static_cast<int>(envs_.size()); }
+    const VecEnvConfig& config() const { return config_; }
+    const GameState& state(int env) const { return envs_[env].state; }
+    bool done(int env) const { return envs_[env].done; }
+
+    // Start game i afresh with FastDiceRoller(seeds[i]); with `which`, only
+    // the games where which[i] != 0 (seeds of the others are ignored).
+    void reset(const uint64_t* seeds, const uint8_t* which = nullptr);
+
+    // Each game's legal actions, padded to maxActions:
+    //   actions  [N][maxActions][ACTION_COLUMNS], -1 in unused slots
+    //   mask     [N][maxActions], 1 for a legal slot
+    //   features [N][maxActions][NUM_ACTION_FEATURES] (extractActionFeatures),
+    //            zero in unused slots; skipped when null
+    // Done games have no legal slots.
+    void legalActions(int16_t* actions, uint8_t* mask, float* features = nullptr) const;
+
+    // Play slot choices[i] in game i. rewards[i] is the change in score
+    // difference, from the acting team's side, over the action and the
+    // restarts that follow it; done[i] says whether game i is over. Done
+    // games are skipped. Throws std::out_of_range for a choice outside a
+    // live game's legal slots, before any game is stepped.
+    void step(const int32_t* choices, float* rewards, uint8_t* done);
+
+    // extractFeatures() of every game from its active team's side:
+    // features [N][NUM_FEATURES]; activeTeams [N] (0 home, 1 away) when non-null.
+    void observe(float* features, uint8_t* activeTeams = nullptr) const;
+    // extractBoardPlanes(), likewise: planes [N][NUM_BOARD_PLANES][BOARD_PLANE_SIZE].
+    void observePlanes(uint8_t* planes, uint8_t* activeTeams = nullptr) const;
+
+private:
+    struct Env {
+        GameState state;
+        FastDiceRoller dice{0};
+        std::vector<Action> actions;  // legal actions, truncated to maxActions
+        int gameActions = 0;
+        bool done = true;
+    };
+
+    // Play out restarts and forced END_TURNs, then list the legal actions.
+    void advance(Env& env) const;
+
+    TeamRoster home_;
+    TeamRoster away_;
+    VecEnvConfig config_;
+    std::vector<Env> envs_;
+    mutable WorkerPool pool_;
+};
+
+} // namespace bb
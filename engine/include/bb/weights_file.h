@@ -0,0 +1,71 @@
+#pragma once
+
+#include "bb/policy_network.h"
+#include "bb/value_function.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace bb {
+
+// Binary weights file: a header, a table of sections (one per network),
+// then the float arrays, each starting on a 64-byte boundary. Files are
+// opened with a read-only shared mmap, so the first-layer matrices are used
+// in place and shared between every process serving the same snapshot;
+// nothing is parsed. Numbers are stored in host byte order.
+//
+// Section arrays, in order:
+//   VALUE_LINEAR   weights[inputSize]
+//   VALUE_NEURAL   W1[hidden][simdPadded(inputSize)] (the runtime layout), b1, W2
+//   POLICY_LINEAR  weights[inputSize]
+//   POLICY_NEURAL  W1[inputSize * hidden] (input-major, as in JSON), b1, W2
+//   VALUE_MLP,     widths[layers] (each layer's output count, as floats),
+//   POLICY_MLP     then every layer's weights [outputs][inputs] back to
+//                  back, then every layer's bias. hiddenSize holds the
+//                  layer count and `reserved` is 1 for a residual net.
+constexpr uint32_t WEIGHTS_FILE_MAGIC = 0x57424242;  // "BBBW"
+constexpr uint32_t WEIGHTS_FILE_VERSION = 1;
+constexpr uint64_t WEIGHTS_FILE_ALIGN = 64;
+
+enum class WeightsSectionKind : uint32_t {
+    VALUE_LINEAR = 1,
+    VALUE_NEURAL = 2,
+    POLICY_LINEAR = 3,
+    POLICY_NEURAL = 4,
+    VALUE_MLP = 5,
+    POLICY_MLP = 6,
+};
+
+struct WeightsFileHeader {
+    uint32_t magic = WEIGHTS_FILE_MAGIC;
+    uint32_t version = WEIGHTS_FILE_VERSION;
+    uint32_t numSections = 0;
+    uint32_t reserved = 0;
+};
+
+struct WeightsSection {
+    WeightsSectionKind kind = WeightsSectionKind::VALUE_LINEAR;
+    int32_t inputSize = 0;
+    int32_t hiddenSize = 0;     // 0 for linear sections; layer count for MLP
+    float scalar = 0.0f;        // b2 (neural) or bias (linear policy)
+    float temperature = 1.0f;   // policy sections only
+    uint32_t reserved = 0;      // MLP sections: 1 = residual
+    uint64_t offsets[3] = {};   // byte offsets of the section's arrays
+};
+
+// True if `path` starts with the binary weights magic.
+bool isWeightsFile(const std::string& path);
+
+// First value / policy section of a binary weights file; nullptr if the
+// file is missing, malformed, or has no such section.
+std::unique_ptr<ValueFunction> loadValueFunctionBinary(const std::string& path, bool int8 = false);
+std::unique_ptr<PolicyNetwork> loadPolicyNetworkBinary(const std::string& path, bool int8 = false);
+
+// Write either network (or both, for combined AlphaZero snapshots).
+bool writeWeightsFile(const std::string& path, const ValueFunction* valueFn,
+                      const PolicyNetwork* policy);
+
+// Convert a JSON weights file; returns false if it holds neither network.
+bool convertWeightsJson(const std::string& jsonPath, const std::string& binPath);
+
+} // namespace bb
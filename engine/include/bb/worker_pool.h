@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bb {
+
+// A few long-lived helper threads for fine-grained fork/join inside one
+// search. run(n, fn) calls fn(task, worker) for every task in [0, n),
+// spread over the helpers and the calling thread, and returns once all have
+// finished. `worker` is 0 for the caller and 1..helpers() for the helpers,
+// so per-worker scratch can be indexed by it. Between batches the helpers
+// spin briefly before sleeping, keeping the hand-off cheap when batches come
+// back to back (one per search iteration). One batch at a time; run() is
+// not reentrant. With thread affinity on (thread_placement.h) the helpers
+// are bound to the NUMA node of the thread that created the pool.
+class WorkerPool {
+public:
+    using Task = std::function<void(int task, int worker)>;
+
+    explicit WorkerPool(int helpers);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int helpers() const { return static_cast<int>(threads_.size()); }
+    void run(int tasks, const Task& fn);
+
+private:
+    void helperLoop(int worker, int node);
+    // Claim and run tasks of the current batch until none are left.
+    void work(const Task& fn, int tasks, int worker);
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::atomic<uint64_t> generation_{0};  // bumped per batch
+    const Task* fn_ = nullptr;              // current batch (under mutex_)
+    int tasks_ = 0;
+    std::atomic<int> next_{0};              // next unclaimed task
+    int unfinished_ = 0;                    // tasks not yet run to completion (under mutex_)
+    int active_ = 0;                        // helpers inside the current batch (under mutex_)
+    bool stop_ = false;
+};
+
+} // namespace bb
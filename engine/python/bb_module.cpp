@@ -15,6 +15,8 @@
 #include "bb/roster.h"
 #include "bb/dice.h"
 #include "bb/feature_extractor.h"
+#include "bb/feature_sets.h"
+#include "bb/board_planes.h"
 #include "bb/action_features.h"
 #include "bb/policy_network.h"
 #include "bb/policies.h"
@@ -23,9 +25,260 @@
 #include "bb/value_function.h"
 #include "bb/mcts.h"
 #include "bb/macro_mcts.h"
+#include "bb/model_cache.h"
+#include "bb/batch_runner.h"
+#include "bb/batched_self_play.h"
+#include "bb/game_log_columns.h"
+#include "bb/replay_file.h"
+#include "bb/training_shards.h"
+#include "bb/replay_buffer.h"
+#include "bb/shard_trainer.h"
+#include "bb/profile.h"
+#include "bb/alloc_tracking.h"
+#include "bb/state_arrays.h"
+#include "bb/state_io.h"
+#include "bb/tournament.h"
+#include "bb/vec_env.h"
+#include "bb/macro_search_handle.h"
+#include "bb/search_tree_file.h"
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
 
 namespace py = pybind11;
 
+namespace {
+
+// Weights argument: a Model handle from load_model(), or a path resolved
+// through the process-wide cache. None or "" means no weights.
+bool hasWeights(const py::object& weights) {
+    if (weights.is_none()) return false;
+    return !py::isinstance<py::str>(weights) || !weights.cast<std::string>().empty();
+}
+
+std::shared_ptr<bb::LoadedModel> resolveModel(const py::object& weights) {
+    if (!hasWeights(weights)) return nullptr;
+    if (py::isinstance<bb::LoadedModel>(weights)) return weights.cast<std::shared_ptr<bb::LoadedModel>>();
+    if (py::isinstance<bb::ModelHandle>(weights)) {
+        return std::const_pointer_cast<bb::LoadedModel>(weights.cast<bb::ModelHandle&>().current());
+    }
+    return bb::ModelCache::global().get(weights.cast<std::string>());
+}
+
+// Hand a vector to numpy without copying: the array's base capsule owns it.
+template<typename T>
+py::array_t<T> adoptVector(std::vector<T>&& v, std::vector<py::ssize_t> shape) {
+    auto* owned = new std::vector<T>(std::move(v));
+    py::capsule base(owned, [](void* p) { delete static_cast<std::vector<T>*>(p); });
+    return py::array_t<T>(std::move(shape), owned->data(), base);
+}
+
+template<typename T>
+py::array_t<T> adoptRows(std::vector<T>&& v, int cols) {
+    py::ssize_t rows = static_cast<py::ssize_t>(v.size() / cols);
+    return adoptVector(std::move(v), {rows, cols});
+}
+
+void addBoardColumns(py::dict& out, const std::string& prefix, bb::BoardColumns&& b) {
+    BB_ALLOC_SCOPE(bb::alloc::BINDINGS);
+    out[(prefix + "_board_players").c_str()] = adoptRows(std::move(b.players), bb::BoardColumns::PLAYER_COLS);
+    py::ssize_t offsets = static_cast<py::ssize_t>(b.playerOffsets.size());
+    out[(prefix + "_board_offsets").c_str()] = adoptVector(std::move(b.playerOffsets), {offsets});
+    out[(prefix + "_ball").c_str()] = adoptRows(std::move(b.ball), bb::BoardColumns::BALL_COLS);
+}
+
+// Turn logs (ranging over `arena`) as the list of dicts written to replay JSON.
+py::list turnLogsToList(const std::vector<bb::TurnLog>& turns, const std::vector<bb::GameEvent>& arena) {
+    BB_ALLOC_SCOPE(bb::alloc::BINDINGS);
+    py::list result;
+    // GameEvent type names
+    static const char* eventNames[] = {
+        "MOVE", "DODGE", "GFI", "BLOCK", "PUSH", "INJURY",
+        "TOUCHDOWN", "TURNOVER", "BALL_BOUNCE", "PASS", "CATCH",
+        "PICKUP", "FOUL", "KICKOFF", "WEATHER", "SKILL",
+        "KNOCKED_DOWN", "ARMOR_BREAK", "CASUALTY", "REGENERATION",
+        "EJECTED"
+    };
+    for (auto& turn : turns) {
+        py::dict t;
+        t["half"] = turn.half;
+        t["turn"] = turn.turnNumber;
+        t["active_team"] = turn.activeTeam == bb::TeamSide::HOME ? "home" : "away";
+        t["home_score"] = turn.homeScore;
+        t["away_score"] = turn.awayScore;
+        t["ball_x"] = turn.ballX;
+        t["ball_y"] = turn.ballY;
+        t["ball_held"] = turn.ballHeld;
+        t["ball_carrier_id"] = turn.ballCarrierId;
+        t["turnover"] = turn.turnover;
+        t["touchdown"] = turn.touchdown;
+
+        // Player snapshots
+        py::list home_players, away_players;
+        for (auto& p : turn.homePlayers) {
+            py::dict pd;
+            pd["id"] = p.id;
+            pd["x"] = p.x;
+            pd["y"] = p.y;
+            pd["state"] = p.state;
+            pd["has_ball"] = p.hasBall;
+            home_players.append(pd);
+        }
+        for (auto& p : turn.awayPlayers) {
+            py::dict pd;
+            pd["id"] = p.id;
+            pd["x"] = p.x;
+            pd["y"] = p.y;
+            pd["state"] = p.state;
+            pd["has_ball"] = p.hasBall;
+            away_players.append(pd);
+        }
+        t["home_players"] = home_players;
+        t["away_players"] = away_players;
+
+        // Events
+        py::list events;
+        for (auto& ev : bb::turnEvents(arena, turn)) {
+            py::dict ed;
+            int typeIdx = static_cast<int>(ev.type);
+            ed["type"] = (typeIdx < 21) ? eventNames[typeIdx] : "UNKNOWN";
+            ed["player_id"] = ev.playerId;
+            ed["target_id"] = ev.targetId;
+            ed["from_x"] = ev.from.x;
+            ed["from_y"] = ev.from.y;
+            ed["to_x"] = ev.to.x;
+            ed["to_y"] = ev.to.y;
+            ed["roll"] = ev.roll;
+            ed["success"] = ev.success;
+            ed["die1"] = ev.die1;
+            ed["die2"] = ev.die2;
+            events.append(ed);
+        }
+        t["events"] = events;
+        result.append(t);
+    }
+    return result;
+}
+
+// simulate_game settings; the value function (and the policy, for the
+// search AIs) come from `weights`.
+bb::GameConfig makeGameConfig(const std::string& homeAI, const std::string& awayAI,
+                              const py::object& weights, float epsilon, int mctsIterations,
+                              float policyBlend, float vfBlend, int gameIterations = 0,
+                              int gumbelTopK = 0) {
+    bb::GameConfig cfg;
+    cfg.homeAI = homeAI;
+    cfg.awayAI = awayAI;
+    cfg.epsilon = epsilon;
+    cfg.mctsIterations = mctsIterations;
+    cfg.policyBlend = policyBlend;
+    cfg.vfBlend = vfBlend;
+    cfg.gameIterations = gameIterations;
+    cfg.gumbelTopK = gumbelTopK;
+    bool searchAI = homeAI == "mcts" || awayAI == "mcts" ||
+                    homeAI == "macro_mcts" || awayAI == "macro_mcts";
+    if (searchAI || homeAI == "learning" || awayAI == "learning") {
+        if (auto model = resolveModel(weights)) {
+            cfg.valueFn = model->value;
+            if (searchAI) cfg.policy = model->policy;
+        }
+    }
+    return cfg;
+}
+
+// A search started from Python, owning what it reads. Members are
+// destroyed in reverse order: the handle (cancel and join) goes first.
+struct PyMacroSearch {
+    std::shared_ptr<bb::LoadedModel> model;
+    std::unique_ptr<bb::MacroMCTSSearch> search;
+    std::unique_ptr<bb::MacroSearchHandle> handle;
+};
+
+py::dict macroToDict(const bb::Macro& macro) {
+    BB_ALLOC_SCOPE(bb::alloc::BINDINGS);
+    py::dict d;
+    d["type"] = bb::macroTypeName(macro.type);
+    d["player"] = macro.playerId;
+    d["target_player"] = macro.targetId;
+    d["target_pos"] = py::make_tuple(macro.targetPos.x, macro.targetPos.y);
+    d["third_player"] = macro.thirdId;
+    return d;
+}
+
+py::dict searchProgressToDict(const bb::MacroSearchHandle::Progress& p) {
+    BB_ALLOC_SCOPE(bb::alloc::BINDINGS);
+    py::dict out;
+    out["iterations"] = p.iterations;
+    out["elapsed_ms"] = p.elapsedMs;
+    out["done"] = p.done;
+    out["best"] = p.hasBest ? py::object(macroToDict(p.best)) : py::object(py::none());
+    out["best_value"] = p.bestValue;
+    py::list visits;
+    for (const auto& v : p.visits) {
+        py::dict d = macroToDict(v.macro);
+        d["visits"] = v.visits;
+        d["share"] = v.target;
+        d["prior"] = v.prior;
+        d["value"] = v.value;
+        visits.append(d);
+    }
+    out["visits"] = visits;
+    return out;
+}
+
+} // anonymous namespace
+
+// numpy record layouts of bb/state_arrays.h, with snake_case field names
+PYBIND11_NUMPY_DTYPE_EX(bb::PlayerRecord, id, "id", team, "team", state, "state", x, "x", y, "y",
+                        movementRemaining, "movement_remaining", movement, "movement", strength,
+                        "strength", agility, "agility", armour, "armour", flags, "flags", profile,
+                        "profile", skills, "skills");
+PYBIND11_NUMPY_DTYPE_EX(bb::StateRecord, half, "half", phase, "phase", activeTeam, "active_team",
+                        kickingTeam, "kicking_team", weather, "weather", ballX, "ball_x", ballY,
+                        "ball_y", ballHeld, "ball_held", ballCarrierId, "ball_carrier_id",
+                        turnoverPending, "turnover_pending", homeScore, "home_score", awayScore,
+                        "away_score", homeRerolls, "home_rerolls", awayRerolls, "away_rerolls",
+                        homeTurn, "home_turn", awayTurn, "away_turn", homeFlags, "home_flags",
+                        awayFlags, "away_flags");
+
+PYBIND11_NUMPY_DTYPE_EX(bb::SearchTreeRecord, parent, "parent", visits, "visits", q, "q", prior,
+                        "prior", chance, "chance", numChildren, "num_children", kind, "kind",
+                        playerId, "player_id", targetId, "target_id", thirdId, "third_id", targetX,
+                        "target_x", targetY, "target_y", actingTeam, "acting_team", depth, "depth");
+
+namespace {
+
+// GameState.as_arrays / states_as_arrays: numpy arrays allocated up front
+// and filled in place with the GIL released. `batched` adds a leading axis
+// of states.size(); otherwise states holds one state.
+py::dict stateArrays(const std::vector<const bb::GameState*>& states, bool batched, int threads) {
+    std::vector<py::ssize_t> lead;
+    if (batched) lead.push_back(static_cast<py::ssize_t>(states.size()));
+    auto shape = [&lead](std::initializer_list<py::ssize_t> tail) {
+        std::vector<py::ssize_t> s = lead;
+        s.insert(s.end(), tail);
+        return s;
+    };
+    py::array_t<bb::PlayerRecord> players(shape({bb::STATE_PLAYERS}));
+    py::array_t<uint8_t> board(shape({bb::Position::PITCH_HEIGHT, bb::Position::PITCH_WIDTH}));
+    py::array_t<bb::StateRecord> record(shape({}));
+    bb::PlayerRecord* p = players.mutable_data();
+    uint8_t* b = board.mutable_data();
+    bb::StateRecord* r = record.mutable_data();
+    {
+        py::gil_scoped_release release;
+        bb::writeStateArrays(states.data(), states.size(), p, b, r, threads);
+    }
+    py::dict out;
+    out["players"] = players;
+    out["board"] = board;
+    out["state"] = record;
+    return out;
+}
+
+} // anonymous namespace
+
 PYBIND11_MODULE(bb_engine, m) {
     m.doc() = "Blood Bowl C++ Engine - Python bindings";
 
@@ -65,7 +318,8 @@ PYBIND11_MODULE(bb_engine, m) {
         .value("HYPNOTIC_GAZE", bb::ActionType::HYPNOTIC_GAZE)
         .value("BALL_AND_CHAIN", bb::ActionType::BALL_AND_CHAIN)
         .value("MULTIPLE_BLOCK", bb::ActionType::MULTIPLE_BLOCK)
-        .value("END_TURN", bb::ActionType::END_TURN);
+        .value("END_TURN", bb::ActionType::END_TURN)
+        .value("MOVE_PATH", bb::ActionType::MOVE_PATH);
 
     py::enum_<bb::Weather>(m, "Weather")
         .value("SWELTERING_HEAT", bb::Weather::SWELTERING_HEAT)
@@ -110,7 +364,8 @@ PYBIND11_MODULE(bb_engine, m) {
         .def_readwrite("team_side", &bb::Player::teamSide)
         .def_readwrite("state", &bb::Player::state)
         .def_readwrite("position", &bb::Player::position)
-        .def_readwrite("stats", &bb::Player::stats)
+        // A copy: assign a whole PlayerStats to change it (stats live in the shared profile table)
+        .def_property("stats", [](const bb::Player& p) { return p.stats(); }, &bb::Player::setStats)
         .def_readwrite("movement_remaining", &bb::Player::movementRemaining)
         .def_readwrite("has_moved", &bb::Player::hasMoved)
         .def_readwrite("has_acted", &bb::Player::hasActed)
@@ -137,9 +392,47 @@ PYBIND11_MODULE(bb_engine, m) {
         .def_readwrite("weather", &bb::GameState::weather)
         .def_readwrite("kicking_team", &bb::GameState::kickingTeam)
         .def("get_player", [](bb::GameState& gs, int id) -> bb::Player& {
+            // The returned reference is writable from Python, bypassing the
+            // GameState mutators: drop the occupancy index so it is rebuilt.
+            gs.invalidateOccupancy();
             return gs.getPlayer(id);
         }, py::return_value_policy::reference_internal)
-        .def("clone", &bb::GameState::clone);
+        .def("hash", &bb::GameState::hash)
+        .def("clone", &bb::GameState::clone)
+        // Every player, the board and the scalar state in one copy
+        // (bb/state_arrays.h): {"players": (22,) structured, "board":
+        // (15, 26) uint8 player ids, 0 = empty, "state": 0-d structured}
+        .def("as_arrays", [](const bb::GameState& gs) { return stateArrays({&gs}, false, 1); })
+        // Binary record (bb/state_io.h), e.g. to pickle or ship to a worker
+        .def("serialize", [](const bb::GameState& gs) {
+            std::vector<uint8_t> bytes = bb::serializeState(gs);
+            return py::bytes(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        })
+        .def_static("deserialize", [](const py::bytes& data) {
+            std::string_view bytes = data;
+            auto state = bb::deserializeState(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+            if (!state) throw std::invalid_argument("not a serialized GameState of this version");
+            return *state;
+        }, py::arg("data"));
+
+    m.def("states_as_arrays", [](const std::vector<const bb::GameState*>& states, int threads) {
+        return stateArrays(states, true, threads);
+    }, py::arg("states"), py::arg("threads") = 1,
+       "GameState.as_arrays for a list of states, each array with a leading axis of len(states)");
+    m.attr("PLAYER_FLAGS") = py::dict(
+        py::arg("has_moved") = static_cast<int>(bb::PlayerRecord::HAS_MOVED),
+        py::arg("has_acted") = static_cast<int>(bb::PlayerRecord::HAS_ACTED),
+        py::arg("used_blitz") = static_cast<int>(bb::PlayerRecord::USED_BLITZ),
+        py::arg("lost_tacklezones") = static_cast<int>(bb::PlayerRecord::LOST_TACKLEZONES),
+        py::arg("pro_used") = static_cast<int>(bb::PlayerRecord::PRO_USED),
+        py::arg("has_ball") = static_cast<int>(bb::PlayerRecord::HAS_BALL));
+    m.attr("TEAM_FLAGS") = py::dict(
+        py::arg("reroll_used") = static_cast<int>(bb::StateRecord::REROLL_USED),
+        py::arg("blitz_used") = static_cast<int>(bb::StateRecord::BLITZ_USED),
+        py::arg("pass_used") = static_cast<int>(bb::StateRecord::PASS_USED),
+        py::arg("foul_used") = static_cast<int>(bb::StateRecord::FOUL_USED),
+        py::arg("has_apothecary") = static_cast<int>(bb::StateRecord::HAS_APOTHECARY),
+        py::arg("apothecary_used") = static_cast<int>(bb::StateRecord::APOTHECARY_USED));
 
     // --- Action ---
     py::class_<bb::Action>(m, "Action")
@@ -158,11 +451,44 @@ PYBIND11_MODULE(bb_engine, m) {
     py::class_<bb::GameResult>(m, "GameResult")
         .def_readwrite("home_score", &bb::GameResult::homeScore)
         .def_readwrite("away_score", &bb::GameResult::awayScore)
-        .def_readwrite("total_actions", &bb::GameResult::totalActions);
+        .def_readwrite("total_actions", &bb::GameResult::totalActions)
+        .def_readwrite("home_policy_ms", &bb::GameResult::homePolicyMs)
+        .def_readwrite("away_policy_ms", &bb::GameResult::awayPolicyMs)
+        .def_readwrite("adjudicated", &bb::GameResult::adjudicated);
 
     // --- LoggedGameResult ---
     py::class_<bb::LoggedGameResult>(m, "LoggedGameResult")
         .def_readwrite("result", &bb::LoggedGameResult::result)
+        .def("to_columns", [](const bb::LoggedGameResult& lgr) {
+            // Columnar mode: one numpy array per field, backed by the C++
+            // buffers (no per-element Python objects). Variable-length
+            // parts use *_offsets arrays of length count + 1.
+            bb::GameLogColumns c;
+            {
+                py::gil_scoped_release release;
+                c = bb::toColumns(lgr);
+            }
+            auto vec1 = [](auto&& v) {
+                py::ssize_t n = static_cast<py::ssize_t>(v.size());
+                return adoptVector(std::move(v), {n});
+            };
+            py::dict out;
+            out["state_features"] = adoptRows(std::move(c.stateFeatures), bb::NUM_FEATURES);
+            out["state_perspective"] = vec1(std::move(c.statePerspective));
+            out["decision_features"] = adoptRows(std::move(c.decisionFeatures), bb::NUM_FEATURES);
+            out["decision_perspective"] = vec1(std::move(c.decisionPerspective));
+            out["decision_hash"] = vec1(std::move(c.decisionHash));
+            out["visit_offsets"] = vec1(std::move(c.visitOffsets));
+            out["visit_action_features"] = adoptRows(std::move(c.visitActionFeatures),
+                                                     bb::NUM_ACTION_FEATURES);
+            out["visit_fractions"] = vec1(std::move(c.visitFractions));
+            addBoardColumns(out, "decision", std::move(c.decisionBoards));
+            out["turns"] = adoptRows(std::move(c.turns), bb::GameLogColumns::TURN_COLS);
+            out["event_offsets"] = vec1(std::move(c.eventOffsets));
+            out["events"] = adoptRows(std::move(c.events), bb::GameLogColumns::EVENT_COLS);
+            addBoardColumns(out, "turn", std::move(c.turnBoards));
+            return out;
+        })
         .def("get_states", [](const bb::LoggedGameResult& lgr) {
             // Return list of (features_numpy, perspective_str) tuples
             py::list result;
@@ -175,20 +501,52 @@ PYBIND11_MODULE(bb_engine, m) {
             return result;
         })
         .def("get_policy_decisions", [](const bb::LoggedGameResult& lgr) {
-            auto playersToList = [](const std::vector<bb::PlayerSnapshot>& players) {
+            // Positionals are resolved here, against the game's rosters
+            auto playersToList = [&lgr](const bb::CompactBoardSnapshot& board, bool away) {
+                const bb::TeamRoster& roster = away ? lgr.record.away : lgr.record.home;
                 py::list out;
-                for (auto& p : players) {
+                int begin = away ? board.numHome : 0;
+                int end = away ? board.numPlayers() : board.numHome;
+                for (int i = begin; i < end; ++i) {
+                    const bb::CompactPlayerSnapshot& p = board.players[i];
                     py::dict pd;
                     pd["id"] = p.id;
                     pd["x"] = p.x;
                     pd["y"] = p.y;
-                    pd["state"] = p.state;
-                    pd["has_ball"] = p.hasBall;
+                    pd["state"] = p.state();
+                    pd["has_ball"] = p.hasBall();
+                    pd["positional"] = bb::positionalIndex(roster, p.profile);
                     out.append(pd);
                 }
                 return out;
             };
 
+            auto statsToDict = [](const bb::SearchStats& st) {
+                BB_ALLOC_SCOPE(bb::alloc::BINDINGS);
+                py::dict sd;
+                sd["iterations"] = st.iterations;
+                sd["total_ms"] = st.totalMs;
+                sd["select_ms"] = st.selectMs;
+                sd["replay_ms"] = st.replayMs;
+                sd["expand_ms"] = st.expandMs;
+                sd["simulate_ms"] = st.simulateMs;
+                sd["backprop_ms"] = st.backpropMs;
+                sd["nodes_allocated"] = st.nodesAllocated;
+                sd["max_depth"] = st.maxDepth;
+                sd["avg_depth"] = st.avgDepth;
+                sd["truncated_replays"] = st.truncatedReplays;
+                sd["leaf_evals"] = st.leafEvals;
+                sd["stopped_early"] = st.stoppedEarly;
+                sd["prior_cache_hit_rate"] = st.priorCacheHitRate();
+                sd["recycled_nodes"] = st.recycledNodes;
+                sd["expansions_skipped"] = st.expansionsSkipped;
+                sd["iterations_per_sec"] = st.iterationsPerSec;
+                sd["allocations"] = st.allocations;
+                sd["allocated_bytes"] = st.allocatedBytes;
+                sd["peak_live_bytes"] = st.peakLiveBytes;
+                return sd;
+            };
+
             py::list result;
             for (auto& dec : lgr.policyDecisions) {
                 py::dict d;
@@ -206,101 +564,315 @@ PYBIND11_MODULE(bb_engine, m) {
                 d["visits"] = visits;
 
                 // Raw board snapshot at decision time (offline per-player feature research)
-                d["home_players"] = playersToList(dec.board.homePlayers);
-                d["away_players"] = playersToList(dec.board.awayPlayers);
-                d["ball_x"] = dec.board.ballX;
-                d["ball_y"] = dec.board.ballY;
-                d["ball_held"] = dec.board.ballHeld;
-                d["ball_carrier_id"] = dec.board.ballCarrierId;
+                if (dec.board.captured) {
+                    d["home_players"] = playersToList(dec.board, false);
+                    d["away_players"] = playersToList(dec.board, true);
+                    d["ball_x"] = dec.board.ballX;
+                    d["ball_y"] = dec.board.ballY;
+                    d["ball_held"] = dec.board.ballHeld;
+                    d["ball_carrier_id"] = dec.board.ballCarrierId;
+                }
+                d["state_hash"] = dec.stateHash;
+                d["canonical_hash"] = dec.canonicalHash;
+                d["total_visits"] = dec.totalVisits;
+                d["mirrored"] = dec.mirrored;
+                d["search_stats"] = statsToDict(dec.search);
 
                 result.append(d);
             }
             return result;
         })
         .def("get_turn_logs", [](const bb::LoggedGameResult& lgr) {
+            return turnLogsToList(lgr.turnLogs, lgr.events);
+        })
+        .def("get_decision_searches", [](const bb::LoggedGameResult& lgr) {
+            // Per record action: "none", "cheap" or "full"
+            static const char* const names[] = {"none", "cheap", "full"};
             py::list result;
-            // GameEvent type names
-            static const char* eventNames[] = {
-                "MOVE", "DODGE", "GFI", "BLOCK", "PUSH", "INJURY",
-                "TOUCHDOWN", "TURNOVER", "BALL_BOUNCE", "PASS", "CATCH",
-                "PICKUP", "FOUL", "KICKOFF", "WEATHER", "SKILL",
-                "KNOCKED_DOWN", "ARMOR_BREAK", "CASUALTY", "REGENERATION",
-                "EJECTED"
-            };
-            for (auto& turn : lgr.turnLogs) {
-                py::dict t;
-                t["half"] = turn.half;
-                t["turn"] = turn.turnNumber;
-                t["active_team"] = turn.activeTeam == bb::TeamSide::HOME ? "home" : "away";
-                t["home_score"] = turn.homeScore;
-                t["away_score"] = turn.awayScore;
-                t["ball_x"] = turn.ballX;
-                t["ball_y"] = turn.ballY;
-                t["ball_held"] = turn.ballHeld;
-                t["ball_carrier_id"] = turn.ballCarrierId;
-                t["turnover"] = turn.turnover;
-                t["touchdown"] = turn.touchdown;
-
-                // Player snapshots
-                py::list home_players, away_players;
-                for (auto& p : turn.homePlayers) {
-                    py::dict pd;
-                    pd["id"] = p.id;
-                    pd["x"] = p.x;
-                    pd["y"] = p.y;
-                    pd["state"] = p.state;
-                    pd["has_ball"] = p.hasBall;
-                    home_players.append(pd);
-                }
-                for (auto& p : turn.awayPlayers) {
-                    py::dict pd;
-                    pd["id"] = p.id;
-                    pd["x"] = p.x;
-                    pd["y"] = p.y;
-                    pd["state"] = p.state;
-                    pd["has_ball"] = p.hasBall;
-                    away_players.append(pd);
+            for (bb::DecisionSearch kind : lgr.decisionSearches) {
+                result.append(names[static_cast<int>(kind)]);
+            }
+            return result;
+        })
+        .def_readonly("record", &bb::LoggedGameResult::record);
+
+    // --- Training shards (bb/training_shards.h) ---
+    // blood_bowl.training_shards maps the files as numpy record arrays.
+    py::class_<bb::ShardWriter>(m, "ShardWriter")
+        .def(py::init([](const std::string& dir, uint64_t maxShardBytes, bool compress, int level) {
+            bb::ShardWriterConfig cfg;
+            cfg.maxShardBytes = maxShardBytes;
+            cfg.compress = compress;
+            cfg.compressionLevel = level;
+            return std::make_unique<bb::ShardWriter>(dir, cfg);
+        }), py::arg("dir"), py::arg("max_shard_bytes") = bb::ShardWriterConfig{}.maxShardBytes,
+            py::arg("compress") = false, py::arg("compression_level") = 3)
+        .def("append_game", &bb::ShardWriter::appendGame,
+             py::arg("logged"), py::arg("home_outcome"), py::arg("away_outcome"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("close", &bb::ShardWriter::close, py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("shards_written", &bb::ShardWriter::shardsWritten);
+
+    // Batches come back as a dict of contiguous arrays: features
+    // (batch, NUM_FEATURES), outcomes, weights, ids, perspectives.
+    auto batchToDict = [](bb::ReplayBatch&& b) {
+        py::dict out;
+        out["features"] = adoptRows(std::move(b.features), bb::NUM_FEATURES);
+        out["outcomes"] = adoptVector(std::move(b.outcomes), {b.size});
+        out["weights"] = adoptVector(std::move(b.weights), {b.size});
+        out["ids"] = adoptVector(std::move(b.ids), {b.size});
+        out["perspectives"] = adoptVector(std::move(b.perspectives), {b.size});
+        return out;
+    };
+    py::class_<bb::ReplayBuffer>(m, "ReplayBuffer")
+        .def(py::init([](const std::string& dir, uint64_t capacity, float alpha, float beta, uint64_t seed) {
+            bb::ReplayBufferConfig cfg;
+            cfg.capacity = capacity;
+            cfg.alpha = alpha;
+            cfg.beta = beta;
+            cfg.seed = seed;
+            return std::make_unique<bb::ReplayBuffer>(dir, cfg);
+        }), py::arg("dir"), py::arg("capacity") = bb::ReplayBufferConfig{}.capacity,
+            py::arg("alpha") = 0.6f, py::arg("beta") = 0.4f, py::arg("seed") = 0)
+        .def("refresh", &bb::ReplayBuffer::refresh, py::call_guard<py::gil_scoped_release>())
+        .def("__len__", &bb::ReplayBuffer::size)
+        .def_property_readonly("total_added", &bb::ReplayBuffer::totalAdded)
+        .def("sample", [batchToDict](bb::ReplayBuffer& rb, int batchSize, bool prioritized) {
+            bb::ReplayBatch b;
+            {
+                py::gil_scoped_release release;
+                b = rb.sample(batchSize, prioritized);
+            }
+            return batchToDict(std::move(b));
+        }, py::arg("batch_size"), py::arg("prioritized") = false)
+        .def("update_priorities", [](bb::ReplayBuffer& rb,
+                                     py::array_t<uint64_t, py::array::c_style | py::array::forcecast> ids,
+                                     py::array_t<float, py::array::c_style | py::array::forcecast> priorities) {
+            if (ids.size() != priorities.size()) throw std::invalid_argument("ids and priorities differ in length");
+            rb.updatePriorities(ids.data(), priorities.data(), static_cast<size_t>(ids.size()));
+        }, py::arg("ids"), py::arg("priorities"))
+        .def("start_prefetch", &bb::ReplayBuffer::startPrefetch,
+             py::arg("batch_size"), py::arg("prioritized") = false, py::arg("threads") = 2, py::arg("depth") = 4)
+        .def("next_batch", [batchToDict](bb::ReplayBuffer& rb) {
+            bb::ReplayBatch b;
+            {
+                py::gil_scoped_release release;
+                b = rb.nextBatch();
+            }
+            return batchToDict(std::move(b));
+        })
+        .def("stop_prefetch", &bb::ReplayBuffer::stopPrefetch, py::call_guard<py::gil_scoped_release>());
+
+    // Native trainer over a shard directory; weights_json() / save_weights()
+    // write the JSON the engine's loaders read for that model.
+    py::class_<bb::ShardTrainer>(m, "ShardTrainer")
+        .def(py::init([](const std::string& dir, const std::string& model, int hiddenSize,
+                         const std::string& optimizer, float learningRate, float momentum,
+                         float weightDecay, int batchSize, int threads, uint64_t seed,
+                         const std::string& initialWeights) {
+            bb::TrainerConfig cfg;
+            if (!bb::parseTrainerModel(model, cfg.model)) {
+                throw std::invalid_argument("unknown model '" + model +
+                                            "' (linear_value, neural_value, linear_policy, neural_policy)");
+            }
+            if (optimizer == "adam") {
+                cfg.optimizer = bb::TrainerOptimizer::ADAM;
+            } else if (optimizer == "sgd") {
+                cfg.optimizer = bb::TrainerOptimizer::SGD;
+            } else {
+                throw std::invalid_argument("unknown optimizer '" + optimizer + "' (adam, sgd)");
+            }
+            cfg.hiddenSize = hiddenSize;
+            cfg.learningRate = learningRate;
+            cfg.momentum = momentum;
+            cfg.weightDecay = weightDecay;
+            cfg.batchSize = batchSize;
+            cfg.threads = threads;
+            cfg.seed = seed;
+            cfg.initialWeights = initialWeights;
+            return std::make_unique<bb::ShardTrainer>(dir, cfg);
+        }), py::arg("dir"), py::arg("model") = "linear_value", py::arg("hidden_size") = 32,
+            py::arg("optimizer") = "adam", py::arg("learning_rate") = 1e-3f, py::arg("momentum") = 0.0f,
+            py::arg("weight_decay") = 0.0f, py::arg("batch_size") = 256, py::arg("threads") = 1,
+            py::arg("seed") = 0, py::arg("initial_weights") = "")
+        .def("train_epoch", &bb::ShardTrainer::trainEpoch, py::call_guard<py::gil_scoped_release>())
+        .def("loss", &bb::ShardTrainer::loss, py::call_guard<py::gil_scoped_release>())
+        .def("weights_json", &bb::ShardTrainer::weightsJson)
+        .def("save_weights", &bb::ShardTrainer::saveWeights, py::arg("path"))
+        .def_property_readonly("samples", &bb::ShardTrainer::samples)
+        .def_property_readonly("parameters", &bb::ShardTrainer::parameters)
+        .def_property_readonly("epochs", &bb::ShardTrainer::epochs);
+
+    // --- Vectorized environment ---
+    // Every method covers all N games in one call, with the GIL released.
+    py::class_<bb::VecEnv>(m, "VecEnv")
+        .def(py::init([](const bb::TeamRoster& home, const bb::TeamRoster& away, int numEnvs,
+                         int maxActions, bool fullKickoff, bool paths, int threads, int maxGameActions) {
+            bb::VecEnvConfig cfg;
+            cfg.maxActions = maxActions;
+            cfg.useFullKickoff = fullKickoff;
+            cfg.paths = paths;
+            cfg.threads = threads;
+            cfg.maxGameActions = maxGameActions;
+            return std::make_unique<bb::VecEnv>(home, away, numEnvs, cfg);
+        }), py::arg("home"), py::arg("away"), py::arg("num_envs"),
+            py::arg("max_actions") = bb::VecEnvConfig{}.maxActions, py::arg("full_kickoff") = false,
+            py::arg("paths") = false, py::arg("threads") = 0,
+            py::arg("max_game_actions") = bb::VecEnvConfig{}.maxGameActions)
+        .def_property_readonly("num_envs", &bb::VecEnv::numEnvs)
+        .def_property_readonly("max_actions", [](const bb::VecEnv& env) { return env.config().maxActions; })
+        .def("state", [](const bb::VecEnv& env, int i) {
+            if (i < 0 || i >= env.numEnvs()) throw py::index_error("env index out of range");
+            return env.state(i);
+        }, py::arg("env"))
+        // Reset every game, or only those where `mask` is true.
+        .def("reset", [](bb::VecEnv& env,
+                         py::array_t<uint64_t, py::array::c_style | py::array::forcecast> seeds,
+                         std::optional<py::array_t<uint8_t, py::array::c_style | py::array::forcecast>> mask) {
+            if (seeds.size() != env.numEnvs()) throw std::invalid_argument("need one seed per env");
+            if (mask && mask->size() != env.numEnvs()) throw std::invalid_argument("need one mask entry per env");
+            const uint8_t* which = mask ? mask->data() : nullptr;
+            py::gil_scoped_release release;
+            env.reset(seeds.data(), which);
+        }, py::arg("seeds"), py::arg("mask") = py::none())
+        // Dict of actions (N, max_actions, 5) int16 [type, player_id, target_id,
+        // target_x, target_y] padded with -1, mask (N, max_actions) bool, and
+        // with action_features=True, (N, max_actions, NUM_ACTION_FEATURES) float32.
+        .def("legal_actions", [](const bb::VecEnv& env, bool withFeatures) {
+            const py::ssize_t n = env.numEnvs(), slots = env.config().maxActions;
+            std::vector<int16_t> actions(static_cast<size_t>(n * slots) * bb::VecEnv::ACTION_COLUMNS);
+            std::vector<uint8_t> mask(static_cast<size_t>(n * slots));
+            std::vector<float> features(withFeatures ? static_cast<size_t>(n * slots) * bb::NUM_ACTION_FEATURES : 0);
+            {
+                py::gil_scoped_release release;
+                env.legalActions(actions.data(), mask.data(), withFeatures ? features.data() : nullptr);
+            }
+            py::dict out;
+            out["actions"] = adoptVector(std::move(actions), {n, slots, bb::VecEnv::ACTION_COLUMNS});
+            out["mask"] = adoptVector(std::move(mask), {n, slots}).attr("astype")("bool");
+            if (withFeatures) {
+                out["action_features"] = adoptVector(std::move(features), {n, slots, bb::NUM_ACTION_FEATURES});
+            }
+            return out;
+        }, py::arg("action_features") = false)
+        // (rewards float32, done bool): reward is the acting team's change in
+        // score difference.
+        .def("step", [](bb::VecEnv& env, py::array_t<int32_t, py::array::c_style | py::array::forcecast> choices) {
+            const py::ssize_t n = env.numEnvs();
+            if (choices.size() != n) throw std::invalid_argument("need one choice per env");
+            std::vector<float> rewards(n);
+            std::vector<uint8_t> done(n);
+            {
+                py::gil_scoped_release release;
+                env.step(choices.data(), rewards.data(), done.data());
+            }
+            return py::make_tuple(adoptVector(std::move(rewards), {n}),
+                                  adoptVector(std::move(done), {n}).attr("astype")("bool"));
+        }, py::arg("choices"))
+        // (observation, active_team): features (N, NUM_FEATURES) float32, or with
+        // planes=True (N, C, 15, 26) uint8, each from the game's active team.
+        .def("observe", [](const bb::VecEnv& env, bool planes) {
+            const py::ssize_t n = env.numEnvs();
+            std::vector<uint8_t> teams(n);
+            py::array obs;
+            if (planes) {
+                std::vector<uint8_t> out(static_cast<size_t>(n) * bb::NUM_BOARD_PLANES * bb::BOARD_PLANE_SIZE);
+                {
+                    py::gil_scoped_release release;
+                    env.observePlanes(out.data(), teams.data());
                 }
-                t["home_players"] = home_players;
-                t["away_players"] = away_players;
-
-                // Events
-                py::list events;
-                for (auto& ev : turn.events) {
-                    py::dict ed;
-                    int typeIdx = static_cast<int>(ev.type);
-                    ed["type"] = (typeIdx < 21) ? eventNames[typeIdx] : "UNKNOWN";
-                    ed["player_id"] = ev.playerId;
-                    ed["target_id"] = ev.targetId;
-                    ed["from_x"] = ev.from.x;
-                    ed["from_y"] = ev.from.y;
-                    ed["to_x"] = ev.to.x;
-                    ed["to_y"] = ev.to.y;
-                    ed["roll"] = ev.roll;
-                    ed["success"] = ev.success;
-                    ed["die1"] = ev.die1;
-                    ed["die2"] = ev.die2;
-                    events.append(ed);
+                obs = adoptVector(std::move(out), {n, bb::NUM_BOARD_PLANES, bb::BOARD_PLANE_HEIGHT,
+                                                   bb::BOARD_PLANE_WIDTH});
+            } else {
+                std::vector<float> out(static_cast<size_t>(n) * bb::NUM_FEATURES);
+                {
+                    py::gil_scoped_release release;
+                    env.observe(out.data(), teams.data());
                 }
-                t["events"] = events;
-                result.append(t);
+                obs = adoptRows(std::move(out), bb::NUM_FEATURES);
             }
-            return result;
-        });
+            return py::make_tuple(obs, adoptVector(std::move(teams), {n}));
+        }, py::arg("planes") = false);
+
+    // --- Event-sourced game records ---
+    py::class_<bb::GameRecord>(m, "GameRecord")
+        .def_property_readonly("num_actions", [](const bb::GameRecord& r) { return r.actions.size(); })
+        .def_property_readonly("num_dice", [](const bb::GameRecord& r) { return r.dice.size(); })
+        .def("save", [](const bb::GameRecord& r, const std::string& path) {
+            if (!bb::writeGameRecord(path, r)) throw std::runtime_error("cannot write game record to " + path);
+        }, py::arg("path"))
+        .def_static("load", [](const std::string& path) {
+            auto r = bb::readGameRecord(path);
+            if (!r) throw std::runtime_error("cannot read game record from " + path);
+            return *r;
+        }, py::arg("path"));
+    m.def("replay_game", [](const bb::GameRecord& record) {
+        py::gil_scoped_release release;
+        return bb::replayGame(record);
+    }, py::arg("record"));
+    py::class_<bb::GameReplayer>(m, "GameReplayer")
+        .def(py::init<bb::GameRecord, int>(), py::arg("record"), py::arg("checkpoint_interval") = 4,
+             py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("num_turns", &bb::GameReplayer::numTurns)
+        .def_property_readonly("result", &bb::GameReplayer::result)
+        .def("state_at_turn", &bb::GameReplayer::stateAtTurn, py::arg("turn"))
+        .def("turn_log", [](const bb::GameReplayer& r, int turn) {
+            std::vector<bb::GameEvent> events;
+            bb::TurnLog log = r.turnLog(turn, events);
+            return py::object(turnLogsToList({log}, events)[0]);
+        }, py::arg("turn"));
+
+    // --- Binary replays (bb/replay_file.h) ---
+    // read_replay returns the get_turn_logs() dicts; blood_bowl.replay_file
+    // reads the same files through numpy.memmap without the extension.
+    m.def("write_replay", [](const std::string& path, const bb::LoggedGameResult& lgr,
+                             const std::string& metadata) {
+        bb::ReplayInfo info{lgr.result.homeScore, lgr.result.awayScore, metadata};
+        if (!bb::writeReplay(path, lgr.turnLogs, lgr.events, info)) {
+            throw std::runtime_error("cannot write replay to " + path);
+        }
+    }, py::arg("path"), py::arg("logged"), py::arg("metadata") = "");
+    m.def("read_replay", [](const std::string& path) {
+        auto reader = bb::ReplayReader::open(path);
+        if (!reader) throw std::runtime_error("cannot read replay from " + path);
+        py::dict d;
+        d["home_score"] = reader->info().homeScore;
+        d["away_score"] = reader->info().awayScore;
+        d["metadata"] = reader->info().metadata;
+        std::vector<bb::GameEvent> events;
+        std::vector<bb::TurnLog> turns = reader->turns(events);
+        d["turns"] = turnLogsToList(turns, events);
+        return d;
+    }, py::arg("path"));
 
     // --- DiceRoller ---
     py::class_<bb::DiceRoller>(m, "DiceRoller")
         .def(py::init<uint32_t>())
         .def("roll_d6", &bb::DiceRoller::rollD6)
         .def("roll_d8", &bb::DiceRoller::rollD8)
-        .def("roll_2d6", &bb::DiceRoller::roll2D6);
+        .def("roll_2d6", &bb::DiceRoller::roll2D6)
+        .def("get_state", [](const bb::DiceRoller& dice) {
+            std::vector<uint8_t> bytes = bb::serializeDice(dice);
+            return py::bytes(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        })
+        .def("set_state", [](bb::DiceRoller& dice, const py::bytes& data) {
+            std::string_view bytes = data;
+            if (!bb::deserializeDice(dice, reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size())) {
+                throw std::invalid_argument("not a saved DiceRoller state");
+            }
+        }, py::arg("data"));
 
     // --- TeamRoster ---
     py::class_<bb::TeamRoster>(m, "TeamRoster")
         .def_readonly("name", &bb::TeamRoster::name)
         .def_readonly("positional_count", &bb::TeamRoster::positionalCount)
         .def_readonly("reroll_cost", &bb::TeamRoster::rerollCost)
-        .def_readonly("has_apothecary", &bb::TeamRoster::hasApothecary);
+        .def_readonly("has_apothecary", &bb::TeamRoster::hasApothecary)
+        // Registry id (bb/roster.h), or None for a roster that is not built in
+        .def_property_readonly("roster_id", [](const bb::TeamRoster& r) -> py::object {
+            bb::RosterId id = bb::rosterIdOf(r);
+            return id == bb::INVALID_ROSTER ? py::object(py::none()) : py::int_(id);
+        });
 
     // --- ActionResult ---
     py::class_<bb::ActionResult>(m, "ActionResult")
@@ -325,6 +897,8 @@ PYBIND11_MODULE(bb_engine, m) {
         return actions;
     });
 
+    m.def("is_action_legal", &bb::isActionLegal, py::arg("state"), py::arg("action"));
+
     m.def("execute_action", [](bb::GameState& state, const bb::Action& action, bb::DiceRoller& dice) {
         bb::DiceRollerBase& base = dice;
         return bb::executeAction(state, action, base, nullptr);
@@ -343,128 +917,445 @@ PYBIND11_MODULE(bb_engine, m) {
         bb::extractFeatures(state, perspective, features);
         return py::array_t<float>(bb::NUM_FEATURES, features);
     });
+    // (n, NUM_FEATURES) array; perspective defaults to each state's active team
+    m.def("extract_features_batch", [](const std::vector<bb::GameState>& states,
+                                       std::optional<std::vector<bb::TeamSide>> perspectives) {
+        std::vector<bb::TeamSide> persp;
+        if (perspectives) {
+            if (perspectives->size() != states.size()) {
+                throw std::invalid_argument("perspectives must match states in length");
+            }
+            persp = std::move(*perspectives);
+        } else {
+            for (const auto& s : states) persp.push_back(s.activeTeam);
+        }
+        int n = static_cast<int>(states.size());
+        std::vector<float> out(static_cast<size_t>(n) * bb::NUM_FEATURES);
+        {
+            py::gil_scoped_release release;
+            bb::extractFeaturesBatch(states.data(), n, persp.data(), out.data());
+        }
+        return adoptRows(std::move(out), bb::NUM_FEATURES);
+    }, py::arg("states"), py::arg("perspectives") = py::none());
+    // (C, 15, 26) float32 planes, or with packed=True (C, BOARD_PLANE_BYTES)
+    // uint8 rows: np.unpackbits(a, axis=1, count=390, bitorder="little")
+    m.attr("NUM_BOARD_PLANES") = static_cast<int>(bb::NUM_BOARD_PLANES);
+    m.attr("BOARD_PLANE_BYTES") = bb::BOARD_PLANE_BYTES;
+    m.def("extract_board_planes", [](const bb::GameState& state, bb::TeamSide perspective,
+                                     bool packed) -> py::object {
+        if (packed) {
+            std::vector<uint8_t> out(bb::NUM_BOARD_PLANES * bb::BOARD_PLANE_BYTES);
+            bb::extractBoardPlanesPacked(state, perspective, out.data());
+            return adoptRows(std::move(out), bb::BOARD_PLANE_BYTES);
+        }
+        std::vector<float> out(bb::NUM_BOARD_PLANES * bb::BOARD_PLANE_SIZE);
+        bb::extractBoardPlanes(state, perspective, out.data());
+        return adoptVector(std::move(out), {bb::NUM_BOARD_PLANES, bb::BOARD_PLANE_HEIGHT,
+                                            bb::BOARD_PLANE_WIDTH});
+    }, py::arg("state"), py::arg("perspective"), py::arg("packed") = false);
 
-    // simulate_game: supports "random", "greedy", "learning", and "mcts" AI types
+    // --- Offline re-featurization ---
+    // Boards in to_columns() form (<prefix>_board_players, _board_offsets,
+    // _ball) rebuilt into states and encoded by a registered feature set.
+    // contexts: (n or 1, SNAPSHOT_CONTEXT_COLS) int16 rows, see
+    // SnapshotContext; perspectives: n or 1 values, 0 home / 1 away.
+    m.attr("SNAPSHOT_CONTEXT_COLS") = bb::SnapshotContext::COLS;
+    m.def("feature_set_names", &bb::featureSetNames);
+    m.def("feature_set_size", [](const std::string& name) {
+        auto set = bb::findFeatureSet(name);
+        if (!set) throw std::invalid_argument("unknown feature set '" + name + "'");
+        return set->size;
+    }, py::arg("name"));
+    m.def("featurize_boards", [](const std::string& name,
+                                 py::array_t<int8_t, py::array::c_style | py::array::forcecast> players,
+                                 py::array_t<int32_t, py::array::c_style | py::array::forcecast> offsets,
+                                 py::array_t<int8_t, py::array::c_style | py::array::forcecast> ball,
+                                 py::array_t<int16_t, py::array::c_style | py::array::forcecast> contexts,
+                                 py::array_t<uint8_t, py::array::c_style | py::array::forcecast> perspectives,
+                                 const bb::TeamRoster& home, const bb::TeamRoster& away, int threads) {
+        auto set = bb::findFeatureSet(name);
+        if (!set) throw std::invalid_argument("unknown feature set '" + name + "'");
+        if (offsets.size() < 1) throw std::invalid_argument("board_offsets must hold boards + 1 entries");
+        bb::BoardColumnsView view;
+        view.players = players.data();
+        view.playerOffsets = offsets.data();
+        view.ball = ball.data();
+        view.boards = static_cast<size_t>(offsets.size() - 1);
+        if (players.ndim() != 2 || players.shape(1) != bb::BoardColumns::PLAYER_COLS ||
+            ball.ndim() != 2 || ball.shape(1) != bb::BoardColumns::BALL_COLS ||
+            static_cast<size_t>(ball.shape(0)) != view.boards ||
+            offsets.data()[view.boards] > players.shape(0)) {
+            throw std::invalid_argument("board arrays do not match (see LoggedGameResult.to_columns)");
+        }
+        if (contexts.ndim() != 2 || contexts.shape(1) != bb::SnapshotContext::COLS) {
+            throw std::invalid_argument("contexts must have SNAPSHOT_CONTEXT_COLS columns");
+        }
+        std::vector<bb::SnapshotContext> ctx;
+        for (py::ssize_t r = 0; r < contexts.shape(0); ++r) {
+            ctx.push_back(bb::SnapshotContext::fromRow(contexts.data(r, 0)));
+        }
+        std::vector<bb::TeamSide> persp;
+        for (py::ssize_t i = 0; i < perspectives.size(); ++i) {
+            persp.push_back(perspectives.data()[i] ? bb::TeamSide::AWAY : bb::TeamSide::HOME);
+        }
+        std::vector<float> out(view.boards * static_cast<size_t>(set->size));
+        {
+            py::gil_scoped_release release;
+            bb::featurizeBoards(*set, view, ctx, persp, home, away, threads, out.data());
+        }
+        return adoptRows(std::move(out), set->size);
+    }, py::arg("feature_set"), py::arg("board_players"), py::arg("board_offsets"), py::arg("ball"),
+       py::arg("contexts"), py::arg("perspectives"), py::arg("home"), py::arg("away"),
+       py::arg("threads") = 1);
+
+    // --- Model registry ---
+    // Networks stay resident across calls; a path is re-read only when its
+    // modification time changes.
+    py::class_<bb::LoadedModel, std::shared_ptr<bb::LoadedModel>>(m, "Model")
+        .def_readonly("path", &bb::LoadedModel::path)
+        .def_readonly("mtime", &bb::LoadedModel::mtime)
+        .def_property_readonly("has_value", [](const bb::LoadedModel& mo) { return mo.value != nullptr; })
+        .def_property_readonly("has_policy", [](const bb::LoadedModel& mo) { return mo.policy != nullptr; })
+        .def("__repr__", [](const bb::LoadedModel& mo) { return "<Model " + mo.path + ">"; });
+
+    m.def("load_model", [](const std::string& path) {
+        auto model = bb::ModelCache::global().get(path);
+        if (!model) throw std::runtime_error("cannot load model from " + path);
+        return model;
+    }, py::arg("path"));
+    m.def("clear_model_cache", []() { bb::ModelCache::global().clear(); });
+
+    // A path whose model can be swapped while games hold the old one; pass
+    // it anywhere weights are accepted to use the model current at the call.
+    py::class_<bb::ModelHandle, std::shared_ptr<bb::ModelHandle>>(m, "ModelHandle")
+        .def(py::init([](const std::string& path) { return std::make_shared<bb::ModelHandle>(path); }),
+             py::arg("path"))
+        .def("current", [](const bb::ModelHandle& h) {
+            return std::const_pointer_cast<bb::LoadedModel>(h.current());
+        })
+        .def("refresh", &bb::ModelHandle::refresh, py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("version", &bb::ModelHandle::version)
+        .def_property_readonly("path", &bb::ModelHandle::path)
+        .def("watch", &bb::ModelHandle::watch, py::arg("interval_ms"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("stop_watching", &bb::ModelHandle::stopWatching, py::call_guard<py::gil_scoped_release>())
+        .def("__repr__", [](const bb::ModelHandle& h) {
+            return "<ModelHandle " + h.path() + " v" + std::to_string(h.version()) + ">";
+        });
+    m.def("model_cache_size", []() { return bb::ModelCache::global().size(); });
+
+    // Batched native inference for offline re-scoring: one call per array
+    // instead of one Python round trip per sample
+    using FloatArray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+    m.def("evaluate_values", [](const py::object& weights, FloatArray features) {
+        auto model = resolveModel(weights);
+        auto vf = model ? model->value : nullptr;
+        if (!vf) throw std::runtime_error("cannot load value function from " + py::str(weights).cast<std::string>());
+        if (features.ndim() != 2 || features.shape(1) != bb::NUM_FEATURES) {
+            throw std::invalid_argument("features must have shape (n, NUM_FEATURES)");
+        }
+        int n = static_cast<int>(features.shape(0));
+        py::array_t<float> out(n);
+        const float* in = features.data();
+        float* dst = out.mutable_data();
+        {
+            py::gil_scoped_release release;
+            vf->evaluateBatch(in, n, bb::NUM_FEATURES, dst);
+        }
+        return out;
+    }, py::arg("weights_path"), py::arg("features"));
+
+    // Priors for many states: action_features rows are grouped by state,
+    // action_counts[s] rows for state s; returns one prior per row.
+    m.def("compute_priors_batch", [](const py::object& weights, FloatArray stateFeatures,
+                                     FloatArray actionFeatures,
+                                     py::array_t<int, py::array::c_style | py::array::forcecast> actionCounts) {
+        auto model = resolveModel(weights);
+        auto policy = model ? model->policy : nullptr;
+        if (!policy) throw std::runtime_error("cannot load policy network from " + py::str(weights).cast<std::string>());
+        if (stateFeatures.ndim() != 2 || stateFeatures.shape(1) != bb::NUM_FEATURES) {
+            throw std::invalid_argument("state_features must have shape (n, NUM_FEATURES)");
+        }
+        if (actionFeatures.ndim() != 2 || actionFeatures.shape(1) != bb::NUM_ACTION_FEATURES) {
+            throw std::invalid_argument("action_features must have shape (m, NUM_ACTION_FEATURES)");
+        }
+        int numStates = static_cast<int>(stateFeatures.shape(0));
+        if (actionCounts.ndim() != 1 || actionCounts.shape(0) != numStates) {
+            throw std::invalid_argument("action_counts must have one entry per state");
+        }
+        const int* counts = actionCounts.data();
+        long total = 0;
+        for (int s = 0; s < numStates; ++s) total += std::max(0, counts[s]);
+        if (total != actionFeatures.shape(0)) {
+            throw std::invalid_argument("action_counts must sum to the number of action rows");
+        }
+        py::array_t<float> out(total);
+        const float* states = stateFeatures.data();
+        const float* actions = actionFeatures.data();
+        float* dst = out.mutable_data();
+        {
+            py::gil_scoped_release release;
+            policy->computePriorsBatch(states, numStates, actions, counts, dst);
+        }
+        return out;
+    }, py::arg("weights_path"), py::arg("state_features"), py::arg("action_features"),
+       py::arg("action_counts"));
+
+    // simulate_game: supports "random", "greedy", "learning", and "mcts" AI types.
+    // Runs without the GIL, so threaded callers play games concurrently.
     m.def("simulate_game", [](const bb::TeamRoster& home, const bb::TeamRoster& away,
                                const std::string& homeAI, const std::string& awayAI,
                                uint32_t seed,
-                               const std::string& weightsPath,
+                               const py::object& weights,
                                float epsilon,
                                int mctsIterations,
                                float policyBlend,
-                               float vfBlend) {
-        bb::DiceRoller dice(seed);
+                               float vfBlend,
+                               int gumbelTopK) {
+        bb::GameConfig cfg = makeGameConfig(homeAI, awayAI, weights, epsilon, mctsIterations,
+                                            policyBlend, vfBlend, 0, gumbelTopK);
+        py::gil_scoped_release release;
+        return bb::playConfiguredGame(home, away, cfg, seed);
+    }, py::arg("home"), py::arg("away"),
+       py::arg("home_ai") = "random", py::arg("away_ai") = "random",
+       py::arg("seed") = 42,
+       py::arg("weights_path") = py::str(""),
+       py::arg("epsilon") = 0.3f,
+       py::arg("mcts_iterations") = 0,
+       py::arg("policy_blend") = 0.0f,
+       py::arg("vf_blend") = 0.0f,
+       py::arg("gumbel_top_k") = 0);  // macro_mcts: Gumbel sequential-halving root (0 = PUCT)
 
-        // Load value function if needed
-        std::unique_ptr<bb::ValueFunction> vf;
-        if ((homeAI == "learning" || awayAI == "learning" ||
-             homeAI == "mcts" || awayAI == "mcts" ||
-             homeAI == "macro_mcts" || awayAI == "macro_mcts") && !weightsPath.empty()) {
-            vf = bb::loadValueFunction(weightsPath);
-        }
+    // --- Batch game runner ---
+    py::class_<bb::GameConfig>(m, "GameConfig")
+        .def(py::init(&makeGameConfig),
+             py::arg("home_ai") = "random", py::arg("away_ai") = "random",
+             py::arg("weights_path") = py::str(""),
+             py::arg("epsilon") = 0.3f,
+             py::arg("mcts_iterations") = 0,
+             py::arg("policy_blend") = 0.0f,
+             py::arg("vf_blend") = 0.0f,
+             py::arg("game_iterations") = 0,
+             py::arg("gumbel_top_k") = 0)
+        .def_readonly("home_ai", &bb::GameConfig::homeAI)
+        .def_readonly("away_ai", &bb::GameConfig::awayAI)
+        .def_readonly("epsilon", &bb::GameConfig::epsilon)
+        .def_readonly("mcts_iterations", &bb::GameConfig::mctsIterations)
+        .def_readonly("game_iterations", &bb::GameConfig::gameIterations)
+        .def_readonly("gumbel_top_k", &bb::GameConfig::gumbelTopK);
+
+    py::class_<bb::BatchResult>(m, "BatchResult")
+        .def_readonly("games", &bb::BatchResult::games)
+        .def_readonly("home_wins", &bb::BatchResult::homeWins)
+        .def_readonly("away_wins", &bb::BatchResult::awayWins)
+        .def_readonly("draws", &bb::BatchResult::draws)
+        .def_readonly("total_actions", &bb::BatchResult::totalActions);
 
-        // Load policy network from weights file (if it contains policy data)
-        std::unique_ptr<bb::PolicyNetwork> policyNet;
-        if (!weightsPath.empty() && (homeAI == "mcts" || awayAI == "mcts" ||
-            homeAI == "macro_mcts" || awayAI == "macro_mcts")) {
-            policyNet = bb::loadPolicyNetworkFromFile(weightsPath);
+    // Many games on a native thread pool: configs has one GameConfig per
+    // seed, or a single one shared by all; networks are shared read-only.
+    m.def("simulate_games", [](const bb::TeamRoster& home, const bb::TeamRoster& away,
+                                const std::vector<bb::GameConfig>& configs,
+                                const std::vector<uint32_t>& seeds, int threads) {
+        py::gil_scoped_release release;
+        return bb::runGames(home, away, configs, seeds, threads);
+    }, py::arg("home"), py::arg("away"), py::arg("configs"), py::arg("seeds"),
+       py::arg("threads") = 1);
+
+    // Monte Carlo continuations of a position (bb/batch_runner.h): the
+    // config's home and away halves play n_games times to until ("drive" or
+    // "game"). Returns TD probabilities, the score-difference histogram and
+    // every continuation's result.
+    m.def("simulate_from_state", [](const bb::GameState& state, const bb::TeamRoster& home,
+                                     const bb::TeamRoster& away, const bb::GameConfig& config,
+                                     int nGames, int threads, const std::string& until, uint32_t seed) {
+        bb::PlayUntil horizon;
+        if (until == "drive") horizon = bb::PlayUntil::DRIVE_END;
+        else if (until == "game") horizon = bb::PlayUntil::GAME_END;
+        else throw std::invalid_argument("until must be 'drive' or 'game'");
+        bb::ContinuationResult r;
+        {
+            py::gil_scoped_release release;
+            r = bb::simulateFromState(state, home, away, bb::playerConfig(config, bb::TeamSide::HOME),
+                                      bb::playerConfig(config, bb::TeamSide::AWAY), nGames, threads,
+                                      horizon, seed);
         }
+        py::dict diffs;
+        for (const auto& [diff, count] : r.scoreDiff) diffs[py::int_(diff)] = count;
+        py::dict out;
+        out["home_td_probability"] = r.homeTdProbability();
+        out["away_td_probability"] = r.awayTdProbability();
+        out["mean_score_diff"] = r.meanScoreDiff();
+        out["score_diff"] = diffs;
+        out["total_actions"] = r.totalActions;
+        out["games"] = r.games;
+        return out;
+    }, py::arg("state"), py::arg("home"), py::arg("away"), py::arg("config"),
+       py::arg("n_games") = 100, py::arg("threads") = 1, py::arg("until") = "drive",
+       py::arg("seed") = 0);
 
-        // MCTS/MacroMCTS policies need to persist across calls (they hold state)
-        std::shared_ptr<bb::MCTSPolicy> homeMcts, awayMcts;
-        std::shared_ptr<bb::MacroMCTSPolicy> homeMacroMcts, awayMacroMcts;
+    // Side-swapped gating match with early stopping (bb/tournament.h).
+    // Each entrant is the home half of a GameConfig (home_ai, weights and
+    // search knobs). Returns the match summary with every game played
+    // under "games", A's score first.
+    m.def("run_match", [](const bb::GameConfig& a, const bb::GameConfig& b,
+                          int pairs, int minPairs, int threads, uint32_t seed,
+                          const std::vector<const bb::TeamRoster*>& rosters,
+                          const std::string& stop, double elo0, double elo1,
+                          double alpha, double beta, double wilsonZ, bool adjudicate) {
+        bb::TournamentConfig cfg;
+        cfg.maxPairs = pairs;
+        cfg.minPairs = minPairs;
+        cfg.threads = threads;
+        cfg.seed = seed;
+        cfg.rosters = rosters;
+        if (stop == "sprt") cfg.stop = bb::StopRule::SPRT;
+        else if (stop == "wilson") cfg.stop = bb::StopRule::WILSON;
+        else if (stop == "none") cfg.stop = bb::StopRule::NONE;
+        else throw std::invalid_argument("stop must be 'sprt', 'wilson' or 'none'");
+        cfg.elo0 = elo0;
+        cfg.elo1 = elo1;
+        cfg.alpha = alpha;
+        cfg.beta = beta;
+        cfg.wilsonZ = wilsonZ;
+        cfg.adjudicate = adjudicate;
 
-        auto makePolicy = [&](const std::string& ai,
-                              std::shared_ptr<bb::MCTSPolicy>& mctsOut,
-                              std::shared_ptr<bb::MacroMCTSPolicy>& macroMctsOut) -> bb::ActionSelector {
-            if (ai == "greedy") {
-                return [&dice](const bb::GameState& s) { return bb::greedyPolicy(s, dice); };
-            } else if (ai == "macro_mcts" && mctsIterations > 0) {
-                bb::MCTSConfig cfg;
-                cfg.maxIterations = mctsIterations;
-                cfg.timeBudgetMs = 0;
-                cfg.explorationC = 1.0;   // Eval: low C for exploitation
-                cfg.dirichletAlpha = 0.0f; // No noise during evaluation
-                cfg.vfBlend = vfBlend;
-                if (policyNet) {
-                    cfg.policy = policyNet.get();
-                    cfg.policyBlend = policyBlend;
-                }
-                macroMctsOut = std::make_shared<bb::MacroMCTSPolicy>(vf.get(), cfg, seed);
-                return [m = macroMctsOut](const bb::GameState& s) { return (*m)(s); };
-            } else if (ai == "mcts" && vf && mctsIterations > 0) {
-                bb::MCTSConfig cfg;
-                cfg.maxIterations = mctsIterations;
-                cfg.timeBudgetMs = 0;
-                cfg.maxChildren = 40;
-                if (policyNet) {
-                    cfg.policy = policyNet.get();
-                    cfg.explorationC = 2.5;
-                }
-                mctsOut = std::make_shared<bb::MCTSPolicy>(vf.get(), cfg, seed);
-                return [mcts = mctsOut](const bb::GameState& s) { return (*mcts)(s); };
-            } else if (ai == "learning" && vf) {
-                return [&dice, &vf, epsilon](const bb::GameState& s) {
-                    return bb::learningPolicy(s, dice, *vf, epsilon);
-                };
-            } else {
-                return [&dice](const bb::GameState& s) { return bb::randomPolicy(s, dice); };
+        std::vector<bb::TournamentGame> games;
+        bb::MatchResult r;
+        {
+            py::gil_scoped_release release;
+            r = bb::runMatch(bb::playerConfig(a, bb::TeamSide::HOME), bb::playerConfig(b, bb::TeamSide::HOME),
+                             cfg, [&games](const bb::TournamentGame& g) { games.push_back(g); });
+        }
+        py::list gameList;
+        for (const auto& g : games) {
+            py::dict d;
+            d["pair"] = g.pair;
+            d["a_is_home"] = g.aIsHome;
+            d["seed"] = g.seed;
+            d["home_roster"] = g.homeRoster;
+            d["away_roster"] = g.awayRoster;
+            d["score_a"] = g.scoreA;
+            d["score_b"] = g.scoreB;
+            d["actions"] = g.totalActions;
+            d["adjudicated"] = g.adjudicated;
+            gameList.append(d);
+        }
+        py::dict out;
+        out["pairs"] = r.pairs;
+        out["wins"] = r.wins;
+        out["draws"] = r.draws;
+        out["losses"] = r.losses;
+        out["score"] = r.score;
+        out["llr"] = r.llr;
+        out["lower"] = r.lower;
+        out["upper"] = r.upper;
+        out["verdict"] = bb::matchVerdictName(r.verdict);
+        out["games"] = gameList;
+        return out;
+    }, py::arg("a"), py::arg("b"), py::arg("pairs") = 200, py::arg("min_pairs") = 10,
+       py::arg("threads") = 1, py::arg("seed") = 1,
+       py::arg("rosters") = std::vector<const bb::TeamRoster*>{},
+       py::arg("stop") = "sprt", py::arg("elo0") = 0.0, py::arg("elo1") = 35.0,
+       py::arg("alpha") = 0.05, py::arg("beta") = 0.05, py::arg("wilson_z") = 1.96,
+       py::arg("adjudicate") = false);  // end games once the winner is settled (W/D/L only)
+
+    // Interactive search: returns at once; poll() for the current preference,
+    // extend() while the user thinks, cancel() or wait() to take the move
+    py::class_<PyMacroSearch>(m, "MacroSearch")
+        .def("poll", [](const PyMacroSearch& s) { return searchProgressToDict(s.handle->poll()); })
+        .def("extend", [](PyMacroSearch& s, int ms, int iterations) { s.handle->extend(ms, iterations); },
+             py::arg("ms") = 0, py::arg("iterations") = 0)
+        .def("cancel", [](PyMacroSearch& s) { s.handle->cancel(); })
+        .def("wait", [](PyMacroSearch& s) {
+            {
+                py::gil_scoped_release release;
+                s.handle->wait();
             }
-        };
+            return searchProgressToDict(s.handle->poll());
+        })
+        .def_property_readonly("done", [](const PyMacroSearch& s) { return s.handle->done(); })
+        // The finished search's tree (bb/search_tree_file.h) as a structured
+        // array, breadth-first from the root; with `path`, also written there
+        // for blood_bowl.search_tree.SearchTree
+        .def("export_tree", [](PyMacroSearch& s, int minVisits, const std::string& path) {
+            if (!s.handle->done()) throw std::runtime_error("export_tree: the search is still running");
+            bb::SearchTree tree = s.search->exportTree(minVisits);
+            if (!path.empty() && !bb::writeSearchTree(path, tree)) {
+                throw std::runtime_error("cannot write " + path);
+            }
+            py::array_t<bb::SearchTreeRecord> out(static_cast<py::ssize_t>(tree.nodes.size()));
+            std::copy(tree.nodes.begin(), tree.nodes.end(), out.mutable_data());
+            return out;
+        }, py::arg("min_visits") = 1, py::arg("path") = "");
 
-        return bb::simulateGame(home, away,
-            makePolicy(homeAI, homeMcts, homeMacroMcts),
-            makePolicy(awayAI, awayMcts, awayMacroMcts), dice);
-    }, py::arg("home"), py::arg("away"),
-       py::arg("home_ai") = "random", py::arg("away_ai") = "random",
-       py::arg("seed") = 42,
-       py::arg("weights_path") = "",
-       py::arg("epsilon") = 0.3f,
-       py::arg("mcts_iterations") = 0,
-       py::arg("policy_blend") = 0.0f,
-       py::arg("vf_blend") = 0.0f);
+    m.def("search_async", [](const bb::GameState& state, const py::object& weights, int iterations,
+                             int timeMs, double explorationC, float vfBlend, float policyBlend,
+                             uint32_t seed) {
+        auto s = std::make_unique<PyMacroSearch>();
+        s->model = resolveModel(weights);
+        if (hasWeights(weights) && !s->model) {
+            throw std::runtime_error("cannot load model from " + py::str(weights).cast<std::string>());
+        }
+        bb::MCTSConfig cfg;
+        cfg.explorationC = explorationC;
+        cfg.vfBlend = vfBlend;
+        cfg.policyBlend = policyBlend;
+        if (s->model) cfg.policy = s->model->policy.get();
+        s->search = std::make_unique<bb::MacroMCTSSearch>(s->model ? s->model->value.get() : nullptr, cfg, seed);
+        s->handle = s->search->searchAsync(state, timeMs, iterations);
+        return s;
+    }, py::arg("state"), py::arg("weights") = py::none(), py::arg("iterations") = 100000,
+       py::arg("time_ms") = 0, py::arg("exploration_c") = 1.41, py::arg("vf_blend") = 0.0f,
+       py::arg("policy_blend") = 0.0f, py::arg("seed") = 0);
 
     // simulate_game_logged: returns result + features at turn boundaries + policy decisions
     m.def("simulate_game_logged", [](const bb::TeamRoster& home, const bb::TeamRoster& away,
                                       const std::string& homeAI, const std::string& awayAI,
                                       uint32_t seed,
-                                      const std::string& weightsPath,
+                                      const py::object& weights,
                                       float epsilon,
                                       int mctsIterations,
-                                      const std::string& policyWeightsPath,
+                                      const py::object& policyWeights,
                                       float policyBlend,
                                       float vfBlend,
-                                      const std::string& awayWeightsPath,
+                                      const py::object& awayWeights,
                                       float dirichletAlpha,
                                       float explorationC,
                                       int nRollouts,
-                                      bool leafLookahead) {
+                                      bool leafLookahead,
+                                      int gumbelTopK,
+                                      bool recordOnly,
+                                      bool logBoards,
+                                      float fullSearchFraction) {
         bb::DiceRoller dice(seed);
 
+        auto usesValue = [](const std::string& ai) {
+            return ai == "learning" || ai == "mcts" || ai == "macro_mcts";
+        };
+
         // Home VF (training weights)
-        std::unique_ptr<bb::ValueFunction> vf;
-        if ((homeAI == "learning" || homeAI == "mcts" || homeAI == "macro_mcts") && !weightsPath.empty()) {
-            vf = bb::loadValueFunction(weightsPath);
+        std::shared_ptr<const bb::ValueFunction> vf;
+        if (usesValue(homeAI)) {
+            if (auto model = resolveModel(weights)) vf = model->value;
         }
 
         // Away VF: frozen weights if provided, otherwise same as home
-        std::unique_ptr<bb::ValueFunction> awayVf;
-        const std::string& awayWPath = awayWeightsPath.empty() ? weightsPath : awayWeightsPath;
-        if ((awayAI == "learning" || awayAI == "mcts" || awayAI == "macro_mcts") && !awayWPath.empty()) {
-            awayVf = bb::loadValueFunction(awayWPath);
+        std::shared_ptr<const bb::ValueFunction> awayVf;
+        if (usesValue(awayAI)) {
+            if (auto model = resolveModel(hasWeights(awayWeights) ? awayWeights : weights)) {
+                awayVf = model->value;
+            }
         }
 
         // Load policy network if provided
-        std::unique_ptr<bb::PolicyNetwork> policyNet;
-        if (!policyWeightsPath.empty()) {
-            policyNet = bb::loadPolicyNetworkFromFile(policyWeightsPath);
-        }
+        std::shared_ptr<const bb::PolicyNetwork> policyNet;
+        if (auto model = resolveModel(policyWeights)) policyNet = model->policy;
 
         std::shared_ptr<bb::MCTSPolicy> homeMcts, awayMcts;
         std::shared_ptr<bb::MacroMCTSPolicy> homeMacroMcts, awayMacroMcts;
 
         auto makePolicy = [&](const std::string& ai,
-                              bb::ValueFunction* vfPtr,
+                              const bb::ValueFunction* vfPtr,
                               std::shared_ptr<bb::MCTSPolicy>& mctsOut,
                               std::shared_ptr<bb::MacroMCTSPolicy>& macroMctsOut) -> bb::ActionSelector {
             if (ai == "greedy") {
@@ -479,24 +1370,27 @@ PYBIND11_MODULE(bb_engine, m) {
                 cfg.vfBlend = vfBlend;
                 cfg.nRollouts = nRollouts;
                 cfg.leafLookahead = leafLookahead;
+                cfg.gumbelTopK = gumbelTopK;
+                cfg.fullSearchFraction = fullSearchFraction;
                 if (policyNet) {
                     cfg.policy = policyNet.get();
                     cfg.policyBlend = policyBlend;
                 }
                 macroMctsOut = std::make_shared<bb::MacroMCTSPolicy>(vfPtr, cfg, seed);
-                macroMctsOut->setLogDecisions(true, 20);
+                macroMctsOut->setLogDecisions(true, 20, logBoards);
                 return [m = macroMctsOut](const bb::GameState& s) { return (*m)(s); };
             } else if (ai == "mcts" && mctsIterations > 0) {
                 bb::MCTSConfig cfg;
                 cfg.maxIterations = mctsIterations;
                 cfg.timeBudgetMs = 0;
                 cfg.maxChildren = 40;
+                cfg.fullSearchFraction = fullSearchFraction;
                 if (policyNet) {
                     cfg.policy = policyNet.get();
                     cfg.explorationC = 2.5;
                 }
                 mctsOut = std::make_shared<bb::MCTSPolicy>(vfPtr, cfg, seed);
-                mctsOut->setLogDecisions(true, 20);
+                mctsOut->setLogDecisions(true, 20, logBoards);
                 return [mcts = mctsOut](const bb::GameState& s) { return (*mcts)(s); };
             } else if (ai == "learning" && vfPtr) {
                 return [&dice, vfPtr, epsilon](const bb::GameState& s) {
@@ -507,11 +1401,15 @@ PYBIND11_MODULE(bb_engine, m) {
             }
         };
 
-        auto logged = bb::simulateGameLogged(
-            home, away,
-            makePolicy(homeAI, vf.get(), homeMcts, homeMacroMcts),
-            makePolicy(awayAI, awayVf.get(), awayMcts, awayMacroMcts),
-            dice);
+        bb::ActionSelector homePolicy = makePolicy(homeAI, vf.get(), homeMcts, homeMacroMcts);
+        bb::ActionSelector awayPolicy = makePolicy(awayAI, awayVf.get(), awayMcts, awayMacroMcts);
+        bb::LoggedGameResult logged;
+        {
+            py::gil_scoped_release release;
+            logged = bb::simulateGameLogged(home, away, homePolicy, awayPolicy, dice, false,
+                                            recordOnly ? bb::GameLogMode::RECORD_ONLY
+                                                       : bb::GameLogMode::FULL);
+        }
 
         // Copy policy decisions from MCTS policies
         if (homeMcts) {
@@ -540,17 +1438,89 @@ PYBIND11_MODULE(bb_engine, m) {
     }, py::arg("home"), py::arg("away"),
        py::arg("home_ai") = "random", py::arg("away_ai") = "random",
        py::arg("seed") = 42,
-       py::arg("weights_path") = "",
+       py::arg("weights_path") = py::str(""),
        py::arg("epsilon") = 0.3f,
        py::arg("mcts_iterations") = 0,
-       py::arg("policy_weights_path") = "",
+       py::arg("policy_weights_path") = py::str(""),
        py::arg("policy_blend") = 0.0f,
        py::arg("vf_blend") = 0.0f,
-       py::arg("away_weights_path") = "",
+       py::arg("away_weights_path") = py::str(""),
        py::arg("dirichlet_alpha") = 0.3f,
        py::arg("exploration_c") = 0.5f,   // T2: 2.0 over-explored, flat target; 0.5 sharpens. eval path (simulate_game) uses its own 1.0
        py::arg("n_rollouts") = 1,
-       py::arg("leaf_lookahead") = false);  // 2026-07-02 experiment: bounded greedy 1-ply leaf look-ahead (macro_mcts only)
+       py::arg("leaf_lookahead") = false,  // 2026-07-02 experiment: bounded greedy 1-ply leaf look-ahead (macro_mcts only)
+       py::arg("gumbel_top_k") = 0,        // macro_mcts: Gumbel root, logged targets are its improved policy
+       py::arg("record_only") = false,     // keep only .record; replay_game() regenerates the logs
+       py::arg("log_boards") = true,       // per-decision board snapshots (get_policy_decisions)
+       py::arg("full_search_fraction") = 1.0f);  // playout-cap randomization: share of searches at full budget, logged (get_decision_searches)
+
+    // Self-play of len(seeds) games, concurrent_games at a time in this
+    // process, with every search's leaf evaluations pooled into shared
+    // batches of the value model. Returns (games, eval stats) with games
+    // shaped like simulate_game_logged's results, in seed order.
+    m.def("run_batched_self_play", [](const bb::TeamRoster& home, const bb::TeamRoster& away,
+                                       const py::object& weights,
+                                       const std::vector<uint32_t>& seeds,
+                                       int concurrentGames,
+                                       int mctsIterations,
+                                       int evalBatchSize,
+                                       float vfBlend,
+                                       const py::object& policyWeights,
+                                       float policyBlend,
+                                       float dirichletAlpha,
+                                       float explorationC,
+                                       int gumbelTopK,
+                                       int maxWaitUs,
+                                       bool recordOnly,
+                                       bool logBoards,
+                                       float fullSearchFraction) {
+        auto model = resolveModel(weights);
+        if (!model || !model->value) throw std::invalid_argument("run_batched_self_play needs a value model");
+        std::shared_ptr<bb::LoadedModel> policyModel = resolveModel(policyWeights);
+
+        bb::BatchedSelfPlayConfig cfg;
+        cfg.concurrentGames = concurrentGames;
+        cfg.search.maxIterations = mctsIterations;
+        cfg.search.timeBudgetMs = 0;
+        cfg.search.explorationC = explorationC;
+        cfg.search.dirichletAlpha = dirichletAlpha;
+        cfg.search.dirichletWeight = 0.25f;
+        cfg.search.vfBlend = vfBlend;
+        cfg.search.evalBatchSize = evalBatchSize;
+        cfg.search.gumbelTopK = gumbelTopK;
+        cfg.search.fullSearchFraction = fullSearchFraction;
+        if (policyModel && policyModel->policy) {
+            cfg.search.policy = policyModel->policy.get();
+            cfg.search.policyBlend = policyBlend;
+        }
+        cfg.maxWaitUs = maxWaitUs;
+        cfg.logBoards = logBoards;
+        cfg.logMode = recordOnly ? bb::GameLogMode::RECORD_ONLY : bb::GameLogMode::FULL;
+
+        bb::BatchedSelfPlayResult result;
+        {
+            py::gil_scoped_release release;
+            result = bb::runBatchedSelfPlay(home, away, *model->value, cfg, seeds);
+        }
+        py::dict stats;
+        stats["batches"] = result.eval.batches;
+        stats["requests"] = result.eval.requests;
+        stats["rows"] = result.eval.rows;
+        return py::make_tuple(std::move(result.games), stats);
+    }, py::arg("home"), py::arg("away"), py::arg("weights_path"), py::arg("seeds"),
+       py::arg("concurrent_games") = 8,
+       py::arg("mcts_iterations") = 200,
+       py::arg("eval_batch_size") = 8,
+       py::arg("vf_blend") = 1.0f,
+       py::arg("policy_weights_path") = py::str(""),
+       py::arg("policy_blend") = 0.0f,
+       py::arg("dirichlet_alpha") = 0.3f,
+       py::arg("exploration_c") = 0.5f,
+       py::arg("gumbel_top_k") = 0,
+       py::arg("max_wait_us") = 2000,
+       py::arg("record_only") = false,
+       py::arg("log_boards") = true,
+       py::arg("full_search_fraction") = 1.0f);
 
     // --- Roster getters ---
     m.def("get_roster", [](const std::string& name) -> const bb::TeamRoster* {
@@ -563,11 +1533,62 @@ PYBIND11_MODULE(bb_engine, m) {
         return bb::getDevelopedRoster(name, tv);
     }, py::arg("name"), py::arg("tv") = 1000, py::return_value_policy::reference);
 
+    // Stable small ids of the built-in rosters, for logs and files
+    m.def("roster_by_id", [](int id) -> const bb::TeamRoster* {
+        return id >= 0 && id < bb::rosterCount() ? bb::rosterById(static_cast<bb::RosterId>(id)) : nullptr;
+    }, py::arg("id"), py::return_value_policy::reference);
+    m.def("roster_key", [](int id) -> std::string {
+        return id >= 0 && id < bb::rosterCount() ? bb::rosterKey(static_cast<bb::RosterId>(id)) : "";
+    }, py::arg("id"));
+    m.def("roster_count", &bb::rosterCount);
+    m.attr("ROSTER_REGISTRY_VERSION") = bb::ROSTER_REGISTRY_VERSION;
+
     m.def("get_human_roster", &bb::getHumanRoster, py::return_value_policy::reference);
     m.def("get_orc_roster", &bb::getOrcRoster, py::return_value_policy::reference);
     m.def("get_skaven_roster", &bb::getSkavenRoster, py::return_value_policy::reference);
     m.def("get_dwarf_roster", &bb::getDwarfRoster, py::return_value_policy::reference);
 
+    // Hot-path profile (empty unless the engine was built with BB_PROFILE=ON)
+    m.def("profile_enabled", &bb::profileEnabled);
+    m.def("profile_snapshot", []() {
+        py::list out;
+        for (const auto& e : bb::profileSnapshot()) {
+            py::dict d;
+            d["name"] = e.name;
+            d["calls"] = e.calls;
+            d["ticks"] = e.ticks;
+            d["units"] = e.units;
+            d["seconds"] = e.seconds;
+            out.append(d);
+        }
+        return out;
+    });
+    m.def("profile_reset", &bb::profileReset);
+    m.def("profile_report", &bb::profileReport);
+
+    // Heap allocation counters (zeros unless built with BB_ALLOC_TRACKING=ON)
+    m.def("alloc_tracking_enabled", &bb::allocTrackingEnabled);
+    m.def("alloc_snapshot", []() {
+        bb::AllocCounters c = bb::processAllocCounters();
+        py::dict out;
+        out["allocations"] = c.allocations;
+        out["frees"] = c.frees;
+        out["bytes"] = c.bytes;
+        out["live_bytes"] = bb::allocLiveBytes();
+        out["peak_bytes"] = bb::allocPeakBytes();
+        py::dict tags;
+        for (int t = 0; t < bb::alloc::NUM_TAGS; ++t) {
+            py::dict d;
+            d["allocations"] = c.tagAllocations[t];
+            d["bytes"] = c.tagBytes[t];
+            tags[bb::allocTagName(static_cast<bb::alloc::Tag>(t))] = d;
+        }
+        out["tags"] = tags;
+        return out;
+    });
+    m.def("alloc_reset_peak", &bb::allocResetPeak);
+    m.def("alloc_report", &bb::allocReport);
+
     m.attr("NUM_FEATURES") = bb::NUM_FEATURES;
     m.attr("NUM_ACTION_FEATURES") = bb::NUM_ACTION_FEATURES;
 }
@@ -72,6 +72,7 @@ def test_available_actions():
     # Should always have END_TURN
     has_end_turn = any(a.type == bb_engine.ActionType.END_TURN for a in actions)
     assert has_end_turn
+    assert all(bb_engine.is_action_legal(gs, a) for a in actions)
 
 
 def test_execute_action():
@@ -165,6 +166,11 @@ def test_simulate_game_logged():
         assert s['features'].dtype == np.float32
         assert s['perspective'] in ('home', 'away')
 
+    # Random AIs search nothing
+    searches = result.get_decision_searches()
+    assert len(searches) == result.record.num_actions
+    assert set(searches) == {'none'}
+
 
 def test_simulate_game_learning_ai():
     """Test learning AI with a dummy weights file."""
@@ -295,3 +301,206 @@ if __name__ == "__main__":
     print(f"\n{passed} passed, {failed} failed out of {len(tests)} tests")
     if failed > 0:
         exit(1)
+
+
+def test_batched_inference(tmp_path):
+    """evaluate_values / compute_priors_batch score whole arrays natively."""
+    import json
+    n = bb_engine.NUM_FEATURES
+    na = bb_engine.NUM_ACTION_FEATURES
+    weights = [0.0] * n
+    weights[0] = 0.5
+    vf_path = tmp_path / "vf.json"
+    vf_path.write_text(json.dumps(weights))
+
+    features = np.zeros((3, n), dtype=np.float32)
+    features[:, 0] = [1.0, -2.0, 0.0]
+    values = bb_engine.evaluate_values(str(vf_path), features)
+    assert values.shape == (3,)
+    np.testing.assert_allclose(values, [0.5, -1.0, 0.0], atol=1e-6)
+
+    policy_path = tmp_path / "policy.json"
+    policy_path.write_text(json.dumps({"policy_weights": [0.0] * (n + na), "policy_bias": 0.0}))
+    states = np.zeros((2, n), dtype=np.float32)
+    actions = np.zeros((5, na), dtype=np.float32)
+    priors = bb_engine.compute_priors_batch(str(policy_path), states, actions,
+                                            np.array([3, 2], dtype=np.int32))
+    np.testing.assert_allclose(priors, [1 / 3] * 3 + [0.5] * 2, atol=1e-6)
+
+
+def test_model_cache(tmp_path):
+    """load_model returns a resident handle; paths are cached by mtime."""
+    import json
+    n = bb_engine.NUM_FEATURES
+    vf_path = tmp_path / "vf.json"
+    vf_path.write_text(json.dumps([0.0] * n))
+
+    bb_engine.clear_model_cache()
+    model = bb_engine.load_model(str(vf_path))
+    assert model.has_value and not model.has_policy
+    assert bb_engine.model_cache_size() == 1
+
+    features = np.zeros((1, n), dtype=np.float32)
+    np.testing.assert_allclose(bb_engine.evaluate_values(model, features), [0.0])
+    bb_engine.evaluate_values(str(vf_path), features)
+    assert bb_engine.model_cache_size() == 1
+
+    result = bb_engine.simulate_game(bb_engine.get_human_roster(), bb_engine.get_human_roster(),
+                                     home_ai="learning", away_ai="random", seed=3,
+                                     weights_path=model, epsilon=1.0)
+    assert result is not None
+
+
+def test_model_handle_swaps_on_change(tmp_path):
+    """A ModelHandle picks up a rewritten file and bumps its version."""
+    import json
+    import os
+    n = bb_engine.NUM_FEATURES
+    vf_path = tmp_path / "vf.json"
+    vf_path.write_text(json.dumps([0.0] * n))
+    handle = bb_engine.ModelHandle(str(vf_path))
+    first = handle.current()
+    assert handle.version == 0 and not handle.refresh()
+
+    vf_path.write_text(json.dumps([0.5] + [0.0] * (n - 1)))
+    st = os.stat(vf_path)
+    os.utime(vf_path, ns=(st.st_atime_ns, st.st_mtime_ns + 1_000_000_000))
+    assert handle.refresh()
+    assert handle.version == 1
+    assert first.has_value  # the old model stays usable
+    features = np.zeros((1, n), dtype=np.float32)
+    features[0, 0] = 1.0
+    np.testing.assert_allclose(bb_engine.evaluate_values(handle, features), [0.5], atol=1e-6)
+
+
+def test_state_as_arrays():
+    """as_arrays copies every player and the board into numpy records in one call."""
+    gs = bb_engine.GameState()
+    bb_engine.setup_half(gs, bb_engine.get_human_roster(), bb_engine.get_orc_roster())
+    arrays = gs.as_arrays()
+    players, board = arrays["players"], arrays["board"]
+    assert players.shape == (22,) and board.shape == (15, 26)
+    for pid in (1, 5, 12, 22):
+        p = gs.get_player(pid)
+        row = players[pid - 1]
+        assert row["id"] == pid
+        assert row["strength"] == p.stats.strength
+        if p.is_on_pitch():
+            assert board[p.position.y, p.position.x] == pid
+    assert (board > 0).sum() == sum(gs.get_player(i).is_on_pitch() for i in range(1, 23))
+    assert int(arrays["state"]["half"]) == gs.half
+
+    batch = bb_engine.states_as_arrays([gs, gs.clone()], threads=2)
+    assert batch["players"].shape == (2, 22) and batch["board"].shape == (2, 15, 26)
+    assert batch["state"].shape == (2,)
+    assert (batch["players"][1] == players).all()
+
+
+def test_roster_registry_ids():
+    """Built-in rosters have stable small ids that round-trip."""
+    assert bb_engine.roster_count() == 31
+    for i in range(bb_engine.roster_count()):
+        roster = bb_engine.roster_by_id(i)
+        assert roster.roster_id == i
+        assert bb_engine.get_roster(bb_engine.roster_key(i)).roster_id == i
+    assert bb_engine.get_roster("wood-elf").roster_id == 4
+    assert bb_engine.roster_by_id(bb_engine.roster_count()) is None
+
+
+def test_search_export_tree(tmp_path):
+    """A finished search exports its tree, pruned, and writes it to a file."""
+    human = bb_engine.get_human_roster()
+    gs = bb_engine.GameState()
+    bb_engine.setup_half(gs, human, human)
+    bb_engine.simple_kickoff(gs, bb_engine.DiceRoller(5))
+    search = bb_engine.search_async(gs, iterations=200, seed=3)
+    search.wait()
+    path = tmp_path / "tree.bbt"
+    nodes = search.export_tree(min_visits=2, path=str(path))
+    assert nodes["parent"][0] == -1 and (nodes["visits"][1:] >= 2).all()
+    assert path.stat().st_size == 24 + nodes.itemsize * len(nodes)
+    assert nodes["num_children"][0] == (nodes["parent"] == 0).sum()
+
+
+def test_simulate_games_matches_single_games():
+    """simulate_games runs on native threads; each game depends only on its seed."""
+    human = bb_engine.get_human_roster()
+    cfg = bb_engine.GameConfig(home_ai="greedy", away_ai="random")
+    seeds = [1, 2, 3, 4]
+    batch = bb_engine.simulate_games(human, human, [cfg], seeds, threads=4)
+    assert len(batch.games) == len(seeds)
+    assert batch.home_wins + batch.away_wins + batch.draws == len(seeds)
+    for seed, game in zip(seeds, batch.games):
+        single = bb_engine.simulate_game(human, human, "greedy", "random", seed=seed)
+        assert (game.home_score, game.away_score, game.total_actions) == \
+            (single.home_score, single.away_score, single.total_actions)
+
+
+def test_simulate_from_state():
+    """Continuations of a kicked-off drive: per-side TD rates and a score histogram."""
+    human = bb_engine.get_human_roster()
+    gs = bb_engine.GameState()
+    bb_engine.setup_half(gs, human, human)
+    bb_engine.simple_kickoff(gs, bb_engine.DiceRoller(5))
+    cfg = bb_engine.GameConfig(home_ai="greedy", away_ai="greedy")
+    out = bb_engine.simulate_from_state(gs, human, human, cfg, n_games=16, threads=2, until="drive")
+    assert len(out["games"]) == 16
+    assert sum(out["score_diff"].values()) == 16
+    assert 0.0 <= out["home_td_probability"] + out["away_td_probability"] <= 1.0
+    again = bb_engine.simulate_from_state(gs, human, human, cfg, n_games=16, threads=1, until="drive")
+    assert again["score_diff"] == out["score_diff"]
+
+
+def test_shard_trainer(tmp_path):
+    """ShardTrainer fits shards natively and saves weights the engine loads."""
+    human = bb_engine.get_human_roster()
+    writer = bb_engine.ShardWriter(str(tmp_path / "shards"))
+    for seed in range(4):
+        logged = bb_engine.simulate_game_logged(human, human, "random", "random", seed=seed)
+        writer.append_game(logged, 1.0, -1.0)
+    writer.close()
+    trainer = bb_engine.ShardTrainer(str(tmp_path / "shards"), model="neural_value",
+                                     hidden_size=8, learning_rate=0.01, threads=2)
+    before = trainer.loss()
+    for _ in range(5):
+        trainer.train_epoch()
+    assert trainer.epochs == 5 and trainer.loss() < before
+    assert trainer.save_weights(str(tmp_path / "vf.json"))
+    features = np.zeros((1, bb_engine.NUM_FEATURES), dtype=np.float32)
+    assert bb_engine.evaluate_values(str(tmp_path / "vf.json"), features).shape == (1,)
+
+
+def test_featurize_boards():
+    """Logged turn boards re-encoded natively by a registered feature set."""
+    human = bb_engine.get_human_roster()
+    cols = bb_engine.simulate_game_logged(human, human, "random", "random", seed=4).to_columns()
+    n = len(cols["turn_board_offsets"]) - 1
+    contexts = np.zeros((n, bb_engine.SNAPSHOT_CONTEXT_COLS), dtype=np.int16)
+    contexts[:, 0] = cols["turns"][:, 0]  # half
+    contexts[:, 1] = cols["turns"][:, 1]  # home turn (approximate)
+    contexts[:, 3] = cols["turns"][:, 2]  # active team
+    contexts[:, 6:8] = 3
+    assert "features" in bb_engine.feature_set_names()
+    out = bb_engine.featurize_boards("features", cols["turn_board_players"], cols["turn_board_offsets"],
+                                     cols["turn_ball"], contexts, cols["turns"][:, 2].astype(np.uint8),
+                                     human, human, threads=2)
+    assert out.shape == (n, bb_engine.feature_set_size("features"))
+
+
+def test_logged_game_columns():
+    """to_columns returns numpy arrays matching the per-object getters."""
+    human = bb_engine.get_human_roster()
+    logged = bb_engine.simulate_game_logged(human, human, "random", "random", seed=9)
+    cols = logged.to_columns()
+    states = logged.get_states()
+    assert cols["state_features"].shape == (len(states), bb_engine.NUM_FEATURES)
+    np.testing.assert_array_equal(cols["state_features"][-1], states[-1]["features"])
+    assert cols["state_perspective"][-1] == (0 if states[-1]["perspective"] == "home" else 1)
+
+    turns = logged.get_turn_logs()
+    assert cols["turns"].shape == (len(turns), 7)
+    assert len(cols["event_offsets"]) == len(turns) + 1
+    assert cols["events"].shape[0] == cols["event_offsets"][-1]
+    # random AIs log no policy decisions
+    assert list(cols["visit_offsets"]) == [0]
+    assert cols["decision_features"].shape == (0, bb_engine.NUM_FEATURES)
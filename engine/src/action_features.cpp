@@ -2,18 +2,33 @@
 #include "bb/helpers.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 
 namespace bb {
 
-void extractActionFeatures(const GameState& state, const Action& action, float* out) {
+namespace {
+
+// What the features read about the acting player, shared by all of its
+// actions in a batch. Block assists are worked out per defender on first use.
+struct ActingPlayer {
+    int id = 0;  // 0 = none yet
+    uint32_t assistsKnown = 0;  // bit per defender id
+    int8_t attAssists[23] = {};
+    int8_t defAssists[23] = {};
+};
+
+void extractActionFeatures(const GameState& state, const Action& action, ActingPlayer& acting, float* out) {
     // Zero all features
     for (int i = 0; i < NUM_ACTION_FEATURES; ++i) out[i] = 0.0f;
 
+    // MOVE_PATH is a run of MOVEs to the same target
+    const bool isMove = action.type == ActionType::MOVE || action.type == ActionType::MOVE_PATH;
+
     // [0] is_end_turn
     out[0] = (action.type == ActionType::END_TURN) ? 1.0f : 0.0f;
 
     // [1] is_move
-    out[1] = (action.type == ActionType::MOVE) ? 1.0f : 0.0f;
+    out[1] = isMove ? 1.0f : 0.0f;
 
     // [2] is_block
     out[2] = (action.type == ActionType::BLOCK) ? 1.0f : 0.0f;
@@ -34,18 +49,22 @@ void extractActionFeatures(const GameState& state, const Action& action, float*
     // For actions with a player, extract player-based features
     if (action.playerId > 0 && action.playerId <= 22) {
         const Player& player = state.getPlayer(action.playerId);
+        if (acting.id != action.playerId) {
+            acting.id = action.playerId;
+            acting.assistsKnown = 0;
+        }
 
         // [6] player_strength / 7
-        out[6] = player.stats.strength / 7.0f;
+        out[6] = player.stats().strength / 7.0f;
 
         // [7] player_agility / 7
-        out[7] = player.stats.agility / 7.0f;
+        out[7] = player.stats().agility / 7.0f;
 
         // [8] is_ball_carrier
         out[8] = (state.ball.isHeld && state.ball.carrierId == action.playerId) ? 1.0f : 0.0f;
 
         // [9] is_scoring_move (carrier moves to endzone)
-        if (out[8] > 0.5f && action.type == ActionType::MOVE) {
+        if (out[8] > 0.5f && isMove) {
             int endzoneX = (player.teamSide == TeamSide::HOME) ? 25 : 0;
             if (action.target.x == endzoneX) {
                 out[9] = 1.0f;
@@ -57,7 +76,7 @@ void extractActionFeatures(const GameState& state, const Action& action, float*
             int endzoneX = (player.teamSide == TeamSide::HOME) ? 25 : 0;
             int dist = std::abs(player.position.x - endzoneX);
             // For move actions, use target position instead
-            if (action.type == ActionType::MOVE && action.target.isOnPitch()) {
+            if (isMove && action.target.isOnPitch()) {
                 dist = std::abs(action.target.x - endzoneX);
             }
             out[10] = dist / 26.0f;
@@ -68,8 +87,8 @@ void extractActionFeatures(const GameState& state, const Action& action, float*
             action.targetId > 0 && action.targetId <= 22) {
             const Player& defender = state.getPlayer(action.targetId);
             if (defender.isOnPitch() && player.isOnPitch()) {
-                int attST = player.stats.strength;
-                int defST = defender.stats.strength;
+                int attST = player.stats().strength;
+                int defST = defender.stats().strength;
 
                 // Horns bonus for blitz
                 if (action.type == ActionType::BLITZ && player.hasSkill(SkillName::Horns)) {
@@ -77,13 +96,17 @@ void extractActionFeatures(const GameState& state, const Action& action, float*
                 }
 
                 // Count assists
-                int attAssists = countAssists(state, defender.position, player.teamSide,
-                                              player.id, defender.id, defender.id);
-                int defAssists = countAssists(state, player.position, defender.teamSide,
-                                              defender.id, player.id, player.id);
+                const uint32_t bit = uint32_t{1} << defender.id;
+                if (!(acting.assistsKnown & bit)) {
+                    acting.attAssists[defender.id] = static_cast<int8_t>(
+                        countAssists(state, defender.position, player.teamSide, player.id, defender.id, defender.id));
+                    acting.defAssists[defender.id] = static_cast<int8_t>(
+                        countAssists(state, player.position, defender.teamSide, defender.id, player.id, player.id));
+                    acting.assistsKnown |= bit;
+                }
 
-                int effectiveAttST = attST + attAssists;
-                int effectiveDefST = defST + defAssists;
+                int effectiveAttST = attST + acting.attAssists[defender.id];
+                int effectiveDefST = defST + acting.defAssists[defender.id];
 
                 BlockDiceInfo info = getBlockDiceInfo(effectiveAttST, effectiveDefST);
                 float dice = static_cast<float>(info.count);
@@ -93,7 +116,7 @@ void extractActionFeatures(const GameState& state, const Action& action, float*
         }
 
         // [12] moves_ball_forward (toward endzone)
-        if (action.type == ActionType::MOVE && player.isOnPitch() && action.target.isOnPitch()) {
+        if (isMove && player.isOnPitch() && action.target.isOnPitch()) {
             int endzoneX = (player.teamSide == TeamSide::HOME) ? 25 : 0;
             int currentDist = std::abs(player.position.x - endzoneX);
             int targetDist = std::abs(action.target.x - endzoneX);
@@ -103,7 +126,7 @@ void extractActionFeatures(const GameState& state, const Action& action, float*
         }
 
         // [13] gfi_required / 3
-        if (action.type == ActionType::MOVE && player.isOnPitch() && action.target.isOnPitch()) {
+        if (isMove && player.isOnPitch() && action.target.isOnPitch()) {
             int moveDist = player.position.distanceTo(action.target);
             int remaining = player.movementRemaining;
             int gfi = std::max(0, moveDist - remaining);
@@ -162,4 +185,16 @@ void extractActionFeatures(const GameState& state, const Action& action, float*
     }
 }
 
+} // anonymous namespace
+
+void extractActionFeatures(const GameState& state, const Action& action, float* out) {
+    ActingPlayer acting;
+    extractActionFeatures(state, action, acting, out);
+}
+
+void extractActionFeatures(const GameState& state, const Action* actions, int n, float* out) {
+    ActingPlayer acting;
+    for (int i = 0; i < n; ++i) extractActionFeatures(state, actions[i], acting, out + i * NUM_ACTION_FEATURES);
+}
+
 } // namespace bb
@@ -1,4 +1,5 @@
 #include "bb/action_resolver.h"
+#include "bb/geometry.h"
 #include "bb/move_handler.h"
 #include "bb/block_handler.h"
 #include "bb/foul_handler.h"
@@ -11,27 +12,42 @@
 #include "bb/bomb_handler.h"
 #include "bb/gaze_handler.h"
 #include "bb/ball_and_chain_handler.h"
+#include "bb/matchup_features.h"
+#include "bb/profile.h"
 
 namespace bb {
 
+namespace {
+
+constexpr uint32_t BIG_GUY_SKILLS =
+    hotSkillBit(SkillName::BoneHead) | hotSkillBit(SkillName::ReallyStupid) |
+    hotSkillBit(SkillName::WildAnimal) | hotSkillBit(SkillName::TakeRoot) |
+    hotSkillBit(SkillName::Bloodlust);
+
+// BigGuy pre-action check: true if it wastes the action. Compiled out of
+// matchups without Big Guys.
+template <MatchupFeatures Features>
+bool bigGuyWastesAction(GameState& state, const Action& action,
+                        DiceRollerBase& dice, std::vector<GameEvent>* events) {
+    if constexpr ((Features & feature::BIG_GUY) == 0) {
+        return false;
+    } else {
+        if (!requiresPlayer(action.type) || action.playerId <= 0) return false;
+        if (!(state.getPlayer(action.playerId).hotSkills() & BIG_GUY_SKILLS)) return false;
+        BigGuyResult bgResult = resolveBigGuyCheck(state, action.playerId,
+                                                    action.type, dice, events);
+        return bgResult.actionBlocked && !bgResult.proceed;
+    }
+}
+
+} // anonymous namespace
+
 ActionResult resolveAction(GameState& state, const Action& action,
                            DiceRollerBase& dice, std::vector<GameEvent>* events) {
-    // BigGuy pre-action checks for player actions
-    if (requiresPlayer(action.type) && action.playerId > 0) {
-        Player& p = state.getPlayer(action.playerId);
-        bool hasBigGuySkill = p.hasSkill(SkillName::BoneHead) ||
-                              p.hasSkill(SkillName::ReallyStupid) ||
-                              p.hasSkill(SkillName::WildAnimal) ||
-                              p.hasSkill(SkillName::TakeRoot) ||
-                              p.hasSkill(SkillName::Bloodlust);
-        if (hasBigGuySkill) {
-            BigGuyResult bgResult = resolveBigGuyCheck(state, action.playerId,
-                                                        action.type, dice, events);
-            if (bgResult.actionBlocked && !bgResult.proceed) {
-                return ActionResult::ok();  // Action wasted, not turnover
-            }
-        }
-    }
+    bool wasted = withMatchupFeatures(matchupFeatures(state), [&](auto features) {
+        return bigGuyWastesAction<features.value>(state, action, dice, events);
+    });
+    if (wasted) return ActionResult::ok();  // Action wasted, not turnover
 
     switch (action.type) {
         case ActionType::MOVE: {
@@ -51,6 +67,29 @@ ActionResult resolveAction(GameState& state, const Action& action,
             return resolveMoveStep(state, action.playerId, action.target, dice, events);
         }
 
+        case ActionType::MOVE_PATH: {
+            Player& player = state.getPlayer(action.playerId);
+            if (player.state != PlayerState::STANDING) return ActionResult::fail();
+
+            // Route fixed up front from the current board; each step then
+            // resolves on its own (dodge, GFI, pickup), stopping at the first
+            // failure, at a touchdown, or when a step leaves the player in place
+            // (Tentacles).
+            Position path[MAX_PATH_LENGTH];
+            int steps = tracePath(state, getReachability(state, player), action.target, path);
+            if (steps == 0) return ActionResult::fail();
+
+            for (int i = 0; i < steps; ++i) {
+                Position beforeStep = player.position;
+                ActionResult stepResult = resolveMoveStep(state, action.playerId, path[i],
+                                                          dice, events);
+                if (stepResult.turnover || !stepResult.success) return stepResult;
+                if (player.state != PlayerState::STANDING) return ActionResult::turnovr();
+                if (player.position == beforeStep || checkTouchdown(state)) break;
+            }
+            return ActionResult::ok();
+        }
+
         case ActionType::BLOCK: {
             BlockParams params;
             params.attackerId = action.playerId;
@@ -86,9 +125,7 @@ ActionResult resolveAction(GameState& state, const Action& action,
                 // Find next step toward adjPos using simple greedy approach
                 Position bestNext{-1, -1};
                 int bestDist = 999;
-                auto adj = player.position.getAdjacent();
-                for (auto& pos : adj) {
-                    if (!pos.isOnPitch()) continue;
+                for (Position pos : onPitchNeighbours(player.position)) {
                     if (state.getPlayerAtPosition(pos) != nullptr) continue;
                     int d = pos.distanceTo(target.position);
                     if (d < bestDist) {
@@ -178,6 +215,7 @@ ActionResult resolveAction(GameState& state, const Action& action,
 
 ActionResult executeAction(GameState& state, const Action& action,
                            DiceRollerBase& dice, std::vector<GameEvent>* events) {
+    BB_PROFILE_SCOPE(prof::EXECUTE_ACTION + static_cast<int>(action.type));
     // Activation close-out at the actor-switch boundary: a successful MOVE never
     // sets hasActed (only failure paths do), so without this a player who moved
     // could be independently reactivated later in the same team-turn (free
@@ -207,8 +245,8 @@ ActionResult executeAction(GameState& state, const Action& action,
         TeamSide scoringSide = state.getPlayer(state.ball.carrierId).teamSide;
         state.getTeamState(scoringSide).score++;
         state.phase = GamePhase::TOUCHDOWN;
-        emitEvent(events, {GameEvent::Type::TOUCHDOWN, state.ball.carrierId, -1,
-                          state.ball.position, {}, 0, true});
+        BB_EMIT_EVENT(events, GameEvent::Type::TOUCHDOWN, state.ball.carrierId, -1,
+                              state.ball.position, {}, 0, true);
     }
 
     // Check half over
@@ -0,0 +1,273 @@
+#include "bb/alloc_tracking.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#ifdef BB_ALLOC_TRACKING
+#if !defined(__GLIBC__)
+#error "BB_ALLOC_TRACKING needs glibc's malloc_usable_size"
+#endif
+#include <malloc.h>
+#endif
+
+namespace bb {
+
+namespace {
+
+const char* const TAG_NAMES[alloc::NUM_TAGS] = {
+    "other", "searchTree", "moveGen", "macroExpansion", "logging", "bindings",
+};
+
+#ifdef BB_ALLOC_TRACKING
+
+// One thread's counters. Only the owning thread writes; snapshots read them
+// concurrently, hence relaxed atomics rather than plain integers. Nothing
+// here may allocate through operator new.
+struct Slot {
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> frees;
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> tagAllocations[alloc::NUM_TAGS];
+    std::atomic<uint64_t> tagBytes[alloc::NUM_TAGS];
+};
+
+constexpr int MAX_SLOTS = 512;
+
+// Zero-initialized static storage, usable before any constructor has run
+Slot slots[MAX_SLOTS];
+std::atomic<bool> slotTaken[MAX_SLOTS];
+Slot shared;   // threads beyond MAX_SLOTS, updated with atomic adds
+Slot retired;  // totals of threads that have exited (under retireMutex)
+std::mutex retireMutex;
+std::atomic<int64_t> liveBytes{0};
+std::atomic<int64_t> peakBytes{0};
+
+thread_local uint8_t currentTag = alloc::OTHER;
+
+void bump(std::atomic<uint64_t>& c, uint64_t n, bool owned) {
+    if (owned) c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    else c.fetch_add(n, std::memory_order_relaxed);
+}
+
+void addSlot(AllocCounters& out, const Slot& s) {
+    out.allocations += s.allocations.load(std::memory_order_relaxed);
+    out.frees += s.frees.load(std::memory_order_relaxed);
+    out.bytes += s.bytes.load(std::memory_order_relaxed);
+    for (int t = 0; t < alloc::NUM_TAGS; ++t) {
+        out.tagAllocations[t] += s.tagAllocations[t].load(std::memory_order_relaxed);
+        out.tagBytes[t] += s.tagBytes[t].load(std::memory_order_relaxed);
+    }
+}
+
+void moveSlot(Slot& from, Slot& to) {
+    auto move = [](std::atomic<uint64_t>& a, std::atomic<uint64_t>& b) {
+        b.fetch_add(a.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    };
+    move(from.allocations, to.allocations);
+    move(from.frees, to.frees);
+    move(from.bytes, to.bytes);
+    for (int t = 0; t < alloc::NUM_TAGS; ++t) {
+        move(from.tagAllocations[t], to.tagAllocations[t]);
+        move(from.tagBytes[t], to.tagBytes[t]);
+    }
+}
+
+// Claims a slot on the thread's first allocation and folds it into
+// `retired` when the thread exits, so the slot can be reused.
+struct SlotHandle {
+    int index = -1;
+    bool claimed = false;
+
+    Slot& get() {
+        if (!claimed) {
+            claimed = true;
+            for (int i = 0; i < MAX_SLOTS; ++i) {
+                bool expected = false;
+                if (!slotTaken[i].load(std::memory_order_relaxed) &&
+                    slotTaken[i].compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    index = i;
+                    break;
+                }
+            }
+        }
+        return index >= 0 ? slots[index] : shared;
+    }
+    ~SlotHandle() {
+        if (index < 0) return;
+        {
+            std::lock_guard<std::mutex> lock(retireMutex);
+            moveSlot(slots[index], retired);
+        }
+        slotTaken[index].store(false, std::memory_order_release);
+        index = -1;
+    }
+};
+
+thread_local SlotHandle handle;
+
+void recordAlloc(void* p) {
+    if (!p) return;
+    uint64_t size = malloc_usable_size(p);
+    Slot& s = handle.get();
+    bool owned = &s != &shared;
+    bump(s.allocations, 1, owned);
+    bump(s.bytes, size, owned);
+    bump(s.tagAllocations[currentTag], 1, owned);
+    bump(s.tagBytes[currentTag], size, owned);
+    int64_t live = liveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) +
+                   static_cast<int64_t>(size);
+    int64_t peak = peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+void recordFree(void* p) {
+    if (!p) return;
+    liveBytes.fetch_sub(static_cast<int64_t>(malloc_usable_size(p)), std::memory_order_relaxed);
+    Slot& s = handle.get();
+    bump(s.frees, 1, &s != &shared);
+}
+
+void* trackedAlloc(std::size_t size, std::size_t align, bool nothrow) {
+    if (size == 0) size = 1;
+    for (;;) {
+        void* p = align > alignof(std::max_align_t)
+                      ? std::aligned_alloc(align, (size + align - 1) / align * align)
+                      : std::malloc(size);
+        if (p) {
+            recordAlloc(p);
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            if (nothrow) return nullptr;
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void trackedFree(void* p) {
+    recordFree(p);
+    std::free(p);
+}
+
+#endif // BB_ALLOC_TRACKING
+
+} // anonymous namespace
+
+AllocCounters AllocCounters::since(const AllocCounters& earlier) const {
+    AllocCounters d;
+    d.allocations = allocations - earlier.allocations;
+    d.frees = frees - earlier.frees;
+    d.bytes = bytes - earlier.bytes;
+    for (int t = 0; t < alloc::NUM_TAGS; ++t) {
+        d.tagAllocations[t] = tagAllocations[t] - earlier.tagAllocations[t];
+        d.tagBytes[t] = tagBytes[t] - earlier.tagBytes[t];
+    }
+    return d;
+}
+
+const char* allocTagName(alloc::Tag tag) {
+    return tag < alloc::NUM_TAGS ? TAG_NAMES[tag] : "unknown";
+}
+
+#ifdef BB_ALLOC_TRACKING
+
+bool allocTrackingEnabled() { return true; }
+
+AllocCounters threadAllocCounters() {
+    AllocCounters out;
+    addSlot(out, handle.get());
+    return out;
+}
+
+AllocCounters processAllocCounters() {
+    AllocCounters out;
+    std::lock_guard<std::mutex> lock(retireMutex);
+    addSlot(out, retired);
+    addSlot(out, shared);
+    for (int i = 0; i < MAX_SLOTS; ++i) {
+        if (slotTaken[i].load(std::memory_order_acquire)) addSlot(out, slots[i]);
+    }
+    return out;
+}
+
+int64_t allocLiveBytes() { return liveBytes.load(std::memory_order_relaxed); }
+int64_t allocPeakBytes() { return peakBytes.load(std::memory_order_relaxed); }
+void allocResetPeak() { peakBytes.store(liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+
+AllocTagScope::AllocTagScope(alloc::Tag tag) : saved_(currentTag) { currentTag = tag; }
+AllocTagScope::~AllocTagScope() { currentTag = saved_; }
+
+#else
+
+bool allocTrackingEnabled() { return false; }
+AllocCounters threadAllocCounters() { return {}; }
+AllocCounters processAllocCounters() { return {}; }
+int64_t allocLiveBytes() { return 0; }
+int64_t allocPeakBytes() { return 0; }
+void allocResetPeak() {}
+
+#endif // BB_ALLOC_TRACKING
+
+std::string allocReport() {
+    if (!allocTrackingEnabled()) return "allocation tracking disabled (build with -DBB_ALLOC_TRACKING=ON)\n";
+
+    AllocCounters c = processAllocCounters();
+    std::string out;
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-20s %14s %14s %12s\n", "tag", "allocations", "bytes", "bytes/alloc");
+    out += line;
+    for (int t = 0; t < alloc::NUM_TAGS; ++t) {
+        if (c.tagAllocations[t] == 0) continue;
+        std::snprintf(line, sizeof(line), "%-20s %14llu %14llu %12.1f\n",
+                      allocTagName(static_cast<alloc::Tag>(t)),
+                      static_cast<unsigned long long>(c.tagAllocations[t]),
+                      static_cast<unsigned long long>(c.tagBytes[t]),
+                      static_cast<double>(c.tagBytes[t]) / static_cast<double>(c.tagAllocations[t]));
+        out += line;
+    }
+    std::snprintf(line, sizeof(line), "%-20s %14llu %14llu\nlive %.2f MB, peak %.2f MB\n", "total",
+                  static_cast<unsigned long long>(c.allocations), static_cast<unsigned long long>(c.bytes),
+                  static_cast<double>(allocLiveBytes()) / (1 << 20),
+                  static_cast<double>(allocPeakBytes()) / (1 << 20));
+    out += line;
+    return out;
+}
+
+} // namespace bb
+
+#ifdef BB_ALLOC_TRACKING
+
+// Global replacements; every form funnels into trackedAlloc/trackedFree.
+void* operator new(std::size_t n) { return bb::trackedAlloc(n, 0, false); }
+void* operator new[](std::size_t n) { return bb::trackedAlloc(n, 0, false); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept { return bb::trackedAlloc(n, 0, true); }
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { return bb::trackedAlloc(n, 0, true); }
+void* operator new(std::size_t n, std::align_val_t a) { return bb::trackedAlloc(n, static_cast<std::size_t>(a), false); }
+void* operator new[](std::size_t n, std::align_val_t a) { return bb::trackedAlloc(n, static_cast<std::size_t>(a), false); }
+void* operator new(std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+    return bb::trackedAlloc(n, static_cast<std::size_t>(a), true);
+}
+void* operator new[](std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+    return bb::trackedAlloc(n, static_cast<std::size_t>(a), true);
+}
+
+void operator delete(void* p) noexcept { bb::trackedFree(p); }
+void operator delete[](void* p) noexcept { bb::trackedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { bb::trackedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { bb::trackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { bb::trackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { bb::trackedFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { bb::trackedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { bb::trackedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { bb::trackedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { bb::trackedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { bb::trackedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { bb::trackedFree(p); }
+
+#endif // BB_ALLOC_TRACKING
@@ -19,14 +19,14 @@ bool resolveAutoBlock(GameState& state, int bcPlayerId, int targetId,
 
     BlockDiceFace face = dice.rollBlockDie();
 
-    emitEvent(events, {GameEvent::Type::BLOCK, bcPlayerId, targetId, bcp.position,
-                      target.position, static_cast<int>(face), true});
+    BB_EMIT_EVENT(events, GameEvent::Type::BLOCK, bcPlayerId, targetId, bcp.position,
+                          target.position, static_cast<int>(face), true);
 
     switch (face) {
         case BlockDiceFace::ATTACKER_DOWN: {
-            bcp.state = PlayerState::PRONE;
-            emitEvent(events, {GameEvent::Type::KNOCKED_DOWN, bcPlayerId, -1,
-                              bcp.position, {}, 0, false});
+            state.setPlayerState(bcp, PlayerState::PRONE);
+            BB_EMIT_EVENT(events, GameEvent::Type::KNOCKED_DOWN, bcPlayerId, -1,
+                                  bcp.position, {}, 0, false);
             InjuryContext ctx;
             resolveArmourAndInjury(state, bcPlayerId, dice, ctx, events);
             handleBallOnPlayerDown(state, bcPlayerId, dice, events);
@@ -39,17 +39,17 @@ bool resolveAutoBlock(GameState& state, int bcPlayerId, int targetId,
             bool defFalls = !target.hasSkill(SkillName::Block);
 
             if (bcFalls) {
-                bcp.state = PlayerState::PRONE;
-                emitEvent(events, {GameEvent::Type::KNOCKED_DOWN, bcPlayerId, -1,
-                                  bcp.position, {}, 0, false});
+                state.setPlayerState(bcp, PlayerState::PRONE);
+                BB_EMIT_EVENT(events, GameEvent::Type::KNOCKED_DOWN, bcPlayerId, -1,
+                                      bcp.position, {}, 0, false);
                 InjuryContext ctx;
                 resolveArmourAndInjury(state, bcPlayerId, dice, ctx, events);
                 handleBallOnPlayerDown(state, bcPlayerId, dice, events);
             }
             if (defFalls) {
-                target.state = PlayerState::PRONE;
-                emitEvent(events, {GameEvent::Type::KNOCKED_DOWN, targetId, -1,
-                                  target.position, {}, 0, false});
+                state.setPlayerState(target, PlayerState::PRONE);
+                BB_EMIT_EVENT(events, GameEvent::Type::KNOCKED_DOWN, targetId, -1,
+                                      target.position, {}, 0, false);
                 InjuryContext ctx;
                 resolveArmourAndInjury(state, targetId, dice, ctx, events);
                 handleBallOnPlayerDown(state, targetId, dice, events);
@@ -69,9 +69,9 @@ bool resolveAutoBlock(GameState& state, int bcPlayerId, int targetId,
                 return false;
             }
             // Knocked down
-            target.state = PlayerState::PRONE;
-            emitEvent(events, {GameEvent::Type::KNOCKED_DOWN, targetId, -1,
-                              target.position, {}, 0, false});
+            state.setPlayerState(target, PlayerState::PRONE);
+            BB_EMIT_EVENT(events, GameEvent::Type::KNOCKED_DOWN, targetId, -1,
+                                  target.position, {}, 0, false);
             InjuryContext ctx;
             resolveArmourAndInjury(state, targetId, dice, ctx, events);
             handleBallOnPlayerDown(state, targetId, dice, events);
@@ -79,9 +79,9 @@ bool resolveAutoBlock(GameState& state, int bcPlayerId, int targetId,
         }
 
         case BlockDiceFace::DEFENDER_DOWN: {
-            target.state = PlayerState::PRONE;
-            emitEvent(events, {GameEvent::Type::KNOCKED_DOWN, targetId, -1,
-                              target.position, {}, 0, false});
+            state.setPlayerState(target, PlayerState::PRONE);
+            BB_EMIT_EVENT(events, GameEvent::Type::KNOCKED_DOWN, targetId, -1,
+                                  target.position, {}, 0, false);
             InjuryContext ctx;
             resolveArmourAndInjury(state, targetId, dice, ctx, events);
             handleBallOnPlayerDown(state, targetId, dice, events);
@@ -98,7 +98,7 @@ ActionResult resolveBallAndChain(GameState& state, int playerId,
     Player& bcp = state.getPlayer(playerId);
     bcp.hasActed = true;
 
-    int ma = bcp.stats.movement;
+    int ma = bcp.stats().movement;
 
     for (int step = 0; step < ma; step++) {
         // D8 scatter direction
@@ -110,26 +110,27 @@ ActionResult resolveBallAndChain(GameState& state, int playerId,
         // Off-pitch: player KO, drop ball, stop. NOT turnover
         if (!target.isOnPitch()) {
             handleBallOnPlayerDown(state, playerId, dice, events);
-            bcp.state = PlayerState::KO;
-            bcp.position = {-1, -1};
+            state.removePlayer(bcp, PlayerState::KO);
             return ActionResult::ok(); // Never turnover
         }
 
         // Occupied: auto-block
         Player* occupant = state.getPlayerAtPosition(target);
-        if (occupant && occupant->state == PlayerState::STANDING) {
-            bool bcDown = resolveAutoBlock(state, playerId, occupant->id, dice, events);
-            if (bcDown) {
-                return ActionResult::ok(); // B&C down stops, never turnover
+        if (occupant) {
+            if (occupant->state == PlayerState::STANDING) {
+                bool bcDown = resolveAutoBlock(state, playerId, occupant->id, dice, events);
+                if (bcDown) {
+                    return ActionResult::ok(); // B&C down stops, never turnover
+                }
             }
-            // Don't move into occupied square, continue to next step
+            // Don't move into occupied square (standing or prone), continue to next step
             continue;
         }
 
         // Move to empty square
         Position oldPos = bcp.position;
-        bcp.position = target;
-        emitEvent(events, {GameEvent::Type::PLAYER_MOVE, playerId, -1, oldPos, target, 0, true});
+        state.movePlayer(bcp, target);
+        BB_EMIT_EVENT(events, GameEvent::Type::PLAYER_MOVE, playerId, -1, oldPos, target, 0, true);
 
         // Ball carrier moves with ball
         if (state.ball.isHeld && state.ball.carrierId == playerId) {
@@ -8,8 +8,8 @@ bool resolvePickup(GameState& state, int playerId, DiceRollerBase& dice,
     Player& player = state.getPlayer(playerId);
 
     if (player.hasSkill(SkillName::NoHands)) {
-        emitEvent(events, {GameEvent::Type::PICKUP, playerId, -1, player.position, {},
-                          0, false});
+        BB_EMIT_EVENT(events, GameEvent::Type::PICKUP, playerId, -1, player.position, {},
+                              0, false);
         return false;
     }
 
@@ -17,8 +17,8 @@ bool resolvePickup(GameState& state, int playerId, DiceRollerBase& dice,
     bool success = attemptRoll(state, playerId, dice, target,
                                SkillName::SureHands, false, true, events);
 
-    emitEvent(events, {GameEvent::Type::PICKUP, playerId, -1, player.position, {},
-                      target, success});
+    BB_EMIT_EVENT(events, GameEvent::Type::PICKUP, playerId, -1, player.position, {},
+                          target, success);
 
     if (success) {
         state.ball = BallState::carried(player.position, playerId);
@@ -31,8 +31,8 @@ bool resolveCatch(GameState& state, int catcherId, DiceRollerBase& dice,
     Player& catcher = state.getPlayer(catcherId);
 
     if (catcher.hasSkill(SkillName::NoHands)) {
-        emitEvent(events, {GameEvent::Type::CATCH, catcherId, -1, catcher.position, {},
-                          0, false});
+        BB_EMIT_EVENT(events, GameEvent::Type::CATCH, catcherId, -1, catcher.position, {},
+                              0, false);
         return false;
     }
 
@@ -40,8 +40,8 @@ bool resolveCatch(GameState& state, int catcherId, DiceRollerBase& dice,
     bool success = attemptRoll(state, catcherId, dice, target,
                                SkillName::Catch, false, true, events);
 
-    emitEvent(events, {GameEvent::Type::CATCH, catcherId, -1, catcher.position, {},
-                      target, success});
+    BB_EMIT_EVENT(events, GameEvent::Type::CATCH, catcherId, -1, catcher.position, {},
+                          target, success);
 
     if (success) {
         state.ball = BallState::carried(catcher.position, catcherId);
@@ -51,6 +51,21 @@ bool resolveCatch(GameState& state, int catcherId, DiceRollerBase& dice,
 
 void resolveBounce(GameState& state, Position from, DiceRollerBase& dice,
                    int depth, std::vector<GameEvent>* events) {
+    if (dice.resolutionMode() == ResolutionMode::Expected) {
+        // The scatter averages out to `from`: the ball rests there if it is
+        // free, else on the first free square of the template around it.
+        // Nobody is left to catch it
+        Position dest = from;
+        for (int d8 = 1; d8 <= 8 && state.getPlayerAtPosition(dest); ++d8) {
+            Position offset = scatterDirection(d8);
+            Position next{static_cast<int8_t>(from.x + offset.x),
+                          static_cast<int8_t>(from.y + offset.y)};
+            if (next.isOnPitch()) dest = next;
+        }
+        state.ball = BallState::onGround(state.getPlayerAtPosition(dest) ? from : dest);
+        return;
+    }
+
     if (depth > 5) {
         // Ball stays on ground at from
         state.ball = BallState::onGround(from);
@@ -62,7 +77,7 @@ void resolveBounce(GameState& state, Position from, DiceRollerBase& dice,
     Position dest{static_cast<int8_t>(from.x + offset.x),
                   static_cast<int8_t>(from.y + offset.y)};
 
-    emitEvent(events, {GameEvent::Type::BALL_BOUNCE, -1, -1, from, dest, d8, true});
+    BB_EMIT_EVENT(events, GameEvent::Type::BALL_BOUNCE, -1, -1, from, dest, d8, true);
 
     if (!dest.isOnPitch()) {
         // Ball goes off pitch — throw-in from last on-pitch position
@@ -110,52 +125,48 @@ ExitEdge classifyExit(Position offPitchExit) {
 // uniform 8-way Bounce scatter template). For a corner exit, a D3 picks one
 // of 3 directions -- straight along one edge, the pure diagonal into the
 // corner, or straight along the other edge.
-Position throwInDirection(ExitEdge edge, DiceRollerBase& dice) {
+Position throwInDirection(ExitEdge edge, int d6) {
     switch (edge) {
         case ExitEdge::TOP: {
-            int d6 = dice.rollD6();
             if (d6 <= 2) return {-1, 1};   // SW
             if (d6 <= 4) return {0, 1};    // S (straight back in)
             return {1, 1};                  // SE
         }
         case ExitEdge::BOTTOM: {
-            int d6 = dice.rollD6();
             if (d6 <= 2) return {-1, -1};  // NW
             if (d6 <= 4) return {0, -1};   // N
             return {1, -1};                 // NE
         }
         case ExitEdge::LEFT: {
-            int d6 = dice.rollD6();
             if (d6 <= 2) return {1, -1};   // NE
             if (d6 <= 4) return {1, 0};    // E
             return {1, 1};                  // SE
         }
         case ExitEdge::RIGHT: {
-            int d6 = dice.rollD6();
             if (d6 <= 2) return {-1, -1};  // NW
             if (d6 <= 4) return {-1, 0};   // W
             return {-1, 1};                 // SW
         }
         case ExitEdge::TOP_LEFT: {
-            int d3 = (dice.rollD6() + 1) / 2;
+            int d3 = (d6 + 1) / 2;
             if (d3 == 1) return {1, 0};    // E, along the top edge
             if (d3 == 2) return {1, 1};    // SE, pure diagonal
             return {0, 1};                   // S, along the left edge
         }
         case ExitEdge::TOP_RIGHT: {
-            int d3 = (dice.rollD6() + 1) / 2;
+            int d3 = (d6 + 1) / 2;
             if (d3 == 1) return {-1, 0};   // W, along the top edge
             if (d3 == 2) return {-1, 1};   // SW, pure diagonal
             return {0, 1};                   // S, along the right edge
         }
         case ExitEdge::BOTTOM_LEFT: {
-            int d3 = (dice.rollD6() + 1) / 2;
+            int d3 = (d6 + 1) / 2;
             if (d3 == 1) return {1, 0};    // E, along the bottom edge
             if (d3 == 2) return {1, -1};   // NE, pure diagonal
             return {0, -1};                  // N, along the left edge
         }
         default: {  // BOTTOM_RIGHT
-            int d3 = (dice.rollD6() + 1) / 2;
+            int d3 = (d6 + 1) / 2;
             if (d3 == 1) return {-1, 0};   // W, along the bottom edge
             if (d3 == 2) return {-1, -1};  // NW, pure diagonal
             return {0, -1};                  // N, along the right edge
@@ -168,8 +179,10 @@ Position throwInDirection(ExitEdge edge, DiceRollerBase& dice) {
 void resolveThrowIn(GameState& state, Position lastOnPitch, Position offPitchExit,
                     DiceRollerBase& dice, std::vector<GameEvent>* events) {
     ExitEdge edge = classifyExit(offPitchExit);
-    Position offset = throwInDirection(edge, dice);
-    int distance = dice.roll2D6();
+    // ResolutionMode::Expected: the middle of the template, the median 2d6
+    bool expected = dice.resolutionMode() == ResolutionMode::Expected;
+    Position offset = throwInDirection(edge, expected ? 3 : dice.rollD6());
+    int distance = expected ? 7 : dice.roll2D6();
 
     Position dest{
         static_cast<int8_t>(lastOnPitch.x + offset.x * distance),
@@ -184,8 +197,10 @@ void resolveThrowIn(GameState& state, Position lastOnPitch, Position offPitchExi
                             static_cast<int8_t>(Position::PITCH_HEIGHT - 1));
     }
 
-    emitEvent(events, {GameEvent::Type::BALL_BOUNCE, -1, -1, lastOnPitch, dest,
-                      distance, true});
+    if (!expected) {
+        BB_EMIT_EVENT(events, GameEvent::Type::BALL_BOUNCE, -1, -1, lastOnPitch, dest,
+                              distance, true);
+    }
 
     // A throw-in always ends with one standard bounce from the landing
     // square, regardless of whether that square is occupied.
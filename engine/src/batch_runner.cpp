@@ -0,0 +1,220 @@
+#include "bb/batch_runner.h"
+#include "bb/macro_mcts.h"
+#include "bb/metrics.h"
+#include "bb/policies.h"
+#include "bb/thread_placement.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+namespace bb {
+
+PlayerConfig playerConfig(const GameConfig& config, TeamSide side) {
+    PlayerConfig p;
+    p.ai = side == TeamSide::HOME ? config.homeAI : config.awayAI;
+    p.valueFn = config.valueFn;
+    p.policy = config.policy;
+    p.epsilon = config.epsilon;
+    p.mctsIterations = config.mctsIterations;
+    p.gameIterations = config.gameIterations;
+    p.policyBlend = config.policyBlend;
+    p.vfBlend = config.vfBlend;
+    p.gumbelTopK = config.gumbelTopK;
+    return p;
+}
+
+GameResult playConfiguredGame(const TeamRoster& home, const TeamRoster& away,
+                              const GameConfig& config, uint32_t seed) {
+    return playConfiguredGame(home, away, playerConfig(config, TeamSide::HOME),
+                              playerConfig(config, TeamSide::AWAY), seed, config.adjudicate);
+}
+
+namespace {
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// `select`, each call recorded as a decision of `ai` without a search
+ActionSelector metered(ActionSelector select, MetricsRegistry* metrics, const char* ai) {
+    if (!metrics) return select;
+    return [select = std::move(select), metrics, ai](const GameState& s) {
+        auto start = std::chrono::steady_clock::now();
+        Action a = select(s);
+        recordDecision(*metrics, ai, msSince(start), nullptr);
+        return a;
+    };
+}
+
+// One side's ActionSelector under `config`. A search policy is also handed
+// out through macroOut (MacroMCTSPolicy) and, with gameIterations, gets a
+// TimeManager appended to `clocks`; `dice` and `clocks` must outlive the
+// selector.
+ActionSelector configuredPolicy(const PlayerConfig& config, DiceRollerBase& dice, uint32_t seed,
+                                std::shared_ptr<MacroMCTSPolicy>& macroOut,
+                                std::vector<std::unique_ptr<TimeManager>>& clocks) {
+    const std::string& ai = config.ai;
+    const ValueFunction* vf = config.valueFn.get();
+    if (ai == "greedy") {
+        return metered([&dice](const GameState& s) { return greedyPolicy(s, dice); }, config.metrics, "greedy");
+    } else if (ai == "macro_mcts" && config.mctsIterations > 0) {
+        MCTSConfig cfg;
+        cfg.maxIterations = config.mctsIterations;
+        cfg.timeBudgetMs = 0;
+        cfg.explorationC = 1.0;   // Eval: low C for exploitation
+        cfg.dirichletAlpha = 0.0f; // No noise during evaluation
+        cfg.earlyStop = true;      // Move only, no visit targets: skip settled decisions
+        cfg.vfBlend = config.vfBlend;
+        cfg.gumbelTopK = config.gumbelTopK;
+        if (config.policy) {
+            cfg.policy = config.policy.get();
+            cfg.policyBlend = config.policyBlend;
+        }
+        cfg.rootCache = config.rootCache.get();
+        cfg.rootCacheModel = config.rootCacheModel;
+        macroOut = std::make_shared<MacroMCTSPolicy>(vf, cfg, seed);
+        if (config.gameIterations > 0) {
+            TimeManager::Config tm;
+            tm.unit = TimeManager::Unit::ITERATIONS;
+            tm.gameBudget = config.gameIterations;
+            clocks.push_back(std::make_unique<TimeManager>(tm));
+            macroOut->setTimeManager(clocks.back().get());
+        }
+        if (config.metrics) {
+            // Plan steps after the first are decisions too, without a search
+            return [m = macroOut, metrics = config.metrics](const GameState& s) {
+                auto start = std::chrono::steady_clock::now();
+                int before = m->searches();
+                Action a = (*m)(s);
+                recordDecision(*metrics, "macro_mcts", msSince(start),
+                               m->searches() != before ? &m->lastSearchStats() : nullptr);
+                return a;
+            };
+        }
+        return [m = macroOut](const GameState& s) { return (*m)(s); };
+    } else if (ai == "mcts" && vf && config.mctsIterations > 0) {
+        MCTSConfig cfg;
+        cfg.maxIterations = config.mctsIterations;
+        cfg.timeBudgetMs = 0;
+        cfg.maxChildren = 40;
+        if (config.policy) {
+            cfg.policy = config.policy.get();
+            cfg.explorationC = 2.5;
+        }
+        auto mcts = std::make_shared<MCTSPolicy>(vf, cfg, seed);
+        if (config.metrics) {
+            return [mcts, metrics = config.metrics](const GameState& s) {
+                auto start = std::chrono::steady_clock::now();
+                Action a = (*mcts)(s);
+                recordDecision(*metrics, "mcts", msSince(start), &mcts->lastSearchStats());
+                return a;
+            };
+        }
+        return [mcts](const GameState& s) { return (*mcts)(s); };
+    } else if (ai == "learning" && vf) {
+        return metered([&dice, vf, eps = config.epsilon](const GameState& s) {
+            return learningPolicy(s, dice, *vf, eps);
+        }, config.metrics, "learning");
+    } else {
+        return metered([&dice](const GameState& s) { return randomPolicy(s, dice); }, config.metrics, "random");
+    }
+}
+
+} // anonymous namespace
+
+GameResult playConfiguredGame(const TeamRoster& home, const TeamRoster& away,
+                              const PlayerConfig& homePlayer, const PlayerConfig& awayPlayer,
+                              uint32_t seed, bool adjudicate) {
+    DiceRoller dice(seed);
+
+    // MCTS/MacroMCTS policies hold state across calls
+    std::shared_ptr<MacroMCTSPolicy> homeMacroMcts, awayMacroMcts;
+    std::vector<std::unique_ptr<TimeManager>> clocks;  // PlayerConfig::gameIterations
+
+    ActionSelector homePolicy = configuredPolicy(homePlayer, dice, seed, homeMacroMcts, clocks);
+    ActionSelector awayPolicy = configuredPolicy(awayPlayer, dice, seed, awayMacroMcts, clocks);
+    // Pondering: show each position the opponent acts from to the other side
+    auto pondering = [](ActionSelector opponent, std::shared_ptr<MacroMCTSPolicy> self) -> ActionSelector {
+        return [opponent = std::move(opponent), self = std::move(self)](const GameState& s) {
+            self->ponder(s);
+            return opponent(s);
+        };
+    };
+    if (homePlayer.ponder && homeMacroMcts) awayPolicy = pondering(std::move(awayPolicy), homeMacroMcts);
+    if (awayPlayer.ponder && awayMacroMcts) homePolicy = pondering(std::move(homePolicy), awayMacroMcts);
+
+    GameResult result = simulateGame(home, away, homePolicy, awayPolicy, dice, false, adjudicate);
+    for (MetricsRegistry* metrics : {homePlayer.metrics, awayPlayer.metrics}) {
+        if (metrics) metrics->counter("bb_games_completed_total", "Games played to the end").inc();
+        if (homePlayer.metrics == awayPlayer.metrics) break;  // one registry, one game
+    }
+    return result;
+}
+
+BatchResult runGames(const TeamRoster& home, const TeamRoster& away,
+                     const std::vector<GameConfig>& configs,
+                     const std::vector<uint32_t>& seeds, int threads) {
+    if (configs.size() != 1 && configs.size() != seeds.size()) {
+        throw std::invalid_argument("runGames: need one config, or one per seed");
+    }
+    BatchResult batch;
+    int n = static_cast<int>(seeds.size());
+    batch.games.resize(n);
+    if (n == 0) return batch;
+
+    // Workers claim games from a shared counter; results land by index.
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int i = next.fetch_add(1); i < n; i = next.fetch_add(1)) {
+            const GameConfig& cfg = configs.size() == 1 ? configs[0] : configs[i];
+            batch.games[i] = playConfiguredGame(home, away, cfg, seeds[i]);
+        }
+    };
+    int workers = std::clamp(threads, 1, n);
+    runWorkers(workers, [&](int) { worker(); });
+
+    for (auto& g : batch.games) {
+        if (g.homeScore > g.awayScore) ++batch.homeWins;
+        else if (g.awayScore > g.homeScore) ++batch.awayWins;
+        else ++batch.draws;
+        batch.totalActions += g.totalActions;
+    }
+    return batch;
+}
+
+ContinuationResult simulateFromState(const GameState& state, const TeamRoster& home,
+                                     const TeamRoster& away, const PlayerConfig& homePlayer,
+                                     const PlayerConfig& awayPlayer, int nGames, int threads,
+                                     PlayUntil until, uint32_t seed) {
+    ContinuationResult out;
+    int n = std::max(0, nGames);
+    out.games.resize(n);
+    if (n == 0) return out;
+
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int i = next.fetch_add(1); i < n; i = next.fetch_add(1)) {
+            // Continuation i's own stream; its policies are seeded from it
+            FastDiceRoller dice(seed, static_cast<uint64_t>(i));
+            uint32_t policySeed = static_cast<uint32_t>(dice.next());
+            std::shared_ptr<MacroMCTSPolicy> homeMacroMcts, awayMacroMcts;
+            std::vector<std::unique_ptr<TimeManager>> clocks;
+            ActionSelector homePolicy = configuredPolicy(homePlayer, dice, policySeed, homeMacroMcts, clocks);
+            ActionSelector awayPolicy = configuredPolicy(awayPlayer, dice, policySeed, awayMacroMcts, clocks);
+            GameState s = state.clone();
+            out.games[i] = continueGame(s, home, away, homePolicy, awayPolicy, dice, until);
+        }
+    };
+    runWorkers(std::clamp(threads, 1, n), [&](int) { worker(); });
+
+    for (const GameResult& g : out.games) {
+        if (g.homeScore > state.homeTeam.score) ++out.homeScored;
+        if (g.awayScore > state.awayTeam.score) ++out.awayScored;
+        ++out.scoreDiff[g.homeScore - g.awayScore];
+        out.totalActions += g.totalActions;
+    }
+    return out;
+}
+
+} // namespace bb
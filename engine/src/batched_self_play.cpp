@@ -0,0 +1,150 @@
+#include "bb/batched_self_play.h"
+#include "bb/macro_mcts.h"
+#include "bb/thread_placement.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+namespace bb {
+
+SharedEvalBatcher::SharedEvalBatcher(const ValueFunction& model, int maxBatch, int maxWaitUs)
+    : model_(model), maxBatch_(std::max(1, maxBatch)), maxWaitUs_(std::max(0, maxWaitUs)) {}
+
+void SharedEvalBatcher::attach() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++attached_;
+}
+
+void SharedEvalBatcher::detach() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --attached_;
+    }
+    // The waiters may now be everyone left
+    changed_.notify_all();
+}
+
+float SharedEvalBatcher::evaluate(const float* features, int numFeatures) const {
+    if (numFeatures != inputSize()) return model_.evaluate(features, numFeatures);
+    float value = 0.0f;
+    Request req{features, 1, &value};
+    submit(req);
+    return value;
+}
+
+void SharedEvalBatcher::evaluateBatch(const float* features, int batch, int numFeatures, float* out) const {
+    if (batch <= 0) return;
+    if (numFeatures != inputSize()) {
+        model_.evaluateBatch(features, batch, numFeatures, out);
+        return;
+    }
+    Request req{features, batch, out};
+    submit(req);
+}
+
+void SharedEvalBatcher::submit(Request& req) const {
+    const int rowSize = inputSize();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(maxWaitUs_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    queue_.push_back(&req);
+    queuedRows_ += req.count;
+    changed_.notify_all();
+
+    while (!req.done) {
+        bool ready = !queue_.empty() &&
+                     (static_cast<int>(queue_.size()) >= attached_ || queuedRows_ >= maxBatch_ ||
+                      std::chrono::steady_clock::now() >= deadline);
+        if (evaluating_) {
+            changed_.wait(lock);  // for the batch in flight, which may hold this request
+            continue;
+        }
+        if (!ready) {
+            changed_.wait_until(lock, deadline);
+            continue;
+        }
+
+        // This thread evaluates everything queued, its own request included
+        std::vector<Request*> batch;
+        batch.swap(queue_);
+        const int total = queuedRows_;
+        queuedRows_ = 0;
+        evaluating_ = true;
+        lock.unlock();
+
+        if (batch.size() == 1) {
+            model_.evaluateBatch(batch[0]->rows, batch[0]->count, rowSize, batch[0]->out);
+        } else {
+            rows_.resize(static_cast<size_t>(total) * rowSize);
+            values_.resize(total);
+            size_t at = 0;
+            for (const Request* r : batch) {
+                std::copy(r->rows, r->rows + static_cast<size_t>(r->count) * rowSize, rows_.begin() + at * rowSize);
+                at += r->count;
+            }
+            model_.evaluateBatch(rows_.data(), total, rowSize, values_.data());
+            at = 0;
+            for (Request* r : batch) {
+                std::copy(values_.begin() + at, values_.begin() + at + r->count, r->out);
+                at += r->count;
+            }
+        }
+
+        lock.lock();
+        for (Request* r : batch) r->done = true;
+        evaluating_ = false;
+        stats_.batches++;
+        stats_.requests += batch.size();
+        stats_.rows += total;
+        changed_.notify_all();
+    }
+}
+
+SharedEvalBatcher::Stats SharedEvalBatcher::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+BatchedSelfPlayResult runBatchedSelfPlay(const TeamRoster& home, const TeamRoster& away,
+                                         const ValueFunction& model,
+                                         const BatchedSelfPlayConfig& config,
+                                         const std::vector<uint32_t>& seeds) {
+    if (config.concurrentGames <= 0) {
+        throw std::invalid_argument("runBatchedSelfPlay: concurrentGames must be positive");
+    }
+    BatchedSelfPlayResult out;
+    const int n = static_cast<int>(seeds.size());
+    out.games.resize(n);
+    SharedEvalBatcher batcher(model, config.maxBatch, config.maxWaitUs);
+
+    // As runGames(): workers claim games from a shared counter
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int i = next.fetch_add(1); i < n; i = next.fetch_add(1)) {
+            DiceRoller dice(seeds[i]);
+            MacroMCTSPolicy homePolicy(&batcher, config.search, seeds[i]);
+            MacroMCTSPolicy awayPolicy(&batcher, config.search, seeds[i]);
+            homePolicy.setLogDecisions(true, config.topK, config.logBoards);
+            awayPolicy.setLogDecisions(true, config.topK, config.logBoards);
+            LoggedGameResult& logged = out.games[i];
+            logged = simulateGameLogged(home, away,
+                [&homePolicy](const GameState& s) { return homePolicy(s); },
+                [&awayPolicy](const GameState& s) { return awayPolicy(s); },
+                dice, config.useFullKickoff, config.logMode);
+            for (const auto* p : {&homePolicy, &awayPolicy}) {
+                logged.policyDecisions.insert(logged.policyDecisions.end(),
+                                              p->decisions().begin(), p->decisions().end());
+            }
+        }
+        batcher.detach();
+    };
+    const int workers = std::min(config.concurrentGames, std::max(n, 1));
+    // Attach up front, so the first batches wait for every game
+    for (int t = 0; t < workers; ++t) batcher.attach();
+    runWorkers(workers, [&](int) { worker(); });
+
+    out.eval = batcher.stats();
+    return out;
+}
+
+} // namespace bb
@@ -1,4 +1,5 @@
 #include "bb/big_guy_handler.h"
+#include "bb/geometry.h"
 #include "bb/helpers.h"
 
 namespace bb {
@@ -11,10 +12,10 @@ BigGuyResult resolveBigGuyCheck(GameState& state, int playerId, ActionType actio
     // BoneHead: D6, 1=fail → lostTZ + hasActed + hasMoved
     if (player.hasSkill(SkillName::BoneHead)) {
         int roll = dice.rollD6();
-        emitEvent(events, {GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
-                          static_cast<int>(SkillName::BoneHead), roll >= 2});
+        BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
+                              static_cast<int>(SkillName::BoneHead), roll >= 2);
         if (roll == 1) {
-            player.lostTacklezones = true;
+            state.setLostTacklezones(player, true);
             player.hasActed = true;
             player.hasMoved = true;
             result.actionBlocked = true;
@@ -27,9 +28,7 @@ BigGuyResult resolveBigGuyCheck(GameState& state, int playerId, ActionType actio
     if (player.hasSkill(SkillName::ReallyStupid)) {
         // Check for adjacent standing ally (non-ReallyStupid or any ally)
         bool hasAdjacentAlly = false;
-        auto adj = player.position.getAdjacent();
-        for (auto& pos : adj) {
-            if (!pos.isOnPitch()) continue;
+        for (Position pos : onPitchNeighbours(player.position)) {
             const Player* ally = state.getPlayerAtPosition(pos);
             if (ally && ally->teamSide == player.teamSide &&
                 canAct(ally->state) && !ally->lostTacklezones) {
@@ -40,10 +39,10 @@ BigGuyResult resolveBigGuyCheck(GameState& state, int playerId, ActionType actio
 
         int target = hasAdjacentAlly ? 2 : 4;
         int roll = dice.rollD6();
-        emitEvent(events, {GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
-                          static_cast<int>(SkillName::ReallyStupid), roll >= target});
+        BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
+                              static_cast<int>(SkillName::ReallyStupid), roll >= target);
         if (roll < target) {
-            player.lostTacklezones = true;
+            state.setLostTacklezones(player, true);
             player.hasActed = true;
             player.hasMoved = true;
             result.actionBlocked = true;
@@ -56,8 +55,8 @@ BigGuyResult resolveBigGuyCheck(GameState& state, int playerId, ActionType actio
     if (player.hasSkill(SkillName::WildAnimal)) {
         if (actionType != ActionType::BLOCK && actionType != ActionType::BLITZ) {
             int roll = dice.rollD6();
-            emitEvent(events, {GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
-                              static_cast<int>(SkillName::WildAnimal), roll >= 3});
+            BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
+                                  static_cast<int>(SkillName::WildAnimal), roll >= 3);
             if (roll < 3) {
                 // WildAnimal keeps tacklezones (unlike BoneHead/ReallyStupid)
                 player.hasActed = true;
@@ -73,8 +72,8 @@ BigGuyResult resolveBigGuyCheck(GameState& state, int playerId, ActionType actio
     if (player.hasSkill(SkillName::TakeRoot)) {
         if (actionType == ActionType::MOVE || actionType == ActionType::BLITZ) {
             int roll = dice.rollD6();
-            emitEvent(events, {GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
-                              static_cast<int>(SkillName::TakeRoot), roll >= 2});
+            BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
+                                  static_cast<int>(SkillName::TakeRoot), roll >= 2);
             if (roll == 1) {
                 player.hasActed = true;
                 player.hasMoved = true;
@@ -88,14 +87,12 @@ BigGuyResult resolveBigGuyCheck(GameState& state, int playerId, ActionType actio
     // Bloodlust: D6, 2+=pass. Fail: bite adjacent Thrall
     if (player.hasSkill(SkillName::Bloodlust)) {
         int roll = dice.rollD6();
-        emitEvent(events, {GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
-                          static_cast<int>(SkillName::Bloodlust), roll >= 2});
+        BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
+                              static_cast<int>(SkillName::Bloodlust), roll >= 2);
         if (roll == 1) {
             // Find adjacent Thrall (teammate without Bloodlust skill)
             int thrallId = -1;
-            auto adj = player.position.getAdjacent();
-            for (auto& pos : adj) {
-                if (!pos.isOnPitch()) continue;
+            for (Position pos : onPitchNeighbours(player.position)) {
                 const Player* ally = state.getPlayerAtPosition(pos);
                 if (ally && ally->teamSide == player.teamSide &&
                     canAct(ally->state) && !ally->hasSkill(SkillName::Bloodlust)) {
@@ -107,17 +104,15 @@ BigGuyResult resolveBigGuyCheck(GameState& state, int playerId, ActionType actio
             if (thrallId >= 0) {
                 // Bite Thrall: KO + remove from pitch
                 Player& thrall = state.getPlayer(thrallId);
-                thrall.state = PlayerState::KO;
-                thrall.position = {-1, -1};
-                emitEvent(events, {GameEvent::Type::INJURY, thrallId, playerId, {}, {},
-                                  0, false});
+                state.removePlayer(thrall, PlayerState::KO);
+                BB_EMIT_EVENT(events, GameEvent::Type::INJURY, thrallId, playerId, {}, {},
+                                      0, false);
                 // Action still proceeds
                 result.actionBlocked = false;
                 result.proceed = true;
             } else {
                 // No Thrall available: player goes off pitch
-                player.state = PlayerState::KO;
-                player.position = {-1, -1};
+                state.removePlayer(player, PlayerState::KO);
                 result.actionBlocked = true;
                 result.proceed = false;
             }
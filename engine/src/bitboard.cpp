@@ -0,0 +1,88 @@
+#include "bb/bitboard.h"
+#include "bb/geometry.h"
+
+namespace bb {
+
+namespace {
+
+constexpr int W = Position::PITCH_WIDTH;
+
+Bitboard makePitch() {
+    Bitboard b;
+    for (int i = 0; i < Bitboard::SQUARES; ++i) b.set(i);
+    return b;
+}
+
+// All squares except column `x` (stops east/west shifts wrapping rows).
+Bitboard makeNotColumn(int x) {
+    Bitboard b = makePitch();
+    for (int y = 0; y < Position::PITCH_HEIGHT; ++y) b.clear(y * W + x);
+    return b;
+}
+
+struct Tables {
+    Bitboard pitch = makePitch();
+    Bitboard notFirstColumn = makeNotColumn(0);
+    Bitboard notLastColumn = makeNotColumn(W - 1);
+    std::array<Bitboard, Bitboard::SQUARES> adjacent{};
+
+    Tables() {
+        for (int i = 0; i < Bitboard::SQUARES; ++i) {
+            Position p = Bitboard::positionOf(i);
+            for (Position apos : onPitchNeighbours(p)) adjacent[i].set(apos);
+        }
+    }
+};
+
+const Tables& tables() {
+    static const Tables t;
+    return t;
+}
+
+} // anonymous namespace
+
+Bitboard Bitboard::shiftUp(int n) const {
+    Bitboard r;
+    int words = n >> 6, bits = n & 63;
+    for (int i = WORDS - 1; i >= words; --i) {
+        uint64_t v = w[i - words] << bits;
+        if (bits && i - words - 1 >= 0) v |= w[i - words - 1] >> (64 - bits);
+        r.w[i] = v;
+    }
+    return r & pitch();
+}
+
+Bitboard Bitboard::shiftDown(int n) const {
+    Bitboard r;
+    int words = n >> 6, bits = n & 63;
+    for (int i = 0; i + words < WORDS; ++i) {
+        uint64_t v = w[i + words] >> bits;
+        if (bits && i + words + 1 < WORDS) v |= w[i + words + 1] << (64 - bits);
+        r.w[i] = v;
+    }
+    return r;
+}
+
+const Bitboard& Bitboard::pitch() { return tables().pitch; }
+
+const Bitboard& Bitboard::adjacent(Position p) { return tables().adjacent[indexOf(p)]; }
+
+Bitboard dilate(const Bitboard& b) {
+    const Tables& t = tables();
+    // x+1 moves a bit up one index; anything landing in column 0 wrapped.
+    Bitboard row = b | (b.shiftUp(1) & t.notFirstColumn) | (b.shiftDown(1) & t.notLastColumn);
+    return row | row.shiftUp(W) | row.shiftDown(W);
+}
+
+Bitboard floodFill(Position start, const Bitboard& passable, int steps) {
+    Bitboard reached;
+    reached.set(start);
+    for (int i = 0; i < steps; ++i) {
+        Bitboard next = reached | (dilate(reached) & passable);
+        if (next == reached) break;
+        reached = next;
+    }
+    return reached;
+}
+
+} // namespace bb
@@ -27,19 +27,14 @@ static int scoreFace(BlockDiceFace face, bool attHasBlock, bool defHasBlock,
     return 0;
 }
 
-BlockDiceFace autoChooseBlockDie(const BlockDiceFace* faces, int count,
-                                 bool attackerChooses,
-                                 const Player& att, const Player& def) {
-    bool attBlock = att.hasSkill(SkillName::Block);
-    bool defBlock = def.hasSkill(SkillName::Block);
-    bool defDodge = def.hasSkill(SkillName::Dodge);
-    bool attTackle = att.hasSkill(SkillName::Tackle);
-
+BlockDiceFace chooseBlockDie(const BlockDiceFace* faces, int count, bool attackerChooses,
+                             bool attHasBlock, bool defHasBlock, bool defHasDodge,
+                             bool attHasTackle) {
     int bestIdx = 0;
-    int bestScore = scoreFace(faces[0], attBlock, defBlock, defDodge, attTackle);
+    int bestScore = scoreFace(faces[0], attHasBlock, defHasBlock, defHasDodge, attHasTackle);
 
     for (int i = 1; i < count; i++) {
-        int s = scoreFace(faces[i], attBlock, defBlock, defDodge, attTackle);
+        int s = scoreFace(faces[i], attHasBlock, defHasBlock, defHasDodge, attHasTackle);
         if (attackerChooses) {
             if (s > bestScore) { bestScore = s; bestIdx = i; }
         } else {
@@ -49,13 +44,65 @@ BlockDiceFace autoChooseBlockDie(const BlockDiceFace* faces, int count,
     return faces[bestIdx];
 }
 
-static bool shouldRerollBlock(BlockDiceFace face, const Player& att) {
+BlockDiceFace autoChooseBlockDie(const BlockDiceFace* faces, int count,
+                                 bool attackerChooses,
+                                 const Player& att, const Player& def) {
+    return chooseBlockDie(faces, count, attackerChooses,
+                          att.hasSkill(SkillName::Block), def.hasSkill(SkillName::Block),
+                          def.hasSkill(SkillName::Dodge), att.hasSkill(SkillName::Tackle));
+}
+
+bool shouldRerollBlock(BlockDiceFace face, bool attHasBlock) {
     if (face == BlockDiceFace::ATTACKER_DOWN) return true;
-    if (face == BlockDiceFace::BOTH_DOWN && !att.hasSkill(SkillName::Block)) return true;
+    if (face == BlockDiceFace::BOTH_DOWN && !attHasBlock) return true;
     return false;
 }
 
 // Resolve pushback: returns true if defender was pushed off pitch (crowd surf)
+// Push `occupant` away from `pusherPos` to make room for a pushed player.
+// Prefers an empty square; if all three are taken the push cascades into the
+// straight-ahead square's occupant, so no two players ever share a square.
+static void resolveChainPush(GameState& state, Position pusherPos, Player& occupant,
+                             DiceRollerBase& dice, std::vector<GameEvent>* events,
+                             int depth) {
+    Position chainSquares[3];
+    int chainCount = getPushbackSquares(pusherPos, occupant.position, chainSquares);
+
+    // Depth guard: a cascade can involve at most every other player once
+    if (chainCount == 0 || depth >= 21) {
+        // Chain push off pitch
+        BB_EMIT_EVENT(events, GameEvent::Type::PUSH, occupant.id, -1,
+                              occupant.position, {-1, -1}, 0, true);
+        handleBallOnPlayerDown(state, occupant.id, dice, events);
+        resolveCrowdSurf(state, occupant.id, dice, events);
+        return;
+    }
+
+    // Find empty chain destination
+    int chainIdx = -1;
+    for (int i = 0; i < chainCount; i++) {
+        if (!state.getPlayerAtPosition(chainSquares[i])) {
+            chainIdx = i;
+            break;
+        }
+    }
+    if (chainIdx < 0) {
+        chainIdx = 0;
+        resolveChainPush(state, occupant.position,
+                         *state.getPlayerAtPosition(chainSquares[0]), dice, events, depth + 1);
+    }
+    Position chainDest = chainSquares[chainIdx];
+
+    BB_EMIT_EVENT(events, GameEvent::Type::PUSH, occupant.id, -1,
+                          occupant.position, chainDest, 0, true);
+
+    // Move chain-pushed player
+    if (state.ball.isHeld && state.ball.carrierId == occupant.id) {
+        state.ball.position = chainDest;
+    }
+    state.movePlayer(occupant, chainDest);
+}
+
 static bool resolvePushback(GameState& state, Player& attacker, Player& defender,
                             bool isBlitz, DiceRollerBase& dice,
                             Position& pushDest, std::vector<GameEvent>* events) {
@@ -73,8 +120,8 @@ static bool resolvePushback(GameState& state, Player& attacker, Player& defender
 
     if (pushCount == 0) {
         // Off pitch — crowd surf
-        emitEvent(events, {GameEvent::Type::PUSH, defender.id, -1,
-                          defender.position, {-1, -1}, 0, true});
+        BB_EMIT_EVENT(events, GameEvent::Type::PUSH, defender.id, -1,
+                              defender.position, {-1, -1}, 0, true);
         pushDest = {-1, -1};
         return true;
     }
@@ -122,38 +169,7 @@ static bool resolvePushback(GameState& state, Player& attacker, Player& defender
     // Check if destination is occupied → chain push
     Player* occupant = state.getPlayerAtPosition(pushDest);
     if (occupant) {
-        // Chain push: push occupant in the same direction
-        Position chainPushDest;
-        Position chainSquares[3];
-        int chainCount = getPushbackSquares(defender.position, occupant->position, chainSquares);
-
-        if (chainCount == 0) {
-            // Chain push off pitch
-            Position occupantOldPos = occupant->position;
-            emitEvent(events, {GameEvent::Type::PUSH, occupant->id, -1,
-                              occupant->position, {-1, -1}, 0, true});
-            handleBallOnPlayerDown(state, occupant->id, dice, events);
-            resolveCrowdSurf(state, occupant->id, dice, events);
-        } else {
-            // Find empty chain destination
-            int chainIdx = 0;
-            for (int i = 0; i < chainCount; i++) {
-                if (!state.getPlayerAtPosition(chainSquares[i])) {
-                    chainIdx = i;
-                    break;
-                }
-            }
-            Position chainDest = chainSquares[chainIdx];
-
-            emitEvent(events, {GameEvent::Type::PUSH, occupant->id, -1,
-                              occupant->position, chainDest, 0, true});
-
-            // Move chain-pushed player
-            if (state.ball.isHeld && state.ball.carrierId == occupant->id) {
-                state.ball.position = chainDest;
-            }
-            occupant->position = chainDest;
-        }
+        resolveChainPush(state, defender.position, *occupant, dice, events, 0);
     }
 
     // Check if push goes off pitch
@@ -161,12 +177,12 @@ static bool resolvePushback(GameState& state, Player& attacker, Player& defender
         return true; // crowd surf
     }
 
-    emitEvent(events, {GameEvent::Type::PUSH, defender.id, -1,
-                      defender.position, pushDest, 0, true});
+    BB_EMIT_EVENT(events, GameEvent::Type::PUSH, defender.id, -1,
+                          defender.position, pushDest, 0, true);
 
     // Move defender
     Position defOldPos = defender.position;
-    defender.position = pushDest;
+    state.movePlayer(defender, pushDest);
     if (state.ball.isHeld && state.ball.carrierId == defender.id) {
         state.ball.position = pushDest;
     }
@@ -187,8 +203,8 @@ ActionResult resolveBlock(GameState& state, const BlockParams& params,
         int faRoll = dice.rollD6();
         if (faRoll == 1) {
             att.hasActed = true;
-            emitEvent(events, {GameEvent::Type::SKILL_USED, def.id, att.id, {}, {},
-                              static_cast<int>(SkillName::FoulAppearance), true});
+            BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, def.id, att.id, {}, {},
+                                  static_cast<int>(SkillName::FoulAppearance), true);
             return ActionResult::fail(); // action wasted, not turnover
         }
     }
@@ -196,14 +212,14 @@ ActionResult resolveBlock(GameState& state, const BlockParams& params,
     // 2. Chainsaw
     if (att.hasSkill(SkillName::Chainsaw)) {
         int chainsawRoll = dice.rollD6();
-        emitEvent(events, {GameEvent::Type::BLOCK, att.id, def.id, att.position,
-                          def.position, chainsawRoll, chainsawRoll >= 2});
+        BB_EMIT_EVENT(events, GameEvent::Type::BLOCK, att.id, def.id, att.position,
+                              def.position, chainsawRoll, chainsawRoll >= 2);
 
         if (chainsawRoll == 1) {
             // Kickback on attacker
-            att.state = PlayerState::PRONE;
-            emitEvent(events, {GameEvent::Type::KNOCKED_DOWN, att.id, -1,
-                              att.position, {}, 0, false});
+            state.setPlayerState(att, PlayerState::PRONE);
+            BB_EMIT_EVENT(events, GameEvent::Type::KNOCKED_DOWN, att.id, -1,
+                                  att.position, {}, 0, false);
             InjuryContext ctx;
             resolveArmourAndInjury(state, att.id, dice, ctx, events);
             handleBallOnPlayerDown(state, att.id, dice, events);
@@ -221,8 +237,8 @@ ActionResult resolveBlock(GameState& state, const BlockParams& params,
 
     // 3. Stab
     if (att.hasSkill(SkillName::Stab)) {
-        emitEvent(events, {GameEvent::Type::BLOCK, att.id, def.id, att.position,
-                          def.position, 0, true});
+        BB_EMIT_EVENT(events, GameEvent::Type::BLOCK, att.id, def.id, att.position,
+                              def.position, 0, true);
         InjuryContext ctx;
         if (att.hasSkill(SkillName::Stakes)) ctx.hasStakes = true;
         resolveArmourAndInjury(state, def.id, dice, ctx, events);
@@ -232,8 +248,8 @@ ActionResult resolveBlock(GameState& state, const BlockParams& params,
     }
 
     // 4. Normal block — calculate strengths
-    int attST = att.stats.strength;
-    int defST = def.stats.strength;
+    int attST = att.stats().strength;
+    int defST = def.stats().strength;
 
     if (params.hornsBonus && att.hasSkill(SkillName::Horns)) {
         attST += 1;
@@ -248,13 +264,13 @@ ActionResult resolveBlock(GameState& state, const BlockParams& params,
     // Dauntless
     if (att.hasSkill(SkillName::Dauntless) && effDefST > effAttST) {
         int dauntlessRoll = dice.rollD6();
-        if (dauntlessRoll + att.stats.strength > def.stats.strength) {
+        if (dauntlessRoll + att.stats().strength > def.stats().strength) {
             effAttST = effDefST; // treat as equal
-            emitEvent(events, {GameEvent::Type::SKILL_USED, att.id, -1, {}, {},
-                              static_cast<int>(SkillName::Dauntless), true});
+            BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, att.id, -1, {}, {},
+                                  static_cast<int>(SkillName::Dauntless), true);
         } else {
-            emitEvent(events, {GameEvent::Type::SKILL_USED, att.id, -1, {}, {},
-                              static_cast<int>(SkillName::Dauntless), false});
+            BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, att.id, -1, {}, {},
+                                  static_cast<int>(SkillName::Dauntless), false);
         }
     }
 
@@ -277,7 +293,7 @@ ActionResult resolveBlock(GameState& state, const BlockParams& params,
     }
 
     // Pro/team reroll on bad result
-    if (shouldRerollBlock(chosen, att)) {
+    if (shouldRerollBlock(chosen, att.hasSkill(SkillName::Block))) {
         bool rerolled = false;
 
         // Pro reroll
@@ -297,7 +313,7 @@ ActionResult resolveBlock(GameState& state, const BlockParams& params,
         }
 
         // Team reroll
-        if (!rerolled && shouldRerollBlock(chosen, att)) {
+        if (!rerolled && shouldRerollBlock(chosen, att.hasSkill(SkillName::Block))) {
             TeamState& team = state.getTeamState(att.teamSide);
             if (team.canUseReroll()) {
                 team.rerolls--;
@@ -322,8 +338,8 @@ ActionResult resolveBlock(GameState& state, const BlockParams& params,
         }
     }
 
-    emitEvent(events, {GameEvent::Type::BLOCK, att.id, def.id, att.position,
-                      def.position, static_cast<int>(chosen), true});
+    BB_EMIT_EVENT(events, GameEvent::Type::BLOCK, att.id, def.id, att.position,
+                          def.position, static_cast<int>(chosen), true);
 
     // 5. Apply block result
     bool defPushed = false;
@@ -334,11 +350,11 @@ ActionResult resolveBlock(GameState& state, const BlockParams& params,
 
     switch (chosen) {
         case BlockDiceFace::ATTACKER_DOWN: {
-            att.state = PlayerState::PRONE;
+            state.setPlayerState(att, PlayerState::PRONE);
             attKnockedDown = true;
             turnover = true;
-            emitEvent(events, {GameEvent::Type::KNOCKED_DOWN, att.id, -1,
-                              att.position, {}, 0, false});
+            BB_EMIT_EVENT(events, GameEvent::Type::KNOCKED_DOWN, att.id, -1,
+                                  att.position, {}, 0, false);
             break;
         }
 
@@ -350,11 +366,11 @@ ActionResult resolveBlock(GameState& state, const BlockParams& params,
 
             if (defWrestle || attWrestle) {
                 // Wrestle: both prone, no armor, no turnover
-                att.state = PlayerState::PRONE;
-                def.state = PlayerState::PRONE;
-                emitEvent(events, {GameEvent::Type::SKILL_USED,
-                                  defWrestle ? def.id : att.id, -1, {}, {},
-                                  static_cast<int>(SkillName::Wrestle), true});
+                state.setPlayerState(att, PlayerState::PRONE);
+                state.setPlayerState(def, PlayerState::PRONE);
+                BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED,
+                                      defWrestle ? def.id : att.id, -1, {}, {},
+                                      static_cast<int>(SkillName::Wrestle), true);
                 // Handle ball on either player going down
                 handleBallOnPlayerDown(state, att.id, dice, events);
                 handleBallOnPlayerDown(state, def.id, dice, events);
@@ -367,11 +383,11 @@ ActionResult resolveBlock(GameState& state, const BlockParams& params,
             bool defFalls = !def.hasSkill(SkillName::Block);
 
             if (attFalls) {
-                att.state = PlayerState::PRONE;
+                state.setPlayerState(att, PlayerState::PRONE);
                 attKnockedDown = true;
                 turnover = true;
-                emitEvent(events, {GameEvent::Type::KNOCKED_DOWN, att.id, -1,
-                                  att.position, {}, 0, false});
+                BB_EMIT_EVENT(events, GameEvent::Type::KNOCKED_DOWN, att.id, -1,
+                                      att.position, {}, 0, false);
             }
             if (defFalls) {
                 defKnockedDown = true;
@@ -432,14 +448,14 @@ ActionResult resolveBlock(GameState& state, const BlockParams& params,
             // Crowd surf
             handleBallOnPlayerDown(state, def.id, dice, events);
             Position lastPos = def.position;
-            def.position = {-1, -1};
+            state.movePlayer(def, {-1, -1});
             resolveCrowdSurf(state, def.id, dice, events);
 
             // StripBall: ball drops at crowd edge (already handled by crowd surf)
 
             // Follow-up: attacker to old defender position
             if (!noFollowUp) {
-                att.position = defOldPos;
+                state.movePlayer(att, defOldPos);
                 if (state.ball.isHeld && state.ball.carrierId == att.id) {
                     state.ball.position = att.position;
                 }
@@ -460,9 +476,9 @@ ActionResult resolveBlock(GameState& state, const BlockParams& params,
             att.hasSkill(SkillName::StripBall)) {
             if (def.hasSkill(SkillName::SureHands)) {
                 // Sure Hands negates Strip Ball (BB2016/LRB6) — ball stays with carrier.
-                emitEvent(events, {GameEvent::Type::SKILL_USED, def.id, att.id,
-                                  def.position, {},
-                                  static_cast<int>(SkillName::SureHands), true});
+                BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, def.id, att.id,
+                                      def.position, {},
+                                      static_cast<int>(SkillName::SureHands), true);
             } else {
                 state.ball = BallState::onGround(def.position);
                 resolveBounce(state, def.position, dice, 0, events);
@@ -471,8 +487,10 @@ ActionResult resolveBlock(GameState& state, const BlockParams& params,
 
         // Follow-up: attacker moves to old defender position
         bool fendPrevents = def.hasSkill(SkillName::Fend) && !defKnockedDown;
-        if (!noFollowUp && !fendPrevents) {
-            att.position = defOldPos;
+        // Stand Firm leaves the defender in place: there is no square to follow into.
+        bool defVacated = def.position != defOldPos;
+        if (!noFollowUp && !fendPrevents && defVacated) {
+            state.movePlayer(att, defOldPos);
             if (state.ball.isHeld && state.ball.carrierId == att.id) {
                 state.ball.position = att.position;
             }
@@ -480,9 +498,9 @@ ActionResult resolveBlock(GameState& state, const BlockParams& params,
 
         // Knockdown
         if (defKnockedDown) {
-            def.state = PlayerState::PRONE;
-            emitEvent(events, {GameEvent::Type::KNOCKED_DOWN, def.id, -1,
-                              def.position, {}, 0, false});
+            state.setPlayerState(def, PlayerState::PRONE);
+            BB_EMIT_EVENT(events, GameEvent::Type::KNOCKED_DOWN, def.id, -1,
+                                  def.position, {}, 0, false);
 
             InjuryContext defCtx;
             if (att.hasSkill(SkillName::MightyBlow)) {
@@ -536,16 +554,16 @@ ActionResult resolveMultipleBlock(GameState& state, int attackerId,
             int faRoll = dice.rollD6();
             if (faRoll == 1) {
                 // Skip this block (action wasted on this target)
-                emitEvent(events, {GameEvent::Type::SKILL_USED, def1.id, att.id, {}, {},
-                                  static_cast<int>(SkillName::FoulAppearance), true});
+                BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, def1.id, att.id, {}, {},
+                                      static_cast<int>(SkillName::FoulAppearance), true);
                 goto second_block;
             }
         }
 
         {
             // Temporarily add +2 ST to defender
-            int8_t origST = def1.stats.strength;
-            def1.stats.strength += 2;
+            ProfileId origProfile = def1.profile;
+            def1.setStrength(def1.stats().strength + 2);
 
             BlockParams params;
             params.attackerId = attackerId;
@@ -554,7 +572,7 @@ ActionResult resolveMultipleBlock(GameState& state, int attackerId,
             params.hornsBonus = false;
             ActionResult result = resolveBlock(state, params, dice, events, false, true);
 
-            def1.stats.strength = origST;
+            def1.profile = origProfile;
 
             // If attacker went down, turnover — skip 2nd block
             if (result.turnover || att.state != PlayerState::STANDING) {
@@ -576,15 +594,15 @@ second_block:
             int faRoll = dice.rollD6();
             if (faRoll == 1) {
                 att.hasActed = true;
-                emitEvent(events, {GameEvent::Type::SKILL_USED, def2.id, att.id, {}, {},
-                                  static_cast<int>(SkillName::FoulAppearance), true});
+                BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, def2.id, att.id, {}, {},
+                                      static_cast<int>(SkillName::FoulAppearance), true);
                 return ActionResult::ok();
             }
         }
 
         // Temporarily add +2 ST to defender
-        int8_t origST = def2.stats.strength;
-        def2.stats.strength += 2;
+        ProfileId origProfile = def2.profile;
+        def2.setStrength(def2.stats().strength + 2);
 
         BlockParams params;
         params.attackerId = attackerId;
@@ -593,7 +611,7 @@ second_block:
         params.hornsBonus = false;
         ActionResult result = resolveBlock(state, params, dice, events, false, true);
 
-        def2.stats.strength = origST;
+        def2.profile = origProfile;
 
         return result;
     }
@@ -0,0 +1,149 @@
+#include "bb/block_odds.h"
+#include "bb/block_handler.h"
+#include "bb/helpers.h"
+#include <algorithm>
+#include <vector>
+
+namespace bb {
+
+namespace {
+
+constexpr int FACES = 5;
+constexpr int SKILL_COMBOS = 1 << 7;
+
+int skillIndex(const BlockSkills& s) {
+    return (s.attBlock ? 1 : 0) | (s.attWrestle ? 2 : 0) | (s.attTackle ? 4 : 0) |
+           (s.defBlock ? 8 : 0) | (s.defDodge ? 16 : 0) | (s.defWrestle ? 32 : 0) |
+           (s.defStandFirm ? 64 : 0);
+}
+
+BlockSkills skillsOf(int index) {
+    return {(index & 1) != 0, (index & 2) != 0, (index & 4) != 0, (index & 8) != 0,
+            (index & 16) != 0, (index & 32) != 0, (index & 64) != 0};
+}
+
+int rerollIndex(RerollAccess a) {
+    return (a.team ? 1 : 0) | (a.pro ? 2 : 0) | (a.loner ? 4 : 0);
+}
+
+BlockDiceFace faceOfRoll(int d6) {
+    switch (d6) {
+        case 1: return BlockDiceFace::ATTACKER_DOWN;
+        case 2: return BlockDiceFace::BOTH_DOWN;
+        case 3: case 4: return BlockDiceFace::PUSHED;
+        case 5: return BlockDiceFace::DEFENDER_STUMBLES;
+        default: return BlockDiceFace::DEFENDER_DOWN;
+    }
+}
+
+struct BlockTable {
+    // [dice - 1][attackerChooses][skills][rerolls]
+    std::vector<BlockOdds> odds;
+
+    BlockTable() : odds(3 * 2 * SKILL_COMBOS * 8) {
+        for (int dice = 1; dice <= 3; ++dice) {
+            for (int chooses = 0; chooses < 2; ++chooses) {
+                for (int k = 0; k < SKILL_COMBOS; ++k) {
+                    BlockSkills s = skillsOf(k);
+                    // Chosen face over all 6^dice rolls
+                    double chosen[FACES] = {};
+                    int combos = dice == 1 ? 6 : (dice == 2 ? 36 : 216);
+                    for (int c = 0; c < combos; ++c) {
+                        BlockDiceFace faces[3];
+                        for (int i = 0, rest = c; i < dice; ++i, rest /= 6) faces[i] = faceOfRoll(rest % 6 + 1);
+                        BlockDiceFace f = chooseBlockDie(faces, dice, chooses != 0, s.attBlock,
+                                                         s.defBlock, s.defDodge, s.attTackle);
+                        chosen[static_cast<int>(f)] += 1.0 / combos;
+                    }
+                    double bad = 0.0;
+                    for (int f = 0; f < FACES; ++f) {
+                        if (shouldRerollBlock(static_cast<BlockDiceFace>(f), s.attBlock)) bad += chosen[f];
+                    }
+                    for (int r = 0; r < 8; ++r) {
+                        // Chance a bad face gets all the dice rerolled: Pro
+                        // on a 4+, else the team reroll (Loner: on a 4+)
+                        double lonerGate = (r & 4) ? 0.5 : 1.0;
+                        double team = (r & 1) ? lonerGate : 0.0;
+                        double reroll = (r & 2) ? 0.5 + 0.5 * team : team;
+                        BlockOdds& out = odds[index(dice, chooses != 0, k, r)];
+                        for (int f = 0; f < FACES; ++f) {
+                            BlockDiceFace face = static_cast<BlockDiceFace>(f);
+                            double p = chosen[f] * (shouldRerollBlock(face, s.attBlock) ? 1.0 - reroll : 1.0) +
+                                       bad * reroll * chosen[f];
+                            out.p[static_cast<size_t>(blockOutcome(face, s))] += static_cast<float>(p);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    static size_t index(int dice, bool chooses, int skills, int rerolls) {
+        return ((static_cast<size_t>(dice - 1) * 2 + (chooses ? 1 : 0)) * SKILL_COMBOS + skills) * 8 + rerolls;
+    }
+};
+
+const BlockTable& blockTable() {
+    static const BlockTable table;
+    return table;
+}
+
+} // anonymous namespace
+
+const BlockOdds& blockOdds(int dice, bool attackerChooses, const BlockSkills& skills,
+                           RerollAccess rerolls) {
+    dice = std::clamp(dice, 1, 3);
+    return blockTable().odds[BlockTable::index(dice, attackerChooses, skillIndex(skills),
+                                               rerollIndex(rerolls))];
+}
+
+BlockOutcome blockOutcome(BlockDiceFace face, const BlockSkills& s) {
+    switch (face) {
+        case BlockDiceFace::ATTACKER_DOWN:
+            return BlockOutcome::ATTACKER_DOWN;
+        case BlockDiceFace::BOTH_DOWN:
+            if (s.defWrestle || (s.attWrestle && !s.attBlock)) return BlockOutcome::WRESTLED;
+            if (s.attBlock) return s.defBlock ? BlockOutcome::STANDOFF : BlockOutcome::DEFENDER_DOWN;
+            return s.defBlock ? BlockOutcome::ATTACKER_DOWN : BlockOutcome::BOTH_DOWN;
+        case BlockDiceFace::PUSHED:
+            return s.defStandFirm ? BlockOutcome::STANDOFF : BlockOutcome::PUSHED;
+        case BlockDiceFace::DEFENDER_STUMBLES:
+            if (s.defDodge && !s.attTackle) {
+                return s.defStandFirm ? BlockOutcome::STANDOFF : BlockOutcome::PUSHED;
+            }
+            return BlockOutcome::DEFENDER_DOWN;
+        case BlockDiceFace::DEFENDER_DOWN:
+            return BlockOutcome::DEFENDER_DOWN;
+    }
+    return BlockOutcome::PUSHED;
+}
+
+BlockSkills blockSkills(const Player& att, const Player& def) {
+    BlockSkills s;
+    s.attBlock = att.hasSkill(SkillName::Block);
+    s.attWrestle = att.hasSkill(SkillName::Wrestle);
+    s.attTackle = att.hasSkill(SkillName::Tackle);
+    s.defBlock = def.hasSkill(SkillName::Block);
+    s.defDodge = def.hasSkill(SkillName::Dodge);
+    s.defWrestle = def.hasSkill(SkillName::Wrestle);
+    s.defStandFirm = def.hasSkill(SkillName::StandFirm);
+    return s;
+}
+
+BlockDiceInfo blockDice(const GameState& state, const Player& att, const Player& def,
+                        bool isBlitz) {
+    int attST = att.stats().strength;
+    if (isBlitz && att.hasSkill(SkillName::Horns)) attST += 1;
+    int attAssists = countAssists(state, def.position, att.teamSide, att.id, def.id, def.id);
+    int defAssists = countAssists(state, att.position, def.teamSide, att.id, def.id, att.id);
+    return getBlockDiceInfo(attST + attAssists, def.stats().strength + defAssists);
+}
+
+const BlockOdds& blockOdds(const GameState& state, const Player& att, const Player& def,
+                           bool isBlitz) {
+    BlockDiceInfo info = blockDice(state, att, def, isBlitz);
+    return blockOdds(info.count, info.attackerChooses, blockSkills(att, def),
+                     RiskOracle::access(state, att));
+}
+
+} // namespace bb
@@ -0,0 +1,104 @@
+#include "bb/board_planes.h"
+
+namespace bb {
+
+namespace {
+
+int mirrorIndex(int idx, bool flip) {
+    if (!flip) return idx;
+    int y = idx / BOARD_PLANE_WIDTH;
+    int x = idx - y * BOARD_PLANE_WIDTH;
+    return y * BOARD_PLANE_WIDTH + (BOARD_PLANE_WIDTH - 1 - x);
+}
+
+Bitboard oriented(const Bitboard& b, bool flip) {
+    if (!flip) return b;
+    Bitboard r;
+    b.forEach([&](int idx) { r.set(mirrorIndex(idx, true)); });
+    return r;
+}
+
+} // namespace
+
+void boardPlaneMasks(const GameState& state, TeamSide perspective, BoardPlaneMasks& out) {
+    for (Bitboard& b : out) b = Bitboard{};
+    const bool flip = perspective == TeamSide::AWAY;
+    const TeamSide opp = opponent(perspective);
+
+    out[PLANE_OWN_STANDING] = oriented(state.standingOf(perspective), flip);
+    out[PLANE_OPP_STANDING] = oriented(state.standingOf(opp), flip);
+
+    auto downPlanes = [&](TeamSide side, int prone, int stunned) {
+        state.forEachOnPitch(side, [&](const Player& p) {
+            int idx = mirrorIndex(Bitboard::indexOf(p.position), flip);
+            if (p.state == PlayerState::PRONE) out[prone].set(idx);
+            else if (p.state == PlayerState::STUNNED) out[stunned].set(idx);
+        });
+    };
+    downPlanes(perspective, PLANE_OWN_PRONE, PLANE_OWN_STUNNED);
+    downPlanes(opp, PLANE_OPP_PRONE, PLANE_OPP_STUNNED);
+
+    // Only squares on the TZ board can carry a count
+    auto tzPlanes = [&](TeamSide side, int first) {
+        state.tacklezoneBoard(side).forEach([&](int idx) {
+            int n = state.tacklezoneCount(side, Bitboard::positionOf(idx));
+            int m = mirrorIndex(idx, flip);
+            for (int level = 0; level < 3 && level < n; ++level) out[first + level].set(m);
+        });
+    };
+    tzPlanes(perspective, PLANE_OWN_TZ_1);
+    tzPlanes(opp, PLANE_OPP_TZ_1);
+
+    if (state.ball.isOnPitch()) {
+        int idx = mirrorIndex(Bitboard::indexOf(state.ball.position), flip);
+        out[PLANE_BALL].set(idx);
+        if (state.ball.isHeld && state.ball.carrierId > 0) {
+            bool own = state.getPlayer(state.ball.carrierId).teamSide == perspective;
+            out[own ? PLANE_OWN_CARRIER : PLANE_OPP_CARRIER].set(idx);
+        }
+    }
+
+    constexpr int MA_LEVELS[] = {1, 3, 5, 7};
+    state.forEachOnPitch(perspective, [&](const Player& p) {
+        int idx = mirrorIndex(Bitboard::indexOf(p.position), flip);
+        if (p.canAct()) out[PLANE_OWN_CAN_ACT].set(idx);
+        for (int i = 0; i < 4; ++i) {
+            if (p.movementRemaining >= MA_LEVELS[i]) out[PLANE_OWN_MA_1 + i].set(idx);
+        }
+    });
+
+    if (state.activeTeam == perspective) out[PLANE_OWN_TURN] = Bitboard::pitch();
+}
+
+void extractBoardPlanes(const GameState& state, TeamSide perspective, float* out) {
+    BoardPlaneMasks masks;
+    boardPlaneMasks(state, perspective, masks);
+    for (int c = 0; c < NUM_BOARD_PLANES; ++c) {
+        float* plane = out + c * BOARD_PLANE_SIZE;
+        for (int i = 0; i < BOARD_PLANE_SIZE; ++i) plane[i] = masks[c].test(i) ? 1.0f : 0.0f;
+    }
+}
+
+void extractBoardPlanes(const GameState& state, TeamSide perspective, uint8_t* out) {
+    BoardPlaneMasks masks;
+    boardPlaneMasks(state, perspective, masks);
+    for (int c = 0; c < NUM_BOARD_PLANES; ++c) {
+        uint8_t* plane = out + c * BOARD_PLANE_SIZE;
+        for (int i = 0; i < BOARD_PLANE_SIZE; ++i) plane[i] = masks[c].test(i) ? 1 : 0;
+    }
+}
+
+void extractBoardPlanesPacked(const GameState& state, TeamSide perspective, uint8_t* out) {
+    BoardPlaneMasks masks;
+    boardPlaneMasks(state, perspective, masks);
+    // Bitboard bit i is square i, so a plane's bytes are its words' bytes
+    // in little-endian order, cut at BOARD_PLANE_BYTES.
+    for (int c = 0; c < NUM_BOARD_PLANES; ++c) {
+        uint8_t* plane = out + c * BOARD_PLANE_BYTES;
+        for (int b = 0; b < BOARD_PLANE_BYTES; ++b) {
+            plane[b] = static_cast<uint8_t>(masks[c].w[b >> 3] >> ((b & 7) * 8));
+        }
+    }
+}
+
+} // namespace bb
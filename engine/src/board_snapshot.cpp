@@ -1,35 +1,161 @@
 #include "bb/board_snapshot.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+#include <stdexcept>
 
 namespace bb {
 
-BoardSnapshot captureBoardSnapshot(const GameState& state) {
-    BoardSnapshot snap;
+CompactBoardSnapshot captureCompactBoardSnapshot(const GameState& state) {
+    CompactBoardSnapshot snap;
+    snap.captured = true;
 
     if (state.ball.isOnPitch()) {
         snap.ballX = state.ball.position.x;
         snap.ballY = state.ball.position.y;
     }
     snap.ballHeld = state.ball.isHeld;
-    snap.ballCarrierId = state.ball.carrierId;
+    snap.ballCarrierId = static_cast<int8_t>(state.ball.carrierId);
 
-    auto snapshotTeam = [&](TeamSide side, std::vector<PlayerSnapshot>& out) {
+    int n = 0;
+    auto snapshotTeam = [&](TeamSide side) {
         state.forEachOnPitch(side, [&](const Player& p) {
-            PlayerSnapshot ps;
-            ps.id = p.id;
+            CompactPlayerSnapshot& ps = snap.players[n++];
+            ps.id = static_cast<uint8_t>(p.id);
             ps.x = p.position.x;
             ps.y = p.position.y;
-            if (p.state == PlayerState::STANDING) ps.state = 0;
-            else if (p.state == PlayerState::PRONE) ps.state = 1;
-            else if (p.state == PlayerState::STUNNED) ps.state = 2;
-            else ps.state = 3;
-            ps.hasBall = (state.ball.isHeld && state.ball.carrierId == p.id);
-            out.push_back(ps);
+            if (p.state == PlayerState::STANDING) ps.flags = 0;
+            else if (p.state == PlayerState::PRONE) ps.flags = 1;
+            else if (p.state == PlayerState::STUNNED) ps.flags = 2;
+            else ps.flags = 3;
+            if (state.ball.isHeld && state.ball.carrierId == p.id) ps.flags |= 4;
+            ps.profile = p.profile;
         });
     };
-    snapshotTeam(TeamSide::HOME, snap.homePlayers);
-    snapshotTeam(TeamSide::AWAY, snap.awayPlayers);
+    snapshotTeam(TeamSide::HOME);
+    snap.numHome = static_cast<uint8_t>(n);
+    snapshotTeam(TeamSide::AWAY);
+    snap.numAway = static_cast<uint8_t>(n - snap.numHome);
 
     return snap;
 }
 
+BoardSnapshot expandBoardSnapshot(const CompactBoardSnapshot& snap) {
+    BoardSnapshot board;
+    board.ballX = snap.ballX;
+    board.ballY = snap.ballY;
+    board.ballHeld = snap.ballHeld;
+    board.ballCarrierId = snap.ballCarrierId;
+    board.homePlayers.reserve(snap.numHome);
+    board.awayPlayers.reserve(snap.numAway);
+    for (int i = 0; i < snap.numPlayers(); ++i) {
+        const CompactPlayerSnapshot& p = snap.players[i];
+        PlayerSnapshot ps;
+        ps.id = p.id;
+        ps.x = p.x;
+        ps.y = p.y;
+        ps.state = p.state();
+        ps.hasBall = p.hasBall();
+        (i < snap.numHome ? board.homePlayers : board.awayPlayers).push_back(std::move(ps));
+    }
+    return board;
+}
+
+BoardSnapshot captureBoardSnapshot(const GameState& state) {
+    return expandBoardSnapshot(captureCompactBoardSnapshot(state));
+}
+
+SnapshotContext SnapshotContext::fromRow(const int16_t* row) {
+    auto side = [](int16_t v) { return v ? TeamSide::AWAY : TeamSide::HOME; };
+    SnapshotContext c;
+    c.half = row[0];
+    c.homeTurn = row[1];
+    c.awayTurn = row[2];
+    c.activeTeam = side(row[3]);
+    c.homeScore = row[4];
+    c.awayScore = row[5];
+    c.homeRerolls = row[6];
+    c.awayRerolls = row[7];
+    c.kickingTeam = side(row[8]);
+    return c;
+}
+
+GameState stateFromSnapshot(const CompactBoardSnapshot& snap, const TeamRoster& home,
+                            const TeamRoster& away, const SnapshotContext& context) {
+    GameState state;
+    setupHalf(state, home, away, context.kickingTeam);
+    for (auto& p : state.players) {
+        p.state = PlayerState::OFF_PITCH;
+        p.position = {-1, -1};
+    }
+
+    for (int i = 0; i < snap.numPlayers(); ++i) {
+        const CompactPlayerSnapshot& ps = snap.players[i];
+        int first = i < snap.numHome ? 1 : 12;
+        if (ps.id < first || ps.id >= first + 11) {
+            throw std::invalid_argument("stateFromSnapshot: player id " + std::to_string(ps.id) +
+                                        " is not a " + (first == 1 ? "home" : "away") + " id");
+        }
+        Player& p = state.getPlayer(ps.id);
+        if (ps.profile != 0) p.profile = ps.profile;
+        p.position = {ps.x, ps.y};
+        static constexpr PlayerState STATES[4] = {PlayerState::STANDING, PlayerState::PRONE,
+                                                  PlayerState::STUNNED, PlayerState::OFF_PITCH};
+        p.state = STATES[ps.state()];
+        if (p.state == PlayerState::OFF_PITCH) p.position = {-1, -1};
+        p.movementRemaining = static_cast<int8_t>(p.stats().movement);
+    }
+
+    if (snap.ballHeld && snap.ballCarrierId > 0) {
+        state.ball = BallState::carried({snap.ballX, snap.ballY}, snap.ballCarrierId);
+    } else if (snap.ballX >= 0) {
+        state.ball = BallState::onGround({snap.ballX, snap.ballY});
+    }
+
+    state.half = context.half;
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = context.activeTeam;
+    state.homeTeam.turnNumber = context.homeTurn;
+    state.awayTeam.turnNumber = context.awayTurn;
+    state.homeTeam.score = context.homeScore;
+    state.awayTeam.score = context.awayScore;
+    state.homeTeam.rerolls = context.homeRerolls;
+    state.awayTeam.rerolls = context.awayRerolls;
+    state.invalidateOccupancy();
+    return state;
+}
+
+GameState stateFromSnapshot(const BoardSnapshot& board, const TeamRoster& home,
+                            const TeamRoster& away, const SnapshotContext& context) {
+    CompactBoardSnapshot snap;
+    snap.captured = true;
+    int n = 0;
+    for (const auto* team : {&board.homePlayers, &board.awayPlayers}) {
+        for (const PlayerSnapshot& ps : *team) {
+            if (n == CompactBoardSnapshot::MAX_PLAYERS) {
+                throw std::invalid_argument("stateFromSnapshot: more than 22 players");
+            }
+            CompactPlayerSnapshot& p = snap.players[n++];
+            p.id = static_cast<uint8_t>(ps.id);
+            p.x = ps.x;
+            p.y = ps.y;
+            p.flags = static_cast<uint8_t>((ps.state & 3) | (ps.hasBall ? 4 : 0));
+        }
+        if (team == &board.homePlayers) snap.numHome = static_cast<uint8_t>(n);
+    }
+    snap.numAway = static_cast<uint8_t>(n - snap.numHome);
+    snap.ballX = board.ballX;
+    snap.ballY = board.ballY;
+    snap.ballHeld = board.ballHeld;
+    snap.ballCarrierId = static_cast<int8_t>(board.ballCarrierId);
+    return stateFromSnapshot(snap, home, away, context);
+}
+
+int positionalIndex(const TeamRoster& roster, ProfileId profile) {
+    for (int t = 0; t < roster.positionalCount; ++t) {
+        const PlayerTemplate& tmpl = roster.positionals[t];
+        if (internProfile(tmpl.stats, tmpl.skills) == profile) return t;
+    }
+    return -1;
+}
+
 } // namespace bb
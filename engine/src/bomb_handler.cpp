@@ -17,7 +17,7 @@ ActionResult resolveBombThrow(GameState& state, int throwerId, Position target,
     int dist = thrower.position.distanceTo(target);
     PassRange range = passRangeFromDistance(dist);
 
-    int passTarget = 7 - thrower.stats.agility;
+    int passTarget = 7 - thrower.stats().agility;
     passTarget -= passModifier(range);
 
     if (!thrower.hasSkill(SkillName::NervesOfSteel)) {
@@ -34,8 +34,8 @@ ActionResult resolveBombThrow(GameState& state, int throwerId, Position target,
     passTarget = std::clamp(passTarget, 2, 6);
 
     int roll = dice.rollD6();
-    emitEvent(events, {GameEvent::Type::PASS, throwerId, -1, thrower.position, target,
-                      roll, roll >= passTarget && roll != 1});
+    BB_EMIT_EVENT(events, GameEvent::Type::PASS, throwerId, -1, thrower.position, target,
+                          roll, roll >= passTarget && roll != 1);
 
     // Determine explosion position
     Position explosionPos = target;
@@ -76,9 +76,9 @@ ActionResult resolveBombThrow(GameState& state, int throwerId, Position target,
             if (victim->state != PlayerState::STANDING) continue;
 
             // Knocked down + armor roll
-            victim->state = PlayerState::PRONE;
-            emitEvent(events, {GameEvent::Type::KNOCKED_DOWN, victim->id, throwerId,
-                              victim->position, {}, 0, false});
+            state.setPlayerState(*victim, PlayerState::PRONE);
+            BB_EMIT_EVENT(events, GameEvent::Type::KNOCKED_DOWN, victim->id, throwerId,
+                                  victim->position, {}, 0, false);
             InjuryContext ctx;
             resolveArmourAndInjury(state, victim->id, dice, ctx, events);
             handleBallOnPlayerDown(state, victim->id, dice, events);
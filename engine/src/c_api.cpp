@@ -0,0 +1,299 @@
+#include "bb/c_api.h"
+#include "bb/action_resolver.h"
+#include "bb/game_simulator.h"
+#include "bb/model_cache.h"
+#include "bb/move_server.h"
+#include "bb/roster.h"
+#include "bb/state_io.h"
+#include <nlohmann/json.hpp>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace bb;
+using nlohmann::json;
+
+struct bb_state {
+    GameState state;
+    // Set by bb_state_new: lets bb_execute set up the next drive itself
+    const TeamRoster* home = nullptr;
+    const TeamRoster* away = nullptr;
+};
+
+struct bb_engine {
+    MCTSConfig search;
+    std::shared_ptr<LoadedModel> model;
+    std::shared_ptr<LoadedModel> policyModel;  // search.policy's owner
+    std::unique_ptr<MacroMCTSSearch> engine;
+    uint32_t moves = 0;  // plan dice seeds
+};
+
+namespace {
+
+thread_local std::string lastError;
+thread_local std::string result;
+
+const char* reply(std::string text) {
+    lastError.clear();
+    result = std::move(text);
+    return result.c_str();
+}
+
+template<typename T>
+T* fail(const std::string& error) {
+    lastError = error;
+    return nullptr;
+}
+
+// An entrypoint's body, with any exception it throws turned into a failure:
+// nothing may unwind through the C ABI into the caller's runtime.
+template<typename T, typename Body>
+T* guarded(Body&& body) {
+    try {
+        return body();
+    } catch (const std::exception& e) {
+        return fail<T>(e.what());
+    } catch (...) {
+        return fail<T>("unknown error");
+    }
+}
+
+const char* EVENT_NAMES[] = {
+    "player_move", "dodge", "gfi", "block", "push", "injury",
+    "touchdown", "turnover", "ball_bounce", "pass", "catch",
+    "pickup", "foul", "kickoff", "weather_change", "skill_used",
+    "knocked_down", "armor_break", "casualty", "regeneration",
+    "ejected",
+};
+static_assert(std::size(EVENT_NAMES) == static_cast<size_t>(GameEvent::Type::EJECTED) + 1);
+
+json actionToJson(const Action& a) {
+    return {
+        {"type", actionTypeName(a.type)},
+        {"type_id", static_cast<int>(a.type)},
+        {"player", a.playerId},
+        {"target_player", a.targetId},
+        {"x", a.target.x},
+        {"y", a.target.y},
+    };
+}
+
+// Throws json::exception for a malformed action, std::invalid_argument for
+// an unknown type.
+Action actionFromJson(const json& j) {
+    Action a;
+    const json& type = j.at("type");
+    if (type.is_string()) {
+        std::string name = type.get<std::string>();
+        int t = 0;
+        while (t <= static_cast<int>(ActionType::MOVE_PATH) && name != actionTypeName(static_cast<ActionType>(t))) ++t;
+        if (t > static_cast<int>(ActionType::MOVE_PATH)) throw std::invalid_argument("unknown action type " + name);
+        a.type = static_cast<ActionType>(t);
+    } else {
+        int t = type.get<int>();
+        if (t < 0 || t > static_cast<int>(ActionType::MOVE_PATH)) {
+            throw std::invalid_argument("unknown action type " + std::to_string(t));
+        }
+        a.type = static_cast<ActionType>(t);
+    }
+    a.playerId = j.value("player", -1);
+    a.targetId = j.value("target_player", -1);
+    a.target = {static_cast<int8_t>(j.value("x", -1)), static_cast<int8_t>(j.value("y", -1))};
+    return a;
+}
+
+json eventToJson(const GameEvent& e) {
+    return {
+        {"type", EVENT_NAMES[static_cast<int>(e.type)]},
+        {"player", e.playerId},
+        {"target", e.targetId},
+        {"from", {e.from.x, e.from.y}},
+        {"to", {e.to.x, e.to.y}},
+        {"roll", e.roll},
+        {"die1", e.die1},
+        {"die2", e.die2},
+        {"success", e.success},
+    };
+}
+
+// The simulator's drive restarts (continueGame), for states that know
+// their rosters; the opening kick is always the away team's.
+void restartDrive(bb_state& s, DiceRollerBase& dice) {
+    GameState& state = s.state;
+    if (state.phase == GamePhase::TOUCHDOWN) {
+        state.kickingTeam = state.getPlayer(state.ball.carrierId).teamSide;
+        setupDrive(state, *s.home, *s.away, state.kickingTeam);
+        simpleKickoff(state, dice);
+    } else if (state.phase == GamePhase::HALF_TIME) {
+        state.half = 2;
+        state.kickingTeam = TeamSide::HOME;
+        setupHalf(state, *s.home, *s.away, state.kickingTeam);
+        simpleKickoff(state, dice);
+    }
+}
+
+} // anonymous namespace
+
+extern "C" {
+
+int bb_abi_version(void) {
+    return BB_ABI_VERSION;
+}
+
+const char* bb_last_error(void) {
+    return lastError.c_str();
+}
+
+bb_state* bb_state_new(const char* home_roster, const char* away_roster, uint32_t seed) {
+    return guarded<bb_state>([&]() -> bb_state* {
+        std::string homeName = home_roster ? home_roster : "";
+        std::string awayName = away_roster ? away_roster : "";
+        const TeamRoster* home = getRosterByName(homeName);
+        const TeamRoster* away = getRosterByName(awayName);
+        if (!home || !away) return fail<bb_state>("unknown roster " + (home ? awayName : homeName));
+        auto s = std::make_unique<bb_state>();
+        s->home = home;
+        s->away = away;
+        setupHalf(s->state, *home, *away);
+        DiceRoller dice(seed);
+        simpleKickoff(s->state, dice);
+        lastError.clear();
+        return s.release();
+    });
+}
+
+bb_state* bb_state_from_json(const char* text) {
+    return guarded<bb_state>([&]() -> bb_state* {
+        try {
+            auto s = std::make_unique<bb_state>();
+            s->state = stateFromJson(text ? text : "");
+            lastError.clear();
+            return s.release();
+        } catch (const json::exception& e) {
+            return fail<bb_state>(std::string("bad state: ") + e.what());
+        }
+    });
+}
+
+bb_state* bb_state_clone(const bb_state* state) {
+    if (!state) return fail<bb_state>("no state");
+    return guarded<bb_state>([&] {
+        auto copy = std::make_unique<bb_state>(*state);
+        lastError.clear();
+        return copy.release();
+    });
+}
+
+void bb_state_free(bb_state* state) {
+    delete state;
+}
+
+const char* bb_state_to_json(const bb_state* state) {
+    if (!state) return fail<const char>("no state");
+    return guarded<const char>([&] { return reply(stateToJson(state->state)); });
+}
+
+const char* bb_legal_actions(const bb_state* state) {
+    if (!state) return fail<const char>("no state");
+    return guarded<const char>([&] {
+        ActionList actions;
+        getAvailableActions(state->state, actions);
+        json out = json::array();
+        for (const Action& a : actions) out.push_back(actionToJson(a));
+        return reply(out.dump());
+    });
+}
+
+const char* bb_execute(bb_state* state, const char* action, uint32_t seed) {
+    if (!state) return fail<const char>("no state");
+    return guarded<const char>([&]() -> const char* {
+        Action a;
+        try {
+            a = actionFromJson(json::parse(action ? action : ""));
+        } catch (const json::exception& e) {
+            return fail<const char>(std::string("bad action: ") + e.what());
+        }
+        if (!isActionLegal(state->state, a)) return fail<const char>("illegal action");
+
+        DiceRoller dice(seed);
+        std::vector<GameEvent> events;
+        ActionResult r = executeAction(state->state, a, dice, &events);
+        if (state->home) restartDrive(*state, dice);
+
+        json out = {{"success", r.success}, {"turnover", r.turnover},
+                    {"phase", static_cast<int>(state->state.phase)}, {"events", json::array()}};
+        for (const GameEvent& e : events) out["events"].push_back(eventToJson(e));
+        return reply(out.dump());
+    });
+}
+
+bb_engine* bb_engine_new(const char* config) {
+    return guarded<bb_engine>([&]() -> bb_engine* {
+        json j = json::parse(config ? config : "{}", nullptr, false);
+        if (j.is_discarded() || !j.is_object()) return fail<bb_engine>("config is not a JSON object");
+        auto e = std::make_unique<bb_engine>();
+        try {
+            e->search.timeBudgetMs = j.value("time_ms", 1000);
+            e->search.maxIterations = j.value("iterations", 100000);
+            e->search.explorationC = j.value("exploration_c", 1.0);
+            e->search.vfBlend = j.value("vf_blend", 0.0f);
+            e->search.policyBlend = j.value("policy_blend", 0.0f);
+            ModelCache models;
+            std::string weights = j.value("weights", std::string());
+            if (!weights.empty()) {
+                e->model = models.get(weights);
+                if (!e->model || !e->model->value) return fail<bb_engine>("no value network in " + weights);
+            }
+            e->policyModel = e->model;
+            std::string policy = j.value("policy", std::string());
+            if (!policy.empty()) {
+                e->policyModel = models.get(policy);
+                if (!e->policyModel || !e->policyModel->policy) return fail<bb_engine>("no policy network in " + policy);
+            }
+            if (e->policyModel) e->search.policy = e->policyModel->policy.get();
+            e->engine = std::make_unique<MacroMCTSSearch>(e->model ? e->model->value.get() : nullptr, e->search,
+                                                          j.value("seed", 1u));
+        } catch (const json::exception& ex) {
+            return fail<bb_engine>(std::string("bad config: ") + ex.what());
+        }
+        lastError.clear();
+        return e.release();
+    });
+}
+
+void bb_engine_free(bb_engine* engine) {
+    delete engine;
+}
+
+const char* bb_engine_move(bb_engine* engine, const bb_state* state, const char* options) {
+    if (!engine || !state) return fail<const char>("no engine or state");
+    return guarded<const char>([&]() -> const char* {
+        json j = json::parse(options ? options : "{}", nullptr, false);
+        if (j.is_discarded() || !j.is_object()) return fail<const char>("options are not a JSON object");
+
+        MoveRequest request;
+        MoveReply out;
+        try {
+            if (j.contains("id")) request.tag = j["id"].dump();
+            request.timeBudgetMs = j.value("time_ms", 0);
+            request.maxIterations = j.value("iterations", 0);
+            request.plan = j.value("plan", false);
+        } catch (const json::exception& ex) {
+            return fail<const char>(std::string("bad options: ") + ex.what());
+        }
+        request.state = state->state;
+        out.tag = request.tag;
+        if (request.state.phase == GamePhase::GAME_OVER) {
+            out.status = MoveStatus::FAILED;
+            out.error = "game is over";
+            return reply(moveReplyToJson(out));
+        }
+        engine->engine->setBudget(request.timeBudgetMs > 0 ? request.timeBudgetMs : engine->search.timeBudgetMs,
+                                  request.maxIterations > 0 ? request.maxIterations : engine->search.maxIterations);
+        searchMove(*engine->engine, request, ++engine->moves, out);
+        return reply(moveReplyToJson(out));
+    });
+}
+
+} // extern "C"
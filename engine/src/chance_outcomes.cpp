@@ -0,0 +1,211 @@
+#include "bb/chance_outcomes.h"
+#include "bb/action_resolver.h"
+#include "bb/block_handler.h"
+#include "bb/block_odds.h"
+#include "bb/helpers.h"
+#include "bb/risk_oracle.h"
+
+namespace bb {
+
+namespace {
+
+constexpr float MIN_PROBABILITY = 1e-6f;
+
+// A band of the 2d6 armour roll: held or broken (and, split on doubles, a
+// double or not), with its chance and the first pair that rolls it.
+struct ArmourBand {
+    float probability = 0.0f;
+    uint8_t die1 = 0;
+    uint8_t die2 = 0;
+    bool broken = false;
+};
+
+int armourBands(int av, int modifier, bool claw, bool splitDoubles, ArmourBand* bands) {
+    ArmourBand byKey[4];
+    for (int d1 = 1; d1 <= 6; ++d1) {
+        for (int d2 = 1; d2 <= 6; ++d2) {
+            int roll = d1 + d2 + modifier;
+            bool broken = roll > av || (claw && roll >= 8);
+            ArmourBand& b = byKey[(broken ? 2 : 0) | (splitDoubles && d1 == d2 ? 1 : 0)];
+            if (b.probability == 0.0f) {
+                b.die1 = static_cast<uint8_t>(d1);
+                b.die2 = static_cast<uint8_t>(d2);
+                b.broken = broken;
+            }
+            b.probability += 1.0f / 36.0f;
+        }
+    }
+    int n = 0;
+    for (const ArmourBand& b : byKey) {
+        if (b.probability > 0.0f) bands[n++] = b;
+    }
+    return n;
+}
+
+uint8_t rollOfFace(BlockDiceFace face) {
+    switch (face) {
+        case BlockDiceFace::ATTACKER_DOWN: return 1;
+        case BlockDiceFace::BOTH_DOWN: return 2;
+        case BlockDiceFace::PUSHED: return 3;
+        case BlockDiceFace::DEFENDER_STUMBLES: return 5;
+        case BlockDiceFace::DEFENDER_DOWN: return 6;
+    }
+    return 3;
+}
+
+// resolveAction's pre-action rolls
+bool hasBigGuyCheck(const Player& p) {
+    return p.hasSkill(SkillName::BoneHead) || p.hasSkill(SkillName::ReallyStupid) ||
+           p.hasSkill(SkillName::WildAnimal) || p.hasSkill(SkillName::TakeRoot) ||
+           p.hasSkill(SkillName::Bloodlust);
+}
+
+const GameEvent* firstEvent(const std::vector<GameEvent>& events, GameEvent::Type type,
+                            int playerId) {
+    for (const GameEvent& e : events) {
+        if (e.type == type && e.playerId == playerId) return &e;
+    }
+    return nullptr;
+}
+
+// Plays `outcome`'s script on a copy of `state`: true if every scripted
+// face was read and `check` holds on the events
+template <typename Check>
+bool reproduces(const GameState& state, const Action& action, const ChanceOutcome& outcome,
+                DiceRollerBase& fallback, Check check) {
+    GameState copy = state.clone();
+    OutcomeDiceRoller dice(outcome.script, outcome.length, fallback);
+    std::vector<GameEvent> events;
+    executeAction(copy, action, dice, &events);
+    return dice.consumed() == outcome.length && check(events);
+}
+
+bool blockOutcomes(const GameState& state, const Action& action, DiceRollerBase& fallback,
+                   std::vector<ChanceOutcome>& out) {
+    const Player& att = state.getPlayer(action.playerId);
+    const Player& def = state.getPlayer(action.targetId);
+    bool isBlitz = action.type == ActionType::BLITZ;
+    if (att.state != PlayerState::STANDING || att.position.distanceTo(def.position) != 1) {
+        return false;
+    }
+    if (hasBigGuyCheck(att) || def.hasSkill(SkillName::FoulAppearance) ||
+        att.hasSkill(SkillName::Chainsaw) || att.hasSkill(SkillName::Stab) ||
+        att.hasSkill(SkillName::Dauntless) || (isBlitz && att.hasSkill(SkillName::Juggernaut))) {
+        return false;
+    }
+
+    BlockDiceInfo info = blockDice(state, att, def, isBlitz);
+    BlockSkills skills = blockSkills(att, def);
+    RerollAccess access = RiskOracle::access(state, att);
+    const BlockOdds& odds = blockOdds(info.count, info.attackerChooses, skills, access);
+
+    for (int o = 0; o < static_cast<int>(BlockOutcome::COUNT); ++o) {
+        BlockOutcome outcome = static_cast<BlockOutcome>(o);
+        float p = odds[outcome];
+        if (p < MIN_PROBABILITY) continue;
+
+        BlockDiceFace face = BlockDiceFace::PUSHED;
+        for (int f = 0; f < 5; ++f) {
+            if (blockOutcome(static_cast<BlockDiceFace>(f), skills) == outcome) {
+                face = static_cast<BlockDiceFace>(f);
+                break;
+            }
+        }
+        ChanceOutcome block;
+        block.probability = p;
+        auto rollAll = [&] {
+            for (int i = 0; i < info.count; ++i) block.script[block.length++] = rollOfFace(face);
+        };
+        rollAll();
+        if (shouldRerollBlock(face, skills.attBlock) && (access.pro || access.team)) {
+            if (access.pro || access.loner) block.script[block.length++] = 4;  // Pro / Loner 4+
+            rollAll();
+        }
+        auto chosen = [&](const std::vector<GameEvent>& events) {
+            const GameEvent* e = firstEvent(events, GameEvent::Type::BLOCK, att.id);
+            return e && e->roll == static_cast<int>(face);
+        };
+        if (!reproduces(state, action, block, fallback, chosen)) return false;
+
+        const Player* victim = outcome == BlockOutcome::DEFENDER_DOWN ? &def
+                             : outcome == BlockOutcome::ATTACKER_DOWN ? &att
+                             : nullptr;
+        if (victim) {
+            bool byAttacker = victim == &def;
+            ArmourBand bands[4];
+            int n = armourBands(victim->stats().armour,
+                                byAttacker && att.hasSkill(SkillName::MightyBlow) ? 1 : 0,
+                                byAttacker && att.hasSkill(SkillName::Claw), false, bands);
+            size_t first = out.size();
+            bool split = n > 1;
+            for (int b = 0; split && b < n; ++b) {
+                ChanceOutcome banded = block;
+                banded.probability = p * bands[b].probability;
+                banded.script[banded.length++] = bands[b].die1;
+                banded.script[banded.length++] = bands[b].die2;
+                split = reproduces(state, action, banded, fallback, [&](const std::vector<GameEvent>& events) {
+                    const GameEvent* e = firstEvent(events, GameEvent::Type::ARMOR_BREAK, victim->id);
+                    return chosen(events) && e && e->success == bands[b].broken;
+                });
+                out.push_back(banded);
+            }
+            if (split) continue;
+            out.resize(first);
+        }
+        out.push_back(block);
+    }
+    return true;
+}
+
+bool foulOutcomes(const GameState& state, const Action& action, DiceRollerBase& fallback,
+                  std::vector<ChanceOutcome>& out) {
+    const Player& fouler = state.getPlayer(action.playerId);
+    const Player& target = state.getPlayer(action.targetId);
+    if (hasBigGuyCheck(fouler)) return false;
+    if (target.state != PlayerState::PRONE && target.state != PlayerState::STUNNED) return false;
+
+    // resolveFoul's modifier
+    int modifier = countAssists(state, target.position, fouler.teamSide, fouler.id, target.id) -
+                   countAssists(state, fouler.position, target.teamSide, fouler.id, target.id);
+    if (fouler.hasSkill(SkillName::DirtyPlayer)) modifier += 1;
+
+    ArmourBand bands[4];
+    int n = armourBands(target.stats().armour, modifier, false,
+                        !fouler.hasSkill(SkillName::SneakyGit), bands);
+    for (int b = 0; b < n; ++b) {
+        ChanceOutcome foul;
+        foul.probability = bands[b].probability;
+        foul.script[foul.length++] = bands[b].die1;
+        foul.script[foul.length++] = bands[b].die2;
+        bool ok = reproduces(state, action, foul, fallback, [&](const std::vector<GameEvent>& events) {
+            const GameEvent* e = firstEvent(events, GameEvent::Type::FOUL, fouler.id);
+            return e && e->success == bands[b].broken;
+        });
+        if (!ok) return false;
+        out.push_back(foul);
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+bool enumerateChanceOutcomes(const GameState& state, const Action& action,
+                             DiceRollerBase& fallback, std::vector<ChanceOutcome>& out) {
+    out.clear();
+    bool ok = false;
+    switch (action.type) {
+        case ActionType::BLOCK:
+        case ActionType::BLITZ:
+            ok = blockOutcomes(state, action, fallback, out);
+            break;
+        case ActionType::FOUL:
+            ok = foulOutcomes(state, action, fallback, out);
+            break;
+        default:
+            break;
+    }
+    if (!ok) out.clear();
+    return ok;
+}
+
+} // namespace bb
@@ -0,0 +1,359 @@
+#include "bb/conv_network.h"
+#include "bb/profile.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace bb {
+
+namespace {
+
+// The run of padded-plane cells one output plane is computed over: from the
+// first board square to the last, border columns in between included.
+constexpr int RUN_START = CONV_ROW + 1;
+constexpr int RUN_LENGTH = BOARD_PLANE_HEIGHT * CONV_ROW - 2;
+static_assert(RUN_START - CONV_ROW - 1 >= 0 && RUN_START + RUN_LENGTH + CONV_ROW + 1 <= CONV_PLANE,
+              "every tap of the run stays inside its plane");
+
+constexpr int TAPS[9] = {
+    -CONV_ROW - 1, -CONV_ROW, -CONV_ROW + 1,
+    -1, 0, 1,
+    CONV_ROW - 1, CONV_ROW, CONV_ROW + 1,
+};
+
+constexpr int paddedIndex(int square) {
+    return (square / BOARD_PLANE_WIDTH + 1) * CONV_ROW + square % BOARD_PLANE_WIDTH + 1;
+}
+
+// 1 on board squares, 0 on the border and the SIMD tail.
+constexpr std::array<float, CONV_PLANE> makeBoardMask() {
+    std::array<float, CONV_PLANE> m{};
+    for (int sq = 0; sq < BOARD_PLANE_SIZE; ++sq) m[paddedIndex(sq)] = 1.0f;
+    return m;
+}
+
+alignas(SIMD_ALIGN) constexpr std::array<float, CONV_PLANE> BOARD_MASK = makeBoardMask();
+
+// acc[p] += sum over the 9 taps of w[t] * in[p + TAPS[t]], for p in [0, n).
+// The accumulator stays in a register across all nine taps.
+void conv3x3(float* acc, const float* in, const float* w, int n) {
+    int p = 0;
+#if defined(__AVX2__)
+    __m256 wv[9];
+    for (int t = 0; t < 9; ++t) wv[t] = _mm256_set1_ps(w[t]);
+    for (; p + 8 <= n; p += 8) {
+        __m256 a = _mm256_loadu_ps(acc + p);
+        for (int t = 0; t < 9; ++t) {
+#if defined(__FMA__)
+            a = _mm256_fmadd_ps(wv[t], _mm256_loadu_ps(in + p + TAPS[t]), a);
+#else
+            a = _mm256_add_ps(a, _mm256_mul_ps(wv[t], _mm256_loadu_ps(in + p + TAPS[t])));
+#endif
+        }
+        _mm256_storeu_ps(acc + p, a);
+    }
+#elif defined(__wasm_simd128__)
+    v128_t wv[9];
+    for (int t = 0; t < 9; ++t) wv[t] = wasm_f32x4_splat(w[t]);
+    for (; p + 4 <= n; p += 4) {
+        v128_t a = wasm_v128_load(acc + p);
+        for (int t = 0; t < 9; ++t) a = wasm_f32x4_add(a, wasm_f32x4_mul(wv[t], wasm_v128_load(in + p + TAPS[t])));
+        wasm_v128_store(acc + p, a);
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    __m128 wv[9];
+    for (int t = 0; t < 9; ++t) wv[t] = _mm_set1_ps(w[t]);
+    for (; p + 4 <= n; p += 4) {
+        __m128 a = _mm_loadu_ps(acc + p);
+        for (int t = 0; t < 9; ++t) a = _mm_add_ps(a, _mm_mul_ps(wv[t], _mm_loadu_ps(in + p + TAPS[t])));
+        _mm_storeu_ps(acc + p, a);
+    }
+#elif defined(__ARM_NEON)
+    float32x4_t wv[9];
+    for (int t = 0; t < 9; ++t) wv[t] = vdupq_n_f32(w[t]);
+    for (; p + 4 <= n; p += 4) {
+        float32x4_t a = vld1q_f32(acc + p);
+        for (int t = 0; t < 9; ++t) a = vmlaq_f32(a, wv[t], vld1q_f32(in + p + TAPS[t]));
+        vst1q_f32(acc + p, a);
+    }
+#endif
+    for (; p < n; ++p) {
+        float a = acc[p];
+        for (int t = 0; t < 9; ++t) a += w[t] * in[p + TAPS[t]];
+        acc[p] = a;
+    }
+}
+
+// Activation buffers, grown once per thread and reused by every call: two
+// ping-pong stacks of maxChannels padded planes.
+float* scratch(int maxChannels) {
+    thread_local AlignedVector<float> buffer;
+    size_t need = 2 * static_cast<size_t>(maxChannels) * CONV_PLANE;
+    if (buffer.size() < need) buffer.resize(need);
+    return buffer.data();
+}
+
+void checkSize(const std::vector<float>& v, size_t n, const char* what) {
+    if (v.size() != n) throw std::invalid_argument(std::string("ConvNet: bad ") + what + " size");
+}
+
+} // anonymous namespace
+
+// --- ConvNet ---
+
+ConvNet::ConvNet(std::vector<ConvLayer> trunk,
+                 std::vector<float> valueW1, std::vector<float> valueB1,
+                 std::vector<float> valueW2, float valueB2,
+                 std::vector<float> policyW, std::vector<float> policyB)
+    : trunk_(std::move(trunk)), valueW1_(std::move(valueW1)), valueB1_(std::move(valueB1)),
+      valueW2_(std::move(valueW2)), valueB2_(valueB2),
+      policyW_(std::move(policyW)), policyB_(std::move(policyB)) {
+    if (trunk_.empty()) throw std::invalid_argument("ConvNet: no trunk layers");
+    int in = NUM_BOARD_PLANES;
+    for (const ConvLayer& l : trunk_) {
+        if (l.inChannels != in || l.outChannels <= 0) {
+            throw std::invalid_argument("ConvNet: layer channels do not chain");
+        }
+        checkSize(l.weights, static_cast<size_t>(l.outChannels) * l.inChannels * 9, "layer weights");
+        checkSize(l.bias, static_cast<size_t>(l.outChannels), "layer bias");
+        maxChannels_ = std::max(maxChannels_, l.outChannels);
+        in = l.outChannels;
+    }
+    size_t c = static_cast<size_t>(channels());
+    if (valueB1_.empty()) throw std::invalid_argument("ConvNet: empty value head");
+    checkSize(valueW1_, valueB1_.size() * c, "value W1");
+    checkSize(valueW2_, valueB1_.size(), "value W2");
+    checkSize(policyW_, CONV_POLICY_PLANES * c, "policy weights");
+    checkSize(policyB_, CONV_POLICY_PLANES, "policy bias");
+}
+
+const float* ConvNet::forward(const float* planes) const {
+    float* cur = scratch(maxChannels_);
+    float* next = cur + static_cast<size_t>(maxChannels_) * CONV_PLANE;
+
+    std::fill(cur, cur + static_cast<size_t>(NUM_BOARD_PLANES) * CONV_PLANE, 0.0f);
+    for (int c = 0; c < NUM_BOARD_PLANES; ++c) {
+        const float* src = planes + c * BOARD_PLANE_SIZE;
+        float* dst = cur + c * CONV_PLANE;
+        for (int y = 0; y < BOARD_PLANE_HEIGHT; ++y) {
+            std::memcpy(dst + (y + 1) * CONV_ROW + 1, src + y * BOARD_PLANE_WIDTH,
+                        BOARD_PLANE_WIDTH * sizeof(float));
+        }
+    }
+
+    for (const ConvLayer& l : trunk_) {
+        for (int o = 0; o < l.outChannels; ++o) {
+            float* acc = next + o * CONV_PLANE;
+            std::fill(acc, acc + CONV_PLANE, 0.0f);
+            std::fill(acc + RUN_START, acc + RUN_START + RUN_LENGTH, l.bias[o]);
+            const float* w = &l.weights[static_cast<size_t>(o) * l.inChannels * 9];
+            for (int i = 0; i < l.inChannels; ++i) {
+                conv3x3(acc + RUN_START, cur + i * CONV_PLANE + RUN_START, w + i * 9, RUN_LENGTH);
+            }
+            for (int p = RUN_START; p < RUN_START + RUN_LENGTH; ++p) {
+                acc[p] = std::max(acc[p], 0.0f) * BOARD_MASK[p];
+            }
+        }
+        std::swap(cur, next);
+    }
+    return cur;
+}
+
+void ConvNet::pool(const float* act, float* out) const {
+    // Border cells are zero, so a plain sum over the plane is the board sum
+    for (int c = 0; c < channels(); ++c) {
+        const float* plane = act + c * CONV_PLANE;
+        float sum = 0.0f;
+        for (int p = 0; p < CONV_PLANE; ++p) sum += plane[p];
+        out[c] = sum * (1.0f / BOARD_PLANE_SIZE);
+    }
+}
+
+float ConvNet::valueHead(const float* pooled) const {
+    float v = valueB2_;
+    int c = channels();
+    for (int h = 0; h < valueHidden(); ++h) {
+        float z = valueB1_[h] + dotProduct(&valueW1_[static_cast<size_t>(h) * c], pooled, c);
+        if (z > 0.0f) v += valueW2_[h] * z;
+    }
+    return v;
+}
+
+float ConvNet::value(const float* planes) const {
+    std::vector<float> pooled(static_cast<size_t>(channels()));
+    pool(forward(planes), pooled.data());
+    return valueHead(pooled.data());
+}
+
+void ConvNet::values(const float* planes, int batch, float* out) const {
+    std::vector<float> pooled(static_cast<size_t>(channels()));
+    for (int b = 0; b < batch; ++b) {
+        pool(forward(planes + static_cast<size_t>(b) * CONV_INPUT_SIZE), pooled.data());
+        out[b] = valueHead(pooled.data());
+    }
+}
+
+void ConvNet::policyLogits(const float* planes, TeamSide perspective, const Action* actions,
+                           int numActions, float* out) const {
+    const float* act = forward(planes);
+    int c = channels();
+    std::vector<float> pooled(static_cast<size_t>(c));
+    pool(act, pooled.data());
+    for (int a = 0; a < numActions; ++a) {
+        int type = static_cast<int>(actions[a].type);
+        const float* w = &policyW_[static_cast<size_t>(type) * c];
+        Position t = actions[a].target;
+        if (!t.isOnPitch()) {
+            out[a] = policyB_[type] + dotProduct(w, pooled.data(), c);
+            continue;
+        }
+        int x = perspective == TeamSide::AWAY ? BOARD_PLANE_WIDTH - 1 - t.x : t.x;
+        int cell = paddedIndex(t.y * BOARD_PLANE_WIDTH + x);
+        float logit = policyB_[type];
+        for (int k = 0; k < c; ++k) logit += w[k] * act[k * CONV_PLANE + cell];
+        out[a] = logit;
+    }
+}
+
+// --- ConvValueFunction ---
+
+ConvValueFunction::ConvValueFunction(std::shared_ptr<const ConvNet> net) : net_(std::move(net)) {}
+
+float ConvValueFunction::evaluate(const float* planes, int numFeatures) const {
+    BB_PROFILE_NAMED_SCOPE(profile, prof::VALUE_EVAL);
+    BB_PROFILE_UNITS(profile, 1);
+    if (numFeatures != CONV_INPUT_SIZE) {
+        throw std::invalid_argument("ConvValueFunction: input is not a board-plane row");
+    }
+    return net_->value(planes);
+}
+
+void ConvValueFunction::evaluateBatch(const float* planes, int batch, int numFeatures,
+                                      float* out) const {
+    BB_PROFILE_NAMED_SCOPE(profile, prof::VALUE_EVAL);
+    BB_PROFILE_UNITS(profile, batch);
+    if (numFeatures != CONV_INPUT_SIZE) {
+        throw std::invalid_argument("ConvValueFunction: input is not a board-plane row");
+    }
+    net_->values(planes, batch, out);
+}
+
+void ConvValueFunction::encodeState(const GameState& state, TeamSide perspective, float* out) const {
+    extractBoardPlanes(state, perspective, out);
+}
+
+// --- ConvPolicyNetwork ---
+
+ConvPolicyNetwork::ConvPolicyNetwork(std::shared_ptr<const ConvNet> net, float temperature)
+    : net_(std::move(net)), temperature_(temperature) {}
+
+void ConvPolicyNetwork::computePriors(const GameState& state, const Action* actions,
+                                      int numActions, float* outPriors) const {
+    if (numActions <= 0) return;
+    if (numActions == 1) {
+        outPriors[0] = 1.0f;
+        return;
+    }
+
+    thread_local std::vector<float> planes;
+    planes.resize(CONV_INPUT_SIZE);
+    extractBoardPlanes(state, state.activeTeam, planes.data());
+    net_->policyLogits(planes.data(), state.activeTeam, actions, numActions, outPriors);
+
+    float maxLogit = -1e30f;
+    for (int i = 0; i < numActions; ++i) {
+        outPriors[i] /= temperature_;
+        maxLogit = std::max(maxLogit, outPriors[i]);
+    }
+    float sumExp = 0.0f;
+    for (int i = 0; i < numActions; ++i) {
+        outPriors[i] = std::exp(outPriors[i] - maxLogit);
+        sumExp += outPriors[i];
+    }
+    for (int i = 0; i < numActions; ++i) outPriors[i] /= sumExp;
+}
+
+// --- Weights file ---
+
+struct ConvNetAccess {
+    static const std::vector<ConvLayer>& trunk(const ConvNet& n) { return n.trunk_; }
+    static ConvFileHeader header(const ConvNet& n) {
+        ConvFileHeader h;
+        h.layers = static_cast<int32_t>(n.trunk_.size());
+        h.channels = n.channels();
+        h.valueHidden = n.valueHidden();
+        h.valueB2 = n.valueB2_;
+        return h;
+    }
+    static std::vector<const std::vector<float>*> heads(const ConvNet& n) {
+        return {&n.valueW1_, &n.valueB1_, &n.valueW2_, &n.policyW_, &n.policyB_};
+    }
+};
+
+bool isConvNetFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    uint32_t magic = 0;
+    if (!file.read(reinterpret_cast<char*>(&magic), sizeof(magic))) return false;
+    return magic == CONV_FILE_MAGIC;
+}
+
+std::shared_ptr<const ConvNet> loadConvNet(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    ConvFileHeader h;
+    if (!file.read(reinterpret_cast<char*>(&h), sizeof(h))) return nullptr;
+    if (h.magic != CONV_FILE_MAGIC || h.version != CONV_FILE_VERSION ||
+        h.inputPlanes != NUM_BOARD_PLANES || h.policyPlanes != CONV_POLICY_PLANES ||
+        h.layers <= 0 || h.layers > 64 || h.channels <= 0 || h.channels > 1024 ||
+        h.valueHidden <= 0 || h.valueHidden > 65536) return nullptr;
+
+    auto readArray = [&](size_t n, std::vector<float>& out) {
+        out.resize(n);
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(out.data()),
+                                           static_cast<std::streamsize>(n * sizeof(float))));
+    };
+
+    std::vector<ConvLayer> trunk(static_cast<size_t>(h.layers));
+    size_t c = static_cast<size_t>(h.channels);
+    for (int l = 0; l < h.layers; ++l) {
+        ConvLayer& layer = trunk[l];
+        layer.inChannels = l == 0 ? NUM_BOARD_PLANES : h.channels;
+        layer.outChannels = h.channels;
+        if (!readArray(c * layer.inChannels * 9, layer.weights) || !readArray(c, layer.bias)) {
+            return nullptr;
+        }
+    }
+    size_t hidden = static_cast<size_t>(h.valueHidden);
+    std::vector<float> w1, b1, w2, pw, pb;
+    if (!readArray(hidden * c, w1) || !readArray(hidden, b1) || !readArray(hidden, w2) ||
+        !readArray(CONV_POLICY_PLANES * c, pw) || !readArray(CONV_POLICY_PLANES, pb)) {
+        return nullptr;
+    }
+    return std::make_shared<const ConvNet>(std::move(trunk), std::move(w1), std::move(b1),
+                                           std::move(w2), h.valueB2, std::move(pw), std::move(pb));
+}
+
+bool writeConvNet(const std::string& path, const ConvNet& net) {
+    // The file format has one width for every trunk layer
+    for (const ConvLayer& l : ConvNetAccess::trunk(net)) {
+        if (l.outChannels != net.channels()) return false;
+    }
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+    ConvFileHeader h = ConvNetAccess::header(net);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    auto writeArray = [&](const std::vector<float>& v) {
+        out.write(reinterpret_cast<const char*>(v.data()),
+                  static_cast<std::streamsize>(v.size() * sizeof(float)));
+    };
+    for (const ConvLayer& l : ConvNetAccess::trunk(net)) {
+        writeArray(l.weights);
+        writeArray(l.bias);
+    }
+    for (const std::vector<float>* v : ConvNetAccess::heads(net)) writeArray(*v);
+    return static_cast<bool>(out);
+}
+
+} // namespace bb
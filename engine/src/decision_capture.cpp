@@ -0,0 +1,256 @@
+#include "bb/decision_capture.h"
+#include "bb/macro_mcts.h"
+#include "bb/move_server.h"
+#include "bb/state_io.h"
+#include "bb/sweep.h"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace bb {
+
+using nlohmann::json;
+
+namespace {
+
+constexpr int CAPTURE_VERSION = 1;
+
+json statsToJson(const SearchStats& s) {
+    return {
+        {"iterations", s.iterations},
+        {"total_ms", s.totalMs},
+        {"select_ms", s.selectMs},
+        {"replay_ms", s.replayMs},
+        {"expand_ms", s.expandMs},
+        {"simulate_ms", s.simulateMs},
+        {"backprop_ms", s.backpropMs},
+        {"nodes_allocated", s.nodesAllocated},
+        {"max_depth", s.maxDepth},
+        {"avg_depth", s.avgDepth},
+        {"truncated_replays", s.truncatedReplays},
+        {"leaf_evals", s.leafEvals},
+        {"cached_replays", s.cachedReplays},
+        {"lookahead_reuses", s.lookaheadReuses},
+        {"prior_cache_hits", s.priorCacheHits},
+        {"prior_cache_misses", s.priorCacheMisses},
+        {"recycle_sweeps", s.recycleSweeps},
+        {"recycled_nodes", s.recycledNodes},
+        {"expansions_skipped", s.expansionsSkipped},
+        {"stopped_early", s.stoppedEarly},
+        {"root_cache_hit", s.rootCacheHit},
+        {"iterations_per_sec", s.iterationsPerSec},
+        {"allocations", s.allocations},
+        {"allocated_bytes", s.allocatedBytes},
+        {"peak_live_bytes", s.peakLiveBytes},
+    };
+}
+
+SearchStats statsFromJson(const json& j) {
+    SearchStats s;
+    s.iterations = j.value("iterations", 0);
+    s.totalMs = j.value("total_ms", 0.0);
+    s.selectMs = j.value("select_ms", 0.0);
+    s.replayMs = j.value("replay_ms", 0.0);
+    s.expandMs = j.value("expand_ms", 0.0);
+    s.simulateMs = j.value("simulate_ms", 0.0);
+    s.backpropMs = j.value("backprop_ms", 0.0);
+    s.nodesAllocated = j.value("nodes_allocated", 0);
+    s.maxDepth = j.value("max_depth", 0);
+    s.avgDepth = j.value("avg_depth", 0.0);
+    s.truncatedReplays = j.value("truncated_replays", 0);
+    s.leafEvals = j.value("leaf_evals", 0);
+    s.cachedReplays = j.value("cached_replays", 0);
+    s.lookaheadReuses = j.value("lookahead_reuses", 0);
+    s.priorCacheHits = j.value("prior_cache_hits", 0);
+    s.priorCacheMisses = j.value("prior_cache_misses", 0);
+    s.recycleSweeps = j.value("recycle_sweeps", 0);
+    s.recycledNodes = j.value("recycled_nodes", 0);
+    s.expansionsSkipped = j.value("expansions_skipped", 0);
+    s.stoppedEarly = j.value("stopped_early", false);
+    s.rootCacheHit = j.value("root_cache_hit", false);
+    s.iterationsPerSec = j.value("iterations_per_sec", 0.0);
+    s.allocations = j.value("allocations", uint64_t{0});
+    s.allocatedBytes = j.value("allocated_bytes", uint64_t{0});
+    s.peakLiveBytes = j.value("peak_live_bytes", int64_t{0});
+    return s;
+}
+
+std::string hex(uint64_t v) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(v));
+    return buf;
+}
+
+bool sameMacro(const Macro& a, const Macro& b) {
+    return a.type == b.type && a.playerId == b.playerId && a.targetId == b.targetId &&
+           a.targetPos == b.targetPos && a.thirdId == b.thirdId;
+}
+
+} // anonymous namespace
+
+void recordDecisionOutcome(DecisionCapture& capture, const MacroMCTSSearch& search, double searchMs) {
+    capture.reusedVisits = search.lastReusedVisits();
+    capture.searchMs = searchMs;
+    capture.stats = search.lastStats();
+}
+
+std::string decisionCaptureToJson(const DecisionCapture& c) {
+    json config = json::object();
+    for (const auto& [field, value] : searchParameters(c.config)) config[field] = value;
+    json j = {
+        {"version", CAPTURE_VERSION},
+        {"reason", c.reason},
+        {"state_b64", encodeBase64(serializeState(c.state))},
+        {"config", std::move(config)},
+        {"seed", c.seed},
+        {"dice_b64", encodeBase64(c.dice)},
+        {"value_path", c.valuePath},
+        {"policy_path", c.policyPath},
+        {"model_key", hex(c.modelKey)},
+        {"model_version", c.modelVersion},
+        {"reused_visits", c.reusedVisits},
+        {"macro", {
+            {"type", macroTypeName(c.macro.type)},
+            {"type_id", static_cast<int>(c.macro.type)},
+            {"player", c.macro.playerId},
+            {"target_player", c.macro.targetId},
+            {"x", c.macro.targetPos.x},
+            {"y", c.macro.targetPos.y},
+            {"third_player", c.macro.thirdId},
+        }},
+        {"search_ms", c.searchMs},
+        {"stats", statsToJson(c.stats)},
+    };
+    return j.dump(1);
+}
+
+std::optional<DecisionCapture> decisionCaptureFromJson(const std::string& text) {
+    json j = json::parse(text, nullptr, false);
+    if (j.is_discarded() || !j.is_object() || j.value("version", 0) != CAPTURE_VERSION) return std::nullopt;
+    try {
+        DecisionCapture c;
+        c.reason = j.value("reason", std::string());
+        std::vector<uint8_t> bytes;
+        if (!decodeBase64(j.at("state_b64").get<std::string>(), bytes)) return std::nullopt;
+        std::optional<GameState> state = deserializeState(bytes.data(), bytes.size());
+        if (!state) return std::nullopt;
+        c.state = std::move(*state);
+        for (const auto& [field, value] : j.at("config").items()) {
+            if (!setSearchParameter(c.config, field, value.get<double>())) return std::nullopt;
+        }
+        c.seed = j.value("seed", 0u);
+        if (!decodeBase64(j.value("dice_b64", std::string()), c.dice)) return std::nullopt;
+        if (!c.dice.empty()) {
+            FastDiceRoller probe(0);
+            if (!deserializeDice(probe, c.dice.data(), c.dice.size())) return std::nullopt;
+        }
+        c.valuePath = j.value("value_path", std::string());
+        c.policyPath = j.value("policy_path", std::string());
+        c.modelKey = std::stoull(j.value("model_key", std::string("0")), nullptr, 16);
+        c.modelVersion = j.value("model_version", uint64_t{0});
+        c.reusedVisits = j.value("reused_visits", 0);
+        const json& m = j.at("macro");
+        c.macro.type = static_cast<MacroType>(m.at("type_id").get<int>());
+        c.macro.playerId = m.value("player", -1);
+        c.macro.targetId = m.value("target_player", -1);
+        c.macro.targetPos = {static_cast<int8_t>(m.value("x", -1)), static_cast<int8_t>(m.value("y", -1))};
+        c.macro.thirdId = m.value("third_player", -1);
+        c.searchMs = j.value("search_ms", 0.0);
+        if (j.contains("stats")) c.stats = statsFromJson(j["stats"]);
+        return c;
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+bool saveDecisionCapture(const DecisionCapture& capture, const std::string& path) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << decisionCaptureToJson(capture) << "\n";
+    return static_cast<bool>(out);
+}
+
+std::optional<DecisionCapture> loadDecisionCapture(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) return std::nullopt;
+    std::stringstream text;
+    text << in.rdbuf();
+    return decisionCaptureFromJson(text.str());
+}
+
+// --- SlowDecisionMonitor ---
+
+SlowDecisionMonitor::SlowDecisionMonitor(SlowDecisionConfig config) : config_(std::move(config)) {}
+
+std::string SlowDecisionMonitor::observe(double searchMs, int iterations) {
+    if (!enabled()) return "";
+    std::lock_guard<std::mutex> lock(mutex_);
+    char reason[96] = "";
+    if (config_.thresholdMs > 0.0 && searchMs > config_.thresholdMs) {
+        std::snprintf(reason, sizeof(reason), "%.0f ms over %.0f ms", searchMs, config_.thresholdMs);
+    }
+    if (iterations > 0) {
+        double perIteration = searchMs / iterations;
+        if (!reason[0] && config_.outlierFactor > 0.0 && observed_ >= config_.warmup &&
+            perIteration > config_.outlierFactor * meanMsPerIteration_) {
+            std::snprintf(reason, sizeof(reason), "%.3f ms per iteration, %.1fx the mean",
+                          perIteration, perIteration / meanMsPerIteration_);
+        }
+        // The mean of every search so far, outliers included
+        ++observed_;
+        meanMsPerIteration_ += (perIteration - meanMsPerIteration_) / observed_;
+    }
+    if (!reason[0] || captures_ >= config_.maxCaptures) return "";
+    ++captures_;
+    return reason;
+}
+
+std::string SlowDecisionMonitor::write(const DecisionCapture& capture) {
+    std::error_code ec;
+    std::filesystem::create_directories(config_.dir, ec);
+    // Timestamped, so restarts do not overwrite earlier captures
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    int n;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        n = written_++;
+    }
+    char name[64];
+    std::snprintf(name, sizeof(name), "/decision-%lld-%d.json",
+                  static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count()), n);
+    std::string path = config_.dir + name;
+    return saveDecisionCapture(capture, path) ? path : "";
+}
+
+int SlowDecisionMonitor::captures() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return captures_;
+}
+
+// --- Replay ---
+
+DecisionReplay replayDecision(const DecisionCapture& capture, const ValueFunction* valueFn,
+                              const PolicyNetwork* policy, bool sameIterations) {
+    MCTSConfig config = capture.config;
+    config.policy = policy;
+    if (sameIterations && capture.stats.iterations > 0) {
+        config.timeBudgetMs = 0;
+        config.maxIterations = capture.stats.iterations;
+    }
+    MacroMCTSSearch search(valueFn, config, capture.seed);
+    if (!capture.dice.empty()) deserializeDice(search.dice(), capture.dice.data(), capture.dice.size());
+
+    DecisionReplay replay;
+    auto start = std::chrono::steady_clock::now();
+    replay.macro = search.search(capture.state);
+    replay.searchMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    replay.iterations = search.lastIterations();
+    replay.stats = search.lastStats();
+    replay.sameMacro = sameMacro(replay.macro, capture.macro);
+    return replay;
+}
+
+} // namespace bb
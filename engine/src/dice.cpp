@@ -1,24 +1,314 @@
 #include "bb/dice.h"
+#include <cstring>
+#include <sstream>
 #include <stdexcept>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace bb {
 
+// --- Saved state ---
+
+namespace {
+
+// First byte of a saved roller, so state restores into the same kind only.
+enum SavedRoller : uint8_t { SAVED_MT19937 = 1, SAVED_XOSHIRO = 2, SAVED_BUFFERED = 3 };
+
+// mt19937 streams out its 624 state words and then its position.
+constexpr size_t MT_WORDS = std::mt19937::state_size + 1;
+
+void put(std::vector<uint8_t>& out, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+bool take(const uint8_t*& in, const uint8_t* end, void* data, size_t size) {
+    if (static_cast<size_t>(end - in) < size) return false;
+    std::memcpy(data, in, size);
+    in += size;
+    return true;
+}
+
+bool takeTag(const uint8_t*& in, const uint8_t* end, SavedRoller tag) {
+    uint8_t got = 0;
+    return take(in, end, &got, 1) && got == tag;
+}
+
+} // anonymous namespace
+
+bool DiceRollerBase::saveState(std::vector<uint8_t>&) const { return false; }
+bool DiceRollerBase::restoreState(const uint8_t*&, const uint8_t*) { return false; }
+
 // --- DiceRoller ---
 
 DiceRoller::DiceRoller(uint32_t seed) : rng_(seed) {}
 
 DiceRoller::DiceRoller() : rng_(std::random_device{}()) {}
 
-int DiceRoller::rollD6() {
+int DiceRoller::d6() {
     std::uniform_int_distribution<int> dist(1, 6);
     return dist(rng_);
 }
 
-int DiceRoller::rollD8() {
+int DiceRoller::d8() {
     std::uniform_int_distribution<int> dist(1, 8);
     return dist(rng_);
 }
 
+bool DiceRoller::saveState(std::vector<uint8_t>& out) const {
+    std::stringstream text;
+    text << rng_;
+    uint32_t words[MT_WORDS];
+    for (uint32_t& w : words) {
+        if (!(text >> w)) return false;
+    }
+    out.push_back(SAVED_MT19937);
+    put(out, words, sizeof(words));
+    return true;
+}
+
+bool DiceRoller::restoreState(const uint8_t*& in, const uint8_t* end) {
+    const uint8_t* p = in;
+    uint32_t words[MT_WORDS];
+    if (!takeTag(p, end, SAVED_MT19937) || !take(p, end, words, sizeof(words))) return false;
+    std::stringstream text;
+    for (uint32_t w : words) text << w << ' ';
+    std::mt19937 rng;
+    if (!(text >> rng)) return false;
+    rng_ = rng;
+    in = p;
+    return true;
+}
+
+// --- FastDiceRoller ---
+
+bool FastDiceRoller::saveState(std::vector<uint8_t>& out) const {
+    out.push_back(SAVED_XOSHIRO);
+    put(out, gen_.s, sizeof(gen_.s));
+    return true;
+}
+
+bool FastDiceRoller::restoreState(const uint8_t*& in, const uint8_t* end) {
+    const uint8_t* p = in;
+    uint64_t words[4];
+    if (!takeTag(p, end, SAVED_XOSHIRO) || !take(p, end, words, sizeof(words))) return false;
+    std::memcpy(gen_.s, words, sizeof(words));
+    in = p;
+    return true;
+}
+
+// --- DiceRollerBase ---
+
+int DiceRollerBase::rollIndexFromD6(int n) {
+    if (n <= 1) return 0;
+    // Smallest power of six covering n; draws past the last whole multiple
+    // of n are rejected so every index keeps equal weight.
+    int span = 6;
+    while (span < n) span *= 6;
+    const int limit = span - span % n;
+    for (;;) {
+        int v = 0;
+        for (int s = 1; s < span; s *= 6) v = v * 6 + (rollD6() - 1);
+        if (v < limit) return v % n;
+    }
+}
+
+// --- Xoshiro256 ---
+
+namespace {
+
+uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+} // anonymous namespace
+
+void Xoshiro256::seed(uint64_t seed, uint64_t gameId, uint64_t decisionId, uint64_t threadId) {
+    // Fold each stream coordinate through the mixer so neighbouring
+    // counters land on unrelated states.
+    uint64_t key = seed;
+    for (uint64_t counter : {gameId, decisionId, threadId}) {
+        uint64_t x = key ^ counter;
+        key = splitmix64(x);
+    }
+    for (auto& word : s) word = splitmix64(key);
+}
+
+// --- BufferedDiceRoller ---
+
+namespace {
+
+// Byte -> d6 face, 0 for the four bytes rejected to keep faces unbiased.
+struct D6ByteTable {
+    uint8_t face[256];
+    constexpr D6ByteTable() : face() {
+        for (int b = 0; b < 256; ++b) face[b] = b < 252 ? static_cast<uint8_t>(b % 6 + 1) : 0;
+    }
+};
+constexpr D6ByteTable D6_FROM_BYTE;
+
+constexpr int WORDS_PER_CHUNK = 64;  // generated per step while filling
+
+} // anonymous namespace
+
+BufferedDiceRoller::BufferedDiceRoller(uint64_t seed, uint64_t gameId,
+                                       uint64_t decisionId, uint64_t threadId) {
+    gen_.seed(seed, gameId, decisionId, threadId);
+    for (int lane = 0; lane < LANES; ++lane) {
+        for (int w = 0; w < 4; ++w) lanes_[w][lane] = gen_.next();
+    }
+}
+
+BufferedDiceRoller::BufferedDiceRoller(const BufferedDiceRoller& other)
+    : DiceRollerBase(other) {
+    rebase(other);
+}
+
+BufferedDiceRoller& BufferedDiceRoller::operator=(const BufferedDiceRoller& other) {
+    if (this != &other) {
+        DiceRollerBase::operator=(other);
+        rebase(other);
+    }
+    return *this;
+}
+
+void BufferedDiceRoller::rebase(const BufferedDiceRoller& other) {
+    std::memcpy(lanes_, other.lanes_, sizeof(lanes_));
+    std::memcpy(d6Buf_, other.d6Buf_, sizeof(d6Buf_));
+    std::memcpy(d8Buf_, other.d8Buf_, sizeof(d8Buf_));
+    auto moved = [](const uint8_t* p, const uint8_t* from, const uint8_t* to) {
+        return p ? to + (p - from) : nullptr;
+    };
+    d6Next_ = moved(other.d6Next_, other.d6Buf_, d6Buf_);
+    d6End_ = moved(other.d6End_, other.d6Buf_, d6Buf_);
+    d8Next_ = moved(other.d8Next_, other.d8Buf_, d8Buf_);
+    d8End_ = moved(other.d8End_, other.d8Buf_, d8Buf_);
+}
+
+// The unserved faces of both blocks are saved with the lanes, so a
+// restored roller continues mid-block exactly.
+bool BufferedDiceRoller::saveState(std::vector<uint8_t>& out) const {
+    out.push_back(SAVED_BUFFERED);
+    put(out, gen_.s, sizeof(gen_.s));
+    put(out, lanes_, sizeof(lanes_));
+    for (auto [next, end] : {std::pair{d6Next_, d6End_}, std::pair{d8Next_, d8End_}}) {
+        uint32_t left = static_cast<uint32_t>(end - next);
+        put(out, &left, sizeof(left));
+        put(out, next, left);
+    }
+    return true;
+}
+
+bool BufferedDiceRoller::restoreState(const uint8_t*& in, const uint8_t* end) {
+    const uint8_t* p = in;
+    uint64_t words[4];
+    uint64_t lanes[4][LANES];
+    if (!takeTag(p, end, SAVED_BUFFERED) || !take(p, end, words, sizeof(words)) ||
+        !take(p, end, lanes, sizeof(lanes))) {
+        return false;
+    }
+    uint32_t left[2];
+    const uint8_t* faces[2];
+    for (int k = 0; k < 2; ++k) {
+        if (!take(p, end, &left[k], sizeof(left[k])) || left[k] > BLOCK ||
+            static_cast<size_t>(end - p) < left[k]) {
+            return false;
+        }
+        faces[k] = p;
+        p += left[k];
+    }
+    std::memcpy(gen_.s, words, sizeof(words));
+    std::memcpy(lanes_, lanes, sizeof(lanes));
+    std::memcpy(d6Buf_, faces[0], left[0]);
+    std::memcpy(d8Buf_, faces[1], left[1]);
+    d6Next_ = d6Buf_;
+    d6End_ = d6Buf_ + left[0];
+    d8Next_ = d8Buf_;
+    d8End_ = d8Buf_ + left[1];
+    in = p;
+    return true;
+}
+
+void BufferedDiceRoller::generate(uint64_t* out, int count) {
+#if defined(__AVX2__)
+    __m256i s0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes_[0]));
+    __m256i s1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes_[1]));
+    __m256i s2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes_[2]));
+    __m256i s3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes_[3]));
+    auto rotl = [](__m256i x, int k) {
+        return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k));
+    };
+    for (int i = 0; i < count; i += LANES) {
+        __m256i x5 = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);  // s1 * 5
+        __m256i r = rotl(x5, 7);
+        __m256i result = _mm256_add_epi64(_mm256_slli_epi64(r, 3), r);  // * 9
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), result);
+        __m256i t = _mm256_slli_epi64(s1, 17);
+        s2 = _mm256_xor_si256(s2, s0);
+        s3 = _mm256_xor_si256(s3, s1);
+        s1 = _mm256_xor_si256(s1, s2);
+        s0 = _mm256_xor_si256(s0, s3);
+        s2 = _mm256_xor_si256(s2, t);
+        s3 = rotl(s3, 45);
+    }
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes_[0]), s0);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes_[1]), s1);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes_[2]), s2);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes_[3]), s3);
+#else
+    for (int i = 0; i < count; i += LANES) {
+        for (int l = 0; l < LANES; ++l) {
+            uint64_t& s0 = lanes_[0][l];
+            uint64_t& s1 = lanes_[1][l];
+            uint64_t& s2 = lanes_[2][l];
+            uint64_t& s3 = lanes_[3][l];
+            out[i + l] = Xoshiro256::rotl(s1 * 5, 7) * 9;
+            uint64_t t = s1 << 17;
+            s2 ^= s0;
+            s3 ^= s1;
+            s1 ^= s2;
+            s0 ^= s3;
+            s2 ^= t;
+            s3 = Xoshiro256::rotl(s3, 45);
+        }
+    }
+#endif
+}
+
+int BufferedDiceRoller::refillD6() {
+    uint64_t words[WORDS_PER_CHUNK];
+    int n = 0;
+    while (n < BLOCK) {
+        generate(words, WORDS_PER_CHUNK);
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(words);
+        for (size_t b = 0; b < sizeof(words) && n < BLOCK; ++b) {
+            uint8_t face = D6_FROM_BYTE.face[bytes[b]];
+            d6Buf_[n] = face;
+            n += face != 0;
+        }
+    }
+    d6Next_ = d6Buf_;
+    d6End_ = d6Buf_ + BLOCK;
+    return *d6Next_++;
+}
+
+int BufferedDiceRoller::refillD8() {
+    uint64_t words[WORDS_PER_CHUNK];
+    for (int n = 0; n < BLOCK; n += static_cast<int>(sizeof(words))) {
+        generate(words, WORDS_PER_CHUNK);
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(words);
+        for (size_t b = 0; b < sizeof(words); ++b) d8Buf_[n + b] = static_cast<uint8_t>((bytes[b] & 7) + 1);
+    }
+    d8Next_ = d8Buf_;
+    d8End_ = d8Buf_ + BLOCK;
+    return *d8Next_++;
+}
+
 // --- FixedDiceRoller ---
 
 FixedDiceRoller::FixedDiceRoller(std::vector<int> rolls)
@@ -31,7 +321,7 @@ int FixedDiceRoller::next() {
     return rolls_[index_++];
 }
 
-int FixedDiceRoller::rollD6() { return next(); }
-int FixedDiceRoller::rollD8() { return next(); }
+int FixedDiceRoller::d6() { return next(); }
+int FixedDiceRoller::d8() { return next(); }
 
 } // namespace bb
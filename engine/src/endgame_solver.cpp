@@ -0,0 +1,178 @@
+#include "bb/endgame_solver.h"
+#include <algorithm>
+
+namespace bb {
+
+namespace {
+
+// What the dice still to come can no longer change about the active team's
+// touchdown this turn: 1 scored, 0 not (its turn is over, or its activating
+// player was knocked down with no standing teammate holding the ball -- the
+// armour, injury and bounce rolls that follow are a turnover's), -1 open.
+int settled(const GameState& state, TeamSide side, int scoreBefore) {
+    if (state.getTeamState(side).score > scoreBefore) return 1;
+    if (state.phase != GamePhase::PLAY || state.activeTeam != side || state.turnoverPending) return 0;
+    if (state.currentActivationId <= 0) return -1;
+    const Player& active = state.getPlayer(state.currentActivationId);
+    if (active.teamSide != side || active.state == PlayerState::STANDING || !active.hasActed) return -1;
+    if (state.ball.isHeld && state.ball.carrierId > 0) {
+        const Player& carrier = state.getPlayer(state.ball.carrierId);
+        if (carrier.teamSide == side && carrier.state == PlayerState::STANDING) return -1;
+    }
+    return 0;
+}
+
+// Serves a scripted prefix of faces. Past its end it notes the size of the
+// first unscripted die, and whether the outcome was already settled when it
+// was asked for, and serves 1s so the expansion can run to the end; the
+// solver then discards that replay and branches on the die instead.
+class EnumeratingDice : public DiceRollerBase {
+public:
+    EnumeratingDice(const std::vector<uint8_t>& prefix, const GameState& sim, TeamSide side,
+                    int scoreBefore)
+        : prefix_(prefix), sim_(sim), side_(side), scoreBefore_(scoreBefore) {}
+
+    int overrun() const { return overrun_; }  // sides of the first unscripted die, 0 if none
+    int settledAtOverrun() const { return settled_; }
+
+protected:
+    int d6() override { return next(6); }
+    int d8() override { return next(8); }
+
+private:
+    int next(int sides) {
+        if (index_ < prefix_.size()) return prefix_[index_++];
+        if (overrun_ == 0) {
+            overrun_ = sides;
+            settled_ = settled(sim_, side_, scoreBefore_);
+        }
+        return 1;
+    }
+
+    const std::vector<uint8_t>& prefix_;
+    const GameState& sim_;
+    TeamSide side_;
+    int scoreBefore_;
+    size_t index_ = 0;
+    int overrun_ = 0;
+    int settled_ = -1;
+};
+
+uint64_t memoKey(uint64_t hash, int depth) {
+    return hash ^ (static_cast<uint64_t>(depth + 1) * 0x9E3779B97F4A7C15ull);
+}
+
+} // anonymous namespace
+
+bool EndgameSolver::applies(const GameState& state) {
+    if (state.phase != GamePhase::PLAY) return false;
+    return state.getTeamState(state.activeTeam).turnNumber >= 8;
+}
+
+bool EndgameSolver::isScoringMacro(MacroType type) {
+    switch (type) {
+        case MacroType::SCORE:
+        case MacroType::HAND_OFF_SCORE:
+        case MacroType::PASS_SCORE:
+        case MacroType::CHAIN_SCORE:
+        case MacroType::BLITZ_AND_SCORE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::vector<EndgameSolver::Line> EndgameSolver::solve(const GameState& state) {
+    replays_ = 0;
+    if (memo_.size() > config_.maxMemo) memo_.clear();
+
+    std::vector<Line> lines;
+    MacroList macros;
+    getAvailableMacros(state, macros);
+    for (const Macro& m : macros) {
+        if (!isScoringMacro(m.type)) continue;
+        Bounds b = solveLine(state, m, 0);
+        lines.push_back({m, b.lo, b.hi, b.hi - b.lo < 1e-12});
+    }
+    std::stable_sort(lines.begin(), lines.end(), [](const Line& a, const Line& b) {
+        return a.pTouchdown > b.pTouchdown;
+    });
+    return lines;
+}
+
+EndgameSolver::Bounds EndgameSolver::solveState(const GameState& state, int depth) {
+    uint64_t key = memoKey(state.hash(), depth);
+    auto it = memo_.find(key);
+    if (it != memo_.end()) return it->second;
+
+    Bounds best;
+    MacroList macros;
+    getAvailableMacros(state, macros);
+    for (const Macro& m : macros) {
+        if (!isScoringMacro(m.type)) continue;
+        Bounds b = solveLine(state, m, depth);
+        best.lo = std::max(best.lo, b.lo);
+        best.hi = std::max(best.hi, b.hi);
+    }
+    memo_[key] = best;
+    return best;
+}
+
+EndgameSolver::Bounds EndgameSolver::solveLine(const GameState& state, const Macro& macro, int depth) {
+    const TeamSide side = state.activeTeam;
+    const int scoreBefore = state.getTeamState(side).score;
+    Bounds total;
+    std::vector<uint8_t> prefix;
+
+    // Depth-first over dice sequences; `prob` is the chance of `prefix`
+    auto explore = [&](auto& self, double prob) -> void {
+        if (replays_ >= config_.maxReplays) {
+            total.hi += prob;
+            return;
+        }
+        ++replays_;
+        GameState sim = state.clone();
+        EnumeratingDice dice(prefix, sim, side, scoreBefore);
+        MacroExpansionResult result = greedyExpandMacro(sim, macro, dice);
+
+        if (dice.overrun() && dice.settledAtOverrun() >= 0) {
+            total.lo += prob * dice.settledAtOverrun();
+            total.hi += prob * dice.settledAtOverrun();
+            return;
+        }
+        if (int sides = dice.overrun()) {
+            if (static_cast<int>(prefix.size()) >= config_.maxDice) {
+                total.hi += prob;
+                return;
+            }
+            for (int face = 1; face <= sides; ++face) {
+                prefix.push_back(static_cast<uint8_t>(face));
+                self(self, prob / sides);
+                prefix.pop_back();
+            }
+            return;
+        }
+
+        Bounds leaf;
+        if (sim.getTeamState(side).score > scoreBefore) {
+            leaf = {1.0, 1.0};
+        } else if (result.turnover || sim.phase != GamePhase::PLAY || sim.activeTeam != side) {
+            leaf = {0.0, 0.0};
+        } else if (depth + 1 < config_.maxDepth) {
+            leaf = solveState(sim, depth + 1);
+        } else {
+            // Out of depth: another scoring macro may still be on
+            MacroList next;
+            getAvailableMacros(sim, next);
+            bool canScore = std::any_of(next.begin(), next.end(),
+                                        [](const Macro& m) { return isScoringMacro(m.type); });
+            leaf = {0.0, canScore ? 1.0 : 0.0};
+        }
+        total.lo += prob * leaf.lo;
+        total.hi += prob * leaf.hi;
+    };
+    explore(explore, 1.0);
+    return total;
+}
+
+} // namespace bb
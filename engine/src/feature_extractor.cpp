@@ -1,5 +1,7 @@
 #include "bb/feature_extractor.h"
+#include "bb/geometry.h"
 #include "bb/helpers.h"
+#include "bb/profile.h"
 #include <algorithm>
 #include <cmath>
 
@@ -60,37 +62,39 @@ inline bool isBetweenBallAndEndzone(Position p, Position ballPos, TeamSide persp
 } // anonymous namespace
 
 void extractFeatures(const GameState& state, TeamSide perspective, float* out) {
+    BB_PROFILE_SCOPE(prof::EXTRACT_FEATURES);
     TeamSide opp = opponent(perspective);
 
     const TeamState& myTeam = state.getTeamState(perspective);
     const TeamState& oppTeam = state.getTeamState(opp);
 
-    // Player counts
-    int myStanding = 0, oppStanding = 0;
-    int myKO = 0, oppKO = 0;
-    int myInjured = 0, oppInjured = 0;
-    int myProneStunned = 0, oppProneStunned = 0;
-
-    // Averages
-    float myXSum = 0, oppXSum = 0;
-    float mySTSum = 0, oppSTSum = 0;
-    float myAVSum = 0, oppAVSum = 0;
-    float myAGSum = 0, oppAGSum = 0;
-
-    // Sideline counts
-    int mySideline = 0, oppSideline = 0;
-
-    // Skill counts
-    int myBlock = 0, oppBlock = 0;
-    int myDodge = 0, oppDodge = 0;
-    int myGuard = 0, myMightyBlow = 0, myClaw = 0;
-    int myRegen = 0;
-    int myTotal = 0;
-
-    // Engaged counts
-    int myEngaged = 0, oppEngaged = 0;
-
-    // Collect standing players for new features
+    // Team aggregates, kept incrementally by GameState's mutators
+    const FeatureAccumulator& mine = state.featureAccumulator(perspective);
+    const FeatureAccumulator& theirs = state.featureAccumulator(opp);
+    int myStanding = mine.standing, oppStanding = theirs.standing;
+    int myKO = mine.ko, oppKO = theirs.ko;
+    int myInjured = mine.injured, oppInjured = theirs.injured;
+    int myProneStunned = mine.down, oppProneStunned = theirs.down;
+    // Normalized x (0 = my endzone): 25 - x for AWAY
+    auto xSum = [perspective](const FeatureAccumulator& a) {
+        return static_cast<float>(perspective == TeamSide::AWAY ? 25 * a.standing - a.x : a.x);
+    };
+    float myXSum = xSum(mine), oppXSum = xSum(theirs);
+    float mySTSum = mine.strength, oppSTSum = theirs.strength;
+    float myAVSum = mine.armour, oppAVSum = theirs.armour;
+    float myAGSum = mine.agility, oppAGSum = theirs.agility;
+    int mySideline = mine.sideline, oppSideline = theirs.sideline;
+    int myBlock = mine.block, oppBlock = theirs.block;
+    int myDodge = mine.dodge, oppDodge = theirs.dodge;
+    int myGuard = mine.guard, myMightyBlow = mine.mightyBlow, myClaw = mine.claw;
+    int myRegen = mine.regeneration;
+    int myTotal = 11;
+
+    // Engaged: standing in at least one enemy tacklezone
+    int myEngaged = (state.standingOf(perspective) & state.tacklezoneBoard(opp)).count();
+    int oppEngaged = (state.standingOf(opp) & state.tacklezoneBoard(perspective)).count();
+
+    // Standing players, for the positional features below
     struct StandingInfo {
         Position pos;
         int id;
@@ -100,78 +104,20 @@ void extractFeatures(const GameState& state, TeamSide perspective, float* out) {
         bool hasFrenzy;
         bool hasSureHands;
     };
+    auto collectStanding = [&state](TeamSide side, StandingInfo* out) {
+        int n = 0;
+        state.forEachPlayer(side, [&](const Player& p) {
+            if (p.state != PlayerState::STANDING || n >= 11) return;
+            out[n++] = {p.position, p.id, p.stats().movement, p.stats().agility,
+                        p.stats().strength, p.hasSkill(SkillName::Frenzy),
+                        p.hasSkill(SkillName::SureHands)};
+        });
+        return n;
+    };
     StandingInfo myStandingPlayers[11];
-    int myStandingIdx = 0;
+    int myStandingIdx = collectStanding(perspective, myStandingPlayers);
     StandingInfo oppStandingPlayers[11];
-    int oppStandingIdx = 0;
-
-    // My players
-    state.forEachPlayer(perspective, [&](const Player& p) {
-        myTotal++;
-        if (p.state == PlayerState::STANDING) {
-            myStanding++;
-            myXSum += normalizeX(p.position.x, perspective);
-            mySTSum += p.stats.strength;
-            myAVSum += p.stats.armour;
-            myAGSum += p.stats.agility;
-            if (p.position.y == 0 || p.position.y == 14) mySideline++;
-            if (p.hasSkill(SkillName::Block)) myBlock++;
-            if (p.hasSkill(SkillName::Dodge)) myDodge++;
-            if (p.hasSkill(SkillName::Guard)) myGuard++;
-            if (p.hasSkill(SkillName::MightyBlow)) myMightyBlow++;
-            if (p.hasSkill(SkillName::Claw)) myClaw++;
-            // Check if engaged (adjacent to enemy standing player)
-            if (countTacklezones(state, p.position, perspective) > 0) {
-                myEngaged++;
-            }
-            if (myStandingIdx < 11) {
-                myStandingPlayers[myStandingIdx++] = {
-                    p.position, p.id, p.stats.movement, p.stats.agility,
-                    p.stats.strength, p.hasSkill(SkillName::Frenzy),
-                    p.hasSkill(SkillName::SureHands)
-                };
-            }
-        } else if (p.state == PlayerState::KO) {
-            myKO++;
-        } else if (p.state == PlayerState::INJURED || p.state == PlayerState::DEAD) {
-            myInjured++;
-        }
-        if (p.state == PlayerState::PRONE || p.state == PlayerState::STUNNED) {
-            myProneStunned++;
-        }
-        if (p.hasSkill(SkillName::Regeneration)) myRegen++;
-    });
-
-    // Opp players
-    state.forEachPlayer(opp, [&](const Player& p) {
-        if (p.state == PlayerState::STANDING) {
-            oppStanding++;
-            oppXSum += normalizeX(p.position.x, perspective);
-            oppSTSum += p.stats.strength;
-            oppAVSum += p.stats.armour;
-            oppAGSum += p.stats.agility;
-            if (p.position.y == 0 || p.position.y == 14) oppSideline++;
-            if (p.hasSkill(SkillName::Block)) oppBlock++;
-            if (p.hasSkill(SkillName::Dodge)) oppDodge++;
-            if (countTacklezones(state, p.position, opp) > 0) {
-                oppEngaged++;
-            }
-            if (oppStandingIdx < 11) {
-                oppStandingPlayers[oppStandingIdx++] = {
-                    p.position, p.id, p.stats.movement, p.stats.agility,
-                    p.stats.strength, p.hasSkill(SkillName::Frenzy),
-                    p.hasSkill(SkillName::SureHands)
-                };
-            }
-        } else if (p.state == PlayerState::KO) {
-            oppKO++;
-        } else if (p.state == PlayerState::INJURED || p.state == PlayerState::DEAD) {
-            oppInjured++;
-        }
-        if (p.state == PlayerState::PRONE || p.state == PlayerState::STUNNED) {
-            oppProneStunned++;
-        }
-    });
+    int oppStandingIdx = collectStanding(opp, oppStandingPlayers);
 
     // Ball state
     bool iHaveBall = false;
@@ -192,15 +138,15 @@ void extractFeatures(const GameState& state, TeamSide perspective, float* out) {
             if (carrier.state == PlayerState::STANDING) {
                 carrierDistToTD = distanceToEndzone(carrier.position.x, perspective);
                 carrierTZCount = countTacklezones(state, carrier.position, perspective);
-                scoringThreat = (carrier.stats.movement >= carrierDistToTD);
+                scoringThreat = (carrier.stats().movement >= carrierDistToTD);
                 carrierPos = carrier.position;
-                carrierMA = carrier.stats.movement;
+                carrierMA = carrier.stats().movement;
             }
         } else {
             oppHasBall = true;
             if (carrier.state == PlayerState::STANDING) {
                 int oppDist = distanceToEndzone(carrier.position.x, opp);
-                oppScoringThreat = (carrier.stats.movement >= oppDist);
+                oppScoringThreat = (carrier.stats().movement >= oppDist);
                 oppCarrierPos = carrier.position;
             }
         }
@@ -244,9 +190,7 @@ void extractFeatures(const GameState& state, TeamSide perspective, float* out) {
     // Cage count (adjacent friendly standing players to ball carrier)
     int cageCount = 0;
     if (iHaveBall && carrierPos.isOnPitch()) {
-        auto adj = carrierPos.getAdjacent();
-        for (auto& pos : adj) {
-            if (!pos.isOnPitch()) continue;
+        for (Position pos : onPitchNeighbours(carrierPos)) {
             const Player* p = state.getPlayerAtPosition(pos);
             if (p && p->teamSide == perspective && p->state == PlayerState::STANDING) {
                 cageCount++;
@@ -626,4 +570,10 @@ void extractFeatures(const GameState& state, TeamSide perspective, float* out) {
     out[72] = pickupClear;        // loose ball is uncontested by opponent tackle zones
 }
 
+void extractFeaturesBatch(const GameState* states, int n, const TeamSide* persp, float* out) {
+    for (int i = 0; i < n; ++i) {
+        extractFeatures(states[i], persp[i], out + static_cast<size_t>(i) * NUM_FEATURES);
+    }
+}
+
 } // namespace bb
@@ -0,0 +1,92 @@
+#include "bb/feature_sets.h"
+#include "bb/board_planes.h"
+#include "bb/feature_extractor.h"
+#include "bb/thread_placement.h"
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace bb {
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<const FeatureSet>> sets;
+
+    Registry() {
+        add({"features", NUM_FEATURES, extractFeatures});
+        add({"board_planes", NUM_BOARD_PLANES * BOARD_PLANE_SIZE,
+             [](const GameState& s, TeamSide perspective, float* out) {
+                 extractBoardPlanes(s, perspective, out);
+             }});
+    }
+    void add(FeatureSet set) {
+        std::string name = set.name;
+        sets[name] = std::make_shared<const FeatureSet>(std::move(set));
+    }
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+constexpr size_t CHUNK = 256;  // boards claimed per worker step
+
+} // anonymous namespace
+
+void registerFeatureSet(FeatureSet set) {
+    if (set.name.empty()) throw std::invalid_argument("registerFeatureSet: empty name");
+    if (set.size < 1) throw std::invalid_argument("registerFeatureSet: size must be positive");
+    if (!set.extract) throw std::invalid_argument("registerFeatureSet: no extractor");
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.add(std::move(set));
+}
+
+std::shared_ptr<const FeatureSet> findFeatureSet(const std::string& name) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    auto it = r.sets.find(name);
+    return it == r.sets.end() ? nullptr : it->second;
+}
+
+std::vector<std::string> featureSetNames() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::vector<std::string> names;
+    for (const auto& [name, set] : r.sets) names.push_back(name);
+    return names;
+}
+
+void featurizeBoards(const FeatureSet& set, const BoardColumnsView& boards,
+                     const std::vector<SnapshotContext>& contexts,
+                     const std::vector<TeamSide>& perspectives,
+                     const TeamRoster& home, const TeamRoster& away, int threads, float* out) {
+    const size_t n = boards.boards;
+    if (contexts.size() != 1 && contexts.size() != n) {
+        throw std::invalid_argument("featurizeBoards: need one context or one per board");
+    }
+    if (perspectives.size() != 1 && perspectives.size() != n) {
+        throw std::invalid_argument("featurizeBoards: need one perspective or one per board");
+    }
+    std::string problem = boards.validate();
+    if (!problem.empty()) throw std::invalid_argument("featurizeBoards: " + problem);
+
+    std::atomic<size_t> next{0};
+    runWorkers(std::max(1, std::min(threads, static_cast<int>((n + CHUNK - 1) / CHUNK))), [&](int) {
+        for (size_t begin = next.fetch_add(CHUNK); begin < n; begin = next.fetch_add(CHUNK)) {
+            for (size_t k = begin; k < std::min(n, begin + CHUNK); ++k) {
+                GameState state = stateFromSnapshot(boards.compact(k), home, away,
+                                                    contexts[contexts.size() == 1 ? 0 : k]);
+                set.extract(state, perspectives[perspectives.size() == 1 ? 0 : k],
+                            out + k * static_cast<size_t>(set.size));
+            }
+        }
+    });
+}
+
+} // namespace bb
@@ -33,15 +33,15 @@ ActionResult resolveFoul(GameState& state, int foulerId, int targetId,
     int armourRoll = die1 + die2 + assistMod;
     bool isDoubles = (die1 == die2);
 
-    bool armourBroken = (armourRoll > target.stats.armour);
+    bool armourBroken = (armourRoll > target.stats().armour);
 
-    emitEvent(events, {GameEvent::Type::FOUL, fouler.id, target.id,
-                      fouler.position, target.position, armourRoll, armourBroken,
-                      die1, die2});
+    BB_EMIT_EVENT(events, GameEvent::Type::FOUL, fouler.id, target.id,
+                          fouler.position, target.position, armourRoll, armourBroken,
+                          die1, die2);
 
     if (armourBroken) {
-        emitEvent(events, {GameEvent::Type::ARMOR_BREAK, target.id, -1,
-                          target.position, {}, armourRoll, true, die1, die2});
+        BB_EMIT_EVENT(events, GameEvent::Type::ARMOR_BREAK, target.id, -1,
+                              target.position, {}, armourRoll, true, die1, die2);
 
         // Injury roll -- delegate to the shared helper (also used by
         // BLOCK/bomb/ball-and-chain) instead of the previous inline
@@ -64,11 +64,10 @@ ActionResult resolveFoul(GameState& state, int foulerId, int targetId,
     // Doubles: fouler ejected (SneakyGit prevents)
     if (isDoubles) {
         if (!fouler.hasSkill(SkillName::SneakyGit)) {
-            fouler.state = PlayerState::EJECTED;
-            fouler.position = {-1, -1};
+            state.removePlayer(fouler, PlayerState::EJECTED);
             handleBallOnPlayerDown(state, fouler.id, dice, events);
-            emitEvent(events, {GameEvent::Type::EJECTED, fouler.id, -1, {}, {},
-                              0, false});
+            BB_EMIT_EVENT(events, GameEvent::Type::EJECTED, fouler.id, -1, {}, {},
+                                  0, false);
         }
     }
 
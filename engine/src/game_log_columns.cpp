@@ -0,0 +1,144 @@
+#include "bb/game_log_columns.h"
+
+namespace bb {
+
+void BoardColumns::append(const std::vector<PlayerSnapshot>& home,
+                          const std::vector<PlayerSnapshot>& away,
+                          int ballX, int ballY, bool ballHeld, int ballCarrierId) {
+    auto addTeam = [this](const std::vector<PlayerSnapshot>& team, int8_t side) {
+        for (auto& p : team) {
+            players.insert(players.end(), {side, static_cast<int8_t>(p.id), p.x, p.y,
+                                           static_cast<int8_t>(p.state),
+                                           static_cast<int8_t>(p.hasBall)});
+        }
+    };
+    addTeam(home, 0);
+    addTeam(away, 1);
+    playerOffsets.push_back(static_cast<int32_t>(players.size() / PLAYER_COLS));
+    ball.insert(ball.end(), {static_cast<int8_t>(ballX), static_cast<int8_t>(ballY),
+                             static_cast<int8_t>(ballHeld), static_cast<int8_t>(ballCarrierId)});
+}
+
+void BoardColumns::append(const CompactBoardSnapshot& board) {
+    for (int i = 0; i < board.numPlayers(); ++i) {
+        const CompactPlayerSnapshot& p = board.players[i];
+        players.insert(players.end(), {static_cast<int8_t>(i < board.numHome ? 0 : 1),
+                                       static_cast<int8_t>(p.id), p.x, p.y,
+                                       static_cast<int8_t>(p.state()),
+                                       static_cast<int8_t>(p.hasBall())});
+    }
+    playerOffsets.push_back(static_cast<int32_t>(players.size() / PLAYER_COLS));
+    ball.insert(ball.end(), {board.ballX, board.ballY, static_cast<int8_t>(board.ballHeld),
+                             board.ballCarrierId});
+}
+
+BoardColumnsView BoardColumnsView::of(const BoardColumns& columns) {
+    BoardColumnsView view;
+    view.players = columns.players.data();
+    view.playerOffsets = columns.playerOffsets.data();
+    view.ball = columns.ball.data();
+    view.boards = columns.playerOffsets.size() - 1;
+    return view;
+}
+
+CompactBoardSnapshot BoardColumnsView::compact(size_t k) const {
+    CompactBoardSnapshot snap;
+    snap.captured = true;
+    int n = 0;
+    for (int32_t r = playerOffsets[k]; r < playerOffsets[k + 1]; ++r) {
+        const int8_t* row = players + static_cast<size_t>(r) * BoardColumns::PLAYER_COLS;
+        CompactPlayerSnapshot& p = snap.players[n++];
+        p.id = static_cast<uint8_t>(row[1]);
+        p.x = row[2];
+        p.y = row[3];
+        p.flags = static_cast<uint8_t>((row[4] & 3) | (row[5] ? 4 : 0));
+        if (row[0] == 0) snap.numHome++;
+    }
+    snap.numAway = static_cast<uint8_t>(n - snap.numHome);
+    const int8_t* b = ball + k * BoardColumns::BALL_COLS;
+    snap.ballX = b[0];
+    snap.ballY = b[1];
+    snap.ballHeld = b[2] != 0;
+    snap.ballCarrierId = b[3];
+    return snap;
+}
+
+std::string BoardColumnsView::validate() const {
+    if (boards > 0 && playerOffsets[0] != 0) return "board offsets must start at 0";
+    for (size_t k = 0; k < boards; ++k) {
+        int32_t begin = playerOffsets[k], end = playerOffsets[k + 1];
+        if (end < begin) return "board offsets must not decrease";
+        int counts[2] = {0, 0};
+        for (int32_t r = begin; r < end; ++r) {
+            const int8_t* row = players + static_cast<size_t>(r) * BoardColumns::PLAYER_COLS;
+            int side = row[0];
+            int first = side == 0 ? 1 : 12;
+            if (side != 0 && side != 1) return "board " + std::to_string(k) + ": side must be 0 or 1";
+            if (side == 0 && counts[1] > 0) return "board " + std::to_string(k) + ": home rows must come first";
+            if (++counts[side] > 11) return "board " + std::to_string(k) + ": more than 11 players a side";
+            if (row[1] < first || row[1] >= first + 11) {
+                return "board " + std::to_string(k) + ": player id " + std::to_string(row[1]) +
+                       " outside its side's range";
+            }
+        }
+    }
+    return {};
+}
+
+GameLogColumns toColumns(const LoggedGameResult& logged) {
+    GameLogColumns c;
+
+    c.stateFeatures.reserve(logged.states.size() * NUM_FEATURES);
+    c.statePerspective.reserve(logged.states.size());
+    for (auto& s : logged.states) {
+        c.stateFeatures.insert(c.stateFeatures.end(), s.features, s.features + NUM_FEATURES);
+        c.statePerspective.push_back(s.perspective == TeamSide::HOME ? 0 : 1);
+    }
+
+    size_t numDecisions = logged.policyDecisions.size();
+    c.decisionFeatures.reserve(numDecisions * NUM_FEATURES);
+    c.decisionPerspective.reserve(numDecisions);
+    c.decisionHash.reserve(numDecisions);
+    c.visitOffsets.reserve(numDecisions + 1);
+    c.visitOffsets.push_back(0);
+    for (auto& d : logged.policyDecisions) {
+        c.decisionFeatures.insert(c.decisionFeatures.end(), d.stateFeatures,
+                                  d.stateFeatures + NUM_FEATURES);
+        c.decisionPerspective.push_back(d.perspective == TeamSide::HOME ? 0 : 1);
+        c.decisionHash.push_back(d.stateHash);
+        for (auto& v : d.visits) {
+            c.visitActionFeatures.insert(c.visitActionFeatures.end(), v.actionFeatures,
+                                         v.actionFeatures + NUM_ACTION_FEATURES);
+            c.visitFractions.push_back(v.visitFraction);
+        }
+        c.visitOffsets.push_back(static_cast<int32_t>(c.visitFractions.size()));
+        c.decisionBoards.append(d.board);
+    }
+
+    c.turns.reserve(logged.turnLogs.size() * GameLogColumns::TURN_COLS);
+    c.eventOffsets.reserve(logged.turnLogs.size() + 1);
+    c.eventOffsets.push_back(0);
+    c.events.reserve(logged.events.size() * GameLogColumns::EVENT_COLS);
+    for (auto& t : logged.turnLogs) {
+        c.turns.insert(c.turns.end(), {
+            static_cast<int16_t>(t.half), static_cast<int16_t>(t.turnNumber),
+            static_cast<int16_t>(t.activeTeam == TeamSide::HOME ? 0 : 1),
+            static_cast<int16_t>(t.homeScore), static_cast<int16_t>(t.awayScore),
+            static_cast<int16_t>(t.turnover), static_cast<int16_t>(t.touchdown)});
+        for (auto& e : turnEvents(logged.events, t)) {
+            c.events.insert(c.events.end(), {
+                static_cast<int16_t>(e.type), static_cast<int16_t>(e.playerId),
+                static_cast<int16_t>(e.targetId),
+                static_cast<int16_t>(e.from.x), static_cast<int16_t>(e.from.y),
+                static_cast<int16_t>(e.to.x), static_cast<int16_t>(e.to.y),
+                static_cast<int16_t>(e.roll), static_cast<int16_t>(e.success),
+                static_cast<int16_t>(e.die1), static_cast<int16_t>(e.die2)});
+        }
+        c.eventOffsets.push_back(static_cast<int32_t>(c.events.size() / GameLogColumns::EVENT_COLS));
+        c.turnBoards.append(t.homePlayers, t.awayPlayers, t.ballX, t.ballY,
+                            t.ballHeld, t.ballCarrierId);
+    }
+    return c;
+}
+
+} // namespace bb
@@ -1,10 +1,15 @@
 #include "bb/game_simulator.h"
+#include "bb/alloc_tracking.h"
 #include "bb/action_resolver.h"
 #include "bb/ball_handler.h"
 #include "bb/kickoff_handler.h"
 #include "bb/helpers.h"
 #include "bb/turn_handler.h"
 #include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
 
 namespace bb {
 
@@ -127,9 +132,9 @@ void placeTeam(GameState& state, TeamSide side, const TeamRoster& roster,
             static_cast<int8_t>(baseLOS + formation[i].dx),
             formation[i].y
         };
-        p.stats = roster.positionals[templateIdx].stats;
-        p.skills = roster.positionals[templateIdx].skills;
-        p.movementRemaining = p.stats.movement;
+        const PlayerTemplate& tmpl = roster.positionals[templateIdx];
+        p.setProfile(tmpl.stats, tmpl.skills);
+        p.movementRemaining = p.stats().movement;
         p.hasMoved = false;
         p.hasActed = false;
         p.usedBlitz = false;
@@ -154,81 +159,82 @@ void placeTeam(GameState& state, TeamSide side, const TeamRoster& roster,
     ts.apothecaryUsed = false;
 }
 
-// Build a standard 11-player team: fill specialized positions first, then linemen
-// resetHalfState: true at true half boundaries (game start, half-time) -- resets the
-// turn clock and reroll allowance. false for a post-touchdown drive restart, which
-// only re-places players/ball and must NOT grant a fresh 8-turn clock or reroll pool.
-void buildTeam(GameState& state, TeamSide side, const TeamRoster& roster,
-               const FormationPos formation[11], bool resetHalfState) {
+// Build a standard 11-player team: fill specialized positions first, then linemen.
+// `out` receives the 11 players, slot i being player baseId + i.
+void buildFormation(Player out[11], TeamSide side, const TeamRoster& roster,
+                    const FormationPos formation[11]) {
     int baseId = (side == TeamSide::HOME) ? 1 : 12;
     int baseLOS = (side == TeamSide::HOME) ? 12 : 13;
 
-    // First pass: assign specialized positionals (non-linemen, index > 0)
-    int slot = 0;
-    // Start with special positionals to fill key positions
-    // Blitzers in backfield/second row, catchers in backfield, thrower in back
-    // For simplicity: fill from back of formation (backfield first) with specialists
-
-    // Collect how many of each positional to place
-    struct Placement { int templateIdx; int count; };
-    Placement placements[8];
-    int nPlacements = 0;
+    auto place = [&](int slot, const PlayerTemplate& tmpl) {
+        Player& player = out[slot];
+        player = Player{};
+        player.id = baseId + slot;
+        player.teamSide = side;
+        player.state = PlayerState::STANDING;
+        player.position = {
+            static_cast<int8_t>(baseLOS + formation[slot].dx),
+            formation[slot].y
+        };
+        player.setProfile(tmpl.stats, tmpl.skills);
+        player.movementRemaining = player.stats().movement;
+    };
 
-    // Specialists first (indices 1+)
-    for (int t = 1; t < roster.positionalCount; ++t) {
+    // Specialists first (indices 1+), filling from the end of the formation
+    // (backfield/second row); the rest are linemen (template index 0)
+    int specSlot = 10;
+    for (int t = 1; t < roster.positionalCount && specSlot >= 0; ++t) {
         int qty = std::min((int)roster.positionals[t].quantity, 11);
-        if (qty > 0) {
-            placements[nPlacements++] = {t, qty};
-        }
+        for (int q = 0; q < qty && specSlot >= 0; ++q) place(specSlot--, roster.positionals[t]);
     }
+    for (int i = 0; i <= specSlot; ++i) place(i, roster.positionals[0]);
+}
+
+// A side's 11 players as buildFormation places them (with Kick on the
+// kicking side's slot 10 safety), cached per thread on first use: every
+// drive repeats one of a handful of setups, and each placement interns 11
+// profiles under the profile table's lock.
+struct FormationTemplate {
+    const TeamRoster* roster;
+    TeamRoster built;  // byte copy: a different roster at a reused address misses
+    const FormationPos* formation;
+    TeamSide side;
+    bool kicking;
+    Player players[11];
+};
 
-    // Fill from end of formation (backfield) with specialists, rest with linemen
-    int placed = 0;
-    int specSlot = 10; // start filling from backfield
-
-    // Place specialists in the "best" positions (backfield/second row)
-    for (int p = 0; p < nPlacements && specSlot >= 0; ++p) {
-        for (int q = 0; q < placements[p].count && specSlot >= 0; ++q) {
-            Player& player = state.getPlayer(baseId + specSlot);
-            player.id = baseId + specSlot;
-            player.teamSide = side;
-            player.state = PlayerState::STANDING;
-            player.position = {
-                static_cast<int8_t>(baseLOS + formation[specSlot].dx),
-                formation[specSlot].y
-            };
-            player.stats = roster.positionals[placements[p].templateIdx].stats;
-            player.skills = roster.positionals[placements[p].templateIdx].skills;
-            player.movementRemaining = player.stats.movement;
-            player.hasMoved = false;
-            player.hasActed = false;
-            player.usedBlitz = false;
-            player.lostTacklezones = false;
-            player.proUsedThisTurn = false;
-            specSlot--;
-            placed++;
+constexpr size_t MAX_CACHED_FORMATIONS = 64;
+
+const Player* cachedFormation(const TeamRoster& roster, TeamSide side,
+                              const FormationPos formation[11], bool kicking) {
+    thread_local std::vector<FormationTemplate> cache;
+    for (const FormationTemplate& t : cache) {
+        if (t.roster == &roster && t.formation == formation && t.side == side &&
+            t.kicking == kicking && std::memcmp(&t.built, &roster, sizeof(TeamRoster)) == 0) {
+            return t.players;
         }
     }
+    if (cache.size() >= MAX_CACHED_FORMATIONS) cache.clear();
+    FormationTemplate& t = cache.emplace_back();
+    t.roster = &roster;
+    std::memcpy(&t.built, &roster, sizeof(TeamRoster));
+    t.formation = formation;
+    t.side = side;
+    t.kicking = kicking;
+    buildFormation(t.players, side, roster, formation);
+    if (kicking) t.players[10].addSkill(SkillName::Kick);
+    return t.players;
+}
 
-    // Fill remaining slots (0 to specSlot) with linemen (template index 0)
-    for (int i = 0; i <= specSlot; ++i) {
-        Player& player = state.getPlayer(baseId + i);
-        player.id = baseId + i;
-        player.teamSide = side;
-        player.state = PlayerState::STANDING;
-        player.position = {
-            static_cast<int8_t>(baseLOS + formation[i].dx),
-            formation[i].y
-        };
-        player.stats = roster.positionals[0].stats;
-        player.skills = roster.positionals[0].skills;
-        player.movementRemaining = player.stats.movement;
-        player.hasMoved = false;
-        player.hasActed = false;
-        player.usedBlitz = false;
-        player.lostTacklezones = false;
-        player.proUsedThisTurn = false;
-    }
+// Place a team from its cached formation and initialize its team state.
+// resetHalfState: true at true half boundaries (game start, half-time) -- resets the
+// turn clock and reroll allowance. false for a post-touchdown drive restart, which
+// only re-places players/ball and must NOT grant a fresh 8-turn clock or reroll pool.
+void buildTeam(GameState& state, TeamSide side, const TeamRoster& roster,
+               const FormationPos formation[11], bool kicking, bool resetHalfState) {
+    int baseId = (side == TeamSide::HOME) ? 1 : 12;
+    const Player* players = cachedFormation(roster, side, formation, kicking);
+    for (int i = 0; i < 11; ++i) state.getPlayer(baseId + i) = players[i];
 
     // Set team state
     TeamState& ts = state.getTeamState(side);
@@ -284,17 +290,11 @@ void setupHalfOrDrive(GameState& state, const TeamRoster& home, const TeamRoster
     const auto* awayForm = (kickingTeam == TeamSide::AWAY)
         ? awayKickForm : AWAY_DEEP_RECEIVER_FORMATION;
 
-    buildTeam(state, TeamSide::HOME, home, homeForm, isNewHalf);
-    buildTeam(state, TeamSide::AWAY, away, awayForm, isNewHalf);
-
-    // Give the kicking team's slot 10 player the Kick skill (sweeper/deep safety)
-    {
-        int kickBaseId = (kickingTeam == TeamSide::HOME) ? 1 : 12;
-        Player& safety = state.getPlayer(kickBaseId + 10);
-        if (safety.isOnPitch()) {
-            safety.skills.add(SkillName::Kick);
-        }
-    }
+    // The kicking team's slot 10 player (sweeper/deep safety) gets Kick
+    buildTeam(state, TeamSide::HOME, home, homeForm, kickingTeam == TeamSide::HOME, isNewHalf);
+    buildTeam(state, TeamSide::AWAY, away, awayForm, kickingTeam == TeamSide::AWAY, isNewHalf);
+    // Bulk placement writes players directly; re-index once afterwards.
+    state.invalidateOccupancy();
 
     // Ball off pitch until kickoff
     state.ball = BallState::offPitch();
@@ -388,11 +388,23 @@ void simpleKickoff(GameState& state, DiceRollerBase& dice) {
     state.weather = weatherFromRoll(dice.roll2D6());
 }
 
-GameResult simulateGame(const TeamRoster& home, const TeamRoster& away,
+int maxTouchdownsLeft(const GameState& state) {
+    if (state.phase == GamePhase::GAME_OVER) return 0;
+    constexpr int SECOND_HALF = 16 + 2;  // both clocks at 0
+    int turnsLeft = std::max(0, 8 - state.homeTeam.turnNumber) + std::max(0, 8 - state.awayTeam.turnNumber);
+    return turnsLeft + 2 + (state.half < 2 ? SECOND_HALF : 0);
+}
+
+bool outcomeDecided(const GameState& state) {
+    return std::abs(state.homeTeam.score - state.awayTeam.score) > maxTouchdownsLeft(state);
+}
+
+GameResult continueGame(GameState& state, const TeamRoster& home, const TeamRoster& away,
                         ActionSelector homePolicy, ActionSelector awayPolicy,
-                        DiceRollerBase& dice, bool useFullKickoff) {
-    GameState state;
+                        DiceRollerBase& dice, PlayUntil until, bool useFullKickoff,
+                        bool adjudicate) {
     GameResult result;
+    adjudicate = adjudicate && !useFullKickoff;
 
     constexpr int MAX_ACTIONS = 5000;
 
@@ -404,20 +416,24 @@ GameResult simulateGame(const TeamRoster& home, const TeamRoster& away,
         }
     };
 
-    // First half
     // No coin toss (yet): the opening kick is fixed. Named so the half-time
     // branch below can derive the H2 kicker from the opening, not from
     // whoever happened to kick the last H1 drive.
     const TeamSide openingKickingTeam = TeamSide::AWAY;  // Home receives first
-    state.half = 1;
-    state.kickingTeam = openingKickingTeam;
-    setupHalf(state, home, away, state.kickingTeam);
-    doKickoff();
 
-    std::vector<Action> actions;
+    ActionList actions;
     int totalActions = 0;
 
     while (state.phase != GamePhase::GAME_OVER && totalActions < MAX_ACTIONS) {
+        if (adjudicate && outcomeDecided(state)) {
+            result.adjudicated = true;
+            break;
+        }
+        if (until == PlayUntil::DRIVE_END &&
+            (state.phase == GamePhase::TOUCHDOWN || state.phase == GamePhase::HALF_TIME)) {
+            break;
+        }
+
         // Handle touchdown → setup + kickoff
         if (state.phase == GamePhase::TOUCHDOWN) {
             // The scoring team kicks off next, not simply "whoever didn't kick last".
@@ -440,7 +456,7 @@ GameResult simulateGame(const TeamRoster& home, const TeamRoster& away,
             continue;
         }
 
-        // Get available actions
+        // Get available actions, once: the policy reads them through PublishedActions
         actions.clear();
         getAvailableActions(state, actions);
 
@@ -456,7 +472,14 @@ GameResult simulateGame(const TeamRoster& home, const TeamRoster& away,
         // Select action using appropriate policy
         ActionSelector& policy = (state.activeTeam == TeamSide::HOME)
                                     ? homePolicy : awayPolicy;
-        Action chosen = policy(state);
+        auto policyStart = std::chrono::steady_clock::now();
+        Action chosen;
+        {
+            PublishedActions published(state, actions);
+            chosen = policy(state);
+        }
+        (state.activeTeam == TeamSide::HOME ? result.homePolicyMs : result.awayPolicyMs) +=
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - policyStart).count();
 
         // Execute
         executeAction(state, chosen, dice, nullptr);
@@ -470,6 +493,22 @@ GameResult simulateGame(const TeamRoster& home, const TeamRoster& away,
     return result;
 }
 
+GameResult simulateGame(const TeamRoster& home, const TeamRoster& away,
+                        ActionSelector homePolicy, ActionSelector awayPolicy,
+                        DiceRollerBase& dice, bool useFullKickoff, bool adjudicate) {
+    GameState state;
+    state.half = 1;
+    state.kickingTeam = TeamSide::AWAY;  // the fixed opening; see continueGame()
+    setupHalf(state, home, away, state.kickingTeam);
+    if (useFullKickoff) {
+        resolveKickoff(state, dice, nullptr);
+    } else {
+        simpleKickoff(state, dice);
+    }
+    return continueGame(state, home, away, std::move(homePolicy), std::move(awayPolicy), dice,
+                        PlayUntil::GAME_END, useFullKickoff, adjudicate);
+}
+
 // Helper: take a snapshot of the board state for replay
 static TurnLog captureTurnSnapshot(const GameState& state) {
     TurnLog turn;
@@ -491,84 +530,127 @@ static TurnLog captureTurnSnapshot(const GameState& state) {
     return turn;
 }
 
-LoggedGameResult simulateGameLogged(const TeamRoster& home, const TeamRoster& away,
-                                    ActionSelector homePolicy, ActionSelector awayPolicy,
-                                    DiceRollerBase& dice, bool useFullKickoff) {
-    GameState state;
-    LoggedGameResult logged;
+namespace {
 
-    constexpr int MAX_ACTIONS = 5000;
+constexpr int MAX_LOGGED_ACTIONS = 5000;
+constexpr size_t EVENT_ARENA_RESERVE = 1024;  // a typical game's events, so the arena rarely regrows
+
+// Observes a game run by runLoggedGame(). turnStarted() sees the cursor
+// before the turn is counted; returning false stops the run there, leaving
+// a cursor that resumes at the same turn start. Actions write their events
+// straight into eventSink() (nullptr: not logged), then eventsLogged()
+// hears where this action's events start.
+struct GameObserver {
+    virtual ~GameObserver() = default;
+    virtual bool turnStarted(const GameCursor&) { return true; }
+    virtual std::vector<GameEvent>* eventSink() { return nullptr; }
+    virtual void eventsLogged(size_t) {}
+    virtual void touchdownScored() {}
+};
 
-    auto doKickoff = [&]() {
-        if (useFullKickoff) {
-            resolveKickoff(state, dice, nullptr);
-        } else {
-            simpleKickoff(state, dice);
-        }
-    };
+// Rules dice of a game being recorded: serves the wrapped roller's faces
+// and keeps them. Policies hold the wrapped roller directly, so their own
+// draws are not recorded.
+class RecordingDiceRoller : public DiceRollerBase {
+    DiceRollerBase& inner_;
+    std::vector<uint8_t>& faces_;
+protected:
+    int d6() override { return keep(inner_.rollD6()); }
+    int d8() override { return keep(inner_.rollD8()); }
+public:
+    RecordingDiceRoller(DiceRollerBase& inner, std::vector<uint8_t>& faces)
+        : inner_(inner), faces_(faces) {}
+    int keep(int face) {
+        faces_.push_back(static_cast<uint8_t>(face));
+        return face;
+    }
+};
 
-    // First half
-    // Same fixed opening as simulateGame(); see the comment there.
-    const TeamSide openingKickingTeam = TeamSide::AWAY;
-    state.half = 1;
-    state.kickingTeam = openingKickingTeam;
-    setupHalf(state, home, away, state.kickingTeam);
-    doKickoff();
+// Serves a record's faces from a cursor's position.
+class RecordedDiceRoller : public DiceRollerBase {
+    const std::vector<uint8_t>& faces_;
+    size_t& next_;
+protected:
+    int d6() override { return next(); }
+    int d8() override { return next(); }
+public:
+    RecordedDiceRoller(const std::vector<uint8_t>& faces, size_t& next) : faces_(faces), next_(next) {}
+    int next() {
+        if (next_ >= faces_.size()) throw std::runtime_error("replay: record has no more dice");
+        return faces_[next_++];
+    }
+};
 
-    std::vector<Action> actions;
-    std::vector<GameEvent> turnEvents;
-    int totalActions = 0;
-    TeamSide lastActiveTeam = state.activeTeam;
-    int lastTurnNumber = state.getTeamState(state.activeTeam).turnNumber;
+// Same fixed opening as simulateGame(); see the comment there.
+constexpr TeamSide OPENING_KICKING_TEAM = TeamSide::AWAY;
 
-    // Capture initial state features + first turn snapshot
-    {
-        StateLog log;
-        log.perspective = state.activeTeam;
-        extractFeatures(state, log.perspective, log.features);
-        logged.states.push_back(log);
+void kickOff(GameState& state, DiceRollerBase& dice, bool useFullKickoff) {
+    if (useFullKickoff) {
+        resolveKickoff(state, dice, nullptr);
+    } else {
+        simpleKickoff(state, dice);
+    }
+}
+
+void beginLoggedGame(GameCursor& c, const TeamRoster& home, const TeamRoster& away,
+                     DiceRollerBase& dice, bool useFullKickoff) {
+    c.state.half = 1;
+    c.state.kickingTeam = OPENING_KICKING_TEAM;
+    setupHalf(c.state, home, away, c.state.kickingTeam);
+    kickOff(c.state, dice, useFullKickoff);
+    c.lastActiveTeam = c.state.activeTeam;
+    c.lastTurnNumber = c.state.getTeamState(c.state.activeTeam).turnNumber;
+}
 
-        logged.turnLogs.push_back(captureTurnSnapshot(state));
+// The simulateGameLogged loop from `c`, shared with replay: `choose`
+// supplies the action for each decision. Returns false if the observer
+// stopped the run.
+template<typename Choose>
+bool runLoggedGame(GameCursor& c, const TeamRoster& home, const TeamRoster& away,
+                   DiceRollerBase& dice, bool useFullKickoff, bool adjudicate, Choose&& choose,
+                   GameObserver& observer) {
+    GameState& state = c.state;
+    ActionList actions;
+    adjudicate = adjudicate && !useFullKickoff;
+
+    // First turn snapshot, taken before any restart is handled
+    if (c.turns == 0) {
+        if (!observer.turnStarted(c)) return false;
+        c.turns = 1;
     }
 
-    while (state.phase != GamePhase::GAME_OVER && totalActions < MAX_ACTIONS) {
+    while (state.phase != GamePhase::GAME_OVER && c.totalActions < MAX_LOGGED_ACTIONS) {
+        if (adjudicate && outcomeDecided(state)) {
+            c.adjudicated = true;
+            break;
+        }
         if (state.phase == GamePhase::TOUCHDOWN) {
-            // Mark touchdown in current turn log
-            if (!logged.turnLogs.empty()) {
-                logged.turnLogs.back().touchdown = true;
-            }
+            observer.touchdownScored();
             // The scoring team kicks off next, not simply "whoever didn't kick last".
             state.kickingTeam = state.getPlayer(state.ball.carrierId).teamSide;
             setupDrive(state, home, away, state.kickingTeam);
-            doKickoff();
+            kickOff(state, dice, useFullKickoff);
             continue;
         }
 
         if (state.phase == GamePhase::HALF_TIME) {
             state.half = 2;
             // H2 reverses the OPENING kickoff roles, not the last H1 drive;
-            // see the comment in simulateGame().
-            state.kickingTeam = opponent(openingKickingTeam);
+            // see the comment in continueGame().
+            state.kickingTeam = opponent(OPENING_KICKING_TEAM);
             setupHalf(state, home, away, state.kickingTeam);
-            doKickoff();
+            kickOff(state, dice, useFullKickoff);
             continue;
         }
 
         // Check if turn changed — log features at turn boundaries
         TeamSide curTeam = state.activeTeam;
         int curTurn = state.getTeamState(curTeam).turnNumber;
-        if (curTeam != lastActiveTeam || curTurn != lastTurnNumber) {
-            StateLog log;
-            log.perspective = curTeam;
-            extractFeatures(state, log.perspective, log.features);
-            logged.states.push_back(log);
-
-            // Save previous turn events and start new turn log
-            logged.turnLogs.push_back(captureTurnSnapshot(state));
-            turnEvents.clear();
-
-            lastActiveTeam = curTeam;
-            lastTurnNumber = curTurn;
+        if (curTeam != c.lastActiveTeam || curTurn != c.lastTurnNumber) {
+            if (!observer.turnStarted(c)) return false;
+            c.turns++;
+            c.lastActiveTeam = curTeam;
+            c.lastTurnNumber = curTurn;
         }
 
         actions.clear();
@@ -578,36 +660,206 @@ LoggedGameResult simulateGameLogged(const TeamRoster& home, const TeamRoster& aw
             Action endTurn;
             endTurn.type = ActionType::END_TURN;
             executeAction(state, endTurn, dice, nullptr);
-            totalActions++;
+            c.totalActions++;
             continue;
         }
 
-        ActionSelector& policy = (state.activeTeam == TeamSide::HOME)
-                                    ? homePolicy : awayPolicy;
-        Action chosen = policy(state);
+        Action chosen;
+        {
+            PublishedActions published(state, actions);
+            chosen = choose(c);
+        }
 
         // Execute with event capture
-        turnEvents.clear();
-        executeAction(state, chosen, dice, &turnEvents);
-
-        // Append events to current turn log
-        if (!logged.turnLogs.empty()) {
-            auto& curLog = logged.turnLogs.back();
-            for (auto& ev : turnEvents) {
-                curLog.events.push_back(ev);
-                if (ev.type == GameEvent::Type::TURNOVER) curLog.turnover = true;
-                if (ev.type == GameEvent::Type::TOUCHDOWN) curLog.touchdown = true;
-            }
-        }
+        std::vector<GameEvent>* sink = observer.eventSink();
+        size_t first = sink ? sink->size() : 0;
+        executeAction(state, chosen, dice, sink);
+        if (sink) observer.eventsLogged(first);
+        c.totalActions++;
+    }
+    return true;
+}
 
-        totalActions++;
+// Extend `log`'s range over the arena's new events, from `first` on
+void extendTurnEvents(TurnLog& log, const std::vector<GameEvent>& arena, size_t first) {
+    log.numEvents = static_cast<uint32_t>(arena.size() - log.firstEvent);
+    for (size_t e = first; e < arena.size(); ++e) {
+        if (arena[e].type == GameEvent::Type::TURNOVER) log.turnover = true;
+        if (arena[e].type == GameEvent::Type::TOUCHDOWN) log.touchdown = true;
     }
+}
+
+TurnLog startTurnLog(const GameState& state, const std::vector<GameEvent>& arena) {
+    TurnLog log = captureTurnSnapshot(state);
+    log.firstEvent = static_cast<uint32_t>(arena.size());
+    return log;
+}
 
-    logged.result.homeScore = state.homeTeam.score;
-    logged.result.awayScore = state.awayTeam.score;
-    logged.result.totalActions = totalActions;
+StateLog captureStateLog(const GameState& state) {
+    StateLog log;
+    log.perspective = state.activeTeam;
+    extractFeatures(state, log.perspective, log.features);
+    return log;
+}
 
+// Fills the states and turn logs of a LoggedGameResult.
+struct FullLogObserver : GameObserver {
+    LoggedGameResult& logged;
+    explicit FullLogObserver(LoggedGameResult& l) : logged(l) { logged.events.reserve(EVENT_ARENA_RESERVE); }
+    bool turnStarted(const GameCursor& c) override {
+        BB_ALLOC_SCOPE(alloc::LOGGING);
+        logged.states.push_back(captureStateLog(c.state));
+        logged.turnLogs.push_back(startTurnLog(c.state, logged.events));
+        return true;
+    }
+    std::vector<GameEvent>* eventSink() override { return &logged.events; }
+    void eventsLogged(size_t first) override {
+        BB_ALLOC_SCOPE(alloc::LOGGING);
+        extendTurnEvents(logged.turnLogs.back(), logged.events, first);
+    }
+    void touchdownScored() override { logged.turnLogs.back().touchdown = true; }
+};
+
+void finishResult(const GameCursor& c, GameResult& result) {
+    result.homeScore = c.state.homeTeam.score;
+    result.awayScore = c.state.awayTeam.score;
+    result.totalActions = c.totalActions;
+    result.adjudicated = c.adjudicated;
+}
+
+// Choose callback replaying a record's actions.
+auto recordedChoice(const GameRecord& record) {
+    return [&record](GameCursor& c) {
+        if (c.nextAction >= record.actions.size()) {
+            throw std::runtime_error("replay: record has no more actions");
+        }
+        return record.actions[c.nextAction++];
+    };
+}
+
+} // anonymous namespace
+
+LoggedGameResult simulateGameLogged(const TeamRoster& home, const TeamRoster& away,
+                                    ActionSelector homePolicy, ActionSelector awayPolicy,
+                                    DiceRollerBase& dice, bool useFullKickoff,
+                                    GameLogMode mode, bool adjudicate) {
+    LoggedGameResult logged;
+    GameRecord& record = logged.record;
+    record.home = home;
+    record.away = away;
+    record.useFullKickoff = useFullKickoff;
+    record.adjudicate = adjudicate;
+    RecordingDiceRoller rulesDice(dice, record.dice);
+
+    auto choose = [&](GameCursor& c) {
+        const GameState& state = c.state;
+        ActionSelector& policy = (state.activeTeam == TeamSide::HOME) ? homePolicy : awayPolicy;
+        auto policyStart = std::chrono::steady_clock::now();
+        DecisionSearchScope searched;
+        Action chosen = policy(state);
+        (state.activeTeam == TeamSide::HOME ? logged.result.homePolicyMs : logged.result.awayPolicyMs) +=
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - policyStart).count();
+        record.actions.push_back(chosen);
+        logged.decisionSearches.push_back(searched.kind());
+        return chosen;
+    };
+
+    GameCursor c;
+    beginLoggedGame(c, home, away, rulesDice, useFullKickoff);
+    FullLogObserver full(logged);
+    GameObserver recordOnly;
+    runLoggedGame(c, home, away, rulesDice, useFullKickoff, adjudicate, choose,
+                  mode == GameLogMode::FULL ? static_cast<GameObserver&>(full) : recordOnly);
+    finishResult(c, logged.result);
+    return logged;
+}
+
+LoggedGameResult replayGame(const GameRecord& record) {
+    LoggedGameResult logged;
+    logged.record = record;
+    GameCursor c;
+    RecordedDiceRoller dice(record.dice, c.nextDie);
+    beginLoggedGame(c, record.home, record.away, dice, record.useFullKickoff);
+    FullLogObserver full(logged);
+    runLoggedGame(c, record.home, record.away, dice, record.useFullKickoff, record.adjudicate,
+                  recordedChoice(record), full);
+    finishResult(c, logged.result);
     return logged;
 }
 
+// --- GameReplayer ---
+
+namespace {
+
+struct CheckpointObserver : GameObserver {
+    std::vector<GameCursor>& checkpoints;
+    int interval;
+    CheckpointObserver(std::vector<GameCursor>& cp, int k) : checkpoints(cp), interval(k) {}
+    bool turnStarted(const GameCursor& c) override {
+        if (c.turns % interval == 0) checkpoints.push_back(c);
+        return true;
+    }
+};
+
+// Stops as turn `stop` starts; collects the log of turn `target` (and its
+// events) on the way.
+struct SeekObserver : GameObserver {
+    int target, stop;
+    TurnLog* log;
+    std::vector<GameEvent>* events;
+    bool inTarget = false;
+    SeekObserver(int t, int s, TurnLog* l, std::vector<GameEvent>* e) : target(t), stop(s), log(l), events(e) {}
+    bool turnStarted(const GameCursor& c) override {
+        if (c.turns >= stop) return false;
+        inTarget = c.turns == target;
+        if (inTarget && log) *log = startTurnLog(c.state, *events);
+        return true;
+    }
+    std::vector<GameEvent>* eventSink() override { return inTarget && log ? events : nullptr; }
+    void eventsLogged(size_t first) override { extendTurnEvents(*log, *events, first); }
+    void touchdownScored() override {
+        if (inTarget && log) log->touchdown = true;
+    }
+};
+
+} // anonymous namespace
+
+GameReplayer::GameReplayer(GameRecord record, int checkpointInterval)
+    : record_(std::move(record)), interval_(std::max(1, checkpointInterval)) {
+    GameCursor c;
+    RecordedDiceRoller dice(record_.dice, c.nextDie);
+    beginLoggedGame(c, record_.home, record_.away, dice, record_.useFullKickoff);
+    CheckpointObserver observer(checkpoints_, interval_);
+    runLoggedGame(c, record_.home, record_.away, dice, record_.useFullKickoff, record_.adjudicate,
+                  recordedChoice(record_), observer);
+    numTurns_ = c.turns;
+    finishResult(c, result_);
+}
+
+GameState GameReplayer::stateAtTurn(int turn) const {
+    if (turn < 0 || turn >= numTurns_) throw std::out_of_range("GameReplayer: no such turn");
+    GameCursor c = checkpoints_[turn / interval_];
+    RecordedDiceRoller dice(record_.dice, c.nextDie);
+    SeekObserver observer(turn, turn, nullptr, nullptr);
+    runLoggedGame(c, record_.home, record_.away, dice, record_.useFullKickoff, record_.adjudicate,
+                  recordedChoice(record_), observer);
+    return c.state;
+}
+
+TurnLog GameReplayer::turnLog(int turn, std::vector<GameEvent>& events) const {
+    if (turn < 0 || turn >= numTurns_) throw std::out_of_range("GameReplayer: no such turn");
+    GameCursor c = checkpoints_[turn / interval_];
+    RecordedDiceRoller dice(record_.dice, c.nextDie);
+    TurnLog log;
+    events.clear();
+    SeekObserver observer(turn, turn + 1, &log, &events);
+    runLoggedGame(c, record_.home, record_.away, dice, record_.useFullKickoff, record_.adjudicate,
+                  recordedChoice(record_), observer);
+    return log;
+}
+
+StateLog GameReplayer::stateLog(int turn) const {
+    return captureStateLog(stateAtTurn(turn));
+}
+
 } // namespace bb
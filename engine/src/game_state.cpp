@@ -1,8 +1,73 @@
 #include "bb/game_state.h"
+#include "bb/geometry.h"
+#include <atomic>
+#include <cassert>
 #include <stdexcept>
+#include <utility>
 
 namespace bb {
 
+namespace {
+
+// Zobrist key features. Keys are splitmix64 of (feature, a, b) rather than
+// random tables: nothing to initialize, and identical in every process.
+enum ZobristFeature : uint64_t {
+    Z_PLAYER_STATE = 1,
+    Z_PLAYER_SQUARE,
+    Z_PLAYER_LOST_TZ,
+    Z_PLAYER_TURN,
+    Z_BALL,
+    Z_ACTIVE_TEAM,
+    Z_PHASE,
+    Z_HALF,
+    Z_ACTIVATION,
+    Z_TEAM,
+};
+
+uint64_t zobristKey(uint64_t feature, uint64_t a, uint64_t b = 0) {
+    uint64_t z = 0x9E3779B97F4A7C15ULL * ((feature << 48) ^ (a << 24) ^ b ^ 0x5DEECE66DULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+} // anonymous namespace
+
+void FeatureAccumulator::add(const Player& p, int delta) {
+    switch (p.state) {
+        case PlayerState::STANDING: {
+            const PlayerStats& s = p.stats();
+            uint32_t hot = p.hotSkills();
+            standing += delta;
+            if (p.position.y == 0 || p.position.y == 14) sideline += delta;
+            strength += delta * s.strength;
+            armour += delta * s.armour;
+            agility += delta * s.agility;
+            if (hot & hotSkillBit(SkillName::Block)) block += delta;
+            if (hot & hotSkillBit(SkillName::Dodge)) dodge += delta;
+            if (hot & hotSkillBit(SkillName::Guard)) guard += delta;
+            if (hot & hotSkillBit(SkillName::MightyBlow)) mightyBlow += delta;
+            if (hot & hotSkillBit(SkillName::Claw)) claw += delta;
+            x += delta * p.position.x;
+            break;
+        }
+        case PlayerState::KO:
+            ko += delta;
+            break;
+        case PlayerState::INJURED:
+        case PlayerState::DEAD:
+            injured += delta;
+            break;
+        case PlayerState::PRONE:
+        case PlayerState::STUNNED:
+            down += delta;
+            break;
+        default:
+            break;
+    }
+    if (p.hasSkill(SkillName::Regeneration)) regeneration += delta;
+}
+
 GameState::GameState() {
     homeTeam.side = TeamSide::HOME;
     awayTeam.side = TeamSide::AWAY;
@@ -22,7 +87,9 @@ Player& GameState::getPlayer(int id) {
     if (id < 1 || id > 22) {
         throw std::out_of_range("Player ID must be 1-22");
     }
-    return players[id <= 11 ? id - 1 : id - 12 + 11];
+    int slot = id <= 11 ? id - 1 : id - 12 + 11;
+    touched_ |= 1u << slot;
+    return players[slot];
 }
 
 const Player& GameState::getPlayer(int id) const {
@@ -33,19 +100,284 @@ const Player& GameState::getPlayer(int id) const {
 }
 
 Player* GameState::getPlayerAtPosition(Position pos) {
-    for (auto& p : players) {
-        if (p.isOnPitch() && p.position == pos) return &p;
-    }
-    return nullptr;
+    Player* found = const_cast<Player*>(std::as_const(*this).getPlayerAtPosition(pos));
+    if (found) touch(*found);
+    return found;
 }
 
 const Player* GameState::getPlayerAtPosition(Position pos) const {
+    if (!pos.isOnPitch()) return nullptr;
+    if (occupancyStale_) rebuildOccupancy();
+    int slot = occupancy_[squareIndex(pos)];
+    const Player* found = slot ? &players[slot - 1] : nullptr;
+    // A mismatch here means someone assigned Player::position/state without
+    // going through the mutators (or invalidateOccupancy()).
+    assert(found == scanPlayerAtPosition(pos));
+    return found;
+}
+
+const Player* GameState::scanPlayerAtPosition(Position pos) const {
     for (const auto& p : players) {
         if (p.isOnPitch() && p.position == pos) return &p;
     }
     return nullptr;
 }
 
+int GameState::tacklezoneCount(TeamSide exertedBy, Position pos) const {
+    if (!pos.isOnPitch()) return 0;
+    if (occupancyStale_) rebuildOccupancy();
+    int count = tacklezones_[static_cast<int>(exertedBy)][squareIndex(pos)];
+    // Same contract as getPlayerAtPosition: lostTacklezones and state changes
+    // must go through the mutators.
+    assert(count == scanTacklezoneCount(exertedBy, pos));
+    return count;
+}
+
+int GameState::scanTacklezoneCount(TeamSide exertedBy, Position pos) const {
+    int count = 0;
+    for (const auto& p : players) {
+        if (p.teamSide == exertedBy && exertsIndexedTacklezone(p) &&
+            p.position.distanceTo(pos) == 1) {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool GameState::exertsIndexedTacklezone(const Player& p) {
+    return exertsTacklezone(p.state) && !p.lostTacklezones && p.position.isOnPitch();
+}
+
+void GameState::addTacklezones(const Player& p, int delta) const {
+    int side = static_cast<int>(p.teamSide);
+    auto& grid = tacklezones_[side];
+    for (Position apos : onPitchNeighbours(p.position)) {
+        int sq = squareIndex(apos);
+        grid[sq] += delta;
+        tacklezoneBoard_[side].assign(sq, grid[sq] > 0);
+    }
+}
+
+void GameState::refreshSquareBoards(int sq) const {
+    int slot = occupancy_[sq];
+    for (int side = 0; side < 2; ++side) {
+        bool mine = slot && static_cast<int>(players[slot - 1].teamSide) == side;
+        occupiedBoard_[side].assign(sq, mine);
+        standingBoard_[side].assign(sq, mine && players[slot - 1].state == PlayerState::STANDING);
+    }
+}
+
+const Bitboard& GameState::occupiedBy(TeamSide side) const {
+    if (occupancyStale_) rebuildOccupancy();
+    return occupiedBoard_[static_cast<int>(side)];
+}
+
+const Bitboard& GameState::standingOf(TeamSide side) const {
+    if (occupancyStale_) rebuildOccupancy();
+    return standingBoard_[static_cast<int>(side)];
+}
+
+const Bitboard& GameState::tacklezoneBoard(TeamSide exertedBy) const {
+    if (occupancyStale_) rebuildOccupancy();
+    return tacklezoneBoard_[static_cast<int>(exertedBy)];
+}
+
+uint64_t GameState::layoutKey(const Player& p, bool mirrorY) const {
+    uint64_t slot = static_cast<uint64_t>(slotOf(p));
+    uint64_t key = zobristKey(Z_PLAYER_STATE, slot, static_cast<uint64_t>(p.state));
+    if (p.isOnPitch() && p.position.isOnPitch()) {
+        Position sq = mirrorY ? Position{p.position.x, static_cast<int8_t>(Position::PITCH_HEIGHT - 1 - p.position.y)}
+                              : p.position;
+        key ^= zobristKey(Z_PLAYER_SQUARE, slot, static_cast<uint64_t>(squareIndex(sq)));
+    }
+    if (p.lostTacklezones) key ^= zobristKey(Z_PLAYER_LOST_TZ, slot);
+    return key;
+}
+
+uint64_t GameState::hash() const {
+    if (occupancyStale_) rebuildOccupancy();
+    return hashWithLayout(layoutHash_, false);
+}
+
+uint64_t GameState::mirroredHash() const {
+    uint64_t layout = 0;
+    for (const Player& p : players) layout ^= layoutKey(p, true);
+    return hashWithLayout(layout, true);
+}
+
+uint64_t GameState::hashWithLayout(uint64_t layout, bool mirrorY) const {
+    uint64_t h = layout;
+    for (int i = 0; i < static_cast<int>(players.size()); ++i) {
+        const Player& p = players[i];
+        uint64_t turn = static_cast<uint64_t>(static_cast<uint8_t>(p.movementRemaining)) |
+                        uint64_t{p.hasMoved} << 8 | uint64_t{p.hasActed} << 9 |
+                        uint64_t{p.usedBlitz} << 10 | uint64_t{p.proUsedThisTurn} << 11;
+        h ^= zobristKey(Z_PLAYER_TURN, static_cast<uint64_t>(i), turn);
+    }
+    Position ballPos = mirrorY ? Position{ball.position.x, static_cast<int8_t>(Position::PITCH_HEIGHT - 1 - ball.position.y)}
+                               : ball.position;
+    uint64_t ballSq = ball.isOnPitch() ? static_cast<uint64_t>(squareIndex(ballPos)) : 0xFFFF;
+    h ^= zobristKey(Z_BALL, ballSq, static_cast<uint64_t>(ball.isHeld ? ball.carrierId : 0));
+    h ^= zobristKey(Z_ACTIVE_TEAM, static_cast<uint64_t>(activeTeam));
+    h ^= zobristKey(Z_PHASE, static_cast<uint64_t>(phase));
+    h ^= zobristKey(Z_HALF, static_cast<uint64_t>(half));
+    h ^= zobristKey(Z_ACTIVATION, static_cast<uint64_t>(currentActivationId + 1));
+    for (const TeamState* t : {&homeTeam, &awayTeam}) {
+        uint64_t side = static_cast<uint64_t>(t->side);
+        uint64_t flags = uint64_t{t->rerollUsedThisTurn} | uint64_t{t->blitzUsedThisTurn} << 1 |
+                         uint64_t{t->passUsedThisTurn} << 2 | uint64_t{t->foulUsedThisTurn} << 3 |
+                         uint64_t{t->apothecaryUsed} << 4;
+        uint64_t counters = static_cast<uint64_t>(t->score & 0xFF) |
+                            static_cast<uint64_t>(t->rerolls & 0xFF) << 8 |
+                            static_cast<uint64_t>(t->turnNumber & 0xFF) << 16;
+        h ^= zobristKey(Z_TEAM, side, counters << 8 | flags);
+    }
+    return h;
+}
+
+void GameState::unindexPlayer(const Player& p) {
+    touch(p);
+    stampDirty_ = true;
+    if (occupancyStale_) return;
+    layoutHash_ ^= layoutKey(p);
+    features_[static_cast<int>(p.teamSide)].add(p, -1);
+    if (!p.isOnPitch() || !p.position.isOnPitch()) return;
+    uint8_t& cell = occupancy_[squareIndex(p.position)];
+    // Only clear the square if it is still ours: mid-swap (Tentacles, chain
+    // pushes) another player may already have been indexed onto it.
+    if (cell == slotOf(p) + 1) cell = 0;
+    refreshSquareBoards(squareIndex(p.position));
+    if (exertsIndexedTacklezone(p)) addTacklezones(p, -1);
+}
+
+void GameState::indexPlayer(const Player& p) {
+    stampDirty_ = true;
+    if (occupancyStale_) return;
+    layoutHash_ ^= layoutKey(p);
+    features_[static_cast<int>(p.teamSide)].add(p, +1);
+    if (!p.isOnPitch() || !p.position.isOnPitch()) return;
+    occupancy_[squareIndex(p.position)] = static_cast<uint8_t>(slotOf(p) + 1);
+    refreshSquareBoards(squareIndex(p.position));
+    if (exertsIndexedTacklezone(p)) addTacklezones(p, +1);
+}
+
+void GameState::movePlayer(Player& p, Position to) {
+    unindexPlayer(p);
+    p.position = to;
+    indexPlayer(p);
+}
+
+void GameState::setPlayerState(Player& p, PlayerState s) {
+    unindexPlayer(p);
+    p.state = s;
+    indexPlayer(p);
+}
+
+void GameState::removePlayer(Player& p, PlayerState s) {
+    unindexPlayer(p);
+    p.state = s;
+    p.position = {-1, -1};
+    indexPlayer(p);  // off pitch: only the layout hash changes
+}
+
+void GameState::setLostTacklezones(Player& p, bool lost) {
+    if (p.lostTacklezones == lost) return;
+    unindexPlayer(p);
+    p.lostTacklezones = lost;
+    indexPlayer(p);
+}
+
+void GameState::restorePlayer(Player& p, const Player& saved) {
+    unindexPlayer(p);
+    p = saved;
+    indexPlayer(p);
+}
+
+uint64_t GameState::occupancyStamp() const {
+    static std::atomic<uint64_t> nextStamp{1};
+    if (stampDirty_) {
+        stamp_ = nextStamp.fetch_add(1, std::memory_order_relaxed);
+        stampDirty_ = false;
+    }
+    return stamp_;
+}
+
+void GameState::rebuildOccupancy() const {
+    occupancy_.fill(0);
+    for (auto& grid : tacklezones_) grid.fill(0);
+    occupiedBoard_ = {};
+    standingBoard_ = {};
+    tacklezoneBoard_ = {};
+    layoutHash_ = 0;
+    teamHotSkills_ = {};
+    features_ = {};
+    for (int i = 0; i < static_cast<int>(players.size()); ++i) {
+        const Player& p = players[i];
+        layoutHash_ ^= layoutKey(p);
+        teamHotSkills_[static_cast<int>(p.teamSide)] |= p.hotSkills();
+        features_[static_cast<int>(p.teamSide)].add(p, +1);
+        if (p.isOnPitch() && p.position.isOnPitch()) {
+            int sq = squareIndex(p.position);
+            occupancy_[sq] = static_cast<uint8_t>(i + 1);
+            refreshSquareBoards(sq);
+            if (exertsIndexedTacklezone(p)) addTacklezones(p, +1);
+        }
+    }
+    occupancyStale_ = false;
+}
+
+bool GameState::teamMayHaveSkill(TeamSide side, SkillName s) const {
+    uint32_t bit = hotSkillBit(s);
+    if (!bit) return true;
+    if (occupancyStale_) rebuildOccupancy();
+    return teamHotSkills_[static_cast<int>(side)] & bit;
+}
+
+uint32_t GameState::teamHotSkills(TeamSide side) const {
+    if (occupancyStale_) rebuildOccupancy();
+    return teamHotSkills_[static_cast<int>(side)];
+}
+
+const FeatureAccumulator& GameState::featureAccumulator(TeamSide side) const {
+    if (occupancyStale_) rebuildOccupancy();
+    return features_[static_cast<int>(side)];
+}
+
+bool GameState::occupancyConsistent() const {
+    if (occupancyStale_) return true;  // nothing cached to disagree with
+    uint64_t layout = 0;
+    std::array<uint32_t, 2> hot{};
+    std::array<FeatureAccumulator, 2> features{};
+    for (const auto& p : players) {
+        layout ^= layoutKey(p);
+        hot[static_cast<int>(p.teamSide)] |= p.hotSkills();
+        features[static_cast<int>(p.teamSide)].add(p, +1);
+    }
+    if (layout != layoutHash_ || hot != teamHotSkills_ || features != features_) return false;
+    for (int y = 0; y < Position::PITCH_HEIGHT; ++y) {
+        for (int x = 0; x < Position::PITCH_WIDTH; ++x) {
+            Position pos{static_cast<int8_t>(x), static_cast<int8_t>(y)};
+            int slot = occupancy_[squareIndex(pos)];
+            const Player* indexed = slot ? &players[slot - 1] : nullptr;
+            if (indexed != scanPlayerAtPosition(pos)) return false;
+            for (TeamSide side : {TeamSide::HOME, TeamSide::AWAY}) {
+                int s = static_cast<int>(side);
+                int tz = scanTacklezoneCount(side, pos);
+                if (tacklezones_[s][squareIndex(pos)] != tz) return false;
+                if (tacklezoneBoard_[s].test(squareIndex(pos)) != (tz > 0)) return false;
+                const Player* occ = scanPlayerAtPosition(pos);
+                bool mine = occ && occ->teamSide == side;
+                if (occupiedBoard_[s].test(squareIndex(pos)) != mine) return false;
+                if (standingBoard_[s].test(squareIndex(pos)) !=
+                    (mine && occ->state == PlayerState::STANDING)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
 TeamState& GameState::getTeamState(TeamSide side) {
     return side == TeamSide::HOME ? homeTeam : awayTeam;
 }
@@ -57,16 +389,16 @@ const TeamState& GameState::getTeamState(TeamSide side) const {
 void GameState::resetPlayersForNewTurn(TeamSide side) {
     // New turn (or new drive via kickoff): no activation is open.
     currentActivationId = -1;
-    forEachPlayer(side, [](Player& p) {
+    forEachPlayer(side, [this](Player& p) {
         if (p.state == PlayerState::STUNNED) {
-            p.state = PlayerState::PRONE;
+            setPlayerState(p, PlayerState::PRONE);
         }
         p.hasMoved = false;
         p.hasActed = false;
         p.usedBlitz = false;
-        p.lostTacklezones = false;
+        setLostTacklezones(p, false);
         p.proUsedThisTurn = false;
-        p.movementRemaining = p.stats.movement;
+        p.movementRemaining = p.stats().movement;
     });
 }
 
@@ -16,13 +16,13 @@ ActionResult resolveHypnoticGaze(GameState& state, int gazerId, int targetId,
     int gazeTarget = std::min(6, 2 + tz);
 
     int roll = dice.rollD6();
-    emitEvent(events, {GameEvent::Type::SKILL_USED, gazerId, targetId, gazer.position,
-                      target.position, static_cast<int>(SkillName::HypnoticGaze),
-                      roll >= gazeTarget});
+    BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, gazerId, targetId, gazer.position,
+                          target.position, static_cast<int>(SkillName::HypnoticGaze),
+                          roll >= gazeTarget);
 
     if (roll >= gazeTarget) {
         // Success: target loses tacklezones
-        target.lostTacklezones = true;
+        state.setLostTacklezones(target, true);
         return ActionResult::ok();
     }
 
@@ -1,18 +1,20 @@
 #include "bb/helpers.h"
+#include "bb/geometry.h"
 #include <algorithm>
 
 namespace bb {
 
 int countTacklezones(const GameState& state, Position pos, TeamSide friendlySide,
                      int excludeId) {
-    int count = 0;
-    auto adj = pos.getAdjacent();
-    for (auto& apos : adj) {
-        if (!apos.isOnPitch()) continue;
-        const Player* p = state.getPlayerAtPosition(apos);
-        if (p && p->teamSide != friendlySide && p->id != excludeId &&
-            exertsTacklezone(p->state) && !p->lostTacklezones) {
-            count++;
+    TeamSide enemySide = opponent(friendlySide);
+    int count = state.tacklezoneCount(enemySide, pos);
+    if (excludeId >= 1 && excludeId <= 22 && count > 0) {
+        // Take the excluded player's own tacklezone back out, if they put one here
+        const Player& ex = state.getPlayer(excludeId);
+        if (ex.teamSide == enemySide && ex.isOnPitch() &&
+            exertsTacklezone(ex.state) && !ex.lostTacklezones &&
+            ex.position.distanceTo(pos) == 1) {
+            count--;
         }
     }
     return count;
@@ -21,6 +23,7 @@ int countTacklezones(const GameState& state, Position pos, TeamSide friendlySide
 int countDisturbingPresence(const GameState& state, Position pos, TeamSide friendlySide) {
     int count = 0;
     TeamSide enemySide = opponent(friendlySide);
+    if (!state.teamMayHaveSkill(enemySide, SkillName::DisturbingPresence)) return 0;
     state.forEachOnPitch(enemySide, [&](const Player& p) {
         if (p.hasSkill(SkillName::DisturbingPresence) &&
             p.position.distanceTo(pos) <= 3) {
@@ -32,10 +35,10 @@ int countDisturbingPresence(const GameState& state, Position pos, TeamSide frien
 
 int calculateDodgeTarget(const GameState& state, const Player& player,
                          Position dest, Position source) {
-    int ag = player.stats.agility;
+    int ag = player.stats().agility;
     // BreakTackle: use ST if higher
-    if (player.hasSkill(SkillName::BreakTackle) && player.stats.strength > ag) {
-        ag = player.stats.strength;
+    if (player.hasSkill(SkillName::BreakTackle) && player.stats().strength > ag) {
+        ag = player.stats().strength;
     }
 
     int target = 7 - ag;
@@ -45,46 +48,55 @@ int calculateDodgeTarget(const GameState& state, const Player& player,
 
     // Skills that make dodging easier
     // Dodge: -1 (negated if any opponent adjacent to source has Tackle)
-    if (player.hasSkill(SkillName::Dodge)) {
+    TeamSide enemySide = opponent(player.teamSide);
+    uint32_t hot = player.hotSkills();
+    if (hot & hotSkillBit(SkillName::Dodge)) {
         bool tacklePresent = false;
-        auto srcAdj = source.getAdjacent();
-        for (auto& apos : srcAdj) {
-            if (!apos.isOnPitch()) continue;
-            const Player* opp = state.getPlayerAtPosition(apos);
-            if (opp && opp->teamSide != player.teamSide &&
-                exertsTacklezone(opp->state) && !opp->lostTacklezones &&
-                opp->hasSkill(SkillName::Tackle)) {
-                tacklePresent = true;
-                break;
+        if (state.teamMayHaveSkill(enemySide, SkillName::Tackle)) {
+            for (Position apos : onPitchNeighbours(source)) {
+                const Player* opp = state.getPlayerAtPosition(apos);
+                if (opp && opp->teamSide != player.teamSide &&
+                    exertsTacklezone(opp->state) && !opp->lostTacklezones &&
+                    opp->hasSkill(SkillName::Tackle)) {
+                    tacklePresent = true;
+                    break;
+                }
             }
         }
         if (!tacklePresent) target -= 1;
     }
 
-    if (player.hasSkill(SkillName::Stunty)) target -= 1;
-    if (player.hasSkill(SkillName::Titchy)) target -= 1;
-    if (player.hasSkill(SkillName::TwoHeads)) target -= 1;
-
-    // Skills that make dodging harder (opponents at source)
-    auto srcAdj = source.getAdjacent();
-    for (auto& apos : srcAdj) {
-        if (!apos.isOnPitch()) continue;
-        const Player* opp = state.getPlayerAtPosition(apos);
-        if (opp && opp->teamSide != player.teamSide &&
-            exertsTacklezone(opp->state) && !opp->lostTacklezones) {
-            if (opp->hasSkill(SkillName::PrehensileTail)) target += 1;
+    if (hot & hotSkillBit(SkillName::Stunty)) target -= 1;
+    if (hot & hotSkillBit(SkillName::Titchy)) target -= 1;
+    if (hot & hotSkillBit(SkillName::TwoHeads)) target -= 1;
+
+    // Skills that make dodging harder (opponents at source). Most teams
+    // field neither, so both scans are skipped on the team masks.
+    bool tail = state.teamMayHaveSkill(enemySide, SkillName::PrehensileTail);
+    bool divingTackle = state.teamMayHaveSkill(enemySide, SkillName::DivingTackle);
+    if (!tail && !divingTackle) return std::clamp(target, 2, 6);
+
+    const geometry::Neighbours& srcAdj = onPitchNeighbours(source);
+    if (tail) {
+        for (Position apos : srcAdj) {
+            const Player* opp = state.getPlayerAtPosition(apos);
+            if (opp && opp->teamSide != player.teamSide &&
+                exertsTacklezone(opp->state) && !opp->lostTacklezones) {
+                if (opp->hasSkill(SkillName::PrehensileTail)) target += 1;
+            }
         }
     }
 
     // DivingTackle: +2 from one opponent at source
-    for (auto& apos : srcAdj) {
-        if (!apos.isOnPitch()) continue;
-        const Player* opp = state.getPlayerAtPosition(apos);
-        if (opp && opp->teamSide != player.teamSide &&
-            exertsTacklezone(opp->state) && !opp->lostTacklezones &&
-            opp->hasSkill(SkillName::DivingTackle)) {
-            target += 2;
-            break; // only one DivingTackle applies
+    if (divingTackle) {
+        for (Position apos : srcAdj) {
+            const Player* opp = state.getPlayerAtPosition(apos);
+            if (opp && opp->teamSide != player.teamSide &&
+                exertsTacklezone(opp->state) && !opp->lostTacklezones &&
+                opp->hasSkill(SkillName::DivingTackle)) {
+                target += 2;
+                break; // only one DivingTackle applies
+            }
         }
     }
 
@@ -92,7 +104,7 @@ int calculateDodgeTarget(const GameState& state, const Player& player,
 }
 
 int calculatePickupTarget(const GameState& state, const Player& player) {
-    int target = 6 - player.stats.agility;
+    int target = 6 - player.stats().agility;
 
     if (!player.hasSkill(SkillName::BigHand)) {
         target += countTacklezones(state, player.position, player.teamSide);
@@ -107,7 +119,7 @@ int calculatePickupTarget(const GameState& state, const Player& player) {
 }
 
 int calculateCatchTarget(const GameState& state, const Player& catcher, int modifier) {
-    int target = 7 - catcher.stats.agility - modifier;
+    int target = 7 - catcher.stats().agility - modifier;
 
     if (!catcher.hasSkill(SkillName::NervesOfSteel)) {
         target += countTacklezones(state, catcher.position, catcher.teamSide);
@@ -125,9 +137,7 @@ int calculateCatchTarget(const GameState& state, const Player& catcher, int modi
 int countAssists(const GameState& state, Position targetPos, TeamSide assistingSide,
                  int excludeId1, int excludeId2, int tzExcludeId) {
     int count = 0;
-    auto adj = targetPos.getAdjacent();
-    for (auto& apos : adj) {
-        if (!apos.isOnPitch()) continue;
+    for (Position apos : onPitchNeighbours(targetPos)) {
         const Player* p = state.getPlayerAtPosition(apos);
         if (!p || p->teamSide != assistingSide) continue;
         if (p->id == excludeId1 || p->id == excludeId2) continue;
@@ -161,31 +171,17 @@ int getPushbackSquares(Position attackerPos, Position defenderPos, Position out[
     int dx = defenderPos.x - attackerPos.x;
     int dy = defenderPos.y - attackerPos.y;
     // Normalize
-    if (dx > 0) dx = 1; else if (dx < 0) dx = -1;
-    if (dy > 0) dy = 1; else if (dy < 0) dy = -1;
-
-    // 8 compass directions (clockwise from N)
-    static const int8_t compass[8][2] = {
-        {0,-1}, {1,-1}, {1,0}, {1,1}, {0,1}, {-1,1}, {-1,0}, {-1,-1}
-    };
-
-    // Find the direction index
-    int idx = 0;
-    for (int i = 0; i < 8; i++) {
-        if (compass[i][0] == dx && compass[i][1] == dy) {
-            idx = i;
-            break;
-        }
-    }
+    dx = (dx > 0) - (dx < 0);
+    dy = (dy > 0) - (dy < 0);
 
     // Three pushback directions: straight, CW 45°, CCW 45°
-    int dirs[3] = { idx, (idx + 1) % 8, (idx + 7) % 8 };
+    const auto& dirs = geometry::PUSHBACK_DIRS[(dy + 1) * 3 + (dx + 1)];
 
     int count = 0;
-    for (int i = 0; i < 3; i++) {
+    for (uint8_t d : dirs) {
         Position p{
-            static_cast<int8_t>(defenderPos.x + compass[dirs[i]][0]),
-            static_cast<int8_t>(defenderPos.y + compass[dirs[i]][1])
+            static_cast<int8_t>(defenderPos.x + geometry::COMPASS[d][0]),
+            static_cast<int8_t>(defenderPos.y + geometry::COMPASS[d][1])
         };
         if (p.isOnPitch()) {
             out[count++] = p;
@@ -196,11 +192,8 @@ int getPushbackSquares(Position attackerPos, Position defenderPos, Position out[
 
 Position scatterDirection(int d8) {
     // Clockwise from North: 1=N, 2=NE, 3=E, 4=SE, 5=S, 6=SW, 7=W, 8=NW
-    static const int8_t offsets[8][2] = {
-        {0,-1}, {1,-1}, {1,0}, {1,1}, {0,1}, {-1,1}, {-1,0}, {-1,-1}
-    };
     int idx = std::clamp(d8, 1, 8) - 1;
-    return {offsets[idx][0], offsets[idx][1]};
+    return {geometry::COMPASS[idx][0], geometry::COMPASS[idx][1]};
 }
 
 bool attemptRoll(GameState& state, int playerId, DiceRollerBase& dice,
@@ -217,8 +210,8 @@ bool attemptRoll(GameState& state, int playerId, DiceRollerBase& dice,
     if (skillReroll != SkillName::SKILL_COUNT &&
         player.hasSkill(skillReroll) && !skillNegatedByOpponent) {
         roll = dice.rollD6();
-        emitEvent(events, {GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
-                          static_cast<int>(skillReroll), roll >= target});
+        BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
+                              static_cast<int>(skillReroll), roll >= target);
         if (roll >= target) return true;
     }
 
@@ -228,8 +221,8 @@ bool attemptRoll(GameState& state, int playerId, DiceRollerBase& dice,
         int proRoll = dice.rollD6();
         if (proRoll >= 4) {
             roll = dice.rollD6();
-            emitEvent(events, {GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
-                              static_cast<int>(SkillName::Pro), roll >= target});
+            BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
+                                  static_cast<int>(SkillName::Pro), roll >= target);
             if (roll >= target) return true;
         }
     }
@@ -4,9 +4,32 @@
 
 namespace bb {
 
+namespace {
+
+// ResolutionMode::Expected: the median 2d6, 7, so armour breaks and each
+// injury band is reached exactly when that is more likely than not (Decay's
+// worse of two medians is the median). The 4+ saves, an even chance, are
+// taken as made.
+constexpr int MEDIAN_2D6 = 7;
+
+int expectedInjury(GameState& state, Player& player, const InjuryContext& ctx) {
+    int injuryRoll = MEDIAN_2D6 + ctx.injuryModifier;
+    if (player.hasSkill(SkillName::Stunty)) injuryRoll += 1;
+    if (injuryRoll <= 7 || (injuryRoll <= 9 && player.hasSkill(SkillName::ThickSkull)) ||
+        (injuryRoll > 9 && player.hasSkill(SkillName::Regeneration) && !ctx.hasStakes)) {
+        state.setPlayerState(player, PlayerState::STUNNED);
+    } else {
+        state.removePlayer(player, injuryRoll <= 9 ? PlayerState::KO : PlayerState::INJURED);
+    }
+    return injuryRoll;
+}
+
+} // anonymous namespace
+
 int resolveInjuryRoll(GameState& state, int playerId, DiceRollerBase& dice,
                       const InjuryContext& ctx, std::vector<GameEvent>* events) {
     Player& player = state.getPlayer(playerId);
+    if (dice.resolutionMode() == ResolutionMode::Expected) return expectedInjury(state, player, ctx);
 
     int d1 = dice.rollD6();
     int d2 = dice.rollD6();
@@ -32,44 +55,42 @@ int resolveInjuryRoll(GameState& state, int playerId, DiceRollerBase& dice,
 
     if (injuryRoll <= 7) {
         // Stunned
-        player.state = PlayerState::STUNNED;
-        emitEvent(events, {GameEvent::Type::INJURY, playerId, -1, player.position, {},
-                          injuryRoll, false, d1, d2});
+        state.setPlayerState(player, PlayerState::STUNNED);
+        BB_EMIT_EVENT(events, GameEvent::Type::INJURY, playerId, -1, player.position, {},
+                              injuryRoll, false, d1, d2);
     } else if (injuryRoll <= 9) {
         // KO — ThickSkull: 4+ saves from KO (stays stunned)
         if (player.hasSkill(SkillName::ThickSkull)) {
             int thickSkullRoll = dice.rollD6();
             if (thickSkullRoll >= 4) {
-                player.state = PlayerState::STUNNED;
-                emitEvent(events, {GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
-                                  static_cast<int>(SkillName::ThickSkull), true});
+                state.setPlayerState(player, PlayerState::STUNNED);
+                BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
+                                      static_cast<int>(SkillName::ThickSkull), true);
                 return injuryRoll;
             }
         }
-        player.state = PlayerState::KO;
-        player.position = {-1, -1};
-        emitEvent(events, {GameEvent::Type::INJURY, playerId, -1, {}, {},
-                          injuryRoll, false, d1, d2});
+        state.removePlayer(player, PlayerState::KO);
+        BB_EMIT_EVENT(events, GameEvent::Type::INJURY, playerId, -1, {}, {},
+                              injuryRoll, false, d1, d2);
     } else {
         // Casualty (10+)
         // Regeneration save (4+), blocked by Stakes
         if (player.hasSkill(SkillName::Regeneration) && !ctx.hasStakes) {
             int regenRoll = dice.rollD6();
-            emitEvent(events, {GameEvent::Type::REGENERATION, playerId, -1, {}, {},
-                              regenRoll, regenRoll >= 4});
+            BB_EMIT_EVENT(events, GameEvent::Type::REGENERATION, playerId, -1, {}, {},
+                                  regenRoll, regenRoll >= 4);
             if (regenRoll >= 4) {
-                player.state = PlayerState::STUNNED;
+                state.setPlayerState(player, PlayerState::STUNNED);
                 return injuryRoll;
             }
         }
-        player.state = PlayerState::INJURED;
-        player.position = {-1, -1};
-        emitEvent(events, {GameEvent::Type::CASUALTY, playerId, -1, {}, {},
-                          injuryRoll, false, d1, d2});
+        state.removePlayer(player, PlayerState::INJURED);
+        BB_EMIT_EVENT(events, GameEvent::Type::CASUALTY, playerId, -1, {}, {},
+                              injuryRoll, false, d1, d2);
 
         if (ctx.hasNurglesRot) {
-            emitEvent(events, {GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
-                              static_cast<int>(SkillName::NurglesRot), true});
+            BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, playerId, -1, {}, {},
+                                  static_cast<int>(SkillName::NurglesRot), true);
         }
     }
 
@@ -79,7 +100,14 @@ int resolveInjuryRoll(GameState& state, int playerId, DiceRollerBase& dice,
 bool resolveArmourAndInjury(GameState& state, int playerId, DiceRollerBase& dice,
                             const InjuryContext& ctx, std::vector<GameEvent>* events) {
     Player& player = state.getPlayer(playerId);
-    int av = player.stats.armour;
+    int av = player.stats().armour;
+
+    if (dice.resolutionMode() == ResolutionMode::Expected) {
+        int armourRoll = MEDIAN_2D6 + ctx.armourModifier;
+        bool broken = armourRoll > av || (ctx.hasClaw && armourRoll >= 8);
+        if (broken) expectedInjury(state, player, ctx);
+        return broken;
+    }
 
     int aD1 = dice.rollD6();
     int aD2 = dice.rollD6();
@@ -93,8 +121,8 @@ bool resolveArmourAndInjury(GameState& state, int playerId, DiceRollerBase& dice
         broken = (armourRoll > av);
     }
 
-    emitEvent(events, {GameEvent::Type::ARMOR_BREAK, playerId, -1, player.position, {},
-                      armourRoll, broken, aD1, aD2});
+    BB_EMIT_EVENT(events, GameEvent::Type::ARMOR_BREAK, playerId, -1, player.position, {},
+                          armourRoll, broken, aD1, aD2);
 
     if (broken) {
         resolveInjuryRoll(state, playerId, dice, ctx, events);
@@ -108,8 +136,8 @@ void resolveCrowdSurf(GameState& state, int playerId, DiceRollerBase& dice,
                       std::vector<GameEvent>* events) {
     Player& player = state.getPlayer(playerId);
 
-    emitEvent(events, {GameEvent::Type::INJURY, playerId, -1, player.position, {},
-                      0, true});
+    BB_EMIT_EVENT(events, GameEvent::Type::INJURY, playerId, -1, player.position, {},
+                          0, true);
 
     // Crowd injury: injury roll with +1
     InjuryContext ctx;
@@ -122,8 +150,7 @@ void resolveCrowdSurf(GameState& state, int playerId, DiceRollerBase& dice,
     // If player survived (KO), they're already placed off-pitch by injury resolver
     // If still on pitch (STUNNED from ThickSkull), remove them
     if (isOnPitch(player.state)) {
-        player.state = PlayerState::KO;
-        player.position = {-1, -1};
+        state.removePlayer(player, PlayerState::KO);
     }
 }
 
@@ -1,4 +1,5 @@
 #include "bb/kickoff_handler.h"
+#include "bb/geometry.h"
 #include "bb/ball_handler.h"
 #include "bb/helpers.h"
 #include <algorithm>
@@ -31,9 +32,7 @@ void movePlayerToward(GameState& state, int playerId, Position target) {
     int bestDist = p.position.distanceTo(target);
     Position bestPos = p.position;
 
-    auto adj = p.position.getAdjacent();
-    for (auto& pos : adj) {
-        if (!pos.isOnPitch()) continue;
+    for (Position pos : onPitchNeighbours(p.position)) {
         if (state.getPlayerAtPosition(pos) != nullptr) continue;
         int d = pos.distanceTo(target);
         if (d < bestDist) {
@@ -46,7 +45,7 @@ void movePlayerToward(GameState& state, int playerId, Position target) {
         if (state.ball.isHeld && state.ball.carrierId == playerId) {
             state.ball.position = bestPos;
         }
-        p.position = bestPos;
+        state.movePlayer(p, bestPos);
     }
 }
 
@@ -81,7 +80,7 @@ void resolveKickoffEvent(GameState& state, KickoffEvent event, TeamSide receivin
                 Player& p = state.getPlayer(closestId);
                 // Check no one is at ball position
                 if (!state.getPlayerAtPosition(state.ball.position)) {
-                    p.position = state.ball.position;
+                    state.movePlayer(p, state.ball.position);
                 }
             }
             break;
@@ -113,8 +112,8 @@ void resolveKickoffEvent(GameState& state, KickoffEvent event, TeamSide receivin
         case KickoffEvent::CHANGING_WEATHER: {
             int weatherRoll = dice.roll2D6();
             state.weather = weatherFromRoll(weatherRoll);
-            emitEvent(events, {GameEvent::Type::WEATHER_CHANGE, -1, -1, {}, {},
-                              weatherRoll, true});
+            BB_EMIT_EVENT(events, GameEvent::Type::WEATHER_CHANGE, -1, -1, {}, {},
+                                  weatherRoll, true);
             break;
         }
 
@@ -156,9 +155,9 @@ void resolveKickoffEvent(GameState& state, KickoffEvent event, TeamSide receivin
                     if (p.state != PlayerState::STANDING) return;
                     if (idx == target) {
                         Player& mp = state.getPlayer(p.id);
-                        mp.state = PlayerState::STUNNED;
-                        emitEvent(events, {GameEvent::Type::KNOCKED_DOWN, p.id, -1,
-                                          p.position, {}, 0, false});
+                        state.setPlayerState(mp, PlayerState::STUNNED);
+                        BB_EMIT_EVENT(events, GameEvent::Type::KNOCKED_DOWN, p.id, -1,
+                                              p.position, {}, 0, false);
                     }
                     idx++;
                 });
@@ -172,9 +171,9 @@ void resolveKickoffEvent(GameState& state, KickoffEvent event, TeamSide receivin
                 if (p.state != PlayerState::STANDING || !p.isOnPitch()) continue;
                 int roll = dice.rollD6();
                 if (roll == 6) {
-                    p.state = PlayerState::STUNNED;
-                    emitEvent(events, {GameEvent::Type::KNOCKED_DOWN, p.id, -1,
-                                      p.position, {}, roll, false});
+                    state.setPlayerState(p, PlayerState::STUNNED);
+                    BB_EMIT_EVENT(events, GameEvent::Type::KNOCKED_DOWN, p.id, -1,
+                                          p.position, {}, roll, false);
                 }
             }
             break;
@@ -195,8 +194,85 @@ bool hasKickPlayer(const GameState& state, TeamSide kickingTeam) {
     return found;
 }
 
+struct KickTables {
+    // [x][y][kick]
+    std::vector<KickTable> tables;
+
+    KickTables() : tables(static_cast<size_t>(Position::PITCH_WIDTH) * Position::PITCH_HEIGHT * 2) {
+        for (int x = 0; x < Position::PITCH_WIDTH; ++x) {
+            for (int y = 0; y < Position::PITCH_HEIGHT; ++y) {
+                for (int kick = 0; kick < 2; ++kick) {
+                    fill(tables[index({static_cast<int8_t>(x), static_cast<int8_t>(y)}, kick != 0)],
+                         x, y, kick != 0);
+                }
+            }
+        }
+    }
+
+    static void fill(KickTable& t, int x, int y, bool kick) {
+        for (int d6 = 1; d6 <= 6; ++d6) {
+            int dist = kick ? (d6 + 1) / 2 : d6;
+            for (int d8 = 1; d8 <= 8; ++d8) {
+                Position scatter = scatterDirection(d8);
+                Position land{static_cast<int8_t>(std::clamp(x + scatter.x * dist, 0, 25)),
+                              static_cast<int8_t>(std::clamp(y + scatter.y * dist, 0, 14))};
+                t.byRoll[d6 - 1][d8 - 1] = land;
+                int i = 0;
+                while (i < t.landingCount && t.landings[i].square != land) ++i;
+                if (i == t.landingCount) t.landings[t.landingCount++] = {land, 0.0f};
+                t.landings[i].probability += 1.0f / 48.0f;
+            }
+        }
+    }
+
+    static size_t index(Position target, bool kick) {
+        return (static_cast<size_t>(target.x) * Position::PITCH_HEIGHT + target.y) * 2 + (kick ? 1 : 0);
+    }
+};
+
 } // anonymous namespace
 
+Position kickTarget(const GameState& state) {
+    int kickX;
+    if (state.receiverSpeed == RosterSpeed::FAST) {
+        kickX = (state.kickingTeam == TeamSide::HOME) ? 18 : 7;
+    } else {
+        kickX = (state.kickingTeam == TeamSide::HOME) ? 22 : 3;
+    }
+    return {static_cast<int8_t>(kickX), 7};
+}
+
+const KickTable& kickTable(Position target, bool kickSkill) {
+    static const KickTables tables;
+    return tables.tables[KickTables::index(target, kickSkill)];
+}
+
+const std::array<float, 13>& kickoffEventOdds() {
+    static const std::array<float, 13> odds = [] {
+        std::array<float, 13> p{};
+        for (int d1 = 1; d1 <= 6; ++d1) {
+            for (int d2 = 1; d2 <= 6; ++d2) {
+                p[static_cast<size_t>(kickoffEventFromRoll(d1 + d2))] += 1.0f / 36.0f;
+            }
+        }
+        return p;
+    }();
+    return odds;
+}
+
+bool placeKickedBall(GameState& state, TeamSide receiving, Position landing) {
+    // Touchback: ball must land in receiving half
+    bool touchback = receiving == TeamSide::HOME ? landing.x > 12 : landing.x < 13;
+    int closestId = touchback ? findClosestPlayer(state, receiving, landing) : -1;
+    if (closestId >= 0) {
+        // Touchback: closest receiving player gets ball
+        state.ball = BallState::carried(state.getPlayer(closestId).position, closestId);
+    } else {
+        state.ball = BallState::onGround(landing);
+    }
+    return touchback;
+}
+
 void resolveKickoff(GameState& state, DiceRollerBase& dice, std::vector<GameEvent>* events) {
     TeamSide receiving = opponent(state.kickingTeam);
     state.activeTeam = receiving;
@@ -215,55 +291,15 @@ void resolveKickoff(GameState& state, DiceRollerBase& dice, std::vector<GameEven
     recvTeam.resetForNewTurn();
     state.resetPlayersForNewTurn(receiving);
 
-    // Kick target: short vs fast, deep vs slow/mixed
-    int kickX;
-    if (state.receiverSpeed == RosterSpeed::FAST) {
-        kickX = (state.kickingTeam == TeamSide::HOME) ? 18 : 7;
-    } else {
-        kickX = (state.kickingTeam == TeamSide::HOME) ? 22 : 3;
-    }
-    int kickY = 7;
-
-    // Scatter: D6 for distance, D8 for direction
+    // Scatter: D6 for distance, D8 for direction (Kick halves the distance)
+    const KickTable& kick = kickTable(kickTarget(state), hasKickPlayer(state, state.kickingTeam));
     int dist = dice.rollD6();
-    // Kick skill: halve scatter distance (round up)
-    if (hasKickPlayer(state, state.kickingTeam)) {
-        dist = (dist + 1) / 2;  // ceil(dist/2)
-    }
     int dir = dice.rollD8();
-    Position scatter = scatterDirection(dir);
-    int landX = kickX + scatter.x * dist;
-    int landY = kickY + scatter.y * dist;
-
-    // Clamp to pitch
-    landX = std::clamp(landX, 0, 25);
-    landY = std::clamp(landY, 0, 14);
-
-    Position landPos{static_cast<int8_t>(landX), static_cast<int8_t>(landY)};
-
-    // Check touchback: ball must land in receiving half
-    bool touchback = false;
-    if (receiving == TeamSide::HOME && landPos.x > 12) {
-        touchback = true;
-    } else if (receiving == TeamSide::AWAY && landPos.x < 13) {
-        touchback = true;
-    }
-
-    if (touchback) {
-        // Touchback: closest receiving player gets ball
-        int closestId = findClosestPlayer(state, receiving, landPos);
-        if (closestId >= 0) {
-            Player& p = state.getPlayer(closestId);
-            state.ball = BallState::carried(p.position, closestId);
-        } else {
-            state.ball = BallState::onGround(landPos);
-        }
-    } else {
-        state.ball = BallState::onGround(landPos);
-    }
+    Position landPos = kick.byRoll[dist - 1][dir - 1];
+    bool touchback = placeKickedBall(state, receiving, landPos);
 
     // Kickoff event
-    emitEvent(events, {GameEvent::Type::KICKOFF, -1, -1, {}, landPos, 0, true});
+    BB_EMIT_EVENT(events, GameEvent::Type::KICKOFF, -1, -1, {}, landPos, 0, true);
 
     // Roll 2D6 for kickoff table
     int kickoffRoll = dice.roll2D6();
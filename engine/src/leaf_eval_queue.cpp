@@ -0,0 +1,51 @@
+#include "bb/leaf_eval_queue.h"
+#include <algorithm>
+
+namespace bb {
+
+LeafEvalQueue::LeafEvalQueue(const ValueFunction* vf, int batchSize) {
+    reset(vf, batchSize);
+}
+
+void LeafEvalQueue::reset(const ValueFunction* vf, int batchSize) {
+    vf_ = vf;
+    batchSize_ = std::max(1, batchSize);
+    rowSize_ = vf ? vf->inputSize() : NUM_FEATURES;
+    clear();
+    features_.reserve(static_cast<size_t>(batchSize_) * rowSize_);
+    results_.reserve(batchSize_);
+}
+
+int LeafEvalQueue::push(const float* features) {
+    features_.insert(features_.end(), features, features + rowSize_);
+    results_.push_back(0.0f);
+    return size() - 1;
+}
+
+int LeafEvalQueue::push(const GameState& state, TeamSide perspective) {
+    size_t at = features_.size();
+    features_.resize(at + rowSize_);
+    float* row = &features_[at];
+    if (vf_) vf_->encodeState(state, perspective, row);
+    else extractFeatures(state, perspective, row);
+    results_.push_back(0.0f);
+    return size() - 1;
+}
+
+void LeafEvalQueue::flush() {
+    if (evaluated_ == size()) return;
+    if (vf_) {
+        vf_->evaluateBatch(&features_[static_cast<size_t>(evaluated_) * rowSize_],
+                           size() - evaluated_, rowSize_, &results_[evaluated_]);
+    }
+    evaluated_ = size();
+    batches_++;
+}
+
+void LeafEvalQueue::clear() {
+    features_.clear();
+    results_.clear();
+    evaluated_ = 0;
+}
+
+} // namespace bb
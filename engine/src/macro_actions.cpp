@@ -1,11 +1,29 @@
 #include "bb/macro_actions.h"
+#include "bb/alloc_tracking.h"
+#include "bb/geometry.h"
 #include "bb/action_resolver.h"
+#include "bb/block_odds.h"
 #include "bb/helpers.h"
+#include "bb/pathfinder.h"
+#include "bb/profile.h"
+#include "bb/risk_oracle.h"
 #include <algorithm>
+#include <bit>
 #include <cmath>
+#include <iterator>
 
 namespace bb {
 
+const char* macroTypeName(MacroType t) {
+    static constexpr const char* names[] = {
+        "SCORE", "ADVANCE", "CAGE", "BLITZ", "BLOCK", "PICKUP", "PASS_ACTION",
+        "FOUL", "REPOSITION", "END_TURN", "BLITZ_AND_SCORE", "HAND_OFF_SCORE",
+        "PASS_SCORE", "CHAIN_SCORE",
+    };
+    static_assert(std::size(names) == static_cast<size_t>(MacroType::MACRO_COUNT));
+    return names[static_cast<int>(t)];
+}
+
 // --- Helper functions ---
 
 static int endzoneX(TeamSide side) {
@@ -30,21 +48,21 @@ static const Player* findCarrier(const GameState& state) {
     return &p;
 }
 
-// Score a MOVE action: lower is better.
+// Score a step from `from` to `to` by a player of `side` with
+// `movementRemaining` left: lower is better.
 // Prefers: close to target, no enemy TZ, no GFI.
-static int scoreMoveAction(const GameState& state, const Action& a,
-                           Position target, int playerId) {
-    const Player& p = state.getPlayer(playerId);
-    int dist = a.target.distanceTo(target);
+static int scoreMoveStep(const GameState& state, TeamSide side, Position from,
+                         int movementRemaining, Position to, Position target) {
+    int dist = to.distanceTo(target);
 
     // Enemy tackle zones at destination
-    int destTZ = countTacklezones(state, a.target, p.teamSide);
+    int destTZ = countTacklezones(state, to, side);
 
     // Currently in TZ? (leaving requires dodge regardless of destination)
-    bool currentlyInTZ = countTacklezones(state, p.position, p.teamSide) > 0;
+    bool currentlyInTZ = countTacklezones(state, from, side) > 0;
 
     // GFI penalty: movementRemaining <= 0 means GFI roll needed
-    bool needsGfi = (p.movementRemaining <= 0);
+    bool needsGfi = (movementRemaining <= 0);
 
     // Score: distance * 10 + TZ penalty + GFI penalty
     // Distance is primary (each square = 10 points)
@@ -61,15 +79,22 @@ static int scoreMoveAction(const GameState& state, const Action& a,
         score += 8;  // GFI is risky
     }
     // Sideline penalty: avoid Y=0 and Y=14 (Frenzy crowd-surf risk)
-    if (a.target.y <= 1 || a.target.y >= 13) {
+    if (to.y <= 1 || to.y >= 13) {
         score += 6;  // mild sideline avoidance
     }
     return score;
 }
 
+// Score a MOVE action: lower is better.
+static int scoreMoveAction(const GameState& state, const Action& a,
+                           Position target, int playerId) {
+    const Player& p = state.getPlayer(playerId);
+    return scoreMoveStep(state, p.teamSide, p.position, p.movementRemaining, a.target, target);
+}
+
 // Find available MOVE action toward a target position.
 // Prefers safe routes (avoids enemy tackle zones and GFI).
-static bool findMoveToward(const std::vector<Action>& actions, int playerId,
+static bool findMoveToward(const ActionList& actions, int playerId,
                            Position target, Action& bestMove,
                            const GameState* state = nullptr) {
     int bestScore = 9999;
@@ -102,8 +127,8 @@ static bool isFreeToAct(const Player& p) {
 // Count block dice for attacker vs defender
 static int getBlockDiceCount(const GameState& state, const Player& att, const Player& def,
                              bool isBlitz) {
-    int attST = att.stats.strength;
-    int defST = def.stats.strength;
+    int attST = att.stats().strength;
+    int defST = def.stats().strength;
     if (isBlitz && att.hasSkill(SkillName::Horns)) attST += 1;
     int attAssists = countAssists(state, def.position, att.teamSide,
                                   att.id, def.id, def.id);
@@ -113,6 +138,20 @@ static int getBlockDiceCount(const GameState& state, const Player& att, const Pl
     return info.attackerChooses ? info.count : -info.count;
 }
 
+// Squares `p` must move to stand on `target` (or next to it, if it is
+// occupied), from the player's reachability map. Players who cannot get
+// there this turn rank after every player who can, by straight-line distance.
+static int pathDistance(const GameState& state, const Player& p, Position target) {
+    int straight = p.position.distanceTo(target);
+    if (straight <= 1) return straight;
+    const ReachabilityMap& reach = getReachability(state, p);
+    int c = reach.costTo(target);
+    if (c >= 0) return c;
+    Position adj;
+    if (canReachAdjacentTo(state, p, target, adj)) return reach.costTo(adj) + 1;
+    return 100 + straight;
+}
+
 // Find nearest free standing teammate to a position (excluding specific player)
 static const Player* findNearestFreePlayer(const GameState& state, Position target,
                                             int excludeId = -1) {
@@ -122,7 +161,7 @@ static const Player* findNearestFreePlayer(const GameState& state, Position targ
         if (p.id == excludeId) return;
         if (!isFreeToAct(p)) return;
         if (p.hasSkill(SkillName::BallAndChain)) return;
-        int d = p.position.distanceTo(target);
+        int d = pathDistance(state, p, target);
         if (d < bestDist) {
             bestDist = d;
             best = &p;
@@ -131,9 +170,61 @@ static const Player* findNearestFreePlayer(const GameState& state, Position targ
     return best;
 }
 
+// Visit the players whose bits are set in mask, in id order (the
+// forEachOnPitch order).
+template <typename F>
+static void forEachInMask(const GameState& state, uint32_t mask, F&& func) {
+    for (; mask != 0; mask &= mask - 1) {
+        func(state.getPlayer(std::countr_zero(mask)));
+    }
+}
+
+void computeTacticalContext(const GameState& state, TacticalContext& out) {
+    out = TacticalContext{};
+    TeamSide mySide = state.activeTeam;
+    out.side = mySide;
+    out.carrier = findCarrier(state);
+    out.ballOnGround = !state.ball.isHeld && state.ball.isOnPitch();
+    if (state.ball.isHeld && state.ball.carrierId > 0) {
+        const Player& holder = state.getPlayer(state.ball.carrierId);
+        if (holder.teamSide != mySide && holder.isOnPitch()) out.oppCarrier = &holder;
+    }
+
+    for (TeamSide side : {TeamSide::HOME, TeamSide::AWAY}) {
+        state.forEachOnPitch(side, [&](const Player& p) {
+            out.endzoneDist[p.id] = static_cast<int8_t>(distToEndzone(p.position, side));
+            out.reach[p.id] = static_cast<int8_t>(p.movementRemaining + 2);
+            out.tacklezones[p.id] = static_cast<int8_t>(countTacklezones(state, p.position, side));
+        });
+    }
+
+    const Bitboard& enemyStanding = state.standingOf(opponent(mySide));
+    state.forEachOnPitch(mySide, [&](const Player& p) {
+        uint32_t b = TacticalContext::bit(p.id);
+        uint32_t hot = p.hotSkills();
+        if (isFreeToAct(p) && !(hot & hotSkillBit(SkillName::BallAndChain))) out.freePlayers |= b;
+        if (p.state == PlayerState::STANDING && !p.hasActed &&
+            !(hot & hotSkillBit(SkillName::NoHands)) && &p != out.carrier) {
+            out.openReceivers |= b;
+        }
+        if ((Bitboard::adjacent(p.position) & enemyStanding).any()) out.engaged |= b;
+    });
+
+    state.forEachOnPitch(opponent(mySide), [&](const Player& op) {
+        if (op.state != PlayerState::STANDING) return;
+        if (op.stats().movement + 2 >= out.endzoneDist[op.id] && out.tacklezones[op.id] == 0) {
+            out.oppScoringThreats++;
+        }
+    });
+}
+
 // --- Macro Generation ---
 
-void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
+// Fills either list type (std::vector or MacroList).
+template <typename Out>
+static void availableMacros(const GameState& state, const TacticalContext& ctx, Out& out) {
+    BB_PROFILE_SCOPE(prof::GET_AVAILABLE_MACROS);
+    BB_ALLOC_SCOPE(alloc::MOVE_GEN);
     out.clear();
 
     if (state.phase != GamePhase::PLAY) return;
@@ -144,69 +235,53 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
     // Always: END_TURN
     out.push_back({MacroType::END_TURN, -1, -1, {-1, -1}});
 
-    const Player* carrier = findCarrier(state);
-    bool iHaveBall = (carrier != nullptr);
-    bool ballOnGround = !state.ball.isHeld && state.ball.isOnPitch();
+    const Player* carrier = ctx.carrier;
+    bool iHaveBall = ctx.hasBall();
+    bool ballOnGround = ctx.ballOnGround;
+
+    // Carrier's reach to the endzone, shared by the scoring macros below
+    int carrierDist = 0, carrierMaxReach = 0;
+    bool carrierStuck = false;  // can't walk in, or boxed in by 2+ tacklezones
+    if (iHaveBall) {
+        carrierDist = ctx.endzoneDist[carrier->id];
+        carrierMaxReach = ctx.reach[carrier->id];
+        carrierStuck = (carrierDist > carrierMaxReach) ||
+                       (ctx.tacklezones[carrier->id] >= 2 && carrierDist > 0);
+    }
 
     // SCORE: carrier can reach endzone with MA + 2 GFI
     if (iHaveBall && carrier->canAct()) {
-        int dist = distToEndzone(carrier->position, mySide);
-        int maxReach = carrier->movementRemaining + 2; // +2 GFI
-        if (dist <= maxReach && dist > 0) {
+        if (carrierDist <= carrierMaxReach && carrierDist > 0) {
             out.push_back({MacroType::SCORE, carrier->id, -1, {-1, -1}});
         }
     }
 
     // HAND_OFF_SCORE: carrier stuck/in heavy TZ, nearby teammate can score
-    if (iHaveBall && carrier->canAct() && !myTeam.passUsedThisTurn) {
-        int carrierDist = distToEndzone(carrier->position, mySide);
-        int carrierMaxReach = carrier->movementRemaining + 2;
-        int carrierTZ = countTacklezones(state, carrier->position, carrier->teamSide);
-        bool carrierStuck = (carrierDist > carrierMaxReach) || (carrierTZ >= 2 && carrierDist > 0);
-
-        if (carrierStuck) {
-            state.forEachOnPitch(mySide, [&](const Player& teammate) {
-                if (teammate.id == carrier->id) return;
-                if (teammate.state != PlayerState::STANDING) return;
-                if (teammate.hasActed) return;
-                if (teammate.hasSkill(SkillName::NoHands)) return;
-
-                int adjDist = carrier->position.distanceTo(teammate.position);
-                if (adjDist > 2) return; // carrier must reach adjacency within 1 move
-
-                int receiverDist = distToEndzone(teammate.position, mySide);
-                int receiverMaxReach = teammate.movementRemaining + 2;
-                if (receiverDist > 0 && receiverDist <= receiverMaxReach) {
-                    out.push_back({MacroType::HAND_OFF_SCORE, carrier->id, teammate.id, {-1, -1}});
-                }
-            });
-        }
+    if (iHaveBall && carrier->canAct() && !myTeam.passUsedThisTurn && carrierStuck) {
+        forEachInMask(state, ctx.openReceivers, [&](const Player& teammate) {
+            int adjDist = carrier->position.distanceTo(teammate.position);
+            if (adjDist > 2) return; // carrier must reach adjacency within 1 move
+
+            int receiverDist = ctx.endzoneDist[teammate.id];
+            if (receiverDist > 0 && receiverDist <= ctx.reach[teammate.id]) {
+                out.push_back({MacroType::HAND_OFF_SCORE, carrier->id, teammate.id, {-1, -1}});
+            }
+        });
     }
 
     // PASS_SCORE: carrier stuck, pass (longer range) to teammate who can score
     if (iHaveBall && carrier->canAct() && !myTeam.passUsedThisTurn) {
-        int carrierDist = distToEndzone(carrier->position, mySide);
-        int carrierMaxReach = carrier->movementRemaining + 2;
-        int carrierTZ = countTacklezones(state, carrier->position, carrier->teamSide);
-        bool carrierStuck = (carrierDist > carrierMaxReach) || (carrierTZ >= 2 && carrierDist > 0);
-
         if (carrierStuck) {
             int bestScore = -999;
             int bestTargetId = -1;
-            state.forEachOnPitch(mySide, [&](const Player& teammate) {
-                if (teammate.id == carrier->id) return;
-                if (teammate.state != PlayerState::STANDING) return;
-                if (teammate.hasActed) return;
-                if (teammate.hasSkill(SkillName::NoHands)) return;
-
+            forEachInMask(state, ctx.openReceivers, [&](const Player& teammate) {
                 int passDist = carrier->position.distanceTo(teammate.position);
                 if (passDist < 2 || passDist > 10) return; // hand-off is separate; max pass ~10
 
-                int receiverDist = distToEndzone(teammate.position, mySide);
-                int receiverMaxReach = teammate.movementRemaining + 2;
-                if (receiverDist <= 0 || receiverDist > receiverMaxReach) return;
+                int receiverDist = ctx.endzoneDist[teammate.id];
+                if (receiverDist <= 0 || receiverDist > ctx.reach[teammate.id]) return;
 
-                int score = teammate.stats.agility * 5 - passDist;
+                int score = teammate.stats().agility * 5 - passDist;
                 if (teammate.hasSkill(SkillName::Catch)) score += 5;
                 if (score > bestScore) {
                     bestScore = score;
@@ -221,36 +296,24 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
 
     // CHAIN_SCORE: carrier passes to relay, relay hand-offs to scorer near endzone
     if (iHaveBall && carrier->canAct() && !myTeam.passUsedThisTurn) {
-        int carrierDist = distToEndzone(carrier->position, mySide);
-        int carrierMaxReach = carrier->movementRemaining + 2;
-        bool carrierStuck = (carrierDist > carrierMaxReach);
-
-        if (carrierStuck) {
+        if (carrierDist > carrierMaxReach) {
             int bestChainScore = -999;
             int bestRelayId = -1, bestScorerId = -1;
 
-            state.forEachOnPitch(mySide, [&](const Player& relay) {
-                if (relay.id == carrier->id) return;
-                if (relay.state != PlayerState::STANDING || relay.hasActed) return;
-                if (relay.hasSkill(SkillName::NoHands)) return;
-
+            forEachInMask(state, ctx.openReceivers, [&](const Player& relay) {
                 int passDist = carrier->position.distanceTo(relay.position);
                 if (passDist < 1 || passDist > 10) return;
 
-                state.forEachOnPitch(mySide, [&](const Player& scorer) {
-                    if (scorer.id == carrier->id || scorer.id == relay.id) return;
-                    if (scorer.state != PlayerState::STANDING || scorer.hasActed) return;
-                    if (scorer.hasSkill(SkillName::NoHands)) return;
-
+                uint32_t scorers = ctx.openReceivers & ~TacticalContext::bit(relay.id);
+                forEachInMask(state, scorers, [&](const Player& scorer) {
                     int adjDist = relay.position.distanceTo(scorer.position);
                     if (adjDist > 2) return; // relay must reach adjacency for hand-off
 
-                    int scorerDist = distToEndzone(scorer.position, mySide);
-                    int scorerMaxReach = scorer.movementRemaining + 2;
-                    if (scorerDist <= 0 || scorerDist > scorerMaxReach) return;
+                    int scorerDist = ctx.endzoneDist[scorer.id];
+                    if (scorerDist <= 0 || scorerDist > ctx.reach[scorer.id]) return;
 
-                    int score = relay.stats.agility * 3 + scorer.stats.agility * 5
-                              + scorer.stats.movement - passDist * 2;
+                    int score = relay.stats().agility * 3 + scorer.stats().agility * 5
+                              + scorer.stats().movement - passDist * 2;
                     if (relay.hasSkill(SkillName::Catch)) score += 5;
                     if (scorer.hasSkill(SkillName::Catch)) score += 3;
                     if (score > bestChainScore) {
@@ -271,22 +334,14 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
 
     // ADVANCE: carrier can move forward but can't score
     if (iHaveBall && carrier->canAct() && carrier->movementRemaining > 0) {
-        int dist = distToEndzone(carrier->position, mySide);
-        int maxReach = carrier->movementRemaining + 2;
-        if (dist > maxReach) {
+        if (carrierDist > carrierMaxReach) {
             out.push_back({MacroType::ADVANCE, carrier->id, -1, {-1, -1}});
         }
     }
 
     // CAGE: have ball and at least one free teammate
     if (iHaveBall) {
-        bool hasFreePlayer = false;
-        state.forEachOnPitch(mySide, [&](const Player& p) {
-            if (p.id != carrier->id && isFreeToAct(p) && !p.hasSkill(SkillName::BallAndChain)) {
-                hasFreePlayer = true;
-            }
-        });
-        if (hasFreePlayer) {
+        if ((ctx.freePlayers & ~TacticalContext::bit(carrier->id)) != 0) {
             out.push_back({MacroType::CAGE, carrier->id, -1, {-1, -1}});
         }
     }
@@ -303,17 +358,14 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
             int targetId;
             int bestScore;
         };
-        std::vector<BlitzCandidate> candidates;
+        InlineVector<BlitzCandidate, 11> candidates;
 
         state.forEachOnPitch(opponent(mySide), [&](const Player& def) {
             if (def.state != PlayerState::STANDING) return;
 
             int targetBestScore = -999;
 
-            state.forEachOnPitch(mySide, [&](const Player& blitzer) {
-                if (!isFreeToAct(blitzer)) return;
-                if (blitzer.hasSkill(SkillName::BallAndChain)) return;
-
+            forEachInMask(state, ctx.freePlayers, [&](const Player& blitzer) {
                 int dice = getBlockDiceCount(state, blitzer, def, true);
                 int score = dice * 2;
 
@@ -330,13 +382,11 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
                         score += 10;
                     }
                     // Opponent scoring threat (can score this turn)
-                    int oppEzX = (def.teamSide == TeamSide::HOME) ? 25 : 0;
-                    int distEz = std::abs(def.position.x - oppEzX);
-                    if (def.stats.movement + 2 >= distEz) {
+                    if (def.stats().movement + 2 >= ctx.endzoneDist[def.id]) {
                         score += 4;
                     }
                     // Free opponent (no friendly TZ on them) — more dangerous
-                    if (countTacklezones(state, def.position, def.teamSide) == 0) {
+                    if (ctx.tacklezones[def.id] == 0) {
                         score += 2;
                     }
                 } else {
@@ -376,13 +426,8 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
     // BLITZ_AND_SCORE: carrier can almost reach endzone, but opponent blocks path
     // Blitz the blocker out of the way, then move carrier to score
     if (iHaveBall && carrier->canAct() && !myTeam.blitzUsedThisTurn) {
-        int dist = distToEndzone(carrier->position, mySide);
-        int maxReach = carrier->movementRemaining + 2;
-        int ezX = endzoneX(mySide);
-        int dx = forwardDx(mySide);
-
         // Carrier can't directly score (SCORE not available) or would need to go through enemies
-        if (dist > 0 && dist <= maxReach + 3) {
+        if (carrierDist > 0 && carrierDist <= carrierMaxReach + 3) {
             // Find opponent on the path between carrier and endzone
             int bestBlocker = -1;
             int bestBlockerDist = 999;
@@ -390,8 +435,7 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
                 if (def.state != PlayerState::STANDING) return;
                 // Is the defender roughly between carrier and endzone?
                 int defDist = distToEndzone(def.position, mySide);
-                int carrierDistEz = distToEndzone(carrier->position, mySide);
-                if (defDist >= carrierDistEz) return; // defender is behind carrier
+                if (defDist >= carrierDist) return; // defender is behind carrier
                 // Is defender close to carrier's path (within 2 Y)?
                 int yDiff = std::abs(def.position.y - carrier->position.y);
                 if (yDiff > 2) return;
@@ -417,9 +461,7 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
         if (!att.canAct() || att.hasActed) return;
         if (att.hasSkill(SkillName::BallAndChain)) return;
 
-        auto adj = att.position.getAdjacent();
-        for (auto& pos : adj) {
-            if (!pos.isOnPitch()) continue;
+        for (Position pos : onPitchNeighbours(att.position)) {
             const Player* def = state.getPlayerAtPosition(pos);
             if (!def || def->teamSide == mySide) continue;
             if (def->state != PlayerState::STANDING) continue;
@@ -449,16 +491,13 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
         // worse -- emitting it would only donate floored prior mass.
         constexpr int kSecondPickerMaxGap = 15;
 
-        state.forEachOnPitch(mySide, [&](const Player& p) {
-            if (!isFreeToAct(p)) return;
-            if (p.hasSkill(SkillName::BallAndChain)) return;
+        forEachInMask(state, ctx.freePlayers, [&](const Player& p) {
             if (p.hasSkill(SkillName::NoHands)) return;
 
             int dist = p.position.distanceTo(state.ball.position);
-            int maxReach = p.movementRemaining + 2;
-            if (dist > maxReach) return;
+            if (dist > ctx.reach[p.id]) return;
 
-            int score = p.stats.agility * 10 - dist * 3;
+            int score = p.stats().agility * 10 - dist * 3;
             if (p.hasSkill(SkillName::SureHands)) score += 15;
             if (p.hasSkill(SkillName::BigHand)) score += 5;
 
@@ -519,9 +558,7 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
             if (!fouler.canAct() || fouler.hasActed) return;
             if (fouler.hasSkill(SkillName::BallAndChain)) return;
 
-            auto adj = fouler.position.getAdjacent();
-            for (auto& pos : adj) {
-                if (!pos.isOnPitch()) continue;
+            for (Position pos : onPitchNeighbours(fouler.position)) {
                 const Player* target = state.getPlayerAtPosition(pos);
                 if (!target || target->teamSide == mySide) continue;
                 if (target->state != PlayerState::PRONE &&
@@ -546,43 +583,13 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
     int endzoneGuardCount = 0;
     int screenSlot = 0;
 
-    // Pre-compute defensive info
-    const Player* oppCarrierPtr = nullptr;
-    int oppScoringThreatCount = 0;
-    if (onDefense) {
-        if (state.ball.isHeld && state.ball.carrierId > 0) {
-            oppCarrierPtr = &state.getPlayer(state.ball.carrierId);
-            if (!oppCarrierPtr->isOnPitch()) oppCarrierPtr = nullptr;
-        }
-        state.forEachOnPitch(opponent(mySide), [&](const Player& op) {
-            if (op.state != PlayerState::STANDING) return;
-            int oppEzX = (op.teamSide == TeamSide::HOME) ? 25 : 0;
-            int dist = std::abs(op.position.x - oppEzX);
-            if (op.stats.movement + 2 >= dist &&
-                countTacklezones(state, op.position, op.teamSide) == 0) {
-                oppScoringThreatCount++;
-            }
-        });
-    }
+    const Player* oppCarrierPtr = ctx.oppCarrier;
+    int oppScoringThreatCount = ctx.oppScoringThreats;
 
-    state.forEachOnPitch(mySide, [&](const Player& p) {
-        if (!isFreeToAct(p)) return;
-        if (p.hasSkill(SkillName::BallAndChain)) return;
+    // Free players with no adjacent enemies
+    forEachInMask(state, ctx.freePlayers & ~ctx.engaged, [&](const Player& p) {
         if (iHaveBall && p.id == carrier->id) return; // carrier has SCORE/ADVANCE
 
-        // Check if player is free (no adjacent enemies)
-        bool hasAdjacentEnemy = false;
-        auto adj = p.position.getAdjacent();
-        for (auto& pos : adj) {
-            if (!pos.isOnPitch()) continue;
-            const Player* other = state.getPlayerAtPosition(pos);
-            if (other && other->teamSide != mySide && other->state == PlayerState::STANDING) {
-                hasAdjacentEnemy = true;
-                break;
-            }
-        }
-        if (hasAdjacentEnemy) return;
-
         Position target;
 
         if (ballOnGround) {
@@ -596,13 +603,13 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
 
             // Hunter/shield split: fast players (MA≥7) pressure opponent scoring threats
             // while slow players stay as shields near carrier
-            if (!hunterPlaced && p.stats.movement >= 7 && carrierDist > 4) {
+            if (!hunterPlaced && p.stats().movement >= 7 && carrierDist > 4) {
                 Position huntTarget = carrier->position;
                 int bestThreat = -999;
                 state.forEachOnPitch(opponent(mySide), [&](const Player& opp) {
                     if (opp.state != PlayerState::STANDING) return;
-                    int threat = opp.stats.movement * 2 + opp.stats.agility;
-                    if (countTacklezones(state, opp.position, opp.teamSide) == 0) threat += 5;
+                    int threat = opp.stats().movement * 2 + opp.stats().agility;
+                    if (ctx.tacklezones[opp.id] == 0) threat += 5;
                     if (threat > bestThreat) {
                         bestThreat = threat;
                         huntTarget = opp.position;
@@ -613,7 +620,7 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
             }
             // Receiver setup: when ≤2 turns left, send fast player near endzone
             // as a pass/hand-off target for next turn's scoring chain
-            else if (!receiverPlaced && turnsLeft <= 2 && p.stats.movement >= 6 &&
+            else if (!receiverPlaced && turnsLeft <= 2 && p.stats().movement >= 6 &&
                 carrierDist > 3) {
                 int recvY = carrier->position.y + ((p.position.y > carrier->position.y) ? 2 : -2);
                 recvY = std::clamp(recvY, 2, 12);
@@ -646,9 +653,7 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
                 if (cageCount >= 2) {
                     Position bestCorner = oppCarrierPtr->position;
                     int minFriendlyTZ = 999;
-                    auto adj = oppCarrierPtr->position.getAdjacent();
-                    for (auto& apos : adj) {
-                        if (!apos.isOnPitch()) continue;
+                    for (Position apos : onPitchNeighbours(oppCarrierPtr->position)) {
                         if (state.getPlayerAtPosition(apos)) continue;
                         int friendlyTZ = countTacklezones(state, apos, opponent(mySide));
                         if (friendlyTZ < minFriendlyTZ) {
@@ -690,7 +695,7 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
                 // falls through to Strategies 1-4 unchanged.
                 bool goalSide =
                     (p.position.x - oppCarrierPtr->position.x) * dxOpp >= -2;
-                if (goalSide && p.position.distanceTo(lane) <= p.stats.movement * 2) {
+                if (goalSide && p.position.distanceTo(lane) <= p.stats().movement * 2) {
                     target = lane;
                     interceptPlaced = true;
                     usedIntercept = true;
@@ -698,7 +703,7 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
             }
             if (!usedIntercept) {
             // Strategy 1: Safety player (fast, near our endzone)
-            if (!safetyPlaced && p.stats.movement >= 6) {
+            if (!safetyPlaced && p.stats().movement >= 6) {
                 target = {static_cast<int8_t>(myEndzone),
                           static_cast<int8_t>(7)};
                 safetyPlaced = true;
@@ -738,6 +743,22 @@ void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
     });
 }
 
+void getAvailableMacros(const GameState& state, std::vector<Macro>& out) {
+    TacticalContext ctx;
+    computeTacticalContext(state, ctx);
+    availableMacros(state, ctx, out);
+}
+
+void getAvailableMacros(const GameState& state, MacroList& out) {
+    TacticalContext ctx;
+    computeTacticalContext(state, ctx);
+    availableMacros(state, ctx, out);
+}
+
+void getAvailableMacros(const GameState& state, const TacticalContext& ctx, MacroList& out) {
+    availableMacros(state, ctx, out);
+}
+
 // --- Macro Expansion ---
 
 // Execute a single action, add to result, return true if turnover
@@ -752,33 +773,123 @@ static bool executeAndRecord(GameState& state, const Action& action,
     return false;
 }
 
-// Find and execute MOVE actions for playerId toward target, up to maxSteps.
-// Uses state-aware scoring to avoid enemy tackle zones (prefers safe routes).
+// Greedy route toward a target, planned on a frozen board. Each step is the
+// MOVE findMoveToward would pick from the square before it, with the same
+// detour and loop cut-offs. Only the mover changes square while it walks, so
+// the legal steps, their tacklezone scores and the GFI flag can all be worked
+// out ahead from the board minus the mover instead of from a fresh action
+// list per square.
+struct MoveRoute {
+    Position steps[MAX_PATH_LENGTH];
+    int count = 0;
+    int movementRemaining = 0;  // mover's allowance when planned
+    Bitboard others;            // occupied squares, mover excluded
+    Bitboard enemyStanding;     // source of every tacklezone score
+};
+
+// Plan up to maxSteps moves for standing player p. lastPos is the square p
+// stood on before its previous step ({-1,-1} if none). Stops short when p
+// arrives or when the step-by-step loop would stop (no legal move, detour
+// or back-step); count is 0 if p cannot move at all.
+static void planMoveRoute(const GameState& state, const Player& p, Position target,
+                          Position lastPos, int maxSteps, MoveRoute& route) {
+    route.count = 0;
+    route.movementRemaining = p.movementRemaining;
+    route.others = state.occupied();
+    route.others.clear(Bitboard::indexOf(p.position));
+    route.enemyStanding = state.standingOf(opponent(p.teamSide));
+
+    // Same preconditions under which getAvailableActions lists p's MOVEs
+    if (state.phase != GamePhase::PLAY || p.teamSide != state.activeTeam) return;
+    if (!p.canAct() || p.hasSkill(SkillName::BallAndChain)) return;
+
+    int maxGfi = p.hasSkill(SkillName::Sprint) ? 3 : 2;
+    int ma = p.movementRemaining;
+    Position pos = p.position;
+    maxSteps = std::min(maxSteps, MAX_PATH_LENGTH);
+    while (route.count < maxSteps && pos != target && ma - 1 >= -maxGfi) {
+        // Ascending square order, as the MOVEs appear in the action list;
+        // ties keep the first, as findMoveToward does.
+        Position best{-1, -1};
+        int bestScore = 9999;
+        Bitboard::adjacent(pos).andNot(route.others).forEach([&](int sq) {
+            Position to = Bitboard::positionOf(sq);
+            int score = scoreMoveStep(state, p.teamSide, pos, ma, to, target);
+            if (score < bestScore) {
+                bestScore = score;
+                best = to;
+            }
+        });
+        if (best.x < 0) break;
+
+        int currentDist = pos.distanceTo(target);
+        int moveDist = best.distanceTo(target);
+        if (moveDist > currentDist + 1) break;
+        if (moveDist >= currentDist && best == lastPos) break;
+
+        route.steps[route.count++] = best;
+        lastPos = pos;
+        pos = best;
+        --ma;
+    }
+}
+
+// Did step i of the route go exactly as planned, leaving the rest valid?
+// A knockdown, a failed or skipped step (Tentacles, Bone Head), or anything
+// that moved or felled another player means the route must be replanned.
+static bool followsRoute(const GameState& state, const Player& p,
+                         const MoveRoute& route, int i) {
+    if (state.phase != GamePhase::PLAY || p.teamSide != state.activeTeam) return false;
+    if (p.position != route.steps[i] || !p.canAct()) return false;
+    if (p.movementRemaining != route.movementRemaining - (i + 1)) return false;
+    Bitboard expected = route.others;
+    expected.set(p.position);
+    return state.occupied() == expected &&
+           state.standingOf(opponent(p.teamSide)) == route.enemyStanding;
+}
+
+// Move playerId toward target, up to maxSteps, by the same greedy square-by-
+// square choice as findMoveToward (TZ-avoiding, safe routes preferred). The
+// route is planned once and walked, and replanned only when a step does not
+// go as planned.
 static bool movePlayerToward(GameState& state, int playerId, Position target,
                               DiceRollerBase& dice, MacroExpansionResult& result,
                               int maxSteps = 12) {
     Position lastPos{-1, -1};  // Detect loops
-    for (int step = 0; step < maxSteps; ++step) {
+    int step = 0;
+    while (step < maxSteps) {
         const Player& p = state.getPlayer(playerId);
         if (!p.isOnPitch() || p.lostTacklezones) return false;
         if (p.position == target) return true; // arrived
 
-        // Get available actions
-        std::vector<Action> actions;
-        getAvailableActions(state, actions);
-
-        // Find best move toward target (with TZ avoidance)
-        Action bestMove;
-        if (!findMoveToward(actions, playerId, target, bestMove, &state)) return false;
+        if (p.state != PlayerState::STANDING) {
+            // Prone: the stand-up MOVE goes through the action list
+            ActionList actions;
+            getPlayerActions(state, p, actions);
+            Action bestMove;
+            if (!findMoveToward(actions, playerId, target, bestMove, &state)) return false;
+            int currentDist = p.position.distanceTo(target);
+            int moveDist = bestMove.target.distanceTo(target);
+            if (moveDist > currentDist + 1) return false; // max 1 square detour
+            if (moveDist >= currentDist && bestMove.target == lastPos) return false; // loop
+
+            lastPos = p.position;
+            ++step;
+            if (executeAndRecord(state, bestMove, dice, result)) return false;
+            continue;
+        }
 
-        // Allow sideways moves to dodge around opponents, but don't go too far
-        int currentDist = p.position.distanceTo(target);
-        int moveDist = bestMove.target.distanceTo(target);
-        if (moveDist > currentDist + 1) return false; // max 1 square detour
-        if (moveDist >= currentDist && bestMove.target == lastPos) return false; // loop
+        MoveRoute route;
+        planMoveRoute(state, p, target, lastPos, maxSteps - step, route);
+        if (route.count == 0) return false;
 
-        lastPos = p.position;
-        if (executeAndRecord(state, bestMove, dice, result)) return false;
+        for (int i = 0; i < route.count; ++i) {
+            lastPos = p.position;
+            ++step;
+            Action move{ActionType::MOVE, playerId, -1, route.steps[i]};
+            if (executeAndRecord(state, move, dice, result)) return false;
+            if (!followsRoute(state, p, route, i)) break;  // replan
+        }
     }
     return false;
 }
@@ -855,7 +966,7 @@ static bool carrierIsBlitzable(const GameState& state, const Player& carrier) {
     state.forEachOnPitch(opponent(carrier.teamSide), [&](const Player& opp) {
         if (blitzable) return;
         if (opp.state != PlayerState::STANDING) return;
-        if (opp.position.distanceTo(carrier.position) <= opp.stats.movement) {
+        if (opp.position.distanceTo(carrier.position) <= opp.stats().movement) {
             blitzable = true;
         }
     });
@@ -955,7 +1066,7 @@ static MacroExpansionResult expandBlitz(GameState& state, const Macro& macro,
     const Player& target = state.getPlayer(macro.targetId);
 
     // Find best BLITZ action for this target (prefer more dice, closer blitzer)
-    std::vector<Action> actions;
+    ActionList actions;
     getAvailableActions(state, actions);
 
     Action bestBlitzAction{};
@@ -966,7 +1077,7 @@ static MacroExpansionResult expandBlitz(GameState& state, const Macro& macro,
         if (a.type != ActionType::BLITZ || a.targetId != macro.targetId) continue;
         const Player& blitzer = state.getPlayer(a.playerId);
         int diceCount = getBlockDiceCount(state, blitzer, target, true);
-        int dist = blitzer.position.distanceTo(target.position);
+        int dist = pathDistance(state, blitzer, target.position);
         int score = diceCount * 10 - dist; // more dice + closer = better
         if (score > bestScore) {
             bestScore = score;
@@ -989,7 +1100,7 @@ static MacroExpansionResult expandBlitzAndScore(GameState& state, const Macro& m
     const Player& blocker = state.getPlayer(macro.targetId);
     int carrierId = macro.playerId;
 
-    std::vector<Action> actions;
+    ActionList actions;
     getAvailableActions(state, actions);
 
     // Find the best blitzer for this target (prefer non-carrier with good dice)
@@ -1067,7 +1178,7 @@ static MacroExpansionResult expandBlock(GameState& state, const Macro& macro,
                                          DiceRollerBase& dice) {
     MacroExpansionResult result;
 
-    std::vector<Action> actions;
+    ActionList actions;
     getAvailableActions(state, actions);
 
     for (auto& a : actions) {
@@ -1112,21 +1223,26 @@ static MacroExpansionResult expandPickup(GameState& state, const Macro& macro,
     return result;
 }
 
+// The PASS or HAND_OFF (`type`) from giverId to receiverId, as
+// getAvailableActions would list it; false if it would not. Checked on its
+// own: the ball macros only ever need this one action, not every player's.
+static bool ballActionTo(const GameState& state, ActionType type, int giverId, int receiverId,
+                         Action& out) {
+    if (receiverId < 1 || receiverId > 22) return false;
+    out = {type, giverId, receiverId, state.getPlayer(receiverId).position};
+    return isActionLegal(state, out);
+}
+
 static MacroExpansionResult expandPass(GameState& state, const Macro& macro,
                                         DiceRollerBase& dice) {
     MacroExpansionResult result;
 
-    std::vector<Action> actions;
-    getAvailableActions(state, actions);
-
     // Try HAND_OFF first (safer), then PASS
     for (ActionType passType : {ActionType::HAND_OFF, ActionType::PASS}) {
-        for (auto& a : actions) {
-            if (a.type == passType && a.playerId == macro.playerId &&
-                a.targetId == macro.targetId) {
-                executeAndRecord(state, a, dice, result);
-                return result;
-            }
+        Action a;
+        if (ballActionTo(state, passType, macro.playerId, macro.targetId, a)) {
+            executeAndRecord(state, a, dice, result);
+            return result;
         }
     }
     return result;
@@ -1136,7 +1252,7 @@ static MacroExpansionResult expandFoul(GameState& state, const Macro& macro,
                                         DiceRollerBase& dice) {
     MacroExpansionResult result;
 
-    std::vector<Action> actions;
+    ActionList actions;
     getAvailableActions(state, actions);
 
     for (auto& a : actions) {
@@ -1199,18 +1315,9 @@ static MacroExpansionResult expandHandOffScore(GameState& state, const Macro& ma
 
     // Step 2: Execute HAND_OFF
     {
-        std::vector<Action> actions;
-        getAvailableActions(state, actions);
-        bool executed = false;
-        for (auto& a : actions) {
-            if (a.type == ActionType::HAND_OFF && a.playerId == carrierId &&
-                a.targetId == receiverId) {
-                if (executeAndRecord(state, a, dice, result)) return result;
-                executed = true;
-                break;
-            }
-        }
-        if (!executed) return result;
+        Action handOff;
+        if (!ballActionTo(state, ActionType::HAND_OFF, carrierId, receiverId, handOff)) return result;
+        if (executeAndRecord(state, handOff, dice, result)) return result;
     }
 
     // Step 3: Move receiver to score
@@ -1232,19 +1339,9 @@ static MacroExpansionResult expandPassScore(GameState& state, const Macro& macro
     if (carrierId <= 0 || receiverId <= 0) return result;
 
     // Step 1: Pass to receiver
-    std::vector<Action> actions;
-    getAvailableActions(state, actions);
-
-    bool passed = false;
-    for (auto& a : actions) {
-        if (a.type == ActionType::PASS && a.playerId == carrierId &&
-            a.targetId == receiverId) {
-            if (executeAndRecord(state, a, dice, result)) return result;
-            passed = true;
-            break;
-        }
-    }
-    if (!passed) return result;
+    Action pass;
+    if (!ballActionTo(state, ActionType::PASS, carrierId, receiverId, pass)) return result;
+    if (executeAndRecord(state, pass, dice, result)) return result;
 
     // Step 2: Move receiver to endzone (if catch succeeded)
     if (!state.ball.isHeld || state.ball.carrierId != receiverId) return result;
@@ -1266,18 +1363,9 @@ static MacroExpansionResult expandChainScore(GameState& state, const Macro& macr
     if (carrierId <= 0 || relayId <= 0 || scorerId <= 0) return result;
 
     // Step 1: Pass to relay
-    std::vector<Action> actions;
-    getAvailableActions(state, actions);
-    bool passed = false;
-    for (auto& a : actions) {
-        if (a.type == ActionType::PASS && a.playerId == carrierId &&
-            a.targetId == relayId) {
-            if (executeAndRecord(state, a, dice, result)) return result;
-            passed = true;
-            break;
-        }
-    }
-    if (!passed) return result;
+    Action pass;
+    if (!ballActionTo(state, ActionType::PASS, carrierId, relayId, pass)) return result;
+    if (executeAndRecord(state, pass, dice, result)) return result;
     if (!state.ball.isHeld || state.ball.carrierId != relayId) return result;
 
     // Step 2: Relay moves adjacent to scorer and hand-offs
@@ -1294,14 +1382,10 @@ static MacroExpansionResult expandChainScore(GameState& state, const Macro& macr
     }
 
     // Hand-off to scorer
-    actions.clear();
-    getAvailableActions(state, actions);
-    for (auto& a : actions) {
-        if (a.type == ActionType::HAND_OFF && a.playerId == relayId &&
-            a.targetId == scorerId) {
-            if (executeAndRecord(state, a, dice, result)) return result;
-            break;
-        }
+    Action handOff;
+    if (ballActionTo(state, ActionType::HAND_OFF, relayId, scorerId, handOff) &&
+        executeAndRecord(state, handOff, dice, result)) {
+        return result;
     }
     if (!state.ball.isHeld || state.ball.carrierId != scorerId) return result;
 
@@ -1316,6 +1400,8 @@ static MacroExpansionResult expandChainScore(GameState& state, const Macro& macr
 
 MacroExpansionResult greedyExpandMacro(GameState& state, const Macro& macro,
                                        DiceRollerBase& dice) {
+    BB_PROFILE_SCOPE(prof::EXPAND_MACRO + static_cast<int>(macro.type));
+    BB_ALLOC_SCOPE(alloc::MACRO_EXPANSION);
     switch (macro.type) {
         case MacroType::SCORE:       return expandScore(state, macro, dice);
         case MacroType::ADVANCE:     return expandAdvance(state, macro, dice);
@@ -1338,6 +1424,24 @@ MacroExpansionResult greedyExpandMacro(GameState& state, const Macro& macro,
 // --- Macro Feature Extraction ---
 
 void extractMacroFeatures(const GameState& state, const Macro& macro, float* out) {
+    TacticalContext ctx;
+    computeTacticalContext(state, ctx);
+    extractMacroFeatures(state, ctx, macro, out);
+}
+
+void extractMacroFeatures(const GameState& state, const Macro* macros, int n, float* out) {
+    TacticalContext ctx;
+    computeTacticalContext(state, ctx);
+    extractMacroFeatures(state, ctx, macros, n, out);
+}
+
+void extractMacroFeatures(const GameState& state, const TacticalContext& ctx,
+                          const Macro* macros, int n, float* out) {
+    for (int i = 0; i < n; ++i) extractMacroFeatures(state, ctx, macros[i], out + i * NUM_ACTION_FEATURES);
+}
+
+void extractMacroFeatures(const GameState& state, const TacticalContext& ctx,
+                          const Macro& macro, float* out) {
     for (int i = 0; i < NUM_ACTION_FEATURES; ++i) out[i] = 0.0f;
 
     int typeIdx = static_cast<int>(macro.type);
@@ -1353,8 +1457,6 @@ void extractMacroFeatures(const GameState& state, const Macro& macro, float* out
         out[typeIdx] = 1.0f;
     }
 
-    TeamSide mySide = state.activeTeam;
-
     // [10] scoring_potential
     if (macro.type == MacroType::SCORE || macro.type == MacroType::BLITZ_AND_SCORE ||
         macro.type == MacroType::HAND_OFF_SCORE ||
@@ -1364,9 +1466,8 @@ void extractMacroFeatures(const GameState& state, const Macro& macro, float* out
     } else if (macro.type == MacroType::ADVANCE && macro.playerId > 0) {
         const Player& p = state.getPlayer(macro.playerId);
         if (p.isOnPitch()) {
-            int dist = distToEndzone(p.position, mySide);
-            int ma = p.movementRemaining + 2;
-            out[10] = std::min(1.0f, static_cast<float>(ma) / std::max(dist, 1));
+            int dist = ctx.endzoneDist[p.id];
+            out[10] = std::min(1.0f, static_cast<float>(ctx.reach[p.id]) / std::max(dist, 1));
         }
     }
 
@@ -1389,7 +1490,7 @@ void extractMacroFeatures(const GameState& state, const Macro& macro, float* out
     // [12] player_strength / 7
     if (macro.playerId > 0) {
         const Player& p = state.getPlayer(macro.playerId);
-        out[12] = p.stats.strength / 7.0f;
+        out[12] = p.stats().strength / 7.0f;
     }
 
     // [13] risk_level (probability of failure estimate)
@@ -1398,7 +1499,15 @@ void extractMacroFeatures(const GameState& state, const Macro& macro, float* out
             out[13] = 0.0f; // no risk
             break;
         case MacroType::BLOCK:
-            out[13] = 0.15f; // low risk for favorable block
+            // Turnover odds of the block, rerolls included
+            out[13] = 0.15f;
+            if (macro.playerId > 0 && macro.targetId > 0) {
+                const Player& att = state.getPlayer(macro.playerId);
+                const Player& def = state.getPlayer(macro.targetId);
+                if (att.isOnPitch() && def.isOnPitch()) {
+                    out[13] = blockOdds(state, att, def, false).turnover();
+                }
+            }
             break;
         case MacroType::BLITZ:
             out[13] = 0.25f; // moderate (movement + block)
@@ -1407,13 +1516,13 @@ void extractMacroFeatures(const GameState& state, const Macro& macro, float* out
             out[13] = 0.35f; // higher risk (blitz + movement to score)
             break;
         case MacroType::SCORE:
-            // Risk depends on distance (GFIs)
+            // Risk of the GFIs the run needs, rerolls included
             if (macro.playerId > 0) {
                 const Player& p = state.getPlayer(macro.playerId);
                 if (p.isOnPitch()) {
-                    int dist = distToEndzone(p.position, mySide);
+                    int dist = ctx.endzoneDist[p.id];
                     int gfis = std::max(0, dist - p.movementRemaining);
-                    out[13] = gfis * 0.17f; // ~1/6 per GFI
+                    out[13] = 1.0f - RiskOracle::goForItChance(state, p, gfis);
                 }
             }
             break;
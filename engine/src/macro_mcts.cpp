@@ -1,10 +1,22 @@
 #include "bb/macro_mcts.h"
+#include "bb/alloc_tracking.h"
+#include "bb/macro_search_handle.h"
+#include "bb/geometry.h"
 #include "bb/action_resolver.h"
 #include "bb/helpers.h"
+#include "bb/profile.h"
+#include "bb/risk_oracle.h"
+#include "bb/root_cache.h"
+#include "bb/symmetry.h"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <limits>
+#include <mutex>
 #include <random>
+#include <thread>
+#include <utility>
 
 namespace bb {
 
@@ -52,8 +64,52 @@ static int greedyMacroRank(MacroType t) {
 
 // --- MacroMCTSNode ---
 
-MacroMCTSNode* MacroMCTSNode::bestChildPUCT(double C, bool maximize) const {
-    if (children.empty()) return nullptr;
+// Visits and mean value used to rank `child`: its own, or the shared
+// transposition entry for its last-seen position when that has seen more.
+static double childStats(const MacroMCTSNode& child, TranspositionTable* tt, int& visits) {
+    visits = child.visits;
+    double q = child.visits > 0 ? child.totalValue / child.visits : 0.0;
+    TranspositionTable::Stats shared;
+    if (tt && child.stateHash != 0 && tt->probe(child.stateHash, shared) &&
+        static_cast<int>(shared.visits) > child.visits) {
+        visits = static_cast<int>(shared.visits);
+        q = shared.totalValue / shared.visits;
+    }
+    return q;
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool sameMacro(const Macro& a, const Macro& b) {
+    return a.type == b.type && a.playerId == b.playerId && a.targetId == b.targetId &&
+           a.targetPos == b.targetPos && a.thirdId == b.thirdId;
+}
+
+// What MCTSConfig::rootCache keeps of a finished search: the chosen macro
+// first, then the other children by visits.
+static RootResult rootResult(const std::vector<MacroChildVisitInfo>& visits, const Macro& chosen,
+                             double value) {
+    RootResult result;
+    result.value = value;
+    result.children = visits;
+    std::stable_sort(result.children.begin(), result.children.end(),
+                     [&](const MacroChildVisitInfo& a, const MacroChildVisitInfo& b) {
+                         bool aChosen = sameMacro(a.macro, chosen), bChosen = sameMacro(b.macro, chosen);
+                         if (aChosen != bChosen) return aChosen;
+                         return a.visits > b.visits;
+                     });
+    if (result.children.empty() || !sameMacro(result.children[0].macro, chosen)) {
+        result.children.insert(result.children.begin(), {chosen, 0, 0.0f, 0.0f, value});
+    }
+    return result;
+}
+
+uint32_t MacroMCTSNode::bestChildPUCT(const MacroMCTSArena& arena, double C, bool maximize,
+                                      TranspositionTable* tt) const {
+    if (numChildren == 0) return MacroMCTSArena::NONE;
+    auto children = arena.children(*this);
     double parentVisits = static_cast<double>(visits);
     // totalValue/Q is always stored in the search's fixed searchingSide
     // perspective. When this node's children represent the OPPONENT's
@@ -63,39 +119,50 @@ MacroMCTSNode* MacroMCTSNode::bestChildPUCT(double C, bool maximize) const {
     // not value).
     double sign = maximize ? 1.0 : -1.0;
 
+    // Q and visit count per child (from the transposition table if it
+    // knows the child's position better than the child does).
+    thread_local std::vector<std::pair<double, int>> stats;
+    stats.resize(children.size());
+    for (size_t i = 0; i < children.size(); ++i) {
+        stats[i].first = childStats(children[i], tt, stats[i].second);
+    }
+
     // FPU: average Q of visited children
     double visitedSum = 0.0;
     int visitedCount = 0;
-    for (auto& child : children) {
-        if (child.visits > 0) {
-            visitedSum += sign * (child.totalValue / child.visits);
+    for (size_t i = 0; i < children.size(); ++i) {
+        if (stats[i].second > 0) {
+            visitedSum += sign * stats[i].first;
             visitedCount++;
         }
     }
     double fpu = (visitedCount > 0) ? visitedSum / visitedCount : 0.0;
 
-    MacroMCTSNode* best = nullptr;
+    uint32_t best = MacroMCTSArena::NONE;
     double bestScore = -std::numeric_limits<double>::max();
-    for (auto& child : const_cast<std::vector<MacroMCTSNode>&>(children)) {
-        double q = (child.visits == 0) ? fpu : sign * (child.totalValue / child.visits);
-        double u = C * child.prior * std::sqrt(parentVisits) / (1.0 + child.visits);
+    for (size_t i = 0; i < children.size(); ++i) {
+        const MacroMCTSNode& child = children[i];
+        int n = stats[i].second;
+        double q = (n == 0) ? fpu : sign * stats[i].first;
+        double u = C * child.prior * std::sqrt(parentVisits) / (1.0 + n);
         double score = q + u;
         if (score > bestScore) {
             bestScore = score;
-            best = &child;
+            best = firstChild + static_cast<uint32_t>(i);
         }
     }
     return best;
 }
 
-MacroMCTSNode* MacroMCTSNode::mostVisitedChild() const {
-    if (children.empty()) return nullptr;
-    MacroMCTSNode* best = nullptr;
+uint32_t MacroMCTSNode::mostVisitedChild(const MacroMCTSArena& arena) const {
+    if (numChildren == 0) return MacroMCTSArena::NONE;
+    uint32_t best = MacroMCTSArena::NONE;
     int bestVisits = -1;
-    for (auto& child : const_cast<std::vector<MacroMCTSNode>&>(children)) {
-        if (child.visits > bestVisits) {
-            bestVisits = child.visits;
-            best = &child;
+    auto children = arena.children(*this);
+    for (uint32_t i = 0; i < children.size(); ++i) {
+        if (children[i].visits > bestVisits) {
+            bestVisits = children[i].visits;
+            best = firstChild + i;
         }
     }
     return best;
@@ -104,33 +171,132 @@ MacroMCTSNode* MacroMCTSNode::mostVisitedChild() const {
 // --- MacroMCTSSearch ---
 
 MacroMCTSSearch::MacroMCTSSearch(const ValueFunction* vf, MCTSConfig config, uint32_t seed)
-    : valueFn_(vf), config_(config), dice_(seed) {}
+    : valueFn_(vf), config_(config), dice_(seed),
+      tt_(static_cast<size_t>(std::max(0, config.ttMemoryMB)) << 20),
+      priorCache_(static_cast<size_t>(std::max(0, config.priorCacheMB)) << 20),
+      evalQueue_(vf, config.evalBatchSize) {
+    // Common random numbers key each sample's dice to its index already
+    if (config_.rolloutThreads > 0 && config_.nRollouts > 1 && !config_.commonRandomNumbers) {
+        // Helpers only pay off on idle cores; with none the pool runs the
+        // samples inline, with the same per-sample dice and so the same results.
+        int cores = static_cast<int>(std::thread::hardware_concurrency());
+        int helpers = cores > 0 ? std::min(config_.rolloutThreads, cores - 1) : config_.rolloutThreads;
+        rolloutPool_ = std::make_unique<WorkerPool>(helpers);
+        rolloutWorkers_.resize(helpers + 1);
+    }
+}
+
+SearchTree MacroMCTSSearch::exportTree(int minVisits) const {
+    SearchTree tree;
+    tree.macro = true;
+    tree.minVisits = minVisits;
+    if (searchRoot_ != MacroMCTSArena::NONE) tree.searchingSide = arena_[searchRoot_].actingTeam;
+    flattenTree(arena_, searchRoot_, minVisits, tree.nodes,
+                [&](const MacroMCTSNode& n, const MacroMCTSNode* parent, SearchTreeRecord& r) {
+        r.kind = static_cast<uint8_t>(n.macro.type);
+        r.playerId = static_cast<int8_t>(n.macro.playerId);
+        r.targetId = static_cast<int8_t>(n.macro.targetId);
+        r.thirdId = static_cast<int8_t>(n.macro.thirdId);
+        r.targetX = n.macro.targetPos.x;
+        r.targetY = n.macro.targetPos.y;
+        // A node's actingTeam is the team choosing among its children
+        r.actingTeam = static_cast<uint8_t>(parent ? parent->actingTeam : n.actingTeam);
+    });
+    return tree;
+}
 
 Macro MacroMCTSSearch::search(const GameState& state) {
-    std::vector<Macro> macros;
+    TraceSpan searchSpan(config_.trace, "MacroMCTSSearch::search");
+    auto startTime = std::chrono::steady_clock::now();
+    lastStats_ = {};
+    lastSolved_ = false;
+    AllocCounters allocStart = threadAllocCounters();
+    SearchTimer total;
+    SearchTimer timer;
+
+    MacroList macros;
     getAvailableMacros(state, macros);
 
+    searchRoot_ = MacroMCTSArena::NONE;
     if (macros.empty()) {
+        reuseRoot_ = MacroMCTSArena::NONE;
+        lastReusedVisits_ = 0;
         return {MacroType::END_TURN, -1, -1, {-1, -1}};
     }
     if (macros.size() == 1) {
+        reuseRoot_ = MacroMCTSArena::NONE;
+        lastReusedVisits_ = 0;
         lastIterations_ = 0;
         lastBestValue_ = 0.0;
         lastChildVisits_.clear();
         return macros[0];
     }
 
-    // Create root
-    MacroMCTSNode root;
-    root.visits = 1;  // Virtual visit for PUCT
-    root.expanded = false;
+    // Last turn of the half: only a touchdown counts, so when a scoring line
+    // is provably the likeliest one (its lower bound clears every other
+    // line's upper bound), play it rather than sample the heuristic priors
+    if (config_.endgameSolver && EndgameSolver::applies(state)) {
+        std::vector<EndgameSolver::Line> lines = endgame_.solve(state);
+        bool settled = !lines.empty() && lines[0].pTouchdown > 0.0;
+        for (size_t i = 1; settled && i < lines.size(); ++i) {
+            settled = lines[i].pUpper <= lines[0].pTouchdown;
+        }
+        if (settled) {
+            reuseRoot_ = MacroMCTSArena::NONE;
+            lastReusedVisits_ = 0;
+            lastIterations_ = 0;
+            lastBestValue_ = lines[0].pTouchdown;
+            lastSolved_ = true;
+            lastChildVisits_.clear();
+            for (size_t i = 0; i < lines.size(); ++i) {
+                lastChildVisits_.push_back({lines[i].macro, 0, 0.0f, i == 0 ? 1.0f : 0.0f,
+                                            lines[i].pTouchdown});
+            }
+            lastStats_.totalMs = total.lap();
+            return lines[0].macro;
+        }
+    }
 
-    // Expand root
-    expand(&root, state);
+    // A position searched before under the same networks and settings: its
+    // stored result stands in for the search, if every macro is still legal
+    const uint64_t cacheModel = config_.rootCache ? rootCacheSearchKey(config_) : 0;
+    if (config_.rootCache) {
+        RootResult cached;
+        bool legal = config_.rootCache->lookup(state.hash(), cacheModel, cached);
+        for (size_t i = 0; legal && i < cached.children.size(); ++i) {
+            legal = std::any_of(macros.begin(), macros.end(),
+                                [&](const Macro& m) { return sameMacro(m, cached.children[i].macro); });
+        }
+        if (legal) {
+            reuseRoot_ = MacroMCTSArena::NONE;
+            lastReusedVisits_ = 0;
+            lastIterations_ = 0;
+            lastBestValue_ = cached.value;
+            lastChildVisits_ = std::move(cached.children);
+            lastStats_.rootCacheHit = true;
+            lastStats_.totalMs = total.lap();
+            return lastChildVisits_[0].macro;
+        }
+    }
+
+    // Re-root at the last search's chosen child if this is its position;
+    // otherwise start a fresh tree
+    uint32_t root = reuseSubtree(state);
+    if (root == MacroMCTSArena::NONE) {
+        arena_.reset();
+        root = arena_.allocate(1);
+        arena_[root].visits = 1;  // Virtual visit for PUCT
+
+        // Expand root
+        expand(root, state);
+        lastStats_.nodesAllocated += 1 + static_cast<int>(arena_[root].numChildren);
+    }
+    searchRoot_ = root;
+    auto rootChildren = arena_.children(arena_[root]);
 
     // Dirichlet noise on root priors (AlphaZero-style exploration)
-    if (config_.dirichletAlpha > 0.0f && !root.children.empty()) {
-        int n = static_cast<int>(root.children.size());
+    if (config_.dirichletAlpha > 0.0f && !rootChildren.empty()) {
+        int n = static_cast<int>(rootChildren.size());
         std::mt19937 rng(dice_.rollD6() * 1000 + dice_.rollD6());
         std::gamma_distribution<float> gamma(config_.dirichletAlpha, 1.0f);
         std::vector<float> noise(n);
@@ -143,123 +309,935 @@ Macro MacroMCTSSearch::search(const GameState& state) {
             float w = config_.dirichletWeight;
             for (int i = 0; i < n; ++i) {
                 noise[i] /= noiseSum;
-                root.children[i].prior = (1.0f - w) * root.children[i].prior + w * noise[i];
+                rootChildren[i].prior = (1.0f - w) * rootChildren[i].prior + w * noise[i];
             }
         }
     }
 
     TeamSide searchingSide = state.activeTeam;
 
-    int iterations = 0;
-    while (iterations < config_.maxIterations) {
-        // 1. Select
-        MacroMCTSNode* node = select(&root, searchingSide);
+    journal_.clear();
+    tt_.newSearch();
+    stateCache_.clear();
+    cachedStates_ = 0;
+    leaf_ = leafInvariants(state);
+    lookahead_.clear();
+    lookaheadReuses_ = 0;
+    // Leaf evaluations run on several threads in parallel search and under
+    // rolloutThreads; the reuse table is not shared between them.
+    lookaheadShared_ = config_.leafLookahead && config_.lookaheadSamples > 0 &&
+                       config_.numThreads <= 1 && !rolloutPool_;
+    crnVisit_ = -1;
+    if (config_.commonRandomNumbers) crnBase_ = dice_.next();
+    for (RolloutWorker& w : rolloutWorkers_) {
+        w.sim = state.clone();
+        w.journal.clear();
+    }
 
-        // 2. Replay state to this node (open-loop: fresh dice each replay)
+    SearchStats& stats = lastStats_;
+    stats.expandMs += timer.lap();
+    int iterations = 0;
+    bool gumbel = config_.gumbelTopK > 0 && config_.numThreads <= 1;
+    if (gumbel) gumbelStart(root, config_.maxIterations);
+    if (config_.numThreads > 1) {
+        iterations = searchParallel(root, state, searchingSide, startTime, stats);
+    } else {
+        double depthSum = 0.0;
+        auto countLeaf = [&](int depth, int samples) {
+            stats.leafEvals += samples;
+            stats.maxDepth = std::max(stats.maxDepth, depth);
+            depthSum += depth;
+        };
         GameState sim = state.clone();
-        ReplayOutcome replay = replayToNode(sim, node);
-        if (!replay.complete) {
-            // A turnover or terminal phase cut the replay short. This is a
-            // real outcome of the macro that was attempted, not a replay to
-            // discard — backpropagate it against the state it actually
-            // produced instead of silently dropping the whole iteration
-            // (which previously starved risky-but-scoring branches of any
-            // penalty signal, since only "lucky" replays ever contributed).
-            double value = simulate(sim, searchingSide);
-            backpropagate(replay.reached, value);
-            iterations++;
-            continue;
-        }
+        bool batched = config_.evalBatchSize > 1 && usesValueFunction();
+        int nRollouts = std::max(1, config_.nRollouts);
+        while (iterations < config_.maxIterations) {
+            // Report progress, then check the clock and the root every 64 iterations
+            if ((iterations & 63) == 0 && iterations > 0) {
+                if (progress_ && !progress_(iterations)) break;
+                double elapsed = elapsedMs(startTime);
+                if (config_.timeBudgetMs > 0 && elapsed >= config_.timeBudgetMs) break;
+                if (cancelled()) break;
+                if (config_.earlyStop && !gumbel &&
+                    rootSettled(root, remainingIterations(iterations, elapsed),
+                                static_cast<int>(pending_.size()))) {
+                    stats.stoppedEarly = true;
+                    break;
+                }
+            }
+            iterTrace_ = (config_.trace && config_.trace->sampled(iterations)) ? config_.trace : nullptr;
+            TraceSpan iterSpan(iterTrace_, "iteration");
+
+            // 1. Select (under the Gumbel root, below this phase's next candidate)
+            uint32_t from = root;
+            if (gumbel) {
+                if (gumbelNext_ == gumbelSchedule_.size()) {
+                    // Halve on finished evaluations only
+                    if (batched) flushLeaves(searchingSide);
+                    if (!gumbelHalve(root, config_.maxIterations - iterations)) break;
+                }
+                from = gumbelSchedule_[gumbelNext_++];
+            }
+            uint32_t node = select(from, searchingSide);
+            stats.selectMs += timer.lap(iterTrace_, "select");
+            if (config_.commonRandomNumbers) {
+                // The node evaluated is this one, or (about to be expanded)
+                // its first child, on that child's first visit
+                const MacroMCTSNode& n = arena_[node];
+                crnVisit_ = (n.expanded || n.visits == 0) ? n.visits : 0;
+                crnSample_ = 0;
+            }
 
-        // 3. Expand if unexpanded
-        if (!node->expanded && node->visits > 0) {
-            expand(node, sim);
-            if (!node->children.empty()) {
-                // Descend into the highest-prior child, not always children[0]
-                // (getAvailableMacros always emits END_TURN first, so index 0
-                // would otherwise make every node's first-ever realized value
-                // the passive END_TURN continuation regardless of its actual
-                // prior -- systematically biasing the tree toward passivity).
-                MacroMCTSNode* bestChild = &node->children[0];
-                for (auto& child : node->children) {
-                    if (child.prior > bestChild->prior) bestChild = &child;
+            // 2. Replay state to this node (open-loop: fresh dice each replay).
+            //    `sim` is the single working state; every replay is journaled and
+            //    rolled back to the root before the next one.
+            ReplayOutcome replay = replayToNode(sim, node);
+            int depth = static_cast<int>(path_.size());
+            stats.replayMs += timer.lap(iterTrace_, "replay");
+            if (!replay.complete) {
+                stats.truncatedReplays++;
+                int reachedDepth = nodeDepth(arena_, replay.reached);
+                countLeaf(reachedDepth, 1);
+                // A turnover or terminal phase cut the replay short. This is a
+                // real outcome of the macro that was attempted, not a replay to
+                // discard — backpropagate it against the state it actually
+                // produced instead of silently dropping the whole iteration
+                // (which previously starved risky-but-scoring branches of any
+                // penalty signal, since only "lucky" replays ever contributed).
+                if (batched) {
+                    PendingLeaf leaf{replay.reached, evalQueue_.size(), 0, 1};
+                    queueSample(sim, searchingSide, leaf, stepDice(reachedDepth + 1));
+                    journal_.undoTo(sim, 0);
+                    deferLeaf(leaf, searchingSide);
+                    stats.simulateMs += timer.lap(iterTrace_, "simulate");
+                } else {
+                    double value = simulate(sim, searchingSide, stepDice(reachedDepth + 1));
+                    stats.simulateMs += timer.lap(iterTrace_, "simulate");
+                    journal_.undoTo(sim, 0);
+                    stats.replayMs += timer.lap(iterTrace_, "replay");
+                    backpropagate(replay.reached, value);
+                    stats.backpropMs += timer.lap(iterTrace_, "backprop");
                 }
-                node = bestChild;
-                // Execute this child's macro to get leaf state
-                greedyExpandMacro(sim, node->macro, dice_);
+                iterations++;
+                continue;
             }
-        }
 
-        // 4. Evaluate leaf, averaging nRollouts open-loop samples to cut
-        //    Q-variance (~sqrt(K)). The first rollout reuses the already-replayed
-        //    `sim`; extra rollouts re-replay with fresh dice from this node.
-        double value = simulate(sim, searchingSide);
-        int nRollouts = std::max(1, config_.nRollouts);
-        for (int r = 1; r < nRollouts; ++r) {
-            GameState extra = state.clone();
-            if (!replayToNode(extra, node).complete) continue;
-            value += simulate(extra, searchingSide);
-        }
-        value /= static_cast<double>(nRollouts);
+            // 3. Expand if unexpanded (and the node budget has room)
+            if (!arena_[node].expanded && arena_[node].visits > 0 &&
+                makeRoom(node, searchingSide, batched, stats)) {
+                expand(node, sim);
+                stats.nodesAllocated += static_cast<int>(arena_[node].numChildren);
+                if (arena_[node].numChildren > 0) {
+                    // Descend into the highest-prior child, not always children[0]
+                    // (getAvailableMacros always emits END_TURN first, so index 0
+                    // would otherwise make every node's first-ever realized value
+                    // the passive END_TURN continuation regardless of its actual
+                    // prior -- systematically biasing the tree toward passivity).
+                    uint32_t bestChild = arena_[node].firstChild;
+                    for (uint32_t c = bestChild; c < arena_[node].firstChild + arena_[node].numChildren; ++c) {
+                        if (arena_[c].prior > arena_[bestChild].prior) bestChild = c;
+                    }
+                    node = bestChild;
+                    // Execute this child's macro to get leaf state
+                    TraceSpan span(iterTrace_, macroTypeName(arena_[node].macro.type), "macro");
+                    depth++;
+                    auto result = greedyExpandMacroJournaled(sim, arena_[node].macro, stepDice(depth), journal_);
+                    if (tt_.enabled()) arena_[node].stateHash = ttKey(sim);
+                    cacheOutcome(node, depth, sim, result.turnover);
+                }
+                stats.expandMs += timer.lap(iterTrace_, "expand");
+            }
+
+            // 4. Evaluate leaf, averaging nRollouts open-loop samples to cut
+            //    Q-variance (~sqrt(K)). The first rollout reuses the already-replayed
+            //    `sim`; extra rollouts re-replay with fresh dice from this node.
+            //    Batched: queue the samples, then backpropagate (5.) at flush.
+            if (batched) {
+                PendingLeaf leaf{node, evalQueue_.size(), 0, nRollouts};
+                queueSample(sim, searchingSide, leaf, stepDice(depth + 1));
+                stats.simulateMs += timer.lap(iterTrace_, "simulate");
+                journal_.undoTo(sim, 0);
+                for (int r = 1; r < nRollouts; ++r) {
+                    crnSample_ = r;
+                    bool complete = replayToNode(sim, node).complete;
+                    stats.replayMs += timer.lap(iterTrace_, "replay");
+                    if (complete) {
+                        queueSample(sim, searchingSide, leaf, stepDice(depth + 1));
+                    } else {
+                        stats.truncatedReplays++;
+                    }
+                    stats.simulateMs += timer.lap(iterTrace_, "simulate");
+                    journal_.undoTo(sim, 0);
+                }
+                stats.replayMs += timer.lap(iterTrace_, "replay");
+                countLeaf(depth, leaf.samples);
+                deferLeaf(leaf, searchingSide);
+                stats.simulateMs += timer.lap(iterTrace_, "simulate");
+                iterations++;
+                continue;
+            }
+            double value;
+            int samples;
+            if (rolloutPool_) {
+                // Replays run inside the workers' samples: all simulate time
+                value = sampleRollouts(sim, node, searchingSide, nRollouts, samples);
+                stats.truncatedReplays += nRollouts - samples;
+                stats.simulateMs += timer.lap(iterTrace_, "simulate");
+            } else {
+                value = simulate(sim, searchingSide, stepDice(depth + 1));
+                samples = 1;
+                stats.simulateMs += timer.lap(iterTrace_, "simulate");
+                journal_.undoTo(sim, 0);
+                for (int r = 1; r < nRollouts; ++r) {
+                    crnSample_ = r;
+                    bool complete = replayToNode(sim, node).complete;
+                    stats.replayMs += timer.lap(iterTrace_, "replay");
+                    if (complete) {
+                        value += simulate(sim, searchingSide, stepDice(depth + 1));
+                        samples++;
+                    } else {
+                        stats.truncatedReplays++;
+                    }
+                    stats.simulateMs += timer.lap(iterTrace_, "simulate");
+                    journal_.undoTo(sim, 0);
+                }
+                stats.replayMs += timer.lap(iterTrace_, "replay");
+            }
+            countLeaf(depth, samples);
+            value /= static_cast<double>(nRollouts);
 
-        // 5. Backpropagate
-        backpropagate(node, value);
+            // 5. Backpropagate
+            backpropagate(node, value);
+            stats.backpropMs += timer.lap(iterTrace_, "backprop");
 
-        iterations++;
+            iterations++;
+        }
+        iterTrace_ = nullptr;
+        crnVisit_ = -1;
+        if (batched) {
+            flushLeaves(searchingSide);
+            stats.simulateMs += timer.lap(config_.trace, "simulate");
+        }
+        if (iterations > 0) stats.avgDepth = depthSum / iterations;
     }
 
     lastIterations_ = iterations;
-
-    // Save child visit info
+    stats.iterations = iterations;
+    stats.lookaheadReuses = lookaheadReuses_;
+    if (searchSpan.active()) searchSpan.args = "\"iterations\":" + std::to_string(iterations);
+    stats.totalMs = total.lap();
+    if (stats.totalMs > 0.0) stats.iterationsPerSec = iterations * 1000.0 / stats.totalMs;
+    stats.addAllocations(threadAllocCounters().since(allocStart));
+
+    // Save child visit info and the policy-improvement target: the visit
+    // shares, or the Gumbel root's improved policy, which also covers
+    // children it never visited
     lastChildVisits_.clear();
-    for (auto& child : root.children) {
-        if (child.visits > 0) {
-            lastChildVisits_.push_back({child.macro, child.visits, child.prior});
+    if (gumbel) {
+        std::vector<float> targets;
+        gumbelTargets(root, targets);
+        auto children = arena_.children(arena_[root]);
+        for (size_t i = 0; i < children.size(); ++i) {
+            const MacroMCTSNode& c = children[i];
+            lastChildVisits_.push_back({c.macro, c.visits, c.prior, targets[i],
+                                        c.visits > 0 ? c.totalValue / c.visits : 0.0});
+        }
+    } else {
+        int totalVisits = 0;
+        for (auto& child : arena_.children(arena_[root])) {
+            if (child.visits > 0) {
+                lastChildVisits_.push_back({child.macro, child.visits, child.prior, 0.0f,
+                                            child.totalValue / child.visits});
+                totalVisits += child.visits;
+            }
         }
+        for (auto& cv : lastChildVisits_) cv.target = static_cast<float>(cv.visits) / totalVisits;
     }
 
-    MacroMCTSNode* best = root.mostVisitedChild();
+    if (gumbel) {
+        gumbelRank(root);
+        reuseRoot_ = gumbelArms_.front().child;
+    } else {
+        reuseRoot_ = arena_[root].mostVisitedChild(arena_);
+    }
+    const MacroMCTSNode* best = arena_.get(reuseRoot_);
     if (best) {
         lastBestValue_ = best->visits > 0
             ? best->totalValue / best->visits : 0.0;
+        if (config_.rootCache && iterations > 0 && !cancelled()) {
+            config_.rootCache->store(state.hash(), cacheModel,
+                                     rootResult(lastChildVisits_, best->macro, lastBestValue_));
+        }
         return best->macro;
     }
 
     return macros[0];
 }
 
-MacroMCTSNode* MacroMCTSSearch::select(MacroMCTSNode* root, TeamSide searchingSide) {
-    MacroMCTSNode* node = root;
-    while (node->expanded && !node->children.empty()) {
-        bool maximize = (node->actingTeam == searchingSide);
-        MacroMCTSNode* child = node->bestChildPUCT(config_.explorationC, maximize);
-        if (!child) break;
+void MacroMCTSSearch::rootVisits(std::vector<MacroChildVisitInfo>& out) const {
+    out.clear();
+    if (searchRoot_ == MacroMCTSArena::NONE) return;
+    int totalVisits = 0;
+    for (const auto& child : arena_.children(arena_[searchRoot_])) {
+        if (child.visits > 0) {
+            out.push_back({child.macro, child.visits, child.prior, 0.0f, child.totalValue / child.visits});
+            totalVisits += child.visits;
+        }
+    }
+    for (auto& cv : out) cv.target = static_cast<float>(cv.visits) / totalVisits;
+}
+
+uint32_t MacroMCTSSearch::reuseSubtree(const GameState& state) {
+    lastReusedVisits_ = 0;
+    uint32_t keep = reuseRoot_;
+    reuseRoot_ = MacroMCTSArena::NONE;
+    if (ponderReuse_ && arena_.size() > 0) {
+        // Any expanded position of the last tree, the most visited if
+        // several share the hash
+        const uint64_t hash = state.hash();
+        keep = MacroMCTSArena::NONE;
+        for (uint32_t i = 0; i < arena_.size(); ++i) {
+            const MacroMCTSNode& n = arena_[i];
+            if (n.expanded && n.numChildren > 0 && n.expandedHash == hash &&
+                (keep == MacroMCTSArena::NONE || n.visits > arena_[keep].visits)) {
+                keep = i;
+            }
+        }
+    } else if (!config_.reuseTree) {
+        return MacroMCTSArena::NONE;
+    }
+    if (keep == MacroMCTSArena::NONE) return MacroMCTSArena::NONE;
+    // Same open-loop caveat as MCTSSearch::reuseSubtree: match by hash.
+    const MacroMCTSNode& kept = arena_[keep];
+    if (!kept.expanded || kept.numChildren == 0 || kept.expandedHash != state.hash()) {
+        return MacroMCTSArena::NONE;
+    }
+    if (config_.opponentReplyWidth > 0) {
+        // A subtree searched for the other side has this side's nodes
+        // narrowed to opponent replies (MCTSConfig::opponentReplyWidth)
+        uint32_t oldRoot = keep;
+        while (arena_[oldRoot].parent != MacroMCTSArena::NONE) oldRoot = arena_[oldRoot].parent;
+        if (arena_[oldRoot].actingTeam != kept.actingTeam) return MacroMCTSArena::NONE;
+    }
+
+    double decay = config_.reuseDecay;
+    uint32_t root = copySubtree(arena_, keep, spare_, [decay](MacroMCTSNode& n) {
+        int v = static_cast<int>(n.visits * decay);
+        n.totalValue = n.visits > 0 ? n.totalValue * v / n.visits : 0.0;
+        n.visits = v;
+    });
+    std::swap(arena_, spare_);
+    arena_[root].visits = std::max(arena_[root].visits, 1);
+    lastReusedVisits_ = arena_[root].visits;
+    return root;
+}
+
+uint32_t MacroMCTSSearch::select(uint32_t root, TeamSide searchingSide) {
+    uint32_t node = root;
+    while (arena_[node].expanded && arena_[node].numChildren > 0) {
+        bool maximize = (arena_[node].actingTeam == searchingSide);
+        uint32_t child = arena_[node].bestChildPUCT(arena_, config_.explorationC, maximize,
+                                                    tt_.enabled() ? &tt_ : nullptr);
+        if (child == MacroMCTSArena::NONE) break;
         node = child;
     }
     return node;
 }
 
-void MacroMCTSSearch::expand(MacroMCTSNode* node, const GameState& state) {
+// Gumbel MuZero's sigma: Q mapped to [0, 1], scaled so it outweighs the
+// priors as the best candidate's visits grow.
+static constexpr double GUMBEL_C_VISIT = 50.0;
+static constexpr double GUMBEL_C_SCALE = 1.0;
+
+double MacroMCTSSearch::gumbelSigma(double q, int maxVisits) const {
+    double unit = (std::clamp(q, -1.0, 1.0) + 1.0) * 0.5;
+    return (GUMBEL_C_VISIT + maxVisits) * GUMBEL_C_SCALE * unit;
+}
+
+static double logPrior(float prior) {
+    return std::log(std::max(static_cast<double>(prior), 1e-8));
+}
+
+void MacroMCTSSearch::gumbelStart(uint32_t root, int budget) {
+    const MacroMCTSNode& r = arena_[root];
+    gumbelArms_.clear();
+    for (uint32_t i = 0; i < r.numChildren; ++i) {
+        double u = (static_cast<double>(dice_.next() >> 11) + 0.5) * 0x1.0p-53;
+        double g = -std::log(-std::log(u));
+        gumbelArms_.push_back({r.firstChild + i, g + logPrior(arena_[r.firstChild + i].prior)});
+    }
+    // Top k by noise + log prior: k samples without replacement from the prior
+    size_t k = std::min(gumbelArms_.size(), static_cast<size_t>(config_.gumbelTopK));
+    std::partial_sort(gumbelArms_.begin(), gumbelArms_.begin() + k, gumbelArms_.end(),
+                      [](const GumbelArm& a, const GumbelArm& b) { return a.score > b.score; });
+    gumbelArms_.resize(k);
+    gumbelPhasesLeft_ = k > 1 ? static_cast<int>(std::ceil(std::log2(static_cast<double>(k)))) : 0;
+    gumbelPlanPhase(budget);
+}
+
+bool MacroMCTSSearch::gumbelPlanPhase(int budget) {
+    gumbelSchedule_.clear();
+    gumbelNext_ = 0;
+    int m = static_cast<int>(gumbelArms_.size());
+    if (m < 2 || gumbelPhasesLeft_ <= 0 || budget <= 0) return false;
+    int perArm = std::max(1, budget / (gumbelPhasesLeft_ * m));
+    for (int v = 0; v < perArm; ++v) {
+        for (const GumbelArm& arm : gumbelArms_) gumbelSchedule_.push_back(arm.child);
+    }
+    gumbelPhasesLeft_--;
+    return true;
+}
+
+void MacroMCTSSearch::gumbelRank(uint32_t root) {
+    TranspositionTable* tt = tt_.enabled() ? &tt_ : nullptr;
+    int maxVisits = 0;
+    for (const MacroMCTSNode& child : arena_.children(arena_[root])) {
+        maxVisits = std::max(maxVisits, child.visits);
+    }
+    auto rank = [&](const GumbelArm& arm) {
+        int visits;
+        double q = childStats(arena_[arm.child], tt, visits);
+        return visits > 0 ? arm.score + gumbelSigma(q, maxVisits) : arm.score;
+    };
+    std::stable_sort(gumbelArms_.begin(), gumbelArms_.end(),
+                     [&](const GumbelArm& a, const GumbelArm& b) { return rank(a) > rank(b); });
+}
+
+bool MacroMCTSSearch::gumbelHalve(uint32_t root, int budget) {
+    gumbelRank(root);
+    gumbelArms_.resize((gumbelArms_.size() + 1) / 2);
+    return gumbelPlanPhase(budget);
+}
+
+void MacroMCTSSearch::gumbelTargets(uint32_t root, std::vector<float>& targets) {
+    TranspositionTable* tt = tt_.enabled() ? &tt_ : nullptr;
+    auto children = arena_.children(arena_[root]);
+    std::vector<double> q(children.size());
+    std::vector<int> visits(children.size());
+    int maxVisits = 0;
+    double priorSum = 0.0, weighted = 0.0;
+    for (size_t i = 0; i < children.size(); ++i) {
+        q[i] = childStats(children[i], tt, visits[i]);
+        maxVisits = std::max(maxVisits, children[i].visits);
+        if (visits[i] > 0) {
+            priorSum += children[i].prior;
+            weighted += children[i].prior * q[i];
+        }
+    }
+    // Completed Q: unvisited children take the prior-weighted mean of the
+    // visited ones
+    double mixed = priorSum > 0.0 ? weighted / priorSum : 0.0;
+    std::vector<double> logits(children.size());
+    double top = -std::numeric_limits<double>::max();
+    for (size_t i = 0; i < children.size(); ++i) {
+        logits[i] = logPrior(children[i].prior) + gumbelSigma(visits[i] > 0 ? q[i] : mixed, maxVisits);
+        top = std::max(top, logits[i]);
+    }
+    double sum = 0.0;
+    for (double& l : logits) sum += (l = std::exp(l - top));
+    targets.resize(children.size());
+    for (size_t i = 0; i < children.size(); ++i) targets[i] = static_cast<float>(logits[i] / sum);
+}
+
+int MacroMCTSSearch::remainingIterations(int done, double elapsedMs) const {
+    int remaining = std::max(0, config_.maxIterations - done);
+    if (config_.timeBudgetMs > 0 && done > 0 && elapsedMs > 0.0) {
+        double rate = done / elapsedMs;  // iterations per ms so far
+        double left = std::max(0.0, config_.timeBudgetMs - elapsedMs) * rate;
+        remaining = std::min(remaining, static_cast<int>(std::ceil(left)));
+    }
+    return remaining;
+}
+
+bool MacroMCTSSearch::rootSettled(uint32_t root, int remaining, int inFlight) const {
+    // search() returns the most-visited child; it cannot change once the
+    // runner-up would still trail it after taking every remaining visit,
+    // and after the leader lost every visit that is only a virtual loss.
+    int best = 0, second = 0;
+    for (const MacroMCTSNode& child : arena_.children(arena_[root])) {
+        if (child.visits > best) {
+            second = best;
+            best = child.visits;
+        } else if (child.visits > second) {
+            second = child.visits;
+        }
+    }
+    return best - inFlight - second > remaining;
+}
+
+// Tree-parallel search (MCTSConfig::numThreads > 1). Workers share arena_
+// and tt_ behind one mutex, held only to select a path, attach children and
+// backpropagate; replay, macro generation, priors and leaf evaluation --
+// nearly all of an iteration's cost -- run unlocked on each worker's own
+// working state, journal and dice. While a worker is out on a path every
+// node on it carries a virtual loss (one extra visit valued as a loss for
+// the team that chose the node), steering concurrent selections onto other
+// lines; the real value replaces it at backpropagation. Expansions share
+// priorCache_ behind a second mutex, held only for lookups and stores.
+int MacroMCTSSearch::searchParallel(uint32_t root, const GameState& state, TeamSide searchingSide,
+                                    std::chrono::steady_clock::time_point startTime,
+                                    SearchStats& stats) {
+    std::mutex treeMutex;
+    std::mutex cacheMutex;  // priorCache_
+    std::atomic<int> claimed{0};
+    std::atomic<int> completed{0};
+    std::atomic<bool> stop{false};  // time budget spent, root settled or progress_ said so
+    int inFlight = 0;               // paths carrying a virtual loss (treeMutex)
+    // The budget as of the last progress_ call, which may move it (treeMutex)
+    std::atomic<int> maxIterations{config_.maxIterations};
+    std::atomic<int> timeBudgetMs{config_.timeBudgetMs};
+    TranspositionTable* tt = tt_.enabled() ? &tt_ : nullptr;
+    int nRollouts = std::max(1, config_.nRollouts);
+
+    auto addVirtualLoss = [&](uint32_t node) {
+        arena_[node].visits++;
+        arena_[node].totalValue += virtualLoss(node, searchingSide);
+    };
+
+    auto worker = [&](uint64_t base, uint64_t thread) {
+        AllocCounters allocStart = threadAllocCounters();
+        FastDiceRoller dice(base, 0, 0, thread);
+        UndoJournal journal;
+        GameState sim = state.clone();
+        std::vector<uint32_t> path;     // root first
+        std::vector<Macro> pathMacros;  // macros of path[1..], copied under the lock
+        std::vector<uint64_t> hashes;   // ttKey(sim) after each replayed macro (TT only)
+        MacroList childMacros;
+        std::vector<float> childPriors;
+        SearchStats local;  // this worker's share, merged into `stats` on exit
+        SearchTimer timer;
+        double depthSum = 0.0;
+        int tid = static_cast<int>(thread) + 1;  // trace track
+        SearchTrace* iterTrace = nullptr;         // set for sampled iterations
+
+        // Open-loop replay of pathMacros; returns how many were attempted.
+        // `complete` as in ReplayOutcome.
+        auto replay = [&](std::vector<uint64_t>* record, bool& complete) -> size_t {
+            BB_PROFILE_NAMED_SCOPE(profile, prof::MACRO_REPLAY);
+            if (record) record->clear();
+            complete = false;
+            for (size_t i = 0; i < pathMacros.size(); ++i) {
+                if (sim.phase == GamePhase::GAME_OVER ||
+                    sim.phase == GamePhase::TOUCHDOWN ||
+                    sim.phase == GamePhase::HALF_TIME) {
+                    return i;
+                }
+                TraceSpan span(iterTrace, macroTypeName(pathMacros[i].type), "macro", tid);
+                auto result = greedyExpandMacroJournaled(sim, pathMacros[i], dice, journal);
+                BB_PROFILE_UNITS(profile, 1);
+                if (record) record->push_back(tt ? ttKey(sim) : 0);
+                if (result.turnover) return i + 1;
+            }
+            complete = true;
+            return pathMacros.size();
+        };
+
+        // Take back this path's virtual loss, then add `value` to path[0..depth].
+        // The worker completing every 64th iteration reports progress.
+        auto backpropagate = [&](size_t depth, double value) {
+            std::lock_guard<std::mutex> lock(treeMutex);
+            for (uint32_t idx : path) {
+                arena_[idx].visits--;
+                arena_[idx].totalValue -= virtualLoss(idx, searchingSide);
+            }
+            --inFlight;
+            for (size_t i = 0; i <= depth; ++i) {
+                MacroMCTSNode& n = arena_[path[i]];
+                if (tt && i > 0) n.stateHash = hashes[i - 1];
+                n.visits++;
+                n.totalValue += value;
+                if (n.stateHash != 0) tt_.update(n.stateHash, value);
+            }
+            int done = completed.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (progress_ && (done & 63) == 0) {
+                if (!progress_(done)) stop.store(true, std::memory_order_relaxed);
+                maxIterations.store(config_.maxIterations, std::memory_order_relaxed);
+                timeBudgetMs.store(config_.timeBudgetMs, std::memory_order_relaxed);
+            }
+        };
+
+        int iteration;
+        while (!stop.load(std::memory_order_relaxed) &&
+               (iteration = claimed.fetch_add(1, std::memory_order_relaxed)) <
+                   maxIterations.load(std::memory_order_relaxed)) {
+            // Each worker checks the clock and the root every 64 of its iterations
+            if ((local.iterations & 63) == 0 && local.iterations > 0) {
+                double elapsed = elapsedMs(startTime);
+                int budgetMs = timeBudgetMs.load(std::memory_order_relaxed);
+                if ((budgetMs > 0 && elapsed >= budgetMs) || cancelled()) {
+                    stop.store(true, std::memory_order_relaxed);
+                    break;
+                }
+                if (config_.earlyStop) {
+                    int done = completed.load(std::memory_order_relaxed);
+                    std::lock_guard<std::mutex> lock(treeMutex);
+                    if (rootSettled(root, remainingIterations(done, elapsed), inFlight)) {
+                        local.stoppedEarly = true;
+                        stop.store(true, std::memory_order_relaxed);
+                        break;
+                    }
+                }
+            }
+            iterTrace = (config_.trace && config_.trace->sampled(iteration)) ? config_.trace : nullptr;
+            TraceSpan iterSpan(iterTrace, "iteration", "search", tid);
+
+            // 1. Select (locked)
+            bool expandLeaf;
+            {
+                std::lock_guard<std::mutex> lock(treeMutex);
+                path.assign(1, root);
+                uint32_t node = root;
+                while (arena_[node].expanded && arena_[node].numChildren > 0) {
+                    bool maximize = (arena_[node].actingTeam == searchingSide);
+                    uint32_t child = arena_[node].bestChildPUCT(arena_, config_.explorationC,
+                                                                maximize, tt);
+                    if (child == MacroMCTSArena::NONE) break;
+                    node = child;
+                    path.push_back(node);
+                }
+                expandLeaf = !arena_[node].expanded && arena_[node].visits > 0;
+                if (expandLeaf && config_.maxTreeNodes > 0 &&
+                    arena_.live() >= static_cast<uint32_t>(config_.maxTreeNodes)) {
+                    // Workers hold paths outside the lock: nothing is recycled
+                    expandLeaf = false;
+                    local.expansionsSkipped++;
+                }
+                pathMacros.clear();
+                for (size_t i = 1; i < path.size(); ++i) pathMacros.push_back(arena_[path[i]].macro);
+                for (uint32_t idx : path) addVirtualLoss(idx);
+                ++inFlight;
+            }
+            local.selectMs += timer.lap(iterTrace, "select", tid);
+
+            // 2. Replay
+            bool complete;
+            size_t depth = replay(&hashes, complete);
+            local.replayMs += timer.lap(iterTrace, "replay", tid);
+            if (!complete) {
+                double value = simulate(sim, searchingSide, dice);
+                local.truncatedReplays++;
+                local.leafEvals++;
+                local.maxDepth = std::max(local.maxDepth, static_cast<int>(depth));
+                depthSum += depth;
+                local.simulateMs += timer.lap(iterTrace, "simulate", tid);
+                journal.undoTo(sim, 0);
+                local.replayMs += timer.lap(iterTrace, "replay", tid);
+                backpropagate(depth, value);
+                local.backpropMs += timer.lap(iterTrace, "backprop", tid);
+                local.iterations++;
+                continue;
+            }
+
+            // 3. Expand: macros and priors unlocked, attach locked. If another
+            //    worker expanded the leaf in the meantime, its children stand.
+            if (expandLeaf) {
+                cachedChildren(sim, childMacros, childPriors, local, &cacheMutex, iterTrace, tid);
+                bool descended = false;
+                {
+                    std::lock_guard<std::mutex> lock(treeMutex);
+                    uint32_t leaf = path.back();
+                    if (!arena_[leaf].expanded) {
+                        attachChildren(leaf, sim, childMacros, childPriors);
+                        local.nodesAllocated += static_cast<int>(arena_[leaf].numChildren);
+                    }
+                    if (arena_[leaf].numChildren > 0) {
+                        // Highest-prior child, as in the serial loop
+                        uint32_t bestChild = arena_[leaf].firstChild;
+                        for (uint32_t c = bestChild; c < arena_[leaf].firstChild + arena_[leaf].numChildren; ++c) {
+                            if (arena_[c].prior > arena_[bestChild].prior) bestChild = c;
+                        }
+                        path.push_back(bestChild);
+                        pathMacros.push_back(arena_[bestChild].macro);
+                        addVirtualLoss(bestChild);
+                        descended = true;
+                    }
+                }
+                if (descended) {
+                    TraceSpan span(iterTrace, macroTypeName(pathMacros.back().type), "macro", tid);
+                    greedyExpandMacroJournaled(sim, pathMacros.back(), dice, journal);
+                    hashes.push_back(tt ? ttKey(sim) : 0);
+                }
+                local.expandMs += timer.lap(iterTrace, "expand", tid);
+            }
+
+            // 4. Evaluate (nRollouts samples, as in the serial loop)
+            int leafDepth = static_cast<int>(path.size()) - 1;
+            double value = simulate(sim, searchingSide, dice);
+            local.leafEvals++;
+            local.simulateMs += timer.lap(iterTrace, "simulate", tid);
+            journal.undoTo(sim, 0);
+            for (int r = 1; r < nRollouts; ++r) {
+                replay(nullptr, complete);
+                local.replayMs += timer.lap(iterTrace, "replay", tid);
+                if (complete) {
+                    value += simulate(sim, searchingSide, dice);
+                    local.leafEvals++;
+                } else {
+                    local.truncatedReplays++;
+                }
+                local.simulateMs += timer.lap(iterTrace, "simulate", tid);
+                journal.undoTo(sim, 0);
+            }
+            local.replayMs += timer.lap(iterTrace, "replay", tid);
+            local.maxDepth = std::max(local.maxDepth, leafDepth);
+            depthSum += leafDepth;
+            value /= static_cast<double>(nRollouts);
+
+            // 5. Backpropagate (locked)
+            backpropagate(path.size() - 1, value);
+            local.backpropMs += timer.lap(iterTrace, "backprop", tid);
+            local.iterations++;
+        }
+
+        if (local.iterations > 0) local.avgDepth = depthSum / local.iterations;
+        local.addAllocations(threadAllocCounters().since(allocStart));
+        std::lock_guard<std::mutex> lock(treeMutex);
+        stats.merge(local);
+    };
+
+    // Per-worker streams keyed off this search's own dice, so a seeded
+    // search still starts its workers from reproducible streams.
+    uint64_t base = dice_.next();
+    std::vector<std::thread> threads;
+    threads.reserve(config_.numThreads);
+    for (int t = 0; t < config_.numThreads; ++t) {
+        threads.emplace_back(worker, base, static_cast<uint64_t>(t));
+    }
+    for (auto& th : threads) th.join();
+    return completed.load();
+}
+
+double MacroMCTSSearch::virtualLoss(uint32_t node, TeamSide searchingSide) const {
+    constexpr double VIRTUAL_LOSS = 1.0;  // leaf values are clamped to [-1, 1]
+    // Q is searchingSide's; the chooser is the parent's actingTeam.
+    uint32_t parent = arena_[node].parent;
+    if (parent == MacroMCTSArena::NONE) return 0.0;
+    return arena_[parent].actingTeam == searchingSide ? -VIRTUAL_LOSS : VIRTUAL_LOSS;
+}
+
+void MacroMCTSSearch::applyVirtualLoss(uint32_t node, TeamSide searchingSide, int sign) {
+    for (uint32_t n = node; n != MacroMCTSArena::NONE; n = arena_[n].parent) {
+        arena_[n].visits += sign;
+        arena_[n].totalValue += sign * virtualLoss(n, searchingSide);
+    }
+}
+
+void MacroMCTSSearch::queueSample(const GameState& state, TeamSide perspective, PendingLeaf& leaf,
+                                  DiceRollerBase& dice) {
+    queuedTerms_.push_back(leafTerms(state, perspective, dice));
+    evalQueue_.push(state, perspective);
+    leaf.samples++;
+}
+
+// Until its evaluation comes back a queued leaf's path carries virtual
+// loss, so the selections that follow spread to other lines.
+void MacroMCTSSearch::deferLeaf(const PendingLeaf& leaf, TeamSide searchingSide) {
+    applyVirtualLoss(leaf.node, searchingSide, +1);
+    pending_.push_back(leaf);
+    if (evalQueue_.full()) flushLeaves(searchingSide);
+}
+
+void MacroMCTSSearch::flushLeaves(TeamSide searchingSide) {
+    evalQueue_.flush();
+    for (const PendingLeaf& leaf : pending_) {
+        double value = 0.0;
+        for (int t = leaf.firstTicket; t < leaf.firstTicket + leaf.samples; ++t) {
+            value += combineLeaf(queuedTerms_[t], evalQueue_.result(t));
+        }
+        value /= static_cast<double>(leaf.divisor);
+        applyVirtualLoss(leaf.node, searchingSide, -1);
+        backpropagate(leaf.node, value);
+    }
+    pending_.clear();
+    queuedTerms_.clear();
+    evalQueue_.clear();
+}
+
+bool MacroMCTSSearch::makeRoom(uint32_t node, TeamSide searchingSide, bool batched, SearchStats& stats) {
+    if (config_.maxTreeNodes <= 0) return true;
+    const uint32_t budget = static_cast<uint32_t>(config_.maxTreeNodes);
+    if (arena_.live() < budget) return true;
+    // Queued leaves may sit in a block about to be released
+    if (batched) flushLeaves(searchingSide);
+
+    // Frontier nodes (expanded, no child expanded) off the path to `node`,
+    // least visited first
+    std::vector<uint32_t> path;
+    for (uint32_t n = node; n != MacroMCTSArena::NONE; n = arena_[n].parent) path.push_back(n);
+    std::vector<std::pair<int, uint32_t>> frontier;
+    for (uint32_t i = 0; i < arena_.size(); ++i) {
+        const MacroMCTSNode& n = arena_[i];
+        if (!n.expanded || n.numChildren == 0) continue;
+        auto children = arena_.children(n);
+        if (std::any_of(children.begin(), children.end(), [](const MacroMCTSNode& c) { return c.expanded; })) {
+            continue;
+        }
+        if (std::find(path.begin(), path.end(), i) != path.end()) continue;
+        frontier.emplace_back(n.visits, i);
+    }
+    std::sort(frontier.begin(), frontier.end());
+
+    // Down to 3/4 of the budget, so sweeps stay rare
+    const uint32_t target = budget - budget / 4;
+    int freed = 0;
+    for (const auto& [visits, i] : frontier) {
+        if (arena_.live() <= target) break;
+        MacroMCTSNode& n = arena_[i];
+        for (uint32_t c = n.firstChild; c < n.firstChild + n.numChildren; ++c) {
+            auto cached = stateCache_.find(c);
+            if (cached == stateCache_.end()) continue;
+            cachedStates_ -= cached->second.size();
+            stateCache_.erase(cached);
+        }
+        freed += static_cast<int>(n.numChildren);
+        arena_.release(n.firstChild, n.numChildren);
+        n.firstChild = MacroMCTSArena::NONE;
+        n.numChildren = 0;
+        n.expanded = false;
+    }
+    if (freed > 0) {
+        stats.recycleSweeps++;
+        stats.recycledNodes += freed;
+    }
+    if (arena_.live() < budget) return true;
+    stats.expansionsSkipped++;
+    return false;
+}
+
+uint64_t MacroMCTSSearch::ttKey(const GameState& state) const {
+    return config_.symmetricCaches ? canonicalHash(state) : state.hash();
+}
+
+void MacroMCTSSearch::expand(uint32_t node, const GameState& state) {
+    BB_ALLOC_SCOPE(alloc::SEARCH_TREE);
+    MacroList macros;
+    std::vector<float> priors;
+    cachedChildren(state, macros, priors, lastStats_, nullptr, iterTrace_);
+    attachChildren(node, state, macros, priors);
+}
+
+void MacroMCTSSearch::cachedChildren(const GameState& state, MacroList& macros,
+                                     std::vector<float>& priors, SearchStats& stats,
+                                     std::mutex* cacheMutex, SearchTrace* trace, int tid) {
+    if (!priorCache_.enabled()) {
+        computeChildren(state, macros, priors, trace, tid);
+        return;
+    }
+    // Same position, same config: same macros and priors. Under
+    // symmetricCaches entries are stored in the canonical orientation and
+    // mapped back to this one on a hit; the mirror keeps the list order.
+    uint64_t key;
+    Symmetry sym;
+    if (config_.symmetricCaches) {
+        CanonicalForm form = canonicalize(state);
+        key = form.hash;
+        sym = form.toCanonical;
+    } else {
+        key = state.hash();
+    }
+    // Lookups move the cache's clock marks: parallel workers take turns
+    auto hold = [&] {
+        return cacheMutex ? std::unique_lock<std::mutex>(*cacheMutex) : std::unique_lock<std::mutex>();
+    };
+    bool hit;
+    {
+        auto lock = hold();
+        hit = priorCache_.lookup(key, macros, priors);
+    }
+    if (hit) {
+        stats.priorCacheHits++;
+        if (sym.flipY) {
+            for (Macro& m : macros) m = sym.apply(m);
+        }
+        return;
+    }
+    stats.priorCacheMisses++;
+    computeChildren(state, macros, priors, trace, tid);
+    MacroList canonical;
+    if (sym.flipY) {
+        for (const Macro& m : macros) canonical.push_back(sym.apply(m));
+    }
+    auto lock = hold();
+    priorCache_.store(key, sym.flipY ? canonical : macros, priors);
+}
+
+void MacroMCTSSearch::attachChildren(uint32_t node, const GameState& state,
+                                     const MacroList& macros,
+                                     const std::vector<float>& priors) {
     // Children about to be generated represent whichever team is active in
     // `state` — needed by select()/bestChildPUCT to tell a cooperative
     // (searchingSide's own) decision node from an adversarial (opponent's)
     // one.
-    node->actingTeam = state.activeTeam;
+    arena_[node].actingTeam = state.activeTeam;
+    if (config_.reuseTree || ponderReuse_) arena_[node].expandedHash = state.hash();
+
+    int n = static_cast<int>(macros.size());
+    std::vector<int> kept = opponentReplies(node, priors);
+    if (!kept.empty()) n = static_cast<int>(kept.size());
+    float keptMass = 0.0f;
+    for (int k : kept) keptMass += priors[k];
+    if (n > 0) {
+        uint32_t first = arena_.allocate(static_cast<uint32_t>(n));
+        for (int i = 0; i < n; ++i) {
+            int from = kept.empty() ? i : kept[i];
+            MacroMCTSNode& child = arena_[first + i];
+            child.macro = macros[from];
+            child.parent = node;
+            child.prior = kept.empty() ? priors[from]
+                        : keptMass > 0.0f ? priors[from] / keptMass : 1.0f / n;
+        }
+        arena_[node].firstChild = first;
+        arena_[node].numChildren = static_cast<uint32_t>(n);
+    }
+    arena_[node].expanded = true;
+}
 
+std::vector<int> MacroMCTSSearch::opponentReplies(uint32_t node, const std::vector<float>& priors) const {
+    const int width = config_.opponentReplyWidth;
+    if (width <= 0 || static_cast<int>(priors.size()) <= width) return {};
+    // The root chose first: its acting team is the searching side
+    int depth = 0;
+    uint32_t root = node;
+    while (arena_[root].parent != MacroMCTSArena::NONE) {
+        root = arena_[root].parent;
+        ++depth;
+    }
+    if (depth < config_.opponentReplyMinDepth || arena_[node].actingTeam == arena_[root].actingTeam) return {};
+
+    std::vector<int> order(priors.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = static_cast<int>(i);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return priors[a] > priors[b]; });
+    order.resize(width);
+    std::sort(order.begin(), order.end());  // generation order among the kept
+    return order;
+}
+
+void MacroMCTSSearch::computeChildren(const GameState& state, MacroList& macros,
+                                      std::vector<float>& priors,
+                                      SearchTrace* trace, int tid) const {
+    macros.clear();
+    priors.clear();
     if (state.phase == GamePhase::GAME_OVER ||
         state.phase == GamePhase::TOUCHDOWN ||
         state.phase == GamePhase::HALF_TIME) {
-        node->expanded = true;
         return;
     }
 
-    std::vector<Macro> macros;
-    getAvailableMacros(state, macros);
-
-    int n = static_cast<int>(macros.size());
+    // One tactical analysis serves generation, macro features and the
+    // heuristic priors below
+    TacticalContext ctx;
+    int n;
+    {
+        TraceSpan span(trace, "getAvailableMacros", "expand", tid);
+        computeTacticalContext(state, ctx);
+        getAvailableMacros(state, ctx, macros);
+        n = static_cast<int>(macros.size());
+        if (span.active()) span.args = "\"macros\":" + std::to_string(n);
+    }
+    TraceSpan priorSpan(trace, "priors", "expand", tid);
 
     // Compute priors: blend policy network with heuristic priors
-    std::vector<float> priors(n, 1.0f / std::max(n, 1));
+    priors.assign(n, 1.0f / std::max(n, 1));
 
     // A) Compute policy network priors (if available)
     std::vector<float> policyPriors;
@@ -269,14 +1247,13 @@ void MacroMCTSSearch::expand(MacroMCTSNode* node, const GameState& state) {
         extractFeatures(state, state.activeTeam, stateFeats);
 
         std::vector<float> macroFeats(n * NUM_ACTION_FEATURES);
-        for (int i = 0; i < n; ++i) {
-            extractMacroFeatures(state, macros[i], &macroFeats[i * NUM_ACTION_FEATURES]);
-        }
+        extractMacroFeatures(state, ctx, macros.data(), n, macroFeats.data());
 
+        // All candidates in one call: the state half of the network is
+        // evaluated once per node, not once per macro
+        config_.policy->evaluateActions(stateFeats, macroFeats.data(), n, policyPriors.data());
         float maxLogit = -1e30f;
         for (int i = 0; i < n; ++i) {
-            policyPriors[i] = config_.policy->evaluateAction(
-                stateFeats, &macroFeats[i * NUM_ACTION_FEATURES]);
             if (policyPriors[i] > maxLogit) maxLogit = policyPriors[i];
         }
         float sumExp = 0.0f;
@@ -323,7 +1300,7 @@ void MacroMCTSSearch::expand(MacroMCTSNode* node, const GameState& state) {
                         // One-turn TD: last turn, force scoring attempt
                         if (macros[i].playerId > 0) {
                             const Player& p = state.getPlayer(macros[i].playerId);
-                            int dist = distToEndzone(p.position, state.activeTeam);
+                            int dist = ctx.endzoneDist[p.id];
                             bool safeWalkIn = (dist <= static_cast<int>(p.movementRemaining));
                             minPrior = safeWalkIn ? 0.90f : 0.70f;
                         } else {
@@ -474,45 +1451,60 @@ void MacroMCTSSearch::expand(MacroMCTSNode* node, const GameState& state) {
         }
     }
 
-    node->children.reserve(n);
-    for (int i = 0; i < n; ++i) {
-        MacroMCTSNode child;
-        child.macro = macros[i];
-        child.parent = node;
-        child.prior = priors[i];
-        node->children.push_back(std::move(child));
-    }
-    node->expanded = true;
 }
 
 std::vector<std::pair<Macro, float>> MacroMCTSSearch::expandRootPriorsForTest(
         const GameState& state) {
-    MacroMCTSNode root;
-    expand(&root, state);
+    reuseRoot_ = MacroMCTSArena::NONE;
+    arena_.reset();
+    uint32_t root = arena_.allocate(1);
+    expand(root, state);
     std::vector<std::pair<Macro, float>> out;
-    out.reserve(root.children.size());
-    for (auto& c : root.children) out.emplace_back(c.macro, c.prior);
+    auto children = arena_.children(arena_[root]);
+    out.reserve(children.size());
+    for (auto& c : children) out.emplace_back(c.macro, c.prior);
     return out;
 }
 
-double MacroMCTSSearch::greedyLookaheadBonus(const GameState& leafState, TeamSide perspective) {
+double MacroMCTSSearch::greedyLookaheadBonus(const GameState& leafState, TeamSide perspective,
+                                             DiceRollerBase& dice) const {
+    if (!lookaheadShared_) {
+        Macro macro;
+        if (!greedyLookaheadMacro(leafState, perspective, macro)) return 0.0;
+        return greedyLookaheadSample(leafState, perspective, macro, dice);
+    }
+    // Repeat visits to a leaf state skip the macro generation, and once
+    // lookaheadSamples outcomes are in, the greedy expansion as well.
+    auto [it, inserted] = lookahead_.try_emplace(leafState.hash());
+    LookaheadEntry& entry = it->second;
+    if (inserted) entry.applies = greedyLookaheadMacro(leafState, perspective, entry.macro);
+    if (!entry.applies) return 0.0;
+    if (entry.samples >= config_.lookaheadSamples) {
+        lookaheadReuses_++;
+        return entry.sum / entry.samples;
+    }
+    entry.sum += greedyLookaheadSample(leafState, perspective, entry.macro, dice);
+    entry.samples++;
+    return entry.sum / entry.samples;
+}
+
+bool MacroMCTSSearch::greedyLookaheadMacro(const GameState& leafState, TeamSide perspective,
+                                           Macro& out) const {
     // Only meaningful while it is still OUR turn: getAvailableMacros() and
     // greedyExpandMacro() both operate on state.activeTeam, so if the turn
     // has already passed to the opponent this would silently simulate THEIR
     // next macro instead of ours. Bail out rather than mislabel that signal.
-    if (leafState.phase != GamePhase::PLAY) return 0.0;
-    if (leafState.activeTeam != perspective) return 0.0;
-    if (!leafState.ball.isHeld || leafState.ball.carrierId <= 0) return 0.0;
+    if (leafState.phase != GamePhase::PLAY) return false;
+    if (leafState.activeTeam != perspective) return false;
+    if (!leafState.ball.isHeld || leafState.ball.carrierId <= 0) return false;
 
     const Player& carrier = leafState.getPlayer(leafState.ball.carrierId);
-    if (carrier.teamSide != perspective) return 0.0;
-
-    int distBefore = distToEndzone(carrier.position, perspective);
-    if (distBefore <= 0) return 0.0;  // already in the endzone somehow
+    if (carrier.teamSide != perspective) return false;
+    if (distToEndzone(carrier.position, perspective) <= 0) return false;  // already in the endzone somehow
 
-    std::vector<Macro> macros;
+    MacroList macros;
     getAvailableMacros(leafState, macros);
-    if (macros.empty()) return 0.0;
+    if (macros.empty()) return false;
 
     int bestIdx = -1, bestRank = -1;
     for (size_t i = 0; i < macros.size(); ++i) {
@@ -523,14 +1515,22 @@ double MacroMCTSSearch::greedyLookaheadBonus(const GameState& leafState, TeamSid
         }
     }
     if (bestIdx < 0 || macros[static_cast<size_t>(bestIdx)].type == MacroType::END_TURN) {
-        return 0.0;  // nothing constructive left to try from here
+        return false;  // nothing constructive left to try from here
     }
+    out = macros[static_cast<size_t>(bestIdx)];
+    return true;
+}
+
+double MacroMCTSSearch::greedyLookaheadSample(const GameState& leafState, TeamSide perspective,
+                                              const Macro& macro, DiceRollerBase& dice) const {
+    const Player& carrier = leafState.getPlayer(leafState.ball.carrierId);
+    int distBefore = distToEndzone(carrier.position, perspective);
 
     // Apply exactly ONE more macro on a clone -- bounded cost, never mutates
-    // the real leaf/search state. Real dice (via dice_) resolve the atomic
+    // the real leaf/search state. Real dice (the caller's) resolve the atomic
     // actions, same as every other macro application in this search.
     GameState projected = leafState.clone();
-    auto result = greedyExpandMacro(projected, macros[static_cast<size_t>(bestIdx)], dice_);
+    auto result = greedyExpandMacro(projected, macro, dice);
 
     if (result.turnover) {
         // The greedy continuation actually loses the ball one ply out --
@@ -551,35 +1551,52 @@ double MacroMCTSSearch::greedyLookaheadBonus(const GameState& leafState, TeamSid
     return std::clamp(progress, -0.10, 0.20) * 0.5;      // bounded, modest weight
 }
 
-double MacroMCTSSearch::simulate(const GameState& state, TeamSide perspective) {
-    // Heuristic baseline — always computed (provides signal even with zero VF)
+double MacroMCTSSearch::simulate(const GameState& state, TeamSide perspective,
+                                 DiceRollerBase& dice) const {
+    LeafTerms terms = leafTerms(state, perspective, dice);
+    if (!usesValueFunction()) return combineLeaf(terms, 0.0f);
+    return combineLeaf(terms, valueFn_->evaluateState(state, perspective));
+}
+
+MacroMCTSSearch::LeafInvariants MacroMCTSSearch::leafInvariants(const GameState& state) {
+    LeafInvariants leaf;
+    for (const Player& p : state.players) {
+        if (p.id < 1 || p.id > 22) continue;
+        if (p.stats().strength >= 4) leaf.strong |= 1u << p.id;
+        if (p.stats().agility >= 4) leaf.agile |= 1u << p.id;
+    }
+    return leaf;
+}
+
+// The leaf heuristic as a sequence of terms: emit(term, value) once per
+// term that applies, in a fixed order (the sums are order-sensitive).
+template <typename Emit>
+void MacroMCTSSearch::emitLeafTerms(const GameState& state, TeamSide perspective, DiceRollerBase& dice,
+                                    const LeafInvariants& leaf, Emit&& emit) const {
     const TeamState& my = state.getTeamState(perspective);
     const TeamState& opp = state.getTeamState(opponent(perspective));
-    double heuristic = 0.0;
-    // fix #1 (2026-06-24): offensive forward/scoring pull is accumulated
-    // separately and added AFTER the vf blend, so a calibrated value head —
-    // which is flat/negative on the rare scoring-frontier states — cannot
-    // dilute the only signal telling MCTS to carry the ball into the endzone
-    // (root cause of the 0-0 draw collapse).
-    double scoringBonus = 0.0;
+    const TeamSide oppSide = opponent(perspective);
+    // Ids 1-11 are home's, 12-22 away's (GameState::getPlayer)
+    const uint32_t oppIds = oppSide == TeamSide::HOME ? 0x00000ffeu : 0x007ff000u;
 
     // Score advantage (dominant signal)
-    heuristic += (my.score - opp.score) * 0.5;
+    emit(LeafTerm::SCORE_DIFF, (my.score - opp.score) * 0.5);
 
     int turnsLeft = std::max(0, 9 - my.turnNumber);
+    const Player* oppCarrier = nullptr;
 
     // Ball possession + endzone proximity + scoring urgency
     if (state.ball.isHeld && state.ball.carrierId > 0) {
         const Player& carrier = state.getPlayer(state.ball.carrierId);
         int ezX = (carrier.teamSide == TeamSide::HOME) ? 25 : 0;
         int dist = std::abs(carrier.position.x - ezX);
-        int ma = carrier.stats.movement;
+        int ma = carrier.stats().movement;
         double proximity = 1.0 - dist / 25.0; // 0..1, 1=at endzone
 
         if (carrier.teamSide == perspective) {
-            heuristic += 0.1;  // have ball (possession value — may be blended)
-            // fix #1: all offensive endzone/scoring pull below -> scoringBonus
-            scoringBonus += 0.25 * proximity;  // closer to endzone = better
+            emit(LeafTerm::POSSESSION, 0.1);  // have ball (possession value — may be blended)
+            // fix #1: all offensive endzone/scoring pull below is a scoring term
+            emit(LeafTerm::PROXIMITY, 0.25 * proximity);  // closer to endzone = better
 
             // search-side #2 (2026-06-25): advance the whole CAGE, not just the carrier.
             // search-side #1 (stronger lone-carrier pull) was a no-op in smoke: the
@@ -587,7 +1604,7 @@ double MacroMCTSSearch::simulate(const GameState& state, TeamSide perspective) {
             // turnover risk pulls it back). The missing signal is the protective cage
             // moving up. Reward EARLY-TURN forward progress of standing teammates near
             // the carrier so "cage advanced, carrier screened" outranks "cage sat back";
-            // the carrier then follows safely. Inside scoringBonus (post-vfBlend) -> no dilution.
+            // the carrier then follows safely. A scoring term (post-vfBlend) -> no dilution.
             if (turnsLeft >= 3) {  // early/mid turns — late turns are already urgency-driven
                 double cageProxSum = 0.0;
                 int cageN = 0;
@@ -599,16 +1616,16 @@ double MacroMCTSSearch::simulate(const GameState& state, TeamSide perspective) {
                     cageProxSum += 1.0 - pd / 25.0;   // this escort's forward progress
                     cageN++;
                 });
-                if (cageN > 0) scoringBonus += 0.20 * (cageProxSum / cageN);
+                if (cageN > 0) emit(LeafTerm::CAGE_ADVANCE, 0.20 * (cageProxSum / cageN));
             }
 
             // Can score without GFI (safe walk-in)
             if (dist <= static_cast<int>(carrier.movementRemaining)) {
-                scoringBonus += 0.4;  // strong bonus — safe TD
+                emit(LeafTerm::WALK_IN, 0.4);  // strong bonus — safe TD
             }
             // Can score with GFI (risky but possible)
             else if (dist <= carrier.movementRemaining + 2) {
-                scoringBonus += 0.2;
+                emit(LeafTerm::GFI_SCORE, 0.2);
             }
 
             // Stall pacing: reward being on-track to score on last turn
@@ -616,34 +1633,30 @@ double MacroMCTSSearch::simulate(const GameState& state, TeamSide perspective) {
             if (turnsLeft > 0 && dist > 0) {
                 int idealDist = turnsLeft * ma;
                 double pacing = 1.0 - std::abs(dist - idealDist) / (double)std::max(idealDist, 1);
-                if (pacing > 0) scoringBonus += 0.1 * pacing;
+                if (pacing > 0) emit(LeafTerm::PACING, 0.1 * pacing);
             }
 
             // Urgency: last 2 turns and near endzone — must score!
             if (turnsLeft <= 2 && dist <= ma + 2) {
-                scoringBonus += 0.3;
+                emit(LeafTerm::URGENCY, 0.3);
             }
 
             // One-turn TD: last turn, carrier can score NOW — massive bonus
+            // (safe walk-in: 0.8; GFIs needed: scaled by their odds)
             if (turnsLeft <= 1) {
-                if (dist <= static_cast<int>(carrier.movementRemaining)) {
-                    scoringBonus += 0.8;  // safe walk-in on last turn
-                } else if (dist <= carrier.movementRemaining + 2) {
-                    scoringBonus += 0.5;  // GFI needed but scoreable
-                }
+                int gfis = std::max(0, dist - static_cast<int>(carrier.movementRemaining));
+                emit(LeafTerm::ONE_TURN_TD, 0.8 * RiskOracle::goForItChance(state, carrier, gfis));
             }
 
             // Hand-off scoring potential: carrier can't reach EZ but adjacent teammate can
             if (dist > static_cast<int>(carrier.movementRemaining) + 2) {
-                auto adj = carrier.position.getAdjacent();
-                for (auto& apos : adj) {
-                    if (!apos.isOnPitch()) continue;
+                for (Position apos : onPitchNeighbours(carrier.position)) {
                     const Player* tm = state.getPlayerAtPosition(apos);
                     if (!tm || tm->teamSide != perspective) continue;
                     if (tm->state != PlayerState::STANDING) continue;
                     int tmDist = distToEndzone(tm->position, perspective);
                     if (tmDist > 0 && tmDist <= static_cast<int>(tm->movementRemaining) + 2) {
-                        scoringBonus += 0.15;
+                        emit(LeafTerm::HAND_OFF_SCORE, 0.15);
                         break;
                     }
                 }
@@ -652,19 +1665,22 @@ double MacroMCTSSearch::simulate(const GameState& state, TeamSide perspective) {
             // Bounded greedy 1-ply forward look (2026-07-02 experiment, off by
             // default via config_.leafLookahead): see greedyLookaheadBonus().
             if (config_.leafLookahead) {
-                scoringBonus += greedyLookaheadBonus(state, perspective);
+                ResolutionScope resolution(dice, config_.expectedResolution ? ResolutionMode::Expected
+                                                                            : dice.resolutionMode());
+                emit(LeafTerm::LOOKAHEAD, greedyLookaheadBonus(state, perspective, dice));
             }
 
         } else {
-            heuristic -= 0.1;
-            heuristic -= 0.25 * proximity;
+            emit(LeafTerm::OPP_POSSESSION, -0.1);
+            emit(LeafTerm::OPP_PROXIMITY, -0.25 * proximity);
             // Opponent can score — bad
             if (dist <= static_cast<int>(carrier.movementRemaining)) {
-                heuristic -= 0.4;
+                emit(LeafTerm::OPP_CAN_SCORE, -0.4);
             }
+            if (carrier.isOnPitch() && carrier.state == PlayerState::STANDING) oppCarrier = &carrier;
         }
     } else if (!state.ball.isHeld && state.ball.isOnPitch()) {
-        heuristic -= 0.1;  // loose ball is bad
+        emit(LeafTerm::LOOSE_BALL, -0.1);  // loose ball is bad
 
         // Bonus for having a player near the loose ball (quick pickup potential)
         int nearestDist = 999;
@@ -673,196 +1689,378 @@ double MacroMCTSSearch::simulate(const GameState& state, TeamSide perspective) {
             int d = p.position.distanceTo(state.ball.position);
             if (d < nearestDist) nearestDist = d;
         });
-        if (nearestDist <= 2) heuristic += 0.08;
-        else if (nearestDist <= 4) heuristic += 0.04;
+        if (nearestDist <= 2) emit(LeafTerm::NEAR_LOOSE_BALL, 0.08);
+        else if (nearestDist <= 4) emit(LeafTerm::NEAR_LOOSE_BALL, 0.04);
     }
 
     // Defense: bonus for marking opponent carrier with tackle zones
-    if (state.ball.isHeld && state.ball.carrierId > 0) {
-        const Player& ballHolder = state.getPlayer(state.ball.carrierId);
-        if (ballHolder.teamSide != perspective && ballHolder.isOnPitch() &&
-            ballHolder.state == PlayerState::STANDING) {
-            int carrierTZ = countTacklezones(state, ballHolder.position, ballHolder.teamSide);
-            if (carrierTZ > 0) {
-                heuristic += 0.08 * std::min(carrierTZ, 3); // max +0.24
-            }
-        }
+    int carrierTZ = oppCarrier ? countTacklezones(state, oppCarrier->position, oppCarrier->teamSide) : 0;
+    if (carrierTZ > 0) {
+        emit(LeafTerm::MARK_OPP_CARRIER, 0.08 * std::min(carrierTZ, 3)); // max +0.24
     }
 
-    // Dodge-back vs bash: penalty when our players are adjacent to strong (ST≥4) opponents
-    {
-        int bashExposure = 0;
-        state.forEachOnPitch(perspective, [&](const Player& p) {
-            if (p.state != PlayerState::STANDING) return;
-            auto adj = p.position.getAdjacent();
-            for (auto& apos : adj) {
-                if (!apos.isOnPitch()) continue;
-                const Player* opp = state.getPlayerAtPosition(apos);
-                if (opp && opp->teamSide != perspective &&
-                    opp->state == PlayerState::STANDING &&
-                    opp->stats.strength >= 4) {
-                    bashExposure++;
-                    break; // count once per our player
-                }
-            }
+    // Dodge-back vs bash: penalty for each of our standing players next to a
+    // strong (ST≥4) standing opponent. Skipped when the opponents have none.
+    if ((leaf.strong & oppIds) != 0) {
+        Bitboard bashers;
+        state.forEachOnPitch(oppSide, [&](const Player& p) {
+            if (p.state == PlayerState::STANDING && (leaf.strong >> p.id & 1u)) bashers.set(p.position);
         });
-        heuristic -= 0.05 * bashExposure;
+        int bashExposure = (dilate(bashers) & state.standingOf(perspective)).count();
+        if (bashExposure > 0) emit(LeafTerm::BASH_EXPOSURE, -0.05 * bashExposure);
     }
 
     // Sideline trap: bonus when opponent carrier is near sideline (limited escape routes)
-    if (state.ball.isHeld && state.ball.carrierId > 0) {
-        const Player& bh = state.getPlayer(state.ball.carrierId);
-        if (bh.teamSide != perspective && bh.isOnPitch() &&
-            bh.state == PlayerState::STANDING) {
-            int y = bh.position.y;
-            if (y <= 2 || y >= 12) heuristic += 0.10;
-            else if (y <= 4 || y >= 10) heuristic += 0.05;
-        }
+    if (oppCarrier) {
+        int y = oppCarrier->position.y;
+        if (y <= 2 || y >= 12) emit(LeafTerm::SIDELINE_TRAP, 0.10);
+        else if (y <= 4 || y >= 10) emit(LeafTerm::SIDELINE_TRAP, 0.05);
     }
 
     // Contain vs agility: bonus when we TZ agile (AG≥4) opponent carrier from multiple sides
-    if (state.ball.isHeld && state.ball.carrierId > 0) {
-        const Player& bh = state.getPlayer(state.ball.carrierId);
-        if (bh.teamSide != perspective && bh.isOnPitch() &&
-            bh.state == PlayerState::STANDING && bh.stats.agility >= 4) {
-            int tzCount = countTacklezones(state, bh.position, bh.teamSide);
-            if (tzCount >= 2) heuristic += 0.06 * std::min(tzCount - 1, 2); // max +0.12
-        }
+    if (oppCarrier && (leaf.agile >> oppCarrier->id & 1u) && carrierTZ >= 2) {
+        emit(LeafTerm::CONTAIN_AGILE, 0.06 * std::min(carrierTZ - 1, 2)); // max +0.12
     }
 
     // Player count advantage (H8.8-H8.9): more players = better
-    int myPlayers = 0, oppPlayers = 0;
-    state.forEachOnPitch(perspective, [&](const Player& p) {
-        if (p.state == PlayerState::STANDING) myPlayers++;
-    });
-    state.forEachOnPitch(opponent(perspective), [&](const Player& p) {
-        if (p.state == PlayerState::STANDING) oppPlayers++;
+    int playerDiff = state.standingOf(perspective).count() - state.standingOf(oppSide).count();
+    if (playerDiff != 0) emit(LeafTerm::PLAYER_DIFF, playerDiff * 0.03);  // each player advantage = small bonus
+}
+
+MacroMCTSSearch::LeafTerms MacroMCTSSearch::leafTerms(const GameState& state, TeamSide perspective,
+                                                      DiceRollerBase& dice) const {
+    // Heuristic baseline — always computed (provides signal even with zero VF).
+    // fix #1 (2026-06-24): offensive forward/scoring pull is accumulated
+    // separately and added AFTER the vf blend, so a calibrated value head —
+    // which is flat/negative on the rare scoring-frontier states — cannot
+    // dilute the only signal telling MCTS to carry the ball into the endzone
+    // (root cause of the 0-0 draw collapse).
+    LeafTerms terms{0.0, 0.0};
+    emitLeafTerms(state, perspective, dice, leaf_, [&](LeafTerm term, double value) {
+        (isScoringTerm(term) ? terms.scoringBonus : terms.heuristic) += value;
     });
-    int playerDiff = myPlayers - oppPlayers;
-    heuristic += playerDiff * 0.03;  // each player advantage = small bonus
+    terms.heuristic = std::clamp(terms.heuristic, -1.0, 1.0);
+    return terms;
+}
 
-    heuristic = std::clamp(heuristic, -1.0, 1.0);
+LeafBreakdown MacroMCTSSearch::leafBreakdown(const GameState& state, TeamSide perspective,
+                                             DiceRollerBase& dice) const {
+    LeafBreakdown out;
+    LeafTerms terms{0.0, 0.0};
+    emitLeafTerms(state, perspective, dice, leafInvariants(state), [&](LeafTerm term, double value) {
+        out.terms[static_cast<size_t>(term)] += value;
+        (isScoringTerm(term) ? terms.scoringBonus : terms.heuristic) += value;
+    });
+    terms.heuristic = std::clamp(terms.heuristic, -1.0, 1.0);
+    out.heuristic = terms.heuristic;
+    out.scoringBonus = terms.scoringBonus;
+    if (usesValueFunction()) out.vfRaw = valueFn_->evaluateState(state, perspective);
+    out.value = combineLeaf(terms, out.vfRaw);
+    return out;
+}
 
+double MacroMCTSSearch::combineLeaf(const LeafTerms& terms, float vfRaw) const {
     // Blend with value function if available. fix #1: the offensive scoring
     // pull (scoringBonus) is added AFTER the blend so vf_blend never dilutes
     // it — the VF is flat/negative on scoring-frontier states and would
     // otherwise steer the search to the safe 0-0 line.
     double leaf;
-    if (valueFn_ && config_.vfBlend > 0.0f) {
-        float features[NUM_FEATURES];
-        extractFeatures(state, perspective, features);
-        double vfRaw = static_cast<double>(valueFn_->evaluate(features, NUM_FEATURES));
-        double vfValue = std::clamp(vfRaw, -1.0, 1.0);
+    if (usesValueFunction()) {
+        double vfValue = std::clamp(static_cast<double>(vfRaw), -1.0, 1.0);
 
         double blend = static_cast<double>(config_.vfBlend);
-        leaf = (1.0 - blend) * heuristic + blend * vfValue;
+        leaf = (1.0 - blend) * terms.heuristic + blend * vfValue;
     } else {
-        leaf = heuristic;
+        leaf = terms.heuristic;
     }
 
-    return std::clamp(leaf + scoringBonus, -1.0, 1.0);
+    return std::clamp(leaf + terms.scoringBonus, -1.0, 1.0);
 }
 
-void MacroMCTSSearch::backpropagate(MacroMCTSNode* node, double value) {
-    while (node) {
-        node->visits++;
-        node->totalValue += value;
-        node = node->parent;
+void MacroMCTSSearch::backpropagate(uint32_t node, double value) {
+    for (MacroMCTSNode* n = arena_.get(node); n; n = arena_.get(n->parent)) {
+        n->visits++;
+        n->totalValue += value;
+        if (n->stateHash != 0) tt_.update(n->stateHash, value);
     }
 }
 
-ReplayOutcome MacroMCTSSearch::replayToNode(GameState& state, MacroMCTSNode* node) {
+ReplayOutcome MacroMCTSSearch::replayToNode(GameState& state, uint32_t node) {
+    BB_PROFILE_NAMED_SCOPE(profile, prof::MACRO_REPLAY);
+
     // Build path from root to node
-    std::vector<MacroMCTSNode*> path;
-    MacroMCTSNode* cur = node;
-    while (cur->parent) {
+    std::vector<uint32_t>& path = path_;
+    path.clear();
+    uint32_t cur = node;
+    while (arena_[cur].parent != MacroMCTSArena::NONE) {
         path.push_back(cur);
-        cur = cur->parent;
+        cur = arena_[cur].parent;
     }
-    MacroMCTSNode* root = cur;
+    uint32_t root = cur;
 
-    // Replay in root-to-leaf order (open-loop: fresh dice each time).
+    // Replay in root-to-leaf order (open-loop: fresh dice each time, or
+    // the evaluated visit's per-depth substreams under common random numbers).
     // `reached` tracks the deepest node whose macro was actually attempted,
     // so a turnover/terminal-phase cutoff can still be backpropagated
     // against the real outcome instead of silently discarded.
-    MacroMCTSNode* reached = root;
+    //
+    // Shallow nodes with a full state cache are not replayed: one of their
+    // cached outcomes is drawn instead. Consecutive draws only decide
+    // whether the path survives (each node's samples already follow from
+    // its ancestors' outcomes), so only the last one is written to `state`.
+    uint32_t reached = root;
+    const CachedOutcome* drawn = nullptr;
+    auto applyDrawn = [&] {
+        if (!drawn) return;
+        journal_.assign(state, drawn->state);
+        if (tt_.enabled()) arena_[reached].stateHash = ttKey(state);
+        drawn = nullptr;
+    };
+    size_t samples = static_cast<size_t>(std::max(1, config_.stateCacheSamples));
     for (int i = static_cast<int>(path.size()) - 1; i >= 0; --i) {
-        if (state.phase == GamePhase::GAME_OVER ||
-            state.phase == GamePhase::TOUCHDOWN ||
-            state.phase == GamePhase::HALF_TIME) {
+        GamePhase phase = drawn ? drawn->state.phase : state.phase;
+        if (phase == GamePhase::GAME_OVER ||
+            phase == GamePhase::TOUCHDOWN ||
+            phase == GamePhase::HALF_TIME) {
+            applyDrawn();
             return {reached, false};
         }
-        auto result = greedyExpandMacro(state, path[i]->macro, dice_);
+        int depth = static_cast<int>(path.size()) - i;
+        if (depth <= config_.stateCacheDepth) {
+            auto it = stateCache_.find(path[i]);
+            if (it != stateCache_.end() && it->second.size() >= samples) {
+                drawn = &it->second[stepDice(depth).next() % it->second.size()];
+                reached = path[i];
+                lastStats_.cachedReplays++;
+                if (drawn->turnover) {
+                    applyDrawn();
+                    return {reached, false};
+                }
+                continue;
+            }
+        }
+        applyDrawn();
+        TraceSpan span(iterTrace_, macroTypeName(arena_[path[i]].macro.type), "macro");
+        auto result = greedyExpandMacroJournaled(state, arena_[path[i]].macro, stepDice(depth), journal_);
+        BB_PROFILE_UNITS(profile, 1);
         reached = path[i];
+        if (tt_.enabled()) arena_[reached].stateHash = ttKey(state);
+        cacheOutcome(reached, depth, state, result.turnover);
         if (result.turnover) {
             return {reached, false};
         }
     }
+    applyDrawn();
 
     return {node, true};
 }
 
+FastDiceRoller& MacroMCTSSearch::stepDice(int depth) {
+    if (crnVisit_ < 0) return dice_;
+    crnDice_ = FastDiceRoller(crnBase_, static_cast<uint64_t>(crnVisit_),
+                              static_cast<uint64_t>(depth), static_cast<uint64_t>(crnSample_));
+    return crnDice_;
+}
+
+// Open-loop replay of `macros` from `state`: false if a turnover or a
+// terminal phase cut it short (as replayToNode's `complete`).
+static bool replayMacros(GameState& state, const std::vector<Macro>& macros,
+                         DiceRollerBase& dice, UndoJournal& journal) {
+    for (const Macro& m : macros) {
+        if (state.phase == GamePhase::GAME_OVER ||
+            state.phase == GamePhase::TOUCHDOWN ||
+            state.phase == GamePhase::HALF_TIME) {
+            return false;
+        }
+        if (greedyExpandMacroJournaled(state, m, dice, journal).turnover) return false;
+    }
+    return true;
+}
+
+double MacroMCTSSearch::sampleRollouts(GameState& sim, uint32_t node, TeamSide perspective,
+                                       int n, int& samples) {
+    rolloutPath_.clear();
+    for (uint32_t cur = node; arena_[cur].parent != MacroMCTSArena::NONE; cur = arena_[cur].parent) {
+        rolloutPath_.push_back(arena_[cur].macro);
+    }
+    std::reverse(rolloutPath_.begin(), rolloutPath_.end());
+
+    // Each extra sample rolls dice keyed to (this draw, sample index), not
+    // to the worker that happens to run it: results do not depend on
+    // scheduling, so a seeded search stays reproducible.
+    uint64_t base = dice_.next();
+    rolloutValues_.assign(n, std::numeric_limits<double>::quiet_NaN());
+    rolloutPool_->run(n, [&](int task, int worker) {
+        if (task == 0) {
+            rolloutValues_[0] = simulate(sim, perspective, dice_);
+            return;
+        }
+        RolloutWorker& w = rolloutWorkers_[worker];
+        FastDiceRoller dice(base, static_cast<uint64_t>(task));
+        if (replayMacros(w.sim, rolloutPath_, dice, w.journal)) {
+            rolloutValues_[task] = simulate(w.sim, perspective, dice);
+        }
+        w.journal.undoTo(w.sim, 0);
+    });
+    journal_.undoTo(sim, 0);
+
+    double sum = 0.0;
+    samples = 0;
+    for (double v : rolloutValues_) {
+        if (std::isnan(v)) continue;
+        sum += v;
+        samples++;
+    }
+    return sum;
+}
+
+void MacroMCTSSearch::cacheOutcome(uint32_t node, int depth, const GameState& state, bool turnover) {
+    if (depth > config_.stateCacheDepth) return;
+    size_t cap = (static_cast<size_t>(std::max(0, config_.stateCacheMB)) << 20) / sizeof(CachedOutcome);
+    if (cachedStates_ >= cap) return;
+    std::vector<CachedOutcome>& outcomes = stateCache_[node];
+    if (outcomes.size() >= static_cast<size_t>(std::max(1, config_.stateCacheSamples))) return;
+    outcomes.push_back({state.clone(), turnover});
+    cachedStates_++;
+}
+
 // --- MacroMCTSPolicy ---
 
 MacroMCTSPolicy::MacroMCTSPolicy(const ValueFunction* vf, MCTSConfig config, uint32_t seed)
-    : search_(vf, config, seed), expansionDice_(seed + 12345) {}
+    : search_(vf, config, seed), baseConfig_(config), expansionDice_(seed + 12345),
+      capDice_(seed + 24691) {}
+
+MacroMCTSPolicy::~MacroMCTSPolicy() = default;
+
+void MacroMCTSPolicy::ponder(const GameState& state, int maxIterations) {
+    stopPondering();
+    search_.setPonderReuse(true);
+    ponder_ = search_.searchAsync(state, 0, maxIterations);
+}
+
+bool MacroMCTSPolicy::pondering() const {
+    return ponder_ && !ponder_->done();
+}
 
-void MacroMCTSPolicy::setLogDecisions(bool log, int topK) {
+void MacroMCTSPolicy::stopPondering() {
+    if (!ponder_) return;
+    ponder_.reset();  // cancels and joins
+    pondered_ = true;
+    if (!timeManager_) search_.setBudget(baseConfig_.timeBudgetMs, baseConfig_.maxIterations);
+}
+
+void MacroMCTSPolicy::setTimeManager(TimeManager* tm) {
+    timeManager_ = tm;
+    if (!tm) search_.setBudget(baseConfig_.timeBudgetMs, baseConfig_.maxIterations);
+}
+
+Macro MacroMCTSPolicy::budgetedSearch(const GameState& state) {
+    if (!timeManager_) return search_.search(state);
+
+    // One extra root expansion per decision: the allocation reads the
+    // search's own candidates and priors
+    MacroList macros;
+    std::vector<float> priors;
+    search_.rootPriors(state, macros, priors);
+    double budget = timeManager_->allocate(state, priors);
+    if (budget <= 0.0) return search_.search(state);  // forced: no iterations run
+
+    bool iterations = timeManager_->config().unit == TimeManager::Unit::ITERATIONS;
+    if (iterations) {
+        int n = static_cast<int>(std::lround(budget));
+        search_.setBudget(baseConfig_.timeBudgetMs, std::clamp(n, 1, baseConfig_.maxIterations));
+    } else {
+        search_.setBudget(std::max(1, static_cast<int>(std::lround(budget))), baseConfig_.maxIterations);
+    }
+    auto start = std::chrono::steady_clock::now();
+    Macro best = search_.search(state);
+    timeManager_->spend(iterations ? search_.lastIterations() : elapsedMs(start));
+    return best;
+}
+
+Macro MacroMCTSPolicy::cheapSearch(const GameState& state) {
+    search_.setBudget(baseConfig_.timeBudgetMs,
+                      std::min(baseConfig_.cheapSearchIterations, baseConfig_.maxIterations));
+    Macro best = search_.search(state);
+    search_.setBudget(baseConfig_.timeBudgetMs, baseConfig_.maxIterations);
+    return best;
+}
+
+void MacroMCTSPolicy::setLogDecisions(bool log, int topK, bool logBoards, bool logMirrored) {
     logDecisions_ = log;
     topK_ = topK;
+    logBoards_ = logBoards;
+    logMirrored_ = logMirrored;
 }
 
 Action MacroMCTSPolicy::operator()(const GameState& state) {
+    stopPondering();
+
     // Check if current plan still valid
     if (planIndex_ < static_cast<int>(currentPlan_.size())) {
         const Action& planned = currentPlan_[planIndex_];
 
         // Validate: is this action still available?
-        std::vector<Action> available;
-        getAvailableActions(state, available);
-        for (auto& a : available) {
-            if (a.type == planned.type && a.playerId == planned.playerId &&
-                a.targetId == planned.targetId && a.target == planned.target) {
-                planIndex_++;
-                return planned;
-            }
+        if (isActionLegal(state, planned)) {
+            planIndex_++;
+            return planned;
         }
         // Plan invalidated — search again
         currentPlan_.clear();
         planIndex_ = 0;
     }
 
-    // Search for best macro
-    Macro bestMacro = search_.search(state);
+    // Search for best macro, from the pondered tree if it reached this position
+    bool full = drawFullSearch(baseConfig_, capDice_);
+    Macro bestMacro = full ? budgetedSearch(state) : cheapSearch(state);
+    DecisionSearchScope::report(full ? DecisionSearch::FULL : DecisionSearch::CHEAP);
+    ++searches_;
+    searchIterations_ += search_.lastIterations();
+    if (pondered_) {
+        if (search_.lastReusedVisits() > 0) ++ponderHits_;
+        pondered_ = false;
+        search_.setPonderReuse(false);
+    }
 
     // Log decision if enabled
-    if (logDecisions_) {
+    if (logDecisions_ && full) {
         const auto& childVisits = search_.lastChildVisits();
-        if (!childVisits.empty()) {
-            PolicyDecision decision;
-            extractFeatures(state, state.activeTeam, decision.stateFeatures);
-            decision.perspective = state.activeTeam;
-            decision.board = captureBoardSnapshot(state);
-
-            int totalVisits = 0;
-            for (auto& cv : childVisits) totalVisits += cv.visits;
-
-            if (totalVisits > 0) {
-                std::vector<MacroChildVisitInfo> sorted = childVisits;
-                std::sort(sorted.begin(), sorted.end(),
-                          [](const MacroChildVisitInfo& a, const MacroChildVisitInfo& b) {
-                              return a.visits > b.visits;
-                          });
-
-                int k = std::min(topK_, static_cast<int>(sorted.size()));
+        int totalVisits = 0;
+        for (auto& cv : childVisits) totalVisits += cv.visits;
+
+        if (totalVisits > 0) {
+            std::vector<MacroChildVisitInfo> sorted = childVisits;
+            std::sort(sorted.begin(), sorted.end(),
+                      [](const MacroChildVisitInfo& a, const MacroChildVisitInfo& b) {
+                          return a.target > b.target;
+                      });
+            int k = std::min(topK_, static_cast<int>(sorted.size()));
+
+            // The decision as seen in `s`, `state` under `sym`
+            auto record = [&](const GameState& s, Symmetry sym) {
+                PolicyDecision decision;
+                extractFeatures(s, s.activeTeam, decision.stateFeatures);
+                decision.perspective = s.activeTeam;
+                if (logBoards_) decision.board = captureCompactBoardSnapshot(s);
+                decision.stateHash = s.hash();
+                decision.canonicalHash = canonicalHash(s);
+                decision.totalVisits = totalVisits;
+                decision.search = search_.lastStats();
+                decision.mirrored = sym.flipY;
+                std::vector<Macro> logged(k);
+                std::vector<float> features(k * NUM_ACTION_FEATURES);
+                for (int i = 0; i < k; ++i) logged[i] = sym.apply(sorted[i].macro);
+                extractMacroFeatures(s, logged.data(), k, features.data());
                 for (int i = 0; i < k; ++i) {
                     PolicyDecision::ActionVisit av;
-                    extractMacroFeatures(state, sorted[i].macro, av.actionFeatures);
-                    av.visitFraction = static_cast<float>(sorted[i].visits) / totalVisits;
+                    std::copy_n(&features[i * NUM_ACTION_FEATURES], NUM_ACTION_FEATURES, av.actionFeatures);
+                    av.visitFraction = sorted[i].target;
                     decision.visits.push_back(av);
                 }
                 decisions_.push_back(std::move(decision));
-            }
+            };
+            record(state, Symmetry{});
+            if (logMirrored_) record(transformed(state, Symmetry{true}), Symmetry{true});
         }
     }
 
@@ -879,15 +2077,10 @@ Action MacroMCTSPolicy::operator()(const GameState& state) {
     }
 
     // Validate first action
-    std::vector<Action> available;
-    getAvailableActions(state, available);
     const Action& first = currentPlan_[0];
-    for (auto& a : available) {
-        if (a.type == first.type && a.playerId == first.playerId &&
-            a.targetId == first.targetId && a.target == first.target) {
-            planIndex_ = 1;
-            return first;
-        }
+    if (isActionLegal(state, first)) {
+        planIndex_ = 1;
+        return first;
     }
 
     // First action invalid — just pick something safe
@@ -0,0 +1,89 @@
+#include "bb/macro_search_handle.h"
+#include <algorithm>
+
+namespace bb {
+
+namespace {
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // anonymous namespace
+
+std::unique_ptr<MacroSearchHandle> MacroMCTSSearch::searchAsync(const GameState& state, int timeBudgetMs,
+                                                                int maxIterations) {
+    return std::make_unique<MacroSearchHandle>(*this, state, timeBudgetMs, maxIterations);
+}
+
+MacroSearchHandle::MacroSearchHandle(MacroMCTSSearch& search, const GameState& state,
+                                     int timeBudgetMs, int maxIterations)
+    : search_(search), state_(state.clone()), start_(std::chrono::steady_clock::now()) {
+    search_.setBudget(timeBudgetMs, maxIterations);
+    search_.setProgress([this](int iterations) { return report(iterations); });
+    thread_ = std::thread([this] {
+        Macro best = search_.search(state_);
+        search_.setProgress(nullptr);
+        std::lock_guard<std::mutex> lock(mutex_);
+        result_ = best;
+        progress_.iterations = search_.lastIterations();
+        progress_.elapsedMs = msSince(start_);
+        progress_.done = true;
+        progress_.hasBest = true;
+        progress_.best = best;
+        progress_.bestValue = search_.lastBestValue();
+        progress_.visits = search_.lastChildVisits();
+        done_ = true;
+    });
+}
+
+MacroSearchHandle::~MacroSearchHandle() {
+    cancel();
+    if (thread_.joinable()) thread_.join();
+}
+
+bool MacroSearchHandle::report(int iterations) {
+    int ms = extraMs_.exchange(0);
+    int its = extraIterations_.exchange(0);
+    if (ms != 0 || its != 0) {
+        const MCTSConfig& c = search_.config();
+        search_.setBudget(c.timeBudgetMs > 0 ? c.timeBudgetMs + ms : c.timeBudgetMs, c.maxIterations + its);
+    }
+
+    std::vector<MacroChildVisitInfo> visits;
+    search_.rootVisits(visits);
+    std::lock_guard<std::mutex> lock(mutex_);
+    progress_.iterations = iterations;
+    progress_.elapsedMs = msSince(start_);
+    progress_.visits = std::move(visits);
+    auto best = std::max_element(progress_.visits.begin(), progress_.visits.end(),
+                                 [](const MacroChildVisitInfo& a, const MacroChildVisitInfo& b) {
+                                     return a.visits < b.visits;
+                                 });
+    if (best != progress_.visits.end()) {
+        progress_.hasBest = true;
+        progress_.best = best->macro;
+        progress_.bestValue = best->value;
+    }
+    return !cancelled_.load();
+}
+
+MacroSearchHandle::Progress MacroSearchHandle::poll() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Progress p = progress_;
+    if (!p.done) p.elapsedMs = msSince(start_);
+    return p;
+}
+
+void MacroSearchHandle::extend(int extraMs, int extraIterations) {
+    extraMs_ += extraMs;
+    extraIterations_ += extraIterations;
+}
+
+Macro MacroSearchHandle::wait() {
+    if (thread_.joinable()) thread_.join();
+    std::lock_guard<std::mutex> lock(mutex_);
+    return result_;
+}
+
+} // namespace bb
@@ -0,0 +1,39 @@
+#include "bb/matchup_features.h"
+
+namespace bb {
+
+namespace {
+
+uint32_t rosterHotSkills(const TeamRoster& roster) {
+    uint32_t hot = 0;
+    for (int i = 0; i < roster.positionalCount; ++i) hot |= hotSkillMask(roster.positionals[i].skills);
+    return hot;
+}
+
+} // anonymous namespace
+
+MatchupFeatures teamFeatures(uint32_t hot) {
+    auto has = [hot](SkillName s) { return (hot & hotSkillBit(s)) != 0; };
+    MatchupFeatures f = 0;
+    if (has(SkillName::BallAndChain)) f |= feature::BALL_AND_CHAIN;
+    if (has(SkillName::ThrowTeamMate) && has(SkillName::RightStuff)) f |= feature::THROW_TEAM_MATE;
+    if (has(SkillName::Bombardier)) f |= feature::BOMBARDIER;
+    if (has(SkillName::HypnoticGaze)) f |= feature::HYPNOTIC_GAZE;
+    if (has(SkillName::MultipleBlock)) f |= feature::MULTIPLE_BLOCK;
+    if (has(SkillName::BoneHead) || has(SkillName::ReallyStupid) || has(SkillName::WildAnimal) ||
+        has(SkillName::TakeRoot) || has(SkillName::Bloodlust)) {
+        f |= feature::BIG_GUY;
+    }
+    return f;
+}
+
+MatchupFeatures matchupFeatures(const GameState& state) {
+    return teamFeatures(state.teamHotSkills(TeamSide::HOME)) |
+           teamFeatures(state.teamHotSkills(TeamSide::AWAY));
+}
+
+MatchupFeatures matchupFeatures(const TeamRoster& home, const TeamRoster& away) {
+    return teamFeatures(rosterHotSkills(home)) | teamFeatures(rosterHotSkills(away));
+}
+
+} // namespace bb
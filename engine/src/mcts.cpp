@@ -1,14 +1,53 @@
 #include "bb/mcts.h"
+#include "bb/alloc_tracking.h"
 #include "bb/action_resolver.h"
 #include "bb/action_features.h"
 #include "bb/helpers.h"
+#include "bb/profile.h"
 #include <chrono>
 #include <cmath>
 #include <algorithm>
 #include <limits>
+#include <thread>
+#include <utility>
 
 namespace bb {
 
+// Sums, except depth: the deepest leaf wins and the mean is weighted by
+// iterations. totalMs and iterationsPerSec are left to the caller, which
+// knows the wall time the merged searches shared.
+void SearchStats::merge(const SearchStats& o) {
+    int n = iterations + o.iterations;
+    if (n > 0) avgDepth = (avgDepth * iterations + o.avgDepth * o.iterations) / n;
+    iterations = n;
+    selectMs += o.selectMs;
+    replayMs += o.replayMs;
+    expandMs += o.expandMs;
+    simulateMs += o.simulateMs;
+    backpropMs += o.backpropMs;
+    nodesAllocated += o.nodesAllocated;
+    maxDepth = std::max(maxDepth, o.maxDepth);
+    truncatedReplays += o.truncatedReplays;
+    leafEvals += o.leafEvals;
+    cachedReplays += o.cachedReplays;
+    lookaheadReuses += o.lookaheadReuses;
+    priorCacheHits += o.priorCacheHits;
+    priorCacheMisses += o.priorCacheMisses;
+    recycleSweeps += o.recycleSweeps;
+    recycledNodes += o.recycledNodes;
+    expansionsSkipped += o.expansionsSkipped;
+    stoppedEarly = stoppedEarly || o.stoppedEarly;
+    allocations += o.allocations;
+    allocatedBytes += o.allocatedBytes;
+    peakLiveBytes = std::max(peakLiveBytes, o.peakLiveBytes);
+}
+
+void SearchStats::addAllocations(const AllocCounters& delta) {
+    allocations += delta.allocations;
+    allocatedBytes += delta.bytes;
+    peakLiveBytes = std::max(peakLiveBytes, allocPeakBytes());
+}
+
 // --- MCTSNode ---
 
 double MCTSNode::ucb(double parentLogN, double C) const {
@@ -25,25 +64,27 @@ double MCTSNode::puct(double parentVisits, double C) const {
     return q + u;
 }
 
-MCTSNode* MCTSNode::bestChild(double C) const {
-    if (children.empty()) return nullptr;
+uint32_t MCTSNode::bestChild(const MCTSArena& arena, double C) const {
+    if (numChildren == 0) return MCTSArena::NONE;
     double parentLogN = std::log(static_cast<double>(visits));
 
-    MCTSNode* best = nullptr;
+    uint32_t best = MCTSArena::NONE;
     double bestUCB = -std::numeric_limits<double>::max();
-    for (auto& child : const_cast<std::vector<MCTSNode>&>(children)) {
-        double u = child.ucb(parentLogN, C);
+    auto children = arena.children(*this);
+    for (uint32_t i = 0; i < children.size(); ++i) {
+        double u = children[i].ucb(parentLogN, C);
         if (u > bestUCB) {
             bestUCB = u;
-            best = &child;
+            best = firstChild + i;
         }
     }
     return best;
 }
 
-MCTSNode* MCTSNode::bestChildPUCT(double C) const {
-    if (children.empty()) return nullptr;
+uint32_t MCTSNode::bestChildPUCT(const MCTSArena& arena, double C, uint32_t width) const {
+    if (numChildren == 0) return MCTSArena::NONE;
     double parentVisits = static_cast<double>(visits);
+    auto children = arena.children(*this).first(std::min(width, numChildren));
 
     // Compute FPU (First Play Urgency): average Q of visited children
     // Unvisited children use this instead of Q=0
@@ -57,28 +98,51 @@ MCTSNode* MCTSNode::bestChildPUCT(double C) const {
     }
     double fpu = (visitedCount > 0) ? visitedSum / visitedCount : 0.0;
 
-    MCTSNode* best = nullptr;
+    uint32_t best = MCTSArena::NONE;
     double bestScore = -std::numeric_limits<double>::max();
-    for (auto& child : const_cast<std::vector<MCTSNode>&>(children)) {
+    for (uint32_t i = 0; i < children.size(); ++i) {
+        const MCTSNode& child = children[i];
         double q = (child.visits == 0) ? fpu : child.totalValue / child.visits;
         double u = C * child.prior * std::sqrt(parentVisits) / (1.0 + child.visits);
         double score = q + u;
         if (score > bestScore) {
             bestScore = score;
-            best = &child;
+            best = firstChild + i;
         }
     }
     return best;
 }
 
-MCTSNode* MCTSNode::mostVisitedChild() const {
-    if (children.empty()) return nullptr;
-    MCTSNode* best = nullptr;
+uint32_t MCTSNode::mostVisitedChild(const MCTSArena& arena) const {
+    if (numChildren == 0) return MCTSArena::NONE;
+    uint32_t best = MCTSArena::NONE;
     int bestVisits = -1;
-    for (auto& child : const_cast<std::vector<MCTSNode>&>(children)) {
-        if (child.visits > bestVisits) {
-            bestVisits = child.visits;
-            best = &child;
+    auto children = arena.children(*this);
+    for (uint32_t i = 0; i < children.size(); ++i) {
+        if (children[i].visits > bestVisits) {
+            bestVisits = children[i].visits;
+            best = firstChild + i;
+        }
+    }
+    return best;
+}
+
+bool MCTSNode::isChanceParent(const MCTSArena& arena) const {
+    return numChildren > 0 && arena[firstChild].chance > 0.0f;
+}
+
+uint32_t MCTSNode::chanceChild(const MCTSArena& arena) const {
+    if (numChildren == 0) return MCTSArena::NONE;
+    // Deficit against the probability-proportional allocation: outcomes get
+    // visited in step with their chances instead of as the dice fall
+    uint32_t best = MCTSArena::NONE;
+    double bestDeficit = -std::numeric_limits<double>::max();
+    auto children = arena.children(*this);
+    for (uint32_t i = 0; i < children.size(); ++i) {
+        double deficit = children[i].chance * (visits + 1.0) - children[i].visits;
+        if (deficit > bestDeficit) {
+            bestDeficit = deficit;
+            best = firstChild + i;
         }
     }
     return best;
@@ -87,37 +151,83 @@ MCTSNode* MCTSNode::mostVisitedChild() const {
 // --- MCTSSearch ---
 
 MCTSSearch::MCTSSearch(const ValueFunction* vf, MCTSConfig config, uint32_t seed)
-    : valueFn_(vf), config_(config), dice_(seed) {}
+    : valueFn_(vf), config_(config), dice_(seed) {
+    if (config_.rootParallel > 1) {
+        // Tree 0 keeps `seed`, so it plays out exactly like a single search.
+        MCTSConfig member = config_;
+        member.rootParallel = 1;
+        ensemble_.reserve(config_.rootParallel);
+        for (int i = 0; i < config_.rootParallel; ++i) {
+            ensemble_.emplace_back(vf, member, seed + 7919u * static_cast<uint32_t>(i));
+            ensemble_.back().traceTid_ = i + 1;
+        }
+    }
+}
+
+void MCTSSearch::setBudget(int timeBudgetMs, int maxIterations) {
+    config_.timeBudgetMs = timeBudgetMs;
+    config_.maxIterations = maxIterations;
+    for (MCTSSearch& tree : ensemble_) tree.setBudget(timeBudgetMs, maxIterations);
+}
 
 Action MCTSSearch::search(const GameState& state) {
+    if (!ensemble_.empty()) return searchEnsemble(state);
+    TraceSpan searchSpan(config_.trace, "MCTSSearch::search", "search", traceTid_);
+
+    lastStats_ = {};
+    searchRoot_ = MCTSArena::NONE;
+    AllocCounters allocStart = threadAllocCounters();
+    SearchTimer total;
+    SearchTimer timer;
+
     // Get available actions
     std::vector<Action> actions;
-    getAvailableActions(state, actions);
+    getActions(state, actions);
 
     if (actions.empty()) {
+        reuseRoot_ = MCTSArena::NONE;
+        lastReusedVisits_ = 0;
         return Action{ActionType::END_TURN, -1, -1, {-1, -1}};
     }
     if (actions.size() == 1) {
+        reuseRoot_ = MCTSArena::NONE;
+        lastReusedVisits_ = 0;
         lastIterations_ = 0;
         lastBestValue_ = 0.0;
         lastChildVisits_.clear();
         return actions[0];
     }
 
-    // Create root
-    MCTSNode root;
-    root.visits = 1;  // Virtual visit so PUCT exploration term is non-zero
-    root.expanded = false;
-
-    // Expand root immediately
-    expand(&root, state);
+    // Re-root at the last search's chosen child if this is its position;
+    // otherwise start a fresh tree
+    uint32_t root = reuseSubtree(state);
+    if (root == MCTSArena::NONE) {
+        arena_.reset();
+        outcomes_.clear();
+        root = arena_.allocate(1);
+        arena_[root].visits = 1;  // Virtual visit so PUCT exploration term is non-zero
+
+        // Expand root immediately
+        expand(root, state);
+        lastStats_.nodesAllocated += 1 + static_cast<int>(arena_[root].numChildren);
+    }
+    SearchStats& stats = lastStats_;
+    stats.expandMs += timer.lap();
+    double depthSum = 0.0;
 
     TeamSide searchingSide = state.activeTeam;
+    searchRoot_ = root;
+    searchSide_ = searchingSide;
 
     auto startTime = std::chrono::steady_clock::now();
     int iterations = 0;
+    GameState sim = state.clone();
+    journal_.clear();
 
     while (iterations < config_.maxIterations) {
+        iterTrace_ = (config_.trace && config_.trace->sampled(iterations)) ? config_.trace : nullptr;
+        TraceSpan iterSpan(iterTrace_, "iteration", "search", traceTid_);
+
         // Check time every 64 iterations
         if ((iterations & 63) == 0 && iterations > 0) {
             auto now = std::chrono::steady_clock::now();
@@ -127,46 +237,81 @@ Action MCTSSearch::search(const GameState& state) {
         }
 
         // 1. Select
-        MCTSNode* node = select(&root);
-
-        // 2. Expand (if not terminal)
-        GameState sim = state.clone();
-        if (!replayToNode(sim, node)) {
+        uint32_t node = select(root);
+        stats.selectMs += timer.lap(iterTrace_, "select", traceTid_);
+
+        // 2. Expand (if not terminal). `sim` walks down the path and is
+        //    rolled back to the root through the journal afterwards.
+        bool reached = replayToNode(sim, node);
+        int depth = static_cast<int>(path_.size());
+        stats.replayMs += timer.lap(iterTrace_, "replay", traceTid_);
+        stats.maxDepth = std::max(stats.maxDepth, depth);
+        depthSum += depth;
+        if (!reached) {
+            stats.truncatedReplays++;
+            journal_.undoTo(sim, 0);
+            stats.replayMs += timer.lap(iterTrace_, "replay", traceTid_);
             iterations++;
             continue;
         }
 
-        if (!node->expanded && node->visits > 0) {
-            expand(node, sim);
-            if (!node->children.empty()) {
-                // Pick first unvisited child
-                node = &node->children[0];
-                executeAction(sim, node->action, dice_, nullptr);
+        if (!arena_[node].expanded && arena_[node].visits > 0) {
+            if (config_.chanceNodes && arena_[node].chance == 0.0f && expandChance(node, sim)) {
+                // `sim` is back before the action: play one of its outcomes
+                stats.nodesAllocated += static_cast<int>(arena_[node].numChildren);
+                node = arena_[node].chanceChild(arena_);
+                playNode(sim, node);
+                stats.maxDepth = std::max(stats.maxDepth, depth + 1);
+                depthSum += 1;
+            } else {
+                expand(node, sim);
+                stats.nodesAllocated += static_cast<int>(arena_[node].numChildren);
+                if (arena_[node].numChildren > 0) {
+                    // Pick first unvisited child
+                    node = arena_[node].firstChild;
+                    playNode(sim, node);
+                    stats.maxDepth = std::max(stats.maxDepth, depth + 1);
+                    depthSum += 1;
+                }
             }
+            stats.expandMs += timer.lap(iterTrace_, "expand", traceTid_);
         }
 
         // 3. Simulate (evaluate)
         double value = simulate(sim, searchingSide);
+        stats.leafEvals++;
+        stats.simulateMs += timer.lap(iterTrace_, "simulate", traceTid_);
+        journal_.undoTo(sim, 0);
+        stats.replayMs += timer.lap(iterTrace_, "replay", traceTid_);
 
         // 4. Backpropagate
         backpropagate(node, value, searchingSide, state);
+        stats.backpropMs += timer.lap(iterTrace_, "backprop", traceTid_);
 
         iterations++;
     }
 
+    iterTrace_ = nullptr;
+    stats.iterations = iterations;
+    if (iterations > 0) stats.avgDepth = depthSum / iterations;
+    if (searchSpan.active()) searchSpan.args = "\"iterations\":" + std::to_string(iterations);
+    stats.totalMs = total.lap();
+    if (stats.totalMs > 0.0) stats.iterationsPerSec = iterations * 1000.0 / stats.totalMs;
+    stats.addAllocations(threadAllocCounters().since(allocStart));
 
     lastIterations_ = iterations;
 
     // Save child visit info before tree is destroyed
     lastChildVisits_.clear();
-    for (auto& child : root.children) {
+    for (auto& child : arena_.children(arena_[root])) {
         if (child.visits > 0) {
-            lastChildVisits_.push_back({child.action, child.visits});
+            lastChildVisits_.push_back({child.action, child.visits, child.totalValue});
         }
     }
 
     // Return most-visited child's action
-    MCTSNode* best = root.mostVisitedChild();
+    reuseRoot_ = arena_[root].mostVisitedChild(arena_);
+    const MCTSNode* best = arena_.get(reuseRoot_);
     if (best) {
         lastBestValue_ = best->visits > 0
             ? best->totalValue / best->visits : 0.0;
@@ -176,30 +321,220 @@ Action MCTSSearch::search(const GameState& state) {
     return actions[0];
 }
 
-MCTSNode* MCTSSearch::select(MCTSNode* root) {
-    MCTSNode* node = root;
-    while (node->expanded && !node->children.empty()) {
-        MCTSNode* child = config_.policy
-            ? node->bestChildPUCT(config_.explorationC)
-            : node->bestChild(config_.explorationC);
-        if (!child) break;
+SearchTree MCTSSearch::exportTree(int minVisits) const {
+    if (!ensemble_.empty()) return ensemble_[0].exportTree(minVisits);
+    SearchTree tree;
+    tree.searchingSide = searchSide_;
+    tree.minVisits = minVisits;
+    auto teamOf = [](int playerId) { return static_cast<uint8_t>(playerId <= 11 ? TeamSide::HOME : TeamSide::AWAY); };
+    flattenTree(arena_, searchRoot_, minVisits, tree.nodes,
+                [&](const MCTSNode& n, const MCTSNode* parent, SearchTreeRecord& r) {
+        r.kind = static_cast<uint8_t>(n.action.type);
+        r.playerId = static_cast<int8_t>(n.action.playerId);
+        r.targetId = static_cast<int8_t>(n.action.targetId);
+        r.targetX = n.action.target.x;
+        r.targetY = n.action.target.y;
+        r.chance = n.chance;
+        if (!parent) {
+            r.actingTeam = static_cast<uint8_t>(searchSide_);
+            return;
+        }
+        // Actions do not record their team; an action is its player's, and
+        // siblings (alternatives in one position) share theirs
+        r.actingTeam = SearchTreeRecord::TEAM_UNKNOWN;
+        if (n.action.playerId > 0) {
+            r.actingTeam = teamOf(n.action.playerId);
+            return;
+        }
+        for (const MCTSNode& sibling : arena_.children(*parent)) {
+            if (sibling.action.playerId > 0) {
+                r.actingTeam = teamOf(sibling.action.playerId);
+                break;
+            }
+        }
+    });
+    return tree;
+}
+
+// Root parallelism: every tree searches the same position on its own thread
+// with its own dice, sharing nothing, and the move is picked from the summed
+// root visit counts. Each tree still reuses its own subtree between moves.
+Action MCTSSearch::searchEnsemble(const GameState& state) {
+    TraceSpan searchSpan(config_.trace, "MCTSSearch::searchEnsemble");
+    SearchTimer total;
+    std::vector<Action> picks(ensemble_.size());
+    std::vector<std::thread> threads;
+    threads.reserve(ensemble_.size() - 1);
+    for (size_t i = 1; i < ensemble_.size(); ++i) {
+        threads.emplace_back([&, i] { picks[i] = ensemble_[i].search(state); });
+    }
+    picks[0] = ensemble_[0].search(state);
+    for (auto& t : threads) t.join();
+
+    auto sameAction = [](const Action& a, const Action& b) {
+        return a.type == b.type && a.playerId == b.playerId &&
+               a.targetId == b.targetId && a.target == b.target;
+    };
+
+    lastIterations_ = 0;
+    lastReusedVisits_ = 0;
+    lastChildVisits_.clear();
+    lastStats_ = {};
+    for (const MCTSSearch& tree : ensemble_) {
+        lastStats_.merge(tree.lastStats_);
+        lastIterations_ += tree.lastIterations_;
+        lastReusedVisits_ += tree.lastReusedVisits_;
+        for (const ChildVisitInfo& cv : tree.lastChildVisits_) {
+            auto it = std::find_if(lastChildVisits_.begin(), lastChildVisits_.end(),
+                                   [&](const ChildVisitInfo& m) { return sameAction(m.action, cv.action); });
+            if (it == lastChildVisits_.end()) {
+                lastChildVisits_.push_back(cv);
+            } else {
+                it->visits += cv.visits;
+                it->totalValue += cv.totalValue;
+            }
+        }
+    }
+
+    // No statistics (a forced or empty move): every tree returned the same.
+    if (lastChildVisits_.empty()) {
+        lastBestValue_ = 0.0;
+        lastStats_ = {};
+        return picks[0];
+    }
+    lastStats_.totalMs = total.lap();
+    if (lastStats_.totalMs > 0.0) {
+        lastStats_.iterationsPerSec = lastStats_.iterations * 1000.0 / lastStats_.totalMs;
+    }
+    auto best = std::max_element(lastChildVisits_.begin(), lastChildVisits_.end(),
+                                 [](const ChildVisitInfo& a, const ChildVisitInfo& b) {
+                                     return a.visits < b.visits;
+                                 });
+    lastBestValue_ = best->totalValue / best->visits;
+    return best->action;
+}
+
+uint32_t MCTSSearch::reuseSubtree(const GameState& state) {
+    lastReusedVisits_ = 0;
+    uint32_t keep = reuseRoot_;
+    reuseRoot_ = MCTSArena::NONE;
+    if (!config_.reuseTree || keep == MCTSArena::NONE) return MCTSArena::NONE;
+    // Open-loop: the child's state depends on the dice, so only reuse when
+    // the observed state hashes to the one its children were built from.
+    const MCTSNode& kept = arena_[keep];
+    if (!kept.expanded || kept.numChildren == 0 || kept.expandedHash != state.hash()) {
+        return MCTSArena::NONE;
+    }
+
+    double decay = config_.reuseDecay;
+    uint32_t root = copySubtree(arena_, keep, spare_, [decay](MCTSNode& n) {
+        int v = static_cast<int>(n.visits * decay);
+        n.totalValue = n.visits > 0 ? n.totalValue * v / n.visits : 0.0;
+        n.visits = v;
+    });
+    std::swap(arena_, spare_);
+    arena_[root].visits = std::max(arena_[root].visits, 1);
+    lastReusedVisits_ = arena_[root].visits;
+    return root;
+}
+
+uint32_t MCTSSearch::openChildren(const MCTSNode& n) const {
+    if (config_.wideningExponent <= 0.0f) return n.numChildren;
+    double open = std::ceil(2.0 * std::pow(std::max(n.visits, 1), config_.wideningExponent));
+    return static_cast<uint32_t>(std::min<double>(open, n.numChildren));
+}
+
+uint32_t MCTSSearch::select(uint32_t root) {
+    uint32_t node = root;
+    while (arena_[node].expanded && arena_[node].numChildren > 0) {
+        const MCTSNode& n = arena_[node];
+        uint32_t child = n.isChanceParent(arena_) ? n.chanceChild(arena_)
+                       : config_.policy ? n.bestChildPUCT(arena_, config_.explorationC, openChildren(n))
+                       : n.bestChild(arena_, config_.explorationC);
+        if (child == MCTSArena::NONE) break;
         node = child;
     }
     return node;
 }
 
-void MCTSSearch::expand(MCTSNode* node, const GameState& state) {
+void MCTSSearch::getActions(const GameState& state, std::vector<Action>& out) const {
+    if (config_.pathMoves) getAvailableActionsWithPaths(state, out);
+    else if (const ActionList* listed = PublishedActions::find(state)) out.assign(listed->begin(), listed->end());
+    else getAvailableActions(state, out);
+}
+
+// MCTSConfig::prefilterChildren's first-stage score: a few comparisons per
+// action, no features. Contact and ball play first, then moves that close
+// on the mover's goal (the endzone with the ball, else the ball) and do
+// not leave a tacklezone.
+static float prefilterScore(const GameState& state, const Action& a) {
+    switch (a.type) {
+        case ActionType::BLOCK:
+        case ActionType::BLITZ:
+        case ActionType::MULTIPLE_BLOCK:
+            return 3.0f;
+        case ActionType::PASS:
+        case ActionType::HAND_OFF:
+        case ActionType::THROW_TEAM_MATE:
+        case ActionType::BOMB_THROW:
+        case ActionType::HYPNOTIC_GAZE:
+        case ActionType::BALL_AND_CHAIN:
+            return 2.0f;
+        case ActionType::FOUL:
+            return 1.0f;
+        case ActionType::END_TURN:
+            return 0.5f;
+        case ActionType::MOVE:
+        case ActionType::MOVE_PATH:
+            break;
+        default:
+            return 1.0f;
+    }
+    const Player& p = state.getPlayer(a.playerId);
+    if (a.target == p.position) return 1.5f;  // stand up
+    auto goalDistance = [&](Position from) {
+        if (state.ball.isHeld && state.ball.carrierId == p.id) {
+            return p.teamSide == TeamSide::HOME ? 25 - from.x : static_cast<int>(from.x);
+        }
+        return state.ball.isOnPitch() ? from.distanceTo(state.ball.position) : 0;
+    };
+    float score = 1.0f + 0.25f * static_cast<float>(goalDistance(p.position) - goalDistance(a.target));
+    if (state.tacklezoneCount(opponent(p.teamSide), p.position) > 0) score -= 0.5f;  // dodge
+    return score;
+}
+
+void MCTSSearch::expand(uint32_t node, const GameState& state) {
+    BB_ALLOC_SCOPE(alloc::SEARCH_TREE);
+    if (config_.reuseTree) arena_[node].expandedHash = state.hash();
     if (state.phase == GamePhase::GAME_OVER ||
         state.phase == GamePhase::TOUCHDOWN ||
         state.phase == GamePhase::HALF_TIME) {
-        node->expanded = true;
+        arena_[node].expanded = true;
         return;
     }
 
     std::vector<Action> actions;
-    getAvailableActions(state, actions);
+    getActions(state, actions);
 
     int n = static_cast<int>(actions.size());
+    bool widen = config_.maxChildren > 0 && n > config_.maxChildren && config_.policy;
+
+    // First stage: a cheap heuristic keeps the best prefilterChildren, so
+    // features and the policy run only on those (ties keep legal-move order)
+    if (widen && config_.prefilterChildren > 0 &&
+        n > std::max(config_.prefilterChildren, config_.maxChildren)) {
+        int survivors = std::max(config_.prefilterChildren, config_.maxChildren);
+        std::vector<std::pair<float, int>> scored(n);
+        for (int i = 0; i < n; ++i) scored[i] = {-prefilterScore(state, actions[i]), i};
+        std::nth_element(scored.begin(), scored.begin() + survivors, scored.end());
+        scored.resize(survivors);
+        std::sort(scored.begin(), scored.end(),
+                  [](const auto& a, const auto& b) { return a.second < b.second; });
+        std::vector<Action> kept(survivors);
+        for (int i = 0; i < survivors; ++i) kept[i] = actions[scored[i].second];
+        actions.swap(kept);
+        n = survivors;
+    }
 
     // Compute priors from policy network first (needed for progressive widening)
     std::vector<float> priors(n, 1.0f / std::max(n, 1));  // default uniform
@@ -208,23 +543,23 @@ void MCTSSearch::expand(MCTSNode* node, const GameState& state) {
         extractFeatures(state, state.activeTeam, stateFeats);
 
         std::vector<float> actionFeats(n * NUM_ACTION_FEATURES);
-        for (int i = 0; i < n; ++i) {
-            extractActionFeatures(state, actions[i], &actionFeats[i * NUM_ACTION_FEATURES]);
-        }
+        extractActionFeatures(state, actions.data(), n, actionFeats.data());
         config_.policy->computePriors(stateFeats, actionFeats.data(), n, priors.data());
     }
 
-    // Progressive widening: sort by prior desc, keep top maxChildren
+    // Progressive widening: keep the top maxChildren by prior, in prior
+    // order (ties by legal-move order), so openChildren() can open them
+    // best first. The policy orders every node it has priors for.
     int keep = n;
     std::vector<int> indices(n);
     for (int i = 0; i < n; ++i) indices[i] = i;
+    auto byPrior = [&priors](int a, int b) {
+        return priors[a] > priors[b] || (priors[a] == priors[b] && a < b);
+    };
 
-    if (config_.maxChildren > 0 && n > config_.maxChildren && config_.policy) {
-        // Sort indices by prior descending
-        std::sort(indices.begin(), indices.end(), [&priors](int a, int b) {
-            return priors[a] > priors[b];
-        });
+    if (widen) {
         keep = config_.maxChildren;
+        std::partial_sort(indices.begin(), indices.begin() + keep, indices.end(), byPrior);
 
         // Renormalize priors for kept children
         float priorSum = 0.0f;
@@ -232,18 +567,23 @@ void MCTSSearch::expand(MCTSNode* node, const GameState& state) {
         if (priorSum > 0.0f) {
             for (int i = 0; i < keep; ++i) priors[indices[i]] /= priorSum;
         }
+    } else if (config_.policy && config_.wideningExponent > 0.0f) {
+        std::sort(indices.begin(), indices.end(), byPrior);
     }
 
-    node->children.reserve(keep);
-    for (int i = 0; i < keep; ++i) {
-        int idx = indices[i];
-        MCTSNode child;
-        child.action = actions[idx];
-        child.parent = node;
-        child.prior = priors[idx];
-        node->children.push_back(std::move(child));
+    if (keep > 0) {
+        uint32_t first = arena_.allocate(static_cast<uint32_t>(keep));
+        for (int i = 0; i < keep; ++i) {
+            int idx = indices[i];
+            MCTSNode& child = arena_[first + i];
+            child.action = actions[idx];
+            child.parent = node;
+            child.prior = priors[idx];
+        }
+        arena_[node].firstChild = first;
+        arena_[node].numChildren = static_cast<uint32_t>(keep);
     }
-    node->expanded = true;
+    arena_[node].expanded = true;
 }
 
 double MCTSSearch::simulate(const GameState& state, TeamSide perspective) {
@@ -253,9 +593,7 @@ double MCTSSearch::simulate(const GameState& state, TeamSide perspective) {
 
     // Pure value function evaluation
     if (valueFn_) {
-        float features[NUM_FEATURES];
-        extractFeatures(state, perspective, features);
-        double raw = static_cast<double>(valueFn_->evaluate(features, NUM_FEATURES));
+        double raw = static_cast<double>(valueFn_->evaluateState(state, perspective));
         // Normalize to [-1, 1] so Q values don't dominate PUCT exploration term
         return std::tanh(raw);
     }
@@ -273,37 +611,42 @@ double MCTSSearch::simulate(const GameState& state, TeamSide perspective) {
     return std::clamp(value, -1.0, 1.0);
 }
 
-void MCTSSearch::backpropagate(MCTSNode* node, double value,
+void MCTSSearch::backpropagate(uint32_t node, double value,
                                 TeamSide searchingSide,
                                 const GameState& rootState) {
     // Walk up to root, updating each node
     // Value is always from searchingSide's perspective
-    while (node) {
-        node->visits++;
-        node->totalValue += value;
-        node = node->parent;
+    for (MCTSNode* n = arena_.get(node); n; n = arena_.get(n->parent)) {
+        n->visits++;
+        n->totalValue += value;
+        if (n->isChanceParent(arena_)) {
+            // Expectation over the outcomes seen so far, not the visit mix
+            double q = 0.0, mass = 0.0;
+            for (const MCTSNode& c : arena_.children(*n)) {
+                if (c.visits == 0) continue;
+                q += c.chance * c.totalValue / c.visits;
+                mass += c.chance;
+            }
+            n->totalValue = n->visits * q / mass;
+        }
     }
 }
 
 double MCTSSearch::rollout(GameState state, TeamSide perspective, int depth) {
+    const RolloutPolicy& policy = config_.rolloutPolicy ? *config_.rolloutPolicy
+                                                        : defaultRolloutPolicy();
+    ResolutionScope resolution(dice_, config_.expectedResolution ? ResolutionMode::Expected
+                                                                 : dice_.resolutionMode());
+    Action action;
     for (int i = 0; i < depth; ++i) {
         if (state.phase != GamePhase::PLAY) break;
-
-        std::vector<Action> actions;
-        getAvailableActions(state, actions);
-        if (actions.empty()) break;
-
-        // Pick random action
-        int idx = (dice_.rollD6() - 1 + dice_.rollD6() - 1) % static_cast<int>(actions.size());
-        if (idx < 0) idx = 0;
-        executeAction(state, actions[idx], dice_, nullptr);
+        if (!policy.choose(state, dice_, rolloutActions_, action)) break;
+        executeAction(state, action, dice_, nullptr);
     }
 
     // Evaluate final state
     if (valueFn_) {
-        float features[NUM_FEATURES];
-        extractFeatures(state, perspective, features);
-        double raw = static_cast<double>(valueFn_->evaluate(features, NUM_FEATURES));
+        double raw = static_cast<double>(valueFn_->evaluateState(state, perspective));
         return std::tanh(raw);
     }
 
@@ -313,13 +656,14 @@ double MCTSSearch::rollout(GameState state, TeamSide perspective, int depth) {
     return std::clamp((my.score - opp.score) * 0.5, -1.0, 1.0);
 }
 
-bool MCTSSearch::replayToNode(GameState& state, MCTSNode* node) {
+bool MCTSSearch::replayToNode(GameState& state, uint32_t node) {
+    BB_PROFILE_NAMED_SCOPE(profile, prof::ACTION_REPLAY);
+
     // Build path from root to node
-    std::vector<MCTSNode*> path;
-    MCTSNode* cur = node;
-    while (cur->parent) {
+    std::vector<uint32_t>& path = path_;
+    path.clear();
+    for (uint32_t cur = node; arena_[cur].parent != MCTSArena::NONE; cur = arena_[cur].parent) {
         path.push_back(cur);
-        cur = cur->parent;
     }
 
     // Replay in reverse (root-to-leaf order)
@@ -330,9 +674,54 @@ bool MCTSSearch::replayToNode(GameState& state, MCTSNode* node) {
             state.phase == GamePhase::HALF_TIME) {
             return false;
         }
-        executeAction(state, path[i]->action, dice_, nullptr);
+        playNode(state, path[i]);
+        BB_PROFILE_UNITS(profile, 1);
+    }
+
+    return true;
+}
+
+void MCTSSearch::playNode(GameState& state, uint32_t node) {
+    const MCTSNode& n = arena_[node];
+    if (n.isChanceParent(arena_)) return;
+    TraceSpan span(iterTrace_, actionTypeName(n.action.type), "action", traceTid_);
+    lastPlayMark_ = journal_.mark();
+    if (n.chance > 0.0f) {
+        const ChanceOutcome& o = outcomes_[n.outcome];
+        OutcomeDiceRoller forced(o.script, o.length, dice_);
+        executeActionJournaled(state, n.action, forced, journal_);
+    } else {
+        executeActionJournaled(state, n.action, dice_, journal_);
     }
+}
 
+bool MCTSSearch::expandChance(uint32_t node, GameState& state) {
+    MCTSNode& parent = arena_[node];
+    ActionType type = parent.action.type;
+    if (type != ActionType::BLOCK && type != ActionType::BLITZ && type != ActionType::FOUL) {
+        return false;
+    }
+    journal_.undoTo(state, lastPlayMark_);
+    if (!enumerateChanceOutcomes(state, parent.action, dice_, outcomeScratch_) ||
+        outcomeScratch_.empty()) {
+        // Not enumerated: the action goes back to open-loop dice
+        executeActionJournaled(state, parent.action, dice_, journal_);
+        return false;
+    }
+
+    uint32_t count = static_cast<uint32_t>(outcomeScratch_.size());
+    uint32_t first = arena_.allocate(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        MCTSNode& child = arena_[first + i];
+        child.action = parent.action;
+        child.parent = node;
+        child.chance = outcomeScratch_[i].probability;
+        child.outcome = static_cast<uint32_t>(outcomes_.size());
+        outcomes_.push_back(outcomeScratch_[i]);
+    }
+    parent.firstChild = first;
+    parent.numChildren = count;
+    parent.expanded = true;
     return true;
 }
 
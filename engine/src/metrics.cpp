@@ -0,0 +1,212 @@
+#include "bb/metrics.h"
+#include "bb/profile.h"
+#include <sys/resource.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+namespace bb {
+
+namespace {
+
+// Seconds a decision took; iterations per search
+const std::vector<double> SECONDS_BUCKETS = {0.001, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2, 5, 10, 30};
+const std::vector<double> ITERATION_BUCKETS = {1, 10, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 50000, 100000};
+
+std::string number(double v) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.17g", v);
+    return buf;
+}
+
+// name{labels} or name{labels,extra}
+std::string series(const std::string& name, const std::string& labels, const std::string& extra = "") {
+    std::string all = labels;
+    if (!extra.empty()) all += (all.empty() ? "" : ",") + extra;
+    return all.empty() ? name : name + "{" + all + "}";
+}
+
+std::string escapeHelp(const std::string& help) {
+    std::string out;
+    for (char c : help) {
+        if (c == '\\') out += "\\\\";
+        else if (c == '\n') out += "\\n";
+        else out += c;
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+MetricHistogram::MetricHistogram(std::vector<double> bounds)
+    : bounds_(std::move(bounds)), counts_(new std::atomic<uint64_t>[bounds_.size() + 1]) {
+    if (!std::is_sorted(bounds_.begin(), bounds_.end())) {
+        throw std::invalid_argument("MetricHistogram: bucket bounds must ascend");
+    }
+    for (size_t i = 0; i <= bounds_.size(); ++i) counts_[i].store(0, std::memory_order_relaxed);
+}
+
+void MetricHistogram::observe(double v) {
+    size_t bucket = std::lower_bound(bounds_.begin(), bounds_.end(), v) - bounds_.begin();
+    counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(v, std::memory_order_relaxed);
+}
+
+std::vector<uint64_t> MetricHistogram::cumulativeCounts() const {
+    std::vector<uint64_t> out(bounds_.size() + 1);
+    uint64_t total = 0;
+    for (size_t i = 0; i <= bounds_.size(); ++i) {
+        total += counts_[i].load(std::memory_order_relaxed);
+        out[i] = total;
+    }
+    return out;
+}
+
+// --- MetricsRegistry ---
+
+MetricsRegistry::Family& MetricsRegistry::family(const std::string& name, const std::string& help, Kind kind) {
+    auto [it, fresh] = families_.try_emplace(name);
+    if (fresh) {
+        it->second.kind = kind;
+        it->second.help = help;
+        order_.push_back(name);
+    } else if (it->second.kind != kind) {
+        throw std::invalid_argument("MetricsRegistry: " + name + " is registered as another kind of metric");
+    }
+    return it->second;
+}
+
+MetricCounter& MetricsRegistry::counter(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& all = family(name, help, Kind::COUNTER).counters;
+    for (auto& [l, c] : all) {
+        if (l == labels) return *c;
+    }
+    all.emplace_back(labels, std::make_unique<MetricCounter>());
+    return *all.back().second;
+}
+
+MetricGauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& all = family(name, help, Kind::GAUGE).gauges;
+    for (auto& [l, g] : all) {
+        if (l == labels) return *g;
+    }
+    all.emplace_back(labels, std::make_unique<MetricGauge>());
+    return *all.back().second;
+}
+
+MetricHistogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                            const std::vector<double>& bounds, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& all = family(name, help, Kind::HISTOGRAM).histograms;
+    for (auto& [l, h] : all) {
+        if (l == labels) return *h;
+    }
+    all.emplace_back(labels, std::make_unique<MetricHistogram>(bounds));
+    return *all.back().second;
+}
+
+std::string MetricsRegistry::renderPrometheus() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string out;
+    for (const std::string& name : order_) {
+        const Family& f = families_.at(name);
+        const char* type = f.kind == Kind::COUNTER ? "counter" : f.kind == Kind::GAUGE ? "gauge" : "histogram";
+        out += "# HELP " + name + " " + escapeHelp(f.help) + "\n";
+        out += "# TYPE " + name + " " + type + "\n";
+        for (const auto& [labels, c] : f.counters) out += series(name, labels) + " " + number(c->value()) + "\n";
+        for (const auto& [labels, g] : f.gauges) out += series(name, labels) + " " + number(g->value()) + "\n";
+        for (const auto& [labels, h] : f.histograms) {
+            std::vector<uint64_t> counts = h->cumulativeCounts();
+            for (size_t i = 0; i < h->bounds().size(); ++i) {
+                out += series(name + "_bucket", labels, "le=\"" + number(h->bounds()[i]) + "\"") + " " +
+                       std::to_string(counts[i]) + "\n";
+            }
+            out += series(name + "_bucket", labels, "le=\"+Inf\"") + " " + std::to_string(counts.back()) + "\n";
+            out += series(name + "_sum", labels) + " " + number(h->sum()) + "\n";
+            out += series(name + "_count", labels) + " " + std::to_string(counts.back()) + "\n";
+        }
+    }
+    return out;
+}
+
+bool MetricsRegistry::writeTextFile(const std::string& path) const {
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp);
+        if (!out) return false;
+        out << renderPrometheus();
+        if (!out) return false;
+    }
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+std::string metricLabel(const std::string& label, const std::string& value) {
+    std::string out = label + "=\"";
+    for (char c : value) {
+        if (c == '\\') out += "\\\\";
+        else if (c == '"') out += "\\\"";
+        else if (c == '\n') out += "\\n";
+        else out += c;
+    }
+    return out + "\"";
+}
+
+void recordDecision(MetricsRegistry& metrics, const std::string& ai, double ms, const SearchStats* stats) {
+    const std::string labels = metricLabel("ai", ai);
+    metrics.counter("bb_decisions_total", "Decisions made", labels).inc();
+    if (!stats || stats->iterations == 0) return;
+    metrics.histogram("bb_search_seconds", "Wall time of a searched decision", SECONDS_BUCKETS, labels)
+        .observe(ms / 1000.0);
+    metrics.histogram("bb_search_iterations", "Iterations of a searched decision", ITERATION_BUCKETS, labels)
+        .observe(stats->iterations);
+    metrics.counter("bb_prior_cache_hits_total", "Expansions served by the prior cache", labels)
+        .inc(stats->priorCacheHits);
+    metrics.counter("bb_prior_cache_misses_total", "Expansions that missed the prior cache", labels)
+        .inc(stats->priorCacheMisses);
+    metrics.counter("bb_root_cache_hits_total", "Searches answered by the root cache", labels)
+        .inc(stats->rootCacheHit ? 1.0 : 0.0);
+    metrics.counter("bb_cached_replays_total", "Macros sampled from cached outcomes instead of replayed", labels)
+        .inc(stats->cachedReplays);
+    metrics.counter("bb_leaf_evals_total", "Leaf evaluations", labels).inc(stats->leafEvals);
+}
+
+bool MetricsFile::update(bool force) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = std::chrono::steady_clock::now();
+    if (!force && written_ && now - last_ < interval_) return true;
+    last_ = now;
+    written_ = true;
+    updateProcessMetrics(metrics_);
+    return metrics_.writeTextFile(path_);
+}
+
+void updateProcessMetrics(MetricsRegistry& metrics) {
+    // Linux: resident pages from /proc; elsewhere only the peak is known
+    std::ifstream statm("/proc/self/statm");
+    long pages = 0, resident = 0;
+    if (statm >> pages >> resident) {
+        metrics.gauge("process_resident_memory_bytes", "Resident memory size in bytes")
+            .set(static_cast<double>(resident) * static_cast<double>(sysconf(_SC_PAGESIZE)));
+    }
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        double peak = static_cast<double>(usage.ru_maxrss);  // bytes
+#else
+        double peak = static_cast<double>(usage.ru_maxrss) * 1024.0;  // kilobytes
+#endif
+        metrics.gauge("bb_peak_resident_memory_bytes", "Peak resident memory size in bytes").set(peak);
+    }
+    for (const ProfileEntry& e : profileSnapshot()) {
+        const std::string labels = metricLabel("slot", e.name);
+        metrics.gauge("bb_profile_calls", "Calls per profiled slot (BB_PROFILE builds)", labels)
+            .set(static_cast<double>(e.calls));
+        metrics.gauge("bb_profile_seconds", "Time per profiled slot (BB_PROFILE builds)", labels).set(e.seconds);
+    }
+}
+
+} // namespace bb
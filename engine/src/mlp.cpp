@@ -0,0 +1,188 @@
+#include "bb/mlp.h"
+#include "bb/profile.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace bb {
+
+namespace {
+
+// y[k] = bias[k] + dot(rows + k * N, x) for k < 4, N a compile-time width:
+// the loop over x unrolls completely and each x load feeds four rows.
+template<int N>
+void dot4(const float* rows, const float* x, const float* bias, float* y) {
+    static_assert(N % SIMD_FLOATS == 0);
+#if defined(__AVX2__)
+    __m256 acc[4] = {_mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps()};
+    for (int i = 0; i < N; i += 8) {
+        __m256 xv = _mm256_loadu_ps(x + i);
+        for (int k = 0; k < 4; ++k) {
+#if defined(__FMA__)
+            acc[k] = _mm256_fmadd_ps(_mm256_load_ps(rows + k * N + i), xv, acc[k]);
+#else
+            acc[k] = _mm256_add_ps(acc[k], _mm256_mul_ps(_mm256_load_ps(rows + k * N + i), xv));
+#endif
+        }
+    }
+    for (int k = 0; k < 4; ++k) {
+        __m128 lo = _mm_add_ps(_mm256_castps256_ps128(acc[k]), _mm256_extractf128_ps(acc[k], 1));
+        lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+        lo = _mm_add_ss(lo, _mm_shuffle_ps(lo, lo, 1));
+        y[k] = bias[k] + _mm_cvtss_f32(lo);
+    }
+#elif defined(__wasm_simd128__)
+    v128_t acc[4] = {wasm_f32x4_splat(0.0f), wasm_f32x4_splat(0.0f), wasm_f32x4_splat(0.0f), wasm_f32x4_splat(0.0f)};
+    for (int i = 0; i < N; i += 4) {
+        v128_t xv = wasm_v128_load(x + i);
+        for (int k = 0; k < 4; ++k) acc[k] = wasm_f32x4_add(acc[k], wasm_f32x4_mul(wasm_v128_load(rows + k * N + i), xv));
+    }
+    for (int k = 0; k < 4; ++k) {
+        y[k] = bias[k] + wasm_f32x4_extract_lane(acc[k], 0) + wasm_f32x4_extract_lane(acc[k], 1) +
+               wasm_f32x4_extract_lane(acc[k], 2) + wasm_f32x4_extract_lane(acc[k], 3);
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    __m128 acc[4] = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+    for (int i = 0; i < N; i += 4) {
+        __m128 xv = _mm_loadu_ps(x + i);
+        for (int k = 0; k < 4; ++k) acc[k] = _mm_add_ps(acc[k], _mm_mul_ps(_mm_load_ps(rows + k * N + i), xv));
+    }
+    for (int k = 0; k < 4; ++k) {
+        __m128 s = _mm_add_ps(acc[k], _mm_movehl_ps(acc[k], acc[k]));
+        s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+        y[k] = bias[k] + _mm_cvtss_f32(s);
+    }
+#elif defined(__ARM_NEON)
+    float32x4_t acc[4] = {vdupq_n_f32(0.0f), vdupq_n_f32(0.0f), vdupq_n_f32(0.0f), vdupq_n_f32(0.0f)};
+    for (int i = 0; i < N; i += 4) {
+        float32x4_t xv = vld1q_f32(x + i);
+        for (int k = 0; k < 4; ++k) acc[k] = vmlaq_f32(acc[k], vld1q_f32(rows + k * N + i), xv);
+    }
+    for (int k = 0; k < 4; ++k) {
+        float32x2_t half = vadd_f32(vget_low_f32(acc[k]), vget_high_f32(acc[k]));
+        y[k] = bias[k] + vget_lane_f32(vpadd_f32(half, half), 0);
+    }
+#else
+    for (int k = 0; k < 4; ++k) y[k] = bias[k] + dotProduct(rows + k * N, x, N);
+#endif
+}
+
+template<int N>
+void denseFixed(const float* rows, int, const float* bias, const float* x, float* y,
+                int, int outputs) {
+    int j = 0;
+    for (; j + 4 <= outputs; j += 4) dot4<N>(rows + static_cast<size_t>(j) * N, x, bias + j, y + j);
+    for (; j < outputs; ++j) y[j] = bias[j] + dotProduct(rows + static_cast<size_t>(j) * N, x, N);
+}
+
+void denseGeneric(const float* rows, int stride, const float* bias, const float* x, float* y,
+                  int inputs, int outputs) {
+    for (int j = 0; j < outputs; ++j) {
+        y[j] = bias[j] + dotProduct(rows + static_cast<size_t>(j) * stride, x, inputs);
+    }
+}
+
+Mlp::Kernel kernelFor(int inputs) {
+    switch (inputs) {
+        case 32: return denseFixed<32>;
+        case 64: return denseFixed<64>;
+        case 128: return denseFixed<128>;
+        case 256: return denseFixed<256>;
+        default: return denseGeneric;
+    }
+}
+
+} // anonymous namespace
+
+// --- Mlp ---
+
+Mlp::Mlp(std::vector<MlpLayer> layers, bool residual)
+    : layers_(std::move(layers)), residual_(residual) {
+    if (layers_.empty()) throw std::invalid_argument("Mlp: no layers");
+    for (size_t l = 0; l < layers_.size(); ++l) {
+        const MlpLayer& layer = layers_[l];
+        if (layer.inputs <= 0 || layer.outputs <= 0 ||
+            (l > 0 && layer.inputs != layers_[l - 1].outputs) ||
+            layer.weights.size() != static_cast<size_t>(layer.inputs) * layer.outputs ||
+            layer.bias.size() != static_cast<size_t>(layer.outputs)) {
+            throw std::invalid_argument("Mlp: layer shapes do not chain");
+        }
+        Packed p;
+        p.stride = simdPadded(layer.inputs);
+        p.rows.assign(static_cast<size_t>(layer.outputs) * p.stride, 0.0f);
+        for (int j = 0; j < layer.outputs; ++j) {
+            std::copy_n(&layer.weights[static_cast<size_t>(j) * layer.inputs], layer.inputs,
+                        &p.rows[static_cast<size_t>(j) * p.stride]);
+        }
+        p.kernel = kernelFor(layer.inputs);
+        bool hidden = l + 1 < layers_.size();
+        p.addInput = residual_ && hidden && layer.inputs == layer.outputs;
+        packed_.push_back(std::move(p));
+        maxWidth_ = std::max({maxWidth_, simdPadded(layer.inputs), simdPadded(layer.outputs)});
+    }
+}
+
+void Mlp::forward(const float* x, float* out) const {
+    forwardFrom(0, x, out);
+}
+
+void Mlp::forwardFrom(int first, const float* h, float* out) const {
+    // Ping-pong activation buffers, grown once per thread
+    thread_local AlignedVector<float> buffers;
+    if (buffers.size() < 2 * static_cast<size_t>(maxWidth_)) buffers.resize(2 * static_cast<size_t>(maxWidth_));
+    float* next = buffers.data();
+    float* spare = next + maxWidth_;
+    const float* cur = h;
+    int last = numLayers() - 1;
+    for (int l = first; l <= last; ++l) {
+        const MlpLayer& layer = layers_[l];
+        const Packed& p = packed_[l];
+        float* y = l == last ? out : next;
+        p.kernel(p.rows.data(), p.stride, layer.bias.data(), cur, y, layer.inputs, layer.outputs);
+        if (l == last) break;
+        for (int j = 0; j < layer.outputs; ++j) y[j] = std::max(0.0f, y[j]);  // ReLU
+        if (p.addInput) {
+            for (int j = 0; j < layer.outputs; ++j) y[j] += cur[j];
+        }
+        cur = y;
+        std::swap(next, spare);
+    }
+}
+
+void Mlp::accumulateFirst(const float* x, int begin, int count, float* out) const {
+    const Packed& p = packed_.front();
+    for (int j = 0; j < layers_.front().outputs; ++j) {
+        out[j] += dotProduct(&p.rows[static_cast<size_t>(j) * p.stride + begin], x, count);
+    }
+}
+
+// --- MlpValueFunction ---
+
+MlpValueFunction::MlpValueFunction(std::shared_ptr<const Mlp> net) : net_(std::move(net)) {
+    if (net_->outputSize() != 1) throw std::invalid_argument("MlpValueFunction: net must have one output");
+}
+
+float MlpValueFunction::evaluate(const float* features, int numFeatures) const {
+    BB_PROFILE_NAMED_SCOPE(profile, prof::VALUE_EVAL);
+    BB_PROFILE_UNITS(profile, 1);
+    float out;
+    if (numFeatures >= net_->inputSize()) {
+        net_->forward(features, &out);
+    } else {
+        // Missing trailing features read as zero, as in NeuralValueFunction
+        thread_local std::vector<float> padded;
+        padded.assign(static_cast<size_t>(net_->inputSize()), 0.0f);
+        std::copy_n(features, std::max(0, numFeatures), padded.data());
+        net_->forward(padded.data(), &out);
+    }
+    return std::tanh(out);
+}
+
+void MlpValueFunction::evaluateBatch(const float* features, int batch, int numFeatures,
+                                     float* out) const {
+    for (int b = 0; b < batch; ++b) {
+        out[b] = evaluate(features + static_cast<size_t>(b) * numFeatures, numFeatures);
+    }
+}
+
+} // namespace bb
@@ -0,0 +1,121 @@
+#include "bb/model_cache.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+
+namespace bb {
+
+namespace {
+
+bool modificationTime(const std::string& path, int64_t& out) {
+    std::error_code ec;
+    auto t = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+    out = static_cast<int64_t>(t.time_since_epoch().count());
+    return true;
+}
+
+} // anonymous namespace
+
+std::shared_ptr<LoadedModel> ModelCache::get(const std::string& path) {
+    int64_t mtime = 0;
+    if (!modificationTime(path, mtime)) return nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = models_.find(path);
+        if (it != models_.end() && it->second->mtime == mtime) return it->second;
+    }
+
+    // Parse outside the lock; concurrent first loads of one path race
+    // harmlessly and the last one wins the slot.
+    auto model = std::make_shared<LoadedModel>();
+    model->path = path;
+    model->mtime = mtime;
+    model->value = loadValueFunction(path);
+    model->policy = loadPolicyNetworkFromFile(path);
+    if (!model->value && !model->policy) return nullptr;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++loads_;
+    models_[path] = model;
+    return model;
+}
+
+void ModelCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    models_.clear();
+}
+
+size_t ModelCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return models_.size();
+}
+
+uint64_t ModelCache::loads() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return loads_;
+}
+
+ModelCache& ModelCache::global() {
+    static ModelCache cache;
+    return cache;
+}
+
+// --- ModelHandle ---
+
+ModelHandle::ModelHandle(std::string path, ModelCache& cache)
+    : path_(std::move(path)), cache_(cache) {
+    std::shared_ptr<const LoadedModel> model;
+    try {
+        model = cache_.get(path_);
+    } catch (const std::exception& e) {
+        throw std::runtime_error("ModelHandle: cannot load " + path_ + ": " + e.what());
+    }
+    if (!model) throw std::runtime_error("ModelHandle: no network in " + path_);
+    current_.store(std::move(model));
+}
+
+ModelHandle::~ModelHandle() {
+    stopWatching();
+}
+
+bool ModelHandle::refresh() {
+    std::lock_guard<std::mutex> lock(refreshMutex_);
+    std::shared_ptr<const LoadedModel> next;
+    try {
+        next = cache_.get(path_);
+    } catch (const std::exception&) {
+        return false;  // mid-write; the next refresh tries again
+    }
+    if (!next || next == current_.load()) return false;
+    current_.store(std::move(next));
+    version_.fetch_add(1);
+    return true;
+}
+
+void ModelHandle::watch(int intervalMs) {
+    stopWatching();
+    std::lock_guard<std::mutex> lock(watchMutex_);
+    watchStop_ = false;
+    watcher_ = std::thread([this, interval = std::chrono::milliseconds(std::max(1, intervalMs))] {
+        std::unique_lock<std::mutex> lock(watchMutex_);
+        while (!watchWake_.wait_for(lock, interval, [this] { return watchStop_; })) {
+            lock.unlock();
+            refresh();
+            lock.lock();
+        }
+    });
+}
+
+void ModelHandle::stopWatching() {
+    {
+        std::lock_guard<std::mutex> lock(watchMutex_);
+        watchStop_ = true;
+    }
+    watchWake_.notify_all();
+    if (watcher_.joinable()) watcher_.join();
+}
+
+} // namespace bb
@@ -1,4 +1,5 @@
 #include "bb/move_handler.h"
+#include "bb/geometry.h"
 #include "bb/helpers.h"
 #include "bb/injury.h"
 #include "bb/ball_handler.h"
@@ -13,10 +14,8 @@ namespace {
 bool checkTentacles(GameState& state, int playerId, Position from,
                     DiceRollerBase& dice, std::vector<GameEvent>* events) {
     Player& mover = state.getPlayer(playerId);
-    auto adj = from.getAdjacent();
-
-    for (auto& pos : adj) {
-        if (!pos.isOnPitch()) continue;
+    if (!state.teamMayHaveSkill(opponent(mover.teamSide), SkillName::Tentacles)) return false;
+    for (Position pos : onPitchNeighbours(from)) {
         const Player* opp = state.getPlayerAtPosition(pos);
         if (!opp || opp->teamSide == mover.teamSide) continue;
         if (!canAct(opp->state) || opp->lostTacklezones) continue;
@@ -25,10 +24,10 @@ bool checkTentacles(GameState& state, int playerId, Position from,
         // Contest: D6+moverST vs D6+tentaclesST, strictly greater to escape
         int moverRoll = dice.rollD6();
         int tentRoll = dice.rollD6();
-        bool escaped = (moverRoll + mover.stats.strength) > (tentRoll + opp->stats.strength);
+        bool escaped = (moverRoll + mover.stats().strength) > (tentRoll + opp->stats().strength);
 
-        emitEvent(events, {GameEvent::Type::SKILL_USED, opp->id, playerId, {}, {},
-                          static_cast<int>(SkillName::Tentacles), !escaped});
+        BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, opp->id, playerId, {}, {},
+                              static_cast<int>(SkillName::Tentacles), !escaped);
 
         if (!escaped) {
             // Caught: movement ends, player stays at from
@@ -45,10 +44,8 @@ bool checkTentacles(GameState& state, int playerId, Position from,
 void checkShadowing(GameState& state, int playerId, Position from,
                     DiceRollerBase& dice, std::vector<GameEvent>* events) {
     Player& mover = state.getPlayer(playerId);
-    auto adj = from.getAdjacent();
-
-    for (auto& pos : adj) {
-        if (!pos.isOnPitch()) continue;
+    if (!state.teamMayHaveSkill(opponent(mover.teamSide), SkillName::Shadowing)) return;
+    for (Position pos : onPitchNeighbours(from)) {
         Player* opp = state.getPlayerAtPosition(pos);
         if (!opp || opp->teamSide == mover.teamSide) continue;
         if (!canAct(opp->state) || opp->lostTacklezones) continue;
@@ -56,16 +53,16 @@ void checkShadowing(GameState& state, int playerId, Position from,
 
         // Roll: D6 + shadowMA - moverMA. If >= 6, follower moves to vacated square
         int roll = dice.rollD6();
-        int total = roll + opp->stats.movement - mover.stats.movement;
+        int total = roll + opp->stats().movement - mover.stats().movement;
         bool follows = (total >= 6);
 
-        emitEvent(events, {GameEvent::Type::SKILL_USED, opp->id, playerId, opp->position, from,
-                          static_cast<int>(SkillName::Shadowing), follows});
+        BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, opp->id, playerId, opp->position, from,
+                              static_cast<int>(SkillName::Shadowing), follows);
 
         if (follows) {
             // Check that vacated square is empty (should be, since we just left)
             if (!state.getPlayerAtPosition(from)) {
-                opp->position = from;
+                state.movePlayer(*opp, from);
             }
         }
         // Only one Shadowing attempt per dodge step
@@ -122,9 +119,7 @@ ActionResult resolveMoveStep(GameState& state, int playerId, Position to,
 
         // Check if Tackle negates Dodge reroll
         bool tackleNegates = false;
-        auto srcAdj = from.getAdjacent();
-        for (auto& apos : srcAdj) {
-            if (!apos.isOnPitch()) continue;
+        for (Position apos : onPitchNeighbours(from)) {
             const Player* opp = state.getPlayerAtPosition(apos);
             if (opp && opp->teamSide != player.teamSide &&
                 exertsTacklezone(opp->state) && !opp->lostTacklezones &&
@@ -137,13 +132,13 @@ ActionResult resolveMoveStep(GameState& state, int playerId, Position to,
         bool dodgeOk = attemptRoll(state, playerId, dice, target,
                                     SkillName::Dodge, tackleNegates, true, events);
 
-        emitEvent(events, {GameEvent::Type::DODGE, playerId, -1, from, to,
-                          target, dodgeOk});
+        BB_EMIT_EVENT(events, GameEvent::Type::DODGE, playerId, -1, from, to,
+                              target, dodgeOk);
 
         if (!dodgeOk) {
             // Failed dodge: player falls at destination
-            player.position = to;
-            player.state = PlayerState::PRONE;
+            state.movePlayer(player, to);
+            state.setPlayerState(player, PlayerState::PRONE);
             player.hasActed = true;
 
             InjuryContext ctx;
@@ -161,13 +156,13 @@ ActionResult resolveMoveStep(GameState& state, int playerId, Position to,
         bool gfiOk = attemptRoll(state, playerId, dice, gfiTarget,
                                   SkillName::SureFeet, false, true, events);
 
-        emitEvent(events, {GameEvent::Type::GFI, playerId, -1, from, to,
-                          gfiTarget, gfiOk});
+        BB_EMIT_EVENT(events, GameEvent::Type::GFI, playerId, -1, from, to,
+                              gfiTarget, gfiOk);
 
         if (!gfiOk) {
             // Failed GFI: player falls at destination
-            player.position = to;
-            player.state = PlayerState::PRONE;
+            state.movePlayer(player, to);
+            state.setPlayerState(player, PlayerState::PRONE);
             player.hasActed = true;
 
             InjuryContext ctx;
@@ -179,14 +174,14 @@ ActionResult resolveMoveStep(GameState& state, int playerId, Position to,
     }
 
     // Move player
-    player.position = to;
+    state.movePlayer(player, to);
 
     // Update ball position if carrier
     if (state.ball.isHeld && state.ball.carrierId == playerId) {
         state.ball.position = to;
     }
 
-    emitEvent(events, {GameEvent::Type::PLAYER_MOVE, playerId, -1, from, to, 0, true});
+    BB_EMIT_EVENT(events, GameEvent::Type::PLAYER_MOVE, playerId, -1, from, to, 0, true);
 
     // Shadowing: after successful dodge, enemy may follow
     if (needsDodge) {
@@ -235,7 +230,7 @@ ActionResult resolveLeap(GameState& state, int playerId, Position to,
     }
 
     // Leap agility check: target = max(2, min(6, 7-AG+TZ_at_dest))
-    int target = 7 - player.stats.agility;
+    int target = 7 - player.stats().agility;
     target += countTacklezones(state, to, player.teamSide);
     if (player.hasSkill(SkillName::VeryLongLegs)) target -= 1;
     target = std::clamp(target, 2, 6);
@@ -243,13 +238,13 @@ ActionResult resolveLeap(GameState& state, int playerId, Position to,
     bool leapOk = attemptRoll(state, playerId, dice, target,
                                SkillName::SKILL_COUNT, false, true, events);
 
-    emitEvent(events, {GameEvent::Type::DODGE, playerId, -1, from, to,
-                      target, leapOk});
+    BB_EMIT_EVENT(events, GameEvent::Type::DODGE, playerId, -1, from, to,
+                          target, leapOk);
 
     if (!leapOk) {
         // Failed leap: player prone at destination, armor+injury, turnover
-        player.position = to;
-        player.state = PlayerState::PRONE;
+        state.movePlayer(player, to);
+        state.setPlayerState(player, PlayerState::PRONE);
         player.hasActed = true;
 
         InjuryContext ctx;
@@ -265,8 +260,8 @@ ActionResult resolveLeap(GameState& state, int playerId, Position to,
         bool gfiOk = attemptRoll(state, playerId, dice, gfiTarget,
                                   SkillName::SureFeet, false, true, events);
         if (!gfiOk) {
-            player.position = to;
-            player.state = PlayerState::PRONE;
+            state.movePlayer(player, to);
+            state.setPlayerState(player, PlayerState::PRONE);
             player.hasActed = true;
 
             InjuryContext ctx;
@@ -278,13 +273,13 @@ ActionResult resolveLeap(GameState& state, int playerId, Position to,
     }
 
     // Move player
-    player.position = to;
+    state.movePlayer(player, to);
 
     if (state.ball.isHeld && state.ball.carrierId == playerId) {
         state.ball.position = to;
     }
 
-    emitEvent(events, {GameEvent::Type::PLAYER_MOVE, playerId, -1, from, to, 0, true});
+    BB_EMIT_EVENT(events, GameEvent::Type::PLAYER_MOVE, playerId, -1, from, to, 0, true);
 
     // Pickup ball if on ground at destination
     if (!state.ball.isHeld && state.ball.position == to) {
@@ -308,7 +303,7 @@ ActionResult resolveStandUp(GameState& state, int playerId, DiceRollerBase& dice
 
     if (player.hasSkill(SkillName::JumpUp)) {
         // Free stand up
-        player.state = PlayerState::STANDING;
+        state.setPlayerState(player, PlayerState::STANDING);
         return ActionResult::ok();
     }
 
@@ -318,7 +313,7 @@ ActionResult resolveStandUp(GameState& state, int playerId, DiceRollerBase& dice
     }
 
     player.movementRemaining -= 3;
-    player.state = PlayerState::STANDING;
+    state.setPlayerState(player, PlayerState::STANDING);
     return ActionResult::ok();
 }
 
@@ -0,0 +1,423 @@
+#include "bb/move_server.h"
+#include "bb/policies.h"
+#include "bb/root_cache.h"
+#include "bb/state_io.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace bb {
+
+using nlohmann::json;
+
+namespace {
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+json actionToJson(const Action& a) {
+    return {
+        {"type", actionTypeName(a.type)},
+        {"type_id", static_cast<int>(a.type)},
+        {"player", a.playerId},
+        {"target_player", a.targetId},
+        {"x", a.target.x},
+        {"y", a.target.y},
+    };
+}
+
+const char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+} // anonymous namespace
+
+const char* moveStatusName(MoveStatus s) {
+    switch (s) {
+        case MoveStatus::OK: return "ok";
+        case MoveStatus::CANCELLED: return "cancelled";
+        default: return "failed";
+    }
+}
+
+// --- MoveServer ---
+
+MoveServer::MoveServer(MoveServerConfig config) : config_(std::move(config)) {
+    if (config_.workers <= 0 || config_.queueCapacity < 0) {
+        throw std::invalid_argument("MoveServer: workers must be positive and queueCapacity non-negative");
+    }
+    policyFromModel_ = !config_.search.policy;
+    slow_ = std::make_unique<SlowDecisionMonitor>(config_.slowDecisions);
+    std::shared_ptr<const LoadedModel> model = config_.model;
+    uint64_t version = 0;
+    if (config_.liveModel) {
+        model = config_.liveModel->current();
+        version = config_.liveModel->version();
+    }
+    for (int w = 0; w < config_.workers; ++w) {
+        auto worker = std::make_unique<Worker>();
+        worker->seed = static_cast<uint32_t>(w + 1);
+        buildSearch(*worker, model, version);
+        workers_.push_back(std::move(worker));
+    }
+    threads_.reserve(workers_.size());
+    for (auto& worker : workers_) {
+        threads_.emplace_back([this, w = worker.get()] { workerLoop(*w); });
+    }
+}
+
+void MoveServer::buildSearch(Worker& worker, std::shared_ptr<const LoadedModel> model, uint64_t version) {
+    MCTSConfig search = config_.search;
+    search.cancel = &worker.cancel;
+    if (policyFromModel_) search.policy = model ? model->policy.get() : nullptr;
+    // Roots searched by an earlier model must not answer for this one
+    if (version > 0) search.rootCacheModel ^= (version * 0x9e3779b97f4a7c15ull) | 1;
+    const ValueFunction* vf = model ? model->value.get() : nullptr;
+    worker.search = std::make_unique<MacroMCTSSearch>(vf, search, worker.seed);
+    worker.model = std::move(model);
+    worker.modelVersion = version;
+    worker.ttHits = 0;
+    worker.ttMisses = 0;
+}
+
+MoveServer::~MoveServer() {
+    shutdown();
+}
+
+uint64_t MoveServer::submit(MoveRequest request, Callback done) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_ || static_cast<int>(queue_.size()) >= config_.queueCapacity) {
+        metrics_.counter("bb_requests_rejected_total", "Move requests refused: queue full or shutting down").inc();
+        return 0;
+    }
+    Job job;
+    job.ticket = nextTicket_++;
+    job.request = std::move(request);
+    job.done = std::move(done);
+    job.submitted = std::chrono::steady_clock::now();
+    queue_.push_back(std::move(job));
+    wake_.notify_one();
+    return queue_.back().ticket;
+}
+
+bool MoveServer::cancel(uint64_t ticket) {
+    Job cancelled;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& worker : workers_) {
+            if (worker->ticket == ticket && ticket != 0) {
+                worker->cancel = true;
+                return true;
+            }
+        }
+        auto it = std::find_if(queue_.begin(), queue_.end(),
+                               [ticket](const Job& j) { return j.ticket == ticket; });
+        if (it == queue_.end()) return false;
+        cancelled = std::move(*it);
+        queue_.erase(it);
+    }
+    MoveReply reply;
+    reply.tag = cancelled.request.tag;
+    reply.status = MoveStatus::CANCELLED;
+    reply.queueMs = msSince(cancelled.submitted);
+    count(reply);
+    cancelled.done(reply);
+    return true;
+}
+
+void MoveServer::shutdown() {
+    std::deque<Job> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_ && threads_.empty()) return;
+        stopping_ = true;
+        dropped.swap(queue_);
+    }
+    wake_.notify_all();
+    for (Job& job : dropped) {
+        MoveReply reply;
+        reply.tag = job.request.tag;
+        reply.status = MoveStatus::CANCELLED;
+        reply.queueMs = msSince(job.submitted);
+        job.done(reply);
+    }
+    for (auto& th : threads_) th.join();
+    threads_.clear();
+}
+
+void MoveServer::count(const MoveReply& reply) {
+    metrics_.counter("bb_requests_total", "Move requests answered", metricLabel("status", moveStatusName(reply.status)))
+        .inc();
+    static const std::vector<double> queueBuckets = {0.001, 0.01, 0.05, 0.1, 0.25, 0.5, 1, 2, 5, 10};
+    metrics_.histogram("bb_queue_seconds", "Time a move request waited for a worker", queueBuckets)
+        .observe(reply.queueMs / 1000.0);
+}
+
+std::string MoveServer::metricsText() {
+    metrics_.gauge("bb_queue_depth", "Move requests waiting for a worker").set(queued());
+    metrics_.gauge("bb_running_searches", "Move requests being searched").set(running());
+    metrics_.gauge("bb_workers", "Search workers").set(static_cast<double>(workers_.size()));
+    updateProcessMetrics(metrics_);
+    return metrics_.renderPrometheus();
+}
+
+int MoveServer::queued() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(queue_.size());
+}
+
+int MoveServer::running() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(std::count_if(workers_.begin(), workers_.end(),
+                                          [](const auto& w) { return w->ticket != 0; }));
+}
+
+void MoveServer::workerLoop(Worker& worker) {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;  // stopping
+            job = std::move(queue_.front());
+            queue_.pop_front();
+            worker.ticket = job.ticket;
+            worker.cancel = false;
+        }
+        MoveReply reply = choose(worker, job);
+        count(reply);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            worker.ticket = 0;
+        }
+        job.done(reply);
+    }
+}
+
+MoveReply MoveServer::choose(Worker& worker, const Job& job) {
+    const MoveRequest& request = job.request;
+    MoveReply reply;
+    reply.tag = request.tag;
+    reply.queueMs = msSince(job.submitted);
+    if (request.state.phase == GamePhase::GAME_OVER) {
+        reply.status = MoveStatus::FAILED;
+        reply.error = "game is over";
+        return reply;
+    }
+
+    // The budget runs from submission: time spent queued comes off the search
+    int budgetMs = request.timeBudgetMs > 0 ? request.timeBudgetMs : config_.search.timeBudgetMs;
+    if (budgetMs > 0) {
+        budgetMs = std::min(budgetMs, config_.maxTimeBudgetMs);
+        budgetMs = std::max(1, budgetMs - static_cast<int>(reply.queueMs));
+    }
+    int iterations = request.maxIterations > 0 ? request.maxIterations : config_.search.maxIterations;
+    if (config_.liveModel) {
+        // Version before model: a swap in between is picked up next time
+        uint64_t version = config_.liveModel->version();
+        std::shared_ptr<const LoadedModel> model = config_.liveModel->current();
+        if (model != worker.model) buildSearch(worker, std::move(model), version);
+    }
+    reply.modelVersion = worker.modelVersion;
+    worker.search->setBudget(budgetMs, iterations);
+    std::vector<uint8_t> dice;
+    if (slow_->enabled()) dice = serializeDice(worker.search->dice());
+    searchMove(*worker.search, request, static_cast<uint32_t>(job.ticket), reply, &worker.cancel);
+    if (reply.status == MoveStatus::OK) {
+        recordDecision(metrics_, "macro_mcts", reply.searchMs, &worker.search->lastStats());
+        // The table's counters are cumulative over the search object
+        const TranspositionTable& tt = worker.search->transpositionTable();
+        metrics_.counter("bb_tt_hits_total", "Transposition table hits", metricLabel("ai", "macro_mcts"))
+            .inc(static_cast<double>(tt.hits() - worker.ttHits));
+        metrics_.counter("bb_tt_misses_total", "Transposition table misses", metricLabel("ai", "macro_mcts"))
+            .inc(static_cast<double>(tt.misses() - worker.ttMisses));
+        worker.ttHits = tt.hits();
+        worker.ttMisses = tt.misses();
+    }
+    if (slow_->enabled() && reply.status == MoveStatus::OK) {
+        std::string reason = slow_->observe(reply.searchMs, reply.iterations);
+        if (!reason.empty()) {
+            DecisionCapture capture;
+            capture.reason = std::move(reason);
+            capture.state = request.state.clone();
+            capture.config = worker.search->config();
+            capture.seed = worker.seed;
+            capture.dice = std::move(dice);
+            if (worker.model) {
+                capture.valuePath = worker.model->path;
+                if (policyFromModel_ && worker.model->policy) capture.policyPath = worker.model->path;
+            }
+            if (!policyFromModel_) capture.policyPath = config_.policyPath;
+            capture.modelKey = rootCacheModelKey({capture.valuePath, capture.policyPath});
+            capture.modelVersion = worker.modelVersion;
+            capture.macro = reply.macro;
+            recordDecisionOutcome(capture, *worker.search, reply.searchMs);
+            reply.capture = slow_->write(capture);
+        }
+    }
+    return reply;
+}
+
+void searchMove(MacroMCTSSearch& search, const MoveRequest& request, uint32_t planSeed, MoveReply& reply,
+                const std::atomic<bool>* cancel) {
+    auto start = std::chrono::steady_clock::now();
+    try {
+        reply.macro = search.search(request.state);
+        reply.iterations = search.lastIterations();
+        reply.value = search.lastBestValue();
+        if (cancel && cancel->load()) {
+            reply.status = MoveStatus::CANCELLED;
+            reply.searchMs = msSince(start);
+            return;
+        }
+
+        // Expand the macro as MacroMCTSPolicy does, including its fallbacks
+        DiceRoller dice(planSeed);
+        GameState planState = request.state.clone();
+        reply.actions = greedyExpandMacro(planState, reply.macro, dice).actions;
+        if (reply.actions.empty()) reply.actions.push_back(Action{ActionType::END_TURN, -1, -1, {-1, -1}});
+        if (!isActionLegal(request.state, reply.actions[0])) reply.actions = {greedyPolicy(request.state, dice)};
+        if (!request.plan) reply.actions.resize(1);
+    } catch (const std::exception& e) {
+        reply.status = MoveStatus::FAILED;
+        reply.error = e.what();
+        reply.actions.clear();
+    }
+    reply.searchMs = msSince(start);
+}
+
+// --- Line protocol ---
+
+ServerMessage parseServerMessage(const std::string& line) {
+    ServerMessage msg;
+    json j = json::parse(line, nullptr, false);
+    if (j.is_discarded() || !j.is_object()) {
+        msg.error = "not a JSON object";
+        return msg;
+    }
+    if (j.contains("id")) msg.request.tag = j["id"].dump();
+
+    std::string op = j.value("op", std::string("move"));
+    if (op == "stats") {
+        msg.op = ServerOp::STATS;
+        return msg;
+    }
+    if (op == "metrics") {
+        msg.op = ServerOp::METRICS;
+        return msg;
+    }
+    if (op == "cancel") {
+        if (msg.request.tag.empty()) msg.error = "cancel needs an id";
+        else msg.op = ServerOp::CANCEL;
+        return msg;
+    }
+    if (op != "move") {
+        msg.error = "unknown op: " + op;
+        return msg;
+    }
+
+    try {
+        if (j.contains("state")) {
+            msg.request.state = stateFromJson(j["state"].dump());
+        } else if (j.contains("state_b64")) {
+            std::vector<uint8_t> bytes;
+            std::optional<GameState> state;
+            if (decodeBase64(j["state_b64"].get<std::string>(), bytes)) {
+                state = deserializeState(bytes.data(), bytes.size());
+            }
+            if (!state) {
+                msg.error = "state_b64 is not a valid binary state record";
+                return msg;
+            }
+            msg.request.state = std::move(*state);
+        } else {
+            msg.error = "move needs state or state_b64";
+            return msg;
+        }
+        msg.request.timeBudgetMs = j.value("time_ms", 0);
+        msg.request.maxIterations = j.value("iterations", 0);
+        msg.request.plan = j.value("plan", false);
+    } catch (const std::exception& e) {
+        // Malformed JSON, or a state stateFromJson refused
+        msg.error = std::string("bad move request: ") + e.what();
+        return msg;
+    }
+    msg.op = ServerOp::MOVE;
+    return msg;
+}
+
+std::string moveReplyToJson(const MoveReply& reply) {
+    json j;
+    j["id"] = reply.tag.empty() ? json() : json::parse(reply.tag, nullptr, false);
+    j["status"] = moveStatusName(reply.status);
+    if (reply.status == MoveStatus::FAILED) j["error"] = reply.error;
+    if (reply.status == MoveStatus::OK) {
+        j["macro"] = {
+            {"type", macroTypeName(reply.macro.type)},
+            {"player", reply.macro.playerId},
+            {"target_player", reply.macro.targetId},
+            {"x", reply.macro.targetPos.x},
+            {"y", reply.macro.targetPos.y},
+        };
+        json actions = json::array();
+        for (const Action& a : reply.actions) actions.push_back(actionToJson(a));
+        j["actions"] = std::move(actions);
+        j["value"] = reply.value;
+    }
+    j["iterations"] = reply.iterations;
+    j["queue_ms"] = reply.queueMs;
+    j["search_ms"] = reply.searchMs;
+    if (reply.modelVersion > 0) j["model_version"] = reply.modelVersion;
+    return j.dump();
+}
+
+std::string serverErrorJson(const std::string& tag, const std::string& error) {
+    json j;
+    j["id"] = tag.empty() ? json() : json::parse(tag, nullptr, false);
+    j["status"] = "error";
+    j["error"] = error;
+    return j.dump();
+}
+
+std::string encodeBase64(const std::vector<uint8_t>& data) {
+    std::string out;
+    out.reserve((data.size() + 2) / 3 * 4);
+    for (size_t i = 0; i < data.size(); i += 3) {
+        uint32_t n = static_cast<uint32_t>(data[i]) << 16;
+        if (i + 1 < data.size()) n |= static_cast<uint32_t>(data[i + 1]) << 8;
+        if (i + 2 < data.size()) n |= data[i + 2];
+        out += BASE64_ALPHABET[(n >> 18) & 63];
+        out += BASE64_ALPHABET[(n >> 12) & 63];
+        out += i + 1 < data.size() ? BASE64_ALPHABET[(n >> 6) & 63] : '=';
+        out += i + 2 < data.size() ? BASE64_ALPHABET[n & 63] : '=';
+    }
+    return out;
+}
+
+bool decodeBase64(const std::string& text, std::vector<uint8_t>& out) {
+    out.clear();
+    if (text.size() % 4 != 0) return false;
+    out.reserve(text.size() / 4 * 3);
+    for (size_t i = 0; i < text.size(); i += 4) {
+        uint32_t n = 0;
+        int pad = 0;
+        for (size_t k = 0; k < 4; ++k) {
+            char c = text[i + k];
+            int v;
+            if (c == '=' && i + 4 == text.size() && k >= 2) { v = 0; ++pad; }
+            else if (pad > 0) return false;
+            else if (c >= 'A' && c <= 'Z') v = c - 'A';
+            else if (c >= 'a' && c <= 'z') v = c - 'a' + 26;
+            else if (c >= '0' && c <= '9') v = c - '0' + 52;
+            else if (c == '+') v = 62;
+            else if (c == '/') v = 63;
+            else return false;
+            n = (n << 6) | static_cast<uint32_t>(v);
+        }
+        out.push_back(static_cast<uint8_t>(n >> 16));
+        if (pad < 2) out.push_back(static_cast<uint8_t>(n >> 8));
+        if (pad < 1) out.push_back(static_cast<uint8_t>(n));
+    }
+    return true;
+}
+
+} // namespace bb
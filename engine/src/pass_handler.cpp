@@ -1,6 +1,7 @@
 #include "bb/pass_handler.h"
 #include "bb/ball_handler.h"
 #include "bb/helpers.h"
+#include "bb/geometry.h"
 #include <algorithm>
 #include <cmath>
 
@@ -8,47 +9,6 @@ namespace bb {
 
 namespace {
 
-// Bresenham line from src to dst, returning all positions along the path
-// (excluding src and dst themselves)
-int getPassPath(Position src, Position dst, Position* out, int maxOut) {
-    int count = 0;
-    int x0 = src.x, y0 = src.y;
-    int x1 = dst.x, y1 = dst.y;
-
-    int dx = std::abs(x1 - x0);
-    int dy = std::abs(y1 - y0);
-    int sx = (x0 < x1) ? 1 : -1;
-    int sy = (y0 < y1) ? 1 : -1;
-    int err = dx - dy;
-
-    // The line spans exactly max(dx, dy) steps along the dominant axis. Bounding
-    // the loop to that many iterations guarantees termination: previously this was
-    // `while (true)` that broke only on (x0==x1 && y0==y1), but the strict `>`/`<`
-    // comparisons can overshoot the endpoint on degenerate inputs, so the break
-    // never fired and the game hung forever (the `count < maxOut` guard only stops
-    // writing, not looping). Skip the start position; never record the endpoint.
-    int steps = std::max(dx, dy);
-    for (int s = 0; s < steps; ++s) {
-        int e2 = 2 * err;
-        if (e2 > -dy) {
-            err -= dy;
-            x0 += sx;
-        }
-        if (e2 < dx) {
-            err += dx;
-            y0 += sy;
-        }
-
-        // Reached destination
-        if (x0 == x1 && y0 == y1) break;
-
-        if (count < maxOut) {
-            out[count++] = {static_cast<int8_t>(x0), static_cast<int8_t>(y0)};
-        }
-    }
-    return count;
-}
-
 // Check for interception along pass path
 // Returns interceptor player ID or -1
 int checkInterception(GameState& state, int passerId, Position target,
@@ -56,22 +16,23 @@ int checkInterception(GameState& state, int passerId, Position target,
     Player& passer = state.getPlayer(passerId);
     TeamSide enemySide = opponent(passer.teamSide);
 
-    // Get pass path
-    Position path[30];
-    int pathLen = getPassPath(passer.position, target, path, 30);
+    // Squares strictly between passer and target (precomputed Bresenham
+    // corridor). An off-pitch target has none on the table; passes are only
+    // generated to on-pitch squares.
+    if (!target.isOnPitch()) return -1;
+    const geometry::PassLine& line = passLine(passer.position, target);
 
     // Find first eligible interceptor along path
-    for (int i = 0; i < pathLen; i++) {
-        if (!path[i].isOnPitch()) continue;
-
+    for (int i = 0; i < line.length; i++) {
         // Check for standing enemy at this position
-        const Player* interceptor = state.getPlayerAtPosition(path[i]);
+        const Player* interceptor =
+            state.getPlayerAtPosition(passLineSquare(line, passer.position, i));
         if (!interceptor || interceptor->teamSide != enemySide) continue;
         if (!canAct(interceptor->state) || interceptor->lostTacklezones) continue;
         if (interceptor->hasSkill(SkillName::NoHands)) continue;
 
         // Interception target: 7 - AG + 2 (base modifier)
-        int intTarget = 7 - interceptor->stats.agility + 2;
+        int intTarget = 7 - interceptor->stats().agility + 2;
         if (interceptor->hasSkill(SkillName::VeryLongLegs)) intTarget -= 1;
         if (interceptor->hasSkill(SkillName::ExtraArms)) intTarget -= 1;
 
@@ -90,16 +51,16 @@ int checkInterception(GameState& state, int passerId, Position target,
             int reroll = dice.rollD6();
             if (reroll < intTarget) {
                 success = false;
-                emitEvent(events, {GameEvent::Type::SKILL_USED, passerId, -1, {}, {},
-                                  static_cast<int>(SkillName::SafeThrow), true});
+                BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, passerId, -1, {}, {},
+                                      static_cast<int>(SkillName::SafeThrow), true);
             }
         }
 
         if (success) {
             // Interceptor catches the ball
             state.ball = BallState::carried(interceptor->position, interceptor->id);
-            emitEvent(events, {GameEvent::Type::CATCH, interceptor->id, passerId,
-                              interceptor->position, {}, intTarget, true});
+            BB_EMIT_EVENT(events, GameEvent::Type::CATCH, interceptor->id, passerId,
+                                  interceptor->position, {}, intTarget, true);
             return interceptor->id;
         }
         // Only first eligible interceptor gets a chance (simplified)
@@ -137,8 +98,8 @@ ActionResult resolvePass(GameState& state, int passerId, Position target,
     if (isHailMary) {
         // Hail Mary: no interception, D6: 1=fumble, 2+=inaccurate
         int hmpRoll = dice.rollD6();
-        emitEvent(events, {GameEvent::Type::PASS, passerId, -1, passer.position, target,
-                          hmpRoll, hmpRoll >= 2});
+        BB_EMIT_EVENT(events, GameEvent::Type::PASS, passerId, -1, passer.position, target,
+                              hmpRoll, hmpRoll >= 2);
 
         if (hmpRoll == 1) {
             // Fumble: ball bounces from thrower
@@ -199,7 +160,7 @@ ActionResult resolvePass(GameState& state, int passerId, Position target,
         range = static_cast<PassRange>(static_cast<int>(range) - 1);
     }
 
-    int passTarget = 7 - passer.stats.agility;
+    int passTarget = 7 - passer.stats().agility;
     passTarget -= passModifier(range);  // range modifier (QP=+1, SP=0, LP=-1, LB=-2)
 
     if (passer.hasSkill(SkillName::Accurate)) passTarget -= 1;
@@ -221,8 +182,8 @@ ActionResult resolvePass(GameState& state, int passerId, Position target,
     // Roll with Pass skill reroll chain
     int roll = dice.rollD6();
 
-    emitEvent(events, {GameEvent::Type::PASS, passerId, -1, passer.position, target,
-                      roll, roll >= passTarget});
+    BB_EMIT_EVENT(events, GameEvent::Type::PASS, passerId, -1, passer.position, target,
+                          roll, roll >= passTarget);
 
     // Natural 1 = always fumble
     if (roll == 1) {
@@ -231,8 +192,8 @@ ActionResult resolvePass(GameState& state, int passerId, Position target,
         // Pass skill reroll
         if (passer.hasSkill(SkillName::Pass)) {
             roll = dice.rollD6();
-            emitEvent(events, {GameEvent::Type::SKILL_USED, passerId, -1, {}, {},
-                              static_cast<int>(SkillName::Pass), roll >= passTarget && roll != 1});
+            BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, passerId, -1, {}, {},
+                                  static_cast<int>(SkillName::Pass), roll >= passTarget && roll != 1);
             if (roll != 1 && roll >= passTarget) {
                 rerolled = true;
                 // accurate pass handled below
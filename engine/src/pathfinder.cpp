@@ -1,99 +1,146 @@
 #include "bb/pathfinder.h"
+#include "bb/geometry.h"
 #include "bb/helpers.h"
-#include <cstring>
 
 namespace bb {
 
-// BFS node for pathfinding
-struct PathNode {
-    int8_t x, y;
-    int8_t cost;      // movement spent so far
-    bool dodged;      // needed a dodge at some point
-};
-
 static constexpr int GRID_W = Position::PITCH_WIDTH;
 static constexpr int GRID_H = Position::PITCH_HEIGHT;
 static constexpr int GRID_SIZE = GRID_W * GRID_H;
 
 static inline int gridIdx(int x, int y) { return y * GRID_W + x; }
 
-bool canReachAdjacentTo(const GameState& state, const Player& player,
-                        Position target, Position& outAdjacent) {
-    if (!player.isOnPitch() || player.state == PlayerState::STUNNED) return false;
+void computeReachability(const GameState& state, const Player& player, ReachabilityMap& out) {
+    out.playerId = player.id;
+    out.origin = player.position;
+    out.cost.fill(ReachabilityMap::UNREACHABLE);
+    out.dodges.fill(ReachabilityMap::UNREACHABLE);
+    out.reachable = Bitboard{};
+    out.movementAllowance = 0;
+    out.maxRange = 0;
+
+    if (!player.isOnPitch() || player.state == PlayerState::STUNNED) return;
 
     int maxMove = player.movementRemaining;
-    if (player.state == PlayerState::PRONE) {
-        if (player.hasSkill(SkillName::JumpUp)) {
-            // Free stand up
-        } else {
-            maxMove -= 3; // stand up cost
-        }
+    if (player.state == PlayerState::PRONE && !player.hasSkill(SkillName::JumpUp)) {
+        maxMove -= 3; // stand up cost
     }
-
     int maxGfi = player.hasSkill(SkillName::Sprint) ? 3 : 2;
-    int maxRange = maxMove + maxGfi;
+    out.movementAllowance = maxMove;
+    out.maxRange = std::max(0, maxMove + maxGfi);
 
-    if (maxRange <= 0) return false;
+    TeamSide enemySide = opponent(player.teamSide);
 
-    // Quick distance check
-    int dist = player.position.distanceTo(target);
-    if (dist > maxRange + 1) return false; // too far even in best case
-
-    // BFS
-    bool visited[GRID_SIZE];
-    int8_t costAt[GRID_SIZE];
-    std::memset(visited, 0, sizeof(visited));
-    std::memset(costAt, 127, sizeof(costAt)); // max cost
-
-    PathNode queue[GRID_SIZE];
+    // Plain BFS: every step costs one square, so squares leave the queue in
+    // cost order. A later same-cost predecessor can still lower a square's
+    // dodge count, which is all the relaxation needed.
+    int16_t queue[GRID_SIZE];
     int qHead = 0, qTail = 0;
 
-    int startCost = 0;
-    if (player.state == PlayerState::PRONE && !player.hasSkill(SkillName::JumpUp)) {
-        startCost = 3;
-    }
-
     int startIdx = gridIdx(player.position.x, player.position.y);
-    visited[startIdx] = true;
-    costAt[startIdx] = startCost;
-    queue[qTail++] = {player.position.x, player.position.y,
-                      static_cast<int8_t>(startCost), false};
-
-    Position bestAdj{-1, -1};
-    int bestCost = 999;
+    out.cost[startIdx] = 0;
+    out.dodges[startIdx] = 0;
+    queue[qTail++] = static_cast<int16_t>(startIdx);
 
     while (qHead < qTail) {
-        PathNode cur = queue[qHead++];
-
-        // Check if current position is adjacent to target
-        Position curPos{cur.x, cur.y};
-        if (curPos.distanceTo(target) == 1 && curPos != player.position) {
-            if (cur.cost < bestCost) {
-                bestCost = cur.cost;
-                bestAdj = curPos;
+        int cur = queue[qHead++];
+        int curCost = out.cost[cur];
+        if (curCost >= out.maxRange) continue;
+
+        Position curPos = Bitboard::positionOf(cur);
+        int stepDodge = state.tacklezoneCount(enemySide, curPos) > 0 ? 1 : 0;
+        int newDodges = out.dodges[cur] + stepDodge;
+
+        Bitboard::adjacent(curPos).forEach([&](int n) {
+            if (out.cost[n] == ReachabilityMap::UNREACHABLE) {
+                if (state.getPlayerAtPosition(Bitboard::positionOf(n)) != nullptr) return;
+                out.cost[n] = static_cast<int8_t>(curCost + 1);
+                out.dodges[n] = static_cast<int8_t>(newDodges);
+                queue[qTail++] = static_cast<int16_t>(n);
+            } else if (out.cost[n] == curCost + 1 && newDodges < out.dodges[n]) {
+                out.dodges[n] = static_cast<int8_t>(newDodges);
             }
-        }
+        });
+    }
 
-        // Expand neighbors
-        auto adj = curPos.getAdjacent();
-        for (auto& np : adj) {
-            if (!np.isOnPitch()) continue;
+    for (int i = 0; i < qTail; ++i) out.reachable.set(queue[i]);
+}
 
-            int nIdx = gridIdx(np.x, np.y);
-            if (visited[nIdx]) continue;
+namespace {
+
+// Small direct-mapped cache. The key covers everything computeReachability
+// reads: the board layout (stamp) plus the player's own mutable fields.
+struct ReachCacheEntry {
+    uint64_t stamp = 0;
+    Position position{-1, -1};
+    PlayerState playerState = PlayerState::OFF_PITCH;
+    int8_t movementRemaining = 0;
+    bool valid = false;
+    ReachabilityMap map;
+};
 
-            // Can't move through occupied squares (except target itself for adjacent check)
-            if (np != target && state.getPlayerAtPosition(np) != nullptr) continue;
-            if (np == target) continue; // don't enter the target's square
+constexpr int REACH_CACHE_SIZE = 64;
 
-            int newCost = cur.cost + 1;
-            if (newCost > maxRange) continue;
+} // anonymous namespace
 
-            visited[nIdx] = true;
-            costAt[nIdx] = newCost;
-            queue[qTail++] = {np.x, np.y, static_cast<int8_t>(newCost), false};
-        }
+const ReachabilityMap& getReachability(const GameState& state, const Player& player) {
+    thread_local std::array<ReachCacheEntry, REACH_CACHE_SIZE> cache;
+
+    uint64_t stamp = state.occupancyStamp();
+    ReachCacheEntry& e = cache[(stamp * 23 + player.id) % REACH_CACHE_SIZE];
+    if (!e.valid || e.stamp != stamp || e.map.playerId != player.id ||
+        e.position != player.position || e.playerState != player.state ||
+        e.movementRemaining != player.movementRemaining) {
+        computeReachability(state, player, e.map);
+        e.stamp = stamp;
+        e.position = player.position;
+        e.playerState = player.state;
+        e.movementRemaining = player.movementRemaining;
+        e.valid = true;
+    }
+    return e.map;
+}
+
+int tracePath(const GameState& state, const ReachabilityMap& reach, Position target,
+              Position (&out)[MAX_PATH_LENGTH]) {
+    int steps = reach.costTo(target);
+    if (steps <= 0 || steps > MAX_PATH_LENGTH) return 0;
+
+    // Walk back from target: some neighbour one square nearer whose dodge
+    // count plus the dodge for leaving it accounts for target's count
+    // always exists, because BFS set target's count from such a square.
+    TeamSide enemySide = opponent(state.getPlayer(reach.playerId).teamSide);
+    int sq = Bitboard::indexOf(target);
+    for (int i = steps - 1; i >= 0; --i) {
+        out[i] = Bitboard::positionOf(sq);
+        if (i == 0) break;
+        int prev = -1;
+        Bitboard::adjacent(out[i]).forEach([&](int n) {
+            if (prev >= 0 || reach.cost[n] != reach.cost[sq] - 1) return;
+            int leave = state.tacklezoneCount(enemySide, Bitboard::positionOf(n)) > 0 ? 1 : 0;
+            if (reach.dodges[n] + leave == reach.dodges[sq]) prev = n;
+        });
+        sq = prev;
     }
+    return steps;
+}
+
+bool canReachAdjacentTo(const GameState& state, const Player& player,
+                        Position target, Position& outAdjacent) {
+    const ReachabilityMap& reach = getReachability(state, player);
+
+    Position bestAdj{-1, -1};
+    int bestCost = 999, bestDodges = 999;
+    Bitboard::adjacent(target).forEach([&](int sq) {
+        Position pos = Bitboard::positionOf(sq);
+        if (pos == player.position || !reach.canReach(pos)) return;
+        int c = reach.cost[sq], d = reach.dodges[sq];
+        if (c < bestCost || (c == bestCost && d < bestDodges)) {
+            bestCost = c;
+            bestDodges = d;
+            bestAdj = pos;
+        }
+    });
 
     if (bestAdj.x >= 0) {
         outAdjacent = bestAdj;
@@ -112,9 +159,7 @@ int getValidMoveTargets(const GameState& state, const Player& player,
     int maxGfi = player.hasSkill(SkillName::Sprint) ? 3 : 2;
     bool canGfi = player.movementRemaining <= 0 && player.movementRemaining > -maxGfi;
 
-    auto adj = player.position.getAdjacent();
-    for (auto& pos : adj) {
-        if (!pos.isOnPitch()) continue;
+    for (Position pos : onPitchNeighbours(player.position)) {
         if (state.getPlayerAtPosition(pos) != nullptr) continue;
 
         // Check if player has movement remaining (including GFI)
@@ -0,0 +1,69 @@
+#include "bb/player_profile.h"
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace bb {
+
+namespace {
+
+struct ProfileKey {
+    uint32_t stats;
+    uint64_t skills[2];
+    bool operator==(const ProfileKey&) const = default;
+};
+
+struct ProfileKeyHash {
+    size_t operator()(const ProfileKey& k) const {
+        uint64_t h = k.stats * 0x9E3779B97F4A7C15ull;
+        h ^= k.skills[0] + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+        h ^= k.skills[1] + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+        return static_cast<size_t>(h);
+    }
+};
+
+ProfileKey keyOf(const PlayerStats& stats, const SkillSet& skills) {
+    uint32_t s = static_cast<uint8_t>(stats.movement) | static_cast<uint8_t>(stats.strength) << 8 |
+                 static_cast<uint8_t>(stats.agility) << 16 |
+                 static_cast<uint32_t>(static_cast<uint8_t>(stats.armour)) << 24;
+    return {s, {skills.word(0), skills.word(1)}};
+}
+
+struct ProfileTable {
+    std::mutex mutex;
+    std::unordered_map<ProfileKey, ProfileId, ProfileKeyHash> ids{{ProfileKey{}, 0}};
+    int count = 1;
+};
+
+ProfileTable& table() {
+    static ProfileTable t;
+    return t;
+}
+
+} // anonymous namespace
+
+namespace detail {
+// Profile 0 (a default Player's) is the zero entry, valid before any
+// interning, including during static initialization.
+PlayerProfile profileTable[PROFILE_CAPACITY];
+} // namespace detail
+
+ProfileId internProfile(const PlayerStats& stats, const SkillSet& skills) {
+    ProfileKey key = keyOf(stats, skills);
+    ProfileTable& t = table();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    auto it = t.ids.find(key);
+    if (it != t.ids.end()) return it->second;
+
+    if (t.count >= detail::PROFILE_CAPACITY) {
+        throw std::length_error("internProfile: more than 65536 distinct player profiles");
+    }
+    int id = t.count++;
+    // Readers only see `id` once this returns, and hand it to other threads
+    // through whatever synchronizes the state that carries it.
+    detail::profileTable[id] = {skills, stats, hotSkillMask(skills)};
+    t.ids.emplace(key, static_cast<ProfileId>(id));
+    return static_cast<ProfileId>(id);
+}
+
+} // namespace bb
@@ -1,12 +1,14 @@
 #include "bb/policies.h"
 #include "bb/action_resolver.h"
+#include "bb/symmetry.h"
 #include <algorithm>
+#include <vector>
 
 namespace bb {
 
 Action randomPolicy(const GameState& state, DiceRollerBase& dice) {
-    std::vector<Action> actions;
-    getAvailableActions(state, actions);
+    ActionList scratch;
+    const ActionList& actions = decisionActions(state, scratch);
 
     if (actions.empty()) {
         return Action{ActionType::END_TURN, -1, -1, {-1, -1}};
@@ -25,8 +27,8 @@ Action randomPolicy(const GameState& state, DiceRollerBase& dice) {
 }
 
 Action greedyPolicy(const GameState& state, DiceRollerBase& dice) {
-    std::vector<Action> actions;
-    getAvailableActions(state, actions);
+    ActionList scratch;
+    const ActionList& actions = decisionActions(state, scratch);
 
     if (actions.empty()) {
         return Action{ActionType::END_TURN, -1, -1, {-1, -1}};
@@ -83,7 +85,7 @@ Action greedyPolicy(const GameState& state, DiceRollerBase& dice) {
     }
 
     // Priority 3: Block actions (build advantage)
-    std::vector<Action> blocks;
+    ActionList blocks;
     for (auto& a : actions) {
         if (a.type == ActionType::BLOCK) blocks.push_back(a);
     }
@@ -101,7 +103,7 @@ Action greedyPolicy(const GameState& state, DiceRollerBase& dice) {
     }
 
     // Priority 5: Move actions (non-carrier)
-    std::vector<Action> moves;
+    ActionList moves;
     for (auto& a : actions) {
         if (a.type == ActionType::MOVE) moves.push_back(a);
     }
@@ -119,8 +121,8 @@ Action greedyPolicy(const GameState& state, DiceRollerBase& dice) {
 
 Action learningPolicy(const GameState& state, DiceRollerBase& dice,
                       const ValueFunction& vf, float epsilon) {
-    std::vector<Action> actions;
-    getAvailableActions(state, actions);
+    ActionList scratch;
+    const ActionList& actions = decisionActions(state, scratch);
 
     if (actions.empty()) {
         return Action{ActionType::END_TURN, -1, -1, {-1, -1}};
@@ -135,22 +137,31 @@ Action learningPolicy(const GameState& state, DiceRollerBase& dice,
         return greedyPolicy(state, dice);
     }
 
-    // Value function evaluation for all decisions (no heuristic bootstrap)
+    // Value function evaluation for all decisions (no heuristic bootstrap):
+    // every successor encoded into one buffer, then a single batched call.
+    // One scratch state is overwritten per action instead of a clone each.
     TeamSide perspective = state.activeTeam;
-    float bestValue = -1e9f;
-    int bestIdx = 0;
-
-    for (int i = 0; i < static_cast<int>(actions.size()); i++) {
-        GameState clone = state.clone();
+    int n = static_cast<int>(actions.size());
+    int width = vf.inputSize();
+    thread_local std::vector<float> rows;
+    thread_local std::vector<float> values;
+    rows.resize(static_cast<size_t>(n) * width);
+    values.resize(n);
+
+    GameState successor;
+    for (int i = 0; i < n; i++) {
+        successor = state;
         DiceRoller simDice(static_cast<uint32_t>(i * 31 + 17));
-        executeAction(clone, actions[i], simDice, nullptr);
-
-        float features[NUM_FEATURES];
-        extractFeatures(clone, perspective, features);
-        float value = vf.evaluate(features, NUM_FEATURES);
+        executeAction(successor, actions[i], simDice, nullptr);
+        vf.encodeState(successor, perspective, rows.data() + static_cast<size_t>(i) * width);
+    }
+    vf.evaluateBatch(rows.data(), n, width, values.data());
 
-        if (value > bestValue) {
-            bestValue = value;
+    float bestValue = -1e9f;
+    int bestIdx = 0;
+    for (int i = 0; i < n; i++) {
+        if (values[i] > bestValue) {
+            bestValue = values[i];
             bestIdx = i;
         }
     }
@@ -158,53 +169,98 @@ Action learningPolicy(const GameState& state, DiceRollerBase& dice,
     return actions[bestIdx];
 }
 
+namespace {
+thread_local DecisionSearchScope* searchScope = nullptr;
+}
+
+DecisionSearchScope::DecisionSearchScope() : outer_(searchScope) {
+    searchScope = this;
+}
+
+DecisionSearchScope::~DecisionSearchScope() {
+    searchScope = outer_;
+}
+
+void DecisionSearchScope::report(DecisionSearch kind) {
+    if (searchScope) searchScope->kind_ = kind;
+}
+
+bool drawFullSearch(const MCTSConfig& config, FastDiceRoller& dice) {
+    if (config.fullSearchFraction >= 1.0f) return true;
+    double u = static_cast<double>(dice.next() >> 11) * 0x1.0p-53;
+    return u < config.fullSearchFraction;
+}
+
 MCTSPolicy::MCTSPolicy(const ValueFunction* vf, MCTSConfig config, uint32_t seed)
-    : search_(vf, config, seed) {}
+    : search_(vf, config, seed), capDice_(seed + 24691) {}
 
-void MCTSPolicy::setLogDecisions(bool log, int topK) {
+void MCTSPolicy::setLogDecisions(bool log, int topK, bool logBoards, bool logMirrored) {
     logDecisions_ = log;
     topK_ = topK;
+    logBoards_ = logBoards;
+    logMirrored_ = logMirrored;
 }
 
 Action MCTSPolicy::operator()(const GameState& state) {
-    Action result = search_.search(state);
+    bool full = drawFullSearch(search_.config(), capDice_);
+    Action result;
+    if (full) {
+        result = search_.search(state);
+    } else {
+        int timeBudgetMs = search_.config().timeBudgetMs;
+        int maxIterations = search_.config().maxIterations;
+        search_.setBudget(timeBudgetMs, std::min(search_.config().cheapSearchIterations, maxIterations));
+        result = search_.search(state);
+        search_.setBudget(timeBudgetMs, maxIterations);
+    }
+    DecisionSearchScope::report(full ? DecisionSearch::FULL : DecisionSearch::CHEAP);
 
     // Log decision if enabled
-    if (logDecisions_) {
+    if (logDecisions_ && full) {
         const auto& childVisits = search_.lastChildVisits();
-        if (!childVisits.empty()) {
-            PolicyDecision decision;
-
-            // Extract state features
-            extractFeatures(state, state.activeTeam, decision.stateFeatures);
-            decision.perspective = state.activeTeam;
-            decision.board = captureBoardSnapshot(state);
-
-            // Compute total visits for fraction calculation
-            int totalVisits = 0;
-            for (auto& cv : childVisits) {
-                totalVisits += cv.visits;
-            }
 
-            if (totalVisits > 0) {
-                // Sort by visits descending (copy to sort)
-                std::vector<ChildVisitInfo> sorted = childVisits;
-                std::sort(sorted.begin(), sorted.end(),
-                          [](const ChildVisitInfo& a, const ChildVisitInfo& b) {
-                              return a.visits > b.visits;
-                          });
+        // Compute total visits for fraction calculation
+        int totalVisits = 0;
+        for (auto& cv : childVisits) {
+            totalVisits += cv.visits;
+        }
+
+        if (totalVisits > 0) {
+            // Sort by visits descending (copy to sort)
+            std::vector<ChildVisitInfo> sorted = childVisits;
+            std::sort(sorted.begin(), sorted.end(),
+                      [](const ChildVisitInfo& a, const ChildVisitInfo& b) {
+                          return a.visits > b.visits;
+                      });
+            int k = std::min(topK_, static_cast<int>(sorted.size()));
+
+            // The decision as seen in `s`, `state` under `sym`
+            auto record = [&](const GameState& s, Symmetry sym) {
+                PolicyDecision decision;
+                extractFeatures(s, s.activeTeam, decision.stateFeatures);
+                decision.perspective = s.activeTeam;
+                if (logBoards_) decision.board = captureCompactBoardSnapshot(s);
+                decision.stateHash = s.hash();
+                decision.canonicalHash = canonicalHash(s);
+                decision.totalVisits = totalVisits;
+                decision.search = search_.lastStats();
+                decision.mirrored = sym.flipY;
 
                 // Take top-K
-                int k = std::min(topK_, static_cast<int>(sorted.size()));
+                std::vector<Action> logged(k);
+                std::vector<float> features(k * NUM_ACTION_FEATURES);
+                for (int i = 0; i < k; ++i) logged[i] = sym.apply(sorted[i].action);
+                extractActionFeatures(s, logged.data(), k, features.data());
                 for (int i = 0; i < k; ++i) {
                     PolicyDecision::ActionVisit av;
-                    extractActionFeatures(state, sorted[i].action, av.actionFeatures);
+                    std::copy_n(&features[i * NUM_ACTION_FEATURES], NUM_ACTION_FEATURES, av.actionFeatures);
                     av.visitFraction = static_cast<float>(sorted[i].visits) / totalVisits;
                     decision.visits.push_back(av);
                 }
-
                 decisions_.push_back(std::move(decision));
-            }
+            };
+            record(state, Symmetry{});
+            if (logMirrored_) record(transformed(state, Symmetry{true}), Symmetry{true});
         }
     }
 
@@ -1,9 +1,12 @@
 #include "bb/policy_network.h"
+#include "bb/weights_file.h"
+#include "bb/profile.h"
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <cmath>
 #include <algorithm>
 #include <numeric>
+#include <stdexcept>
 
 namespace bb {
 
@@ -20,46 +23,148 @@ PolicyNetwork::PolicyNetwork(std::vector<float> weights, float bias, float tempe
 PolicyNetwork::PolicyNetwork(std::vector<float> W1, std::vector<float> b1,
                               std::vector<float> W2, float b2,
                               int hiddenSize, float temperature)
+    : PolicyNetwork(std::shared_ptr<const float[]>(), std::move(b1), std::move(W2), b2,
+                    hiddenSize, temperature) {
+    auto owned = std::make_shared<std::vector<float>>(std::move(W1));
+    W1_ = std::shared_ptr<const float[]>(owned, owned->data());
+    buildInt8();
+}
+
+PolicyNetwork::PolicyNetwork(std::shared_ptr<const float[]> W1, std::vector<float> b1,
+                             std::vector<float> W2, float b2,
+                             int hiddenSize, float temperature)
     : neural_(true), hiddenSize_(hiddenSize),
       W1_(std::move(W1)), b1_(std::move(b1)), W2_(std::move(W2)),
-      b2_(b2), temperature_(temperature) {}
+      b2_(b2), temperature_(temperature) {
+    if (W1_) buildInt8();
+}
+
+PolicyNetwork::PolicyNetwork(std::shared_ptr<const Mlp> mlp, float temperature)
+    : mlp_(std::move(mlp)), temperature_(temperature) {
+    if (mlp_->inputSize() != POLICY_INPUT_SIZE || mlp_->outputSize() != 1) {
+        throw std::invalid_argument("PolicyNetwork: deep net must map POLICY_INPUT_SIZE inputs to one logit");
+    }
+}
+
+void PolicyNetwork::buildInt8() {
+    int H = hiddenSize_;
+    W1q_.assign(static_cast<size_t>(H) * POLICY_INPUT_SIZE, 0);
+    W1scale_.resize(H);
+    std::vector<float> column(POLICY_INPUT_SIZE);
+    for (int j = 0; j < H; ++j) {
+        for (int i = 0; i < POLICY_INPUT_SIZE; ++i) column[i] = W1_[i * H + j];
+        W1scale_[j] = quantizeSymmetric(column.data(), POLICY_INPUT_SIZE,
+                                        &W1q_[static_cast<size_t>(j) * POLICY_INPUT_SIZE]);
+    }
+}
 
 float PolicyNetwork::evaluateAction(const float* stateFeatures, const float* actionFeatures) const {
+    float logit;
+    evaluateActions(stateFeatures, actionFeatures, 1, &logit);
+    return logit;
+}
+
+// The input is [state | action], so either network splits into a state
+// term shared by every candidate and a per-action term. Neural:
+//   pre-activation = (b1 + state @ W1[state rows]) + action @ W1[action rows]
+// where the bracket is computed once and each candidate adds only its
+// 23 x H action block (skipping zero features, which most are).
+void PolicyNetwork::evaluateActions(const float* stateFeatures, const float* actionFeatures,
+                                    int numActions, float* outLogits) const {
+    BB_PROFILE_NAMED_SCOPE(profile, prof::POLICY_EVAL);
+    BB_PROFILE_UNITS(profile, numActions);
+    evaluateActionsWith(stateFeatures, actionFeatures, numActions, outLogits, int8_);
+}
+
+void PolicyNetwork::evaluateActionsWith(const float* stateFeatures, const float* actionFeatures,
+                                        int numActions, float* outLogits, bool useInt8) const {
+    if (numActions <= 0) return;
+
+    if (mlp_) {
+        // Same split on the first layer; the rest of the net runs per action
+        int H = mlp_->layer(0).outputs;
+        thread_local std::vector<float> statePart;
+        thread_local std::vector<float> first;
+        statePart.assign(mlp_->layer(0).bias.begin(), mlp_->layer(0).bias.end());
+        mlp_->accumulateFirst(stateFeatures, 0, NUM_FEATURES, statePart.data());
+        first.resize(H);
+        for (int a = 0; a < numActions; ++a) {
+            std::copy(statePart.begin(), statePart.end(), first.begin());
+            mlp_->accumulateFirst(&actionFeatures[a * NUM_ACTION_FEATURES], NUM_FEATURES,
+                                  NUM_ACTION_FEATURES, first.data());
+            if (mlp_->numLayers() == 1) {
+                outLogits[a] = first[0];
+                continue;
+            }
+            for (float& h : first) h = std::max(0.0f, h);  // ReLU
+            mlp_->forwardFrom(1, first.data(), &outLogits[a]);
+        }
+        return;
+    }
+
     if (!neural_) {
         // Linear: dot product
-        float logit = bias_;
         int nState = std::min(static_cast<int>(weights_.size()), NUM_FEATURES);
-        for (int i = 0; i < nState; ++i) {
-            logit += weights_[i] * stateFeatures[i];
-        }
+        float stateLogit = bias_ + dotProduct(weights_.data(), stateFeatures, nState);
         int nAction = std::min(static_cast<int>(weights_.size()) - NUM_FEATURES, NUM_ACTION_FEATURES);
-        for (int i = 0; i < nAction; ++i) {
-            logit += weights_[NUM_FEATURES + i] * actionFeatures[i];
+        for (int a = 0; a < numActions; ++a) {
+            outLogits[a] = stateLogit;
+            if (nAction > 0) {
+                outLogits[a] += dotProduct(&weights_[NUM_FEATURES],
+                                           &actionFeatures[a * NUM_ACTION_FEATURES], nAction);
+            }
         }
-        return logit;
+        return;
     }
 
-    // Neural: input(85) -> hidden(ReLU) -> output(1)
+    // Neural: input(POLICY_INPUT_SIZE) -> hidden(ReLU) -> output(1)
     int H = hiddenSize_;
-    float hidden[64]; // stack-allocate (max hidden size = 64)
-    H = std::min(H, 64);
+    thread_local std::vector<float> stateBlock;
+    thread_local std::vector<float> hidden;
 
-    for (int j = 0; j < H; ++j) {
-        float sum = b1_[j];
-        for (int i = 0; i < NUM_FEATURES; ++i) {
-            sum += stateFeatures[i] * W1_[i * H + j];
+    if (useInt8) {
+        // Same factorization; state and each action vector get their own
+        // activation scale.
+        int8_t sq[NUM_FEATURES];
+        int8_t aq[NUM_ACTION_FEATURES];
+        float sScale = quantizeSymmetric(stateFeatures, NUM_FEATURES, sq);
+        stateBlock.resize(H);
+        for (int j = 0; j < H; ++j) {
+            const int8_t* row = &W1q_[static_cast<size_t>(j) * POLICY_INPUT_SIZE];
+            stateBlock[j] = b1_[j] + static_cast<float>(dotInt8(row, sq, NUM_FEATURES)) *
+                                     sScale * W1scale_[j];
         }
-        for (int i = 0; i < NUM_ACTION_FEATURES; ++i) {
-            sum += actionFeatures[i] * W1_[(NUM_FEATURES + i) * H + j];
+        for (int a = 0; a < numActions; ++a) {
+            float aScale = quantizeSymmetric(&actionFeatures[a * NUM_ACTION_FEATURES],
+                                             NUM_ACTION_FEATURES, aq);
+            float out = b2_;
+            for (int j = 0; j < H; ++j) {
+                const int8_t* row = &W1q_[static_cast<size_t>(j) * POLICY_INPUT_SIZE + NUM_FEATURES];
+                float h = stateBlock[j] + static_cast<float>(dotInt8(row, aq, NUM_ACTION_FEATURES)) *
+                                          aScale * W1scale_[j];
+                out += std::max(0.0f, h) * W2_[j];  // ReLU
+            }
+            outLogits[a] = out;
         }
-        hidden[j] = std::max(0.0f, sum); // ReLU
+        return;
     }
 
-    float output = b2_;
-    for (int j = 0; j < H; ++j) {
-        output += hidden[j] * W2_[j];
+    stateBlock.assign(b1_.begin(), b1_.begin() + H);
+    for (int i = 0; i < NUM_FEATURES; ++i) {
+        if (stateFeatures[i] != 0.0f) addScaled(stateBlock.data(), &W1_[i * H], stateFeatures[i], H);
+    }
+
+    hidden.resize(H);
+    float* row = hidden.data();
+    for (int a = 0; a < numActions; ++a) {
+        const float* feats = &actionFeatures[a * NUM_ACTION_FEATURES];
+        std::copy(stateBlock.begin(), stateBlock.end(), row);
+        for (int k = 0; k < NUM_ACTION_FEATURES; ++k) {
+            if (feats[k] != 0.0f) addScaled(row, &W1_[(NUM_FEATURES + k) * H], feats[k], H);
+        }
+        for (int j = 0; j < H; ++j) row[j] = std::max(0.0f, row[j]);  // ReLU
+        outLogits[a] = b2_ + dotProduct(row, W2_.data(), H);
     }
-    return output;
 }
 
 void PolicyNetwork::computePriors(const float* stateFeatures, const float* actionFeatures,
@@ -72,10 +177,10 @@ void PolicyNetwork::computePriors(const float* stateFeatures, const float* actio
     }
 
     // Compute logits
+    evaluateActions(stateFeatures, actionFeatures, numActions, outPriors);
     float maxLogit = -1e30f;
     for (int i = 0; i < numActions; ++i) {
-        float logit = evaluateAction(stateFeatures, &actionFeatures[i * NUM_ACTION_FEATURES]);
-        outPriors[i] = logit / temperature_;
+        outPriors[i] /= temperature_;
         if (outPriors[i] > maxLogit) maxLogit = outPriors[i];
     }
 
@@ -99,9 +204,41 @@ void PolicyNetwork::computePriors(const float* stateFeatures, const float* actio
     }
 }
 
-std::unique_ptr<PolicyNetwork> loadPolicyNetwork(const std::string& jsonStr) {
+void PolicyNetwork::computePriorsBatch(const float* stateFeatures, int numStates,
+                                       const float* actionFeatures, const int* actionCounts,
+                                       float* outPriors) const {
+    size_t offset = 0;  // candidates before state s
+    for (int s = 0; s < numStates; ++s) {
+        computePriors(stateFeatures + static_cast<size_t>(s) * NUM_FEATURES,
+                      actionFeatures + offset * NUM_ACTION_FEATURES,
+                      actionCounts[s], outPriors + offset);
+        offset += std::max(0, actionCounts[s]);
+    }
+}
+
+QuantizationError PolicyNetwork::quantizationError(const float* stateFeatures,
+                                                   const float* actionFeatures, int count) const {
+    QuantizationError err;
+    for (int k = 0; k < count; ++k) {
+        const float* st = stateFeatures + static_cast<size_t>(k) * NUM_FEATURES;
+        const float* act = actionFeatures + static_cast<size_t>(k) * NUM_ACTION_FEATURES;
+        float exact, quantized;
+        evaluateActionsWith(st, act, 1, &exact, false);
+        evaluateActionsWith(st, act, 1, &quantized, neural_);
+        err.add(exact, quantized);
+    }
+    return err;
+}
+
+std::unique_ptr<PolicyNetwork> loadPolicyNetwork(const std::string& jsonStr, bool int8) {
     auto j = nlohmann::json::parse(jsonStr);
 
+    if (j.contains("policy_type") && j["policy_type"] == "mlp") {
+        return std::make_unique<PolicyNetwork>(
+            mlpFromJson(j["policy_layers"], j.value("policy_residual", false)),
+            j.value("policy_temperature", 1.0f));
+    }
+
     // Neural policy: has policy_type == "neural"
     if (j.contains("policy_type") && j["policy_type"] == "neural") {
         int hiddenSize = j["policy_hidden_size"].get<int>();
@@ -112,8 +249,10 @@ std::unique_ptr<PolicyNetwork> loadPolicyNetwork(const std::string& jsonStr) {
         float b2 = j.value("policy_b2", 0.0f);
         float temperature = j.value("policy_temperature", 1.0f);
 
-        return std::make_unique<PolicyNetwork>(
+        auto policy = std::make_unique<PolicyNetwork>(
             std::move(W1), std::move(b1), std::move(W2), b2, hiddenSize, temperature);
+        policy->setInt8(int8);
+        return policy;
     }
 
     // Linear policy: has policy_weights array
@@ -130,12 +269,13 @@ std::unique_ptr<PolicyNetwork> loadPolicyNetwork(const std::string& jsonStr) {
     return std::make_unique<PolicyNetwork>(std::move(weights), bias, temperature);
 }
 
-std::unique_ptr<PolicyNetwork> loadPolicyNetworkFromFile(const std::string& path) {
+std::unique_ptr<PolicyNetwork> loadPolicyNetworkFromFile(const std::string& path, bool int8) {
+    if (isWeightsFile(path)) return loadPolicyNetworkBinary(path, int8);
     std::ifstream file(path);
     if (!file.is_open()) return nullptr;
     std::string content((std::istreambuf_iterator<char>(file)),
                         std::istreambuf_iterator<char>());
-    return loadPolicyNetwork(content);
+    return loadPolicyNetwork(content, int8);
 }
 
 } // namespace bb
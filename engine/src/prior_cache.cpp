@@ -0,0 +1,79 @@
+#include "bb/prior_cache.h"
+
+namespace bb {
+
+PriorCache::PriorCache(size_t bytes) : budget_(bytes) {}
+
+size_t PriorCache::entryBytes(size_t macros) {
+    // The slot, its two arrays and a rough hash-map node
+    return sizeof(Entry) + macros * (sizeof(Macro) + sizeof(float)) + 32;
+}
+
+bool PriorCache::lookup(uint64_t key, MacroList& macros, std::vector<float>& priors) {
+    if (!enabled()) return false;
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        misses_++;
+        return false;
+    }
+    Entry& e = slots_[it->second];
+    e.referenced = true;
+    macros.assign(e.macros.data(), e.macros.data() + e.macros.size());
+    priors = e.priors;
+    hits_++;
+    return true;
+}
+
+void PriorCache::store(uint64_t key, const MacroList& macros, const std::vector<float>& priors) {
+    size_t need = entryBytes(macros.size());
+    if (!enabled() || need > budget_ || index_.count(key)) return;
+    while (used_ + need > budget_ && !index_.empty()) evictOne();
+
+    uint32_t slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+    Entry& e = slots_[slot];
+    e.key = key;
+    e.macros.assign(macros.begin(), macros.end());
+    e.priors = priors;
+    e.live = true;
+    e.referenced = false;
+    index_.emplace(key, slot);
+    used_ += need;
+}
+
+void PriorCache::evictOne() {
+    for (;;) {
+        if (hand_ >= slots_.size()) hand_ = 0;
+        Entry& e = slots_[hand_];
+        uint32_t slot = static_cast<uint32_t>(hand_++);
+        if (!e.live) continue;
+        if (e.referenced) {
+            e.referenced = false;
+            continue;
+        }
+        used_ -= entryBytes(e.macros.size());
+        index_.erase(e.key);
+        e.live = false;
+        e.macros.clear();
+        e.priors.clear();
+        freeSlots_.push_back(slot);
+        evictions_++;
+        return;
+    }
+}
+
+void PriorCache::clear() {
+    slots_.clear();
+    freeSlots_.clear();
+    index_.clear();
+    used_ = 0;
+    hand_ = 0;
+}
+
+} // namespace bb
@@ -0,0 +1,192 @@
+#include "bb/profile.h"
+#include "bb/enums.h"
+#include "bb/macro_actions.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+
+namespace bb {
+
+static_assert(prof::MACRO_TYPES == static_cast<int>(MacroType::MACRO_COUNT));
+static_assert(prof::ACTION_TYPES == static_cast<int>(ActionType::MOVE_PATH) + 1);
+
+namespace {
+
+#ifdef BB_PROFILE
+
+std::string slotName(int slot) {
+    static const char* const fixed[] = {
+        "getAvailableActions", "getAvailableMacros", "extractFeatures",
+        "valueEval", "policyEval", "macroReplayToNode", "actionReplayToNode",
+    };
+    if (slot < prof::EXPAND_MACRO) return fixed[slot];
+    if (slot < prof::EXECUTE_ACTION) {
+        return std::string("greedyExpandMacro.") +
+               macroTypeName(static_cast<MacroType>(slot - prof::EXPAND_MACRO));
+    }
+    return std::string("executeAction.") +
+           actionTypeName(static_cast<ActionType>(slot - prof::EXECUTE_ACTION));
+}
+
+// One thread's slots. Only the owning thread writes; snapshots read them
+// concurrently, hence relaxed atomics rather than plain integers.
+struct SlotCounters {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> ticks{0};
+    std::atomic<uint64_t> units{0};
+};
+
+struct ThreadProfile;
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadProfile*> live;
+    // Totals of threads that have exited
+    std::array<uint64_t, prof::NUM_SLOTS> retiredCalls{};
+    std::array<uint64_t, prof::NUM_SLOTS> retiredTicks{};
+    std::array<uint64_t, prof::NUM_SLOTS> retiredUnits{};
+};
+
+Registry& registry() {
+    static Registry* r = new Registry;  // outlives thread_local destructors
+    return *r;
+}
+
+struct ThreadProfile {
+    std::array<SlotCounters, prof::NUM_SLOTS> slots;
+
+    ThreadProfile() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.live.push_back(this);
+    }
+    ~ThreadProfile() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (int i = 0; i < prof::NUM_SLOTS; ++i) {
+            r.retiredCalls[i] += slots[i].calls.load(std::memory_order_relaxed);
+            r.retiredTicks[i] += slots[i].ticks.load(std::memory_order_relaxed);
+            r.retiredUnits[i] += slots[i].units.load(std::memory_order_relaxed);
+        }
+        r.live.erase(std::find(r.live.begin(), r.live.end(), this));
+    }
+};
+
+ThreadProfile& threadProfile() {
+    thread_local ThreadProfile profile;
+    return profile;
+}
+
+void bump(std::atomic<uint64_t>& c, uint64_t n) {
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+// Tick rate, measured against the steady clock since the first call.
+double secondsPerTick() {
+#if defined(__x86_64__) || defined(_M_X64)
+    using Clock = std::chrono::steady_clock;
+    static const Clock::time_point clock0 = Clock::now();
+    static const uint64_t ticks0 = profileTicks();
+    double elapsed = std::chrono::duration<double>(Clock::now() - clock0).count();
+    uint64_t ticks = profileTicks() - ticks0;
+    return (ticks > 0 && elapsed > 1e-3) ? elapsed / static_cast<double>(ticks) : 0.0;
+#else
+    return 1e-9;
+#endif
+}
+
+// Start the tick-rate baseline at load time so it is long by the first report.
+[[maybe_unused]] const double tickRateBaseline = secondsPerTick();
+
+#endif // BB_PROFILE
+
+} // anonymous namespace
+
+#ifdef BB_PROFILE
+
+void profileRecord(int slot, uint64_t ticks, uint64_t units) {
+    SlotCounters& s = threadProfile().slots[slot];
+    bump(s.calls, 1);
+    bump(s.ticks, ticks);
+    bump(s.units, units);
+}
+
+bool profileEnabled() { return true; }
+
+std::vector<ProfileEntry> profileSnapshot() {
+    std::array<uint64_t, prof::NUM_SLOTS> calls{}, ticks{}, units{};
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        calls = r.retiredCalls;
+        ticks = r.retiredTicks;
+        units = r.retiredUnits;
+        for (const ThreadProfile* t : r.live) {
+            for (int i = 0; i < prof::NUM_SLOTS; ++i) {
+                calls[i] += t->slots[i].calls.load(std::memory_order_relaxed);
+                ticks[i] += t->slots[i].ticks.load(std::memory_order_relaxed);
+                units[i] += t->slots[i].units.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    double spt = secondsPerTick();
+    std::vector<ProfileEntry> out;
+    for (int i = 0; i < prof::NUM_SLOTS; ++i) {
+        if (calls[i] == 0) continue;
+        out.push_back({slotName(i), calls[i], ticks[i], units[i],
+                       static_cast<double>(ticks[i]) * spt});
+    }
+    return out;
+}
+
+void profileReset() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.retiredCalls.fill(0);
+    r.retiredTicks.fill(0);
+    r.retiredUnits.fill(0);
+    for (ThreadProfile* t : r.live) {
+        for (SlotCounters& s : t->slots) {
+            s.calls.store(0, std::memory_order_relaxed);
+            s.ticks.store(0, std::memory_order_relaxed);
+            s.units.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+#else
+
+bool profileEnabled() { return false; }
+std::vector<ProfileEntry> profileSnapshot() { return {}; }
+void profileReset() {}
+
+#endif // BB_PROFILE
+
+std::string profileReport() {
+    if (!profileEnabled()) return "profiling disabled (build with -DBB_PROFILE=ON)\n";
+
+    std::vector<ProfileEntry> entries = profileSnapshot();
+    std::sort(entries.begin(), entries.end(), [](const ProfileEntry& a, const ProfileEntry& b) {
+        return a.ticks > b.ticks;
+    });
+
+    std::string out;
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-34s %12s %12s %10s %12s\n",
+                  "slot", "calls", "total ms", "us/call", "units");
+    out += line;
+    for (const ProfileEntry& e : entries) {
+        std::snprintf(line, sizeof(line), "%-34s %12llu %12.2f %10.3f %12llu\n",
+                      e.name.c_str(), static_cast<unsigned long long>(e.calls),
+                      e.seconds * 1e3, e.seconds * 1e6 / static_cast<double>(e.calls),
+                      static_cast<unsigned long long>(e.units));
+        out += line;
+    }
+    return out;
+}
+
+} // namespace bb
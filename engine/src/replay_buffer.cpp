@@ -0,0 +1,249 @@
+#include "bb/replay_buffer.h"
+#include "bb/mapped_file.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+
+namespace bb {
+
+namespace {
+
+double uniform01(Xoshiro256& rng) {
+    return static_cast<double>(rng.next() >> 11) * 0x1.0p-53;
+}
+
+} // anonymous namespace
+
+ReplayBuffer::ReplayBuffer(std::string dir, ReplayBufferConfig config)
+    : dir_(std::move(dir)), config_(config) {
+    if (config_.capacity == 0) throw std::invalid_argument("ReplayBuffer: capacity must be positive");
+    while (leaves_ < config_.capacity) leaves_ <<= 1;
+    tree_.assign(2 * leaves_, 0.0);
+    rng_.seed(config_.seed, 0, 0, 0);
+    refresh();
+}
+
+ReplayBuffer::~ReplayBuffer() {
+    stopPrefetch();
+}
+
+int ReplayBuffer::refresh() {
+    std::lock_guard<std::mutex> refreshing(refreshMutex_);
+
+    // Index lines in shard order, newer than the last one mapped
+    std::map<int, nlohmann::json> entries;
+    std::ifstream index(dir_ + "/index.jsonl");
+    std::string line;
+    while (std::getline(index, line)) {
+        auto entry = nlohmann::json::parse(line, nullptr, false);
+        if (entry.is_discarded()) continue;
+        int shard = entry.value("shard", -1);
+        if (shard > lastShard_) entries.emplace(shard, std::move(entry));
+    }
+
+    // Map outside the lock; sampling carries on meanwhile
+    std::vector<std::pair<int, MappedShard>> fresh;
+    for (const auto& [shard, entry] : entries) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/shard-%06d.states", shard);
+        std::string path = dir_ + name;
+        if (entry.value("zstd", false)) {
+            throw std::runtime_error("ReplayBuffer: " + path + " is compressed; only raw shards can be mapped");
+        }
+        MappedShard s;
+        s.file = std::make_shared<const MappedFile>(path);
+        s.count = entry.value("states", uint64_t{0});
+        ShardFileHeader h;
+        if (!s.file->ok() || s.file->size() < sizeof(h)) {
+            throw std::runtime_error("ReplayBuffer: cannot map " + path);
+        }
+        std::memcpy(&h, s.file->bytes(), sizeof(h));
+        if (h.magic != SHARD_FILE_MAGIC || h.version != SHARD_FILE_VERSION ||
+            h.kind != ShardKind::STATES || h.recordSize != sizeof(ShardStateRecord) ||
+            h.numFeatures != NUM_FEATURES ||
+            s.file->size() < sizeof(h) + s.count * sizeof(ShardStateRecord)) {
+            throw std::runtime_error("ReplayBuffer: " + path + " is not a matching state shard");
+        }
+        s.rows = reinterpret_cast<const ShardStateRecord*>(s.file->bytes() + sizeof(h));
+        fresh.emplace_back(shard, std::move(s));
+    }
+    if (fresh.empty()) return 0;
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    const uint64_t cap = config_.capacity;
+    for (auto& [shard, s] : fresh) {
+        s.firstId = total_;
+        total_ += s.count;
+        // Only the newest `cap` ids get a slot; each overwrites the id it evicts
+        double p = std::pow(maxPriority_, static_cast<double>(config_.alpha));
+        for (uint64_t id = std::max(s.firstId, total_ > cap ? total_ - cap : 0); id < total_; ++id) {
+            setPriority(id % cap, p);
+        }
+        shards_.push_back(std::move(s));
+        lastShard_ = shard;
+    }
+    uint64_t base = total_ - std::min(total_, cap);
+    while (!shards_.empty() && shards_.front().firstId + shards_.front().count <= base) {
+        shards_.pop_front();
+    }
+    return static_cast<int>(fresh.size());
+}
+
+uint64_t ReplayBuffer::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return std::min(total_, config_.capacity);
+}
+
+uint64_t ReplayBuffer::totalAdded() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return total_;
+}
+
+void ReplayBuffer::setPriority(uint64_t slot, double p) {
+    uint64_t i = leaves_ + slot;
+    tree_[i] = p;
+    // Re-sum the path rather than adding deltas, so rounding cannot drift
+    for (i >>= 1; i > 0; i >>= 1) tree_[i] = tree_[2 * i] + tree_[2 * i + 1];
+}
+
+uint64_t ReplayBuffer::slotId(uint64_t slot) const {
+    const uint64_t cap = config_.capacity;
+    uint64_t base = total_ - std::min(total_, cap);
+    return base + (slot + cap - base % cap) % cap;
+}
+
+const ShardStateRecord& ReplayBuffer::record(uint64_t id) const {
+    auto it = std::upper_bound(shards_.begin(), shards_.end(), id,
+                               [](uint64_t v, const MappedShard& s) { return v < s.firstId; });
+    const MappedShard& s = *(it - 1);
+    return s.rows[id - s.firstId];
+}
+
+void ReplayBuffer::fill(ReplayBatch& batch, int batchSize, bool prioritized, Xoshiro256& rng) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    uint64_t n = std::min(total_, config_.capacity);
+    if (n == 0) throw std::runtime_error("ReplayBuffer: empty");
+    uint64_t base = total_ - n;
+
+    batch.size = batchSize;
+    batch.features.resize(static_cast<size_t>(batchSize) * NUM_FEATURES);
+    batch.outcomes.resize(batchSize);
+    batch.weights.assign(batchSize, 1.0f);
+    batch.ids.resize(batchSize);
+    batch.perspectives.resize(batchSize);
+
+    const double total = tree_[1];
+    const double segment = total / batchSize;
+    double maxWeight = 0.0;
+    for (int i = 0; i < batchSize; ++i) {
+        uint64_t id = base + rng.next() % n;
+        if (prioritized && total > 0.0) {
+            // One draw per equal slice of the priority mass (stratified)
+            double u = (i + uniform01(rng)) * segment;
+            uint64_t node = 1;
+            while (node < leaves_) {
+                double left = tree_[2 * node];
+                if (u < left) {
+                    node = 2 * node;
+                } else {
+                    u -= left;
+                    node = 2 * node + 1;
+                }
+            }
+            // Rounding can land on an empty leaf; keep the uniform draw then
+            if (tree_[node] > 0.0 && node - leaves_ < config_.capacity) {
+                id = slotId(node - leaves_);
+                double w = std::pow(static_cast<double>(n) * tree_[node] / total,
+                                    -static_cast<double>(config_.beta));
+                batch.weights[i] = static_cast<float>(w);
+                maxWeight = std::max(maxWeight, w);
+            }
+        }
+        const ShardStateRecord& r = record(id);
+        std::copy(r.features, r.features + NUM_FEATURES, batch.features.begin() + static_cast<size_t>(i) * NUM_FEATURES);
+        batch.outcomes[i] = r.outcome;
+        batch.ids[i] = id;
+        batch.perspectives[i] = r.perspective;
+    }
+    if (maxWeight > 0.0) {
+        for (float& w : batch.weights) w = static_cast<float>(std::min(1.0, w / maxWeight));
+    }
+}
+
+ReplayBatch ReplayBuffer::sample(int batchSize, bool prioritized) {
+    if (batchSize <= 0) throw std::invalid_argument("ReplayBuffer: batch size must be positive");
+    ReplayBatch batch;
+    std::lock_guard<std::mutex> lock(sampleMutex_);
+    fill(batch, batchSize, prioritized, rng_);
+    return batch;
+}
+
+void ReplayBuffer::updatePriorities(const uint64_t* ids, const float* priorities, size_t n) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    uint64_t base = total_ - std::min(total_, config_.capacity);
+    for (size_t i = 0; i < n; ++i) {
+        if (ids[i] < base || ids[i] >= total_) continue;
+        double p = std::max(static_cast<double>(priorities[i]), 1e-6);
+        maxPriority_ = std::max(maxPriority_, p);
+        setPriority(ids[i] % config_.capacity, std::pow(p, static_cast<double>(config_.alpha)));
+    }
+}
+
+void ReplayBuffer::startPrefetch(int batchSize, bool prioritized, int threads, int depth) {
+    if (batchSize <= 0 || threads <= 0 || depth <= 0) {
+        throw std::invalid_argument("ReplayBuffer: prefetch sizes must be positive");
+    }
+    if (!prefetchers_.empty()) throw std::runtime_error("ReplayBuffer: prefetch already running");
+    if (size() == 0) throw std::runtime_error("ReplayBuffer: empty");
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        stopping_ = false;
+        depth_ = static_cast<size_t>(depth);
+        queue_.clear();
+    }
+    for (int t = 0; t < threads; ++t) {
+        prefetchers_.emplace_back(&ReplayBuffer::prefetchLoop, this, t, batchSize, prioritized);
+    }
+}
+
+void ReplayBuffer::prefetchLoop(int thread, int batchSize, bool prioritized) {
+    Xoshiro256 rng;
+    rng.seed(config_.seed, 1, 0, static_cast<uint64_t>(thread));
+    for (;;) {
+        ReplayBatch batch;
+        fill(batch, batchSize, prioritized, rng);
+        std::unique_lock<std::mutex> lock(queueMutex_);
+        queueChanged_.wait(lock, [&] { return stopping_ || queue_.size() < depth_; });
+        if (stopping_) return;
+        queue_.push_back(std::move(batch));
+        queueChanged_.notify_all();
+    }
+}
+
+ReplayBatch ReplayBuffer::nextBatch() {
+    if (prefetchers_.empty()) throw std::runtime_error("ReplayBuffer: prefetch is not running");
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    queueChanged_.wait(lock, [&] { return !queue_.empty(); });
+    ReplayBatch batch = std::move(queue_.front());
+    queue_.pop_front();
+    queueChanged_.notify_all();
+    return batch;
+}
+
+void ReplayBuffer::stopPrefetch() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        stopping_ = true;
+    }
+    queueChanged_.notify_all();
+    for (std::thread& t : prefetchers_) t.join();
+    prefetchers_.clear();
+    queue_.clear();
+}
+
+} // namespace bb
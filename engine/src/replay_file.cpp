@@ -0,0 +1,467 @@
+#include "bb/replay_file.h"
+#include "bb/alloc_tracking.h"
+#include "bb/roster.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+
+namespace bb {
+
+namespace {
+
+constexpr uint64_t REPLAY_ALIGN = 8;
+constexpr int MAX_REPLAY_PLAYER_ID = 127;
+
+uint64_t alignUp(uint64_t v) {
+    return (v + REPLAY_ALIGN - 1) & ~(REPLAY_ALIGN - 1);
+}
+
+bool fitsInt8(int v) { return v >= -128 && v <= 127; }
+bool fitsUint8(int v) { return v >= 0 && v <= 255; }
+
+bool packSquare(Position p, uint32_t& out) {
+    if (p.x < -1 || p.x > 62 || p.y < -1 || p.y > 62) return false;
+    out = static_cast<uint32_t>(p.x + 1) | static_cast<uint32_t>(p.y + 1) << 6;
+    return true;
+}
+
+Position unpackSquare(uint32_t s) {
+    return {static_cast<int8_t>(static_cast<int>(s & 63) - 1),
+            static_cast<int8_t>(static_cast<int>(s >> 6 & 63) - 1)};
+}
+
+// Same players, in the same order: the previous turn's records can be
+// patched in place.
+bool sameLineup(const std::vector<PlayerSnapshot>& a, const std::vector<PlayerSnapshot>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].id != b[i].id) return false;
+    }
+    return true;
+}
+
+bool samePlacement(const PlayerSnapshot& a, const PlayerSnapshot& b) {
+    return a.x == b.x && a.y == b.y && a.state == b.state && a.hasBall == b.hasBall;
+}
+
+ReplayPlayerRecord playerRecord(const PlayerSnapshot& p, int side) {
+    ReplayPlayerRecord r;
+    r.id = static_cast<int8_t>(p.id);
+    r.x = p.x;
+    r.y = p.y;
+    r.flags = static_cast<uint8_t>((p.state & 3) | (p.hasBall ? 4 : 0) | side << 3);
+    return r;
+}
+
+void applyRecord(const ReplayPlayerRecord& r, PlayerSnapshot& p) {
+    p.id = r.id;
+    p.x = r.x;
+    p.y = r.y;
+    p.state = r.flags & 3;
+    p.hasBall = (r.flags & 4) != 0;
+}
+
+template<typename T>
+void writeSection(std::ofstream& out, uint64_t& pos, uint64_t offset, const T* data, size_t count) {
+    static const char zeros[REPLAY_ALIGN] = {};
+    out.write(zeros, static_cast<std::streamsize>(offset - pos));
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+    pos = offset + count * sizeof(T);
+}
+
+} // anonymous namespace
+
+bool writeReplay(const std::string& path, const std::vector<TurnLog>& turns,
+                 const std::vector<GameEvent>& arena, const ReplayInfo& info) {
+    BB_ALLOC_SCOPE(alloc::LOGGING);
+    std::vector<ReplayTurnRecord> turnRecords;
+    std::vector<ReplayPlayerRecord> players;
+    std::vector<ReplayEventRecord> events;
+    std::vector<ReplayRosterRecord> roster;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint16_t> nameIndex;
+    bool named[2][MAX_REPLAY_PLAYER_ID + 1] = {};
+
+    turnRecords.reserve(turns.size());
+    for (size_t i = 0; i < turns.size(); ++i) {
+        const TurnLog& t = turns[i];
+        const TurnLog* prev = i > 0 ? &turns[i - 1] : nullptr;
+        if (!fitsUint8(t.half) || !fitsUint8(t.turnNumber) || !fitsUint8(t.homeScore) ||
+            !fitsUint8(t.awayScore) || !fitsInt8(t.ballCarrierId)) return false;
+
+        ReplayTurnRecord rec;
+        rec.half = static_cast<uint8_t>(t.half);
+        rec.turnNumber = static_cast<uint8_t>(t.turnNumber);
+        rec.ballX = t.ballX;
+        rec.ballY = t.ballY;
+        rec.ballCarrierId = static_cast<int8_t>(t.ballCarrierId);
+        rec.homeScore = static_cast<uint8_t>(t.homeScore);
+        rec.awayScore = static_cast<uint8_t>(t.awayScore);
+        bool keyframe = !prev || i % REPLAY_KEYFRAME_INTERVAL == 0 ||
+                        !sameLineup(prev->homePlayers, t.homePlayers) ||
+                        !sameLineup(prev->awayPlayers, t.awayPlayers);
+        rec.flags = static_cast<uint8_t>(
+            (t.activeTeam == TeamSide::AWAY ? ReplayTurnRecord::AWAY_ACTIVE : 0) |
+            (t.turnover ? ReplayTurnRecord::TURNOVER : 0) |
+            (t.touchdown ? ReplayTurnRecord::TOUCHDOWN : 0) |
+            (keyframe ? ReplayTurnRecord::KEYFRAME : 0) |
+            (t.ballHeld ? ReplayTurnRecord::BALL_HELD : 0));
+        rec.firstPlayer = static_cast<uint32_t>(players.size());
+        rec.firstEvent = static_cast<uint32_t>(events.size());
+
+        for (int side = 0; side < 2; ++side) {
+            const auto& list = side == 0 ? t.homePlayers : t.awayPlayers;
+            for (size_t k = 0; k < list.size(); ++k) {
+                const PlayerSnapshot& p = list[k];
+                if (p.id < 0 || p.id > MAX_REPLAY_PLAYER_ID) return false;
+                if (!p.name.empty() && !named[side][p.id]) {
+                    auto [it, added] = nameIndex.try_emplace(p.name, static_cast<uint16_t>(names.size()));
+                    if (added) {
+                        if (names.size() > UINT16_MAX) return false;
+                        names.push_back(p.name);
+                    }
+                    roster.push_back({static_cast<uint8_t>(side), static_cast<int8_t>(p.id), it->second});
+                    named[side][p.id] = true;
+                }
+                if (keyframe || !samePlacement((side == 0 ? prev->homePlayers : prev->awayPlayers)[k], p)) {
+                    players.push_back(playerRecord(p, side));
+                }
+            }
+        }
+
+        if (static_cast<size_t>(t.firstEvent) + t.numEvents > arena.size()) return false;
+        for (const GameEvent& ev : turnEvents(arena, t)) {
+            uint32_t from, to;
+            if (!fitsInt8(ev.playerId) || !fitsInt8(ev.targetId) || !fitsInt8(ev.roll) ||
+                ev.die1 < 0 || ev.die1 > 7 || ev.die2 < 0 || ev.die2 > 7 ||
+                !packSquare(ev.from, from) || !packSquare(ev.to, to)) return false;
+            ReplayEventRecord r;
+            r.type = static_cast<uint8_t>(ev.type);
+            r.flags = static_cast<uint8_t>((ev.success ? 1 : 0) | ev.die1 << 1 | ev.die2 << 4);
+            r.playerId = static_cast<int8_t>(ev.playerId);
+            r.targetId = static_cast<int8_t>(ev.targetId);
+            r.roll = static_cast<int8_t>(ev.roll);
+            uint32_t squares = from | to << 12;
+            r.squares[0] = static_cast<uint8_t>(squares);
+            r.squares[1] = static_cast<uint8_t>(squares >> 8);
+            r.squares[2] = static_cast<uint8_t>(squares >> 16);
+            events.push_back(r);
+        }
+        turnRecords.push_back(rec);
+    }
+
+    std::vector<uint32_t> nameOffsets{0};
+    std::string nameBytes;
+    for (const std::string& n : names) {
+        nameBytes += n;
+        nameOffsets.push_back(static_cast<uint32_t>(nameBytes.size()));
+    }
+
+    ReplayFileHeader h;
+    h.numTurns = static_cast<uint32_t>(turnRecords.size());
+    h.numPlayers = static_cast<uint32_t>(players.size());
+    h.numEvents = static_cast<uint32_t>(events.size());
+    h.numRoster = static_cast<uint32_t>(roster.size());
+    h.numNames = static_cast<uint32_t>(names.size());
+    h.metadataBytes = static_cast<uint32_t>(info.metadata.size());
+    h.homeScore = info.homeScore;
+    h.awayScore = info.awayScore;
+    h.turnsOffset = alignUp(sizeof(h));
+    h.playersOffset = alignUp(h.turnsOffset + turnRecords.size() * sizeof(ReplayTurnRecord));
+    h.eventsOffset = alignUp(h.playersOffset + players.size() * sizeof(ReplayPlayerRecord));
+    h.rosterOffset = alignUp(h.eventsOffset + events.size() * sizeof(ReplayEventRecord));
+    h.namesOffset = alignUp(h.rosterOffset + roster.size() * sizeof(ReplayRosterRecord));
+    h.metadataOffset = alignUp(h.namesOffset + nameOffsets.size() * sizeof(uint32_t) + nameBytes.size());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+    uint64_t pos = 0;
+    writeSection(out, pos, 0, &h, 1);
+    writeSection(out, pos, h.turnsOffset, turnRecords.data(), turnRecords.size());
+    writeSection(out, pos, h.playersOffset, players.data(), players.size());
+    writeSection(out, pos, h.eventsOffset, events.data(), events.size());
+    writeSection(out, pos, h.rosterOffset, roster.data(), roster.size());
+    writeSection(out, pos, h.namesOffset, nameOffsets.data(), nameOffsets.size());
+    writeSection(out, pos, pos, nameBytes.data(), nameBytes.size());
+    writeSection(out, pos, h.metadataOffset, info.metadata.data(), info.metadata.size());
+    return static_cast<bool>(out);
+}
+
+// --- ReplayReader ---
+
+std::unique_ptr<ReplayReader> ReplayReader::open(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return nullptr;
+    std::unique_ptr<ReplayReader> reader(new ReplayReader());
+    reader->bytes_.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reader->bytes_.data(), static_cast<std::streamsize>(reader->bytes_.size())) ||
+        !reader->parse()) return nullptr;
+    return reader;
+}
+
+bool ReplayReader::parse() {
+    if (bytes_.size() < sizeof(header_)) return false;
+    std::memcpy(&header_, bytes_.data(), sizeof(header_));
+    const ReplayFileHeader& h = header_;
+    if (h.magic != REPLAY_FILE_MAGIC || h.version != REPLAY_FILE_VERSION) return false;
+    auto fits = [&](uint64_t offset, uint64_t count, uint64_t size) {
+        return offset % REPLAY_ALIGN == 0 && offset <= bytes_.size() &&
+               count <= (bytes_.size() - offset) / size;
+    };
+    if (!fits(h.turnsOffset, h.numTurns, sizeof(ReplayTurnRecord)) ||
+        !fits(h.playersOffset, h.numPlayers, sizeof(ReplayPlayerRecord)) ||
+        !fits(h.eventsOffset, h.numEvents, sizeof(ReplayEventRecord)) ||
+        !fits(h.rosterOffset, h.numRoster, sizeof(ReplayRosterRecord)) ||
+        !fits(h.namesOffset, uint64_t{h.numNames} + 1, sizeof(uint32_t)) ||
+        !fits(h.metadataOffset, h.metadataBytes, 1)) return false;
+
+    // Turn index: record ranges must be ordered and start on a keyframe
+    for (int i = 0; i < numTurns(); ++i) {
+        const ReplayTurnRecord& t = turnRecord(i);
+        if (t.firstPlayer > endPlayer(i) || endPlayer(i) > h.numPlayers ||
+            t.firstEvent > endEvent(i) || endEvent(i) > h.numEvents) return false;
+        if (i == 0 && !(t.flags & ReplayTurnRecord::KEYFRAME)) return false;
+    }
+
+    const uint32_t* offsets = reinterpret_cast<const uint32_t*>(&bytes_[h.namesOffset]);
+    uint64_t chars = h.namesOffset + (uint64_t{h.numNames} + 1) * sizeof(uint32_t);
+    if (offsets[0] != 0 || offsets[h.numNames] > bytes_.size() - chars) return false;
+    names_.reserve(h.numNames);
+    for (uint32_t n = 0; n < h.numNames; ++n) {
+        if (offsets[n + 1] < offsets[n]) return false;
+        names_.emplace_back(&bytes_[chars + offsets[n]], offsets[n + 1] - offsets[n]);
+    }
+
+    const auto* roster = reinterpret_cast<const ReplayRosterRecord*>(&bytes_[h.rosterOffset]);
+    for (uint32_t r = 0; r < h.numRoster; ++r) {
+        if (roster[r].side > 1 || roster[r].id < 0 || roster[r].name >= h.numNames) return false;
+        auto& byId = rosterNames_[roster[r].side];
+        if (byId.size() <= static_cast<size_t>(roster[r].id)) byId.resize(roster[r].id + 1, 0);
+        byId[roster[r].id] = static_cast<uint16_t>(roster[r].name + 1);
+    }
+
+    info_.homeScore = h.homeScore;
+    info_.awayScore = h.awayScore;
+    info_.metadata.assign(bytes_.data() + h.metadataOffset, h.metadataBytes);
+    return true;
+}
+
+const ReplayTurnRecord& ReplayReader::turnRecord(int i) const {
+    return reinterpret_cast<const ReplayTurnRecord*>(&bytes_[header_.turnsOffset])[i];
+}
+
+uint32_t ReplayReader::endPlayer(int i) const {
+    return i + 1 < numTurns() ? turnRecord(i + 1).firstPlayer : header_.numPlayers;
+}
+
+uint32_t ReplayReader::endEvent(int i) const {
+    return i + 1 < numTurns() ? turnRecord(i + 1).firstEvent : header_.numEvents;
+}
+
+void ReplayReader::applyPlayers(int i, TurnLog& log) const {
+    const auto* records = reinterpret_cast<const ReplayPlayerRecord*>(&bytes_[header_.playersOffset]);
+    bool keyframe = turnRecord(i).flags & ReplayTurnRecord::KEYFRAME;
+    if (keyframe) {
+        log.homePlayers.clear();
+        log.awayPlayers.clear();
+    }
+    for (uint32_t r = turnRecord(i).firstPlayer; r < endPlayer(i); ++r) {
+        int side = records[r].flags >> 3 & 1;
+        auto& list = side == 0 ? log.homePlayers : log.awayPlayers;
+        if (keyframe) {
+            PlayerSnapshot p;
+            applyRecord(records[r], p);
+            const auto& byId = rosterNames_[side];
+            if (p.id >= 0 && static_cast<size_t>(p.id) < byId.size() && byId[p.id] > 0) {
+                p.name = names_[byId[p.id] - 1];
+            }
+            list.push_back(std::move(p));
+            continue;
+        }
+        auto it = std::find_if(list.begin(), list.end(),
+                               [&](const PlayerSnapshot& p) { return p.id == records[r].id; });
+        if (it != list.end()) applyRecord(records[r], *it);
+    }
+}
+
+void ReplayReader::fillTurn(int i, TurnLog& log, std::vector<GameEvent>& events) const {
+    const ReplayTurnRecord& t = turnRecord(i);
+    log.half = t.half;
+    log.turnNumber = t.turnNumber;
+    log.activeTeam = (t.flags & ReplayTurnRecord::AWAY_ACTIVE) ? TeamSide::AWAY : TeamSide::HOME;
+    log.homeScore = t.homeScore;
+    log.awayScore = t.awayScore;
+    log.ballX = t.ballX;
+    log.ballY = t.ballY;
+    log.ballHeld = (t.flags & ReplayTurnRecord::BALL_HELD) != 0;
+    log.ballCarrierId = t.ballCarrierId;
+    log.turnover = (t.flags & ReplayTurnRecord::TURNOVER) != 0;
+    log.touchdown = (t.flags & ReplayTurnRecord::TOUCHDOWN) != 0;
+
+    const auto* records = reinterpret_cast<const ReplayEventRecord*>(&bytes_[header_.eventsOffset]);
+    log.firstEvent = static_cast<uint32_t>(events.size());
+    log.numEvents = endEvent(i) - t.firstEvent;
+    events.reserve(events.size() + log.numEvents);
+    for (uint32_t e = t.firstEvent; e < endEvent(i); ++e) {
+        const ReplayEventRecord& r = records[e];
+        GameEvent ev;
+        ev.type = static_cast<GameEvent::Type>(r.type);
+        ev.playerId = r.playerId;
+        ev.targetId = r.targetId;
+        uint32_t squares = r.squares[0] | r.squares[1] << 8 | static_cast<uint32_t>(r.squares[2]) << 16;
+        ev.from = unpackSquare(squares & 0xfff);
+        ev.to = unpackSquare(squares >> 12);
+        ev.roll = r.roll;
+        ev.success = (r.flags & 1) != 0;
+        ev.die1 = r.flags >> 1 & 7;
+        ev.die2 = r.flags >> 4 & 7;
+        events.push_back(ev);
+    }
+}
+
+TurnLog ReplayReader::turn(int index, std::vector<GameEvent>& events) const {
+    int k = index;
+    while (k > 0 && !(turnRecord(k).flags & ReplayTurnRecord::KEYFRAME)) --k;
+    TurnLog log;
+    for (int i = k; i <= index; ++i) applyPlayers(i, log);
+    events.clear();
+    fillTurn(index, log, events);
+    return log;
+}
+
+std::vector<TurnLog> ReplayReader::turns(std::vector<GameEvent>& events) const {
+    std::vector<TurnLog> out;
+    out.reserve(numTurns());
+    events.clear();
+    events.reserve(header_.numEvents);
+    TurnLog board;
+    for (int i = 0; i < numTurns(); ++i) {
+        applyPlayers(i, board);
+        out.push_back(board);
+        fillTurn(i, out.back(), events);
+    }
+    return out;
+}
+
+// --- Game records ---
+
+namespace {
+
+struct GameRecordHeader {
+    uint32_t magic = GAME_RECORD_MAGIC;
+    uint32_t version = GAME_RECORD_VERSION;
+    uint32_t numActions = 0;
+    uint32_t numDice = 0;
+    uint32_t useFullKickoff = 0;
+    uint32_t adjudicate = 0;  // 0 in files from before adjudication, which played it out
+};
+
+struct GameRecordRoster {
+    char name[32] = {};
+    int32_t positionalCount = 0;
+    int32_t rerollCost = 0;
+    int32_t hasApothecary = 0;
+    // ROSTER_REGISTRY_VERSION << 8 | RosterId for a built-in roster, else 0
+    // (custom rosters, files from before the registry)
+    uint32_t registryId = 0;
+    PlayerTemplate positionals[8] = {};
+};
+static_assert(std::is_trivially_copyable_v<PlayerTemplate>);
+
+struct GameRecordAction {
+    uint8_t type;
+    int8_t playerId;
+    int8_t targetId;
+    int8_t x;
+    int8_t y;
+};
+static_assert(sizeof(GameRecordAction) == 5);
+
+GameRecordRoster packRoster(const TeamRoster& r) {
+    GameRecordRoster out;
+    if (r.name) std::strncpy(out.name, r.name, sizeof(out.name) - 1);
+    out.positionalCount = r.positionalCount;
+    out.rerollCost = r.rerollCost;
+    out.hasApothecary = r.hasApothecary ? 1 : 0;
+    RosterId id = rosterIdOf(r);
+    if (id != INVALID_ROSTER) out.registryId = ROSTER_REGISTRY_VERSION << 8 | id;
+    std::copy(std::begin(r.positionals), std::end(r.positionals), out.positionals);
+    return out;
+}
+
+bool unpackRoster(const GameRecordRoster& in, TeamRoster& r) {
+    if (in.positionalCount < 0 || in.positionalCount > 8) return false;
+    // The name pointer must outlive the record: borrow the built-in roster's
+    const TeamRoster* known = in.registryId >> 8 == ROSTER_REGISTRY_VERSION
+        ? rosterById(static_cast<RosterId>(in.registryId & 0xFF))
+        : nullptr;
+    if (!known) known = getRosterByName(std::string(in.name, strnlen(in.name, sizeof(in.name))));
+    r.name = known ? known->name : "custom";
+    r.positionalCount = in.positionalCount;
+    r.rerollCost = in.rerollCost;
+    r.hasApothecary = in.hasApothecary != 0;
+    std::copy(std::begin(in.positionals), std::end(in.positionals), r.positionals);
+    return true;
+}
+
+} // anonymous namespace
+
+bool writeGameRecord(const std::string& path, const GameRecord& record) {
+    std::vector<GameRecordAction> actions;
+    actions.reserve(record.actions.size());
+    for (const Action& a : record.actions) {
+        if (!fitsInt8(a.playerId) || !fitsInt8(a.targetId)) return false;
+        actions.push_back({static_cast<uint8_t>(a.type), static_cast<int8_t>(a.playerId),
+                           static_cast<int8_t>(a.targetId), a.target.x, a.target.y});
+    }
+    GameRecordHeader h;
+    h.numActions = static_cast<uint32_t>(actions.size());
+    h.numDice = static_cast<uint32_t>(record.dice.size());
+    h.useFullKickoff = record.useFullKickoff ? 1 : 0;
+    h.adjudicate = record.adjudicate ? 1 : 0;
+    GameRecordRoster rosters[2] = {packRoster(record.home), packRoster(record.away)};
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(rosters), sizeof(rosters));
+    out.write(reinterpret_cast<const char*>(actions.data()),
+              static_cast<std::streamsize>(actions.size() * sizeof(GameRecordAction)));
+    out.write(reinterpret_cast<const char*>(record.dice.data()),
+              static_cast<std::streamsize>(record.dice.size()));
+    return static_cast<bool>(out);
+}
+
+std::unique_ptr<GameRecord> readGameRecord(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return nullptr;
+    uint64_t size = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+    GameRecordHeader h;
+    GameRecordRoster rosters[2];
+    if (!file.read(reinterpret_cast<char*>(&h), sizeof(h)) ||
+        h.magic != GAME_RECORD_MAGIC || h.version != GAME_RECORD_VERSION ||
+        size != sizeof(h) + sizeof(rosters) + uint64_t{h.numActions} * sizeof(GameRecordAction) + h.numDice ||
+        !file.read(reinterpret_cast<char*>(rosters), sizeof(rosters))) return nullptr;
+
+    auto record = std::make_unique<GameRecord>();
+    if (!unpackRoster(rosters[0], record->home) || !unpackRoster(rosters[1], record->away)) return nullptr;
+    record->useFullKickoff = h.useFullKickoff != 0;
+    record->adjudicate = h.adjudicate != 0;
+    std::vector<GameRecordAction> actions(h.numActions);
+    record->dice.resize(h.numDice);
+    if (!file.read(reinterpret_cast<char*>(actions.data()),
+                   static_cast<std::streamsize>(actions.size() * sizeof(GameRecordAction))) ||
+        !file.read(reinterpret_cast<char*>(record->dice.data()),
+                   static_cast<std::streamsize>(record->dice.size()))) return nullptr;
+    record->actions.reserve(actions.size());
+    for (const GameRecordAction& a : actions) {
+        record->actions.push_back({static_cast<ActionType>(a.type), a.playerId, a.targetId, {a.x, a.y}});
+    }
+    return record;
+}
+
+} // namespace bb
@@ -0,0 +1,144 @@
+#include "bb/risk_oracle.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace bb {
+
+namespace {
+
+// A roll's table category: (target - 2) * 2 + skill, 0..9
+constexpr int CATEGORIES = 10;
+
+int category(const RiskRoll& r) {
+    return (std::clamp(r.target, 2, 6) - 2) * 2 + (r.skillReroll ? 1 : 0);
+}
+
+int flagIndex(RerollAccess a) {
+    return (a.team ? 1 : 0) | (a.pro ? 2 : 0) | (a.loner ? 4 : 0);
+}
+
+// Forward pass over the rolls, tracking the chance of having passed them
+// all so far with each combination of Pro and team reroll still unused
+float chainChance(const int* categories, int count, RerollAccess access) {
+    double w[2][2] = {};  // [pro left][team reroll left]
+    w[access.pro][access.team] = 1.0;
+    const double lonerGate = access.loner ? 0.5 : 1.0;
+    for (int i = 0; i < count; ++i) {
+        const double p = (5 - categories[i] / 2) / 6.0;
+        const bool skill = (categories[i] & 1) != 0;
+        const double pass = skill ? p + (1.0 - p) * p : p;
+        const double fail = 1.0 - pass;
+        double next[2][2] = {};
+        for (int pro = 0; pro < 2; ++pro) {
+            for (int team = 0; team < 2; ++team) {
+                const double m = w[pro][team];
+                if (m == 0.0) continue;
+                next[pro][team] += m * pass;
+                if (pro) {
+                    // Pro is spent either way; on a failed gate or reroll
+                    // the team reroll gets its turn
+                    next[0][team] += m * fail * 0.5 * p;
+                    if (team) next[0][0] += m * fail * (1.0 - 0.5 * p) * lonerGate * p;
+                } else if (team) {
+                    next[0][0] += m * fail * lonerGate * p;
+                }
+            }
+        }
+        std::copy(&next[0][0], &next[0][0] + 4, &w[0][0]);
+    }
+    return static_cast<float>(w[0][0] + w[0][1] + w[1][0] + w[1][1]);
+}
+
+// Multisets of up to MAX_TABLED categories, ranked by the combinatorial
+// number system over their sorted members (shorter ones first)
+struct ChainTable {
+    std::array<std::array<int, RiskOracle::MAX_TABLED + CATEGORIES>, RiskOracle::MAX_TABLED + 1> binom{};
+    std::array<int, RiskOracle::MAX_TABLED + 2> offset{};
+    std::vector<float> odds;  // [rank * 8 + flags]
+
+    ChainTable() {
+        const int rows = RiskOracle::MAX_TABLED + CATEGORIES;
+        for (int n = 0; n < rows; ++n) {
+            for (int k = 0; k <= RiskOracle::MAX_TABLED; ++k) {
+                binom[k][n] = k == 0 ? 1 : (n < k ? 0 : (k == 1 ? n : binom[k - 1][n - 1] + binom[k][n - 1]));
+            }
+        }
+        // Multisets of size m from CATEGORIES kinds: C(m + CATEGORIES - 1, m)
+        for (int m = 0; m <= RiskOracle::MAX_TABLED; ++m) {
+            offset[m + 1] = offset[m] + binom[m][m + CATEGORIES - 1];
+        }
+        odds.resize(static_cast<size_t>(offset[RiskOracle::MAX_TABLED + 1]) * 8);
+        int chain[RiskOracle::MAX_TABLED];
+        fill(chain, 0, 0);
+    }
+
+    void fill(int* chain, int size, int minCategory) {
+        int r = rank(chain, size);
+        for (int flags = 0; flags < 8; ++flags) {
+            RerollAccess a{(flags & 1) != 0, (flags & 2) != 0, (flags & 4) != 0};
+            odds[static_cast<size_t>(r) * 8 + flags] = chainChance(chain, size, a);
+        }
+        if (size == RiskOracle::MAX_TABLED) return;
+        for (int c = minCategory; c < CATEGORIES; ++c) {
+            chain[size] = c;
+            fill(chain, size + 1, c);
+        }
+    }
+
+    // `sorted` is non-decreasing
+    int rank(const int* sorted, int size) const {
+        int r = offset[size];
+        for (int k = 0; k < size; ++k) r += binom[k + 1][sorted[k] + k];
+        return r;
+    }
+};
+
+const ChainTable& chainTable() {
+    static const ChainTable table;
+    return table;
+}
+
+} // anonymous namespace
+
+float RiskOracle::rollChance(int target) {
+    return (7 - std::clamp(target, 2, 6)) / 6.0f;
+}
+
+float RiskOracle::chance(const RiskRoll* rolls, int count, RerollAccess access) {
+    if (count <= 0) return 1.0f;
+    if (count > MAX_TABLED) {
+        std::vector<int> categories(count);
+        for (int i = 0; i < count; ++i) categories[i] = category(rolls[i]);
+        return chainChance(categories.data(), count, access);
+    }
+    int sorted[MAX_TABLED];
+    for (int i = 0; i < count; ++i) {
+        // Insertion sort: a handful of rolls
+        int c = category(rolls[i]);
+        int j = i;
+        for (; j > 0 && sorted[j - 1] > c; --j) sorted[j] = sorted[j - 1];
+        sorted[j] = c;
+    }
+    const ChainTable& table = chainTable();
+    return table.odds[static_cast<size_t>(table.rank(sorted, count)) * 8 + flagIndex(access)];
+}
+
+RerollAccess RiskOracle::access(const GameState& state, const Player& player) {
+    RerollAccess a;
+    a.team = state.getTeamState(player.teamSide).canUseReroll();
+    a.pro = player.hasSkill(SkillName::Pro) && !player.proUsedThisTurn;
+    a.loner = player.hasSkill(SkillName::Loner);
+    return a;
+}
+
+float RiskOracle::goForItChance(const GameState& state, const Player& player, int gfis) {
+    if (gfis <= 0) return 1.0f;
+    int maxGfi = player.hasSkill(SkillName::Sprint) ? 3 : 2;
+    if (gfis > maxGfi) return 0.0f;
+    RiskRoll gfi{state.weather == Weather::BLIZZARD ? 3 : 2, player.hasSkill(SkillName::SureFeet)};
+    RiskRoll rolls[3] = {gfi, gfi, gfi};
+    return chance(rolls, gfis, access(state, player));
+}
+
+} // namespace bb
@@ -0,0 +1,45 @@
+#include "bb/rollout_policy.h"
+
+namespace bb {
+
+bool UniformRolloutPolicy::choose(const GameState& state, DiceRollerBase& dice,
+                                  ActionList& scratch, Action& out) const {
+    getAvailableActions(state, scratch);
+    if (scratch.empty()) return false;
+    out = scratch[dice.rollIndex(static_cast<int>(scratch.size()))];
+    return true;
+}
+
+bool PlayerFirstRolloutPolicy::choose(const GameState& state, DiceRollerBase& dice,
+                                      ActionList& scratch, Action& out) const {
+    if (state.phase != GamePhase::PLAY) return false;
+
+    // Players that may have actions; those whose list turns out empty are
+    // dropped and the pick redrawn, which keeps it uniform over the rest.
+    const Player* candidates[11];
+    int n = 0;
+    state.forEachOnPitch(state.activeTeam, [&](const Player& p) {
+        if (p.canAct() || (p.state == PlayerState::PRONE && !p.hasActed)) candidates[n++] = &p;
+    });
+
+    for (;;) {
+        int pick = dice.rollIndex(n + 1);
+        if (pick == n) {
+            out = {ActionType::END_TURN, -1, -1, {-1, -1}};
+            return true;
+        }
+        getPlayerActions(state, *candidates[pick], scratch);
+        if (!scratch.empty()) {
+            out = scratch[dice.rollIndex(static_cast<int>(scratch.size()))];
+            return true;
+        }
+        candidates[pick] = candidates[--n];
+    }
+}
+
+const RolloutPolicy& defaultRolloutPolicy() {
+    static const PlayerFirstRolloutPolicy policy;
+    return policy;
+}
+
+} // namespace bb
@@ -0,0 +1,280 @@
+#include "bb/root_cache.h"
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace bb {
+
+namespace {
+
+constexpr char MAGIC[8] = {'B', 'B', 'R', 'O', 'O', 'T', 'C', '1'};
+constexpr uint32_t VERSION = 1;
+
+constexpr uint64_t FNV_OFFSET = 1469598103934665603ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+uint64_t fnv(uint64_t h, const void* data, size_t n) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < n; ++i) h = (h ^ p[i]) * FNV_PRIME;
+    return h;
+}
+
+template <typename T>
+uint64_t fnvValue(uint64_t h, T v) {
+    return fnv(h, &v, sizeof(v));
+}
+
+uint64_t mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+// Exclusive flock for the scope of one operation
+class FileLock {
+    int fd_;
+public:
+    explicit FileLock(int fd) : fd_(fd) { ::flock(fd_, LOCK_EX); }
+    ~FileLock() { ::flock(fd_, LOCK_UN); }
+};
+
+} // anonymous namespace
+
+struct RootCache::Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t slotBytes;
+    uint64_t slots;
+    uint64_t clock;     // last use stamp handed out
+    uint64_t occupied;
+    uint8_t reserved[24];
+};
+
+struct ChildRecord {
+    uint8_t type;
+    int8_t playerId;
+    int8_t targetId;
+    int8_t thirdId;
+    int8_t x;
+    int8_t y;
+    uint8_t reserved[2];
+    int32_t visits;
+    float target;
+    float value;
+};
+
+struct RootCache::Slot {
+    uint64_t state;
+    uint64_t model;
+    uint64_t lastUse;  // 0 = empty
+    double value;
+    uint32_t count;
+    uint32_t reserved;
+    ChildRecord children[MAX_CHILDREN];
+};
+
+static_assert(sizeof(ChildRecord) == 20);
+
+std::unique_ptr<RootCache> RootCache::open(const std::string& path, size_t bytes) {
+#ifdef __EMSCRIPTEN__
+    // Emscripten's in-memory filesystem: no other process to share with,
+    // and no flock or write-back shared mappings
+    (void)path;
+    (void)bytes;
+    return nullptr;
+#else
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return nullptr;
+    FileLock lock(fd);
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    Header existing{};
+    bool valid = size >= sizeof(Header) &&
+                 ::pread(fd, &existing, sizeof(existing), 0) == static_cast<ssize_t>(sizeof(existing)) &&
+                 std::memcmp(existing.magic, MAGIC, sizeof(MAGIC)) == 0 && existing.version == VERSION &&
+                 existing.slotBytes == sizeof(Slot) && existing.slots > 0 &&
+                 size == sizeof(Header) + existing.slots * sizeof(Slot);
+    if (!valid) {
+        size_t room = bytes > sizeof(Header) ? bytes - sizeof(Header) : 0;
+        size_t slots = std::max<size_t>(PROBE, room / sizeof(Slot));
+        size = sizeof(Header) + slots * sizeof(Slot);
+        Header fresh{};
+        std::memcpy(fresh.magic, MAGIC, sizeof(MAGIC));
+        fresh.version = VERSION;
+        fresh.slotBytes = sizeof(Slot);
+        fresh.slots = slots;
+        // Truncating to 0 first zeroes every slot (empty)
+        if (::ftruncate(fd, 0) != 0 || ::ftruncate(fd, static_cast<off_t>(size)) != 0 ||
+            ::pwrite(fd, &fresh, sizeof(fresh), 0) != static_cast<ssize_t>(sizeof(fresh))) {
+            ::close(fd);
+            return nullptr;
+        }
+    }
+    void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        ::close(fd);
+        return nullptr;
+    }
+    return std::unique_ptr<RootCache>(new RootCache(fd, data, size));
+#endif
+}
+
+RootCache::RootCache(int fd, void* data, size_t bytes)
+    : fd_(fd), data_(data), bytes_(bytes), slots_(static_cast<Header*>(data)->slots) {}
+
+RootCache::~RootCache() {
+    ::munmap(data_, bytes_);
+    ::close(fd_);
+}
+
+RootCache::Header& RootCache::header() const {
+    return *static_cast<Header*>(data_);
+}
+
+RootCache::Slot& RootCache::slot(size_t i) const {
+    return reinterpret_cast<Slot*>(static_cast<char*>(data_) + sizeof(Header))[i];
+}
+
+size_t RootCache::size() const {
+    return static_cast<size_t>(header().occupied);
+}
+
+bool RootCache::lookup(uint64_t state, uint64_t model, RootResult& out) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    FileLock lock(fd_);
+    size_t home = mix(state ^ mix(model)) % slots_;
+    for (int p = 0; p < PROBE; ++p) {
+        Slot& s = slot((home + p) % slots_);
+        if (s.lastUse == 0 || s.state != state || s.model != model) continue;
+        s.lastUse = ++header().clock;
+        out.value = s.value;
+        out.children.clear();
+        for (uint32_t c = 0; c < std::min<uint32_t>(s.count, MAX_CHILDREN); ++c) {
+            const ChildRecord& r = s.children[c];
+            Macro m;
+            m.type = static_cast<MacroType>(r.type);
+            m.playerId = r.playerId;
+            m.targetId = r.targetId;
+            m.thirdId = r.thirdId;
+            m.targetPos = {r.x, r.y};
+            out.children.push_back({m, r.visits, 0.0f, r.target, r.value});
+        }
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return !out.children.empty();
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void RootCache::store(uint64_t state, uint64_t model, const RootResult& result) {
+    if (result.children.empty()) return;
+    std::lock_guard<std::mutex> guard(mutex_);
+    FileLock lock(fd_);
+    Header& h = header();
+    size_t home = mix(state ^ mix(model)) % slots_;
+    Slot* target = nullptr;
+    Slot* empty = nullptr;
+    Slot* oldest = nullptr;
+    for (int p = 0; p < PROBE && !target; ++p) {
+        Slot& s = slot((home + p) % slots_);
+        if (s.lastUse == 0) {
+            if (!empty) empty = &s;
+        } else if (s.state == state && s.model == model) {
+            target = &s;
+        } else if (!oldest || s.lastUse < oldest->lastUse) {
+            oldest = &s;
+        }
+    }
+    if (!target && empty) {
+        target = empty;
+        h.occupied++;
+    } else if (!target) {
+        target = oldest;
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    target->state = state;
+    target->model = model;
+    target->value = result.value;
+    target->count = static_cast<uint32_t>(std::min<size_t>(result.children.size(), MAX_CHILDREN));
+    for (uint32_t c = 0; c < target->count; ++c) {
+        const MacroChildVisitInfo& cv = result.children[c];
+        ChildRecord& r = target->children[c];
+        r = ChildRecord{};
+        r.type = static_cast<uint8_t>(cv.macro.type);
+        r.playerId = static_cast<int8_t>(cv.macro.playerId);
+        r.targetId = static_cast<int8_t>(cv.macro.targetId);
+        r.thirdId = static_cast<int8_t>(cv.macro.thirdId);
+        r.x = static_cast<int8_t>(cv.macro.targetPos.x);
+        r.y = static_cast<int8_t>(cv.macro.targetPos.y);
+        r.visits = cv.visits;
+        r.target = cv.target;
+        r.value = static_cast<float>(cv.value);
+    }
+    target->lastUse = ++h.clock;
+}
+
+uint64_t rootCacheModelKey(const std::vector<std::string>& paths) {
+    uint64_t h = FNV_OFFSET;
+    char buffer[1 << 16];
+    for (const std::string& path : paths) {
+        if (path.empty()) {  // no such network
+            h = fnvValue(h, uint8_t{0xfe});
+            continue;
+        }
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return 0;
+        while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0) {
+            h = fnv(h, buffer, static_cast<size_t>(in.gcount()));
+        }
+        h = fnvValue(h, uint8_t{0xff});  // file boundary
+    }
+    return h;
+}
+
+uint64_t rootCacheSearchKey(const MCTSConfig& c) {
+    uint64_t h = fnvValue(FNV_OFFSET, c.rootCacheModel);
+    h = fnvValue(h, c.timeBudgetMs);
+    h = fnvValue(h, c.maxIterations);
+    h = fnvValue(h, c.explorationC);
+    h = fnvValue(h, c.rolloutDepth);
+    h = fnvValue(h, c.rolloutPolicy != nullptr);
+    h = fnvValue(h, c.policy != nullptr);
+    h = fnvValue(h, c.maxChildren);
+    h = fnvValue(h, c.dirichletAlpha);
+    h = fnvValue(h, c.dirichletWeight);
+    h = fnvValue(h, c.policyBlend);
+    h = fnvValue(h, c.vfBlend);
+    h = fnvValue(h, c.nRollouts);
+    h = fnvValue(h, c.leafLookahead);
+    h = fnvValue(h, c.lookaheadSamples);
+    h = fnvValue(h, c.stateCacheDepth);
+    h = fnvValue(h, c.stateCacheSamples);
+    h = fnvValue(h, c.commonRandomNumbers);
+    h = fnvValue(h, c.gumbelTopK);
+    if (c.opponentReplyWidth > 0) {
+        // Only when set, so caches filled before the option keep their keys
+        h = fnvValue(h, c.opponentReplyWidth);
+        h = fnvValue(h, c.opponentReplyMinDepth);
+    }
+    if (c.maxTreeNodes > 0) h = fnvValue(h, c.maxTreeNodes);
+    h = fnvValue(h, c.earlyStop);
+    h = fnvValue(h, c.endgameSolver);
+    h = fnvValue(h, c.expectedResolution);
+    return h;
+}
+
+} // namespace bb
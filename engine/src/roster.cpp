@@ -1,6 +1,8 @@
 #include "bb/roster.h"
 #include <algorithm>
 #include <cctype>
+#include <iterator>
+#include <unordered_map>
 
 namespace bb {
 
@@ -12,13 +14,6 @@ SkillSet makeSkills(std::initializer_list<SkillName> list) {
     return ss;
 }
 
-std::string toLower(const std::string& s) {
-    std::string out = s;
-    std::transform(out.begin(), out.end(), out.begin(),
-                   [](unsigned char c){ return std::tolower(c); });
-    return out;
-}
-
 } // anonymous namespace
 
 // Human: Lineman 0-16, Catcher 0-4, Thrower 0-2, Blitzer 0-4, Ogre 0-1
@@ -588,59 +583,115 @@ const TeamRoster& getWoodElfRoster1200() {
     return roster;
 }
 
-const TeamRoster* getDevelopedRoster(const std::string& name, int tv) {
-    if (tv >= 1200) {
-        std::string lower = toLower(name);
-        std::string normalized;
-        for (char c : lower) {
-            if (c != ' ' && c != '_' && c != '-') normalized += c;
+// --- Registry ---
+
+namespace {
+
+// Append-only: an entry's index is its RosterId, which files record.
+constexpr const TeamRoster& (*ROSTER_TABLE[])() = {
+    getHumanRoster, getOrcRoster, getSkavenRoster, getDwarfRoster, getWoodElfRoster,
+    getChaosRoster, getUndeadRoster, getLizardmenRoster, getDarkElfRoster, getHalflingRoster,
+    getNorseRoster, getHighElfRoster, getVampireRoster, getAmazonRoster, getNecromanticRoster,
+    getBretonianRoster, getKhemriRoster, getGoblinRoster, getChaosDwarfRoster, getOgreRoster,
+    getNurgleRoster, getProElfRoster, getSlannRoster, getUnderworldRoster, getKhorneRoster,
+    getChaosPactRoster,
+    getOrcRoster1200, getHumanRoster1200, getDwarfRoster1200, getSkavenRoster1200,
+    getWoodElfRoster1200,
+};
+constexpr int ROSTER_TABLE_SIZE = static_cast<int>(std::size(ROSTER_TABLE));
+static_assert(ROSTER_TABLE_SIZE < INVALID_ROSTER);
+
+std::string normalizeName(std::string_view name) {
+    std::string out;
+    out.reserve(name.size());
+    for (unsigned char c : name) {
+        if (std::isalnum(c)) out += static_cast<char>(std::tolower(c));
+    }
+    return out;
+}
+
+bool sameRoster(const TeamRoster& a, const TeamRoster& b) {
+    if (a.positionalCount != b.positionalCount || a.rerollCost != b.rerollCost ||
+        a.hasApothecary != b.hasApothecary) {
+        return false;
+    }
+    for (int i = 0; i < a.positionalCount; ++i) {
+        const PlayerTemplate& p = a.positionals[i];
+        const PlayerTemplate& q = b.positionals[i];
+        if (p.stats.movement != q.stats.movement || p.stats.strength != q.stats.strength ||
+            p.stats.agility != q.stats.agility || p.stats.armour != q.stats.armour ||
+            !(p.skills == q.skills) || p.quantity != q.quantity) {
+            return false;
         }
-        if (normalized == "orc") return &getOrcRoster1200();
-        if (normalized == "human") return &getHumanRoster1200();
-        if (normalized == "dwarf") return &getDwarfRoster1200();
-        if (normalized == "skaven") return &getSkavenRoster1200();
-        if (normalized == "woodelf") return &getWoodElfRoster1200();
     }
-    return getRosterByName(name);
+    return true;
 }
 
-const TeamRoster* getRosterByName(const std::string& name) {
-    std::string lower = toLower(name);
+struct Registry {
+    const TeamRoster* rosters[ROSTER_TABLE_SIZE];
+    std::string keys[ROSTER_TABLE_SIZE];
+    std::unordered_map<std::string, RosterId> byKey;
+    std::unordered_map<const TeamRoster*, RosterId> byRoster;
 
-    // Remove spaces/underscores for flexible matching
-    std::string normalized;
-    for (char c : lower) {
-        if (c != ' ' && c != '_' && c != '-') normalized += c;
+    Registry() {
+        for (int i = 0; i < ROSTER_TABLE_SIZE; ++i) {
+            rosters[i] = &ROSTER_TABLE[i]();
+            keys[i] = normalizeName(rosters[i]->name);
+            byKey.emplace(keys[i], static_cast<RosterId>(i));
+            byRoster.emplace(rosters[i], static_cast<RosterId>(i));
+        }
+    }
+    RosterId findKey(const std::string& key) const {
+        auto it = byKey.find(key);
+        return it == byKey.end() ? INVALID_ROSTER : it->second;
     }
+};
 
-    if (normalized == "human") return &getHumanRoster();
-    if (normalized == "orc") return &getOrcRoster();
-    if (normalized == "skaven") return &getSkavenRoster();
-    if (normalized == "dwarf") return &getDwarfRoster();
-    if (normalized == "woodelf") return &getWoodElfRoster();
-    if (normalized == "chaos") return &getChaosRoster();
-    if (normalized == "undead") return &getUndeadRoster();
-    if (normalized == "lizardmen") return &getLizardmenRoster();
-    if (normalized == "darkelf") return &getDarkElfRoster();
-    if (normalized == "halfling") return &getHalflingRoster();
-    if (normalized == "norse") return &getNorseRoster();
-    if (normalized == "highelf") return &getHighElfRoster();
-    if (normalized == "vampire") return &getVampireRoster();
-    if (normalized == "amazon") return &getAmazonRoster();
-    if (normalized == "necromantic") return &getNecromanticRoster();
-    if (normalized == "bretonnian") return &getBretonianRoster();
-    if (normalized == "khemri") return &getKhemriRoster();
-    if (normalized == "goblin") return &getGoblinRoster();
-    if (normalized == "chaosdwarf") return &getChaosDwarfRoster();
-    if (normalized == "ogre") return &getOgreRoster();
-    if (normalized == "nurgle") return &getNurgleRoster();
-    if (normalized == "proelf") return &getProElfRoster();
-    if (normalized == "slann") return &getSlannRoster();
-    if (normalized == "underworld") return &getUnderworldRoster();
-    if (normalized == "khorne") return &getKhorneRoster();
-    if (normalized == "chaospact") return &getChaosPactRoster();
-
-    return nullptr;
+const Registry& registry() {
+    static const Registry r;
+    return r;
+}
+
+} // anonymous namespace
+
+int rosterCount() { return ROSTER_TABLE_SIZE; }
+
+const TeamRoster* rosterById(RosterId id) {
+    return id < ROSTER_TABLE_SIZE ? registry().rosters[id] : nullptr;
+}
+
+RosterId rosterIdOf(const TeamRoster& roster) {
+    const Registry& r = registry();
+    auto it = r.byRoster.find(&roster);
+    if (it != r.byRoster.end()) return it->second;
+    // A copy (GameRecord keeps its rosters by value): same name, same contents
+    RosterId id = roster.name ? r.findKey(normalizeName(roster.name)) : INVALID_ROSTER;
+    return id != INVALID_ROSTER && sameRoster(roster, *r.rosters[id]) ? id : INVALID_ROSTER;
+}
+
+RosterId findRosterId(std::string_view name) {
+    return registry().findKey(normalizeName(name));
+}
+
+const char* rosterKey(RosterId id) {
+    return id < ROSTER_TABLE_SIZE ? registry().keys[id].c_str() : "";
+}
+
+const PlayerTemplate* positionalById(PositionalId id) {
+    const TeamRoster* roster = rosterById(positionalRoster(id));
+    if (!roster || positionalSlot(id) >= roster->positionalCount) return nullptr;
+    return &roster->positionals[positionalSlot(id)];
+}
+
+const TeamRoster* getDevelopedRoster(const std::string& name, int tv) {
+    if (tv >= 1200) {
+        if (const TeamRoster* developed = rosterById(findRosterId(name + "tv1200"))) return developed;
+    }
+    return getRosterByName(name);
+}
+
+const TeamRoster* getRosterByName(const std::string& name) {
+    return rosterById(findRosterId(name));
 }
 
 } // namespace bb
@@ -1,194 +1,392 @@
 #include "bb/rules_engine.h"
+#include "bb/alloc_tracking.h"
 #include "bb/helpers.h"
+#include "bb/matchup_features.h"
+#include "bb/bitboard.h"
 #include "bb/pathfinder.h"
+#include "bb/profile.h"
+#include <algorithm>
 
 namespace bb {
 
-void getAvailableActions(const GameState& state, std::vector<Action>& out) {
-    out.clear();
+namespace {
 
-    if (state.phase != GamePhase::PLAY) return;
+// The generators below fill either list type (std::vector or ActionList).
 
-    TeamSide side = state.activeTeam;
+// Everything player p (which canAct()) may do, appended to out. Skills
+// outside `Features` are known absent from the matchup and not tested.
+template <MatchupFeatures Features, typename Out>
+void appendActingActions(const GameState& state, const Player& p,
+                         const Bitboard& occupied, Out& out) {
+    TeamSide side = p.teamSide;
     const TeamState& team = state.getTeamState(side);
 
-    // END_TURN is always available
-    out.push_back({ActionType::END_TURN, -1, -1, {-1, -1}});
-
-    state.forEachOnPitch(side, [&](const Player& p) {
-        if (!p.canAct()) return;
-
-        // BallAndChain players can ONLY use the BALL_AND_CHAIN action
+    // BallAndChain players can ONLY use the BALL_AND_CHAIN action
+    if constexpr ((Features & feature::BALL_AND_CHAIN) != 0) {
         if (p.hasSkill(SkillName::BallAndChain)) {
             out.push_back({ActionType::BALL_AND_CHAIN, p.id, -1, {-1, -1}});
             return; // Skip all other action types
         }
+    }
 
-        // MOVE: each adjacent empty square (single-step)
-        auto adj = p.position.getAdjacent();
-        for (auto& pos : adj) {
-            if (!pos.isOnPitch()) continue;
-            if (state.getPlayerAtPosition(pos) != nullptr) continue;
-
-            // Check movement remaining (including GFI)
-            int maxGfi = p.hasSkill(SkillName::Sprint) ? 3 : 2;
-            if (p.movementRemaining - 1 < -maxGfi) continue;
-
-            out.push_back({ActionType::MOVE, p.id, -1, pos});
-        }
+    // Candidate squares come from bitboard masks; Bitboard::forEach walks
+    // them in ascending square order, which is getAdjacent() order, so the
+    // output matches the old per-square loops action for action.
+    TeamSide enemySide = opponent(side);
+    const Bitboard& adj = Bitboard::adjacent(p.position);
+    const Bitboard& enemyStanding = state.standingOf(enemySide);
 
-        // BLOCK: each adjacent standing enemy
-        TeamSide enemySide = opponent(side);
-        for (auto& pos : adj) {
-            if (!pos.isOnPitch()) continue;
-            const Player* enemy = state.getPlayerAtPosition(pos);
-            if (enemy && enemy->teamSide == enemySide && canAct(enemy->state)) {
-                out.push_back({ActionType::BLOCK, p.id, enemy->id, enemy->position});
-            }
-        }
+    // MOVE: each adjacent empty square (single-step), movement incl. GFI permitting
+    int maxGfi = p.hasSkill(SkillName::Sprint) ? 3 : 2;
+    if (p.movementRemaining - 1 >= -maxGfi) {
+        adj.andNot(occupied).forEach([&](int sq) {
+            out.push_back({ActionType::MOVE, p.id, -1, Bitboard::positionOf(sq)});
+        });
+    }
 
-        // BLITZ: if not used this turn, each reachable enemy
-        if (!team.blitzUsedThisTurn && !p.usedBlitz) {
-            state.forEachOnPitch(enemySide, [&](const Player& enemy) {
-                if (!canAct(enemy.state) && !isOnPitch(enemy.state)) return;
-                if (enemy.state != PlayerState::STANDING) return;
-
-                // Check if already adjacent
-                if (p.position.distanceTo(enemy.position) == 1) {
-                    // Already adjacent — blitz is just a block with blitz flag
-                    out.push_back({ActionType::BLITZ, p.id, enemy.id, enemy.position});
-                    return;
-                }
+    // BLOCK: each adjacent standing enemy
+    (adj & enemyStanding).forEach([&](int sq) {
+        Position pos = Bitboard::positionOf(sq);
+        out.push_back({ActionType::BLOCK, p.id, state.getPlayerAtPosition(pos)->id, pos});
+    });
 
-                // Check if we can reach adjacent to enemy
-                Position adjPos;
-                if (canReachAdjacentTo(state, p, enemy.position, adjPos)) {
-                    out.push_back({ActionType::BLITZ, p.id, enemy.id, enemy.position});
-                }
-            });
+    // BLITZ: if not used this turn, each reachable enemy
+    if (!team.blitzUsedThisTurn && !p.usedBlitz) {
+        // Same reachability as canReachAdjacentTo, computed once for all
+        // targets: flood empty squares out to MA + GFI, then every square
+        // next to the flooded area (other than the start) is blitzable.
+        Bitboard blitzable;
+        int maxRange = p.movementRemaining + maxGfi;
+        if (maxRange > 0) {
+            Bitboard reach = floodFill(p.position, Bitboard::pitch().andNot(occupied), maxRange);
+            reach.clear(Bitboard::indexOf(p.position));
+            blitzable = dilate(reach);
         }
+        state.forEachOnPitch(enemySide, [&](const Player& enemy) {
+            if (enemy.state != PlayerState::STANDING) return;
+            // Already adjacent (blitz is just a block with blitz flag) or reachable
+            if (adj.test(enemy.position) || blitzable.test(enemy.position)) {
+                out.push_back({ActionType::BLITZ, p.id, enemy.id, enemy.position});
+            }
+        });
+    }
 
-        // PASS: if not used this turn, has ball, each standing teammate within range 13
-        if (!team.passUsedThisTurn && state.ball.isHeld && state.ball.carrierId == p.id &&
-            !p.hasSkill(SkillName::NoHands)) {
-            state.forEachOnPitch(side, [&](const Player& teammate) {
-                if (teammate.id == p.id) return;
-                if (teammate.state != PlayerState::STANDING) return;
-                int dist = p.position.distanceTo(teammate.position);
-                if (dist > 13) return;
-                out.push_back({ActionType::PASS, p.id, teammate.id, teammate.position});
-            });
-        }
+    // PASS: if not used this turn, has ball, each standing teammate within range 13
+    if (!team.passUsedThisTurn && state.ball.isHeld && state.ball.carrierId == p.id &&
+        !p.hasSkill(SkillName::NoHands)) {
+        state.forEachOnPitch(side, [&](const Player& teammate) {
+            if (teammate.id == p.id) return;
+            if (teammate.state != PlayerState::STANDING) return;
+            int dist = p.position.distanceTo(teammate.position);
+            if (dist > 13) return;
+            out.push_back({ActionType::PASS, p.id, teammate.id, teammate.position});
+        });
+    }
 
-        // HAND_OFF: if not used this turn, has ball, each adjacent standing teammate
-        if (!team.passUsedThisTurn && state.ball.isHeld && state.ball.carrierId == p.id &&
-            !p.hasSkill(SkillName::NoHands)) {
-            for (auto& pos : adj) {
-                if (!pos.isOnPitch()) continue;
-                const Player* teammate = state.getPlayerAtPosition(pos);
-                if (teammate && teammate->teamSide == side &&
-                    teammate->state == PlayerState::STANDING) {
-                    out.push_back({ActionType::HAND_OFF, p.id, teammate->id, teammate->position});
-                }
-            }
-        }
+    // HAND_OFF: if not used this turn, has ball, each adjacent standing teammate
+    if (!team.passUsedThisTurn && state.ball.isHeld && state.ball.carrierId == p.id &&
+        !p.hasSkill(SkillName::NoHands)) {
+        (adj & state.standingOf(side)).forEach([&](int sq) {
+            Position pos = Bitboard::positionOf(sq);
+            out.push_back({ActionType::HAND_OFF, p.id, state.getPlayerAtPosition(pos)->id, pos});
+        });
+    }
 
-        // FOUL: if not used this turn, each adjacent prone/stunned enemy
-        if (!team.foulUsedThisTurn) {
-            for (auto& pos : adj) {
-                if (!pos.isOnPitch()) continue;
-                const Player* enemy = state.getPlayerAtPosition(pos);
-                if (enemy && enemy->teamSide == enemySide &&
-                    (enemy->state == PlayerState::PRONE ||
-                     enemy->state == PlayerState::STUNNED)) {
-                    out.push_back({ActionType::FOUL, p.id, enemy->id, enemy->position});
-                }
-            }
-        }
+    // FOUL: if not used this turn, each adjacent prone/stunned enemy
+    if (!team.foulUsedThisTurn) {
+        // Adjacent enemies that are down (on pitch but not standing)
+        (adj & state.occupiedBy(enemySide)).andNot(enemyStanding).forEach([&](int sq) {
+            Position pos = Bitboard::positionOf(sq);
+            out.push_back({ActionType::FOUL, p.id, state.getPlayerAtPosition(pos)->id, pos});
+        });
+    }
 
-        // THROW_TEAM_MATE: player has ThrowTeamMate + adjacent RightStuff teammate
-        if (p.hasSkill(SkillName::ThrowTeamMate) && !team.passUsedThisTurn) {
-            for (auto& pos : adj) {
-                if (!pos.isOnPitch()) continue;
-                const Player* teammate = state.getPlayerAtPosition(pos);
-                if (teammate && teammate->teamSide == side &&
-                    teammate->state == PlayerState::STANDING &&
-                    teammate->hasSkill(SkillName::RightStuff)) {
-                    // Target positions: any square within pass range
-                    // For simplicity, generate targets every 3 squares in each direction
-                    for (int tx = 0; tx < 26; tx += 3) {
-                        for (int ty = 0; ty < 15; ty += 3) {
-                            int dist = p.position.distanceTo({static_cast<int8_t>(tx),
-                                                              static_cast<int8_t>(ty)});
-                            if (dist > 0 && dist <= 13) {
-                                out.push_back({ActionType::THROW_TEAM_MATE, p.id,
-                                              teammate->id,
-                                              {static_cast<int8_t>(tx), static_cast<int8_t>(ty)}});
-                            }
+    // THROW_TEAM_MATE: player has ThrowTeamMate + adjacent RightStuff teammate
+    if ((Features & feature::THROW_TEAM_MATE) != 0 && p.hasSkill(SkillName::ThrowTeamMate) &&
+        !team.passUsedThisTurn) {
+        (adj & state.standingOf(side)).forEach([&](int sq) {
+            const Player* teammate = state.getPlayerAtPosition(Bitboard::positionOf(sq));
+            if (teammate->hasSkill(SkillName::RightStuff)) {
+                // Target positions: any square within pass range
+                // For simplicity, generate targets every 3 squares in each direction
+                for (int tx = 0; tx < 26; tx += 3) {
+                    for (int ty = 0; ty < 15; ty += 3) {
+                        int dist = p.position.distanceTo({static_cast<int8_t>(tx),
+                                                          static_cast<int8_t>(ty)});
+                        if (dist > 0 && dist <= 13) {
+                            out.push_back({ActionType::THROW_TEAM_MATE, p.id,
+                                          teammate->id,
+                                          {static_cast<int8_t>(tx), static_cast<int8_t>(ty)}});
                         }
                     }
                 }
             }
-        }
+        });
+    }
 
-        // BOMB_THROW: Bombardier player, target positions within range 13
-        if (p.hasSkill(SkillName::Bombardier) && !team.passUsedThisTurn) {
-            state.forEachOnPitch(enemySide, [&](const Player& enemy) {
-                if (enemy.state != PlayerState::STANDING) return;
-                int dist = p.position.distanceTo(enemy.position);
-                if (dist > 13) return;
-                out.push_back({ActionType::BOMB_THROW, p.id, -1, enemy.position});
-            });
-        }
+    // BOMB_THROW: Bombardier player, target positions within range 13
+    if ((Features & feature::BOMBARDIER) != 0 && p.hasSkill(SkillName::Bombardier) &&
+        !team.passUsedThisTurn) {
+        state.forEachOnPitch(enemySide, [&](const Player& enemy) {
+            if (enemy.state != PlayerState::STANDING) return;
+            int dist = p.position.distanceTo(enemy.position);
+            if (dist > 13) return;
+            out.push_back({ActionType::BOMB_THROW, p.id, -1, enemy.position});
+        });
+    }
 
-        // HYPNOTIC_GAZE: each adjacent standing enemy
-        if (p.hasSkill(SkillName::HypnoticGaze)) {
-            for (auto& pos : adj) {
-                if (!pos.isOnPitch()) continue;
-                const Player* enemy = state.getPlayerAtPosition(pos);
-                if (enemy && enemy->teamSide == enemySide &&
-                    enemy->state == PlayerState::STANDING) {
-                    out.push_back({ActionType::HYPNOTIC_GAZE, p.id, enemy->id, enemy->position});
-                }
-            }
-        }
+    // HYPNOTIC_GAZE: each adjacent standing enemy
+    if ((Features & feature::HYPNOTIC_GAZE) != 0 && p.hasSkill(SkillName::HypnoticGaze)) {
+        (adj & enemyStanding).forEach([&](int sq) {
+            Position pos = Bitboard::positionOf(sq);
+            out.push_back({ActionType::HYPNOTIC_GAZE, p.id, state.getPlayerAtPosition(pos)->id, pos});
+        });
+    }
 
-        // MULTIPLE_BLOCK: player has MultipleBlock, 2+ adjacent enemies, no Frenzy
-        if (p.hasSkill(SkillName::MultipleBlock) && !p.hasSkill(SkillName::Frenzy)) {
-            // Collect adjacent standing enemies
-            int adjEnemies[8];
-            int nAdj = 0;
-            for (auto& pos : adj) {
-                if (!pos.isOnPitch()) continue;
-                const Player* enemy = state.getPlayerAtPosition(pos);
-                if (enemy && enemy->teamSide == enemySide &&
-                    enemy->state == PlayerState::STANDING) {
-                    if (nAdj < 8) adjEnemies[nAdj++] = enemy->id;
-                }
-            }
-            // Generate all pairs
-            for (int i = 0; i < nAdj; i++) {
-                for (int j = i + 1; j < nAdj; j++) {
-                    // Encode: targetId=first target, target.x=second target ID
-                    out.push_back({ActionType::MULTIPLE_BLOCK, p.id, adjEnemies[i],
-                                  {static_cast<int8_t>(adjEnemies[j]), 0}});
-                }
+    // MULTIPLE_BLOCK: player has MultipleBlock, 2+ adjacent enemies, no Frenzy
+    if ((Features & feature::MULTIPLE_BLOCK) != 0 && p.hasSkill(SkillName::MultipleBlock) &&
+        !p.hasSkill(SkillName::Frenzy)) {
+        // Collect adjacent standing enemies
+        int adjEnemies[8];
+        int nAdj = 0;
+        (adj & enemyStanding).forEach([&](int sq) {
+            adjEnemies[nAdj++] = state.getPlayerAtPosition(Bitboard::positionOf(sq))->id;
+        });
+        // Generate all pairs
+        for (int i = 0; i < nAdj; i++) {
+            for (int j = i + 1; j < nAdj; j++) {
+                // Encode: targetId=first target, target.x=second target ID
+                out.push_back({ActionType::MULTIPLE_BLOCK, p.id, adjEnemies[i],
+                              {static_cast<int8_t>(adjEnemies[j]), 0}});
             }
         }
+    }
+}
+
+// Stand-up for a prone player that has not acted, appended to out.
+template <typename Out>
+void appendStandUp(const Player& p, Out& out) {
+    if (p.state != PlayerState::PRONE) return;
+    if (p.hasActed || p.lostTacklezones) return;
+
+    // Can stand up if JumpUp or movementRemaining >= 3
+    if (p.hasSkill(SkillName::JumpUp) || p.movementRemaining >= 3) {
+        // After standing up, the player can move — generate a MOVE action
+        // to their own position as a "stand up" action
+        out.push_back({ActionType::MOVE, p.id, -1, p.position});
+    }
+}
+
+template <typename Out>
+void availableActions(const GameState& state, Out& out) {
+    BB_PROFILE_SCOPE(prof::GET_AVAILABLE_ACTIONS);
+    BB_ALLOC_SCOPE(alloc::MOVE_GEN);
+    out.clear();
+
+    if (state.phase != GamePhase::PLAY) return;
+
+    TeamSide side = state.activeTeam;
+
+    // END_TURN is always available
+    out.push_back({ActionType::END_TURN, -1, -1, {-1, -1}});
+
+    const Bitboard occupied = state.occupied();
+
+    withMatchupFeatures(matchupFeatures(state), [&](auto features) {
+        state.forEachOnPitch(side, [&](const Player& p) {
+            if (p.canAct()) appendActingActions<features.value>(state, p, occupied, out);
+        });
     });
 
     // Also allow standing up prone players
-    state.forEachOnPitch(side, [&](const Player& p) {
-        if (p.state != PlayerState::PRONE) return;
-        if (p.hasActed || p.lostTacklezones) return;
-
-        // Can stand up if JumpUp or movementRemaining >= 3
-        if (p.hasSkill(SkillName::JumpUp) || p.movementRemaining >= 3) {
-            // After standing up, the player can move — generate a MOVE action
-            // to their own position as a "stand up" action
-            out.push_back({ActionType::MOVE, p.id, -1, p.position});
+    state.forEachOnPitch(side, [&](const Player& p) { appendStandUp(p, out); });
+}
+
+template <typename Out>
+void playerActions(const GameState& state, const Player& player, Out& out) {
+    out.clear();
+    if (state.phase != GamePhase::PLAY || player.teamSide != state.activeTeam) return;
+    if (!player.isOnPitch()) return;
+    if (!player.canAct()) {
+        appendStandUp(player, out);
+        return;
+    }
+    withMatchupFeatures(matchupFeatures(state), [&](auto features) {
+        appendActingActions<features.value>(state, player, state.occupied(), out);
+    });
+}
+
+// Player `id` if it is on the pitch for `side`, else nullptr.
+const Player* onPitchPlayer(const GameState& state, int id, TeamSide side) {
+    if (id < 1 || id > 22) return nullptr;
+    const Player& p = state.getPlayer(id);
+    return p.isOnPitch() && p.teamSide == side ? &p : nullptr;
+}
+
+// appendActingActions' conditions for the one action `a` of player p.
+bool actingActionLegal(const GameState& state, const Player& p, const Action& a,
+                       MatchupFeatures features) {
+    TeamSide side = p.teamSide;
+    TeamSide enemySide = opponent(side);
+    const TeamState& team = state.getTeamState(side);
+
+    if ((features & feature::BALL_AND_CHAIN) != 0 && p.hasSkill(SkillName::BallAndChain)) {
+        return a.type == ActionType::BALL_AND_CHAIN && a.targetId == -1 && a.target == Position{-1, -1};
+    }
+
+    // Every remaining action names an on-pitch target square
+    if (!a.target.isOnPitch()) return false;
+    const Bitboard& adj = Bitboard::adjacent(p.position);
+    const Player* at = state.getPlayerAtPosition(a.target);
+    bool adjacent = adj.test(a.target);
+    bool carrier = state.ball.isHeld && state.ball.carrierId == p.id;
+    auto standingAt = [&](TeamSide s) {
+        return at && at->teamSide == s && at->state == PlayerState::STANDING;
+    };
+    int maxGfi = p.hasSkill(SkillName::Sprint) ? 3 : 2;
+
+    switch (a.type) {
+    case ActionType::MOVE:
+        return a.targetId == -1 && adjacent && !state.occupied().test(a.target) &&
+               p.movementRemaining - 1 >= -maxGfi;
+    case ActionType::BLOCK:
+        return adjacent && standingAt(enemySide) && a.targetId == at->id;
+    case ActionType::BLITZ: {
+        if (team.blitzUsedThisTurn || p.usedBlitz) return false;
+        const Player* enemy = onPitchPlayer(state, a.targetId, enemySide);
+        if (!enemy || enemy->state != PlayerState::STANDING || enemy->position != a.target) return false;
+        if (adjacent) return true;
+        int maxRange = p.movementRemaining + maxGfi;
+        if (maxRange <= 0) return false;
+        Bitboard reach = floodFill(p.position, Bitboard::pitch().andNot(state.occupied()), maxRange);
+        reach.clear(Bitboard::indexOf(p.position));
+        return dilate(reach).test(a.target);
+    }
+    case ActionType::PASS: {
+        if (team.passUsedThisTurn || !carrier || p.hasSkill(SkillName::NoHands)) return false;
+        const Player* teammate = onPitchPlayer(state, a.targetId, side);
+        return teammate && teammate->id != p.id && teammate->state == PlayerState::STANDING &&
+               teammate->position == a.target && p.position.distanceTo(a.target) <= 13;
+    }
+    case ActionType::HAND_OFF:
+        return !team.passUsedThisTurn && carrier && !p.hasSkill(SkillName::NoHands) && adjacent &&
+               standingAt(side) && a.targetId == at->id;
+    case ActionType::FOUL:
+        return !team.foulUsedThisTurn && adjacent && at && at->teamSide == enemySide &&
+               at->state != PlayerState::STANDING && a.targetId == at->id;
+    case ActionType::THROW_TEAM_MATE: {
+        if ((features & feature::THROW_TEAM_MATE) == 0 || !p.hasSkill(SkillName::ThrowTeamMate) ||
+            team.passUsedThisTurn) {
+            return false;
+        }
+        const Player* teammate = onPitchPlayer(state, a.targetId, side);
+        int dist = p.position.distanceTo(a.target);
+        return teammate && teammate->state == PlayerState::STANDING && adj.test(teammate->position) &&
+               teammate->hasSkill(SkillName::RightStuff) && a.target.x % 3 == 0 &&
+               a.target.y % 3 == 0 && dist > 0 && dist <= 13;
+    }
+    case ActionType::BOMB_THROW:
+        return (features & feature::BOMBARDIER) != 0 && p.hasSkill(SkillName::Bombardier) &&
+               !team.passUsedThisTurn && a.targetId == -1 && standingAt(enemySide) &&
+               p.position.distanceTo(a.target) <= 13;
+    case ActionType::HYPNOTIC_GAZE:
+        return (features & feature::HYPNOTIC_GAZE) != 0 && p.hasSkill(SkillName::HypnoticGaze) &&
+               adjacent && standingAt(enemySide) && a.targetId == at->id;
+    case ActionType::MULTIPLE_BLOCK: {
+        // Pairs in ascending square order, the second target's id in target.x
+        if ((features & feature::MULTIPLE_BLOCK) == 0 || !p.hasSkill(SkillName::MultipleBlock) ||
+            p.hasSkill(SkillName::Frenzy) || a.target.y != 0) {
+            return false;
         }
+        const Player* first = onPitchPlayer(state, a.targetId, enemySide);
+        const Player* second = onPitchPlayer(state, a.target.x, enemySide);
+        if (!first || !second || first == second) return false;
+        if (first->state != PlayerState::STANDING || second->state != PlayerState::STANDING) return false;
+        return adj.test(first->position) && adj.test(second->position) &&
+               Bitboard::indexOf(first->position) < Bitboard::indexOf(second->position);
+    }
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+bool isActionLegal(const GameState& state, const Action& action) {
+    if (state.phase != GamePhase::PLAY) return false;
+    if (action.type == ActionType::END_TURN) {
+        return action.playerId == -1 && action.targetId == -1 && action.target == Position{-1, -1};
+    }
+    const Player* p = onPitchPlayer(state, action.playerId, state.activeTeam);
+    if (!p) return false;
+    if (!p->canAct()) {
+        // appendStandUp's MOVE onto the player's own square
+        return action.type == ActionType::MOVE && action.targetId == -1 && action.target == p->position &&
+               p->state == PlayerState::PRONE && !p->hasActed && !p->lostTacklezones &&
+               (p->hasSkill(SkillName::JumpUp) || p->movementRemaining >= 3);
+    }
+    return actingActionLegal(state, *p, action, matchupFeatures(state));
+}
+
+void getAvailableActions(const GameState& state, std::vector<Action>& out) {
+    availableActions(state, out);
+}
+
+void getAvailableActions(const GameState& state, ActionList& out) {
+    availableActions(state, out);
+}
+
+void getAvailableActionsWithPaths(const GameState& state, std::vector<Action>& out) {
+    if (const ActionList* listed = PublishedActions::find(state)) out.assign(listed->begin(), listed->end());
+    else getAvailableActions(state, out);
+    if (out.empty()) return;
+
+    out.erase(std::remove_if(out.begin(), out.end(), [&](const Action& a) {
+        return a.type == ActionType::MOVE && a.target != state.getPlayer(a.playerId).position;
+    }), out.end());
+
+    // Reachability has the same MA + GFI limit as the single-step MOVEs
+    state.forEachOnPitch(state.activeTeam, [&](const Player& p) {
+        if (!p.canAct() || p.hasSkill(SkillName::BallAndChain)) return;
+        const ReachabilityMap& reach = getReachability(state, p);
+        reach.reachable.forEach([&](int sq) {
+            if (reach.cost[sq] > 0) {
+                out.push_back({ActionType::MOVE_PATH, p.id, -1, Bitboard::positionOf(sq)});
+            }
+        });
     });
 }
 
+namespace {
+thread_local const PublishedActions* publishedScope = nullptr;
+}
+
+PublishedActions::PublishedActions(const GameState& state, const ActionList& actions)
+    : state_(&state), actions_(&actions), outer_(publishedScope) {
+    publishedScope = this;
+}
+
+PublishedActions::~PublishedActions() {
+    publishedScope = outer_;
+}
+
+const ActionList* PublishedActions::find(const GameState& state) {
+    const PublishedActions* scope = publishedScope;
+    return scope && scope->state_ == &state ? scope->actions_ : nullptr;
+}
+
+const ActionList& decisionActions(const GameState& state, ActionList& scratch) {
+    if (const ActionList* listed = PublishedActions::find(state)) return *listed;
+    getAvailableActions(state, scratch);
+    return scratch;
+}
+
+void getPlayerActions(const GameState& state, const Player& player, std::vector<Action>& out) {
+    playerActions(state, player, out);
+}
+
+void getPlayerActions(const GameState& state, const Player& player, ActionList& out) {
+    playerActions(state, player, out);
+}
+
 } // namespace bb
@@ -0,0 +1,60 @@
+#include "bb/search_trace.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace bb {
+
+SearchTrace::SearchTrace(int sampleEvery)
+    : sampleEvery_(std::max(1, sampleEvery)), origin_(Clock::now()) {}
+
+void SearchTrace::span(const char* name, const char* category, Clock::time_point start,
+                       Clock::time_point end, int tid, std::string args) {
+    using Us = std::chrono::duration<double, std::micro>;
+    Event e{name, category, Us(start - origin_).count(), Us(end - start).count(), tid,
+            std::move(args)};
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.push_back(std::move(e));
+}
+
+size_t SearchTrace::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_.size();
+}
+
+void SearchTrace::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.clear();
+}
+
+std::string SearchTrace::toJson() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    char buf[256];
+    for (size_t i = 0; i < events_.size(); ++i) {
+        const Event& e = events_[i];
+        // Names and categories are string literals from the engine: no escaping needed
+        std::snprintf(buf, sizeof(buf),
+                      "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                      "\"pid\":1,\"tid\":%d",
+                      i ? "," : "", e.name, e.category, e.startUs, e.durUs, e.tid);
+        out += buf;
+        if (!e.args.empty()) {
+            out += ",\"args\":{";
+            out += e.args;
+            out += '}';
+        }
+        out += '}';
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+bool SearchTrace::write(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+    file << toJson();
+    return static_cast<bool>(file);
+}
+
+} // namespace bb
@@ -0,0 +1,47 @@
+#include "bb/search_tree_file.h"
+#include <fstream>
+
+namespace bb {
+
+bool writeSearchTree(const std::string& path, const SearchTree& tree) {
+    SearchTreeFileHeader h;
+    h.numNodes = static_cast<uint32_t>(tree.nodes.size());
+    h.macro = tree.macro ? 1 : 0;
+    h.searchingSide = static_cast<uint8_t>(tree.searchingSide);
+    h.minVisits = tree.minVisits;
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(tree.nodes.data()),
+              static_cast<std::streamsize>(tree.nodes.size() * sizeof(SearchTreeRecord)));
+    return static_cast<bool>(out);
+}
+
+std::unique_ptr<SearchTree> readSearchTree(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return nullptr;
+    uint64_t size = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+    SearchTreeFileHeader h;
+    if (!file.read(reinterpret_cast<char*>(&h), sizeof(h)) ||
+        h.magic != SEARCH_TREE_MAGIC || h.version != SEARCH_TREE_VERSION || h.searchingSide > 1 ||
+        size != sizeof(h) + uint64_t{h.numNodes} * sizeof(SearchTreeRecord)) return nullptr;
+
+    auto tree = std::make_unique<SearchTree>();
+    tree->macro = h.macro != 0;
+    tree->searchingSide = static_cast<TeamSide>(h.searchingSide);
+    tree->minVisits = h.minVisits;
+    tree->nodes.resize(h.numNodes);
+    if (!file.read(reinterpret_cast<char*>(tree->nodes.data()),
+                   static_cast<std::streamsize>(tree->nodes.size() * sizeof(SearchTreeRecord)))) {
+        return nullptr;
+    }
+    // Parents come first: a row pointing forward (or out of range) is corrupt
+    for (size_t i = 0; i < tree->nodes.size(); ++i) {
+        int32_t parent = tree->nodes[i].parent;
+        if (i == 0 ? parent != -1 : parent < 0 || static_cast<size_t>(parent) >= i) return nullptr;
+    }
+    return tree;
+}
+
+} // namespace bb
@@ -0,0 +1,457 @@
+#include "bb/self_play_cluster.h"
+#include "bb/batched_self_play.h"
+#include "bb/model_cache.h"
+#include "bb/roster.h"
+#include "bb/sweep.h"
+#include "bb/training_shards.h"
+#include <nlohmann/json.hpp>
+#include <sys/socket.h>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+namespace bb {
+
+namespace {
+
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+constexpr int WAIT_MS = 1000;  // a worker's pause when every open unit is leased out
+
+json specToJson(const ClusterRunSpec& spec) {
+    json search = json::object();
+    for (const auto& [field, value] : spec.search) search[field] = value;
+    return {
+        {"home", spec.home},
+        {"away", spec.away},
+        {"model", spec.modelHash},
+        {"search", std::move(search)},
+        {"concurrent_games", spec.concurrentGames},
+        {"top_k", spec.topK},
+        {"full_kickoff", spec.useFullKickoff},
+    };
+}
+
+ClusterRunSpec specFromJson(const json& j) {
+    ClusterRunSpec spec;
+    spec.home = j.value("home", spec.home);
+    spec.away = j.value("away", spec.away);
+    spec.modelHash = j.value("model", std::string());
+    if (j.contains("search")) {
+        for (const auto& [field, value] : j["search"].items()) spec.search[field] = value.get<double>();
+    }
+    spec.concurrentGames = j.value("concurrent_games", spec.concurrentGames);
+    spec.topK = j.value("top_k", spec.topK);
+    spec.useFullKickoff = j.value("full_kickoff", spec.useFullKickoff);
+    return spec;
+}
+
+float outcomeFor(const GameResult& r, TeamSide side) {
+    int diff = side == TeamSide::HOME ? r.homeScore - r.awayScore : r.awayScore - r.homeScore;
+    return diff > 0 ? 1.0f : diff < 0 ? -1.0f : 0.0f;
+}
+
+bool readFile(const fs::path& path, std::vector<uint8_t>& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+} // anonymous namespace
+
+// --- Content hashes and the model store ---
+
+std::string contentHash(const std::vector<uint8_t>& bytes) {
+    uint64_t lanes[2] = {0xcbf29ce484222325ULL, 0x84222325cbf29ce4ULL};
+    for (int lane = 0; lane < 2; ++lane) {
+        uint64_t h = lanes[lane] ^ bytes.size();
+        for (uint8_t b : bytes) {
+            h ^= static_cast<uint64_t>(b) + static_cast<uint64_t>(lane);
+            h *= 0x100000001b3ULL;
+        }
+        lanes[lane] = h;
+    }
+    char hex[33];
+    std::snprintf(hex, sizeof(hex), "%016llx%016llx", static_cast<unsigned long long>(lanes[0]),
+                  static_cast<unsigned long long>(lanes[1]));
+    return hex;
+}
+
+ContentStore::ContentStore(std::string dir) : dir_(std::move(dir)) {
+    fs::create_directories(dir_);
+}
+
+std::string ContentStore::path(const std::string& hash) const {
+    return (fs::path(dir_) / (hash + ".model")).string();
+}
+
+bool ContentStore::has(const std::string& hash) const {
+    return fs::exists(path(hash));
+}
+
+bool ContentStore::put(const std::string& hash, const std::vector<uint8_t>& bytes) {
+    if (contentHash(bytes) != hash) return false;
+    std::string final = path(hash);
+    std::string temp = final + ".part";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!out) return false;
+    }
+    std::error_code ec;
+    fs::rename(temp, final, ec);
+    return !ec;
+}
+
+// --- Coordinator bookkeeping ---
+
+ClusterCoordinator::ClusterCoordinator(ClusterRunConfig config) : config_(std::move(config)) {
+    if (config_.games <= 0) throw std::invalid_argument("ClusterCoordinator: no games");
+    if (config_.unitGames <= 0) throw std::invalid_argument("ClusterCoordinator: unitGames must be positive");
+    if (config_.maxAttempts <= 0) throw std::invalid_argument("ClusterCoordinator: maxAttempts must be positive");
+    if (config_.spec.modelHash.empty()) throw std::invalid_argument("ClusterCoordinator: no model hash");
+    units_.resize(static_cast<size_t>((config_.games + config_.unitGames - 1) / config_.unitGames));
+}
+
+std::optional<WorkUnit> ClusterCoordinator::assign(const std::string& worker, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (uint32_t id = 0; id < units_.size(); ++id) {
+        Unit& u = units_[id];
+        if (u.state != UnitState::PENDING) continue;
+        u.state = UnitState::LEASED;
+        u.attempts++;
+        u.worker = worker;
+        u.leased = now;
+        WorkUnit unit;
+        unit.id = id;
+        unit.attempt = u.attempts;
+        unit.firstSeed = config_.firstSeed + id * static_cast<uint32_t>(config_.unitGames);
+        unit.games = std::min(config_.unitGames, config_.games - static_cast<int>(id) * config_.unitGames);
+        unit.spec = config_.spec;
+        return unit;
+    }
+    return std::nullopt;
+}
+
+bool ClusterCoordinator::complete(uint32_t id, UnitResult result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id >= units_.size()) return false;
+    Unit& u = units_[id];
+    if (u.state == UnitState::DONE || u.state == UnitState::FAILED) return false;
+    u.state = UnitState::DONE;
+    results_[id] = std::move(result);
+    return true;
+}
+
+void ClusterCoordinator::failLocked(uint32_t id, const std::string& error) {
+    Unit& u = units_[id];
+    u.lastError = error;
+    u.worker.clear();
+    u.state = u.attempts >= config_.maxAttempts ? UnitState::FAILED : UnitState::PENDING;
+}
+
+void ClusterCoordinator::fail(uint32_t id, int attempt, const std::string& error) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id >= units_.size()) return;
+    const Unit& u = units_[id];
+    if (u.state != UnitState::LEASED || u.attempts != attempt) return;
+    failLocked(id, error);
+}
+
+void ClusterCoordinator::workerLost(const std::string& worker) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (uint32_t id = 0; id < units_.size(); ++id) {
+        if (units_[id].state == UnitState::LEASED && units_[id].worker == worker) {
+            failLocked(id, "worker lost: " + worker);
+        }
+    }
+}
+
+int ClusterCoordinator::expireLeases(Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int expired = 0;
+    for (uint32_t id = 0; id < units_.size(); ++id) {
+        const Unit& u = units_[id];
+        if (u.state == UnitState::LEASED && now - u.leased >= std::chrono::milliseconds(config_.leaseMs)) {
+            failLocked(id, "lease expired");
+            expired++;
+        }
+    }
+    return expired;
+}
+
+bool ClusterCoordinator::finished() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::all_of(units_.begin(), units_.end(), [](const Unit& u) {
+        return u.state == UnitState::DONE || u.state == UnitState::FAILED;
+    });
+}
+
+int ClusterCoordinator::completed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(std::count_if(units_.begin(), units_.end(),
+                                          [](const Unit& u) { return u.state == UnitState::DONE; }));
+}
+
+int ClusterCoordinator::failed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(std::count_if(units_.begin(), units_.end(),
+                                          [](const Unit& u) { return u.state == UnitState::FAILED; }));
+}
+
+std::map<uint32_t, UnitResult> ClusterCoordinator::takeResults() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<uint32_t, UnitResult> out;
+    out.swap(results_);
+    return out;
+}
+
+// --- Playing a unit ---
+
+UnitResult runWorkUnit(const WorkUnit& unit, const ValueFunction& model, const std::string& scratchDir) {
+    const TeamRoster* home = getRosterByName(unit.spec.home);
+    const TeamRoster* away = getRosterByName(unit.spec.away);
+    if (!home || !away) throw std::invalid_argument("runWorkUnit: unknown roster");
+
+    BatchedSelfPlayConfig config;
+    config.concurrentGames = unit.spec.concurrentGames;
+    config.topK = unit.spec.topK;
+    config.useFullKickoff = unit.spec.useFullKickoff;
+    config.logBoards = false;
+    // Iteration budgets unless the run says otherwise: a retried unit
+    // replays the same games
+    config.search.timeBudgetMs = 0;
+    for (const auto& [field, value] : unit.spec.search) {
+        if (!setSearchParameter(config.search, field, value)) {
+            throw std::invalid_argument("runWorkUnit: unknown search field: " + field);
+        }
+    }
+    std::vector<uint32_t> seeds(static_cast<size_t>(unit.games));
+    for (int g = 0; g < unit.games; ++g) seeds[g] = unit.firstSeed + static_cast<uint32_t>(g);
+    BatchedSelfPlayResult played = runBatchedSelfPlay(*home, *away, model, config, seeds);
+
+    UnitResult result;
+    fs::remove_all(scratchDir);
+    {
+        ShardWriter writer(scratchDir);
+        for (const LoggedGameResult& game : played.games) {
+            const GameResult& r = game.result;
+            if (r.homeScore > r.awayScore) result.homeWins++;
+            else if (r.awayScore > r.homeScore) result.awayWins++;
+            else result.draws++;
+            result.totalActions += r.totalActions;
+            writer.appendGame(game, outcomeFor(r, TeamSide::HOME), outcomeFor(r, TeamSide::AWAY));
+        }
+        writer.close();
+    }
+    std::vector<fs::path> paths;
+    for (const auto& entry : fs::recursive_directory_iterator(scratchDir)) {
+        if (entry.is_regular_file()) paths.push_back(entry.path());
+    }
+    std::sort(paths.begin(), paths.end());
+    for (const fs::path& p : paths) {
+        ClusterFile file;
+        file.name = fs::relative(p, scratchDir).generic_string();
+        if (!readFile(p, file.bytes)) throw std::runtime_error("runWorkUnit: cannot read " + p.string());
+        result.files.push_back(std::move(file));
+    }
+    fs::remove_all(scratchDir);
+    return result;
+}
+
+// --- Framing ---
+
+bool ClusterChannel::readLine(std::string& line) {
+    for (;;) {
+        size_t end = buffer_.find('\n');
+        if (end != std::string::npos) {
+            line = buffer_.substr(0, end);
+            buffer_.erase(0, end + 1);
+            return true;
+        }
+        char chunk[65536];
+        ssize_t n = ::recv(fd_, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        buffer_.append(chunk, static_cast<size_t>(n));
+    }
+}
+
+bool ClusterChannel::readBytes(size_t n, std::vector<uint8_t>& out) {
+    out.resize(n);
+    size_t have = std::min(n, buffer_.size());
+    std::copy(buffer_.begin(), buffer_.begin() + static_cast<std::ptrdiff_t>(have), out.begin());
+    buffer_.erase(0, have);
+    while (have < n) {
+        ssize_t got = ::recv(fd_, out.data() + have, n - have, 0);
+        if (got <= 0) return false;
+        have += static_cast<size_t>(got);
+    }
+    return true;
+}
+
+bool ClusterChannel::writeBytes(const std::vector<uint8_t>& bytes) {
+    size_t sent = 0;
+    while (sent < bytes.size()) {
+        ssize_t n = ::send(fd_, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool ClusterChannel::writeLine(const std::string& line) {
+    std::vector<uint8_t> bytes(line.begin(), line.end());
+    bytes.push_back('\n');
+    return writeBytes(bytes);
+}
+
+// --- Conversation ---
+
+void serveClusterConnection(ClusterCoordinator& coordinator, ClusterChannel& channel,
+                            const std::vector<uint8_t>& model) {
+    const std::string modelHash = coordinator.config().spec.modelHash;
+    std::string worker = "anonymous";
+    std::string line;
+    while (channel.readLine(line)) {
+        json msg = json::parse(line, nullptr, false);
+        if (msg.is_discarded() || !msg.is_object()) continue;
+        std::string op = msg.value("op", std::string());
+
+        if (op == "hello") {
+            worker = msg.value("worker", worker);
+        } else if (op == "next") {
+            coordinator.expireLeases();
+            std::optional<WorkUnit> unit = coordinator.assign(worker);
+            json reply;
+            if (unit) {
+                reply = specToJson(unit->spec);
+                reply["op"] = "unit";
+                reply["unit"] = unit->id;
+                reply["attempt"] = unit->attempt;
+                reply["first_seed"] = unit->firstSeed;
+                reply["games"] = unit->games;
+            } else if (coordinator.finished()) {
+                reply = {{"op", "done"}};
+            } else {
+                reply = {{"op", "wait"}, {"ms", WAIT_MS}};
+            }
+            if (!channel.writeLine(reply.dump())) break;
+        } else if (op == "model") {
+            std::string hash = msg.value("hash", std::string());
+            if (hash != modelHash) {
+                if (!channel.writeLine(json{{"op", "error"}, {"error", "unknown model " + hash}}.dump())) break;
+                continue;
+            }
+            json header = {{"op", "model"}, {"hash", hash}, {"bytes", model.size()}};
+            if (!channel.writeLine(header.dump()) || !channel.writeBytes(model)) break;
+        } else if (op == "result") {
+            uint32_t id = msg.value("unit", 0u);
+            UnitResult result;
+            result.homeWins = msg.value("home_wins", 0);
+            result.awayWins = msg.value("away_wins", 0);
+            result.draws = msg.value("draws", 0);
+            result.totalActions = msg.value("total_actions", 0L);
+            bool ok = true;
+            for (const json& f : msg.value("files", json::array())) {
+                ClusterFile file;
+                file.name = f.value("name", std::string());
+                ok = channel.readBytes(f.value("bytes", size_t{0}), file.bytes);
+                if (!ok) break;
+                result.files.push_back(std::move(file));
+            }
+            if (!ok) break;
+            coordinator.complete(id, std::move(result));
+            if (!channel.writeLine(json{{"op", "ack"}, {"unit", id}}.dump())) break;
+        } else if (op == "failed") {
+            coordinator.fail(msg.value("unit", 0u), msg.value("attempt", 0),
+                             msg.value("error", std::string("unspecified")));
+        }
+    }
+    coordinator.workerLost(worker);
+}
+
+int runClusterWorker(ClusterChannel& channel, const ClusterWorkerOptions& options, bool* finished) {
+    ContentStore store(options.cacheDir);
+    ModelCache models;
+    int done = 0;
+    if (finished) *finished = false;
+    if (!channel.writeLine(json{{"op", "hello"}, {"worker", options.name}}.dump())) return done;
+
+    std::string line;
+    while (options.maxUnits <= 0 || done < options.maxUnits) {
+        if (!channel.writeLine(json{{"op", "next"}}.dump()) || !channel.readLine(line)) break;
+        json msg = json::parse(line, nullptr, false);
+        if (msg.is_discarded()) break;
+        std::string op = msg.value("op", std::string());
+        if (op == "done") {
+            if (finished) *finished = true;
+            break;
+        }
+        if (op == "wait") {
+            std::this_thread::sleep_for(std::chrono::milliseconds(msg.value("ms", WAIT_MS)));
+            continue;
+        }
+        if (op != "unit") break;
+
+        WorkUnit unit;
+        unit.spec = specFromJson(msg);
+        unit.id = msg.value("unit", 0u);
+        unit.attempt = msg.value("attempt", 0);
+        unit.firstSeed = msg.value("first_seed", 0u);
+        unit.games = msg.value("games", 0);
+        auto failUnit = [&](const std::string& error) {
+            return channel.writeLine(json{{"op", "failed"}, {"unit", unit.id},
+                                          {"attempt", unit.attempt}, {"error", error}}.dump());
+        };
+
+        // The model, fetched once per machine
+        if (!store.has(unit.spec.modelHash)) {
+            json request = {{"op", "model"}, {"hash", unit.spec.modelHash}};
+            std::vector<uint8_t> bytes;
+            if (!channel.writeLine(request.dump()) || !channel.readLine(line)) break;
+            json header = json::parse(line, nullptr, false);
+            if (header.is_discarded() || header.value("op", std::string()) != "model") {
+                if (!failUnit("model not available")) break;
+                continue;
+            }
+            if (!channel.readBytes(header.value("bytes", size_t{0}), bytes)) break;
+            if (!store.put(unit.spec.modelHash, bytes)) {
+                if (!failUnit("model does not match its hash")) break;
+                continue;
+            }
+        }
+        std::shared_ptr<LoadedModel> model = models.get(store.path(unit.spec.modelHash));
+        if (!model || !model->value) {
+            if (!failUnit("no value network in model " + unit.spec.modelHash)) break;
+            continue;
+        }
+
+        UnitResult result;
+        try {
+            result = runWorkUnit(unit, *model->value, options.scratchDir);
+        } catch (const std::exception& e) {
+            if (!failUnit(e.what())) break;
+            continue;
+        }
+
+        json header = {{"op", "result"}, {"unit", unit.id}, {"attempt", unit.attempt},
+                       {"home_wins", result.homeWins}, {"away_wins", result.awayWins},
+                       {"draws", result.draws}, {"total_actions", result.totalActions}};
+        json files = json::array();
+        for (const ClusterFile& f : result.files) files.push_back({{"name", f.name}, {"bytes", f.bytes.size()}});
+        header["files"] = std::move(files);
+        bool sent = channel.writeLine(header.dump());
+        for (const ClusterFile& f : result.files) sent = sent && channel.writeBytes(f.bytes);
+        if (!sent || !channel.readLine(line)) break;
+        done++;
+        if (finished && done == options.maxUnits) *finished = true;
+    }
+    return done;
+}
+
+} // namespace bb
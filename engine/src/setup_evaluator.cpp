@@ -0,0 +1,70 @@
+#include "bb/setup_evaluator.h"
+#include "bb/kickoff_handler.h"
+
+namespace bb {
+
+namespace {
+
+int baseIdOf(TeamSide side) { return side == TeamSide::HOME ? 1 : 12; }
+
+bool hasStandingKicker(const GameState& state, TeamSide side) {
+    bool found = false;
+    state.forEachOnPitch(side, [&](const Player& p) {
+        if (p.state == PlayerState::STANDING && p.hasSkill(SkillName::Kick)) found = true;
+    });
+    return found;
+}
+
+} // anonymous namespace
+
+SetupCandidate currentSetup(const GameState& state, TeamSide side) {
+    SetupCandidate c;
+    for (int i = 0; i < 11; ++i) c.squares[i] = state.getPlayer(baseIdOf(side) + i).position;
+    return c;
+}
+
+std::vector<float> evaluateSetups(const GameState& state, TeamSide side,
+                                  const std::vector<SetupCandidate>& candidates,
+                                  const ValueFunction& vf, TeamSide perspective) {
+    std::vector<float> values(candidates.size(), 0.0f);
+    if (candidates.empty()) return values;
+
+    TeamSide receiving = opponent(state.kickingTeam);
+    const int width = vf.inputSize();
+    std::vector<float> rows;
+    std::vector<float> weights;             // landing chance per row
+    std::vector<int> counts;                // rows per candidate
+    counts.reserve(candidates.size());
+
+    for (const SetupCandidate& candidate : candidates) {
+        GameState placed = state.clone();
+        for (int i = 0; i < 11; ++i) {
+            Player& p = placed.getPlayer(baseIdOf(side) + i);
+            if (p.isOnPitch()) p.position = candidate.squares[i];
+        }
+        placed.invalidateOccupancy();
+        placed.phase = GamePhase::PLAY;
+        placed.activeTeam = receiving;
+
+        // Kick is read from the setup: a candidate may move the kicker
+        const KickTable& kick = kickTable(kickTarget(placed), hasStandingKicker(placed, state.kickingTeam));
+        for (int l = 0; l < kick.landingCount; ++l) {
+            GameState landed = placed.clone();
+            placeKickedBall(landed, receiving, kick.landings[l].square);
+            rows.resize(rows.size() + width);
+            vf.encodeState(landed, perspective, rows.data() + rows.size() - width);
+            weights.push_back(kick.landings[l].probability);
+        }
+        counts.push_back(kick.landingCount);
+    }
+
+    std::vector<float> out(weights.size());
+    vf.evaluateBatch(rows.data(), static_cast<int>(weights.size()), width, out.data());
+    size_t row = 0;
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        for (int l = 0; l < counts[c]; ++l, ++row) values[c] += weights[row] * out[row];
+    }
+    return values;
+}
+
+} // namespace bb
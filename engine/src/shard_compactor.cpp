@@ -0,0 +1,234 @@
+#include "bb/shard_compactor.h"
+#include "bb/mapped_file.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace bb {
+
+namespace {
+
+constexpr size_t EMIT_BLOCK = 4096;  // records per appendRecords call
+
+struct InputShard {
+    std::string base;  // dir + "/shard-NNNNNN."
+    uint64_t states = 0;
+    uint64_t decisions = 0;
+    uint64_t visits = 0;
+};
+
+struct Group {
+    ShardDecisionRecord record;
+    std::vector<ShardVisitRecord> visits;
+};
+
+std::vector<InputShard> listShards(const std::string& dir) {
+    std::map<int, nlohmann::json> entries;
+    std::ifstream index(dir + "/index.jsonl");
+    std::string line;
+    while (std::getline(index, line)) {
+        auto entry = nlohmann::json::parse(line, nullptr, false);
+        if (entry.is_discarded()) continue;
+        entries.emplace(entry.value("shard", -1), std::move(entry));
+    }
+    std::vector<InputShard> shards;
+    for (const auto& [shard, entry] : entries) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/shard-%06d.", shard);
+        InputShard s;
+        s.base = dir + name;
+        if (entry.value("zstd", false)) {
+            throw std::runtime_error("compactShards: " + s.base + "* is compressed; only raw shards can be read");
+        }
+        s.states = entry.value("states", uint64_t{0});
+        s.decisions = entry.value("decisions", uint64_t{0});
+        s.visits = entry.value("visits", uint64_t{0});
+        shards.push_back(std::move(s));
+    }
+    return shards;
+}
+
+// The rows of one shard file after checking its header against this build.
+template<typename Record>
+const Record* mapRows(const std::string& path, ShardKind kind, uint64_t count,
+                      std::shared_ptr<const MappedFile>& file) {
+    if (count == 0) return nullptr;
+    file = std::make_shared<const MappedFile>(path);
+    ShardFileHeader h;
+    if (!file->ok() || file->size() < sizeof(h)) throw std::runtime_error("compactShards: cannot map " + path);
+    std::memcpy(&h, file->bytes(), sizeof(h));
+    if (h.magic != SHARD_FILE_MAGIC || h.version != SHARD_FILE_VERSION || h.kind != kind ||
+        h.recordSize != sizeof(Record) || h.numFeatures != NUM_FEATURES ||
+        h.numActionFeatures != NUM_ACTION_FEATURES || file->size() < sizeof(h) + count * sizeof(Record)) {
+        throw std::runtime_error("compactShards: " + path + " does not match this build's records");
+    }
+    return reinterpret_cast<const Record*>(file->bytes() + sizeof(h));
+}
+
+// Records written before visit weights existed count one per sample.
+float weightOf(const ShardDecisionRecord& r) {
+    return r.visitWeight > 0.0f ? r.visitWeight : static_cast<float>(std::max(r.samples, 1u));
+}
+
+bool lowInformation(const ShardDecisionRecord& r, const ShardVisitRecord* visits, const CompactorConfig& config) {
+    if (static_cast<int>(r.numVisits) < config.minActions) return true;
+    if (r.visitWeight < config.minVisitWeight) return true;
+    float top = 0.0f;
+    for (uint32_t i = 0; i < r.numVisits; ++i) top = std::max(top, visits[i].visitFraction);
+    return top > config.maxTopFraction;
+}
+
+void mergeOutcome(ShardDecisionRecord& into, const ShardDecisionRecord& r) {
+    uint32_t a = std::max(into.samples, 1u), b = std::max(r.samples, 1u);
+    into.outcome = (into.outcome * a + r.outcome * b) / static_cast<float>(a + b);
+    into.samples = a + b;
+}
+
+// Visit-weighted average of two distributions over the union of their
+// actions, most visited first.
+void mergeVisits(Group& g, const ShardDecisionRecord& r, const ShardVisitRecord* visits) {
+    float wa = weightOf(g.record), wb = weightOf(r);
+    float total = wa + wb;
+    for (ShardVisitRecord& v : g.visits) v.visitFraction *= wa / total;
+    size_t existing = g.visits.size();
+    for (uint32_t i = 0; i < r.numVisits; ++i) {
+        const ShardVisitRecord& v = visits[i];
+        float share = v.visitFraction * wb / total;
+        auto end = g.visits.begin() + static_cast<std::ptrdiff_t>(existing);
+        auto same = std::find_if(g.visits.begin(), end, [&](const ShardVisitRecord& e) {
+            return std::memcmp(e.actionFeatures, v.actionFeatures, sizeof(v.actionFeatures)) == 0;
+        });
+        if (same != end) {
+            same->visitFraction += share;
+        } else {
+            g.visits.push_back(v);
+            g.visits.back().visitFraction = share;
+        }
+    }
+    std::stable_sort(g.visits.begin(), g.visits.end(), [](const ShardVisitRecord& a, const ShardVisitRecord& b) {
+        return a.visitFraction > b.visitFraction;
+    });
+    g.record.visitWeight = total;
+}
+
+uint32_t partitionOf(uint64_t key, uint32_t partitions) {
+    return static_cast<uint32_t>(((key * 0x9E3779B97F4A7C15ull) >> 32) % partitions);
+}
+
+} // anonymous namespace
+
+CompactorStats compactShards(const std::vector<std::string>& inputDirs, const std::string& outputDir,
+                             const CompactorConfig& config) {
+    if (config.memoryBytes == 0) throw std::invalid_argument("compactShards: memoryBytes must be positive");
+    std::error_code ec;
+    auto outPath = std::filesystem::weakly_canonical(outputDir, ec);
+    std::vector<InputShard> shards;
+    for (const std::string& dir : inputDirs) {
+        if (std::filesystem::weakly_canonical(dir, ec) == outPath) {
+            throw std::invalid_argument("compactShards: " + outputDir + " is also an input");
+        }
+        std::vector<InputShard> listed = listShards(dir);
+        shards.insert(shards.end(), listed.begin(), listed.end());
+    }
+
+    // Partitions: enough that the groups of one fit the budget even if
+    // every decision were distinct
+    uint64_t decisions = 0, visits = 0;
+    for (const InputShard& s : shards) {
+        decisions += s.decisions;
+        visits += s.visits;
+    }
+    double bytes = static_cast<double>(decisions) * (sizeof(Group) + 2 * sizeof(void*) + 2 * sizeof(uint64_t)) +
+                   static_cast<double>(visits) * sizeof(ShardVisitRecord);
+    uint32_t partitions = std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil(bytes / config.memoryBytes)));
+
+    CompactorStats stats;
+    stats.passes = static_cast<int>(partitions);
+    ShardWriter writer(outputDir, config.output);
+    std::vector<ShardStateRecord> stateBlock;
+    std::vector<ShardDecisionRecord> decisionBlock;
+    std::vector<ShardVisitRecord> visitBlock;
+
+    if (config.copyStates) {
+        for (const InputShard& s : shards) {
+            std::shared_ptr<const MappedFile> file;
+            const auto* rows = mapRows<ShardStateRecord>(s.base + "states", ShardKind::STATES, s.states, file);
+            for (uint64_t i = 0; i < s.states; i += EMIT_BLOCK) {
+                stateBlock.assign(rows + i, rows + std::min<uint64_t>(s.states, i + EMIT_BLOCK));
+                writer.appendRecords(stateBlock, decisionBlock, visitBlock);
+                stats.statesOut += stateBlock.size();
+            }
+        }
+        stateBlock.clear();
+    }
+
+    for (uint32_t pass = 0; pass < partitions; ++pass) {
+        std::unordered_map<uint64_t, uint32_t> index;
+        std::vector<Group> groups;
+        for (const InputShard& s : shards) {
+            std::shared_ptr<const MappedFile> decisionFile, visitFile;
+            const auto* rows = mapRows<ShardDecisionRecord>(s.base + "decisions", ShardKind::DECISIONS,
+                                                            s.decisions, decisionFile);
+            const auto* visitRows = mapRows<ShardVisitRecord>(s.base + "visits", ShardKind::VISITS, s.visits,
+                                                              visitFile);
+            for (uint64_t i = 0; i < s.decisions; ++i) {
+                const ShardDecisionRecord& r = rows[i];
+                uint64_t key = config.canonical ? r.canonicalHash : r.stateHash;
+                if (partitionOf(key, partitions) != pass) continue;
+                if (static_cast<uint64_t>(r.firstVisit) + r.numVisits > s.visits) {
+                    throw std::runtime_error("compactShards: " + s.base + "decisions has visit rows out of range");
+                }
+                const ShardVisitRecord* v = visitRows ? visitRows + r.firstVisit : nullptr;
+                stats.decisionsIn++;
+                stats.visitsIn += r.numVisits;
+                if (lowInformation(r, v, config)) {
+                    stats.dropped++;
+                    continue;
+                }
+                auto [it, fresh] = index.emplace(key, static_cast<uint32_t>(groups.size()));
+                if (fresh) {
+                    Group& g = groups.emplace_back();
+                    g.record = r;
+                    g.record.samples = std::max(r.samples, 1u);
+                    g.visits.assign(v, v + r.numVisits);
+                    continue;
+                }
+                Group& g = groups[it->second];
+                stats.merged++;
+                if (r.stateHash == g.record.stateHash) {
+                    mergeVisits(g, r, v);
+                } else {
+                    stats.mirrorMerged++;
+                }
+                mergeOutcome(g.record, r);
+            }
+        }
+
+        for (size_t i = 0; i < groups.size(); ++i) {
+            Group& g = groups[i];
+            g.record.firstVisit = static_cast<uint32_t>(visitBlock.size());
+            g.record.numVisits = static_cast<uint32_t>(g.visits.size());
+            decisionBlock.push_back(g.record);
+            visitBlock.insert(visitBlock.end(), g.visits.begin(), g.visits.end());
+            if (decisionBlock.size() == EMIT_BLOCK || i + 1 == groups.size()) {
+                stats.decisionsOut += decisionBlock.size();
+                stats.visitsOut += visitBlock.size();
+                writer.appendRecords(stateBlock, decisionBlock, visitBlock);
+                decisionBlock.clear();
+                visitBlock.clear();
+            }
+        }
+    }
+    writer.close();
+    return stats;
+}
+
+} // namespace bb
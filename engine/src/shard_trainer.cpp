@@ -0,0 +1,519 @@
+#include "bb/shard_trainer.h"
+#include "bb/mapped_file.h"
+#include "bb/policy_network.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+
+namespace bb {
+
+struct ShardTrainer::Sample {
+    const float* features;           // state features
+    float outcome;                   // value models
+    const ShardVisitRecord* visits;  // policy models
+    uint32_t numVisits;
+};
+
+namespace {
+
+constexpr const char* MODEL_NAMES[] = {"linear_value", "neural_value", "linear_policy", "neural_policy"};
+
+double uniform01(Xoshiro256& rng) {
+    return static_cast<double>(rng.next() >> 11) * 0x1.0p-53;
+}
+
+// The rows of one shard file after checking its header against this build.
+const char* mapRows(const std::string& path, ShardKind kind, uint32_t recordSize, uint64_t count,
+                    std::vector<std::shared_ptr<const MappedFile>>& files) {
+    if (count == 0) return nullptr;
+    auto file = std::make_shared<const MappedFile>(path);
+    ShardFileHeader h;
+    if (!file->ok() || file->size() < sizeof(h)) {
+        throw std::runtime_error("ShardTrainer: cannot map " + path);
+    }
+    std::memcpy(&h, file->bytes(), sizeof(h));
+    if (h.magic != SHARD_FILE_MAGIC || h.version != SHARD_FILE_VERSION || h.kind != kind ||
+        h.recordSize != recordSize || h.numFeatures != NUM_FEATURES ||
+        h.numActionFeatures != NUM_ACTION_FEATURES ||
+        file->size() < sizeof(h) + count * recordSize) {
+        throw std::runtime_error("ShardTrainer: " + path + " does not match this build's records");
+    }
+    files.push_back(file);
+    return file->bytes() + sizeof(h);
+}
+
+std::vector<float> floats(const nlohmann::json& j) {
+    std::vector<float> out;
+    out.reserve(j.size());
+    for (const auto& v : j) out.push_back(v.is_array() ? v[0].get<float>() : v.get<float>());
+    return out;
+}
+
+float scalar(const nlohmann::json& j) {
+    return j.is_array() ? j[0].get<float>() : j.get<float>();
+}
+
+} // anonymous namespace
+
+const char* trainerModelName(TrainerModel model) {
+    return MODEL_NAMES[static_cast<int>(model)];
+}
+
+bool parseTrainerModel(const std::string& name, TrainerModel& out) {
+    for (int m = 0; m < 4; ++m) {
+        if (name == MODEL_NAMES[m]) {
+            out = static_cast<TrainerModel>(m);
+            return true;
+        }
+    }
+    return false;
+}
+
+ShardTrainer::ShardTrainer(std::string dir, TrainerConfig config)
+    : dir_(std::move(dir)), config_(std::move(config)) {
+    bool neural = config_.model == TrainerModel::NEURAL_VALUE ||
+                  config_.model == TrainerModel::NEURAL_POLICY;
+    if (neural && config_.hiddenSize <= 0) {
+        throw std::invalid_argument("ShardTrainer: hiddenSize must be positive");
+    }
+    if (config_.batchSize <= 0) throw std::invalid_argument("ShardTrainer: batchSize must be positive");
+    if (config_.threads <= 0) throw std::invalid_argument("ShardTrainer: threads must be positive");
+    if (!(config_.learningRate > 0.0f)) {
+        throw std::invalid_argument("ShardTrainer: learningRate must be positive");
+    }
+
+    mapShards();
+    int in = inputSize();
+    int H = config_.hiddenSize;
+    size_t n = neural ? static_cast<size_t>(H) * in + 2 * H + 1
+                      : static_cast<size_t>(in) + (policyModel() ? 1 : 0);
+    params_.assign(n, 0.0f);
+    moment1_.assign(n, 0.0f);
+    moment2_.assign(n, 0.0f);
+    grads_.assign(CHUNKS, AlignedVector<float>(n, 0.0f));
+    scratch_.resize(config_.threads);
+    rng_.seed(config_.seed, 0, 0, 0);
+    if (config_.initialWeights.empty()) {
+        initWeights();
+    } else {
+        loadWeights(config_.initialWeights);
+    }
+    if (config_.threads > 1) pool_ = std::make_unique<WorkerPool>(config_.threads - 1);
+}
+
+ShardTrainer::~ShardTrainer() = default;
+
+bool ShardTrainer::policyModel() const {
+    return config_.model == TrainerModel::LINEAR_POLICY || config_.model == TrainerModel::NEURAL_POLICY;
+}
+
+int ShardTrainer::inputSize() const {
+    return policyModel() ? POLICY_INPUT_SIZE : NUM_FEATURES;
+}
+
+uint64_t ShardTrainer::samples() const {
+    return samples_.size();
+}
+
+void ShardTrainer::mapShards() {
+    std::map<int, nlohmann::json> entries;
+    std::ifstream index(dir_ + "/index.jsonl");
+    std::string line;
+    while (std::getline(index, line)) {
+        auto entry = nlohmann::json::parse(line, nullptr, false);
+        if (entry.is_discarded()) continue;
+        entries.emplace(entry.value("shard", -1), std::move(entry));
+    }
+
+    for (const auto& [shard, entry] : entries) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/shard-%06d.", shard);
+        std::string base = dir_ + name;
+        if (entry.value("zstd", false)) {
+            throw std::runtime_error("ShardTrainer: " + base + "* is compressed; only raw shards can be mapped");
+        }
+        if (!policyModel()) {
+            uint64_t count = entry.value("states", uint64_t{0});
+            auto rows = reinterpret_cast<const ShardStateRecord*>(
+                mapRows(base + "states", ShardKind::STATES, sizeof(ShardStateRecord), count, files_));
+            for (uint64_t i = 0; i < count; ++i) {
+                samples_.push_back({rows[i].features, rows[i].outcome, nullptr, 0});
+            }
+            continue;
+        }
+        uint64_t count = entry.value("decisions", uint64_t{0});
+        uint64_t visitCount = entry.value("visits", uint64_t{0});
+        auto rows = reinterpret_cast<const ShardDecisionRecord*>(
+            mapRows(base + "decisions", ShardKind::DECISIONS, sizeof(ShardDecisionRecord), count, files_));
+        auto visits = reinterpret_cast<const ShardVisitRecord*>(
+            mapRows(base + "visits", ShardKind::VISITS, sizeof(ShardVisitRecord), visitCount, files_));
+        for (uint64_t i = 0; i < count; ++i) {
+            const ShardDecisionRecord& d = rows[i];
+            if (d.numVisits == 0) continue;
+            if (static_cast<uint64_t>(d.firstVisit) + d.numVisits > visitCount) {
+                throw std::runtime_error("ShardTrainer: " + base + "decisions points past its visits");
+            }
+            samples_.push_back({d.stateFeatures, d.outcome, visits + d.firstVisit, d.numVisits});
+        }
+    }
+    if (samples_.empty()) throw std::runtime_error("ShardTrainer: no samples in " + dir_);
+    if (samples_.size() > UINT32_MAX) throw std::runtime_error("ShardTrainer: too many samples in " + dir_);
+    order_.resize(samples_.size());
+    for (size_t i = 0; i < order_.size(); ++i) order_[i] = static_cast<uint32_t>(i);
+}
+
+void ShardTrainer::initWeights() {
+    // Linear models start at zero (uniform priors, a value of 0), as the
+    // Python trainers do; hidden layers get Xavier-uniform weights and zero
+    // biases.
+    if (config_.model == TrainerModel::LINEAR_VALUE || config_.model == TrainerModel::LINEAR_POLICY) return;
+    int in = inputSize();
+    int H = config_.hiddenSize;
+    float limit1 = std::sqrt(6.0f / (in + H));
+    float limit2 = std::sqrt(6.0f / (H + 1));
+    size_t w1 = static_cast<size_t>(H) * in;
+    for (size_t i = 0; i < w1; ++i) {
+        params_[i] = static_cast<float>((2.0 * uniform01(rng_) - 1.0) * limit1);
+    }
+    for (int j = 0; j < H; ++j) {
+        params_[w1 + H + j] = static_cast<float>((2.0 * uniform01(rng_) - 1.0) * limit2);
+    }
+}
+
+void ShardTrainer::loadWeights(const std::string& text) {
+    auto j = nlohmann::json::parse(text, nullptr, false);
+    if (j.is_discarded()) throw std::invalid_argument("ShardTrainer: initial weights are not JSON");
+    int in = inputSize();
+    int H = config_.hiddenSize;
+    size_t w1 = static_cast<size_t>(H) * in;
+    auto expect = [](bool ok) {
+        if (!ok) throw std::invalid_argument("ShardTrainer: initial weights do not fit the model");
+    };
+
+    switch (config_.model) {
+    case TrainerModel::LINEAR_VALUE: {
+        expect(j.is_array());
+        std::vector<float> w = floats(j);
+        expect(w.size() <= params_.size());  // older, shorter feature sets start the rest at 0
+        std::copy(w.begin(), w.end(), params_.begin());
+        break;
+    }
+    case TrainerModel::NEURAL_VALUE: {
+        expect(j.is_object() && j.value("type", "") == "neural" && j.value("hidden_size", 0) == H);
+        const auto& W1 = j["W1"];  // [input][hidden]
+        expect(W1.is_array() && static_cast<int>(W1.size()) <= in);
+        for (size_t i = 0; i < W1.size(); ++i) {
+            expect(static_cast<int>(W1[i].size()) == H);
+            for (int u = 0; u < H; ++u) params_[static_cast<size_t>(u) * in + i] = W1[i][u].get<float>();
+        }
+        std::vector<float> b1 = floats(j["b1"]);
+        std::vector<float> W2 = floats(j["W2"]);
+        expect(static_cast<int>(b1.size()) == H && static_cast<int>(W2.size()) == H);
+        std::copy(b1.begin(), b1.end(), params_.begin() + w1);
+        std::copy(W2.begin(), W2.end(), params_.begin() + w1 + H);
+        params_[w1 + 2 * H] = scalar(j["b2"]);
+        break;
+    }
+    case TrainerModel::LINEAR_POLICY: {
+        expect(j.is_object() && j.contains("policy_weights"));
+        std::vector<float> w = floats(j["policy_weights"]);
+        expect(static_cast<int>(w.size()) == in);
+        std::copy(w.begin(), w.end(), params_.begin());
+        params_[in] = j.value("policy_bias", 0.0f);
+        break;
+    }
+    case TrainerModel::NEURAL_POLICY: {
+        expect(j.is_object() && j.value("policy_type", "") == "neural" &&
+               j.value("policy_hidden_size", 0) == H);
+        std::vector<float> W1 = floats(j["policy_W1"]);  // row-major [input][hidden]
+        std::vector<float> b1 = floats(j["policy_b1"]);
+        std::vector<float> W2 = floats(j["policy_W2"]);
+        expect(W1.size() == w1 && static_cast<int>(b1.size()) == H && static_cast<int>(W2.size()) == H);
+        for (int i = 0; i < in; ++i) {
+            for (int u = 0; u < H; ++u) {
+                params_[static_cast<size_t>(u) * in + i] = W1[static_cast<size_t>(i) * H + u];
+            }
+        }
+        std::copy(b1.begin(), b1.end(), params_.begin() + w1);
+        std::copy(W2.begin(), W2.end(), params_.begin() + w1 + H);
+        params_[w1 + 2 * H] = j.value("policy_b2", 0.0f);
+        break;
+    }
+    }
+}
+
+double ShardTrainer::valueLoss(const Sample& s, float* grad, std::vector<float>& scratch) const {
+    const float* x = s.features;
+    if (config_.model == TrainerModel::LINEAR_VALUE) {
+        float err = dotProduct(params_.data(), x, NUM_FEATURES) - s.outcome;
+        if (grad) addScaled(grad, x, err, NUM_FEATURES);
+        return 0.5 * err * err;
+    }
+
+    // tanh(W2 relu(W1 x + b1) + b2), as NeuralValueFunction evaluates it
+    int H = config_.hiddenSize;
+    size_t w1 = static_cast<size_t>(H) * NUM_FEATURES;
+    const float* b1 = &params_[w1];
+    const float* W2 = &params_[w1 + H];
+    scratch.resize(H);
+    float* h = scratch.data();
+    float z = params_[w1 + 2 * H];
+    for (int u = 0; u < H; ++u) {
+        h[u] = std::max(0.0f, b1[u] + dotProduct(&params_[static_cast<size_t>(u) * NUM_FEATURES], x, NUM_FEATURES));
+        z += h[u] * W2[u];
+    }
+    float y = std::tanh(z);
+    float err = y - s.outcome;
+    if (grad) {
+        float dz = err * (1.0f - y * y);
+        for (int u = 0; u < H; ++u) {
+            grad[w1 + H + u] += dz * h[u];
+            if (h[u] <= 0.0f) continue;
+            float dh = dz * W2[u];
+            grad[w1 + u] += dh;
+            addScaled(&grad[static_cast<size_t>(u) * NUM_FEATURES], x, dh, NUM_FEATURES);
+        }
+        grad[w1 + 2 * H] += dz;
+    }
+    return 0.5 * err * err;
+}
+
+double ShardTrainer::policyLoss(const Sample& s, float* grad, std::vector<float>& scratch) const {
+    // Logits of [state; action] for every candidate, split the way
+    // PolicyNetwork evaluates them: the state block once per decision.
+    const int in = POLICY_INPUT_SIZE;
+    const int k = static_cast<int>(s.numVisits);
+    const bool neural = config_.model == TrainerModel::NEURAL_POLICY;
+    const int H = neural ? config_.hiddenSize : 0;
+    size_t w1 = static_cast<size_t>(H) * in;
+    // scratch: logits[k], targets[k], state block[H], hidden[k][H], state gradient[H]
+    scratch.resize(2 * static_cast<size_t>(k) + static_cast<size_t>(H) * (k + 2));
+    float* logits = scratch.data();
+    float* target = logits + k;
+    float* block = target + k;
+    float* hidden = block + H;
+    float* stateGrad = hidden + static_cast<size_t>(H) * k;
+
+    float targetSum = 0.0f;
+    for (int a = 0; a < k; ++a) targetSum += s.visits[a].visitFraction;
+    for (int a = 0; a < k; ++a) {
+        target[a] = targetSum > 0.0f ? s.visits[a].visitFraction / targetSum : 1.0f / k;
+    }
+
+    if (!neural) {
+        float stateLogit = params_[in] + dotProduct(params_.data(), s.features, NUM_FEATURES);
+        for (int a = 0; a < k; ++a) {
+            logits[a] = stateLogit + dotProduct(&params_[NUM_FEATURES], s.visits[a].actionFeatures,
+                                                NUM_ACTION_FEATURES);
+        }
+    } else {
+        const float* b1 = &params_[w1];
+        const float* W2 = &params_[w1 + H];
+        for (int u = 0; u < H; ++u) {
+            block[u] = b1[u] + dotProduct(&params_[static_cast<size_t>(u) * in], s.features, NUM_FEATURES);
+        }
+        for (int a = 0; a < k; ++a) {
+            float* h = hidden + static_cast<size_t>(a) * H;
+            float logit = params_[w1 + 2 * H];
+            for (int u = 0; u < H; ++u) {
+                h[u] = std::max(0.0f, block[u] + dotProduct(&params_[static_cast<size_t>(u) * in + NUM_FEATURES],
+                                                            s.visits[a].actionFeatures, NUM_ACTION_FEATURES));
+                logit += h[u] * W2[u];
+            }
+            logits[a] = logit;
+        }
+    }
+
+    // Cross-entropy of the log-softmax; logits become d loss / d logit
+    float maxLogit = *std::max_element(logits, logits + k);
+    double sumExp = 0.0;
+    for (int a = 0; a < k; ++a) sumExp += std::exp(static_cast<double>(logits[a] - maxLogit));
+    double logSum = std::log(sumExp) + maxLogit;
+    double loss = 0.0;
+    for (int a = 0; a < k; ++a) {
+        loss -= target[a] * (logits[a] - logSum);
+        logits[a] = static_cast<float>(std::exp(logits[a] - logSum)) - target[a];
+    }
+    if (!grad) return loss;
+
+    const float* dLogit = logits;
+    if (!neural) {
+        float stateCoeff = 0.0f;
+        for (int a = 0; a < k; ++a) {
+            stateCoeff += dLogit[a];
+            addScaled(&grad[NUM_FEATURES], s.visits[a].actionFeatures, dLogit[a], NUM_ACTION_FEATURES);
+        }
+        addScaled(grad, s.features, stateCoeff, NUM_FEATURES);
+        grad[in] += stateCoeff;
+        return loss;
+    }
+
+    const float* W2 = &params_[w1 + H];
+    std::fill(stateGrad, stateGrad + H, 0.0f);
+    for (int a = 0; a < k; ++a) {
+        const float* h = hidden + static_cast<size_t>(a) * H;
+        grad[w1 + 2 * H] += dLogit[a];
+        for (int u = 0; u < H; ++u) {
+            grad[w1 + H + u] += dLogit[a] * h[u];
+            if (h[u] <= 0.0f) continue;
+            float dh = dLogit[a] * W2[u];
+            stateGrad[u] += dh;
+            addScaled(&grad[static_cast<size_t>(u) * in + NUM_FEATURES], s.visits[a].actionFeatures, dh,
+                      NUM_ACTION_FEATURES);
+        }
+    }
+    for (int u = 0; u < H; ++u) {
+        if (stateGrad[u] == 0.0f) continue;
+        grad[w1 + u] += stateGrad[u];
+        addScaled(&grad[static_cast<size_t>(u) * in], s.features, stateGrad[u], NUM_FEATURES);
+    }
+    return loss;
+}
+
+double ShardTrainer::accumulate(const uint32_t* rows, size_t count, float* grad, int worker) {
+    double loss = 0.0;
+    std::vector<float>& scratch = scratch_[worker];
+    for (size_t r = 0; r < count; ++r) {
+        const Sample& s = samples_[rows[r]];
+        loss += policyModel() ? policyLoss(s, grad, scratch) : valueLoss(s, grad, scratch);
+    }
+    return loss;
+}
+
+double ShardTrainer::runChunks(const uint32_t* rows, size_t count, bool learn) {
+    auto chunk = [&](int c, int worker) {
+        size_t begin = count * c / CHUNKS;
+        size_t end = count * (c + 1) / CHUNKS;
+        float* grad = nullptr;
+        if (learn) {
+            std::fill(grads_[c].begin(), grads_[c].end(), 0.0f);
+            grad = grads_[c].data();
+        }
+        chunkLoss_[c] = accumulate(rows + begin, end - begin, grad, worker);
+    };
+    if (pool_) {
+        pool_->run(CHUNKS, chunk);
+    } else {
+        for (int c = 0; c < CHUNKS; ++c) chunk(c, 0);
+    }
+    double loss = 0.0;
+    for (int c = 0; c < CHUNKS; ++c) loss += chunkLoss_[c];
+    return loss;
+}
+
+void ShardTrainer::step(size_t batch) {
+    // Sum the chunk gradients in chunk order, then update, one slice of
+    // the parameters per task.
+    steps_++;
+    const float scale = 1.0f / static_cast<float>(batch);
+    const float lr = config_.learningRate;
+    const bool adam = config_.optimizer == TrainerOptimizer::ADAM;
+    const float correction1 = 1.0f - std::pow(config_.beta1, static_cast<float>(steps_));
+    const float correction2 = 1.0f - std::pow(config_.beta2, static_cast<float>(steps_));
+    const size_t n = params_.size();
+    auto slice = [&](int t, int) {
+        size_t begin = n * t / CHUNKS;
+        size_t end = n * (t + 1) / CHUNKS;
+        for (size_t i = begin; i < end; ++i) {
+            float g = 0.0f;
+            for (int c = 0; c < CHUNKS; ++c) g += grads_[c][i];
+            g = g * scale + config_.weightDecay * params_[i];
+            if (adam) {
+                moment1_[i] = config_.beta1 * moment1_[i] + (1.0f - config_.beta1) * g;
+                moment2_[i] = config_.beta2 * moment2_[i] + (1.0f - config_.beta2) * g * g;
+                params_[i] -= lr * (moment1_[i] / correction1) /
+                              (std::sqrt(moment2_[i] / correction2) + config_.epsilon);
+            } else {
+                moment1_[i] = config_.momentum * moment1_[i] + g;
+                params_[i] -= lr * moment1_[i];
+            }
+        }
+    };
+    if (pool_) {
+        pool_->run(CHUNKS, slice);
+    } else {
+        for (int t = 0; t < CHUNKS; ++t) slice(t, 0);
+    }
+}
+
+double ShardTrainer::trainEpoch() {
+    for (size_t i = order_.size(); i > 1; --i) {
+        std::swap(order_[i - 1], order_[rng_.next() % i]);
+    }
+    double loss = 0.0;
+    size_t batch = static_cast<size_t>(config_.batchSize);
+    for (size_t begin = 0; begin < order_.size(); begin += batch) {
+        size_t count = std::min(batch, order_.size() - begin);
+        loss += runChunks(&order_[begin], count, true);
+        step(count);
+    }
+    epochs_++;
+    return loss / static_cast<double>(order_.size());
+}
+
+double ShardTrainer::loss() {
+    std::vector<uint32_t> rows(samples_.size());
+    for (size_t i = 0; i < rows.size(); ++i) rows[i] = static_cast<uint32_t>(i);
+    return runChunks(rows.data(), rows.size(), false) / static_cast<double>(rows.size());
+}
+
+std::string ShardTrainer::weightsJson() const {
+    const int in = inputSize();
+    const int H = config_.hiddenSize;
+    const size_t w1 = static_cast<size_t>(H) * in;
+    nlohmann::json j;
+    switch (config_.model) {
+    case TrainerModel::LINEAR_VALUE:
+        j = std::vector<float>(params_.begin(), params_.end());
+        break;
+    case TrainerModel::NEURAL_VALUE: {
+        nlohmann::json W1 = nlohmann::json::array();
+        for (int i = 0; i < in; ++i) {
+            std::vector<float> row(H);
+            for (int u = 0; u < H; ++u) row[u] = params_[static_cast<size_t>(u) * in + i];
+            W1.push_back(std::move(row));
+        }
+        nlohmann::json W2 = nlohmann::json::array();
+        for (int u = 0; u < H; ++u) W2.push_back(nlohmann::json::array({params_[w1 + H + u]}));
+        j = {{"type", "neural"},
+             {"hidden_size", H},
+             {"n_features", in},
+             {"W1", std::move(W1)},
+             {"b1", std::vector<float>(params_.begin() + w1, params_.begin() + w1 + H)},
+             {"W2", std::move(W2)},
+             {"b2", nlohmann::json::array({params_[w1 + 2 * H]})}};
+        break;
+    }
+    case TrainerModel::LINEAR_POLICY:
+        j = {{"policy_weights", std::vector<float>(params_.begin(), params_.begin() + in)},
+             {"policy_bias", params_[in]}};
+        break;
+    case TrainerModel::NEURAL_POLICY: {
+        std::vector<float> W1(w1);
+        for (int i = 0; i < in; ++i) {
+            for (int u = 0; u < H; ++u) W1[static_cast<size_t>(i) * H + u] = params_[static_cast<size_t>(u) * in + i];
+        }
+        j = {{"policy_type", "neural"},
+             {"policy_hidden_size", H},
+             {"policy_W1", std::move(W1)},
+             {"policy_b1", std::vector<float>(params_.begin() + w1, params_.begin() + w1 + H)},
+             {"policy_W2", std::vector<float>(params_.begin() + w1 + H, params_.begin() + w1 + 2 * H)},
+             {"policy_b2", params_[w1 + 2 * H]}};
+        break;
+    }
+    }
+    return j.dump();
+}
+
+bool ShardTrainer::saveWeights(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    out << weightsJson();
+    return static_cast<bool>(out);
+}
+
+} // namespace bb
@@ -0,0 +1,92 @@
+#include "bb/state_arrays.h"
+#include "bb/thread_placement.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace bb {
+
+namespace {
+
+constexpr size_t CHUNK = 256;
+
+uint8_t teamFlags(const TeamState& t) {
+    return (t.rerollUsedThisTurn ? StateRecord::REROLL_USED : 0) |
+           (t.blitzUsedThisTurn ? StateRecord::BLITZ_USED : 0) |
+           (t.passUsedThisTurn ? StateRecord::PASS_USED : 0) |
+           (t.foulUsedThisTurn ? StateRecord::FOUL_USED : 0) |
+           (t.hasApothecary ? StateRecord::HAS_APOTHECARY : 0) |
+           (t.apothecaryUsed ? StateRecord::APOTHECARY_USED : 0);
+}
+
+} // namespace
+
+void writeStateArrays(const GameState& state, PlayerRecord* players, uint8_t* board,
+                      StateRecord* record) {
+    const BallState& ball = state.ball;
+    std::memset(board, 0, BOARD_SQUARES);
+    for (size_t i = 0; i < state.players.size(); ++i) {
+        const Player& p = state.players[i];
+        const PlayerProfile& profile = profileOf(p.profile);
+        PlayerRecord& r = players[i];
+        r = PlayerRecord{};
+        r.id = static_cast<uint8_t>(p.id);
+        r.team = static_cast<uint8_t>(p.teamSide);
+        r.state = static_cast<uint8_t>(p.state);
+        r.x = p.position.x;
+        r.y = p.position.y;
+        r.movementRemaining = p.movementRemaining;
+        r.movement = profile.stats.movement;
+        r.strength = profile.stats.strength;
+        r.agility = profile.stats.agility;
+        r.armour = profile.stats.armour;
+        r.flags = (p.hasMoved ? PlayerRecord::HAS_MOVED : 0) |
+                  (p.hasActed ? PlayerRecord::HAS_ACTED : 0) |
+                  (p.usedBlitz ? PlayerRecord::USED_BLITZ : 0) |
+                  (p.lostTacklezones ? PlayerRecord::LOST_TACKLEZONES : 0) |
+                  (p.proUsedThisTurn ? PlayerRecord::PRO_USED : 0) |
+                  (ball.isHeld && ball.carrierId == p.id ? PlayerRecord::HAS_BALL : 0);
+        r.profile = p.profile;
+        r.skills[0] = profile.skills.word(0);
+        r.skills[1] = profile.skills.word(1);
+        if (p.isOnPitch() && p.position.isOnPitch()) {
+            board[p.position.y * Position::PITCH_WIDTH + p.position.x] = r.id;
+        }
+    }
+
+    StateRecord& s = *record;
+    s = StateRecord{};
+    s.half = static_cast<int8_t>(state.half);
+    s.phase = static_cast<uint8_t>(state.phase);
+    s.activeTeam = static_cast<uint8_t>(state.activeTeam);
+    s.kickingTeam = static_cast<uint8_t>(state.kickingTeam);
+    s.weather = static_cast<uint8_t>(state.weather);
+    s.ballX = ball.position.x;
+    s.ballY = ball.position.y;
+    s.ballHeld = ball.isHeld;
+    s.ballCarrierId = static_cast<int8_t>(ball.carrierId);
+    s.turnoverPending = state.turnoverPending;
+    s.homeScore = static_cast<int8_t>(state.homeTeam.score);
+    s.awayScore = static_cast<int8_t>(state.awayTeam.score);
+    s.homeRerolls = static_cast<int8_t>(state.homeTeam.rerolls);
+    s.awayRerolls = static_cast<int8_t>(state.awayTeam.rerolls);
+    s.homeTurn = static_cast<int8_t>(state.homeTeam.turnNumber);
+    s.awayTurn = static_cast<int8_t>(state.awayTeam.turnNumber);
+    s.homeFlags = teamFlags(state.homeTeam);
+    s.awayFlags = teamFlags(state.awayTeam);
+}
+
+void writeStateArrays(const GameState* const* states, size_t n, PlayerRecord* players,
+                      uint8_t* board, StateRecord* records, int threads) {
+    std::atomic<size_t> next{0};
+    runWorkers(std::max(1, std::min(threads, static_cast<int>((n + CHUNK - 1) / CHUNK))), [&](int) {
+        for (size_t begin = next.fetch_add(CHUNK); begin < n; begin = next.fetch_add(CHUNK)) {
+            for (size_t k = begin; k < std::min(n, begin + CHUNK); ++k) {
+                writeStateArrays(*states[k], players + k * STATE_PLAYERS, board + k * BOARD_SQUARES,
+                                 records + k);
+            }
+        }
+    });
+}
+
+} // namespace bb
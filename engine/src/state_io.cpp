@@ -0,0 +1,413 @@
+#include "bb/state_io.h"
+#include "bb/bitboard.h"
+#include <nlohmann/json.hpp>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace bb {
+
+using nlohmann::json;
+
+static constexpr int STATE_FORMAT_VERSION = 1;
+static constexpr int MAX_SKILLS = 128;  // SkillSet width
+
+template<typename E>
+static int enumValue(E e) { return static_cast<int>(e); }
+
+// Why `state`, as read, is not one the engine can hold (nullptr if it is).
+// Enums, sides and ids arrive unchecked from files and sockets, and the
+// occupancy and feature indexes are keyed on them, so loaders check before
+// invalidateOccupancy().
+static const char* invalidState(const GameState& state) {
+    if (state.phase > GamePhase::GAME_OVER) return "phase out of range";
+    if (state.activeTeam > TeamSide::AWAY || state.kickingTeam > TeamSide::AWAY) {
+        return "team out of range";
+    }
+    if (state.weather > Weather::BLIZZARD) return "weather out of range";
+    if (state.receiverSpeed > RosterSpeed::FAST) return "receiver speed out of range";
+    if (state.currentActivationId != -1 &&
+        (state.currentActivationId < 1 || state.currentActivationId > 22)) {
+        return "activation id out of range";
+    }
+    std::array<bool, Bitboard::SQUARES> occupied{};
+    for (size_t i = 0; i < state.players.size(); ++i) {
+        const Player& p = state.players[i];
+        if (p.state > PlayerState::OFF_PITCH) return "player state out of range";
+        if (p.teamSide != (i < 11 ? TeamSide::HOME : TeamSide::AWAY)) return "player on the wrong side";
+        if (p.isOnPitch() && p.position.isOnPitch()) {
+            bool& square = occupied[Bitboard::indexOf(p.position)];
+            if (square) return "two players on one square";
+            square = true;
+        }
+    }
+    if (state.ball.isHeld) {
+        int id = state.ball.carrierId;
+        if (id < 1 || id > 22) return "carrier id out of range";
+        const Player& carrier = state.getPlayer(id);
+        if (!carrier.isOnPitch() || carrier.position != state.ball.position) {
+            return "carrier is not holding the ball";
+        }
+    } else if (state.ball.carrierId != -1 &&
+               (state.ball.carrierId < 1 || state.ball.carrierId > 22)) {
+        return "carrier id out of range";
+    }
+    return nullptr;
+}
+
+static json teamToJson(const TeamState& t) {
+    return {
+        {"score", t.score},
+        {"rerolls", t.rerolls},
+        {"rerollUsedThisTurn", t.rerollUsedThisTurn},
+        {"turnNumber", t.turnNumber},
+        {"blitzUsedThisTurn", t.blitzUsedThisTurn},
+        {"passUsedThisTurn", t.passUsedThisTurn},
+        {"foulUsedThisTurn", t.foulUsedThisTurn},
+        {"hasApothecary", t.hasApothecary},
+        {"apothecaryUsed", t.apothecaryUsed},
+    };
+}
+
+static void teamFromJson(const json& j, TeamState& t) {
+    t.score = j.at("score").get<int>();
+    t.rerolls = j.at("rerolls").get<int>();
+    t.rerollUsedThisTurn = j.at("rerollUsedThisTurn").get<bool>();
+    t.turnNumber = j.at("turnNumber").get<int>();
+    t.blitzUsedThisTurn = j.at("blitzUsedThisTurn").get<bool>();
+    t.passUsedThisTurn = j.at("passUsedThisTurn").get<bool>();
+    t.foulUsedThisTurn = j.at("foulUsedThisTurn").get<bool>();
+    t.hasApothecary = j.at("hasApothecary").get<bool>();
+    t.apothecaryUsed = j.at("apothecaryUsed").get<bool>();
+}
+
+static json playerToJson(const Player& p) {
+    json skills = json::array();
+    for (int s = 0; s < MAX_SKILLS; ++s) {
+        if (p.hasSkill(static_cast<SkillName>(s))) skills.push_back(s);
+    }
+    return {
+        {"id", p.id},
+        {"state", enumValue(p.state)},
+        {"x", p.position.x},
+        {"y", p.position.y},
+        {"ma", p.stats().movement},
+        {"st", p.stats().strength},
+        {"ag", p.stats().agility},
+        {"av", p.stats().armour},
+        {"skills", skills},
+        {"movementRemaining", p.movementRemaining},
+        {"hasMoved", p.hasMoved},
+        {"hasActed", p.hasActed},
+        {"usedBlitz", p.usedBlitz},
+        {"lostTacklezones", p.lostTacklezones},
+        {"proUsedThisTurn", p.proUsedThisTurn},
+    };
+}
+
+static void playerFromJson(const json& j, Player& p) {
+    p.state = static_cast<PlayerState>(j.at("state").get<int>());
+    p.position = {static_cast<int8_t>(j.at("x").get<int>()), static_cast<int8_t>(j.at("y").get<int>())};
+    PlayerStats stats{static_cast<int8_t>(j.at("ma").get<int>()), static_cast<int8_t>(j.at("st").get<int>()),
+                      static_cast<int8_t>(j.at("ag").get<int>()), static_cast<int8_t>(j.at("av").get<int>())};
+    SkillSet skills;
+    for (const json& s : j.at("skills")) {
+        int skill = s.get<int>();
+        if (skill < 0 || skill >= static_cast<int>(SkillName::SKILL_COUNT)) {
+            throw json::other_error::create(501, "skill out of range", &s);
+        }
+        skills.add(static_cast<SkillName>(skill));
+    }
+    p.setProfile(stats, skills);
+    p.movementRemaining = static_cast<int8_t>(j.at("movementRemaining").get<int>());
+    p.hasMoved = j.at("hasMoved").get<bool>();
+    p.hasActed = j.at("hasActed").get<bool>();
+    p.usedBlitz = j.at("usedBlitz").get<bool>();
+    p.lostTacklezones = j.at("lostTacklezones").get<bool>();
+    p.proUsedThisTurn = j.at("proUsedThisTurn").get<bool>();
+}
+
+std::string stateToJson(const GameState& state) {
+    json players = json::array();
+    for (const Player& p : state.players) players.push_back(playerToJson(p));
+    json j = {
+        {"version", STATE_FORMAT_VERSION},
+        {"half", state.half},
+        {"phase", enumValue(state.phase)},
+        {"activeTeam", enumValue(state.activeTeam)},
+        {"turnoverPending", state.turnoverPending},
+        {"currentActivationId", state.currentActivationId},
+        {"kickingTeam", enumValue(state.kickingTeam)},
+        {"weather", enumValue(state.weather)},
+        {"receiverSpeed", enumValue(state.receiverSpeed)},
+        {"homeTeam", teamToJson(state.homeTeam)},
+        {"awayTeam", teamToJson(state.awayTeam)},
+        {"ball", {
+            {"x", state.ball.position.x},
+            {"y", state.ball.position.y},
+            {"isHeld", state.ball.isHeld},
+            {"carrierId", state.ball.carrierId},
+        }},
+        {"players", players},
+    };
+    return j.dump(1);
+}
+
+GameState stateFromJson(const std::string& text) {
+    json j = json::parse(text);
+    if (j.at("version").get<int>() != STATE_FORMAT_VERSION) {
+        throw json::other_error::create(501, "unsupported state format version", &j);
+    }
+
+    GameState state;
+    state.half = j.at("half").get<int>();
+    state.phase = static_cast<GamePhase>(j.at("phase").get<int>());
+    state.activeTeam = static_cast<TeamSide>(j.at("activeTeam").get<int>());
+    state.turnoverPending = j.at("turnoverPending").get<bool>();
+    state.currentActivationId = j.at("currentActivationId").get<int>();
+    state.kickingTeam = static_cast<TeamSide>(j.at("kickingTeam").get<int>());
+    state.weather = static_cast<Weather>(j.at("weather").get<int>());
+    state.receiverSpeed = static_cast<RosterSpeed>(j.at("receiverSpeed").get<int>());
+    teamFromJson(j.at("homeTeam"), state.homeTeam);
+    teamFromJson(j.at("awayTeam"), state.awayTeam);
+
+    const json& ball = j.at("ball");
+    state.ball.position = {static_cast<int8_t>(ball.at("x").get<int>()),
+                           static_cast<int8_t>(ball.at("y").get<int>())};
+    state.ball.isHeld = ball.at("isHeld").get<bool>();
+    state.ball.carrierId = ball.at("carrierId").get<int>();
+
+    const json& players = j.at("players");
+    if (players.size() != state.players.size()) {
+        throw json::other_error::create(501, "expected 22 players", &players);
+    }
+    for (const json& pj : players) {
+        int id = pj.at("id").get<int>();
+        if (id < 1 || id > 22) throw json::other_error::create(501, "player id out of range", &pj);
+        playerFromJson(pj, state.getPlayer(id));
+    }
+    if (const char* reason = invalidState(state)) throw json::other_error::create(501, reason, &j);
+    state.invalidateOccupancy();
+    return state;
+}
+
+// --- Binary records ---
+
+namespace {
+
+struct BinaryTeam {
+    int16_t score, rerolls, turnNumber;
+    uint8_t flags;  // TEAM_* bits
+    uint8_t reserved;
+};
+
+struct BinaryPlayer {
+    uint64_t skills[2];
+    int8_t id;
+    uint8_t side;
+    uint8_t state;
+    int8_t x, y;
+    int8_t ma, st, ag, av;
+    int8_t movementRemaining;
+    uint8_t flags;  // PLAYER_* bits
+    uint8_t reserved[5];
+};
+
+struct BinaryState {
+    uint32_t magic, version;
+    int8_t half;
+    uint8_t phase, activeTeam, turnoverPending;
+    int8_t currentActivationId;
+    uint8_t kickingTeam, weather, receiverSpeed;
+    BinaryTeam teams[2];
+    int8_t ballX, ballY;
+    uint8_t ballHeld;
+    int8_t ballCarrierId;
+    uint32_t reserved;
+    BinaryPlayer players[22];
+};
+static_assert(sizeof(BinaryPlayer) == 32);
+static_assert(sizeof(BinaryState) == STATE_BINARY_SIZE);
+
+enum : uint8_t {
+    TEAM_REROLL_USED = 1, TEAM_BLITZ_USED = 2, TEAM_PASS_USED = 4, TEAM_FOUL_USED = 8,
+    TEAM_HAS_APOTHECARY = 16, TEAM_APOTHECARY_USED = 32,
+};
+enum : uint8_t {
+    PLAYER_MOVED = 1, PLAYER_ACTED = 2, PLAYER_USED_BLITZ = 4, PLAYER_LOST_TACKLEZONES = 8,
+    PLAYER_PRO_USED = 16,
+};
+
+uint8_t bit(bool set, uint8_t flag) { return set ? flag : 0; }
+
+BinaryTeam packTeam(const TeamState& t) {
+    BinaryTeam b{};
+    b.score = static_cast<int16_t>(t.score);
+    b.rerolls = static_cast<int16_t>(t.rerolls);
+    b.turnNumber = static_cast<int16_t>(t.turnNumber);
+    b.flags = bit(t.rerollUsedThisTurn, TEAM_REROLL_USED) | bit(t.blitzUsedThisTurn, TEAM_BLITZ_USED) |
+              bit(t.passUsedThisTurn, TEAM_PASS_USED) | bit(t.foulUsedThisTurn, TEAM_FOUL_USED) |
+              bit(t.hasApothecary, TEAM_HAS_APOTHECARY) | bit(t.apothecaryUsed, TEAM_APOTHECARY_USED);
+    return b;
+}
+
+void unpackTeam(const BinaryTeam& b, TeamState& t) {
+    t.score = b.score;
+    t.rerolls = b.rerolls;
+    t.turnNumber = b.turnNumber;
+    t.rerollUsedThisTurn = b.flags & TEAM_REROLL_USED;
+    t.blitzUsedThisTurn = b.flags & TEAM_BLITZ_USED;
+    t.passUsedThisTurn = b.flags & TEAM_PASS_USED;
+    t.foulUsedThisTurn = b.flags & TEAM_FOUL_USED;
+    t.hasApothecary = b.flags & TEAM_HAS_APOTHECARY;
+    t.apothecaryUsed = b.flags & TEAM_APOTHECARY_USED;
+}
+
+BinaryPlayer packPlayer(const Player& p) {
+    BinaryPlayer b{};
+    b.skills[0] = p.skills().word(0);
+    b.skills[1] = p.skills().word(1);
+    b.id = static_cast<int8_t>(p.id);
+    b.side = static_cast<uint8_t>(p.teamSide);
+    b.state = static_cast<uint8_t>(p.state);
+    b.x = p.position.x;
+    b.y = p.position.y;
+    b.ma = p.stats().movement;
+    b.st = p.stats().strength;
+    b.ag = p.stats().agility;
+    b.av = p.stats().armour;
+    b.movementRemaining = p.movementRemaining;
+    b.flags = bit(p.hasMoved, PLAYER_MOVED) | bit(p.hasActed, PLAYER_ACTED) |
+              bit(p.usedBlitz, PLAYER_USED_BLITZ) | bit(p.lostTacklezones, PLAYER_LOST_TACKLEZONES) |
+              bit(p.proUsedThisTurn, PLAYER_PRO_USED);
+    return b;
+}
+
+// False if a skill bit is set past SKILL_COUNT.
+bool unpackPlayer(const BinaryPlayer& b, Player& p) {
+    SkillSet skills;
+    for (int s = 0; s < MAX_SKILLS; ++s) {
+        if (!((b.skills[s >> 6] >> (s & 63)) & 1)) continue;
+        if (s >= static_cast<int>(SkillName::SKILL_COUNT)) return false;
+        skills.add(static_cast<SkillName>(s));
+    }
+    p.setProfile(PlayerStats{b.ma, b.st, b.ag, b.av}, skills);
+    p.teamSide = static_cast<TeamSide>(b.side);
+    p.state = static_cast<PlayerState>(b.state);
+    p.position = {b.x, b.y};
+    p.movementRemaining = b.movementRemaining;
+    p.hasMoved = b.flags & PLAYER_MOVED;
+    p.hasActed = b.flags & PLAYER_ACTED;
+    p.usedBlitz = b.flags & PLAYER_USED_BLITZ;
+    p.lostTacklezones = b.flags & PLAYER_LOST_TACKLEZONES;
+    p.proUsedThisTurn = b.flags & PLAYER_PRO_USED;
+    return true;
+}
+
+} // anonymous namespace
+
+std::vector<uint8_t> serializeState(const GameState& state) {
+    BinaryState b{};
+    b.magic = STATE_BINARY_MAGIC;
+    b.version = STATE_BINARY_VERSION;
+    b.half = static_cast<int8_t>(state.half);
+    b.phase = static_cast<uint8_t>(state.phase);
+    b.activeTeam = static_cast<uint8_t>(state.activeTeam);
+    b.turnoverPending = state.turnoverPending;
+    b.currentActivationId = static_cast<int8_t>(state.currentActivationId);
+    b.kickingTeam = static_cast<uint8_t>(state.kickingTeam);
+    b.weather = static_cast<uint8_t>(state.weather);
+    b.receiverSpeed = static_cast<uint8_t>(state.receiverSpeed);
+    b.teams[0] = packTeam(state.homeTeam);
+    b.teams[1] = packTeam(state.awayTeam);
+    b.ballX = state.ball.position.x;
+    b.ballY = state.ball.position.y;
+    b.ballHeld = state.ball.isHeld;
+    b.ballCarrierId = static_cast<int8_t>(state.ball.carrierId);
+    for (size_t i = 0; i < state.players.size(); ++i) b.players[i] = packPlayer(state.players[i]);
+
+    std::vector<uint8_t> out(sizeof(b));
+    std::memcpy(out.data(), &b, sizeof(b));
+    return out;
+}
+
+std::optional<GameState> deserializeState(const uint8_t* data, size_t size) {
+    BinaryState b;
+    if (size != sizeof(b)) return std::nullopt;
+    std::memcpy(&b, data, sizeof(b));
+    if (b.magic != STATE_BINARY_MAGIC || b.version != STATE_BINARY_VERSION) return std::nullopt;
+
+    GameState state;
+    state.half = b.half;
+    state.phase = static_cast<GamePhase>(b.phase);
+    state.activeTeam = static_cast<TeamSide>(b.activeTeam);
+    state.turnoverPending = b.turnoverPending;
+    state.currentActivationId = b.currentActivationId;
+    state.kickingTeam = static_cast<TeamSide>(b.kickingTeam);
+    state.weather = static_cast<Weather>(b.weather);
+    state.receiverSpeed = static_cast<RosterSpeed>(b.receiverSpeed);
+    unpackTeam(b.teams[0], state.homeTeam);
+    unpackTeam(b.teams[1], state.awayTeam);
+    state.ball.position = {b.ballX, b.ballY};
+    state.ball.isHeld = b.ballHeld;
+    state.ball.carrierId = b.ballCarrierId;
+    for (size_t i = 0; i < state.players.size(); ++i) {
+        if (b.players[i].id != state.players[i].id) return std::nullopt;
+        if (!unpackPlayer(b.players[i], state.players[i])) return std::nullopt;
+    }
+    if (invalidState(state)) return std::nullopt;
+    state.invalidateOccupancy();
+    return state;
+}
+
+std::vector<uint8_t> serializeDice(const DiceRollerBase& dice) {
+    std::vector<uint8_t> out(2 * sizeof(uint32_t));
+    const uint32_t header[2] = {DICE_BINARY_MAGIC, DICE_BINARY_VERSION};
+    std::memcpy(out.data(), header, sizeof(header));
+    if (!dice.saveState(out)) return {};
+    return out;
+}
+
+bool deserializeDice(DiceRollerBase& dice, const uint8_t* data, size_t size) {
+    uint32_t header[2];
+    if (size < sizeof(header)) return false;
+    std::memcpy(header, data, sizeof(header));
+    if (header[0] != DICE_BINARY_MAGIC || header[1] != DICE_BINARY_VERSION) return false;
+    const uint8_t* in = data + sizeof(header);
+    const uint8_t* end = data + size;
+    return dice.restoreState(in, end) && in == end;
+}
+
+// --- Files ---
+
+std::optional<GameState> loadState(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return std::nullopt;
+    std::stringstream text;
+    text << file.rdbuf();
+    std::string bytes = text.str();
+    uint32_t magic = 0;
+    if (bytes.size() >= sizeof(magic)) std::memcpy(&magic, bytes.data(), sizeof(magic));
+    if (magic == STATE_BINARY_MAGIC) {
+        return deserializeState(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+    }
+    return stateFromJson(bytes);
+}
+
+bool saveState(const GameState& state, const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+    file << stateToJson(state) << "\n";
+    return static_cast<bool>(file);
+}
+
+bool saveStateBinary(const GameState& state, const std::string& path) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    std::vector<uint8_t> bytes = serializeState(state);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+} // namespace bb
@@ -0,0 +1,288 @@
+#include "bb/strength_bench.h"
+#include "bb/game_simulator.h"
+#include "bb/macro_mcts.h"
+#include "bb/state_io.h"
+#include "bb/thread_placement.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace bb {
+
+using nlohmann::json;
+
+namespace {
+
+// --- Reference positions ---
+
+// A human v orc setupHalf lineup in open play. Home holds x 7-12 and
+// scores at x = 25; away holds x 13-18 and scores at x = 0.
+GameState lineup(TeamSide active, int turn) {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getOrcRoster());
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = active;
+    state.half = 1;
+    state.homeTeam.turnNumber = turn;
+    state.awayTeam.turnNumber = turn;
+    state.homeTeam.rerolls = 2;
+    state.awayTeam.rerolls = 2;
+    state.weather = Weather::NICE;
+    return state;
+}
+
+void place(GameState& state, int id, int x, int y) {
+    state.movePlayer(state.getPlayer(id), {static_cast<int8_t>(x), static_cast<int8_t>(y)});
+}
+
+void giveBall(GameState& state, int id) {
+    state.ball = BallState::carried(state.getPlayer(id).position, id);
+}
+
+MacroType parseMacroType(const std::string& name) {
+    for (int t = 0; t < static_cast<int>(MacroType::MACRO_COUNT); ++t) {
+        if (name == macroTypeName(static_cast<MacroType>(t))) return static_cast<MacroType>(t);
+    }
+    throw std::invalid_argument("unknown macro type " + name);
+}
+
+// --- Runs ---
+
+// What one task (a position search or a game) adds to its budget's row
+struct Tally {
+    bool solved = false;
+    int iterations = 0;
+    double searchMs = 0.0;
+    GameResult result;
+    bool measuredHome = true;
+    int searches = 0;
+    int64_t searchIterations = 0;
+};
+
+MCTSConfig budgeted(const MCTSConfig& base, const StrengthBudget& budget) {
+    MCTSConfig c = base;
+    c.maxIterations = budget.iterations > 0 ? budget.iterations : 1 << 30;
+    c.timeBudgetMs = budget.timeMs;
+    return c;
+}
+
+} // anonymous namespace
+
+bool solvesPosition(const BenchPosition& position, const Macro& chosen) {
+    return std::any_of(position.accept.begin(), position.accept.end(), [&](const AcceptedMacro& a) {
+        return a.type == chosen.type && (a.playerId < 0 || a.playerId == chosen.playerId) &&
+               (a.targetId < 0 || a.targetId == chosen.targetId);
+    });
+}
+
+std::vector<BenchPosition> referencePositions() {
+    std::vector<BenchPosition> out;
+
+    // Home catcher (MA 8) six squares out with nobody in the way
+    GameState s = lineup(TeamSide::HOME, 3);
+    place(s, 9, 19, 2);
+    giveBall(s, 9);
+    out.push_back({"score_open_home", "scoring", s, {{MacroType::SCORE, 9}}});
+
+    // Orc blitzer (MA 6) five squares out, unmarked
+    s = lineup(TeamSide::AWAY, 3);
+    place(s, 12, 5, 12);
+    giveBall(s, 12);
+    out.push_back({"score_open_away", "scoring", s, {{MacroType::SCORE, 12}}});
+
+    // Home thrower deep in its own half, orcs pulled back out of contact:
+    // too far to score, so protect the ball or move it up
+    s = lineup(TeamSide::HOME, 2);
+    for (int id = 12; id <= 22; ++id) {
+        Position p = s.getPlayer(id).position;
+        place(s, id, p.x + 4, p.y);
+    }
+    place(s, 11, 7, 7);
+    giveBall(s, 11);
+    out.push_back({"cage_or_advance", "cage_or_advance", s,
+                   {{MacroType::CAGE, 11}, {MacroType::ADVANCE, 11}}});
+
+    // Orc carrier four squares from the home endzone, free to score next turn
+    s = lineup(TeamSide::HOME, 4);
+    place(s, 21, 4, 7);
+    place(s, 11, 7, 12);
+    giveBall(s, 21);
+    out.push_back({"blitz_carrier_home", "defensive_blitz", s, {{MacroType::BLITZ, -1, 21}}});
+
+    // Human catcher four squares from the away endzone
+    s = lineup(TeamSide::AWAY, 4);
+    place(s, 9, 21, 7);
+    place(s, 22, 18, 12);
+    giveBall(s, 9);
+    out.push_back({"blitz_carrier_away", "defensive_blitz", s, {{MacroType::BLITZ, -1, 9}}});
+
+    // Loose ball behind the home line, orcs still on theirs
+    s = lineup(TeamSide::HOME, 2);
+    s.ball = BallState::onGround({8, 3});
+    out.push_back({"pickup_loose_ball", "pickup", s, {{MacroType::PICKUP}}});
+
+    return out;
+}
+
+std::string positionSuiteJson(const std::vector<BenchPosition>& positions) {
+    json list = json::array();
+    for (const BenchPosition& p : positions) {
+        json accept = json::array();
+        for (const AcceptedMacro& a : p.accept) {
+            accept.push_back({{"macro", macroTypeName(a.type)}, {"player", a.playerId}, {"target", a.targetId}});
+        }
+        list.push_back({{"name", p.name}, {"category", p.category}, {"accept", accept},
+                        {"state", json::parse(stateToJson(p.state))}});
+    }
+    return json{{"positions", list}}.dump(1);
+}
+
+std::vector<BenchPosition> parsePositionSuite(const std::string& text) {
+    json j = json::parse(text);
+    std::vector<BenchPosition> out;
+    for (const json& p : j.at("positions")) {
+        BenchPosition pos;
+        pos.name = p.at("name").get<std::string>();
+        pos.category = p.value("category", "");
+        pos.state = stateFromJson(p.at("state").dump());
+        for (const json& a : p.at("accept")) {
+            pos.accept.push_back({parseMacroType(a.at("macro").get<std::string>()),
+                                  a.value("player", -1), a.value("target", -1)});
+        }
+        out.push_back(std::move(pos));
+    }
+    return out;
+}
+
+std::vector<BenchPosition> loadPositionSuite(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) return {};
+    std::stringstream text;
+    text << file.rdbuf();
+    try {
+        return parsePositionSuite(text.str());
+    } catch (const std::exception&) {
+        return {};
+    }
+}
+
+bool savePositionSuite(const std::vector<BenchPosition>& positions, const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+    file << positionSuiteJson(positions) << "\n";
+    return static_cast<bool>(file);
+}
+
+std::vector<StrengthRow> runStrengthBench(const StrengthBenchConfig& config) {
+    for (const StrengthBudget& b : config.budgets) {
+        if (b.iterations <= 0 && b.timeMs <= 0) {
+            throw std::invalid_argument("runStrengthBench: a budget needs iterations or a time limit");
+        }
+    }
+    if (config.threads < 1) throw std::invalid_argument("runStrengthBench: threads must be positive");
+    if (config.positionSeeds < 0 || config.matchPairs < 0) {
+        throw std::invalid_argument("runStrengthBench: negative positionSeeds or matchPairs");
+    }
+    const std::vector<BenchPosition> positions =
+        config.positions.empty() ? referencePositions() : config.positions;
+    std::vector<const TeamRoster*> rosters = config.rosters;
+    if (rosters.empty()) rosters = {&getHumanRoster(), &getOrcRoster()};
+    const int numRosters = static_cast<int>(rosters.size());
+
+    // Per budget: every position x seed search, then both games of every
+    // pair. One slot per task, reduced in order afterwards, so the counts
+    // do not depend on the thread count.
+    const int searchTasks = static_cast<int>(positions.size()) * config.positionSeeds;
+    const int perBudget = searchTasks + 2 * config.matchPairs;
+    const int tasks = static_cast<int>(config.budgets.size()) * perBudget;
+    std::vector<Tally> tallies(tasks);
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int t = next.fetch_add(1); t < tasks; t = next.fetch_add(1)) {
+            const MCTSConfig cell = budgeted(config.search, config.budgets[t / perBudget]);
+            const int i = t % perBudget;
+            Tally& tally = tallies[t];
+            if (i < searchTasks) {
+                const BenchPosition& pos = positions[i / config.positionSeeds];
+                MacroMCTSSearch search(config.valueFn, cell, config.seed + i % config.positionSeeds);
+                tally.solved = solvesPosition(pos, search.search(pos.state));
+                tally.iterations = search.lastIterations();
+                tally.searchMs = search.lastStats().totalMs;
+                continue;
+            }
+            const int pair = (i - searchTasks) / 2;
+            const uint32_t seed = config.seed + pair;
+            tally.measuredHome = (i - searchTasks) % 2 == 0;
+            DiceRoller dice(seed);
+            MacroMCTSPolicy measured(config.valueFn, cell, seed);
+            MacroMCTSPolicy opponent(config.opponentValueFn, config.opponent, seed);
+            auto measuredFn = [&measured](const GameState& s) { return measured(s); };
+            auto opponentFn = [&opponent](const GameState& s) { return opponent(s); };
+            const TeamRoster& home = *rosters[pair % numRosters];
+            const TeamRoster& away = *rosters[(pair + 1) % numRosters];
+            tally.result = tally.measuredHome ? simulateGame(home, away, measuredFn, opponentFn, dice)
+                                              : simulateGame(home, away, opponentFn, measuredFn, dice);
+            tally.searches = measured.searches();
+            tally.searchIterations = measured.searchIterations();
+        }
+    };
+    const int workers = std::clamp(config.threads, 1, std::max(tasks, 1));
+    runWorkers(workers, [&](int) { worker(); });
+
+    const double cpuScale = std::max(1, config.search.numThreads) / 1000.0;
+    std::vector<StrengthRow> out(config.budgets.size());
+    for (size_t b = 0; b < config.budgets.size(); ++b) {
+        StrengthRow& r = out[b];
+        r.budget = config.budgets[b];
+        std::map<std::string, std::pair<int, int>> categories;  // solved, searches
+        for (int i = 0; i < searchTasks; ++i) {
+            const Tally& t = tallies[b * perBudget + i];
+            auto& [solved, searches] = categories[positions[i / config.positionSeeds].category];
+            ++searches;
+            ++r.searches;
+            if (t.solved) {
+                ++solved;
+                ++r.solved;
+            }
+            r.positionIterations += t.iterations;
+            r.positionMs += t.searchMs;
+        }
+        r.cpuSeconds += r.positionMs * cpuScale;
+        if (r.searches > 0) {
+            r.accuracy = static_cast<double>(r.solved) / r.searches;
+            r.positionIterations /= r.searches;
+            r.positionMs /= r.searches;
+        }
+        for (const auto& [name, counts] : categories) {
+            r.categoryAccuracy[name] = static_cast<double>(counts.first) / counts.second;
+        }
+
+        int searches = 0;
+        for (int i = searchTasks; i < perBudget; ++i) {
+            const Tally& t = tallies[b * perBudget + i];
+            const int mine = t.measuredHome ? t.result.homeScore : t.result.awayScore;
+            const int theirs = t.measuredHome ? t.result.awayScore : t.result.homeScore;
+            ++r.games;
+            if (mine > theirs) ++r.wins;
+            else if (mine == theirs) ++r.draws;
+            else ++r.losses;
+            r.scoreDiff += mine - theirs;
+            r.gameMs += t.measuredHome ? t.result.homePolicyMs : t.result.awayPolicyMs;
+            searches += t.searches;
+            r.gameSearchIterations += static_cast<double>(t.searchIterations);
+        }
+        r.cpuSeconds += r.gameMs * cpuScale;
+        if (r.games > 0) {
+            r.score = (r.wins + 0.5 * r.draws) / r.games;
+            r.scoreDiff /= r.games;
+            r.gameMs /= r.games;
+        }
+        if (searches > 0) r.gameSearchIterations /= searches;
+    }
+    return out;
+}
+
+} // namespace bb
@@ -0,0 +1,210 @@
+#include "bb/sweep.h"
+#include "bb/game_simulator.h"
+#include "bb/macro_mcts.h"
+#include "bb/thread_placement.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+namespace bb {
+
+namespace {
+
+// Sums over one game's measured searches
+struct GameTally {
+    GameResult result;
+    int decisions = 0;
+    int shaped = 0;  // decisions with 2+ logged visits
+    double entropy = 0.0;
+    double topShare = 0.0;
+    double iterations = 0.0;
+    double searchMs = 0.0;
+};
+
+void tallyDecisions(const std::vector<PolicyDecision>& decisions, GameTally& t) {
+    for (const PolicyDecision& d : decisions) {
+        ++t.decisions;
+        t.iterations += d.search.iterations;
+        t.searchMs += d.search.totalMs;
+        if (d.visits.size() < 2) continue;
+        double sum = 0.0, top = 0.0;
+        for (const auto& v : d.visits) {
+            sum += v.visitFraction;
+            top = std::max(top, static_cast<double>(v.visitFraction));
+        }
+        if (sum <= 0.0) continue;
+        double h = 0.0;
+        for (const auto& v : d.visits) {
+            double p = v.visitFraction / sum;
+            if (p > 0.0) h -= p * std::log(p);
+        }
+        ++t.shaped;
+        t.entropy += h / std::log(static_cast<double>(d.visits.size()));
+        t.topShare += top / sum;
+    }
+}
+
+} // anonymous namespace
+
+bool setSearchParameter(MCTSConfig& c, const std::string& field, double value) {
+    const int i = static_cast<int>(std::lround(value));
+    const float f = static_cast<float>(value);
+    if (field == "explorationC") c.explorationC = value;
+    else if (field == "maxIterations") c.maxIterations = i;
+    else if (field == "timeBudgetMs") c.timeBudgetMs = i;
+    else if (field == "nRollouts") c.nRollouts = i;
+    else if (field == "vfBlend") c.vfBlend = f;
+    else if (field == "policyBlend") c.policyBlend = f;
+    else if (field == "leafLookahead") c.leafLookahead = value != 0.0;
+    else if (field == "lookaheadSamples") c.lookaheadSamples = i;
+    else if (field == "expectedResolution") c.expectedResolution = value != 0.0;
+    else if (field == "dirichletAlpha") c.dirichletAlpha = f;
+    else if (field == "dirichletWeight") c.dirichletWeight = f;
+    else if (field == "maxChildren") c.maxChildren = i;
+    else if (field == "gumbelTopK") c.gumbelTopK = i;
+    else if (field == "opponentReplyWidth") c.opponentReplyWidth = i;
+    else if (field == "opponentReplyMinDepth") c.opponentReplyMinDepth = i;
+    else if (field == "stateCacheDepth") c.stateCacheDepth = i;
+    else if (field == "stateCacheSamples") c.stateCacheSamples = i;
+    else if (field == "commonRandomNumbers") c.commonRandomNumbers = value != 0.0;
+    else if (field == "evalBatchSize") c.evalBatchSize = i;
+    else if (field == "earlyStop") c.earlyStop = value != 0.0;
+    else if (field == "reuseTree") c.reuseTree = value != 0.0;
+    else if (field == "reuseDecay") c.reuseDecay = f;
+    else if (field == "priorCacheMB") c.priorCacheMB = i;
+    else if (field == "ttMemoryMB") c.ttMemoryMB = i;
+    else if (field == "maxTreeNodes") c.maxTreeNodes = i;
+    else if (field == "symmetricCaches") c.symmetricCaches = value != 0.0;
+    else if (field == "endgameSolver") c.endgameSolver = value != 0.0;
+    else if (field == "fullSearchFraction") c.fullSearchFraction = f;
+    else if (field == "cheapSearchIterations") c.cheapSearchIterations = i;
+    else if (field == "numThreads") c.numThreads = i;
+    else if (field == "rolloutThreads") c.rolloutThreads = i;
+    else if (field == "stateCacheMB") c.stateCacheMB = i;
+    else return false;
+    return true;
+}
+
+std::vector<std::pair<std::string, double>> searchParameters(const MCTSConfig& c) {
+    return {
+        {"explorationC", c.explorationC},
+        {"maxIterations", c.maxIterations},
+        {"timeBudgetMs", c.timeBudgetMs},
+        {"nRollouts", c.nRollouts},
+        {"vfBlend", c.vfBlend},
+        {"policyBlend", c.policyBlend},
+        {"leafLookahead", c.leafLookahead},
+        {"lookaheadSamples", c.lookaheadSamples},
+        {"expectedResolution", c.expectedResolution},
+        {"dirichletAlpha", c.dirichletAlpha},
+        {"dirichletWeight", c.dirichletWeight},
+        {"maxChildren", c.maxChildren},
+        {"gumbelTopK", c.gumbelTopK},
+        {"opponentReplyWidth", c.opponentReplyWidth},
+        {"opponentReplyMinDepth", c.opponentReplyMinDepth},
+        {"stateCacheDepth", c.stateCacheDepth},
+        {"stateCacheSamples", c.stateCacheSamples},
+        {"commonRandomNumbers", c.commonRandomNumbers},
+        {"evalBatchSize", c.evalBatchSize},
+        {"earlyStop", c.earlyStop},
+        {"reuseTree", c.reuseTree},
+        {"reuseDecay", c.reuseDecay},
+        {"priorCacheMB", c.priorCacheMB},
+        {"ttMemoryMB", c.ttMemoryMB},
+        {"maxTreeNodes", c.maxTreeNodes},
+        {"symmetricCaches", c.symmetricCaches},
+        {"endgameSolver", c.endgameSolver},
+        {"fullSearchFraction", c.fullSearchFraction},
+        {"cheapSearchIterations", c.cheapSearchIterations},
+        {"numThreads", c.numThreads},
+        {"rolloutThreads", c.rolloutThreads},
+        {"stateCacheMB", c.stateCacheMB},
+    };
+}
+
+std::vector<MCTSConfig> expandGrid(const MCTSConfig& base, const std::vector<SweepAxis>& axes) {
+    std::vector<MCTSConfig> cells = {base};
+    for (const SweepAxis& axis : axes) {
+        MCTSConfig probe = base;
+        if (!setSearchParameter(probe, axis.field, 0.0)) {
+            throw std::invalid_argument("expandGrid: unknown MCTSConfig field " + axis.field);
+        }
+        if (axis.values.empty()) throw std::invalid_argument("expandGrid: no values for " + axis.field);
+        std::vector<MCTSConfig> next;
+        next.reserve(cells.size() * axis.values.size());
+        for (const MCTSConfig& cell : cells) {
+            for (double v : axis.values) {
+                next.push_back(cell);
+                setSearchParameter(next.back(), axis.field, v);
+            }
+        }
+        cells = std::move(next);
+    }
+    return cells;
+}
+
+std::vector<SweepCellResult> runSweep(const std::vector<MCTSConfig>& cells, const SweepConfig& config) {
+    std::vector<const TeamRoster*> rosters = config.rosters;
+    if (rosters.empty()) rosters = {&getHumanRoster(), &getOrcRoster()};
+    const int numRosters = static_cast<int>(rosters.size());
+    const int numSeeds = static_cast<int>(config.seeds.size());
+    const int tasks = static_cast<int>(cells.size()) * numSeeds;
+
+    // One slot per cell x seed game, reduced in order afterwards, so the
+    // table does not depend on the thread count
+    std::vector<GameTally> tallies(tasks);
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int t = next.fetch_add(1); t < tasks; t = next.fetch_add(1)) {
+            const MCTSConfig& cell = cells[t / numSeeds];
+            const int g = t % numSeeds;
+            const uint32_t seed = config.seeds[g];
+            DiceRoller dice(seed);
+            MacroMCTSPolicy home(config.valueFn, cell, seed);
+            MacroMCTSPolicy away(config.valueFn, config.mirror ? cell : config.opponent, seed);
+            home.setLogDecisions(true, config.topK, false);
+            if (config.mirror) away.setLogDecisions(true, config.topK, false);
+            GameTally& tally = tallies[t];
+            tally.result = simulateGame(*rosters[g % numRosters], *rosters[(g + 1) % numRosters],
+                [&home](const GameState& s) { return home(s); },
+                [&away](const GameState& s) { return away(s); }, dice);
+            tallyDecisions(home.decisions(), tally);
+            tallyDecisions(away.decisions(), tally);
+        }
+    };
+    const int workers = std::clamp(config.threads, 1, std::max(tasks, 1));
+    runWorkers(workers, [&](int) { worker(); });
+
+    std::vector<SweepCellResult> out(cells.size());
+    for (size_t c = 0; c < cells.size(); ++c) {
+        SweepCellResult& r = out[c];
+        int shaped = 0;
+        for (int g = 0; g < numSeeds; ++g) {
+            const GameTally& t = tallies[c * numSeeds + g];
+            ++r.games;
+            if (t.result.homeScore > t.result.awayScore) ++r.wins;
+            else if (t.result.homeScore == t.result.awayScore) ++r.draws;
+            else ++r.losses;
+            r.scoreDiff += t.result.homeScore - t.result.awayScore;
+            r.decisions += t.decisions;
+            shaped += t.shaped;
+            r.visitEntropy += t.entropy;
+            r.topShare += t.topShare;
+            r.iterations += t.iterations;
+            r.searchMs += t.searchMs;
+        }
+        if (r.games > 0) r.scoreDiff /= r.games;
+        if (shaped > 0) {
+            r.visitEntropy /= shaped;
+            r.topShare /= shaped;
+        }
+        if (r.decisions > 0) {
+            r.iterations /= r.decisions;
+            r.searchMs /= r.decisions;
+        }
+    }
+    return out;
+}
+
+} // namespace bb
@@ -0,0 +1,27 @@
+#include "bb/symmetry.h"
+
+namespace bb {
+
+CanonicalForm canonicalize(const GameState& state) {
+    uint64_t plain = state.hash();
+    uint64_t mirrored = state.mirroredHash();
+    CanonicalForm form;
+    form.toCanonical.flipY = mirrored < plain;
+    form.hash = form.toCanonical.flipY ? mirrored : plain;
+    return form;
+}
+
+GameState transformed(const GameState& state, Symmetry symmetry) {
+    GameState out = state.clone();
+    if (!symmetry.flipY) return out;
+    // Moved in bulk: one player's image square may still hold another
+    // until both have moved, so the indexes are rebuilt afterwards.
+    for (Player& p : out.players) {
+        if (p.isOnPitch()) p.position = symmetry.apply(p.position);
+    }
+    out.ball.position = symmetry.apply(out.ball.position);
+    out.invalidateOccupancy();
+    return out;
+}
+
+} // namespace bb
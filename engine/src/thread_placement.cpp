@@ -0,0 +1,195 @@
+#include "bb/thread_placement.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace bb {
+
+namespace {
+
+std::atomic<AffinityMode> affinityMode{AffinityMode::NONE};
+
+#ifdef __linux__
+std::vector<int> allowedCpus() {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    std::vector<int> cpus;
+    if (sched_getaffinity(0, sizeof(mask), &mask) != 0) return cpus;
+    for (int c = 0; c < CPU_SETSIZE; ++c) {
+        if (CPU_ISSET(c, &mask)) cpus.push_back(c);
+    }
+    return cpus;
+}
+
+bool setMask(const std::vector<int>& cpus) {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (int c : cpus) {
+        if (c >= 0 && c < CPU_SETSIZE) CPU_SET(c, &mask);
+    }
+    return CPU_COUNT(&mask) > 0 && sched_setaffinity(0, sizeof(mask), &mask) == 0;
+}
+#else
+std::vector<int> allowedCpus() {
+    std::vector<int> cpus(std::max(1u, std::thread::hardware_concurrency()));
+    for (size_t c = 0; c < cpus.size(); ++c) cpus[c] = static_cast<int>(c);
+    return cpus;
+}
+
+bool setMask(const std::vector<int>&) { return false; }
+#endif
+
+CpuTopology readTopology() {
+    std::vector<int> allowed = allowedCpus();
+    CpuTopology topology;
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    std::vector<std::pair<int, std::vector<int>>> nodes;
+    for (const auto& entry : fs::directory_iterator("/sys/devices/system/node", ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+            !std::all_of(name.begin() + 4, name.end(), ::isdigit)) continue;
+        std::ifstream in(entry.path() / "cpulist");
+        std::string list;
+        std::getline(in, list);
+        std::vector<int> cpus;
+        for (int c : parseCpuList(list)) {
+            if (std::binary_search(allowed.begin(), allowed.end(), c)) cpus.push_back(c);
+        }
+        if (!cpus.empty()) nodes.emplace_back(std::stoi(name.substr(4)), std::move(cpus));
+    }
+    std::sort(nodes.begin(), nodes.end());
+    for (auto& [id, cpus] : nodes) topology.nodes.push_back(std::move(cpus));
+    if (topology.nodes.empty() && !allowed.empty()) topology.nodes.push_back(allowed);
+    return topology;
+}
+
+} // anonymous namespace
+
+const char* affinityModeName(AffinityMode mode) {
+    switch (mode) {
+        case AffinityMode::COMPACT: return "compact";
+        case AffinityMode::SPREAD: return "spread";
+        default: return "none";
+    }
+}
+
+bool parseAffinityMode(const std::string& name, AffinityMode& out) {
+    if (name == "none") out = AffinityMode::NONE;
+    else if (name == "compact") out = AffinityMode::COMPACT;
+    else if (name == "spread") out = AffinityMode::SPREAD;
+    else return false;
+    return true;
+}
+
+int CpuTopology::cpus() const {
+    int n = 0;
+    for (const auto& node : nodes) n += static_cast<int>(node.size());
+    return n;
+}
+
+int CpuTopology::nodeOf(int cpu) const {
+    for (size_t n = 0; n < nodes.size(); ++n) {
+        if (std::binary_search(nodes[n].begin(), nodes[n].end(), cpu)) return static_cast<int>(n);
+    }
+    return -1;
+}
+
+const CpuTopology& CpuTopology::system() {
+    static const CpuTopology topology = readTopology();
+    return topology;
+}
+
+std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        size_t dash = item.find('-');
+        try {
+            int first = std::stoi(item.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+            if (first < 0 || last < first) return {};
+            for (int c = first; c <= last; ++c) cpus.push_back(c);
+        } catch (const std::exception&) {
+            return {};
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+void setThreadAffinity(AffinityMode mode) {
+    affinityMode.store(mode, std::memory_order_relaxed);
+}
+
+AffinityMode threadAffinity() {
+    return affinityMode.load(std::memory_order_relaxed);
+}
+
+int placeWorker(int index, AffinityMode mode, const CpuTopology& topology) {
+    const int total = topology.cpus();
+    if (mode == AffinityMode::NONE || total == 0 || index < 0) return -1;
+    index %= total;
+    if (mode == AffinityMode::COMPACT) {
+        for (const auto& node : topology.nodes) {
+            if (index < static_cast<int>(node.size())) return node[index];
+            index -= static_cast<int>(node.size());
+        }
+        return -1;
+    }
+    // SPREAD: the k-th round takes each node's k-th CPU, skipping nodes
+    // that have run out
+    for (size_t round = 0;; ++round) {
+        for (const auto& node : topology.nodes) {
+            if (round < node.size() && index-- == 0) return node[round];
+        }
+    }
+}
+
+bool pinToCpu(int cpu) {
+    return cpu >= 0 && setMask({cpu});
+}
+
+bool pinToNode(int node, const CpuTopology& topology) {
+    return node >= 0 && node < static_cast<int>(topology.nodes.size()) && setMask(topology.nodes[node]);
+}
+
+int currentNode(const CpuTopology& topology) {
+#ifdef __linux__
+    int cpu = sched_getcpu();
+    return cpu < 0 ? -1 : topology.nodeOf(cpu);
+#else
+    (void)topology;
+    return -1;
+#endif
+}
+
+void runWorkers(int workers, const std::function<void(int worker)>& fn) {
+    const AffinityMode mode = threadAffinity();
+    const CpuTopology& topology = CpuTopology::system();
+    auto placed = [&](int w) {
+        if (mode != AffinityMode::NONE) pinToCpu(placeWorker(w, mode, topology));
+        fn(w);
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(std::max(0, workers - 1));
+    for (int w = 1; w < workers; ++w) pool.emplace_back(placed, w);
+    if (workers > 0) {
+        std::vector<int> callerCpus = mode != AffinityMode::NONE ? allowedCpus() : std::vector<int>{};
+        placed(0);
+        if (!callerCpus.empty()) setMask(callerCpus);
+    }
+    for (auto& th : pool) th.join();
+}
+
+} // namespace bb
@@ -0,0 +1,108 @@
+#include "bb/time_manager.h"
+#include <algorithm>
+#include <cmath>
+
+namespace bb {
+
+namespace {
+
+constexpr int TURNS_PER_HALF = 8;
+
+// Prior entropy over log(n): 1 for a flat root, 0 for a settled one.
+double normalizedEntropy(const std::vector<float>& priors) {
+    double sum = 0.0;
+    for (float p : priors) sum += std::max(0.0f, p);
+    if (priors.size() < 2 || sum <= 0.0) return 0.0;
+    double h = 0.0;
+    for (float p : priors) {
+        double q = std::max(0.0f, p) / sum;
+        if (q > 0.0) h -= q * std::log(q);
+    }
+    return h / std::log(static_cast<double>(priors.size()));
+}
+
+} // anonymous namespace
+
+TimeManager::TimeManager(Config config) : config_(config) {}
+
+void TimeManager::newGame() {
+    gameSpent_ = 0.0;
+    turnSpent_ = 0.0;
+    decisions_ = 0;
+    turns_ = 0;
+    turnDecisions_ = 0;
+    turnHalf_ = 0;
+    turnNumber_ = 0;
+}
+
+void TimeManager::observeTurn(const GameState& state) {
+    int half = state.half;
+    int turn = state.getTeamState(state.activeTeam).turnNumber;
+    if (half == turnHalf_ && turn == turnNumber_) return;
+    // Turn numbers only run backwards when a new game has started
+    if (half < turnHalf_ || (half == turnHalf_ && turn < turnNumber_)) newGame();
+    turnHalf_ = half;
+    turnNumber_ = turn;
+    turnSpent_ = 0.0;
+    turnDecisions_ = 0;
+}
+
+double TimeManager::decisionsPerTurn() const {
+    // The configured guess counts as one turn's worth of evidence
+    return (config_.decisionsPerTurn + decisions_) / (1.0 + turns_);
+}
+
+double TimeManager::remaining() const {
+    double left = config_.gameBudget > 0.0 ? config_.gameBudget - gameSpent_
+                                           : config_.turnBudget - turnSpent_;
+    return std::max(0.0, left);
+}
+
+double TimeManager::allocate(const GameState& state, const std::vector<float>& priors) {
+    if (priors.size() < 2) return 0.0;
+    observeTurn(state);
+
+    // Decisions still to come, this one included
+    double perTurn = std::max(1.0, decisionsPerTurn());
+    double expected = std::max(1.0, perTurn - turnDecisions_);
+    int turn = std::clamp(turnNumber_, 1, TURNS_PER_HALF);
+    bool lastTurn = turn == TURNS_PER_HALF;
+    if (config_.gameBudget > 0.0) {
+        int turnsAfter = (TURNS_PER_HALF - turn) + (state.half < 2 ? TURNS_PER_HALF : 0);
+        expected += turnsAfter * perTurn;
+    }
+    double left = remaining();
+    double share = left / expected;
+
+    // Wide, undecided roots need more; near-forced ones less
+    double n = static_cast<double>(priors.size());
+    double breadth = std::min(1.5, std::log(n) / std::log(8.0));
+    double scale = 0.25 + normalizedEntropy(priors) * breadth;
+
+    // Score situation: the last turn of a half is the last chance to use
+    // this drive; it is decisive when the game is on it. Lopsided games
+    // matter less.
+    const TeamState& own = state.getTeamState(state.activeTeam);
+    const TeamState& opp = state.getTeamState(opponent(state.activeTeam));
+    int margin = own.score - opp.score;
+    if (lastTurn) scale *= 2.0;
+    if (lastTurn && state.half >= 2 && margin <= 0) scale *= 1.5;  // must score
+    if (state.half >= 2 && std::abs(margin) <= 1) scale *= 1.25;
+    if (std::abs(margin) >= 3) scale *= 0.5;
+
+    double budget = share * std::clamp(scale, config_.minScale, config_.maxScale);
+    if (config_.gameBudget > 0.0) budget = std::min(budget, left * config_.maxFraction);
+    budget = std::min(std::max(budget, config_.minAllocation), std::max(left, config_.minAllocation));
+
+    if (turnDecisions_ == 0) turns_++;
+    turnDecisions_++;
+    decisions_++;
+    return budget;
+}
+
+void TimeManager::spend(double used) {
+    gameSpent_ += used;
+    turnSpent_ += used;
+}
+
+} // namespace bb
@@ -0,0 +1,269 @@
+#include "bb/tournament.h"
+#include "bb/roster.h"
+#include "bb/thread_placement.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+
+namespace bb {
+
+namespace {
+
+// Expected score of a side `elo` points stronger (logistic Elo)
+double eloScore(double elo) {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+double gameScore(int own, int other) {
+    return own > other ? 1.0 : own == other ? 0.5 : 0.0;
+}
+
+// Counts pairs into a result, in the order given, and applies the stopping
+// rule after each
+class MatchTally {
+public:
+    MatchTally(MatchResult& match, const TournamentConfig& config)
+        : match_(match), config_(config),
+          lowerBound_(std::log(config.beta / (1.0 - config.alpha))),
+          upperBound_(std::log((1.0 - config.beta) / config.alpha)) {}
+
+    // True once the match is settled
+    bool add(const PairOutcome& p) {
+        MatchResult& match = match_;
+        for (int g = 0; g < 2; ++g) {
+            if (p.scoreA[g] > p.scoreB[g]) ++match.wins;
+            else if (p.scoreA[g] == p.scoreB[g]) ++match.draws;
+            else ++match.losses;
+            match.touchdownsA += p.scoreA[g];
+            match.touchdownsB += p.scoreB[g];
+            match.totalActions += p.totalActions[g];
+            ++match.scoreDiff[p.scoreA[g] - p.scoreB[g]];
+        }
+        match.outcomes.push_back(p);
+        double pairScore = (gameScore(p.scoreA[0], p.scoreB[0]) + gameScore(p.scoreA[1], p.scoreB[1])) / 2.0;
+        ++match.pairs;
+        sum_ += pairScore;
+        sumSquares_ += pairScore * pairScore;
+        match.score = sum_ / match.pairs;
+        wilsonInterval(match.score, 2 * match.pairs, config_.wilsonZ, match.lower, match.upper);
+        if (config_.stop == StopRule::SPRT) {
+            match.llr = sprtLlr(match.pairs, sum_, sumSquares_, config_.elo0, config_.elo1);
+        }
+
+        if (match.pairs < config_.minPairs) return false;
+        if (config_.stop == StopRule::SPRT) {
+            if (match.llr >= upperBound_) match.verdict = MatchVerdict::A_STRONGER;
+            else if (match.llr <= lowerBound_) match.verdict = MatchVerdict::NOT_STRONGER;
+        } else if (config_.stop == StopRule::WILSON) {
+            if (match.lower > 0.5) match.verdict = MatchVerdict::A_STRONGER;
+            else if (match.upper < 0.5) match.verdict = MatchVerdict::NOT_STRONGER;
+        }
+        return match.verdict != MatchVerdict::UNDECIDED;
+    }
+
+private:
+    MatchResult& match_;
+    const TournamentConfig& config_;
+    double lowerBound_;
+    double upperBound_;
+    double sum_ = 0.0;
+    double sumSquares_ = 0.0;
+};
+
+} // anonymous namespace
+
+const char* matchVerdictName(MatchVerdict v) {
+    switch (v) {
+        case MatchVerdict::A_STRONGER: return "A_STRONGER";
+        case MatchVerdict::NOT_STRONGER: return "NOT_STRONGER";
+        default: return "UNDECIDED";
+    }
+}
+
+double sprtLlr(int n, double sum, double sumSquares, double elo0, double elo1) {
+    if (n <= 0) return 0.0;
+    const double mean = sum / n;
+    // Identical pair scores carry no variance estimate. Floor it near the
+    // variance one quarter-point step among n pairs would give, so a short
+    // identical run moves the ratio without settling the match by itself.
+    const double variance = std::max(sumSquares / n - mean * mean, 0.0625 / n);
+    const double s0 = eloScore(elo0), s1 = eloScore(elo1);
+    return n * (s1 - s0) * (2.0 * mean - s0 - s1) / (2.0 * variance);
+}
+
+void wilsonInterval(double score, int n, double z, double& lower, double& upper) {
+    if (n <= 0) {
+        lower = 0.0;
+        upper = 1.0;
+        return;
+    }
+    const double z2n = z * z / n;
+    const double centre = (score + z2n / 2.0) / (1.0 + z2n);
+    const double half = z * std::sqrt(score * (1.0 - score) / n + z2n / (4.0 * n)) / (1.0 + z2n);
+    lower = std::max(0.0, centre - half);
+    upper = std::min(1.0, centre + half);
+}
+
+MatchResult runMatch(const PlayerConfig& a, const PlayerConfig& b,
+                     const TournamentConfig& config, const GameCallback& onGame,
+                     int indexA, int indexB) {
+    if (config.maxPairs <= 0 || config.threads <= 0 || config.firstPair < 0) {
+        throw std::invalid_argument("runMatch: maxPairs and threads must be positive, firstPair not negative");
+    }
+    std::vector<const TeamRoster*> rosters = config.rosters;
+    if (rosters.empty()) rosters = {&getHumanRoster(), &getOrcRoster()};
+    const int numRosters = static_cast<int>(rosters.size());
+
+    MatchResult match;
+    match.playerA = indexA;
+    match.playerB = indexB;
+    MatchTally tally(match, config);
+    std::mutex mutex;
+    std::vector<PairOutcome> outcomes(config.maxPairs);
+    std::vector<int> gamesDone(config.maxPairs, 0);
+    int nextPair = 0;  // the first pair not yet counted
+    std::atomic<bool> stopped{false};
+
+    // Completed games: stream them, and count finished pairs in pair order
+    auto record = [&](const TournamentGame& game) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (onGame) onGame(game);
+        const int local = game.pair - config.firstPair;
+        const int side = game.aIsHome ? 0 : 1;
+        PairOutcome& o = outcomes[local];
+        o.pair = game.pair;
+        o.scoreA[side] = game.scoreA;
+        o.scoreB[side] = game.scoreB;
+        o.totalActions[side] = game.totalActions;
+        ++gamesDone[local];
+        while (!stopped.load() && nextPair < config.maxPairs && gamesDone[nextPair] == 2) {
+            if (tally.add(outcomes[nextPair++])) stopped = true;
+        }
+    };
+
+    // Workers claim games in order, pair by pair, until the match is settled
+    const int games = 2 * config.maxPairs;
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int g = next.fetch_add(1); g < games && !stopped.load(); g = next.fetch_add(1)) {
+            TournamentGame game;
+            game.playerA = indexA;
+            game.playerB = indexB;
+            game.pair = config.firstPair + g / 2;
+            game.aIsHome = g % 2 == 0;
+            game.seed = config.seed + static_cast<uint32_t>(game.pair);
+            const TeamRoster& home = *rosters[game.pair % numRosters];
+            const TeamRoster& away = *rosters[(game.pair + 1) % numRosters];
+            game.homeRoster = home.name;
+            game.awayRoster = away.name;
+            GameResult r = game.aIsHome ? playConfiguredGame(home, away, a, b, game.seed, config.adjudicate)
+                                        : playConfiguredGame(home, away, b, a, game.seed, config.adjudicate);
+            game.scoreA = game.aIsHome ? r.homeScore : r.awayScore;
+            game.scoreB = game.aIsHome ? r.awayScore : r.homeScore;
+            game.totalActions = r.totalActions;
+            game.adjudicated = r.adjudicated;
+            record(game);
+        }
+    };
+    const int workers = std::min(config.threads, games);
+    runWorkers(workers, [&](int) { worker(); });
+    return match;
+}
+
+MatchResult mergeMatches(const std::vector<MatchResult>& shards, const TournamentConfig& config) {
+    std::vector<PairOutcome> outcomes;
+    for (const MatchResult& shard : shards) {
+        outcomes.insert(outcomes.end(), shard.outcomes.begin(), shard.outcomes.end());
+    }
+    std::sort(outcomes.begin(), outcomes.end(),
+              [](const PairOutcome& x, const PairOutcome& y) { return x.pair < y.pair; });
+    for (size_t i = 1; i < outcomes.size(); ++i) {
+        if (outcomes[i].pair == outcomes[i - 1].pair) {
+            throw std::invalid_argument("mergeMatches: pair " + std::to_string(outcomes[i].pair) + " played twice");
+        }
+        if (outcomes[i].pair != outcomes[i - 1].pair + 1) {
+            throw std::invalid_argument("mergeMatches: pair " + std::to_string(outcomes[i - 1].pair + 1) + " missing");
+        }
+    }
+
+    MatchResult match;
+    if (!shards.empty()) {
+        match.playerA = shards[0].playerA;
+        match.playerB = shards[0].playerB;
+    }
+    MatchTally tally(match, config);
+    for (const PairOutcome& o : outcomes) {
+        if (tally.add(o)) break;
+    }
+    return match;
+}
+
+std::string matchSummaryJson(const MatchResult& match) {
+    nlohmann::json diff = nlohmann::json::object();
+    for (const auto& [d, games] : match.scoreDiff) diff[std::to_string(d)] = games;
+    nlohmann::json outcomes = nlohmann::json::array();
+    for (const PairOutcome& o : match.outcomes) {
+        outcomes.push_back({o.pair, o.scoreA[0], o.scoreB[0], o.totalActions[0],
+                            o.scoreA[1], o.scoreB[1], o.totalActions[1]});
+    }
+    nlohmann::json j = {
+        {"player_a", match.playerA}, {"player_b", match.playerB},
+        {"pairs", match.pairs}, {"wins", match.wins}, {"draws", match.draws}, {"losses", match.losses},
+        {"score", match.score}, {"llr", match.llr}, {"lower", match.lower}, {"upper", match.upper},
+        {"verdict", matchVerdictName(match.verdict)},
+        {"touchdowns_a", match.touchdownsA}, {"touchdowns_b", match.touchdownsB},
+        {"total_actions", match.totalActions}, {"score_diff", std::move(diff)},
+        {"outcomes", std::move(outcomes)},
+    };
+    return j.dump();
+}
+
+bool parseMatchSummary(const std::string& text, MatchResult& out) {
+    nlohmann::json j = nlohmann::json::parse(text, nullptr, false);
+    if (j.is_discarded() || !j.is_object() || !j.contains("outcomes") || !j["outcomes"].is_array()) {
+        return false;
+    }
+    MatchResult shard;
+    shard.playerA = j.value("player_a", 0);
+    shard.playerB = j.value("player_b", 1);
+    for (const nlohmann::json& row : j["outcomes"]) {
+        if (!row.is_array() || row.size() != 7) return false;
+        for (const nlohmann::json& v : row) {
+            if (!v.is_number_integer()) return false;
+        }
+        PairOutcome o;
+        o.pair = row[0].get<int>();
+        for (int g = 0; g < 2; ++g) {
+            o.scoreA[g] = row[1 + 3 * g].get<int>();
+            o.scoreB[g] = row[2 + 3 * g].get<int>();
+            o.totalActions[g] = row[3 + 3 * g].get<int>();
+        }
+        shard.outcomes.push_back(o);
+    }
+    TournamentConfig counting;
+    counting.stop = StopRule::NONE;
+    try {
+        out = mergeMatches({shard}, counting);
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
+    return true;
+}
+
+std::vector<MatchResult> runTournament(const std::vector<PlayerConfig>& players,
+                                       const TournamentConfig& config,
+                                       const GameCallback& onGame) {
+    std::vector<MatchResult> results;
+    for (size_t i = 0; i < players.size(); ++i) {
+        for (size_t j = i + 1; j < players.size(); ++j) {
+            results.push_back(runMatch(players[i], players[j], config, onGame,
+                                       static_cast<int>(i), static_cast<int>(j)));
+        }
+    }
+    return results;
+}
+
+} // namespace bb
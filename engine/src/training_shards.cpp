@@ -0,0 +1,202 @@
+#include "bb/training_shards.h"
+#include "bb/alloc_tracking.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+#ifdef BB_ZSTD
+#include <zstd.h>
+#endif
+
+namespace bb {
+
+namespace {
+
+constexpr const char* SHARD_EXTENSIONS[3] = {"states", "decisions", "visits"};
+constexpr uint32_t SHARD_RECORD_SIZES[3] = {
+    sizeof(ShardStateRecord), sizeof(ShardDecisionRecord), sizeof(ShardVisitRecord)};
+
+int kindIndex(ShardKind kind) { return static_cast<int>(kind) - 1; }
+
+#ifdef BB_ZSTD
+// Replace `path` by a zstd frame of its contents at path + ".zst".
+bool compressFile(const std::string& path, int level) {
+    std::ifstream in(path, std::ios::binary);
+    std::string raw((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::string packed(ZSTD_compressBound(raw.size()), '\0');
+    size_t n = ZSTD_compress(packed.data(), packed.size(), raw.data(), raw.size(), level);
+    if (ZSTD_isError(n)) return false;
+    std::ofstream out(path + ".zst", std::ios::binary | std::ios::trunc);
+    out.write(packed.data(), static_cast<std::streamsize>(n));
+    if (!out) return false;
+    std::remove(path.c_str());
+    return true;
+}
+#endif
+
+} // anonymous namespace
+
+ShardWriter::ShardWriter(std::string dir, ShardWriterConfig config)
+    : dir_(std::move(dir)), config_(config) {
+#ifndef BB_ZSTD
+    if (config_.compress) throw std::invalid_argument("ShardWriter: built without zstd (BB_ZSTD)");
+#endif
+    std::filesystem::create_directories(dir_);
+    // Continue after the shards a previous writer completed
+    std::ifstream index(dir_ + "/index.jsonl");
+    std::string line;
+    while (std::getline(index, line)) {
+        auto entry = nlohmann::json::parse(line, nullptr, false);
+        if (entry.is_discarded()) continue;
+        shardId_ = std::max(shardId_, entry.value("shard", -1) + 1);
+        nextGame_ = std::max(nextGame_, entry.value("first_game", 0u) + entry.value("games", 0u));
+    }
+}
+
+ShardWriter::~ShardWriter() {
+    try {
+        close();
+    } catch (const std::exception&) {
+        // The open shard stays out of the index
+    }
+}
+
+std::string ShardWriter::shardPath(int shard, ShardKind kind) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "shard-%06d.", shard);
+    return dir_ + "/" + name + SHARD_EXTENSIONS[kindIndex(kind)];
+}
+
+void ShardWriter::openShard() {
+    shard_ = Shard();
+    for (ShardKind kind : {ShardKind::STATES, ShardKind::DECISIONS, ShardKind::VISITS}) {
+        int k = kindIndex(kind);
+        std::ofstream& f = shard_.files[k];
+        f.open(shardPath(shardId_, kind), std::ios::binary | std::ios::trunc);
+        if (!f.is_open()) throw std::runtime_error("ShardWriter: cannot open " + shardPath(shardId_, kind));
+        ShardFileHeader h;
+        h.kind = kind;
+        h.recordSize = SHARD_RECORD_SIZES[k];
+        f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        shard_.bytes += sizeof(h);
+    }
+    open_ = true;
+}
+
+void ShardWriter::finishShard() {
+    for (std::ofstream& f : shard_.files) f.close();
+    bool compressed = false;
+#ifdef BB_ZSTD
+    if (config_.compress) {
+        compressed = true;
+        for (ShardKind kind : {ShardKind::STATES, ShardKind::DECISIONS, ShardKind::VISITS}) {
+            if (!compressFile(shardPath(shardId_, kind), config_.compressionLevel)) {
+                throw std::runtime_error("ShardWriter: cannot compress " + shardPath(shardId_, kind));
+            }
+        }
+    }
+#endif
+    nlohmann::json entry = {
+        {"shard", shardId_},
+        {"first_game", nextGame_ - shard_.games},
+        {"games", shard_.games},
+        {"states", shard_.counts[0]},
+        {"decisions", shard_.counts[1]},
+        {"visits", shard_.counts[2]},
+        {"zstd", compressed},
+    };
+    std::ofstream index(dir_ + "/index.jsonl", std::ios::app);
+    index << entry.dump() << '\n';
+    open_ = false;
+    shardId_++;
+    shardsWritten_++;
+}
+
+uint32_t ShardWriter::appendGame(const LoggedGameResult& game, float homeOutcome, float awayOutcome) {
+    BB_ALLOC_SCOPE(alloc::LOGGING);
+    auto outcome = [&](TeamSide side) { return side == TeamSide::HOME ? homeOutcome : awayOutcome; };
+
+    // Pack outside the lock; only the game number and the visit rows
+    // depend on where the block lands.
+    std::vector<ShardStateRecord> states(game.states.size());
+    for (size_t i = 0; i < game.states.size(); ++i) {
+        const StateLog& s = game.states[i];
+        ShardStateRecord& r = states[i];
+        std::memcpy(r.features, s.features, sizeof(r.features));
+        r.outcome = outcome(s.perspective);
+        r.index = static_cast<uint16_t>(std::min<size_t>(i, UINT16_MAX));
+        r.perspective = s.perspective == TeamSide::HOME ? 0 : 1;
+    }
+    std::vector<ShardDecisionRecord> decisions(game.policyDecisions.size());
+    std::vector<ShardVisitRecord> visits;
+    for (size_t i = 0; i < game.policyDecisions.size(); ++i) {
+        const PolicyDecision& d = game.policyDecisions[i];
+        ShardDecisionRecord& r = decisions[i];
+        std::memcpy(r.stateFeatures, d.stateFeatures, sizeof(r.stateFeatures));
+        r.outcome = outcome(d.perspective);
+        r.firstVisit = static_cast<uint32_t>(visits.size());  // rebased below
+        r.numVisits = static_cast<uint32_t>(d.visits.size());
+        r.perspective = d.perspective == TeamSide::HOME ? 0 : 1;
+        r.mirrored = d.mirrored ? 1 : 0;
+        r.stateHash = d.stateHash;
+        r.canonicalHash = d.canonicalHash;
+        r.visitWeight = static_cast<float>(d.totalVisits);
+        r.samples = 1;
+        for (const auto& v : d.visits) {
+            ShardVisitRecord& vr = visits.emplace_back();
+            std::memcpy(vr.actionFeatures, v.actionFeatures, sizeof(vr.actionFeatures));
+            vr.visitFraction = v.visitFraction;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_) throw std::runtime_error("ShardWriter: append after close");
+    if (!open_) openShard();
+    uint32_t gameId = nextGame_++;
+    for (ShardStateRecord& r : states) r.game = gameId;
+    for (ShardDecisionRecord& r : decisions) r.game = gameId;
+    writeBlock(states, decisions, visits);
+    shard_.games++;
+    if (shard_.bytes >= config_.maxShardBytes) finishShard();
+    return gameId;
+}
+
+void ShardWriter::appendRecords(std::vector<ShardStateRecord>& states, std::vector<ShardDecisionRecord>& decisions,
+                                const std::vector<ShardVisitRecord>& visits) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_) throw std::runtime_error("ShardWriter: append after close");
+    if (!open_) openShard();
+    writeBlock(states, decisions, visits);
+    if (shard_.bytes >= config_.maxShardBytes) finishShard();
+}
+
+void ShardWriter::writeBlock(const std::vector<ShardStateRecord>& states, std::vector<ShardDecisionRecord>& decisions,
+                             const std::vector<ShardVisitRecord>& visits) {
+    for (ShardDecisionRecord& r : decisions) r.firstVisit += static_cast<uint32_t>(shard_.counts[2]);
+    auto write = [&](int k, const void* data, size_t count) {
+        size_t bytes = count * SHARD_RECORD_SIZES[k];
+        shard_.files[k].write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        if (!shard_.files[k]) throw std::runtime_error("ShardWriter: write failed");
+        shard_.bytes += bytes;
+        shard_.counts[k] += count;
+    };
+    write(0, states.data(), states.size());
+    write(1, decisions.data(), decisions.size());
+    write(2, visits.data(), visits.size());
+}
+
+void ShardWriter::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_) finishShard();
+    closed_ = true;
+}
+
+int ShardWriter::shardsWritten() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return shardsWritten_;
+}
+
+} // namespace bb
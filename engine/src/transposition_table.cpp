@@ -0,0 +1,75 @@
+#include "bb/transposition_table.h"
+
+namespace bb {
+
+TranspositionTable::TranspositionTable(size_t bytes) {
+    resize(bytes);
+}
+
+void TranspositionTable::resize(size_t bytes) {
+    buckets_.clear();
+    mask_ = 0;
+    if (bytes == 0) return;
+    size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= bytes) count *= 2;
+    buckets_.assign(count, Bucket{});
+    mask_ = count - 1;
+    generation_ = 1;
+}
+
+void TranspositionTable::newSearch() {
+    // On wrap-around old generations could alias live ones: start clean.
+    if (++generation_ == 0) clear();
+}
+
+void TranspositionTable::clear() {
+    for (auto& b : buckets_) b = Bucket{};
+    generation_ = 1;
+}
+
+bool TranspositionTable::probe(uint64_t key, Stats& out) {
+    if (!enabled()) return false;
+    for (const Entry& e : bucketFor(key).entries) {
+        if (e.key == key && e.generation == generation_ && e.visits > 0) {
+            out.visits = e.visits;
+            out.totalValue = e.totalValue;
+            hits_++;
+            return true;
+        }
+    }
+    misses_++;
+    return false;
+}
+
+void TranspositionTable::update(uint64_t key, double value) {
+    if (!enabled()) return;
+    Bucket& bucket = bucketFor(key);
+    Entry* slot = nullptr;
+    for (Entry& e : bucket.entries) {
+        if (e.key == key && e.generation == generation_) {
+            slot = &e;
+            break;
+        }
+    }
+    if (!slot) {
+        // Replace: empty first, then an older generation, then fewest visits.
+        auto rank = [this](const Entry& e) {
+            int age = e.generation == 0 ? 0 : (e.generation != generation_ ? 1 : 2);
+            return (age << 16) | e.visits;
+        };
+        slot = &bucket.entries[0];
+        for (Entry& e : bucket.entries) {
+            if (rank(e) < rank(*slot)) slot = &e;
+        }
+        if (slot->generation == generation_) evictions_++;
+        *slot = Entry{key, 0.0f, 0, generation_};
+    }
+    if (slot->visits == UINT16_MAX) {
+        slot->visits /= 2;
+        slot->totalValue *= 0.5f;
+    }
+    slot->visits++;
+    slot->totalValue += static_cast<float>(value);
+}
+
+} // namespace bb
@@ -40,14 +40,13 @@ ActionResult resolveThrowTeamMate(GameState& state, int throwerId, int projectil
 
             if (!rerolled && hungryRoll == 1) {
                 // Eaten! Projectile injured, removed from pitch
-                emitEvent(events, {GameEvent::Type::SKILL_USED, throwerId, projectileId,
-                                  thrower.position, {}, static_cast<int>(SkillName::AlwaysHungry), false});
+                BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, throwerId, projectileId,
+                                      thrower.position, {}, static_cast<int>(SkillName::AlwaysHungry), false);
 
                 // Drop ball if projectile carried it
                 handleBallOnPlayerDown(state, projectileId, dice, events);
 
-                projectile.state = PlayerState::INJURED;
-                projectile.position = {-1, -1};
+                state.removePlayer(projectile, PlayerState::INJURED);
                 return ActionResult::ok(); // NOT turnover
             }
         }
@@ -61,7 +60,7 @@ ActionResult resolveThrowTeamMate(GameState& state, int throwerId, int projectil
         range = static_cast<PassRange>(static_cast<int>(range) - 1);
     }
 
-    int passTarget = 7 - thrower.stats.agility;
+    int passTarget = 7 - thrower.stats().agility;
     passTarget -= passModifier(range);
 
     if (!thrower.hasSkill(SkillName::NervesOfSteel)) {
@@ -71,8 +70,8 @@ ActionResult resolveThrowTeamMate(GameState& state, int throwerId, int projectil
     passTarget = std::clamp(passTarget, 2, 6);
 
     int roll = dice.rollD6();
-    emitEvent(events, {GameEvent::Type::PASS, throwerId, projectileId, thrower.position,
-                      target, roll, roll >= passTarget && roll != 1});
+    BB_EMIT_EVENT(events, GameEvent::Type::PASS, throwerId, projectileId, thrower.position,
+                          target, roll, roll >= passTarget && roll != 1);
 
     // Determine landing position
     Position landPos = target;
@@ -97,7 +96,7 @@ ActionResult resolveThrowTeamMate(GameState& state, int throwerId, int projectil
     // Off-pitch: crowd surf + injury + turnover
     if (!landPos.isOnPitch()) {
         handleBallOnPlayerDown(state, projectileId, dice, events);
-        projectile.position = {-1, -1};
+        state.movePlayer(projectile, {-1, -1});
         resolveCrowdSurf(state, projectileId, dice, events);
         return ActionResult::turnovr();
     }
@@ -110,20 +109,20 @@ ActionResult resolveThrowTeamMate(GameState& state, int throwerId, int projectil
                    static_cast<int8_t>(landPos.y + scatter.y)};
         if (!landPos.isOnPitch()) {
             handleBallOnPlayerDown(state, projectileId, dice, events);
-            projectile.position = {-1, -1};
+            state.movePlayer(projectile, {-1, -1});
             resolveCrowdSurf(state, projectileId, dice, events);
             return ActionResult::turnovr();
         }
     }
 
     // Move projectile to landing position
-    projectile.position = landPos;
+    state.movePlayer(projectile, landPos);
     if (state.ball.isHeld && state.ball.carrierId == projectileId) {
         state.ball.position = landPos;
     }
 
     // Landing roll
-    int landTarget = 7 - projectile.stats.agility;
+    int landTarget = 7 - projectile.stats().agility;
     int tz = countTacklezones(state, landPos, projectile.teamSide);
     landTarget += tz;
     landTarget = std::clamp(landTarget, 2, 6);
@@ -131,14 +130,14 @@ ActionResult resolveThrowTeamMate(GameState& state, int throwerId, int projectil
     int landRoll = dice.rollD6();
     if (landRoll >= landTarget) {
         // Landed successfully — standing
-        emitEvent(events, {GameEvent::Type::SKILL_USED, projectileId, -1, landPos, {},
-                          static_cast<int>(SkillName::RightStuff), true});
+        BB_EMIT_EVENT(events, GameEvent::Type::SKILL_USED, projectileId, -1, landPos, {},
+                              static_cast<int>(SkillName::RightStuff), true);
         return ActionResult::ok();
     }
 
     // Failed landing: prone + armor roll
-    projectile.state = PlayerState::PRONE;
-    emitEvent(events, {GameEvent::Type::KNOCKED_DOWN, projectileId, -1, landPos, {}, 0, false});
+    state.setPlayerState(projectile, PlayerState::PRONE);
+    BB_EMIT_EVENT(events, GameEvent::Type::KNOCKED_DOWN, projectileId, -1, landPos, {}, 0, false);
     InjuryContext ctx;
     resolveArmourAndInjury(state, projectileId, dice, ctx, events);
     handleBallOnPlayerDown(state, projectileId, dice, events);
@@ -9,8 +9,7 @@ void resolveEndTurn(GameState& state, std::vector<GameEvent>* events, bool wasTu
     // Eject Secret Weapon players
     state.forEachOnPitch(current, [&](Player& p) {
         if (p.hasSkill(SkillName::SecretWeapon)) {
-            p.state = PlayerState::EJECTED;
-            p.position = {-1, -1};
+            state.removePlayer(p, PlayerState::EJECTED);
         }
     });
 
@@ -29,8 +28,8 @@ void resolveEndTurn(GameState& state, std::vector<GameEvent>* events, bool wasTu
     state.turnoverPending = false;
 
     if (wasTurnover) {
-        emitEvent(events, {GameEvent::Type::TURNOVER, -1, -1, {}, {},
-                          newTeam.turnNumber, true});
+        BB_EMIT_EVENT(events, GameEvent::Type::TURNOVER, -1, -1, {}, {},
+                              newTeam.turnNumber, true);
     }
 }
 
@@ -0,0 +1,126 @@
+#include "bb/undo_journal.h"
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+namespace bb {
+
+namespace {
+
+constexpr uint32_t ALL_SLOTS = (1u << 22) - 1;
+
+// Bytewise comparison of trivially-copyable records. Padding can only cause
+// a spurious "changed" (a redundant entry), never a missed change.
+template<typename T>
+bool sameBytes(const T& a, const T& b) {
+    return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+} // anonymous namespace
+
+UndoJournal::Header UndoJournal::readHeader(const GameState& state) {
+    return {state.half, state.phase, state.activeTeam, state.ball,
+            state.turnoverPending, state.currentActivationId,
+            state.kickingTeam, state.weather, state.receiverSpeed,
+            state.homeTeam, state.awayTeam};
+}
+
+void UndoJournal::writeHeader(GameState& state, const Header& h) {
+    state.half = h.half;
+    state.phase = h.phase;
+    state.activeTeam = h.activeTeam;
+    state.ball = h.ball;
+    state.turnoverPending = h.turnoverPending;
+    state.currentActivationId = h.currentActivationId;
+    state.kickingTeam = h.kickingTeam;
+    state.weather = h.weather;
+    state.receiverSpeed = h.receiverSpeed;
+    state.homeTeam = h.homeTeam;
+    state.awayTeam = h.awayTeam;
+}
+
+bool UndoJournal::matchesCurrent(const GameState& state, uint32_t slots) const {
+    for (; slots; slots &= slots - 1) {
+        int i = std::countr_zero(slots);
+        if (!sameBytes(current_[i], state.players[i])) return false;
+    }
+    return true;
+}
+
+void UndoJournal::begin(GameState& state) {
+    if (!tracking_) {
+        current_ = state.players;
+        tracking_ = true;
+    }
+    // Changed outside a journaled step: that change could not be undone
+    assert(matchesCurrent(state, ALL_SLOTS));
+    preHeader_ = readHeader(state);
+    state.clearTouched();
+}
+
+void UndoJournal::end(const GameState& state) {
+    steps_.push_back({preHeader_, static_cast<uint32_t>(players_.size())});
+    uint32_t touched = state.touchedPlayers();
+    for (uint32_t slots = touched; slots; slots &= slots - 1) {
+        int i = std::countr_zero(slots);
+        if (!sameBytes(current_[i], state.players[i])) {
+            players_.push_back({static_cast<uint8_t>(i), current_[i]});
+            current_[i] = state.players[i];
+        }
+    }
+    // A player written without passing the write barrier
+    assert(matchesCurrent(state, ~touched & ALL_SLOTS));
+}
+
+void UndoJournal::assign(GameState& state, const GameState& source) {
+    begin(state);
+    for (size_t i = 0; i < state.players.size(); ++i) {
+        if (!sameBytes(state.players[i], source.players[i])) {
+            state.restorePlayer(state.players[i], source.players[i]);
+        }
+    }
+    writeHeader(state, readHeader(source));
+    end(state);
+}
+
+void UndoJournal::undoTo(GameState& state, size_t mark) {
+    assert(mark <= steps_.size());
+    while (steps_.size() > mark) {
+        const Step& step = steps_.back();
+        // Within a step each slot appears at most once, so restore order
+        // doesn't matter; restorePlayer copes with swapped squares.
+        for (size_t i = players_.size(); i > step.firstPlayer; --i) {
+            const PlayerEntry& e = players_[i - 1];
+            state.restorePlayer(state.players[e.slot], e.before);
+            current_[e.slot] = e.before;
+        }
+        players_.resize(step.firstPlayer);
+        writeHeader(state, step.header);
+        steps_.pop_back();
+    }
+}
+
+void UndoJournal::clear() {
+    steps_.clear();
+    players_.clear();
+    tracking_ = false;
+}
+
+ActionResult executeActionJournaled(GameState& state, const Action& action,
+                                    DiceRollerBase& dice, UndoJournal& journal,
+                                    std::vector<GameEvent>* events) {
+    journal.begin(state);
+    ActionResult result = executeAction(state, action, dice, events);
+    journal.end(state);
+    return result;
+}
+
+MacroExpansionResult greedyExpandMacroJournaled(GameState& state, const Macro& macro,
+                                                DiceRollerBase& dice, UndoJournal& journal) {
+    journal.begin(state);
+    MacroExpansionResult result = greedyExpandMacro(state, macro, dice);
+    journal.end(state);
+    return result;
+}
+
+} // namespace bb
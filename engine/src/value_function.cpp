@@ -1,4 +1,9 @@
 #include "bb/value_function.h"
+#include "bb/conv_network.h"
+#include "bb/feature_extractor.h"
+#include "bb/mlp.h"
+#include "bb/weights_file.h"
+#include "bb/profile.h"
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <cmath>
@@ -6,52 +11,155 @@
 
 namespace bb {
 
+void ValueFunction::evaluateBatch(const float* features, int batch, int numFeatures,
+                                  float* out) const {
+    for (int b = 0; b < batch; ++b) {
+        out[b] = evaluate(features + static_cast<size_t>(b) * numFeatures, numFeatures);
+    }
+}
+
+int ValueFunction::inputSize() const { return NUM_FEATURES; }
+
+void ValueFunction::encodeState(const GameState& state, TeamSide perspective, float* out) const {
+    extractFeatures(state, perspective, out);
+}
+
+float ValueFunction::evaluateState(const GameState& state, TeamSide perspective) const {
+    int n = inputSize();
+    if (n <= NUM_FEATURES) {
+        float features[NUM_FEATURES];
+        encodeState(state, perspective, features);
+        return evaluate(features, n);
+    }
+    thread_local std::vector<float> input;
+    input.resize(static_cast<size_t>(n));
+    encodeState(state, perspective, input.data());
+    return evaluate(input.data(), n);
+}
+
 // --- LinearValueFunction ---
 
 LinearValueFunction::LinearValueFunction(std::vector<float> weights)
     : weights_(std::move(weights)) {}
 
 float LinearValueFunction::evaluate(const float* features, int numFeatures) const {
-    float sum = 0.0f;
+    BB_PROFILE_NAMED_SCOPE(profile, prof::VALUE_EVAL);
+    BB_PROFILE_UNITS(profile, 1);
+    int n = std::min(numFeatures, static_cast<int>(weights_.size()));
+    return dotProduct(weights_.data(), features, n);
+}
+
+void LinearValueFunction::evaluateBatch(const float* features, int batch, int numFeatures,
+                                        float* out) const {
+    BB_PROFILE_NAMED_SCOPE(profile, prof::VALUE_EVAL);
+    BB_PROFILE_UNITS(profile, batch);
     int n = std::min(numFeatures, static_cast<int>(weights_.size()));
-    for (int i = 0; i < n; ++i) {
-        sum += weights_[i] * features[i];
+    for (int b = 0; b < batch; ++b) {
+        out[b] = dotProduct(weights_.data(), features + static_cast<size_t>(b) * numFeatures, n);
     }
-    return sum;
 }
 
 // --- NeuralValueFunction ---
 
 NeuralValueFunction::NeuralValueFunction(int inputSize, int hiddenSize,
-                                         std::vector<std::vector<float>> W1,
+                                         const std::vector<std::vector<float>>& W1,
                                          std::vector<float> b1,
                                          std::vector<float> W2,
                                          float b2)
-    : inputSize_(inputSize), hiddenSize_(hiddenSize),
-      W1_(std::move(W1)), b1_(std::move(b1)),
-      W2_(std::move(W2)), b2_(b2) {}
+    : inputSize_(inputSize), hiddenSize_(hiddenSize), stride_(simdPadded(inputSize)),
+      b1_(std::move(b1)), W2_(std::move(W2)), b2_(b2) {
+    auto rows = std::make_shared<AlignedVector<float>>(static_cast<size_t>(hiddenSize) * stride_, 0.0f);
+    for (int i = 0; i < inputSize_; ++i) {
+        for (int j = 0; j < hiddenSize_; ++j) {
+            (*rows)[static_cast<size_t>(j) * stride_ + i] = W1[i][j];
+        }
+    }
+    W1_ = std::shared_ptr<const float[]>(rows, rows->data());
+    buildInt8();
+}
 
-float NeuralValueFunction::evaluate(const float* features, int numFeatures) const {
-    // Hidden layer: h = ReLU(features @ W1 + b1)
-    std::vector<float> hidden(hiddenSize_);
-    int inSize = std::min(numFeatures, inputSize_);
+NeuralValueFunction::NeuralValueFunction(int inputSize, int hiddenSize,
+                                         std::shared_ptr<const float[]> W1Rows,
+                                         std::vector<float> b1,
+                                         std::vector<float> W2,
+                                         float b2)
+    : inputSize_(inputSize), hiddenSize_(hiddenSize), stride_(simdPadded(inputSize)),
+      W1_(std::move(W1Rows)), b1_(std::move(b1)), W2_(std::move(W2)), b2_(b2) {
+    buildInt8();
+}
 
+void NeuralValueFunction::buildInt8() {
+    // Int8 copy, one scale per hidden unit (a quarter of the float size)
+    W1q_.assign(static_cast<size_t>(hiddenSize_) * stride_, 0);
+    W1scale_.resize(hiddenSize_);
     for (int j = 0; j < hiddenSize_; ++j) {
-        float sum = b1_[j];
-        for (int i = 0; i < inSize; ++i) {
-            sum += features[i] * W1_[i][j];
-        }
-        hidden[j] = std::max(0.0f, sum);  // ReLU
+        size_t row = static_cast<size_t>(j) * stride_;
+        W1scale_[j] = quantizeSymmetric(&W1_[row], inputSize_, &W1q_[row]);
     }
+}
+
+float NeuralValueFunction::evaluate(const float* features, int numFeatures) const {
+    BB_PROFILE_NAMED_SCOPE(profile, prof::VALUE_EVAL);
+    BB_PROFILE_UNITS(profile, 1);
+    return evaluateWith(features, numFeatures, int8_);
+}
 
-    // Output: tanh(hidden @ W2 + b2)
+float NeuralValueFunction::evaluateWith(const float* features, int numFeatures, bool useInt8) const {
+    // out = tanh(ReLU(features @ W1 + b1) @ W2 + b2), one hidden unit at a
+    // time: each is a dot product against its contiguous W1 row and is folded
+    // into the output straight away, so no hidden-layer buffer is needed.
+    int inSize = std::min(numFeatures, inputSize_);
     float out = b2_;
+    if (useInt8) {
+        thread_local std::vector<int8_t> xq;
+        xq.resize(inSize);
+        float xScale = quantizeSymmetric(features, inSize, xq.data());
+        for (int j = 0; j < hiddenSize_; ++j) {
+            int32_t acc = dotInt8(&W1q_[static_cast<size_t>(j) * stride_], xq.data(), inSize);
+            float h = b1_[j] + static_cast<float>(acc) * xScale * W1scale_[j];
+            out += std::max(0.0f, h) * W2_[j];  // ReLU
+        }
+        return std::tanh(out);
+    }
     for (int j = 0; j < hiddenSize_; ++j) {
-        out += hidden[j] * W2_[j];
+        float h = b1_[j] + dotProduct(&W1_[static_cast<size_t>(j) * stride_], features, inSize);
+        out += std::max(0.0f, h) * W2_[j];  // ReLU
     }
     return std::tanh(out);
 }
 
+QuantizationError NeuralValueFunction::quantizationError(const float* features, int count,
+                                                         int numFeatures) const {
+    QuantizationError err;
+    for (int b = 0; b < count; ++b) {
+        const float* row = features + static_cast<size_t>(b) * numFeatures;
+        err.add(evaluateWith(row, numFeatures, false), evaluateWith(row, numFeatures, true));
+    }
+    return err;
+}
+
+void NeuralValueFunction::evaluateBatch(const float* features, int batch, int numFeatures,
+                                        float* out) const {
+    if (int8_) {
+        ValueFunction::evaluateBatch(features, batch, numFeatures, out);  // profiled per row
+        return;
+    }
+    BB_PROFILE_NAMED_SCOPE(profile, prof::VALUE_EVAL);
+    BB_PROFILE_UNITS(profile, batch);
+    // Hidden unit outermost: each W1 row is fetched once per batch rather
+    // than once per state, which is what keeps large hidden layers cheap.
+    int inSize = std::min(numFeatures, inputSize_);
+    for (int b = 0; b < batch; ++b) out[b] = b2_;
+    for (int j = 0; j < hiddenSize_; ++j) {
+        const float* w = &W1_[static_cast<size_t>(j) * stride_];
+        for (int b = 0; b < batch; ++b) {
+            float h = b1_[j] + dotProduct(w, features + static_cast<size_t>(b) * numFeatures, inSize);
+            out[b] += std::max(0.0f, h) * W2_[j];
+        }
+    }
+    for (int b = 0; b < batch; ++b) out[b] = std::tanh(out[b]);
+}
+
 // --- JSON Loading ---
 
 namespace {
@@ -97,7 +205,7 @@ std::unique_ptr<ValueFunction> parseNeuralWeights(const nlohmann::json& j,
     }
 
     return std::make_unique<NeuralValueFunction>(inputSize, hiddenSize,
-                                                  std::move(W1), std::move(b1),
+                                                  W1, std::move(b1),
                                                   std::move(W2), b2);
 }
 
@@ -124,6 +232,16 @@ std::unique_ptr<ValueFunction> parseJson(const nlohmann::json& j) {
         if (type == "neural") {
             return parseNeuralWeights(j);
         }
+
+        // Any number of hidden layers
+        if (type == "mlp") {
+            return std::make_unique<MlpValueFunction>(
+                mlpFromJson(j["layers"], j.value("residual", false)));
+        }
+        if (type == "alphazero_mlp" && j.contains("value_layers")) {
+            return std::make_unique<MlpValueFunction>(
+                mlpFromJson(j["value_layers"], j.value("value_residual", false)));
+        }
     }
 
     // Linear model: plain array of floats
@@ -139,18 +257,29 @@ std::unique_ptr<ValueFunction> parseJson(const nlohmann::json& j) {
     return nullptr;
 }
 
+std::unique_ptr<ValueFunction> withInt8(std::unique_ptr<ValueFunction> vf, bool int8) {
+    if (auto* neural = dynamic_cast<NeuralValueFunction*>(vf.get())) neural->setInt8(int8);
+    return vf;
+}
+
 } // anonymous namespace
 
-std::unique_ptr<ValueFunction> loadValueFunction(const std::string& path) {
+std::unique_ptr<ValueFunction> loadValueFunction(const std::string& path, bool int8) {
+    if (isWeightsFile(path)) return loadValueFunctionBinary(path, int8);
+    if (isConvNetFile(path)) {
+        auto net = loadConvNet(path);
+        if (!net) return nullptr;
+        return std::make_unique<ConvValueFunction>(std::move(net));
+    }
     std::ifstream file(path);
     if (!file.is_open()) return nullptr;
     nlohmann::json j = nlohmann::json::parse(file);
-    return parseJson(j);
+    return withInt8(parseJson(j), int8);
 }
 
-std::unique_ptr<ValueFunction> loadValueFunctionFromString(const std::string& json) {
+std::unique_ptr<ValueFunction> loadValueFunctionFromString(const std::string& json, bool int8) {
     auto j = nlohmann::json::parse(json);
-    return parseJson(j);
+    return withInt8(parseJson(j), int8);
 }
 
 } // namespace bb
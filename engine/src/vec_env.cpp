@@ -0,0 +1,164 @@
+#include "bb/vec_env.h"
+#include "bb/action_features.h"
+#include "bb/board_planes.h"
+#include "bb/feature_extractor.h"
+#include "bb/game_simulator.h"
+#include "bb/kickoff_handler.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace bb {
+
+namespace {
+
+// Same fixed opening as simulateGame(); see the comment there.
+constexpr TeamSide OPENING_KICKING_TEAM = TeamSide::AWAY;
+
+void kickOff(GameState& state, DiceRollerBase& dice, bool useFullKickoff) {
+    if (useFullKickoff) {
+        resolveKickoff(state, dice, nullptr);
+    } else {
+        simpleKickoff(state, dice);
+    }
+}
+
+int scoreDifference(const GameState& state, TeamSide side) {
+    return state.getTeamState(side).score - state.getTeamState(opponent(side)).score;
+}
+
+} // anonymous namespace
+
+VecEnv::VecEnv(const TeamRoster& home, const TeamRoster& away, int numEnvs, VecEnvConfig config)
+    : home_(home), away_(away), config_(config), pool_(std::max(0, config.threads)) {
+    if (numEnvs <= 0) throw std::invalid_argument("VecEnv: numEnvs must be positive");
+    if (config_.maxActions <= 0) throw std::invalid_argument("VecEnv: maxActions must be positive");
+    envs_.resize(numEnvs);
+}
+
+void VecEnv::advance(Env& env) const {
+    GameState& state = env.state;
+    env.actions.clear();
+    for (;;) {
+        if (state.phase == GamePhase::GAME_OVER || env.gameActions >= config_.maxGameActions) {
+            env.done = true;
+            return;
+        }
+        if (state.phase == GamePhase::TOUCHDOWN) {
+            // The scoring team kicks off next
+            state.kickingTeam = state.getPlayer(state.ball.carrierId).teamSide;
+            setupDrive(state, home_, away_, state.kickingTeam);
+            kickOff(state, env.dice, config_.useFullKickoff);
+            continue;
+        }
+        if (state.phase == GamePhase::HALF_TIME) {
+            state.half = 2;
+            state.kickingTeam = opponent(OPENING_KICKING_TEAM);
+            setupHalf(state, home_, away_, state.kickingTeam);
+            kickOff(state, env.dice, config_.useFullKickoff);
+            continue;
+        }
+        if (config_.paths) {
+            getAvailableActionsWithPaths(state, env.actions);
+        } else {
+            getAvailableActions(state, env.actions);
+        }
+        if (!env.actions.empty()) break;
+        // No actions available: force end turn
+        Action endTurn;
+        endTurn.type = ActionType::END_TURN;
+        executeAction(state, endTurn, env.dice, nullptr);
+        env.gameActions++;
+    }
+    if (env.actions.size() > static_cast<size_t>(config_.maxActions)) {
+        env.actions.resize(config_.maxActions);
+    }
+}
+
+void VecEnv::reset(const uint64_t* seeds, const uint8_t* which) {
+    auto fn = [&](int i, int) {
+        if (which && !which[i]) return;
+        Env& env = envs_[i];
+        env.state = GameState{};
+        env.dice = FastDiceRoller(seeds[i]);
+        env.gameActions = 0;
+        env.done = false;
+        env.state.half = 1;
+        env.state.kickingTeam = OPENING_KICKING_TEAM;
+        setupHalf(env.state, home_, away_, env.state.kickingTeam);
+        kickOff(env.state, env.dice, config_.useFullKickoff);
+        advance(env);
+    };
+    pool_.run(numEnvs(), fn);
+}
+
+void VecEnv::legalActions(int16_t* actions, uint8_t* mask, float* features) const {
+    const int slots = config_.maxActions;
+    auto fn = [&](int i, int) {
+        const Env& env = envs_[i];
+        int16_t* a = actions + static_cast<size_t>(i) * slots * ACTION_COLUMNS;
+        uint8_t* m = mask + static_cast<size_t>(i) * slots;
+        float* f = features ? features + static_cast<size_t>(i) * slots * NUM_ACTION_FEATURES : nullptr;
+        const int n = static_cast<int>(env.actions.size());
+        for (int k = 0; k < n; ++k) {
+            const Action& act = env.actions[k];
+            int16_t* row = a + k * ACTION_COLUMNS;
+            row[0] = static_cast<int16_t>(act.type);
+            row[1] = static_cast<int16_t>(act.playerId);
+            row[2] = static_cast<int16_t>(act.targetId);
+            row[3] = static_cast<int16_t>(act.target.x);
+            row[4] = static_cast<int16_t>(act.target.y);
+        }
+        if (f) extractActionFeatures(env.state, env.actions.data(), n, f);
+        std::fill(a + n * ACTION_COLUMNS, a + slots * ACTION_COLUMNS, int16_t{-1});
+        std::fill(m, m + n, uint8_t{1});
+        std::fill(m + n, m + slots, uint8_t{0});
+        if (f) std::fill(f + n * NUM_ACTION_FEATURES, f + slots * NUM_ACTION_FEATURES, 0.0f);
+    };
+    pool_.run(numEnvs(), fn);
+}
+
+void VecEnv::step(const int32_t* choices, float* rewards, uint8_t* done) {
+    for (int i = 0; i < numEnvs(); ++i) {
+        const Env& env = envs_[i];
+        if (!env.done && (choices[i] < 0 || choices[i] >= static_cast<int32_t>(env.actions.size()))) {
+            throw std::out_of_range("VecEnv: choice " + std::to_string(choices[i]) +
+                                    " is not a legal slot of game " + std::to_string(i));
+        }
+    }
+    auto fn = [&](int i, int) {
+        Env& env = envs_[i];
+        rewards[i] = 0.0f;
+        if (!env.done) {
+            TeamSide actor = env.state.activeTeam;
+            int before = scoreDifference(env.state, actor);
+            executeAction(env.state, env.actions[choices[i]], env.dice, nullptr);
+            env.gameActions++;
+            advance(env);
+            rewards[i] = static_cast<float>(scoreDifference(env.state, actor) - before);
+        }
+        done[i] = env.done ? 1 : 0;
+    };
+    pool_.run(numEnvs(), fn);
+}
+
+void VecEnv::observe(float* features, uint8_t* activeTeams) const {
+    auto fn = [&](int i, int) {
+        const GameState& s = envs_[i].state;
+        extractFeatures(s, s.activeTeam, features + static_cast<size_t>(i) * NUM_FEATURES);
+        if (activeTeams) activeTeams[i] = static_cast<uint8_t>(s.activeTeam);
+    };
+    pool_.run(numEnvs(), fn);
+}
+
+void VecEnv::observePlanes(uint8_t* planes, uint8_t* activeTeams) const {
+    constexpr size_t stride = static_cast<size_t>(NUM_BOARD_PLANES) * BOARD_PLANE_SIZE;
+    auto fn = [&](int i, int) {
+        const GameState& s = envs_[i].state;
+        extractBoardPlanes(s, s.activeTeam, planes + i * stride);
+        if (activeTeams) activeTeams[i] = static_cast<uint8_t>(s.activeTeam);
+    };
+    pool_.run(numEnvs(), fn);
+}
+
+} // namespace bb
@@ -0,0 +1,310 @@
+#include "bb/weights_file.h"
+#include "bb/mapped_file.h"
+#include "bb/mlp.h"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace bb {
+
+// Reads and builds networks from their internals (friend of each class).
+struct WeightsFileAccess {
+    static bool describe(const ValueFunction& vf, WeightsSection& s,
+                         std::vector<std::vector<float>>& arrays) {
+        if (auto* lin = dynamic_cast<const LinearValueFunction*>(&vf)) {
+            s.kind = WeightsSectionKind::VALUE_LINEAR;
+            s.inputSize = static_cast<int32_t>(lin->weights_.size());
+            arrays = {lin->weights_};
+            return true;
+        }
+        if (auto* mlp = dynamic_cast<const MlpValueFunction*>(&vf)) {
+            describe(*mlp->net(), WeightsSectionKind::VALUE_MLP, s, arrays);
+            return true;
+        }
+        if (auto* nn = dynamic_cast<const NeuralValueFunction*>(&vf)) {
+            s.kind = WeightsSectionKind::VALUE_NEURAL;
+            s.inputSize = nn->inputSize_;
+            s.hiddenSize = nn->hiddenSize_;
+            s.scalar = nn->b2_;
+            size_t rows = static_cast<size_t>(nn->hiddenSize_) * nn->stride_;
+            arrays = {std::vector<float>(nn->W1_.get(), nn->W1_.get() + rows), nn->b1_, nn->W2_};
+            return true;
+        }
+        return false;
+    }
+
+    static void describe(const PolicyNetwork& p, WeightsSection& s,
+                         std::vector<std::vector<float>>& arrays) {
+        s.temperature = p.temperature_;
+        if (p.mlp_) {
+            describe(*p.mlp_, WeightsSectionKind::POLICY_MLP, s, arrays);
+        } else if (p.neural_) {
+            s.kind = WeightsSectionKind::POLICY_NEURAL;
+            s.inputSize = POLICY_INPUT_SIZE;
+            s.hiddenSize = p.hiddenSize_;
+            s.scalar = p.b2_;
+            size_t n = static_cast<size_t>(POLICY_INPUT_SIZE) * p.hiddenSize_;
+            arrays = {std::vector<float>(p.W1_.get(), p.W1_.get() + n), p.b1_, p.W2_};
+        } else {
+            s.kind = WeightsSectionKind::POLICY_LINEAR;
+            s.inputSize = static_cast<int32_t>(p.weights_.size());
+            s.scalar = p.bias_;
+            arrays = {p.weights_};
+        }
+    }
+
+    static void describe(const Mlp& net, WeightsSectionKind kind, WeightsSection& s,
+                         std::vector<std::vector<float>>& arrays) {
+        s.kind = kind;
+        s.inputSize = net.inputSize();
+        s.hiddenSize = net.numLayers();
+        s.reserved = net.residual() ? 1 : 0;
+        arrays.assign(3, {});
+        for (int l = 0; l < net.numLayers(); ++l) {
+            const MlpLayer& layer = net.layer(l);
+            arrays[0].push_back(static_cast<float>(layer.outputs));
+            arrays[1].insert(arrays[1].end(), layer.weights.begin(), layer.weights.end());
+            arrays[2].insert(arrays[2].end(), layer.bias.begin(), layer.bias.end());
+        }
+    }
+};
+
+namespace {
+
+int arrayCount(const WeightsSection& s) {
+    return (s.kind == WeightsSectionKind::VALUE_LINEAR ||
+            s.kind == WeightsSectionKind::POLICY_LINEAR) ? 1 : 3;
+}
+
+// Float count of each array in a section, or false for bad shapes.
+bool arrayLengths(const WeightsSection& s, size_t lengths[3]) {
+    if (s.inputSize <= 0 || s.hiddenSize < 0) return false;
+    size_t in = static_cast<size_t>(s.inputSize);
+    size_t h = static_cast<size_t>(s.hiddenSize);
+    switch (s.kind) {
+        case WeightsSectionKind::VALUE_LINEAR:
+        case WeightsSectionKind::POLICY_LINEAR:
+            lengths[0] = in;
+            return true;
+        case WeightsSectionKind::VALUE_NEURAL:
+            lengths[0] = h * static_cast<size_t>(simdPadded(s.inputSize));
+            break;
+        case WeightsSectionKind::POLICY_NEURAL:
+            if (s.inputSize != POLICY_INPUT_SIZE) return false;
+            lengths[0] = in * h;
+            break;
+        case WeightsSectionKind::VALUE_MLP:
+        case WeightsSectionKind::POLICY_MLP:
+            // The other two follow from the widths (mlpLengths)
+            lengths[0] = h;
+            lengths[1] = lengths[2] = 0;
+            return h > 0 && s.hiddenSize <= 1024;
+        default:
+            return false;
+    }
+    lengths[1] = lengths[2] = h;
+    return h > 0;
+}
+
+bool isMlp(WeightsSectionKind k) {
+    return k == WeightsSectionKind::VALUE_MLP || k == WeightsSectionKind::POLICY_MLP;
+}
+
+// Weight and bias counts of an MLP section, from its widths array.
+bool mlpLengths(const MappedFile& file, const WeightsSection& s, size_t lengths[3]) {
+    uint64_t off = s.offsets[0];
+    if (off % WEIGHTS_FILE_ALIGN != 0 || off > file.size() ||
+        lengths[0] > (file.size() - off) / sizeof(float)) return false;
+    const float* widths = reinterpret_cast<const float*>(file.bytes() + off);
+    size_t in = static_cast<size_t>(s.inputSize);
+    for (size_t l = 0; l < lengths[0]; ++l) {
+        float w = widths[l];
+        if (!(w >= 1.0f && w <= 65536.0f) || w != std::floor(w)) return false;
+        size_t out = static_cast<size_t>(w);
+        lengths[1] += in * out;
+        lengths[2] += out;
+        in = out;
+    }
+    return true;
+}
+
+// Rebuild the Mlp a section describes.
+std::shared_ptr<const Mlp> buildMlp(const WeightsSection& s, const float* const arrays[3]) {
+    std::vector<MlpLayer> layers(static_cast<size_t>(s.hiddenSize));
+    int in = s.inputSize;
+    const float* w = arrays[1];
+    const float* b = arrays[2];
+    for (size_t i = 0; i < layers.size(); ++i) {
+        MlpLayer& l = layers[i];
+        l.inputs = in;
+        l.outputs = static_cast<int>(arrays[0][i]);
+        size_t n = static_cast<size_t>(l.inputs) * l.outputs;
+        l.weights.assign(w, w + n);
+        l.bias.assign(b, b + l.outputs);
+        w += n;
+        b += l.outputs;
+        in = l.outputs;
+    }
+    return std::make_shared<const Mlp>(std::move(layers), s.reserved == 1);
+}
+
+struct SectionView {
+    WeightsSection section;
+    const float* arrays[3] = {};
+    size_t lengths[3] = {};
+};
+
+// Map `path` and find its first section whose kind satisfies `wanted`.
+template<typename Pred>
+std::shared_ptr<const MappedFile> findSection(const std::string& path, Pred wanted,
+                                              SectionView& view) {
+    auto file = std::make_shared<const MappedFile>(path);
+    if (!file->ok() || file->size() < sizeof(WeightsFileHeader)) return nullptr;
+
+    WeightsFileHeader header;
+    std::memcpy(&header, file->bytes(), sizeof(header));
+    if (header.magic != WEIGHTS_FILE_MAGIC || header.version != WEIGHTS_FILE_VERSION) return nullptr;
+    size_t tableEnd = sizeof(header) + static_cast<size_t>(header.numSections) * sizeof(WeightsSection);
+    if (tableEnd > file->size()) return nullptr;
+
+    for (uint32_t i = 0; i < header.numSections; ++i) {
+        WeightsSection s;
+        std::memcpy(&s, file->bytes() + sizeof(header) + i * sizeof(WeightsSection), sizeof(s));
+        if (!wanted(s.kind)) continue;
+        if (!arrayLengths(s, view.lengths)) return nullptr;
+        if (isMlp(s.kind) && !mlpLengths(*file, s, view.lengths)) return nullptr;
+        for (int a = 0; a < arrayCount(s); ++a) {
+            uint64_t off = s.offsets[a];
+            if (off % WEIGHTS_FILE_ALIGN != 0 || off > file->size() ||
+                view.lengths[a] > (file->size() - off) / sizeof(float)) return nullptr;
+            view.arrays[a] = reinterpret_cast<const float*>(file->bytes() + off);
+        }
+        view.section = s;
+        return file;
+    }
+    return nullptr;
+}
+
+std::vector<float> copyArray(const SectionView& view, int a) {
+    return std::vector<float>(view.arrays[a], view.arrays[a] + view.lengths[a]);
+}
+
+uint64_t alignUp(uint64_t n) {
+    return (n + WEIGHTS_FILE_ALIGN - 1) / WEIGHTS_FILE_ALIGN * WEIGHTS_FILE_ALIGN;
+}
+
+} // anonymous namespace
+
+bool isWeightsFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    uint32_t magic = 0;
+    if (!file.read(reinterpret_cast<char*>(&magic), sizeof(magic))) return false;
+    return magic == WEIGHTS_FILE_MAGIC;
+}
+
+std::unique_ptr<ValueFunction> loadValueFunctionBinary(const std::string& path, bool int8) {
+    SectionView view;
+    auto file = findSection(path, [](WeightsSectionKind k) {
+        return k == WeightsSectionKind::VALUE_LINEAR || k == WeightsSectionKind::VALUE_NEURAL ||
+               k == WeightsSectionKind::VALUE_MLP;
+    }, view);
+    if (!file) return nullptr;
+
+    const WeightsSection& s = view.section;
+    if (s.kind == WeightsSectionKind::VALUE_MLP) {
+        auto net = buildMlp(s, view.arrays);
+        if (net->outputSize() != 1) return nullptr;
+        return std::make_unique<MlpValueFunction>(std::move(net));
+    }
+    if (s.kind == WeightsSectionKind::VALUE_LINEAR) {
+        return std::make_unique<LinearValueFunction>(copyArray(view, 0));
+    }
+    auto nn = std::make_unique<NeuralValueFunction>(
+        s.inputSize, s.hiddenSize, std::shared_ptr<const float[]>(file, view.arrays[0]),
+        copyArray(view, 1), copyArray(view, 2), s.scalar);
+    nn->setInt8(int8);
+    return nn;
+}
+
+std::unique_ptr<PolicyNetwork> loadPolicyNetworkBinary(const std::string& path, bool int8) {
+    SectionView view;
+    auto file = findSection(path, [](WeightsSectionKind k) {
+        return k == WeightsSectionKind::POLICY_LINEAR || k == WeightsSectionKind::POLICY_NEURAL ||
+               k == WeightsSectionKind::POLICY_MLP;
+    }, view);
+    if (!file) return nullptr;
+
+    const WeightsSection& s = view.section;
+    if (s.kind == WeightsSectionKind::POLICY_MLP) {
+        auto net = buildMlp(s, view.arrays);
+        if (net->inputSize() != POLICY_INPUT_SIZE || net->outputSize() != 1) return nullptr;
+        return std::make_unique<PolicyNetwork>(std::move(net), s.temperature);
+    }
+    if (s.kind == WeightsSectionKind::POLICY_LINEAR) {
+        return std::make_unique<PolicyNetwork>(copyArray(view, 0), s.scalar, s.temperature);
+    }
+    auto policy = std::make_unique<PolicyNetwork>(
+        std::shared_ptr<const float[]>(file, view.arrays[0]),
+        copyArray(view, 1), copyArray(view, 2), s.scalar, s.hiddenSize, s.temperature);
+    policy->setInt8(int8);
+    return policy;
+}
+
+bool writeWeightsFile(const std::string& path, const ValueFunction* valueFn,
+                      const PolicyNetwork* policy) {
+    std::vector<WeightsSection> sections;
+    std::vector<std::vector<std::vector<float>>> arrays;
+    if (valueFn) {
+        WeightsSection s;
+        std::vector<std::vector<float>> a;
+        if (!WeightsFileAccess::describe(*valueFn, s, a)) return false;
+        sections.push_back(s);
+        arrays.push_back(std::move(a));
+    }
+    if (policy) {
+        WeightsSection s;
+        std::vector<std::vector<float>> a;
+        WeightsFileAccess::describe(*policy, s, a);
+        sections.push_back(s);
+        arrays.push_back(std::move(a));
+    }
+    if (sections.empty()) return false;
+
+    // Lay out every array on an aligned offset after the section table.
+    uint64_t cursor = sizeof(WeightsFileHeader) + sections.size() * sizeof(WeightsSection);
+    for (size_t i = 0; i < sections.size(); ++i) {
+        for (size_t a = 0; a < arrays[i].size(); ++a) {
+            cursor = alignUp(cursor);
+            sections[i].offsets[a] = cursor;
+            cursor += arrays[i][a].size() * sizeof(float);
+        }
+    }
+
+    std::vector<char> buffer(cursor, 0);
+    WeightsFileHeader header;
+    header.numSections = static_cast<uint32_t>(sections.size());
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    std::memcpy(buffer.data() + sizeof(header), sections.data(),
+                sections.size() * sizeof(WeightsSection));
+    for (size_t i = 0; i < sections.size(); ++i) {
+        for (size_t a = 0; a < arrays[i].size(); ++a) {
+            std::memcpy(buffer.data() + sections[i].offsets[a], arrays[i][a].data(),
+                        arrays[i][a].size() * sizeof(float));
+        }
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return static_cast<bool>(out);
+}
+
+bool convertWeightsJson(const std::string& jsonPath, const std::string& binPath) {
+    auto valueFn = loadValueFunction(jsonPath);
+    auto policy = loadPolicyNetworkFromFile(jsonPath);
+    if (!valueFn && !policy) return false;
+    return writeWeightsFile(binPath, valueFn.get(), policy.get());
+}
+
+} // namespace bb
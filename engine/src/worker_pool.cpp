@@ -0,0 +1,100 @@
+#include "bb/worker_pool.h"
+#include "bb/thread_placement.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace bb {
+
+namespace {
+
+constexpr int SPIN_ROUNDS = 4096;  // polls before a helper goes to sleep
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+} // anonymous namespace
+
+WorkerPool::WorkerPool(int helpers) {
+    // Searches are built on their game's thread, so this is the game's node
+    int node = threadAffinity() != AffinityMode::NONE ? currentNode(CpuTopology::system()) : -1;
+    threads_.reserve(std::max(0, helpers));
+    for (int i = 0; i < helpers; ++i) threads_.emplace_back(&WorkerPool::helperLoop, this, i + 1, node);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+    wake_.notify_all();
+    for (auto& t : threads_) t.join();
+}
+
+void WorkerPool::work(const Task& fn, int tasks, int worker) {
+    int done = 0;
+    for (int t; (t = next_.fetch_add(1, std::memory_order_relaxed)) < tasks; ++done) fn(t, worker);
+    if (done == 0) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    unfinished_ -= done;
+    if (unfinished_ == 0) done_.notify_all();
+}
+
+void WorkerPool::run(int tasks, const Task& fn) {
+    if (tasks <= 0) return;
+    if (threads_.empty() || tasks == 1) {
+        for (int t = 0; t < tasks; ++t) fn(t, 0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fn_ = &fn;
+        tasks_ = tasks;
+        unfinished_ = tasks;
+        next_.store(0, std::memory_order_relaxed);
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+    wake_.notify_all();
+    work(fn, tasks, 0);
+    // Wait for the last tasks, and for every helper to leave the batch
+    // before fn (a caller's temporary) can go out of scope
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&] { return unfinished_ == 0 && active_ == 0; });
+    fn_ = nullptr;
+}
+
+void WorkerPool::helperLoop(int worker, int node) {
+    if (node >= 0) pinToNode(node, CpuTopology::system());
+    uint64_t seen = 0;
+    for (;;) {
+        for (int i = 0; i < SPIN_ROUNDS && generation_.load(std::memory_order_acquire) == seen; ++i) {
+            cpuRelax();
+        }
+        const Task* fn;
+        int tasks;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return generation_.load(std::memory_order_relaxed) != seen; });
+            seen = generation_.load(std::memory_order_relaxed);
+            if (stop_) return;
+            if (!fn_) continue;  // that batch is already over
+            fn = fn_;
+            tasks = tasks_;
+            active_++;
+        }
+        work(*fn, tasks, worker);
+        std::lock_guard<std::mutex> lock(mutex_);
+        active_--;
+        if (active_ == 0 && unfinished_ == 0) done_.notify_all();
+    }
+}
+
+} // namespace bb
@@ -4,7 +4,10 @@
 #include "bb/game_simulator.h"
 #include "bb/roster.h"
 #include "bb/helpers.h"
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <vector>
 
 using namespace bb;
 
@@ -25,7 +28,7 @@ GameState makeSimpleState() {
     p1.teamSide = TeamSide::HOME;
     p1.state = PlayerState::STANDING;
     p1.position = {10, 7};
-    p1.stats = {6, 3, 3, 8};
+    p1.setStats({6, 3, 3, 8});
     p1.movementRemaining = 6;
     p1.hasMoved = false;
     p1.hasActed = false;
@@ -36,7 +39,7 @@ GameState makeSimpleState() {
     p2.teamSide = TeamSide::AWAY;
     p2.state = PlayerState::STANDING;
     p2.position = {11, 7};
-    p2.stats = {6, 3, 3, 8};
+    p2.setStats({6, 3, 3, 8});
     p2.movementRemaining = 6;
 
     state.ball = BallState::onGround({13, 7});
@@ -81,9 +84,9 @@ TEST(ActionFeatures, BlockAction2Dice) {
     GameState state = makeSimpleState();
 
     // ST4 home player vs ST3 away player = 2 dice attacker
-    state.getPlayer(1).stats.strength = 4;
+    state.getPlayer(1).setStrength(4);
     state.getPlayer(1).position = {10, 7};
-    state.getPlayer(12).stats.strength = 3;
+    state.getPlayer(12).setStrength(3);
     state.getPlayer(12).position = {11, 7};
 
     Action action;
@@ -103,8 +106,8 @@ TEST(ActionFeatures, BlockAction1Die) {
     GameState state = makeSimpleState();
 
     // ST3 vs ST3 = 1 die
-    state.getPlayer(1).stats.strength = 3;
-    state.getPlayer(12).stats.strength = 3;
+    state.getPlayer(1).setStrength(3);
+    state.getPlayer(12).setStrength(3);
 
     Action action;
     action.type = ActionType::BLOCK;
@@ -200,9 +203,9 @@ TEST(ActionFeatures, BlitzWithHorns) {
     GameState state = makeSimpleState();
 
     // ST3 + Horns blitz vs ST3 = effectively ST4 vs ST3 = 2 dice
-    state.getPlayer(1).stats.strength = 3;
-    state.getPlayer(1).skills.add(SkillName::Horns);
-    state.getPlayer(12).stats.strength = 3;
+    state.getPlayer(1).setStrength(3);
+    state.getPlayer(1).addSkill(SkillName::Horns);
+    state.getPlayer(12).setStrength(3);
 
     Action action;
     action.type = ActionType::BLITZ;
@@ -216,3 +219,26 @@ TEST(ActionFeatures, BlitzWithHorns) {
     // ST3+1(Horns) vs ST3 = 2 dice attacker
     EXPECT_NEAR(feats[11], 2.0f / 3.0f, 0.01f);
 }
+
+TEST(ActionFeatures, BatchMatchesPerActionCalls) {
+    DiceRoller dice(11);
+    int checked = 0;
+    auto check = [&](const GameState& s) {
+        std::vector<Action> actions;
+        getAvailableActions(s, actions);
+        // Generation order, then with the players' actions interleaved
+        for (int pass = 0; pass < 2; ++pass) {
+            const int n = static_cast<int>(actions.size());
+            std::vector<float> batch(n * NUM_ACTION_FEATURES), single(n * NUM_ACTION_FEATURES);
+            extractActionFeatures(s, actions.data(), n, batch.data());
+            for (int i = 0; i < n; ++i) extractActionFeatures(s, actions[i], &single[i * NUM_ACTION_FEATURES]);
+            EXPECT_EQ(std::memcmp(batch.data(), single.data(), batch.size() * sizeof(float)), 0);
+            checked += n;
+            std::stable_sort(actions.begin(), actions.end(),
+                             [](const Action& a, const Action& b) { return a.targetId < b.targetId; });
+        }
+        return randomPolicy(s, dice);
+    };
+    simulateGame(getHumanRoster(), getOrcRoster(), check, check, dice);
+    EXPECT_GT(checked, 1000);
+}
@@ -10,8 +10,8 @@ static void placePlayer(GameState& gs, int id, Position pos, TeamSide side,
     Player& p = gs.getPlayer(id);
     p.state = PlayerState::STANDING;
     p.position = pos;
-    p.stats = {static_cast<int8_t>(ma), static_cast<int8_t>(st),
-               static_cast<int8_t>(ag), static_cast<int8_t>(av)};
+    p.setStats({static_cast<int8_t>(ma), static_cast<int8_t>(st),
+                static_cast<int8_t>(ag), static_cast<int8_t>(av)});
     p.movementRemaining = ma;
 }
 
@@ -264,3 +264,33 @@ TEST(ActionResolver, BlitzAdjacentBlock) {
     EXPECT_TRUE(result.success);
     EXPECT_TRUE(gs.homeTeam.blitzUsedThisTurn);
 }
+
+TEST(ActionResolver, MovePathWalksToTarget) {
+    GameState gs;
+    gs.phase = GamePhase::PLAY;
+    gs.activeTeam = TeamSide::HOME;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 2);
+
+    Action action{ActionType::MOVE_PATH, 1, -1, {13, 8}};
+    FixedDiceRoller dice({6});  // GFI on the third square
+    auto result = resolveAction(gs, action, dice, nullptr);
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(gs.getPlayer(1).position, (Position{13, 8}));
+    EXPECT_EQ(gs.getPlayer(1).movementRemaining, -1);
+    EXPECT_EQ(dice.remaining(), 0u);
+}
+
+TEST(ActionResolver, MovePathStopsAtFailedDodge) {
+    GameState gs;
+    gs.phase = GamePhase::PLAY;
+    gs.activeTeam = TeamSide::HOME;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
+    placePlayer(gs, 12, {11, 8}, TeamSide::AWAY);
+
+    Action action{ActionType::MOVE_PATH, 1, -1, {10, 3}};
+    FixedDiceRoller dice({1, 2, 2});  // dodge fails, armor holds
+    auto result = resolveAction(gs, action, dice, nullptr);
+    EXPECT_TRUE(result.turnover);
+    EXPECT_EQ(gs.getPlayer(1).position.distanceTo({10, 7}), 1);
+    EXPECT_EQ(gs.getPlayer(1).state, PlayerState::PRONE);
+}
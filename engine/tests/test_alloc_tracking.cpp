@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "bb/alloc_tracking.h"
+#include "bb/macro_mcts.h"
+#include "bb/game_state.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace bb;
+
+TEST(AllocTracking, CountersSubtract) {
+    AllocCounters a, b;
+    b.allocations = 5;
+    b.bytes = 80;
+    b.tagAllocations[alloc::MOVE_GEN] = 2;
+    AllocCounters d = b.since(a);
+    EXPECT_EQ(d.allocations, 5u);
+    EXPECT_EQ(d.bytes, 80u);
+    EXPECT_EQ(d.tagAllocations[alloc::MOVE_GEN], 2u);
+    EXPECT_STREQ(allocTagName(alloc::SEARCH_TREE), "searchTree");
+}
+
+#ifdef BB_ALLOC_TRACKING
+
+TEST(AllocTracking, CountsThisThreadsAllocationsByTag) {
+    AllocCounters start = threadAllocCounters();
+    {
+        BB_ALLOC_SCOPE(alloc::LOGGING);
+        auto p = std::make_unique<std::vector<int>>(1000);
+        EXPECT_GE(allocLiveBytes(), 4000);
+    }
+    AllocCounters d = threadAllocCounters().since(start);
+    EXPECT_EQ(d.tagAllocations[alloc::LOGGING], 2u);  // the vector and its buffer
+    EXPECT_GE(d.tagBytes[alloc::LOGGING], 4000u);
+    EXPECT_EQ(d.frees, 2u);
+    EXPECT_GE(allocPeakBytes(), allocLiveBytes());
+    EXPECT_TRUE(allocTrackingEnabled());
+    EXPECT_NE(allocReport().find("logging"), std::string::npos);
+}
+
+TEST(AllocTracking, KeepsCountsOfExitedThreads) {
+    AllocCounters start = processAllocCounters();
+    std::thread worker([] {
+        // Kept until after the loop: a new/delete pair with nothing in
+        // between may be elided by the optimizer
+        std::vector<int*> kept;
+        kept.reserve(10);
+        {
+            BB_ALLOC_SCOPE(alloc::BINDINGS);
+            for (int i = 0; i < 10; ++i) kept.push_back(new int(i));
+        }
+        for (int* p : kept) delete p;
+    });
+    worker.join();
+    AllocCounters d = processAllocCounters().since(start);
+    EXPECT_EQ(d.tagAllocations[alloc::BINDINGS], 10u);
+}
+
+TEST(AllocTracking, SearchReportsItsAllocations) {
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 32;
+    MacroMCTSSearch search(nullptr, config, 7);
+    GameState state;
+    setupHalf(state, getHumanRoster(), getHumanRoster());
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.half = 1;
+    state.homeTeam.turnNumber = 1;
+    state.ball = BallState::onGround({13, 7});
+    search.search(state);
+    ASSERT_GT(search.lastIterations(), 0);
+    const SearchStats& stats = search.lastStats();
+    EXPECT_GT(stats.allocations, 0u);
+    EXPECT_GE(stats.allocatedBytes, stats.allocations);
+    EXPECT_GT(stats.peakLiveBytes, 0);
+}
+
+#else
+
+TEST(AllocTracking, DisabledBuildReportsNothing) {
+    AllocCounters start = threadAllocCounters();
+    delete new int(1);
+    EXPECT_EQ(threadAllocCounters().since(start).allocations, 0u);
+    EXPECT_FALSE(allocTrackingEnabled());
+    EXPECT_EQ(allocPeakBytes(), 0);
+    EXPECT_NE(allocReport().find("disabled"), std::string::npos);
+}
+
+#endif
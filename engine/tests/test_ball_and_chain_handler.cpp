@@ -9,8 +9,8 @@ static void placePlayer(GameState& gs, int id, Position pos, TeamSide side,
     Player& p = gs.getPlayer(id);
     p.state = PlayerState::STANDING;
     p.position = pos;
-    p.stats = {static_cast<int8_t>(ma), static_cast<int8_t>(st),
-               static_cast<int8_t>(ag), static_cast<int8_t>(av)};
+    p.setStats({static_cast<int8_t>(ma), static_cast<int8_t>(st),
+                static_cast<int8_t>(ag), static_cast<int8_t>(av)});
     p.movementRemaining = ma;
 }
 
@@ -21,8 +21,8 @@ TEST(BallAndChainHandler, RandomMovement) {
     GameState gs;
     gs.phase = GamePhase::PLAY;
     placePlayer(gs, 1, {12, 7}, TeamSide::HOME, 4, 7, 1, 8);
-    gs.getPlayer(1).skills.add(SkillName::BallAndChain);
-    gs.getPlayer(1).skills.add(SkillName::NoHands);
+    gs.getPlayer(1).addSkill(SkillName::BallAndChain);
+    gs.getPlayer(1).addSkill(SkillName::NoHands);
 
     // MA=4, 4 moves. D8: 3,3,3,3 → each E(+1,0) → should end at (16,7)
     FixedDiceRoller dice({3, 3, 3, 3});
@@ -36,8 +36,8 @@ TEST(BallAndChainHandler, OffPitchKO) {
     GameState gs;
     gs.phase = GamePhase::PLAY;
     placePlayer(gs, 1, {24, 7}, TeamSide::HOME, 4, 7, 1, 8);
-    gs.getPlayer(1).skills.add(SkillName::BallAndChain);
-    gs.getPlayer(1).skills.add(SkillName::NoHands);
+    gs.getPlayer(1).addSkill(SkillName::BallAndChain);
+    gs.getPlayer(1).addSkill(SkillName::NoHands);
 
     // D8=3 → E(+1,0) → (25,7). D8=3 → E(+1,0) → (26,7) off pitch → KO
     FixedDiceRoller dice({3, 3});
@@ -50,8 +50,8 @@ TEST(BallAndChainHandler, AutoBlockOccupied) {
     GameState gs;
     gs.phase = GamePhase::PLAY;
     placePlayer(gs, 1, {12, 7}, TeamSide::HOME, 2, 7, 1, 8);
-    gs.getPlayer(1).skills.add(SkillName::BallAndChain);
-    gs.getPlayer(1).skills.add(SkillName::NoHands);
+    gs.getPlayer(1).addSkill(SkillName::BallAndChain);
+    gs.getPlayer(1).addSkill(SkillName::NoHands);
     placePlayer(gs, 12, {13, 7}, TeamSide::AWAY); // Standing enemy
 
     // MA=2. Step 1: D8=3 → E(+1,0) → (13,7) occupied → auto-block
@@ -67,10 +67,10 @@ TEST(BallAndChainHandler, BCDownStops) {
     GameState gs;
     gs.phase = GamePhase::PLAY;
     placePlayer(gs, 1, {12, 7}, TeamSide::HOME, 4, 3, 1, 8);
-    gs.getPlayer(1).skills.add(SkillName::BallAndChain);
-    gs.getPlayer(1).skills.add(SkillName::NoHands);
+    gs.getPlayer(1).addSkill(SkillName::BallAndChain);
+    gs.getPlayer(1).addSkill(SkillName::NoHands);
     placePlayer(gs, 12, {13, 7}, TeamSide::AWAY);
-    gs.getPlayer(12).skills.add(SkillName::Block);
+    gs.getPlayer(12).addSkill(SkillName::Block);
 
     // Step 1: D8=3 → E(+1,0) → (13,7) occupied + standing → auto-block
     // rollBlockDie: D6=1 → AD. B&C player down. Armor: 3+3=6
@@ -85,8 +85,8 @@ TEST(BallAndChainHandler, NoHandsBounce) {
     GameState gs;
     gs.phase = GamePhase::PLAY;
     placePlayer(gs, 1, {12, 7}, TeamSide::HOME, 2, 7, 1, 8);
-    gs.getPlayer(1).skills.add(SkillName::BallAndChain);
-    gs.getPlayer(1).skills.add(SkillName::NoHands);
+    gs.getPlayer(1).addSkill(SkillName::BallAndChain);
+    gs.getPlayer(1).addSkill(SkillName::NoHands);
     gs.ball = BallState::onGround({13, 7});
 
     // Step 1: D8=3 → E(+1,0) → (13,7) empty → move there. Ball on ground → bounce
@@ -103,8 +103,8 @@ TEST(BallAndChainHandler, NeverTurnover) {
     GameState gs;
     gs.phase = GamePhase::PLAY;
     placePlayer(gs, 1, {0, 7}, TeamSide::HOME, 2, 3, 1, 8);
-    gs.getPlayer(1).skills.add(SkillName::BallAndChain);
-    gs.getPlayer(1).skills.add(SkillName::NoHands);
+    gs.getPlayer(1).addSkill(SkillName::BallAndChain);
+    gs.getPlayer(1).addSkill(SkillName::NoHands);
     gs.ball = BallState::carried({0, 7}, 1);
 
     // D8=7 → W(-1,0) → (-1,7) off pitch → KO
@@ -9,8 +9,8 @@ static void placePlayer(GameState& gs, int id, Position pos, TeamSide side,
     Player& p = gs.getPlayer(id);
     p.state = PlayerState::STANDING;
     p.position = pos;
-    p.stats = {static_cast<int8_t>(ma), static_cast<int8_t>(st),
-               static_cast<int8_t>(ag), static_cast<int8_t>(av)};
+    p.setStats({static_cast<int8_t>(ma), static_cast<int8_t>(st),
+                static_cast<int8_t>(ag), static_cast<int8_t>(av)});
     p.movementRemaining = ma;
 }
 
@@ -41,7 +41,7 @@ TEST(BallHandler, PickupFail) {
 TEST(BallHandler, PickupSureHandsReroll) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::SureHands);
+    gs.getPlayer(1).addSkill(SkillName::SureHands);
     gs.ball = BallState::onGround({10, 7});
     // Roll 2 (fail), SureHands reroll: 4 (success)
     FixedDiceRoller dice({2, 4});
@@ -52,7 +52,7 @@ TEST(BallHandler, PickupSureHandsReroll) {
 TEST(BallHandler, PickupNoHands) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::NoHands);
+    gs.getPlayer(1).addSkill(SkillName::NoHands);
     gs.ball = BallState::onGround({10, 7});
     FixedDiceRoller dice({6}); // doesn't matter
     bool ok = resolvePickup(gs, 1, dice, nullptr);
@@ -190,3 +190,25 @@ TEST(BallHandler, ThrowInFinalBounceOntoPlayer) {
     EXPECT_TRUE(gs.ball.isHeld);
     EXPECT_EQ(gs.ball.carrierId, 1);
 }
+
+TEST(BallHandler, ExpectedModeBounceAndThrowIn) {
+    // ResolutionMode::Expected reads no dice: an empty script would throw
+    GameState gs;
+    placePlayer(gs, 1, {5, 5}, TeamSide::HOME);
+    placePlayer(gs, 2, {5, 4}, TeamSide::HOME);
+    FixedDiceRoller dice({});
+    dice.setResolutionMode(ResolutionMode::Expected);
+
+    // Off an occupied square: the first free square of the template (N is
+    // taken, NE is next), and nobody tries to catch it
+    resolveBounce(gs, {5, 5}, dice, 0, nullptr);
+    EXPECT_FALSE(gs.ball.isHeld);
+    EXPECT_EQ(gs.ball.position, (Position{6, 4}));
+    resolveBounce(gs, {12, 7}, dice, 0, nullptr);
+    EXPECT_EQ(gs.ball.position, (Position{12, 7}));
+
+    // Straight back in, seven squares
+    resolveThrowIn(gs, {10, 0}, {10, -1}, dice, nullptr);
+    EXPECT_EQ(gs.ball.position, (Position{10, 7}));
+    EXPECT_EQ(dice.remaining(), 0u);
+}
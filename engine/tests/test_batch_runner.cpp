@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "bb/batch_runner.h"
+#include "bb/roster.h"
+#include <set>
+#include <stdexcept>
+
+using namespace bb;
+
+TEST(BatchRunner, ParallelGamesMatchSerialPerSeed) {
+    GameConfig cfg;
+    cfg.homeAI = "greedy";
+    cfg.awayAI = "random";
+    std::vector<uint32_t> seeds = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    BatchResult serial = runGames(getHumanRoster(), getOrcRoster(), {cfg}, seeds, 1);
+    BatchResult parallel = runGames(getHumanRoster(), getOrcRoster(), {cfg}, seeds, 4);
+    ASSERT_EQ(parallel.games.size(), seeds.size());
+    for (size_t i = 0; i < seeds.size(); ++i) {
+        GameResult lone = playConfiguredGame(getHumanRoster(), getOrcRoster(), cfg, seeds[i]);
+        EXPECT_EQ(serial.games[i].homeScore, lone.homeScore);
+        EXPECT_EQ(parallel.games[i].homeScore, lone.homeScore);
+        EXPECT_EQ(parallel.games[i].awayScore, lone.awayScore);
+        EXPECT_EQ(parallel.games[i].totalActions, lone.totalActions);
+    }
+    EXPECT_EQ(parallel.homeWins + parallel.awayWins + parallel.draws, 8);
+    EXPECT_EQ(parallel.homeWins, serial.homeWins);
+    EXPECT_EQ(parallel.totalActions, serial.totalActions);
+}
+
+TEST(BatchRunner, PerGameConfigsAndSharedValueFunction) {
+    std::vector<float> weights(NUM_FEATURES, 0.0f);
+    weights[0] = 1.0f;
+    auto vf = std::make_shared<const LinearValueFunction>(weights);
+
+    GameConfig learning;
+    learning.homeAI = "learning";
+    learning.valueFn = vf;
+    learning.epsilon = 0.1f;
+    GameConfig random;
+    BatchResult batch = runGames(getHumanRoster(), getHumanRoster(),
+                                 {random, learning}, {11, 12}, 2);
+    ASSERT_EQ(batch.games.size(), 2u);
+    for (auto& g : batch.games) EXPECT_GT(g.totalActions, 0);
+    EXPECT_EQ(batch.games[1].totalActions,
+              playConfiguredGame(getHumanRoster(), getHumanRoster(), learning, 12).totalActions);
+}
+
+TEST(BatchRunner, ConfigCountMustMatchSeeds) {
+    GameConfig cfg;
+    EXPECT_THROW(runGames(getHumanRoster(), getHumanRoster(), {cfg, cfg}, {1, 2, 3}, 2),
+                 std::invalid_argument);
+    EXPECT_TRUE(runGames(getHumanRoster(), getHumanRoster(), {cfg}, {}, 2).games.empty());
+}
+
+TEST(BatchRunner, GameIterationBudgetIsSpreadOverDecisions) {
+    GameConfig cfg;
+    cfg.homeAI = "macro_mcts";
+    cfg.awayAI = "greedy";
+    cfg.mctsIterations = 64;
+    cfg.gameIterations = 1500;
+    GameResult a = playConfiguredGame(getHumanRoster(), getOrcRoster(), cfg, 5);
+    GameResult b = playConfiguredGame(getHumanRoster(), getOrcRoster(), cfg, 5);
+    // Iteration budgets keep configured games reproducible
+    EXPECT_EQ(a.homeScore, b.homeScore);
+    EXPECT_EQ(a.awayScore, b.awayScore);
+    EXPECT_EQ(a.totalActions, b.totalActions);
+    EXPECT_GT(a.homePolicyMs, 0.0);
+}
+
+TEST(BatchRunner, PonderingSidePlaysAFullGame) {
+    PlayerConfig home;
+    home.ai = "macro_mcts";
+    home.mctsIterations = 32;
+    home.ponder = true;
+    PlayerConfig away;
+    away.ai = "greedy";
+    GameResult r = playConfiguredGame(getHumanRoster(), getOrcRoster(), home, away, 9);
+    EXPECT_GT(r.totalActions, 0);
+    EXPECT_GE(r.homeScore, 0);
+}
+
+TEST(BatchRunner, ContinuationsFromAPositionAreIndependentOfThreads) {
+    // A drive just kicked off: home receives
+    GameState state;
+    state.kickingTeam = TeamSide::AWAY;
+    setupHalf(state, getHumanRoster(), getOrcRoster());
+    DiceRoller kick(3);
+    simpleKickoff(state, kick);
+
+    PlayerConfig greedy;
+    greedy.ai = "greedy";
+    ContinuationResult serial = simulateFromState(state, getHumanRoster(), getOrcRoster(), greedy, greedy,
+                                                  24, 1, PlayUntil::DRIVE_END, 7);
+    ContinuationResult parallel = simulateFromState(state, getHumanRoster(), getOrcRoster(), greedy, greedy,
+                                                    24, 4, PlayUntil::DRIVE_END, 7);
+    ASSERT_EQ(serial.games.size(), 24u);
+    for (size_t i = 0; i < serial.games.size(); ++i) {
+        EXPECT_EQ(parallel.games[i].homeScore, serial.games[i].homeScore);
+        EXPECT_EQ(parallel.games[i].awayScore, serial.games[i].awayScore);
+        EXPECT_EQ(parallel.games[i].totalActions, serial.games[i].totalActions);
+        // A drive ends at its first touchdown
+        EXPECT_LE(serial.games[i].homeScore + serial.games[i].awayScore, 1);
+    }
+    EXPECT_EQ(parallel.homeScored, serial.homeScored);
+    EXPECT_EQ(serial.homeScored + serial.awayScored, serial.scoreDiff[1] + serial.scoreDiff[-1]);
+    EXPECT_LE(serial.scoreDiff.size(), 3u);
+    EXPECT_NEAR(serial.meanScoreDiff(), serial.homeTdProbability() - serial.awayTdProbability(), 1e-9);
+
+    // The streams differ: not every continuation plays out alike
+    std::set<int> lengths;
+    for (const GameResult& g : serial.games) lengths.insert(g.totalActions);
+    EXPECT_GT(lengths.size(), 1u);
+
+    // To the end of the game: the same streams play the same drive first
+    ContinuationResult games = simulateFromState(state, getHumanRoster(), getOrcRoster(), greedy, greedy,
+                                                 4, 2, PlayUntil::GAME_END, 7);
+    for (size_t i = 0; i < games.games.size(); ++i) {
+        EXPECT_GT(games.games[i].totalActions, serial.games[i].totalActions);
+        EXPECT_GE(games.games[i].homeScore, serial.games[i].homeScore);
+        EXPECT_GE(games.games[i].awayScore, serial.games[i].awayScore);
+    }
+}
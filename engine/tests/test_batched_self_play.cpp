@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "bb/batched_self_play.h"
+#include "bb/roster.h"
+#include <thread>
+
+using namespace bb;
+
+namespace {
+
+LinearValueFunction makeModel() {
+    std::vector<float> weights(NUM_FEATURES, 0.0f);
+    weights[0] = 1.0f;
+    weights[1] = 0.5f;
+    weights[5] = -0.25f;
+    return LinearValueFunction(weights);
+}
+
+} // namespace
+
+TEST(SharedEvalBatcher, PoolsConcurrentRequestsIntoOneModelCall) {
+    LinearValueFunction model = makeModel();
+    SharedEvalBatcher batcher(model, 1024, 1000000);  // only a full house fires
+    constexpr int CLIENTS = 4, ROWS = 3;
+    for (int t = 0; t < CLIENTS; ++t) batcher.attach();
+
+    std::vector<std::vector<float>> features(CLIENTS, std::vector<float>(ROWS * NUM_FEATURES));
+    std::vector<std::vector<float>> values(CLIENTS, std::vector<float>(ROWS));
+    for (int t = 0; t < CLIENTS; ++t) {
+        for (size_t f = 0; f < features[t].size(); ++f) features[t][f] = static_cast<float>((t + 1) * f % 7);
+    }
+    std::vector<std::thread> threads;
+    for (int t = 0; t < CLIENTS; ++t) {
+        threads.emplace_back([&, t] {
+            batcher.evaluateBatch(features[t].data(), ROWS, NUM_FEATURES, values[t].data());
+            batcher.detach();
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    for (int t = 0; t < CLIENTS; ++t) {
+        for (int r = 0; r < ROWS; ++r) {
+            EXPECT_FLOAT_EQ(values[t][r], model.evaluate(&features[t][r * NUM_FEATURES], NUM_FEATURES));
+        }
+    }
+    SharedEvalBatcher::Stats s = batcher.stats();
+    EXPECT_EQ(s.batches, 1u);
+    EXPECT_EQ(s.requests, 4u);
+    EXPECT_EQ(s.rows, 12u);
+
+    // Detached, a lone caller is served straight away
+    EXPECT_FLOAT_EQ(batcher.evaluate(features[0].data(), NUM_FEATURES),
+                    model.evaluate(features[0].data(), NUM_FEATURES));
+    EXPECT_EQ(batcher.stats().batches, 2u);
+}
+
+TEST(BatchedSelfPlay, ConcurrentGamesShareBatchesAndPlayAsAlone) {
+    LinearValueFunction model = makeModel();
+    BatchedSelfPlayConfig config;
+    config.search.timeBudgetMs = 0;
+    config.search.maxIterations = 24;
+    config.search.vfBlend = 0.5f;
+    config.search.evalBatchSize = 8;
+    config.logBoards = false;
+    config.logMode = GameLogMode::RECORD_ONLY;
+    config.maxWaitUs = 1000000;
+    std::vector<uint32_t> seeds = {3, 4, 5};
+
+    config.concurrentGames = 3;
+    BatchedSelfPlayResult pooled = runBatchedSelfPlay(getHumanRoster(), getOrcRoster(), model, config, seeds);
+    config.concurrentGames = 1;
+    BatchedSelfPlayResult alone = runBatchedSelfPlay(getHumanRoster(), getOrcRoster(), model, config, seeds);
+
+    ASSERT_EQ(pooled.games.size(), seeds.size());
+    for (size_t i = 0; i < seeds.size(); ++i) {
+        EXPECT_EQ(pooled.games[i].result.homeScore, alone.games[i].result.homeScore);
+        EXPECT_EQ(pooled.games[i].result.awayScore, alone.games[i].result.awayScore);
+        EXPECT_EQ(pooled.games[i].result.totalActions, alone.games[i].result.totalActions);
+        EXPECT_EQ(pooled.games[i].policyDecisions.size(), alone.games[i].policyDecisions.size());
+        EXPECT_FALSE(pooled.games[i].policyDecisions.empty());
+    }
+    // Same leaves, fewer and larger model calls
+    EXPECT_EQ(pooled.eval.rows, alone.eval.rows);
+    EXPECT_EQ(alone.eval.batches, alone.eval.requests);
+    EXPECT_LT(pooled.eval.batches, pooled.eval.requests);
+
+    config.concurrentGames = 0;
+    EXPECT_THROW(runBatchedSelfPlay(getHumanRoster(), getOrcRoster(), model, config, seeds),
+                 std::invalid_argument);
+}
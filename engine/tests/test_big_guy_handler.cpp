@@ -13,8 +13,8 @@ static void placePlayer(GameState& gs, int id, Position pos, TeamSide side,
     p.teamSide = side;
     p.state = PlayerState::STANDING;
     p.position = pos;
-    p.stats = {static_cast<int8_t>(ma), static_cast<int8_t>(st),
-               static_cast<int8_t>(ag), static_cast<int8_t>(av)};
+    p.setStats({static_cast<int8_t>(ma), static_cast<int8_t>(st),
+                static_cast<int8_t>(ag), static_cast<int8_t>(av)});
     p.movementRemaining = ma;
 }
 
@@ -34,7 +34,7 @@ static GameState makeGameState() {
 TEST(BigGuyHandler, BoneHeadPass) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::BoneHead);
+    gs.getPlayer(1).addSkill(SkillName::BoneHead);
 
     FixedDiceRoller dice({4});  // Pass on 2+
     auto result = resolveBigGuyCheck(gs, 1, ActionType::MOVE, dice, nullptr);
@@ -47,7 +47,7 @@ TEST(BigGuyHandler, BoneHeadPass) {
 TEST(BigGuyHandler, BoneHeadFail) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::BoneHead);
+    gs.getPlayer(1).addSkill(SkillName::BoneHead);
 
     FixedDiceRoller dice({1});  // Fail
     auto result = resolveBigGuyCheck(gs, 1, ActionType::MOVE, dice, nullptr);
@@ -64,7 +64,7 @@ TEST(BigGuyHandler, BoneHeadFail) {
 TEST(BigGuyHandler, ReallyStupidWithAlly) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::ReallyStupid);
+    gs.getPlayer(1).addSkill(SkillName::ReallyStupid);
     placePlayer(gs, 2, {11, 7}, TeamSide::HOME);  // adjacent ally
 
     FixedDiceRoller dice({2});  // Pass with ally (need 2+)
@@ -76,7 +76,7 @@ TEST(BigGuyHandler, ReallyStupidWithAlly) {
 TEST(BigGuyHandler, ReallyStupidAlone) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::ReallyStupid);
+    gs.getPlayer(1).addSkill(SkillName::ReallyStupid);
     // No adjacent allies
 
     FixedDiceRoller dice({3});  // Fail alone (need 4+)
@@ -89,7 +89,7 @@ TEST(BigGuyHandler, ReallyStupidAlone) {
 TEST(BigGuyHandler, ReallyStupidAlonePass) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::ReallyStupid);
+    gs.getPlayer(1).addSkill(SkillName::ReallyStupid);
 
     FixedDiceRoller dice({4});  // Pass alone (need 4+)
     auto result = resolveBigGuyCheck(gs, 1, ActionType::MOVE, dice, nullptr);
@@ -102,7 +102,7 @@ TEST(BigGuyHandler, ReallyStupidAlonePass) {
 TEST(BigGuyHandler, WildAnimalAutoPassBlock) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::WildAnimal);
+    gs.getPlayer(1).addSkill(SkillName::WildAnimal);
 
     FixedDiceRoller dice({});  // No roll needed for Block
     auto result = resolveBigGuyCheck(gs, 1, ActionType::BLOCK, dice, nullptr);
@@ -113,7 +113,7 @@ TEST(BigGuyHandler, WildAnimalAutoPassBlock) {
 TEST(BigGuyHandler, WildAnimalFailMove) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::WildAnimal);
+    gs.getPlayer(1).addSkill(SkillName::WildAnimal);
 
     FixedDiceRoller dice({2});  // Fail on MOVE (need 3+)
     auto result = resolveBigGuyCheck(gs, 1, ActionType::MOVE, dice, nullptr);
@@ -129,7 +129,7 @@ TEST(BigGuyHandler, WildAnimalFailMove) {
 TEST(BigGuyHandler, TakeRootOnlyMove) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::TakeRoot);
+    gs.getPlayer(1).addSkill(SkillName::TakeRoot);
 
     // Block: no roll needed
     FixedDiceRoller dice({});
@@ -140,7 +140,7 @@ TEST(BigGuyHandler, TakeRootOnlyMove) {
 TEST(BigGuyHandler, TakeRootFailMove) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::TakeRoot);
+    gs.getPlayer(1).addSkill(SkillName::TakeRoot);
 
     FixedDiceRoller dice({1});  // Fail on MOVE
     auto result = resolveBigGuyCheck(gs, 1, ActionType::MOVE, dice, nullptr);
@@ -153,7 +153,7 @@ TEST(BigGuyHandler, TakeRootFailMove) {
 TEST(BigGuyHandler, BloodlustPass) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Bloodlust);
+    gs.getPlayer(1).addSkill(SkillName::Bloodlust);
 
     FixedDiceRoller dice({2});  // Pass (2+)
     auto result = resolveBigGuyCheck(gs, 1, ActionType::MOVE, dice, nullptr);
@@ -164,7 +164,7 @@ TEST(BigGuyHandler, BloodlustPass) {
 TEST(BigGuyHandler, BloodlustBiteThrall) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Bloodlust);
+    gs.getPlayer(1).addSkill(SkillName::Bloodlust);
     placePlayer(gs, 2, {11, 7}, TeamSide::HOME);  // Adjacent Thrall (no Bloodlust)
 
     FixedDiceRoller dice({1});  // Fail → bite
@@ -178,7 +178,7 @@ TEST(BigGuyHandler, BloodlustBiteThrall) {
 TEST(BigGuyHandler, BloodlustNoThrall) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Bloodlust);
+    gs.getPlayer(1).addSkill(SkillName::Bloodlust);
     // No adjacent Thrall
 
     FixedDiceRoller dice({1});
@@ -194,7 +194,7 @@ TEST(BigGuyHandler, BloodlustNoThrall) {
 TEST(MoveHandler, LeapSuccess) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Leap);
+    gs.getPlayer(1).addSkill(SkillName::Leap);
 
     // Leap to (12, 7) = dist 2. AG3: target = 7-3=4. Roll 5 → success
     FixedDiceRoller dice({5});
@@ -209,7 +209,7 @@ TEST(MoveHandler, LeapFail) {
     auto gs = makeGameState();
     gs.homeTeam.rerolls = 0;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Leap);
+    gs.getPlayer(1).addSkill(SkillName::Leap);
 
     // Leap AG3: target 4. Roll 2 → fail
     // Armor: 2D6=7 vs AV8 → no break
@@ -224,8 +224,8 @@ TEST(MoveHandler, LeapFail) {
 TEST(MoveHandler, LeapWithVeryLongLegs) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Leap);
-    gs.getPlayer(1).skills.add(SkillName::VeryLongLegs);
+    gs.getPlayer(1).addSkill(SkillName::Leap);
+    gs.getPlayer(1).addSkill(SkillName::VeryLongLegs);
 
     // AG3 + VLL: target = 7-3-1=3. Roll 3 → success
     FixedDiceRoller dice({3});
@@ -238,7 +238,7 @@ TEST(MoveHandler, LeapWithVeryLongLegs) {
 TEST(MoveHandler, LeapIgnoresTZ) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Leap);
+    gs.getPlayer(1).addSkill(SkillName::Leap);
     // Enemy adjacent to start — no dodge needed for leap
     placePlayer(gs, 12, {10, 8}, TeamSide::AWAY);
 
@@ -258,7 +258,7 @@ TEST(MoveHandler, TentaclesCaught) {
     gs.homeTeam.rerolls = 0;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 3, 3, 8);
     placePlayer(gs, 12, {10, 8}, TeamSide::AWAY, 6, 5, 1, 9);
-    gs.getPlayer(12).skills.add(SkillName::Tentacles);
+    gs.getPlayer(12).addSkill(SkillName::Tentacles);
 
     // Tentacles check: mover D6 + ST3 vs tentacles D6 + ST5
     // Mover rolls 2 (2+3=5), tentacles rolls 1 (1+5=6), 5 < 6 → caught
@@ -275,7 +275,7 @@ TEST(MoveHandler, TentaclesEscape) {
     gs.homeTeam.rerolls = 0;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 4, 3, 8);
     placePlayer(gs, 12, {10, 8}, TeamSide::AWAY, 6, 3, 1, 9);
-    gs.getPlayer(12).skills.add(SkillName::Tentacles);
+    gs.getPlayer(12).addSkill(SkillName::Tentacles);
 
     // Tentacles: mover rolls 4 (4+4=8) vs tentacles rolls 2 (2+3=5), 8 > 5 → escaped
     // Then dodge: AG3, 1 TZ at dest? No, enemy at (10,8) is adjacent to (10,7) not (11,7).
@@ -296,7 +296,7 @@ TEST(MoveHandler, ShadowingFollow) {
     gs.homeTeam.rerolls = 0;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 3, 4, 8);  // MA6 AG4
     placePlayer(gs, 12, {10, 8}, TeamSide::AWAY, 8, 3, 3, 8);  // MA8 with Shadowing
-    gs.getPlayer(12).skills.add(SkillName::Shadowing);
+    gs.getPlayer(12).addSkill(SkillName::Shadowing);
 
     // needsDodge = true (enemy at (10,8) has TZ on (10,7))
     // Dodge: AG4, target = 7-4 + TZ@(11,7)=0 = 3. Roll 4 → success
@@ -313,7 +313,7 @@ TEST(MoveHandler, ShadowingFail) {
     gs.homeTeam.rerolls = 0;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 8, 3, 4, 8);  // MA8 AG4
     placePlayer(gs, 12, {10, 8}, TeamSide::AWAY, 6, 3, 3, 8);  // MA6 with Shadowing
-    gs.getPlayer(12).skills.add(SkillName::Shadowing);
+    gs.getPlayer(12).addSkill(SkillName::Shadowing);
 
     // Dodge: AG4, target 3. Roll 4 → success
     // Shadowing: D6 + MA6 - MA8 = D6-2. Need 6 → roll must be 8+ → impossible
@@ -329,7 +329,7 @@ TEST(MoveHandler, ShadowingFail) {
 TEST(BigGuyHandler, BoneHeadBlockedViaResolver) {
     auto gs = makeGameState();
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::BoneHead);
+    gs.getPlayer(1).addSkill(SkillName::BoneHead);
 
     Action action{ActionType::MOVE, 1, -1, {11, 7}};
 
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "bb/bitboard.h"
+
+using namespace bb;
+
+TEST(Bitboard, SetTestClear) {
+    Bitboard b;
+    EXPECT_FALSE(b.any());
+    b.set(Position{25, 14});
+    b.set(Position{0, 0});
+    EXPECT_TRUE(b.test(Position{25, 14}));
+    EXPECT_TRUE(b.test(Position{0, 0}));
+    EXPECT_EQ(b.count(), 2);
+    b.clear(Bitboard::indexOf({0, 0}));
+    EXPECT_FALSE(b.test(Position{0, 0}));
+    EXPECT_EQ(Bitboard::pitch().count(), 390);
+}
+
+TEST(Bitboard, AdjacentMatchesGetAdjacent) {
+    for (int i = 0; i < Bitboard::SQUARES; ++i) {
+        Position p = Bitboard::positionOf(i);
+        std::vector<Position> expected;
+        for (auto& a : p.getAdjacent()) {
+            if (a.isOnPitch()) expected.push_back(a);
+        }
+        std::vector<Position> got;
+        Bitboard::adjacent(p).forEach([&](int sq) { got.push_back(Bitboard::positionOf(sq)); });
+        ASSERT_EQ(got, expected) << "square " << i;
+    }
+}
+
+TEST(Bitboard, DilateDoesNotWrapRows) {
+    Bitboard b;
+    b.set(Position{25, 7});  // east touchline column
+    Bitboard d = dilate(b);
+    EXPECT_EQ(d.count(), 6);
+    EXPECT_FALSE(d.test(Position{0, 8}));
+    EXPECT_FALSE(d.test(Position{0, 7}));
+
+    Bitboard c;
+    c.set(Position{0, 0});  // corner
+    EXPECT_EQ(dilate(c).count(), 4);
+}
+
+TEST(Bitboard, ShiftAcrossWords) {
+    Bitboard b;
+    b.set(63);
+    EXPECT_TRUE(b.shiftUp(1).test(64));
+    EXPECT_TRUE(b.shiftUp(130).test(193));
+    EXPECT_TRUE(b.shiftDown(63).test(0));
+    Bitboard top;
+    top.set(389);
+    EXPECT_FALSE(top.shiftUp(1).any());  // falls off the pitch
+}
+
+TEST(Bitboard, FloodFillRespectsWallsAndSteps) {
+    // Wall across column 5 with no gap: nothing beyond it is reachable
+    Bitboard passable = Bitboard::pitch();
+    for (int y = 0; y < Position::PITCH_HEIGHT; ++y) {
+        passable.clear(Bitboard::indexOf({5, static_cast<int8_t>(y)}));
+    }
+    Bitboard reach = floodFill({2, 7}, passable, 20);
+    EXPECT_TRUE(reach.test(Position{4, 0}));
+    EXPECT_FALSE(reach.test(Position{6, 7}));
+
+    // Open pitch: n steps cover the Chebyshev ball of radius n
+    Bitboard open = floodFill({10, 7}, Bitboard::pitch(), 2);
+    EXPECT_EQ(open.count(), 25);
+}
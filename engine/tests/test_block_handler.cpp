@@ -9,8 +9,8 @@ static void placePlayer(GameState& gs, int id, Position pos, TeamSide side,
     Player& p = gs.getPlayer(id);
     p.state = PlayerState::STANDING;
     p.position = pos;
-    p.stats = {static_cast<int8_t>(ma), static_cast<int8_t>(st),
-               static_cast<int8_t>(ag), static_cast<int8_t>(av)};
+    p.setStats({static_cast<int8_t>(ma), static_cast<int8_t>(st),
+                static_cast<int8_t>(ag), static_cast<int8_t>(av)});
     p.movementRemaining = ma;
 }
 
@@ -31,7 +31,7 @@ TEST(BlockHandler, TwoDiceAdvantage) {
 TEST(BlockHandler, BlockSkillSavesOnBD) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Block);
+    gs.getPlayer(1).addSkill(SkillName::Block);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
     // 1 die (equal ST). Roll BD (D6=2 → BD)
     // Attacker has Block, defender doesn't → only defender falls
@@ -62,7 +62,7 @@ TEST(BlockHandler, WrestleBothProne) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
-    gs.getPlayer(12).skills.add(SkillName::Wrestle);
+    gs.getPlayer(12).addSkill(SkillName::Wrestle);
     // Roll BD. Defender has Wrestle → both prone, no armor, no turnover
     FixedDiceRoller dice({2});
     BlockParams params{1, 12, false, false};
@@ -76,7 +76,7 @@ TEST(BlockHandler, DodgeSavesOnDS) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
-    gs.getPlayer(12).skills.add(SkillName::Dodge);
+    gs.getPlayer(12).addSkill(SkillName::Dodge);
     // Roll DS (D6=5). Defender has Dodge → treated as PUSHED, not knocked down
     FixedDiceRoller dice({5});
     BlockParams params{1, 12, false, false};
@@ -89,9 +89,9 @@ TEST(BlockHandler, DodgeSavesOnDS) {
 TEST(BlockHandler, TackleNegatesDodgeOnDS) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Tackle);
+    gs.getPlayer(1).addSkill(SkillName::Tackle);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
-    gs.getPlayer(12).skills.add(SkillName::Dodge);
+    gs.getPlayer(12).addSkill(SkillName::Dodge);
     // Roll DS. Tackle negates Dodge → defender knocked down
     // Armor: 3+3=6 ≤ 8
     FixedDiceRoller dice({5, 3, 3});
@@ -132,7 +132,7 @@ TEST(BlockHandler, StandFirmPrevents) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
-    gs.getPlayer(12).skills.add(SkillName::StandFirm);
+    gs.getPlayer(12).addSkill(SkillName::StandFirm);
     // Roll PUSHED. StandFirm blocks push
     FixedDiceRoller dice({3});
     BlockParams params{1, 12, false, false};
@@ -140,12 +140,47 @@ TEST(BlockHandler, StandFirmPrevents) {
     EXPECT_EQ(gs.getPlayer(12).position, (Position{11, 7})); // didn't move
 }
 
+TEST(BlockHandler, StandFirmNoFollowUp) {
+    GameState gs;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
+    placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
+    gs.getPlayer(12).addSkill(SkillName::StandFirm);
+    // Defender holds the square, so the attacker has nowhere to follow into
+    FixedDiceRoller dice({3});
+    BlockParams params{1, 12, false, false};
+    resolveBlock(gs, params, dice, nullptr);
+    EXPECT_EQ(gs.getPlayer(1).position, (Position{10, 7}));
+    EXPECT_EQ(gs.getPlayerAtPosition({11, 7})->id, 12);
+}
+
+TEST(BlockHandler, ChainPushCascades) {
+    GameState gs;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
+    placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
+    // All three push squares taken, and all three behind the straight one too
+    placePlayer(gs, 13, {12, 7}, TeamSide::AWAY);
+    placePlayer(gs, 14, {12, 6}, TeamSide::AWAY);
+    placePlayer(gs, 15, {12, 8}, TeamSide::AWAY);
+    placePlayer(gs, 16, {13, 7}, TeamSide::AWAY);
+    placePlayer(gs, 17, {13, 6}, TeamSide::AWAY);
+    placePlayer(gs, 18, {13, 8}, TeamSide::AWAY);
+    // Roll PUSHED: 12 -> (12,7), 13 -> (13,7), 16 -> (14,7)
+    FixedDiceRoller dice({3});
+    BlockParams params{1, 12, false, false};
+    resolveBlock(gs, params, dice, nullptr);
+    EXPECT_EQ(gs.getPlayer(16).position, (Position{14, 7}));
+    EXPECT_EQ(gs.getPlayer(13).position, (Position{13, 7}));
+    EXPECT_EQ(gs.getPlayer(12).position, (Position{12, 7}));
+    EXPECT_EQ(gs.getPlayer(1).position, (Position{11, 7}));
+    EXPECT_TRUE(gs.occupancyConsistent());
+}
+
 TEST(BlockHandler, JuggernautIgnoresStandFirmOnBlitz) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Juggernaut);
+    gs.getPlayer(1).addSkill(SkillName::Juggernaut);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
-    gs.getPlayer(12).skills.add(SkillName::StandFirm);
+    gs.getPlayer(12).addSkill(SkillName::StandFirm);
     // Roll PUSHED on blitz. Juggernaut ignores StandFirm
     FixedDiceRoller dice({3});
     BlockParams params{1, 12, true, false};
@@ -156,8 +191,8 @@ TEST(BlockHandler, JuggernautIgnoresStandFirmOnBlitz) {
 TEST(BlockHandler, MightyBlowAndClaw) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::MightyBlow);
-    gs.getPlayer(1).skills.add(SkillName::Claw);
+    gs.getPlayer(1).addSkill(SkillName::MightyBlow);
+    gs.getPlayer(1).addSkill(SkillName::Claw);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY, 6, 3, 3, 9);
     // Roll DD. Defender pushed + knocked down
     // Claw: armor broken on 8+. MB: +1 to armor and injury
@@ -171,7 +206,7 @@ TEST(BlockHandler, MightyBlowAndClaw) {
 TEST(BlockHandler, HornsBonusOnBlitz) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME); // ST3
-    gs.getPlayer(1).skills.add(SkillName::Horns);
+    gs.getPlayer(1).addSkill(SkillName::Horns);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY); // ST3
     // With Horns on blitz: ST3+1=4 vs ST3 → 2 dice attacker
     // Roll: DD, AD → choose DD. Armor: 3+3=6
@@ -185,7 +220,7 @@ TEST(BlockHandler, HornsBonusOnBlitz) {
 TEST(BlockHandler, DauntlessSuccess) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME); // ST3
-    gs.getPlayer(1).skills.add(SkillName::Dauntless);
+    gs.getPlayer(1).addSkill(SkillName::Dauntless);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY, 6, 5, 3, 9); // ST5
     // Effective: ST3 vs ST5 (defender stronger)
     // Dauntless: D6=4, 4+3=7 > 5 → treat as equal (1 die attacker)
@@ -200,7 +235,7 @@ TEST(BlockHandler, FoulAppearanceBlocks) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
-    gs.getPlayer(12).skills.add(SkillName::FoulAppearance);
+    gs.getPlayer(12).addSkill(SkillName::FoulAppearance);
     // FA roll: 1 → attacker too revolted
     FixedDiceRoller dice({1});
     BlockParams params{1, 12, false, false};
@@ -213,7 +248,7 @@ TEST(BlockHandler, FoulAppearanceBlocks) {
 TEST(BlockHandler, StabArmorRoll) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Stab);
+    gs.getPlayer(1).addSkill(SkillName::Stab);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
     // Stab: armor roll. 5+4=9 > 8 → broken. Injury: 3+3=6 → stunned
     FixedDiceRoller dice({5, 4, 3, 3});
@@ -226,7 +261,7 @@ TEST(BlockHandler, StabArmorRoll) {
 TEST(BlockHandler, ChainsawSuccess) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Chainsaw);
+    gs.getPlayer(1).addSkill(SkillName::Chainsaw);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
     // Chainsaw: D6=3 (2+ success) → armor on defender: 5+4=9 > 8 → injured 3+3
     FixedDiceRoller dice({3, 5, 4, 3, 3});
@@ -238,7 +273,7 @@ TEST(BlockHandler, ChainsawSuccess) {
 TEST(BlockHandler, ChainsawKickback) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Chainsaw);
+    gs.getPlayer(1).addSkill(SkillName::Chainsaw);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
     // Chainsaw: D6=1 → kickback on attacker. Armor: 3+3=6 ≤ 8 not broken
     FixedDiceRoller dice({1, 3, 3});
@@ -251,7 +286,7 @@ TEST(BlockHandler, ChainsawKickback) {
 TEST(BlockHandler, FrenzyDoubleBlock) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Frenzy);
+    gs.getPlayer(1).addSkill(SkillName::Frenzy);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
     // 1st block: PUSHED (D6=3). Defender pushed to (12,7). Attacker follows to (11,7).
     // Both still standing + adjacent → mandatory 2nd block
@@ -279,7 +314,7 @@ TEST(BlockHandler, AttackerDown) {
 TEST(BlockHandler, StripBall) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::StripBall);
+    gs.getPlayer(1).addSkill(SkillName::StripBall);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
     gs.ball = BallState::carried({11, 7}, 12);
     // Roll PUSHED. Defender pushed to (12,7). StripBall → ball drops at (12,7)
@@ -293,9 +328,9 @@ TEST(BlockHandler, StripBall) {
 TEST(BlockHandler, StripBallNegatedBySureHands) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::StripBall);
+    gs.getPlayer(1).addSkill(SkillName::StripBall);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
-    gs.getPlayer(12).skills.add(SkillName::SureHands);
+    gs.getPlayer(12).addSkill(SkillName::SureHands);
     gs.ball = BallState::carried({11, 7}, 12);
     // Roll PUSHED. Defender pushed to (12,7). Sure Hands negates Strip Ball (BB2016)
     // → ball stays with the carrier, and a SKILL_USED(SureHands) event is emitted.
@@ -338,7 +373,7 @@ TEST(BlockHandler, DefenderChoosesWorstForAttacker) {
 TEST(BlockHandler, JuggernautConvertsBDToPushOnBlitz) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Juggernaut);
+    gs.getPlayer(1).addSkill(SkillName::Juggernaut);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
     // Roll BD (D6=2). Juggernaut on blitz → treated as PUSHED
     FixedDiceRoller dice({2});
@@ -355,7 +390,7 @@ TEST(BlockHandler, MultipleBlockBothResolve) {
     GameState gs;
     gs.phase = GamePhase::PLAY;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 4, 3, 8); // ST4
-    gs.getPlayer(1).skills.add(SkillName::MultipleBlock);
+    gs.getPlayer(1).addSkill(SkillName::MultipleBlock);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY); // ST3
     placePlayer(gs, 13, {11, 8}, TeamSide::AWAY); // ST3
 
@@ -375,7 +410,7 @@ TEST(BlockHandler, MultipleBlockNoFollowUp) {
     GameState gs;
     gs.phase = GamePhase::PLAY;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 6, 3, 8); // ST6
-    gs.getPlayer(1).skills.add(SkillName::MultipleBlock);
+    gs.getPlayer(1).addSkill(SkillName::MultipleBlock);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY); // ST3+2=5; def2 at (11,8) assists → 6vs6=1die
     placePlayer(gs, 13, {11, 8}, TeamSide::AWAY);
 
@@ -392,7 +427,7 @@ TEST(BlockHandler, MultipleBlockAttackerDownSkipsSecond) {
     GameState gs;
     gs.phase = GamePhase::PLAY;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 3, 3, 8); // ST3
-    gs.getPlayer(1).skills.add(SkillName::MultipleBlock);
+    gs.getPlayer(1).addSkill(SkillName::MultipleBlock);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY); // ST3+2=5 → 2-die def
     placePlayer(gs, 13, {11, 8}, TeamSide::AWAY);
 
@@ -409,9 +444,9 @@ TEST(BlockHandler, MultipleBlockFAFailSkipsBlock) {
     GameState gs;
     gs.phase = GamePhase::PLAY;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 6, 3, 8);
-    gs.getPlayer(1).skills.add(SkillName::MultipleBlock);
+    gs.getPlayer(1).addSkill(SkillName::MultipleBlock);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
-    gs.getPlayer(12).skills.add(SkillName::FoulAppearance);
+    gs.getPlayer(12).addSkill(SkillName::FoulAppearance);
     placePlayer(gs, 13, {11, 8}, TeamSide::AWAY);
 
     // Block 1: FA check → roll 1 → skip block 1
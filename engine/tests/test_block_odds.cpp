@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "bb/block_odds.h"
+#include "bb/block_handler.h"
+#include "bb/dice.h"
+#include "bb/game_state.h"
+
+using namespace bb;
+
+namespace {
+
+float total(const BlockOdds& odds) {
+    float sum = 0.0f;
+    for (float p : odds.p) sum += p;
+    return sum;
+}
+
+GameState makeBlockState() {
+    GameState state;
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.homeTeam.rerolls = 2;
+    state.weather = Weather::NICE;
+
+    Player& att = state.getPlayer(1);
+    att.id = 1;
+    att.teamSide = TeamSide::HOME;
+    att.state = PlayerState::STANDING;
+    att.position = {12, 7};
+    att.setStats({6, 4, 3, 8});
+    att.addSkill(SkillName::Block);
+
+    Player& def = state.getPlayer(12);
+    def.id = 12;
+    def.teamSide = TeamSide::AWAY;
+    def.state = PlayerState::STANDING;
+    def.position = {13, 7};
+    def.setStats({6, 3, 3, 8});
+    def.addSkill(SkillName::Dodge);
+
+    state.ball = BallState::onGround({3, 3});
+    return state;
+}
+
+} // anonymous namespace
+
+TEST(BlockOdds, OneDieNoSkills) {
+    const BlockOdds& odds = blockOdds(1, true, BlockSkills{}, RerollAccess{});
+    EXPECT_NEAR(odds[BlockOutcome::DEFENDER_DOWN], 2.0f / 6.0f, 1e-6);
+    EXPECT_NEAR(odds[BlockOutcome::PUSHED], 2.0f / 6.0f, 1e-6);
+    EXPECT_NEAR(odds[BlockOutcome::BOTH_DOWN], 1.0f / 6.0f, 1e-6);
+    EXPECT_NEAR(odds[BlockOutcome::ATTACKER_DOWN], 1.0f / 6.0f, 1e-6);
+    EXPECT_NEAR(odds.turnover(), 2.0f / 6.0f, 1e-6);
+}
+
+TEST(BlockOdds, SkillsAndRerolls) {
+    // Two dice, attacker chooses: only double skulls / skull + both down fail
+    const BlockOdds& two = blockOdds(2, true, BlockSkills{}, RerollAccess{});
+    EXPECT_NEAR(two.turnover(), 4.0f / 36.0f, 1e-6);
+    // Defender chooses: the worst face for the attacker
+    const BlockOdds& red = blockOdds(2, false, BlockSkills{}, RerollAccess{});
+    EXPECT_NEAR(red.turnover(), 1.0f - (4.0f / 6.0f) * (4.0f / 6.0f), 1e-6);
+
+    // A team reroll of a failed block retries it once
+    const BlockOdds& rerolled = blockOdds(1, true, BlockSkills{}, RerollAccess{true, false, false});
+    EXPECT_NEAR(rerolled.turnover(), (2.0f / 6.0f) * (2.0f / 6.0f), 1e-6);
+
+    BlockSkills s;
+    s.attBlock = true;
+    s.defBlock = true;
+    const BlockOdds& blocks = blockOdds(1, true, s, RerollAccess{});
+    EXPECT_NEAR(blocks[BlockOutcome::STANDOFF], 1.0f / 6.0f, 1e-6);
+    s = {};
+    s.defWrestle = true;
+    EXPECT_NEAR(blockOdds(1, true, s, RerollAccess{})[BlockOutcome::WRESTLED], 1.0f / 6.0f, 1e-6);
+    s = {};
+    s.defDodge = true;
+    s.defStandFirm = true;
+    const BlockOdds& dodgy = blockOdds(1, true, s, RerollAccess{});
+    EXPECT_NEAR(dodgy[BlockOutcome::STANDOFF], 3.0f / 6.0f, 1e-6);
+    s.attTackle = true;
+    EXPECT_NEAR(blockOdds(1, true, s, RerollAccess{})[BlockOutcome::DEFENDER_DOWN], 2.0f / 6.0f, 1e-6);
+
+    for (int dice = 1; dice <= 3; ++dice) {
+        for (int k = 0; k < 8; ++k) {
+            RerollAccess r{(k & 1) != 0, (k & 2) != 0, (k & 4) != 0};
+            EXPECT_NEAR(total(blockOdds(dice, dice != 3, s, r)), 1.0f, 1e-5);
+        }
+    }
+}
+
+TEST(BlockOdds, MatchesResolveBlock) {
+    // Monte Carlo over the rules engine: ST4 Block vs ST3 Dodge, two dice,
+    // team rerolls available
+    GameState base = makeBlockState();
+    const BlockOdds& odds = blockOdds(base, base.getPlayer(1), base.getPlayer(12), false);
+    DiceRoller dice(5);
+    std::array<int, static_cast<size_t>(BlockOutcome::COUNT)> counts{};
+    const int trials = 100000;
+    for (int t = 0; t < trials; ++t) {
+        GameState s = base;
+        BlockParams params;
+        params.attackerId = 1;
+        params.targetId = 12;
+        resolveBlock(s, params, dice, nullptr, false, true);
+        const Player& att = s.getPlayer(1);
+        const Player& def = s.getPlayer(12);
+        bool attDown = att.state != PlayerState::STANDING;
+        bool defDown = def.state != PlayerState::STANDING;
+        BlockOutcome o = attDown ? (defDown ? BlockOutcome::BOTH_DOWN : BlockOutcome::ATTACKER_DOWN)
+                       : defDown ? BlockOutcome::DEFENDER_DOWN
+                       : def.position != Position{13, 7} ? BlockOutcome::PUSHED
+                       : BlockOutcome::STANDOFF;
+        ++counts[static_cast<size_t>(o)];
+    }
+    for (size_t i = 0; i < counts.size(); ++i) {
+        EXPECT_NEAR(static_cast<double>(counts[i]) / trials, odds.p[i], 0.006) << "outcome " << i;
+    }
+    EXPECT_GT(odds[BlockOutcome::DEFENDER_DOWN], 0.5f);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "bb/board_planes.h"
+#include "bb/game_state.h"
+#include "bb/game_simulator.h"
+#include "bb/helpers.h"
+#include "bb/roster.h"
+#include "bb/rules_engine.h"
+#include "bb/action_resolver.h"
+#include <vector>
+
+using namespace bb;
+
+namespace {
+
+bool planeAt(const std::vector<float>& t, int plane, int x, int y) {
+    return t[plane * BOARD_PLANE_SIZE + y * BOARD_PLANE_WIDTH + x] != 0.0f;
+}
+
+void place(GameState& gs, int id, Position pos, PlayerState st) {
+    Player& p = gs.getPlayer(id);
+    p.state = st;
+    p.position = pos;
+    p.setStats({6, 3, 3, 8});
+    p.movementRemaining = 6;
+}
+
+} // namespace
+
+TEST(BoardPlanes, PlayersBallAndOrientation) {
+    GameState gs;
+    gs.phase = GamePhase::PLAY;
+    gs.activeTeam = TeamSide::HOME;
+    place(gs, 1, {3, 5}, PlayerState::STANDING);
+    place(gs, 2, {4, 9}, PlayerState::STUNNED);
+    place(gs, 12, {10, 2}, PlayerState::PRONE);
+    place(gs, 13, {4, 6}, PlayerState::STANDING);
+    gs.ball = BallState::carried({3, 5}, 1);
+    gs.invalidateOccupancy();
+
+    std::vector<float> home(NUM_BOARD_PLANES * BOARD_PLANE_SIZE);
+    extractBoardPlanes(gs, TeamSide::HOME, home.data());
+    EXPECT_TRUE(planeAt(home, PLANE_OWN_STANDING, 3, 5));
+    EXPECT_TRUE(planeAt(home, PLANE_OWN_STUNNED, 4, 9));
+    EXPECT_TRUE(planeAt(home, PLANE_OPP_PRONE, 10, 2));
+    EXPECT_TRUE(planeAt(home, PLANE_OPP_STANDING, 4, 6));
+    EXPECT_TRUE(planeAt(home, PLANE_BALL, 3, 5));
+    EXPECT_TRUE(planeAt(home, PLANE_OWN_CARRIER, 3, 5));
+    EXPECT_TRUE(planeAt(home, PLANE_OWN_MA_5, 3, 5));
+    EXPECT_FALSE(planeAt(home, PLANE_OWN_MA_7, 3, 5));
+    EXPECT_TRUE(planeAt(home, PLANE_OWN_TURN, 20, 0));
+
+    // AWAY sees the same pitch mirrored in x, with the teams swapped
+    std::vector<float> away(NUM_BOARD_PLANES * BOARD_PLANE_SIZE);
+    extractBoardPlanes(gs, TeamSide::AWAY, away.data());
+    EXPECT_TRUE(planeAt(away, PLANE_OPP_STANDING, 22, 5));
+    EXPECT_TRUE(planeAt(away, PLANE_OPP_STUNNED, 21, 9));
+    EXPECT_TRUE(planeAt(away, PLANE_OWN_PRONE, 15, 2));
+    EXPECT_TRUE(planeAt(away, PLANE_OWN_STANDING, 21, 6));
+    EXPECT_TRUE(planeAt(away, PLANE_OPP_CARRIER, 22, 5));
+    EXPECT_FALSE(planeAt(away, PLANE_OWN_CARRIER, 22, 5));
+    EXPECT_FALSE(planeAt(away, PLANE_OWN_TURN, 20, 0));
+
+    // The standing home player's TZ covers the away player next to it
+    EXPECT_TRUE(planeAt(home, PLANE_OWN_TZ_1, 4, 6));
+    EXPECT_FALSE(planeAt(home, PLANE_OWN_TZ_2, 4, 6));
+    EXPECT_TRUE(planeAt(away, PLANE_OPP_TZ_1, 21, 6));
+}
+
+TEST(BoardPlanes, TacklezonePlanesAreThermometerCounts) {
+    GameState gs;
+    setupHalf(gs, getOrcRoster(), getHumanRoster());
+    gs.phase = GamePhase::PLAY;
+    BoardPlaneMasks m;
+    boardPlaneMasks(gs, TeamSide::HOME, m);
+    for (TeamSide side : {TeamSide::HOME, TeamSide::AWAY}) {
+        int first = side == TeamSide::HOME ? PLANE_OWN_TZ_1 : PLANE_OPP_TZ_1;
+        for (int i = 0; i < BOARD_PLANE_SIZE; ++i) {
+            int n = gs.tacklezoneCount(side, Bitboard::positionOf(i));
+            for (int level = 0; level < 3; ++level) {
+                ASSERT_EQ(m[first + level].test(i), n > level) << "square " << i;
+            }
+        }
+    }
+}
+
+TEST(BoardPlanes, DenseAndPackedFormsAgree) {
+    std::vector<GameState> states;
+    std::vector<Action> actions;
+    for (uint32_t seed = 1; seed <= 4; ++seed) {
+        GameState gs;
+        DiceRoller dice(seed);
+        setupHalf(gs, getSkavenRoster(), getWoodElfRoster(), TeamSide::AWAY);
+        simpleKickoff(gs, dice);
+        for (int step = 0; step < 20 && gs.phase == GamePhase::PLAY; ++step) {
+            states.push_back(gs.clone());
+            getAvailableActions(gs, actions);
+            executeAction(gs, actions[dice.rollD6() * 31 % actions.size()], dice, nullptr);
+        }
+    }
+    ASSERT_GT(states.size(), 20u);
+
+    std::vector<float> dense(NUM_BOARD_PLANES * BOARD_PLANE_SIZE);
+    std::vector<uint8_t> bytes(NUM_BOARD_PLANES * BOARD_PLANE_SIZE);
+    std::vector<uint8_t> packed(NUM_BOARD_PLANES * BOARD_PLANE_BYTES);
+    for (const GameState& gs : states) {
+        for (TeamSide persp : {TeamSide::HOME, TeamSide::AWAY}) {
+            extractBoardPlanes(gs, persp, dense.data());
+            extractBoardPlanes(gs, persp, bytes.data());
+            extractBoardPlanesPacked(gs, persp, packed.data());
+            for (int c = 0; c < NUM_BOARD_PLANES; ++c) {
+                for (int i = 0; i < BOARD_PLANE_SIZE; ++i) {
+                    int bit = (packed[c * BOARD_PLANE_BYTES + (i >> 3)] >> (i & 7)) & 1;
+                    ASSERT_EQ(bytes[c * BOARD_PLANE_SIZE + i], bit);
+                    ASSERT_EQ(dense[c * BOARD_PLANE_SIZE + i], static_cast<float>(bit));
+                }
+                // Padding bits past the last square stay clear
+                ASSERT_EQ(packed[c * BOARD_PLANE_BYTES + BOARD_PLANE_BYTES - 1] >> (BOARD_PLANE_SIZE & 7), 0);
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "bb/board_snapshot.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+
+using namespace bb;
+
+TEST(BoardSnapshot, CompactFormExpandsToTheFullSnapshot) {
+    GameState state;
+    const TeamRoster& home = getHumanRoster();
+    const TeamRoster& away = getOrcRoster();
+    setupHalf(state, home, away);
+    Player& carrier = state.getPlayer(3);
+    state.ball = BallState::carried(carrier.position, carrier.id);
+    state.getPlayer(14).state = PlayerState::PRONE;
+
+    CompactBoardSnapshot compact = captureCompactBoardSnapshot(state);
+    EXPECT_TRUE(compact.captured);
+    EXPECT_EQ(compact.numHome, 11);
+    EXPECT_EQ(compact.numAway, 11);
+    BoardSnapshot board = captureBoardSnapshot(state);
+    ASSERT_EQ(board.homePlayers.size(), 11u);
+    ASSERT_EQ(board.awayPlayers.size(), 11u);
+    EXPECT_EQ(board.ballCarrierId, 3);
+    for (int i = 0; i < compact.numPlayers(); ++i) {
+        const CompactPlayerSnapshot& c = compact.players[i];
+        const PlayerSnapshot& p = i < 11 ? board.homePlayers[i] : board.awayPlayers[i - 11];
+        EXPECT_EQ(c.id, p.id);
+        EXPECT_EQ(c.x, p.x);
+        EXPECT_EQ(c.y, p.y);
+        EXPECT_EQ(c.state(), p.state);
+        EXPECT_EQ(c.hasBall(), p.hasBall);
+        EXPECT_EQ(c.hasBall(), c.id == 3);
+        if (c.id == 14) EXPECT_EQ(c.state(), 1);
+
+        // Starting players were built from a roster positional, except a
+        // kicking-team safety given Kick at setup
+        const TeamRoster& roster = i < 11 ? home : away;
+        int t = positionalIndex(roster, c.profile);
+        if (t < 0) {
+            EXPECT_TRUE(profileOf(c.profile).skills.has(SkillName::Kick));
+            continue;
+        }
+        EXPECT_EQ(internProfile(roster.positionals[t].stats, roster.positionals[t].skills), c.profile);
+    }
+    EXPECT_EQ(positionalIndex(home, 0), -1);
+}
+
+TEST(BoardSnapshot, StateRebuildsFromASnapshotAndItsContext) {
+    const TeamRoster& home = getHumanRoster();
+    const TeamRoster& away = getOrcRoster();
+    GameState state;
+    setupHalf(state, home, away, TeamSide::HOME);
+    DiceRoller dice(11);
+    simpleKickoff(state, dice);
+
+    SnapshotContext context;
+    context.half = state.half;
+    context.homeTurn = state.homeTeam.turnNumber;
+    context.awayTurn = state.awayTeam.turnNumber;
+    context.activeTeam = state.activeTeam;
+    context.kickingTeam = TeamSide::HOME;
+
+    // Right after the kickoff nothing the snapshot leaves out has happened yet
+    GameState rebuilt = stateFromSnapshot(captureCompactBoardSnapshot(state), home, away, context);
+    float expected[NUM_FEATURES], actual[NUM_FEATURES];
+    for (TeamSide side : {TeamSide::HOME, TeamSide::AWAY}) {
+        extractFeatures(state, side, expected);
+        extractFeatures(rebuilt, side, actual);
+        for (int f = 0; f < NUM_FEATURES; ++f) EXPECT_FLOAT_EQ(actual[f], expected[f]) << f;
+    }
+
+    // Later boards come back square for square, from either form
+    state.getPlayer(14).state = PlayerState::PRONE;
+    state.getPlayer(5).state = PlayerState::KO;
+    state.getPlayer(5).position = {-1, -1};
+    state.invalidateOccupancy();
+    CompactBoardSnapshot snap = captureCompactBoardSnapshot(state);
+    for (const GameState& s : {stateFromSnapshot(snap, home, away, context),
+                               stateFromSnapshot(expandBoardSnapshot(snap), home, away, context)}) {
+        CompactBoardSnapshot again = captureCompactBoardSnapshot(s);
+        ASSERT_EQ(again.numHome, 10);
+        ASSERT_EQ(again.numAway, 11);
+        for (int i = 0; i < snap.numPlayers(); ++i) {
+            EXPECT_EQ(again.players[i].id, snap.players[i].id);
+            EXPECT_EQ(again.players[i].x, snap.players[i].x);
+            EXPECT_EQ(again.players[i].y, snap.players[i].y);
+            EXPECT_EQ(again.players[i].flags, snap.players[i].flags);
+            EXPECT_EQ(again.players[i].profile, snap.players[i].profile);
+        }
+        EXPECT_EQ(again.ballX, snap.ballX);
+        EXPECT_EQ(again.ballY, snap.ballY);
+        EXPECT_EQ(s.getPlayer(5).state, PlayerState::OFF_PITCH);
+    }
+
+    snap.players[0].id = 12;  // an away id among the home players
+    EXPECT_THROW(stateFromSnapshot(snap, home, away, context), std::invalid_argument);
+}
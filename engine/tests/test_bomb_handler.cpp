@@ -9,8 +9,8 @@ static void placePlayer(GameState& gs, int id, Position pos, TeamSide side,
     Player& p = gs.getPlayer(id);
     p.state = PlayerState::STANDING;
     p.position = pos;
-    p.stats = {static_cast<int8_t>(ma), static_cast<int8_t>(st),
-               static_cast<int8_t>(ag), static_cast<int8_t>(av)};
+    p.setStats({static_cast<int8_t>(ma), static_cast<int8_t>(st),
+                static_cast<int8_t>(ag), static_cast<int8_t>(av)});
     p.movementRemaining = ma;
 }
 
@@ -19,7 +19,7 @@ TEST(BombHandler, AccurateExplosion) {
     gs.phase = GamePhase::PLAY;
     gs.activeTeam = TeamSide::HOME;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME); // Bombardier AG3
-    gs.getPlayer(1).skills.add(SkillName::Bombardier);
+    gs.getPlayer(1).addSkill(SkillName::Bombardier);
     placePlayer(gs, 12, {13, 7}, TeamSide::AWAY); // Target
 
     // Distance 3 = quick pass. AG3: target = 7-3-1 = 3. Roll 5 >= 3 → accurate
@@ -37,7 +37,7 @@ TEST(BombHandler, InaccurateTripleScatter) {
     gs.phase = GamePhase::PLAY;
     gs.activeTeam = TeamSide::HOME;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 3, 2, 8); // AG2
-    gs.getPlayer(1).skills.add(SkillName::Bombardier);
+    gs.getPlayer(1).addSkill(SkillName::Bombardier);
     placePlayer(gs, 12, {13, 7}, TeamSide::AWAY);
 
     // AG2: target = 7-2-1 = 4. Roll 2 < 4 → inaccurate
@@ -55,7 +55,7 @@ TEST(BombHandler, Fumble) {
     gs.phase = GamePhase::PLAY;
     gs.activeTeam = TeamSide::HOME;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Bombardier);
+    gs.getPlayer(1).addSkill(SkillName::Bombardier);
     placePlayer(gs, 12, {13, 7}, TeamSide::AWAY);
 
     // Natural 1 = fumble. Scatter from thrower (10,7): D8=1 → (11,7)
@@ -70,7 +70,7 @@ TEST(BombHandler, OffPitchFizzle) {
     gs.phase = GamePhase::PLAY;
     gs.activeTeam = TeamSide::HOME;
     placePlayer(gs, 1, {1, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Bombardier);
+    gs.getPlayer(1).addSkill(SkillName::Bombardier);
 
     // Fumble (roll=1), scatter D8=5 → (-1,0) → (0,7) still on pitch
     // Actually let's make it scatter off pitch: thrower at (0,7)
@@ -86,7 +86,7 @@ TEST(BombHandler, ThrowerImmune) {
     gs.phase = GamePhase::PLAY;
     gs.activeTeam = TeamSide::HOME;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Bombardier);
+    gs.getPlayer(1).addSkill(SkillName::Bombardier);
 
     // Fumble (roll=1), scatter D8=5 → (-1,0) → (9,7)
     // Explosion at (9,7). Thrower at (10,7) is adjacent → in 3x3 but IMMUNE
@@ -100,7 +100,7 @@ TEST(BombHandler, NeverTurnover) {
     gs.phase = GamePhase::PLAY;
     gs.activeTeam = TeamSide::HOME;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Bombardier);
+    gs.getPlayer(1).addSkill(SkillName::Bombardier);
     gs.ball = BallState::carried({10, 7}, 1);
 
     // Even if fumble with ball carrier, never turnover
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "bb/c_api.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using nlohmann::json;
+
+TEST(CApi, StatesRoundTripAndExecuteActions) {
+    EXPECT_EQ(bb_abi_version(), BB_ABI_VERSION);
+    EXPECT_EQ(bb_state_new("human", "no such team", 1), nullptr);
+    EXPECT_NE(std::string(bb_last_error()).find("no such team"), std::string::npos);
+    EXPECT_EQ(bb_state_from_json("{}"), nullptr);
+
+    bb_state* state = bb_state_new("human", "orc", 1);
+    ASSERT_NE(state, nullptr);
+    json saved = json::parse(bb_state_to_json(state));
+    EXPECT_EQ(saved["phase"], 3);  // PLAY
+    EXPECT_EQ(saved["activeTeam"], 0);
+
+    json actions = json::parse(bb_legal_actions(state));
+    ASSERT_FALSE(actions.empty());
+    json move;  // a step back from the line without Bone-head (21): no dice
+    for (const json& a : actions) {
+        if (a["type"] != "MOVE" || a["x"] >= 11) continue;
+        const json& skills = saved["players"][a["player"].get<int>() - 1]["skills"];
+        if (std::find(skills.begin(), skills.end(), 21) == skills.end()) {
+            move = a;
+            break;
+        }
+    }
+    ASSERT_FALSE(move.is_null());
+
+    bb_state* copy = bb_state_clone(state);
+    const char* out = bb_execute(state, move.dump().c_str(), 7);
+    ASSERT_NE(out, nullptr) << bb_last_error();
+    json result = json::parse(out);
+    EXPECT_TRUE(result["success"]);
+    EXPECT_TRUE(result["events"].is_array());
+    json mover = json::parse(bb_state_to_json(state))["players"][move["player"].get<int>() - 1];
+    EXPECT_EQ(mover["x"], move["x"]);
+    EXPECT_EQ(mover["y"], move["y"]);
+
+    // The copy is unchanged, and takes the action by type id with
+    // target_player left to its default
+    bb_state* loaded = bb_state_from_json(bb_state_to_json(copy));
+    ASSERT_NE(loaded, nullptr);
+    json byName = {{"type", move["type_id"]}, {"player", move["player"]}, {"x", move["x"]}, {"y", move["y"]}};
+    ASSERT_NE(bb_execute(loaded, byName.dump().c_str(), 7), nullptr) << bb_last_error();
+    EXPECT_EQ(json::parse(bb_state_to_json(loaded)), json::parse(bb_state_to_json(state)));
+
+    EXPECT_EQ(bb_execute(state, move.dump().c_str(), 7), nullptr);  // the square is occupied now
+    EXPECT_EQ(std::string(bb_last_error()), "illegal action");
+    EXPECT_EQ(bb_execute(state, R"({"type": "DANCE"})", 7), nullptr);
+    EXPECT_EQ(bb_execute(state, "not json", 7), nullptr);
+
+    bb_state_free(loaded);
+    bb_state_free(copy);
+    bb_state_free(state);
+}
+
+TEST(CApi, EngineChoosesLegalMoves) {
+    EXPECT_EQ(bb_engine_new("[1]"), nullptr);
+    EXPECT_EQ(bb_engine_new(R"({"weights": "/no/such/model.bin"})"), nullptr);
+    bb_engine* engine = bb_engine_new(R"({"iterations": 40, "time_ms": 0, "seed": 3})");
+    ASSERT_NE(engine, nullptr) << bb_last_error();
+    bb_state* state = bb_state_new("human", "orc", 2);
+
+    json reply = json::parse(bb_engine_move(engine, state, R"({"id": "m1", "plan": true})"));
+    ASSERT_EQ(reply["status"], "ok") << reply.dump();
+    EXPECT_EQ(reply["id"], "m1");
+    EXPECT_EQ(reply["iterations"], 40);
+    ASSERT_FALSE(reply["actions"].empty());
+    bb_state* probe = bb_state_clone(state);
+    EXPECT_NE(bb_execute(probe, reply["actions"][0].dump().c_str(), 1), nullptr) << bb_last_error();
+
+    reply = json::parse(bb_engine_move(engine, state, nullptr));
+    EXPECT_EQ(reply["actions"].size(), 1u);
+    EXPECT_EQ(bb_engine_move(engine, state, "[]"), nullptr);
+
+    bb_state_free(probe);
+    bb_state_free(state);
+    bb_engine_free(engine);
+}
+
+TEST(CApi, LoaderExceptionsBecomeErrors) {
+    // A deep policy net of the wrong input width: the loader throws
+    // std::invalid_argument, which must not unwind into the caller
+    std::string path = ::testing::TempDir() + "bb_c_api_bad_policy.json";
+    std::ofstream(path) << R"({"policy_type": "mlp", "policy_layers": [{"W": [[1.0], [1.0]], "b": [0.0]}]})";
+    json config = {{"policy", path}};
+    EXPECT_EQ(bb_engine_new(config.dump().c_str()), nullptr);
+    EXPECT_NE(std::string(bb_last_error()).find("POLICY_INPUT_SIZE"), std::string::npos) << bb_last_error();
+    std::remove(path.c_str());
+
+    // A state the loader refuses
+    bb_state* state = bb_state_new("human", "orc", 1);
+    json saved = json::parse(bb_state_to_json(state));
+    saved["players"][0]["skills"].push_back(200);
+    EXPECT_EQ(bb_state_from_json(saved.dump().c_str()), nullptr);
+    EXPECT_NE(std::string(bb_last_error()).find("skill out of range"), std::string::npos) << bb_last_error();
+    bb_state_free(state);
+}
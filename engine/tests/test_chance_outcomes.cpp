@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "bb/chance_outcomes.h"
+#include "bb/action_resolver.h"
+#include "bb/block_odds.h"
+#include "bb/dice.h"
+#include "bb/game_state.h"
+
+using namespace bb;
+
+namespace {
+
+float total(const std::vector<ChanceOutcome>& outcomes) {
+    float sum = 0.0f;
+    for (const ChanceOutcome& o : outcomes) sum += o.probability;
+    return sum;
+}
+
+GameState makeBlockState() {
+    GameState state;
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.homeTeam.rerolls = 2;
+    state.homeTeam.turnNumber = 1;
+    state.awayTeam.turnNumber = 1;
+    state.weather = Weather::NICE;
+
+    Player& att = state.getPlayer(1);
+    att.id = 1;
+    att.teamSide = TeamSide::HOME;
+    att.state = PlayerState::STANDING;
+    att.position = {12, 7};
+    att.setStats({6, 3, 3, 8});
+
+    Player& def = state.getPlayer(12);
+    def.id = 12;
+    def.teamSide = TeamSide::AWAY;
+    def.state = PlayerState::STANDING;
+    def.position = {13, 7};
+    def.setStats({6, 3, 3, 8});
+
+    state.ball = BallState::onGround({3, 3});
+    return state;
+}
+
+} // anonymous namespace
+
+TEST(OutcomeDiceRoller, ServesScriptThenInner) {
+    const uint8_t script[3] = {6, 1, 4};
+    FixedDiceRoller inner({2, 5, 7});
+    OutcomeDiceRoller dice(script, 3, inner);
+    EXPECT_EQ(dice.rollD6(), 6);
+    EXPECT_EQ(dice.rollD6(), 1);
+    EXPECT_EQ(dice.consumed(), 2);
+    EXPECT_EQ(dice.rollD6(), 4);
+    EXPECT_EQ(dice.rollD6(), 2);
+    EXPECT_EQ(dice.rollD6(), 5);
+    EXPECT_EQ(dice.rollD8(), 7);
+    EXPECT_EQ(dice.consumed(), 3);
+}
+
+TEST(ChanceOutcomes, BlockClassesAndArmour) {
+    GameState state = makeBlockState();
+    DiceRoller fallback(3);
+    std::vector<ChanceOutcome> outcomes;
+    Action block{ActionType::BLOCK, 1, 12, {13, 7}};
+    ASSERT_TRUE(enumerateChanceOutcomes(state, block, fallback, outcomes));
+    EXPECT_NEAR(total(outcomes), 1.0f, 1e-5);
+
+    // DEFENDER_DOWN and ATTACKER_DOWN split on AV 8: broken on 9+, 10/36
+    const BlockOdds& odds = blockOdds(state, state.getPlayer(1), state.getPlayer(12), false);
+    std::vector<GameEvent> events;
+    float broken = 0.0f;
+    for (const ChanceOutcome& o : outcomes) {
+        GameState s = state.clone();
+        OutcomeDiceRoller dice(o.script, o.length, fallback);
+        events.clear();
+        executeAction(s, block, dice, &events);
+        EXPECT_EQ(dice.consumed(), o.length);
+        for (const GameEvent& e : events) {
+            if (e.type == GameEvent::Type::ARMOR_BREAK && e.playerId == 12 && e.success) {
+                broken += o.probability;
+            }
+        }
+    }
+    EXPECT_NEAR(broken, odds[BlockOutcome::DEFENDER_DOWN] * 10.0f / 36.0f, 1e-5);
+    // PUSHED, BOTH_DOWN and the two splits
+    EXPECT_EQ(outcomes.size(), 6u);
+
+    // Mighty Blow moves the split: broken on 8+, 15/36
+    state.getPlayer(1).addSkill(SkillName::MightyBlow);
+    ASSERT_TRUE(enumerateChanceOutcomes(state, block, fallback, outcomes));
+    float mightyBroken = 0.0f;
+    for (const ChanceOutcome& o : outcomes) {
+        if (o.length == 3 && o.script[0] >= 5 && o.script[1] + o.script[2] + 1 > 8) {
+            mightyBroken += o.probability;
+        }
+    }
+    EXPECT_NEAR(mightyBroken, odds[BlockOutcome::DEFENDER_DOWN] * 15.0f / 36.0f, 1e-5);
+}
+
+TEST(ChanceOutcomes, RerolledBlockScripts) {
+    // A bad face with a team reroll: the script rerolls into the same face
+    GameState state = makeBlockState();
+    state.getPlayer(12).setStats({6, 4, 3, 8});  // two dice, defender chooses
+    DiceRoller fallback(5);
+    std::vector<ChanceOutcome> outcomes;
+    Action block{ActionType::BLOCK, 1, 12, {13, 7}};
+    ASSERT_TRUE(enumerateChanceOutcomes(state, block, fallback, outcomes));
+    EXPECT_NEAR(total(outcomes), 1.0f, 1e-5);
+    bool sawReroll = false;
+    for (const ChanceOutcome& o : outcomes) {
+        if (o.script[0] == 1) {
+            sawReroll = true;
+            EXPECT_GE(o.length, 4);  // 2 dice, then 2 again
+        }
+    }
+    EXPECT_TRUE(sawReroll);
+
+    // Chainsaw is not tabled
+    state.getPlayer(1).addSkill(SkillName::Chainsaw);
+    EXPECT_FALSE(enumerateChanceOutcomes(state, block, fallback, outcomes));
+    EXPECT_TRUE(outcomes.empty());
+    EXPECT_FALSE(enumerateChanceOutcomes(state, Action{ActionType::MOVE, 1, -1, {11, 7}},
+                                         fallback, outcomes));
+}
+
+TEST(ChanceOutcomes, FoulBandsSplitOnDoubles) {
+    GameState state = makeBlockState();
+    state.getPlayer(12).state = PlayerState::PRONE;
+    DiceRoller fallback(9);
+    std::vector<ChanceOutcome> outcomes;
+    Action foul{ActionType::FOUL, 1, 12, {13, 7}};
+    ASSERT_TRUE(enumerateChanceOutcomes(state, foul, fallback, outcomes));
+    EXPECT_EQ(outcomes.size(), 4u);
+    EXPECT_NEAR(total(outcomes), 1.0f, 1e-5);
+    float doubles = 0.0f;
+    for (const ChanceOutcome& o : outcomes) {
+        ASSERT_EQ(o.length, 2);
+        if (o.script[0] == o.script[1]) doubles += o.probability;
+    }
+    EXPECT_NEAR(doubles, 1.0f / 6.0f, 1e-5);
+
+    // Sneaky Git: doubles do not matter
+    state.getPlayer(1).addSkill(SkillName::SneakyGit);
+    ASSERT_TRUE(enumerateChanceOutcomes(state, foul, fallback, outcomes));
+    EXPECT_EQ(outcomes.size(), 2u);
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include "bb/conv_network.h"
+#include "bb/game_simulator.h"
+#include "bb/leaf_eval_queue.h"
+#include "bb/roster.h"
+#include "bb/rules_engine.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+using namespace bb;
+
+namespace {
+
+std::vector<float> randomVector(std::mt19937& rng, size_t n, float scale) {
+    std::uniform_real_distribution<float> dist(-scale, scale);
+    std::vector<float> v(n);
+    for (float& x : v) x = dist(rng);
+    return v;
+}
+
+std::shared_ptr<const ConvNet> makeNet(int layers, int channels, int hidden, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<ConvLayer> trunk;
+    int in = NUM_BOARD_PLANES;
+    for (int l = 0; l < layers; ++l) {
+        ConvLayer layer;
+        layer.inChannels = in;
+        layer.outChannels = channels;
+        layer.weights = randomVector(rng, static_cast<size_t>(channels) * in * 9, 0.3f);
+        layer.bias = randomVector(rng, channels, 0.1f);
+        trunk.push_back(std::move(layer));
+        in = channels;
+    }
+    return std::make_shared<const ConvNet>(
+        std::move(trunk), randomVector(rng, static_cast<size_t>(hidden) * channels, 0.5f),
+        randomVector(rng, hidden, 0.1f), randomVector(rng, hidden, 0.5f), 0.05f,
+        randomVector(rng, static_cast<size_t>(CONV_POLICY_PLANES) * channels, 0.5f),
+        randomVector(rng, CONV_POLICY_PLANES, 0.1f));
+}
+
+// Straightforward zero-padded 3x3 conv + ReLU over [c][y][x] planes.
+std::vector<float> referenceLayer(const std::vector<float>& in, int inC, int outC,
+                                  const std::vector<float>& w, const std::vector<float>& b) {
+    const int H = BOARD_PLANE_HEIGHT, W = BOARD_PLANE_WIDTH;
+    std::vector<float> out(static_cast<size_t>(outC) * H * W);
+    for (int o = 0; o < outC; ++o) {
+        for (int y = 0; y < H; ++y) {
+            for (int x = 0; x < W; ++x) {
+                double s = b[o];
+                for (int i = 0; i < inC; ++i) {
+                    for (int ky = -1; ky <= 1; ++ky) {
+                        for (int kx = -1; kx <= 1; ++kx) {
+                            int yy = y + ky, xx = x + kx;
+                            if (yy < 0 || yy >= H || xx < 0 || xx >= W) continue;
+                            s += w[((o * inC + i) * 3 + (ky + 1)) * 3 + (kx + 1)] *
+                                 in[(i * H + yy) * W + xx];
+                        }
+                    }
+                }
+                out[(o * H + y) * W + x] = std::max(0.0f, static_cast<float>(s));
+            }
+        }
+    }
+    return out;
+}
+
+std::vector<GameState> randomPlayStates(int count) {
+    std::vector<GameState> states;
+    std::vector<Action> actions;
+    GameState gs;
+    DiceRoller dice(7);
+    setupHalf(gs, getOrcRoster(), getHumanRoster(), TeamSide::AWAY);
+    simpleKickoff(gs, dice);
+    while (static_cast<int>(states.size()) < count && gs.phase == GamePhase::PLAY) {
+        states.push_back(gs.clone());
+        getAvailableActions(gs, actions);
+        executeAction(gs, actions[dice.rollD6() * 31 % actions.size()], dice, nullptr);
+    }
+    return states;
+}
+
+} // namespace
+
+TEST(ConvNetwork, TrunkMatchesReferenceConvolution) {
+    // One layer, read back through a value head that pools a single
+    // channel: the value is then a function of that channel's board sum.
+    std::mt19937 rng(3);
+    ConvLayer layer;
+    layer.inChannels = NUM_BOARD_PLANES;
+    layer.outChannels = 4;
+    layer.weights = randomVector(rng, static_cast<size_t>(4) * NUM_BOARD_PLANES * 9, 0.4f);
+    layer.bias = randomVector(rng, 4, 0.2f);
+    std::vector<float> planes = randomVector(rng, CONV_INPUT_SIZE, 1.0f);
+    std::vector<float> ref = referenceLayer(planes, NUM_BOARD_PLANES, 4, layer.weights, layer.bias);
+
+    for (int c = 0; c < 4; ++c) {
+        std::vector<float> w1(4, 0.0f);
+        w1[c] = 1.0f;
+        ConvNet net({layer}, w1, {0.0f}, {1.0f}, 0.0f,
+                    std::vector<float>(CONV_POLICY_PLANES * 4, 0.0f),
+                    std::vector<float>(CONV_POLICY_PLANES, 0.0f));
+        double sum = 0.0;
+        for (int i = 0; i < BOARD_PLANE_SIZE; ++i) sum += ref[c * BOARD_PLANE_SIZE + i];
+        EXPECT_NEAR(net.value(planes.data()), sum / BOARD_PLANE_SIZE, 1e-4) << "channel " << c;
+    }
+}
+
+TEST(ConvNetwork, PolicyLogitsReadTheTargetSquare) {
+    // A single 1-channel identity layer: the policy map is the (ReLU'd)
+    // input plane 0, scaled by the action type's weight.
+    ConvLayer layer;
+    layer.inChannels = NUM_BOARD_PLANES;
+    layer.outChannels = 1;
+    layer.weights.assign(NUM_BOARD_PLANES * 9, 0.0f);
+    layer.weights[4] = 1.0f;  // centre tap of plane 0
+    layer.bias = {0.0f};
+    std::vector<float> pw(CONV_POLICY_PLANES, 2.0f), pb(CONV_POLICY_PLANES, 0.5f);
+    ConvNet net({layer}, {1.0f}, {0.0f}, {1.0f}, 0.0f, pw, pb);
+
+    std::vector<float> planes(CONV_INPUT_SIZE, 0.0f);
+    planes[7 * BOARD_PLANE_WIDTH + 20] = 1.0f;  // (20, 7) in perspective coordinates
+    Action actions[3];
+    actions[0] = {ActionType::MOVE, 1, -1, {20, 7}};
+    actions[1] = {ActionType::MOVE, 1, -1, {5, 7}};   // mirrored: (20, 7) for AWAY
+    actions[2] = {ActionType::END_TURN, -1, -1, {-1, -1}};
+    float home[3], away[3];
+    net.policyLogits(planes.data(), TeamSide::HOME, actions, 3, home);
+    net.policyLogits(planes.data(), TeamSide::AWAY, actions, 3, away);
+    EXPECT_FLOAT_EQ(home[0], 2.5f);
+    EXPECT_FLOAT_EQ(home[1], 0.5f);
+    EXPECT_FLOAT_EQ(away[0], 0.5f);
+    EXPECT_FLOAT_EQ(away[1], 2.5f);
+    // No target: the pooled plane (one set square of 390)
+    EXPECT_FLOAT_EQ(home[2], 0.5f + 2.0f / BOARD_PLANE_SIZE);
+}
+
+TEST(ConvNetwork, BatchMatchesSingleAndPriorsNormalise) {
+    auto net = makeNet(3, 8, 6, 11);
+    ConvValueFunction vf(net);
+    EXPECT_EQ(vf.inputSize(), CONV_INPUT_SIZE);
+
+    std::vector<GameState> states = randomPlayStates(12);
+    ASSERT_GE(states.size(), 4u);
+    int n = static_cast<int>(states.size());
+    std::vector<float> rows(static_cast<size_t>(n) * CONV_INPUT_SIZE);
+    for (int i = 0; i < n; ++i) {
+        vf.encodeState(states[i], states[i].activeTeam, &rows[static_cast<size_t>(i) * CONV_INPUT_SIZE]);
+    }
+    std::vector<float> batch(n);
+    vf.evaluateBatch(rows.data(), n, CONV_INPUT_SIZE, batch.data());
+    for (int i = 0; i < n; ++i) {
+        EXPECT_FLOAT_EQ(batch[i], vf.evaluateState(states[i], states[i].activeTeam));
+    }
+    EXPECT_THROW(vf.evaluate(rows.data(), NUM_FEATURES), std::invalid_argument);
+
+    // The leaf queue sizes its rows from the value function
+    LeafEvalQueue queue(&vf, 4);
+    int t = queue.push(states[1], states[1].activeTeam);
+    queue.flush();
+    EXPECT_FLOAT_EQ(queue.result(t), batch[1]);
+
+    ConvPolicyNetwork policy(net);
+    std::vector<Action> actions;
+    getAvailableActions(states[0], actions);
+    std::vector<float> priors(actions.size());
+    policy.computePriors(states[0], actions.data(), static_cast<int>(actions.size()), priors.data());
+    float sum = 0.0f;
+    for (float p : priors) {
+        EXPECT_GE(p, 0.0f);
+        sum += p;
+    }
+    EXPECT_NEAR(sum, 1.0f, 1e-5);
+}
+
+TEST(ConvNetwork, WeightsFileRoundTrip) {
+    auto net = makeNet(2, 6, 5, 21);
+    std::string path = (std::filesystem::temp_directory_path() / "bb_conv_test.bin").string();
+    ASSERT_TRUE(writeConvNet(path, *net));
+    EXPECT_TRUE(isConvNetFile(path));
+
+    auto vf = loadValueFunction(path);
+    ASSERT_NE(vf, nullptr);
+    ASSERT_NE(dynamic_cast<ConvValueFunction*>(vf.get()), nullptr);
+    std::vector<GameState> states = randomPlayStates(3);
+    for (const GameState& s : states) {
+        EXPECT_EQ(vf->evaluateState(s, TeamSide::HOME),
+                  ConvValueFunction(net).evaluateState(s, TeamSide::HOME));
+    }
+
+    // Truncated files are rejected
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+    EXPECT_EQ(loadConvNet(path), nullptr);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "bb/decision_capture.h"
+#include "bb/move_server.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+#include "bb/state_io.h"
+#include <filesystem>
+#include <future>
+
+using namespace bb;
+
+namespace {
+
+GameState makePlayState() {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getOrcRoster());
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.half = 1;
+    state.homeTeam.turnNumber = 1;
+    state.weather = Weather::NICE;
+    state.ball = BallState::onGround({13, 7});
+    return state;
+}
+
+MoveReply move(MoveServer& server, const std::string& tag, int iterations) {
+    MoveRequest r;
+    r.tag = tag;
+    r.state = makePlayState();
+    r.timeBudgetMs = 60000;
+    r.maxIterations = iterations;
+    std::promise<MoveReply> done;
+    EXPECT_NE(server.submit(std::move(r), [&done](const MoveReply& reply) { done.set_value(reply); }), 0u);
+    return done.get_future().get();
+}
+
+} // anonymous namespace
+
+TEST(DecisionCapture, ServerCapturesSlowSearchesForReplay) {
+    std::string dir = (std::filesystem::temp_directory_path() / "bb_slow_decisions").string();
+    std::filesystem::remove_all(dir);
+    MoveServerConfig config;
+    config.workers = 1;
+    config.search.explorationC = 0.9;
+    config.slowDecisions.dir = dir;
+    config.slowDecisions.thresholdMs = 1e-6;  // every search is slow
+    config.slowDecisions.maxCaptures = 2;
+    MoveServer server(config);
+
+    // The second search starts partway along the worker's dice
+    MoveReply first = move(server, "1", 150);
+    MoveReply second = move(server, "2", 200);
+    EXPECT_EQ(move(server, "3", 50).capture, "");  // over maxCaptures
+    ASSERT_FALSE(first.capture.empty());
+    ASSERT_FALSE(second.capture.empty());
+    EXPECT_NE(first.capture, second.capture);
+
+    std::optional<DecisionCapture> capture = loadDecisionCapture(second.capture);
+    ASSERT_TRUE(capture.has_value());
+    EXPECT_EQ(capture->state.hash(), makePlayState().hash());
+    EXPECT_DOUBLE_EQ(capture->config.explorationC, 0.9);
+    EXPECT_EQ(capture->config.maxIterations, 200);
+    EXPECT_EQ(capture->seed, 1u);
+    EXPECT_FALSE(capture->dice.empty());
+    EXPECT_EQ(capture->macro.type, second.macro.type);
+    EXPECT_EQ(capture->macro.playerId, second.macro.playerId);
+    EXPECT_EQ(capture->stats.iterations, second.iterations);
+    EXPECT_DOUBLE_EQ(capture->searchMs, second.searchMs);
+    EXPECT_EQ(capture->reusedVisits, 0);
+
+    // The replay is the captured search: same work, same choice
+    DecisionReplay replay = replayDecision(*capture, nullptr, nullptr);
+    EXPECT_TRUE(replay.sameMacro);
+    EXPECT_EQ(replay.iterations, second.iterations);
+    EXPECT_EQ(replay.stats.nodesAllocated, capture->stats.nodesAllocated);
+    EXPECT_EQ(replay.stats.leafEvals, capture->stats.leafEvals);
+    EXPECT_EQ(replay.stats.maxDepth, capture->stats.maxDepth);
+
+    // Without the captured dice it is only a search of the same position
+    DecisionCapture fresh = *capture;
+    fresh.dice.clear();
+    DecisionReplay other = replayDecision(fresh, nullptr, nullptr);
+    EXPECT_EQ(other.iterations, second.iterations);
+    EXPECT_TRUE(other.stats.leafEvals != replay.stats.leafEvals ||
+                other.stats.nodesAllocated != replay.stats.nodesAllocated ||
+                other.stats.maxDepth != replay.stats.maxDepth || !other.sameMacro);
+}
+
+TEST(DecisionCapture, MonitorFlagsThresholdsAndIterationOutliers) {
+    SlowDecisionConfig config;
+    EXPECT_FALSE(SlowDecisionMonitor(config).enabled());
+    config.dir = "unused";
+    EXPECT_FALSE(SlowDecisionMonitor(config).enabled());
+
+    config.outlierFactor = 3.0;
+    config.warmup = 4;
+    config.maxCaptures = 2;
+    SlowDecisionMonitor monitor(config);
+    EXPECT_EQ(monitor.observe(50.0, 100), "");  // warming up, however slow
+    for (int i = 0; i < 3; ++i) EXPECT_EQ(monitor.observe(10.0, 100), "");
+    // Mean 0.2 ms per iteration: 0.5 is within 3x, 1.0 beyond it
+    EXPECT_EQ(monitor.observe(50.0, 100), "");
+    EXPECT_NE(monitor.observe(100.0, 100), "");
+    EXPECT_EQ(monitor.observe(1000.0, 1000000), "");  // long but steady
+    config.thresholdMs = 500.0;
+    SlowDecisionMonitor both(config);
+    EXPECT_NE(both.observe(600.0, 1000000), "");
+    EXPECT_EQ(both.observe(400.0, 1000000), "");
+    EXPECT_NE(both.observe(700.0, 1000000), "");
+    EXPECT_EQ(both.observe(800.0, 1000000), "");  // maxCaptures reached
+    EXPECT_EQ(both.captures(), 2);
+}
+
+TEST(DecisionCapture, RejectsDamagedReproducers) {
+    DecisionCapture c;
+    c.state = makePlayState();
+    c.config.gumbelTopK = 8;
+    c.dice = serializeDice(FastDiceRoller(7));
+    c.modelKey = 0xfedcba9876543210ull;
+    c.macro.type = MacroType::BLITZ;
+    c.macro.playerId = 3;
+    c.macro.targetId = 15;
+    std::string json = decisionCaptureToJson(c);
+    std::optional<DecisionCapture> back = decisionCaptureFromJson(json);
+    ASSERT_TRUE(back.has_value());
+    EXPECT_EQ(back->config.gumbelTopK, 8);
+    EXPECT_EQ(back->dice, c.dice);
+    EXPECT_EQ(back->modelKey, c.modelKey);
+    EXPECT_EQ(back->macro.type, MacroType::BLITZ);
+    EXPECT_EQ(back->macro.targetId, 15);
+
+    EXPECT_FALSE(decisionCaptureFromJson("{").has_value());
+    std::string unknown = json;
+    unknown.replace(unknown.find("\"gumbelTopK\""), 12, "\"noSuchField\"");
+    EXPECT_FALSE(decisionCaptureFromJson(unknown).has_value());
+    std::string badDice = json;
+    badDice.replace(badDice.find("\"dice_b64\": \"") + 13, 4, "AAAA");
+    EXPECT_FALSE(decisionCaptureFromJson(badDice).has_value());
+    EXPECT_FALSE(loadDecisionCapture("/nonexistent/decision.json").has_value());
+}
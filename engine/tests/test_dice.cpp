@@ -66,3 +66,111 @@ TEST(DiceRoller, DeterministicWithSeed) {
         EXPECT_EQ(a.rollD6(), b.rollD6());
     }
 }
+
+TEST(FastDiceRoller, FacesInRangeAndUniform) {
+    FastDiceRoller roller(7);
+    int d6[7] = {}, d8[9] = {};
+    const int n = 60000;
+    for (int i = 0; i < n; ++i) {
+        int a = roller.rollD6(), b = roller.rollD8();
+        ASSERT_GE(a, 1);
+        ASSERT_LE(a, 6);
+        ASSERT_GE(b, 1);
+        ASSERT_LE(b, 8);
+        ++d6[a];
+        ++d8[b];
+    }
+    for (int f = 1; f <= 6; ++f) EXPECT_NEAR(d6[f], n / 6, n / 60);
+    for (int f = 1; f <= 8; ++f) EXPECT_NEAR(d8[f], n / 8, n / 80);
+}
+
+TEST(FastDiceRoller, StreamsReproducibleAndIndependent) {
+    FastDiceRoller a(42, 3, 1, 0), b(42, 3, 1, 0);
+    for (int i = 0; i < 50; ++i) EXPECT_EQ(a.next(), b.next());
+
+    // Any one coordinate changes the stream.
+    FastDiceRoller base(42, 3, 1, 0);
+    for (FastDiceRoller other : {FastDiceRoller(43, 3, 1, 0), FastDiceRoller(42, 4, 1, 0),
+                                 FastDiceRoller(42, 3, 2, 0), FastDiceRoller(42, 3, 1, 1)}) {
+        FastDiceRoller ref = base;
+        int same = 0;
+        for (int i = 0; i < 64; ++i) same += ref.next() == other.next();
+        EXPECT_EQ(same, 0);
+    }
+    EXPECT_LE(sizeof(FastDiceRoller), 48u);
+}
+
+TEST(BufferedDiceRoller, MatchesScalarLaneReference) {
+    // Reference: four scalar xoshiro256** lanes seeded like the roller,
+    // words interleaved lane by lane, bytes mapped to faces. A block is
+    // filled from 64-word chunks; the rest of the chunk that completes it
+    // is dropped.
+    Xoshiro256 seeder;
+    seeder.seed(99, 1, 2, 3);
+    Xoshiro256 lanes[BufferedDiceRoller::LANES];
+    for (auto& lane : lanes) {
+        for (auto& word : lane.s) word = seeder.next();
+    }
+    std::vector<int> expected;
+    for (int block = 0; block < 2; ++block) {
+        std::vector<int> faces;
+        while (faces.size() < BufferedDiceRoller::BLOCK) {
+            for (int round = 0; round < 64 / BufferedDiceRoller::LANES; ++round) {
+                for (auto& lane : lanes) {
+                    uint64_t w = lane.next();
+                    for (int b = 0; b < 8; ++b) {
+                        int byte = static_cast<int>((w >> (8 * b)) & 0xFF);
+                        if (byte < 252) faces.push_back(byte % 6 + 1);
+                    }
+                }
+            }
+        }
+        expected.insert(expected.end(), faces.begin(), faces.begin() + BufferedDiceRoller::BLOCK);
+    }
+
+    BufferedDiceRoller roller(99, 1, 2, 3);
+    for (int i = 0; i < 5000; ++i) ASSERT_EQ(roller.rollD6(), expected[i]) << i;  // crosses a refill
+}
+
+TEST(BufferedDiceRoller, FacesUniformAndCopiesContinueStream) {
+    BufferedDiceRoller roller(5);
+    int d6[7] = {}, d8[9] = {};
+    const int n = 60000;
+    for (int i = 0; i < n; ++i) {
+        ++d6[roller.rollD6()];
+        int b = roller.rollD8();
+        ASSERT_GE(b, 1);
+        ASSERT_LE(b, 8);
+        ++d8[b];
+    }
+    EXPECT_EQ(d6[0], 0);
+    for (int f = 1; f <= 6; ++f) EXPECT_NEAR(d6[f], n / 6, n / 60);
+    for (int f = 1; f <= 8; ++f) EXPECT_NEAR(d8[f], n / 8, n / 80);
+
+    BufferedDiceRoller copy = roller;
+    for (int i = 0; i < 10000; ++i) ASSERT_EQ(copy.rollD6(), roller.rollD6());
+    BufferedDiceRoller assigned(1);
+    assigned = roller;
+    for (int i = 0; i < 100; ++i) ASSERT_EQ(assigned.rollD8(), roller.rollD8());
+}
+
+TEST(FixedDiceRoller, RollIndexFromD6Digits) {
+    // n = 10 reads two d6 digits (0..35) and rejects draws >= 30
+    FixedDiceRoller dice({6, 6, 1, 2, 3, 4});
+    EXPECT_EQ(dice.rollIndex(10), 1);  // 35 rejected, then 0 * 6 + 1
+    EXPECT_EQ(dice.rollIndex(4), 2);   // one digit: 2 of 0..3 (4, 5 rejected)
+    EXPECT_EQ(dice.rollIndex(1), 0);
+    EXPECT_EQ(dice.remaining(), 1u);
+}
+
+TEST(FastDiceRoller, RollIndexInRange) {
+    FastDiceRoller dice(9);
+    int counts[7] = {};
+    for (int i = 0; i < 7000; ++i) {
+        int v = dice.rollIndex(7);
+        ASSERT_GE(v, 0);
+        ASSERT_LT(v, 7);
+        counts[v]++;
+    }
+    for (int c : counts) EXPECT_NEAR(c, 1000, 150);
+}
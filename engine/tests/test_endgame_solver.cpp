@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "bb/endgame_solver.h"
+#include "bb/macro_mcts.h"
+#include "bb/game_state.h"
+
+using namespace bb;
+
+namespace {
+
+// Home carrier two squares from the endzone on the home team's last turn,
+// one opponent far away
+GameState makeLastTurnState(int movement, int rerolls) {
+    GameState state;
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.half = 2;
+    state.homeTeam.turnNumber = 8;
+    state.homeTeam.rerolls = rerolls;
+    state.awayTeam.rerolls = 3;
+    state.weather = Weather::NICE;
+
+    Player& p1 = state.getPlayer(1);
+    p1.id = 1;
+    p1.teamSide = TeamSide::HOME;
+    p1.state = PlayerState::STANDING;
+    p1.position = {23, 7};
+    p1.setStats({6, 3, 3, 8});
+    p1.movementRemaining = static_cast<int8_t>(movement);
+
+    Player& p2 = state.getPlayer(12);
+    p2.id = 12;
+    p2.teamSide = TeamSide::AWAY;
+    p2.state = PlayerState::STANDING;
+    p2.position = {5, 7};
+    p2.setStats({6, 3, 3, 8});
+    p2.movementRemaining = 6;
+
+    state.ball = BallState::carried({23, 7}, 1);
+    return state;
+}
+
+const EndgameSolver::Line* findScore(const std::vector<EndgameSolver::Line>& lines) {
+    for (const auto& line : lines) {
+        if (line.macro.type == MacroType::SCORE) return &line;
+    }
+    return nullptr;
+}
+
+} // anonymous namespace
+
+TEST(EndgameSolver, AppliesOnTheLastTurnOnly) {
+    GameState state = makeLastTurnState(6, 0);
+    EXPECT_TRUE(EndgameSolver::applies(state));
+    state.homeTeam.turnNumber = 5;
+    EXPECT_FALSE(EndgameSolver::applies(state));
+    EXPECT_TRUE(EndgameSolver::isScoringMacro(MacroType::PASS_SCORE));
+    EXPECT_FALSE(EndgameSolver::isScoringMacro(MacroType::ADVANCE));
+}
+
+TEST(EndgameSolver, WalkInIsCertain) {
+    EndgameSolver solver;
+    auto lines = solver.solve(makeLastTurnState(6, 0));
+    const EndgameSolver::Line* score = findScore(lines);
+    ASSERT_NE(score, nullptr);
+    EXPECT_TRUE(score->exact);
+    EXPECT_DOUBLE_EQ(score->pTouchdown, 1.0);
+    EXPECT_EQ(lines[0].pTouchdown, 1.0);
+}
+
+TEST(EndgameSolver, GoingForItWithAndWithoutAReroll) {
+    // One square of movement left: the second square is a 2+ GFI
+    EndgameSolver solver;
+    const EndgameSolver::Line* score = nullptr;
+    auto lines = solver.solve(makeLastTurnState(1, 0));
+    score = findScore(lines);
+    ASSERT_NE(score, nullptr);
+    EXPECT_TRUE(score->exact);
+    EXPECT_NEAR(score->pTouchdown, 5.0 / 6.0, 1e-9);
+
+    // The engine rerolls a failed GFI itself
+    lines = solver.solve(makeLastTurnState(1, 2));
+    score = findScore(lines);
+    ASSERT_NE(score, nullptr);
+    EXPECT_NEAR(score->pTouchdown, 35.0 / 36.0, 1e-9);
+    EXPECT_GT(solver.lastReplays(), 6);
+}
+
+TEST(EndgameSolver, ReplayCapGivesBounds) {
+    EndgameSolver::Config config;
+    config.maxReplays = 3;
+    EndgameSolver solver(config);
+    auto lines = solver.solve(makeLastTurnState(1, 2));
+    const EndgameSolver::Line* score = findScore(lines);
+    ASSERT_NE(score, nullptr);
+    EXPECT_FALSE(score->exact);
+    EXPECT_LT(score->pTouchdown, 35.0 / 36.0);
+    EXPECT_GE(score->pUpper, 35.0 / 36.0 - 1e-12);
+    EXPECT_LE(solver.lastReplays(), 3);
+}
+
+TEST(EndgameSolver, SettlesTheMacroSearch) {
+    GameState state = makeLastTurnState(6, 0);
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 200;
+    config.endgameSolver = true;
+    MacroMCTSSearch search(nullptr, config, 1);
+    Macro best = search.search(state);
+    EXPECT_EQ(best.type, MacroType::SCORE);
+    EXPECT_TRUE(search.lastSolved());
+    EXPECT_EQ(search.lastIterations(), 0);
+    EXPECT_DOUBLE_EQ(search.lastBestValue(), 1.0);
+    ASSERT_FALSE(search.lastChildVisits().empty());
+    EXPECT_FLOAT_EQ(search.lastChildVisits()[0].target, 1.0f);
+
+    // Not the last turn: an ordinary search
+    state.homeTeam.turnNumber = 3;
+    search.search(state);
+    EXPECT_FALSE(search.lastSolved());
+    EXPECT_GT(search.lastIterations(), 0);
+}
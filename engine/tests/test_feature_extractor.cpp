@@ -4,7 +4,11 @@
 #include "bb/roster.h"
 #include "bb/game_simulator.h"
 #include "bb/helpers.h"
+#include "bb/rules_engine.h"
+#include "bb/action_resolver.h"
 #include <cmath>
+#include <cstring>
+#include <vector>
 
 using namespace bb;
 
@@ -167,7 +171,7 @@ TEST(FeatureExtractor, CarrierDistanceToTouchdown) {
     p.teamSide = TeamSide::HOME;
     p.state = PlayerState::STANDING;
     p.position = {20, 7};
-    p.stats = {6, 3, 3, 8};
+    p.setStats({6, 3, 3, 8});
 
     state.ball = BallState::carried({20, 7}, 1);
 
@@ -265,7 +269,7 @@ TEST(FeatureExtractor, ScoringThreat) {
     p.teamSide = TeamSide::HOME;
     p.state = PlayerState::STANDING;
     p.position = {22, 7};
-    p.stats = {6, 3, 3, 8};
+    p.setStats({6, 3, 3, 8});
 
     state.ball = BallState::carried({22, 7}, 1);
 
@@ -277,3 +281,65 @@ TEST(FeatureExtractor, ScoringThreat) {
     // Carrier near endzone (dist <= 3)
     EXPECT_NEAR(features[34], 1.0f, 0.001f);
 }
+
+TEST(FeatureExtractor, BatchMatchesScalar) {
+    // Random play over several rosters, from both perspectives
+    std::vector<GameState> states;
+    std::vector<TeamSide> persp;
+    std::vector<Action> actions;
+    const TeamRoster* rosters[] = {&getHumanRoster(), &getOrcRoster(), &getSkavenRoster(),
+                                   &getWoodElfRoster()};
+    for (uint32_t seed = 1; seed <= 8; ++seed) {
+        GameState gs;
+        DiceRoller dice(seed);
+        setupHalf(gs, *rosters[seed % 4], *rosters[(seed + 1) % 4], TeamSide::AWAY);
+        simpleKickoff(gs, dice);
+        for (int step = 0; step < 30 && gs.phase == GamePhase::PLAY; ++step) {
+            states.push_back(gs.clone());
+            persp.push_back(step % 3 ? gs.activeTeam : opponent(gs.activeTeam));
+            getAvailableActions(gs, actions);
+            executeAction(gs, actions[dice.rollD6() * 31 % actions.size()], dice, nullptr);
+        }
+    }
+    ASSERT_GT(states.size(), 100u);
+
+    int n = static_cast<int>(states.size());
+    std::vector<float> batch(static_cast<size_t>(n) * NUM_FEATURES);
+    extractFeaturesBatch(states.data(), n, persp.data(), batch.data());
+    for (int i = 0; i < n; ++i) {
+        float scalar[NUM_FEATURES];
+        extractFeatures(states[i], persp[i], scalar);
+        ASSERT_EQ(std::memcmp(scalar, &batch[static_cast<size_t>(i) * NUM_FEATURES], sizeof(scalar)), 0)
+            << "state " << i;
+    }
+}
+
+TEST(FeatureExtractor, IncrementalAggregatesMatchRebuild) {
+    // Random play keeps the mutators' FeatureAccumulator in step with a
+    // from-scratch rebuild, so extracted features are unchanged
+    std::vector<Action> actions;
+    const TeamRoster* rosters[] = {&getHumanRoster(), &getOrcRoster(), &getSkavenRoster(),
+                                   &getWoodElfRoster()};
+    int checked = 0;
+    for (uint32_t seed = 1; seed <= 8; ++seed) {
+        GameState gs;
+        DiceRoller dice(seed);
+        setupHalf(gs, *rosters[seed % 4], *rosters[(seed + 3) % 4], TeamSide::AWAY);
+        simpleKickoff(gs, dice);
+        for (int step = 0; step < 60 && gs.phase == GamePhase::PLAY; ++step, ++checked) {
+            GameState rebuilt = gs.clone();
+            rebuilt.invalidateOccupancy();
+            for (TeamSide side : {TeamSide::HOME, TeamSide::AWAY}) {
+                ASSERT_TRUE(gs.featureAccumulator(side) == rebuilt.featureAccumulator(side))
+                    << "seed " << seed << " step " << step;
+                float incremental[NUM_FEATURES], scratch[NUM_FEATURES];
+                extractFeatures(gs, side, incremental);
+                extractFeatures(rebuilt, side, scratch);
+                ASSERT_EQ(std::memcmp(incremental, scratch, sizeof(scratch)), 0);
+            }
+            getAvailableActions(gs, actions);
+            executeAction(gs, actions[dice.rollD6() * 31 % actions.size()], dice, nullptr);
+        }
+    }
+    EXPECT_GT(checked, 200);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "bb/feature_sets.h"
+#include "bb/board_planes.h"
+#include "bb/feature_extractor.h"
+#include "bb/roster.h"
+#include <algorithm>
+
+using namespace bb;
+
+TEST(FeatureSets, BuiltInsAndRegisteredSetsAreFound) {
+    auto features = findFeatureSet("features");
+    ASSERT_NE(features, nullptr);
+    EXPECT_EQ(features->size, NUM_FEATURES);
+    ASSERT_NE(findFeatureSet("board_planes"), nullptr);
+    EXPECT_EQ(findFeatureSet("board_planes")->size, NUM_BOARD_PLANES * BOARD_PLANE_SIZE);
+    EXPECT_EQ(findFeatureSet("no_such_set"), nullptr);
+
+    registerFeatureSet({"test_ball_x", 1, [](const GameState& s, TeamSide, float* out) {
+        out[0] = s.ball.position.x;
+    }});
+    auto names = featureSetNames();
+    EXPECT_NE(std::find(names.begin(), names.end(), "test_ball_x"), names.end());
+    EXPECT_THROW(registerFeatureSet({"", 1, nullptr}), std::invalid_argument);
+    EXPECT_THROW(registerFeatureSet({"bad", 0, extractFeatures}), std::invalid_argument);
+}
+
+TEST(FeatureSets, FeaturizesLoggedBoardsOnAnyNumberOfThreads) {
+    const TeamRoster& home = getHumanRoster();
+    const TeamRoster& away = getOrcRoster();
+    DiceRoller dice(8);
+    auto policy = [&dice](const GameState& s) { return randomPolicy(s, dice); };
+    GameLogColumns columns = toColumns(simulateGameLogged(home, away, policy, policy, dice));
+    BoardColumnsView view = BoardColumnsView::of(columns.turnBoards);
+    ASSERT_GT(view.boards, 10u);
+
+    // Context from each turn's header row
+    std::vector<SnapshotContext> contexts;
+    std::vector<TeamSide> perspectives;
+    for (size_t t = 0; t < view.boards; ++t) {
+        const int16_t* row = &columns.turns[t * GameLogColumns::TURN_COLS];
+        SnapshotContext c;
+        c.half = row[0];
+        c.activeTeam = row[2] ? TeamSide::AWAY : TeamSide::HOME;
+        (row[2] ? c.awayTurn : c.homeTurn) = row[1];
+        c.homeScore = row[3];
+        c.awayScore = row[4];
+        contexts.push_back(c);
+        perspectives.push_back(c.activeTeam);
+    }
+
+    const FeatureSet& set = *findFeatureSet("features");
+    std::vector<float> single(view.boards * NUM_FEATURES), pooled(view.boards * NUM_FEATURES);
+    featurizeBoards(set, view, contexts, perspectives, home, away, 1, single.data());
+    featurizeBoards(set, view, contexts, perspectives, home, away, 4, pooled.data());
+    EXPECT_EQ(single, pooled);
+
+    size_t k = view.boards / 2;
+    float expected[NUM_FEATURES];
+    extractFeatures(stateFromSnapshot(view.compact(k), home, away, contexts[k]), perspectives[k], expected);
+    for (int f = 0; f < NUM_FEATURES; ++f) EXPECT_EQ(single[k * NUM_FEATURES + f], expected[f]);
+
+    EXPECT_THROW(featurizeBoards(set, view, {contexts[0], contexts[1]}, perspectives, home, away, 1,
+                                 single.data()),
+                 std::invalid_argument);
+    columns.turnBoards.players[1] = 30;  // no such player id
+    EXPECT_THROW(featurizeBoards(set, view, contexts, perspectives, home, away, 1, single.data()),
+                 std::invalid_argument);
+}
@@ -10,8 +10,8 @@ static void placePlayer(GameState& gs, int id, Position pos, TeamSide side,
     Player& p = gs.getPlayer(id);
     p.state = PlayerState::STANDING;
     p.position = pos;
-    p.stats = {static_cast<int8_t>(ma), static_cast<int8_t>(st),
-               static_cast<int8_t>(ag), static_cast<int8_t>(av)};
+    p.setStats({static_cast<int8_t>(ma), static_cast<int8_t>(st),
+                static_cast<int8_t>(ag), static_cast<int8_t>(av)});
     p.movementRemaining = ma;
 }
 
@@ -44,7 +44,7 @@ TEST(FoulHandler, FoulBreaksArmour) {
 TEST(FoulHandler, DirtyPlayerBonus) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::DirtyPlayer);
+    gs.getPlayer(1).addSkill(SkillName::DirtyPlayer);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
     gs.getPlayer(12).state = PlayerState::PRONE;
     // Armor: 4+4+1(DP)=9 > 8, broken. Injury: 3+3=6 → stunned
@@ -67,7 +67,7 @@ TEST(FoulHandler, DoublesEjection) {
 TEST(FoulHandler, SneakyGitPreventsEjection) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::SneakyGit);
+    gs.getPlayer(1).addSkill(SkillName::SneakyGit);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
     gs.getPlayer(12).state = PlayerState::PRONE;
     // Armor: 3+3=6 (doubles), not broken. SneakyGit prevents ejection.
@@ -152,7 +152,7 @@ TEST(FoulHandler, FoulDecayTakesWorseRoll) {
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
     gs.getPlayer(12).state = PlayerState::PRONE;
-    gs.getPlayer(12).skills.add(SkillName::Decay);
+    gs.getPlayer(12).addSkill(SkillName::Decay);
     // Armor: 5+4=9 > 8, broken. Injury roll 1: 3+3=6 (stunned).
     // Decay roll 2: 5+4=9 (KO). Takes worse: 9 → KO.
     FixedDiceRoller dice({5, 4, 3, 3, 5, 4});
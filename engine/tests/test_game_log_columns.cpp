@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include "bb/game_log_columns.h"
+#include "bb/roster.h"
+
+using namespace bb;
+
+TEST(GameLogColumns, StatesAndTurnsMatchLoggedGame) {
+    DiceRoller dice(5);
+    auto policy = [&dice](const GameState& s) { return randomPolicy(s, dice); };
+    LoggedGameResult logged = simulateGameLogged(getHumanRoster(), getOrcRoster(),
+                                                 policy, policy, dice);
+    ASSERT_FALSE(logged.states.empty());
+    GameLogColumns c = toColumns(logged);
+
+    ASSERT_EQ(c.numStates(), logged.states.size());
+    ASSERT_EQ(c.stateFeatures.size(), logged.states.size() * NUM_FEATURES);
+    size_t last = logged.states.size() - 1;
+    EXPECT_EQ(c.stateFeatures[last * NUM_FEATURES + 3], logged.states[last].features[3]);
+    EXPECT_EQ(c.statePerspective[last], logged.states[last].perspective == TeamSide::HOME ? 0 : 1);
+    EXPECT_EQ(c.numDecisions(), 0u);
+    EXPECT_EQ(c.visitOffsets, std::vector<int32_t>{0});
+
+    ASSERT_EQ(c.numTurns(), logged.turnLogs.size());
+    ASSERT_EQ(c.turns.size(), logged.turnLogs.size() * GameLogColumns::TURN_COLS);
+    size_t events = 0, players = 0;
+    for (size_t t = 0; t < logged.turnLogs.size(); ++t) {
+        const TurnLog& turn = logged.turnLogs[t];
+        const int16_t* row = &c.turns[t * GameLogColumns::TURN_COLS];
+        EXPECT_EQ(row[1], turn.turnNumber);
+        EXPECT_EQ(row[3], turn.homeScore);
+        EXPECT_EQ(c.eventOffsets[t], static_cast<int32_t>(events));
+        EXPECT_EQ(c.turnBoards.playerOffsets[t], static_cast<int32_t>(players));
+        EXPECT_EQ(c.turnBoards.ball[t * BoardColumns::BALL_COLS], turn.ballX);
+        EXPECT_EQ(turn.firstEvent, events);
+        events += turn.numEvents;
+        players += turn.homePlayers.size() + turn.awayPlayers.size();
+    }
+    EXPECT_EQ(events, logged.events.size());
+    EXPECT_EQ(c.events.size(), events * GameLogColumns::EVENT_COLS);
+    EXPECT_EQ(c.turnBoards.players.size(), players * BoardColumns::PLAYER_COLS);
+}
+
+TEST(GameLogColumns, DecisionVisitsFlattenedWithOffsets) {
+    LoggedGameResult logged;
+    for (int k = 0; k < 2; ++k) {
+        PolicyDecision d{};
+        d.stateFeatures[0] = static_cast<float>(k + 1);
+        d.perspective = k == 0 ? TeamSide::HOME : TeamSide::AWAY;
+        d.stateHash = 100 + k;
+        for (int v = 0; v < k + 2; ++v) {
+            PolicyDecision::ActionVisit visit{};
+            visit.actionFeatures[1] = static_cast<float>(v);
+            visit.visitFraction = 0.1f * static_cast<float>(v + 1);
+            d.visits.push_back(visit);
+        }
+        CompactPlayerSnapshot& p = d.board.players[0];
+        p.id = static_cast<uint8_t>(7 + k);
+        p.x = 3;
+        p.y = 4;
+        p.flags = k == 1 ? 4 : 0;
+        (k == 0 ? d.board.numHome : d.board.numAway) = 1;
+        d.board.captured = true;
+        d.board.ballX = 3;
+        d.board.ballCarrierId = static_cast<int8_t>(k == 1 ? p.id : -1);
+        logged.policyDecisions.push_back(d);
+    }
+
+    GameLogColumns c = toColumns(logged);
+    ASSERT_EQ(c.numDecisions(), 2u);
+    EXPECT_EQ(c.visitOffsets, (std::vector<int32_t>{0, 2, 5}));
+    EXPECT_EQ(c.visitFractions.size(), 5u);
+    EXPECT_FLOAT_EQ(c.visitFractions[4], 0.3f);
+    EXPECT_FLOAT_EQ(c.visitActionFeatures[4 * NUM_ACTION_FEATURES + 1], 2.0f);
+    EXPECT_FLOAT_EQ(c.decisionFeatures[NUM_FEATURES], 2.0f);
+    EXPECT_EQ(c.decisionPerspective, (std::vector<uint8_t>{0, 1}));
+    EXPECT_EQ(c.decisionHash[1], 101u);
+
+    EXPECT_EQ(c.decisionBoards.playerOffsets, (std::vector<int32_t>{0, 1, 2}));
+    const int8_t* away = &c.decisionBoards.players[BoardColumns::PLAYER_COLS];
+    EXPECT_EQ(away[0], 1);  // side
+    EXPECT_EQ(away[1], 8);  // id
+    EXPECT_EQ(away[5], 1);  // has_ball
+    EXPECT_EQ(c.decisionBoards.ball[BoardColumns::BALL_COLS + 3], 8);
+    EXPECT_EQ(c.numTurns(), 0u);
+}
@@ -3,6 +3,7 @@
 #include "bb/kickoff_handler.h"
 #include "bb/roster.h"
 #include "bb/policies.h"
+#include "bb/macro_mcts.h"
 #include "bb/dice.h"
 #include <set>
 
@@ -114,6 +115,164 @@ TEST(GameSimulator, RandomVsRandomCompletes) {
     EXPECT_LE(result.totalActions, 5000);
 }
 
+TEST(GameSimulator, PoliciesReadThePublishedMoveList) {
+    // Every decision handed to a policy carries the loop's own move list
+    DiceRoller dice(7);
+    int decisions = 0, published = 0;
+    auto policy = [&](const GameState& s) {
+        ++decisions;
+        if (PublishedActions::find(s)) ++published;
+        return randomPolicy(s, dice);
+    };
+    simulateGame(getHumanRoster(), getOrcRoster(), policy, policy, dice);
+    EXPECT_GT(decisions, 0);
+    EXPECT_EQ(published, decisions);
+
+    simulateGameLogged(getHumanRoster(), getOrcRoster(), policy, policy,
+                       dice, false, GameLogMode::RECORD_ONLY);
+    EXPECT_EQ(published, decisions);
+    EXPECT_EQ(PublishedActions::find(GameState{}), nullptr);
+}
+
+TEST(GameSimulator, LogsWhichDecisionsWereFullSearches) {
+    // Playout-cap randomization: a quarter of the searches get the full
+    // budget and only those are logged as policy targets
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 24;
+    config.cheapSearchIterations = 3;
+    config.fullSearchFraction = 0.25f;
+    MacroMCTSPolicy macro(nullptr, config, 5);
+    macro.setLogDecisions(true, 10, false);
+    DiceRoller dice(5);
+    std::vector<int> iterations;
+    ActionSelector home = [&](const GameState& s) {
+        int before = macro.searches();
+        Action a = macro(s);
+        if (macro.searches() > before) iterations.push_back(macro.lastIterations());
+        return a;
+    };
+    ActionSelector away = [&](const GameState& s) { return randomPolicy(s, dice); };
+    LoggedGameResult logged = simulateGameLogged(getHumanRoster(), getOrcRoster(), home, away,
+                                                 dice, false, GameLogMode::RECORD_ONLY);
+
+    ASSERT_EQ(logged.decisionSearches.size(), logged.record.actions.size());
+    size_t full = 0, cheap = 0;
+    for (DecisionSearch kind : logged.decisionSearches) {
+        if (kind == DecisionSearch::NONE) continue;  // away's, or a step of a searched plan
+        ASSERT_LT(full + cheap, iterations.size());
+        EXPECT_LE(iterations[full + cheap], kind == DecisionSearch::FULL ? 24 : 3);
+        ++(kind == DecisionSearch::FULL ? full : cheap);
+    }
+    EXPECT_EQ(full + cheap, iterations.size());
+    EXPECT_GT(full, 0u);
+    EXPECT_GT(cheap, full);
+    EXPECT_LE(macro.decisions().size(), full);
+    EXPECT_GT(macro.decisions().size(), 0u);
+
+    // The low-level policy: every search is full by default, none at 0
+    GameState state;
+    state.kickingTeam = TeamSide::AWAY;
+    setupHalf(state, getHumanRoster(), getOrcRoster());
+    simpleKickoff(state, dice);
+    for (float fraction : {1.0f, 0.0f}) {
+        MCTSConfig lowLevel = config;
+        lowLevel.fullSearchFraction = fraction;
+        MCTSPolicy mcts(nullptr, lowLevel, 5);
+        mcts.setLogDecisions(true, 10, false);
+        DecisionSearchScope scope;
+        mcts(state);
+        bool isFull = fraction == 1.0f;
+        EXPECT_EQ(scope.kind(), isFull ? DecisionSearch::FULL : DecisionSearch::CHEAP);
+        EXPECT_EQ(mcts.lastIterations(), isFull ? 24 : 3);
+        EXPECT_EQ(mcts.decisions().size(), isFull ? 1u : 0u);
+    }
+}
+
+TEST(GameSimulator, TouchdownBoundCoversTheRestOfTheGame) {
+    GameState state;
+    state.half = 2;
+    state.homeTeam.turnNumber = 8;
+    state.awayTeam.turnNumber = 8;
+    EXPECT_EQ(maxTouchdownsLeft(state), 2);
+    state.homeTeam.score = 2;
+    EXPECT_FALSE(outcomeDecided(state));
+    state.homeTeam.score = 3;
+    EXPECT_TRUE(outcomeDecided(state));
+    state.half = 1;
+    EXPECT_FALSE(outcomeDecided(state));
+
+    // The bound holds at every decision of real games
+    for (uint32_t seed = 1; seed <= 12; ++seed) {
+        DiceRoller dice(seed);
+        std::vector<std::pair<int, int>> seen;  // (touchdowns so far, bound)
+        auto policy = [&](const GameState& s) {
+            seen.push_back({s.homeTeam.score + s.awayTeam.score, maxTouchdownsLeft(s)});
+            return greedyPolicy(s, dice);
+        };
+        GameResult r = simulateGame(getHumanRoster(), getSkavenRoster(), policy, policy, dice);
+        for (const auto& [scored, bound] : seen) {
+            EXPECT_LE(r.homeScore + r.awayScore - scored, bound) << "seed " << seed;
+        }
+    }
+}
+
+TEST(GameSimulator, AdjudicationStopsSettledGames) {
+    // Greedy against a side that only ends its turns
+    DiceRoller greedyDice(0);
+    auto passive = [&](const GameState& s) {
+        for (const Action& a : *PublishedActions::find(s)) {
+            if (a.type == ActionType::END_TURN) return a;
+        }
+        return randomPolicy(s, greedyDice);
+    };
+    auto greedy = [&](const GameState& s) { return greedyPolicy(s, greedyDice); };
+
+    // A second half with a 7-0 lead: one more round of turns settles it
+    GameState start;
+    start.half = 2;
+    setupHalf(start, getHumanRoster(), getHumanRoster());
+    DiceRoller kick(1);
+    simpleKickoff(start, kick);
+    start.homeTeam.turnNumber = 6;
+    start.awayTeam.turnNumber = 5;
+    start.homeTeam.score = 7;
+    EXPECT_FALSE(outcomeDecided(start));
+
+    GameState played = start, stopped = start;
+    DiceRoller fullDice(3), shortDice(3);
+    GameResult full = continueGame(played, getHumanRoster(), getHumanRoster(), greedy, passive, fullDice,
+                                   PlayUntil::GAME_END);
+    GameResult early = continueGame(stopped, getHumanRoster(), getHumanRoster(), greedy, passive, shortDice,
+                                    PlayUntil::GAME_END, false, true);
+    EXPECT_FALSE(full.adjudicated);
+    EXPECT_EQ(played.phase, GamePhase::GAME_OVER);
+    EXPECT_TRUE(early.adjudicated);
+    EXPECT_TRUE(outcomeDecided(stopped));
+    EXPECT_GT(early.totalActions, 0);
+    EXPECT_LT(early.totalActions, full.totalActions);
+    EXPECT_GT(full.homeScore, full.awayScore);
+    EXPECT_GT(early.homeScore, early.awayScore);
+
+    // Not with the full kickoff, whose Riot can add turns
+    GameState riot = start;
+    riot.homeTeam.score = 20;
+    DiceRoller riotDice(3);
+    GameResult played20 = continueGame(riot, getHumanRoster(), getHumanRoster(), greedy, passive, riotDice,
+                                       PlayUntil::GAME_END, true, true);
+    EXPECT_FALSE(played20.adjudicated);
+
+    // A logged game records it, and its replay stops at the same place
+    DiceRoller dice(2);
+    LoggedGameResult logged = simulateGameLogged(getHumanRoster(), getHumanRoster(), greedy, passive,
+                                                 dice, false, GameLogMode::RECORD_ONLY, true);
+    EXPECT_TRUE(logged.record.adjudicate);
+    LoggedGameResult replayed = replayGame(logged.record);
+    EXPECT_EQ(replayed.result.adjudicated, logged.result.adjudicated);
+    EXPECT_EQ(replayed.result.totalActions, logged.result.totalActions);
+    EXPECT_EQ(replayed.result.homeScore, logged.result.homeScore);
+}
+
 TEST(GameSimulator, MaxActionsLimitWorks) {
     // The game loop should stop at 5000 actions max
     DiceRoller dice(123);
@@ -173,6 +332,37 @@ TEST(GameSimulator, GetRosterByNameWorks) {
     EXPECT_EQ(getRosterByName("invalid"), nullptr);
 }
 
+TEST(GameSimulator, RosterRegistryRoundTripsIdsAndKeys) {
+    ASSERT_EQ(rosterCount(), 31);
+    EXPECT_EQ(rosterById(0), &getHumanRoster());
+    EXPECT_EQ(rosterById(25), &getChaosPactRoster());
+    EXPECT_EQ(rosterById(static_cast<RosterId>(rosterCount())), nullptr);
+    for (int i = 0; i < rosterCount(); ++i) {
+        RosterId id = static_cast<RosterId>(i);
+        const TeamRoster* r = rosterById(id);
+        ASSERT_NE(r, nullptr);
+        EXPECT_EQ(rosterIdOf(*r), id);
+        EXPECT_EQ(findRosterId(rosterKey(id)), id);
+        EXPECT_EQ(findRosterId(r->name), id);
+    }
+    EXPECT_EQ(std::string(rosterKey(findRosterId("Wood Elf"))), "woodelf");
+    EXPECT_EQ(rosterById(findRosterId("Orc (TV1200)")), getDevelopedRoster("orc", 1200));
+    EXPECT_EQ(findRosterId("invalid"), INVALID_ROSTER);
+    EXPECT_EQ(std::string(rosterKey(INVALID_ROSTER)), "");
+
+    TeamRoster copy = getHumanRoster();
+    EXPECT_EQ(rosterIdOf(copy), 0);
+    copy.positionals[0].stats.strength = 4;  // edited: no longer the built-in roster
+    EXPECT_EQ(rosterIdOf(copy), INVALID_ROSTER);
+
+    PositionalId blitzer = makePositionalId(rosterIdOf(getHumanRoster()), 3);
+    EXPECT_EQ(positionalRoster(blitzer), 0);
+    EXPECT_EQ(positionalSlot(blitzer), 3);
+    EXPECT_EQ(positionalById(blitzer), &getHumanRoster().positionals[3]);
+    EXPECT_EQ(positionalById(makePositionalId(0, 7)), nullptr);  // humans have 5 positionals
+    EXPECT_EQ(positionalById(INVALID_POSITIONAL), nullptr);
+}
+
 TEST(GameSimulator, AllRostersHaveValidPositionals) {
     const char* names[] = {
         "human", "orc", "skaven", "dwarf", "wood-elf", "chaos",
@@ -746,7 +936,7 @@ TEST(DevelopedRoster, HumanOgreBlockAndStripBall) {
     // Ogre (ST5) is fielded with Block.
     bool ogreHasBlock = false;
     state.forEachPlayer(TeamSide::HOME, [&](const Player& p) {
-        if (p.isOnPitch() && p.stats.strength == 5 && p.hasSkill(SkillName::Block)) {
+        if (p.isOnPitch() && p.stats().strength == 5 && p.hasSkill(SkillName::Block)) {
             ogreHasBlock = true;
         }
     });
@@ -793,3 +983,62 @@ TEST(DevelopedRoster, BelowTVFallsBackToBase) {
     ASSERT_NE(base, nullptr);
     EXPECT_STREQ(base->name, "Orc");
 }
+
+TEST(GameSimulator, SetupFormationsAreCachedPerRoster) {
+    // A cached formation is replayed exactly, Kick following the kicking side
+    GameState first;
+    setupHalf(first, getHumanRoster(), getOrcRoster(), TeamSide::AWAY);
+    GameState again;
+    setupHalf(again, getHumanRoster(), getOrcRoster(), TeamSide::AWAY);
+    for (int id = 1; id <= 22; ++id) {
+        EXPECT_EQ(first.getPlayer(id).position, again.getPlayer(id).position);
+        EXPECT_EQ(first.getPlayer(id).profile, again.getPlayer(id).profile);
+    }
+    EXPECT_TRUE(first.getPlayer(22).hasSkill(SkillName::Kick));
+    setupDrive(again, getHumanRoster(), getOrcRoster(), TeamSide::HOME);
+    EXPECT_TRUE(again.getPlayer(11).hasSkill(SkillName::Kick));
+    EXPECT_FALSE(again.getPlayer(22).hasSkill(SkillName::Kick));
+
+    // A roster edited in place is not served the old formation
+    TeamRoster roster = getHumanRoster();
+    GameState before;
+    setupHalf(before, roster, getOrcRoster());
+    roster.positionals[1].stats.movement = 9;  // catchers fill the back slots
+    GameState after;
+    setupHalf(after, roster, getOrcRoster());
+    EXPECT_EQ(before.getPlayer(11).stats().movement, 8);
+    EXPECT_EQ(after.getPlayer(11).stats().movement, 9);
+}
+
+TEST(GameSimulator, LearningPolicyPicksBestSuccessor) {
+    // The batched evaluation picks what one-at-a-time evaluation would
+    GameState state;
+    setupHalf(state, getHumanRoster(), getOrcRoster());
+    DiceRoller kick(3);
+    simpleKickoff(state, kick);
+    std::vector<float> weights(NUM_FEATURES, 0.0f);
+    for (int i = 0; i < NUM_FEATURES; ++i) weights[i] = 0.01f * static_cast<float>((i * 5) % 11 - 5);
+    LinearValueFunction vf(weights);
+
+    std::vector<Action> actions;
+    getAvailableActions(state, actions);
+    ASSERT_GT(actions.size(), 1u);
+    float bestValue = -1e9f;
+    size_t best = 0;
+    for (size_t i = 0; i < actions.size(); ++i) {
+        GameState next = state.clone();
+        DiceRoller simDice(static_cast<uint32_t>(i * 31 + 17));
+        executeAction(next, actions[i], simDice, nullptr);
+        float value = vf.evaluateState(next, state.activeTeam);
+        if (value > bestValue) {
+            bestValue = value;
+            best = i;
+        }
+    }
+
+    DiceRoller dice(11);
+    Action chosen = learningPolicy(state, dice, vf, 0.0f);
+    EXPECT_EQ(chosen.type, actions[best].type);
+    EXPECT_EQ(chosen.playerId, actions[best].playerId);
+    EXPECT_EQ(chosen.target, actions[best].target);
+}
@@ -94,7 +94,7 @@ TEST(GameState, ResetPlayersForNewTurn) {
     GameState gs;
     auto& p = gs.getPlayer(1);
     p.state = PlayerState::STUNNED;
-    p.stats.movement = 6;
+    p.setMovement(6);
     p.hasMoved = true;
     p.hasActed = true;
     p.lostTacklezones = true;
@@ -129,3 +129,134 @@ TEST(GameState, Clone) {
     EXPECT_EQ(gs.getPlayer(1).position, (Position{10, 7}));
     EXPECT_EQ(gs.homeTeam.score, 3);
 }
+
+TEST(GameState, OccupancyTracksMutators) {
+    GameState gs;
+    auto& p = gs.getPlayer(3);
+    gs.setPlayerState(p, PlayerState::STANDING);
+    gs.movePlayer(p, {8, 4});
+    EXPECT_EQ(gs.getPlayerAtPosition({8, 4}), &p);
+
+    gs.movePlayer(p, {9, 4});
+    EXPECT_EQ(gs.getPlayerAtPosition({8, 4}), nullptr);
+    EXPECT_EQ(gs.getPlayerAtPosition({9, 4}), &p);
+
+    // Prone players still occupy their square
+    gs.setPlayerState(p, PlayerState::PRONE);
+    EXPECT_EQ(gs.getPlayerAtPosition({9, 4}), &p);
+
+    gs.removePlayer(p, PlayerState::KO);
+    EXPECT_EQ(gs.getPlayerAtPosition({9, 4}), nullptr);
+    EXPECT_EQ(p.position, (Position{-1, -1}));
+    EXPECT_TRUE(gs.occupancyConsistent());
+}
+
+TEST(GameState, OccupancySwap) {
+    // Tentacles-style swap: the second move lands on a square the first
+    // player still nominally owns; the first move must not clear it.
+    GameState gs;
+    auto& a = gs.getPlayer(1);
+    auto& b = gs.getPlayer(12);
+    a.state = PlayerState::STANDING;
+    a.position = {5, 5};
+    b.state = PlayerState::STANDING;
+    b.position = {6, 5};
+    gs.invalidateOccupancy();
+
+    gs.movePlayer(a, {6, 5});
+    gs.movePlayer(b, {5, 5});
+    EXPECT_EQ(gs.getPlayerAtPosition({6, 5}), &a);
+    EXPECT_EQ(gs.getPlayerAtPosition({5, 5}), &b);
+    EXPECT_TRUE(gs.occupancyConsistent());
+}
+
+TEST(GameState, OccupancyInvalidateAfterDirectEdit) {
+    GameState gs;
+    auto& p = gs.getPlayer(7);
+    gs.setPlayerState(p, PlayerState::STANDING);
+    gs.movePlayer(p, {2, 2});
+    ASSERT_EQ(gs.getPlayerAtPosition({2, 2}), &p);
+
+    p.position = {3, 3};
+    EXPECT_FALSE(gs.occupancyConsistent());
+    gs.invalidateOccupancy();
+    EXPECT_EQ(gs.getPlayerAtPosition({2, 2}), nullptr);
+    EXPECT_EQ(gs.getPlayerAtPosition({3, 3}), &p);
+}
+
+TEST(GameState, OccupancySurvivesClone) {
+    GameState gs;
+    auto& p = gs.getPlayer(4);
+    gs.setPlayerState(p, PlayerState::STANDING);
+    gs.movePlayer(p, {10, 10});
+    ASSERT_NE(gs.getPlayerAtPosition({10, 10}), nullptr);
+
+    auto clone = gs.clone();
+    // Index in the clone points into the clone's own players array
+    EXPECT_EQ(clone.getPlayerAtPosition({10, 10}), &clone.getPlayer(4));
+    clone.movePlayer(clone.getPlayer(4), {11, 10});
+    EXPECT_EQ(gs.getPlayerAtPosition({10, 10}), &p);
+    EXPECT_EQ(clone.getPlayerAtPosition({10, 10}), nullptr);
+}
+
+TEST(GameState, HashEqualForEqualStates) {
+    GameState a;
+    auto& p = a.getPlayer(4);
+    a.setPlayerState(p, PlayerState::STANDING);
+    a.movePlayer(p, {10, 10});
+    GameState b = a.clone();
+    EXPECT_EQ(a.hash(), b.hash());
+
+    // Same layout reached by a different route
+    b.movePlayer(b.getPlayer(4), {11, 10});
+    EXPECT_NE(a.hash(), b.hash());
+    b.movePlayer(b.getPlayer(4), {10, 10});
+    EXPECT_EQ(a.hash(), b.hash());
+}
+
+TEST(GameState, HashCoversTrackedFields) {
+    GameState gs;
+    gs.setPlayerState(gs.getPlayer(1), PlayerState::STANDING);
+    gs.movePlayer(gs.getPlayer(1), {5, 5});
+    uint64_t base = gs.hash();
+
+    auto changes = [&](auto&& edit) {
+        GameState c = gs.clone();
+        edit(c);
+        return c.hash() != base;
+    };
+    EXPECT_TRUE(changes([](GameState& s) { s.setPlayerState(s.getPlayer(1), PlayerState::PRONE); }));
+    EXPECT_TRUE(changes([](GameState& s) { s.setLostTacklezones(s.getPlayer(1), true); }));
+    EXPECT_TRUE(changes([](GameState& s) { s.removePlayer(s.getPlayer(1), PlayerState::KO); }));
+    EXPECT_TRUE(changes([](GameState& s) { s.getPlayer(1).hasActed = true; }));
+    EXPECT_TRUE(changes([](GameState& s) { s.ball = BallState::onGround({6, 6}); }));
+    EXPECT_TRUE(changes([](GameState& s) { s.ball = BallState::carried({5, 5}, 1); }));
+    EXPECT_TRUE(changes([](GameState& s) { s.activeTeam = TeamSide::AWAY; }));
+    EXPECT_TRUE(changes([](GameState& s) { s.homeTeam.turnNumber++; }));
+    EXPECT_TRUE(changes([](GameState& s) { s.awayTeam.rerolls++; }));
+    EXPECT_TRUE(changes([](GameState& s) { s.homeTeam.blitzUsedThisTurn = true; }));
+    EXPECT_TRUE(changes([](GameState& s) { s.awayTeam.passUsedThisTurn = true; }));
+    EXPECT_TRUE(changes([](GameState& s) { s.homeTeam.foulUsedThisTurn = true; }));
+    // Swapping two same-team players is a different position (different slots)
+    gs.setPlayerState(gs.getPlayer(2), PlayerState::STANDING);
+    gs.movePlayer(gs.getPlayer(2), {6, 5});
+    base = gs.hash();
+    EXPECT_TRUE(changes([](GameState& s) {
+        s.movePlayer(s.getPlayer(1), {6, 5});
+        s.movePlayer(s.getPlayer(2), {5, 5});
+    }));
+}
+
+TEST(GameState, HashIncrementalMatchesRebuild) {
+    GameState gs;
+    for (int id = 1; id <= 6; ++id) {
+        gs.setPlayerState(gs.getPlayer(id), PlayerState::STANDING);
+        gs.movePlayer(gs.getPlayer(id), {static_cast<int8_t>(id + 3), 7});
+    }
+    gs.setPlayerState(gs.getPlayer(2), PlayerState::STUNNED);
+    gs.removePlayer(gs.getPlayer(3), PlayerState::INJURED);
+    gs.setLostTacklezones(gs.getPlayer(4), true);
+    uint64_t incremental = gs.hash();
+    gs.invalidateOccupancy();
+    EXPECT_EQ(gs.hash(), incremental);
+}
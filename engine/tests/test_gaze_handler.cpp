@@ -9,8 +9,8 @@ static void placePlayer(GameState& gs, int id, Position pos, TeamSide side,
     Player& p = gs.getPlayer(id);
     p.state = PlayerState::STANDING;
     p.position = pos;
-    p.stats = {static_cast<int8_t>(ma), static_cast<int8_t>(st),
-               static_cast<int8_t>(ag), static_cast<int8_t>(av)};
+    p.setStats({static_cast<int8_t>(ma), static_cast<int8_t>(st),
+                static_cast<int8_t>(ag), static_cast<int8_t>(av)});
     p.movementRemaining = ma;
 }
 
@@ -18,7 +18,7 @@ TEST(GazeHandler, SuccessLosesTZ) {
     GameState gs;
     gs.phase = GamePhase::PLAY;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::HypnoticGaze);
+    gs.getPlayer(1).addSkill(SkillName::HypnoticGaze);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
 
     // No TZ on gazer (only target is adjacent) → target = min(6, 2+1) = 3
@@ -35,7 +35,7 @@ TEST(GazeHandler, FailureTurnover) {
     GameState gs;
     gs.phase = GamePhase::PLAY;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::HypnoticGaze);
+    gs.getPlayer(1).addSkill(SkillName::HypnoticGaze);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
 
     // TZ = 1 from target → gaze target = min(6, 2+1) = 3
@@ -50,7 +50,7 @@ TEST(GazeHandler, TZModifier) {
     GameState gs;
     gs.phase = GamePhase::PLAY;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::HypnoticGaze);
+    gs.getPlayer(1).addSkill(SkillName::HypnoticGaze);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY); // +1 TZ
     placePlayer(gs, 13, {10, 6}, TeamSide::AWAY); // +1 TZ
     placePlayer(gs, 14, {10, 8}, TeamSide::AWAY); // +1 TZ
@@ -66,7 +66,7 @@ TEST(GazeHandler, GazerActed) {
     GameState gs;
     gs.phase = GamePhase::PLAY;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::HypnoticGaze);
+    gs.getPlayer(1).addSkill(SkillName::HypnoticGaze);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
 
     // Success
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "bb/geometry.h"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+using namespace bb;
+
+namespace {
+
+// The runtime Bresenham walk the pass line table replaced.
+std::vector<Position> walkPassPath(Position src, Position dst) {
+    std::vector<Position> out;
+    int x0 = src.x, y0 = src.y;
+    int dx = std::abs(dst.x - x0), dy = std::abs(dst.y - y0);
+    int sx = (x0 < dst.x) ? 1 : -1, sy = (y0 < dst.y) ? 1 : -1;
+    int err = dx - dy;
+    for (int s = 0; s < std::max(dx, dy); ++s) {
+        int e2 = 2 * err;
+        if (e2 > -dy) { err -= dy; x0 += sx; }
+        if (e2 < dx) { err += dx; y0 += sy; }
+        if (x0 == dst.x && y0 == dst.y) break;
+        out.push_back({static_cast<int8_t>(x0), static_cast<int8_t>(y0)});
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(Geometry, NeighboursAreOnPitchAdjacentInOrder) {
+    for (int y = 0; y < Position::PITCH_HEIGHT; ++y) {
+        for (int x = 0; x < Position::PITCH_WIDTH; ++x) {
+            Position p{static_cast<int8_t>(x), static_cast<int8_t>(y)};
+            std::vector<Position> expected;
+            for (Position a : p.getAdjacent()) {
+                if (a.isOnPitch()) expected.push_back(a);
+            }
+            const auto& n = onPitchNeighbours(p);
+            ASSERT_EQ(std::vector<Position>(n.begin(), n.end()), expected);
+        }
+    }
+    EXPECT_EQ(onPitchNeighbours({0, 0}).count, 3);
+    EXPECT_EQ(onPitchNeighbours({-1, -1}).count, 0);
+}
+
+TEST(Geometry, PassLinesMatchBresenhamForEveryPair) {
+    for (int s = 0; s < geometry::SQUARES; ++s) {
+        Position src{static_cast<int8_t>(s % geometry::W), static_cast<int8_t>(s / geometry::W)};
+        for (int d = 0; d < geometry::SQUARES; ++d) {
+            Position dst{static_cast<int8_t>(d % geometry::W), static_cast<int8_t>(d / geometry::W)};
+            const auto& line = passLine(src, dst);
+            std::vector<Position> got;
+            for (int i = 0; i < line.length; ++i) got.push_back(passLineSquare(line, src, i));
+            ASSERT_EQ(got, walkPassPath(src, dst));
+            ASSERT_EQ(line.range, passRangeFromDistance(src.distanceTo(dst)));
+        }
+    }
+}
+
+TEST(Geometry, PushbackDirectionsFanAroundTheStraightLine) {
+    // Attacker to the west of the defender: push E, then SE, then NE
+    const auto& east = geometry::PUSHBACK_DIRS[1 * 3 + 2];
+    EXPECT_EQ(east[0], 2);
+    EXPECT_EQ(east[1], 3);
+    EXPECT_EQ(east[2], 1);
+    // Diagonal: attacker NW of the defender pushes SE, then S, then E
+    const auto& se = geometry::PUSHBACK_DIRS[2 * 3 + 2];
+    EXPECT_EQ(se[0], 3);
+    EXPECT_EQ(se[1], 4);
+    EXPECT_EQ(se[2], 2);
+}
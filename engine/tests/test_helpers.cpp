@@ -9,8 +9,8 @@ static void placePlayer(GameState& gs, int id, Position pos, TeamSide side,
     Player& p = gs.getPlayer(id);
     p.state = PlayerState::STANDING;
     p.position = pos;
-    p.stats = {static_cast<int8_t>(ma), static_cast<int8_t>(st),
-               static_cast<int8_t>(ag), static_cast<int8_t>(av)};
+    p.setStats({static_cast<int8_t>(ma), static_cast<int8_t>(st),
+                static_cast<int8_t>(ag), static_cast<int8_t>(av)});
     p.movementRemaining = ma;
 }
 
@@ -57,6 +57,43 @@ TEST(Helpers, CountTacklezonesLostTZNotCounted) {
     EXPECT_EQ(countTacklezones(gs, {10, 7}, TeamSide::HOME), 0);
 }
 
+TEST(Helpers, CountTacklezonesExcludeId) {
+    GameState gs;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
+    placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
+    placePlayer(gs, 13, {10, 8}, TeamSide::AWAY);
+    placePlayer(gs, 14, {15, 7}, TeamSide::AWAY);  // not adjacent
+
+    EXPECT_EQ(countTacklezones(gs, {10, 7}, TeamSide::HOME, 12), 1);
+    EXPECT_EQ(countTacklezones(gs, {10, 7}, TeamSide::HOME, 14), 2);
+    EXPECT_EQ(countTacklezones(gs, {10, 7}, TeamSide::HOME, 1), 2);  // friendly
+}
+
+TEST(Helpers, CountTacklezonesTracksMutators) {
+    GameState gs;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
+    placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
+    ASSERT_EQ(countTacklezones(gs, {10, 7}, TeamSide::HOME), 1);
+
+    Player& enemy = gs.getPlayer(12);
+    gs.setPlayerState(enemy, PlayerState::PRONE);
+    EXPECT_EQ(countTacklezones(gs, {10, 7}, TeamSide::HOME), 0);
+    gs.setPlayerState(enemy, PlayerState::STANDING);
+    EXPECT_EQ(countTacklezones(gs, {10, 7}, TeamSide::HOME), 1);
+
+    gs.setLostTacklezones(enemy, true);
+    EXPECT_EQ(countTacklezones(gs, {10, 7}, TeamSide::HOME), 0);
+    gs.setLostTacklezones(enemy, false);
+
+    gs.movePlayer(enemy, {13, 7});
+    EXPECT_EQ(countTacklezones(gs, {10, 7}, TeamSide::HOME), 0);
+    EXPECT_EQ(countTacklezones(gs, {12, 7}, TeamSide::HOME), 1);
+
+    gs.removePlayer(enemy, PlayerState::KO);
+    EXPECT_EQ(countTacklezones(gs, {12, 7}, TeamSide::HOME), 0);
+    EXPECT_TRUE(gs.occupancyConsistent());
+}
+
 TEST(Helpers, DodgeTargetBasicAG3) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
@@ -81,7 +118,7 @@ TEST(Helpers, DodgeTargetWithTZAtDest) {
 TEST(Helpers, DodgeTargetWithDodgeSkill) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Dodge);
+    gs.getPlayer(1).addSkill(SkillName::Dodge);
 
     EXPECT_EQ(calculateDodgeTarget(gs, gs.getPlayer(1), {11, 7}, {10, 7}), 3);
 }
@@ -89,9 +126,9 @@ TEST(Helpers, DodgeTargetWithDodgeSkill) {
 TEST(Helpers, DodgeTargetDodgeNegatedByTackle) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Dodge);
+    gs.getPlayer(1).addSkill(SkillName::Dodge);
     placePlayer(gs, 12, {9, 7}, TeamSide::AWAY);
-    gs.getPlayer(12).skills.add(SkillName::Tackle);
+    gs.getPlayer(12).addSkill(SkillName::Tackle);
 
     // Tackle at source negates Dodge
     EXPECT_EQ(calculateDodgeTarget(gs, gs.getPlayer(1), {11, 7}, {10, 7}), 4);
@@ -100,8 +137,8 @@ TEST(Helpers, DodgeTargetDodgeNegatedByTackle) {
 TEST(Helpers, DodgeTargetStuntyAndTwoHeads) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Stunty);
-    gs.getPlayer(1).skills.add(SkillName::TwoHeads);
+    gs.getPlayer(1).addSkill(SkillName::Stunty);
+    gs.getPlayer(1).addSkill(SkillName::TwoHeads);
 
     // 7-3-1-1 = 2
     EXPECT_EQ(calculateDodgeTarget(gs, gs.getPlayer(1), {11, 7}, {10, 7}), 2);
@@ -110,7 +147,7 @@ TEST(Helpers, DodgeTargetStuntyAndTwoHeads) {
 TEST(Helpers, DodgeTargetBreakTackle) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 4, 3, 8);
-    gs.getPlayer(1).skills.add(SkillName::BreakTackle);
+    gs.getPlayer(1).addSkill(SkillName::BreakTackle);
 
     // Uses ST4 instead of AG3: 7-4 = 3
     EXPECT_EQ(calculateDodgeTarget(gs, gs.getPlayer(1), {11, 7}, {10, 7}), 3);
@@ -120,7 +157,7 @@ TEST(Helpers, DodgeTargetPrehensileTail) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     placePlayer(gs, 12, {9, 7}, TeamSide::AWAY);
-    gs.getPlayer(12).skills.add(SkillName::PrehensileTail);
+    gs.getPlayer(12).addSkill(SkillName::PrehensileTail);
 
     // +1 from PrehensileTail at source
     EXPECT_EQ(calculateDodgeTarget(gs, gs.getPlayer(1), {11, 7}, {10, 7}), 5);
@@ -129,9 +166,9 @@ TEST(Helpers, DodgeTargetPrehensileTail) {
 TEST(Helpers, DodgeTargetClamped) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 3, 5, 8);
-    gs.getPlayer(1).skills.add(SkillName::Dodge);
-    gs.getPlayer(1).skills.add(SkillName::Stunty);
-    gs.getPlayer(1).skills.add(SkillName::TwoHeads);
+    gs.getPlayer(1).addSkill(SkillName::Dodge);
+    gs.getPlayer(1).addSkill(SkillName::Stunty);
+    gs.getPlayer(1).addSkill(SkillName::TwoHeads);
 
     // 7-5-1-1-1 = -1, clamped to 2
     EXPECT_EQ(calculateDodgeTarget(gs, gs.getPlayer(1), {11, 7}, {10, 7}), 2);
@@ -156,7 +193,7 @@ TEST(Helpers, PickupTargetBigHandIgnoresTZ) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
-    gs.getPlayer(1).skills.add(SkillName::BigHand);
+    gs.getPlayer(1).addSkill(SkillName::BigHand);
     // BigHand ignores TZ and weather
     EXPECT_EQ(calculatePickupTarget(gs, gs.getPlayer(1)), 3);
 }
@@ -179,7 +216,7 @@ TEST(Helpers, CatchTargetBasic) {
 TEST(Helpers, CatchTargetExtraArms) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::ExtraArms);
+    gs.getPlayer(1).addSkill(SkillName::ExtraArms);
     // 7-3-1 = 3
     EXPECT_EQ(calculateCatchTarget(gs, gs.getPlayer(1), 0), 3);
 }
@@ -188,7 +225,7 @@ TEST(Helpers, CatchTargetNervesOfSteel) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
-    gs.getPlayer(1).skills.add(SkillName::NervesOfSteel);
+    gs.getPlayer(1).addSkill(SkillName::NervesOfSteel);
     // NOS ignores TZ
     EXPECT_EQ(calculateCatchTarget(gs, gs.getPlayer(1), 0), 4);
 }
@@ -221,7 +258,7 @@ TEST(Helpers, AssistsGuardInEnemyTZ) {
     placePlayer(gs, 2, {10, 6}, TeamSide::HOME);
     placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
     placePlayer(gs, 13, {11, 6}, TeamSide::AWAY);
-    gs.getPlayer(2).skills.add(SkillName::Guard);
+    gs.getPlayer(2).addSkill(SkillName::Guard);
 
     // Guard allows assist even in enemy TZ
     EXPECT_EQ(countAssists(gs, {11, 7}, TeamSide::HOME, 1, 12, 12), 1);
@@ -301,7 +338,7 @@ TEST(Helpers, AttemptRollFailNoReroll) {
 TEST(Helpers, AttemptRollSkillReroll) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Dodge);
+    gs.getPlayer(1).addSkill(SkillName::Dodge);
     FixedDiceRoller dice({2, 5}); // first roll 2 (fail), skill reroll 5 (success)
     bool ok = attemptRoll(gs, 1, dice, 4, SkillName::Dodge, false, false, nullptr);
     EXPECT_TRUE(ok);
@@ -310,7 +347,7 @@ TEST(Helpers, AttemptRollSkillReroll) {
 TEST(Helpers, AttemptRollSkillNegated) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Dodge);
+    gs.getPlayer(1).addSkill(SkillName::Dodge);
     FixedDiceRoller dice({2}); // fail, skill negated
     bool ok = attemptRoll(gs, 1, dice, 4, SkillName::Dodge, true, false, nullptr);
     EXPECT_FALSE(ok);
@@ -319,7 +356,7 @@ TEST(Helpers, AttemptRollSkillNegated) {
 TEST(Helpers, AttemptRollProReroll) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Pro);
+    gs.getPlayer(1).addSkill(SkillName::Pro);
     // roll 2 (fail), no skill, Pro check: 4 (pass), reroll: 5 (success)
     FixedDiceRoller dice({2, 4, 5});
     bool ok = attemptRoll(gs, 1, dice, 4, SkillName::SKILL_COUNT, false, false, nullptr);
@@ -330,7 +367,7 @@ TEST(Helpers, AttemptRollProReroll) {
 TEST(Helpers, AttemptRollProFails) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Pro);
+    gs.getPlayer(1).addSkill(SkillName::Pro);
     // roll 2 (fail), Pro check: 3 (fail) → no reroll
     FixedDiceRoller dice({2, 3});
     bool ok = attemptRoll(gs, 1, dice, 4, SkillName::SKILL_COUNT, false, false, nullptr);
@@ -352,7 +389,7 @@ TEST(Helpers, AttemptRollTeamReroll) {
 TEST(Helpers, AttemptRollLonerGate) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Loner);
+    gs.getPlayer(1).addSkill(SkillName::Loner);
     gs.homeTeam.rerolls = 1;
     // roll 2 (fail), Loner gate: 3 (fail) → reroll wasted
     FixedDiceRoller dice({2, 3});
@@ -364,8 +401,8 @@ TEST(Helpers, AttemptRollLonerGate) {
 TEST(Helpers, AttemptRollFullChain) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Dodge);
-    gs.getPlayer(1).skills.add(SkillName::Pro);
+    gs.getPlayer(1).addSkill(SkillName::Dodge);
+    gs.getPlayer(1).addSkill(SkillName::Pro);
     gs.homeTeam.rerolls = 1;
     // roll 2 (fail), Dodge reroll: 1 (fail), Pro check: 4 (pass), Pro reroll: 2 (fail),
     // team reroll: 5 (success)
@@ -373,3 +410,19 @@ TEST(Helpers, AttemptRollFullChain) {
     bool ok = attemptRoll(gs, 1, dice, 4, SkillName::Dodge, false, true, nullptr);
     EXPECT_TRUE(ok);
 }
+
+TEST(Helpers, EmitEventSkipsItsArgumentsWithoutALog) {
+    int evaluated = 0;
+    auto roll = [&] { return ++evaluated; };
+    std::vector<GameEvent>* none = nullptr;
+    BB_EMIT_EVENT(none, GameEvent::Type::DODGE, 1, -1, {2, 3}, {3, 3}, roll(), true);
+    EXPECT_EQ(evaluated, 0);
+
+    std::vector<GameEvent> log;
+    std::vector<GameEvent>* events = &log;
+    BB_EMIT_EVENT(events, GameEvent::Type::DODGE, 1, -1, {2, 3}, {3, 3}, roll(), true);
+    EXPECT_EQ(evaluated, 1);
+    ASSERT_EQ(log.size(), 1u);
+    EXPECT_EQ(log[0].roll, 1);
+    EXPECT_EQ(log[0].to, (Position{3, 3}));
+}
@@ -10,8 +10,8 @@ static void placePlayer(GameState& gs, int id, Position pos, TeamSide side,
     Player& p = gs.getPlayer(id);
     p.state = PlayerState::STANDING;
     p.position = pos;
-    p.stats = {static_cast<int8_t>(ma), static_cast<int8_t>(st),
-               static_cast<int8_t>(ag), static_cast<int8_t>(av)};
+    p.setStats({static_cast<int8_t>(ma), static_cast<int8_t>(st),
+                static_cast<int8_t>(ag), static_cast<int8_t>(av)});
     p.movementRemaining = ma;
 }
 
@@ -75,7 +75,7 @@ TEST(Injury, DecayEventDiceMatchWinningRoll) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     gs.getPlayer(1).state = PlayerState::PRONE;
-    gs.getPlayer(1).skills.add(SkillName::Decay);
+    gs.getPlayer(1).addSkill(SkillName::Decay);
     // Armor: 5+4=9. Injury roll 1: 3+3=6 (stunned). Decay roll 2: 5+4=9 (KO).
     // Takes worse: 9 → KO, dice should be the SECOND roll's (5, 4).
     FixedDiceRoller dice({5, 4, 3, 3, 5, 4});
@@ -149,7 +149,7 @@ TEST(Injury, ThickSkullSavesFromKO) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     gs.getPlayer(1).state = PlayerState::PRONE;
-    gs.getPlayer(1).skills.add(SkillName::ThickSkull);
+    gs.getPlayer(1).addSkill(SkillName::ThickSkull);
     // Armor: 5+4=9 > 8. Injury: 4+5=9 → KO range. ThickSkull: 4 → saves
     FixedDiceRoller dice({5, 4, 4, 5, 4});
     InjuryContext ctx;
@@ -162,7 +162,7 @@ TEST(Injury, ThickSkullFails) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     gs.getPlayer(1).state = PlayerState::PRONE;
-    gs.getPlayer(1).skills.add(SkillName::ThickSkull);
+    gs.getPlayer(1).addSkill(SkillName::ThickSkull);
     // Armor: 5+4=9. Injury: 4+4=8 → KO. ThickSkull: 3 → fails
     FixedDiceRoller dice({5, 4, 4, 4, 3});
     InjuryContext ctx;
@@ -175,7 +175,7 @@ TEST(Injury, RegenerationSaves) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     gs.getPlayer(1).state = PlayerState::PRONE;
-    gs.getPlayer(1).skills.add(SkillName::Regeneration);
+    gs.getPlayer(1).addSkill(SkillName::Regeneration);
     // Armor: 5+5=10. Injury: 5+5=10 → casualty. Regen: 4 → saves
     FixedDiceRoller dice({5, 5, 5, 5, 4});
     InjuryContext ctx;
@@ -188,7 +188,7 @@ TEST(Injury, StakesBlocksRegeneration) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     gs.getPlayer(1).state = PlayerState::PRONE;
-    gs.getPlayer(1).skills.add(SkillName::Regeneration);
+    gs.getPlayer(1).addSkill(SkillName::Regeneration);
     // Armor: 5+5=10. Injury: 5+5=10. Stakes blocks regen.
     FixedDiceRoller dice({5, 5, 5, 5});
     InjuryContext ctx;
@@ -202,7 +202,7 @@ TEST(Injury, DecayTakesWorseRoll) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     gs.getPlayer(1).state = PlayerState::PRONE;
-    gs.getPlayer(1).skills.add(SkillName::Decay);
+    gs.getPlayer(1).addSkill(SkillName::Decay);
     // Armor: 5+4=9. Injury roll 1: 3+3=6 (stunned). Decay roll 2: 5+4=9 (KO).
     // Takes worse: 9 → KO
     FixedDiceRoller dice({5, 4, 3, 3, 5, 4});
@@ -228,7 +228,7 @@ TEST(Injury, StuntyInjuryBonus) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     gs.getPlayer(1).state = PlayerState::PRONE;
-    gs.getPlayer(1).skills.add(SkillName::Stunty);
+    gs.getPlayer(1).addSkill(SkillName::Stunty);
     // Armor: 5+4=9 > 8. Injury: 3+4=7 +1(Stunty)=8 → KO
     FixedDiceRoller dice({5, 4, 3, 4});
     InjuryContext ctx;
@@ -236,3 +236,29 @@ TEST(Injury, StuntyInjuryBonus) {
     EXPECT_TRUE(broken);
     EXPECT_EQ(gs.getPlayer(1).state, PlayerState::KO);
 }
+
+TEST(Injury, ExpectedModeRollsNothing) {
+    // ResolutionMode::Expected reads no dice: an empty script would throw
+    GameState gs;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
+    gs.getPlayer(1).state = PlayerState::PRONE;
+    FixedDiceRoller dice({});
+    dice.setResolutionMode(ResolutionMode::Expected);
+    InjuryContext ctx;
+    EXPECT_FALSE(resolveArmourAndInjury(gs, 1, dice, ctx, nullptr));  // 7 vs AV8
+    EXPECT_EQ(gs.getPlayer(1).state, PlayerState::PRONE);
+
+    // Claw breaks on 8+, Mighty Blow's +1 makes the 8
+    ctx.armourModifier = 1;
+    ctx.hasClaw = true;
+    EXPECT_TRUE(resolveArmourAndInjury(gs, 1, dice, ctx, nullptr));
+    EXPECT_EQ(gs.getPlayer(1).state, PlayerState::STUNNED);
+
+    // +1 injury and Stunty: 9, a KO
+    placePlayer(gs, 2, {12, 7}, TeamSide::HOME);
+    gs.getPlayer(2).addSkill(SkillName::Stunty);
+    ctx.injuryModifier = 1;
+    EXPECT_EQ(resolveInjuryRoll(gs, 2, dice, ctx, nullptr), 9);
+    EXPECT_EQ(gs.getPlayer(2).state, PlayerState::KO);
+    EXPECT_EQ(dice.remaining(), 0u);
+}
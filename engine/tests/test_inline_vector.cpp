@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "bb/inline_vector.h"
+#include "bb/macro_actions.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+#include <algorithm>
+
+using namespace bb;
+
+TEST(InlineVector, StaysInlineUpToCapacityThenSpills) {
+    InlineVector<int, 4> v;
+    for (int i = 0; i < 4; ++i) v.push_back(i);
+    EXPECT_FALSE(v.spilled());
+    EXPECT_EQ(v.capacity(), 4u);
+
+    v.push_back(4);
+    v.push_back(5);
+    EXPECT_TRUE(v.spilled());
+    ASSERT_EQ(v.size(), 6u);
+    for (int i = 0; i < 6; ++i) EXPECT_EQ(v[i], i);
+    EXPECT_EQ(v.back(), 5);
+
+    v.clear();
+    EXPECT_TRUE(v.empty());
+    EXPECT_GE(v.capacity(), 6u);  // clear() keeps the buffer
+}
+
+TEST(InlineVector, CopyMoveAndErase) {
+    InlineVector<int, 4> small, big;
+    for (int i = 0; i < 3; ++i) small.push_back(i);
+    for (int i = 0; i < 9; ++i) big.push_back(i);
+
+    InlineVector<int, 4> copy = big;
+    EXPECT_EQ(copy.size(), 9u);
+    EXPECT_EQ(copy[8], 8);
+    InlineVector<int, 4> moved = std::move(big);
+    EXPECT_TRUE(moved.spilled());
+    EXPECT_EQ(moved[8], 8);
+    EXPECT_TRUE(big.empty());
+    InlineVector<int, 4> movedSmall = std::move(small);
+    EXPECT_FALSE(movedSmall.spilled());
+    EXPECT_EQ(movedSmall[2], 2);
+
+    copy.erase(std::remove_if(copy.begin(), copy.end(), [](int x) { return x % 2; }),
+               copy.end());
+    ASSERT_EQ(copy.size(), 5u);
+    for (int i = 0; i < 5; ++i) EXPECT_EQ(copy[i], 2 * i);
+}
+
+TEST(InlineVector, ListsMatchVectorGeneration) {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getOrcRoster());
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.homeTeam.turnNumber = 1;
+    state.ball = BallState::onGround({13, 7});
+
+    std::vector<Action> actionVec;
+    ActionList actionList;
+    getAvailableActions(state, actionVec);
+    getAvailableActions(state, actionList);
+    ASSERT_EQ(actionList.size(), actionVec.size());
+    EXPECT_FALSE(actionList.spilled());
+    for (size_t i = 0; i < actionVec.size(); ++i) {
+        EXPECT_EQ(actionList[i].type, actionVec[i].type);
+        EXPECT_EQ(actionList[i].playerId, actionVec[i].playerId);
+        EXPECT_EQ(actionList[i].target, actionVec[i].target);
+    }
+
+    std::vector<Macro> macroVec;
+    MacroList macroList;
+    getAvailableMacros(state, macroVec);
+    getAvailableMacros(state, macroList);
+    ASSERT_EQ(macroList.size(), macroVec.size());
+    EXPECT_FALSE(macroList.spilled());
+    for (size_t i = 0; i < macroVec.size(); ++i) {
+        EXPECT_EQ(macroList[i].type, macroVec[i].type);
+        EXPECT_EQ(macroList[i].playerId, macroVec[i].playerId);
+        EXPECT_EQ(macroList[i].targetId, macroVec[i].targetId);
+    }
+}
@@ -196,3 +196,26 @@ TEST(KickoffHandler, MultipleKickoffsInGame) {
     // Just verify game completes
     EXPECT_GT(result.totalActions, 0);
 }
+
+TEST(KickoffHandler, KickTableMatchesScatter) {
+    Position target{22, 7};
+    const KickTable& plain = kickTable(target, false);
+    float sum = 0.0f;
+    for (int i = 0; i < plain.landingCount; ++i) sum += plain.landings[i].probability;
+    EXPECT_NEAR(sum, 1.0f, 1e-5);
+    // d6 = 4 north: four squares up; clamped at the far edge going east
+    EXPECT_EQ(plain.byRoll[3][0], (Position{22, 3}));
+    EXPECT_EQ(plain.byRoll[5][2], (Position{25, 7}));
+
+    // Kick halves the distance, rounding up: 1-2 -> 1, 5-6 -> 3
+    const KickTable& kick = kickTable(target, true);
+    EXPECT_EQ(kick.byRoll[1][4], (Position{22, 8}));
+    EXPECT_EQ(kick.byRoll[5][4], (Position{22, 10}));
+    EXPECT_LT(kick.landingCount, plain.landingCount);
+
+    const auto& events = kickoffEventOdds();
+    EXPECT_NEAR(events[static_cast<size_t>(KickoffEvent::CHEERING)], 5.0f / 36.0f, 1e-6);  // a 6
+    float eventSum = 0.0f;
+    for (float p : events) eventSum += p;
+    EXPECT_NEAR(eventSum, 1.0f, 1e-5);
+}
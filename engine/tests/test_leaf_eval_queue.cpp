@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "bb/leaf_eval_queue.h"
+
+using namespace bb;
+
+namespace {
+
+// Counts evaluate() calls; value = first feature.
+class CountingValueFunction : public ValueFunction {
+public:
+    mutable int calls = 0;
+    float evaluate(const float* features, int) const override {
+        calls++;
+        return features[0];
+    }
+};
+
+std::vector<float> featuresWith(float first) {
+    std::vector<float> f(NUM_FEATURES, 0.0f);
+    f[0] = first;
+    return f;
+}
+
+} // anonymous namespace
+
+TEST(LeafEvalQueue, EvaluatesOnlyOnFlush) {
+    CountingValueFunction vf;
+    LeafEvalQueue queue(&vf, 3);
+    int a = queue.push(featuresWith(0.25f).data());
+    int b = queue.push(featuresWith(-0.5f).data());
+    EXPECT_FALSE(queue.full());
+    EXPECT_EQ(vf.calls, 0);
+
+    int c = queue.push(featuresWith(0.75f).data());
+    EXPECT_TRUE(queue.full());
+    queue.flush();
+    EXPECT_EQ(vf.calls, 3);
+    EXPECT_EQ(queue.batches(), 1u);
+    EXPECT_FLOAT_EQ(queue.result(a), 0.25f);
+    EXPECT_FLOAT_EQ(queue.result(b), -0.5f);
+    EXPECT_FLOAT_EQ(queue.result(c), 0.75f);
+}
+
+TEST(LeafEvalQueue, FlushSkipsEvaluatedTickets) {
+    CountingValueFunction vf;
+    LeafEvalQueue queue(&vf, 2);
+    queue.push(featuresWith(1.0f).data());
+    queue.flush();
+    int t = queue.push(featuresWith(2.0f).data());
+    queue.flush();
+    queue.flush();  // nothing new: not a batch
+    EXPECT_EQ(vf.calls, 2);
+    EXPECT_EQ(queue.batches(), 2u);
+    EXPECT_FLOAT_EQ(queue.result(t), 2.0f);
+
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.push(featuresWith(3.0f).data()), 0);
+}
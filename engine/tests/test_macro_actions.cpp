@@ -6,7 +6,9 @@
 #include "bb/dice.h"
 #include "bb/action_features.h"
 #include <algorithm>
+#include <cstring>
 #include <set>
+#include <vector>
 
 using namespace bb;
 
@@ -28,7 +30,7 @@ GameState makeMinimalState() {
     p1.teamSide = TeamSide::HOME;
     p1.state = PlayerState::STANDING;
     p1.position = {10, 7};
-    p1.stats = {6, 3, 3, 8};
+    p1.setStats({6, 3, 3, 8});
     p1.movementRemaining = 6;
     p1.hasMoved = false;
     p1.hasActed = false;
@@ -38,7 +40,7 @@ GameState makeMinimalState() {
     p2.teamSide = TeamSide::AWAY;
     p2.state = PlayerState::STANDING;
     p2.position = {20, 7};
-    p2.stats = {6, 3, 3, 8};
+    p2.setStats({6, 3, 3, 8});
     p2.movementRemaining = 6;
 
     state.ball = BallState::onGround({13, 7});
@@ -173,7 +175,7 @@ TEST(MacroActions, PickupEmitsTopTwoPickersBestFirst) {
     p2.teamSide = TeamSide::HOME;
     p2.state = PlayerState::STANDING;
     p2.position = {15, 7};
-    p2.stats = {6, 3, 3, 8};
+    p2.setStats({6, 3, 3, 8});
     p2.movementRemaining = 6;
     p2.hasMoved = false;
     p2.hasActed = false;
@@ -197,7 +199,7 @@ TEST(MacroActions, PickupSecondPickerGatedByScoreGap) {
     GameState state = makeMinimalState();
     // Player 1: dist 1, AG4 -> score 40 - 3 = 37.
     state.getPlayer(1).position = {12, 7};
-    state.getPlayer(1).stats = {6, 3, 4, 8};
+    state.getPlayer(1).setStats({6, 3, 4, 8});
     // Player 2: dist 8 (reach 6+2 -- still eligible), AG2 -> 20 - 24 = -4.
     // Gap 41 > 15 -> gated out.
     Player& p2 = state.getPlayer(2);
@@ -205,7 +207,7 @@ TEST(MacroActions, PickupSecondPickerGatedByScoreGap) {
     p2.teamSide = TeamSide::HOME;
     p2.state = PlayerState::STANDING;
     p2.position = {5, 7};
-    p2.stats = {6, 3, 2, 8};
+    p2.setStats({6, 3, 2, 8});
     p2.movementRemaining = 6;
     p2.hasMoved = false;
     p2.hasActed = false;
@@ -235,9 +237,9 @@ TEST(MacroActions, PickupSinglePickerUnchanged) {
 TEST(MacroActions, BlockAvailableWithFavorableDice) {
     GameState state = makeMinimalState();
     // Place ST4 player adjacent to ST3 enemy
-    state.getPlayer(1).stats.strength = 4;
+    state.getPlayer(1).setStrength(4);
     state.getPlayer(1).position = {10, 7};
-    state.getPlayer(12).stats.strength = 3;
+    state.getPlayer(12).setStrength(3);
     state.getPlayer(12).position = {11, 7};
 
     std::vector<Macro> macros;
@@ -249,9 +251,9 @@ TEST(MacroActions, BlockAvailableWithFavorableDice) {
 TEST(MacroActions, BlockNotAvailableWith1Die) {
     GameState state = makeMinimalState();
     // Equal strength adjacent — 1 die, not 2+
-    state.getPlayer(1).stats.strength = 3;
+    state.getPlayer(1).setStrength(3);
     state.getPlayer(1).position = {10, 7};
-    state.getPlayer(12).stats.strength = 3;
+    state.getPlayer(12).setStrength(3);
     state.getPlayer(12).position = {11, 7};
 
     std::vector<Macro> macros;
@@ -315,7 +317,7 @@ TEST(MacroActions, CageAvailableWithCarrierAndFreePlayer) {
     p2.teamSide = TeamSide::HOME;
     p2.state = PlayerState::STANDING;
     p2.position = {8, 5};
-    p2.stats = {6, 3, 3, 8};
+    p2.setStats({6, 3, 3, 8});
     p2.movementRemaining = 6;
     p2.hasMoved = false;
     p2.hasActed = false;
@@ -425,7 +427,7 @@ TEST(MacroActions, PassAvailableWithTeammateAhead) {
     p2.teamSide = TeamSide::HOME;
     p2.state = PlayerState::STANDING;
     p2.position = {12, 7};
-    p2.stats = {6, 3, 3, 8};
+    p2.setStats({6, 3, 3, 8});
     p2.movementRemaining = 6;
 
     std::vector<Macro> macros;
@@ -462,6 +464,58 @@ TEST(MacroActions, BranchingFactorReasonable) {
     EXPECT_LT(macros.size(), actions.size());
 }
 
+TEST(MacroActions, TacticalContextSummarizesPlayers) {
+    GameState state = makeAdvanceState();
+    Player& p2 = state.getPlayer(2);
+    p2.id = 2;
+    p2.teamSide = TeamSide::HOME;
+    p2.state = PlayerState::STANDING;
+    p2.position = {19, 7};
+    p2.setStats({6, 3, 3, 8});
+    p2.movementRemaining = 6;
+
+    TacticalContext ctx;
+    computeTacticalContext(state, ctx);
+
+    EXPECT_EQ(ctx.carrier, &state.getPlayer(1));
+    EXPECT_EQ(ctx.oppCarrier, nullptr);
+    EXPECT_EQ(ctx.endzoneDist[1], 20);
+    EXPECT_EQ(ctx.endzoneDist[12], 20);
+    EXPECT_EQ(ctx.reach[1], 8);
+    EXPECT_EQ(ctx.tacklezones[2], 1);  // next to the away player at (20,7)
+    EXPECT_EQ(ctx.freePlayers, TacticalContext::bit(1) | TacticalContext::bit(2));
+    EXPECT_EQ(ctx.openReceivers, TacticalContext::bit(2));  // carrier excluded
+    EXPECT_EQ(ctx.engaged, TacticalContext::bit(2));
+}
+
+TEST(MacroActions, SharedContextMatchesFreshGeneration) {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getOrcRoster());
+    DiceRoller dice(7);
+    simpleKickoff(state, dice);
+    for (int i = 0; i < 40 && state.phase == GamePhase::PLAY; ++i) {
+        TacticalContext ctx;
+        computeTacticalContext(state, ctx);
+        MacroList shared;
+        getAvailableMacros(state, ctx, shared);
+        std::vector<Macro> fresh;
+        getAvailableMacros(state, fresh);
+
+        ASSERT_EQ(shared.size(), fresh.size());
+        for (size_t m = 0; m < fresh.size(); ++m) {
+            EXPECT_EQ(shared[m].type, fresh[m].type);
+            EXPECT_EQ(shared[m].playerId, fresh[m].playerId);
+            EXPECT_EQ(shared[m].targetId, fresh[m].targetId);
+
+            float a[NUM_ACTION_FEATURES], b[NUM_ACTION_FEATURES];
+            extractMacroFeatures(state, ctx, fresh[m], a);
+            extractMacroFeatures(state, fresh[m], b);
+            for (int f = 0; f < NUM_ACTION_FEATURES; ++f) EXPECT_EQ(a[f], b[f]);
+        }
+        greedyExpandMacro(state, fresh[i % fresh.size()], dice);
+    }
+}
+
 // =============================================================
 // Macro Expansion Tests
 // =============================================================
@@ -552,7 +606,7 @@ TEST(MacroExpansion, BlitzAndScoreStopsFollowUpWhenBlockerSurfedOffPitch) {
     carrier.teamSide = TeamSide::HOME;
     carrier.state = PlayerState::STANDING;
     carrier.position = {21, 7};
-    carrier.stats = {6, 3, 3, 8};
+    carrier.setStats({6, 3, 3, 8});
     carrier.movementRemaining = 6;
 
     Player& blitzer = state.getPlayer(2);
@@ -560,7 +614,7 @@ TEST(MacroExpansion, BlitzAndScoreStopsFollowUpWhenBlockerSurfedOffPitch) {
     blitzer.teamSide = TeamSide::HOME;
     blitzer.state = PlayerState::STANDING;
     blitzer.position = {20, 1};
-    blitzer.stats = {6, 6, 3, 8};
+    blitzer.setStats({6, 6, 3, 8});
     blitzer.movementRemaining = 6;
 
     Player& blocker = state.getPlayer(12);
@@ -568,7 +622,7 @@ TEST(MacroExpansion, BlitzAndScoreStopsFollowUpWhenBlockerSurfedOffPitch) {
     blocker.teamSide = TeamSide::AWAY;
     blocker.state = PlayerState::STANDING;
     blocker.position = {20, 0};
-    blocker.stats = {6, 1, 3, 7};
+    blocker.setStats({6, 1, 3, 7});
     blocker.movementRemaining = 6;
 
     state.ball = BallState::carried({21, 7}, 1);
@@ -611,7 +665,7 @@ TEST(MacroExpansion, AdvanceSprintsWhenCarrierIsBlitzable) {
     threat.teamSide = TeamSide::AWAY;
     threat.state = PlayerState::STANDING;
     threat.position = {6, 12};
-    threat.stats = {6, 3, 3, 8};
+    threat.setStats({6, 3, 3, 8});
     threat.movementRemaining = 6;
 
     Macro macro{MacroType::ADVANCE, 1, -1, {-1, -1}};
@@ -626,9 +680,9 @@ TEST(MacroExpansion, AdvanceSprintsWhenCarrierIsBlitzable) {
 
 TEST(MacroExpansion, BlockProducesBlockAction) {
     GameState state = makeMinimalState();
-    state.getPlayer(1).stats.strength = 4;
+    state.getPlayer(1).setStrength(4);
     state.getPlayer(1).position = {10, 7};
-    state.getPlayer(12).stats.strength = 3;
+    state.getPlayer(12).setStrength(3);
     state.getPlayer(12).position = {11, 7};
 
     DiceRoller dice(42);
@@ -668,7 +722,7 @@ TEST(MacroExpansion, RepositionWalksFullMovementBudget) {
     GameState state = makeMinimalState();
     Player& p1 = state.getPlayer(1);
     p1.position = {10, 7};
-    p1.stats = {8, 3, 3, 8};
+    p1.setStats({8, 3, 3, 8});
     p1.movementRemaining = 8;
     // Ball held by the far-away opponent so no PICKUP/loose-ball logic runs.
     state.getPlayer(12).position = {22, 11};
@@ -685,6 +739,32 @@ TEST(MacroExpansion, RepositionWalksFullMovementBudget) {
     EXPECT_EQ(state.getPlayer(1).position.y, 7);
 }
 
+// The planned route is walked one adjacent square at a time and skirts the
+// enemy tacklezones in the lane rather than dodging through them.
+TEST(MacroExpansion, RepositionRoutesAroundTacklezones) {
+    GameState state = makeMinimalState();
+    Player& p1 = state.getPlayer(1);
+    p1.setStats({8, 3, 3, 8});
+    p1.movementRemaining = 8;
+    state.getPlayer(12).position = {13, 7};
+    state.ball = BallState::carried({13, 7}, 12);
+
+    DiceRoller dice(42);
+    Macro macro{MacroType::REPOSITION, 1, -1, {16, 7}};
+    Position from = p1.position;
+    GameState before = state.clone();
+    auto result = greedyExpandMacro(state, macro, dice);
+
+    EXPECT_FALSE(result.turnover);
+    EXPECT_EQ(state.getPlayer(1).position, (Position{16, 7}));
+    for (auto& a : result.actions) {
+        EXPECT_EQ(a.type, ActionType::MOVE);
+        EXPECT_EQ(from.distanceTo(a.target), 1);
+        EXPECT_EQ(before.tacklezoneCount(TeamSide::AWAY, a.target), 0);
+        from = a.target;
+    }
+}
+
 TEST(MacroExpansion, FoulProducesFoulAction) {
     GameState state = makeMinimalState();
     state.getPlayer(12).state = PlayerState::PRONE;
@@ -726,9 +806,9 @@ TEST(MacroFeatures, ScoreOneHotAndScoringPotential) {
 
 TEST(MacroFeatures, BlockDiceQuality) {
     GameState state = makeMinimalState();
-    state.getPlayer(1).stats.strength = 4;
+    state.getPlayer(1).setStrength(4);
     state.getPlayer(1).position = {10, 7};
-    state.getPlayer(12).stats.strength = 3;
+    state.getPlayer(12).setStrength(3);
     state.getPlayer(12).position = {11, 7};
 
     float feats[NUM_ACTION_FEATURES];
@@ -757,7 +837,7 @@ TEST(MacroFeatures, RiskLevel) {
 
 TEST(MacroFeatures, PlayerStrength) {
     GameState state = makeMinimalState();
-    state.getPlayer(1).stats.strength = 4;
+    state.getPlayer(1).setStrength(4);
 
     float feats[NUM_ACTION_FEATURES];
     Macro macro{MacroType::REPOSITION, 1, -1, {15, 7}};
@@ -821,7 +901,7 @@ GameState makeDefensiveState() {
     p1.teamSide = TeamSide::HOME;
     p1.state = PlayerState::STANDING;
     p1.position = {5, 7};
-    p1.stats = {7, 3, 3, 8};
+    p1.setStats({7, 3, 3, 8});
     p1.movementRemaining = 7;
     p1.hasMoved = false;
     p1.hasActed = false;
@@ -832,7 +912,7 @@ GameState makeDefensiveState() {
     p2.teamSide = TeamSide::HOME;
     p2.state = PlayerState::STANDING;
     p2.position = {6, 4};
-    p2.stats = {6, 3, 3, 8};
+    p2.setStats({6, 3, 3, 8});
     p2.movementRemaining = 6;
     p2.hasMoved = false;
     p2.hasActed = false;
@@ -843,7 +923,7 @@ GameState makeDefensiveState() {
     p3.teamSide = TeamSide::HOME;
     p3.state = PlayerState::STANDING;
     p3.position = {4, 10};
-    p3.stats = {6, 3, 3, 8};
+    p3.setStats({6, 3, 3, 8});
     p3.movementRemaining = 6;
     p3.hasMoved = false;
     p3.hasActed = false;
@@ -854,7 +934,7 @@ GameState makeDefensiveState() {
     p12.teamSide = TeamSide::AWAY;
     p12.state = PlayerState::STANDING;
     p12.position = {15, 7};
-    p12.stats = {6, 3, 3, 8};
+    p12.setStats({6, 3, 3, 8});
     p12.movementRemaining = 6;
 
     // Ball held by away player 12
@@ -873,7 +953,7 @@ TEST(MacroActions, BlitzDefensePrioritizesCarrier) {
     p13.teamSide = TeamSide::AWAY;
     p13.state = PlayerState::STANDING;
     p13.position = {20, 10};
-    p13.stats = {6, 3, 3, 8};
+    p13.setStats({6, 3, 3, 8});
 
     std::vector<Macro> macros;
     getAvailableMacros(state, macros);
@@ -898,7 +978,7 @@ TEST(MacroActions, BlitzDefenseMultipleTargets) {
     p13.teamSide = TeamSide::AWAY;
     p13.state = PlayerState::STANDING;
     p13.position = {18, 5};
-    p13.stats = {6, 3, 3, 8};
+    p13.setStats({6, 3, 3, 8});
 
     std::vector<Macro> macros;
     getAvailableMacros(state, macros);
@@ -920,7 +1000,7 @@ TEST(MacroActions, BlitzOffenseSingleTarget) {
     p13.teamSide = TeamSide::AWAY;
     p13.state = PlayerState::STANDING;
     p13.position = {18, 5};
-    p13.stats = {6, 3, 3, 8};
+    p13.setStats({6, 3, 3, 8});
 
     std::vector<Macro> macros;
     getAvailableMacros(state, macros);
@@ -974,7 +1054,7 @@ TEST(MacroActions, RepositionDefenseEndzoneGuard) {
     p13.teamSide = TeamSide::AWAY;
     p13.state = PlayerState::STANDING;
     p13.position = {4, 3};  // near home endzone (x=0)
-    p13.stats = {7, 3, 3, 8};  // MA 7, can score (dist=4, MA+2=9)
+    p13.setStats({7, 3, 3, 8});  // MA 7, can score (dist=4, MA+2=9)
     p13.movementRemaining = 7;
 
     // Add more home players for endzone guard assignment
@@ -983,7 +1063,7 @@ TEST(MacroActions, RepositionDefenseEndzoneGuard) {
     p4.teamSide = TeamSide::HOME;
     p4.state = PlayerState::STANDING;
     p4.position = {3, 12};
-    p4.stats = {6, 3, 3, 8};
+    p4.setStats({6, 3, 3, 8});
     p4.movementRemaining = 6;
     p4.hasMoved = false;
     p4.hasActed = false;
@@ -993,7 +1073,7 @@ TEST(MacroActions, RepositionDefenseEndzoneGuard) {
     p5.teamSide = TeamSide::HOME;
     p5.state = PlayerState::STANDING;
     p5.position = {2, 2};
-    p5.stats = {6, 3, 3, 8};
+    p5.setStats({6, 3, 3, 8});
     p5.movementRemaining = 6;
     p5.hasMoved = false;
     p5.hasActed = false;
@@ -1016,7 +1096,7 @@ TEST(MacroExpansion, BlitzSelectsBestBlitzer) {
     GameState state = makeMinimalState();
     // Two home players that can blitz the target
     state.getPlayer(1).position = {10, 7};
-    state.getPlayer(1).stats.strength = 3;
+    state.getPlayer(1).setStrength(3);
     state.getPlayer(1).movementRemaining = 6;
 
     Player& p2 = state.getPlayer(2);
@@ -1024,13 +1104,13 @@ TEST(MacroExpansion, BlitzSelectsBestBlitzer) {
     p2.teamSide = TeamSide::HOME;
     p2.state = PlayerState::STANDING;
     p2.position = {12, 7};  // closer to target
-    p2.stats = {6, 4, 3, 8}; // ST4 = better dice
+    p2.setStats({6, 4, 3, 8}); // ST4 = better dice
     p2.movementRemaining = 6;
     p2.hasMoved = false;
     p2.hasActed = false;
 
     state.getPlayer(12).position = {14, 7};
-    state.getPlayer(12).stats.strength = 3;
+    state.getPlayer(12).setStrength(3);
     state.homeTeam.blitzUsedThisTurn = false;
     state.ball = BallState::onGround({20, 7});
 
@@ -1054,7 +1134,7 @@ TEST(MacroActions, DefensiveScreenEvenSpread) {
         p.teamSide = TeamSide::HOME;
         p.state = PlayerState::STANDING;
         p.position = {static_cast<int8_t>(2 + i), static_cast<int8_t>(2)};
-        p.stats = {5, 3, 3, 8};  // slow (MA5, won't get safety)
+        p.setStats({5, 3, 3, 8});  // slow (MA5, won't get safety)
         p.movementRemaining = 5;
         p.hasMoved = false;
         p.hasActed = false;
@@ -1100,7 +1180,7 @@ TEST(MacroActions, ScoreAvoidsEnemyTZ) {
     e2.teamSide = TeamSide::AWAY;
     e2.state = PlayerState::STANDING;
     e2.position = {24, 7};
-    e2.stats = {6, 3, 3, 8};
+    e2.setStats({6, 3, 3, 8});
 
     std::vector<Macro> macros;
     getAvailableMacros(state, macros);
@@ -1150,3 +1230,23 @@ TEST(MacroActions, ScoreOffPitchCarrierDoesNotHang) {
     EXPECT_TRUE(result.actions.empty());
 }
 
+
+TEST(MacroActions, BatchFeaturesMatchPerMacroCalls) {
+    DiceRoller dice(5);
+    int checked = 0;
+    auto check = [&](const GameState& s) {
+        if (s.phase == GamePhase::PLAY) {
+            std::vector<Macro> macros;
+            getAvailableMacros(s, macros);
+            const int n = static_cast<int>(macros.size());
+            std::vector<float> batch(n * NUM_ACTION_FEATURES), single(n * NUM_ACTION_FEATURES);
+            extractMacroFeatures(s, macros.data(), n, batch.data());
+            for (int i = 0; i < n; ++i) extractMacroFeatures(s, macros[i], &single[i * NUM_ACTION_FEATURES]);
+            EXPECT_EQ(std::memcmp(batch.data(), single.data(), batch.size() * sizeof(float)), 0);
+            checked += n;
+        }
+        return randomPolicy(s, dice);
+    };
+    simulateGame(getHumanRoster(), getOrcRoster(), check, check, dice);
+    EXPECT_GT(checked, 100);
+}
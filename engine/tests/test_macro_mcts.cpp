@@ -5,7 +5,10 @@
 #include "bb/roster.h"
 #include "bb/value_function.h"
 #include "bb/action_resolver.h"
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <thread>
 
 using namespace bb;
 
@@ -39,7 +42,7 @@ GameState makeScoringState() {
     carrier.teamSide = TeamSide::HOME;
     carrier.state = PlayerState::STANDING;
     carrier.position = {23, 7};
-    carrier.stats = {6, 3, 3, 8};
+    carrier.setStats({6, 3, 3, 8});
     carrier.movementRemaining = 6;
     carrier.hasMoved = false;
     carrier.hasActed = false;
@@ -56,6 +59,35 @@ int countMacroType(const std::vector<Macro>& macros, MacroType type) {
     return count;
 }
 
+// Give `parent` (the root, arena index 0) a contiguous block of `n` children.
+std::span<MacroMCTSNode> addChildren(MacroMCTSArena& arena, MacroMCTSNode& parent, uint32_t n) {
+    uint32_t first = arena.allocate(n);
+    for (uint32_t i = 0; i < n; ++i) arena[first + i].parent = 0;
+    parent.firstChild = first;
+    parent.numChildren = n;
+    return arena.children(parent);
+}
+
+// Two home players and one away player, far apart with the ball loose
+// between them: every move the home side can make is dice-free, so the
+// position after the chosen move is the one the search expanded.
+GameState makeQuietState() {
+    GameState state;
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.homeTeam.turnNumber = 1;
+    state.awayTeam.turnNumber = 1;
+    for (int id : {1, 2, 12}) {
+        Player& p = state.getPlayer(id);
+        p.state = PlayerState::STANDING;
+        p.position = id == 1 ? Position{3, 3} : id == 2 ? Position{3, 11} : Position{22, 12};
+        p.setStats({6, 3, 3, 8});
+        p.movementRemaining = 6;
+    }
+    state.ball = BallState::onGround({13, 7});
+    return state;
+}
+
 } // anonymous namespace
 
 // =============================================================
@@ -63,40 +95,39 @@ int countMacroType(const std::vector<Macro>& macros, MacroType type) {
 // =============================================================
 
 TEST(MacroMCTSNode, MostVisitedChild) {
-    MacroMCTSNode root;
-    root.children.resize(3);
-    root.children[0].visits = 5;
-    root.children[1].visits = 20;
-    root.children[2].visits = 10;
-
-    auto* best = root.mostVisitedChild();
+    MacroMCTSArena arena;
+    MacroMCTSNode& root = arena[arena.allocate(1)];
+    auto children = addChildren(arena, root, 3);
+    children[0].visits = 5;
+    children[1].visits = 20;
+    children[2].visits = 10;
+
+    auto* best = arena.get(root.mostVisitedChild(arena));
     ASSERT_NE(best, nullptr);
     EXPECT_EQ(best->visits, 20);
 }
 
 TEST(MacroMCTSNode, BestChildPUCTWithFPU) {
-    MacroMCTSNode root;
+    MacroMCTSArena arena;
+    MacroMCTSNode& root = arena[arena.allocate(1)];
     root.visits = 30;
-    root.children.resize(3);
+    auto children = addChildren(arena, root, 3);
 
     // Two visited, one unvisited
-    root.children[0].visits = 15;
-    root.children[0].totalValue = 9.0;  // avg 0.6
-    root.children[0].prior = 0.33f;
-    root.children[0].parent = &root;
+    children[0].visits = 15;
+    children[0].totalValue = 9.0;  // avg 0.6
+    children[0].prior = 0.33f;
 
-    root.children[1].visits = 15;
-    root.children[1].totalValue = 3.0;  // avg 0.2
-    root.children[1].prior = 0.33f;
-    root.children[1].parent = &root;
+    children[1].visits = 15;
+    children[1].totalValue = 3.0;  // avg 0.2
+    children[1].prior = 0.33f;
 
     // Unvisited child should use FPU = avg(0.6, 0.2) = 0.4
-    root.children[2].visits = 0;
-    root.children[2].totalValue = 0.0;
-    root.children[2].prior = 0.34f;
-    root.children[2].parent = &root;
+    children[2].visits = 0;
+    children[2].totalValue = 0.0;
+    children[2].prior = 0.34f;
 
-    auto* best = root.bestChildPUCT(2.5, /*maximize=*/true);
+    auto* best = arena.get(root.bestChildPUCT(arena, 2.5, /*maximize=*/true));
     ASSERT_NE(best, nullptr);
     // Unvisited child has high exploration bonus, should be selected
     EXPECT_EQ(best->visits, 0);
@@ -107,29 +138,50 @@ TEST(MacroMCTSNode, BestChildPUCTMinimizeForOpponentNode) {
     // ranking should flip: with no exploration bonus advantage, the child
     // with the WORST value for searchingSide (i.e. best for the opponent)
     // should be favored over one with a better value.
-    MacroMCTSNode root;
+    MacroMCTSArena arena;
+    MacroMCTSNode& root = arena[arena.allocate(1)];
     root.visits = 30;
-    root.children.resize(2);
+    auto children = addChildren(arena, root, 2);
 
-    root.children[0].visits = 15;
-    root.children[0].totalValue = 12.0;  // avg 0.8 -- great for searchingSide
-    root.children[0].prior = 0.5f;
-    root.children[0].parent = &root;
+    children[0].visits = 15;
+    children[0].totalValue = 12.0;  // avg 0.8 -- great for searchingSide
+    children[0].prior = 0.5f;
 
-    root.children[1].visits = 15;
-    root.children[1].totalValue = -12.0;  // avg -0.8 -- bad for searchingSide
-    root.children[1].prior = 0.5f;
-    root.children[1].parent = &root;
+    children[1].visits = 15;
+    children[1].totalValue = -12.0;  // avg -0.8 -- bad for searchingSide
+    children[1].prior = 0.5f;
 
-    auto* bestCooperative = root.bestChildPUCT(0.0, /*maximize=*/true);
+    auto* bestCooperative = arena.get(root.bestChildPUCT(arena, 0.0, /*maximize=*/true));
     ASSERT_NE(bestCooperative, nullptr);
     EXPECT_DOUBLE_EQ(bestCooperative->totalValue, 12.0);
 
-    auto* bestAdversarial = root.bestChildPUCT(0.0, /*maximize=*/false);
+    auto* bestAdversarial = arena.get(root.bestChildPUCT(arena, 0.0, /*maximize=*/false));
     ASSERT_NE(bestAdversarial, nullptr);
     EXPECT_DOUBLE_EQ(bestAdversarial->totalValue, -12.0);
 }
 
+TEST(MacroMCTSNode, BestChildPUCTUsesTranspositionStats) {
+    // Child 1 looks worse on its own visits, but its position has been seen
+    // more often (through another parent) with a better value.
+    MacroMCTSArena arena;
+    MacroMCTSNode& root = arena[arena.allocate(1)];
+    root.visits = 30;
+    auto children = addChildren(arena, root, 2);
+    for (auto& c : children) {
+        c.visits = 10;
+        c.prior = 0.5f;
+    }
+    children[0].totalValue = 3.0;   // avg 0.3
+    children[1].totalValue = -2.0;  // avg -0.2
+    children[1].stateHash = 0xABCDEF;
+
+    TranspositionTable tt(1 << 16);
+    for (int i = 0; i < 40; ++i) tt.update(0xABCDEF, 0.9);
+
+    EXPECT_EQ(arena.get(root.bestChildPUCT(arena, 0.0, true)), &children[0]);
+    EXPECT_EQ(arena.get(root.bestChildPUCT(arena, 0.0, true, &tt)), &children[1]);
+}
+
 // =============================================================
 // MacroMCTSSearch Tests
 // =============================================================
@@ -175,6 +227,86 @@ TEST(MacroMCTS, SearchWithValueFunction) {
     EXPECT_GT(search.lastIterations(), 0);
 }
 
+TEST(MacroMCTS, BatchedLeafEvaluationBackpropagatesEveryLeaf) {
+    GameState state = makePlayState();
+
+    std::vector<float> weights(NUM_FEATURES, 0.0f);
+    weights[0] = 1.0f;
+    LinearValueFunction vf(weights);
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 203;  // not a multiple of the batch: final flush
+    config.vfBlend = 0.5f;
+    config.nRollouts = 2;
+    config.evalBatchSize = 16;
+
+    MacroMCTSSearch search(&vf, config, 42);
+    search.search(state);
+    EXPECT_EQ(search.lastIterations(), 203);
+
+    // Every queued leaf came back and its virtual loss was taken back.
+    int totalVisits = 0;
+    for (auto& cv : search.lastChildVisits()) totalVisits += cv.visits;
+    EXPECT_EQ(totalVisits, 203);
+}
+
+TEST(MacroMCTS, ScoringStateFindsScoreWithBatchedEvaluation) {
+    GameState state = makeScoringState();
+
+    std::vector<float> weights(NUM_FEATURES, 0.0f);
+    weights[0] = 5.0f;
+    weights[1] = 3.0f;
+    LinearValueFunction vf(weights);
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 200;
+    config.vfBlend = 0.5f;
+    config.evalBatchSize = 8;
+
+    MacroMCTSSearch search(&vf, config, 42);
+    EXPECT_EQ(search.search(state).type, MacroType::SCORE);
+}
+
+TEST(MacroMCTS, LeafBreakdownSumsToTheLeafValue) {
+    GameState state = makeScoringState();
+    // A strong opponent next to a home player: one bash exposure
+    Player& mate = state.getPlayer(2);
+    mate.state = PlayerState::STANDING;
+    mate.setStats({6, 3, 3, 8});
+    state.movePlayer(mate, {10, 7});
+    Player& ogre = state.getPlayer(12);
+    ogre.state = PlayerState::STANDING;
+    ogre.setStats({5, 5, 2, 10});
+    state.movePlayer(ogre, {11, 7});
+
+    MCTSConfig config;
+    MacroMCTSSearch search(nullptr, config, 42);
+    DiceRoller dice(1);
+    LeafBreakdown b = search.leafBreakdown(state, TeamSide::HOME, dice);
+    auto term = [&](LeafTerm t) { return b.terms[static_cast<size_t>(t)]; };
+
+    EXPECT_DOUBLE_EQ(term(LeafTerm::POSSESSION), 0.1);
+    EXPECT_DOUBLE_EQ(term(LeafTerm::WALK_IN), 0.4);
+    EXPECT_DOUBLE_EQ(term(LeafTerm::BASH_EXPOSURE), -0.05);
+    EXPECT_DOUBLE_EQ(term(LeafTerm::PLAYER_DIFF), 0.03);
+    EXPECT_EQ(term(LeafTerm::LOOKAHEAD), 0.0);
+
+    double heuristic = 0.0, scoring = 0.0;
+    for (size_t i = 0; i < b.terms.size(); ++i) {
+        (isScoringTerm(static_cast<LeafTerm>(i)) ? scoring : heuristic) += b.terms[i];
+    }
+    EXPECT_NEAR(b.heuristic, std::clamp(heuristic, -1.0, 1.0), 1e-12);
+    EXPECT_NEAR(b.scoringBonus, scoring, 1e-12);
+    EXPECT_DOUBLE_EQ(b.value, std::clamp(b.heuristic + b.scoringBonus, -1.0, 1.0));
+
+    // The opponent's view: their carrier threat, no scoring terms
+    LeafBreakdown away = search.leafBreakdown(state, TeamSide::AWAY, dice);
+    EXPECT_DOUBLE_EQ(away.terms[static_cast<size_t>(LeafTerm::OPP_CAN_SCORE)], -0.4);
+    EXPECT_EQ(away.scoringBonus, 0.0);
+}
+
 TEST(MacroMCTS, ScoringPositionFindsScore) {
     GameState state = makeScoringState();
 
@@ -218,7 +350,7 @@ TEST(MacroMCTS, DefensiveRepositionFloorBindsAtLargeNodes) {
     carrier.teamSide = TeamSide::AWAY;
     carrier.state = PlayerState::STANDING;
     carrier.position = {5, 7};
-    carrier.stats = {6, 3, 3, 8};
+    carrier.setStats({6, 3, 3, 8});
     carrier.movementRemaining = 6;
     state.ball = BallState::carried({5, 7}, 12);
 
@@ -227,7 +359,7 @@ TEST(MacroMCTS, DefensiveRepositionFloorBindsAtLargeNodes) {
     away2.teamSide = TeamSide::AWAY;
     away2.state = PlayerState::STANDING;
     away2.position = {6, 9};
-    away2.stats = {6, 3, 3, 8};
+    away2.setStats({6, 3, 3, 8});
     away2.movementRemaining = 6;
 
     // 14 free HOME players -> 14 REPOSITION + 2 BLITZ + END_TURN.
@@ -240,7 +372,7 @@ TEST(MacroMCTS, DefensiveRepositionFloorBindsAtLargeNodes) {
         int x = 18 + (i % 3);
         int y = std::min(1 + i, 13);
         p.position = {static_cast<int8_t>(x), static_cast<int8_t>(y)};
-        p.stats = {6, 3, 3, 8};
+        p.setStats({6, 3, 3, 8});
         p.movementRemaining = 6;
         id++;
         if (id == 12) id = 14; // skip reserved ids 12/13
@@ -283,7 +415,7 @@ TEST(MacroMCTS, DefensiveFoulCapBindsAtSparseNodes) {
     carrier.teamSide = TeamSide::AWAY;
     carrier.state = PlayerState::STANDING;
     carrier.position = {5, 7};
-    carrier.stats = {6, 3, 3, 8};
+    carrier.setStats({6, 3, 3, 8});
     carrier.movementRemaining = 6;
     state.ball = BallState::carried({5, 7}, 12);
 
@@ -298,7 +430,7 @@ TEST(MacroMCTS, DefensiveFoulCapBindsAtSparseNodes) {
     blockTarget.teamSide = TeamSide::AWAY;
     blockTarget.state = PlayerState::STANDING;
     blockTarget.position = {18, 4};
-    blockTarget.stats = {6, 3, 3, 8};
+    blockTarget.setStats({6, 3, 3, 8});
     blockTarget.movementRemaining = 6;
 
     Player& fouler = state.getPlayer(1);
@@ -306,7 +438,7 @@ TEST(MacroMCTS, DefensiveFoulCapBindsAtSparseNodes) {
     fouler.teamSide = TeamSide::HOME;
     fouler.state = PlayerState::STANDING;
     fouler.position = {15, 7};
-    fouler.stats = {6, 3, 3, 8};
+    fouler.setStats({6, 3, 3, 8});
     fouler.movementRemaining = 6;
 
     Player& blocker = state.getPlayer(2);
@@ -314,7 +446,7 @@ TEST(MacroMCTS, DefensiveFoulCapBindsAtSparseNodes) {
     blocker.teamSide = TeamSide::HOME;
     blocker.state = PlayerState::STANDING;
     blocker.position = {18, 5};
-    blocker.stats = {6, 4, 3, 8};
+    blocker.setStats({6, 4, 3, 8});
     blocker.movementRemaining = 6;
 
     // 2 free HOME REPOSITION fillers -> n=8: 2 BLITZ, 1 BLOCK, 1 FOUL, 3
@@ -328,7 +460,7 @@ TEST(MacroMCTS, DefensiveFoulCapBindsAtSparseNodes) {
         p.teamSide = TeamSide::HOME;
         p.state = PlayerState::STANDING;
         p.position = {static_cast<int8_t>(20 + i), static_cast<int8_t>(1 + i)};
-        p.stats = {6, 3, 3, 8};
+        p.setStats({6, 3, 3, 8});
         p.movementRemaining = 6;
     }
 
@@ -373,7 +505,7 @@ TEST(MacroMCTS, RepositionFloorNoOpAtSmallNodes) {
     carrier.teamSide = TeamSide::AWAY;
     carrier.state = PlayerState::STANDING;
     carrier.position = {5, 7};
-    carrier.stats = {6, 3, 3, 8};
+    carrier.setStats({6, 3, 3, 8});
     carrier.movementRemaining = 6;
     state.ball = BallState::carried({5, 7}, 12);
 
@@ -382,7 +514,7 @@ TEST(MacroMCTS, RepositionFloorNoOpAtSmallNodes) {
     away2.teamSide = TeamSide::AWAY;
     away2.state = PlayerState::STANDING;
     away2.position = {6, 9};
-    away2.stats = {6, 3, 3, 8};
+    away2.setStats({6, 3, 3, 8});
     away2.movementRemaining = 6;
 
     // 3 free HOME players, no FOUL candidate (no prone/stunned enemy) ->
@@ -394,7 +526,7 @@ TEST(MacroMCTS, RepositionFloorNoOpAtSmallNodes) {
         p.teamSide = TeamSide::HOME;
         p.state = PlayerState::STANDING;
         p.position = {static_cast<int8_t>(20 + i), static_cast<int8_t>(1 + i)};
-        p.stats = {6, 3, 3, 8};
+        p.setStats({6, 3, 3, 8});
         p.movementRemaining = 6;
     }
 
@@ -434,7 +566,7 @@ TEST(MacroMCTS, OffensivePriorsUntouchedByDefensiveRebalance) {
     carrier.teamSide = TeamSide::HOME;
     carrier.state = PlayerState::STANDING;
     carrier.position = {12, 7};
-    carrier.stats = {6, 3, 3, 8};
+    carrier.setStats({6, 3, 3, 8});
     carrier.movementRemaining = 6;
     state.ball = BallState::carried({12, 7}, 1);
 
@@ -449,7 +581,7 @@ TEST(MacroMCTS, OffensivePriorsUntouchedByDefensiveRebalance) {
     fouler.teamSide = TeamSide::HOME;
     fouler.state = PlayerState::STANDING;
     fouler.position = {18, 7};
-    fouler.stats = {6, 3, 3, 8};
+    fouler.setStats({6, 3, 3, 8});
     fouler.movementRemaining = 6;
 
     Player& free1 = state.getPlayer(3);
@@ -457,7 +589,7 @@ TEST(MacroMCTS, OffensivePriorsUntouchedByDefensiveRebalance) {
     free1.teamSide = TeamSide::HOME;
     free1.state = PlayerState::STANDING;
     free1.position = {20, 2};
-    free1.stats = {6, 3, 3, 8};
+    free1.setStats({6, 3, 3, 8});
     free1.movementRemaining = 6;
 
     PolicyNetwork zeroPolicy;
@@ -505,7 +637,7 @@ TEST(MacroMCTS, SecondaryPickupPriorIsHalfOfPrimary) {
         p.teamSide = TeamSide::HOME;
         p.state = PlayerState::STANDING;
         p.position = pos;
-        p.stats = {6, 3, 3, 8};
+        p.setStats({6, 3, 3, 8});
         p.movementRemaining = 6;
         p.hasMoved = false;
         p.hasActed = false;
@@ -520,7 +652,7 @@ TEST(MacroMCTS, SecondaryPickupPriorIsHalfOfPrimary) {
     away.teamSide = TeamSide::AWAY;
     away.state = PlayerState::STANDING;
     away.position = {25, 13};
-    away.stats = {6, 3, 3, 8};
+    away.setStats({6, 3, 3, 8});
     away.movementRemaining = 6;
 
     // Precondition: floors must bind (base 1/n < 0.10) and both pickers emit.
@@ -548,6 +680,196 @@ TEST(MacroMCTS, SecondaryPickupPriorIsHalfOfPrimary) {
     EXPECT_NEAR(primary / secondary, 2.0f, 0.01f);
 }
 
+TEST(MacroMCTS, TranspositionTableSearch) {
+    GameState state = makePlayState();
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 200;
+    config.ttMemoryMB = 1;
+
+    MacroMCTSSearch search(nullptr, config, 42);
+    ASSERT_TRUE(search.transpositionTable().enabled());
+    search.search(state);
+    EXPECT_EQ(search.lastIterations(), 200);
+    const auto& tt = search.transpositionTable();
+    EXPECT_GT(tt.hits() + tt.misses(), 0u);
+}
+
+TEST(MacroMCTS, ParallelSearchCompletesAllIterations) {
+    GameState state = makePlayState();
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 400;
+    config.numThreads = 4;
+    config.nRollouts = 2;
+    config.ttMemoryMB = 1;
+
+    MacroMCTSSearch search(nullptr, config, 42);
+    Macro result = search.search(state);
+    EXPECT_EQ(search.lastIterations(), 400);
+
+    std::vector<Macro> macros;
+    getAvailableMacros(state, macros);
+    bool found = false;
+    for (auto& m : macros) found |= (m.type == result.type);
+    EXPECT_TRUE(found);
+
+    // Every iteration attempts a root child's macro, and all virtual loss
+    // has been taken back: root children account for exactly one visit each.
+    int totalVisits = 0;
+    for (auto& cv : search.lastChildVisits()) totalVisits += cv.visits;
+    EXPECT_EQ(totalVisits, 400);
+}
+
+TEST(MacroMCTS, SearchStatsAccountForEveryIteration) {
+    GameState state = makePlayState();
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 200;
+    config.nRollouts = 2;
+
+    MacroMCTSSearch search(nullptr, config, 42);
+    search.search(state);
+    const SearchStats& stats = search.lastStats();
+    EXPECT_EQ(stats.iterations, 200);
+    // One leaf per iteration, plus the extra rollout whenever its replay completes
+    EXPECT_GE(stats.leafEvals, 200);
+    EXPECT_LE(stats.leafEvals, 400);
+    EXPECT_GT(stats.nodesAllocated, 1);
+    EXPECT_GE(stats.maxDepth, 1);
+    EXPECT_GT(stats.avgDepth, 0.0);
+    EXPECT_LE(stats.avgDepth, stats.maxDepth);
+    double phases = stats.selectMs + stats.replayMs + stats.expandMs +
+                    stats.simulateMs + stats.backpropMs;
+    EXPECT_GT(phases, 0.0);
+    EXPECT_LE(phases, stats.totalMs);
+    EXPECT_GT(stats.iterationsPerSec, 0.0);
+
+    // Tree-parallel workers merge their shares
+    config.numThreads = 4;
+    MacroMCTSSearch parallel(nullptr, config, 42);
+    parallel.search(state);
+    EXPECT_EQ(parallel.lastStats().iterations, 200);
+    EXPECT_GE(parallel.lastStats().leafEvals, 200);
+    EXPECT_GT(parallel.lastStats().nodesAllocated, 1);
+}
+
+TEST(MacroMCTS, SubtreeReusedWhenPositionRecurs) {
+    GameState state = makeQuietState();
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 300;
+    config.reuseTree = true;
+
+    MacroMCTSSearch search(nullptr, config, 7);
+    Macro m = search.search(state);
+    EXPECT_EQ(search.lastReusedVisits(), 0);
+
+    DiceRoller dice(1);
+    greedyExpandMacro(state, m, dice);
+    search.search(state);
+    EXPECT_GT(search.lastReusedVisits(), 0);
+
+    // A position no child was expanded from starts a fresh tree.
+    search.search(makePlayState());
+    EXPECT_EQ(search.lastReusedVisits(), 0);
+}
+
+TEST(MacroMCTS, OpponentRepliesNarrowAdversarialNodes) {
+    GameState state = makePlayState();
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 400;
+
+    // Widest opponent node (by its children's acting team) of each search
+    auto widestReply = [&](const MCTSConfig& c, int& opponentNodes) {
+        MacroMCTSSearch search(nullptr, c, 42);
+        search.search(state);
+        SearchTree tree = search.exportTree(0);
+        uint8_t us = static_cast<uint8_t>(tree.searchingSide);
+        uint32_t widest = 0;
+        opponentNodes = 0;
+        for (size_t i = 1; i < tree.nodes.size(); ++i) {
+            const SearchTreeRecord& child = tree.nodes[i];
+            if (child.actingTeam == us || tree.nodes[i - 1].parent == child.parent) continue;
+            // First child of its parent: the parent is an opponent node
+            opponentNodes++;
+            widest = std::max(widest, tree.nodes[child.parent].numChildren);
+        }
+        return widest;
+    };
+
+    int full = 0, narrowed = 0;
+    EXPECT_GT(widestReply(config, full), 2u);
+    config.opponentReplyWidth = 2;
+    EXPECT_LE(widestReply(config, narrowed), 2u);
+    EXPECT_GT(full, 0);
+    EXPECT_GT(narrowed, 0);
+    config.numThreads = 4;  // tree-parallel expansion narrows the same way
+    EXPECT_LE(widestReply(config, narrowed), 2u);
+    config.numThreads = 1;
+
+    // Our own decisions keep every macro
+    MacroMCTSSearch search(nullptr, config, 42);
+    search.search(state);
+    MacroList macros;
+    std::vector<float> priors;
+    search.rootPriors(state, macros, priors);
+    EXPECT_EQ(search.exportTree(0).nodes[0].numChildren, macros.size());
+
+    // Below the minimum depth opponent nodes stay wide
+    config.opponentReplyMinDepth = 100;
+    EXPECT_GT(widestReply(config, full), 2u);
+}
+
+TEST(MacroMCTS, NodeBudgetRecyclesFrontierSubtrees) {
+    GameState state = makePlayState();
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 1500;
+
+    MacroMCTSSearch unbounded(nullptr, config, 42);
+    unbounded.search(state);
+    size_t fullTree = unbounded.exportTree(0).nodes.size();
+    EXPECT_EQ(unbounded.lastStats().recycleSweeps, 0);
+
+    const int budget = 300;
+    ASSERT_GT(fullTree, 2u * budget);
+    config.maxTreeNodes = budget;
+    MacroMCTSSearch bounded(nullptr, config, 42);
+    Macro m = bounded.search(state);
+    const SearchStats& stats = bounded.lastStats();
+    EXPECT_EQ(stats.iterations, 1500);
+    EXPECT_GT(stats.recycleSweeps, 0);
+    EXPECT_GT(stats.recycledNodes, 0);
+    // Over the budget by at most the last expansion's children
+    EXPECT_LE(bounded.exportTree(0).nodes.size(), static_cast<size_t>(budget + 64));
+    MacroList legal;
+    getAvailableMacros(state, legal);
+    EXPECT_TRUE(std::any_of(legal.begin(), legal.end(), [&](const Macro& l) {
+        return l.type == m.type && l.playerId == m.playerId && l.targetId == m.targetId;
+    }));
+
+    // Cached outcomes of recycled nodes go with them
+    config.stateCacheDepth = 3;
+    MacroMCTSSearch cached(nullptr, config, 42);
+    cached.search(state);
+    EXPECT_GT(cached.lastStats().recycledNodes, 0);
+    EXPECT_GT(cached.lastStats().cachedReplays, 0);
+    config.stateCacheDepth = 0;
+
+    // Tree-parallel workers stop expanding instead
+    config.numThreads = 4;
+    MacroMCTSSearch parallel(nullptr, config, 42);
+    parallel.search(state);
+    EXPECT_GT(parallel.lastStats().expansionsSkipped, 0);
+    EXPECT_EQ(parallel.lastStats().recycleSweeps, 0);
+    EXPECT_LE(parallel.exportTree(0).nodes.size(), static_cast<size_t>(budget + 4 * 64));
+}
+
 TEST(MacroMCTS, ChildVisitsRecorded) {
     GameState state = makePlayState();
 
@@ -596,6 +918,8 @@ TEST(MacroMCTSPolicy, ReturnsValidAction) {
         }
     }
     EXPECT_TRUE(found);
+    EXPECT_EQ(policy.searches(), 1);
+    EXPECT_EQ(policy.searchIterations(), policy.lastIterations());
 }
 
 TEST(MacroMCTSPolicy, PlanExecutionMultipleActions) {
@@ -649,7 +973,19 @@ TEST(MacroMCTSPolicy, DecisionLogging) {
         float sum = 0;
         for (auto& v : dec.visits) sum += v.visitFraction;
         EXPECT_NEAR(sum, 1.0f, 0.3f);
+        EXPECT_EQ(dec.search.iterations, policy.lastSearchStats().iterations);
+        EXPECT_EQ(dec.search.iterations, 50);
+        EXPECT_TRUE(dec.board.captured);
+        EXPECT_GT(dec.board.numPlayers(), 0);
     }
+
+    // Visits without boards
+    MacroMCTSPolicy noBoards(nullptr, config, 42);
+    noBoards.setLogDecisions(true, 10, false);
+    noBoards(state);
+    ASSERT_FALSE(noBoards.decisions().empty());
+    EXPECT_FALSE(noBoards.decisions()[0].board.captured);
+    EXPECT_FALSE(noBoards.decisions()[0].visits.empty());
 }
 
 TEST(MacroMCTSPolicy, FallbackOnInvalidPlan) {
@@ -689,3 +1025,384 @@ TEST(MacroMCTSPolicy, FallbackOnInvalidPlan) {
     }
     EXPECT_TRUE(found);
 }
+
+TEST(MacroMCTSPolicy, PonderingAdoptsTheOpponentsEndTurn) {
+    // Ponder the away side's position; its END_TURN leads to our turn
+    GameState state = makePlayState();
+    state.activeTeam = TeamSide::AWAY;
+    state.awayTeam.turnNumber = 1;
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 50;
+    MacroMCTSPolicy policy(nullptr, config, 42);
+    policy.ponder(state, 3000);
+    while (policy.pondering()) std::this_thread::yield();
+
+    DiceRoller dice(1);
+    executeAction(state, Action{ActionType::END_TURN, -1, -1, {-1, -1}}, dice, nullptr);
+    ASSERT_EQ(state.activeTeam, TeamSide::HOME);
+    policy(state);
+    EXPECT_FALSE(policy.pondering());
+    EXPECT_EQ(policy.ponderHits(), 1);
+    EXPECT_EQ(policy.searches(), 1);
+    EXPECT_EQ(policy.lastIterations(), 50);
+
+    // An unrelated position starts a fresh tree
+    MacroMCTSPolicy other(nullptr, config, 42);
+    GameState elsewhere = makePlayState();
+    elsewhere.activeTeam = TeamSide::AWAY;
+    elsewhere.ball = BallState::onGround({5, 5});
+    other.ponder(elsewhere, 500);
+    other(makePlayState());
+    EXPECT_EQ(other.ponderHits(), 0);
+}
+
+TEST(MacroMCTS, TimeBudgetEndsSearch) {
+    GameState state = makePlayState();
+
+    MCTSConfig config;
+    config.timeBudgetMs = 50;
+    config.maxIterations = 10000000;
+
+    MacroMCTSSearch search(nullptr, config, 42);
+    auto start = std::chrono::steady_clock::now();
+    search.search(state);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    EXPECT_LT(search.lastIterations(), config.maxIterations);
+    EXPECT_LT(elapsed, config.timeBudgetMs * 3);
+    EXPECT_FALSE(search.lastStats().stoppedEarly);
+}
+
+TEST(MacroMCTS, EarlyStopKeepsTheChoice) {
+    GameState state = makePlayState();
+
+    // Low exploration: one root child soon takes most visits
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 2000;
+    config.explorationC = 0.1;
+
+    MacroMCTSSearch full(nullptr, config, 42);
+    Macro fullPick = full.search(state);
+    ASSERT_EQ(full.lastIterations(), 2000);
+    EXPECT_FALSE(full.lastStats().stoppedEarly);
+
+    config.earlyStop = true;
+    MacroMCTSSearch early(nullptr, config, 42);
+    Macro earlyPick = early.search(state);
+    EXPECT_TRUE(early.lastStats().stoppedEarly);
+    EXPECT_LT(early.lastIterations(), 2000);
+    EXPECT_EQ(early.lastIterations() % 64, 0);
+    EXPECT_EQ(earlyPick.type, fullPick.type);
+    EXPECT_EQ(earlyPick.playerId, fullPick.playerId);
+    EXPECT_EQ(earlyPick.targetPos, fullPick.targetPos);
+}
+
+TEST(MacroMCTS, ParallelSearchStopsEarly) {
+    GameState state = makePlayState();
+
+    // Low exploration: one root child soon takes most visits. (The scoring
+    // state splits visits evenly between SCORE and END_TURN, so workers
+    // could miss the narrow settled window at the very end.)
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 4000;
+    config.explorationC = 0.1;
+    config.numThreads = 2;
+    config.earlyStop = true;
+
+    MacroMCTSSearch search(nullptr, config, 42);
+    search.search(state);
+    EXPECT_TRUE(search.lastStats().stoppedEarly);
+    EXPECT_LT(search.lastIterations(), 4000);
+    EXPECT_EQ(search.lastStats().iterations, search.lastIterations());
+}
+
+TEST(MacroMCTS, EarlyStopOnTheScoringPosition) {
+    // SCORE against END_TURN: the root settles only late in the budget, the
+    // window a stopping rule could overshoot
+    GameState state = makeScoringState();
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 2000;
+
+    MacroMCTSSearch full(nullptr, config, 42);
+    Macro fullPick = full.search(state);
+    ASSERT_EQ(fullPick.type, MacroType::SCORE);
+
+    config.earlyStop = true;
+    MacroMCTSSearch early(nullptr, config, 42);
+    Macro earlyPick = early.search(state);
+    EXPECT_TRUE(early.lastStats().stoppedEarly);
+    EXPECT_LT(early.lastIterations(), 2000);
+    EXPECT_EQ(earlyPick.type, fullPick.type);
+    EXPECT_EQ(earlyPick.playerId, fullPick.playerId);
+
+    // Parallel workers check with other workers' virtual losses still on the
+    // root's children. SCORE and END_TURN are near-equal here, so scheduling
+    // can decide the pick; what a stop must guarantee is that the runner-up
+    // could not have overtaken it with the iterations left unrun.
+    config.numThreads = 4;
+    for (uint32_t seed = 1; seed <= 10; ++seed) {
+        MacroMCTSSearch parallel(nullptr, config, seed);
+        parallel.search(state);
+        EXPECT_EQ(parallel.lastStats().iterations, parallel.lastIterations());
+        if (!parallel.lastStats().stoppedEarly) continue;
+        int best = 0, second = 0;
+        for (const MacroChildVisitInfo& c : parallel.lastChildVisits()) {
+            if (c.visits > best) {
+                second = best;
+                best = c.visits;
+            } else if (c.visits > second) {
+                second = c.visits;
+            }
+        }
+        EXPECT_GT(best - second, config.maxIterations - parallel.lastIterations()) << "seed " << seed;
+    }
+}
+
+TEST(MacroMCTS, StateCacheReplaysShallowNodesFromSamples) {
+    GameState state = makePlayState();
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 600;
+    config.stateCacheDepth = 2;
+    config.stateCacheSamples = 4;
+    config.nRollouts = 2;
+
+    MacroMCTSSearch a(nullptr, config, 42);
+    MacroMCTSSearch b(nullptr, config, 42);
+    Macro pickA = a.search(state);
+    Macro pickB = b.search(state);
+    EXPECT_EQ(a.lastIterations(), 600);
+    EXPECT_GT(a.lastStats().cachedReplays, 0);
+    EXPECT_EQ(a.lastStats().cachedReplays, b.lastStats().cachedReplays);
+    EXPECT_EQ(pickA.type, pickB.type);
+    EXPECT_EQ(pickA.playerId, pickB.playerId);
+
+    std::vector<Macro> macros;
+    getAvailableMacros(state, macros);
+    bool found = false;
+    for (auto& m : macros) found |= (m.type == pickA.type && m.playerId == pickA.playerId);
+    EXPECT_TRUE(found);
+
+    int totalVisits = 0;
+    for (auto& cv : a.lastChildVisits()) totalVisits += cv.visits;
+    EXPECT_EQ(totalVisits, 600);
+}
+
+TEST(MacroMCTS, LeafLookaheadReusesSamplesPerState) {
+    // The look-ahead only runs for our carrier on our turn
+    GameState state = makePlayState();
+    state.forEachOnPitch(TeamSide::HOME, [&](const Player& p) {
+        if (!state.ball.isHeld) state.ball = BallState::carried(p.position, p.id);
+    });
+    ASSERT_TRUE(state.ball.isHeld);
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 400;
+    config.nRollouts = 4;  // the same leaf, evaluated again
+    config.leafLookahead = true;
+    config.lookaheadSamples = 0;
+
+    MacroMCTSSearch fresh(nullptr, config, 42);
+    fresh.search(state);
+    EXPECT_EQ(fresh.lastStats().lookaheadReuses, 0);
+
+    config.lookaheadSamples = 2;
+    MacroMCTSSearch a(nullptr, config, 42);
+    MacroMCTSSearch b(nullptr, config, 42);
+    Macro pickA = a.search(state);
+    Macro pickB = b.search(state);
+    EXPECT_EQ(a.lastIterations(), 400);
+    EXPECT_GT(a.lastStats().lookaheadReuses, 0);
+    EXPECT_EQ(a.lastStats().lookaheadReuses, b.lastStats().lookaheadReuses);
+    EXPECT_EQ(pickA.type, pickB.type);
+    EXPECT_EQ(pickA.playerId, pickB.playerId);
+
+    // Parallel search samples every time
+    config.numThreads = 2;
+    MacroMCTSSearch parallel(nullptr, config, 42);
+    parallel.search(state);
+    EXPECT_EQ(parallel.lastStats().lookaheadReuses, 0);
+}
+
+TEST(MacroMCTS, StateCacheRespectsMemoryCap) {
+    GameState state = makePlayState();
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 300;
+
+    MacroMCTSSearch open(nullptr, config, 42);
+    Macro openPick = open.search(state);
+
+    // No room for a single sample: exactly the open-loop search
+    config.stateCacheDepth = 3;
+    config.stateCacheMB = 0;
+    MacroMCTSSearch capped(nullptr, config, 42);
+    Macro cappedPick = capped.search(state);
+    EXPECT_EQ(capped.lastStats().cachedReplays, 0);
+    EXPECT_EQ(cappedPick.type, openPick.type);
+    EXPECT_EQ(cappedPick.playerId, openPick.playerId);
+    ASSERT_EQ(capped.lastChildVisits().size(), open.lastChildVisits().size());
+    for (size_t i = 0; i < open.lastChildVisits().size(); ++i) {
+        EXPECT_EQ(capped.lastChildVisits()[i].visits, open.lastChildVisits()[i].visits);
+    }
+}
+
+TEST(MacroMCTS, ConcurrentRolloutsAreReproducible) {
+    GameState state = makePlayState();
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 300;
+    config.nRollouts = 4;
+    config.rolloutThreads = 3;
+
+    MacroMCTSSearch a(nullptr, config, 42);
+    MacroMCTSSearch b(nullptr, config, 42);
+    Macro pickA = a.search(state);
+    Macro pickB = b.search(state);
+    EXPECT_EQ(a.lastIterations(), 300);
+    EXPECT_EQ(pickA.type, pickB.type);
+    EXPECT_EQ(pickA.playerId, pickB.playerId);
+    EXPECT_EQ(a.lastStats().leafEvals, b.lastStats().leafEvals);
+    EXPECT_GT(a.lastStats().leafEvals, 300);
+    EXPECT_LE(a.lastStats().leafEvals, 1200);
+    ASSERT_EQ(a.lastChildVisits().size(), b.lastChildVisits().size());
+    for (size_t i = 0; i < a.lastChildVisits().size(); ++i) {
+        EXPECT_EQ(a.lastChildVisits()[i].visits, b.lastChildVisits()[i].visits);
+    }
+    // The pool survives across searches
+    a.search(state);
+    EXPECT_EQ(a.lastIterations(), 300);
+}
+
+TEST(MacroMCTS, CommonRandomNumbersAreReproducible) {
+    GameState state = makePlayState();
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 300;
+    config.nRollouts = 2;
+    config.commonRandomNumbers = true;
+
+    MacroMCTSSearch a(nullptr, config, 42);
+    MacroMCTSSearch b(nullptr, config, 42);
+    a.search(state);
+    b.search(state);
+    EXPECT_EQ(a.lastIterations(), 300);
+    ASSERT_EQ(a.lastChildVisits().size(), b.lastChildVisits().size());
+    for (size_t i = 0; i < a.lastChildVisits().size(); ++i) {
+        EXPECT_EQ(a.lastChildVisits()[i].visits, b.lastChildVisits()[i].visits);
+    }
+    EXPECT_EQ(a.lastBestValue(), b.lastBestValue());
+
+    // Same seed, independent dice: a different search
+    config.commonRandomNumbers = false;
+    MacroMCTSSearch c(nullptr, config, 42);
+    c.search(state);
+    EXPECT_NE(a.lastBestValue(), c.lastBestValue());
+}
+
+TEST(MacroMCTS, CommonRandomNumbersStillFindScore) {
+    GameState state = makeScoringState();
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 200;
+    config.commonRandomNumbers = true;
+    MacroMCTSSearch search(nullptr, config, 7);
+    EXPECT_EQ(search.search(state).type, MacroType::SCORE);
+}
+
+TEST(MacroMCTS, GumbelRootHalvesOverTopK) {
+    GameState state = makePlayState();
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 100;
+    config.gumbelTopK = 4;
+    MacroMCTSSearch search(nullptr, config, 42);
+    Macro pick = search.search(state);
+
+    // Two phases: 4 candidates x 12 visits, then 2 x 26
+    EXPECT_EQ(search.lastIterations(), 100);
+    const auto& children = search.lastChildVisits();
+    ASSERT_GT(children.size(), 4u);  // every child, visited or not
+    int visited = 0, finalists = 0;
+    float targetSum = 0.0f;
+    for (const auto& cv : children) {
+        if (cv.visits > 0) visited++;
+        if (cv.visits == 12 + 26) finalists++;
+        targetSum += cv.target;
+        if (cv.macro.type == pick.type && cv.macro.playerId == pick.playerId &&
+            cv.macro.targetPos == pick.targetPos) {
+            EXPECT_EQ(cv.visits, 38);
+        }
+    }
+    EXPECT_EQ(visited, 4);
+    EXPECT_EQ(finalists, 2);
+    EXPECT_NEAR(targetSum, 1.0f, 1e-4f);
+}
+
+TEST(MacroMCTS, GumbelRootFindsScoreOnSmallBudget) {
+    GameState state = makeScoringState();
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 24;
+    config.gumbelTopK = 8;
+    for (uint32_t seed : {1u, 2u, 3u}) {
+        MacroMCTSSearch search(nullptr, config, seed);
+        EXPECT_EQ(search.search(state).type, MacroType::SCORE) << "seed " << seed;
+        // The improved policy puts the most weight on scoring
+        const MacroChildVisitInfo* top = nullptr;
+        for (const auto& cv : search.lastChildVisits()) {
+            if (!top || cv.target > top->target) top = &cv;
+        }
+        ASSERT_NE(top, nullptr);
+        EXPECT_EQ(top->macro.type, MacroType::SCORE);
+    }
+}
+
+TEST(MacroMCTS, ParallelSearchKeepsThePUCTRoot) {
+    // gumbelTopK is serial only: tree-parallel workers search a PUCT root
+    // and the targets are visit shares
+    GameState state = makePlayState();
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 100;
+    config.gumbelTopK = 4;
+    config.numThreads = 4;
+    MacroMCTSSearch search(nullptr, config, 42);
+    search.search(state);
+    EXPECT_EQ(search.lastIterations(), 100);
+    int total = 0, visited = 0;
+    for (const auto& cv : search.lastChildVisits()) {
+        total += cv.visits;
+        if (cv.visits > 0) visited++;
+    }
+    EXPECT_EQ(total, 100);
+    EXPECT_GT(visited, 4);
+    for (const auto& cv : search.lastChildVisits()) {
+        EXPECT_FLOAT_EQ(cv.target, static_cast<float>(cv.visits) / total);
+    }
+}
+
+TEST(MacroMCTS, VisitShareIsTheTargetWithoutGumbel) {
+    GameState state = makePlayState();
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 100;
+    MacroMCTSSearch search(nullptr, config, 42);
+    search.search(state);
+    int total = 0;
+    for (const auto& cv : search.lastChildVisits()) total += cv.visits;
+    for (const auto& cv : search.lastChildVisits()) {
+        EXPECT_FLOAT_EQ(cv.target, static_cast<float>(cv.visits) / total);
+    }
+}
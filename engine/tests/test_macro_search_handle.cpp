@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "bb/macro_search_handle.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+#include <thread>
+
+using namespace bb;
+
+namespace {
+
+GameState makePlayState() {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getHumanRoster());
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.half = 1;
+    state.homeTeam.turnNumber = 1;
+    state.weather = Weather::NICE;
+    state.ball = BallState::onGround({13, 7});
+    return state;
+}
+
+bool sameMacro(const Macro& a, const Macro& b) {
+    return a.type == b.type && a.playerId == b.playerId && a.targetId == b.targetId &&
+           a.targetPos == b.targetPos && a.thirdId == b.thirdId;
+}
+
+} // anonymous namespace
+
+TEST(MacroSearchHandle, MatchesTheBlockingSearch) {
+    GameState state = makePlayState();
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 500;
+
+    MacroMCTSSearch blocking(nullptr, config, 7);
+    Macro expected = blocking.search(state);
+
+    MacroMCTSSearch async(nullptr, config, 7);
+    auto handle = async.searchAsync(state, 0, 500);
+    Macro best = handle->wait();
+    EXPECT_TRUE(sameMacro(best, expected));
+    MacroSearchHandle::Progress p = handle->poll();
+    EXPECT_TRUE(p.done);
+    EXPECT_TRUE(handle->done());
+    EXPECT_EQ(p.iterations, blocking.lastIterations());
+    EXPECT_TRUE(sameMacro(p.best, expected));
+    EXPECT_EQ(p.visits.size(), blocking.lastChildVisits().size());
+}
+
+TEST(MacroSearchHandle, PollsProgressAndCancels) {
+    GameState state = makePlayState();
+    MCTSConfig config;
+    MacroMCTSSearch search(nullptr, config, 3);
+    auto handle = search.searchAsync(state, 0, 1 << 30);
+
+    MacroSearchHandle::Progress p = handle->poll();
+    while (!p.hasBest) {
+        std::this_thread::yield();
+        p = handle->poll();
+    }
+    EXPECT_FALSE(p.done);
+    EXPECT_GE(p.iterations, 64);
+    ASSERT_FALSE(p.visits.empty());
+    float shares = 0.0f;
+    for (const auto& v : p.visits) shares += v.target;
+    EXPECT_NEAR(shares, 1.0f, 1e-4f);
+
+    handle->cancel();
+    handle->wait();
+    p = handle->poll();
+    EXPECT_TRUE(p.done);
+    EXPECT_LT(p.iterations, 1 << 30);
+    EXPECT_TRUE(p.hasBest);
+}
+
+TEST(MacroSearchHandle, ExtendsTheBudget) {
+    // The hook may move the budget mid-search
+    GameState state = makePlayState();
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 128;
+    MacroMCTSSearch search(nullptr, config, 5);
+    search.setProgress([&](int iterations) {
+        if (iterations == 64) search.setBudget(0, 640);
+        return true;
+    });
+    search.search(state);
+    EXPECT_EQ(search.lastIterations(), 640);
+    search.setProgress([](int iterations) { return iterations < 192; });
+    search.search(state);
+    EXPECT_EQ(search.lastIterations(), 192);
+    search.setProgress(nullptr);
+
+    // Through the handle: a 150 ms search given 300 ms more at its first report
+    auto handle = search.searchAsync(state, 150, 1 << 30);
+    handle->extend(300, 0);
+    handle->wait();
+    EXPECT_GE(handle->poll().elapsedMs, 440.0);
+}
+
+TEST(MacroSearchHandle, ParallelSearchReportsProgress) {
+    GameState state = makePlayState();
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 128;
+    config.numThreads = 4;
+    MacroMCTSSearch search(nullptr, config, 5);
+    std::vector<int> reports;
+    search.setProgress([&](int iterations) {
+        reports.push_back(iterations);
+        if (iterations == 64) search.setBudget(0, 640);
+        return true;
+    });
+    search.search(state);
+    EXPECT_EQ(search.lastIterations(), 640);
+    ASSERT_EQ(reports.size(), 10u);
+    for (size_t i = 0; i < reports.size(); ++i) EXPECT_EQ(reports[i], 64 * static_cast<int>(i + 1));
+
+    // Paths already out when the hook says stop still finish
+    search.setProgress([](int iterations) { return iterations < 192; });
+    search.search(state);
+    EXPECT_GE(search.lastIterations(), 192);
+    EXPECT_LT(search.lastIterations(), 192 + config.numThreads);
+    search.setProgress(nullptr);
+
+    auto handle = search.searchAsync(state, 0, 1 << 30);
+    MacroSearchHandle::Progress p = handle->poll();
+    while (!p.hasBest) {
+        std::this_thread::yield();
+        p = handle->poll();
+    }
+    EXPECT_GE(p.iterations, 64);
+    handle->cancel();
+    handle->wait();
+    EXPECT_LT(handle->poll().iterations, 1 << 30);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "bb/matchup_features.h"
+#include "bb/action_resolver.h"
+#include "bb/game_simulator.h"
+#include "bb/rules_engine.h"
+#include <algorithm>
+
+using namespace bb;
+
+static bool hasActionOfType(const std::vector<Action>& actions, ActionType type) {
+    return std::any_of(actions.begin(), actions.end(), [&](const Action& a) { return a.type == type; });
+}
+
+TEST(MatchupFeatures, FromRosters) {
+    // Humans: an Ogre (Bone Head, Throw Team-Mate) but nobody with Right Stuff
+    EXPECT_EQ(matchupFeatures(getHumanRoster(), getHumanRoster()), feature::BIG_GUY);
+    // Orcs bring Goblins to throw
+    EXPECT_EQ(matchupFeatures(getHumanRoster(), getOrcRoster()),
+              feature::BIG_GUY | feature::THROW_TEAM_MATE);
+}
+
+TEST(MatchupFeatures, StateFeaturesStayWithinRosterFeatures) {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getOrcRoster());
+    MatchupFeatures f = matchupFeatures(state);
+    EXPECT_EQ(f & ~matchupFeatures(getHumanRoster(), getOrcRoster()), 0u);
+
+    state.getPlayer(3).addSkill(SkillName::HypnoticGaze);
+    state.invalidateOccupancy();
+    EXPECT_TRUE(matchupFeatures(state) & feature::HYPNOTIC_GAZE);
+}
+
+TEST(MatchupFeatures, NarrowestInstantiationCoversTheMatchup) {
+#ifndef BB_GENERIC_RULES
+    EXPECT_EQ(instantiatedFeatures(0), 0u);
+    EXPECT_EQ(instantiatedFeatures(feature::BIG_GUY), feature::BIG_GUY);
+    EXPECT_EQ(instantiatedFeatures(feature::THROW_TEAM_MATE), feature::BIG_GUY | feature::THROW_TEAM_MATE);
+#endif
+    EXPECT_EQ(instantiatedFeatures(feature::BOMBARDIER | feature::BIG_GUY), feature::ALL);
+    for (MatchupFeatures f = 0; f <= feature::ALL; ++f) {
+        EXPECT_EQ(f & ~instantiatedFeatures(f), 0u) << f;
+        MatchupFeatures ran = withMatchupFeatures(f, [](auto m) { return m.value; });
+        EXPECT_EQ(ran, instantiatedFeatures(f));
+    }
+}
+
+TEST(MatchupFeatures, RareSkillActionsAppearOnceTheSkillDoes) {
+    GameState gs;
+    gs.phase = GamePhase::PLAY;
+    gs.activeTeam = TeamSide::HOME;
+    Player& p = gs.getPlayer(1);
+    p.state = PlayerState::STANDING;
+    p.setStats({6, 3, 3, 8});
+    p.movementRemaining = 6;
+    gs.movePlayer(p, {10, 7});
+    Player& enemy = gs.getPlayer(12);
+    enemy.state = PlayerState::STANDING;
+    enemy.setStats({6, 3, 3, 8});
+    gs.movePlayer(enemy, {11, 7});
+
+    std::vector<Action> actions;
+    getAvailableActions(gs, actions);
+    EXPECT_EQ(matchupFeatures(gs), 0u);
+    EXPECT_FALSE(hasActionOfType(actions, ActionType::HYPNOTIC_GAZE));
+
+    p.addSkill(SkillName::HypnoticGaze);
+    p.addSkill(SkillName::Bombardier);
+    gs.invalidateOccupancy();
+    getAvailableActions(gs, actions);
+    EXPECT_TRUE(hasActionOfType(actions, ActionType::HYPNOTIC_GAZE));
+    EXPECT_TRUE(hasActionOfType(actions, ActionType::BOMB_THROW));
+    std::vector<Action> own;
+    getPlayerActions(gs, p, own);
+    EXPECT_TRUE(hasActionOfType(own, ActionType::HYPNOTIC_GAZE));
+}
@@ -7,6 +7,8 @@
 #include "bb/action_resolver.h"
 #include <chrono>
 #include <cmath>
+#include <map>
+#include <tuple>
 
 using namespace bb;
 
@@ -26,6 +28,35 @@ GameState makePlayState() {
     return state;
 }
 
+// Give `parent` (the root, arena index 0) a contiguous block of `n` children.
+std::span<MCTSNode> addChildren(MCTSArena& arena, MCTSNode& parent, uint32_t n) {
+    uint32_t first = arena.allocate(n);
+    for (uint32_t i = 0; i < n; ++i) arena[first + i].parent = 0;
+    parent.firstChild = first;
+    parent.numChildren = n;
+    return arena.children(parent);
+}
+
+// Two home players and one away player, far apart with the ball loose
+// between them: every move the home side can make is dice-free, so the
+// position after the chosen move is the one the search expanded.
+GameState makeQuietState() {
+    GameState state;
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.homeTeam.turnNumber = 1;
+    state.awayTeam.turnNumber = 1;
+    for (int id : {1, 2, 12}) {
+        Player& p = state.getPlayer(id);
+        p.state = PlayerState::STANDING;
+        p.position = id == 1 ? Position{3, 3} : id == 2 ? Position{3, 11} : Position{22, 12};
+        p.setStats({6, 3, 3, 8});
+        p.movementRemaining = 6;
+    }
+    state.ball = BallState::onGround({13, 7});
+    return state;
+}
+
 } // anonymous namespace
 
 TEST(MCTSNode, UCBFormula) {
@@ -49,36 +80,35 @@ TEST(MCTSNode, UCBUnvisitedIsInfinite) {
 }
 
 TEST(MCTSNode, MostVisitedChild) {
-    MCTSNode root;
-    root.children.resize(3);
-    root.children[0].visits = 5;
-    root.children[1].visits = 20;
-    root.children[2].visits = 10;
-
-    MCTSNode* best = root.mostVisitedChild();
+    MCTSArena arena;
+    MCTSNode& root = arena[arena.allocate(1)];
+    auto children = addChildren(arena, root, 3);
+    children[0].visits = 5;
+    children[1].visits = 20;
+    children[2].visits = 10;
+
+    MCTSNode* best = arena.get(root.mostVisitedChild(arena));
     ASSERT_NE(best, nullptr);
     EXPECT_EQ(best->visits, 20);
 }
 
 TEST(MCTSNode, BestChildSelection) {
-    MCTSNode root;
+    MCTSArena arena;
+    MCTSNode& root = arena[arena.allocate(1)];
     root.visits = 30;
-    root.children.resize(3);
+    auto children = addChildren(arena, root, 3);
 
-    root.children[0].visits = 10;
-    root.children[0].totalValue = 8.0;  // avg 0.8
-    root.children[0].parent = &root;
+    children[0].visits = 10;
+    children[0].totalValue = 8.0;  // avg 0.8
 
-    root.children[1].visits = 10;
-    root.children[1].totalValue = 2.0;  // avg 0.2
-    root.children[1].parent = &root;
+    children[1].visits = 10;
+    children[1].totalValue = 2.0;  // avg 0.2
 
-    root.children[2].visits = 10;
-    root.children[2].totalValue = 5.0;  // avg 0.5
-    root.children[2].parent = &root;
+    children[2].visits = 10;
+    children[2].totalValue = 5.0;  // avg 0.5
 
     // With zero exploration, should pick highest avg
-    MCTSNode* best = root.bestChild(0.0);
+    MCTSNode* best = arena.get(root.bestChild(arena, 0.0));
     ASSERT_NE(best, nullptr);
     EXPECT_NEAR(best->totalValue / best->visits, 0.8, 0.001);
 }
@@ -127,6 +157,107 @@ TEST(MCTS, SearchWithValueFunction) {
     EXPECT_GT(search.lastIterations(), 0);
 }
 
+TEST(MCTS, SubtreeReusedWhenPositionRecurs) {
+    GameState state = makeQuietState();
+    MCTSConfig config;
+    config.timeBudgetMs = 100000;
+    config.maxIterations = 400;
+    config.reuseTree = true;
+
+    MCTSSearch search(nullptr, config, 7);
+    Action a = search.search(state);
+    EXPECT_EQ(search.lastReusedVisits(), 0);
+
+    DiceRoller dice(1);
+    executeAction(state, a, dice, nullptr);
+    search.search(state);
+    EXPECT_GT(search.lastReusedVisits(), 0);
+    EXPECT_EQ(search.lastIterations(), 400);
+}
+
+TEST(MCTS, SubtreeNotReusedForOtherPosition) {
+    GameState state = makeQuietState();
+    MCTSConfig config;
+    config.timeBudgetMs = 100000;
+    config.maxIterations = 200;
+    config.reuseTree = true;
+
+    MCTSSearch search(nullptr, config, 7);
+    search.search(state);
+    // Searching the same root again is not a continuation of any child.
+    search.search(state);
+    EXPECT_EQ(search.lastReusedVisits(), 0);
+
+    config.reuseTree = false;
+    MCTSSearch fresh(nullptr, config, 7);
+    Action a = fresh.search(state);
+    DiceRoller dice(1);
+    executeAction(state, a, dice, nullptr);
+    fresh.search(state);
+    EXPECT_EQ(fresh.lastReusedVisits(), 0);
+}
+
+TEST(MCTS, RootParallelSumsIndependentTrees) {
+    GameState state = makePlayState();
+    MCTSConfig config;
+    config.timeBudgetMs = 100000;
+    config.maxIterations = 150;
+
+    // Tree i is seeded 42 + 7919 * i; its counts must match a lone search.
+    std::map<std::tuple<int, int, int, int, int>, int> expected;
+    auto key = [](const Action& a) {
+        return std::make_tuple(static_cast<int>(a.type), a.playerId, a.targetId,
+                               a.target.x, a.target.y);
+    };
+    for (uint32_t i = 0; i < 3; ++i) {
+        MCTSSearch single(nullptr, config, 42 + 7919 * i);
+        single.search(state);
+        for (auto& cv : single.lastChildVisits()) expected[key(cv.action)] += cv.visits;
+    }
+
+    config.rootParallel = 3;
+    MCTSSearch ensemble(nullptr, config, 42);
+    Action best = ensemble.search(state);
+    EXPECT_EQ(ensemble.lastIterations(), 450);
+
+    std::map<std::tuple<int, int, int, int, int>, int> merged;
+    int bestVisits = 0;
+    for (auto& cv : ensemble.lastChildVisits()) {
+        merged[key(cv.action)] = cv.visits;
+        bestVisits = std::max(bestVisits, cv.visits);
+    }
+    EXPECT_EQ(merged, expected);
+    EXPECT_EQ(merged[key(best)], bestVisits);
+}
+
+TEST(MCTS, SearchStatsAccountForEveryIteration) {
+    GameState state = makePlayState();
+    MCTSConfig config;
+    config.timeBudgetMs = 100000;
+    config.maxIterations = 150;
+
+    MCTSSearch search(nullptr, config, 42);
+    search.search(state);
+    const SearchStats& stats = search.lastStats();
+    EXPECT_EQ(stats.iterations, 150);
+    EXPECT_EQ(stats.leafEvals + stats.truncatedReplays, 150);
+    EXPECT_GT(stats.nodesAllocated, 1);
+    EXPECT_GE(stats.maxDepth, 1);
+    EXPECT_GT(stats.avgDepth, 0.0);
+    EXPECT_LE(stats.avgDepth, stats.maxDepth);
+    double phases = stats.selectMs + stats.replayMs + stats.expandMs +
+                    stats.simulateMs + stats.backpropMs;
+    EXPECT_LE(phases, stats.totalMs);
+    EXPECT_GT(stats.iterationsPerSec, 0.0);
+
+    // Root-parallel: the ensemble's stats are the sum of its trees'
+    config.rootParallel = 3;
+    MCTSSearch ensemble(nullptr, config, 42);
+    ensemble.search(state);
+    EXPECT_EQ(ensemble.lastStats().iterations, 450);
+    EXPECT_EQ(ensemble.lastStats().leafEvals + ensemble.lastStats().truncatedReplays, 450);
+}
+
 TEST(MCTS, TimeBudgetRespected) {
     GameState state = makePlayState();
 
@@ -161,6 +292,8 @@ TEST(MCTS, SingleActionNoSearch) {
 
     EXPECT_EQ(action.type, ActionType::END_TURN);
     EXPECT_EQ(search.lastIterations(), 0);
+    EXPECT_EQ(search.lastStats().iterations, 0);
+    EXPECT_EQ(search.lastStats().totalMs, 0.0);
 }
 
 TEST(MCTS, TrivialScoringPosition) {
@@ -179,8 +312,8 @@ TEST(MCTS, TrivialScoringPosition) {
     carrier.teamSide = TeamSide::HOME;
     carrier.state = PlayerState::STANDING;
     carrier.position = {24, 7};
-    carrier.stats = {6, 3, 3, 8};
-    carrier.skills.add(SkillName::SureHands);
+    carrier.setStats({6, 3, 3, 8});
+    carrier.addSkill(SkillName::SureHands);
     carrier.movementRemaining = 6;
     carrier.hasMoved = false;
     carrier.hasActed = false;
@@ -222,3 +355,111 @@ TEST(MCTS, ExpandCreatesChildren) {
     // After search, iterations should have been performed
     EXPECT_GT(search.lastIterations(), 0);
 }
+
+TEST(MCTS, PathMovesSearchOverEndpoints) {
+    GameState state = makeQuietState();
+    MCTSConfig config;
+    config.maxIterations = 200;
+    config.timeBudgetMs = 0;
+    config.pathMoves = true;
+
+    MCTSSearch search(nullptr, config, 3);
+    Action action = search.search(state);
+
+    std::vector<Action> actions;
+    getAvailableActionsWithPaths(state, actions);
+    ASSERT_FALSE(search.lastChildVisits().empty());
+    for (auto& child : search.lastChildVisits()) EXPECT_NE(child.action.type, ActionType::MOVE);
+    bool found = false;
+    for (auto& a : actions) {
+        found |= a.type == action.type && a.playerId == action.playerId && a.target == action.target;
+    }
+    EXPECT_TRUE(found);
+}
+
+TEST(MCTS, ChanceNodesBranchOnBlockOutcomes) {
+    // Setup lines face each other: blocks are on offer, and with chance
+    // nodes each one the search revisits splits into weighted outcomes
+    GameState state = makePlayState();
+    MCTSConfig config;
+    config.maxIterations = 600;
+    config.timeBudgetMs = 10000;
+    config.chanceNodes = true;
+
+    MCTSSearch search(nullptr, config, 17);
+    Action action = search.search(state);
+    EXPECT_EQ(search.lastIterations(), 600);
+
+    std::vector<Action> actions;
+    getAvailableActions(state, actions);
+    bool found = false;
+    for (auto& a : actions) {
+        found |= a.type == action.type && a.playerId == action.playerId &&
+                 a.targetId == action.targetId && a.target == action.target;
+    }
+    EXPECT_TRUE(found);
+    for (const ChildVisitInfo& child : search.lastChildVisits()) {
+        double q = child.totalValue / child.visits;
+        EXPECT_GE(q, -1.0 - 1e-9);
+        EXPECT_LE(q, 1.0 + 1e-9);
+    }
+}
+
+TEST(MCTS, ExpectedResolutionRollouts) {
+    GameState state = makePlayState();
+    MCTSConfig config;
+    config.maxIterations = 200;
+    config.timeBudgetMs = 10000;
+    config.rolloutDepth = 20;
+    config.expectedResolution = true;
+
+    MCTSSearch search(nullptr, config, 23);
+    search.search(state);
+    EXPECT_EQ(search.lastIterations(), 200);
+    EXPECT_FALSE(search.lastChildVisits().empty());
+}
+
+TEST(MCTS, PrefilterRunsPolicyOnHeuristicSurvivors) {
+    GameState state = makePlayState();
+    std::vector<Action> actions;
+    getAvailableActions(state, actions);
+    int contact = 0;
+    for (const Action& a : actions) {
+        contact += a.type == ActionType::BLOCK || a.type == ActionType::BLITZ;
+    }
+    ASSERT_GE(contact, 16);  // the heuristic's top tier fills the survivors
+
+    PolicyNetwork uniform;
+    MCTSConfig config;
+    config.maxIterations = 200;
+    config.timeBudgetMs = 0;
+    config.policy = &uniform;
+    config.maxChildren = 8;
+    config.prefilterChildren = 16;
+    MCTSSearch search(nullptr, config, 5);
+    search.search(state);
+    ASSERT_FALSE(search.lastChildVisits().empty());
+    EXPECT_LE(search.lastChildVisits().size(), 8u);
+    for (const ChildVisitInfo& child : search.lastChildVisits()) {
+        EXPECT_TRUE(child.action.type == ActionType::BLOCK || child.action.type == ActionType::BLITZ);
+    }
+}
+
+TEST(MCTS, WideningOpensChildrenAsVisitsGrow) {
+    GameState state = makePlayState();
+    PolicyNetwork uniform;
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.policy = &uniform;
+    config.wideningExponent = 0.5f;
+
+    config.maxIterations = 24;  // root visits <= 25: at most ceil(2 * 5) children open
+    MCTSSearch few(nullptr, config, 5);
+    few.search(state);
+    EXPECT_LE(few.lastChildVisits().size(), 10u);
+
+    config.maxIterations = 400;
+    MCTSSearch many(nullptr, config, 5);
+    many.search(state);
+    EXPECT_GT(many.lastChildVisits().size(), few.lastChildVisits().size());
+}
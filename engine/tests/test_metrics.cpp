@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "bb/game_simulator.h"
+#include "bb/metrics.h"
+#include "bb/move_server.h"
+#include "bb/roster.h"
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <sstream>
+
+using namespace bb;
+
+namespace {
+
+bool contains(const std::string& text, const std::string& line) {
+    return text.find(line) != std::string::npos;
+}
+
+} // anonymous namespace
+
+TEST(Metrics, RendersPrometheusText) {
+    MetricsRegistry metrics;
+    metrics.counter("bb_games_completed_total", "Games played to the end").inc();
+    metrics.counter("bb_games_completed_total", "Games played to the end").inc(2);
+    metrics.gauge("bb_queue_depth", "Waiting", metricLabel("pool", "a\"b\\c")).set(4);
+    MetricHistogram& h = metrics.histogram("bb_search_seconds", "Search time", {0.1, 1.0}, metricLabel("ai", "mcts"));
+    h.observe(0.05);
+    h.observe(0.1);   // a bound belongs to its own bucket
+    h.observe(0.5);
+    h.observe(7.0);
+
+    std::string text = metrics.renderPrometheus();
+    EXPECT_TRUE(contains(text, "# TYPE bb_games_completed_total counter\nbb_games_completed_total 3\n"));
+    EXPECT_TRUE(contains(text, "# HELP bb_queue_depth Waiting\n"));
+    EXPECT_TRUE(contains(text, "bb_queue_depth{pool=\"a\\\"b\\\\c\"} 4\n"));
+    EXPECT_TRUE(contains(text, "# TYPE bb_search_seconds histogram\n"));
+    EXPECT_TRUE(contains(text, "bb_search_seconds_bucket{ai=\"mcts\",le=\"0.10000000000000001\"} 2\n"));
+    EXPECT_TRUE(contains(text, "bb_search_seconds_bucket{ai=\"mcts\",le=\"1\"} 3\n"));
+    EXPECT_TRUE(contains(text, "bb_search_seconds_bucket{ai=\"mcts\",le=\"+Inf\"} 4\n"));
+    EXPECT_TRUE(contains(text, "bb_search_seconds_count{ai=\"mcts\"} 4\n"));
+    EXPECT_EQ(h.cumulativeCounts(), (std::vector<uint64_t>{2, 3, 4}));
+    EXPECT_DOUBLE_EQ(h.sum(), 7.65);
+    // Families stay in registration order
+    EXPECT_LT(text.find("bb_games_completed_total"), text.find("bb_queue_depth"));
+
+    EXPECT_THROW(metrics.gauge("bb_games_completed_total", "Not a gauge"), std::invalid_argument);
+    EXPECT_THROW(MetricHistogram({1.0, 0.5}), std::invalid_argument);
+}
+
+TEST(Metrics, RecordsDecisionsAndSearches) {
+    MetricsRegistry metrics;
+    recordDecision(metrics, "greedy", 0.01, nullptr);
+    SearchStats forced;  // no iterations: a decision, not a search
+    recordDecision(metrics, "macro_mcts", 0.02, &forced);
+    SearchStats stats;
+    stats.iterations = 300;
+    stats.priorCacheHits = 5;
+    stats.priorCacheMisses = 7;
+    stats.rootCacheHit = true;
+    recordDecision(metrics, "macro_mcts", 40.0, &stats);
+
+    std::string text = metrics.renderPrometheus();
+    EXPECT_TRUE(contains(text, "bb_decisions_total{ai=\"greedy\"} 1\n"));
+    EXPECT_TRUE(contains(text, "bb_decisions_total{ai=\"macro_mcts\"} 2\n"));
+    EXPECT_TRUE(contains(text, "bb_search_seconds_count{ai=\"macro_mcts\"} 1\n"));
+    EXPECT_TRUE(contains(text, "bb_search_seconds_sum{ai=\"macro_mcts\"} 0.040000000000000001\n"));
+    EXPECT_TRUE(contains(text, "bb_search_iterations_bucket{ai=\"macro_mcts\",le=\"500\"} 1\n"));
+    EXPECT_TRUE(contains(text, "bb_prior_cache_hits_total{ai=\"macro_mcts\"} 5\n"));
+    EXPECT_TRUE(contains(text, "bb_prior_cache_misses_total{ai=\"macro_mcts\"} 7\n"));
+    EXPECT_TRUE(contains(text, "bb_root_cache_hits_total{ai=\"macro_mcts\"} 1\n"));
+    EXPECT_FALSE(contains(text, "bb_search_seconds_count{ai=\"greedy\"}"));
+
+    updateProcessMetrics(metrics);
+    EXPECT_TRUE(contains(metrics.renderPrometheus(), "bb_peak_resident_memory_bytes "));
+}
+
+TEST(Metrics, WritesTextFileWhole) {
+    std::string path = (std::filesystem::temp_directory_path() / "bb_metrics_test.prom").string();
+    std::filesystem::remove(path);
+    MetricsRegistry metrics;
+    MetricCounter& games = metrics.counter("bb_games_completed_total", "Games");
+    MetricsFile file(metrics, path, 60000);
+    games.inc();
+    ASSERT_TRUE(file.update());
+    games.inc();
+    EXPECT_TRUE(file.update());  // within the interval: not rewritten
+    auto read = [&path] {
+        std::ifstream in(path);
+        std::stringstream text;
+        text << in.rdbuf();
+        return text.str();
+    };
+    EXPECT_TRUE(contains(read(), "bb_games_completed_total 1\n"));
+    ASSERT_TRUE(file.update(true));
+    EXPECT_TRUE(contains(read(), "bb_games_completed_total 2\n"));
+    EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+    EXPECT_FALSE(MetricsFile(metrics, "/nonexistent/dir/bb.prom").update());
+    std::filesystem::remove(path);
+}
+
+TEST(Metrics, MoveServerExportsRequestsAndQueue) {
+    MoveServerConfig config;
+    config.workers = 1;
+    MoveServer server(config);
+    MoveRequest r;
+    r.tag = "m";
+    setupHalf(r.state, getHumanRoster(), getOrcRoster());
+    r.state.phase = GamePhase::PLAY;
+    r.state.activeTeam = TeamSide::HOME;
+    r.state.half = 1;
+    r.state.homeTeam.turnNumber = 1;
+    r.state.ball = BallState::onGround({13, 7});
+    r.timeBudgetMs = 60000;
+    r.maxIterations = 50;
+    std::promise<MoveReply> done;
+    ASSERT_NE(server.submit(std::move(r), [&done](const MoveReply& reply) { done.set_value(reply); }), 0u);
+    ASSERT_EQ(done.get_future().get().status, MoveStatus::OK);
+
+    std::string text = server.metricsText();
+    EXPECT_TRUE(contains(text, "bb_requests_total{status=\"ok\"} 1\n"));
+    EXPECT_TRUE(contains(text, "bb_queue_seconds_count 1\n"));
+    EXPECT_TRUE(contains(text, "bb_decisions_total{ai=\"macro_mcts\"} 1\n"));
+    EXPECT_TRUE(contains(text, "bb_search_iterations_count{ai=\"macro_mcts\"} 1\n"));
+    EXPECT_TRUE(contains(text, "bb_queue_depth 0\n"));
+    EXPECT_TRUE(contains(text, "bb_workers 1\n"));
+
+    EXPECT_EQ(parseServerMessage(R"({"op":"metrics"})").op, ServerOp::METRICS);
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "bb/mlp.h"
+#include "bb/policy_network.h"
+#include "bb/weights_file.h"
+#include <nlohmann/json.hpp>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+using namespace bb;
+
+namespace {
+
+std::vector<MlpLayer> randomLayers(const std::vector<int>& widths, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-0.3f, 0.3f);
+    std::vector<MlpLayer> layers;
+    for (size_t l = 0; l + 1 < widths.size(); ++l) {
+        MlpLayer layer;
+        layer.inputs = widths[l];
+        layer.outputs = widths[l + 1];
+        layer.weights.resize(static_cast<size_t>(layer.inputs) * layer.outputs);
+        for (float& w : layer.weights) w = dist(rng);
+        layer.bias.resize(layer.outputs);
+        for (float& b : layer.bias) b = dist(rng);
+        layers.push_back(std::move(layer));
+    }
+    return layers;
+}
+
+std::vector<float> reference(const std::vector<MlpLayer>& layers, bool residual, std::vector<float> x) {
+    for (size_t l = 0; l < layers.size(); ++l) {
+        const MlpLayer& layer = layers[l];
+        std::vector<float> y(layer.outputs);
+        for (int j = 0; j < layer.outputs; ++j) {
+            double s = layer.bias[j];
+            for (int i = 0; i < layer.inputs; ++i) s += layer.weights[j * layer.inputs + i] * x[i];
+            y[j] = static_cast<float>(s);
+        }
+        if (l + 1 < layers.size()) {
+            for (int j = 0; j < layer.outputs; ++j) {
+                y[j] = std::max(0.0f, y[j]);
+                if (residual && layer.inputs == layer.outputs) y[j] += x[j];
+            }
+        }
+        x = std::move(y);
+    }
+    return x;
+}
+
+std::vector<float> randomInput(int n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> x(n);
+    for (float& v : x) v = dist(rng);
+    return x;
+}
+
+} // namespace
+
+TEST(Mlp, ForwardMatchesReferenceForFixedAndOddWidths) {
+    const std::vector<std::vector<int>> shapes = {
+        {NUM_FEATURES, 32, 32, 1},
+        {NUM_FEATURES, 64, 64, 64, 1},
+        {NUM_FEATURES, 128, 128, 3},
+        {NUM_FEATURES, 256, 256, 1},
+        {NUM_FEATURES, 48, 40, 48, 1},  // runtime-sized fallback
+    };
+    for (bool residual : {false, true}) {
+        for (size_t s = 0; s < shapes.size(); ++s) {
+            auto layers = randomLayers(shapes[s], static_cast<uint32_t>(s + 1));
+            Mlp net(layers, residual);
+            std::vector<float> x = randomInput(NUM_FEATURES, 9);
+            std::vector<float> expected = reference(layers, residual, x);
+            std::vector<float> out(net.outputSize());
+            net.forward(x.data(), out.data());
+            for (int k = 0; k < net.outputSize(); ++k) {
+                EXPECT_NEAR(out[k], expected[k], 1e-4f) << "shape " << s << " residual " << residual;
+            }
+        }
+    }
+    auto broken = randomLayers({10, 20, 1}, 1);
+    broken[1].inputs = 21;
+    EXPECT_THROW(Mlp(broken, false), std::invalid_argument);
+}
+
+TEST(Mlp, OneHiddenLayerMatchesNeuralValueFunction) {
+    auto layers = randomLayers({NUM_FEATURES, 16, 1}, 4);
+    nlohmann::json neural, mlp;
+    neural["type"] = "neural";
+    neural["hidden_size"] = 16;
+    nlohmann::json layersJson = nlohmann::json::array();
+    for (const MlpLayer& l : layers) {
+        nlohmann::json W = nlohmann::json::array();
+        for (int i = 0; i < l.inputs; ++i) {
+            nlohmann::json row = nlohmann::json::array();
+            for (int j = 0; j < l.outputs; ++j) row.push_back(l.weights[j * l.inputs + i]);
+            W.push_back(row);
+        }
+        layersJson.push_back({{"W", W}, {"b", l.bias}});
+    }
+    neural["W1"] = layersJson[0]["W"];
+    neural["b1"] = layersJson[0]["b"];
+    neural["W2"] = layersJson[1]["W"];
+    neural["b2"] = layersJson[1]["b"];
+    mlp["type"] = "mlp";
+    mlp["layers"] = layersJson;
+
+    auto a = loadValueFunctionFromString(neural.dump());
+    auto b = loadValueFunctionFromString(mlp.dump());
+    ASSERT_NE(dynamic_cast<MlpValueFunction*>(b.get()), nullptr);
+    std::vector<float> x = randomInput(NUM_FEATURES, 5);
+    EXPECT_NEAR(a->evaluate(x.data(), NUM_FEATURES), b->evaluate(x.data(), NUM_FEATURES), 1e-5f);
+}
+
+TEST(Mlp, DeepPolicyAndValueRoundTripThroughWeightsFile) {
+    auto valueLayers = randomLayers({NUM_FEATURES, 64, 64, 32, 1}, 7);
+    auto policyLayers = randomLayers({POLICY_INPUT_SIZE, 128, 128, 1}, 8);
+    MlpValueFunction vf(std::make_shared<const Mlp>(valueLayers, true));
+    PolicyNetwork policy(std::make_shared<const Mlp>(policyLayers, true), 0.7f);
+    EXPECT_TRUE(policy.isDeep());
+
+    std::vector<float> state = randomInput(NUM_FEATURES, 1);
+    std::vector<float> actions = randomInput(3 * NUM_ACTION_FEATURES, 2);
+    float logits[3];
+    policy.evaluateActions(state.data(), actions.data(), 3, logits);
+    for (int a = 0; a < 3; ++a) {
+        std::vector<float> input(state);
+        input.insert(input.end(), actions.begin() + a * NUM_ACTION_FEATURES,
+                     actions.begin() + (a + 1) * NUM_ACTION_FEATURES);
+        EXPECT_NEAR(logits[a], reference(policyLayers, true, input)[0], 1e-4f);
+    }
+
+    std::string path = (std::filesystem::temp_directory_path() / "bb_mlp_test.bin").string();
+    ASSERT_TRUE(writeWeightsFile(path, &vf, &policy));
+    auto vf2 = loadValueFunction(path);
+    auto policy2 = loadPolicyNetworkFromFile(path);
+    ASSERT_NE(vf2, nullptr);
+    ASSERT_NE(policy2, nullptr);
+    EXPECT_TRUE(policy2->isDeep());
+    EXPECT_FLOAT_EQ(policy2->temperature(), 0.7f);
+    EXPECT_EQ(vf2->evaluate(state.data(), NUM_FEATURES), vf.evaluate(state.data(), NUM_FEATURES));
+    float logits2[3];
+    policy2->evaluateActions(state.data(), actions.data(), 3, logits2);
+    for (int a = 0; a < 3; ++a) EXPECT_EQ(logits2[a], logits[a]);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "bb/model_cache.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace bb;
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("bb_model_cache_test_" + name)).string();
+}
+
+void writeText(const std::string& path, const std::string& text) {
+    std::ofstream(path) << text;
+}
+
+} // anonymous namespace
+
+TEST(ModelCache, SecondGetReusesLoadedModel) {
+    std::string path = tempPath("linear.json");
+    writeText(path, "[1.0, 2.0]");
+
+    ModelCache cache;
+    auto first = cache.get(path);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(first->value, nullptr);
+    EXPECT_EQ(first->policy, nullptr);
+
+    auto second = cache.get(path);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(cache.loads(), 1u);
+    EXPECT_EQ(cache.size(), 1u);
+    std::remove(path.c_str());
+}
+
+TEST(ModelCache, ReloadsWhenFileChanges) {
+    std::string path = tempPath("changing.json");
+    writeText(path, "[1.0, 2.0]");
+
+    ModelCache cache;
+    auto before = cache.get(path);
+    ASSERT_NE(before, nullptr);
+
+    writeText(path, "[3.0, 2.0]");
+    std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) +
+                                           std::chrono::seconds(5));
+    auto after = cache.get(path);
+    ASSERT_NE(after, nullptr);
+    EXPECT_NE(after, before);
+    EXPECT_EQ(cache.loads(), 2u);
+
+    float features[] = {1.0f, 1.0f};
+    EXPECT_FLOAT_EQ(after->value->evaluate(features, 2), 5.0f);
+    EXPECT_FLOAT_EQ(before->value->evaluate(features, 2), 3.0f);  // old handle still valid
+    std::remove(path.c_str());
+}
+
+TEST(ModelCache, MissingOrEmptyFileGivesNull) {
+    ModelCache cache;
+    EXPECT_EQ(cache.get(tempPath("does_not_exist.json")), nullptr);
+
+    std::string path = tempPath("no_networks.json");
+    writeText(path, R"({"type": "unknown"})");
+    EXPECT_EQ(cache.get(path), nullptr);
+    EXPECT_EQ(cache.size(), 0u);
+    std::remove(path.c_str());
+}
+
+TEST(ModelHandle, SwapsInNewVersionsAndKeepsTheOldAlive) {
+    std::string path = tempPath("handle.json");
+    writeText(path, "[1.0, 2.0]");
+    ModelCache cache;
+    ModelHandle handle(path, cache);
+    auto before = handle.current();
+    EXPECT_EQ(handle.version(), 0u);
+    EXPECT_FALSE(handle.refresh());  // unchanged file
+
+    // A half-written file keeps the current model
+    writeText(path, "[3.0, ");
+    auto bump = [&](int seconds) {
+        std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) +
+                                               std::chrono::seconds(seconds));
+    };
+    bump(5);
+    EXPECT_FALSE(handle.refresh());
+    EXPECT_EQ(handle.current(), before);
+
+    writeText(path, "[3.0, 2.0]");
+    bump(10);
+    EXPECT_TRUE(handle.refresh());
+    EXPECT_EQ(handle.version(), 1u);
+    float features[] = {1.0f, 1.0f};
+    EXPECT_FLOAT_EQ(handle.current()->value->evaluate(features, 2), 5.0f);
+    EXPECT_FLOAT_EQ(before->value->evaluate(features, 2), 3.0f);
+
+    // The watcher picks up the next one by itself
+    handle.watch(2);
+    writeText(path, "[4.0, 2.0]");
+    bump(15);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (handle.version() < 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    handle.stopWatching();
+    EXPECT_EQ(handle.version(), 2u);
+    EXPECT_FLOAT_EQ(handle.current()->value->evaluate(features, 2), 6.0f);
+
+    std::remove(path.c_str());
+    EXPECT_THROW(ModelHandle(tempPath("missing.json"), cache), std::runtime_error);
+}
@@ -9,8 +9,8 @@ static void placePlayer(GameState& gs, int id, Position pos, TeamSide side,
     Player& p = gs.getPlayer(id);
     p.state = PlayerState::STANDING;
     p.position = pos;
-    p.stats = {static_cast<int8_t>(ma), static_cast<int8_t>(st),
-               static_cast<int8_t>(ag), static_cast<int8_t>(av)};
+    p.setStats({static_cast<int8_t>(ma), static_cast<int8_t>(st),
+                static_cast<int8_t>(ag), static_cast<int8_t>(av)});
     p.movementRemaining = ma;
 }
 
@@ -72,7 +72,7 @@ TEST(MoveHandler, DodgeFails) {
 TEST(MoveHandler, DodgeRerollWithDodgeSkill) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Dodge);
+    gs.getPlayer(1).addSkill(SkillName::Dodge);
     placePlayer(gs, 12, {9, 7}, TeamSide::AWAY);
     // Dodge target 3 (AG3 + Dodge -1). Roll 2 → fail, Dodge reroll: 4 → success
     FixedDiceRoller dice({2, 4});
@@ -83,9 +83,9 @@ TEST(MoveHandler, DodgeRerollWithDodgeSkill) {
 TEST(MoveHandler, TackleNegatesDodgeReroll) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Dodge);
+    gs.getPlayer(1).addSkill(SkillName::Dodge);
     placePlayer(gs, 12, {9, 7}, TeamSide::AWAY);
-    gs.getPlayer(12).skills.add(SkillName::Tackle);
+    gs.getPlayer(12).addSkill(SkillName::Tackle);
     // Tackle negates Dodge reroll AND Dodge -1. Target = 4. Roll 3 → fail
     // Armor: 3+3=6
     FixedDiceRoller dice({3, 3, 3});
@@ -120,7 +120,7 @@ TEST(MoveHandler, SureFeetReroll) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     gs.getPlayer(1).movementRemaining = 0;
-    gs.getPlayer(1).skills.add(SkillName::SureFeet);
+    gs.getPlayer(1).addSkill(SkillName::SureFeet);
     // GFI: roll 1 (fail), SureFeet reroll: 4 (success)
     FixedDiceRoller dice({1, 4});
     auto result = resolveMoveStep(gs, 1, {11, 7}, dice, nullptr);
@@ -141,7 +141,7 @@ TEST(MoveHandler, GFIBlizzardTarget3) {
 TEST(MoveHandler, SprintAllows3GFI) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::Sprint);
+    gs.getPlayer(1).addSkill(SkillName::Sprint);
     gs.getPlayer(1).movementRemaining = -2; // already used 2 GFI
     // Third GFI should be allowed with Sprint
     FixedDiceRoller dice({4}); // GFI success
@@ -208,7 +208,7 @@ TEST(MoveHandler, JumpUpFreeStandUp) {
     GameState gs;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
     gs.getPlayer(1).state = PlayerState::PRONE;
-    gs.getPlayer(1).skills.add(SkillName::JumpUp);
+    gs.getPlayer(1).addSkill(SkillName::JumpUp);
     FixedDiceRoller dice({});
     auto result = resolveStandUp(gs, 1, dice, nullptr);
     EXPECT_TRUE(result.success);
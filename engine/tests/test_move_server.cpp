@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include "bb/move_server.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+#include "bb/state_io.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <nlohmann/json.hpp>
+
+using namespace bb;
+
+namespace {
+
+GameState makePlayState() {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getOrcRoster());
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.half = 1;
+    state.homeTeam.turnNumber = 1;
+    state.weather = Weather::NICE;
+    state.ball = BallState::onGround({13, 7});
+    return state;
+}
+
+MoveRequest makeRequest(const std::string& tag, int iterations) {
+    MoveRequest r;
+    r.tag = tag;
+    r.state = makePlayState();
+    r.timeBudgetMs = 60000;
+    r.maxIterations = iterations;
+    return r;
+}
+
+bool isLegal(const GameState& state, const Action& action) {
+    std::vector<Action> available;
+    getAvailableActions(state, available);
+    for (const Action& a : available) {
+        if (a.type == action.type && a.playerId == action.playerId &&
+            a.targetId == action.targetId && a.target == action.target) return true;
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+TEST(MoveServer, Base64RoundTrip) {
+    std::vector<uint8_t> out;
+    std::vector<uint8_t> data;
+    for (int n = 0; n < 8; ++n) {
+        if (n > 0) data.push_back(static_cast<uint8_t>(250 + n * 37));
+        ASSERT_TRUE(decodeBase64(encodeBase64(data), out));
+        EXPECT_EQ(out, data);
+    }
+    EXPECT_EQ(encodeBase64({'M', 'a'}), "TWE=");
+    EXPECT_FALSE(decodeBase64("TWE", out));
+    EXPECT_FALSE(decodeBase64("T*E=", out));
+    EXPECT_FALSE(decodeBase64("T=E=", out));
+}
+
+TEST(MoveServer, ParsesProtocolMessages) {
+    GameState state = makePlayState();
+    ServerMessage m = parseServerMessage("{\"id\":7,\"state\":" + stateToJson(state) +
+                                         ",\"time_ms\":250,\"iterations\":40,\"plan\":true}");
+    ASSERT_EQ(m.op, ServerOp::MOVE) << m.error;
+    EXPECT_EQ(m.request.tag, "7");
+    EXPECT_EQ(m.request.timeBudgetMs, 250);
+    EXPECT_EQ(m.request.maxIterations, 40);
+    EXPECT_TRUE(m.request.plan);
+    EXPECT_EQ(m.request.state.hash(), state.hash());
+
+    m = parseServerMessage("{\"op\":\"move\",\"id\":\"a\",\"state_b64\":\"" +
+                           encodeBase64(serializeState(state)) + "\"}");
+    ASSERT_EQ(m.op, ServerOp::MOVE) << m.error;
+    EXPECT_EQ(m.request.tag, "\"a\"");
+    EXPECT_EQ(m.request.state.hash(), state.hash());
+    EXPECT_FALSE(m.request.plan);
+
+    EXPECT_EQ(parseServerMessage("{\"op\":\"cancel\",\"id\":7}").op, ServerOp::CANCEL);
+    EXPECT_EQ(parseServerMessage("{\"op\":\"stats\"}").op, ServerOp::STATS);
+    EXPECT_EQ(parseServerMessage("{\"op\":\"cancel\"}").op, ServerOp::INVALID);
+    EXPECT_EQ(parseServerMessage("{\"id\":1}").op, ServerOp::INVALID);
+    EXPECT_EQ(parseServerMessage("{\"id\":1,\"state_b64\":\"AAAA\"}").op, ServerOp::INVALID);
+    EXPECT_EQ(parseServerMessage("not json").op, ServerOp::INVALID);
+    EXPECT_EQ(parseServerMessage("{\"op\":\"dance\"}").op, ServerOp::INVALID);
+
+    MoveReply reply;
+    reply.tag = "\"a\"";
+    reply.actions.push_back(Action{ActionType::END_TURN, -1, -1, {-1, -1}});
+    std::string json = moveReplyToJson(reply);
+    EXPECT_NE(json.find("\"id\":\"a\""), std::string::npos);
+    EXPECT_NE(json.find("\"status\":\"ok\""), std::string::npos);
+    EXPECT_NE(json.find("\"END_TURN\""), std::string::npos);
+}
+
+TEST(MoveServer, RefusesMalformedStates) {
+    // Socket input reaches the engine only as a state the loaders accept
+    GameState state = makePlayState();
+    state.ball = BallState::carried(state.getPlayer(1).position, 1);
+    const nlohmann::json good = nlohmann::json::parse(stateToJson(state));
+    auto request = [](const nlohmann::json& s) {
+        return parseServerMessage(nlohmann::json{{"id", 9}, {"state", s}}.dump());
+    };
+    ASSERT_EQ(request(good).op, ServerOp::MOVE) << request(good).error;
+
+    auto refused = [&](auto edit) {
+        nlohmann::json s = good;
+        edit(s);
+        ServerMessage m = request(s);
+        if (m.op != ServerOp::INVALID) return false;
+        std::string reply = serverErrorJson(m.request.tag, m.error);
+        return reply.find("\"status\":\"error\"") != std::string::npos &&
+               reply.find("\"id\":9") != std::string::npos;
+    };
+    EXPECT_TRUE(refused([](nlohmann::json& s) { s["players"][0]["skills"].push_back(200); }));
+    EXPECT_TRUE(refused([](nlohmann::json& s) { s["players"][0]["state"] = 99; }));
+    EXPECT_TRUE(refused([](nlohmann::json& s) { s["phase"] = 42; }));
+    EXPECT_TRUE(refused([](nlohmann::json& s) { s["activeTeam"] = 2; }));
+    EXPECT_TRUE(refused([](nlohmann::json& s) { s["kickingTeam"] = -1; }));
+    EXPECT_TRUE(refused([](nlohmann::json& s) { s["ball"]["carrierId"] = 40; }));
+    EXPECT_TRUE(refused([](nlohmann::json& s) { s["ball"]["carrierId"] = 2; }));  // not on the ball
+    EXPECT_TRUE(refused([](nlohmann::json& s) { s["players"][0]["skills"] = "Block"; }));
+
+    // The binary form: a HOME slot claiming the AWAY side
+    std::vector<uint8_t> bytes = serializeState(state);
+    bytes[40 + 17] = 1;
+    ServerMessage m = parseServerMessage("{\"id\":9,\"state_b64\":\"" + encodeBase64(bytes) + "\"}");
+    EXPECT_EQ(m.op, ServerOp::INVALID);
+    EXPECT_FALSE(m.error.empty());
+}
+
+TEST(MoveServer, AnswersWithALegalActionOrPlan) {
+    MoveServerConfig config;
+    config.workers = 2;
+    MoveServer server(config);
+
+    std::promise<MoveReply> single, plan;
+    ASSERT_NE(server.submit(makeRequest("1", 64), [&](const MoveReply& r) { single.set_value(r); }), 0u);
+    MoveRequest planRequest = makeRequest("2", 64);
+    planRequest.plan = true;
+    ASSERT_NE(server.submit(planRequest, [&](const MoveReply& r) { plan.set_value(r); }), 0u);
+
+    MoveReply a = single.get_future().get();
+    EXPECT_EQ(a.status, MoveStatus::OK);
+    EXPECT_EQ(a.tag, "1");
+    ASSERT_EQ(a.actions.size(), 1u);
+    EXPECT_TRUE(isLegal(planRequest.state, a.actions[0]));
+    EXPECT_GT(a.iterations, 0);
+    EXPECT_LE(a.iterations, 64);
+
+    MoveReply b = plan.get_future().get();
+    EXPECT_EQ(b.status, MoveStatus::OK);
+    ASSERT_FALSE(b.actions.empty());
+    EXPECT_TRUE(isLegal(planRequest.state, b.actions[0]));
+
+    MoveRequest over = makeRequest("3", 64);
+    over.state.phase = GamePhase::GAME_OVER;
+    std::promise<MoveReply> failed;
+    server.submit(over, [&](const MoveReply& r) { failed.set_value(r); });
+    EXPECT_EQ(failed.get_future().get().status, MoveStatus::FAILED);
+}
+
+TEST(MoveServer, NewSearchesPickUpASwappedModel) {
+    std::string path = (std::filesystem::temp_directory_path() / "bb_move_server_live.json").string();
+    std::ofstream(path) << "[0.5]";
+    ModelCache cache;
+    MoveServerConfig config;
+    config.workers = 1;
+    config.search.vfBlend = 1.0f;
+    config.liveModel = std::make_shared<ModelHandle>(path, cache);
+    MoveServer server(config);
+
+    auto ask = [&] {
+        std::promise<MoveReply> reply;
+        server.submit(makeRequest("1", 16), [&](const MoveReply& r) { reply.set_value(r); });
+        return reply.get_future().get();
+    };
+    MoveReply first = ask();
+    EXPECT_EQ(first.status, MoveStatus::OK);
+    EXPECT_EQ(first.modelVersion, 0u);
+
+    std::ofstream(path) << "[-0.5]";
+    std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(5));
+    ASSERT_TRUE(config.liveModel->refresh());
+    MoveReply second = ask();
+    EXPECT_EQ(second.status, MoveStatus::OK);
+    EXPECT_EQ(second.modelVersion, 1u);
+    EXPECT_NE(moveReplyToJson(second).find("\"model_version\":1"), std::string::npos);
+    std::remove(path.c_str());
+}
+
+TEST(MoveServer, BoundedQueueAndCancellation) {
+    MoveServerConfig config;
+    config.workers = 1;
+    config.queueCapacity = 1;
+    MoveServer server(config);
+
+    // A search that would run for a minute occupies the only worker
+    std::promise<MoveReply> long1, queued;
+    uint64_t running = server.submit(makeRequest("long", 100000000),
+                                     [&](const MoveReply& r) { long1.set_value(r); });
+    ASSERT_NE(running, 0u);
+    while (server.running() == 0) std::this_thread::yield();
+    uint64_t waiting = server.submit(makeRequest("queued", 64),
+                                     [&](const MoveReply& r) { queued.set_value(r); });
+    ASSERT_NE(waiting, 0u);
+    EXPECT_EQ(server.queued(), 1);
+    EXPECT_EQ(server.submit(makeRequest("refused", 64), [](const MoveReply&) { FAIL(); }), 0u);
+
+    // Queued: answered on the spot. Running: the search stops early.
+    EXPECT_TRUE(server.cancel(waiting));
+    EXPECT_EQ(queued.get_future().get().status, MoveStatus::CANCELLED);
+    EXPECT_FALSE(server.cancel(waiting));
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(server.cancel(running));
+    MoveReply r = long1.get_future().get();
+    EXPECT_EQ(r.status, MoveStatus::CANCELLED);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(10));
+
+    server.shutdown();
+    EXPECT_EQ(server.submit(makeRequest("late", 64), [](const MoveReply&) { FAIL(); }), 0u);
+    EXPECT_THROW(MoveServer(MoveServerConfig{0}), std::invalid_argument);
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "bb/node_arena.h"
+
+using namespace bb;
+
+namespace {
+
+struct TestNode {
+    uint32_t firstChild = NodeArena<TestNode>::NONE;
+    uint32_t numChildren = 0;
+    int value = 0;
+};
+
+using TestArena = NodeArena<TestNode>;
+
+} // anonymous namespace
+
+TEST(NodeArena, BlocksAreContiguous) {
+    TestArena arena;
+    uint32_t root = arena.allocate(1);
+    uint32_t first = arena.allocate(5);
+    arena[root].firstChild = first;
+    arena[root].numChildren = 5;
+    auto kids = arena.children(arena[root]);
+    ASSERT_EQ(kids.size(), 5u);
+    for (uint32_t i = 0; i < 5; ++i) EXPECT_EQ(&kids[i], &arena[first + i]);
+    EXPECT_TRUE(arena.children(kids[0]).empty());
+}
+
+TEST(NodeArena, PointersStableAcrossGrowth) {
+    TestArena arena;
+    uint32_t root = arena.allocate(1);
+    TestNode* p = &arena[root];
+    p->value = 42;
+    for (int i = 0; i < 5; ++i) arena.allocate(TestArena::CHUNK_SIZE);
+    EXPECT_EQ(&arena[root], p);
+    EXPECT_EQ(p->value, 42);
+}
+
+TEST(NodeArena, BlockNeverStraddlesChunk) {
+    TestArena arena;
+    arena.allocate(TestArena::CHUNK_SIZE - 2);
+    uint32_t block = arena.allocate(4);
+    EXPECT_EQ(block, TestArena::CHUNK_SIZE);
+    EXPECT_EQ(&arena[block + 3] - &arena[block], 3);
+}
+
+TEST(NodeArena, ResetReusesStorageWithFreshNodes) {
+    TestArena arena;
+    uint32_t a = arena.allocate(3);
+    arena[a + 1].value = 7;
+    TestNode* before = &arena[a];
+    arena.reset();
+    EXPECT_EQ(arena.size(), 0u);
+    uint32_t b = arena.allocate(3);
+    EXPECT_EQ(&arena[b], before);
+    EXPECT_EQ(arena[b + 1].value, 0);
+}
+
+TEST(NodeArena, ReleasedBlocksAreReusedBySize) {
+    TestArena arena;
+    arena.allocate(1);
+    uint32_t three = arena.allocate(3);
+    uint32_t five = arena.allocate(5);
+    arena[three].value = 7;
+    EXPECT_EQ(arena.live(), 9u);
+
+    arena.release(three, 3);
+    EXPECT_EQ(arena.live(), 6u);
+    EXPECT_EQ(arena[three].value, 0);  // reset on release
+    EXPECT_EQ(arena.allocate(5), five + 5);  // no free block of 5: fresh
+    EXPECT_EQ(arena.allocate(3), three);     // the released one
+    EXPECT_EQ(arena.live(), 14u);
+    EXPECT_EQ(arena.size(), 14u);
+
+    arena.release(three, 3);
+    arena.reset();
+    EXPECT_EQ(arena.live(), 0u);
+    EXPECT_EQ(arena.allocate(3), 0u);  // reset forgets released blocks
+}
+
+TEST(NodeArena, GetNoneIsNull) {
+    TestArena arena;
+    EXPECT_EQ(arena.get(TestArena::NONE), nullptr);
+    uint32_t a = arena.allocate(1);
+    EXPECT_EQ(arena.get(a), &arena[a]);
+}
+
+TEST(NodeArena, CopySubtreeKeepsShapeAndAdjusts) {
+    struct TreeNode {
+        uint32_t parent = NodeArena<TreeNode>::NONE;
+        uint32_t firstChild = NodeArena<TreeNode>::NONE;
+        uint32_t numChildren = 0;
+        int value = 0;
+    };
+    NodeArena<TreeNode> from, to;
+    uint32_t root = from.allocate(1);
+    uint32_t kids = from.allocate(2);
+    from[root].firstChild = kids;
+    from[root].numChildren = 2;
+    for (uint32_t i = 0; i < 2; ++i) {
+        from[kids + i].parent = root;
+        from[kids + i].value = 10 + static_cast<int>(i);
+    }
+    uint32_t grand = from.allocate(3);
+    from[kids + 1].firstChild = grand;
+    from[kids + 1].numChildren = 3;
+    for (uint32_t i = 0; i < 3; ++i) {
+        from[grand + i].parent = kids + 1;
+        from[grand + i].value = 20 + static_cast<int>(i);
+    }
+
+    // Re-root at the second child, doubling every value.
+    uint32_t newRoot = copySubtree(from, kids + 1, to, [](TreeNode& n) { n.value *= 2; });
+    EXPECT_EQ(to.size(), 4u);
+    EXPECT_EQ(to[newRoot].parent, NodeArena<TreeNode>::NONE);
+    EXPECT_EQ(to[newRoot].value, 22);
+    auto copied = to.children(to[newRoot]);
+    ASSERT_EQ(copied.size(), 3u);
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(copied[i].value, 2 * (20 + static_cast<int>(i)));
+        EXPECT_EQ(copied[i].parent, newRoot);
+        EXPECT_TRUE(to.children(copied[i]).empty());
+    }
+}
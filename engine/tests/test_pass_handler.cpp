@@ -13,8 +13,8 @@ static void placePlayer(GameState& gs, int id, Position pos, TeamSide side,
     p.teamSide = side;
     p.state = PlayerState::STANDING;
     p.position = pos;
-    p.stats = {static_cast<int8_t>(ma), static_cast<int8_t>(st),
-               static_cast<int8_t>(ag), static_cast<int8_t>(av)};
+    p.setStats({static_cast<int8_t>(ma), static_cast<int8_t>(st),
+                static_cast<int8_t>(ag), static_cast<int8_t>(av)});
     p.movementRemaining = ma;
 }
 
@@ -101,7 +101,7 @@ TEST(PassHandler, InterceptionByEnemy) {
 TEST(PassHandler, SafeThrowBlocksInterception) {
     auto gs = makePassSetup();
     placePlayer(gs, 1, {3, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::SafeThrow);
+    gs.getPlayer(1).addSkill(SkillName::SafeThrow);
     placePlayer(gs, 2, {9, 7}, TeamSide::HOME);
     placePlayer(gs, 12, {6, 7}, TeamSide::AWAY, 6, 3, 4);
 
@@ -123,7 +123,7 @@ TEST(PassHandler, StrongArmReducesRange) {
     // Passer with StrongArm at (3,7), target at (10,7) = dist 7 = Long Pass normally
     // With StrongArm: reduced to Short Pass
     placePlayer(gs, 1, {3, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::StrongArm);
+    gs.getPlayer(1).addSkill(SkillName::StrongArm);
     placePlayer(gs, 2, {10, 7}, TeamSide::HOME);
     gs.ball = BallState::carried({3, 7}, 1);
 
@@ -140,7 +140,7 @@ TEST(PassHandler, StrongArmReducesRange) {
 TEST(PassHandler, AccurateSkillLowersTarget) {
     auto gs = makePassSetup();
     placePlayer(gs, 1, {5, 7}, TeamSide::HOME, 6, 3, 2);  // AG2
-    gs.getPlayer(1).skills.add(SkillName::Accurate);
+    gs.getPlayer(1).addSkill(SkillName::Accurate);
     placePlayer(gs, 2, {8, 7}, TeamSide::HOME);
     gs.ball = BallState::carried({5, 7}, 1);
 
@@ -157,7 +157,7 @@ TEST(PassHandler, AccurateSkillLowersTarget) {
 TEST(PassHandler, NervesOfSteelIgnoresTZ) {
     auto gs = makePassSetup();
     placePlayer(gs, 1, {5, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::NervesOfSteel);
+    gs.getPlayer(1).addSkill(SkillName::NervesOfSteel);
     placePlayer(gs, 2, {8, 7}, TeamSide::HOME);
     // Enemy adjacent to passer — adds TZ
     placePlayer(gs, 12, {5, 8}, TeamSide::AWAY);
@@ -177,7 +177,7 @@ TEST(PassHandler, DisturbingPresenceAddsPenalty) {
     placePlayer(gs, 2, {8, 7}, TeamSide::HOME);
     // Enemy with DisturbingPresence within 3 squares of passer
     placePlayer(gs, 12, {7, 7}, TeamSide::AWAY);
-    gs.getPlayer(12).skills.add(SkillName::DisturbingPresence);
+    gs.getPlayer(12).addSkill(SkillName::DisturbingPresence);
     gs.ball = BallState::carried({5, 7}, 1);
 
     // QP target = 7-3-1(QP)+1(DP) = 4
@@ -209,7 +209,7 @@ TEST(PassHandler, WeatherModifier) {
 TEST(PassHandler, HailMaryPassScatters3Times) {
     auto gs = makePassSetup();
     placePlayer(gs, 1, {3, 7}, TeamSide::HOME);
-    gs.getPlayer(1).skills.add(SkillName::HailMaryPass);
+    gs.getPlayer(1).addSkill(SkillName::HailMaryPass);
     placePlayer(gs, 2, {20, 7}, TeamSide::HOME);
     gs.ball = BallState::carried({3, 7}, 1);
 
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "bb/pathfinder.h"
+
+using namespace bb;
+
+static void placePlayer(GameState& gs, int id, Position pos, TeamSide side,
+                         int ma = 6, int st = 3, int ag = 3, int av = 8) {
+    Player& p = gs.getPlayer(id);
+    p.state = PlayerState::STANDING;
+    p.position = pos;
+    p.setStats({static_cast<int8_t>(ma), static_cast<int8_t>(st),
+                static_cast<int8_t>(ag), static_cast<int8_t>(av)});
+    p.movementRemaining = ma;
+}
+
+TEST(Pathfinder, ReachabilityOpenField) {
+    GameState gs;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 4);
+    ReachabilityMap reach;
+    computeReachability(gs, gs.getPlayer(1), reach);
+
+    EXPECT_EQ(reach.costTo({10, 7}), 0);
+    EXPECT_EQ(reach.costTo({14, 7}), 4);
+    EXPECT_EQ(reach.gfisTo({14, 7}), 0);
+    EXPECT_EQ(reach.costTo({16, 7}), 6);   // MA4 + 2 GFI
+    EXPECT_EQ(reach.gfisTo({16, 7}), 2);
+    EXPECT_FALSE(reach.canReach({17, 7}));
+    EXPECT_EQ(reach.reachable.count(), 13 * 13);
+}
+
+TEST(Pathfinder, ReachabilityRoutesAroundPlayers) {
+    GameState gs;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
+    // Column of teammates at x=11, y=5..9
+    for (int i = 0; i < 5; ++i) {
+        placePlayer(gs, 2 + i, {11, static_cast<int8_t>(5 + i)}, TeamSide::HOME);
+    }
+    ReachabilityMap reach;
+    computeReachability(gs, gs.getPlayer(1), reach);
+    EXPECT_FALSE(reach.canReach({11, 7}));  // occupied
+    EXPECT_EQ(reach.costTo({12, 7}), 6);    // up round the end of the column and back
+}
+
+TEST(Pathfinder, ReachabilityCountsDodges) {
+    GameState gs;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
+    placePlayer(gs, 12, {11, 8}, TeamSide::AWAY);  // start square is in its TZ
+    ReachabilityMap reach;
+    computeReachability(gs, gs.getPlayer(1), reach);
+    EXPECT_EQ(reach.dodgesTo({9, 7}), 1);   // every first step leaves the TZ
+    // Via (9,6)/(10,6)/(11,6) into open space: one dodge, then free
+    EXPECT_EQ(reach.dodgesTo({10, 4}), 1);
+    // Shortest routes to (13,8) pass through (12,7)/(12,8)/(12,9), all in the
+    // TZ; going via (11,6) instead of (11,7) saves one of the three dodges
+    EXPECT_EQ(reach.costTo({13, 8}), 3);
+    EXPECT_EQ(reach.dodgesTo({13, 8}), 2);
+}
+
+TEST(Pathfinder, ProneStandUpCost) {
+    GameState gs;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6);
+    gs.getPlayer(1).state = PlayerState::PRONE;
+    ReachabilityMap reach;
+    computeReachability(gs, gs.getPlayer(1), reach);
+    EXPECT_EQ(reach.movementAllowance, 3);
+    EXPECT_EQ(reach.maxRange, 5);
+    EXPECT_FALSE(reach.canReach({16, 7}));
+    EXPECT_TRUE(reach.canReach({15, 7}));
+}
+
+TEST(Pathfinder, ReachabilityCacheFollowsBoard) {
+    GameState gs;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 3);
+    const Player& p = gs.getPlayer(1);
+    EXPECT_EQ(getReachability(gs, p).costTo({12, 7}), 2);
+
+    // Blocking the straight route must not serve the stale map
+    placePlayer(gs, 2, {11, 7}, TeamSide::HOME);
+    gs.invalidateOccupancy();
+    EXPECT_FALSE(getReachability(gs, p).canReach({11, 7}));
+
+    // Spending movement changes the range without a board change
+    gs.getPlayer(1).movementRemaining = 0;
+    EXPECT_FALSE(getReachability(gs, p).canReach({13, 7}));
+
+    auto clone = gs.clone();
+    clone.movePlayer(clone.getPlayer(2), {20, 7});
+    EXPECT_TRUE(getReachability(clone, clone.getPlayer(1)).canReach({11, 7}));
+    EXPECT_FALSE(getReachability(gs, p).canReach({11, 7}));
+}
+
+TEST(Pathfinder, CanReachAdjacentTo) {
+    GameState gs;
+    placePlayer(gs, 1, {5, 7}, TeamSide::HOME, 3);
+    placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);
+    Position adj;
+    ASSERT_TRUE(canReachAdjacentTo(gs, gs.getPlayer(1), {11, 7}, adj));
+    EXPECT_EQ(adj.distanceTo({11, 7}), 1);
+    EXPECT_EQ(adj.x, 10);
+
+    placePlayer(gs, 13, {14, 7}, TeamSide::AWAY);
+    EXPECT_FALSE(canReachAdjacentTo(gs, gs.getPlayer(1), {14, 7}, adj));
+}
+
+TEST(Pathfinder, TracePathTakesFewestDodges) {
+    GameState gs;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
+    placePlayer(gs, 12, {11, 8}, TeamSide::AWAY);
+    const ReachabilityMap& reach = getReachability(gs, gs.getPlayer(1));
+
+    Position path[MAX_PATH_LENGTH];
+    ASSERT_EQ(tracePath(gs, reach, {13, 8}, path), 3);
+    EXPECT_EQ(path[2], (Position{13, 8}));
+    Position from = gs.getPlayer(1).position;
+    int dodges = 0;
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(from.distanceTo(path[i]), 1);
+        EXPECT_TRUE(reach.canReach(path[i]));
+        dodges += gs.tacklezoneCount(TeamSide::AWAY, from) > 0;
+        from = path[i];
+    }
+    EXPECT_EQ(dodges, reach.dodgesTo({13, 8}));
+
+    EXPECT_EQ(tracePath(gs, reach, {10, 7}, path), 0);  // origin
+    EXPECT_EQ(tracePath(gs, reach, {11, 8}, path), 0);  // occupied
+    EXPECT_EQ(tracePath(gs, reach, {20, 7}, path), 0);  // out of range
+}
@@ -44,8 +44,8 @@ TEST(SkillSet, Clear) {
 
 TEST(Player, HasSkill) {
     Player p;
-    p.skills.add(SkillName::Block);
-    p.skills.add(SkillName::Dodge);
+    p.addSkill(SkillName::Block);
+    p.addSkill(SkillName::Dodge);
 
     EXPECT_TRUE(p.hasSkill(SkillName::Block));
     EXPECT_TRUE(p.hasSkill(SkillName::Dodge));
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "bb/player.h"
+#include "bb/game_state.h"
+#include <thread>
+#include <vector>
+
+using namespace bb;
+
+TEST(PlayerProfile, DefaultIsEmpty) {
+    Player p;
+    EXPECT_EQ(p.profile, 0);
+    EXPECT_EQ(p.stats().movement, 0);
+    EXPECT_EQ(p.skills().count(), 0);
+}
+
+TEST(PlayerProfile, EqualProfilesShareAnId) {
+    SkillSet skills;
+    skills.add(SkillName::Block);
+    skills.add(SkillName::MultipleBlock);
+    ProfileId a = internProfile({6, 3, 3, 8}, skills);
+    ProfileId b = internProfile({6, 3, 3, 8}, skills);
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, internProfile({6, 4, 3, 8}, skills));
+    EXPECT_TRUE(profileOf(a).skills.has(SkillName::MultipleBlock));
+    EXPECT_EQ(profileOf(a).stats.armour, 8);
+}
+
+TEST(PlayerProfile, SettersRepointOnlyThatPlayer) {
+    Player a, b;
+    a.setStats({6, 3, 3, 8});
+    b.setStats({6, 3, 3, 8});
+    EXPECT_EQ(a.profile, b.profile);
+    a.addSkill(SkillName::Dodge);
+    a.setStrength(4);
+    EXPECT_TRUE(a.hasSkill(SkillName::Dodge));
+    EXPECT_EQ(a.stats().strength, 4);
+    EXPECT_FALSE(b.hasSkill(SkillName::Dodge));
+    EXPECT_EQ(b.stats().strength, 3);
+}
+
+TEST(PlayerProfile, HotSkillFlagsFollowSkills) {
+    Player p;
+    p.addSkill(SkillName::Tentacles);
+    p.addSkill(SkillName::Leader);  // not a hot skill
+    EXPECT_EQ(p.hotSkills(), hotSkillBit(SkillName::Tentacles));
+    EXPECT_EQ(hotSkillBit(SkillName::Leader), 0u);
+    for (SkillName s : HOT_SKILLS) {
+        EXPECT_NE(hotSkillBit(s), 0u);
+    }
+}
+
+TEST(PlayerProfile, TeamSkillMasksTrackSkillChanges) {
+    GameState state;
+    state.getPlayer(3).addSkill(SkillName::Shadowing);
+    state.invalidateOccupancy();
+    EXPECT_TRUE(state.teamMayHaveSkill(TeamSide::HOME, SkillName::Shadowing));
+    EXPECT_FALSE(state.teamMayHaveSkill(TeamSide::AWAY, SkillName::Shadowing));
+    EXPECT_FALSE(state.teamMayHaveSkill(TeamSide::HOME, SkillName::Tentacles));
+    // Skills outside HOT_SKILLS are never ruled out
+    EXPECT_TRUE(state.teamMayHaveSkill(TeamSide::AWAY, SkillName::Leader));
+
+    state.getPlayer(15).addSkill(SkillName::Tentacles);
+    state.invalidateOccupancy();
+    EXPECT_TRUE(state.teamMayHaveSkill(TeamSide::AWAY, SkillName::Tentacles));
+    EXPECT_TRUE(state.occupancyConsistent());
+}
+
+TEST(PlayerProfile, ConcurrentInterningAgrees) {
+    std::vector<std::vector<ProfileId>> ids(4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 1500; ++i) {
+                SkillSet skills;
+                skills.add(static_cast<SkillName>(i % 70));
+                ids[t].push_back(internProfile({static_cast<int8_t>(i / 70), 9, 9, 9}, skills));
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    for (int t = 1; t < 4; ++t) EXPECT_EQ(ids[t], ids[0]);
+    for (int i = 0; i < 1500; ++i) {
+        const PlayerProfile& p = profileOf(ids[0][i]);
+        EXPECT_EQ(p.stats.movement, i / 70);
+        EXPECT_TRUE(p.skills.has(static_cast<SkillName>(i % 70)));
+    }
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "bb/policy_network.h"
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 
@@ -358,3 +359,95 @@ TEST(PolicyNetwork, NeuralTemperature) {
     EXPECT_GT(priorsLow[0], priorsHigh[0]);
     EXPECT_GT(priorsHigh[1], priorsLow[1]);
 }
+
+TEST(PolicyNetwork, NeuralEvaluateActionsMatchesUnfactorizedForwardPass) {
+    // Hidden size above the old 64-unit stack buffer and off the SIMD width.
+    int H = 70;
+    std::vector<float> W1(POLICY_INPUT_SIZE * H), b1(H), W2(H);
+    for (size_t i = 0; i < W1.size(); ++i) W1[i] = 0.01f * static_cast<float>((i * 37) % 23) - 0.11f;
+    for (int j = 0; j < H; ++j) {
+        b1[j] = 0.02f * static_cast<float>(j % 9) - 0.08f;
+        W2[j] = 0.05f * static_cast<float>((j * 7) % 13) - 0.3f;
+    }
+    PolicyNetwork pn(W1, b1, W2, 0.25f, H);
+
+    float stateFeats[NUM_FEATURES];
+    for (int i = 0; i < NUM_FEATURES; ++i) stateFeats[i] = (i % 4 == 0) ? 0.0f : 0.1f * (i % 7);
+    constexpr int N = 5;
+    float actionFeats[N * NUM_ACTION_FEATURES];
+    for (int i = 0; i < N * NUM_ACTION_FEATURES; ++i) actionFeats[i] = (i % 3 == 0) ? 1.0f : 0.0f;
+
+    float logits[N];
+    pn.evaluateActions(stateFeats, actionFeats, N, logits);
+    for (int a = 0; a < N; ++a) {
+        double out = 0.25;
+        for (int j = 0; j < H; ++j) {
+            double h = b1[j];
+            for (int i = 0; i < NUM_FEATURES; ++i) h += stateFeats[i] * W1[i * H + j];
+            for (int k = 0; k < NUM_ACTION_FEATURES; ++k) {
+                h += actionFeats[a * NUM_ACTION_FEATURES + k] * W1[(NUM_FEATURES + k) * H + j];
+            }
+            out += std::max(0.0, h) * W2[j];
+        }
+        EXPECT_NEAR(logits[a], out, 1e-4) << "action " << a;
+        EXPECT_FLOAT_EQ(pn.evaluateAction(stateFeats, &actionFeats[a * NUM_ACTION_FEATURES]), logits[a]);
+    }
+}
+
+TEST(PolicyNetwork, ComputePriorsBatchMatchesPerState) {
+    int H = 6;
+    std::vector<float> W1(POLICY_INPUT_SIZE * H), b1(H, 0.05f), W2(H);
+    for (size_t i = 0; i < W1.size(); ++i) W1[i] = 0.03f * static_cast<float>((i * 11) % 19) - 0.25f;
+    for (int j = 0; j < H; ++j) W2[j] = 0.2f * static_cast<float>(j % 3) - 0.2f;
+    PolicyNetwork pn(W1, b1, W2, 0.0f, H, 0.7f);
+
+    constexpr int S = 3;
+    const int counts[S] = {4, 1, 3};
+    constexpr int M = 8;
+    float states[S * NUM_FEATURES];
+    for (int i = 0; i < S * NUM_FEATURES; ++i) states[i] = 0.1f * static_cast<float>(i % 5);
+    float actions[M * NUM_ACTION_FEATURES];
+    for (int i = 0; i < M * NUM_ACTION_FEATURES; ++i) actions[i] = static_cast<float>((i * 7) % 3);
+
+    float batched[M];
+    pn.computePriorsBatch(states, S, actions, counts, batched);
+
+    int offset = 0;
+    for (int s = 0; s < S; ++s) {
+        float single[M];
+        pn.computePriors(&states[s * NUM_FEATURES], &actions[offset * NUM_ACTION_FEATURES],
+                         counts[s], single);
+        for (int a = 0; a < counts[s]; ++a) {
+            EXPECT_FLOAT_EQ(batched[offset + a], single[a]) << "state " << s << " action " << a;
+        }
+        offset += counts[s];
+    }
+}
+
+TEST(PolicyNetwork, NeuralInt8CloseToFloat) {
+    int H = 24;
+    std::vector<float> W1(POLICY_INPUT_SIZE * H), b1(H, 0.02f), W2(H);
+    for (size_t i = 0; i < W1.size(); ++i) W1[i] = 0.02f * static_cast<float>((i * 19) % 31) - 0.3f;
+    for (int j = 0; j < H; ++j) W2[j] = 0.15f * static_cast<float>(j % 4) - 0.2f;
+    PolicyNetwork pn(W1, b1, W2, 0.1f, H);
+
+    constexpr int K = 20;
+    std::vector<float> states(K * NUM_FEATURES), actions(K * NUM_ACTION_FEATURES);
+    for (size_t i = 0; i < states.size(); ++i) states[i] = static_cast<float>((i * 13) % 7) / 6.0f;
+    for (size_t i = 0; i < actions.size(); ++i) actions[i] = static_cast<float>((i * 5) % 3);
+
+    QuantizationError err = pn.quantizationError(states.data(), actions.data(), K);
+    EXPECT_EQ(err.samples, K);
+    EXPECT_GT(err.maxAbs, 0.0);
+    EXPECT_LT(err.maxAbs, 0.1);
+
+    pn.setInt8(true);
+    EXPECT_TRUE(pn.isInt8());
+    float priors[3];
+    pn.computePriors(states.data(), actions.data(), 3, priors);
+    EXPECT_NEAR(priors[0] + priors[1] + priors[2], 1.0f, 1e-5f);
+
+    PolicyNetwork linear;
+    linear.setInt8(true);
+    EXPECT_FALSE(linear.isInt8());
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "bb/prior_cache.h"
+#include "bb/macro_mcts.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+
+using namespace bb;
+
+namespace {
+
+MacroList makeMacros(int n) {
+    MacroList macros;
+    for (int i = 0; i < n; ++i) macros.push_back({MacroType::END_TURN, i, -1, {-1, -1}});
+    return macros;
+}
+
+} // anonymous namespace
+
+TEST(PriorCache, DisabledMissesWithoutCounting) {
+    PriorCache cache;
+    cache.store(1, makeMacros(3), {0.2f, 0.3f, 0.5f});
+    MacroList macros;
+    std::vector<float> priors;
+    EXPECT_FALSE(cache.lookup(1, macros, priors));
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.misses(), 0u);
+}
+
+TEST(PriorCache, StoresAndReturnsEntries) {
+    PriorCache cache(1 << 16);
+    cache.store(7, makeMacros(3), {0.2f, 0.3f, 0.5f});
+    MacroList macros;
+    std::vector<float> priors;
+    EXPECT_FALSE(cache.lookup(8, macros, priors));
+    ASSERT_TRUE(cache.lookup(7, macros, priors));
+    ASSERT_EQ(macros.size(), 3u);
+    EXPECT_EQ(macros[2].playerId, 2);
+    EXPECT_EQ(priors, (std::vector<float>{0.2f, 0.3f, 0.5f}));
+    EXPECT_EQ(cache.hits(), 1u);
+    EXPECT_EQ(cache.misses(), 1u);
+}
+
+TEST(PriorCache, EvictsUnreferencedEntriesFirst) {
+    // Room for about four entries of ten macros
+    PriorCache cache(4 * 400);
+    std::vector<float> priors(10, 0.1f);
+    MacroList out;
+    std::vector<float> outPriors;
+    for (uint64_t key = 1; key <= 3; ++key) cache.store(key, makeMacros(10), priors);
+    ASSERT_EQ(cache.size(), 3u);
+    ASSERT_TRUE(cache.lookup(1, out, outPriors));  // 1 is referenced, 2 is not
+    for (uint64_t key = 4; key <= 8; ++key) cache.store(key, makeMacros(10), priors);
+    EXPECT_GT(cache.evictions(), 0u);
+    EXPECT_LE(cache.bytesUsed(), 4u * 400u);
+    EXPECT_TRUE(cache.lookup(8, out, outPriors));
+    EXPECT_FALSE(cache.lookup(2, out, outPriors));
+}
+
+TEST(PriorCache, SearchReportsHitsAndKeepsResults) {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getHumanRoster());
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.half = 1;
+    state.homeTeam.turnNumber = 1;
+    state.ball = BallState::onGround({13, 7});
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 300;
+    MacroMCTSSearch plain(nullptr, config, 42);
+    config.priorCacheMB = 16;
+    MacroMCTSSearch cached(nullptr, config, 42);
+
+    Macro a = plain.search(state);
+    Macro b = cached.search(state);
+    EXPECT_EQ(a.type, b.type);
+    EXPECT_EQ(a.playerId, b.playerId);
+    ASSERT_EQ(plain.lastChildVisits().size(), cached.lastChildVisits().size());
+    for (size_t i = 0; i < plain.lastChildVisits().size(); ++i) {
+        EXPECT_EQ(plain.lastChildVisits()[i].visits, cached.lastChildVisits()[i].visits);
+    }
+    EXPECT_EQ(plain.lastStats().priorCacheHits + plain.lastStats().priorCacheMisses, 0);
+    const SearchStats& first = cached.lastStats();
+    EXPECT_GT(first.priorCacheMisses, 0);
+
+    // The next search of the same game starts from cached positions
+    cached.search(state);
+    EXPECT_GT(cached.lastStats().priorCacheHits, 0);
+    EXPECT_GT(cached.lastStats().priorCacheHitRate(), 0.0);
+}
+
+TEST(PriorCache, ParallelSearchExpandsThroughTheCache) {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getHumanRoster());
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.half = 1;
+    state.homeTeam.turnNumber = 1;
+    state.ball = BallState::onGround({13, 7});
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 300;
+    config.numThreads = 4;
+    config.priorCacheMB = 16;
+    MacroMCTSSearch search(nullptr, config, 42);
+
+    search.search(state);
+    EXPECT_EQ(search.lastIterations(), 300);
+    EXPECT_GT(search.lastStats().priorCacheMisses, 0);
+    search.search(state);
+    EXPECT_GT(search.lastStats().priorCacheHits, 0);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "bb/profile.h"
+#include "bb/game_state.h"
+#include "bb/rules_engine.h"
+#include "bb/feature_extractor.h"
+#include <thread>
+
+using namespace bb;
+
+namespace {
+
+GameState activeState() {
+    GameState state;
+    state.phase = GamePhase::PLAY;
+    return state;
+}
+
+} // anonymous namespace
+
+#ifdef BB_PROFILE
+
+namespace {
+
+const ProfileEntry* findEntry(const std::vector<ProfileEntry>& entries, const std::string& name) {
+    for (const auto& e : entries) {
+        if (e.name == name) return &e;
+    }
+    return nullptr;
+}
+
+} // anonymous namespace
+
+TEST(Profile, CountsCallsPerSlot) {
+    profileReset();
+    GameState state = activeState();
+    ActionList actions;
+    for (int i = 0; i < 3; ++i) getAvailableActions(state, actions);
+
+    auto entries = profileSnapshot();
+    const ProfileEntry* e = findEntry(entries, "getAvailableActions");
+    ASSERT_NE(e, nullptr);
+    EXPECT_EQ(e->calls, 3u);
+    EXPECT_GT(e->ticks, 0u);
+    EXPECT_TRUE(profileEnabled());
+    EXPECT_NE(profileReport().find("getAvailableActions"), std::string::npos);
+}
+
+TEST(Profile, KeepsCountsOfExitedThreads) {
+    profileReset();
+    std::thread worker([] {
+        GameState state = activeState();
+        float features[NUM_FEATURES];
+        extractFeatures(state, TeamSide::HOME, features);
+        extractFeatures(state, TeamSide::AWAY, features);
+    });
+    worker.join();
+
+    const ProfileEntry* e = findEntry(profileSnapshot(), "extractFeatures");
+    ASSERT_NE(e, nullptr);
+    EXPECT_EQ(e->calls, 2u);
+}
+
+TEST(Profile, ResetClearsCounters) {
+    GameState state = activeState();
+    ActionList actions;
+    getAvailableActions(state, actions);
+    profileReset();
+    EXPECT_TRUE(profileSnapshot().empty());
+}
+
+#else
+
+TEST(Profile, DisabledBuildRecordsNothing) {
+    GameState state = activeState();
+    ActionList actions;
+    getAvailableActions(state, actions);
+    EXPECT_FALSE(profileEnabled());
+    EXPECT_TRUE(profileSnapshot().empty());
+    profileReset();
+    EXPECT_NE(profileReport().find("disabled"), std::string::npos);
+}
+
+#endif
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "bb/quantization.h"
+#include <vector>
+
+using namespace bb;
+
+TEST(Quantization, SymmetricRoundTripWithinHalfStep) {
+    std::vector<float> x = {0.9f, -1.27f, 0.0f, 0.333f, -0.01f, 1.0f};
+    std::vector<int8_t> q(x.size());
+    float scale = quantizeSymmetric(x.data(), static_cast<int>(x.size()), q.data());
+    EXPECT_FLOAT_EQ(scale, 1.27f / 127.0f);
+    EXPECT_EQ(q[1], -127);
+    for (size_t i = 0; i < x.size(); ++i) {
+        EXPECT_NEAR(q[i] * scale, x[i], scale * 0.5f + 1e-6f) << "i=" << i;
+    }
+
+    std::vector<float> zeros(5, 0.0f);
+    std::vector<int8_t> qz(5, 1);
+    EXPECT_EQ(quantizeSymmetric(zeros.data(), 5, qz.data()), 0.0f);
+    for (int8_t v : qz) EXPECT_EQ(v, 0);
+}
+
+TEST(Quantization, DotInt8MatchesScalarAtFullRange) {
+    // Extremes included: a widened multiply never saturates.
+    std::vector<int8_t> a(45), b(45);
+    for (int i = 0; i < 45; ++i) {
+        a[i] = static_cast<int8_t>(i % 2 ? 127 : -127);
+        b[i] = static_cast<int8_t>((i * 37) % 255 - 127);
+    }
+    for (int n = 0; n <= 45; ++n) {
+        int32_t expected = 0;
+        for (int i = 0; i < n; ++i) expected += int32_t{a[i]} * b[i];
+        EXPECT_EQ(dotInt8(a.data(), b.data(), n), expected) << "n=" << n;
+    }
+}
+
+TEST(Quantization, ErrorTracksMaxAndMean) {
+    QuantizationError err;
+    err.add(1.0, 0.9);
+    err.add(-0.5, -0.2);
+    err.add(0.0, 0.0);
+    EXPECT_EQ(err.samples, 3);
+    EXPECT_NEAR(err.maxAbs, 0.3, 1e-12);
+    EXPECT_NEAR(err.meanAbs, 0.4 / 3.0, 1e-12);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "bb/replay_buffer.h"
+#include "bb/roster.h"
+#include <filesystem>
+
+using namespace bb;
+
+namespace {
+
+LoggedGameResult playGame(uint32_t seed) {
+    DiceRoller dice(seed);
+    auto policy = [&dice](const GameState& s) { return randomPolicy(s, dice); };
+    return simulateGameLogged(getHumanRoster(), getOrcRoster(), policy, policy, dice);
+}
+
+// Write `games` games into `dir`, one shard each.
+uint64_t writeGames(const std::string& dir, uint32_t firstSeed, int games) {
+    ShardWriterConfig config;
+    config.maxShardBytes = 1;
+    ShardWriter writer(dir, config);
+    uint64_t states = 0;
+    for (int g = 0; g < games; ++g) {
+        LoggedGameResult logged = playGame(firstSeed + g);
+        states += logged.states.size();
+        writer.appendGame(logged, 1.0f, -1.0f);
+    }
+    return states;
+}
+
+void expectBatchInWindow(const ReplayBatch& b, const ReplayBuffer& buffer) {
+    ASSERT_EQ(b.features.size(), static_cast<size_t>(b.size) * NUM_FEATURES);
+    for (int i = 0; i < b.size; ++i) {
+        EXPECT_GE(b.ids[i], buffer.totalAdded() - buffer.size());
+        EXPECT_LT(b.ids[i], buffer.totalAdded());
+        EXPECT_EQ(b.outcomes[i], b.perspectives[i] == 0 ? 1.0f : -1.0f);
+    }
+}
+
+} // namespace
+
+TEST(ReplayBuffer, KeepsTheNewestStatesAndRefreshes) {
+    std::string dir = (std::filesystem::temp_directory_path() / "bb_replay_buffer_test").string();
+    std::filesystem::remove_all(dir);
+    uint64_t written = writeGames(dir, 1, 3);
+
+    ReplayBufferConfig config;
+    config.capacity = written / 2;
+    ReplayBuffer buffer(dir, config);
+    EXPECT_EQ(buffer.totalAdded(), written);
+    EXPECT_EQ(buffer.size(), config.capacity);
+    ReplayBatch b = buffer.sample(64, false);
+    EXPECT_EQ(b.size, 64);
+    expectBatchInWindow(b, buffer);
+
+    // New shards slide the window forward
+    EXPECT_EQ(buffer.refresh(), 0);
+    uint64_t more = writeGames(dir, 10, 2);
+    EXPECT_EQ(buffer.refresh(), 2);
+    EXPECT_EQ(buffer.totalAdded(), written + more);
+    expectBatchInWindow(buffer.sample(64, false), buffer);
+
+    // Stale ids are ignored; a large priority dominates prioritized batches
+    uint64_t hot = buffer.totalAdded() - 1;
+    uint64_t ids[2] = {0, hot};
+    float priorities[2] = {1e6f, 1e6f};
+    buffer.updatePriorities(ids, priorities, 2);
+    ReplayBatch p = buffer.sample(32, true);
+    expectBatchInWindow(p, buffer);
+    int hits = 0;
+    float hotWeight = 0.0f;
+    for (int i = 0; i < p.size; ++i) {
+        if (p.ids[i] == hot) {
+            ++hits;
+            hotWeight = p.weights[i];
+        }
+    }
+    EXPECT_GT(hits, p.size / 2);
+    // ... and carries the smallest importance weight
+    for (float w : p.weights) EXPECT_GE(w, hotWeight);
+
+    buffer.startPrefetch(16, true, 3, 2);
+    for (int i = 0; i < 10; ++i) {
+        ReplayBatch next = buffer.nextBatch();
+        EXPECT_EQ(next.size, 16);
+        expectBatchInWindow(next, buffer);
+    }
+    EXPECT_THROW(buffer.startPrefetch(16, true), std::runtime_error);
+    buffer.stopPrefetch();
+    EXPECT_THROW(buffer.nextBatch(), std::runtime_error);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(ReplayBuffer, RejectsEmptyAndBadInput) {
+    std::string dir = (std::filesystem::temp_directory_path() / "bb_replay_buffer_empty").string();
+    std::filesystem::remove_all(dir);
+    ReplayBufferConfig config;
+    config.capacity = 0;
+    EXPECT_THROW(ReplayBuffer(dir, config), std::invalid_argument);
+
+    ReplayBuffer buffer(dir);
+    EXPECT_EQ(buffer.size(), 0u);
+    EXPECT_THROW(buffer.sample(8, false), std::runtime_error);
+    EXPECT_THROW(buffer.startPrefetch(8, false), std::runtime_error);
+
+    std::filesystem::create_directories(dir);
+    writeGames(dir, 1, 1);
+    std::filesystem::resize_file(dir + "/shard-000000.states", 100);
+    EXPECT_THROW(buffer.refresh(), std::runtime_error);
+    std::filesystem::remove_all(dir);
+}
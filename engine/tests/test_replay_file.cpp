@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include "bb/replay_file.h"
+#include "bb/roster.h"
+#include <cstdio>
+#include <filesystem>
+
+using namespace bb;
+
+namespace {
+
+std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void expectSamePlayers(const std::vector<PlayerSnapshot>& a, const std::vector<PlayerSnapshot>& b,
+                       size_t turn) {
+    ASSERT_EQ(a.size(), b.size()) << "turn " << turn;
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i].id, b[i].id) << "turn " << turn;
+        EXPECT_EQ(a[i].x, b[i].x) << "turn " << turn;
+        EXPECT_EQ(a[i].y, b[i].y) << "turn " << turn;
+        EXPECT_EQ(a[i].state, b[i].state) << "turn " << turn;
+        EXPECT_EQ(a[i].hasBall, b[i].hasBall) << "turn " << turn;
+        EXPECT_EQ(a[i].name, b[i].name) << "turn " << turn;
+    }
+}
+
+void expectSameTurn(const TurnLog& a, const std::vector<GameEvent>& aEvents,
+                    const TurnLog& b, const std::vector<GameEvent>& bEvents, size_t turn) {
+    EXPECT_EQ(a.half, b.half);
+    EXPECT_EQ(a.turnNumber, b.turnNumber);
+    EXPECT_EQ(a.activeTeam, b.activeTeam);
+    EXPECT_EQ(a.homeScore, b.homeScore);
+    EXPECT_EQ(a.awayScore, b.awayScore);
+    EXPECT_EQ(a.ballX, b.ballX);
+    EXPECT_EQ(a.ballY, b.ballY);
+    EXPECT_EQ(a.ballHeld, b.ballHeld);
+    EXPECT_EQ(a.ballCarrierId, b.ballCarrierId);
+    EXPECT_EQ(a.turnover, b.turnover);
+    EXPECT_EQ(a.touchdown, b.touchdown);
+    expectSamePlayers(a.homePlayers, b.homePlayers, turn);
+    expectSamePlayers(a.awayPlayers, b.awayPlayers, turn);
+    EventRange ea = turnEvents(aEvents, a), eb = turnEvents(bEvents, b);
+    ASSERT_EQ(ea.size(), eb.size()) << "turn " << turn;
+    for (size_t e = 0; e < ea.size(); ++e) {
+        const GameEvent& x = ea[e];
+        const GameEvent& y = eb[e];
+        EXPECT_EQ(x.type, y.type);
+        EXPECT_EQ(x.playerId, y.playerId);
+        EXPECT_EQ(x.targetId, y.targetId);
+        EXPECT_EQ(x.from, y.from);
+        EXPECT_EQ(x.to, y.to);
+        EXPECT_EQ(x.roll, y.roll);
+        EXPECT_EQ(x.success, y.success);
+        EXPECT_EQ(x.die1, y.die1);
+        EXPECT_EQ(x.die2, y.die2);
+    }
+}
+
+} // namespace
+
+TEST(ReplayFile, LoggedGameRoundTrips) {
+    DiceRoller dice(13);
+    auto policy = [&dice](const GameState& s) { return randomPolicy(s, dice); };
+    LoggedGameResult logged = simulateGameLogged(getHumanRoster(), getOrcRoster(),
+                                                 policy, policy, dice);
+    ASSERT_GT(logged.turnLogs.size(), static_cast<size_t>(REPLAY_KEYFRAME_INTERVAL));
+    // Name a few players so the roster table is exercised
+    for (TurnLog& t : logged.turnLogs) {
+        for (PlayerSnapshot& p : t.homePlayers) p.name = p.id % 2 ? "Blitzer" : "Lineman";
+    }
+
+    std::string path = tempPath("bb_replay_test.bbr");
+    ReplayInfo info{logged.result.homeScore, logged.result.awayScore, "{\"seed\": 13}"};
+    ASSERT_TRUE(writeReplay(path, logged.turnLogs, logged.events, info));
+
+    auto reader = ReplayReader::open(path);
+    ASSERT_NE(reader, nullptr);
+    ASSERT_EQ(reader->numTurns(), static_cast<int>(logged.turnLogs.size()));
+    EXPECT_EQ(reader->info().homeScore, info.homeScore);
+    EXPECT_EQ(reader->info().awayScore, info.awayScore);
+    EXPECT_EQ(reader->info().metadata, info.metadata);
+
+    std::vector<GameEvent> events;
+    std::vector<TurnLog> turns = reader->turns(events);
+    EXPECT_EQ(events.size(), logged.events.size());
+    for (size_t t = 0; t < turns.size(); ++t) {
+        expectSameTurn(turns[t], events, logged.turnLogs[t], logged.events, t);
+    }
+    // Random access decodes from the nearest keyframe
+    for (int t : {reader->numTurns() - 1, REPLAY_KEYFRAME_INTERVAL + 3, 1}) {
+        TurnLog turn = reader->turn(t, events);
+        EXPECT_EQ(turn.firstEvent, 0u);
+        expectSameTurn(turn, events, logged.turnLogs[t], logged.events, t);
+    }
+
+    // Deltas make the file much smaller than one full snapshot per turn
+    size_t fullPlayers = 0;
+    for (const TurnLog& t : logged.turnLogs) fullPlayers += t.homePlayers.size() + t.awayPlayers.size();
+    EXPECT_LT(std::filesystem::file_size(path),
+              sizeof(ReplayFileHeader) + logged.turnLogs.size() * sizeof(ReplayTurnRecord) +
+              fullPlayers * sizeof(ReplayPlayerRecord) + logged.events.size() * sizeof(ReplayEventRecord));
+    std::remove(path.c_str());
+}
+
+TEST(ReplayFile, RejectsBadFilesAndUnrepresentableValues) {
+    std::string path = tempPath("bb_replay_bad.bbr");
+    EXPECT_EQ(ReplayReader::open(path + ".missing"), nullptr);
+
+    TurnLog turn;
+    turn.half = 1;
+    turn.turnNumber = 1;
+    turn.homePlayers.push_back({3, 5, 7, 0, false, ""});
+    GameEvent ev{GameEvent::Type::BLOCK};
+    ev.roll = 300;
+    std::vector<GameEvent> events = {ev};
+    turn.numEvents = 1;
+    EXPECT_FALSE(writeReplay(path, {turn}, events));
+    EXPECT_FALSE(writeReplay(path, {turn}, {}));  // range outside the arena
+
+    events[0].roll = 4;
+    ASSERT_TRUE(writeReplay(path, {turn, turn}, events));
+    ASSERT_NE(ReplayReader::open(path), nullptr);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    EXPECT_EQ(ReplayReader::open(path), nullptr);
+    std::remove(path.c_str());
+}
+
+TEST(GameRecord, ReplayRegeneratesTheLoggedGame) {
+    // The random policy draws from the game's own roller, so the rules'
+    // faces have to be recorded for the replay to line up.
+    DiceRoller dice(21);
+    auto policy = [&dice](const GameState& s) { return randomPolicy(s, dice); };
+    LoggedGameResult logged = simulateGameLogged(getSkavenRoster(), getDwarfRoster(),
+                                                 policy, policy, dice);
+    ASSERT_FALSE(logged.record.actions.empty());
+    ASSERT_FALSE(logged.record.dice.empty());
+
+    LoggedGameResult replayed = replayGame(logged.record);
+    EXPECT_EQ(replayed.result.homeScore, logged.result.homeScore);
+    EXPECT_EQ(replayed.result.awayScore, logged.result.awayScore);
+    EXPECT_EQ(replayed.result.totalActions, logged.result.totalActions);
+    ASSERT_EQ(replayed.states.size(), logged.states.size());
+    ASSERT_EQ(replayed.turnLogs.size(), logged.turnLogs.size());
+    for (size_t t = 0; t < logged.turnLogs.size(); ++t) {
+        expectSameTurn(replayed.turnLogs[t], replayed.events, logged.turnLogs[t], logged.events, t);
+        for (int f = 0; f < NUM_FEATURES; ++f) {
+            ASSERT_EQ(replayed.states[t].features[f], logged.states[t].features[f]) << "turn " << t;
+        }
+    }
+
+    // Random access from checkpoints agrees with the sequential replay
+    GameReplayer replayer(logged.record, 3);
+    ASSERT_EQ(replayer.numTurns(), static_cast<int>(logged.turnLogs.size()));
+    std::vector<GameEvent> events;
+    for (int t : {0, 2, 3, 7, replayer.numTurns() - 1}) {
+        TurnLog turn = replayer.turnLog(t, events);
+        expectSameTurn(turn, events, logged.turnLogs[t], logged.events, t);
+        BoardSnapshot board = replayer.board(t);
+        expectSamePlayers(board.homePlayers, logged.turnLogs[t].homePlayers, t);
+        EXPECT_EQ(replayer.stateLog(t).perspective, logged.states[t].perspective);
+    }
+    EXPECT_THROW(replayer.turnLog(replayer.numTurns(), events), std::out_of_range);
+
+    // A record cut short cannot be replayed
+    GameRecord cut = logged.record;
+    cut.dice.resize(cut.dice.size() / 2);
+    EXPECT_THROW(replayGame(cut), std::runtime_error);
+}
+
+TEST(GameRecord, RecordOnlyModeAndFileRoundTrip) {
+    DiceRoller dice(4);
+    auto policy = [&dice](const GameState& s) { return randomPolicy(s, dice); };
+    LoggedGameResult logged = simulateGameLogged(getHumanRoster(), getOrcRoster(), policy, policy,
+                                                 dice, true, GameLogMode::RECORD_ONLY);
+    EXPECT_TRUE(logged.states.empty());
+    EXPECT_TRUE(logged.turnLogs.empty());
+
+    std::string path = tempPath("bb_game_record.bbg");
+    ASSERT_TRUE(writeGameRecord(path, logged.record));
+    auto record = readGameRecord(path);
+    ASSERT_NE(record, nullptr);
+    EXPECT_STREQ(record->home.name, getHumanRoster().name);
+    EXPECT_TRUE(record->useFullKickoff);
+    EXPECT_EQ(record->dice, logged.record.dice);
+    ASSERT_EQ(record->actions.size(), logged.record.actions.size());
+
+    LoggedGameResult replayed = replayGame(*record);
+    EXPECT_EQ(replayed.result.homeScore, logged.result.homeScore);
+    EXPECT_EQ(replayed.result.awayScore, logged.result.awayScore);
+    EXPECT_EQ(replayed.result.totalActions, logged.result.totalActions);
+    EXPECT_FALSE(replayed.turnLogs.empty());
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_EQ(readGameRecord(path), nullptr);
+
+    // Developed rosters come back as themselves through their registry id
+    GameRecord developed = *record;
+    developed.away = *getDevelopedRoster("orc", 1200);
+    ASSERT_TRUE(writeGameRecord(path, developed));
+    record = readGameRecord(path);
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->away.name, getDevelopedRoster("orc", 1200)->name);
+    EXPECT_EQ(rosterIdOf(record->away), findRosterId("orc_tv1200"));
+    std::remove(path.c_str());
+}
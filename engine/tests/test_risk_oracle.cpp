@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "bb/risk_oracle.h"
+#include "bb/helpers.h"
+#include "bb/dice.h"
+#include "bb/game_state.h"
+
+using namespace bb;
+
+namespace {
+
+GameState makeState(int rerolls) {
+    GameState state;
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.homeTeam.rerolls = rerolls;
+    state.weather = Weather::NICE;
+    Player& p = state.getPlayer(1);
+    p.id = 1;
+    p.teamSide = TeamSide::HOME;
+    p.state = PlayerState::STANDING;
+    p.position = {10, 7};
+    p.setStats({6, 3, 3, 8});
+    p.movementRemaining = 6;
+    return state;
+}
+
+} // anonymous namespace
+
+TEST(RiskOracle, SingleRolls) {
+    EXPECT_FLOAT_EQ(RiskOracle::rollChance(2), 5.0f / 6.0f);
+    EXPECT_FLOAT_EQ(RiskOracle::rollChance(6), 1.0f / 6.0f);
+    EXPECT_FLOAT_EQ(RiskOracle::rollChance(9), 1.0f / 6.0f);  // a 6 always passes
+    EXPECT_FLOAT_EQ(RiskOracle::chance({}, {}), 1.0f);
+
+    RerollAccess none;
+    RerollAccess team{true, false, false};
+    EXPECT_FLOAT_EQ(RiskOracle::chance({{3, false}}, none), 4.0f / 6.0f);
+    EXPECT_FLOAT_EQ(RiskOracle::chance({{3, true}}, none), 1.0f - (2.0f / 6.0f) * (2.0f / 6.0f));
+    EXPECT_FLOAT_EQ(RiskOracle::chance({{3, false}}, team), 1.0f - (2.0f / 6.0f) * (2.0f / 6.0f));
+    // Loner: the team reroll only happens on a 4+
+    EXPECT_FLOAT_EQ(RiskOracle::chance({{3, false}}, {true, false, true}),
+                    4.0f / 6.0f + (2.0f / 6.0f) * 0.5f * (4.0f / 6.0f));
+    // Pro: 4+ to use, then the team reroll if that fails
+    float p = 4.0f / 6.0f;
+    EXPECT_FLOAT_EQ(RiskOracle::chance({{3, false}}, {true, true, false}),
+                    p + (1 - p) * (0.5f * p + (1 - 0.5f * p) * p));
+}
+
+TEST(RiskOracle, RerollsServeTheChainOnce) {
+    // Two 2+ GFIs with one team reroll: at most one failure is rescued
+    float p = 5.0f / 6.0f;
+    EXPECT_NEAR(RiskOracle::chance({{2, false}, {2, false}}, {true, false, false}),
+                p * p * (1 + 2 * (1 - p)), 1e-6);
+    // Order does not matter
+    RerollAccess all{true, true, false};
+    std::vector<RiskRoll> chain = {{4, true}, {2, false}, {3, false}, {6, false}, {2, true}};
+    float forward = RiskOracle::chance(chain.data(), 5, all);
+    std::vector<RiskRoll> reversed(chain.rbegin(), chain.rend());
+    EXPECT_NEAR(RiskOracle::chance(reversed.data(), 5, all), forward, 1e-6);
+
+    // Past the table: worked out on the spot
+    std::vector<RiskRoll> seven(7, RiskRoll{2, false});
+    float tabled = RiskOracle::chance(seven.data(), 6, all);
+    float direct = RiskOracle::chance(seven.data(), 7, all);
+    EXPECT_LT(direct, tabled);
+    EXPECT_GT(direct, tabled * 5.0f / 6.0f);  // one more roll costs at most its own odds
+}
+
+TEST(RiskOracle, MatchesAttemptRoll) {
+    // Monte Carlo over the rules engine's own reroll chain
+    GameState base = makeState(1);
+    base.getPlayer(1).addSkill(SkillName::Pro);
+    const int targets[3] = {3, 4, 2};
+    DiceRoller dice(11);
+    int passed = 0;
+    const int trials = 200000;
+    for (int t = 0; t < trials; ++t) {
+        GameState s = base;
+        bool ok = true;
+        for (int target : targets) {
+            if (!attemptRoll(s, 1, dice, target, SkillName::Dodge, false, true, nullptr)) {
+                ok = false;
+                break;
+            }
+        }
+        passed += ok;
+    }
+    float exact = RiskOracle::chance({{3, false}, {4, false}, {2, false}},
+                                     RiskOracle::access(base, base.getPlayer(1)));
+    EXPECT_NEAR(static_cast<double>(passed) / trials, exact, 0.005);
+}
+
+TEST(RiskOracle, GoingForIt) {
+    GameState state = makeState(0);
+    const Player& p = state.getPlayer(1);
+    EXPECT_FLOAT_EQ(RiskOracle::goForItChance(state, p, 0), 1.0f);
+    EXPECT_FLOAT_EQ(RiskOracle::goForItChance(state, p, 1), 5.0f / 6.0f);
+    EXPECT_FLOAT_EQ(RiskOracle::goForItChance(state, p, 3), 0.0f);
+    state.weather = Weather::BLIZZARD;
+    EXPECT_FLOAT_EQ(RiskOracle::goForItChance(state, p, 1), 4.0f / 6.0f);
+    state.homeTeam.rerolls = 2;
+    state.weather = Weather::NICE;
+    EXPECT_FLOAT_EQ(RiskOracle::goForItChance(state, p, 1), 35.0f / 36.0f);
+    state.homeTeam.rerollUsedThisTurn = true;
+    EXPECT_FLOAT_EQ(RiskOracle::goForItChance(state, p, 1), 5.0f / 6.0f);
+}
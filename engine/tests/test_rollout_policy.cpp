@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "bb/rollout_policy.h"
+#include "bb/mcts.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+
+using namespace bb;
+
+namespace {
+
+GameState makePlayState() {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getOrcRoster());
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.half = 1;
+    state.homeTeam.turnNumber = 1;
+    state.ball = BallState::onGround({13, 7});
+    return state;
+}
+
+bool sameAction(const Action& a, const Action& b) {
+    return a.type == b.type && a.playerId == b.playerId && a.targetId == b.targetId &&
+           a.target == b.target;
+}
+
+bool contains(const std::vector<Action>& actions, const Action& a) {
+    for (auto& b : actions) if (sameAction(a, b)) return true;
+    return false;
+}
+
+// Counts calls, delegating to the built-in policy.
+struct CountingPolicy : RolloutPolicy {
+    mutable int calls = 0;
+    bool choose(const GameState& state, DiceRollerBase& dice,
+                ActionList& scratch, Action& out) const override {
+        ++calls;
+        return defaultRolloutPolicy().choose(state, dice, scratch, out);
+    }
+};
+
+} // anonymous namespace
+
+TEST(RolloutPolicy, PlayerActionsSliceAvailableActions) {
+    GameState state = makePlayState();
+    Player& prone = state.getPlayer(3);
+    prone.state = PlayerState::PRONE;
+    state.invalidateOccupancy();
+
+    std::vector<Action> all, slice, joined;
+    getAvailableActions(state, all);
+    // Acting players first, then stand-ups: the order getAvailableActions uses
+    joined.push_back(all[0]);
+    for (bool standUps : {false, true}) {
+        state.forEachOnPitch(TeamSide::HOME, [&](const Player& p) {
+            if ((p.state == PlayerState::PRONE) != standUps) return;
+            getPlayerActions(state, p, slice);
+            joined.insert(joined.end(), slice.begin(), slice.end());
+        });
+    }
+    ASSERT_EQ(joined.size(), all.size());
+    for (size_t i = 0; i < all.size(); ++i) EXPECT_TRUE(sameAction(joined[i], all[i])) << i;
+
+    getPlayerActions(state, state.getPlayer(12), slice);  // not the active team
+    EXPECT_TRUE(slice.empty());
+}
+
+TEST(RolloutPolicy, ChoicesAreAvailableActions) {
+    GameState state = makePlayState();
+    std::vector<Action> all;
+    ActionList scratch;
+    getAvailableActions(state, all);
+
+    FastDiceRoller dice(7);
+    UniformRolloutPolicy uniform;
+    PlayerFirstRolloutPolicy playerFirst;
+    int endTurns = 0;
+    const int draws = 3000;
+    for (int i = 0; i < draws; ++i) {
+        Action a;
+        ASSERT_TRUE(uniform.choose(state, dice, scratch, a));
+        EXPECT_TRUE(contains(all, a));
+        ASSERT_TRUE(playerFirst.choose(state, dice, scratch, a));
+        EXPECT_TRUE(contains(all, a));
+        endTurns += a.type == ActionType::END_TURN;
+    }
+    // Eleven players plus END_TURN: one pick in twelve
+    EXPECT_NEAR(static_cast<double>(endTurns) / draws, 1.0 / 12.0, 0.02);
+
+    state.phase = GamePhase::HALF_TIME;
+    Action a;
+    EXPECT_FALSE(playerFirst.choose(state, dice, scratch, a));
+    EXPECT_FALSE(uniform.choose(state, dice, scratch, a));
+}
+
+TEST(RolloutPolicy, PlayerFirstSkipsPlayersWithNothingToDo) {
+    GameState state = makePlayState();
+    state.forEachOnPitch(TeamSide::HOME, [&](const Player& p) {
+        state.getPlayer(p.id).hasActed = p.id != 4;
+    });
+    ActionList scratch;
+    FastDiceRoller dice(3);
+    for (int i = 0; i < 200; ++i) {
+        Action a;
+        ASSERT_TRUE(defaultRolloutPolicy().choose(state, dice, scratch, a));
+        EXPECT_TRUE(a.type == ActionType::END_TURN || a.playerId == 4);
+    }
+}
+
+TEST(RolloutPolicy, SearchUsesConfiguredPolicy) {
+    CountingPolicy policy;
+    MCTSConfig config;
+    config.maxIterations = 30;
+    config.timeBudgetMs = 1000;
+    config.rolloutDepth = 4;
+    config.rolloutPolicy = &policy;
+
+    MCTSSearch search(nullptr, config, 5);
+    search.search(makePlayState());
+    EXPECT_GT(policy.calls, 0);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "bb/root_cache.h"
+#include "bb/game_state.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+using namespace bb;
+
+namespace {
+
+std::string tempPath(const char* name) {
+    return "/tmp/bb_test_" + std::to_string(::getpid()) + "_" + name;
+}
+
+RootResult makeResult(int visits) {
+    RootResult r;
+    r.value = 0.25;
+    Macro a{MacroType::BLITZ, 3, 7, {12, 5}};
+    Macro b{MacroType::END_TURN, -1, -1, {-1, -1}};
+    r.children.push_back({a, visits, 0.0f, 0.75f, 0.25});
+    r.children.push_back({b, 1, 0.0f, 0.25f, -0.5});
+    return r;
+}
+
+GameState openingState() {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getHumanRoster());
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.half = 1;
+    state.homeTeam.turnNumber = 1;
+    state.ball = BallState::onGround({13, 7});
+    return state;
+}
+
+} // anonymous namespace
+
+TEST(RootCache, StoresAndLooksUpByStateAndModel) {
+    std::string path = tempPath("root_cache_roundtrip");
+    std::remove(path.c_str());
+    {
+        auto cache = RootCache::open(path, 1 << 20);
+        ASSERT_NE(cache, nullptr);
+        RootResult out;
+        EXPECT_FALSE(cache->lookup(42, 1, out));
+        cache->store(42, 1, makeResult(9));
+        ASSERT_TRUE(cache->lookup(42, 1, out));
+        ASSERT_EQ(out.children.size(), 2u);
+        EXPECT_EQ(out.children[0].macro.type, MacroType::BLITZ);
+        EXPECT_EQ(out.children[0].macro.targetId, 7);
+        EXPECT_EQ(out.children[0].macro.targetPos, (Position{12, 5}));
+        EXPECT_EQ(out.children[0].visits, 9);
+        EXPECT_FLOAT_EQ(out.children[1].target, 0.25f);
+        EXPECT_DOUBLE_EQ(out.value, 0.25);
+        EXPECT_FALSE(cache->lookup(42, 2, out));  // another model
+        EXPECT_EQ(cache->size(), 1u);
+        EXPECT_EQ(cache->hits(), 1u);
+        EXPECT_EQ(cache->misses(), 2u);
+    }
+    // The entry outlives the process's handle
+    auto reopened = RootCache::open(path, 1 << 10);
+    ASSERT_NE(reopened, nullptr);
+    RootResult out;
+    ASSERT_TRUE(reopened->lookup(42, 1, out));
+    EXPECT_EQ(out.children[0].visits, 9);
+    EXPECT_GT(reopened->capacity(), static_cast<size_t>(RootCache::PROBE));  // kept its own size
+    std::remove(path.c_str());
+}
+
+TEST(RootCache, EvictsLeastRecentlyUsed) {
+    std::string path = tempPath("root_cache_lru");
+    std::remove(path.c_str());
+    auto cache = RootCache::open(path, 0);  // smallest: one probe window
+    ASSERT_NE(cache, nullptr);
+    ASSERT_EQ(cache->capacity(), static_cast<size_t>(RootCache::PROBE));
+    for (int i = 0; i < RootCache::PROBE; ++i) cache->store(100 + i, 1, makeResult(i + 1));
+    RootResult out;
+    ASSERT_TRUE(cache->lookup(100, 1, out));  // 100 is now the most recent
+    cache->store(999, 1, makeResult(5));
+    EXPECT_EQ(cache->evictions(), 1u);
+    EXPECT_TRUE(cache->lookup(100, 1, out));
+    EXPECT_FALSE(cache->lookup(101, 1, out));
+    EXPECT_TRUE(cache->lookup(999, 1, out));
+    EXPECT_EQ(cache->size(), static_cast<size_t>(RootCache::PROBE));
+    std::remove(path.c_str());
+}
+
+TEST(RootCache, SearchReusesStoredRoot) {
+    std::string path = tempPath("root_cache_search");
+    std::remove(path.c_str());
+    auto cache = RootCache::open(path, 1 << 20);
+    ASSERT_NE(cache, nullptr);
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 64;
+    config.rootCache = cache.get();
+    config.rootCacheModel = 7;
+    GameState state = openingState();
+
+    MacroMCTSSearch first(nullptr, config, 3);
+    Macro chosen = first.search(state);
+    ASSERT_GT(first.lastIterations(), 0);
+    EXPECT_FALSE(first.lastStats().rootCacheHit);
+    EXPECT_EQ(cache->size(), 1u);
+
+    MacroMCTSSearch second(nullptr, config, 11);
+    Macro again = second.search(state);
+    EXPECT_TRUE(second.lastStats().rootCacheHit);
+    EXPECT_EQ(second.lastIterations(), 0);
+    EXPECT_EQ(again.type, chosen.type);
+    EXPECT_EQ(again.playerId, chosen.playerId);
+    EXPECT_EQ(again.targetPos, chosen.targetPos);
+    EXPECT_DOUBLE_EQ(second.lastBestValue(), first.lastBestValue());
+    ASSERT_FALSE(second.lastChildVisits().empty());
+
+    // Other networks or settings do not see it
+    config.rootCacheModel = 8;
+    MacroMCTSSearch otherModel(nullptr, config, 11);
+    otherModel.search(state);
+    EXPECT_FALSE(otherModel.lastStats().rootCacheHit);
+    config.rootCacheModel = 7;
+    config.explorationC = 2.0;
+    MacroMCTSSearch otherSettings(nullptr, config, 11);
+    otherSettings.search(state);
+    EXPECT_FALSE(otherSettings.lastStats().rootCacheHit);
+    std::remove(path.c_str());
+}
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 #include "bb/rules_engine.h"
 #include "bb/helpers.h"
+#include "bb/pathfinder.h"
+#include "bb/action_resolver.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+#include <algorithm>
 
 using namespace bb;
 
@@ -9,8 +14,8 @@ static void placePlayer(GameState& gs, int id, Position pos, TeamSide side,
     Player& p = gs.getPlayer(id);
     p.state = PlayerState::STANDING;
     p.position = pos;
-    p.stats = {static_cast<int8_t>(ma), static_cast<int8_t>(st),
-               static_cast<int8_t>(ag), static_cast<int8_t>(av)};
+    p.setStats({static_cast<int8_t>(ma), static_cast<int8_t>(st),
+                static_cast<int8_t>(ag), static_cast<int8_t>(av)});
     p.movementRemaining = ma;
 }
 
@@ -194,3 +199,170 @@ TEST(RulesEngine, NoMovementLeftNoMoveActions) {
     int moveCount = countActionsOfType(actions, ActionType::MOVE);
     EXPECT_EQ(moveCount, 0);
 }
+
+TEST(RulesEngine, BlitzReachMatchesPathfinder) {
+    GameState gs;
+    gs.phase = GamePhase::PLAY;
+    gs.activeTeam = TeamSide::HOME;
+    placePlayer(gs, 1, {5, 7}, TeamSide::HOME, 3);  // MA3 + 2 GFI = 5 squares
+    placePlayer(gs, 12, {11, 7}, TeamSide::AWAY);   // needs 5 steps to (10,7): reachable
+    placePlayer(gs, 13, {12, 2}, TeamSide::AWAY);   // needs 6 steps: out of range
+    // Wall of teammates around the blitzer except one gap to the east
+    for (int y = 5; y <= 9; ++y) {
+        placePlayer(gs, 2 + (y - 5), {4, static_cast<int8_t>(y)}, TeamSide::HOME);
+    }
+    placePlayer(gs, 7, {5, 6}, TeamSide::HOME);
+    placePlayer(gs, 8, {5, 8}, TeamSide::HOME);
+
+    std::vector<Action> actions;
+    getAvailableActions(gs, actions);
+
+    auto hasBlitz = [&](int target) {
+        for (auto& a : actions) {
+            if (a.type == ActionType::BLITZ && a.playerId == 1 && a.targetId == target) return true;
+        }
+        return false;
+    };
+    Position adj;
+    EXPECT_EQ(hasBlitz(12), canReachAdjacentTo(gs, gs.getPlayer(1), {11, 7}, adj));
+    EXPECT_TRUE(hasBlitz(12));
+    EXPECT_EQ(hasBlitz(13), canReachAdjacentTo(gs, gs.getPlayer(1), {12, 2}, adj));
+    EXPECT_FALSE(hasBlitz(13));
+}
+
+TEST(RulesEngine, AdjacentActionsInSquareOrder) {
+    GameState gs;
+    gs.phase = GamePhase::PLAY;
+    gs.activeTeam = TeamSide::HOME;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
+    placePlayer(gs, 12, {11, 8}, TeamSide::AWAY);
+    placePlayer(gs, 13, {9, 6}, TeamSide::AWAY);
+
+    std::vector<Action> actions;
+    getAvailableActions(gs, actions);
+
+    // MOVEs and BLOCKs follow Position::getAdjacent() order
+    std::vector<Position> moves, blocks;
+    for (auto& a : actions) {
+        if (a.playerId != 1) continue;
+        if (a.type == ActionType::MOVE) moves.push_back(a.target);
+        if (a.type == ActionType::BLOCK) blocks.push_back(a.target);
+    }
+    std::vector<Position> expectedMoves;
+    for (auto& pos : Position{10, 7}.getAdjacent()) {
+        if (pos != Position{11, 8} && pos != Position{9, 6}) expectedMoves.push_back(pos);
+    }
+    EXPECT_EQ(moves, expectedMoves);
+    EXPECT_EQ(blocks, (std::vector<Position>{{9, 6}, {11, 8}}));
+}
+
+TEST(RulesEngine, PathMovesReplaceSingleSteps) {
+    GameState gs;
+    gs.phase = GamePhase::PLAY;
+    gs.activeTeam = TeamSide::HOME;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 4);
+    placePlayer(gs, 2, {3, 3}, TeamSide::HOME);
+    gs.getPlayer(2).state = PlayerState::PRONE;
+
+    std::vector<Action> actions;
+    getAvailableActionsWithPaths(gs, actions);
+    EXPECT_EQ(countActionsOfType(actions, ActionType::END_TURN), 1);
+    // Only the stand-up is still a MOVE
+    ASSERT_EQ(countActionsOfType(actions, ActionType::MOVE), 1);
+    // MA4 + 2 GFI over open field: 13x13 squares less the start
+    EXPECT_EQ(countActionsOfType(actions, ActionType::MOVE_PATH), 13 * 13 - 1);
+    for (auto& a : actions) {
+        if (a.type == ActionType::MOVE) EXPECT_EQ(a.playerId, 2);
+        if (a.type == ActionType::MOVE_PATH) EXPECT_EQ(a.playerId, 1);
+    }
+
+    gs.phase = GamePhase::HALF_TIME;
+    getAvailableActionsWithPaths(gs, actions);
+    EXPECT_TRUE(actions.empty());
+}
+
+TEST(RulesEngine, PublishedActionsMatchByIdentity) {
+    GameState gs;
+    gs.phase = GamePhase::PLAY;
+    placePlayer(gs, 1, {10, 7}, TeamSide::HOME);
+    ActionList listed;
+    getAvailableActions(gs, listed);
+
+    EXPECT_EQ(PublishedActions::find(gs), nullptr);
+    {
+        PublishedActions published(gs, listed);
+        ActionList scratch;
+        EXPECT_EQ(&decisionActions(gs, scratch), &listed);
+        GameState copy = gs.clone();
+        EXPECT_EQ(PublishedActions::find(copy), nullptr);
+        const ActionList& generated = decisionActions(copy, scratch);
+        EXPECT_EQ(&generated, &scratch);
+        EXPECT_EQ(generated.size(), listed.size());
+        {
+            ActionList inner;
+            PublishedActions nested(copy, inner);
+            EXPECT_EQ(PublishedActions::find(copy), &inner);
+            EXPECT_EQ(PublishedActions::find(gs), nullptr);
+        }
+        EXPECT_EQ(PublishedActions::find(gs), &listed);
+    }
+    EXPECT_EQ(PublishedActions::find(gs), nullptr);
+}
+
+TEST(RulesEngine, ActionLegalityMatchesMoveGeneration) {
+    // isActionLegal(a) == (a is listed), over every listed action and every
+    // single-field variation of one, in random play between rosters with
+    // the rare skills (Ball & Chain, Bombardier, TTM, Hypnotic Gaze)
+    const TeamRoster* rosters[] = {&getGoblinRoster(), &getVampireRoster(), &getHalflingRoster(),
+                                   &getOgreRoster(), &getHumanRoster(), &getSkavenRoster()};
+    std::vector<Action> listed;
+    std::vector<Action> candidates;
+    auto same = [](const Action& a, const Action& b) {
+        return a.type == b.type && a.playerId == b.playerId && a.targetId == b.targetId &&
+               a.target == b.target;
+    };
+    int checked = 0, legal = 0;
+    for (uint32_t seed = 1; seed <= 6; ++seed) {
+        GameState gs;
+        DiceRoller dice(seed);
+        setupHalf(gs, *rosters[seed % 6], *rosters[(seed + 1) % 6], TeamSide::AWAY);
+        // No roster has Multiple Block
+        gs.getPlayer(2).addSkill(SkillName::MultipleBlock);
+        gs.getPlayer(13).addSkill(SkillName::MultipleBlock);
+        gs.invalidateOccupancy();
+        simpleKickoff(gs, dice);
+        for (int step = 0; step < 40 && gs.phase == GamePhase::PLAY; ++step) {
+            getAvailableActions(gs, listed);
+            candidates.clear();
+            for (const Action& a : listed) {
+                for (int t = 0; t <= static_cast<int>(ActionType::MOVE_PATH); ++t) {
+                    candidates.push_back({static_cast<ActionType>(t), a.playerId, a.targetId, a.target});
+                }
+                for (int id = -1; id <= 23; ++id) {
+                    candidates.push_back({a.type, id, a.targetId, a.target});
+                    candidates.push_back({a.type, a.playerId, id, a.target});
+                    candidates.push_back({a.type, a.playerId, a.targetId, {static_cast<int8_t>(id), a.target.y}});
+                }
+                for (int dy = -2; dy <= 2; ++dy) {
+                    for (int dx = -2; dx <= 2; ++dx) {
+                        Position t{static_cast<int8_t>(a.target.x + dx), static_cast<int8_t>(a.target.y + dy)};
+                        candidates.push_back({a.type, a.playerId, a.targetId, t});
+                    }
+                }
+            }
+            for (const Action& c : candidates) {
+                bool expected = std::any_of(listed.begin(), listed.end(),
+                                            [&](const Action& a) { return same(a, c); });
+                ASSERT_EQ(isActionLegal(gs, c), expected)
+                    << "seed " << seed << " step " << step << " " << actionTypeName(c.type)
+                    << " player " << c.playerId << " target " << c.targetId << " ("
+                    << int(c.target.x) << "," << int(c.target.y) << ")";
+                ++checked;
+                legal += expected;
+            }
+            executeAction(gs, listed[dice.rollD6() * 31 % listed.size()], dice, nullptr);
+        }
+    }
+    EXPECT_GT(legal, 1000);
+    EXPECT_GT(checked, 100000);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "bb/search_trace.h"
+#include "bb/macro_mcts.h"
+#include "bb/mcts.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+#include <nlohmann/json.hpp>
+#include <string>
+
+using namespace bb;
+
+namespace {
+
+GameState makePlayState() {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getHumanRoster());
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.half = 1;
+    state.homeTeam.turnNumber = 1;
+    state.homeTeam.rerolls = 3;
+    state.awayTeam.rerolls = 3;
+    state.weather = Weather::NICE;
+    state.ball = BallState::onGround({13, 7});
+    return state;
+}
+
+int countNamed(const nlohmann::json& events, const std::string& name) {
+    int n = 0;
+    for (const auto& e : events) {
+        if (e["name"] == name) n++;
+    }
+    return n;
+}
+
+} // anonymous namespace
+
+TEST(SearchTrace, SpansSerializeAsCompleteEvents) {
+    SearchTrace trace;
+    auto t0 = SearchTrace::Clock::now();
+    trace.span("outer", "search", t0, t0 + std::chrono::microseconds(50), 0, "\"iterations\":3");
+    trace.span("inner", "phase", t0, t0 + std::chrono::microseconds(10), 2);
+    EXPECT_EQ(trace.size(), 2u);
+
+    auto json = nlohmann::json::parse(trace.toJson());
+    const auto& events = json["traceEvents"];
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0]["name"], "outer");
+    EXPECT_EQ(events[0]["ph"], "X");
+    EXPECT_NEAR(events[0]["dur"].get<double>(), 50.0, 1e-3);
+    EXPECT_EQ(events[0]["args"]["iterations"], 3);
+    EXPECT_EQ(events[1]["tid"], 2);
+    EXPECT_FALSE(events[1].contains("args"));
+
+    trace.clear();
+    EXPECT_EQ(trace.size(), 0u);
+    EXPECT_TRUE(nlohmann::json::parse(trace.toJson())["traceEvents"].empty());
+}
+
+TEST(SearchTrace, NullTraceSpanRecordsNothing) {
+    TraceSpan span(nullptr, "unused");
+    EXPECT_FALSE(span.active());
+}
+
+TEST(SearchTrace, MacroSearchSamplesEveryNthIteration) {
+    GameState state = makePlayState();
+    SearchTrace trace(10);
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 100;
+    config.trace = &trace;
+
+    MacroMCTSSearch search(nullptr, config, 42);
+    search.search(state);
+
+    auto events = nlohmann::json::parse(trace.toJson())["traceEvents"];
+    EXPECT_EQ(countNamed(events, "MacroMCTSSearch::search"), 1);
+    EXPECT_EQ(countNamed(events, "iteration"), 10);
+    EXPECT_EQ(countNamed(events, "select"), 10);
+    EXPECT_EQ(countNamed(events, "backprop"), 10);
+    int macroSpans = 0;
+    for (const auto& e : events) {
+        if (e["cat"] == "macro") macroSpans++;
+    }
+    EXPECT_GT(macroSpans, 0);
+    EXPECT_GT(countNamed(events, "getAvailableMacros"), 0);
+}
+
+TEST(SearchTrace, ParallelMacroSearchUsesWorkerTracks) {
+    GameState state = makePlayState();
+    SearchTrace trace(4);
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 64;
+    config.numThreads = 2;
+    config.trace = &trace;
+
+    MacroMCTSSearch search(nullptr, config, 42);
+    search.search(state);
+
+    auto events = nlohmann::json::parse(trace.toJson())["traceEvents"];
+    EXPECT_EQ(countNamed(events, "iteration"), 16);
+    for (const auto& e : events) {
+        if (e["name"] == "iteration") {
+            EXPECT_GE(e["tid"].get<int>(), 1);
+            EXPECT_LE(e["tid"].get<int>(), 2);
+        }
+    }
+}
+
+TEST(SearchTrace, ActionSearchRecordsPhasesAndActions) {
+    GameState state = makePlayState();
+    SearchTrace trace(8);
+
+    MCTSConfig config;
+    config.timeBudgetMs = 60000;
+    config.maxIterations = 64;
+    config.trace = &trace;
+
+    MCTSSearch search(nullptr, config, 42);
+    search.search(state);
+
+    auto events = nlohmann::json::parse(trace.toJson())["traceEvents"];
+    EXPECT_EQ(countNamed(events, "MCTSSearch::search"), 1);
+    EXPECT_EQ(countNamed(events, "iteration"), 8);
+    EXPECT_EQ(countNamed(events, "simulate"), 8);
+    int actionSpans = 0;
+    for (const auto& e : events) {
+        if (e["cat"] == "action") actionSpans++;
+    }
+    EXPECT_GT(actionSpans, 0);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "bb/search_tree_file.h"
+#include "bb/macro_mcts.h"
+#include "bb/mcts.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+using namespace bb;
+
+namespace {
+
+GameState makePlayState() {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getHumanRoster());
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::AWAY;
+    state.half = 1;
+    state.awayTeam.turnNumber = 1;
+    state.homeTeam.rerolls = 3;
+    state.awayTeam.rerolls = 3;
+    state.weather = Weather::NICE;
+    state.ball = BallState::onGround({13, 7});
+    return state;
+}
+
+std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Shape checks every export must pass: breadth-first rows, consistent
+// child counts and depths, visits at or above the threshold.
+void expectWellFormed(const SearchTree& tree) {
+    ASSERT_FALSE(tree.nodes.empty());
+    EXPECT_EQ(tree.nodes[0].parent, -1);
+    EXPECT_EQ(tree.nodes[0].depth, 0);
+    std::vector<uint32_t> children(tree.nodes.size(), 0);
+    for (size_t i = 1; i < tree.nodes.size(); ++i) {
+        const SearchTreeRecord& r = tree.nodes[i];
+        ASSERT_GE(r.parent, 0);
+        ASSERT_LT(static_cast<size_t>(r.parent), i);
+        EXPECT_GE(r.parent, tree.nodes[i - 1].parent);  // children blocks in row order
+        EXPECT_EQ(r.depth, tree.nodes[r.parent].depth + 1);
+        EXPECT_GE(r.visits, tree.minVisits);
+        children[r.parent]++;
+    }
+    for (size_t i = 0; i < tree.nodes.size(); ++i) EXPECT_EQ(tree.nodes[i].numChildren, children[i]);
+}
+
+} // anonymous namespace
+
+TEST(SearchTreeFile, MacroSearchExportsItsTreeAndRoundTrips) {
+    GameState state = makePlayState();
+    MCTSConfig config;
+    config.maxIterations = 300;
+    config.timeBudgetMs = 100000;
+    MacroMCTSSearch search(nullptr, config, 5);
+    search.search(state);
+
+    SearchTree tree = search.exportTree();
+    EXPECT_TRUE(tree.macro);
+    EXPECT_EQ(tree.searchingSide, TeamSide::AWAY);
+    expectWellFormed(tree);
+    EXPECT_EQ(tree.nodes[0].actingTeam, static_cast<uint8_t>(TeamSide::AWAY));
+    // Root children are the searching side's macros; their visits are the
+    // ones the search reported
+    int reported = 0;
+    for (const auto& c : search.lastChildVisits()) reported += c.visits;
+    int exported = 0;
+    for (const SearchTreeRecord& r : tree.nodes) {
+        if (r.parent != 0) continue;
+        EXPECT_EQ(r.actingTeam, static_cast<uint8_t>(TeamSide::AWAY));
+        exported += r.visits;
+    }
+    EXPECT_EQ(exported, reported);
+
+    SearchTree pruned = search.exportTree(10);
+    expectWellFormed(pruned);
+    EXPECT_LT(pruned.nodes.size(), tree.nodes.size());
+
+    std::string path = tempPath("bb_search_tree.bbt");
+    ASSERT_TRUE(writeSearchTree(path, pruned));
+    auto read = readSearchTree(path);
+    ASSERT_NE(read, nullptr);
+    EXPECT_TRUE(read->macro);
+    EXPECT_EQ(read->minVisits, 10);
+    ASSERT_EQ(read->nodes.size(), pruned.nodes.size());
+    EXPECT_EQ(0, std::memcmp(read->nodes.data(), pruned.nodes.data(),
+                             pruned.nodes.size() * sizeof(SearchTreeRecord)));
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_EQ(readSearchTree(path), nullptr);
+    std::remove(path.c_str());
+    EXPECT_EQ(readSearchTree(path), nullptr);
+}
+
+TEST(SearchTreeFile, ActionSearchExportsActingTeams) {
+    GameState state = makePlayState();
+    MCTSConfig config;
+    config.maxIterations = 200;
+    config.timeBudgetMs = 100000;
+    MCTSSearch search(nullptr, config, 3);
+    search.search(state);
+
+    SearchTree tree = search.exportTree();
+    EXPECT_FALSE(tree.macro);
+    expectWellFormed(tree);
+    int visits = 0;
+    for (const SearchTreeRecord& r : tree.nodes) {
+        if (r.parent != 0) continue;
+        EXPECT_EQ(r.actingTeam, static_cast<uint8_t>(TeamSide::AWAY));
+        if (r.playerId > 0) {
+            EXPECT_GE(r.playerId, 12);
+        }
+        visits += r.visits;
+    }
+    EXPECT_EQ(visits, search.lastIterations());
+}
+
+TEST(SearchTreeFile, NoTreeExportsEmpty) {
+    MCTSConfig config;
+    MacroMCTSSearch search(nullptr, config, 1);
+    EXPECT_TRUE(search.exportTree().nodes.empty());
+}
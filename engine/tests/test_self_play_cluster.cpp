@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include "bb/self_play_cluster.h"
+#include "bb/feature_extractor.h"
+#include <sys/socket.h>
+#include <unistd.h>
+#include <filesystem>
+#include <thread>
+
+using namespace bb;
+
+namespace {
+
+std::string tempDir(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("bb_cluster_test_" + name)).string();
+}
+
+std::vector<uint8_t> bytesOf(const std::string& text) {
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+ClusterRunConfig makeRun(int games, int unitGames) {
+    ClusterRunConfig run;
+    run.spec.modelHash = "h";
+    run.games = games;
+    run.unitGames = unitGames;
+    run.firstSeed = 100;
+    run.maxAttempts = 2;
+    run.leaseMs = 1000;
+    return run;
+}
+
+} // anonymous namespace
+
+TEST(ContentStore, StoresOnlyMatchingBytes) {
+    std::vector<uint8_t> a = bytesOf("[1.0, 2.0]");
+    std::vector<uint8_t> b = bytesOf("[1.0, 2.5]");
+    EXPECT_EQ(contentHash(a), contentHash(bytesOf("[1.0, 2.0]")));
+    EXPECT_NE(contentHash(a), contentHash(b));
+    EXPECT_EQ(contentHash(a).size(), 32u);
+
+    std::string dir = tempDir("store");
+    std::filesystem::remove_all(dir);
+    ContentStore store(dir);
+    std::string hash = contentHash(a);
+    EXPECT_FALSE(store.has(hash));
+    EXPECT_FALSE(store.put(hash, b));
+    EXPECT_FALSE(store.has(hash));
+    EXPECT_TRUE(store.put(hash, a));
+    EXPECT_TRUE(store.has(hash));
+    EXPECT_EQ(std::filesystem::file_size(store.path(hash)), a.size());
+    std::filesystem::remove_all(dir);
+}
+
+TEST(ClusterCoordinator, SplitsSeedsIntoUnitsInOrder) {
+    ClusterCoordinator coordinator(makeRun(10, 4));
+    EXPECT_EQ(coordinator.units(), 3);
+    std::optional<WorkUnit> u0 = coordinator.assign("a");
+    std::optional<WorkUnit> u1 = coordinator.assign("b");
+    std::optional<WorkUnit> u2 = coordinator.assign("a");
+    ASSERT_TRUE(u0 && u1 && u2);
+    EXPECT_EQ(u0->id, 0u);
+    EXPECT_EQ(u0->firstSeed, 100u);
+    EXPECT_EQ(u0->games, 4);
+    EXPECT_EQ(u1->firstSeed, 104u);
+    EXPECT_EQ(u2->firstSeed, 108u);
+    EXPECT_EQ(u2->games, 2);  // the rest
+    EXPECT_EQ(u2->attempt, 1);
+    EXPECT_FALSE(coordinator.assign("c"));
+    EXPECT_FALSE(coordinator.finished());
+
+    EXPECT_TRUE(coordinator.complete(1, UnitResult{}));
+    EXPECT_FALSE(coordinator.complete(1, UnitResult{}));
+    EXPECT_TRUE(coordinator.complete(0, UnitResult{}));
+    EXPECT_TRUE(coordinator.complete(2, UnitResult{}));
+    EXPECT_TRUE(coordinator.finished());
+    EXPECT_EQ(coordinator.completed(), 3);
+    EXPECT_EQ(coordinator.takeResults().size(), 3u);
+    EXPECT_TRUE(coordinator.takeResults().empty());
+
+    EXPECT_THROW(ClusterCoordinator(makeRun(0, 4)), std::invalid_argument);
+    ClusterRunConfig noModel = makeRun(4, 4);
+    noModel.spec.modelHash.clear();
+    EXPECT_THROW(ClusterCoordinator{noModel}, std::invalid_argument);
+}
+
+TEST(ClusterCoordinator, RetriesFailedUnitsUpToTheLimit) {
+    using Clock = ClusterCoordinator::Clock;
+    ClusterCoordinator coordinator(makeRun(8, 4));
+    Clock::time_point t0 = Clock::now();
+
+    // A failed attempt goes back in line ahead of later units
+    std::optional<WorkUnit> first = coordinator.assign("a", t0);
+    coordinator.fail(first->id, first->attempt, "crashed");
+    std::optional<WorkUnit> retry = coordinator.assign("b", t0);
+    EXPECT_EQ(retry->id, 0u);
+    EXPECT_EQ(retry->attempt, 2);
+    EXPECT_EQ(retry->firstSeed, first->firstSeed);
+    // The superseded attempt's failure is stale
+    coordinator.fail(first->id, first->attempt, "late");
+    ASSERT_TRUE(coordinator.assign("a", t0));  // unit 1
+
+    // Unit 0 fails its last attempt and is given up
+    coordinator.fail(retry->id, retry->attempt, "crashed again");
+    EXPECT_EQ(coordinator.failed(), 1);
+    EXPECT_FALSE(coordinator.assign("c", t0));
+
+    // Unit 1's lease runs out, and the next holder leaves
+    EXPECT_EQ(coordinator.expireLeases(t0 + std::chrono::milliseconds(999)), 0);
+    EXPECT_EQ(coordinator.expireLeases(t0 + std::chrono::milliseconds(1000)), 1);
+    std::optional<WorkUnit> again = coordinator.assign("d", t0);
+    ASSERT_TRUE(again);
+    EXPECT_EQ(again->id, 1u);
+    coordinator.workerLost("d");
+    EXPECT_EQ(coordinator.failed(), 2);
+    EXPECT_TRUE(coordinator.finished());
+}
+
+TEST(SelfPlayCluster, WorkerPlaysUnitsOverASocket) {
+    std::string weights = "[";
+    for (int i = 0; i < NUM_FEATURES; ++i) weights += (i ? ",0.0" : "0.5");
+    weights += "]";
+    std::vector<uint8_t> model = bytesOf(weights);
+
+    ClusterRunConfig run = makeRun(3, 2);
+    run.spec.modelHash = contentHash(model);
+    run.spec.search = {{"maxIterations", 8}, {"vfBlend", 0.5}, {"evalBatchSize", 8}};
+    run.spec.concurrentGames = 2;
+    ClusterCoordinator coordinator(run);
+
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    std::thread server([&] {
+        ClusterChannel channel(fds[0]);
+        serveClusterConnection(coordinator, channel, model);
+    });
+    ClusterWorkerOptions options;
+    options.name = "w";
+    options.cacheDir = tempDir("cache");
+    options.scratchDir = tempDir("scratch");
+    std::filesystem::remove_all(options.cacheDir);
+    ClusterChannel channel(fds[1]);
+    bool finished = false;
+    EXPECT_EQ(runClusterWorker(channel, options, &finished), 2);
+    EXPECT_TRUE(finished);
+    ::shutdown(fds[1], SHUT_RDWR);
+    server.join();
+    ::close(fds[0]);
+    ::close(fds[1]);
+
+    EXPECT_TRUE(ContentStore(options.cacheDir).has(run.spec.modelHash));
+    EXPECT_FALSE(std::filesystem::exists(options.scratchDir));
+    EXPECT_TRUE(coordinator.finished());
+    std::map<uint32_t, UnitResult> results = coordinator.takeResults();
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].homeWins + results[0].awayWins + results[0].draws, 2);
+    EXPECT_EQ(results[1].homeWins + results[1].awayWins + results[1].draws, 1);
+
+    // The unit replays exactly wherever it runs
+    WorkUnit unit;
+    unit.id = 1;
+    unit.firstSeed = run.firstSeed + 2;
+    unit.games = 1;
+    unit.spec = run.spec;
+    std::vector<float> w(NUM_FEATURES, 0.0f);
+    w[0] = 0.5f;
+    UnitResult replay = runWorkUnit(unit, LinearValueFunction(w), options.scratchDir);
+    ASSERT_EQ(replay.files.size(), results[1].files.size());
+    for (size_t i = 0; i < replay.files.size(); ++i) {
+        EXPECT_EQ(replay.files[i].name, results[1].files[i].name);
+        EXPECT_EQ(replay.files[i].bytes, results[1].files[i].bytes);
+    }
+    bool hasIndex = false;
+    for (const ClusterFile& f : replay.files) hasIndex |= f.name == "index.jsonl";
+    EXPECT_TRUE(hasIndex);
+
+    unit.spec.search["noSuchField"] = 1.0;
+    EXPECT_THROW(runWorkUnit(unit, LinearValueFunction(w), options.scratchDir), std::invalid_argument);
+    std::filesystem::remove_all(options.cacheDir);
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "bb/setup_evaluator.h"
+#include "bb/game_simulator.h"
+#include "bb/kickoff_handler.h"
+#include "bb/roster.h"
+
+using namespace bb;
+
+namespace {
+
+LinearValueFunction makeModel() {
+    std::vector<float> weights(NUM_FEATURES, 0.0f);
+    for (int i = 0; i < NUM_FEATURES; ++i) weights[i] = 0.01f * static_cast<float>((i * 7) % 13 - 6);
+    return LinearValueFunction(weights);
+}
+
+} // anonymous namespace
+
+TEST(SetupEvaluator, AveragesOverKickLandings) {
+    GameState state;
+    state.kickingTeam = TeamSide::AWAY;
+    setupHalf(state, getHumanRoster(), getHumanRoster(), TeamSide::AWAY);
+    LinearValueFunction vf = makeModel();
+
+    SetupCandidate current = currentSetup(state, TeamSide::AWAY);
+    SetupCandidate deeper = current;
+    for (Position& sq : deeper.squares) sq.x = static_cast<int8_t>(std::min(sq.x + 2, 25));
+    std::vector<float> values = evaluateSetups(state, TeamSide::AWAY, {current, deeper}, vf,
+                                               TeamSide::AWAY);
+    ASSERT_EQ(values.size(), 2u);
+
+    // The current setup by hand: every landing square, one at a time
+    GameState placed = state.clone();
+    placed.phase = GamePhase::PLAY;
+    placed.activeTeam = TeamSide::HOME;
+    const KickTable& kick = kickTable(kickTarget(placed), true);
+    float expected = 0.0f;
+    for (int l = 0; l < kick.landingCount; ++l) {
+        GameState landed = placed.clone();
+        placeKickedBall(landed, TeamSide::HOME, kick.landings[l].square);
+        expected += kick.landings[l].probability * vf.evaluateState(landed, TeamSide::AWAY);
+    }
+    EXPECT_NEAR(values[0], expected, 1e-4);
+    EXPECT_NE(values[0], values[1]);
+
+    // Batching does not change a candidate's value
+    std::vector<float> alone = evaluateSetups(state, TeamSide::AWAY, {deeper}, vf, TeamSide::AWAY);
+    EXPECT_NEAR(alone[0], values[1], 1e-5);
+    EXPECT_TRUE(evaluateSetups(state, TeamSide::AWAY, {}, vf, TeamSide::AWAY).empty());
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "bb/shard_compactor.h"
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+using namespace bb;
+
+namespace {
+
+// A decision over actions named by their first feature
+PolicyDecision decision(uint64_t hash, uint64_t canonical, int totalVisits,
+                        std::vector<std::pair<float, float>> actionShares) {
+    PolicyDecision d{};
+    d.stateFeatures[0] = static_cast<float>(hash);
+    d.perspective = TeamSide::HOME;
+    d.stateHash = hash;
+    d.canonicalHash = canonical;
+    d.totalVisits = totalVisits;
+    for (auto [action, share] : actionShares) {
+        PolicyDecision::ActionVisit v{};
+        v.actionFeatures[0] = action;
+        v.visitFraction = share;
+        d.visits.push_back(v);
+    }
+    return d;
+}
+
+LoggedGameResult game(std::vector<PolicyDecision> decisions, int states = 2) {
+    LoggedGameResult g;
+    g.states.resize(states);
+    for (StateLog& s : g.states) s = StateLog{};
+    g.policyDecisions = std::move(decisions);
+    return g;
+}
+
+template<typename T>
+std::vector<T> readAll(const std::string& dir, const char* kind) {
+    std::vector<T> out;
+    std::ifstream index(dir + "/index.jsonl");
+    std::string line;
+    for (int shard = 0; std::getline(index, line); ++shard) {
+        char name[40];
+        std::snprintf(name, sizeof(name), "/shard-%06d.%s", shard, kind);
+        std::ifstream in(dir + name, std::ios::binary);
+        ShardFileHeader h;
+        in.read(reinterpret_cast<char*>(&h), sizeof(h));
+        EXPECT_EQ(h.version, SHARD_FILE_VERSION);
+        T r;
+        while (in.read(reinterpret_cast<char*>(&r), sizeof(r))) out.push_back(r);
+    }
+    return out;
+}
+
+std::string freshDir(const char* name) {
+    std::string dir = (std::filesystem::temp_directory_path() / name).string();
+    std::filesystem::remove_all(dir);
+    return dir;
+}
+
+} // namespace
+
+TEST(ShardCompactor, MergesDuplicatesAndDropsForcedDecisions) {
+    std::string in1 = freshDir("bb_compact_in1"), in2 = freshDir("bb_compact_in2");
+    std::string out = freshDir("bb_compact_out"), outCanonical = freshDir("bb_compact_out_canonical");
+    {
+        ShardWriter a(in1);
+        a.appendGame(game({decision(10, 10, 100, {{1, 0.75f}, {2, 0.25f}}),
+                           decision(20, 20, 50, {{1, 1.0f}})}), 1.0f, -1.0f);
+        a.close();
+        ShardWriter b(in2);
+        b.appendGame(game({decision(10, 10, 300, {{2, 0.5f}, {3, 0.5f}}),
+                           decision(11, 10, 80, {{4, 0.6f}, {5, 0.4f}})}), -1.0f, 1.0f);
+        b.close();
+    }
+
+    CompactorStats s = compactShards({in1, in2}, out);
+    EXPECT_EQ(s.decisionsIn, 4u);
+    EXPECT_EQ(s.dropped, 1u);  // hash 20: one action
+    EXPECT_EQ(s.merged, 1u);
+    EXPECT_EQ(s.decisionsOut, 2u);
+    EXPECT_EQ(s.statesOut, 4u);
+    EXPECT_EQ(s.passes, 1);
+
+    auto decisions = readAll<ShardDecisionRecord>(out, "decisions");
+    auto visits = readAll<ShardVisitRecord>(out, "visits");
+    ASSERT_EQ(decisions.size(), 2u);
+    EXPECT_EQ(readAll<ShardStateRecord>(out, "states").size(), 4u);
+    const ShardDecisionRecord& merged = decisions[0].stateHash == 10 ? decisions[0] : decisions[1];
+    EXPECT_EQ(merged.samples, 2u);
+    EXPECT_FLOAT_EQ(merged.visitWeight, 400.0f);
+    EXPECT_FLOAT_EQ(merged.outcome, 0.0f);
+    ASSERT_EQ(merged.numVisits, 3u);
+    // Weighted 1:3 and sorted: action 2 0.4375, action 3 0.375, action 1 0.1875
+    const ShardVisitRecord* v = visits.data() + merged.firstVisit;
+    EXPECT_EQ(v[0].actionFeatures[0], 2.0f);
+    EXPECT_FLOAT_EQ(v[0].visitFraction, 0.4375f);
+    EXPECT_EQ(v[1].actionFeatures[0], 3.0f);
+    EXPECT_FLOAT_EQ(v[1].visitFraction, 0.375f);
+    EXPECT_EQ(v[2].actionFeatures[0], 1.0f);
+    EXPECT_FLOAT_EQ(v[2].visitFraction, 0.1875f);
+
+    // Canonical keys fold the mirror image (hash 11) in, outcome only
+    CompactorConfig canonical;
+    canonical.canonical = true;
+    canonical.copyStates = false;
+    s = compactShards({in1, in2}, outCanonical, canonical);
+    EXPECT_EQ(s.merged, 2u);
+    EXPECT_EQ(s.mirrorMerged, 1u);
+    EXPECT_EQ(s.statesOut, 0u);
+    decisions = readAll<ShardDecisionRecord>(outCanonical, "decisions");
+    ASSERT_EQ(decisions.size(), 1u);
+    EXPECT_EQ(decisions[0].samples, 3u);
+    EXPECT_EQ(decisions[0].numVisits, 3u);
+    EXPECT_FLOAT_EQ(decisions[0].outcome, -1.0f / 3.0f);
+
+    EXPECT_THROW(compactShards({in1, out}, out), std::invalid_argument);
+}
+
+TEST(ShardCompactor, PartitionedPassesGiveTheSameGroups) {
+    std::string in = freshDir("bb_compact_many"), one = freshDir("bb_compact_one"), many = freshDir("bb_compact_parts");
+    {
+        ShardWriter w(in);
+        for (int g = 0; g < 20; ++g) {
+            std::vector<PolicyDecision> ds;
+            for (int i = 0; i < 30; ++i) {
+                uint64_t hash = (g * 7 + i) % 45 + 1;  // plenty of repeats
+                ds.push_back(decision(hash, hash, 10 + i, {{float(i % 3), 0.5f}, {float(3 + g % 2), 0.5f}}));
+            }
+            w.appendGame(game(std::move(ds), 0), g % 2 ? 1.0f : -1.0f, 0.0f);
+        }
+        w.close();
+    }
+    CompactorStats single = compactShards({in}, one);
+    CompactorConfig tight;
+    tight.memoryBytes = 8 << 10;
+    CompactorStats split = compactShards({in}, many, tight);
+    EXPECT_EQ(single.passes, 1);
+    EXPECT_GT(split.passes, 4);
+    EXPECT_EQ(single.decisionsOut, 45u);
+    EXPECT_EQ(split.decisionsOut, single.decisionsOut);
+    EXPECT_EQ(split.merged, single.merged);
+
+    auto byHash = [](const std::string& dir) {
+        std::map<uint64_t, std::pair<uint32_t, float>> out;
+        for (const ShardDecisionRecord& r : readAll<ShardDecisionRecord>(dir, "decisions")) {
+            out[r.stateHash] = {r.samples, r.visitWeight};
+        }
+        return out;
+    };
+    EXPECT_EQ(byHash(one), byHash(many));
+}
@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+#include "bb/simd.h"
+#include <cstdint>
+
+using namespace bb;
+
+TEST(Simd, DotProductMatchesScalarForEveryTailLength) {
+    std::vector<float> a(37), b(37);
+    for (int i = 0; i < 37; ++i) {
+        a[i] = 0.25f * static_cast<float>(i % 7) - 0.5f;
+        b[i] = 0.125f * static_cast<float>((i * 5) % 11) - 0.75f;
+    }
+    for (int n = 0; n <= 37; ++n) {
+        float expected = 0.0f;
+        for (int i = 0; i < n; ++i) expected += a[i] * b[i];
+        EXPECT_NEAR(dotProduct(a.data(), b.data(), n), expected, 1e-4f) << "n=" << n;
+    }
+    // Unaligned starts
+    float expected = 0.0f;
+    for (int i = 0; i < 20; ++i) expected += a[i + 1] * b[i + 3];
+    EXPECT_NEAR(dotProduct(a.data() + 1, b.data() + 3, 20), expected, 1e-4f);
+}
+
+TEST(Simd, AlignedVectorIsAligned) {
+    for (size_t n : {1u, 7u, 93u, 1000u}) {
+        AlignedVector<float> v(n);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data()) % SIMD_ALIGN, 0u);
+    }
+    EXPECT_EQ(simdPadded(0), 0);
+    EXPECT_EQ(simdPadded(1), 8);
+    EXPECT_EQ(simdPadded(70), 72);
+    EXPECT_EQ(simdPadded(72), 72);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "bb/state_arrays.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+#include <cstring>
+#include <tuple>
+#include <vector>
+
+using namespace bb;
+
+TEST(StateArrays, RecordsMatchThePlayersAndBoard) {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getOrcRoster());
+    Player& carrier = state.getPlayer(3);
+    state.ball = BallState::carried(carrier.position, carrier.id);
+    carrier.hasMoved = true;
+    state.getPlayer(14).state = PlayerState::PRONE;
+    state.homeTeam.score = 2;
+    state.awayTeam.blitzUsedThisTurn = true;
+    state.invalidateOccupancy();
+
+    PlayerRecord players[STATE_PLAYERS];
+    uint8_t board[BOARD_SQUARES];
+    StateRecord record;
+    writeStateArrays(state, players, board, &record);
+
+    int occupied = 0;
+    for (uint8_t id : board) occupied += id != 0;
+    int onPitch = 0;
+    for (int i = 0; i < STATE_PLAYERS; ++i) {
+        const Player& p = state.players[i];
+        const PlayerRecord& r = players[i];
+        EXPECT_EQ(r.id, p.id);
+        EXPECT_EQ(r.team, static_cast<uint8_t>(p.teamSide));
+        EXPECT_EQ(r.state, static_cast<uint8_t>(p.state));
+        EXPECT_EQ(r.strength, p.stats().strength);
+        EXPECT_EQ(r.armour, p.stats().armour);
+        EXPECT_EQ(r.skills[0], p.skills().word(0));
+        EXPECT_EQ(r.skills[1], p.skills().word(1));
+        EXPECT_EQ((r.flags & PlayerRecord::HAS_BALL) != 0, p.id == 3);
+        EXPECT_EQ((r.flags & PlayerRecord::HAS_MOVED) != 0, p.id == 3);
+        if (p.isOnPitch()) {
+            ++onPitch;
+            EXPECT_EQ(board[p.position.y * Position::PITCH_WIDTH + p.position.x], p.id);
+            EXPECT_EQ(state.getPlayerAtPosition(p.position)->id, p.id);
+        }
+    }
+    EXPECT_EQ(occupied, onPitch);
+    EXPECT_EQ(record.homeScore, 2);
+    EXPECT_EQ(record.ballCarrierId, 3);
+    EXPECT_TRUE(record.ballHeld);
+    EXPECT_EQ(record.awayFlags & StateRecord::BLITZ_USED, StateRecord::BLITZ_USED);
+    EXPECT_EQ(record.homeFlags & StateRecord::BLITZ_USED, 0);
+}
+
+TEST(StateArrays, BatchMatchesSingleStatesOnAnyThreadCount) {
+    std::vector<GameState> states(600);
+    for (size_t i = 0; i < states.size(); ++i) {
+        setupHalf(states[i], getHumanRoster(), getOrcRoster());
+        states[i].homeTeam.turnNumber = static_cast<int>(i % 8);
+        states[i].getPlayer(1 + static_cast<int>(i % 11)).state = PlayerState::STUNNED;
+    }
+    std::vector<const GameState*> ptrs;
+    for (const GameState& s : states) ptrs.push_back(&s);
+
+    auto run = [&](int threads) {
+        std::vector<PlayerRecord> players(states.size() * STATE_PLAYERS);
+        std::vector<uint8_t> board(states.size() * BOARD_SQUARES);
+        std::vector<StateRecord> records(states.size());
+        writeStateArrays(ptrs.data(), ptrs.size(), players.data(), board.data(), records.data(), threads);
+        return std::make_tuple(players, board, records);
+    };
+    auto [players, board, records] = run(1);
+    auto [players4, board4, records4] = run(4);
+    EXPECT_EQ(board, board4);
+    ASSERT_EQ(players.size(), players4.size());
+    EXPECT_EQ(0, std::memcmp(players.data(), players4.data(), players.size() * sizeof(PlayerRecord)));
+    EXPECT_EQ(0, std::memcmp(records.data(), records4.data(), records.size() * sizeof(StateRecord)));
+
+    PlayerRecord single[STATE_PLAYERS];
+    uint8_t singleBoard[BOARD_SQUARES];
+    StateRecord singleRecord;
+    writeStateArrays(states[599], single, singleBoard, &singleRecord);
+    EXPECT_EQ(0, std::memcmp(single, &players[599 * STATE_PLAYERS], sizeof(single)));
+    EXPECT_EQ(singleRecord.homeTurn, 599 % 8);
+    EXPECT_EQ(players[599 * STATE_PLAYERS + 599 % 11].state, static_cast<uint8_t>(PlayerState::STUNNED));
+}
@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include "bb/state_io.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+#include <cstdio>
+#include <nlohmann/json.hpp>
+
+using namespace bb;
+
+namespace {
+
+GameState midGameState() {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getOrcRoster());
+    DiceRoller dice(5);
+    simpleKickoff(state, dice);
+    state.homeTeam.score = 1;
+    state.homeTeam.blitzUsedThisTurn = true;
+    state.awayTeam.rerolls = 2;
+    state.currentActivationId = 3;
+    state.weather = Weather::POURING_RAIN;
+    Player& p = state.getPlayer(3);
+    p.hasMoved = true;
+    p.movementRemaining = 2;
+    state.setLostTacklezones(state.getPlayer(14), true);
+    return state;
+}
+
+void expectSameState(const GameState& loaded, const GameState& state) {
+    EXPECT_EQ(loaded.hash(), state.hash());
+    EXPECT_EQ(loaded.phase, state.phase);
+    EXPECT_EQ(loaded.weather, Weather::POURING_RAIN);
+    EXPECT_EQ(loaded.currentActivationId, 3);
+    EXPECT_EQ(loaded.kickingTeam, state.kickingTeam);
+    EXPECT_EQ(loaded.awayTeam.rerolls, 2);
+    EXPECT_TRUE(loaded.homeTeam.blitzUsedThisTurn);
+    EXPECT_EQ(loaded.ball.position, state.ball.position);
+    EXPECT_EQ(loaded.ball.isHeld, state.ball.isHeld);
+    for (int id = 1; id <= 22; ++id) {
+        const Player& a = state.getPlayer(id);
+        const Player& b = loaded.getPlayer(id);
+        EXPECT_EQ(b.state, a.state) << id;
+        EXPECT_EQ(b.position, a.position) << id;
+        EXPECT_EQ(b.stats().movement, a.stats().movement) << id;
+        EXPECT_EQ(b.stats().armour, a.stats().armour) << id;
+        EXPECT_TRUE(b.skills() == a.skills()) << id;
+        EXPECT_EQ(b.movementRemaining, a.movementRemaining) << id;
+        EXPECT_EQ(b.hasMoved, a.hasMoved) << id;
+        EXPECT_EQ(b.lostTacklezones, a.lostTacklezones) << id;
+    }
+    // Indexes are rebuilt from the loaded players
+    EXPECT_TRUE(loaded.occupancyConsistent());
+    EXPECT_EQ(loaded.tacklezoneCount(TeamSide::AWAY, {13, 7}),
+              state.tacklezoneCount(TeamSide::AWAY, {13, 7}));
+}
+
+// midGameState with the ball in the first on-pitch player's hands.
+GameState carrierState() {
+    GameState state = midGameState();
+    for (const Player& p : state.players) {
+        if (p.isOnPitch() && p.position.isOnPitch()) {
+            state.ball = BallState::carried(p.position, p.id);
+            break;
+        }
+    }
+    return state;
+}
+
+} // anonymous namespace
+
+TEST(StateIO, RoundTripPreservesEveryField) {
+    GameState state = midGameState();
+    expectSameState(stateFromJson(stateToJson(state)), state);
+}
+
+TEST(StateIO, FileRoundTrip) {
+    GameState state = midGameState();
+    std::string path = ::testing::TempDir() + "bb_state_io_test.json";
+    ASSERT_TRUE(saveState(state, path));
+    auto loaded = loadState(path);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->hash(), state.hash());
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(loadState(path).has_value());
+}
+
+TEST(StateIO, RejectsMalformedInput) {
+    EXPECT_THROW(stateFromJson("{"), nlohmann::json::exception);
+    EXPECT_THROW(stateFromJson(R"({"version": 1})"), nlohmann::json::exception);
+    EXPECT_THROW(stateFromJson(R"({"version": 99})"), nlohmann::json::exception);
+}
+
+TEST(StateIO, RejectsStatesTheEngineCannotHold) {
+    GameState state = carrierState();
+    ASSERT_TRUE(state.ball.isHeld);
+    const nlohmann::json good = nlohmann::json::parse(stateToJson(state));
+    auto load = [](const nlohmann::json& j) { return stateFromJson(j.dump()); };
+    ASSERT_NO_THROW(load(good));
+
+    auto player = [](nlohmann::json& j, int id) -> nlohmann::json& {
+        for (nlohmann::json& p : j["players"]) {
+            if (p["id"] == id) return p;
+        }
+        throw std::out_of_range("no such player");
+    };
+    auto broken = [&](auto edit) {
+        nlohmann::json j = good;
+        edit(j);
+        return j;
+    };
+    EXPECT_THROW(load(broken([&](nlohmann::json& j) { player(j, 3)["skills"].push_back(200); })),
+                 nlohmann::json::exception);
+    EXPECT_THROW(load(broken([&](nlohmann::json& j) {
+                     player(j, 3)["skills"].push_back(static_cast<int>(SkillName::SKILL_COUNT));
+                 })),
+                 nlohmann::json::exception);
+    EXPECT_THROW(load(broken([&](nlohmann::json& j) { player(j, 3)["skills"].push_back(-1); })),
+                 nlohmann::json::exception);
+    EXPECT_THROW(load(broken([&](nlohmann::json& j) { player(j, 3)["state"] = 8; })),
+                 nlohmann::json::exception);
+    EXPECT_THROW(load(broken([](nlohmann::json& j) { j["phase"] = 7; })), nlohmann::json::exception);
+    EXPECT_THROW(load(broken([](nlohmann::json& j) { j["activeTeam"] = 2; })), nlohmann::json::exception);
+    EXPECT_THROW(load(broken([](nlohmann::json& j) { j["kickingTeam"] = 255; })), nlohmann::json::exception);
+    EXPECT_THROW(load(broken([](nlohmann::json& j) { j["weather"] = 5; })), nlohmann::json::exception);
+    EXPECT_THROW(load(broken([](nlohmann::json& j) { j["receiverSpeed"] = 3; })), nlohmann::json::exception);
+    EXPECT_THROW(load(broken([](nlohmann::json& j) { j["currentActivationId"] = 23; })),
+                 nlohmann::json::exception);
+    EXPECT_THROW(load(broken([](nlohmann::json& j) { j["ball"]["carrierId"] = 0; })),
+                 nlohmann::json::exception);
+    EXPECT_THROW(load(broken([](nlohmann::json& j) { j["ball"]["carrierId"] = 23; })),
+                 nlohmann::json::exception);
+
+    // The carrier must be on the pitch, on the ball's square
+    int carrier = state.ball.carrierId;
+    EXPECT_THROW(load(broken([&](nlohmann::json& j) { player(j, carrier)["state"] = 3; })),  // KO
+                 nlohmann::json::exception);
+    EXPECT_THROW(load(broken([&](nlohmann::json& j) {
+                     int other = carrier == 1 ? 2 : 1;
+                     j["ball"]["carrierId"] = other;
+                 })),
+                 nlohmann::json::exception);
+
+    // Two players on one square
+    EXPECT_THROW(load(broken([&](nlohmann::json& j) {
+                     nlohmann::json& p = player(j, carrier <= 11 ? 12 : 1);
+                     p["state"] = 0;
+                     p["x"] = state.getPlayer(carrier).position.x;
+                     p["y"] = state.getPlayer(carrier).position.y;
+                 })),
+                 nlohmann::json::exception);
+}
+
+TEST(StateIO, BinaryRoundTrip) {
+    GameState state = midGameState();
+    std::vector<uint8_t> bytes = serializeState(state);
+    ASSERT_EQ(bytes.size(), STATE_BINARY_SIZE);
+    auto loaded = deserializeState(bytes.data(), bytes.size());
+    ASSERT_TRUE(loaded.has_value());
+    expectSameState(*loaded, state);
+
+    // loadState tells the formats apart
+    std::string path = ::testing::TempDir() + "bb_state_io_test.bbs";
+    ASSERT_TRUE(saveStateBinary(state, path));
+    auto fromFile = loadState(path);
+    ASSERT_TRUE(fromFile.has_value());
+    EXPECT_EQ(fromFile->hash(), state.hash());
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(deserializeState(bytes.data(), bytes.size() - 1).has_value());
+    bytes[4] = 99;  // version
+    EXPECT_FALSE(deserializeState(bytes.data(), bytes.size()).has_value());
+}
+
+TEST(StateIO, BinaryRejectsStatesTheEngineCannotHold) {
+    GameState state = carrierState();
+    ASSERT_TRUE(state.ball.isHeld);
+    const std::vector<uint8_t> good = serializeState(state);
+    ASSERT_TRUE(deserializeState(good.data(), good.size()).has_value());
+
+    // Offsets into the record: the header, then 32 bytes per player slot
+    constexpr size_t PHASE = 9, ACTIVE_TEAM = 10, KICKING_TEAM = 13, WEATHER = 14;
+    constexpr size_t BALL_CARRIER = 35, PLAYERS = 40;
+    constexpr size_t SKILLS = 0, SIDE = 17, STATE = 18;
+    auto rejects = [&](size_t offset, uint8_t value) {
+        std::vector<uint8_t> bytes = good;
+        bytes[offset] = value;
+        return !deserializeState(bytes.data(), bytes.size()).has_value();
+    };
+    EXPECT_FALSE(rejects(PLAYERS + SIDE, 0));  // unchanged
+    EXPECT_TRUE(rejects(PHASE, 7));
+    EXPECT_TRUE(rejects(ACTIVE_TEAM, 2));
+    EXPECT_TRUE(rejects(KICKING_TEAM, 255));
+    EXPECT_TRUE(rejects(WEATHER, 5));
+    EXPECT_TRUE(rejects(PLAYERS + SIDE, 2));            // past the enum
+    EXPECT_TRUE(rejects(PLAYERS + SIDE, 1));            // AWAY in a HOME slot
+    EXPECT_TRUE(rejects(PLAYERS + 32 * 11 + SIDE, 0));  // HOME in an AWAY slot
+    EXPECT_TRUE(rejects(PLAYERS + STATE, 8));
+    EXPECT_TRUE(rejects(PLAYERS + SKILLS + 15, 0x80));  // skill bit 127
+    EXPECT_TRUE(rejects(BALL_CARRIER, 23));
+    EXPECT_TRUE(rejects(BALL_CARRIER, static_cast<uint8_t>(state.ball.carrierId == 1 ? 2 : 1)));
+}
+
+TEST(StateIO, DiceStateRoundTrip) {
+    auto check = [](DiceRollerBase& a, DiceRollerBase& b) {
+        for (int i = 0; i < 37; ++i) a.rollD6();
+        std::vector<uint8_t> saved = serializeDice(a);
+        ASSERT_FALSE(saved.empty());
+        ASSERT_TRUE(deserializeDice(b, saved.data(), saved.size()));
+        for (int i = 0; i < 5000; ++i) {
+            ASSERT_EQ(a.rollD6(), b.rollD6()) << i;
+            ASSERT_EQ(a.rollD8(), b.rollD8()) << i;
+        }
+    };
+    DiceRoller mt(7), mtCopy(8);
+    check(mt, mtCopy);
+    FastDiceRoller fast(7), fastCopy(8);
+    check(fast, fastCopy);
+    BufferedDiceRoller buffered(7), bufferedCopy(8);
+    check(buffered, bufferedCopy);
+
+    // Only into the same kind of roller, and only whole
+    std::vector<uint8_t> saved = serializeDice(fast);
+    EXPECT_FALSE(deserializeDice(mt, saved.data(), saved.size()));
+    EXPECT_FALSE(deserializeDice(fastCopy, saved.data(), saved.size() - 1));
+    FixedDiceRoller fixed({1, 2, 3});
+    EXPECT_TRUE(serializeDice(fixed).empty());
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "bb/strength_bench.h"
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+
+using namespace bb;
+
+TEST(StrengthBench, ReferencePositionsOfferTheirAcceptedMacros) {
+    std::vector<BenchPosition> positions = referencePositions();
+    ASSERT_GE(positions.size(), 6u);
+    for (const BenchPosition& p : positions) {
+        ASSERT_FALSE(p.accept.empty()) << p.name;
+        std::vector<Macro> macros;
+        getAvailableMacros(p.state, macros);
+        bool offered = false;
+        for (const Macro& m : macros) offered |= solvesPosition(p, m);
+        EXPECT_TRUE(offered) << p.name;
+        // END_TURN is never the answer
+        EXPECT_FALSE(solvesPosition(p, Macro{})) << p.name;
+    }
+}
+
+TEST(StrengthBench, SuiteRoundTripsThroughJson) {
+    std::vector<BenchPosition> positions = referencePositions();
+    std::string path = (std::filesystem::temp_directory_path() / "bb_strength_suite.json").string();
+    ASSERT_TRUE(savePositionSuite(positions, path));
+    std::vector<BenchPosition> read = loadPositionSuite(path);
+    std::remove(path.c_str());
+    ASSERT_EQ(read.size(), positions.size());
+    for (size_t i = 0; i < read.size(); ++i) {
+        EXPECT_EQ(read[i].name, positions[i].name);
+        EXPECT_EQ(read[i].category, positions[i].category);
+        EXPECT_EQ(read[i].state.hash(), positions[i].state.hash());
+        ASSERT_EQ(read[i].accept.size(), positions[i].accept.size());
+        for (size_t a = 0; a < read[i].accept.size(); ++a) {
+            EXPECT_EQ(read[i].accept[a].type, positions[i].accept[a].type);
+            EXPECT_EQ(read[i].accept[a].playerId, positions[i].accept[a].playerId);
+            EXPECT_EQ(read[i].accept[a].targetId, positions[i].accept[a].targetId);
+        }
+    }
+    EXPECT_TRUE(loadPositionSuite(path).empty());
+    EXPECT_THROW(parsePositionSuite(R"({"positions": [{"name": "x", "accept": [{"macro": "NAP"}], "state": {}}]})"),
+                 std::exception);
+}
+
+TEST(StrengthBench, RowsCountEveryPositionAndGame) {
+    StrengthBenchConfig config;
+    config.search.explorationC = 1.0;
+    config.opponent.timeBudgetMs = 0;
+    config.opponent.maxIterations = 10;
+    config.budgets = {{20, 0}, {400, 0}};
+    config.positionSeeds = 2;
+    config.matchPairs = 1;
+    config.threads = 4;
+    std::vector<StrengthRow> rows = runStrengthBench(config);
+    ASSERT_EQ(rows.size(), 2u);
+    const int searches = static_cast<int>(referencePositions().size()) * 2;
+    for (const StrengthRow& r : rows) {
+        EXPECT_EQ(r.searches, searches);
+        EXPECT_DOUBLE_EQ(r.accuracy, static_cast<double>(r.solved) / searches);
+        EXPECT_EQ(r.categoryAccuracy.size(), 4u);
+        EXPECT_EQ(r.games, 2);
+        EXPECT_EQ(r.wins + r.draws + r.losses, 2);
+        EXPECT_LE(r.gameSearchIterations, r.budget.iterations);
+        EXPECT_GT(r.cpuSeconds, 0.0);
+    }
+    EXPECT_LE(rows[0].positionIterations, 20.0);
+    EXPECT_GT(rows[1].positionIterations, rows[0].positionIterations);
+    // The reference positions are easy at a few hundred iterations
+    EXPECT_GE(rows[1].accuracy, 0.75);
+
+    // Counts do not depend on the thread count
+    config.threads = 1;
+    config.budgets = {{400, 0}};
+    std::vector<StrengthRow> serial = runStrengthBench(config);
+    EXPECT_EQ(serial[0].solved, rows[1].solved);
+    EXPECT_EQ(serial[0].wins, rows[1].wins);
+    EXPECT_DOUBLE_EQ(serial[0].scoreDiff, rows[1].scoreDiff);
+
+    config.budgets = {{0, 0}};
+    EXPECT_THROW(runStrengthBench(config), std::invalid_argument);
+}
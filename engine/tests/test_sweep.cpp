@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "bb/sweep.h"
+
+using namespace bb;
+
+TEST(Sweep, GridIsTheProductFirstAxisSlowest) {
+    MCTSConfig base;
+    base.maxIterations = 7;
+    std::vector<MCTSConfig> cells = expandGrid(base, {{"explorationC", {0.5, 1.0, 2.0}},
+                                                      {"leafLookahead", {0, 1}}});
+    ASSERT_EQ(cells.size(), 6u);
+    EXPECT_DOUBLE_EQ(cells[0].explorationC, 0.5);
+    EXPECT_FALSE(cells[0].leafLookahead);
+    EXPECT_TRUE(cells[1].leafLookahead);
+    EXPECT_DOUBLE_EQ(cells[2].explorationC, 1.0);
+    EXPECT_DOUBLE_EQ(cells[5].explorationC, 2.0);
+    for (const MCTSConfig& c : cells) EXPECT_EQ(c.maxIterations, 7);
+    EXPECT_EQ(expandGrid(base, {}).size(), 1u);
+
+    EXPECT_FALSE(setSearchParameter(base, "noSuchField", 1.0));
+    EXPECT_THROW(expandGrid(base, {{"noSuchField", {1.0}}}), std::invalid_argument);
+    EXPECT_THROW(expandGrid(base, {{"explorationC", {}}}), std::invalid_argument);
+}
+
+TEST(Sweep, ResultsDoNotDependOnThreads) {
+    MCTSConfig base;
+    base.timeBudgetMs = 0;
+    base.maxIterations = 16;
+    std::vector<MCTSConfig> cells = expandGrid(base, {{"explorationC", {0.5, 2.0}}});
+    SweepConfig config;
+    config.seeds = {11, 12};
+
+    config.threads = 1;
+    std::vector<SweepCellResult> serial = runSweep(cells, config);
+    config.threads = 3;
+    std::vector<SweepCellResult> parallel = runSweep(cells, config);
+
+    ASSERT_EQ(serial.size(), 2u);
+    ASSERT_EQ(parallel.size(), 2u);
+    for (size_t c = 0; c < cells.size(); ++c) {
+        const SweepCellResult& r = parallel[c];
+        EXPECT_EQ(r.games, 2);
+        EXPECT_EQ(r.wins + r.draws + r.losses, 2);
+        EXPECT_EQ(r.wins, serial[c].wins);
+        EXPECT_EQ(r.losses, serial[c].losses);
+        EXPECT_DOUBLE_EQ(r.scoreDiff, serial[c].scoreDiff);
+        EXPECT_EQ(r.decisions, serial[c].decisions);
+        EXPECT_DOUBLE_EQ(r.visitEntropy, serial[c].visitEntropy);
+        EXPECT_GT(r.decisions, 0);
+        EXPECT_GE(r.visitEntropy, 0.0);
+        EXPECT_LE(r.visitEntropy, 1.0 + 1e-9);
+        EXPECT_GT(r.topShare, 0.0);
+        EXPECT_LE(r.topShare, 1.0 + 1e-9);
+        EXPECT_GT(r.iterations, 0.0);
+        EXPECT_LE(r.iterations, 16.0);
+    }
+}
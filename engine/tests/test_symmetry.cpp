@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "bb/symmetry.h"
+#include "bb/dice.h"
+#include "bb/game_simulator.h"
+#include "bb/macro_mcts.h"
+#include "bb/policies.h"
+#include "bb/roster.h"
+#include <algorithm>
+
+using namespace bb;
+
+namespace {
+
+GameState makeOpenPlay() {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getOrcRoster());
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.homeTeam.turnNumber = 1;
+    state.ball = BallState::onGround({16, 3});
+    state.movePlayer(state.getPlayer(3), {10, 2});
+    return state;
+}
+
+bool sameAction(const Action& a, const Action& b) {
+    return a.type == b.type && a.playerId == b.playerId && a.targetId == b.targetId &&
+           a.target == b.target;
+}
+
+} // anonymous namespace
+
+TEST(Symmetry, MirrorIsAnInvolutionWithMatchingHash) {
+    GameState state = makeOpenPlay();
+    Symmetry flip{true};
+    GameState mirror = transformed(state, flip);
+    EXPECT_EQ(mirror.getPlayer(3).position, (Position{10, 12}));
+    EXPECT_EQ(mirror.ball.position, (Position{16, 11}));
+    EXPECT_TRUE(mirror.occupancyConsistent());
+    EXPECT_EQ(mirror.getPlayerAtPosition({10, 12}), &mirror.getPlayer(3));
+
+    EXPECT_EQ(mirror.hash(), state.mirroredHash());
+    EXPECT_EQ(mirror.mirroredHash(), state.hash());
+    EXPECT_NE(mirror.hash(), state.hash());
+    EXPECT_EQ(transformed(mirror, flip).hash(), state.hash());
+
+    CanonicalForm a = canonicalize(state);
+    CanonicalForm b = canonicalize(mirror);
+    EXPECT_EQ(a.hash, b.hash);
+    EXPECT_NE(a.toCanonical.flipY, b.toCanonical.flipY);
+    EXPECT_EQ(canonicalHash(state), std::min(state.hash(), mirror.hash()));
+
+    // Off-pitch sentinels stay put
+    EXPECT_EQ(flip.apply(Position{-1, -1}), (Position{-1, -1}));
+
+    // A position that is its own mirror is left unmirrored
+    GameState empty;
+    empty.phase = GamePhase::PLAY;
+    EXPECT_FALSE(canonicalize(empty).toCanonical.flipY);
+}
+
+TEST(Symmetry, MovesCorrespondSquareForSquare) {
+    GameState state = makeOpenPlay();
+    Symmetry flip{true};
+    GameState mirror = transformed(state, flip);
+    std::vector<Action> actions, mirrored;
+    getAvailableActions(state, actions);
+    getAvailableActions(mirror, mirrored);
+    ASSERT_EQ(actions.size(), mirrored.size());
+    for (const Action& a : actions) {
+        Action image = flip.apply(a);
+        EXPECT_TRUE(std::any_of(mirrored.begin(), mirrored.end(),
+                                [&](const Action& m) { return sameAction(m, image); }));
+    }
+}
+
+TEST(Symmetry, MirrorPositionsShareCacheEntries) {
+    GameState state = makeOpenPlay();
+    GameState mirror = transformed(state, Symmetry{true});
+
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 100;
+    config.priorCacheMB = 16;
+    config.ttMemoryMB = 1;
+    MacroMCTSSearch plain(nullptr, config, 42);
+    config.symmetricCaches = true;
+    MacroMCTSSearch symmetric(nullptr, config, 42);
+
+    plain.search(state);
+    symmetric.search(state);
+    plain.search(mirror);
+    symmetric.search(mirror);
+    EXPECT_GT(symmetric.lastStats().priorCacheHits, plain.lastStats().priorCacheHits);
+
+    // A hit hands back macros in the mirror's own orientation
+    MacroList legal;
+    getAvailableMacros(mirror, legal);
+    for (const MacroChildVisitInfo& cv : symmetric.lastChildVisits()) {
+        EXPECT_TRUE(std::any_of(legal.begin(), legal.end(), [&](const Macro& m) {
+            return m.type == cv.macro.type && m.playerId == cv.macro.playerId &&
+                   m.targetId == cv.macro.targetId && m.targetPos == cv.macro.targetPos;
+        })) << macroTypeName(cv.macro.type) << " " << cv.macro.playerId;
+    }
+}
+
+TEST(Symmetry, PoliciesLogMirroredTwins) {
+    GameState state = makeOpenPlay();
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 50;
+    MacroMCTSPolicy policy(nullptr, config, 7);
+    policy.setLogDecisions(true, 5, true, true);
+    policy(state);
+
+    const std::vector<PolicyDecision>& decisions = policy.decisions();
+    ASSERT_EQ(decisions.size(), 2u);
+    const PolicyDecision& plain = decisions[0];
+    const PolicyDecision& twin = decisions[1];
+    EXPECT_FALSE(plain.mirrored);
+    EXPECT_TRUE(twin.mirrored);
+    EXPECT_EQ(twin.stateHash, state.mirroredHash());
+    ASSERT_EQ(plain.visits.size(), twin.visits.size());
+    for (size_t i = 0; i < plain.visits.size(); ++i) {
+        EXPECT_EQ(plain.visits[i].visitFraction, twin.visits[i].visitFraction);
+    }
+    for (int i = 0; i < plain.board.numPlayers(); ++i) {
+        const CompactPlayerSnapshot& a = plain.board.players[i];
+        const CompactPlayerSnapshot& b = twin.board.players[i];
+        if (a.x >= 0) EXPECT_EQ(b.y, Position::PITCH_HEIGHT - 1 - a.y);
+    }
+    EXPECT_EQ(twin.board.ballY, Position::PITCH_HEIGHT - 1 - plain.board.ballY);
+}
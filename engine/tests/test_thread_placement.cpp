@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "bb/thread_placement.h"
+#include "bb/worker_pool.h"
+#include <atomic>
+#include <mutex>
+#include <set>
+
+using namespace bb;
+
+namespace {
+
+CpuTopology twoNodes() {
+    CpuTopology topology;
+    topology.nodes = {{0, 1, 2, 3}, {4, 5, 6, 7}};
+    return topology;
+}
+
+// Restores the process-wide mode when a test ends
+struct AffinityScope {
+    explicit AffinityScope(AffinityMode mode) : saved(threadAffinity()) { setThreadAffinity(mode); }
+    ~AffinityScope() { setThreadAffinity(saved); }
+    AffinityMode saved;
+};
+
+} // anonymous namespace
+
+TEST(ThreadPlacement, ParsesCpuLists) {
+    EXPECT_EQ(parseCpuList("0-3,8,10-11"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(parseCpuList("5"), (std::vector<int>{5}));
+    EXPECT_EQ(parseCpuList("2,0-1,1"), (std::vector<int>{0, 1, 2}));
+    EXPECT_TRUE(parseCpuList("").empty());
+    EXPECT_TRUE(parseCpuList("3-1").empty());
+    EXPECT_TRUE(parseCpuList("a-b").empty());
+
+    AffinityMode mode = AffinityMode::NONE;
+    EXPECT_TRUE(parseAffinityMode("spread", mode));
+    EXPECT_EQ(mode, AffinityMode::SPREAD);
+    EXPECT_STREQ(affinityModeName(mode), "spread");
+    EXPECT_FALSE(parseAffinityMode("scatter", mode));
+    EXPECT_EQ(mode, AffinityMode::SPREAD);
+}
+
+TEST(ThreadPlacement, PlacesWorkersOverNodes) {
+    CpuTopology topology = twoNodes();
+    EXPECT_EQ(topology.cpus(), 8);
+    EXPECT_EQ(topology.nodeOf(5), 1);
+    EXPECT_EQ(topology.nodeOf(9), -1);
+
+    // Compact fills node 0 first; spread alternates between the nodes
+    std::vector<int> compact, spread;
+    for (int w = 0; w < 8; ++w) {
+        compact.push_back(placeWorker(w, AffinityMode::COMPACT, topology));
+        spread.push_back(placeWorker(w, AffinityMode::SPREAD, topology));
+    }
+    EXPECT_EQ(compact, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+    EXPECT_EQ(spread, (std::vector<int>{0, 4, 1, 5, 2, 6, 3, 7}));
+    EXPECT_EQ(placeWorker(9, AffinityMode::SPREAD, topology), 4);  // wraps around
+    EXPECT_EQ(placeWorker(0, AffinityMode::NONE, topology), -1);
+
+    // Uneven nodes: the smaller one drops out of later rounds
+    topology.nodes = {{0}, {1, 2, 3}};
+    EXPECT_EQ(placeWorker(1, AffinityMode::SPREAD, topology), 1);
+    EXPECT_EQ(placeWorker(2, AffinityMode::SPREAD, topology), 2);
+    EXPECT_EQ(placeWorker(3, AffinityMode::SPREAD, topology), 3);
+}
+
+TEST(ThreadPlacement, SystemTopologyListsTheAllowedCpus) {
+    const CpuTopology& topology = CpuTopology::system();
+    ASSERT_FALSE(topology.nodes.empty());
+    EXPECT_GT(topology.cpus(), 0);
+    for (const auto& node : topology.nodes) EXPECT_FALSE(node.empty());
+}
+
+TEST(ThreadPlacement, RunsEveryWorkerWithPlacement) {
+    for (AffinityMode mode : {AffinityMode::NONE, AffinityMode::COMPACT, AffinityMode::SPREAD}) {
+        AffinityScope scope(mode);
+        std::mutex m;
+        std::set<int> seen;
+        std::atomic<int> onNode{0};
+        runWorkers(5, [&](int worker) {
+            if (currentNode(CpuTopology::system()) >= 0) onNode++;
+            std::lock_guard<std::mutex> lock(m);
+            seen.insert(worker);
+        });
+        EXPECT_EQ(seen, (std::set<int>{0, 1, 2, 3, 4})) << affinityModeName(mode);
+        EXPECT_EQ(onNode.load(), 5);
+
+        // Search helpers created under the mode still run every task
+        WorkerPool pool(2);
+        std::atomic<int> ran{0};
+        pool.run(16, [&](int, int) { ran++; });
+        EXPECT_EQ(ran.load(), 16);
+    }
+}
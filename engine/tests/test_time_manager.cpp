@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "bb/time_manager.h"
+#include "bb/macro_mcts.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+
+using namespace bb;
+
+namespace {
+
+GameState makeTurnState(int half, int turn, int ownScore = 0, int oppScore = 0) {
+    GameState state;
+    setupHalf(state, getHumanRoster(), getHumanRoster());
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.half = half;
+    state.homeTeam.turnNumber = turn;
+    state.homeTeam.score = ownScore;
+    state.awayTeam.score = oppScore;
+    state.ball = BallState::onGround({13, 7});
+    return state;
+}
+
+TimeManager::Config gameBudget(double budget) {
+    TimeManager::Config cfg;
+    cfg.unit = TimeManager::Unit::ITERATIONS;
+    cfg.gameBudget = budget;
+    return cfg;
+}
+
+const std::vector<float> FLAT(10, 0.1f);
+const std::vector<float> PEAKED = {0.91f, 0.01f, 0.01f, 0.01f, 0.01f, 0.01f, 0.01f, 0.01f, 0.01f, 0.01f};
+
+} // anonymous namespace
+
+TEST(TimeManager, ForcedDecisionGetsNothing) {
+    TimeManager tm(gameBudget(10000));
+    EXPECT_EQ(tm.allocate(makeTurnState(1, 1), {1.0f}), 0.0);
+    EXPECT_EQ(tm.allocate(makeTurnState(1, 1), {}), 0.0);
+    EXPECT_EQ(tm.decisions(), 0);
+}
+
+TEST(TimeManager, UndecidedRootsGetMore) {
+    TimeManager flat(gameBudget(10000));
+    TimeManager peaked(gameBudget(10000));
+    TimeManager narrow(gameBudget(10000));
+    GameState state = makeTurnState(1, 3);
+    double wide = flat.allocate(state, FLAT);
+    EXPECT_GT(wide, peaked.allocate(state, PEAKED));
+    EXPECT_GT(wide, narrow.allocate(state, {0.5f, 0.5f}));
+}
+
+TEST(TimeManager, LastTurnMustScoreGetsMore) {
+    // Per-turn budgets: both decisions expect the same number left this turn
+    TimeManager::Config cfg;
+    cfg.turnBudget = 1000;
+    TimeManager early(cfg);
+    TimeManager late(cfg);
+    TimeManager leading(cfg);
+    double mid = early.allocate(makeTurnState(1, 4), FLAT);
+    double mustScore = late.allocate(makeTurnState(2, 8, 0, 1), FLAT);
+    EXPECT_GT(mustScore, 2.0 * mid);
+    EXPECT_GT(mustScore, leading.allocate(makeTurnState(2, 8, 3, 0), FLAT));
+}
+
+TEST(TimeManager, GameBudgetIsNotOverspent) {
+    TimeManager tm(gameBudget(5000));
+    for (int half = 1; half <= 2; ++half) {
+        for (int turn = 1; turn <= 8; ++turn) {
+            GameState state = makeTurnState(half, turn);
+            for (int d = 0; d < 6; ++d) {
+                double budget = tm.allocate(state, FLAT);
+                EXPECT_GE(budget, tm.config().minAllocation);
+                tm.spend(budget);
+            }
+        }
+    }
+    EXPECT_EQ(tm.decisions(), 96);
+    // Only the minimum allocation may run over once the budget is gone
+    EXPECT_LE(tm.spent(), 5000.0 + 96 * tm.config().minAllocation);
+    EXPECT_GT(tm.spent(), 4000.0);
+}
+
+TEST(TimeManager, TurnBudgetResetsEachTurn) {
+    TimeManager::Config cfg;
+    cfg.turnBudget = 400;
+    TimeManager tm(cfg);
+    EXPECT_GT(tm.allocate(makeTurnState(1, 1), FLAT), cfg.minAllocation);
+    tm.spend(400);
+    EXPECT_EQ(tm.remaining(), 0.0);
+    EXPECT_EQ(tm.allocate(makeTurnState(1, 1), FLAT), cfg.minAllocation);
+    EXPECT_GT(tm.allocate(makeTurnState(1, 2), FLAT), cfg.minAllocation);
+    EXPECT_EQ(tm.remaining(), 400.0);
+}
+
+TEST(TimeManager, EarlierTurnStartsNewGame) {
+    TimeManager tm(gameBudget(1000));
+    tm.allocate(makeTurnState(2, 5), FLAT);
+    tm.spend(600);
+    EXPECT_EQ(tm.remaining(), 400.0);
+    tm.allocate(makeTurnState(1, 1), FLAT);
+    EXPECT_EQ(tm.decisions(), 1);
+    EXPECT_EQ(tm.remaining(), 1000.0);
+}
+
+TEST(TimeManager, SizesMacroPolicySearches) {
+    MCTSConfig config;
+    config.timeBudgetMs = 0;
+    config.maxIterations = 300;
+    MacroMCTSPolicy policy(nullptr, config, 42);
+    TimeManager tm(gameBudget(2000));
+    policy.setTimeManager(&tm);
+
+    GameState state = makeTurnState(1, 1);
+    policy(state);
+    EXPECT_EQ(tm.decisions(), 1);
+    EXPECT_GT(policy.lastIterations(), 0);
+    EXPECT_LT(policy.lastIterations(), 300);
+    EXPECT_EQ(tm.spent(), policy.lastIterations());
+}
+
+TEST(TimeManager, SimulateGameReportsPolicyTime) {
+    DiceRoller dice(7);
+    ActionSelector greedy = [&](const GameState& s) { return greedyPolicy(s, dice); };
+    GameResult result = simulateGame(getHumanRoster(), getOrcRoster(), greedy, greedy, dice);
+    EXPECT_GT(result.homePolicyMs, 0.0);
+    EXPECT_GT(result.awayPolicyMs, 0.0);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "bb/tournament.h"
+#include "bb/roster.h"
+#include <set>
+
+using namespace bb;
+
+TEST(Tournament, StoppingStatistics) {
+    // Even scores lean to H0, strong ones to H1
+    EXPECT_LT(sprtLlr(100, 50.0, 30.0, 0.0, 35.0), 0.0);
+    EXPECT_GT(sprtLlr(100, 80.0, 70.0, 0.0, 35.0), 0.0);
+    EXPECT_EQ(sprtLlr(0, 0.0, 0.0, 0.0, 35.0), 0.0);
+    // Uniform wins have no variance but still accept H1
+    EXPECT_GT(sprtLlr(10, 10.0, 10.0, 0.0, 35.0), std::log(0.95 / 0.05));
+
+    double lo, hi;
+    wilsonInterval(0.5, 100, 1.96, lo, hi);
+    EXPECT_NEAR(lo, 0.404, 1e-3);
+    EXPECT_NEAR(hi, 0.596, 1e-3);
+    wilsonInterval(1.0, 20, 1.96, lo, hi);
+    EXPECT_GT(lo, 0.8);
+    EXPECT_DOUBLE_EQ(hi, 1.0);
+}
+
+TEST(Tournament, SideSwappedPairsAndFixedLength) {
+    PlayerConfig random;
+    TournamentConfig config;
+    config.maxPairs = 3;
+    config.threads = 2;
+    config.stop = StopRule::NONE;
+    config.rosters = {&getHumanRoster(), &getOrcRoster(), &getDwarfRoster()};
+
+    std::vector<TournamentGame> games;
+    MatchResult m = runMatch(random, random, config, [&](const TournamentGame& g) { games.push_back(g); });
+    EXPECT_EQ(m.pairs, 3);
+    EXPECT_EQ(m.wins + m.draws + m.losses, 6);
+    EXPECT_EQ(m.verdict, MatchVerdict::UNDECIDED);
+    ASSERT_EQ(games.size(), 6u);
+    std::set<std::pair<int, bool>> seen;
+    for (const TournamentGame& g : games) {
+        seen.insert({g.pair, g.aIsHome});
+        EXPECT_EQ(g.seed, config.seed + g.pair);
+        EXPECT_STREQ(g.homeRoster, config.rosters[g.pair % 3]->name);
+        EXPECT_STREQ(g.awayRoster, config.rosters[(g.pair + 1) % 3]->name);
+    }
+    EXPECT_EQ(seen.size(), 6u);  // each pair played both ways round
+
+    // Same seed and sides: the B-at-home game is the A-at-home game mirrored
+    PlayerConfig greedy;
+    greedy.ai = "greedy";
+    config.maxPairs = 1;
+    config.threads = 1;
+    games.clear();
+    runMatch(greedy, random, config, [&](const TournamentGame& g) { games.push_back(g); });
+    ASSERT_EQ(games.size(), 2u);
+    GameResult home = playConfiguredGame(getHumanRoster(), getOrcRoster(), greedy, random, config.seed);
+    GameResult away = playConfiguredGame(getHumanRoster(), getOrcRoster(), random, greedy, config.seed);
+    EXPECT_EQ(games[0].scoreA, home.homeScore);
+    EXPECT_EQ(games[1].scoreA, away.awayScore);
+    EXPECT_EQ(games[1].scoreB, away.homeScore);
+}
+
+TEST(Tournament, SprtStopsAClearMismatchEarly) {
+    PlayerConfig greedy, random;
+    greedy.ai = "greedy";
+    TournamentConfig config;
+    config.maxPairs = 200;
+    config.minPairs = 4;
+    config.threads = 3;
+    config.elo1 = 100.0;
+
+    int streamed = 0;
+    std::vector<MatchResult> results = runTournament({greedy, random}, config,
+                                                     [&](const TournamentGame&) { ++streamed; });
+    ASSERT_EQ(results.size(), 1u);
+    const MatchResult& m = results[0];
+    EXPECT_EQ(m.verdict, MatchVerdict::A_STRONGER);
+    EXPECT_LT(m.pairs, 50);
+    EXPECT_GT(m.score, 0.5);
+    EXPECT_GE(streamed, 2 * m.pairs);
+
+    EXPECT_THROW(runMatch(greedy, random, TournamentConfig{0}), std::invalid_argument);
+}
+
+TEST(Tournament, ShardsMergeIntoOneRun) {
+    PlayerConfig greedy, random;
+    greedy.ai = "greedy";
+    TournamentConfig config;
+    config.maxPairs = 8;
+    config.minPairs = 2;
+    config.threads = 3;
+    config.seed = 11;
+    config.elo1 = 100.0;
+    MatchResult whole = runMatch(greedy, random, config);
+
+    // Shards play their pairs whole; the merge replays the stopping rule
+    TournamentConfig shard = config;
+    shard.stop = StopRule::NONE;
+    shard.threads = 2;
+    std::vector<MatchResult> shards;
+    for (int first : {5, 0, 3}) {
+        shard.firstPair = first;
+        shard.maxPairs = first == 0 ? 3 : first == 3 ? 2 : 3;
+        shards.push_back(runMatch(greedy, random, shard));
+        EXPECT_EQ(shards.back().outcomes.front().pair, first);
+    }
+    MatchResult merged = mergeMatches(shards, config);
+    EXPECT_EQ(merged.pairs, whole.pairs);
+    EXPECT_EQ(merged.wins, whole.wins);
+    EXPECT_EQ(merged.draws, whole.draws);
+    EXPECT_EQ(merged.losses, whole.losses);
+    EXPECT_EQ(merged.score, whole.score);
+    EXPECT_EQ(merged.llr, whole.llr);
+    EXPECT_EQ(merged.verdict, whole.verdict);
+    EXPECT_EQ(merged.touchdownsA, whole.touchdownsA);
+    EXPECT_EQ(merged.totalActions, whole.totalActions);
+    EXPECT_EQ(merged.scoreDiff, whole.scoreDiff);
+
+    // Without stopping every pair counts, and the summary round-trips
+    config.stop = StopRule::NONE;
+    merged = mergeMatches(shards, config);
+    EXPECT_EQ(merged.pairs, 8);
+    MatchResult parsed;
+    ASSERT_TRUE(parseMatchSummary(matchSummaryJson(merged), parsed));
+    EXPECT_EQ(parsed.wins, merged.wins);
+    EXPECT_EQ(parsed.scoreDiff, merged.scoreDiff);
+    ASSERT_EQ(parsed.outcomes.size(), 8u);
+    EXPECT_EQ(parsed.outcomes[7].scoreA[1], merged.outcomes[7].scoreA[1]);
+    EXPECT_FALSE(parseMatchSummary("{\"outcomes\": [[0, 1]]}", parsed));
+
+    EXPECT_THROW(mergeMatches({shards[0], shards[0]}, config), std::invalid_argument);
+    EXPECT_THROW(mergeMatches({shards[0], shards[1]}, config), std::invalid_argument);  // 3 and 4 missing
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "bb/training_shards.h"
+#include "bb/roster.h"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <set>
+#include <thread>
+
+using namespace bb;
+
+namespace {
+
+// A played game plus synthetic decisions whose visit counts identify them.
+LoggedGameResult makeGame(uint32_t seed) {
+    DiceRoller dice(seed);
+    auto policy = [&dice](const GameState& s) { return randomPolicy(s, dice); };
+    LoggedGameResult logged = simulateGameLogged(getHumanRoster(), getOrcRoster(),
+                                                 policy, policy, dice);
+    for (int i = 0; i < 3; ++i) {
+        PolicyDecision d{};
+        d.stateFeatures[0] = static_cast<float>(seed);
+        d.perspective = i % 2 ? TeamSide::AWAY : TeamSide::HOME;
+        d.stateHash = seed * 100 + i;
+        for (int v = 0; v <= i; ++v) {
+            PolicyDecision::ActionVisit visit{};
+            visit.actionFeatures[0] = static_cast<float>(d.stateHash);
+            visit.visitFraction = 1.0f / (i + 1);
+            d.visits.push_back(visit);
+        }
+        logged.policyDecisions.push_back(std::move(d));
+    }
+    return logged;
+}
+
+template<typename T>
+std::vector<T> readRecords(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    ShardFileHeader h;
+    in.read(reinterpret_cast<char*>(&h), sizeof(h));
+    EXPECT_EQ(h.magic, SHARD_FILE_MAGIC);
+    EXPECT_EQ(h.recordSize, sizeof(T));
+    std::vector<T> out;
+    T r;
+    while (in.read(reinterpret_cast<char*>(&r), sizeof(r))) out.push_back(r);
+    return out;
+}
+
+std::vector<nlohmann::json> readIndex(const std::string& dir) {
+    std::ifstream in(dir + "/index.jsonl");
+    std::vector<nlohmann::json> entries;
+    std::string line;
+    while (std::getline(in, line)) entries.push_back(nlohmann::json::parse(line));
+    return entries;
+}
+
+} // namespace
+
+TEST(TrainingShards, ConcurrentWritersRollOverAndKeepGamesWhole) {
+    std::string dir = (std::filesystem::temp_directory_path() / "bb_shards_test").string();
+    std::filesystem::remove_all(dir);
+
+    std::vector<LoggedGameResult> games;
+    for (uint32_t s = 1; s <= 8; ++s) games.push_back(makeGame(s));
+    size_t totalStates = 0;
+    for (const auto& g : games) totalStates += g.states.size();
+
+    ShardWriterConfig config;
+    config.maxShardBytes = 64 << 10;  // a few games per shard
+    {
+        ShardWriter writer(dir, config);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                for (size_t g = t; g < games.size(); g += 4) writer.appendGame(games[g], 1.0f, -1.0f);
+            });
+        }
+        for (auto& th : threads) th.join();
+        writer.close();
+        EXPECT_GT(writer.shardsWritten(), 1);
+        EXPECT_THROW(writer.appendGame(games[0], 0.0f, 0.0f), std::runtime_error);
+    }
+
+    std::vector<nlohmann::json> index = readIndex(dir);
+    ASSERT_GT(index.size(), 1u);
+    size_t states = 0, decisions = 0;
+    std::set<uint32_t> gameIds;
+    for (const auto& entry : index) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/shard-%06d.", entry["shard"].get<int>());
+        auto stateRows = readRecords<ShardStateRecord>(dir + name + "states");
+        auto decisionRows = readRecords<ShardDecisionRecord>(dir + name + "decisions");
+        auto visitRows = readRecords<ShardVisitRecord>(dir + name + "visits");
+        EXPECT_EQ(stateRows.size(), entry["states"].get<size_t>());
+        EXPECT_EQ(decisionRows.size(), entry["decisions"].get<size_t>());
+        EXPECT_EQ(visitRows.size(), entry["visits"].get<size_t>());
+        states += stateRows.size();
+        decisions += decisionRows.size();
+
+        for (const ShardStateRecord& r : stateRows) {
+            EXPECT_EQ(r.outcome, r.perspective == 0 ? 1.0f : -1.0f);
+            gameIds.insert(r.game);
+        }
+        // Each decision's visits sit in its own rows of this shard
+        for (const ShardDecisionRecord& r : decisionRows) {
+            ASSERT_LE(r.firstVisit + r.numVisits, visitRows.size());
+            EXPECT_EQ(r.numVisits, r.stateHash % 100 + 1);
+            for (uint32_t v = 0; v < r.numVisits; ++v) {
+                EXPECT_EQ(visitRows[r.firstVisit + v].actionFeatures[0], static_cast<float>(r.stateHash));
+            }
+        }
+    }
+    EXPECT_EQ(states, totalStates);
+    EXPECT_EQ(decisions, 3 * games.size());
+    EXPECT_EQ(gameIds.size(), games.size());
+
+    // A new writer continues the numbering
+    {
+        ShardWriter writer(dir, config);
+        EXPECT_EQ(writer.appendGame(games[0], 0.0f, 0.0f), games.size());
+    }
+    auto resumed = readIndex(dir);
+    ASSERT_EQ(resumed.size(), index.size() + 1);
+    EXPECT_EQ(resumed.back()["shard"].get<int>(), index.back()["shard"].get<int>() + 1);
+    std::filesystem::remove_all(dir);
+}
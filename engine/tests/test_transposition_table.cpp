@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "bb/transposition_table.h"
+
+using namespace bb;
+
+TEST(TranspositionTable, DisabledByDefault) {
+    TranspositionTable tt;
+    EXPECT_FALSE(tt.enabled());
+    tt.update(42, 1.0);
+    TranspositionTable::Stats s;
+    EXPECT_FALSE(tt.probe(42, s));
+}
+
+TEST(TranspositionTable, SizeRoundsDownToPowerOfTwoBuckets) {
+    TranspositionTable tt(64 * 5);
+    EXPECT_EQ(tt.capacity(), 4u * 4);
+    tt.resize(10);  // below one bucket still gets one
+    EXPECT_EQ(tt.capacity(), 4u);
+}
+
+TEST(TranspositionTable, AccumulatesAndCountsHits) {
+    TranspositionTable tt(1 << 16);
+    TranspositionTable::Stats s;
+    EXPECT_FALSE(tt.probe(7, s));
+    tt.update(7, 1.0);
+    tt.update(7, 0.0);
+    tt.update(7, 0.5);
+    ASSERT_TRUE(tt.probe(7, s));
+    EXPECT_EQ(s.visits, 3u);
+    EXPECT_NEAR(s.totalValue, 1.5, 1e-6);
+    EXPECT_EQ(tt.hits(), 1u);
+    EXPECT_EQ(tt.misses(), 1u);
+}
+
+TEST(TranspositionTable, NewSearchAgesEntriesOut) {
+    TranspositionTable tt(1 << 16);
+    tt.update(7, 1.0);
+    tt.newSearch();
+    TranspositionTable::Stats s;
+    EXPECT_FALSE(tt.probe(7, s));
+    tt.update(7, -1.0);
+    ASSERT_TRUE(tt.probe(7, s));
+    EXPECT_EQ(s.visits, 1u);  // old generation's visit not carried over
+}
+
+TEST(TranspositionTable, ReplacesLeastVisitedInFullBucket) {
+    TranspositionTable tt(64);  // one bucket: every key collides
+    for (uint64_t key = 1; key <= 4; ++key) {
+        for (uint64_t v = 0; v < key + 1; ++v) tt.update(key, 0.0);
+    }
+    tt.update(5, 1.0);  // evicts key 1 (2 visits)
+    EXPECT_EQ(tt.evictions(), 1u);
+    TranspositionTable::Stats s;
+    EXPECT_FALSE(tt.probe(1, s));
+    EXPECT_TRUE(tt.probe(2, s));
+    EXPECT_TRUE(tt.probe(5, s));
+}
+
+TEST(TranspositionTable, PrefersStaleGenerationForReplacement) {
+    TranspositionTable tt(64);
+    for (uint64_t key = 1; key <= 4; ++key) tt.update(key, 0.0);
+    tt.newSearch();
+    for (uint64_t key = 5; key <= 8; ++key) tt.update(key, 0.0);
+    EXPECT_EQ(tt.evictions(), 0u);  // stale entries are free slots
+}
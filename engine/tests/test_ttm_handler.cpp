@@ -10,8 +10,8 @@ static void placePlayer(GameState& gs, int id, Position pos, TeamSide side,
     Player& p = gs.getPlayer(id);
     p.state = PlayerState::STANDING;
     p.position = pos;
-    p.stats = {static_cast<int8_t>(ma), static_cast<int8_t>(st),
-               static_cast<int8_t>(ag), static_cast<int8_t>(av)};
+    p.setStats({static_cast<int8_t>(ma), static_cast<int8_t>(st),
+                static_cast<int8_t>(ag), static_cast<int8_t>(av)});
     p.movementRemaining = ma;
 }
 
@@ -20,9 +20,9 @@ TEST(TTMHandler, AccurateLanding) {
     gs.phase = GamePhase::PLAY;
     gs.activeTeam = TeamSide::HOME;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 5, 3, 9); // Thrower
-    gs.getPlayer(1).skills.add(SkillName::ThrowTeamMate);
+    gs.getPlayer(1).addSkill(SkillName::ThrowTeamMate);
     placePlayer(gs, 2, {11, 7}, TeamSide::HOME, 6, 2, 3, 7); // Projectile
-    gs.getPlayer(2).skills.add(SkillName::RightStuff);
+    gs.getPlayer(2).addSkill(SkillName::RightStuff);
 
     Position target{13, 7}; // distance 3 = quick pass
     // AG3: passTarget = 7-3-1(QP) = 3. Roll 5 >= 3 → accurate
@@ -40,10 +40,10 @@ TEST(TTMHandler, AlwaysHungryEat) {
     gs.phase = GamePhase::PLAY;
     gs.activeTeam = TeamSide::HOME;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 5, 3, 9);
-    gs.getPlayer(1).skills.add(SkillName::ThrowTeamMate);
-    gs.getPlayer(1).skills.add(SkillName::AlwaysHungry);
+    gs.getPlayer(1).addSkill(SkillName::ThrowTeamMate);
+    gs.getPlayer(1).addSkill(SkillName::AlwaysHungry);
     placePlayer(gs, 2, {11, 7}, TeamSide::HOME, 6, 2, 3, 7);
-    gs.getPlayer(2).skills.add(SkillName::RightStuff);
+    gs.getPlayer(2).addSkill(SkillName::RightStuff);
 
     // AlwaysHungry: roll 1 → eat. No rerolls available.
     FixedDiceRoller dice({1});
@@ -58,9 +58,9 @@ TEST(TTMHandler, Fumble) {
     gs.phase = GamePhase::PLAY;
     gs.activeTeam = TeamSide::HOME;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 5, 3, 9);
-    gs.getPlayer(1).skills.add(SkillName::ThrowTeamMate);
+    gs.getPlayer(1).addSkill(SkillName::ThrowTeamMate);
     placePlayer(gs, 2, {11, 7}, TeamSide::HOME, 6, 2, 3, 7);
-    gs.getPlayer(2).skills.add(SkillName::RightStuff);
+    gs.getPlayer(2).addSkill(SkillName::RightStuff);
 
     // Accuracy: natural 1 = fumble. Scatter: D8=1 → (11, 6)
     // Landing: 7-3=4. Roll 5 >= 4 → lands OK
@@ -77,9 +77,9 @@ TEST(TTMHandler, InaccurateScatter) {
     gs.phase = GamePhase::PLAY;
     gs.activeTeam = TeamSide::HOME;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 5, 2, 9); // AG2 = hard to pass
-    gs.getPlayer(1).skills.add(SkillName::ThrowTeamMate);
+    gs.getPlayer(1).addSkill(SkillName::ThrowTeamMate);
     placePlayer(gs, 2, {11, 7}, TeamSide::HOME, 6, 2, 3, 7);
-    gs.getPlayer(2).skills.add(SkillName::RightStuff);
+    gs.getPlayer(2).addSkill(SkillName::RightStuff);
 
     // AG2: passTarget = 7-2-1(QP) = 4. Roll 3 < 4 → inaccurate
     // Scatter from target (13,7): D8=5 → (-1,0) → (12,7)
@@ -96,9 +96,9 @@ TEST(TTMHandler, OffPitchTurnover) {
     gs.phase = GamePhase::PLAY;
     gs.activeTeam = TeamSide::HOME;
     placePlayer(gs, 1, {10, 0}, TeamSide::HOME, 6, 5, 3, 9);
-    gs.getPlayer(1).skills.add(SkillName::ThrowTeamMate);
+    gs.getPlayer(1).addSkill(SkillName::ThrowTeamMate);
     placePlayer(gs, 2, {11, 0}, TeamSide::HOME, 6, 2, 3, 7);
-    gs.getPlayer(2).skills.add(SkillName::RightStuff);
+    gs.getPlayer(2).addSkill(SkillName::RightStuff);
 
     // Fumble (roll=1), scatter D8=1 → N(0,-1) → (10,-1) off pitch → crowd surf
     // resolveCrowdSurf: injury roll 2D6 = 3+3=6 → stunned → KO for crowd surf
@@ -112,9 +112,9 @@ TEST(TTMHandler, FailedLanding) {
     gs.phase = GamePhase::PLAY;
     gs.activeTeam = TeamSide::HOME;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 5, 3, 9);
-    gs.getPlayer(1).skills.add(SkillName::ThrowTeamMate);
+    gs.getPlayer(1).addSkill(SkillName::ThrowTeamMate);
     placePlayer(gs, 2, {11, 7}, TeamSide::HOME, 6, 2, 3, 7);
-    gs.getPlayer(2).skills.add(SkillName::RightStuff);
+    gs.getPlayer(2).addSkill(SkillName::RightStuff);
 
     // Accurate pass: roll 5 >= 3. Landing: roll 1 < 4 → failed
     // Prone + armor: 3+3=6 ≤ 7 not broken
@@ -129,9 +129,9 @@ TEST(TTMHandler, BallMovesWithProjectile) {
     gs.phase = GamePhase::PLAY;
     gs.activeTeam = TeamSide::HOME;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 5, 3, 9);
-    gs.getPlayer(1).skills.add(SkillName::ThrowTeamMate);
+    gs.getPlayer(1).addSkill(SkillName::ThrowTeamMate);
     placePlayer(gs, 2, {11, 7}, TeamSide::HOME, 6, 2, 3, 7);
-    gs.getPlayer(2).skills.add(SkillName::RightStuff);
+    gs.getPlayer(2).addSkill(SkillName::RightStuff);
     gs.ball = BallState::carried({11, 7}, 2);
 
     Position target{13, 7};
@@ -149,10 +149,10 @@ TEST(TTMHandler, AlwaysHungryTeamReroll) {
     gs.activeTeam = TeamSide::HOME;
     gs.homeTeam.rerolls = 1;
     placePlayer(gs, 1, {10, 7}, TeamSide::HOME, 6, 5, 3, 9);
-    gs.getPlayer(1).skills.add(SkillName::ThrowTeamMate);
-    gs.getPlayer(1).skills.add(SkillName::AlwaysHungry);
+    gs.getPlayer(1).addSkill(SkillName::ThrowTeamMate);
+    gs.getPlayer(1).addSkill(SkillName::AlwaysHungry);
     placePlayer(gs, 2, {11, 7}, TeamSide::HOME, 6, 2, 3, 7);
-    gs.getPlayer(2).skills.add(SkillName::RightStuff);
+    gs.getPlayer(2).addSkill(SkillName::RightStuff);
 
     // AlwaysHungry: roll 1. Team reroll: roll 4 → success.
     // Pass: roll 5 >= 3. Landing: roll 5 >= 4
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "bb/undo_journal.h"
+#include "bb/action_resolver.h"
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+#include <cstring>
+
+using namespace bb;
+
+namespace {
+
+void expectSameState(const GameState& a, const GameState& b) {
+    EXPECT_EQ(a.half, b.half);
+    EXPECT_EQ(a.phase, b.phase);
+    EXPECT_EQ(a.activeTeam, b.activeTeam);
+    EXPECT_EQ(a.ball.position, b.ball.position);
+    EXPECT_EQ(a.ball.isHeld, b.ball.isHeld);
+    EXPECT_EQ(a.ball.carrierId, b.ball.carrierId);
+    EXPECT_EQ(a.turnoverPending, b.turnoverPending);
+    EXPECT_EQ(a.currentActivationId, b.currentActivationId);
+    EXPECT_EQ(a.kickingTeam, b.kickingTeam);
+    for (TeamSide side : {TeamSide::HOME, TeamSide::AWAY}) {
+        const TeamState& ta = a.getTeamState(side);
+        const TeamState& tb = b.getTeamState(side);
+        EXPECT_EQ(ta.score, tb.score);
+        EXPECT_EQ(ta.rerolls, tb.rerolls);
+        EXPECT_EQ(ta.turnNumber, tb.turnNumber);
+        EXPECT_EQ(ta.rerollUsedThisTurn, tb.rerollUsedThisTurn);
+        EXPECT_EQ(ta.blitzUsedThisTurn, tb.blitzUsedThisTurn);
+        EXPECT_EQ(ta.passUsedThisTurn, tb.passUsedThisTurn);
+        EXPECT_EQ(ta.foulUsedThisTurn, tb.foulUsedThisTurn);
+        EXPECT_EQ(ta.apothecaryUsed, tb.apothecaryUsed);
+    }
+    // Field by field: Player has padding bytes, which memcmp would read.
+    for (size_t i = 0; i < a.players.size(); ++i) {
+        const Player& pa = a.players[i];
+        const Player& pb = b.players[i];
+        EXPECT_TRUE(pa.id == pb.id && pa.teamSide == pb.teamSide && pa.state == pb.state &&
+                    pa.position == pb.position &&
+                    std::memcmp(&pa.stats(), &pb.stats(), sizeof(PlayerStats)) == 0 &&
+                    pa.skills() == pb.skills() && pa.movementRemaining == pb.movementRemaining &&
+                    pa.hasMoved == pb.hasMoved && pa.hasActed == pb.hasActed &&
+                    pa.usedBlitz == pb.usedBlitz && pa.lostTacklezones == pb.lostTacklezones &&
+                    pa.proUsedThisTurn == pb.proUsedThisTurn)
+            << "player slot " << i;
+    }
+    EXPECT_TRUE(a.occupancyConsistent());
+    EXPECT_TRUE(b.occupancyConsistent());
+}
+
+GameState makeKickedOffState(uint32_t seed) {
+    GameState state;
+    DiceRoller dice(seed);
+    setupHalf(state, getHumanRoster(), getOrcRoster(), TeamSide::AWAY);
+    simpleKickoff(state, dice);
+    return state;
+}
+
+} // anonymous namespace
+
+TEST(UndoJournal, EmptyUndoIsNoOp) {
+    GameState gs = makeKickedOffState(1);
+    GameState before = gs.clone();
+    UndoJournal journal;
+    EXPECT_TRUE(journal.empty());
+    journal.undoTo(gs, 0);
+    expectSameState(gs, before);
+}
+
+TEST(UndoJournal, RecordsOnlyChangedPlayers) {
+    GameState gs = makeKickedOffState(2);
+    GameState before = gs.clone();
+    Player& p = gs.getPlayer(3);
+    ASSERT_TRUE(p.isOnPitch());
+
+    Position to{-1, -1};
+    for (auto& apos : p.position.getAdjacent()) {
+        if (apos.isOnPitch() && !gs.getPlayerAtPosition(apos)) { to = apos; break; }
+    }
+    ASSERT_TRUE(to.isOnPitch());
+
+    UndoJournal journal;
+    journal.begin(gs);
+    gs.movePlayer(p, to);
+    p.hasMoved = true;
+    gs.homeTeam.blitzUsedThisTurn = true;
+    gs.ball = BallState::offPitch();
+    journal.end(gs);
+    EXPECT_EQ(journal.mark(), 1u);
+
+    journal.undoTo(gs, 0);
+    EXPECT_TRUE(journal.empty());
+    expectSameState(gs, before);
+}
+
+TEST(UndoJournal, RandomPlayRollsBackToEveryMark) {
+    std::vector<Action> actions;
+    for (uint32_t seed = 1; seed <= 20; ++seed) {
+        GameState gs = makeKickedOffState(seed);
+        DiceRoller dice(seed * 7919);
+        UndoJournal journal;
+
+        std::vector<GameState> snapshots;
+        for (int step = 0; step < 40 && gs.phase == GamePhase::PLAY; ++step) {
+            snapshots.push_back(gs.clone());
+            getAvailableActions(gs, actions);
+            ASSERT_FALSE(actions.empty());
+            const Action& a = actions[dice.rollD6() * 31 % actions.size()];
+            executeActionJournaled(gs, a, dice, journal);
+        }
+        ASSERT_EQ(journal.mark(), snapshots.size());
+
+        // Undo half way, check, then all the way back.
+        size_t half = snapshots.size() / 2;
+        journal.undoTo(gs, half);
+        expectSameState(gs, snapshots[half]);
+        journal.undoTo(gs, 0);
+        expectSameState(gs, snapshots[0]);
+    }
+}
+
+TEST(UndoJournal, ReplayAfterUndoMatchesFreshClone) {
+    // Rolling back and re-executing with the same dice must produce exactly
+    // what a fresh clone would: nothing stale left in the working state.
+    GameState root = makeKickedOffState(5);
+    GameState work = root.clone();
+    UndoJournal journal;
+    std::vector<Action> actions;
+
+    for (int iter = 0; iter < 10; ++iter) {
+        DiceRoller diceA(100 + iter), diceB(100 + iter);
+        GameState fresh = root.clone();
+        for (int step = 0; step < 12 && fresh.phase == GamePhase::PLAY; ++step) {
+            getAvailableActions(fresh, actions);
+            Action a = actions[(step * 5 + iter) % actions.size()];
+            executeAction(fresh, a, diceA, nullptr);
+            executeActionJournaled(work, a, diceB, journal);
+        }
+        expectSameState(work, fresh);
+        journal.undoTo(work, 0);
+        expectSameState(work, root);
+    }
+}
+
+TEST(UndoJournal, AssignJumpsToAnotherStateAndBack) {
+    GameState root = makeKickedOffState(9);
+    GameState target = root.clone();
+    DiceRoller dice(77);
+    std::vector<Action> actions;
+    for (int step = 0; step < 15 && target.phase == GamePhase::PLAY; ++step) {
+        getAvailableActions(target, actions);
+        executeAction(target, actions[(step * 7) % actions.size()], dice, nullptr);
+    }
+
+    GameState work = root.clone();
+    UndoJournal journal;
+    journal.assign(work, target);
+    expectSameState(work, target);
+    EXPECT_EQ(work.hash(), target.hash());
+    journal.undoTo(work, 0);
+    expectSameState(work, root);
+    EXPECT_EQ(work.hash(), root.hash());
+}
+
+TEST(UndoJournal, HandEditsAfterInvalidateOccupancyAreRecorded) {
+    GameState gs = makeKickedOffState(4);
+    GameState before = gs.clone();
+    UndoJournal journal;
+    journal.begin(gs);
+    // Written straight into `players`, past the write barrier
+    gs.players[4].movementRemaining = 0;
+    gs.players[15].hasActed = true;
+    gs.invalidateOccupancy();
+    journal.end(gs);
+    journal.undoTo(gs, 0);
+    expectSameState(gs, before);
+}
+
+TEST(UndoJournal, RandomMacroPlayRollsBackToEveryMark) {
+    MacroList macros;
+    for (uint32_t seed = 1; seed <= 20; ++seed) {
+        GameState gs = makeKickedOffState(seed);
+        DiceRoller dice(seed * 104729);
+        UndoJournal journal;
+
+        std::vector<GameState> snapshots;
+        for (int step = 0; step < 30 && gs.phase == GamePhase::PLAY; ++step) {
+            snapshots.push_back(gs.clone());
+            getAvailableMacros(gs, macros);
+            ASSERT_FALSE(macros.empty());
+            greedyExpandMacroJournaled(gs, macros[dice.rollD6() * 17 % macros.size()], dice, journal);
+        }
+        for (size_t mark = snapshots.size(); mark-- > 0;) {
+            journal.undoTo(gs, mark);
+            expectSameState(gs, snapshots[mark]);
+            EXPECT_EQ(gs.hash(), snapshots[mark].hash());
+        }
+    }
+}
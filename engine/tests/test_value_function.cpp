@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "bb/value_function.h"
 #include "bb/feature_extractor.h"
+#include <algorithm>
 #include <cmath>
 
 using namespace bb;
@@ -67,6 +68,104 @@ TEST(ValueFunction, NeuralReLU) {
     EXPECT_NEAR(vf.evaluate(features, 1), expected, 0.001f);
 }
 
+TEST(ValueFunction, NeuralMatchesReferenceForwardPass) {
+    // Sizes off the SIMD width so padding and tails are exercised.
+    const int in = NUM_FEATURES, hidden = 37;
+    std::vector<std::vector<float>> W1(in, std::vector<float>(hidden));
+    std::vector<float> b1(hidden), W2(hidden), features(in);
+    for (int i = 0; i < in; ++i) {
+        features[i] = 0.1f * static_cast<float>((i * 7) % 13) - 0.6f;
+        for (int j = 0; j < hidden; ++j) {
+            W1[i][j] = 0.01f * static_cast<float>((i * 31 + j * 17) % 41) - 0.2f;
+        }
+    }
+    for (int j = 0; j < hidden; ++j) {
+        b1[j] = 0.05f * static_cast<float>(j % 5) - 0.1f;
+        W2[j] = 0.03f * static_cast<float>((j * 3) % 11) - 0.15f;
+    }
+
+    double out = 0.2;
+    for (int j = 0; j < hidden; ++j) {
+        double h = b1[j];
+        for (int i = 0; i < in; ++i) h += static_cast<double>(features[i]) * W1[i][j];
+        out += std::max(0.0, h) * W2[j];
+    }
+
+    NeuralValueFunction vf(in, hidden, W1, b1, W2, 0.2f);
+    EXPECT_NEAR(vf.evaluate(features.data(), in), std::tanh(out), 1e-5);
+}
+
+TEST(ValueFunction, EvaluateBatchMatchesPerRowEvaluate) {
+    const int batch = 11, in = NUM_FEATURES, hidden = 19;
+    std::vector<float> rows(batch * in);
+    for (size_t i = 0; i < rows.size(); ++i) rows[i] = 0.05f * static_cast<float>((i * 13) % 17) - 0.4f;
+
+    std::vector<float> linearWeights(in);
+    for (int i = 0; i < in; ++i) linearWeights[i] = 0.01f * static_cast<float>(i % 9) - 0.03f;
+    LinearValueFunction linear(linearWeights);
+
+    std::vector<std::vector<float>> W1(in, std::vector<float>(hidden));
+    for (int i = 0; i < in; ++i) {
+        for (int j = 0; j < hidden; ++j) W1[i][j] = 0.02f * static_cast<float>((i + 3 * j) % 7) - 0.06f;
+    }
+    std::vector<float> b1(hidden, 0.01f), W2(hidden, 0.1f);
+    NeuralValueFunction neural(in, hidden, W1, b1, W2, -0.05f);
+
+    for (const ValueFunction* vf : {static_cast<const ValueFunction*>(&linear),
+                                    static_cast<const ValueFunction*>(&neural)}) {
+        std::vector<float> out(batch);
+        vf->evaluateBatch(rows.data(), batch, in, out.data());
+        for (int b = 0; b < batch; ++b) {
+            EXPECT_NEAR(out[b], vf->evaluate(&rows[b * in], in), 1e-6f) << "row " << b;
+        }
+    }
+}
+
+TEST(ValueFunction, NeuralInt8CloseToFloat) {
+    const int in = NUM_FEATURES, hidden = 32, samples = 50;
+    std::vector<std::vector<float>> W1(in, std::vector<float>(hidden));
+    for (int i = 0; i < in; ++i) {
+        for (int j = 0; j < hidden; ++j) W1[i][j] = 0.04f * static_cast<float>((i * 7 + j * 13) % 21) - 0.4f;
+    }
+    std::vector<float> b1(hidden, 0.05f), W2(hidden);
+    for (int j = 0; j < hidden; ++j) W2[j] = 0.1f * static_cast<float>(j % 5) - 0.2f;
+    NeuralValueFunction vf(in, hidden, W1, b1, W2, 0.0f);
+
+    std::vector<float> rows(samples * in);
+    for (size_t i = 0; i < rows.size(); ++i) rows[i] = static_cast<float>((i * 29) % 11) / 10.0f;
+
+    QuantizationError err = vf.quantizationError(rows.data(), samples, in);
+    EXPECT_EQ(err.samples, samples);
+    EXPECT_GT(err.maxAbs, 0.0);   // genuinely quantized
+    EXPECT_LT(err.maxAbs, 0.05);
+
+    float exact = vf.evaluate(rows.data(), in);
+    vf.setInt8(true);
+    EXPECT_TRUE(vf.isInt8());
+    std::vector<float> batched(samples);
+    vf.evaluateBatch(rows.data(), samples, in, batched.data());
+    EXPECT_NEAR(batched[0], exact, 0.05);
+    EXPECT_FLOAT_EQ(batched[0], vf.evaluate(rows.data(), in));
+}
+
+TEST(ValueFunction, LoaderSelectsInt8) {
+    std::string json = R"({
+        "type": "neural",
+        "hidden_size": 2,
+        "W1": [[1.0, 0.0], [0.0, 1.0]],
+        "b1": [0.0, 0.0],
+        "W2": [[1.0], [1.0]],
+        "b2": [0.0]
+    })";
+    auto vf = loadValueFunctionFromString(json, true);
+    auto* neural = dynamic_cast<NeuralValueFunction*>(vf.get());
+    ASSERT_NE(neural, nullptr);
+    EXPECT_TRUE(neural->isInt8());
+
+    float features[] = {1.0f, 1.0f};
+    EXPECT_NEAR(vf->evaluate(features, 2), std::tanh(2.0f), 0.01f);
+}
+
 TEST(ValueFunction, LoadLinearFromJson) {
     std::string json = "[1.0, 2.0, 3.0, 0.5]";
     auto vf = loadValueFunctionFromString(json);
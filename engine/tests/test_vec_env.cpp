@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "bb/vec_env.h"
+#include "bb/action_features.h"
+#include "bb/board_planes.h"
+#include "bb/feature_extractor.h"
+
+using namespace bb;
+
+namespace {
+
+struct Rollout {
+    std::vector<float> rewards;
+    std::vector<int> scores;  // home, away per game
+    int steps = 0;
+};
+
+// Play every game to the end, taking slot (step * 7 + game) % legal.
+Rollout playOut(int numEnvs, VecEnvConfig config) {
+    VecEnv env(getHumanRoster(), getOrcRoster(), numEnvs, config);
+    std::vector<uint64_t> seeds(numEnvs);
+    for (int i = 0; i < numEnvs; ++i) seeds[i] = 100 + i;
+    env.reset(seeds.data());
+
+    const int slots = config.maxActions;
+    std::vector<int16_t> actions(static_cast<size_t>(numEnvs) * slots * VecEnv::ACTION_COLUMNS);
+    std::vector<uint8_t> mask(static_cast<size_t>(numEnvs) * slots);
+    std::vector<int32_t> choices(numEnvs);
+    std::vector<float> rewards(numEnvs);
+    std::vector<uint8_t> done(numEnvs, 0);
+    Rollout r;
+    r.rewards.assign(numEnvs, 0.0f);
+    for (;;) {
+        bool live = false;
+        for (int i = 0; i < numEnvs; ++i) live |= !env.done(i);
+        if (!live) break;
+        env.legalActions(actions.data(), mask.data());
+        for (int i = 0; i < numEnvs; ++i) {
+            int legal = 0;
+            while (legal < slots && mask[static_cast<size_t>(i) * slots + legal]) ++legal;
+            choices[i] = legal ? (r.steps * 7 + i) % legal : 0;
+        }
+        env.step(choices.data(), rewards.data(), done.data());
+        for (int i = 0; i < numEnvs; ++i) r.rewards[i] += rewards[i];
+        ++r.steps;
+    }
+    for (int i = 0; i < numEnvs; ++i) {
+        r.scores.push_back(env.state(i).homeTeam.score);
+        r.scores.push_back(env.state(i).awayTeam.score);
+    }
+    return r;
+}
+
+} // namespace
+
+TEST(VecEnv, PlaysGamesToTheEndIdenticallyOnAnyThreadCount) {
+    VecEnvConfig config;
+    config.maxActions = 64;
+    config.maxGameActions = 800;
+    Rollout serial = playOut(6, config);
+    config.threads = 3;
+    Rollout parallel = playOut(6, config);
+    EXPECT_GT(serial.steps, 0);
+    EXPECT_EQ(serial.steps, parallel.steps);
+    EXPECT_EQ(serial.scores, parallel.scores);
+    EXPECT_EQ(serial.rewards, parallel.rewards);
+}
+
+TEST(VecEnv, EncodesLegalActionsAndObservations) {
+    VecEnvConfig config;
+    config.maxActions = 8;  // fewer than the opening turn offers
+    VecEnv env(getHumanRoster(), getOrcRoster(), 2, config);
+    uint64_t seeds[2] = {1, 2};
+    env.reset(seeds);
+
+    std::vector<int16_t> actions(2 * 8 * VecEnv::ACTION_COLUMNS);
+    std::vector<uint8_t> mask(2 * 8);
+    std::vector<float> features(2 * 8 * NUM_ACTION_FEATURES);
+    env.legalActions(actions.data(), mask.data(), features.data());
+    for (int i = 0; i < 2; ++i) {
+        std::vector<Action> legal;
+        getAvailableActions(env.state(i), legal);
+        ASSERT_GT(legal.size(), 8u);
+        for (int k = 0; k < 8; ++k) {
+            EXPECT_EQ(mask[i * 8 + k], 1);
+            const int16_t* row = &actions[(i * 8 + k) * VecEnv::ACTION_COLUMNS];
+            EXPECT_EQ(row[0], static_cast<int16_t>(legal[k].type));
+            EXPECT_EQ(row[1], legal[k].playerId);
+            EXPECT_EQ(row[3], legal[k].target.x);
+            float expected[NUM_ACTION_FEATURES];
+            extractActionFeatures(env.state(i), legal[k], expected);
+            for (int f = 0; f < NUM_ACTION_FEATURES; ++f) {
+                EXPECT_EQ(features[(i * 8 + k) * NUM_ACTION_FEATURES + f], expected[f]);
+            }
+        }
+    }
+
+    std::vector<float> obs(2 * NUM_FEATURES);
+    uint8_t teams[2];
+    env.observe(obs.data(), teams);
+    float expected[NUM_FEATURES];
+    extractFeatures(env.state(1), env.state(1).activeTeam, expected);
+    EXPECT_EQ(teams[1], static_cast<uint8_t>(env.state(1).activeTeam));
+    for (int f = 0; f < NUM_FEATURES; ++f) EXPECT_EQ(obs[NUM_FEATURES + f], expected[f]);
+
+    std::vector<uint8_t> planes(2 * NUM_BOARD_PLANES * BOARD_PLANE_SIZE);
+    env.observePlanes(planes.data());
+    std::vector<uint8_t> plane0(NUM_BOARD_PLANES * BOARD_PLANE_SIZE);
+    extractBoardPlanes(env.state(0), env.state(0).activeTeam, plane0.data());
+    EXPECT_TRUE(std::equal(plane0.begin(), plane0.end(), planes.begin()));
+
+    // A bad slot is rejected before any game moves
+    GameState before = env.state(0);
+    int32_t choices[2] = {0, 8};
+    float rewards[2];
+    uint8_t done[2];
+    EXPECT_THROW(env.step(choices, rewards, done), std::out_of_range);
+    EXPECT_EQ(env.state(0).ball.position, before.ball.position);
+    EXPECT_EQ(env.state(0).getTeamState(before.activeTeam).turnNumber,
+              before.getTeamState(before.activeTeam).turnNumber);
+
+    // Resetting one game leaves the other alone
+    choices[1] = 0;
+    env.step(choices, rewards, done);
+    GameState stepped = env.state(1);
+    uint8_t which[2] = {1, 0};
+    env.reset(seeds, which);
+    EXPECT_EQ(env.state(1).ball.position, stepped.ball.position);
+    EXPECT_THROW(VecEnv(getHumanRoster(), getOrcRoster(), 0), std::invalid_argument);
+}
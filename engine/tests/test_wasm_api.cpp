@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "bb/game_simulator.h"
+#include "bb/roster.h"
+#include "bb/rules_engine.h"
+#include "bb/state_io.h"
+#include <nlohmann/json.hpp>
+
+// The WebAssembly module's C API (wasm/bb_wasm.cpp), built natively
+extern "C" const char* bb_init(const char* config);
+extern "C" const char* bb_move(const char* line);
+
+using namespace bb;
+using nlohmann::json;
+
+TEST(WasmApi, MovesFollowTheServerProtocol) {
+    EXPECT_EQ(json::parse(bb_move("{}"))["status"], "error");  // before bb_init
+
+    EXPECT_EQ(json::parse(bb_init("[1]"))["status"], "error");
+    EXPECT_EQ(json::parse(bb_init(R"({"weights": "/no/such/model.bin"})"))["status"], "error");
+    ASSERT_EQ(json::parse(bb_init(R"({"iterations": 50, "time_ms": 0, "seed": 3})"))["status"], "ok");
+
+    GameState state;
+    setupHalf(state, getHumanRoster(), getOrcRoster());
+    state.phase = GamePhase::PLAY;
+    state.activeTeam = TeamSide::HOME;
+    state.homeTeam.turnNumber = 1;
+    state.ball = BallState::onGround({8, 7});
+    json request = {{"id", 7}, {"state", json::parse(stateToJson(state))}, {"plan", true}};
+    json reply = json::parse(bb_move(request.dump().c_str()));
+    ASSERT_EQ(reply["status"], "ok") << reply.dump();
+    EXPECT_EQ(reply["id"], 7);
+    EXPECT_EQ(reply["iterations"], 50);
+    ASSERT_FALSE(reply["actions"].empty());
+    const json& first = reply["actions"][0];
+    Action action{static_cast<ActionType>(first["type_id"].get<int>()), first["player"].get<int>(),
+                  first["target_player"].get<int>(),
+                  {static_cast<int8_t>(first["x"].get<int>()), static_cast<int8_t>(first["y"].get<int>())}};
+    EXPECT_TRUE(isActionLegal(state, action));
+
+    request["iterations"] = 20;
+    request.erase("plan");
+    reply = json::parse(bb_move(request.dump().c_str()));
+    EXPECT_EQ(reply["iterations"], 20);
+    EXPECT_EQ(reply["actions"].size(), 1u);
+
+    EXPECT_EQ(json::parse(bb_move(R"({"op": "stats"})"))["status"], "error");
+    EXPECT_EQ(json::parse(bb_move("not json"))["status"], "error");
+    state.phase = GamePhase::GAME_OVER;
+    reply = json::parse(bb_move(json{{"state", json::parse(stateToJson(state))}}.dump().c_str()));
+    EXPECT_EQ(reply["status"], "failed");
+}
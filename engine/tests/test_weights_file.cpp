@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "bb/weights_file.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace bb;
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("bb_weights_test_" + name)).string();
+}
+
+void writeText(const std::string& path, const std::string& text) {
+    std::ofstream(path) << text;
+}
+
+// Combined AlphaZero snapshot: neural value head plus neural policy head.
+std::string combinedJson(int hidden) {
+    std::ostringstream js;
+    js << R"({"type": "alphazero_neural", "hidden_size": )" << hidden << R"(, "value_W1": [)";
+    for (int i = 0; i < NUM_FEATURES; ++i) {
+        js << (i ? "," : "") << "[";
+        for (int j = 0; j < hidden; ++j) js << (j ? "," : "") << 0.01f * static_cast<float>((i * 3 + j) % 9 - 4);
+        js << "]";
+    }
+    js << R"(], "value_b1": [)";
+    for (int j = 0; j < hidden; ++j) js << (j ? "," : "") << 0.1f;
+    js << R"(], "value_W2": [)";
+    for (int j = 0; j < hidden; ++j) js << (j ? "," : "") << "[" << 0.2f * static_cast<float>(j % 3 - 1) << "]";
+    js << R"(], "value_b2": [0.05], "policy_type": "neural", "policy_hidden_size": )" << hidden
+       << R"(, "policy_W1": [)";
+    for (int k = 0; k < POLICY_INPUT_SIZE * hidden; ++k) js << (k ? "," : "") << 0.02f * static_cast<float>(k % 7 - 3);
+    js << R"(], "policy_b1": [)";
+    for (int j = 0; j < hidden; ++j) js << (j ? "," : "") << 0.05f;
+    js << R"(], "policy_W2": [)";
+    for (int j = 0; j < hidden; ++j) js << (j ? "," : "") << 0.3f * static_cast<float>(j % 2 ? 1 : -1);
+    js << R"(], "policy_b2": 0.1, "policy_temperature": 0.8})";
+    return js.str();
+}
+
+} // anonymous namespace
+
+TEST(WeightsFile, ConvertedNeuralNetworksMatchJson) {
+    std::string jsonPath = tempPath("combined.json"), binPath = tempPath("combined.bin");
+    writeText(jsonPath, combinedJson(12));
+    ASSERT_TRUE(convertWeightsJson(jsonPath, binPath));
+    EXPECT_TRUE(isWeightsFile(binPath));
+    EXPECT_FALSE(isWeightsFile(jsonPath));
+
+    auto vfJson = loadValueFunction(jsonPath);
+    auto vfBin = loadValueFunction(binPath);
+    auto pnJson = loadPolicyNetworkFromFile(jsonPath);
+    auto pnBin = loadPolicyNetworkFromFile(binPath);
+    ASSERT_NE(vfBin, nullptr);
+    ASSERT_NE(pnBin, nullptr);
+    EXPECT_NE(dynamic_cast<NeuralValueFunction*>(vfBin.get()), nullptr);
+    EXPECT_TRUE(pnBin->isNeural());
+    EXPECT_FLOAT_EQ(pnBin->temperature(), 0.8f);
+
+    float state[NUM_FEATURES], actions[3 * NUM_ACTION_FEATURES];
+    for (int i = 0; i < NUM_FEATURES; ++i) state[i] = static_cast<float>(i % 4) / 3.0f;
+    for (int i = 0; i < 3 * NUM_ACTION_FEATURES; ++i) actions[i] = static_cast<float>(i % 5) / 4.0f;
+    EXPECT_FLOAT_EQ(vfBin->evaluate(state, NUM_FEATURES), vfJson->evaluate(state, NUM_FEATURES));
+
+    float priorsJson[3], priorsBin[3];
+    pnJson->computePriors(state, actions, 3, priorsJson);
+    pnBin->computePriors(state, actions, 3, priorsBin);
+    for (int k = 0; k < 3; ++k) EXPECT_FLOAT_EQ(priorsBin[k], priorsJson[k]);
+
+    // The mapping outlives the file's directory entry.
+    std::remove(binPath.c_str());
+    EXPECT_FLOAT_EQ(vfBin->evaluate(state, NUM_FEATURES), vfJson->evaluate(state, NUM_FEATURES));
+    std::remove(jsonPath.c_str());
+}
+
+TEST(WeightsFile, LinearNetworksRoundTrip) {
+    std::vector<float> valueWeights = {1.0f, -2.0f, 0.5f};
+    LinearValueFunction vf(valueWeights);
+    std::vector<float> policyWeights(POLICY_INPUT_SIZE, 0.0f);
+    policyWeights[NUM_FEATURES] = 1.5f;
+    PolicyNetwork pn(policyWeights, 0.25f, 2.0f);
+
+    std::string path = tempPath("linear.bin");
+    ASSERT_TRUE(writeWeightsFile(path, &vf, &pn));
+
+    auto vfBin = loadValueFunction(path);
+    ASSERT_NE(vfBin, nullptr);
+    float features[] = {1.0f, 1.0f, 2.0f};
+    EXPECT_FLOAT_EQ(vfBin->evaluate(features, 3), 0.0f);
+
+    auto pnBin = loadPolicyNetworkFromFile(path);
+    ASSERT_NE(pnBin, nullptr);
+    EXPECT_FALSE(pnBin->isNeural());
+    EXPECT_FLOAT_EQ(pnBin->temperature(), 2.0f);
+    float state[NUM_FEATURES] = {};
+    float action[NUM_ACTION_FEATURES] = {1.0f};
+    EXPECT_FLOAT_EQ(pnBin->evaluateAction(state, action), pn.evaluateAction(state, action));
+    std::remove(path.c_str());
+}
+
+TEST(WeightsFile, MissingSectionOrBadVersionRejected) {
+    LinearValueFunction vf({1.0f, 2.0f});
+    std::string path = tempPath("value_only.bin");
+    ASSERT_TRUE(writeWeightsFile(path, &vf, nullptr));
+    EXPECT_EQ(loadPolicyNetworkFromFile(path), nullptr);
+    EXPECT_NE(loadValueFunction(path), nullptr);
+
+    // Bump the version field in place.
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        uint32_t version = WEIGHTS_FILE_VERSION + 1;
+        f.seekp(offsetof(WeightsFileHeader, version));
+        f.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+    EXPECT_EQ(loadValueFunction(path), nullptr);
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(writeWeightsFile(path, nullptr, nullptr));
+}
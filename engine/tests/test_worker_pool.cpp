@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+#include "bb/worker_pool.h"
+#include <atomic>
+#include <vector>
+
+using namespace bb;
+
+TEST(WorkerPool, RunsEveryTaskOnceOnValidWorkers) {
+    WorkerPool pool(3);
+    EXPECT_EQ(pool.helpers(), 3);
+    for (int batch = 0; batch < 200; ++batch) {
+        int n = 1 + batch % 9;
+        std::vector<std::atomic<int>> runs(n);
+        std::atomic<bool> badWorker{false};
+        pool.run(n, [&](int task, int worker) {
+            runs[task].fetch_add(1);
+            if (worker < 0 || worker > 3) badWorker = true;
+        });
+        for (int t = 0; t < n; ++t) EXPECT_EQ(runs[t].load(), 1) << "batch " << batch;
+        EXPECT_FALSE(badWorker.load());
+    }
+}
+
+TEST(WorkerPool, WithoutHelpersRunsInline) {
+    WorkerPool pool(0);
+    std::vector<int> order;
+    pool.run(4, [&](int task, int worker) {
+        EXPECT_EQ(worker, 0);
+        order.push_back(task);
+    });
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+}
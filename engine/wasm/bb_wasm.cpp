@@ -0,0 +1,111 @@
+#include "bb/model_cache.h"
+#include "bb/move_server.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten/emscripten.h>
+#define BB_EXPORT extern "C" EMSCRIPTEN_KEEPALIVE
+#else
+#define BB_EXPORT extern "C"
+#endif
+
+using namespace bb;
+using nlohmann::json;
+
+// The engine's AI for the browser: a C API over one single-threaded
+// Macro-MCTS search, speaking bb_server's line protocol (move_server.h) so
+// the web app sends the same requests to either. Built by Emscripten as
+// the bb_wasm module (see CMakeLists.txt) and wrapped for TypeScript by
+// frontend/src/engine/WasmEngine.ts. Networks are read from the module's
+// virtual filesystem, where the page writes the weights file first.
+//
+// Every returned string stays valid until the next call into the module.
+
+namespace {
+
+struct Session {
+    MCTSConfig search;
+    int maxTimeBudgetMs = 30000;
+    std::shared_ptr<LoadedModel> model;
+    std::shared_ptr<LoadedModel> policyModel;  // search.policy's owner
+    std::unique_ptr<MacroMCTSSearch> engine;
+    uint32_t moves = 0;  // plan dice seeds
+};
+
+std::unique_ptr<Session> session;
+std::string result;
+
+const char* reply(std::string text) {
+    result = std::move(text);
+    return result.c_str();
+}
+
+} // anonymous namespace
+
+// Configure the AI: {"weights": PATH, "policy": PATH, "time_ms": N,
+// "iterations": N, "max_time_ms": N, "exploration_c": X, "vf_blend": X,
+// "policy_blend": X, "seed": N}, every key optional (no weights = the
+// heuristic evaluation). Replaces any earlier session. Answers
+// {"status":"ok"} or {"status":"error","error":...}.
+BB_EXPORT const char* bb_init(const char* config) {
+    json j = json::parse(config ? config : "{}", nullptr, false);
+    if (j.is_discarded() || !j.is_object()) return reply(serverErrorJson("", "config is not a JSON object"));
+    auto s = std::make_unique<Session>();
+    try {
+        s->search.timeBudgetMs = j.value("time_ms", 1000);
+        s->search.maxIterations = j.value("iterations", 100000);
+        s->search.explorationC = j.value("exploration_c", 1.0);
+        s->search.vfBlend = j.value("vf_blend", 0.0f);
+        s->search.policyBlend = j.value("policy_blend", 0.0f);
+        s->maxTimeBudgetMs = j.value("max_time_ms", 30000);
+        ModelCache models;
+        std::string weights = j.value("weights", std::string());
+        if (!weights.empty()) {
+            s->model = models.get(weights);
+            if (!s->model || !s->model->value) return reply(serverErrorJson("", "no value network in " + weights));
+        }
+        s->policyModel = s->model;
+        std::string policy = j.value("policy", std::string());
+        if (!policy.empty()) {
+            s->policyModel = models.get(policy);
+            if (!s->policyModel || !s->policyModel->policy) {
+                return reply(serverErrorJson("", "no policy network in " + policy));
+            }
+        }
+        if (s->policyModel) s->search.policy = s->policyModel->policy.get();
+        s->engine = std::make_unique<MacroMCTSSearch>(s->model ? s->model->value.get() : nullptr, s->search,
+                                                      j.value("seed", 1u));
+    } catch (const json::exception& e) {
+        return reply(serverErrorJson("", std::string("bad config: ") + e.what()));
+    }
+    session = std::move(s);
+    return reply(json{{"status", "ok"}}.dump());
+}
+
+// One "move" request line, answered as bb_server would (moveReplyToJson),
+// except that the search runs on the calling thread: time spent here is
+// the caller's, and "cancel" and "stats" are not available.
+BB_EXPORT const char* bb_move(const char* line) {
+    if (!session) return reply(serverErrorJson("", "bb_init has not been called"));
+    ServerMessage msg = parseServerMessage(line ? line : "");
+    if (msg.op == ServerOp::INVALID) return reply(serverErrorJson(msg.request.tag, msg.error));
+    if (msg.op != ServerOp::MOVE) return reply(serverErrorJson(msg.request.tag, "only move requests are served here"));
+
+    const MoveRequest& request = msg.request;
+    MoveReply out;
+    out.tag = request.tag;
+    if (request.state.phase == GamePhase::GAME_OVER) {
+        out.status = MoveStatus::FAILED;
+        out.error = "game is over";
+        return reply(moveReplyToJson(out));
+    }
+    int budgetMs = request.timeBudgetMs > 0 ? request.timeBudgetMs : session->search.timeBudgetMs;
+    if (budgetMs > 0) budgetMs = std::min(budgetMs, session->maxTimeBudgetMs);
+    int iterations = request.maxIterations > 0 ? request.maxIterations : session->search.maxIterations;
+    session->engine->setBudget(budgetMs, iterations);
+    searchMove(*session->engine, request, ++session->moves, out);
+    return reply(moveReplyToJson(out));
+}
@@ -0,0 +1,56 @@
+import { describe, it, expect } from 'vitest';
+import { WasmEngine, WasmEngineError } from './WasmEngine';
+import type { BbEngineModule } from './WasmEngine';
+
+/** Records calls and answers as the C API would */
+function fakeModule(initReply: object = { status: 'ok' }) {
+    const calls: { fn: string; body: Record<string, unknown> }[] = [];
+    const files: Record<string, Uint8Array> = {};
+    const module: BbEngineModule = {
+        ccall(name, _ret, _types, args) {
+            const body = JSON.parse(args[0]);
+            calls.push({ fn: name, body });
+            if (name === 'bb_init') return JSON.stringify(initReply);
+            return JSON.stringify({
+                id: body.id ?? null,
+                status: 'ok',
+                macro: { type: 'SCORE', player: 9, target_player: -1, x: -1, y: -1 },
+                actions: [{ type: 'MOVE', type_id: 0, player: 9, target_player: -1, x: 20, y: 2 }],
+                value: 0.8,
+                iterations: body.iterations ?? 100,
+            });
+        },
+        FS: { writeFile: (path, data) => { files[path] = data; } },
+    };
+    return { module, calls, files };
+}
+
+describe('WasmEngine', () => {
+    it('writes the networks and passes the config to bb_init', async () => {
+        const { module, calls, files } = fakeModule();
+        await WasmEngine.create(async () => module, { weights: new Uint8Array([1, 2]), iterations: 400, timeMs: 0 });
+        expect(files['/weights.bin']).toEqual(new Uint8Array([1, 2]));
+        expect(calls[0]).toEqual({ fn: 'bb_init', body: { weights: '/weights.bin', iterations: 400, time_ms: 0 } });
+    });
+
+    it('sends move requests in the server protocol', async () => {
+        const { module, calls } = fakeModule();
+        const engine = await WasmEngine.create(async () => module);
+        const reply = engine.move({ half: 1 }, { id: 3, iterations: 50, plan: true });
+        expect(calls[1]).toEqual({
+            fn: 'bb_move',
+            body: { op: 'move', id: 3, state: { half: 1 }, iterations: 50, plan: true },
+        });
+        expect(reply.status).toBe('ok');
+        expect(reply.actions?.[0].player).toBe(9);
+
+        engine.move('QkJHUw==');
+        expect(calls[2].body).toEqual({ op: 'move', state_b64: 'QkJHUw==' });
+    });
+
+    it('throws when the engine rejects its config', async () => {
+        const { module } = fakeModule({ status: 'error', error: 'no value network in /weights.bin' });
+        await expect(WasmEngine.create(async () => module, { weights: new Uint8Array([0]) }))
+            .rejects.toThrow(WasmEngineError);
+    });
+});
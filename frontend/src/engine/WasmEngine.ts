@@ -0,0 +1,124 @@
+/**
+ * Client-side AI: the C++ engine's Macro-MCTS compiled to WebAssembly
+ * (engine/wasm/bb_wasm.cpp, built with `emcmake cmake` as bb_wasm.js +
+ * bb_wasm.wasm). Requests and replies are bb_server's line protocol, so a
+ * page can use this or the move server interchangeably.
+ *
+ * Searches run synchronously on the calling thread for their whole budget:
+ * create the engine inside a Web Worker, not on the page's main thread.
+ *
+ * States are the engine's own JSON (state_io.h stateToJson) or the base64
+ * of its binary record, not the backend's api/types GameState.
+ */
+
+/** The parts of the Emscripten module the wrapper uses */
+export interface BbEngineModule {
+    ccall(name: string, returnType: 'string', argTypes: ['string'], args: [string]): string;
+    FS: { writeFile(path: string, data: Uint8Array): void };
+}
+
+/** createBbEngine, the module factory bb_wasm.js exports */
+export type BbEngineFactory = (options?: Record<string, unknown>) => Promise<BbEngineModule>;
+
+export interface WasmEngineOptions {
+    /** Value network file (JSON or binary weights); none = heuristic evaluation */
+    weights?: Uint8Array;
+    /** Policy network file, when it is not part of `weights` */
+    policy?: Uint8Array;
+    /** Default budget per move (engine default: 1000 ms, 100000 iterations) */
+    timeMs?: number;
+    iterations?: number;
+    /** Cap on a request's time budget */
+    maxTimeMs?: number;
+    explorationC?: number;
+    vfBlend?: number;
+    policyBlend?: number;
+    seed?: number;
+}
+
+/** stateToJson's object */
+export type EngineState = Record<string, unknown>;
+
+export interface MoveOptions {
+    id?: string | number;
+    timeMs?: number;
+    iterations?: number;
+    /** Reply with the whole macro plan rather than its first action */
+    plan?: boolean;
+}
+
+export interface EngineAction {
+    type: string;
+    type_id: number;
+    player: number;
+    target_player: number;
+    x: number;
+    y: number;
+}
+
+export interface EngineMoveReply {
+    id: string | number | null;
+    status: 'ok' | 'cancelled' | 'failed' | 'error';
+    error?: string;
+    macro?: { type: string; player: number; target_player: number; x: number; y: number };
+    actions?: EngineAction[];
+    value?: number;
+    iterations?: number;
+    queue_ms?: number;
+    search_ms?: number;
+}
+
+export class WasmEngineError extends Error {
+    constructor(message: string) {
+        super(message);
+        this.name = 'WasmEngineError';
+    }
+}
+
+export class WasmEngine {
+    private constructor(private readonly module: BbEngineModule) {}
+
+    /** Instantiate the module and load the networks into it */
+    static async create(factory: BbEngineFactory, options: WasmEngineOptions = {}): Promise<WasmEngine> {
+        const module = await factory();
+        const config: Record<string, unknown> = {};
+        if (options.weights) {
+            module.FS.writeFile('/weights.bin', options.weights);
+            config.weights = '/weights.bin';
+        }
+        if (options.policy) {
+            module.FS.writeFile('/policy.bin', options.policy);
+            config.policy = '/policy.bin';
+        }
+        if (options.timeMs !== undefined) config.time_ms = options.timeMs;
+        if (options.iterations !== undefined) config.iterations = options.iterations;
+        if (options.maxTimeMs !== undefined) config.max_time_ms = options.maxTimeMs;
+        if (options.explorationC !== undefined) config.exploration_c = options.explorationC;
+        if (options.vfBlend !== undefined) config.vf_blend = options.vfBlend;
+        if (options.policyBlend !== undefined) config.policy_blend = options.policyBlend;
+        if (options.seed !== undefined) config.seed = options.seed;
+
+        const engine = new WasmEngine(module);
+        const reply = engine.call('bb_init', config);
+        if (reply.status !== 'ok') {
+            throw new WasmEngineError(reply.error ?? 'engine initialization failed');
+        }
+        return engine;
+    }
+
+    /** Search `state` (stateToJson's object, or serializeState's record in base64) */
+    move(state: EngineState | string, options: MoveOptions = {}): EngineMoveReply {
+        const request: Record<string, unknown> = { op: 'move' };
+        if (options.id !== undefined) request.id = options.id;
+        if (typeof state === 'string') request.state_b64 = state;
+        else request.state = state;
+        if (options.timeMs !== undefined) request.time_ms = options.timeMs;
+        if (options.iterations !== undefined) request.iterations = options.iterations;
+        if (options.plan) request.plan = true;
+        return this.call('bb_move', request);
+    }
+
+    private call(fn: string, body: Record<string, unknown>): EngineMoveReply {
+        return JSON.parse(this.module.ccall(fn, 'string', ['string'], [JSON.stringify(body)]));
+    }
+}
@@ -0,0 +1,184 @@
+"""Reader for binary replay files (engine/include/bb/replay_file.h).
+
+The file is memory-mapped and each section is exposed as a numpy record
+array, so per-event or per-turn analysis over a corpus never builds a
+Python object per event:
+
+    r = ReplayFile('g0001.bbr')
+    blocks = r.events[r.events['type'] == EVENT_TYPES.index('BLOCK')]
+    turn = r.turn(12)            # same dict layout as get_turn_logs()
+
+Files are written by bb_engine.write_replay(path, logged, metadata).
+"""
+from __future__ import annotations
+
+import numpy as np
+
+MAGIC = 0x50524242  # "BBRP"
+VERSION = 1
+
+# GameEvent::Type order; names as in get_turn_logs()
+EVENT_TYPES = [
+    'MOVE', 'DODGE', 'GFI', 'BLOCK', 'PUSH', 'INJURY',
+    'TOUCHDOWN', 'TURNOVER', 'BALL_BOUNCE', 'PASS', 'CATCH',
+    'PICKUP', 'FOUL', 'KICKOFF', 'WEATHER', 'SKILL',
+    'KNOCKED_DOWN', 'ARMOR_BREAK', 'CASUALTY', 'REGENERATION',
+    'EJECTED',
+]
+
+HEADER_DTYPE = np.dtype([
+    ('magic', '<u4'), ('version', '<u4'),
+    ('num_turns', '<u4'), ('num_players', '<u4'), ('num_events', '<u4'),
+    ('num_roster', '<u4'), ('num_names', '<u4'), ('metadata_bytes', '<u4'),
+    ('home_score', '<i4'), ('away_score', '<i4'),
+    ('turns_offset', '<u8'), ('players_offset', '<u8'), ('events_offset', '<u8'),
+    ('roster_offset', '<u8'), ('names_offset', '<u8'), ('metadata_offset', '<u8'),
+])
+
+TURN_DTYPE = np.dtype([
+    ('half', 'u1'), ('turn', 'u1'), ('flags', 'u1'),
+    ('ball_x', 'i1'), ('ball_y', 'i1'), ('ball_carrier_id', 'i1'),
+    ('home_score', 'u1'), ('away_score', 'u1'),
+    ('first_player', '<u4'), ('first_event', '<u4'),
+])
+TURN_AWAY_ACTIVE, TURN_TURNOVER, TURN_TOUCHDOWN, TURN_KEYFRAME, TURN_BALL_HELD = 1, 2, 4, 8, 16
+
+PLAYER_DTYPE = np.dtype([('id', 'i1'), ('x', 'i1'), ('y', 'i1'), ('flags', 'u1')])
+EVENT_DTYPE = np.dtype([
+    ('type', 'u1'), ('flags', 'u1'), ('player_id', 'i1'), ('target_id', 'i1'),
+    ('roll', 'i1'), ('squares', 'u1', (3,)),
+])
+ROSTER_DTYPE = np.dtype([('side', 'u1'), ('id', 'i1'), ('name', '<u2')])
+
+
+def decode_events(events: np.ndarray) -> dict[str, np.ndarray]:
+    """Unpack event records into one array per get_turn_logs() field."""
+    sq = events['squares'].astype(np.uint32)
+    packed = sq[:, 0] | sq[:, 1] << 8 | sq[:, 2] << 16
+    frm, to = packed & 0xfff, packed >> 12
+    flags = events['flags']
+    return {
+        'type': events['type'],
+        'player_id': events['player_id'].astype(np.int32),
+        'target_id': events['target_id'].astype(np.int32),
+        'from_x': (frm & 63).astype(np.int32) - 1,
+        'from_y': (frm >> 6).astype(np.int32) - 1,
+        'to_x': (to & 63).astype(np.int32) - 1,
+        'to_y': (to >> 6).astype(np.int32) - 1,
+        'roll': events['roll'].astype(np.int32),
+        'success': (flags & 1).astype(bool),
+        'die1': (flags >> 1 & 7).astype(np.int32),
+        'die2': (flags >> 4 & 7).astype(np.int32),
+    }
+
+
+class ReplayFile:
+    """One replay file, mapped read-only.
+
+    `turns`, `players`, `events` and `roster` are record arrays viewing the
+    mapping. Player records are delta-encoded (see replay_file.h): use
+    turn()/turn_logs() for full board snapshots.
+    """
+
+    def __init__(self, path: str):
+        self._map = np.memmap(path, dtype=np.uint8, mode='r')
+        if self._map.size < HEADER_DTYPE.itemsize:
+            raise ValueError(f'{path}: too short for a replay file')
+        h = self._map[:HEADER_DTYPE.itemsize].view(HEADER_DTYPE)[0]
+        if h['magic'] != MAGIC or h['version'] != VERSION:
+            raise ValueError(f'{path}: not a version {VERSION} replay file')
+        self.header = h
+        self.home_score = int(h['home_score'])
+        self.away_score = int(h['away_score'])
+        self.turns = self._section(h['turns_offset'], h['num_turns'], TURN_DTYPE)
+        self.players = self._section(h['players_offset'], h['num_players'], PLAYER_DTYPE)
+        self.events = self._section(h['events_offset'], h['num_events'], EVENT_DTYPE)
+        self.roster = self._section(h['roster_offset'], h['num_roster'], ROSTER_DTYPE)
+
+        n = int(h['num_names'])
+        offsets = self._section(h['names_offset'], n + 1, np.dtype('<u4'))
+        chars = int(h['names_offset']) + 4 * (n + 1)
+        raw = self._map[chars:chars + int(offsets[-1])].tobytes()
+        self.names = [raw[offsets[i]:offsets[i + 1]].decode() for i in range(n)]
+        start = int(h['metadata_offset'])
+        self.metadata = self._map[start:start + int(h['metadata_bytes'])].tobytes().decode()
+
+        self._player_end = np.append(self.turns['first_player'][1:], h['num_players'])
+        self._event_end = np.append(self.turns['first_event'][1:], h['num_events'])
+        self._names_by_player = {(int(r['side']), int(r['id'])): self.names[r['name']]
+                                 for r in self.roster}
+
+    def _section(self, offset, count, dtype: np.dtype) -> np.ndarray:
+        offset, count = int(offset), int(count)
+        end = offset + count * dtype.itemsize
+        if end > self._map.size:
+            raise ValueError('replay section runs past the end of the file')
+        return self._map[offset:end].view(dtype)
+
+    def __len__(self) -> int:
+        return len(self.turns)
+
+    def turn_events(self, i: int) -> np.ndarray:
+        """Event records of turn i."""
+        return self.events[self.turns['first_event'][i]:self._event_end[i]]
+
+    def _apply_players(self, i: int, board: list[dict]) -> None:
+        flags = int(self.turns['flags'][i])
+        records = self.players[self.turns['first_player'][i]:self._player_end[i]]
+        if flags & TURN_KEYFRAME:
+            board[:] = [{}, {}]
+        for r in records:
+            side = int(r['flags']) >> 3 & 1
+            pid = int(r['id'])
+            p = board[side].setdefault(pid, {'id': pid})
+            p['x'], p['y'] = int(r['x']), int(r['y'])
+            p['state'] = int(r['flags']) & 3
+            p['has_ball'] = bool(r['flags'] & 4)
+            name = self._names_by_player.get((side, pid))
+            if name is not None:
+                p['name'] = name
+
+    def _turn_dict(self, i: int, board: list[dict]) -> dict:
+        t = self.turns[i]
+        flags = int(t['flags'])
+        ev = decode_events(self.turn_events(i))
+        events = [{
+            'type': EVENT_TYPES[k] if k < len(EVENT_TYPES) else 'UNKNOWN',
+            'player_id': int(ev['player_id'][e]), 'target_id': int(ev['target_id'][e]),
+            'from_x': int(ev['from_x'][e]), 'from_y': int(ev['from_y'][e]),
+            'to_x': int(ev['to_x'][e]), 'to_y': int(ev['to_y'][e]),
+            'roll': int(ev['roll'][e]), 'success': bool(ev['success'][e]),
+            'die1': int(ev['die1'][e]), 'die2': int(ev['die2'][e]),
+        } for e, k in enumerate(ev['type'].tolist())]
+        return {
+            'half': int(t['half']), 'turn': int(t['turn']),
+            'active_team': 'away' if flags & TURN_AWAY_ACTIVE else 'home',
+            'home_score': int(t['home_score']), 'away_score': int(t['away_score']),
+            'ball_x': int(t['ball_x']), 'ball_y': int(t['ball_y']),
+            'ball_held': bool(flags & TURN_BALL_HELD),
+            'ball_carrier_id': int(t['ball_carrier_id']),
+            'turnover': bool(flags & TURN_TURNOVER),
+            'touchdown': bool(flags & TURN_TOUCHDOWN),
+            'home_players': [dict(p) for p in board[0].values()],
+            'away_players': [dict(p) for p in board[1].values()],
+            'events': events,
+        }
+
+    def turn(self, i: int) -> dict:
+        """Turn i as a get_turn_logs() dict, decoded from the nearest keyframe."""
+        k = i
+        while k > 0 and not self.turns['flags'][k] & TURN_KEYFRAME:
+            k -= 1
+        board: list[dict] = [{}, {}]
+        for j in range(k, i + 1):
+            self._apply_players(j, board)
+        return self._turn_dict(i, board)
+
+    def turn_logs(self) -> list[dict]:
+        """Every turn, decoded sequentially."""
+        board: list[dict] = [{}, {}]
+        out = []
+        for i in range(len(self)):
+            self._apply_players(i, board)
+            out.append(self._turn_dict(i, board))
+        return out
@@ -5,6 +5,7 @@ Usage:
     python -m blood_bowl.replay_viewer --matches=1 --home-ai=macro_mcts --away-ai=random --mcts=200
     python -m blood_bowl.replay_viewer --matches=1 --save=replay.json
     python -m blood_bowl.replay_viewer --load=replay.json
+    python -m blood_bowl.replay_viewer --load=g0001.bbr   (binary replay, see replay_file.py)
 """
 from __future__ import annotations
 
@@ -87,6 +88,28 @@ def render_pitch(turn: dict) -> str:
     return '\n'.join(lines)
 
 
+def turn_from_state_arrays(arrays: dict) -> dict:
+    """Board part of a turn snapshot from GameState.as_arrays(), for render_pitch.
+
+    Lets a live GameState (e.g. one rebuilt with state_from_snapshot) be drawn
+    without reading its players one attribute at a time.
+    """
+    import bb_engine
+
+    players, state = arrays['players'], arrays['state']
+    has_ball = bb_engine.PLAYER_FLAGS['has_ball']
+    turn = {'home_players': [], 'away_players': []}
+    for p in players[players['state'] <= 2]:  # standing, prone, stunned
+        key = 'home_players' if p['team'] == 0 else 'away_players'
+        turn[key].append({'id': int(p['id']), 'x': int(p['x']), 'y': int(p['y']),
+                          'state': int(p['state']), 'has_ball': bool(p['flags'] & has_ball)})
+    turn['ball_x'] = int(state['ball_x'])
+    turn['ball_y'] = int(state['ball_y'])
+    turn['ball_held'] = bool(state['ball_held'])
+    turn['ball_carrier_id'] = int(state['ball_carrier_id'])
+    return turn
+
+
 def summarize_events(events: list) -> list[str]:
     """Summarize events into human-readable lines."""
     lines = []
@@ -290,13 +313,17 @@ def main():
     parser.add_argument('--weights', default='', help='Weights file path')
     parser.add_argument('--verbose', '-v', action='store_true', help='Show pitch each turn')
     parser.add_argument('--save', default='', help='Save replay to JSON file')
-    parser.add_argument('--load', default='', help='Load replay from JSON file')
+    parser.add_argument('--load', default='', help='Load replay from JSON or .bbr file')
     parser.add_argument('--seed', type=int, default=None, help='Random seed')
     args = parser.parse_args()
 
     if args.load:
-        with open(args.load) as f:
-            data = json.load(f)
+        if args.load.endswith('.bbr'):
+            from .replay_file import ReplayFile
+            data = {'games': [{'turns': ReplayFile(args.load).turn_logs()}]}
+        else:
+            with open(args.load) as f:
+                data = json.load(f)
         print(f"Loaded replay from {args.load}")
         for i, game in enumerate(data['games']):
             print(f"\n{'#' * 60}")
@@ -0,0 +1,109 @@
+"""Reader for exported search trees (engine/include/bb/search_tree_file.h).
+
+A search's final tree is written by MacroSearch.export_tree(path=...) (or
+writeSearchTree in C++). The file is memory-mapped and the nodes exposed
+as one numpy record array, breadth-first from the root (row 0), so a
+production search can be inspected offline without re-running it:
+
+    t = SearchTree('decision.bbt')
+    root_children = t.children(0)
+    best = root_children[np.argmax(t.nodes['visits'][root_children])]
+    t.describe(best)             # 'BLITZ p3 -> p14 (visits 812, q +0.214)'
+    deep = t.nodes[t.nodes['depth'] >= 4]
+"""
+from __future__ import annotations
+
+import numpy as np
+
+MAGIC = 0x54534242  # "BBST"
+VERSION = 1
+TEAM_UNKNOWN = 255
+
+# MacroType and ActionType order (macro_actions.h, enums.h)
+MACRO_TYPES = [
+    'SCORE', 'ADVANCE', 'CAGE', 'BLITZ', 'BLOCK', 'PICKUP', 'PASS_ACTION',
+    'FOUL', 'REPOSITION', 'END_TURN', 'BLITZ_AND_SCORE', 'HAND_OFF_SCORE',
+    'PASS_SCORE', 'CHAIN_SCORE',
+]
+ACTION_TYPES = [
+    'MOVE', 'BLOCK', 'BLITZ', 'PASS', 'HAND_OFF', 'FOUL',
+    'THROW_TEAM_MATE', 'BOMB_THROW', 'HYPNOTIC_GAZE',
+    'BALL_AND_CHAIN', 'MULTIPLE_BLOCK',
+    'END_TURN', 'SETUP_PLAYER', 'END_SETUP', 'MOVE_PATH',
+]
+
+HEADER_DTYPE = np.dtype([
+    ('magic', '<u4'), ('version', '<u4'), ('num_nodes', '<u4'),
+    ('macro', 'u1'), ('searching_side', 'u1'), ('reserved', '<u2'),
+    ('min_visits', '<i4'), ('reserved2', '<u4'),
+])
+
+NODE_DTYPE = np.dtype([
+    ('parent', '<i4'), ('visits', '<i4'), ('q', '<f4'), ('prior', '<f4'),
+    ('chance', '<f4'), ('num_children', '<u4'),
+    ('kind', 'u1'), ('player_id', 'i1'), ('target_id', 'i1'), ('third_id', 'i1'),
+    ('target_x', 'i1'), ('target_y', 'i1'), ('acting_team', 'u1'), ('depth', 'u1'),
+])
+
+
+class SearchTree:
+    """One exported search tree, mapped read-only.
+
+    `nodes` is a record array viewing the mapping. Q is the mean backed-up
+    value from the searching side's view (`searching_side`, 0 home 1 away);
+    `acting_team` is the side whose choice a node is.
+    """
+
+    def __init__(self, path: str):
+        self._map = np.memmap(path, dtype=np.uint8, mode='r')
+        if self._map.size < HEADER_DTYPE.itemsize:
+            raise ValueError(f'{path}: too short for a search tree file')
+        h = self._map[:HEADER_DTYPE.itemsize].view(HEADER_DTYPE)[0]
+        if h['magic'] != MAGIC or h['version'] != VERSION:
+            raise ValueError(f'{path}: not a version {VERSION} search tree file')
+        n = int(h['num_nodes'])
+        end = HEADER_DTYPE.itemsize + n * NODE_DTYPE.itemsize
+        if end != self._map.size:
+            raise ValueError(f'{path}: size does not match {n} nodes')
+        self.header = h
+        self.macro = bool(h['macro'])
+        self.searching_side = int(h['searching_side'])
+        self.min_visits = int(h['min_visits'])
+        self.nodes = self._map[HEADER_DTYPE.itemsize:end].view(NODE_DTYPE)
+        # Kept children are consecutive rows: the first child of row i
+        # follows every earlier row's children
+        counts = self.nodes['num_children'].astype(np.int64)
+        self._first_child = 1 + np.concatenate(([0], np.cumsum(counts)[:-1])) if n else counts
+
+    def __len__(self) -> int:
+        return len(self.nodes)
+
+    def children(self, row: int) -> np.ndarray:
+        """Rows of the kept children of `row`."""
+        first = int(self._first_child[row])
+        return np.arange(first, first + int(self.nodes['num_children'][row]))
+
+    def path(self, row: int) -> list[int]:
+        """Rows from the root down to `row`."""
+        rows = [row]
+        while self.nodes['parent'][rows[-1]] >= 0:
+            rows.append(int(self.nodes['parent'][rows[-1]]))
+        return rows[::-1]
+
+    def kind_name(self, row: int) -> str:
+        names = MACRO_TYPES if self.macro else ACTION_TYPES
+        kind = int(self.nodes['kind'][row])
+        return names[kind] if kind < len(names) else str(kind)
+
+    def describe(self, row: int) -> str:
+        """One line for a node: its move and statistics."""
+        n = self.nodes[row]
+        if row == 0:
+            text = 'root'
+        else:
+            text = f"{self.kind_name(row)} p{int(n['player_id'])}"
+            if n['target_id'] >= 0:
+                text += f" -> p{int(n['target_id'])}"
+            elif n['target_x'] >= 0:
+                text += f" -> ({int(n['target_x'])},{int(n['target_y'])})"
+        return f"{text} (visits {int(n['visits'])}, q {float(n['q']):+.3f})"
@@ -0,0 +1,113 @@
+"""Reader for training shards (engine/include/bb/training_shards.h).
+
+Self-play streams StateLog and PolicyDecision records into append-only
+shard files through bb_engine.ShardWriter; this module maps the completed
+shards listed in index.jsonl as numpy record arrays, so training reads
+features and visit distributions with no unpickling and no per-sample
+Python objects:
+
+    shards = ShardSet('data/shards')
+    for shard in shards:
+        x = shard.states['features']          # (n, NUM_FEATURES) float32 view
+        y = shard.states['outcome']
+    visits = shards.decision_visits(0, 5)     # visit rows of one decision
+
+Uncompressed shards are memory-mapped; zstd shards (written with
+compress=True) are decompressed into memory and need the `zstandard`
+package.
+"""
+from __future__ import annotations
+
+import json
+from pathlib import Path
+
+import numpy as np
+
+MAGIC = 0x48534242  # "BBSH"
+VERSION = 2
+HEADER_BYTES = 32
+
+NUM_FEATURES = 73
+NUM_ACTION_FEATURES = 23
+
+HEADER_DTYPE = np.dtype([
+    ('magic', '<u4'), ('version', '<u4'), ('kind', '<u4'), ('record_size', '<u4'),
+    ('num_features', '<u4'), ('num_action_features', '<u4'), ('reserved', '<u8'),
+])
+
+STATE_DTYPE = np.dtype([
+    ('features', '<f4', (NUM_FEATURES,)), ('outcome', '<f4'), ('game', '<u4'),
+    ('index', '<u2'), ('perspective', 'u1'), ('reserved', 'u1'),
+])
+DECISION_DTYPE = np.dtype([
+    ('features', '<f4', (NUM_FEATURES,)), ('outcome', '<f4'), ('game', '<u4'),
+    ('first_visit', '<u4'), ('num_visits', '<u4'), ('perspective', 'u1'),
+    ('mirrored', 'u1'), ('reserved', 'u1', (2,)), ('state_hash', '<u8'),
+    ('canonical_hash', '<u8'), ('visit_weight', '<f4'), ('samples', '<u4'),
+])
+VISIT_DTYPE = np.dtype([
+    ('action_features', '<f4', (NUM_ACTION_FEATURES,)), ('visit_fraction', '<f4'),
+])
+
+_KINDS = (('states', STATE_DTYPE), ('decisions', DECISION_DTYPE), ('visits', VISIT_DTYPE))
+
+
+def _load(path: Path, dtype: np.dtype, compressed: bool) -> np.ndarray:
+    if compressed:
+        import zstandard
+        raw = np.frombuffer(zstandard.ZstdDecompressor().decompress(
+            Path(str(path) + '.zst').read_bytes()), dtype=np.uint8)
+    else:
+        raw = np.memmap(path, dtype=np.uint8, mode='r')
+    header = raw[:HEADER_BYTES].view(HEADER_DTYPE)[0]
+    if (header['magic'] != MAGIC or header['version'] != VERSION
+            or header['record_size'] != dtype.itemsize
+            or header['num_features'] != NUM_FEATURES
+            or header['num_action_features'] != NUM_ACTION_FEATURES):
+        raise ValueError(f'{path}: not a matching version {VERSION} shard file')
+    # Whole records only: a writer may be mid-append on an unindexed shard
+    n = (raw.size - HEADER_BYTES) // dtype.itemsize
+    return raw[HEADER_BYTES:HEADER_BYTES + n * dtype.itemsize].view(dtype)
+
+
+class Shard:
+    """The three record arrays of one completed shard."""
+
+    def __init__(self, directory: Path, entry: dict):
+        self.entry = entry
+        stem = directory / f"shard-{entry['shard']:06d}"
+        for name, dtype in _KINDS:
+            setattr(self, name, _load(stem.with_suffix('.' + name), dtype, entry.get('zstd', False)))
+
+    def decision_visits(self, row: int) -> np.ndarray:
+        d = self.decisions[row]
+        return self.visits[d['first_visit']:d['first_visit'] + d['num_visits']]
+
+
+class ShardSet:
+    """Every shard listed in `directory`/index.jsonl, opened lazily."""
+
+    def __init__(self, directory: str):
+        self.directory = Path(directory)
+        index = self.directory / 'index.jsonl'
+        self.entries = [json.loads(line) for line in index.read_text().splitlines() if line.strip()]
+        self._open: dict[int, Shard] = {}
+
+    def __len__(self) -> int:
+        return len(self.entries)
+
+    def __getitem__(self, i: int) -> Shard:
+        if i not in self._open:
+            self._open[i] = Shard(self.directory, self.entries[i])
+        return self._open[i]
+
+    def __iter__(self):
+        return (self[i] for i in range(len(self)))
+
+    def decision_visits(self, shard: int, row: int) -> np.ndarray:
+        return self[shard].decision_visits(row)
+
+    def concatenate(self, kind: str) -> np.ndarray:
+        """One array of every shard's `kind` records ('states', 'decisions'
+        or 'visits'). Copies; iterate shards to stay zero-copy."""
+        return np.concatenate([getattr(s, kind) for s in self])
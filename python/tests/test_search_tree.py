@@ -0,0 +1,48 @@
+"""Tests for the exported search tree reader."""
+from __future__ import annotations
+
+import numpy as np
+import pytest
+
+from blood_bowl.search_tree import HEADER_DTYPE, MAGIC, NODE_DTYPE, VERSION, SearchTree
+
+
+def _write_tree(path, rows, macro=True):
+    header = np.zeros(1, dtype=HEADER_DTYPE)
+    header['magic'], header['version'] = MAGIC, VERSION
+    header['num_nodes'], header['macro'], header['min_visits'] = len(rows), int(macro), 1
+    nodes = np.zeros(len(rows), dtype=NODE_DTYPE)
+    for i, (parent, visits, kind, player) in enumerate(rows):
+        nodes[i]['parent'], nodes[i]['visits'] = parent, visits
+        nodes[i]['kind'], nodes[i]['player_id'] = kind, player
+        nodes[i]['target_id'] = nodes[i]['target_x'] = nodes[i]['target_y'] = -1
+    for parent in nodes['parent'][1:]:
+        nodes[parent]['num_children'] += 1
+    for i in range(1, len(nodes)):
+        nodes[i]['depth'] = nodes[nodes[i]['parent']]['depth'] + 1
+    with open(path, 'wb') as f:
+        f.write(header.tobytes())
+        f.write(nodes.tobytes())
+
+
+def test_children_and_paths(tmp_path):
+    path = tmp_path / 'tree.bbt'
+    # root -> (1: BLITZ, 2: END_TURN); 1 -> (3, 4); 2 -> (5)
+    _write_tree(path, [(-1, 10, 0, -1), (0, 7, 3, 4), (0, 3, 9, -1),
+                       (1, 4, 1, 5), (1, 3, 2, 6), (2, 3, 0, 14)])
+    t = SearchTree(str(path))
+    assert len(t) == 6 and t.macro
+    assert list(t.children(0)) == [1, 2]
+    assert list(t.children(1)) == [3, 4]
+    assert list(t.children(2)) == [5]
+    assert list(t.children(5)) == []
+    assert t.path(4) == [0, 1, 4]
+    assert t.kind_name(1) == 'BLITZ'
+    assert t.describe(1).startswith('BLITZ p4 (visits 7')
+
+
+def test_rejects_other_files(tmp_path):
+    path = tmp_path / 'bad.bbt'
+    path.write_bytes(b'\0' * 64)
+    with pytest.raises(ValueError):
+        SearchTree(str(path))